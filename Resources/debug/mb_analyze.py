@@ -1,4 +1,5 @@
 # coding=utf-8
+import json
 import re
 import sys
 
@@ -12,6 +13,24 @@ STATES = {
 
 TUMBLER = ['r', 'w', 'p', 'c']
 
+HINTS = [
+    'NO_HINT',
+    'COMMAND_BLOCK',
+    'PERFECT_ACCELERATION',
+    'PERFECT_DECELERATION',
+    'PERFECT_CRUISE',
+    'MIXED_ACCELERATION',
+    'MIXED_DECELERATION',
+    'ZERO_VELOCITY',
+    'ZERO_BUMP',
+    'SYMMETRIC_BUMP',
+    'ASYMMETRIC_BUMP'
+]
+
+# field order of a {"trc":[...]} planner trace line - see trace.h
+TRACE_FIELDS = ['seq', 'linenum', 'hint', 'iterations', 'length',
+                'cruise_vmax', 'cruise_velocity', 'exit_vmax', 'exit_velocity', 'block_time', 'start']
+
 
 def load_pool(filename):
     tumbler_pos = 0
@@ -163,6 +182,47 @@ def print_pool(pool):
                 float(buffer['jerk'])/1000000.0
                 )
 
+def load_trace(filename):
+    # reads a capture of a {trcd:1} dump. Other lines in the capture are ignored
+    trace = []
+    with open(filename) as capture:
+        for line in capture:
+            line = line.strip()
+            if not line.startswith('{"trc":['):
+                continue
+            record = dict(zip(TRACE_FIELDS, json.loads(line)['trc']))
+            record['hint'] = HINTS[record['hint']] if record['hint'] < len(HINTS) else str(record['hint'])
+            trace.append(record)
+    return trace
+
+def print_trace(trace):
+    last_seq = None
+    for record in trace:
+        if last_seq is not None and record['seq'] != last_seq + 1:
+            print '---- %d blocks overwritten during the dump' % (record['seq'] - last_seq - 1)
+        last_seq = record['seq']
+
+        cruise_str = '=' if record['cruise_velocity'] == record['cruise_vmax'] else '<'
+        exit_str = '=' if record['exit_velocity'] == record['exit_vmax'] else '<'
+
+        print '%6d : N%04d (%02dx) L% 8.3f Ti% 8.3f C% 10.2f %1s[% 10.2f] X% 10.2f %1s[% 10.2f] %20s' % (
+            record['seq'],
+            record['linenum'],
+            record['iterations'],
+            record['length'],
+            record['block_time'],
+            record['cruise_velocity'],
+            cruise_str,
+            record['cruise_vmax'],
+            record['exit_velocity'],
+            exit_str,
+            record['exit_vmax'],
+            record['hint']
+            )
+
 if __name__ == "__main__":
-    pool = check_pool(sys.argv[1])
-    print_pool(pool)
+    if sys.argv[1] == '--trace':
+        print_trace(load_trace(sys.argv[2]))
+    else:
+        pool = check_pool(sys.argv[1])
+        print_pool(pool)
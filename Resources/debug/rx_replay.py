@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+"""
+rx_replay.py - send an RX capture dump back to a board with the recorded timing
+
+Usage: rx_replay.py <dump.txt> <serial port>      send it (needs pyserial)
+       rx_replay.py <dump.txt> --raw <out.bin>    write the bytes only, for a look
+
+The dump is what {rxcd:1} prints - see g2core/rx_capture.h:
+
+    {"rxch":[records,bytes]}
+    {"rxc":[usec,"hex bytes"]}
+
+Other lines in the file are skipped, so a terminal log of the dump will do. Each
+record is written once its time since the first record has passed. Responses from
+the board are read and dropped as they come, so its TX path never backs up.
+"""
+
+import json
+import sys
+import time
+
+
+def load_records(filename):
+    records = []
+    expected = None
+    with open(filename) as fp:
+        for line in fp:
+            line = line.strip()
+            if not line.startswith('{"rxc'):
+                continue
+            obj = json.loads(line)
+            if 'rxch' in obj:
+                expected = obj['rxch']
+                records = []                # a new dump starts here
+            elif 'rxc' in obj:
+                usec, data = obj['rxc']
+                records.append((usec, bytes.fromhex(data)))
+    if expected and (len(records) != expected[0]):
+        print("warning: %d records of %d - the dump is cut short" % (len(records), expected[0]),
+              file=sys.stderr)
+    return records
+
+
+def replay(records, port):
+    import serial
+    link = serial.Serial(port, 115200, timeout=0)
+    start = time.monotonic() - (records[0][0] / 1e6)
+    for usec, data in records:
+        while time.monotonic() - start < usec / 1e6:
+            link.read(4096)
+            time.sleep(0.0002)
+        link.write(data)
+    link.flush()
+
+
+def main():
+    if len(sys.argv) == 4 and sys.argv[2] == '--raw':
+        with open(sys.argv[3], 'wb') as out:
+            for _, data in load_records(sys.argv[1]):
+                out.write(data)
+        return
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    records = load_records(sys.argv[1])
+    if not records:
+        sys.exit("%s: no capture records found" % sys.argv[1])
+    replay(records, sys.argv[2])
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,2117 @@
+/*
+ * gcode_file[] - converted to binary frames from gcode/gcode_braid2d.h by Resources/tokenize_gcode.py --frames - do not edit
+ */
+const char PROGMEM gcode_file[] =
+    "\002\020\100\020\100\020\100\020\100\300\204\012"    // SYNC frame
+    "T1M6\n"
+    "G17G21\n"
+    "S8000M3\n"
+    "G92X0.000Y-33.519Z6.000\n"
+    "F600.0\n"
+    "(G1Z-1.000)\n"
+    "\002\001\002\003\020\100\213\154\247\076\201\025\006\302\067\346\012"    // G1X0.327Y-33.521
+    "\002\002\002\003\020\100\213\154\047\077\240\032\006\302\022\360\012"    // X0.654Y-33.526
+    "\002\003\002\003\020\100\110\341\172\077\321\042\006\302\242\027\012"    // X0.980Y-33.534
+    "\002\004\002\003\020\100\171\351\246\077\033\057\006\302\102\273\012"    // X1.304Y-33.546
+    "\002\005\002\003\020\100\305\040\320\077\175\077\006\302\121\272\012"    // X1.626Y-33.562
+    "\002\006\002\003\020\100\207\026\371\077\354\121\006\302\273\163\012"    // X1.946Y-33.580
+    "\002\007\002\003\020\100\234\304\020\120\100\163\150\006\302\270\110\012"    // X2.262Y-33.602
+    "\002\010\002\003\020\100\152\274\044\100\022\203\006\302\132\327\012"    // X2.574Y-33.628
+    "\002\011\002\003\020\100\260\162\070\100\276\237\006\302\020\112\265\012"    // X2.882Y-33.656
+    "\002\020\112\002\003\020\100\020\112\327\113\100\203\300\006\302\360\312\012"    // X3.185Y-33.688
+    "\002\013\002\003\020\100\171\351\136\100\140\345\006\302\174\361\012"    // X3.483Y-33.724
+    "\002\014\002\003\020\100\232\231\161\100\112\014\007\302\145\147\012"    // X3.775Y-33.762
+    "\002\020\115\002\003\020\100\205\353\201\100\122\070\007\302\131\162\012"    // X4.060Y-33.805
+    "\002\016\002\003\020\100\027\331\212\100\146\146\007\302\116\141\012"    // X4.339Y-33.850
+    "\002\017\002\003\020\100\037\205\223\100\215\227\007\302\354\330\012"    // X4.610Y-33.898
+    "\002\020\120\002\003\020\100\317\367\233\100\315\314\007\302\331\343\012"    // X4.874Y-33.950
+    "\002\021\002\003\020\100\366\050\244\100\037\005\010\302\102\063\012"    // X5.130Y-34.005
+    "\002\022\002\003\020\100\061\010\254\100\211\101\010\302\113\271\012"    // X5.376Y-34.064
+    "\002\023\002\003\020\100\343\245\263\100\020\100\200\010\302\167\314\012"    // X5.614Y-34.125
+    "\002\024\002\003\020\100\252\361\272\100\217\302\010\302\115\162\012"    // X5.842Y-34.190
+    "\002\025\002\003\020\100\205\353\301\100\053\007\011\302\050\117\012"    // X6.060Y-34.257
+    "\002\026\002\003\020\100\165\223\310\100\337\117\011\302\244\271\012"    // X6.268Y-34.328
+    "\002\027\002\003\020\100\171\351\316\100\246\233\011\302\376\131\012"    // X6.466Y-34.402
+    "\002\030\002\003\020\100\057\335\324\100\177\352\011\302\063\261\012"    // X6.652Y-34.479
+    "\002\031\002\003\020\100\311\166\332\100\152\074\020\112\302\262\151\012"    // X6.827Y-34.559
+    "\002\032\002\003\020\100\024\256\337\100\150\221\020\112\302\313\217\012"    // X6.990Y-34.642
+    "\002\033\002\003\020\100\022\203\344\100\171\351\020\112\302\035\170\012"    // X7.141Y-34.728
+    "\002\034\002\003\020\100\303\365\350\100\234\104\013\302\224\333\012"    // X7.280Y-34.817
+    "\002\035\002\003\020\100\045\006\355\100\321\242\013\302\203\331\012"    // X7.407Y-34.909
+    "\002\036\002\003\020\100\010\254\360\100\022\003\014\302\325\250\012"    // X7.521Y-35.003
+    "\002\037\002\003\020\100\073\337\363\100\155\147\014\302\072\146\012"    // X7.621Y-35.101
+    "\002\040\002\003\020\100\041\260\366\100\323\315\014\302\305\323\012"    // X7.709Y-35.201
+    "\002\041\002\003\020\100\126\016\371\100\114\067\020\115\302\210\247\012"    // X7.783Y-35.304
+    "\002\042\002\003\020\100\333\371\372\100\327\243\020\115\302\267\215\012"    // X7.843Y-35.410
+    "\002\043\002\003\020\100\341\172\374\100\157\022\016\302\166\117\012"    // X7.890Y-35.518
+    "\002\044\002\003\020\100\067\211\375\100\031\204\016\302\334\354\012"    // X7.923Y-35.629
+    "\002\045\002\003\020\100\335\044\376\100\325\370\016\302\366\276\012"    // X7.942Y-35.743
+    "\002\046\002\003\020\100\242\105\376\100\236\157\017\302\307\147\012"    // X7.946Y-35.859
+    "\002\047\002\003\020\100\347\373\375\100\163\350\017\302\146\327\012"    // X7.937Y-35.977
+    "\002\050\002\003\020\100\175\077\375\100\132\144\020\120\302\120\273\012"    // X7.914Y-36.098
+    "\002\051\002\003\020\100\061\010\374\100\116\342\020\120\302\207\002\012"    // X7.876Y-36.221
+    "\002\052\002\003\020\100\065\136\372\100\124\143\021\302\161\202\012"    // X7.824Y-36.347
+    "\002\053\002\003\020\100\211\101\370\100\146\346\021\302\027\014\012"    // X7.758Y-36.475
+    "\002\054\002\003\020\100\374\251\365\100\205\153\022\302\215\020\112\012"    // X7.677Y-36.605
+    "\002\055\002\003\020\100\360\247\362\100\266\363\022\302\053\204\012"    // X7.583Y-36.738
+    "\002\056\002\003\020\100\002\053\357\100\356\174\023\302\150\072\012"    // X7.474Y-36.872
+    "\002\057\002\003\020\100\226\103\353\100\067\011\024\302\110\041\012"    // X7.352Y-37.009
+    "\002\060\002\003\020\100\171\351\346\100\215\227\024\302\100\056\012"    // X7.216Y-37.148
+    "\002\061\002\003\020\100\254\034\342\100\360\047\025\302\315\265\012"    // X7.066Y-37.289
+    "\002\062\002\003\020\100\140\345\334\100\130\271\025\302\102\020\115\012"    // X6.903Y-37.431
+    "\002\063\002\003\020\100\351\046\321\100\124\343\026\302\005\311\012"    // X6.536Y-37.722
+    "\002\064\002\003\020\100\360\247\312\100\341\172\027\302\100\367\012"    // X6.333Y-37.870
+    "\002\065\002\003\020\100\250\306\303\100\173\024\030\302\162\134\012"    // X6.118Y-38.020
+    "\002\066\002\003\020\100\315\314\264\100\307\113\031\302\125\035\012"    // X5.650Y-38.324
+    "\002\067\002\003\020\100\234\304\254\100\177\352\031\302\102\350\012"    // X5.399Y-38.479
+    "\002\070\002\003\020\100\354\121\244\100\075\212\032\302\006\356\012"    // X5.135Y-38.635
+    "\002\071\002\003\020\100\230\156\222\100\323\315\033\302\247\256\012"    // X4.576Y-38.951
+    "\002\072\002\003\020\100\102\140\125\100\132\144\036\302\357\272\012"    // X3.334Y-39.598
+    "\002\073\002\003\020\100\335\044\076\100\240\032\037\302\043\047\012"    // X2.971Y-39.776
+    "\002\074\002\003\020\100\004\126\046\100\354\321\037\302\150\104\012"    // X2.599Y-39.955
+    "\002\075\002\003\020\100\347\373\351\077\234\104\041\302\076\044\012"    // X1.828Y-40.317
+    "\002\076\002\003\020\100\313\241\105\076\063\063\044\302\310\216\012"    // X0.193Y-41.050
+    "\002\077\002\003\020\100\370\123\123\300\343\045\052\302\073\121\012"    // X-3.302Y-42.537
+    "\002\100\002\003\020\100\331\316\157\300\132\344\052\302\125\273\012"    // X-3.747Y-42.723
+    "\002\101\002\003\020\100\254\034\206\300\313\241\053\302\202\327\012"    // X-4.191Y-42.908
+    "\002\102\002\003\020\100\065\136\242\300\254\034\055\302\160\333\012"    // X-5.074Y-43.278
+    "\002\103\002\003\020\100\055\262\331\300\112\014\060\302\342\242\012"    // X-6.803Y-44.012
+    "\002\104\002\003\020\100\102\140\037\301\136\272\065\302\042\044\012"    // X-9.961Y-45.432
+    "\002\105\002\003\020\100\075\020\112\045\301\171\151\066\302\267\250\012"    // X-10.315Y-45.603
+    "\002\106\002\003\020\100\104\213\052\301\215\027\067\302\062\067\012"    // X-10.659Y-45.773
+    "\002\107\002\003\020\100\364\375\064\301\221\155\070\302\033\153\012"    // X-11.312Y-46.107
+    "\002\110\002\003\020\100\205\353\071\301\207\026\071\302\314\160\012"    // X-11.620Y-46.272
+    "\002\111\002\003\020\100\327\243\076\301\152\274\071\302\112\166\012"    // X-11.915Y-46.434
+    "\002\112\002\003\020\100\274\164\107\301\022\003\073\302\214\016\012"    // X-12.466Y-46.753
+    "\002\113\002\003\020\100\037\205\113\301\321\242\073\302\253\175\012"    // X-12.720Y-46.909
+    "\002\114\002\003\020\100\051\134\117\301\203\100\074\302\141\020\120\012"    // X-12.960Y-47.063
+    "\002\115\002\003\020\100\333\371\122\301\043\333\074\302\356\133\012"    // X-13.186Y-47.214
+    "\002\116\002\003\020\100\004\126\126\301\274\164\075\302\374\110\012"    // X-13.396Y-47.364
+    "\002\117\002\003\020\100\274\164\131\301\075\020\112\076\302\316\030\012"    // X-13.591Y-47.510
+    "\002\120\002\003\020\100\354\121\134\301\262\235\076\302\066\127\012"    // X-13.770Y-47.654
+    "\002\121\002\003\020\100\221\355\136\301\033\057\077\302\333\043\012"    // X-13.933Y-47.796
+    "\002\122\002\003\020\100\256\107\141\301\161\275\077\302\264\102\012"    // X-14.080Y-47.935
+    "\002\123\002\003\020\100\102\140\143\301\264\110\100\302\231\303\012"    // X-14.211Y-48.071
+    "\002\124\002\003\020\100\114\067\145\301\345\320\100\302\346\371\012"    // X-14.326Y-48.204
+    "\002\125\002\003\020\100\264\310\146\301\004\126\101\302\300\212\012"    // X-14.424Y-48.334
+    "\002\126\002\003\020\100\173\024\150\301\027\331\101\302\172\131\012"    // X-14.505Y-48.462
+    "\002\127\002\003\020\100\270\036\151\301\020\120\130\102\302\321\047\012"    // X-14.570Y-48.586
+    "\002\130\002\003\020\100\124\343\151\301\370\323\102\302\254\132\012"    // X-14.618Y-48.707
+    "\002\131\002\003\020\100\116\142\152\301\315\114\103\302\374\337\012"    // X-14.649Y-48.825
+    "\002\132\002\003\020\100\246\233\152\301\217\302\103\302\173\023\012"    // X-14.663Y-48.940
+    "\002\133\002\003\020\100\165\223\152\301\077\065\104\302\267\163\012"    // X-14.661Y-49.052
+    "\002\134\002\003\020\100\242\105\152\301\327\243\104\302\372\241\012"    // X-14.642Y-49.160
+    "\002\135\002\003\020\100\106\266\151\301\134\017\105\302\312\334\012"    // X-14.607Y-49.265
+    "\002\136\002\003\020\100\140\345\150\301\311\166\105\302\020\100\151\012"    // X-14.556Y-49.366
+    "\002\137\002\003\020\100\331\316\147\301\043\333\105\302\167\173\012"    // X-14.488Y-49.464
+    "\002\140\002\003\020\100\311\166\146\301\152\074\106\302\260\305\012"    // X-14.404Y-49.559
+    "\002\141\002\003\020\100\110\341\144\301\223\230\106\302\167\177\012"    // X-14.305Y-49.649
+    "\002\142\002\003\020\100\075\020\112\143\301\260\362\106\302\357\351\012"    // X-14.190Y-49.737
+    "\002\143\002\003\020\100\207\026\141\301\217\102\107\302\042\033\012"    // X-14.068Y-49.815
+    "\002\144\002\003\020\100\252\361\136\301\126\216\107\302\257\335\012"    // X-13.934Y-49.889
+    "\002\145\002\003\020\100\215\227\134\301\020\120\330\107\302\276\136\012"    // X-13.787Y-49.961
+    "\002\146\002\003\020\100\112\014\132\301\262\035\110\302\003\027\012"    // X-13.628Y-50.029
+    "\002\147\002\003\020\100\307\113\127\301\102\140\110\302\154\060\012"    // X-13.456Y-50.094
+    "\002\150\002\003\020\100\065\136\124\301\270\236\110\302\055\156\012"    // X-13.273Y-50.155
+    "\002\151\002\003\020\100\175\077\121\301\035\332\110\302\166\132\012"    // X-13.078Y-50.213
+    "\002\152\002\003\020\100\266\363\115\301\150\021\111\302\011\254\012"    // X-12.872Y-50.267
+    "\002\153\002\003\020\100\341\172\112\301\242\105\111\302\165\262\012"    // X-12.655Y-50.318
+    "\002\154\002\003\020\100\027\331\106\301\311\166\111\302\056\272\012"    // X-12.428Y-50.366
+    "\002\155\002\003\020\100\075\020\112\103\301\327\243\111\302\073\276\012"    // X-12.190Y-50.410
+    "\002\156\002\003\020\100\240\032\077\301\315\314\111\302\247\220\012"    // X-11.944Y-50.450
+    "\002\157\002\003\020\100\014\002\073\301\260\362\111\302\254\003\012"    // X-11.688Y-50.487
+    "\002\160\002\003\020\100\234\304\066\301\173\024\112\302\040\224\012"    // X-11.423Y-50.520
+    "\002\161\002\003\020\100\146\146\062\301\055\062\112\302\055\216\012"    // X-11.150Y-50.549
+    "\002\162\002\003\020\100\205\353\055\301\315\114\112\302\151\352\012"    // X-10.870Y-50.575
+    "\002\163\002\003\020\100\337\117\051\301\124\143\112\302\163\056\012"    // X-10.582Y-50.597
+    "\002\164\002\003\020\100\215\227\044\301\311\166\112\302\360\251\012"    // X-10.287Y-50.616
+    "\002\165\002\003\020\100\301\312\037\301\037\205\112\302\311\224\012"    // X-9.987Y-50.630
+    "\002\166\002\003\020\100\110\341\032\301\142\220\112\302\146\200\012"    // X-9.680Y-50.641
+    "\002\167\002\003\020\100\124\343\025\301\223\230\112\302\250\112\012"    // X-9.368Y-50.649
+    "\002\170\002\003\020\100\376\324\020\120\301\246\233\112\302\352\204\012"    // X-9.052Y-50.652
+    "\002\171\002\003\020\100\106\266\013\301\246\233\112\302\307\050\012"    // X-8.732Y-50.652
+    "\002\172\002\003\020\100\053\207\006\301\215\227\112\302\033\005\012"    // X-8.408Y-50.648
+    "\002\173\002\003\020\100\307\113\001\301\134\217\112\302\252\277\012"    // X-8.081Y-50.640
+    "\002\174\002\003\020\100\061\010\370\300\022\203\112\302\141\265\012"    // X-7.751Y-50.628
+    "\002\175\002\003\020\100\244\160\355\300\266\163\112\302\003\263\012"    // X-7.420Y-50.613
+    "\002\176\002\003\020\100\264\310\342\300\102\140\112\302\175\140\012"    // X-7.087Y-50.594
+    "\002\177\002\003\020\100\305\040\330\300\264\110\112\302\244\041\012"    // X-6.754Y-50.571
+    "\002\200\002\003\020\100\244\160\315\300\016\055\112\302\316\214\012"    // X-6.420Y-50.544
+    "\002\201\002\003\020\100\264\310\302\300\120\020\115\112\302\162\107\012"    // X-6.087Y-50.513
+    "\002\202\002\003\020\100\305\040\270\300\177\352\111\302\260\156\012"    // X-5.754Y-50.479
+    "\002\203\002\003\020\100\150\221\255\300\226\303\111\302\022\301\012"    // X-5.424Y-50.441
+    "\002\204\002\003\020\100\075\020\112\243\300\223\230\111\302\367\017\012"    // X-5.095Y-50.399
+    "\002\205\002\003\020\100\246\233\230\300\171\151\111\302\366\352\012"    // X-4.769Y-50.353
+    "\002\206\002\003\020\100\242\105\216\300\114\067\111\302\344\321\012"    // X-4.446Y-50.304
+    "\002\207\002\003\020\100\142\020\120\204\300\020\100\020\100\111\302\151\255\012"    // X-4.127Y-50.250
+    "\002\210\002\003\020\100\317\367\163\300\242\305\110\302\165\317\012"    // X-3.812Y-50.193
+    "\002\211\002\003\020\100\010\254\114\300\242\105\110\302\044\160\012"    // X-3.198Y-50.068
+    "\002\212\002\003\020\100\067\211\071\300\020\100\020\100\110\302\052\020\112\012"    // X-2.899Y-50.000
+    "\002\213\002\003\020\100\264\310\046\300\106\266\107\302\305\223\012"    // X-2.606Y-49.928
+    "\002\214\002\003\020\100\104\213\024\300\163\150\107\302\230\231\012"    // X-2.321Y-49.852
+    "\002\215\002\003\020\100\203\300\002\300\215\027\107\302\054\236\012"    // X-2.043Y-49.773
+    "\002\216\002\003\020\100\252\361\342\277\217\302\106\302\104\373\012"    // X-1.773Y-49.690
+    "\002\217\002\003\020\100\163\150\301\277\171\151\106\302\302\056\012"    // X-1.511Y-49.603
+    "\002\220\002\003\020\100\205\353\201\277\016\255\105\302\140\142\012"    // X-1.015Y-49.419
+    "\002\221\002\003\020\100\236\357\107\277\272\111\105\302\310\077\012"    // X-0.781Y-49.322
+    "\002\222\002\003\020\100\215\227\016\277\116\342\104\302\110\321\012"    // X-0.557Y-49.221
+    "\002\223\002\003\020\100\262\235\257\276\311\166\104\302\130\230\012"    // X-0.343Y-49.116
+    "\002\224\002\003\020\100\116\142\020\120\276\067\011\104\302\331\236\012"    // X-0.141Y-49.009
+    "\002\225\002\003\020\100\315\314\114\075\207\226\103\302\344\324\012"    // X0.050Y-48.897
+    "\002\226\002\003\020\100\037\205\153\076\313\041\103\302\102\327\012"    // X0.230Y-48.783
+    "\002\227\002\003\020\100\250\306\313\076\360\247\102\302\011\304\012"    // X0.398Y-48.664
+    "\002\230\002\003\020\100\150\221\020\115\077\010\054\102\302\315\147\012"    // X0.553Y-48.543
+    "\002\231\002\003\020\100\016\055\062\077\010\254\101\302\122\115\012"    // X0.696Y-48.418
+    "\002\232\002\003\020\100\274\164\123\077\366\050\101\302\130\175\012"    // X0.826Y-48.290
+    "\002\233\002\003\020\100\163\150\161\077\321\242\100\302\057\336\012"    // X0.943Y-48.159
+    "\002\234\002\003\020\100\124\343\205\077\223\030\100\302\025\247\012"    // X1.046Y-48.024
+    "\002\235\002\003\020\100\163\150\221\077\112\214\077\302\011\003\012"    // X1.136Y-47.887
+    "\002\236\002\003\020\100\226\103\233\077\347\373\076\302\223\040\012"    // X1.213Y-47.746
+    "\002\237\002\003\020\100\063\063\243\077\163\150\076\302\031\146\012"    // X1.275Y-47.602
+    "\002\240\002\003\020\100\020\120\130\251\077\354\321\075\302\154\306\012"    // X1.323Y-47.455
+    "\002\241\002\003\020\100\055\262\255\077\144\073\075\302\246\007\012"    // X1.357Y-47.308
+    "\002\242\002\003\020\100\211\101\260\077\321\242\074\302\155\260\012"    // X1.377Y-47.159
+    "\002\243\002\003\020\100\045\006\261\077\045\006\074\302\256\221\012"    // X1.383Y-47.006
+    "\002\244\002\003\020\100\020\100\020\100\260\077\155\147\073\302\045\220\012"    // X1.375Y-46.851
+    "\002\245\002\003\020\100\033\057\255\077\242\305\072\302\024\117\012"    // X1.353Y-46.693
+    "\002\246\002\003\020\100\165\223\250\077\305\040\072\302\002\371\012"    // X1.317Y-46.532
+    "\002\247\002\003\020\100\016\055\242\077\333\171\071\302\333\366\012"    // X1.267Y-46.369
+    "\002\250\002\003\020\100\347\373\231\077\337\317\070\302\362\165\012"    // X1.203Y-46.203
+    "\002\251\002\003\020\100\305\040\220\077\327\043\070\302\171\220\012"    // X1.126Y-46.035
+    "\002\252\002\003\020\100\035\132\204\077\274\164\067\302\176\132\012"    // X1.034Y-45.864
+    "\002\253\002\003\020\100\362\322\155\077\226\303\066\302\305\034\012"    // X0.929Y-45.691
+    "\002\254\002\003\020\100\051\134\117\077\134\017\066\302\144\133\012"    // X0.810Y-45.515
+    "\002\255\002\003\020\100\337\117\055\077\035\132\065\302\263\126\012"    // X0.677Y-45.338
+    "\002\256\002\003\020\100\236\357\007\077\305\240\064\302\110\256\012"    // X0.531Y-45.157
+    "\002\257\002\003\020\100\250\306\113\076\374\051\063\302\160\006\012"    // X0.199Y-44.791
+    "\002\260\002\003\020\100\102\140\145\074\177\152\062\302\254\147\012"    // X0.014Y-44.604
+    "\002\261\002\003\020\100\177\152\074\276\374\251\061\302\032\265\012"    // X-0.184Y-44.416
+    "\002\262\002\003\020\100\266\363\035\277\313\041\060\302\144\123\012"    // X-0.617Y-44.033
+    "\002\263\002\003\020\100\073\337\317\277\341\372\054\302\003\144\012"    // X-1.624Y-43.245
+    "\002\264\002\003\020\100\201\225\363\277\016\055\054\302\244\374\012"    // X-1.903Y-43.044
+    "\002\265\002\003\020\100\035\132\014\300\057\135\053\302\020\112\376\012"    // X-2.193Y-42.841
+    "\002\266\002\003\020\100\226\103\063\300\136\272\051\302\201\121\012"    // X-2.801Y-42.432
+    "\002\267\002\003\020\100\020\100\020\100\204\300\116\142\046\302\045\343\012"    // X-4.125Y-41.596
+    "\002\270\002\003\020\100\063\063\217\300\067\211\045\302\123\210\012"    // X-4.475Y-41.384
+    "\002\271\002\003\020\100\360\247\232\300\033\257\044\302\350\063\012"    // X-4.833Y-41.171
+    "\002\272\002\003\020\100\335\044\262\300\325\370\042\302\114\060\012"    // X-5.567Y-40.743
+    "\002\273\002\003\020\100\321\042\343\300\006\201\037\302\020\120\260\012"    // X-7.098Y-39.876
+    "\002\274\002\003\020\100\152\274\044\301\325\170\030\302\010\160\012"    // X-10.296Y-38.118
+    "\002\275\002\003\020\100\002\053\053\301\207\226\027\302\207\223\012"    // X-10.698Y-37.897
+    "\002\276\002\003\020\100\201\225\061\301\071\264\026\302\212\167\012"    // X-11.099Y-37.676
+    "\002\277\002\003\020\100\323\115\076\301\244\360\024\302\353\177\012"    // X-11.894Y-37.235
+    "\002\300\002\003\020\100\002\053\127\301\213\154\021\302\106\215\012"    // X-13.448Y-36.356
+    "\002\301\002\003\020\100\063\063\135\301\112\214\020\120\302\370\373\012"    // X-13.825Y-36.137
+    "\002\302\002\003\020\100\351\046\143\301\016\255\017\302\333\276\012"    // X-14.197Y-35.919
+    "\002\303\002\003\020\100\234\304\156\301\244\360\020\115\302\177\213\012"    // X-14.923Y-35.485
+    "\002\304\002\003\020\100\323\115\202\301\020\100\200\020\112\302\320\315\012"    // X-16.288Y-34.625
+    "\002\305\002\003\020\100\207\026\205\301\173\224\011\302\317\365\012"    // X-16.636Y-34.395
+    "\002\306\002\003\020\100\264\310\207\301\366\250\010\302\024\341\012"    // X-16.973Y-34.165
+    "\002\307\002\003\020\100\155\347\214\301\020\120\330\006\302\104\362\012"    // X-17.613Y-33.711
+    "\002\310\002\003\020\100\354\121\217\301\252\361\005\302\072\022\012"    // X-17.915Y-33.486
+    "\002\311\002\003\020\100\313\241\221\301\112\014\005\302\151\075\012"    // X-18.204Y-33.262
+    "\002\312\002\003\020\100\252\361\225\301\264\110\003\302\167\110\012"    // X-18.743Y-32.821
+    "\002\313\002\003\020\100\236\357\227\301\163\150\002\302\176\333\012"    // X-18.992Y-32.602
+    "\002\314\002\003\020\100\345\320\231\301\104\213\001\302\247\067\012"    // X-19.227Y-32.386
+    "\002\315\002\003\020\100\165\223\233\301\033\257\020\100\302\053\262\012"    // X-19.447Y-32.171
+    "\002\316\002\003\020\100\114\067\235\301\010\254\377\301\376\313\012"    // X-19.652Y-31.959
+    "\002\317\002\003\020\100\167\276\236\301\364\375\375\301\316\311\012"    // X-19.843Y-31.749
+    "\002\320\002\003\020\100\321\042\240\301\354\121\374\301\061\357\012"    // X-20.017Y-31.540
+    "\002\321\002\003\020\100\163\150\241\301\024\256\372\301\102\361\012"    // X-20.176Y-31.335
+    "\002\322\002\003\020\100\134\217\242\301\112\014\371\301\376\310\012"    // X-20.320Y-31.131
+    "\002\323\002\003\020\100\165\223\243\301\244\160\367\301\214\141\012"    // X-20.447Y-30.930
+    "\002\324\002\003\020\100\311\166\244\301\027\331\365\301\112\105\012"    // X-20.558Y-30.731
+    "\002\325\002\003\020\100\130\071\245\301\256\107\364\301\323\201\012"    // X-20.653Y-30.535
+    "\002\326\002\003\020\100\027\331\245\301\136\272\362\301\125\047\012"    // X-20.731Y-30.341
+    "\002\327\002\003\020\100\020\120\130\246\301\063\063\361\301\214\256\012"    // X-20.793Y-30.150
+    "\002\330\002\003\020\100\071\264\246\301\041\260\357\301\077\141\012"    // X-20.838Y-29.961
+    "\002\331\002\003\020\100\236\357\246\301\077\065\356\301\145\330\012"    // X-20.867Y-29.776
+    "\002\332\002\003\020\100\061\010\247\301\167\276\354\301\100\200\012"    // X-20.879Y-29.593
+    "\002\333\002\003\020\100\020\100\020\100\247\301\323\115\353\301\205\022\012"    // X-20.875Y-29.413
+    "\002\334\002\003\020\100\376\324\246\301\124\343\351\301\260\100\012"    // X-20.854Y-29.236
+    "\002\335\002\003\020\100\067\211\246\301\372\176\350\301\165\120\012"    // X-20.817Y-29.062
+    "\002\336\002\003\020\100\254\034\246\301\305\040\347\301\243\013\012"    // X-20.764Y-28.891
+    "\002\337\002\003\020\100\134\217\245\301\264\310\345\301\210\224\012"    // X-20.695Y-28.723
+    "\002\340\002\003\020\100\110\341\244\301\325\170\344\301\330\312\012"    // X-20.610Y-28.559
+    "\002\341\002\003\020\100\173\024\244\301\016\055\343\301\216\213\012"    // X-20.510Y-28.397
+    "\002\342\002\003\020\100\351\046\243\301\171\351\341\301\240\277\012"    // X-20.394Y-28.239
+    "\002\343\002\003\020\100\240\032\242\301\010\254\340\301\347\254\012"    // X-20.263Y-28.084
+    "\002\344\002\003\020\100\236\357\240\301\274\164\337\301\240\103\012"    // X-20.117Y-27.932
+    "\002\345\002\003\020\100\360\247\237\301\242\105\336\301\353\217\012"    // X-19.957Y-27.784
+    "\002\346\002\003\020\100\211\101\236\301\254\034\335\301\101\250\012"    // X-19.782Y-27.639
+    "\002\347\002\003\020\100\203\300\234\301\347\373\333\301\024\135\012"    // X-19.594Y-27.498
+    "\002\350\002\003\020\100\321\042\233\301\110\341\332\301\177\063\012"    // X-19.392Y-27.360
+    "\002\351\002\003\020\100\177\152\231\301\331\316\331\301\174\242\012"    // X-19.177Y-27.226
+    "\002\352\002\003\020\100\232\231\227\301\217\302\330\301\057\374\012"    // X-18.950Y-27.095
+    "\002\353\002\003\020\100\024\256\225\301\167\276\327\301\232\360\012"    // X-18.710Y-26.968
+    "\002\354\002\003\020\100\010\254\223\301\217\302\326\301\006\275\012"    // X-18.459Y-26.845
+    "\002\355\002\003\020\100\165\223\221\301\315\314\325\301\231\315\012"    // X-18.197Y-26.725
+    "\002\356\002\003\020\100\132\144\217\301\073\337\324\301\201\127\012"    // X-17.924Y-26.609
+    "\002\357\002\003\020\100\305\040\215\301\333\371\323\301\162\363\012"    // X-17.641Y-26.497
+    "\002\360\002\003\020\100\301\312\212\301\254\034\323\301\331\243\012"    // X-17.349Y-26.389
+    "\002\361\002\003\020\100\140\345\205\301\311\166\321\301\325\237\012"    // X-16.737Y-26.183
+    "\002\362\002\003\020\100\035\132\203\301\041\260\320\301\021\057\012"    // X-16.419Y-26.086
+    "\002\363\002\003\020\100\203\300\200\301\252\361\317\301\233\051\012"    // X-16.094Y-25.993
+    "\002\364\002\003\020\100\077\065\174\301\144\073\317\301\222\267\012"    // X-15.763Y-25.904
+    "\002\365\002\003\020\100\345\320\166\301\104\213\316\301\270\016\012"    // X-15.426Y-25.818
+    "\002\366\002\003\020\100\370\123\161\301\140\345\315\301\113\363\012"    // X-15.083Y-25.737
+    "\002\367\002\003\020\100\250\306\153\301\256\107\315\301\373\200\012"    // X-14.736Y-25.660
+    "\002\370\002\003\020\100\341\172\140\301\305\040\314\301\173\065\012"    // X-14.030Y-25.516
+    "\002\371\002\003\020\100\203\300\132\301\246\233\313\301\063\311\012"    // X-13.672Y-25.451
+    "\002\372\002\003\020\100\014\002\125\301\254\034\313\301\173\355\012"    // X-13.313Y-25.389
+    "\002\373\002\003\020\100\175\077\117\301\360\247\312\301\346\061\012"    // X-12.953Y-25.332
+    "\002\374\002\003\020\100\274\164\111\301\130\071\312\301\200\142\012"    // X-12.591Y-25.278
+    "\002\375\002\003\020\100\024\256\103\301\362\322\311\301\252\112\012"    // X-12.230Y-25.228
+    "\002\376\002\003\020\100\205\353\075\301\274\164\311\301\135\152\012"    // X-11.870Y-25.182
+    "\002\377\002\003\020\100\016\055\070\301\270\036\311\301\154\100\012"    // X-11.511Y-25.140
+    "\002\020\100\002\003\020\100\341\172\062\301\362\322\310\301\044\307\012"    // X-11.155Y-25.103
+    "\002\001\002\003\020\100\033\057\055\301\150\221\310\301\336\276\012"    // X-10.824Y-25.071
+    "\002\002\002\003\020\100\266\363\047\301\020\120\130\310\301\033\201\012"    // X-10.497Y-25.043
+    "\002\003\002\003\020\100\234\304\042\301\335\044\310\301\371\114\012"    // X-10.173Y-25.018
+    "\002\004\002\003\020\100\343\245\035\301\317\367\307\301\275\026\012"    // X-9.853Y-24.996
+    "\002\005\002\003\020\100\246\233\030\301\362\322\307\301\373\373\012"    // X-9.538Y-24.978
+    "\002\006\002\003\020\100\343\245\023\301\106\266\307\301\046\224\012"    // X-9.228Y-24.964
+    "\002\007\002\003\020\100\264\310\016\301\262\235\307\301\163\265\012"    // X-8.924Y-24.952
+    "\002\010\002\003\020\100\020\100\020\100\020\112\301\120\215\307\301\130\333\012"    // X-8.625Y-24.944
+    "\002\011\002\003\020\100\020\120\130\005\301\037\205\307\301\163\112\012"    // X-8.334Y-24.940
+    "\002\020\112\002\003\020\100\264\310\020\100\301\022\203\307\301\315\222\012"    // X-8.049Y-24.939
+    "\002\013\002\003\020\100\071\264\370\300\053\207\307\301\246\331\012"    // X-7.772Y-24.941
+    "\002\014\002\003\020\100\305\040\360\300\150\221\307\301\122\331\012"    // X-7.504Y-24.946
+    "\002\020\115\002\003\020\100\250\306\347\300\327\243\307\301\002\344\012"    // X-7.243Y-24.955
+    "\002\016\002\003\020\100\167\276\337\300\152\274\307\301\275\234\012"    // X-6.992Y-24.967
+    "\002\017\002\003\020\100\020\100\020\100\330\300\043\333\307\301\161\143\012"    // X-6.750Y-24.982
+    "\002\020\120\002\003\020\100\165\223\320\300\020\100\020\100\310\301\373\337\012"    // X-6.518Y-25.000
+    "\002\021\002\003\020\100\244\160\311\300\016\055\310\301\162\131\012"    // X-6.295Y-25.022
+    "\002\022\002\003\020\100\041\260\302\300\102\140\310\301\067\042\012"    // X-6.084Y-25.047
+    "\002\023\002\003\020\100\211\101\274\300\232\231\310\301\264\273\012"    // X-5.883Y-25.075
+    "\002\024\002\003\020\100\077\065\266\300\027\331\310\301\337\262\012"    // X-5.694Y-25.106
+    "\002\025\002\003\020\100\104\213\260\300\270\036\311\301\332\064\012"    // X-5.517Y-25.140
+    "\002\026\002\003\020\100\144\073\253\300\177\152\311\301\076\207\012"    // X-5.351Y-25.177
+    "\002\027\002\003\020\100\323\115\246\300\152\274\311\301\337\343\012"    // X-5.197Y-25.217
+    "\002\030\002\003\020\100\362\322\241\300\173\024\312\301\320\076\012"    // X-5.057Y-25.260
+    "\002\031\002\003\020\100\055\262\235\300\260\162\312\301\207\301\012"    // X-4.928Y-25.306
+    "\002\032\002\003\020\100\031\004\232\300\020\112\327\312\301\257\331\012"    // X-4.813Y-25.355
+    "\002\033\002\003\020\100\203\300\226\300\211\101\313\301\357\210\012"    // X-4.711Y-25.407
+    "\002\034\002\003\020\100\236\357\223\300\041\260\313\301\275\367\012"    // X-4.623Y-25.461
+    "\002\035\002\003\020\100\067\211\221\300\335\044\314\301\106\137\012"    // X-4.548Y-25.518
+    "\002\036\002\003\020\100\201\225\217\300\276\237\314\301\170\122\012"    // X-4.487Y-25.578
+    "\002\037\002\003\020\100\112\014\216\300\305\040\315\301\210\303\012"    // X-4.439Y-25.641
+    "\002\040\002\003\020\100\364\375\214\300\360\247\315\301\010\236\012"    // X-4.406Y-25.707
+    "\002\041\002\003\020\100\116\142\214\300\063\063\316\301\345\170\012"    // X-4.387Y-25.775
+    "\002\042\002\003\020\100\130\071\214\300\217\302\316\301\074\013\012"    // X-4.382Y-25.845
+    "\002\043\002\003\020\100\104\213\214\300\020\120\130\317\301\145\050\012"    // X-4.392Y-25.918
+    "\002\044\002\003\020\100\337\117\215\300\266\363\317\301\105\104\012"    // X-4.416Y-25.994
+    "\002\045\002\003\020\100\053\207\216\300\165\223\320\301\326\216\012"    // X-4.454Y-26.072
+    "\002\046\002\003\020\100\047\061\220\300\114\067\321\301\173\336\012"    // X-4.506Y-26.152
+    "\002\047\002\003\020\100\323\115\222\300\110\341\321\301\141\337\012"    // X-4.572Y-26.235
+    "\002\050\002\003\020\100\140\345\224\300\134\217\322\301\206\140\012"    // X-4.653Y-26.320
+    "\002\051\002\003\020\100\236\357\227\300\211\101\323\301\100\227\012"    // X-4.748Y-26.407
+    "\002\052\002\003\020\100\213\154\233\300\317\367\323\301\027\232\012"    // X-4.857Y-26.496
+    "\002\053\002\003\020\100\051\134\237\300\071\264\324\301\277\252\012"    // X-4.980Y-26.588
+    "\002\054\002\003\020\100\167\276\243\300\260\162\325\301\307\042\012"    // X-5.117Y-26.681
+    "\002\055\002\003\020\100\104\213\250\300\114\067\326\301\342\077\012"    // X-5.267Y-26.777
+    "\002\056\002\003\020\100\301\312\255\300\364\375\326\301\352\074\012"    // X-5.431Y-26.874
+    "\002\057\002\003\020\100\067\211\271\300\215\227\330\301\065\045\012"    // X-5.798Y-27.074
+    "\002\060\002\003\020\100\061\010\300\300\177\152\331\301\274\177\012"    // X-6.001Y-27.177
+    "\002\061\002\003\020\100\171\351\306\300\211\101\332\301\020\120\042\012"    // X-6.216Y-27.282
+    "\002\062\002\003\020\100\043\333\325\300\317\367\333\301\366\246\012"    // X-6.683Y-27.496
+    "\002\063\002\003\020\100\366\050\370\300\067\211\337\301\312\102\012"    // X-7.755Y-27.942
+    "\002\064\002\003\020\100\264\310\020\100\301\274\164\340\301\064\152\012"    // X-8.049Y-28.057
+    "\002\065\002\003\020\100\343\245\005\301\116\142\341\301\373\317\012"    // X-8.353Y-28.173
+    "\002\066\002\003\020\100\020\112\327\017\301\242\105\343\301\070\057\012"    // X-8.990Y-28.409
+    "\002\067\002\003\020\100\301\312\045\301\305\040\347\301\150\053\012"    // X-10.362Y-28.891
+    "\002\070\002\003\020\100\112\014\054\301\047\061\350\301\230\201\012"    // X-10.753Y-29.024
+    "\002\071\002\003\020\100\177\152\062\301\226\103\351\301\253\006\012"    // X-11.151Y-29.158
+    "\002\072\002\003\020\100\356\174\077\301\213\154\353\301\173\262\012"    // X-11.968Y-29.428
+    "\002\073\002\003\020\100\053\207\132\301\264\310\357\301\320\337\012"    // X-13.658Y-29.973
+    "\002\074\002\003\020\100\155\347\210\301\067\211\370\301\363\313\012"    // X-17.113Y-31.067
+    "\002\075\002\003\020\100\323\115\214\301\262\235\371\301\305\020\120\012"    // X-17.538Y-31.202
+    "\002\076\002\003\020\100\010\254\217\301\055\262\372\301\247\166\012"    // X-17.959Y-31.337
+    "\002\077\002\003\020\100\323\115\226\301\376\324\374\301\316\327\012"    // X-18.788Y-31.604
+    "\002\100\002\003\020\100\303\365\242\301\014\202\020\100\302\131\315\012"    // X-20.370Y-32.127
+    "\002\101\002\003\020\100\317\367\245\301\037\005\001\302\271\172\012"    // X-20.746Y-32.255
+    "\002\102\002\003\020\100\155\347\250\301\053\207\001\302\163\274\012"    // X-21.113Y-32.382
+    "\002\103\002\003\020\100\067\211\256\301\045\206\002\302\124\051\012"    // X-21.817Y-32.631
+    "\002\104\002\003\020\100\167\276\270\301\252\161\004\302\321\305\012"    // X-23.093Y-33.111
+    "\002\105\002\003\020\100\112\014\273\301\155\347\004\302\173\242\012"    // X-23.381Y-33.226
+    "\002\106\002\003\020\100\175\077\275\301\043\133\005\302\247\136\012"    // X-23.656Y-33.339
+    "\002\107\002\003\020\100\337\117\301\301\161\075\006\302\110\172\012"    // X-24.164Y-33.560
+    "\002\110\002\003\020\100\016\055\303\301\002\253\006\302\024\123\012"    // X-24.397Y-33.667
+    "\002\111\002\003\020\100\205\353\304\301\207\026\007\302\334\212\012"    // X-24.615Y-33.772
+    "\002\112\002\003\020\100\075\020\112\310\301\140\345\007\302\140\356\012"    // X-25.005Y-33.974
+    "\002\113\002\003\020\100\177\152\311\301\272\111\010\302\262\172\012"    // X-25.177Y-34.072
+    "\002\114\002\003\020\100\360\247\312\301\002\253\010\302\006\276\012"    // X-25.332Y-34.167
+    "\002\115\002\003\020\100\250\306\313\301\067\011\011\302\167\126\012"    // X-25.472Y-34.259
+    "\002\116\002\003\020\100\217\302\314\301\140\145\011\302\003\054\012"    // X-25.595Y-34.349
+    "\002\117\002\003\020\100\246\233\315\301\167\276\011\302\003\126\012"    // X-25.701Y-34.436
+    "\002\120\002\003\020\100\370\123\316\301\173\024\020\112\302\241\154\012"    // X-25.791Y-34.520
+    "\002\121\002\003\020\100\171\351\316\301\155\147\020\112\302\332\151\012"    // X-25.864Y-34.601
+    "\002\122\002\003\020\100\051\134\317\301\114\267\020\112\302\074\115\012"    // X-25.920Y-34.679
+    "\002\123\002\003\020\100\024\256\317\301\031\004\013\302\152\114\012"    // X-25.960Y-34.754
+    "\002\124\002\003\020\100\043\333\317\301\323\115\013\302\020\120\140\012"    // X-25.982Y-34.826
+    "\002\125\002\003\020\100\140\345\317\301\173\224\013\302\165\242\012"    // X-25.987Y-34.895
+    "\002\126\002\003\020\100\331\316\317\301\020\120\330\013\302\146\117\012"    // X-25.976Y-34.961
+    "\002\127\002\003\020\100\201\225\317\301\215\027\014\302\135\124\012"    // X-25.948Y-35.023
+    "\002\130\002\003\020\100\130\071\317\301\370\123\014\302\153\200\012"    // X-25.903Y-35.082
+    "\002\131\002\003\020\100\136\272\316\301\120\215\014\302\056\044\012"    // X-25.841Y-35.138
+    "\002\132\002\003\020\100\240\032\316\301\217\302\014\302\123\172\012"    // X-25.763Y-35.190
+    "\002\133\002\003\020\100\035\132\315\301\274\364\014\302\043\107\012"    // X-25.669Y-35.239
+    "\002\134\002\003\020\100\325\170\314\301\321\042\020\115\302\007\225\012"    // X-25.559Y-35.284
+    "\002\135\002\003\020\100\311\166\313\301\315\114\020\115\302\107\224\012"    // X-25.433Y-35.325
+    "\002\136\002\003\020\100\370\123\312\301\266\163\020\115\302\330\167\012"    // X-25.291Y-35.363
+    "\002\137\002\003\020\100\157\022\311\301\207\226\020\115\302\161\311\012"    // X-25.134Y-35.397
+    "\002\140\002\003\020\100\071\264\307\301\106\266\020\115\302\222\157\012"    // X-24.963Y-35.428
+    "\002\141\002\003\020\100\114\067\306\301\354\321\020\115\302\250\076\012"    // X-24.777Y-35.455
+    "\002\142\002\003\020\100\262\235\304\301\163\350\020\115\302\357\034\012"    // X-24.577Y-35.477
+    "\002\143\002\003\020\100\236\357\302\301\347\373\020\115\302\173\020\112\012"    // X-24.367Y-35.496
+    "\002\144\002\003\020\100\351\046\301\301\104\013\016\302\266\041\012"    // X-24.144Y-35.511
+    "\002\145\002\003\020\100\242\105\277\301\207\026\016\302\121\205\012"    // X-23.909Y-35.522
+    "\002\146\002\003\020\100\272\111\275\301\262\035\016\302\326\032\012"    // X-23.661Y-35.529
+    "\002\147\002\003\020\100\130\071\273\301\305\040\016\302\020\120\173\012"    // X-23.403Y-35.532
+    "\002\150\002\003\020\100\142\020\120\271\301\305\040\016\302\051\161\012"    // X-23.133Y-35.532
+    "\002\151\002\003\020\100\362\322\266\301\246\033\016\302\306\226\012"    // X-22.853Y-35.527
+    "\002\152\002\003\020\100\006\201\264\301\165\023\016\302\222\362\012"    // X-22.563Y-35.519
+    "\002\153\002\003\020\100\240\032\262\301\045\006\016\302\041\160\012"    // X-22.263Y-35.506
+    "\002\154\002\003\020\100\327\243\257\301\303\365\020\115\302\043\316\012"    // X-21.955Y-35.490
+    "\002\155\002\003\020\100\240\032\255\301\110\341\020\115\302\076\264\012"    // X-21.638Y-35.470
+    "\002\156\002\003\020\100\006\201\252\301\256\307\020\115\302\172\077\012"    // X-21.313Y-35.445
+    "\002\157\002\003\020\100\027\331\247\301\374\251\020\115\302\050\151\012"    // X-20.981Y-35.416
+    "\002\160\002\003\020\100\335\044\245\301\067\211\020\115\302\031\262\012"    // X-20.643Y-35.384
+    "\002\161\002\003\020\100\132\144\242\301\124\143\020\115\302\246\073\012"    // X-20.299Y-35.347
+    "\002\162\002\003\020\100\215\227\237\301\130\071\020\115\302\054\217\012"    // X-19.949Y-35.306
+    "\002\163\002\003\020\100\217\302\234\301\104\013\020\115\302\177\241\012"    // X-19.595Y-35.261
+    "\002\164\002\003\020\100\140\345\231\301\027\331\014\302\136\342\012"    // X-19.237Y-35.212
+    "\002\165\002\003\020\100\020\100\020\100\227\301\313\241\014\302\354\033\012"    // X-18.875Y-35.158
+    "\002\166\002\003\020\100\207\026\224\301\155\147\014\302\354\045\012"    // X-18.511Y-35.101
+    "\002\167\002\003\020\100\366\050\221\301\360\047\014\302\366\033\012"    // X-18.145Y-35.039
+    "\002\170\002\003\020\100\114\067\216\301\132\344\013\302\314\044\012"    // X-17.777Y-34.973
+    "\002\171\002\003\020\100\370\123\210\301\345\120\013\302\264\153\012"    // X-17.041Y-34.829
+    "\002\172\002\003\020\100\116\142\205\301\006\001\013\302\332\214\012"    // X-16.673Y-34.751
+    "\002\173\002\003\020\100\260\162\202\301\010\254\020\112\302\257\315\012"    // X-16.306Y-34.668
+    "\002\174\002\003\020\100\256\107\171\301\311\366\011\302\071\035\012"    // X-15.580Y-34.491
+    "\002\175\002\003\020\100\120\215\163\301\201\225\011\302\355\347\012"    // X-15.222Y-34.396
+    "\002\176\002\003\020\100\073\337\155\301\041\060\011\302\054\025\012"    // X-14.867Y-34.297
+    "\002\177\002\003\020\100\203\300\142\301\020\120\130\010\302\351\220\012"    // X-14.172Y-34.086
+    "\002\200\002\003\020\100\370\123\135\301\146\346\007\302\033\365\012"    // X-13.833Y-33.975
+    "\002\201\002\003\020\100\031\004\130\301\236\157\007\302\023\316\012"    // X-13.501Y-33.859
+    "\002\202\002\003\020\100\345\320\122\301\303\365\006\302\150\121\012"    // X-13.176Y-33.740
+    "\002\203\002\003\020\100\136\272\115\301\311\166\006\302\235\252\012"    // X-12.858Y-33.616
+    "\002\204\002\003\020\100\234\304\110\301\266\363\005\302\253\300\012"    // X-12.548Y-33.488
+    "\002\205\002\003\020\100\317\367\103\301\221\155\005\302\071\207\012"    // X-12.248Y-33.357
+    "\002\206\002\003\020\100\315\314\072\301\370\123\004\302\354\125\012"    // X-11.675Y-33.082
+    "\002\207\002\003\020\100\311\166\066\301\203\300\003\302\271\267\012"    // X-11.404Y-32.938
+    "\002\210\002\003\020\100\323\115\062\301\374\051\003\302\252\264\012"    // X-11.144Y-32.791
+    "\002\211\002\003\020\100\004\126\056\301\126\216\002\302\361\242\012"    // X-10.896Y-32.639
+    "\002\212\002\003\020\100\104\213\052\301\236\357\001\302\024\063\012"    // X-10.659Y-32.484
+    "\002\213\002\003\020\100\303\365\046\301\323\115\001\302\024\063\012"    // X-10.435Y-32.326
+    "\002\214\002\003\020\100\150\221\043\301\351\246\020\100\302\167\175\012"    // X-10.223Y-32.163
+    "\002\215\002\003\020\100\146\146\040\301\333\371\377\301\315\230\012"    // X-10.025Y-31.997
+    "\002\216\002\003\020\100\244\160\035\301\262\235\376\301\013\060\012"    // X-9.840Y-31.827
+    "\002\217\002\003\020\100\071\264\032\301\130\071\375\301\363\002\012"    // X-9.669Y-31.653
+    "\002\220\002\003\020\100\047\061\030\301\331\316\373\301\023\273\012"    // X-9.512Y-31.476
+    "\002\221\002\003\020\100\205\353\025\301\051\134\372\301\157\367\012"    // X-9.370Y-31.295
+    "\002\222\002\003\020\100\073\337\023\301\124\343\370\301\111\020\115\012"    // X-9.242Y-31.111
+    "\002\223\002\003\020\100\173\024\022\301\116\142\367\301\056\357\012"    // X-9.130Y-30.923
+    "\002\224\002\003\020\100\053\207\020\120\301\043\333\365\301\031\205\012"    // X-9.033Y-30.732
+    "\002\225\002\003\020\100\114\067\017\301\323\115\364\301\332\207\012"    // X-8.951Y-30.538
+    "\002\226\002\003\020\100\366\050\016\301\122\270\362\301\336\131\012"    // X-8.885Y-30.340
+    "\002\227\002\003\020\100\051\134\020\115\301\254\034\361\301\323\067\012"    // X-8.835Y-30.139
+    "\002\230\002\003\020\100\345\320\014\301\325\170\357\301\061\124\012"    // X-8.801Y-29.934
+    "\002\231\002\003\020\100\022\203\014\301\345\320\355\301\162\261\012"    // X-8.782Y-29.727
+    "\002\232\002\003\020\100\341\172\014\301\321\042\354\301\132\155\012"    // X-8.780Y-29.517
+    "\002\233\002\003\020\100\071\264\014\301\213\154\352\301\027\263\012"    // X-8.794Y-29.303
+    "\002\234\002\003\020\100\063\063\020\115\301\055\262\350\301\045\010\012"    // X-8.825Y-29.087
+    "\002\235\002\003\020\100\236\357\020\115\301\236\357\346\301\105\235\012"    // X-8.871Y-28.867
+    "\002\236\002\003\020\100\252\361\016\301\366\050\345\301\135\060\012"    // X-8.934Y-28.645
+    "\002\237\002\003\020\100\223\030\020\120\301\341\172\343\301\167\125\012"    // X-9.006Y-28.435
+    "\002\240\002\003\020\100\356\174\021\301\264\310\341\301\363\361\012"    // X-9.093Y-28.223
+    "\002\241\002\003\020\100\240\032\023\301\142\020\120\340\301\246\163\012"    // X-9.194Y-28.008
+    "\002\242\002\003\020\100\221\355\024\301\004\126\336\301\167\176\012"    // X-9.308Y-27.792
+    "\002\243\002\003\020\100\303\365\026\301\201\225\334\301\356\156\012"    // X-9.435Y-27.573
+    "\002\244\002\003\020\100\144\073\031\301\345\320\332\301\022\151\012"    // X-9.577Y-27.352
+    "\002\245\002\003\020\100\065\136\036\301\130\071\327\301\207\144\012"    // X-9.898Y-26.903
+    "\002\246\002\003\020\100\175\077\041\301\163\150\325\301\053\116\012"    // X-10.078Y-26.676
+    "\002\247\002\003\020\100\004\126\044\301\150\221\323\301\121\255\012"    // X-10.271Y-26.446
+    "\002\250\002\003\020\100\207\026\053\301\043\333\317\301\130\177\012"    // X-10.693Y-25.982
+    "\002\251\002\003\020\100\203\300\056\301\347\373\315\301\373\111\012"    // X-10.922Y-25.748
+    "\002\252\002\003\020\100\215\227\062\301\207\026\314\301\102\270\012"    // X-11.162Y-25.511
+    "\002\253\002\003\020\100\315\314\072\301\242\105\310\301\114\241\012"    // X-11.675Y-25.034
+    "\002\254\002\003\020\100\002\053\077\301\020\120\130\306\301\266\007\012"    // X-11.948Y-24.793
+    "\002\255\002\003\020\100\024\256\103\301\146\146\304\301\267\370\012"    // X-12.230Y-24.550
+    "\002\256\002\003\020\100\033\057\115\301\356\174\300\301\114\247\012"    // X-12.824Y-24.061
+    "\002\257\002\003\020\100\362\322\141\301\104\213\270\301\237\023\012"    // X-14.114Y-23.068
+    "\002\260\002\003\020\100\020\100\020\100\210\301\323\115\250\301\306\027\012"    // X-17.000Y-21.038
+    "\002\261\002\003\020\100\075\020\112\213\301\211\101\246\301\133\162\012"    // X-17.380Y-20.782
+    "\002\262\002\003\020\100\223\030\216\301\063\063\244\301\325\062\012"    // X-17.762Y-20.525
+    "\002\263\002\003\020\100\211\101\224\301\173\024\240\301\170\344\012"    // X-18.532Y-20.010
+    "\002\264\002\003\020\100\262\235\240\301\376\324\227\301\340\235\012"    // X-20.077Y-18.979
+    "\002\265\002\003\020\100\055\262\243\301\234\304\225\301\046\074\012"    // X-20.462Y-18.721
+    "\002\266\002\003\020\100\217\302\246\301\106\266\223\301\360\053\012"    // X-20.845Y-18.464
+    "\002\267\002\003\020\100\345\320\254\301\215\227\217\301\210\277\012"    // X-21.602Y-17.949
+    "\002\270\002\003\020\100\165\223\270\301\146\146\207\301\053\262\012"    // X-23.072Y-16.925
+    "\002\271\002\003\020\100\177\152\273\301\065\136\205\301\027\016\012"    // X-23.427Y-16.671
+    "\002\272\002\003\020\100\077\065\276\301\004\126\203\301\175\207\012"    // X-23.776Y-16.417
+    "\002\273\002\003\020\100\313\241\303\301\165\223\176\301\050\014\012"    // X-24.454Y-15.911
+    "\002\274\002\003\020\100\152\274\315\301\165\223\156\301\370\233\012"    // X-25.717Y-14.911
+    "\002\275\002\003\020\100\207\026\320\301\276\237\152\301\110\310\012"    // X-26.011Y-14.664
+    "\002\276\002\003\020\100\051\134\322\301\041\260\146\301\046\215\012"    // X-26.295Y-14.418
+    "\002\277\002\003\020\100\374\251\326\301\110\341\136\301\361\357\012"    // X-26.833Y-13.930
+    "\002\300\002\003\020\100\041\260\330\301\014\002\133\301\316\046\012"    // X-27.086Y-13.688
+    "\002\301\002\003\020\100\276\237\332\301\351\046\127\301\327\164\012"    // X-27.328Y-13.447
+    "\002\302\002\003\020\100\114\067\336\301\067\211\117\301\116\362\012"    // X-27.777Y-12.971
+    "\002\303\002\003\020\100\020\100\020\100\340\301\244\160\113\301\376\025\012"    // X-28.000Y-12.715
+    "\002\304\002\003\020\100\010\254\341\301\102\140\107\301\326\164\012"    // X-28.209Y-12.461
+    "\002\305\002\003\020\100\144\073\343\301\051\134\103\301\347\336\012"    // X-28.404Y-12.210
+    "\002\306\002\003\020\100\374\251\344\301\102\140\077\301\212\213\012"    // X-28.583Y-11.961
+    "\002\307\002\003\020\100\317\367\345\301\163\150\073\301\321\244\012"    // X-28.746Y-11.713
+    "\002\310\002\003\020\100\351\046\347\301\006\201\067\301\043\273\012"    // X-28.894Y-11.469
+    "\002\311\002\003\020\100\077\065\350\301\262\235\063\301\144\345\012"    // X-29.026Y-11.226
+    "\002\312\002\003\020\100\321\042\351\301\250\306\057\301\141\376\012"    // X-29.142Y-10.986
+    "\002\313\002\003\020\100\236\357\351\301\347\373\053\301\133\277\012"    // X-29.242Y-10.749
+    "\002\314\002\003\020\100\232\231\352\301\130\071\050\301\042\153\012"    // X-29.325Y-10.514
+    "\002\315\002\003\020\100\305\040\353\301\372\176\044\301\247\074\012"    // X-29.391Y-10.281
+    "\002\316\002\003\020\100\053\207\353\301\376\324\040\301\063\167\012"    // X-29.441Y-10.052
+    "\002\317\002\003\020\100\315\314\353\301\063\063\035\301\075\316\012"    // X-29.475Y-9.825
+    "\002\320\002\003\020\100\221\355\353\301\262\235\031\301\037\047\012"    // X-29.491Y-9.601
+    "\002\321\002\003\020\100\221\355\353\301\173\024\026\301\114\321\012"    // X-29.491Y-9.380
+    "\002\322\002\003\020\100\315\314\353\301\215\227\022\301\215\316\012"    // X-29.475Y-9.162
+    "\002\323\002\003\020\100\053\207\353\301\351\046\017\301\020\112\204\012"    // X-29.441Y-8.947
+    "\002\324\002\003\020\100\305\040\353\301\217\302\013\301\134\160\012"    // X-29.391Y-8.735
+    "\002\325\002\003\020\100\232\231\352\301\177\152\010\301\264\043\012"    // X-29.325Y-8.526
+    "\002\326\002\003\020\100\236\357\351\301\270\036\005\301\377\122\012"    // X-29.242Y-8.320
+    "\002\327\002\003\020\100\351\046\351\301\124\343\001\301\130\335\012"    // X-29.144Y-8.118
+    "\002\330\002\003\020\100\144\073\350\301\163\150\375\300\312\026\012"    // X-29.029Y-7.919
+    "\002\331\002\003\020\100\047\061\347\301\321\042\367\300\356\057\012"    // X-28.899Y-7.723
+    "\002\332\002\003\020\100\045\006\346\301\364\375\360\300\207\373\012"    // X-28.753Y-7.531
+    "\002\333\002\003\020\100\152\274\344\301\252\361\352\300\042\023\012"    // X-28.592Y-7.342
+    "\002\334\002\003\020\100\370\123\343\301\364\375\344\300\276\217\012"    // X-28.416Y-7.156
+    "\002\335\002\003\020\100\331\316\341\301\002\053\337\300\067\373\012"    // X-28.226Y-6.974
+    "\002\336\002\003\020\100\016\055\340\301\325\170\331\300\202\336\012"    // X-28.022Y-6.796
+    "\002\337\002\003\020\100\230\156\336\301\073\337\323\300\077\306\012"    // X-27.804Y-6.621
+    "\002\340\002\003\020\100\165\223\334\301\146\146\316\300\137\275\012"    // X-27.572Y-6.450
+    "\002\341\002\003\020\100\150\221\330\301\331\316\303\300\346\364\012"    // X-27.071Y-6.119
+    "\002\342\002\003\020\100\177\152\326\301\041\260\276\300\103\110\012"    // X-26.802Y-5.959
+    "\002\343\002\003\020\100\016\055\324\301\055\262\271\300\304\113\012"    // X-26.522Y-5.803
+    "\002\344\002\003\020\100\230\156\317\301\142\020\120\260\300\057\014\012"    // X-25.929Y-5.502
+    "\002\345\002\003\020\100\236\357\314\301\274\164\253\300\222\300\012"    // X-25.617Y-5.358
+    "\002\346\002\003\020\100\065\136\312\301\252\361\246\300\167\310\012"    // X-25.296Y-5.217
+    "\002\347\002\003\020\100\045\006\305\301\004\126\236\300\223\266\012"    // X-24.628Y-4.948
+    "\002\350\002\003\020\100\226\103\302\301\077\065\232\300\133\206\012"    // X-24.283Y-4.819
+    "\002\351\002\003\020\100\244\160\277\301\077\065\226\300\351\203\012"    // X-23.930Y-4.694
+    "\002\352\002\003\020\100\360\247\271\301\276\237\216\300\277\314\012"    // X-23.207Y-4.457
+    "\002\353\002\003\020\100\071\264\266\301\014\002\213\300\114\156\012"    // X-22.838Y-4.344
+    "\002\354\002\003\020\100\122\270\263\301\120\215\207\300\165\104\012"    // X-22.465Y-4.236
+    "\002\355\002\003\020\100\360\247\255\301\364\375\200\300\342\010\012"    // X-21.707Y-4.031
+    "\002\356\002\003\020\100\232\231\252\301\020\112\327\173\300\326\001\012"    // X-21.325Y-3.935
+    "\002\357\002\003\020\100\053\207\247\301\124\343\165\300\226\130\012"    // X-20.941Y-3.842
+    "\002\360\002\003\020\100\051\134\241\301\110\341\152\300\233\135\012"    // X-20.170Y-3.670
+    "\002\361\002\003\020\100\272\111\236\301\217\302\145\300\334\337\012"    // X-19.786Y-3.590
+    "\002\362\002\003\020\100\114\067\233\301\303\365\140\300\203\174\012"    // X-19.402Y-3.515
+    "\002\363\002\003\020\100\321\042\225\301\020\100\020\100\130\300\076\213\012"    // X-18.642Y-3.375
+    "\002\364\002\003\020\100\305\040\222\301\317\367\123\300\174\304\012"    // X-18.266Y-3.312
+    "\002\365\002\003\020\100\351\046\217\301\305\040\120\300\310\205\012"    // X-17.894Y-3.252
+    "\002\366\002\003\020\100\114\067\214\301\246\233\114\300\344\205\012"    // X-17.527Y-3.197
+    "\002\367\002\003\020\100\337\117\211\301\256\107\111\300\337\260\012"    // X-17.164Y-3.145
+    "\002\370\002\003\020\100\311\166\206\301\242\105\106\300\155\230\012"    // X-16.808Y-3.098
+    "\002\371\002\003\020\100\010\254\203\301\037\205\103\300\356\067\012"    // X-16.459Y-3.055
+    "\002\372\002\003\020\100\221\355\200\301\303\365\100\300\112\152\012"    // X-16.116Y-3.015
+    "\002\373\002\003\020\100\372\176\174\301\122\270\076\300\366\050\012"    // X-15.781Y-2.980
+    "\002\374\002\003\020\100\313\241\167\301\057\335\074\300\235\104\012"    // X-15.477Y-2.951
+    "\002\375\002\003\020\100\057\335\162\301\063\063\073\300\205\333\012"    // X-15.179Y-2.925
+    "\002\376\002\003\020\100\211\101\156\301\136\272\071\300\113\244\012"    // X-14.891Y-2.902
+    "\002\377\002\003\020\100\250\306\151\301\022\203\070\300\322\250\012"    // X-14.611Y-2.883
+    "\002\020\100\002\003\020\100\244\160\145\301\356\174\067\300\007\323\012"    // X-14.340Y-2.867
+    "\002\001\002\003\020\100\175\077\141\301\122\270\066\300\337\231\012"    // X-14.078Y-2.855
+    "\002\002\002\003\020\100\144\073\135\301\173\024\066\300\220\021\012"    // X-13.827Y-2.845
+    "\002\003\002\003\020\100\102\140\131\301\055\262\065\300\222\106\012"    // X-13.586Y-2.839
+    "\002\004\002\003\020\100\024\256\125\301\150\221\065\300\107\107\012"    // X-13.355Y-2.837
+    "\002\005\002\003\020\100\016\055\122\301\150\221\065\300\300\123\012"    // X-13.136Y-2.837
+    "\002\006\002\003\020\100\057\335\116\301\362\322\065\300\322\276\012"    // X-12.929Y-2.841
+    "\002\007\002\003\020\100\136\272\113\301\242\105\066\300\346\176\012"    // X-12.733Y-2.848
+    "\002\010\002\003\020\100\264\310\110\301\171\351\066\300\303\330\012"    // X-12.549Y-2.858
+    "\002\011\002\003\020\100\112\014\106\301\167\276\067\300\157\165\012"    // X-12.378Y-2.871
+    "\002\020\112\002\003\020\100\037\205\103\301\376\324\070\300\305\122\012"    // X-12.220Y-2.888
+    "\002\013\002\003\020\100\033\057\101\301\112\014\072\300\253\162\012"    // X-12.074Y-2.907
+    "\002\014\002\003\020\100\157\022\077\301\274\164\073\300\165\111\012"    // X-11.942Y-2.929
+    "\002\020\115\002\003\020\100\002\053\075\301\270\036\075\300\040\124\012"    // X-11.823Y-2.955
+    "\002\016\002\003\020\100\325\170\073\301\171\351\076\300\067\351\012"    // X-11.717Y-2.983
+    "\002\017\002\003\020\100\031\004\072\301\140\345\100\300\351\325\012"    // X-11.626Y-3.014
+    "\002\020\120\002\003\020\100\234\304\070\301\157\022\103\300\117\136\012"    // X-11.548Y-3.048
+    "\002\021\002\003\020\100\167\276\067\301\102\140\105\300\206\133\012"    // X-11.484Y-3.084
+    "\002\022\002\003\020\100\303\365\066\301\236\357\107\300\162\257\012"    // X-11.435Y-3.124
+    "\002\023\002\003\020\100\146\146\066\301\276\237\112\300\112\277\012"    // X-11.400Y-3.166
+    "\002\024\002\003\020\100\142\020\120\066\301\244\160\115\300\263\373\012"    // X-11.379Y-3.210
+    "\002\025\002\003\020\100\266\363\065\301\022\203\120\300\252\326\012"    // X-11.372Y-3.258
+    "\002\026\002\003\020\100\173\024\066\301\106\266\123\300\213\205\012"    // X-11.380Y-3.308
+    "\002\027\002\003\020\100\260\162\066\301\075\020\112\127\300\017\122\012"    // X-11.403Y-3.360
+    "\002\030\002\003\020\100\075\020\112\067\301\134\217\132\300\365\061\012"    // X-11.440Y-3.415
+    "\002\031\002\003\020\100\043\333\067\301\077\065\136\300\336\137\012"    // X-11.491Y-3.472
+    "\002\032\002\003\020\100\140\345\070\301\112\014\142\300\036\057\012"    // X-11.556Y-3.532
+    "\002\033\002\003\020\100\016\055\072\301\031\004\146\300\270\332\012"    // X-11.636Y-3.594
+    "\002\034\002\003\020\100\374\251\073\301\254\034\152\300\174\335\012"    // X-11.729Y-3.658
+    "\002\035\002\003\020\100\132\144\075\301\004\126\156\300\310\260\012"    // X-11.837Y-3.724
+    "\002\036\002\003\020\100\020\120\130\077\301\203\300\162\300\317\122\012"    // X-11.959Y-3.793
+    "\002\037\002\003\020\100\006\201\101\301\144\073\167\300\311\172\012"    // X-12.094Y-3.863
+    "\002\040\002\003\020\100\073\337\103\301\155\347\173\300\322\325\012"    // X-12.242Y-3.936
+    "\002\041\002\003\020\100\311\166\106\301\354\121\200\300\246\221\012"    // X-12.404Y-4.010
+    "\002\042\002\003\020\100\242\105\114\301\256\107\205\300\341\105\012"    // X-12.767Y-4.165
+    "\002\043\002\003\020\100\325\170\117\301\020\112\327\207\300\073\162\012"    // X-12.967Y-4.245
+    "\002\044\002\003\020\100\057\335\122\301\311\166\212\300\146\232\012"    // X-13.179Y-4.327
+    "\002\045\002\003\020\100\130\071\132\301\020\112\327\217\300\101\147\012"    // X-13.639Y-4.495
+    "\002\046\002\003\020\100\126\016\153\301\063\063\233\300\362\272\012"    // X-14.691Y-4.850
+    "\002\047\002\003\020\100\374\251\157\301\335\044\236\300\116\153\012"    // X-14.979Y-4.942
+    "\002\050\002\003\020\100\230\156\164\301\351\046\241\300\334\321\012"    // X-15.277Y-5.036
+    "\002\051\002\003\020\100\035\132\176\301\063\063\247\300\102\273\012"    // X-15.897Y-5.225
+    "\002\052\002\003\020\100\020\112\327\211\301\167\276\263\300\256\116\012"    // X-17.230Y-5.617
+    "\002\053\002\003\020\100\002\053\241\301\301\312\315\300\156\357\012"    // X-20.146Y-6.431
+    "\002\054\002\003\020\100\305\040\244\301\045\006\321\300\321\170\012"    // X-20.516Y-6.532
+    "\002\055\002\003\020\100\223\030\247\301\272\111\324\300\323\350\012"    // X-20.887Y-6.634
+    "\002\056\002\003\020\100\075\020\112\255\301\264\310\332\300\021\251\012"    // X-21.630Y-6.837
+    "\002\057\002\003\020\100\027\331\270\301\106\266\347\300\374\102\012"    // X-23.106Y-7.241
+    "\002\060\002\003\020\100\366\050\317\301\260\162\020\100\301\146\220\012"    // X-25.895Y-8.028
+    "\002\061\002\003\020\100\167\276\321\301\317\367\001\301\301\373\012"    // X-26.218Y-8.123
+    "\002\062\002\003\020\100\256\107\324\301\356\174\003\301\324\072\012"    // X-26.535Y-8.218
+    "\002\063\002\003\020\100\366\050\331\301\260\162\006\301\072\250\012"    // X-27.145Y-8.403
+    "\002\064\002\003\020\100\173\024\342\301\366\050\014\301\235\323\012"    // X-28.260Y-8.760
+    "\002\065\002\003\020\100\254\034\344\301\067\211\020\115\301\324\103\012"    // X-28.514Y-8.846
+    "\002\066\002\003\020\100\157\022\346\301\110\341\016\301\245\315\012"    // X-28.759Y-8.930
+    "\002\067\002\003\020\100\106\266\351\301\037\205\021\301\213\135\012"    // X-29.214Y-9.095
+    "\002\070\002\003\020\100\146\146\353\301\315\314\022\301\052\154\012"    // X-29.425Y-9.175
+    "\002\071\002\003\020\100\364\375\354\301\112\014\024\301\144\077\012"    // X-29.624Y-9.253
+    "\002\072\002\003\020\100\124\343\357\301\311\166\026\301\116\110\012"    // X-29.986Y-9.404
+    "\002\073\002\003\020\100\047\061\361\301\313\241\027\301\265\266\012"    // X-30.149Y-9.477
+    "\002\074\002\003\020\100\116\142\362\301\234\304\030\301\011\322\012"    // X-30.298Y-9.548
+    "\002\075\002\003\020\100\341\172\363\301\073\337\031\301\331\124\012"    // X-30.435Y-9.617
+    "\002\076\002\003\020\100\325\170\364\301\252\361\032\301\352\310\012"    // X-30.559Y-9.684
+    "\002\077\002\003\020\100\035\132\365\301\347\373\033\301\113\066\012"    // X-30.669Y-9.749
+    "\002\100\002\003\020\100\305\040\366\301\364\375\034\301\244\233\012"    // X-30.766Y-9.812
+    "\002\101\002\003\020\100\301\312\366\301\266\363\035\301\325\327\012"    // X-30.849Y-9.872
+    "\002\102\002\003\020\100\020\120\130\367\301\140\345\036\301\267\061\012"    // X-30.918Y-9.931
+    "\002\103\002\003\020\100\301\312\367\301\301\312\037\301\221\272\012"    // X-30.974Y-9.987
+    "\002\104\002\003\020\100\305\040\370\301\360\247\040\301\325\005\012"    // X-31.016Y-10.041
+    "\002\105\002\003\020\100\020\120\130\370\301\325\170\041\301\250\236\012"    // X-31.043Y-10.092
+    "\002\106\002\003\020\100\274\164\370\301\211\101\042\301\232\004\012"    // X-31.057Y-10.141
+    "\002\107\002\003\020\100\274\164\370\301\014\002\043\301\136\021\012"    // X-31.057Y-10.188
+    "\002\110\002\003\020\100\020\120\130\370\301\106\266\043\301\166\215\012"    // X-31.043Y-10.232
+    "\002\111\002\003\020\100\270\036\370\301\065\136\044\301\127\043\012"    // X-31.015Y-10.273
+    "\002\112\002\003\020\100\250\306\367\301\364\375\044\301\140\055\012"    // X-30.972Y-10.312
+    "\002\113\002\003\020\100\370\123\367\301\201\225\045\301\237\377\012"    // X-30.916Y-10.349
+    "\002\114\002\003\020\100\250\306\366\301\254\034\046\301\145\142\012"    // X-30.847Y-10.382
+    "\002\115\002\003\020\100\240\032\366\301\246\233\046\301\256\272\012"    // X-30.763Y-10.413
+    "\002\116\002\003\020\100\370\123\365\301\126\016\047\301\372\155\012"    // X-30.666Y-10.441
+    "\002\117\002\003\020\100\260\162\364\301\274\164\047\301\072\346\012"    // X-30.556Y-10.466
+    "\002\120\002\003\020\100\274\164\363\301\362\322\047\301\240\171\012"    // X-30.432Y-10.489
+    "\002\121\002\003\020\100\051\134\362\301\305\040\050\301\155\252\012"    // X-30.295Y-10.508
+    "\002\122\002\003\020\100\002\053\361\301\146\146\050\301\127\217\012"    // X-30.146Y-10.525
+    "\002\123\002\003\020\100\073\337\357\301\276\237\050\301\215\267\012"    // X-29.984Y-10.539
+    "\002\124\002\003\020\100\325\170\356\301\264\310\050\301\360\173\012"    // X-29.809Y-10.549
+    "\002\125\002\003\020\100\333\371\354\301\171\351\050\301\230\105\012"    // X-29.622Y-10.557
+    "\002\126\002\003\020\100\132\144\353\301\364\375\050\301\201\077\012"    // X-29.424Y-10.562
+    "\002\127\002\003\020\100\106\266\351\301\014\002\051\301\346\134\012"    // X-29.214Y-10.563
+    "\002\130\002\003\020\100\236\357\347\301\364\375\050\301\036\300\012"    // X-28.992Y-10.562
+    "\002\131\002\003\020\100\173\024\346\301\171\351\050\301\346\241\012"    // X-28.760Y-10.557
+    "\002\132\002\003\020\100\321\042\344\301\264\310\050\301\320\373\012"    // X-28.517Y-10.549
+    "\002\133\002\003\020\100\236\357\341\301\215\227\050\301\310\245\012"    // X-28.242Y-10.537
+    "\002\134\002\003\020\100\327\243\337\301\004\126\050\301\172\035\012"    // X-27.955Y-10.521
+    "\002\135\002\003\020\100\211\101\335\301\031\004\050\301\265\252\012"    // X-27.657Y-10.501
+    "\002\136\002\003\020\100\301\312\332\301\313\241\047\301\216\154\012"    // X-27.349Y-10.477
+    "\002\137\002\003\020\100\175\077\330\301\063\063\047\301\271\024\012"    // X-27.031Y-10.450
+    "\002\140\002\003\020\100\276\237\325\301\041\260\046\301\066\261\012"    // X-26.703Y-10.418
+    "\002\141\002\003\020\100\221\355\322\301\305\040\046\301\010\020\112\012"    // X-26.366Y-10.383
+    "\002\142\002\003\020\100\002\053\320\301\356\174\045\301\020\112\014\012"    // X-26.021Y-10.343
+    "\002\143\002\003\020\100\020\120\130\315\301\315\314\044\301\025\324\012"    // X-25.668Y-10.300
+    "\002\144\002\003\020\100\311\166\312\301\112\014\044\301\157\215\012"    // X-25.308Y-10.253
+    "\002\145\002\003\020\100\104\213\304\301\004\126\042\301\241\237\012"    // X-24.568Y-10.146
+    "\002\146\002\003\020\100\053\207\301\301\102\140\041\301\175\264\012"    // X-24.191Y-10.086
+    "\002\147\002\003\020\100\311\166\276\301\065\136\040\301\074\241\012"    // X-23.808Y-10.023
+    "\002\150\002\003\020\100\211\101\270\301\305\040\036\301\371\363\012"    // X-23.032Y-9.883
+    "\002\151\002\003\020\100\270\036\265\301\171\351\034\301\131\277\012"    // X-22.640Y-9.807
+    "\002\152\002\003\020\100\303\365\261\301\343\245\033\301\147\326\012"    // X-22.245Y-9.728
+    "\002\153\002\003\020\100\276\237\253\301\140\345\030\301\262\341\012"    // X-21.453Y-9.556
+    "\002\154\002\003\020\100\274\164\250\301\163\150\027\301\075\022\012"    // X-21.057Y-9.463
+    "\002\155\002\003\020\100\307\113\245\301\073\337\025\301\236\034\012"    // X-20.662Y-9.367
+    "\002\156\002\003\020\100\014\002\237\301\215\227\022\301\202\140\012"    // X-19.876Y-9.162
+    "\002\157\002\003\020\100\140\345\233\301\057\335\020\120\301\356\103\012"    // X-19.487Y-9.054
+    "\002\160\002\003\020\100\331\316\230\301\126\016\017\301\273\360\012"    // X-19.101Y-8.941
+    "\002\161\002\003\020\100\167\276\222\301\226\103\013\301\311\311\012"    // X-18.343Y-8.704
+    "\002\162\002\003\020\100\250\306\217\301\226\103\011\301\030\006\012"    // X-17.972Y-8.579
+    "\002\163\002\003\020\100\027\331\214\301\063\063\007\301\264\271\012"    // X-17.606Y-8.450
+    "\002\164\002\003\020\100\002\053\207\301\110\341\002\301\107\340\012"    // X-16.896Y-8.180
+    "\002\165\002\003\020\100\177\152\204\301\327\243\020\100\301\351\251\012"    // X-16.552Y-8.040
+    "\002\166\002\003\020\100\152\274\201\301\327\243\374\300\273\074\012"    // X-16.217Y-7.895
+    "\002\167\002\003\020\100\033\057\171\301\014\002\363\300\141\074\012"    // X-15.574Y-7.594
+    "\002\170\002\003\020\100\272\111\164\301\031\004\356\300\251\322\012"    // X-15.268Y-7.438
+    "\002\171\002\003\020\100\120\215\157\301\057\335\350\300\277\004\012"    // X-14.972Y-7.277
+    "\002\172\002\003\020\100\276\237\146\301\242\105\336\300\147\152\012"    // X-14.414Y-6.946
+    "\002\173\002\003\020\100\260\162\142\301\234\304\330\300\064\053\012"    // X-14.153Y-6.774
+    "\002\174\002\003\020\100\341\172\136\301\002\053\323\300\065\054\012"    // X-13.905Y-6.599
+    "\002\175\002\003\020\100\071\264\132\301\244\160\315\300\357\006\012"    // X-13.669Y-6.420
+    "\002\176\002\003\020\100\351\046\127\301\201\225\307\300\266\250\012"    // X-13.447Y-6.237
+    "\002\177\002\003\020\100\362\322\123\301\313\241\301\300\323\035\012"    // X-13.239Y-6.051
+    "\002\200\002\003\020\100\071\264\120\301\201\225\273\300\300\331\012"    // X-13.044Y-5.862
+    "\002\201\002\003\020\100\362\322\115\301\163\150\265\300\232\261\012"    // X-12.864Y-5.669
+    "\002\202\002\003\020\100\033\057\113\301\240\032\257\300\111\274\012"    // X-12.699Y-5.472
+    "\002\203\002\003\020\100\264\310\110\301\071\264\250\300\262\045\012"    // X-12.549Y-5.272
+    "\002\204\002\003\020\100\276\237\106\301\077\065\242\300\315\013\012"    // X-12.414Y-5.069
+    "\002\205\002\003\020\100\071\264\104\301\201\225\233\300\242\315\012"    // X-12.294Y-4.862
+    "\002\206\002\003\020\100\075\020\112\103\301\057\335\224\300\363\043\012"    // X-12.190Y-4.652
+    "\002\207\002\003\020\100\313\241\101\301\112\014\216\300\053\263\012"    // X-12.102Y-4.439
+    "\002\210\002\003\020\100\341\172\100\301\321\042\207\300\342\372\012"    // X-12.030Y-4.223
+    "\002\211\002\003\020\100\232\231\077\301\223\030\200\300\315\307\012"    // X-11.975Y-4.003
+    "\002\212\002\003\020\100\303\365\076\301\347\373\161\300\373\245\012"    // X-11.935Y-3.781
+    "\002\213\002\003\020\100\165\223\076\301\037\205\143\300\261\063\012"    // X-11.911Y-3.555
+    "\002\214\002\003\020\100\311\166\076\301\221\355\124\300\376\041\012"    // X-11.904Y-3.327
+    "\002\215\002\003\020\100\276\237\076\301\335\044\106\300\151\232\012"    // X-11.914Y-3.096
+    "\002\216\002\003\020\100\045\006\077\301\002\053\067\300\066\020\120\012"    // X-11.939Y-2.862
+    "\002\217\002\003\020\100\055\262\077\301\020\100\020\100\050\300\071\266\012"    // X-11.981Y-2.625
+    "\002\220\002\003\020\100\246\233\100\301\071\264\030\300\065\204\012"    // X-12.038Y-2.386
+    "\002\221\002\003\020\100\301\312\101\301\114\067\011\300\316\166\012"    // X-12.112Y-2.144
+    "\002\222\002\003\020\100\144\073\103\301\157\022\363\277\151\023\012"    // X-12.202Y-1.899
+    "\002\223\002\003\020\100\315\314\104\301\313\241\325\277\011\032\012"    // X-12.300Y-1.669
+    "\002\224\002\003\020\100\215\227\106\301\331\316\267\277\267\342\012"    // X-12.412Y-1.436
+    "\002\225\002\003\020\100\215\227\110\301\136\272\231\277\125\314\012"    // X-12.537Y-1.201
+    "\002\226\002\003\020\100\315\314\112\301\075\020\112\167\277\256\032\012"    // X-12.675Y-0.965
+    "\002\227\002\003\020\100\114\067\115\301\043\333\071\277\345\312\012"    // X-12.826Y-0.726
+    "\002\230\002\003\020\100\020\112\327\117\301\376\324\370\276\116\264\012"    // X-12.990Y-0.486
+    "\002\231\002\003\020\100\024\256\125\301\157\022\203\072\146\006\012"    // X-13.355Y0.001
+    "\002\232\002\003\020\100\110\341\130\301\155\347\173\076\112\377\012"    // X-13.555Y0.246
+    "\002\233\002\003\020\100\272\111\134\301\221\355\374\076\246\373\012"    // X-13.768Y0.494
+    "\002\234\002\003\020\100\262\235\143\301\077\065\176\077\322\156\012"    // X-14.226Y0.993
+    "\002\235\002\003\020\100\211\101\164\301\165\223\020\100\100\061\221\012"    // X-15.266Y2.009
+    "\002\236\002\003\020\100\315\314\170\301\045\006\021\100\263\361\012"    // X-15.550Y2.266
+    "\002\237\002\003\020\100\325\170\175\301\067\211\041\100\052\105\012"    // X-15.842Y2.524
+    "\002\240\002\003\020\100\246\233\203\301\203\300\102\100\133\100\012"    // X-16.451Y3.043
+    "\002\241\002\003\020\100\031\004\216\301\333\371\202\100\001\304\012"    // X-17.752Y4.093
+    "\002\242\002\003\020\100\165\223\244\301\014\002\307\100\351\163\012"    // X-20.572Y6.219
+    "\002\243\002\003\020\100\341\172\247\301\120\215\317\100\300\346\012"    // X-20.935Y6.486
+    "\002\244\002\003\020\100\116\142\252\301\223\030\330\100\140\172\012"    // X-21.298Y6.753
+    "\002\245\002\003\020\100\047\061\260\301\033\057\351\100\135\055\012"    // X-22.024Y7.287
+    "\002\246\002\003\020\100\343\245\273\301\343\245\005\101\363\021\012"    // X-23.456Y8.353
+    "\002\247\002\003\020\100\274\164\276\301\124\343\011\101\262\360\012"    // X-23.807Y8.618
+    "\002\250\002\003\020\100\144\073\301\301\305\040\016\101\357\112\012"    // X-24.154Y8.883
+    "\002\251\002\003\020\100\024\256\306\301\165\223\026\101\126\010\012"    // X-24.835Y9.411
+    "\002\252\002\003\020\100\020\100\020\100\321\301\370\123\047\101\277\356\012"    // X-26.125Y10.458
+    "\002\253\002\003\020\100\260\162\323\301\325\170\053\101\307\004\012"    // X-26.431Y10.717
+    "\002\254\002\003\020\100\362\322\325\301\232\231\057\101\243\334\012"    // X-26.728Y10.975
+    "\002\255\002\003\020\100\102\140\332\301\362\322\067\101\210\210\012"    // X-27.297Y11.489
+    "\002\256\002\003\020\100\104\213\334\301\155\347\073\101\270\252\012"    // X-27.568Y11.744
+    "\002\257\002\003\020\100\327\243\336\301\266\363\077\101\355\062\012"    // X-27.830Y11.997
+    "\002\260\002\003\020\100\165\223\342\301\020\100\020\100\110\101\167\237\012"    // X-28.322Y12.500
+    "\002\261\002\003\020\100\177\152\344\301\347\373\113\101\374\027\012"    // X-28.552Y12.749
+    "\002\262\002\003\020\100\002\053\346\301\266\363\117\101\054\174\012"    // X-28.771Y12.997
+    "\002\263\002\003\020\100\362\322\347\301\124\343\123\101\337\037\012"    // X-28.978Y13.243
+    "\002\264\002\003\020\100\132\144\351\301\301\312\127\101\034\362\012"    // X-29.174Y13.487
+    "\002\265\002\003\020\100\043\333\352\301\374\251\133\101\050\074\012"    // X-29.357Y13.729
+    "\002\266\002\003\020\100\130\071\354\301\037\205\137\101\240\212\012"    // X-29.528Y13.970
+    "\002\267\002\003\020\100\356\174\355\301\020\120\130\143\101\173\340\012"    // X-29.686Y14.209
+    "\002\270\002\003\020\100\343\245\356\301\321\042\147\101\243\027\012"    // X-29.831Y14.446
+    "\002\271\002\003\020\100\301\312\357\301\063\063\153\101\367\304\012"    // X-29.974Y14.700
+    "\002\272\002\003\020\100\331\316\360\301\175\077\157\101\044\211\012"    // X-30.101Y14.953
+    "\002\273\002\003\020\100\055\262\361\301\144\073\163\101\025\051\012"    // X-30.212Y15.202
+    "\002\274\002\003\020\100\274\164\362\301\033\057\167\101\224\172\012"    // X-30.307Y15.449
+    "\002\275\002\003\020\100\173\024\363\301\240\032\173\101\344\307\012"    // X-30.385Y15.694
+    "\002\276\002\003\020\100\165\223\363\301\333\371\176\101\051\264\012"    // X-30.447Y15.936
+    "\002\277\002\003\020\100\236\357\363\301\146\146\201\101\140\130\012"    // X-30.492Y16.175
+    "\002\300\002\003\020\100\002\053\364\301\272\111\203\101\207\112\012"    // X-30.521Y16.411
+    "\002\301\002\003\020\100\211\101\364\301\351\046\205\101\223\321\012"    // X-30.532Y16.644
+    "\002\302\002\003\020\100\114\067\364\301\364\375\206\101\260\120\012"    // X-30.527Y16.874
+    "\002\303\002\003\020\100\075\020\112\364\301\345\320\210\101\026\235\012"    // X-30.505Y17.102
+    "\002\304\002\003\020\100\136\272\363\301\246\233\212\101\333\224\012"    // X-30.466Y17.326
+    "\002\305\002\003\020\100\272\111\363\301\102\140\214\101\376\350\012"    // X-30.411Y17.547
+    "\002\306\002\003\020\100\071\264\362\301\270\036\216\101\052\020\112\012"    // X-30.338Y17.765
+    "\002\307\002\003\020\100\364\375\361\301\020\112\327\217\101\104\373\012"    // X-30.249Y17.980
+    "\002\310\002\003\020\100\351\046\361\301\053\207\221\101\176\266\012"    // X-30.144Y18.191
+    "\002\311\002\003\020\100\016\055\360\301\047\061\223\101\252\151\012"    // X-30.022Y18.399
+    "\002\312\002\003\020\100\157\022\357\301\362\322\224\101\020\115\336\012"    // X-29.884Y18.603
+    "\002\313\002\003\020\100\020\112\327\355\301\244\160\226\101\260\173\012"    // X-29.730Y18.805
+    "\002\314\002\003\020\100\356\174\354\301\031\004\230\101\277\050\012"    // X-29.561Y19.002
+    "\002\315\002\003\020\100\014\002\353\301\150\221\231\101\304\076\012"    // X-29.376Y19.196
+    "\002\316\002\003\020\100\163\150\351\301\207\026\233\101\055\021\012"    // X-29.176Y19.386
+    "\002\317\002\003\020\100\055\262\347\301\201\225\234\101\252\251\012"    // X-28.962Y19.573
+    "\002\320\002\003\020\100\057\335\345\301\112\014\236\101\175\235\012"    // X-28.733Y19.756
+    "\002\321\002\003\020\100\205\353\343\301\341\172\237\101\044\121\012"    // X-28.490Y19.935
+    "\002\322\002\003\020\100\057\335\341\301\124\343\240\101\121\216\012"    // X-28.233Y20.111
+    "\002\323\002\003\020\100\106\266\337\301\211\101\242\101\224\052\012"    // X-27.964Y20.282
+    "\002\324\002\003\020\100\260\162\335\301\232\231\243\101\165\254\012"    // X-27.681Y20.450
+    "\002\325\002\003\020\100\207\026\333\301\171\351\244\101\120\217\012"    // X-27.386Y20.614
+    "\002\326\002\003\020\100\327\243\330\301\047\061\246\101\256\171\012"    // X-27.080Y20.774
+    "\002\327\002\003\020\100\325\170\323\301\343\245\250\101\075\302\012"    // X-26.434Y21.081
+    "\002\330\002\003\020\100\234\304\320\301\376\324\251\101\320\356\012"    // X-26.096Y21.229
+    "\002\331\002\003\020\100\347\373\315\301\347\373\252\101\321\033\012"    // X-25.748Y21.373
+    "\002\332\002\003\020\100\063\063\310\301\033\057\255\101\303\161\012"    // X-25.025Y21.648
+    "\002\333\002\003\020\100\114\067\305\301\161\075\256\101\324\335\012"    // X-24.652Y21.780
+    "\002\334\002\003\020\100\016\055\302\301\211\101\257\101\113\044\012"    // X-24.272Y21.907
+    "\002\335\002\003\020\100\252\361\273\301\047\061\261\101\231\020\100\012"    // X-23.493Y22.149
+    "\002\336\002\003\020\100\217\302\270\301\254\034\262\101\334\053\012"    // X-23.095Y22.264
+    "\002\337\002\003\020\100\104\213\265\301\020\100\020\100\263\101\103\355\012"    // X-22.693Y22.375
+    "\002\340\002\003\020\100\031\004\257\301\374\251\264\101\043\355\012"    // X-21.877Y22.583
+    "\002\341\002\003\020\100\136\272\253\301\260\162\265\101\071\236\012"    // X-21.466Y22.681
+    "\002\342\002\003\020\100\213\154\250\301\063\063\266\101\174\362\012"    // X-21.053Y22.775
+    "\002\343\002\003\020\100\264\310\241\301\215\227\267\101\332\043\012"    // X-20.223Y22.949
+    "\002\344\002\003\020\100\325\170\236\301\161\075\270\101\035\103\012"    // X-19.809Y23.030
+    "\002\345\002\003\020\100\002\053\233\301\043\333\270\101\103\112\012"    // X-19.396Y23.107
+    "\002\346\002\003\020\100\232\231\224\301\333\371\271\101\276\007\012"    // X-18.575Y23.247
+    "\002\347\002\003\020\100\035\132\221\301\356\174\272\101\221\306\012"    // X-18.169Y23.311
+    "\002\350\002\003\020\100\321\042\216\301\317\367\272\101\216\215\012"    // X-17.767Y23.371
+    "\002\351\002\003\020\100\345\320\207\301\362\322\273\101\273\213\012"    // X-16.977Y23.478
+    "\002\352\002\003\020\100\136\272\204\301\063\063\274\101\344\246\012"    // X-16.591Y23.525
+    "\002\353\002\003\020\100\041\260\201\301\104\213\274\101\026\070\012"    // X-16.211Y23.568
+    "\002\354\002\003\020\100\163\150\175\301\027\331\274\101\112\342\012"    // X-15.838Y23.606
+    "\002\355\002\003\020\100\150\221\167\301\305\040\275\101\353\203\012"    // X-15.473Y23.641
+    "\002\356\002\003\020\100\043\333\161\301\065\136\275\101\014\131\012"    // X-15.116Y23.671
+    "\002\357\002\003\020\100\323\115\154\301\201\225\275\101\262\223\012"    // X-14.769Y23.698
+    "\002\360\002\003\020\100\110\341\146\301\217\302\275\101\371\311\012"    // X-14.430Y23.720
+    "\002\361\002\003\020\100\313\241\141\301\171\351\275\101\066\044\012"    // X-14.102Y23.739
+    "\002\362\002\003\020\100\360\247\134\301\045\006\276\101\152\222\012"    // X-13.791Y23.753
+    "\002\363\002\003\020\100\020\112\327\127\301\240\032\276\101\122\135\012"    // X-13.490Y23.763
+    "\002\364\002\003\020\100\063\063\123\301\351\046\276\101\147\270\012"    // X-13.200Y23.769
+    "\002\365\002\003\020\100\203\300\116\301\016\055\276\101\244\206\012"    // X-12.922Y23.772
+    "\002\366\002\003\020\100\022\203\112\301\002\053\276\101\200\372\012"    // X-12.657Y23.771
+    "\002\367\002\003\020\100\311\166\106\301\305\040\276\101\033\126\012"    // X-12.404Y23.766
+    "\002\370\002\003\020\100\276\237\102\301\142\020\120\276\101\234\171\012"    // X-12.164Y23.758
+    "\002\371\002\003\020\100\364\375\076\301\317\367\275\101\301\043\012"    // X-11.937Y23.746
+    "\002\372\002\003\020\100\201\225\073\301\020\112\327\275\101\175\064\012"    // X-11.724Y23.730
+    "\002\373\002\003\020\100\146\146\070\301\041\260\275\101\171\216\012"    // X-11.525Y23.711
+    "\002\374\002\003\020\100\244\160\065\301\006\201\275\101\056\116\012"    // X-11.340Y23.688
+    "\002\375\002\003\020\100\152\274\062\301\307\113\275\101\002\020\120\012"    // X-11.171Y23.662
+    "\002\376\002\003\020\100\211\101\060\301\142\020\120\275\101\017\033\012"    // X-11.016Y23.633
+    "\002\377\002\003\020\100\031\004\056\301\315\314\274\101\177\373\012"    // X-10.876Y23.600
+    "\002\020\100\002\003\020\100\061\010\054\301\022\203\274\101\145\067\012"    // X-10.752Y23.564
+    "\002\001\002\003\020\100\272\111\052\301\047\061\274\101\141\367\012"    // X-10.643Y23.524
+    "\002\002\002\003\020\100\264\310\050\301\027\331\273\101\331\110\012"    // X-10.549Y23.481
+    "\002\003\002\003\020\100\120\215\047\301\341\172\273\101\250\011\012"    // X-10.472Y23.435
+    "\002\004\002\003\020\100\165\223\046\301\207\026\273\101\047\342\012"    // X-10.411Y23.386
+    "\002\005\002\003\020\100\020\112\327\045\301\010\254\272\101\217\131\012"    // X-10.365Y23.334
+    "\002\006\002\003\020\100\102\140\045\301\144\073\272\101\143\264\012"    // X-10.336Y23.279
+    "\002\007\002\003\020\100\002\053\045\301\234\304\271\101\273\127\012"    // X-10.323Y23.221
+    "\002\010\002\003\020\100\114\067\045\301\272\111\271\101\125\040\012"    // X-10.326Y23.161
+    "\002\011\002\003\020\100\006\201\045\301\250\306\270\101\110\305\012"    // X-10.344Y23.097
+    "\002\020\112\002\003\020\100\142\020\120\046\301\161\075\270\101\326\340\012"    // X-10.379Y23.030
+    "\002\013\002\003\020\100\110\341\046\301\041\260\267\101\100\202\012"    // X-10.430Y22.961
+    "\002\014\002\003\020\100\266\363\047\301\254\034\267\101\354\147\012"    // X-10.497Y22.889
+    "\002\020\115\002\003\020\100\226\103\051\301\037\205\266\101\262\322\012"    // X-10.579Y22.815
+    "\002\016\002\003\020\100\345\320\052\301\155\347\265\101\361\052\012"    // X-10.676Y22.738
+    "\002\017\002\003\020\100\276\237\054\301\242\105\265\101\035\132\012"    // X-10.789Y22.659
+    "\002\020\120\002\003\020\100\010\254\056\301\262\235\264\101\324\253\012"    // X-10.917Y22.577
+    "\002\021\002\003\020\100\303\365\060\301\252\361\263\101\332\307\012"    // X-11.060Y22.493
+    "\002\022\002\003\020\100\325\170\063\301\211\101\263\101\104\242\012"    // X-11.217Y22.407
+    "\002\023\002\003\020\100\130\071\066\301\104\213\262\101\175\164\012"    // X-11.389Y22.318
+    "\002\024\002\003\020\100\065\136\074\301\173\024\261\101\352\162\012"    // X-11.773Y22.135
+    "\002\025\002\003\020\100\217\302\077\301\370\123\260\101\137\266\012"    // X-11.985Y22.041
+    "\002\026\002\003\020\100\051\134\103\301\134\217\257\101\250\166\012"    // X-12.210Y21.945
+    "\002\027\002\003\020\100\351\046\113\301\333\371\255\101\076\204\012"    // X-12.697Y21.747
+    "\002\030\002\003\020\100\370\123\117\301\366\050\255\101\261\112\012"    // X-12.958Y21.645
+    "\002\031\002\003\020\100\024\256\123\301\004\126\254\101\242\176\012"    // X-13.230Y21.542
+    "\002\032\002\003\020\100\140\345\134\301\343\245\252\101\377\122\012"    // X-13.806Y21.331
+    "\002\033\002\003\020\100\126\016\161\301\351\046\247\101\347\303\012"    // X-15.066Y20.894
+    "\002\034\002\003\020\100\177\152\166\301\211\101\246\101\110\047\012"    // X-15.401Y20.782
+    "\002\035\002\003\020\100\073\337\173\301\051\134\245\101\007\246\012"    // X-15.742Y20.670
+    "\002\036\002\003\020\100\067\211\203\301\053\207\243\101\310\267\012"    // X-16.442Y20.441
+    "\002\037\002\003\020\100\002\053\217\301\345\320\237\101\210\236\012"    // X-17.896Y19.977
+    "\002\040\002\003\020\100\252\361\246\301\256\107\230\101\337\227\012"    // X-20.868Y19.035
+    "\002\041\002\003\020\100\374\251\251\301\163\150\227\101\160\110\012"    // X-21.208Y18.926
+    "\002\042\002\003\020\100\051\134\254\301\067\211\226\101\327\046\012"    // X-21.545Y18.817
+    "\002\043\002\003\020\100\374\251\261\301\315\314\224\101\330\076\012"    // X-22.208Y18.600
+    "\002\044\002\003\020\100\250\306\273\301\116\142\221\101\347\122\012"    // X-23.472Y18.173
+    "\002\045\002\003\020\100\016\055\276\301\104\213\220\101\107\042\012"    // X-23.772Y18.068
+    "\002\046\002\003\020\100\053\207\300\301\106\266\217\101\241\236\012"    // X-24.066Y17.964
+    "\002\047\002\003\020\100\061\010\305\301\157\022\216\101\131\305\012"    // X-24.629Y17.759
+    "\002\050\002\003\020\100\063\063\315\301\124\343\212\101\254\154\012"    // X-25.650Y17.361
+    "\002\051\002\003\020\100\112\014\317\301\270\036\212\101\043\264\012"    // X-25.881Y17.265
+    "\002\052\002\003\020\100\331\316\320\301\051\134\211\101\070\346\012"    // X-26.101Y17.170
+    "\002\053\002\003\020\100\157\022\324\301\073\337\207\101\265\174\012"    // X-26.509Y16.984
+    "\002\054\002\003\020\100\150\221\325\301\335\044\207\101\355\065\012"    // X-26.696Y16.893
+    "\002\055\002\003\020\100\317\367\326\301\230\156\206\101\062\220\012"    // X-26.871Y16.804
+    "\002\056\002\003\020\100\325\170\331\301\112\014\205\101\105\070\012"    // X-27.184Y16.631
+    "\002\057\002\003\020\100\165\223\332\301\102\140\204\101\020\115\170\012"    // X-27.322Y16.547
+    "\002\060\002\003\020\100\165\223\333\301\122\270\203\101\033\127\012"    // X-27.447Y16.465
+    "\002\061\002\003\020\100\325\170\334\301\173\024\203\101\316\105\012"    // X-27.559Y16.385
+    "\002\062\002\003\020\100\226\103\335\301\260\162\202\101\267\236\012"    // X-27.658Y16.306
+    "\002\063\002\003\020\100\252\361\335\301\020\112\327\201\101\173\302\012"    // X-27.743Y16.230
+    "\002\064\002\003\020\100\037\205\336\301\175\077\201\101\134\250\012"    // X-27.815Y16.156
+    "\002\065\002\003\020\100\347\373\336\301\010\254\200\101\377\242\012"    // X-27.873Y16.084
+    "\002\066\002\003\020\100\004\126\337\301\254\034\200\101\361\253\012"    // X-27.917Y16.014
+    "\002\067\002\003\020\100\165\223\337\301\321\042\177\101\101\366\012"    // X-27.947Y15.946
+    "\002\070\002\003\020\100\071\264\337\301\173\024\176\101\236\263\012"    // X-27.963Y15.880
+    "\002\071\002\003\020\100\122\270\337\301\157\022\175\101\062\217\012"    // X-27.965Y15.817
+    "\002\072\002\003\020\100\276\237\337\301\223\030\174\101\036\270\012"    // X-27.953Y15.756
+    "\002\073\002\003\020\100\177\152\337\301\351\046\173\101\073\314\012"    // X-27.927Y15.697
+    "\002\074\002\003\020\100\223\030\337\301\211\101\172\101\144\065\012"    // X-27.887Y15.641
+    "\002\075\002\003\020\100\360\247\336\301\163\150\171\101\003\364\012"    // X-27.832Y15.588
+    "\002\076\002\003\020\100\254\034\336\301\215\227\170\101\121\123\012"    // X-27.764Y15.537
+    "\002\077\002\003\020\100\260\162\335\301\331\316\167\101\376\134\012"    // X-27.681Y15.488
+    "\002\100\002\003\020\100\024\256\334\301\157\022\167\101\061\322\012"    // X-27.585Y15.442
+    "\002\101\002\003\020\100\315\314\333\301\116\142\166\101\323\017\012"    // X-27.475Y15.399
+    "\002\102\002\003\020\100\331\316\332\301\136\272\165\101\027\237\012"    // X-27.351Y15.358
+    "\002\103\002\003\020\100\106\266\331\301\321\042\165\101\367\204\012"    // X-27.214Y15.321
+    "\002\104\002\003\020\100\006\201\330\301\165\223\164\101\174\245\012"    // X-27.063Y15.286
+    "\002\105\002\003\020\100\047\061\327\301\112\014\164\101\312\001\012"    // X-26.899Y15.253
+    "\002\106\002\003\020\100\264\310\325\301\201\225\163\101\205\121\012"    // X-26.723Y15.224
+    "\002\107\002\003\020\100\226\103\324\301\002\053\163\101\122\240\012"    // X-26.533Y15.198
+    "\002\110\002\003\020\100\360\247\322\301\264\310\162\101\036\366\012"    // X-26.332Y15.174
+    "\002\111\002\003\020\100\252\361\320\301\311\166\162\101\214\361\012"    // X-26.118Y15.154
+    "\002\112\002\003\020\100\321\042\317\301\016\055\162\101\155\230\012"    // X-25.892Y15.136
+    "\002\113\002\003\020\100\144\073\315\301\266\363\161\101\330\240\012"    // X-25.654Y15.122
+    "\002\114\002\003\020\100\161\075\313\301\217\302\161\101\126\334\012"    // X-25.405Y15.110
+    "\002\115\002\003\020\100\366\050\311\301\313\241\161\101\160\106\012"    // X-25.145Y15.102
+    "\002\116\002\003\020\100\020\100\020\100\307\301\120\215\161\101\166\330\012"    // X-24.875Y15.097
+    "\002\117\002\003\020\100\203\300\304\301\037\205\161\101\321\105\012"    // X-24.594Y15.095
+    "\002\120\002\003\020\100\230\156\302\301\067\211\161\101\363\067\012"    // X-24.304Y15.096
+    "\002\121\002\003\020\100\061\010\300\301\232\231\161\101\212\342\012"    // X-24.004Y15.100
+    "\002\122\002\003\020\100\120\215\275\301\106\266\161\101\071\271\012"    // X-23.694Y15.107
+    "\002\123\002\003\020\100\031\004\273\301\124\343\161\101\260\133\012"    // X-23.377Y15.118
+    "\002\124\002\003\020\100\163\150\270\301\254\034\162\101\020\120\340\012"    // X-23.051Y15.132
+    "\002\125\002\003\020\100\152\274\265\301\116\142\162\101\270\343\012"    // X-22.717Y15.149
+    "\002\126\002\003\020\100\014\002\263\301\122\270\162\101\211\120\012"    // X-22.376Y15.170
+    "\002\127\002\003\020\100\347\373\257\301\321\042\163\101\164\052\012"    // X-21.998Y15.196
+    "\002\130\002\003\020\100\155\347\254\301\262\235\163\101\132\356\012"    // X-21.613Y15.226
+    "\002\131\002\003\020\100\234\304\251\301\366\050\164\101\361\072\012"    // X-21.221Y15.260
+    "\002\132\002\003\020\100\165\223\246\301\234\304\164\101\247\304\012"    // X-20.822Y15.298
+    "\002\133\002\003\020\100\020\120\130\243\301\244\160\165\101\313\304\012"    // X-20.418Y15.340
+    "\002\134\002\003\020\100\173\024\240\301\366\050\166\101\237\354\012"    // X-20.010Y15.385
+    "\002\135\002\003\020\100\244\160\231\301\362\322\167\101\054\310\012"    // X-19.180Y15.489
+    "\002\136\002\003\020\100\207\026\226\301\203\300\170\101\156\240\012"    // X-18.761Y15.547
+    "\002\137\002\003\020\100\106\266\222\301\167\276\171\101\263\211\012"    // X-18.339Y15.609
+    "\002\140\002\003\020\100\236\357\213\301\155\347\173\101\223\255\012"    // X-17.492Y15.744
+    "\002\141\002\003\020\100\067\211\210\301\207\026\175\101\134\077\012"    // X-17.067Y15.818
+    "\002\142\002\003\020\100\351\046\205\301\004\126\176\101\210\235\012"    // X-16.644Y15.896
+    "\002\143\002\003\020\100\315\314\174\301\022\203\200\101\237\132\012"    // X-15.800Y16.064
+    "\002\144\002\003\020\100\254\034\166\301\144\073\201\101\120\136\012"    // X-15.382Y16.154
+    "\002\145\002\003\020\100\325\170\157\301\347\373\201\101\211\364\012"    // X-14.967Y16.248
+    "\002\146\002\003\020\100\146\146\142\301\201\225\203\101\315\121\012"    // X-14.150Y16.448
+    "\002\147\002\003\020\100\347\373\133\301\230\156\204\101\350\233\012"    // X-13.749Y16.554
+    "\002\150\002\003\020\100\374\251\125\301\337\117\205\101\261\324\012"    // X-13.354Y16.664
+    "\002\151\002\003\020\100\370\123\111\301\366\050\207\101\270\251\012"    // X-12.583Y16.895
+    "\002\152\002\003\020\100\020\120\130\103\301\321\042\210\101\165\276\012"    // X-12.209Y17.017
+    "\002\153\002\003\020\100\006\201\075\301\321\042\211\101\323\234\012"    // X-11.844Y17.142
+    "\002\154\002\003\020\100\161\075\062\301\161\075\213\101\326\145\012"    // X-11.140Y17.405
+    "\002\155\002\003\020\100\027\331\054\301\004\126\214\101\357\044\012"    // X-10.803Y17.542
+    "\002\156\002\003\020\100\313\241\047\301\311\166\215\101\231\355\012"    // X-10.477Y17.683
+    "\002\157\002\003\020\100\136\272\035\301\315\314\217\101\020\120\046\012"    // X-9.858Y17.975
+    "\002\160\002\003\020\100\126\016\031\301\031\004\221\101\262\344\012"    // X-9.566Y18.127
+    "\002\161\002\003\020\100\215\227\024\301\226\103\222\101\070\072\012"    // X-9.287Y18.283
+    "\002\162\002\003\020\100\004\126\020\120\301\067\211\223\101\077\035\012"    // X-9.021Y18.442
+    "\002\163\002\003\020\100\272\111\014\301\376\324\224\101\050\122\012"    // X-8.768Y18.604
+    "\002\164\002\003\020\100\311\166\010\301\002\053\226\101\241\216\012"    // X-8.529Y18.771
+    "\002\165\002\003\020\100\110\341\004\301\037\205\227\101\056\016\012"    // X-8.305Y18.940
+    "\002\166\002\003\020\100\006\201\001\301\155\347\230\101\103\331\012"    // X-8.094Y19.113
+    "\002\167\002\003\020\100\234\304\374\300\354\121\232\101\053\333\012"    // X-7.899Y19.290
+    "\002\170\002\003\020\100\333\371\366\300\217\302\233\101\323\034\012"    // X-7.718Y19.470
+    "\002\171\002\003\020\100\055\262\361\300\130\071\235\101\111\314\012"    // X-7.553Y19.653
+    "\002\172\002\003\020\100\140\345\354\300\106\266\236\101\263\065\012"    // X-7.403Y19.839
+    "\002\173\002\003\020\100\327\243\350\300\144\073\240\101\134\265\012"    // X-7.270Y20.029
+    "\002\174\002\003\020\100\057\335\344\300\234\304\241\101\226\265\012"    // X-7.152Y20.221
+    "\002\175\002\003\020\100\232\231\341\300\004\126\243\101\114\051\012"    // X-7.050Y20.417
+    "\002\176\002\003\020\100\110\341\336\300\221\355\244\101\220\205\012"    // X-6.965Y20.616
+    "\002\177\002\003\020\100\327\243\334\300\104\213\246\101\262\362\012"    // X-6.895Y20.818
+    "\002\200\002\003\020\100\333\371\332\300\033\057\250\101\111\251\012"    // X-6.843Y21.023
+    "\002\201\002\003\020\100\301\312\331\300\020\112\327\251\101\312\135\012"    // X-6.806Y21.230
+    "\002\202\002\003\020\100\033\057\331\300\053\207\253\101\336\347\012"    // X-6.787Y21.441
+    "\002\203\002\003\020\100\126\016\331\300\144\073\255\101\302\011\012"    // X-6.783Y21.654
+    "\002\204\002\003\020\100\325\170\331\300\303\365\256\101\307\302\012"    // X-6.796Y21.870
+    "\002\205\002\003\020\100\230\156\332\300\071\264\260\101\277\304\012"    // X-6.826Y22.088
+    "\002\206\002\003\020\100\155\347\333\300\325\170\262\101\252\377\012"    // X-6.872Y22.309
+    "\002\207\002\003\020\100\043\333\335\300\211\101\264\101\202\331\012"    // X-6.933Y22.532
+    "\002\210\002\003\020\100\035\132\340\300\142\020\120\266\101\222\365\012"    // X-7.011Y22.758
+    "\002\211\002\003\020\100\370\123\343\300\124\343\267\101\017\251\012"    // X-7.104Y22.986
+    "\002\212\002\003\020\100\345\320\346\300\152\274\271\101\171\050\012"    // X-7.213Y23.217
+    "\002\213\002\003\020\100\345\320\352\300\215\227\273\101\175\345\012"    // X-7.338Y23.449
+    "\002\214\002\003\020\100\226\103\357\300\325\170\275\101\020\120\104\012"    // X-7.477Y23.684
+    "\002\215\002\003\020\100\047\061\364\300\065\136\277\101\241\120\012"    // X-7.631Y23.921
+    "\002\216\002\003\020\100\213\154\377\300\077\065\303\101\132\117\012"    // X-7.982Y24.401
+    "\002\217\002\003\020\100\327\243\002\301\031\004\305\101\112\127\012"    // X-8.165Y24.627
+    "\002\220\002\003\020\100\217\302\005\301\020\112\327\306\101\221\214\012"    // X-8.360Y24.855
+    "\002\221\002\003\020\100\022\203\014\301\037\205\312\101\373\346\012"    // X-8.782Y25.315
+    "\002\222\002\003\020\100\031\004\034\301\014\002\322\101\231\051\012"    // X-9.751Y26.251
+    "\002\223\002\003\020\100\242\105\040\301\155\347\323\101\152\121\012"    // X-10.017Y26.488
+    "\002\224\002\003\020\100\360\247\044\301\331\316\325\101\223\352\012"    // X-10.291Y26.726
+    "\002\225\002\003\020\100\331\316\055\301\313\241\331\101\113\037\012"    // X-10.863Y27.204
+    "\002\226\002\003\020\100\213\154\101\301\051\134\341\101\274\353\012"    // X-12.089Y28.170
+    "\002\227\002\003\020\100\104\213\106\301\323\115\343\101\153\026\012"    // X-12.409Y28.413
+    "\002\230\002\003\020\100\167\276\113\301\211\101\345\101\037\047\012"    // X-12.734Y28.657
+    "\002\231\002\003\020\100\354\121\126\301\366\050\351\101\061\042\012"    // X-13.395Y29.145
+    "\002\232\002\003\020\100\347\373\153\301\364\375\360\101\150\174\012"    // X-14.749Y30.124
+    "\002\233\002\003\020\100\360\247\213\301\331\116\020\100\102\260\074\012"    // X-17.457Y32.077
+    "\002\234\002\003\020\100\256\107\216\301\256\107\001\102\224\204\012"    // X-17.785Y32.320
+    "\002\235\002\003\020\100\057\335\220\301\167\076\002\102\346\200\012"    // X-18.108Y32.561
+    "\002\236\002\003\020\100\205\353\225\301\002\053\004\102\100\325\012"    // X-18.740Y33.042
+    "\002\237\002\003\020\100\244\160\237\301\333\371\007\102\362\276\012"    // X-19.930Y33.994
+    "\002\240\002\003\020\100\024\256\241\301\177\352\010\102\377\271\012"    // X-20.210Y34.229
+    "\002\241\002\003\020\100\027\331\243\301\035\332\011\102\264\046\012"    // X-20.481Y34.463
+    "\002\242\002\003\020\100\333\371\247\301\077\265\013\102\204\132\012"    // X-20.997Y34.927
+    "\002\243\002\003\020\100\205\353\251\301\305\240\014\102\135\035\012"    // X-21.240Y35.157
+    "\002\244\002\003\020\100\301\312\253\301\104\213\020\115\102\366\137\012"    // X-21.474Y35.386
+    "\002\245\002\003\020\100\256\107\257\301\035\132\017\102\041\375\012"    // X-21.910Y35.838
+    "\002\246\002\003\020\100\124\343\260\301\175\077\020\120\102\005\305\012"    // X-22.111Y36.062
+    "\002\247\002\003\020\100\177\152\262\301\321\042\021\102\205\367\012"    // X-22.302Y36.284
+    "\002\250\002\003\020\100\020\112\327\263\301\037\005\022\102\361\006\012"    // X-22.480Y36.505
+    "\002\251\002\003\020\100\002\053\265\301\132\344\022\102\224\256\012"    // X-22.646Y36.723
+    "\002\252\002\003\020\100\146\146\266\301\217\302\023\102\311\303\012"    // X-22.800Y36.940
+    "\002\253\002\003\020\100\053\207\267\301\270\236\024\102\326\112\012"    // X-22.941Y37.155
+    "\002\254\002\003\020\100\120\215\270\301\317\167\025\102\272\014\012"    // X-23.069Y37.367
+    "\002\255\002\003\020\100\311\166\271\301\337\117\026\102\024\225\012"    // X-23.183Y37.578
+    "\002\256\002\003\020\100\256\107\272\301\335\044\027\102\344\100\012"    // X-23.285Y37.786
+    "\002\257\002\003\020\100\347\373\272\301\325\370\027\102\141\331\012"    // X-23.373Y37.993
+    "\002\260\002\003\020\100\165\223\273\301\272\311\030\102\301\270\012"    // X-23.447Y38.197
+    "\002\261\002\003\020\100\126\016\274\301\215\227\031\102\132\275\012"    // X-23.507Y38.398
+    "\002\262\002\003\020\100\213\154\274\301\132\144\032\102\302\035\012"    // X-23.553Y38.598
+    "\002\263\002\003\020\100\024\256\274\301\024\056\033\102\055\064\012"    // X-23.585Y38.795
+    "\002\264\002\003\020\100\345\320\274\301\274\364\033\102\061\115\012"    // X-23.602Y38.989
+    "\002\265\002\003\020\100\027\331\274\301\130\271\034\102\323\057\012"    // X-23.606Y39.181
+    "\002\266\002\003\020\100\167\276\274\301\104\213\035\102\313\301\012"    // X-23.593Y39.386
+    "\002\267\002\003\020\100\006\201\274\301\035\132\036\102\276\147\012"    // X-23.563Y39.588
+    "\002\270\002\003\020\100\305\040\274\301\343\045\037\102\010\060\012"    // X-23.516Y39.787
+    "\002\271\002\003\020\100\262\235\273\301\230\356\037\102\072\036\012"    // X-23.452Y39.983
+    "\002\272\002\003\020\100\333\371\272\301\063\263\040\102\065\005\012"    // X-23.372Y40.175
+    "\002\273\002\003\020\100\047\061\272\301\274\164\041\102\102\046\012"    // X-23.274Y40.364
+    "\002\274\002\003\020\100\256\107\271\301\063\063\042\102\235\245\012"    // X-23.160Y40.550
+    "\002\275\002\003\020\100\144\073\270\301\221\355\042\102\344\326\012"    // X-23.029Y40.732
+    "\002\276\002\003\020\100\126\016\267\301\327\243\043\102\260\203\012"    // X-22.882Y40.910
+    "\002\277\002\003\020\100\203\300\265\301\020\120\130\044\102\376\131\012"    // X-22.719Y41.086
+    "\002\300\002\003\020\100\337\117\264\301\053\007\045\102\366\003\012"    // X-22.539Y41.257
+    "\002\301\002\003\020\100\203\300\262\301\063\263\045\102\372\312\012"    // X-22.344Y41.425
+    "\002\302\002\003\020\100\157\022\261\301\043\133\046\102\342\006\012"    // X-22.134Y41.589
+    "\002\303\002\003\020\100\226\103\257\301\372\376\046\102\332\324\012"    // X-21.908Y41.749
+    "\002\304\002\003\020\100\020\120\130\255\301\276\237\047\102\310\155\012"    // X-21.668Y41.906
+    "\002\305\002\003\020\100\323\115\253\301\152\074\050\102\244\370\012"    // X-21.413Y42.059
+    "\002\306\002\003\020\100\351\046\251\301\376\324\050\102\020\120\134\012"    // X-21.144Y42.208
+    "\002\307\002\003\020\100\140\345\246\301\171\151\051\102\363\223\012"    // X-20.862Y42.353
+    "\002\310\002\003\020\100\053\207\244\301\333\371\051\102\361\207\012"    // X-20.566Y42.494
+    "\002\311\002\003\020\100\126\016\242\301\045\206\052\102\105\363\012"    // X-20.257Y42.631
+    "\002\312\002\003\020\100\372\176\237\301\120\020\115\053\102\200\202\012"    // X-19.937Y42.763
+    "\002\313\002\003\020\100\376\324\234\301\150\221\053\102\113\322\012"    // X-19.604Y42.892
+    "\002\314\002\003\020\100\175\077\227\301\120\215\054\102\045\171\012"    // X-18.906Y43.138
+    "\002\315\002\003\020\100\004\126\224\301\031\004\055\102\162\316\012"    // X-18.542Y43.254
+    "\002\316\002\003\020\100\020\120\130\221\301\311\166\055\102\326\226\012"    // X-18.168Y43.366
+    "\002\317\002\003\020\100\256\107\216\301\140\345\055\102\222\352\012"    // X-17.785Y43.474
+    "\002\320\002\003\020\100\351\046\213\301\337\117\056\102\242\275\012"    // X-17.394Y43.578
+    "\002\321\002\003\020\100\303\365\207\301\106\266\056\102\347\216\012"    // X-16.995Y43.678
+    "\002\322\002\003\020\100\106\266\204\301\215\027\057\102\357\341\012"    // X-16.589Y43.773
+    "\002\323\002\003\020\100\305\040\174\301\315\314\057\102\316\215\012"    // X-15.758Y43.950
+    "\002\324\002\003\020\100\051\134\165\301\313\041\060\102\127\254\012"    // X-15.335Y44.033
+    "\002\325\002\003\020\100\053\207\156\301\252\161\060\102\113\202\012"    // X-14.908Y44.111
+    "\002\326\002\003\020\100\262\235\147\301\152\274\060\102\075\105\012"    // X-14.476Y44.184
+    "\002\327\002\003\020\100\010\254\140\301\022\003\061\102\215\143\012"    // X-14.042Y44.253
+    "\002\330\002\003\020\100\055\262\131\301\242\105\061\102\371\177\012"    // X-13.606Y44.318
+    "\002\331\002\003\020\100\041\260\122\301\031\204\061\102\163\060\012"    // X-13.168Y44.379
+    "\002\332\002\003\020\100\276\237\104\301\252\361\061\102\224\006\012"    // X-12.289Y44.486
+    "\002\333\002\003\020\100\262\235\075\301\321\042\062\102\066\114\012"    // X-11.851Y44.534
+    "\002\334\002\003\020\100\276\237\066\301\323\115\062\102\271\254\012"    // X-11.414Y44.576
+    "\002\335\002\003\020\100\343\245\057\301\303\165\062\102\312\275\012"    // X-10.978Y44.615
+    "\002\336\002\003\020\100\152\274\050\301\223\230\062\102\160\137\012"    // X-10.546Y44.649
+    "\002\337\002\003\020\100\043\333\041\301\114\267\062\102\172\307\012"    // X-10.116Y44.679
+    "\002\340\002\003\020\100\126\016\033\301\345\320\062\102\146\343\012"    // X-9.691Y44.704
+    "\002\341\002\003\020\100\004\126\024\301\155\347\062\102\046\020\100\012"    // X-9.271Y44.726
+    "\002\342\002\003\020\100\055\262\020\115\301\317\367\062\102\346\350\012"    // X-8.856Y44.742
+    "\002\343\002\003\020\100\351\046\007\301\037\005\063\102\351\042\012"    // X-8.447Y44.755
+    "\002\344\002\003\020\100\071\264\020\100\301\120\020\115\063\102\264\073\012"    // X-8.044Y44.763
+    "\002\345\002\003\020\100\315\314\364\300\150\021\063\102\211\317\012"    // X-7.650Y44.767
+    "\002\346\002\003\020\100\177\152\350\300\142\020\120\063\102\073\324\012"    // X-7.263Y44.766
+    "\002\347\002\003\020\100\354\121\334\300\112\014\063\102\016\140\012"    // X-6.885Y44.762
+    "\002\350\002\003\020\100\022\203\320\300\022\003\063\102\326\126\012"    // X-6.516Y44.753
+    "\002\351\002\003\020\100\045\006\305\300\303\365\062\102\310\343\012"    // X-6.157Y44.740
+    "\002\352\002\003\020\100\043\333\271\300\132\344\062\102\074\302\012"    // X-5.808Y44.723
+    "\002\353\002\003\020\100\157\022\257\300\331\316\062\102\161\353\012"    // X-5.471Y44.702
+    "\002\354\002\003\020\100\327\243\244\300\071\264\062\102\051\124\012"    // X-5.145Y44.676
+    "\002\355\002\003\020\100\134\217\232\300\207\226\062\102\355\124\012"    // X-4.830Y44.647
+    "\002\356\002\003\020\100\221\355\220\300\266\163\062\102\040\110\012"    // X-4.529Y44.613
+    "\002\357\002\003\020\100\024\256\207\300\323\115\062\102\362\022\012"    // X-4.240Y44.576
+    "\002\360\002\003\020\100\217\302\175\300\327\043\062\102\217\234\012"    // X-3.965Y44.535
+    "\002\361\002\003\020\100\364\375\154\300\274\364\061\102\203\207\012"    // X-3.703Y44.489
+    "\002\362\002\003\020\100\033\057\135\300\217\302\061\102\166\240\012"    // X-3.456Y44.440
+    "\002\363\002\003\020\100\053\207\116\300\120\215\061\102\150\052\012"    // X-3.227Y44.388
+    "\002\364\002\003\020\100\376\324\100\300\370\123\061\102\356\377\012"    // X-3.013Y44.332
+    "\002\365\002\003\020\100\061\010\064\300\215\027\061\102\155\101\012"    // X-2.813Y44.273
+    "\002\366\002\003\020\100\211\101\050\300\020\112\327\060\102\341\237\012"    // X-2.629Y44.210
+    "\002\367\002\003\020\100\102\140\035\300\165\223\060\102\206\254\012"    // X-2.459Y44.144
+    "\002\370\002\003\020\100\037\205\023\300\307\113\060\102\016\023\012"    // X-2.305Y44.074
+    "\002\371\002\003\020\100\041\260\020\112\300\006\001\060\102\206\245\012"    // X-2.167Y44.001
+    "\002\372\002\003\020\100\345\320\002\300\063\263\057\102\003\011\012"    // X-2.044Y43.925
+    "\002\373\002\003\020\100\142\020\120\370\277\110\141\057\102\245\176\012"    // X-1.938Y43.845
+    "\002\374\002\003\020\100\177\152\354\277\112\014\057\102\146\102\012"    // X-1.847Y43.762
+    "\002\375\002\003\020\100\252\361\342\277\063\263\056\102\273\070\012"    // X-1.773Y43.675
+    "\002\376\002\003\020\100\037\205\333\277\020\120\130\056\102\134\020\120\012"    // X-1.715Y43.586
+    "\002\377\002\003\020\100\335\044\326\277\333\371\055\102\267\326\012"    // X-1.673Y43.494
+    "\002\020\100\002\003\020\100\345\320\322\277\215\227\055\102\164\211\012"    // X-1.647Y43.398
+    "\002\001\002\003\020\100\374\251\321\277\055\062\055\102\353\063\012"    // X-1.638Y43.299
+    "\002\002\002\003\020\100\134\217\322\277\301\312\054\102\264\003\012"    // X-1.645Y43.198
+    "\002\003\002\003\020\100\102\140\325\277\102\140\054\102\226\305\012"    // X-1.667Y43.094
+    "\002\004\002\003\020\100\065\136\332\277\260\362\053\102\044\351\012"    // X-1.706Y42.987
+    "\002\005\002\003\020\100\163\150\341\277\014\202\053\102\047\356\012"    // X-1.761Y42.877
+    "\002\006\002\003\020\100\372\176\352\277\134\017\053\102\374\026\012"    // X-1.832Y42.765
+    "\002\007\002\003\020\100\006\201\365\277\232\231\052\102\320\136\012"    // X-1.918Y42.650
+    "\002\010\002\003\020\100\114\067\001\300\305\040\052\102\027\127\012"    // X-2.019Y42.532
+    "\002\011\002\003\020\100\327\243\010\300\343\245\051\102\160\302\012"    // X-2.135Y42.412
+    "\002\020\112\002\003\020\100\207\026\021\300\366\050\051\102\327\013\012"    // X-2.267Y42.290
+    "\002\013\002\003\020\100\065\136\032\300\374\251\050\102\112\346\012"    // X-2.412Y42.166
+    "\002\014\002\003\020\100\246\233\044\300\360\047\050\102\265\051\012"    // X-2.572Y42.039
+    "\002\020\115\002\003\020\100\250\306\073\300\262\035\047\102\145\372\012"    // X-2.934Y41.779
+    "\002\016\002\003\020\100\165\223\110\300\201\225\046\102\310\221\012"    // X-3.134Y41.646
+    "\002\017\002\003\020\100\077\065\126\300\104\013\046\102\305\147\012"    // X-3.347Y41.511
+    "\002\020\120\002\003\020\100\020\112\327\163\300\244\360\044\102\066\262\012"    // X-3.810Y41.235
+    "\002\021\002\003\020\100\124\343\201\300\110\141\044\102\120\342\012"    // X-4.059Y41.095
+    "\002\022\002\003\020\100\077\065\212\300\337\317\043\102\211\067\012"    // X-4.319Y40.953
+    "\002\023\002\003\020\100\331\316\233\300\360\247\042\102\306\035\012"    // X-4.869Y40.664
+    "\002\024\002\003\020\100\230\156\302\300\264\110\040\102\370\027\012"    // X-6.076Y40.071
+    "\002\025\002\003\020\100\134\217\014\301\051\134\033\102\044\235\012"    // X-8.785Y38.840
+    "\002\026\002\003\020\100\130\071\022\301\144\273\032\102\052\037\012"    // X-9.139Y38.683
+    "\002\027\002\003\020\100\155\347\027\301\240\032\032\102\043\321\012"    // X-9.494Y38.526
+    "\002\030\002\003\020\100\256\107\043\301\027\331\030\102\377\124\012"    // X-10.205Y38.212
+    "\002\031\002\003\020\100\301\312\071\301\376\124\026\102\034\363\012"    // X-11.612Y37.583
+    "\002\032\002\003\020\100\244\160\143\301\073\137\021\102\256\242\012"    // X-14.215Y36.343
+    "\002\033\002\003\020\100\020\112\327\147\301\323\315\020\120\102\210\107\012"    // X-14.490Y36.201
+    "\002\034\002\003\020\100\223\030\154\301\167\076\020\120\102\044\163\012"    // X-14.756Y36.061
+    "\002\035\002\003\020\100\077\065\164\301\305\040\017\102\243\043\012"    // X-15.263Y35.782
+    "\002\036\002\003\020\100\112\014\170\301\173\224\016\102\251\345\012"    // X-15.503Y35.645
+    "\002\037\002\003\020\100\167\276\173\301\061\010\016\102\174\241\012"    // X-15.734Y35.508
+    "\002\040\002\003\020\100\354\121\201\301\274\364\014\102\256\154\012"    // X-16.165Y35.239
+    "\002\041\002\003\020\100\205\353\202\301\213\154\014\102\354\330\012"    // X-16.365Y35.106
+    "\002\042\002\003\020\100\213\154\204\301\146\346\013\102\136\244\012"    // X-16.553Y34.975
+    "\002\043\002\003\020\100\020\112\327\205\301\110\141\013\102\134\312\012"    // X-16.730Y34.845
+    "\002\044\002\003\020\100\366\050\207\301\065\336\020\112\102\020\120\052\012"    // X-16.895Y34.717
+    "\002\045\002\003\020\100\132\144\210\301\051\134\020\112\102\020\120\365\012"    // X-17.049Y34.590
+    "\002\046\002\003\020\100\037\205\211\301\051\334\011\102\312\305\012"    // X-17.190Y34.465
+    "\002\047\002\003\020\100\104\213\212\301\057\135\011\102\357\014\012"    // X-17.318Y34.341
+    "\002\050\002\003\020\100\325\170\213\301\102\340\010\102\233\305\012"    // X-17.434Y34.219
+    "\002\051\002\003\020\100\307\113\214\301\140\145\010\102\076\067\012"    // X-17.537Y34.099
+    "\002\052\002\003\020\100\014\002\215\301\213\354\007\102\337\163\012"    // X-17.626Y33.981
+    "\002\053\002\003\020\100\262\235\215\301\303\165\007\102\172\116\012"    // X-17.702Y33.865
+    "\002\054\002\003\020\100\254\034\216\301\006\001\007\102\305\063\012"    // X-17.764Y33.751
+    "\002\055\002\003\020\100\006\201\216\301\126\216\006\102\314\020\100\012"    // X-17.813Y33.639
+    "\002\056\002\003\020\100\250\306\216\301\254\034\006\102\274\070\012"    // X-17.847Y33.528
+    "\002\057\002\003\020\100\252\361\216\301\024\256\005\102\170\105\012"    // X-17.868Y33.420
+    "\002\060\002\003\020\100\020\100\020\100\217\301\217\102\005\102\327\251\012"    // X-17.875Y33.315
+    "\002\061\002\003\020\100\236\357\216\301\020\120\330\004\102\224\275\012"    // X-17.867Y33.211
+    "\002\062\002\003\020\100\217\302\216\301\244\160\004\102\215\151\012"    // X-17.845Y33.110
+    "\002\063\002\003\020\100\325\170\216\301\104\013\004\102\311\235\012"    // X-17.809Y33.011
+    "\002\064\002\003\020\100\157\022\216\301\360\247\003\102\275\225\012"    // X-17.759Y32.914
+    "\002\065\002\003\020\100\134\217\215\301\256\107\003\102\131\327\012"    // X-17.695Y32.820
+    "\002\066\002\003\020\100\221\355\214\301\171\351\002\102\050\165\012"    // X-17.616Y32.728
+    "\002\067\002\003\020\100\033\057\214\301\126\216\002\102\020\115\361\012"    // X-17.523Y32.639
+    "\002\070\002\003\020\100\004\126\213\301\077\065\002\102\337\305\012"    // X-17.417Y32.552
+    "\002\071\002\003\020\100\065\136\212\301\073\337\001\102\372\351\012"    // X-17.296Y32.468
+    "\002\072\002\003\020\100\307\113\211\301\112\214\001\102\055\235\012"    // X-17.162Y32.387
+    "\002\073\002\003\020\100\254\034\210\301\144\073\001\102\107\235\012"    // X-17.014Y32.308
+    "\002\074\002\003\020\100\345\320\206\301\221\355\020\100\102\005\131\012"    // X-16.852Y32.232
+    "\002\075\002\003\020\100\177\152\205\301\321\242\020\100\102\343\233\012"    // X-16.677Y32.159
+    "\002\076\002\003\020\100\171\351\203\301\043\133\020\100\102\313\357\012"    // X-16.489Y32.089
+    "\002\077\002\003\020\100\323\115\202\301\201\025\020\100\102\360\273\012"    // X-16.288Y32.021
+    "\002\100\002\003\020\100\232\231\200\301\343\245\377\101\113\361\012"    // X-16.075Y31.956
+    "\002\101\002\003\020\100\201\225\175\301\366\050\377\101\130\112\012"    // X-15.849Y31.895
+    "\002\102\002\003\020\100\250\306\171\301\041\260\376\101\225\102\012"    // X-15.611Y31.836
+    "\002\103\002\003\020\100\250\306\165\301\161\075\376\101\063\106\012"    // X-15.361Y31.780
+    "\002\104\002\003\020\100\201\225\161\301\345\320\375\101\360\343\012"    // X-15.099Y31.727
+    "\002\105\002\003\020\100\144\073\155\301\177\152\375\101\350\251\012"    // X-14.827Y31.677
+    "\002\106\002\003\020\100\041\260\150\301\112\014\375\101\251\010\012"    // X-14.543Y31.631
+    "\002\107\002\003\020\100\020\100\020\100\144\301\055\262\374\101\300\020\120\012"    // X-14.250Y31.587
+    "\002\110\002\003\020\100\321\042\137\301\102\140\374\101\346\026\012"    // X-13.946Y31.547
+    "\002\111\002\003\020\100\254\034\132\301\157\022\374\101\137\143\012"    // X-13.632Y31.509
+    "\002\112\002\003\020\100\252\361\124\301\315\314\373\101\135\164\012"    // X-13.309Y31.475
+    "\002\113\002\003\020\100\313\241\117\301\120\215\373\101\166\133\012"    // X-12.977Y31.444
+    "\002\114\002\003\020\100\047\061\112\301\004\126\373\101\237\307\012"    // X-12.637Y31.417
+    "\002\115\002\003\020\100\276\237\104\301\321\042\373\101\174\072\012"    // X-12.289Y31.392
+    "\002\116\002\003\020\100\221\355\076\301\317\367\372\101\375\276\012"    // X-11.933Y31.371
+    "\002\117\002\003\020\100\270\036\071\301\362\322\372\101\353\330\012"    // X-11.570Y31.353
+    "\002\120\002\003\020\100\114\067\063\301\071\264\372\101\360\371\012"    // X-11.201Y31.338
+    "\002\121\002\003\020\100\063\063\055\301\262\235\372\101\332\023\012"    // X-10.825Y31.327
+    "\002\122\002\003\020\100\240\032\047\301\120\215\372\101\334\367\012"    // X-10.444Y31.319
+    "\002\123\002\003\020\100\221\355\040\301\022\203\372\101\316\223\012"    // X-10.058Y31.314
+    "\002\124\002\003\020\100\010\254\032\301\006\201\372\101\214\161\012"    // X-9.667Y31.313
+    "\002\125\002\003\020\100\065\136\024\301\037\205\372\101\211\231\012"    // X-9.273Y31.315
+    "\002\126\002\003\020\100\347\373\020\115\301\134\217\372\101\032\371\012"    // X-8.874Y31.320
+    "\002\127\002\003\020\100\150\221\007\301\313\241\372\101\017\022\012"    // X-8.473Y31.329
+    "\002\130\002\003\020\100\240\032\001\301\136\272\372\101\030\260\012"    // X-8.069Y31.341
+    "\002\131\002\003\020\100\366\050\364\300\057\335\372\101\172\223\012"    // X-7.630Y31.358
+    "\002\132\002\003\020\100\031\004\346\300\061\010\373\101\357\226\012"    // X-7.188Y31.379
+    "\002\133\002\003\020\100\073\337\327\300\144\073\373\101\262\124\012"    // X-6.746Y31.404
+    "\002\134\002\003\020\100\055\262\311\300\311\166\373\101\275\256\012"    // X-6.303Y31.433
+    "\002\135\002\003\020\100\120\215\273\300\136\272\373\101\074\222\012"    // X-5.861Y31.466
+    "\002\136\002\003\020\100\325\170\255\300\045\006\374\101\245\255\012"    // X-5.421Y31.503
+    "\002\137\002\003\020\100\213\154\237\300\035\132\374\101\121\053\012"    // X-4.982Y31.544
+    "\002\140\002\003\020\100\325\170\221\300\106\266\374\101\135\374\012"    // X-4.546Y31.589
+    "\002\141\002\003\020\100\262\235\203\300\240\032\375\101\267\035\012"    // X-4.113Y31.638
+    "\002\142\002\003\020\100\250\306\153\300\053\207\375\101\155\152\012"    // X-3.684Y31.691
+    "\002\143\002\003\020\100\327\243\120\300\347\373\375\101\272\167\012"    // X-3.260Y31.748
+    "\002\144\002\003\020\100\362\322\065\300\325\170\376\101\346\232\012"    // X-2.841Y31.809
+    "\002\145\002\003\020\100\132\144\033\300\347\373\376\101\321\104\012"    // X-2.428Y31.873
+    "\002\146\002\003\020\100\020\120\130\001\300\067\211\377\101\330\234\012"    // X-2.021Y31.942
+    "\002\147\002\003\020\100\150\221\235\277\057\135\020\100\102\066\305\012"    // X-1.231Y32.091
+    "\002\150\002\003\020\100\207\026\131\277\033\257\020\100\102\050\036\012"    // X-0.848Y32.171
+    "\002\151\002\003\020\100\063\063\363\276\037\005\001\102\332\360\012"    // X-0.475Y32.255
+    "\002\152\002\003\020\100\256\107\341\275\073\137\001\102\025\075\012"    // X-0.110Y32.343
+    "\002\153\002\003\020\100\376\324\170\076\152\274\001\102\256\001\012"    // X0.243Y32.434
+    "\002\154\002\003\020\100\242\105\026\077\270\036\002\102\373\101\012"    // X0.587Y32.530
+    "\002\155\002\003\020\100\226\103\153\077\031\204\002\102\377\202\012"    // X0.919Y32.629
+    "\002\156\002\003\020\100\031\004\306\077\035\132\003\102\265\117\012"    // X1.547Y32.838
+    "\002\157\002\003\020\100\250\306\353\077\301\312\003\102\373\102\012"    // X1.842Y32.948
+    "\002\160\002\003\020\100\236\357\007\100\167\076\004\102\214\155\012"    // X2.124Y33.061
+    "\002\161\002\003\020\100\207\026\031\100\106\266\004\102\221\134\012"    // X2.392Y33.178
+    "\002\162\002\003\020\100\163\150\051\100\055\062\005\102\355\021\012"    // X2.647Y33.299
+    "\002\163\002\003\020\100\234\304\070\100\047\261\005\102\202\171\012"    // X2.887Y33.423
+    "\002\164\002\003\020\100\002\053\107\100\063\063\006\102\107\354\012"    // X3.112Y33.550
+    "\002\165\002\003\020\100\010\254\124\100\130\271\006\102\301\243\012"    // X3.323Y33.681
+    "\002\166\002\003\020\100\351\046\141\100\217\102\007\102\062\174\012"    // X3.518Y33.815
+    "\002\167\002\003\020\100\010\254\154\100\331\316\007\102\300\102\012"    // X3.698Y33.952
+    "\002\170\002\003\020\100\002\053\167\100\065\136\010\102\033\010\012"    // X3.862Y34.092
+    "\002\171\002\003\020\100\354\121\200\100\252\361\010\102\110\110\012"    // X4.010Y34.236
+    "\002\172\002\003\020\100\104\213\204\100\061\210\011\102\115\314\012"    // X4.142Y34.383
+    "\002\173\002\003\020\100\130\071\210\100\313\041\020\112\102\367\373\012"    // X4.257Y34.533
+    "\002\174\002\003\020\100\132\144\213\100\161\275\020\112\102\105\046\012"    // X4.356Y34.685
+    "\002\175\002\003\020\100\112\014\216\100\057\135\013\102\123\077\012"    // X4.439Y34.841
+    "\002\176\002\003\020\100\366\050\220\100\020\100\020\100\014\102\231\303\012"    // X4.505Y35.000
+    "\002\177\002\003\020\100\136\272\221\100\335\244\014\102\307\021\012"    // X4.554Y35.161
+    "\002\200\002\003\020\100\203\300\222\100\315\114\020\115\102\175\324\012"    // X4.586Y35.325
+    "\002\201\002\003\020\100\226\103\223\100\317\367\020\115\102\277\167\012"    // X4.602Y35.492
+    "\002\202\002\003\020\100\226\103\223\100\343\245\016\102\241\157\012"    // X4.602Y35.662
+    "\002\203\002\003\020\100\041\260\222\100\004\126\017\102\337\376\012"    // X4.584Y35.834
+    "\002\204\002\003\020\100\313\241\221\100\061\010\020\120\102\005\220\012"    // X4.551Y36.008
+    "\002\205\002\003\020\100\061\010\220\100\161\275\020\120\102\161\237\012"    // X4.501Y36.185
+    "\002\206\002\003\020\100\205\353\215\100\274\164\021\102\020\115\273\012"    // X4.435Y36.364
+    "\002\207\002\003\020\100\307\113\213\100\033\057\022\102\327\311\012"    // X4.353Y36.546
+    "\002\210\002\003\020\100\366\050\210\100\205\353\022\102\261\340\012"    // X4.255Y36.730
+    "\002\211\002\003\020\100\104\213\204\100\374\251\023\102\257\060\012"    // X4.142Y36.916
+    "\002\212\002\003\020\100\260\162\200\100\177\152\024\102\361\325\012"    // X4.014Y37.104
+    "\002\213\002\003\020\100\167\276\167\100\016\055\025\102\203\370\012"    // X3.871Y37.294
+    "\002\214\002\003\020\100\313\241\155\100\252\361\025\102\104\113\012"    // X3.713Y37.486
+    "\002\215\002\003\020\100\264\310\126\100\006\201\027\102\051\116\012"    // X3.356Y37.876
+    "\002\216\002\003\020\100\112\014\112\100\301\112\030\102\057\032\012"    // X3.157Y38.073
+    "\002\217\002\003\020\100\177\152\074\100\207\026\031\102\341\234\012"    // X2.944Y38.272
+    "\002\220\002\003\020\100\171\351\036\100\063\263\032\102\265\315\012"    // X2.483Y38.675
+    "\002\221\002\003\020\100\146\146\266\077\347\373\035\102\332\320\012"    // X1.425Y39.496
+    "\002\222\002\003\020\100\020\112\327\223\077\217\302\036\102\040\247\012"    // X1.155Y39.690
+    "\002\223\002\003\020\100\022\203\140\077\075\212\037\102\262\150\012"    // X0.877Y39.885
+    "\002\224\002\003\020\100\232\231\231\076\246\033\041\102\213\205\012"    // X0.300Y40.277
+    "\002\225\002\003\020\100\315\314\154\277\256\107\044\102\027\022\012"    // X-0.925Y41.070
+    "\002\226\002\003\020\100\134\217\142\300\002\253\052\102\307\076\012"    // X-3.540Y42.667
+    "\002\227\002\003\020\100\167\276\167\300\317\167\053\102\372\201\012"    // X-3.871Y42.867
+    "\002\230\002\003\020\100\311\166\206\300\226\103\054\102\117\200\012"    // X-4.202Y43.066
+    "\002\231\002\003\020\100\274\164\233\300\035\332\055\102\022\131\012"    // X-4.858Y43.463
+    "\002\232\002\003\020\100\035\132\304\300\014\002\061\102\146\223\012"    // X-6.136Y44.252
+    "\002\233\002\003\020\100\077\065\316\300\272\311\061\102\142\333\012"    // X-6.444Y44.447
+    "\002\234\002\003\020\100\236\357\327\300\150\221\062\102\002\025\012"    // X-6.748Y44.642
+    "\002\235\002\003\020\100\264\310\352\300\254\034\064\102\346\100\012"    // X-7.337Y45.028
+    "\002\236\002\003\020\100\110\341\006\301\351\046\067\102\035\363\012"    // X-8.430Y45.788
+    "\002\237\002\003\020\100\171\351\020\112\301\146\346\067\102\010\106\012"    // X-8.682Y45.975
+    "\002\240\002\003\020\100\345\320\016\301\335\244\070\102\104\045\012"    // X-8.926Y46.161
+    "\002\241\002\003\020\100\305\040\026\301\246\033\072\102\301\215\012"    // X-9.383Y46.527
+    "\002\242\002\003\020\100\067\211\031\301\376\324\072\102\213\233\012"    // X-9.596Y46.708
+    "\002\243\002\003\020\100\264\310\034\301\112\214\073\102\370\164\012"    // X-9.799Y46.887
+    "\002\244\002\003\020\100\122\270\042\301\311\366\074\102\265\147\012"    // X-10.170Y47.241
+    "\002\245\002\003\020\100\132\144\045\301\366\250\075\102\247\057\012"    // X-10.337Y47.415
+    "\002\246\002\003\020\100\124\343\047\301\027\131\076\102\273\376\012"    // X-10.493Y47.587
+    "\002\247\002\003\020\100\016\055\052\301\053\007\077\102\055\270\012"    // X-10.636Y47.757
+    "\002\250\002\003\020\100\211\101\054\301\063\263\077\102\234\101\012"    // X-10.766Y47.925
+    "\002\251\002\003\020\100\335\044\056\301\057\135\100\102\337\060\012"    // X-10.884Y48.091
+    "\002\252\002\003\020\100\331\316\057\301\037\005\101\102\227\174\012"    // X-10.988Y48.255
+    "\002\253\002\003\020\100\175\077\061\301\374\251\101\102\163\054\012"    // X-11.078Y48.416
+    "\002\254\002\003\020\100\341\172\062\301\323\115\102\102\023\125\012"    // X-11.155Y48.576
+    "\002\255\002\003\020\100\356\174\063\301\230\356\102\102\156\377\012"    // X-11.218Y48.733
+    "\002\256\002\003\020\100\242\105\064\301\120\215\103\102\373\140\012"    // X-11.267Y48.888
+    "\002\257\002\003\020\100\345\320\064\301\366\050\104\102\167\265\012"    // X-11.301Y49.040
+    "\002\260\002\003\020\100\351\046\065\301\217\302\104\102\234\235\012"    // X-11.322Y49.190
+    "\002\261\002\003\020\100\175\077\065\301\027\131\105\102\243\265\012"    // X-11.328Y49.337
+    "\002\262\002\003\020\100\240\032\065\301\221\355\105\102\162\037\012"    // X-11.319Y49.482
+    "\002\263\002\003\020\100\152\274\064\301\372\176\106\102\127\224\012"    // X-11.296Y49.624
+    "\002\264\002\003\020\100\335\044\064\301\120\020\115\107\102\302\337\012"    // X-11.259Y49.763
+    "\002\265\002\003\020\100\337\117\063\301\232\231\107\102\223\034\012"    // X-11.207Y49.900
+    "\002\266\002\003\020\100\161\075\062\301\313\041\110\102\071\344\012"    // X-11.140Y50.033
+    "\002\267\002\003\020\100\252\361\060\301\360\247\110\102\064\023\012"    // X-11.059Y50.164
+    "\002\270\002\003\020\100\163\150\057\301\010\054\111\102\346\345\012"    // X-10.963Y50.293
+    "\002\271\002\003\020\100\343\245\055\301\010\254\111\102\243\020\112\012"    // X-10.853Y50.418
+    "\002\272\002\003\020\100\374\251\053\301\366\050\112\102\036\273\012"    // X-10.729Y50.540
+    "\002\273\002\003\020\100\274\164\051\301\321\242\112\102\147\364\012"    // X-10.591Y50.659
+    "\002\274\002\003\020\100\045\006\047\301\232\031\113\102\215\114\012"    // X-10.439Y50.775
+    "\002\275\002\003\020\100\177\152\044\301\104\213\113\102\161\046\012"    // X-10.276Y50.886
+    "\002\276\002\003\020\100\232\231\041\301\333\371\113\102\153\013\012"    // X-10.100Y50.994
+    "\002\277\002\003\020\100\215\227\036\301\132\144\114\102\306\042\012"    // X-9.912Y51.098
+    "\002\300\002\003\020\100\051\134\033\301\315\314\114\102\245\301\012"    // X-9.710Y51.200
+    "\002\301\002\003\020\100\236\357\027\301\047\061\115\102\363\341\012"    // X-9.496Y51.298
+    "\002\302\002\003\020\100\354\121\024\301\165\223\115\102\165\236\012"    // X-9.270Y51.394
+    "\002\303\002\003\020\100\053\207\014\301\307\113\116\102\033\043\012"    // X-8.783Y51.574
+    "\002\304\002\003\020\100\035\132\010\301\327\243\116\102\265\122\012"    // X-8.522Y51.660
+    "\002\305\002\003\020\100\020\100\020\100\004\301\317\367\116\102\100\064\012"    // X-8.250Y51.742
+    "\002\306\002\003\020\100\333\371\376\300\264\110\117\102\273\325\012"    // X-7.968Y51.821
+    "\002\307\002\003\020\100\232\231\365\300\207\226\117\102\325\336\012"    // X-7.675Y51.897
+    "\002\310\002\003\020\100\155\347\353\300\102\340\117\102\044\016\012"    // X-7.372Y51.969
+    "\002\311\002\003\020\100\124\343\341\300\351\046\120\102\063\046\012"    // X-7.059Y52.038
+    "\002\312\002\003\020\100\045\006\315\300\366\250\120\102\316\144\012"    // X-6.407Y52.165
+    "\002\313\002\003\020\100\016\055\302\300\132\344\120\102\056\347\012"    // X-6.068Y52.223
+    "\002\314\002\003\020\100\240\032\267\300\254\034\121\102\337\160\012"    // X-5.722Y52.278
+    "\002\315\002\003\020\100\250\306\253\300\354\121\121\102\162\136\012"    // X-5.368Y52.330
+    "\002\316\002\003\020\100\047\061\240\300\022\203\121\102\063\274\012"    // X-5.006Y52.378
+    "\002\317\002\003\020\100\260\162\224\300\041\260\121\102\350\277\012"    // X-4.639Y52.422
+    "\002\320\002\003\020\100\341\172\210\300\035\332\121\102\127\252\012"    // X-4.265Y52.463
+    "\002\321\002\003\020\100\071\264\170\300\020\100\020\100\122\102\033\201\012"    // X-3.886Y52.500
+    "\002\322\002\003\020\100\142\020\120\140\300\313\041\122\102\020\115\226\012"    // X-3.501Y52.533
+    "\002\323\002\003\020\100\002\053\107\300\203\100\122\102\057\260\012"    // X-3.112Y52.563
+    "\002\324\002\003\020\100\031\004\056\300\051\134\122\102\105\024\012"    // X-2.719Y52.590
+    "\002\325\002\003\020\100\246\233\024\300\266\163\122\102\314\162\012"    // X-2.322Y52.613
+    "\002\326\002\003\020\100\335\044\366\277\053\207\122\102\341\321\012"    // X-1.923Y52.632
+    "\002\327\002\003\020\100\041\260\302\277\207\226\122\102\320\053\012"    // X-1.521Y52.647
+    "\002\330\002\003\020\100\027\331\216\277\321\242\122\102\306\114\012"    // X-1.116Y52.659
+    "\002\331\002\003\020\100\031\004\066\277\002\253\122\102\146\041\012"    // X-0.711Y52.667
+    "\002\332\002\003\020\100\343\245\233\276\041\260\122\102\134\237\012"    // X-0.304Y52.672
+    "\002\333\002\003\020\100\252\361\322\075\047\261\122\102\370\346\012"    // X0.103Y52.673
+    "\002\334\002\003\020\100\134\217\002\077\024\256\122\102\114\255\012"    // X0.510Y52.670
+    "\002\335\002\003\020\100\372\176\152\077\360\247\122\102\062\275\012"    // X0.916Y52.664
+    "\002\336\002\003\020\100\207\026\251\077\262\235\122\102\062\217\012"    // X1.321Y52.654
+    "\002\337\002\003\020\100\010\254\334\077\134\217\122\102\020\120\244\012"    // X1.724Y52.640
+    "\002\340\002\003\020\100\020\100\020\100\010\100\364\175\122\102\120\137\012"    // X2.125Y52.623
+    "\002\341\002\003\020\100\067\211\041\100\163\150\122\102\270\004\012"    // X2.524Y52.602
+    "\002\342\002\003\020\100\345\320\072\100\331\116\122\102\242\026\012"    // X2.919Y52.577
+    "\002\343\002\003\020\100\020\112\327\123\100\055\062\122\102\107\112\012"    // X3.310Y52.549
+    "\002\344\002\003\020\100\104\213\154\100\150\021\122\102\361\165\012"    // X3.696Y52.517
+    "\002\345\002\003\020\100\372\176\202\100\213\354\121\102\020\112\345\012"    // X4.078Y52.481
+    "\002\346\002\003\020\100\134\217\216\100\234\304\121\102\100\037\012"    // X4.455Y52.442
+    "\002\347\002\003\020\100\230\156\232\100\232\231\121\102\250\237\012"    // X4.826Y52.400
+    "\002\350\002\003\020\100\173\024\246\100\177\152\121\102\352\345\012"    // X5.190Y52.354
+    "\002\351\002\003\020\100\067\211\261\100\114\067\121\102\037\016\012"    // X5.548Y52.304
+    "\002\352\002\003\020\100\152\274\274\100\006\001\121\102\333\211\012"    // X5.898Y52.251
+    "\002\353\002\003\020\100\106\266\307\100\250\306\120\102\173\115\012"    // X6.241Y52.194
+    "\002\354\002\003\020\100\230\156\322\100\067\211\120\102\157\105\012"    // X6.576Y52.134
+    "\002\355\002\003\020\100\057\335\334\100\256\107\120\102\024\230\012"    // X6.902Y52.070
+    "\002\356\002\003\020\100\014\002\347\100\022\003\120\102\261\166\012"    // X7.219Y52.003
+    "\002\357\002\003\020\100\376\324\360\100\144\273\117\102\236\244\012"    // X7.526Y51.933
+    "\002\360\002\003\020\100\065\136\372\100\236\157\117\102\324\315\012"    // X7.824Y51.859
+    "\002\361\002\003\020\100\130\071\006\101\323\315\116\102\372\070\012"    // X8.389Y51.701
+    "\002\362\002\003\020\100\372\176\020\112\101\317\167\116\102\312\226\012"    // X8.656Y51.617
+    "\002\363\002\003\020\100\165\223\016\101\270\036\116\102\026\123\012"    // X8.911Y51.530
+    "\002\364\002\003\020\100\311\166\022\101\211\301\115\102\077\307\012"    // X9.154Y51.439
+    "\002\365\002\003\020\100\016\055\026\101\116\142\115\102\137\251\012"    // X9.386Y51.346
+    "\002\366\002\003\020\100\055\262\031\101\372\376\114\102\374\311\012"    // X9.606Y51.249
+    "\002\367\002\003\020\100\045\006\035\101\223\230\114\102\056\142\012"    // X9.814Y51.149
+    "\002\370\002\003\020\100\335\044\040\101\033\057\114\102\324\156\012"    // X10.009Y51.046
+    "\002\371\002\003\020\100\126\016\043\101\211\301\113\102\207\034\012"    // X10.191Y50.939
+    "\002\372\002\003\020\100\347\373\045\101\264\110\113\102\354\216\012"    // X10.374Y50.821
+    "\002\373\002\003\020\100\360\247\050\101\301\312\112\102\261\031\012"    // X10.541Y50.698
+    "\002\374\002\003\020\100\207\026\053\101\301\112\112\102\101\331\012"    // X10.693Y50.573
+    "\002\375\002\003\020\100\226\103\055\101\250\306\111\102\117\017\012"    // X10.829Y50.444
+    "\002\376\002\003\020\100\002\053\057\101\167\076\111\102\141\130\012"    // X10.948Y50.311
+    "\002\377\002\003\020\100\376\324\060\101\063\263\110\102\217\223\012"    // X11.052Y50.175
+    "\002\020\100\002\003\020\100\130\071\062\101\335\044\110\102\357\020\112\012"    // X11.139Y50.036
+    "\002\001\002\003\020\100\020\120\130\063\101\165\223\107\102\257\253\012"    // X11.209Y49.894
+    "\002\002\002\003\020\100\077\065\064\101\364\375\106\102\034\205\012"    // X11.263Y49.748
+    "\002\003\002\003\020\100\345\320\064\101\146\146\106\102\213\343\012"    // X11.301Y49.600
+    "\002\004\002\003\020\100\002\053\065\101\301\312\105\102\003\133\012"    // X11.323Y49.448
+    "\002\005\002\003\020\100\144\073\065\101\010\054\105\102\074\060\012"    // X11.327Y49.293
+    "\002\006\002\003\020\100\126\016\065\101\104\213\104\102\140\366\012"    // X11.316Y49.136
+    "\002\007\002\003\020\100\246\233\064\101\146\346\103\102\226\202\012"    // X11.288Y48.975
+    "\002\010\002\003\020\100\205\353\063\101\175\077\103\102\365\220\012"    // X11.245Y48.812
+    "\002\011\002\003\020\100\303\365\062\101\201\225\102\102\333\074\012"    // X11.185Y48.646
+    "\002\020\112\002\003\020\100\167\276\061\101\171\351\101\102\343\067\012"    // X11.109Y48.478
+    "\002\013\002\003\020\100\272\111\060\101\136\072\101\102\170\100\012"    // X11.018Y48.307
+    "\002\014\002\003\020\100\215\227\056\101\061\210\100\102\244\016\012"    // X10.912Y48.133
+    "\002\020\115\002\003\020\100\327\243\054\101\370\323\077\102\111\262\012"    // X10.790Y47.957
+    "\002\016\002\003\020\100\311\166\052\101\262\035\077\102\232\232\012"    // X10.654Y47.779
+    "\002\017\002\003\020\100\112\014\050\101\132\144\076\102\365\044\012"    // X10.503Y47.598
+    "\002\020\120\002\003\020\100\104\213\042\101\205\353\074\102\014\247\012"    // X10.159Y47.230
+    "\002\021\002\003\020\100\325\170\037\101\010\054\074\102\223\362\012"    // X9.967Y47.043
+    "\002\022\002\003\020\100\047\061\034\101\177\152\073\102\045\050\012"    // X9.762Y46.854
+    "\002\023\002\003\020\100\045\006\025\101\110\341\071\102\320\174\012"    // X9.314Y46.470
+    "\002\024\002\003\020\100\022\203\004\101\130\271\066\102\323\204\012"    // X8.282Y45.681
+    "\002\025\002\003\020\100\317\367\377\100\205\353\065\102\267\256\012"    // X7.999Y45.480
+    "\002\026\002\003\020\100\276\237\366\100\254\034\065\102\131\226\012"    // X7.707Y45.278
+    "\002\027\002\003\020\100\321\042\343\100\341\172\063\102\332\124\012"    // X7.098Y44.870
+    "\002\030\002\003\020\100\067\211\271\100\374\051\060\102\221\277\012"    // X5.798Y44.041
+    "\002\031\002\003\020\100\140\345\100\100\146\146\051\102\364\256\012"    // X3.014Y42.350
+    "\002\032\002\003\020\100\065\136\052\100\120\215\050\102\161\040\012"    // X2.662Y42.138
+    "\002\033\002\003\020\100\155\347\023\100\063\263\047\102\370\104\012"    // X2.311Y41.925
+    "\002\034\002\003\020\100\333\371\316\077\020\100\020\100\046\102\365\303\012"    // X1.617Y41.500
+    "\002\035\002\003\020\100\250\306\213\076\262\235\042\102\310\002\012"    // X0.273Y40.654
+    "\002\036\002\003\020\100\071\264\110\275\250\306\041\102\201\120\012"    // X-0.049Y40.444
+    "\002\037\002\003\020\100\110\341\272\276\236\357\040\102\043\343\012"    // X-0.365Y40.234
+    "\002\040\002\003\020\100\232\231\171\277\234\104\037\102\220\150\012"    // X-0.975Y39.817
+    "\002\041\002\003\020\100\313\241\005\300\333\371\033\102\251\124\012"    // X-2.088Y38.994
+    "\002\042\002\003\020\100\152\274\024\300\122\070\033\102\321\055\012"    // X-2.324Y38.805
+    "\002\043\002\003\020\100\226\103\043\300\317\167\032\102\226\315\012"    // X-2.551Y38.617
+    "\002\044\002\003\020\100\004\126\076\300\341\372\030\102\050\032\012"    // X-2.974Y38.245
+    "\002\045\002\003\020\100\110\341\112\300\167\076\030\102\006\115\012"    // X-3.170Y38.061
+    "\002\046\002\003\020\100\360\247\126\300\022\203\027\102\267\311\012"    // X-3.354Y37.878
+    "\002\047\002\003\020\100\317\367\153\300\142\020\120\026\102\251\216\012"    // X-3.687Y37.516
+    "\002\050\002\003\020\100\006\201\165\300\035\132\025\102\325\151\012"    // X-3.836Y37.338
+    "\002\051\002\003\020\100\077\065\176\300\343\245\024\102\040\104\012"    // X-3.972Y37.162
+    "\002\052\002\003\020\100\157\022\203\300\260\362\023\102\270\216\012"    // X-4.096Y36.987
+    "\002\053\002\003\020\100\215\227\206\300\203\100\023\102\247\304\012"    // X-4.206Y36.813
+    "\002\054\002\003\020\100\136\272\211\300\150\221\022\102\343\210\012"    // X-4.304Y36.642
+    "\002\055\002\003\020\100\177\152\214\300\132\344\021\102\150\022\012"    // X-4.388Y36.473
+    "\002\056\002\003\020\100\041\260\216\300\122\070\021\102\324\356\012"    // X-4.459Y36.305
+    "\002\057\002\003\020\100\341\172\220\300\126\216\020\120\102\023\114\012"    // X-4.515Y36.139
+    "\002\060\002\003\020\100\043\333\221\300\155\347\017\102\330\360\012"    // X-4.558Y35.976
+    "\002\061\002\003\020\100\264\310\222\300\217\102\017\102\167\352\012"    // X-4.587Y35.815
+    "\002\062\002\003\020\100\226\103\223\300\270\236\016\102\120\340\012"    // X-4.602Y35.655
+    "\002\063\002\003\020\100\307\113\223\300\364\375\020\115\102\371\112\012"    // X-4.603Y35.498
+    "\002\064\002\003\020\100\027\331\222\300\073\137\020\115\102\040\171\012"    // X-4.589Y35.343
+    "\002\065\002\003\020\100\266\363\221\300\226\303\014\102\256\005\012"    // X-4.561Y35.191
+    "\002\066\002\003\020\100\246\233\220\300\374\051\014\102\033\016\012"    // X-4.519Y35.041
+    "\002\067\002\003\020\100\264\310\216\300\157\222\013\102\224\335\012"    // X-4.462Y34.893
+    "\002\070\002\003\020\100\022\203\214\300\364\375\020\112\102\075\211\012"    // X-4.391Y34.748
+    "\002\071\002\003\020\100\301\312\211\300\205\153\020\112\102\241\077\012"    // X-4.306Y34.605
+    "\002\072\002\003\020\100\276\237\206\300\051\334\011\102\273\216\012"    // X-4.207Y34.465
+    "\002\073\002\003\020\100\014\002\203\300\331\116\011\102\250\005\012"    // X-4.094Y34.327
+    "\002\074\002\003\020\100\124\343\175\300\234\304\010\102\263\164\012"    // X-3.967Y34.192
+    "\002\075\002\003\020\100\057\335\164\300\161\075\010\102\055\362\012"    // X-3.826Y34.060
+    "\002\076\002\003\020\100\252\361\152\300\122\270\007\102\061\210\012"    // X-3.671Y33.930
+    "\002\077\002\003\020\100\047\061\140\300\106\066\007\102\273\041\012"    // X-3.503Y33.803
+    "\002\100\002\003\020\100\104\213\124\300\114\267\006\102\302\214\012"    // X-3.321Y33.679
+    "\002\101\002\003\020\100\142\020\120\110\300\144\073\006\102\150\116\012"    // X-3.126Y33.558
+    "\002\102\002\003\020\100\345\320\072\300\217\302\005\102\302\173\012"    // X-2.919Y33.440
+    "\002\103\002\003\020\100\010\254\054\300\307\113\005\102\021\121\012"    // X-2.698Y33.324
+    "\002\104\002\003\020\100\362\322\035\300\027\331\004\102\005\324\012"    // X-2.466Y33.212
+    "\002\105\002\003\020\100\335\044\016\300\163\150\004\102\357\165\012"    // X-2.221Y33.102
+    "\002\106\002\003\020\100\114\067\331\277\157\222\003\102\164\345\012"    // X-1.697Y32.893
+    "\002\107\002\003\020\100\006\201\265\277\002\053\003\102\075\206\012"    // X-1.418Y32.792
+    "\002\110\002\003\020\100\116\142\220\277\256\307\002\102\231\210\012"    // X-1.128Y32.695
+    "\002\111\002\003\020\100\317\367\123\277\155\147\002\102\257\061\012"    // X-0.828Y32.601
+    "\002\112\002\003\020\100\246\233\004\277\075\020\112\002\102\044\025\012"    // X-0.518Y32.510
+    "\002\113\002\003\020\100\203\300\112\276\041\260\001\102\045\374\012"    // X-0.198Y32.422
+    "\002\114\002\003\020\100\335\044\006\076\035\132\001\102\066\077\012"    // X0.131Y32.338
+    "\002\115\002\003\020\100\116\142\120\077\106\266\020\100\102\253\222\012"    // X0.814Y32.178
+    "\002\116\002\003\020\100\006\201\225\077\177\152\020\100\102\005\215\012"    // X1.168Y32.104
+    "\002\117\002\003\020\100\106\266\303\077\305\040\020\100\102\020\112\206\012"    // X1.529Y32.032
+    "\002\120\002\003\020\100\345\320\362\077\106\266\377\101\327\053\012"    // X1.897Y31.964
+    "\002\121\002\003\020\100\020\120\130\021\100\047\061\377\101\316\271\012"    // X2.271Y31.899
+    "\002\122\002\003\020\100\374\251\051\100\071\264\376\101\216\062\012"    // X2.651Y31.838
+    "\002\123\002\003\020\100\065\136\102\100\161\075\376\101\121\207\012"    // X3.037Y31.780
+    "\002\124\002\003\020\100\246\233\164\100\132\144\375\101\330\226\012"    // X3.822Y31.674
+    "\002\125\002\003\020\100\157\022\207\100\014\002\375\101\365\143\012"    // X4.221Y31.626
+    "\002\126\002\003\020\100\155\347\223\100\343\245\374\101\357\370\012"    // X4.622Y31.581
+    "\002\127\002\003\020\100\057\335\240\100\354\121\374\101\077\042\012"    // X5.027Y31.540
+    "\002\130\002\003\020\100\124\343\255\100\031\004\374\101\017\344\012"    // X5.434Y31.502
+    "\002\131\002\003\020\100\252\361\272\100\167\276\373\101\232\352\012"    // X5.842Y31.468
+    "\002\132\002\003\020\100\142\020\120\310\100\372\176\373\101\231\126\012"    // X6.252Y31.437
+    "\002\133\002\003\020\100\033\057\325\100\256\107\373\101\264\337\012"    // X6.662Y31.410
+    "\002\134\002\003\020\100\323\115\342\100\207\026\373\101\207\133\012"    // X7.072Y31.386
+    "\002\135\002\003\020\100\341\172\360\100\155\347\372\101\227\113\012"    // X7.515Y31.363
+    "\002\136\002\003\020\100\276\237\376\100\217\302\372\101\375\271\012"    // X7.957Y31.345
+    "\002\137\002\003\020\100\065\136\006\101\343\245\372\101\146\141\012"    // X8.398Y31.331
+    "\002\140\002\003\020\100\051\134\020\115\101\150\221\372\101\165\176\012"    // X8.835Y31.321
+    "\002\141\002\003\020\100\323\115\024\101\037\205\372\101\166\360\012"    // X9.269Y31.315
+    "\002\142\002\003\020\100\033\057\033\101\006\201\372\101\210\302\012"    // X9.699Y31.313
+    "\002\143\002\003\020\100\317\367\041\101\037\205\372\101\050\267\012"    // X10.123Y31.315
+    "\002\144\002\003\020\100\041\260\050\101\150\221\372\101\372\121\012"    // X10.543Y31.321
+    "\002\145\002\003\020\100\307\113\057\101\327\243\372\101\161\200\012"    // X10.956Y31.330
+    "\002\146\002\003\020\100\301\312\065\101\203\300\372\101\312\367\012"    // X11.362Y31.344
+    "\002\147\002\003\020\100\016\055\074\101\140\345\372\101\151\035\012"    // X11.761Y31.362
+    "\002\150\002\003\020\100\230\156\102\101\142\020\120\373\101\336\130\012"    // X12.152Y31.383
+    "\002\151\002\003\020\100\104\213\110\101\242\105\373\101\045\235\012"    // X12.534Y31.409
+    "\002\152\002\003\020\100\022\203\116\101\006\201\373\101\351\027\012"    // X12.907Y31.438
+    "\002\153\002\003\020\100\323\115\124\101\234\304\373\101\154\330\012"    // X13.269Y31.471
+    "\002\154\002\003\020\100\266\363\131\101\142\020\120\374\101\112\206\012"    // X13.622Y31.508
+    "\002\155\002\003\020\100\163\150\137\101\132\144\374\101\176\061\012"    // X13.963Y31.549
+    "\002\156\002\003\020\100\041\260\144\101\167\276\374\101\123\342\012"    // X14.293Y31.593
+    "\002\157\002\003\020\100\250\306\151\101\305\040\375\101\031\142\012"    // X14.611Y31.641
+    "\002\160\002\003\020\100\360\247\156\101\104\213\375\101\317\266\012"    // X14.916Y31.693
+    "\002\161\002\003\020\100\020\120\130\163\101\364\375\375\101\114\257\012"    // X15.209Y31.749
+    "\002\162\002\003\020\100\301\312\167\101\311\166\376\101\262\252\012"    // X15.487Y31.808
+    "\002\163\002\003\020\100\112\014\174\101\303\365\376\101\332\234\012"    // X15.753Y31.870
+    "\002\164\002\003\020\100\045\006\200\101\356\174\377\101\310\061\012"    // X16.003Y31.936
+    "\002\165\002\003\020\100\205\353\201\101\045\006\020\100\102\363\202\012"    // X16.240Y32.006
+    "\002\166\002\003\020\100\041\260\203\101\345\120\020\100\102\332\173\012"    // X16.461Y32.079
+    "\002\167\002\003\020\100\004\126\205\101\270\236\020\100\102\025\016\012"    // X16.667Y32.155
+    "\002\170\002\003\020\100\057\335\206\101\244\360\020\100\102\370\112\012"    // X16.858Y32.235
+    "\002\171\002\003\020\100\226\103\210\101\242\105\001\102\327\204\012"    // X17.033Y32.318
+    "\002\172\002\003\020\100\053\207\211\101\262\235\001\102\220\111\012"    // X17.191Y32.404
+    "\002\173\002\003\020\100\010\254\212\101\325\370\001\102\245\152\012"    // X17.334Y32.493
+    "\002\174\002\003\020\100\024\256\213\101\020\120\130\002\102\200\214\012"    // X17.460Y32.586
+    "\002\175\002\003\020\100\134\217\214\101\130\271\002\102\167\005\012"    // X17.570Y32.681
+    "\002\176\002\003\020\100\307\113\215\101\270\036\003\102\326\153\012"    // X17.662Y32.780
+    "\002\177\002\003\020\100\171\351\215\101\045\206\003\102\202\306\012"    // X17.739Y32.881
+    "\002\200\002\003\020\100\116\142\216\101\252\361\003\102\314\020\100\012"    // X17.798Y32.986
+    "\002\201\002\003\020\100\122\270\216\101\073\137\004\102\273\022\012"    // X17.840Y33.093
+    "\002\202\002\003\020\100\221\355\216\101\337\317\004\102\022\161\012"    // X17.866Y33.203
+    "\002\203\002\003\020\100\020\100\020\100\217\101\226\103\005\102\051\242\012"    // X17.875Y33.316
+    "\002\204\002\003\020\100\236\357\216\101\130\271\005\102\201\026\012"    // X17.867Y33.431
+    "\002\205\002\003\020\100\152\274\216\101\055\062\006\102\311\005\012"    // X17.842Y33.549
+    "\002\206\002\003\020\100\163\150\216\101\024\256\006\102\205\066\012"    // X17.801Y33.670
+    "\002\207\002\003\020\100\252\361\215\101\010\054\007\102\054\021\012"    // X17.743Y33.793
+    "\002\210\002\003\020\100\035\132\215\101\010\254\007\102\360\313\012"    // X17.669Y33.918
+    "\002\211\002\003\020\100\313\241\214\101\024\056\010\102\055\116\012"    // X17.579Y34.045
+    "\002\212\002\003\020\100\264\310\213\101\063\263\010\102\340\056\012"    // X17.473Y34.175
+    "\002\213\002\003\020\100\345\320\212\101\136\072\011\102\372\266\012"    // X17.352Y34.307
+    "\002\214\002\003\020\100\122\270\211\101\226\303\011\102\007\147\012"    // X17.215Y34.441
+    "\002\215\002\003\020\100\006\201\210\101\331\116\020\112\102\260\001\012"    // X17.063Y34.577
+    "\002\216\002\003\020\100\016\055\207\101\051\334\020\112\102\206\301\012"    // X16.897Y34.715
+    "\002\217\002\003\020\100\016\055\204\101\356\374\013\102\155\133\012"    // X16.522Y34.997
+    "\002\220\002\003\020\100\022\203\202\101\134\217\014\102\315\055\012"    // X16.314Y35.140
+    "\002\221\002\003\020\100\167\276\200\101\327\043\020\115\102\222\353\012"    // X16.093Y35.285
+    "\002\222\002\003\020\100\362\322\171\101\354\121\016\102\320\262\012"    // X15.614Y35.580
+    "\002\223\002\003\020\100\106\266\165\101\177\352\016\102\347\057\012"    // X15.357Y35.729
+    "\002\224\002\003\020\100\213\154\161\101\031\204\017\102\010\003\012"    // X15.089Y35.879
+    "\002\225\002\003\020\100\035\132\150\101\152\274\020\120\102\255\114\012"    // X14.522Y36.184
+    "\002\226\002\003\020\100\341\172\124\101\130\071\023\102\351\033\012"    // X13.280Y36.806
+    "\002\227\002\003\020\100\337\117\117\101\020\112\327\023\102\076\032\012"    // X12.957Y36.960
+    "\002\230\002\003\020\100\112\014\112\101\303\165\024\102\201\315\012"    // X12.628Y37.115
+    "\002\231\002\003\020\100\226\103\077\101\077\265\025\102\207\175\012"    // X11.954Y37.427
+    "\002\232\002\003\020\100\333\371\050\101\114\067\030\102\234\361\012"    // X10.561Y38.054
+    "\002\233\002\003\020\100\073\337\367\100\106\066\035\102\213\046\012"    // X7.746Y39.303
+    "\002\234\002\003\020\100\221\355\354\100\370\323\035\102\127\301\012"    // X7.404Y39.457
+    "\002\235\002\003\020\100\335\044\342\100\252\161\036\102\303\346\012"    // X7.067Y39.611
+    "\002\236\002\003\020\100\207\026\315\100\366\250\037\102\034\202\012"    // X6.409Y39.915
+    "\002\237\002\003\020\100\006\201\245\100\104\013\042\102\033\147\012"    // X5.172Y40.511
+    "\002\240\002\003\020\100\211\101\234\100\305\240\042\102\321\376\012"    // X4.883Y40.657
+    "\002\241\002\003\020\100\307\113\223\100\077\065\043\102\066\364\012"    // X4.603Y40.802
+    "\002\242\002\003\020\100\065\136\202\100\027\131\044\102\152\347\012"    // X4.074Y41.087
+    "\002\243\002\003\020\100\315\314\164\100\163\350\044\102\230\020\115\012"    // X3.825Y41.227
+    "\002\244\002\003\020\100\313\241\145\100\303\165\045\102\244\173\012"    // X3.588Y41.365
+    "\002\245\002\003\020\100\325\170\111\100\104\213\046\102\050\256\012"    // X3.148Y41.636
+    "\002\246\002\003\020\100\246\233\074\100\165\023\047\102\306\255\012"    // X2.947Y41.769
+    "\002\247\002\003\020\100\327\243\060\100\232\231\047\102\060\064\012"    // X2.760Y41.900
+    "\002\250\002\003\020\100\244\160\045\100\262\035\050\102\352\332\012"    // X2.585Y42.029
+    "\002\251\002\003\020\100\063\063\033\100\276\237\050\102\373\156\012"    // X2.425Y42.156
+    "\002\252\002\003\020\100\301\312\021\100\270\036\051\102\333\063\012"    // X2.278Y42.280
+    "\002\253\002\003\020\100\020\120\130\011\100\246\233\051\102\150\303\012"    // X2.146Y42.402
+    "\002\254\002\003\020\100\301\312\001\100\207\026\052\102\224\046\012"    // X2.028Y42.522
+    "\002\255\002\003\020\100\053\207\366\077\126\216\052\102\357\335\012"    // X1.926Y42.639
+    "\002\256\002\003\020\100\132\144\353\077\031\004\053\102\321\316\012"    // X1.839Y42.754
+    "\002\257\002\003\020\100\016\055\342\077\311\166\053\102\004\251\012"    // X1.767Y42.866
+    "\002\260\002\003\020\100\014\002\333\077\155\347\053\102\356\356\012"    // X1.711Y42.976
+    "\002\261\002\003\020\100\124\343\325\077\376\124\054\102\177\173\012"    // X1.671Y43.083
+    "\002\262\002\003\020\100\041\260\322\077\175\277\054\102\042\152\012"    // X1.646Y43.187
+    "\002\263\002\003\020\100\374\251\321\077\360\047\055\102\226\335\012"    // X1.638Y43.289
+    "\002\264\002\003\020\100\134\217\322\077\112\214\055\102\020\120\206\012"    // X1.645Y43.387
+    "\002\265\002\003\020\100\313\241\325\077\230\356\055\102\027\246\012"    // X1.669Y43.483
+    "\002\266\002\003\020\100\203\300\332\077\323\115\056\102\346\104\012"    // X1.709Y43.576
+    "\002\267\002\003\020\100\205\353\341\077\366\250\056\102\145\316\012"    // X1.765Y43.665
+    "\002\270\002\003\020\100\226\103\353\077\014\002\057\102\155\106\012"    // X1.838Y43.752
+    "\002\271\002\003\020\100\053\207\366\077\020\112\127\057\102\222\331\012"    // X1.926Y43.835
+    "\002\272\002\003\020\100\205\353\001\100\366\250\057\102\032\033\012"    // X2.030Y43.915
+    "\002\273\002\003\020\100\232\231\011\100\317\367\057\102\270\270\012"    // X2.150Y43.992
+    "\002\274\002\003\020\100\323\115\022\100\217\102\060\102\172\056\012"    // X2.286Y44.065
+    "\002\275\002\003\020\100\061\010\034\100\075\212\060\102\227\145\012"    // X2.438Y44.135
+    "\002\276\002\003\020\100\122\270\046\100\331\316\060\102\111\361\012"    // X2.605Y44.202
+    "\002\277\002\003\020\100\065\136\062\100\134\017\061\102\364\136\012"    // X2.787Y44.265
+    "\002\300\002\003\020\100\333\371\076\100\307\113\061\102\312\351\012"    // X2.984Y44.324
+    "\002\301\002\003\020\100\341\172\114\100\037\205\061\102\216\220\012"    // X3.195Y44.380
+    "\002\302\002\003\020\100\252\361\132\100\144\273\061\102\023\100\012"    // X3.421Y44.433
+    "\002\303\002\003\020\100\323\115\152\100\213\354\061\102\252\256\012"    // X3.661Y44.481
+    "\002\304\002\003\020\100\134\217\172\100\240\032\062\102\040\243\012"    // X3.915Y44.526
+    "\002\305\002\003\020\100\362\322\205\100\242\105\062\102\030\163\012"    // X4.182Y44.568
+    "\002\306\002\003\020\100\016\055\216\100\171\151\062\102\325\011\012"    // X4.443Y44.603
+    "\002\307\002\003\020\100\027\331\226\100\075\212\062\102\211\312\012"    // X4.714Y44.635
+    "\002\310\002\003\020\100\073\337\237\100\351\246\062\102\047\313\012"    // X4.996Y44.663
+    "\002\311\002\003\020\100\175\077\251\100\203\300\062\102\165\034\012"    // X5.289Y44.688
+    "\002\312\002\003\020\100\171\351\262\100\020\112\327\062\102\126\307\012"    // X5.591Y44.710
+    "\002\313\002\003\020\100\057\335\274\100\171\351\062\102\151\220\012"    // X5.902Y44.728
+    "\002\314\002\003\020\100\321\042\307\100\325\370\062\102\346\271\012"    // X6.223Y44.743
+    "\002\315\002\003\020\100\374\251\321\100\031\004\063\102\270\271\012"    // X6.552Y44.754
+    "\002\316\002\003\020\100\341\172\334\100\112\014\063\102\036\107\012"    // X6.890Y44.762
+    "\002\317\002\003\020\100\037\205\347\100\142\020\120\063\102\047\132\012"    // X7.235Y44.766
+    "\002\320\002\003\020\100\264\310\362\100\150\021\063\102\052\037\012"    // X7.587Y44.767
+    "\002\321\002\003\020\100\242\105\376\100\126\016\063\102\321\020\112\012"    // X7.946Y44.764
+    "\002\322\002\003\020\100\333\371\004\101\061\010\063\102\344\101\012"    // X8.311Y44.758
+    "\002\323\002\003\020\100\221\355\020\112\101\364\375\062\102\121\147\012"    // X8.683Y44.748
+    "\002\324\002\003\020\100\252\361\020\120\101\244\360\062\102\225\061\012"    // X9.059Y44.735
+    "\002\325\002\003\020\100\075\020\112\027\101\065\336\062\102\327\264\012"    // X9.440Y44.717
+    "\002\326\002\003\020\100\114\067\035\101\272\311\062\102\067\274\012"    // X9.826Y44.697
+    "\002\327\002\003\020\100\274\164\043\101\041\260\062\102\227\306\012"    // X10.216Y44.672
+    "\002\330\002\003\020\100\136\272\051\101\165\223\062\102\050\210\012"    // X10.608Y44.644
+    "\002\331\002\003\020\100\142\020\120\060\101\266\163\062\102\130\060\012"    // X11.004Y44.613
+    "\002\332\002\003\020\100\177\152\066\101\337\117\062\102\270\276\012"    // X11.401Y44.578
+    "\002\333\002\003\020\100\315\314\074\101\360\047\062\102\164\272\012"    // X11.800Y44.539
+    "\002\334\002\003\020\100\313\241\111\101\315\314\061\102\205\175\012"    // X12.602Y44.450
+    "\002\335\002\003\020\100\112\014\120\101\232\231\061\102\351\050\012"    // X13.003Y44.400
+    "\002\336\002\003\020\100\260\162\126\101\124\143\061\102\342\377\012"    // X13.403Y44.347
+    "\002\337\002\003\020\100\027\331\134\101\360\047\061\102\256\124\012"    // X13.803Y44.289
+    "\002\340\002\003\020\100\114\067\143\101\177\352\060\102\323\235\012"    // X14.201Y44.229
+    "\002\341\002\003\020\100\067\211\151\101\360\247\060\102\321\350\012"    // X14.596Y44.164
+    "\002\342\002\003\020\100\020\112\327\157\101\116\142\060\102\204\066\012"    // X14.990Y44.096
+    "\002\343\002\003\020\100\211\101\174\101\307\313\057\102\311\367\012"    // X15.766Y43.949
+    "\002\344\002\003\020\100\033\057\201\101\341\172\057\102\144\067\012"    // X16.148Y43.870
+    "\002\345\002\003\020\100\063\063\204\101\343\045\057\102\045\350\012"    // X16.525Y43.787
+    "\002\346\002\003\020\100\240\032\212\101\252\161\056\102\267\014\012"    // X17.263Y43.611
+    "\002\347\002\003\020\100\347\373\214\101\157\022\056\102\263\336\012"    // X17.623Y43.518
+    "\002\350\002\003\020\100\331\316\217\101\033\257\055\102\056\232\012"    // X17.976Y43.421
+    "\002\351\002\003\020\100\272\111\225\101\065\336\054\102\260\273\012"    // X18.661Y43.217
+    "\002\352\002\003\020\100\221\355\227\101\236\157\054\102\307\241\012"    // X18.991Y43.109
+    "\002\353\002\003\020\100\006\201\232\101\372\376\053\102\020\120\117\012"    // X19.313Y42.999
+    "\002\354\002\003\020\100\014\002\235\101\067\211\053\102\247\272\012"    // X19.626Y42.884
+    "\002\355\002\003\020\100\230\156\237\101\150\021\053\102\366\154\012"    // X19.929Y42.767
+    "\002\356\002\003\020\100\264\310\241\101\173\224\052\102\123\253\012"    // X20.223Y42.645
+    "\002\357\002\003\020\100\112\014\244\101\201\025\052\102\344\164\012"    // X20.506Y42.521
+    "\002\360\002\003\020\100\370\123\250\101\112\014\051\102\053\052\012"    // X21.041Y42.262
+    "\002\361\002\003\020\100\004\126\252\101\014\202\050\102\354\335\012"    // X21.292Y42.127
+    "\002\362\002\003\020\100\175\077\254\101\303\365\047\102\255\016\012"    // X21.531Y41.990
+    "\002\363\002\003\020\100\142\020\120\256\101\140\145\047\102\142\217\012"    // X21.758Y41.849
+    "\002\364\002\003\020\100\301\312\257\101\345\320\046\102\166\171\012"    // X21.974Y41.704
+    "\002\365\002\003\020\100\163\150\261\101\136\072\046\102\020\115\371\012"    // X22.176Y41.557
+    "\002\366\002\003\020\100\221\355\262\101\305\240\045\102\230\055\012"    // X22.366Y41.407
+    "\002\367\002\003\020\100\035\132\264\101\022\003\045\102\350\271\012"    // X22.544Y41.253
+    "\002\370\002\003\020\100\374\251\265\101\124\143\044\102\004\316\012"    // X22.708Y41.097
+    "\002\371\002\003\020\100\073\337\266\101\175\277\043\102\307\247\012"    // X22.859Y40.937
+    "\002\372\002\003\020\100\317\367\267\101\232\031\043\102\270\202\012"    // X22.996Y40.775
+    "\002\373\002\003\020\100\266\363\270\101\236\157\042\102\145\377\012"    // X23.119Y40.609
+    "\002\374\002\003\020\100\376\324\271\101\226\303\041\102\133\065\012"    // X23.229Y40.441
+    "\002\375\002\003\020\100\232\231\272\101\165\023\041\102\137\067\012"    // X23.325Y40.269
+    "\002\376\002\003\020\100\211\101\273\101\110\141\040\102\124\300\012"    // X23.407Y40.095
+    "\002\377\002\003\020\100\315\314\273\101\016\255\037\102\127\164\012"    // X23.475Y39.919
+    "\002\020\100\002\003\020\100\144\073\274\101\274\364\036\102\017\207\012"    // X23.529Y39.739
+    "\002\001\002\003\020\100\150\221\274\101\374\051\036\102\325\352\012"    // X23.571Y39.541
+    "\002\002\002\003\020\100\250\306\274\101\057\135\035\102\214\165\012"    // X23.597Y39.341
+    "\002\003\002\003\020\100\027\331\274\101\112\214\034\102\366\055\012"    // X23.606Y39.137
+    "\002\004\002\003\020\100\301\312\274\101\122\270\033\102\374\142\012"    // X23.599Y38.930
+    "\002\005\002\003\020\100\232\231\274\101\116\342\032\102\374\260\012"    // X23.575Y38.721
+    "\002\006\002\003\020\100\242\105\274\101\061\010\032\102\013\017\012"    // X23.534Y38.508
+    "\002\007\002\003\020\100\345\320\273\101\010\054\031\102\031\300\012"    // X23.477Y38.293
+    "\002\010\002\003\020\100\144\073\273\101\315\114\030\102\337\235\012"    // X23.404Y38.075
+    "\002\011\002\003\020\100\037\205\272\101\205\153\027\102\142\205\012"    // X23.315Y37.855
+    "\002\020\112\002\003\020\100\041\260\271\101\053\207\026\102\267\030\012"    // X23.211Y37.632
+    "\002\013\002\003\020\100\136\272\270\101\276\237\025\102\251\001\012"    // X23.091Y37.406
+    "\002\014\002\003\020\100\327\243\267\101\106\266\024\102\066\105\012"    // X22.955Y37.178
+    "\002\020\115\002\003\020\100\244\160\266\101\301\312\023\102\235\132\012"    // X22.805Y36.948
+    "\002\016\002\003\020\100\270\036\265\101\057\335\022\102\001\357\012"    // X22.640Y36.716
+    "\002\017\002\003\020\100\335\044\262\101\333\371\020\120\102\050\042\012"    // X22.268Y36.244
+    "\002\020\120\002\003\020\100\356\174\260\101\037\005\020\120\102\056\225\012"    // X22.061Y36.005
+    "\002\021\002\003\020\100\136\272\256\101\134\017\017\102\335\101\012"    // X21.841Y35.765
+    "\002\022\002\003\020\100\171\351\252\101\254\034\020\115\102\232\057\012"    // X21.364Y35.278
+    "\002\023\002\003\020\100\047\061\242\101\321\042\011\102\210\317\012"    // X20.274Y34.284
+    "\002\024\002\003\020\100\315\314\237\101\276\037\010\102\042\273\012"    // X19.975Y34.031
+    "\002\025\002\003\020\100\020\120\130\235\101\254\034\007\102\163\261\012"    // X19.668Y33.778
+    "\002\026\002\003\020\100\144\073\230\101\150\021\005\102\162\176\012"    // X19.029Y33.267
+    "\002\027\002\003\020\100\051\134\215\101\236\357\020\100\102\032\221\012"    // X17.670Y32.234
+    "\002\030\002\003\020\100\053\207\212\101\301\312\377\101\040\060\012"    // X17.316Y31.974
+    "\002\031\002\003\020\100\010\254\207\101\071\264\375\101\067\124\012"    // X16.959Y31.713
+    "\002\032\002\003\020\100\124\343\201\101\037\205\371\101\031\177\012"    // X16.236Y31.190
+    "\002\033\002\003\020\100\004\126\154\101\270\036\361\101\232\103\012"    // X14.771Y30.140
+    "\002\034\002\003\020\100\341\172\146\101\031\004\357\101\325\361\012"    // X14.405Y29.877
+    "\002\035\002\003\020\100\327\243\140\101\171\351\354\101\025\075\012"    // X14.040Y29.614
+    "\002\036\002\003\020\100\240\032\125\101\106\266\350\101\227\274\012"    // X13.319Y29.089
+    "\002\037\002\003\020\100\234\304\076\101\020\120\130\340\101\356\147\012"    // X11.923Y28.043
+    "\002\040\002\003\020\100\163\150\071\101\226\103\336\101\212\264\012"    // X11.588Y27.783
+    "\002\041\002\003\020\100\366\050\064\101\047\061\334\101\020\100\306\012"    // X11.260Y27.524
+    "\002\042\002\003\020\100\031\004\052\101\142\020\120\330\101\065\143\012"    // X10.626Y27.008
+    "\002\043\002\003\020\100\351\046\045\101\031\004\326\101\035\006\012"    // X10.322Y26.752
+    "\002\044\002\003\020\100\230\156\040\101\333\371\323\101\363\364\012"    // X10.027Y26.497
+    "\002\045\002\003\020\100\325\170\027\101\205\353\317\101\335\232\012"    // X9.467Y25.990
+    "\002\046\002\003\020\100\175\077\023\101\155\347\315\101\122\327\012"    // X9.203Y25.738
+    "\002\047\002\003\020\100\114\067\017\101\155\347\313\101\104\375\012"    // X8.951Y25.488
+    "\002\050\002\003\020\100\106\266\007\101\236\357\307\101\134\211\012"    // X8.482Y24.992
+    "\002\051\002\003\020\100\211\101\004\101\333\371\305\101\376\345\012"    // X8.266Y24.747
+    "\002\052\002\003\020\100\045\006\001\101\045\006\304\101\323\061\012"    // X8.064Y24.503
+    "\002\053\002\003\020\100\146\146\366\100\002\053\300\101\205\042\012"    // X7.700Y24.021
+    "\002\054\002\003\020\100\232\231\361\100\132\144\276\101\366\361\012"    // X7.550Y23.799
+    "\002\055\002\003\020\100\033\057\355\100\276\237\274\101\075\061\012"    // X7.412Y23.578
+    "\002\056\002\003\020\100\114\067\351\100\073\337\272\101\337\114\012"    // X7.288Y23.359
+    "\002\057\002\003\020\100\374\251\345\100\335\044\271\101\235\264\012"    // X7.177Y23.143
+    "\002\060\002\003\020\100\053\207\342\100\213\154\267\101\115\060\012"    // X7.079Y22.928
+    "\002\061\002\003\020\100\020\112\327\337\100\122\270\265\101\231\020\100\012"    // X6.995Y22.715
+    "\002\062\002\003\020\100\232\231\335\100\061\010\264\101\327\256\012"    // X6.925Y22.504
+    "\002\063\002\003\020\100\250\306\333\100\051\134\262\101\213\077\012"    // X6.868Y22.295
+    "\002\064\002\003\020\100\230\156\332\100\106\266\260\101\260\356\012"    // X6.826Y22.089
+    "\002\065\002\003\020\100\067\211\331\100\157\022\257\101\201\313\012"    // X6.798Y21.884
+    "\002\066\002\003\020\100\207\026\331\100\274\164\255\101\136\037\012"    // X6.784Y21.682
+    "\002\067\002\003\020\100\270\036\331\100\057\335\253\101\160\304\012"    // X6.785Y21.483
+    "\002\070\002\003\020\100\232\231\331\100\256\107\252\101\245\266\012"    // X6.800Y21.285
+    "\002\071\002\003\020\100\053\207\332\100\136\272\250\101\141\332\012"    // X6.829Y21.091
+    "\002\072\002\003\020\100\236\357\333\100\033\057\247\101\044\030\012"    // X6.873Y20.898
+    "\002\073\002\003\020\100\301\312\335\100\374\251\245\101\030\251\012"    // X6.931Y20.708
+    "\002\074\002\003\020\100\223\030\340\100\002\053\244\101\317\376\012"    // X7.003Y20.521
+    "\002\075\002\003\020\100\110\341\342\100\041\260\242\101\030\034\012"    // X7.090Y20.336
+    "\002\076\002\003\020\100\254\034\346\100\144\073\241\101\301\351\012"    // X7.191Y20.154
+    "\002\077\002\003\020\100\301\312\351\100\315\314\237\101\171\115\012"    // X7.306Y19.975
+    "\002\100\002\003\020\100\124\343\355\100\132\144\236\101\204\241\012"    // X7.434Y19.799
+    "\002\101\002\003\020\100\311\166\362\100\020\100\020\100\235\101\152\001\012"    // X7.577Y19.625
+    "\002\102\002\003\020\100\274\164\367\100\313\241\233\101\024\122\012"    // X7.733Y19.454
+    "\002\103\002\003\020\100\140\345\374\100\272\111\232\101\022\237\012"    // X7.903Y19.286
+    "\002\104\002\003\020\100\051\134\001\101\317\367\230\101\072\351\012"    // X8.085Y19.121
+    "\002\105\002\003\020\100\372\176\004\101\010\254\227\101\103\005\012"    // X8.281Y18.959
+    "\002\106\002\003\020\100\362\322\007\101\146\146\226\101\020\115\156\012"    // X8.489Y18.800
+    "\002\107\002\003\020\100\051\134\013\101\351\046\225\101\210\136\012"    // X8.710Y18.644
+    "\002\110\002\003\020\100\207\026\017\101\221\355\223\101\206\306\012"    // X8.943Y18.491
+    "\002\111\002\003\020\100\014\002\023\101\136\272\222\101\042\206\012"    // X9.188Y18.341
+    "\002\112\002\003\020\100\102\140\033\101\163\150\220\101\231\126\012"    // X9.711Y18.051
+    "\002\113\002\003\020\100\362\322\037\101\256\107\217\101\270\122\012"    // X9.989Y17.910
+    "\002\114\002\003\020\100\260\162\044\101\033\057\216\101\313\106\012"    // X10.278Y17.773
+    "\002\115\002\003\020\100\335\044\056\101\142\020\120\214\101\046\155\012"    // X10.884Y17.508
+    "\002\116\002\003\020\100\114\067\063\101\112\014\213\101\171\111\012"    // X11.201Y17.381
+    "\002\117\002\003\020\100\230\156\070\101\126\016\212\101\271\170\012"    // X11.527Y17.257
+    "\002\120\002\003\020\100\175\077\103\101\351\046\210\101\177\334\012"    // X12.203Y17.019
+    "\002\121\002\003\020\100\376\324\110\101\161\075\207\101\140\232\012"    // X12.552Y16.905
+    "\002\122\002\003\020\100\053\207\116\101\051\134\206\101\302\061\012"    // X12.908Y16.795
+    "\002\123\002\003\020\100\130\071\132\101\010\254\204\101\335\122\012"    // X13.639Y16.584
+    "\002\124\002\003\020\100\047\061\140\101\073\337\203\101\201\246\012"    // X14.012Y16.484
+    "\002\125\002\003\020\100\161\075\146\101\223\030\203\101\003\375\012"    // X14.390Y16.387
+    "\002\126\002\003\020\100\104\213\162\101\313\241\201\101\176\117\012"    // X15.159Y16.204
+    "\002\127\002\003\020\100\234\304\170\101\252\361\200\101\252\367\012"    // X15.548Y16.118
+    "\002\130\002\003\020\100\075\020\112\177\101\256\107\200\101\001\057\012"    // X15.940Y16.035
+    "\002\131\002\003\020\100\376\324\205\101\173\024\176\101\036\250\012"    // X16.729Y15.880
+    "\002\132\002\003\020\100\014\002\211\101\221\355\174\101\342\163\012"    // X17.126Y15.808
+    "\002\133\002\003\020\100\016\055\214\101\362\322\173\101\042\352\012"    // X17.522Y15.739
+    "\002\134\002\003\020\100\037\205\222\101\301\312\171\101\036\157\012"    // X18.315Y15.612
+    "\002\135\002\003\020\100\010\254\225\101\057\335\170\101\316\310\012"    // X18.709Y15.554
+    "\002\136\002\003\020\100\345\320\230\101\347\373\167\101\172\141\012"    // X19.102Y15.499
+    "\002\137\002\003\020\100\236\357\233\101\002\053\167\101\023\104\012"    // X19.492Y15.448
+    "\002\140\002\003\020\100\061\010\237\101\177\152\166\101\162\064\012"    // X19.879Y15.401
+    "\002\141\002\003\020\100\240\032\242\101\106\266\165\101\216\034\012"    // X20.263Y15.357
+    "\002\142\002\003\020\100\321\042\245\101\126\016\165\101\126\240\012"    // X20.642Y15.316
+    "\002\143\002\003\020\100\321\042\250\101\311\166\164\101\211\275\012"    // X21.017Y15.279
+    "\002\144\002\003\020\100\223\030\253\101\205\353\163\101\306\052\012"    // X21.387Y15.245
+    "\002\145\002\003\020\100\266\363\255\101\244\160\163\101\172\020\115\012"    // X21.744Y15.215
+    "\002\146\002\003\020\100\217\302\260\101\045\006\163\101\077\143\012"    // X22.095Y15.189
+    "\002\147\002\003\020\100\037\205\263\101\360\247\162\101\354\007\012"    // X22.440Y15.166
+    "\002\150\002\003\020\100\130\071\266\101\004\126\162\101\007\107\012"    // X22.778Y15.146
+    "\002\151\002\003\020\100\073\337\270\101\142\020\120\162\101\234\351\012"    // X23.109Y15.129
+    "\002\152\002\003\020\100\260\162\273\101\043\333\161\101\265\275\012"    // X23.431Y15.116
+    "\002\153\002\003\020\100\317\367\275\101\055\262\161\101\021\057\012"    // X23.746Y15.106
+    "\002\154\002\003\020\100\177\152\300\101\201\225\161\101\102\107\012"    // X24.052Y15.099
+    "\002\155\002\003\020\100\301\312\302\101\037\205\161\101\222\010\012"    // X24.349Y15.095
+    "\002\156\002\003\020\100\207\026\305\101\037\205\161\101\122\240\012"    // X24.636Y15.095
+    "\002\157\002\003\020\100\337\117\307\101\120\215\161\101\121\057\012"    // X24.914Y15.097
+    "\002\160\002\003\020\100\260\162\311\101\343\245\161\101\326\051\012"    // X25.181Y15.103
+    "\002\161\002\003\020\100\006\201\313\101\301\312\161\101\023\020\100\012"    // X25.438Y15.112
+    "\002\162\002\003\020\100\325\170\315\101\317\367\161\101\007\127\012"    // X25.684Y15.123
+    "\002\163\002\003\020\100\035\132\317\101\077\065\162\101\045\106\012"    // X25.919Y15.138
+    "\002\164\002\003\020\100\321\042\321\101\372\176\162\101\336\073\012"    // X26.142Y15.156
+    "\002\165\002\003\020\100\376\324\322\101\376\324\162\101\360\152\012"    // X26.354Y15.177
+    "\002\166\002\003\020\100\213\154\324\101\063\063\163\101\127\347\012"    // X26.553Y15.200
+    "\002\167\002\003\020\100\205\353\325\101\313\241\163\101\371\201\012"    // X26.740Y15.227
+    "\002\170\002\003\020\100\337\117\327\101\223\030\164\101\212\116\012"    // X26.914Y15.256
+    "\002\171\002\003\020\100\246\233\330\101\246\233\164\101\367\023\012"    // X27.076Y15.288
+    "\002\172\002\003\020\100\315\314\331\101\002\053\165\101\105\026\012"    // X27.225Y15.323
+    "\002\173\002\003\020\100\110\341\332\101\250\306\165\101\256\212\012"    // X27.360Y15.361
+    "\002\174\002\003\020\100\043\333\333\101\230\156\166\101\026\133\012"    // X27.482Y15.402
+    "\002\175\002\003\020\100\136\272\334\101\270\036\167\101\106\241\012"    // X27.591Y15.445
+    "\002\176\002\003\020\100\356\174\335\101\043\333\167\101\223\230\012"    // X27.686Y15.491
+    "\002\177\002\003\020\100\321\042\336\101\276\237\170\101\115\074\012"    // X27.767Y15.539
+    "\002\200\002\003\020\100\024\256\336\101\244\160\171\101\377\167\012"    // X27.835Y15.590
+    "\002\201\002\003\020\100\240\032\337\101\272\111\172\101\062\001\012"    // X27.888Y15.643
+    "\002\202\002\003\020\100\213\154\337\101\033\057\173\101\026\020\112\012"    // X27.928Y15.699
+    "\002\203\002\003\020\100\313\241\337\101\254\034\174\101\062\306\012"    // X27.954Y15.757
+    "\002\204\002\003\020\100\122\270\337\101\207\026\175\101\123\226\012"    // X27.965Y15.818
+    "\002\205\002\003\020\100\071\264\337\101\223\030\176\101\136\003\012"    // X27.963Y15.881
+    "\002\206\002\003\020\100\165\223\337\101\321\042\177\101\265\044\012"    // X27.947Y15.946
+    "\002\207\002\003\020\100\004\126\337\101\254\034\200\101\005\171\012"    // X27.917Y16.014
+    "\002\210\002\003\020\100\347\373\336\101\374\251\200\101\073\330\012"    // X27.873Y16.083
+    "\002\211\002\003\020\100\053\207\336\101\161\075\201\101\324\144\012"    // X27.816Y16.155
+    "\002\212\002\003\020\100\266\363\335\101\376\324\201\101\053\113\012"    // X27.744Y16.229
+    "\002\213\002\003\020\100\256\107\335\101\244\160\202\101\035\161\012"    // X27.660Y16.305
+    "\002\214\002\003\020\100\372\176\334\101\126\016\203\101\243\010\012"    // X27.562Y16.382
+    "\002\215\002\003\020\100\246\233\333\101\055\262\203\101\364\257\012"    // X27.451Y16.462
+    "\002\216\002\003\020\100\262\235\332\101\035\132\204\101\331\300\012"    // X27.327Y16.544
+    "\002\217\002\003\020\100\004\126\330\101\055\262\205\101\010\130\012"    // X27.042Y16.712
+    "\002\220\002\003\020\100\112\014\327\101\132\144\206\101\237\131\012"    // X26.881Y16.799
+    "\002\221\002\003\020\100\360\247\325\101\223\030\207\101\040\253\012"    // X26.707Y16.887
+    "\002\222\002\003\020\100\246\233\322\101\120\215\210\101\070\215\012"    // X26.326Y17.069
+    "\002\223\002\003\020\100\252\361\320\101\307\113\211\101\072\144\012"    // X26.118Y17.162
+    "\002\224\002\003\020\100\063\063\317\101\112\014\212\101\354\025\012"    // X25.900Y17.256
+    "\002\225\002\003\020\100\311\166\313\101\215\227\213\101\362\061\012"    // X25.433Y17.449
+    "\002\226\002\003\020\100\173\024\303\101\301\312\216\101\351\034\012"    // X24.385Y17.849
+    "\002\227\002\003\020\100\325\170\257\101\037\205\225\101\242\126\012"    // X21.934Y18.690
+    "\002\230\002\003\020\100\232\231\254\101\274\164\226\101\252\364\012"    // X21.575Y18.807
+    "\002\231\002\003\020\100\055\262\251\101\146\146\227\101\330\063\012"    // X21.212Y18.925
+    "\002\232\002\003\020\100\301\312\243\101\272\111\231\101\316\250\012"    // X20.474Y19.161
+    "\002\233\002\003\020\100\345\320\227\101\173\024\235\101\355\047\012"    // X18.977Y19.635
+    "\002\234\002\003\020\100\354\121\200\101\165\223\244\101\157\024\012"    // X16.040Y20.572
+    "\002\235\002\003\020\100\126\016\173\101\356\174\245\101\352\150\012"    // X15.691Y20.686
+    "\002\236\002\003\020\100\150\221\165\101\146\146\246\101\172\252\012"    // X15.348Y20.800
+    "\002\237\002\003\020\100\252\361\152\101\047\061\250\101\034\241\012"    // X14.684Y21.024
+    "\002\240\002\003\020\100\370\123\127\101\360\247\253\101\020\112\020\115\012"    // X13.458Y21.457
+    "\002\241\002\003\020\100\345\320\122\101\372\176\254\101\354\137\012"    // X13.176Y21.562
+    "\002\242\002\003\020\100\311\166\116\101\370\123\255\101\057\137\012"    // X12.904Y21.666
+    "\002\243\002\003\020\100\004\126\106\101\252\361\256\101\047\174\012"    // X12.396Y21.868
+    "\002\244\002\003\020\100\104\213\102\101\136\272\257\101\250\244\012"    // X12.159Y21.966
+    "\002\245\002\003\020\100\333\371\076\101\006\201\260\101\066\302\012"    // X11.936Y22.063
+    "\002\246\002\003\020\100\260\162\070\101\020\100\020\100\262\101\030\274\012"    // X11.528Y22.250
+    "\002\247\002\003\020\100\037\205\065\101\122\270\262\101\324\127\012"    // X11.345Y22.340
+    "\002\250\002\003\020\100\345\320\062\101\230\156\263\101\275\374\012"    // X11.176Y22.429
+    "\002\251\002\003\020\100\035\132\060\101\270\036\264\101\271\011\012"    // X11.022Y22.515
+    "\002\252\002\003\020\100\254\034\056\101\301\312\264\101\020\120\036\012"    // X10.882Y22.599
+    "\002\253\002\003\020\100\254\034\054\101\260\162\265\101\213\306\012"    // X10.757Y22.681
+    "\002\254\002\003\020\100\065\136\052\101\173\024\266\101\061\266\012"    // X10.648Y22.760
+    "\002\255\002\003\020\100\057\335\050\101\041\260\266\101\173\235\012"    // X10.554Y22.836
+    "\002\256\002\003\020\100\262\235\047\101\256\107\267\101\177\112\012"    // X10.476Y22.910
+    "\002\257\002\003\020\100\246\233\046\101\043\333\267\101\260\166\012"    // X10.413Y22.982
+    "\002\260\002\003\020\100\073\337\045\101\163\150\270\101\062\324\012"    // X10.367Y23.051
+    "\002\261\002\003\020\100\132\144\045\101\236\357\270\101\321\247\012"    // X10.337Y23.117
+    "\002\262\002\003\020\100\002\053\045\101\244\160\271\101\216\003\012"    // X10.323Y23.180
+    "\002\263\002\003\020\100\063\063\045\101\205\353\271\101\020\120\154\012"    // X10.325Y23.240
+    "\002\264\002\003\020\100\006\201\045\101\116\142\272\101\215\245\012"    // X10.344Y23.298
+    "\002\265\002\003\020\100\142\020\120\046\101\345\320\272\101\330\252\012"    // X10.379Y23.352
+    "\002\266\002\003\020\100\110\341\046\101\130\071\273\101\154\027\012"    // X10.430Y23.403
+    "\002\267\002\003\020\100\266\363\047\101\262\235\273\101\240\130\012"    // X10.497Y23.452
+    "\002\270\002\003\020\100\256\107\051\101\333\371\273\101\062\066\012"    // X10.580Y23.497
+    "\002\271\002\003\020\100\110\341\052\101\323\115\274\101\024\121\012"    // X10.680Y23.538
+    "\002\272\002\003\020\100\122\270\054\101\262\235\274\101\013\376\012"    // X10.795Y23.577
+    "\002\273\002\003\020\100\345\320\056\101\140\345\274\101\016\036\012"    // X10.926Y23.612
+    "\002\274\002\003\020\100\351\046\061\101\351\046\275\101\021\064\012"    // X11.072Y23.644
+    "\002\275\002\003\020\100\136\272\063\101\116\142\275\101\276\164\012"    // X11.233Y23.673
+    "\002\276\002\003\020\100\134\217\066\101\201\225\275\101\044\234\012"    // X11.410Y23.698
+    "\002\277\002\003\020\100\262\235\071\101\203\300\275\101\264\273\012"    // X11.601Y23.719
+    "\002\300\002\003\020\100\171\351\074\101\140\345\275\101\277\205\012"    // X11.807Y23.737
+    "\002\301\002\003\020\100\230\156\100\101\014\002\276\101\360\053\012"    // X12.027Y23.751
+    "\002\302\002\003\020\100\366\050\104\101\223\030\276\101\175\321\012"    // X12.260Y23.762
+    "\002\303\002\003\020\100\254\034\110\101\351\046\276\101\302\357\012"    // X12.507Y23.769
+    "\002\304\002\003\020\100\242\105\114\101\016\055\276\101\124\233\012"    // X12.767Y23.772
+    "\002\305\002\003\020\100\327\243\120\101\002\053\276\101\240\065\012"    // X13.040Y23.771
+    "\002\306\002\003\020\100\063\063\125\101\321\042\276\101\246\075\012"    // X13.325Y23.767
+    "\002\307\002\003\020\100\262\235\131\101\173\024\276\101\075\215\012"    // X13.601Y23.760
+    "\002\310\002\003\020\100\047\061\136\101\364\375\275\101\125\053\012"    // X13.887Y23.749
+    "\002\311\002\003\020\100\171\351\142\101\073\337\275\101\025\004\012"    // X14.182Y23.734
+    "\002\312\002\003\020\100\250\306\147\101\152\274\275\101\026\026\012"    // X14.486Y23.717
+    "\002\313\002\003\020\100\264\310\154\101\150\221\275\101\265\341\012"    // X14.799Y23.696
+    "\002\314\002\003\020\100\205\353\161\101\065\136\275\101\071\114\012"    // X15.120Y23.671
+    "\002\315\002\003\020\100\002\053\167\101\335\044\275\101\301\220\012"    // X15.448Y23.643
+    "\002\316\002\003\020\100\104\213\174\101\140\345\274\101\111\017\012"    // X15.784Y23.612
+    "\002\317\002\003\020\100\014\002\201\101\262\235\274\101\076\217\012"    // X16.126Y23.577
+    "\002\320\002\003\020\100\315\314\203\101\323\115\274\101\040\142\012"    // X16.475Y23.538
+    "\002\321\002\003\020\100\313\241\206\101\317\367\273\101\263\017\012"    // X16.829Y23.496
+    "\002\322\002\003\020\100\006\201\211\101\232\231\273\101\370\265\012"    // X17.188Y23.450
+    "\002\323\002\003\020\100\177\152\214\101\077\065\273\101\213\321\012"    // X17.552Y23.401
+    "\002\324\002\003\020\100\065\136\217\101\264\310\272\101\322\271\012"    // X17.921Y23.348
+    "\002\325\002\003\020\100\004\126\225\101\043\333\271\101\121\154\012"    // X18.667Y23.232
+    "\002\326\002\003\020\100\051\134\230\101\035\132\271\101\026\173\012"    // X19.045Y23.169
+    "\002\327\002\003\020\100\132\144\233\101\345\320\270\101\376\321\012"    // X19.424Y23.102
+    "\002\330\002\003\020\100\372\176\241\101\360\247\267\101\013\303\012"    // X20.187Y22.957
+    "\002\331\002\003\020\100\120\215\244\101\061\010\267\101\115\067\012"    // X20.569Y22.879
+    "\002\332\002\003\020\100\246\233\247\101\102\140\266\101\170\177\012"    // X20.951Y22.797
+    "\002\333\002\003\020\100\055\262\255\101\347\373\264\101\202\054\012"    // X21.712Y22.623
+    "\002\334\002\003\020\100\122\270\260\101\175\077\264\101\215\276\012"    // X22.090Y22.531
+    "\002\335\002\003\020\100\136\272\263\101\341\172\263\101\053\344\012"    // X22.466Y22.435
+    "\002\336\002\003\020\100\374\251\271\101\043\333\261\101\002\063\012"    // X23.208Y22.232
+    "\002\337\002\003\020\100\215\227\274\101\020\100\020\100\261\101\133\326\012"    // X23.574Y22.125
+    "\002\340\002\003\020\100\341\172\277\101\270\036\260\101\017\043\012"    // X23.935Y22.015
+    "\002\341\002\003\020\100\305\040\305\101\242\105\256\101\167\163\012"    // X24.641Y21.784
+    "\002\342\002\003\020\100\110\341\307\101\323\115\255\101\020\112\120\012"    // X24.985Y21.663
+    "\002\343\002\003\020\100\201\225\312\101\323\115\254\101\362\071\012"    // X25.323Y21.538
+    "\002\344\002\003\020\100\345\320\317\101\144\073\252\101\324\064\012"    // X25.977Y21.279
+    "\002\345\002\003\020\100\004\126\322\101\351\046\251\101\217\356\012"    // X26.292Y21.144
+    "\002\346\002\003\020\100\301\312\324\101\112\014\250\101\153\350\012"    // X26.599Y21.006
+    "\002\347\002\003\020\100\356\174\331\101\203\300\245\101\277\061\012"    // X27.186Y20.719
+    "\002\350\002\003\020\100\122\270\333\101\150\221\244\101\037\164\012"    // X27.465Y20.571
+    "\002\351\002\003\020\100\073\337\335\101\035\132\243\101\305\065\012"    // X27.734Y20.419
+    "\002\352\002\003\020\100\252\361\337\101\254\034\242\101\333\173\012"    // X27.993Y20.264
+    "\002\353\002\003\020\100\221\355\341\101\027\331\240\101\111\146\012"    // X28.241Y20.106
+    "\002\354\002\003\020\100\345\320\343\101\120\215\237\101\260\101\012"    // X28.477Y19.944
+    "\002\355\002\003\020\100\262\235\345\101\144\073\236\101\310\155\012"    // X28.702Y19.779
+    "\002\356\002\003\020\100\221\355\350\101\037\205\233\101\011\127\012"    // X29.116Y19.440
+    "\002\357\002\003\020\100\244\160\352\101\305\040\232\101\043\002\012"    // X29.305Y19.266
+    "\002\360\002\003\020\100\027\331\353\101\071\264\230\101\077\354\012"    // X29.481Y19.088
+    "\002\361\002\003\020\100\351\046\355\101\226\103\227\101\042\134\012"    // X29.644Y18.908
+    "\002\362\002\003\020\100\035\132\356\101\301\312\225\101\010\344\012"    // X29.794Y18.724
+    "\002\363\002\003\020\100\244\160\357\101\323\115\224\101\005\246\012"    // X29.930Y18.538
+    "\002\364\002\003\020\100\213\154\360\101\301\312\222\101\320\124\012"    // X30.053Y18.349
+    "\002\365\002\003\020\100\307\113\361\101\175\077\221\101\302\141\012"    // X30.162Y18.156
+    "\002\366\002\003\020\100\142\020\120\362\101\041\260\217\101\114\310\012"    // X30.258Y17.961
+    "\002\367\002\003\020\100\106\266\362\101\240\032\216\101\366\071\012"    // X30.339Y17.763
+    "\002\370\002\003\020\100\175\077\363\101\006\201\214\101\266\134\012"    // X30.406Y17.563
+    "\002\371\002\003\020\100\010\254\363\101\073\337\212\101\167\031\012"    // X30.459Y17.359
+    "\002\372\002\003\020\100\347\373\363\101\130\071\211\101\014\303\012"    // X30.498Y17.153
+    "\002\373\002\003\020\100\016\055\364\101\120\215\207\101\260\105\012"    // X30.522Y16.944
+    "\002\374\002\003\020\100\211\101\364\101\057\335\205\101\044\070\012"    // X30.532Y16.733
+    "\002\375\002\003\020\100\130\071\364\101\351\046\204\101\004\351\012"    // X30.528Y16.519
+    "\002\376\002\003\020\100\173\024\364\101\213\154\202\101\020\112\037\012"    // X30.510Y16.303
+    "\002\377\002\003\020\100\301\312\363\101\053\207\200\101\055\121\012"    // X30.474Y16.066
+    "\002\020\100\002\003\020\100\065\136\363\101\114\067\175\101\346\340\012"    // X30.421Y15.826
+    "\002\001\002\003\020\100\345\320\362\101\370\123\171\101\350\271\012"    // X30.352Y15.583
+    "\002\002\002\003\020\100\305\040\362\101\132\144\165\101\301\352\012"    // X30.266Y15.337
+    "\002\003\002\003\020\100\337\117\361\101\213\154\161\101\275\011\012"    // X30.164Y15.089
+    "\002\004\002\003\020\100\065\136\360\101\213\154\155\101\027\154\012"    // X30.046Y14.839
+    "\002\005\002\003\020\100\307\113\357\101\102\140\151\101\144\305\012"    // X29.912Y14.586
+    "\002\006\002\003\020\100\223\030\356\101\256\107\145\101\244\376\012"    // X29.762Y14.330
+    "\002\007\002\003\020\100\250\306\354\101\002\053\141\101\216\022\012"    // X29.597Y14.073
+    "\002\010\002\003\020\100\004\126\353\101\014\002\135\101\005\070\012"    // X29.417Y13.813
+    "\002\011\002\003\020\100\254\034\350\101\215\227\124\101\334\301\012"    // X29.014Y13.287
+    "\002\020\112\002\003\020\100\370\123\346\101\004\126\120\101\240\044\012"    // X28.791Y13.021
+    "\002\013\002\003\020\100\244\160\344\101\112\014\114\101\345\323\012"    // X28.555Y12.753
+    "\002\014\002\003\020\100\035\132\340\101\102\140\103\101\024\331\012"    // X28.044Y12.211
+    "\002\020\115\002\003\020\100\351\046\336\101\014\002\077\101\135\225\012"    // X27.769Y11.938
+    "\002\016\002\003\020\100\057\335\333\101\246\233\072\101\156\247\012"    // X27.483Y11.663
+    "\002\017\002\003\020\100\061\010\327\101\167\276\061\101\357\133\012"    // X26.879Y11.109
+    "\002\020\120\002\003\020\100\213\154\314\101\217\302\037\101\211\154\012"    // X25.553Y9.985
+    "\002\021\002\003\020\100\201\225\264\101\016\055\366\100\215\057\012"    // X22.573Y7.693
+    "\002\022\002\003\020\100\311\166\261\101\303\365\354\100\327\353\012"    // X22.183Y7.405
+    "\002\023\002\003\020\100\370\123\256\101\106\266\343\100\305\024\012"    // X21.791Y7.116
+    "\002\024\002\003\020\100\075\020\112\250\101\033\057\321\100\071\332\012"    // X21.005Y6.537
+    "\002\025\002\003\020\100\067\211\233\101\130\071\254\100\241\240\012"    // X19.442Y5.382
+    "\002\026\002\003\020\100\311\166\230\101\014\002\243\100\223\207\012"    // X19.058Y5.094
+    "\002\027\002\003\020\100\213\154\225\101\301\312\231\100\314\230\012"    // X18.678Y4.806
+    "\002\030\002\003\020\100\260\162\217\101\213\154\207\100\136\253\012"    // X17.931Y4.232
+    "\002\031\002\003\020\100\240\032\204\101\173\024\106\100\013\275\012"    // X16.513Y3.095
+    "\002\032\002\003\020\100\213\154\201\101\061\010\064\100\030\055\012"    // X16.178Y2.813
+    "\002\033\002\003\020\100\313\241\175\101\112\014\042\100\202\367\012"    // X15.852Y2.532
+    "\002\034\002\003\020\100\374\251\163\101\010\254\374\077\073\352\012"    // X15.229Y1.974
+    "\002\035\002\003\020\100\221\355\156\101\114\067\331\077\311\257\012"    // X14.933Y1.697
+    "\002\036\002\003\020\100\116\142\152\101\031\004\266\077\137\054\012"    // X14.649Y1.422
+    "\002\037\002\003\020\100\020\112\327\141\101\211\101\140\077\245\021\012"    // X14.115Y0.876
+    "\002\040\002\003\020\100\073\337\135\101\321\042\033\077\033\013\012"    // X13.867Y0.606
+    "\002\041\002\003\020\100\254\034\132\101\104\213\254\076\371\247\012"    // X13.632Y0.337
+    "\002\042\002\003\020\100\165\223\126\101\163\150\221\075\166\040\012"    // X13.411Y0.071
+    "\002\043\002\003\020\100\226\103\123\101\360\247\106\276\131\370\012"    // X13.204Y-0.194
+    "\002\044\002\003\020\100\366\050\120\101\347\373\351\276\032\047\012"    // X13.010Y-0.457
+    "\002\045\002\003\020\100\337\117\115\101\120\215\067\277\312\024\012"    // X12.832Y-0.717
+    "\002\046\002\003\020\100\041\260\112\101\043\333\171\277\375\264\012"    // X12.668Y-0.976
+    "\002\047\002\003\020\100\354\121\110\101\055\262\235\277\251\272\012"    // X12.520Y-1.232
+    "\002\050\002\003\020\100\354\121\106\101\061\010\274\277\225\161\012"    // X12.395Y-1.469
+    "\002\051\002\003\020\100\104\213\104\101\347\373\331\277\364\022\012"    // X12.284Y-1.703
+    "\002\052\002\003\020\100\014\002\103\101\331\316\367\277\032\062\012"    // X12.188Y-1.936
+    "\002\053\002\003\020\100\024\256\101\101\041\260\020\112\300\107\075\012"    // X12.105Y-2.167
+    "\002\054\002\003\020\100\165\223\100\101\256\107\031\300\164\060\012"    // X12.036Y-2.395
+    "\002\055\002\003\020\100\106\266\077\101\167\276\047\300\113\052\012"    // X11.982Y-2.621
+    "\002\056\002\003\020\100\157\022\077\101\031\004\066\300\210\373\012"    // X11.942Y-2.844
+    "\002\057\002\003\020\100\360\247\076\101\366\050\104\300\341\342\012"    // X11.916Y-3.065
+    "\002\060\002\003\020\100\341\172\076\101\016\055\122\300\372\117\012"    // X11.905Y-3.284
+    "\002\061\002\003\020\100\053\207\076\101\020\100\020\100\140\300\020\112\026\012"    // X11.908Y-3.500
+    "\002\062\002\003\020\100\345\320\076\101\313\241\155\300\115\044\012"    // X11.926Y-3.713
+    "\002\063\002\003\020\100\020\120\130\077\101\321\042\173\300\054\347\012"    // X11.959Y-3.924
+    "\002\064\002\003\020\100\173\024\100\101\130\071\204\300\112\045\012"    // X12.005Y-4.132
+    "\002\065\002\003\020\100\157\022\101\101\345\320\212\300\233\045\012"    // X12.067Y-4.338
+    "\002\066\002\003\020\100\242\105\102\101\256\107\221\300\241\022\012"    // X12.142Y-4.540
+    "\002\067\002\003\020\100\106\266\103\101\024\256\227\300\106\321\012"    // X12.232Y-4.740
+    "\002\070\002\003\020\100\102\140\105\101\347\373\235\300\006\376\012"    // X12.336Y-4.937
+    "\002\071\002\003\020\100\175\077\107\101\047\061\244\300\314\144\012"    // X12.453Y-5.131
+    "\002\072\002\003\020\100\020\120\130\111\101\323\115\252\300\250\113\012"    // X12.584Y-5.322
+    "\002\073\002\003\020\100\374\251\113\101\354\121\260\300\127\027\012"    // X12.729Y-5.510
+    "\002\074\002\003\020\100\047\061\116\101\161\075\266\300\315\010\012"    // X12.887Y-5.695
+    "\002\075\002\003\020\100\252\361\120\101\142\020\120\274\300\110\347\012"    // X13.059Y-5.877
+    "\002\076\002\003\020\100\124\343\123\101\217\302\301\300\256\140\012"    // X13.243Y-6.055
+    "\002\077\002\003\020\100\045\006\127\101\132\144\307\300\075\102\012"    // X13.439Y-6.231
+    "\002\100\002\003\020\100\065\136\132\101\140\345\314\300\161\113\012"    // X13.648Y-6.403
+    "\002\101\002\003\020\100\155\347\135\101\323\115\322\300\017\322\012"    // X13.869Y-6.572
+    "\002\102\002\003\020\100\262\235\141\101\262\235\327\300\360\336\012"    // X14.101Y-6.738
+    "\002\103\002\003\020\100\037\205\145\101\376\324\334\300\027\321\012"    // X14.345Y-6.901
+    "\002\104\002\003\020\100\201\225\151\101\205\353\341\300\327\175\012"    // X14.599Y-7.060
+    "\002\105\002\003\020\100\362\322\155\101\171\351\346\300\132\343\012"    // X14.864Y-7.216
+    "\002\106\002\003\020\100\234\304\166\101\165\223\360\300\072\103\012"    // X15.423Y-7.518
+    "\002\107\002\003\020\100\325\170\173\101\175\077\365\300\001\263\012"    // X15.717Y-7.664
+    "\002\110\002\003\020\100\366\050\200\101\301\312\371\300\132\130\012"    // X16.020Y-7.806
+    "\002\111\002\003\020\100\063\063\205\101\256\107\001\301\353\131\012"    // X16.650Y-8.080
+    "\002\112\002\003\020\100\331\316\207\101\132\144\003\301\253\037\012"    // X16.976Y-8.212
+    "\002\113\002\003\020\100\325\170\212\101\244\160\005\301\151\030\012"    // X17.309Y-8.340
+    "\002\114\002\003\020\100\266\363\217\101\102\140\011\301\105\123\012"    // X17.994Y-8.586
+    "\002\115\002\003\020\100\203\300\222\101\226\103\013\301\234\120\012"    // X18.344Y-8.704
+    "\002\116\002\003\020\100\232\231\225\101\207\026\020\115\301\057\112\012"    // X18.700Y-8.818
+    "\002\117\002\003\020\100\116\142\233\101\134\217\020\120\301\135\261\012"    // X19.423Y-9.035
+    "\002\120\002\003\020\100\114\067\247\101\345\320\026\301\350\167\012"    // X20.902Y-9.426
+    "\002\121\002\003\020\100\077\065\252\101\161\075\030\301\105\357\012"    // X21.276Y-9.515
+    "\002\122\002\003\020\100\063\063\255\101\232\231\031\301\221\132\012"    // X21.650Y-9.600
+    "\002\123\002\003\020\100\002\053\263\101\335\044\034\301\360\032\012"    // X22.396Y-9.759
+    "\002\124\002\003\020\100\321\042\266\101\370\123\035\301\104\141\012"    // X22.767Y-9.833
+    "\002\125\002\003\020\100\223\030\271\101\260\162\036\301\175\173\012"    // X23.137Y-9.903
+    "\002\126\002\003\020\100\252\361\276\101\053\207\040\301\341\154\012"    // X23.868Y-10.033
+    "\002\127\002\003\020\100\362\322\301\101\325\170\041\301\204\115\012"    // X24.228Y-10.092
+    "\002\130\002\003\020\100\010\254\304\101\065\136\042\301\241\222\012"    // X24.584Y-10.148
+    "\002\131\002\003\020\100\356\174\307\101\063\063\043\301\072\043\012"    // X24.936Y-10.200
+    "\002\132\002\003\020\100\211\101\312\101\347\373\043\301\145\174\012"    // X25.282Y-10.249
+    "\002\133\002\003\020\100\333\371\314\101\071\264\044\301\270\165\012"    // X25.622Y-10.294
+    "\002\134\002\003\020\100\343\245\317\101\102\140\045\301\346\205\012"    // X25.956Y-10.336
+    "\002\135\002\003\020\100\376\324\324\101\053\207\046\301\062\322\012"    // X26.604Y-10.408
+    "\002\136\002\003\020\100\256\107\327\101\014\002\047\301\321\023\012"    // X26.910Y-10.438
+    "\002\137\002\003\020\100\374\251\331\101\244\160\047\301\163\047\012"    // X27.208Y-10.465
+    "\002\140\002\003\020\100\347\373\333\101\362\322\047\301\021\006\012"    // X27.498Y-10.489
+    "\002\141\002\003\020\100\144\073\336\101\335\044\050\301\350\247\012"    // X27.779Y-10.509
+    "\002\142\002\003\020\100\163\150\340\101\230\156\050\301\124\315\012"    // X28.051Y-10.527
+    "\002\143\002\003\020\100\006\201\342\101\327\243\050\301\050\120\012"    // X28.313Y-10.540
+    "\002\144\002\003\020\100\037\205\344\101\345\320\050\301\040\060\012"    // X28.565Y-10.551
+    "\002\145\002\003\020\100\274\164\346\101\221\355\050\301\020\100\156\012"    // X28.807Y-10.558
+    "\002\146\002\003\020\100\323\115\350\101\364\375\050\301\363\153\012"    // X29.038Y-10.562
+    "\002\147\002\003\020\100\142\020\120\352\101\014\002\051\301\011\371\012"    // X29.258Y-10.563
+    "\002\150\002\003\020\100\136\272\353\101\333\371\050\301\334\027\012"    // X29.466Y-10.561
+    "\002\151\002\003\020\100\323\115\355\101\140\345\050\301\275\335\012"    // X29.663Y-10.556
+    "\002\152\002\003\020\100\264\310\356\101\203\300\050\301\074\374\012"    // X29.848Y-10.547
+    "\002\153\002\003\020\100\366\050\360\101\165\223\050\301\261\273\012"    // X30.020Y-10.536
+    "\002\154\002\003\020\100\244\160\361\101\035\132\050\301\325\257\012"    // X30.180Y-10.522
+    "\002\155\002\003\020\100\262\235\362\101\142\020\120\050\301\041\141\012"    // X30.327Y-10.504
+    "\002\156\002\003\020\100\055\262\363\101\167\276\047\301\267\315\012"    // X30.462Y-10.484
+    "\002\157\002\003\020\100\374\251\364\101\102\140\047\301\330\345\012"    // X30.583Y-10.461
+    "\002\160\002\003\020\100\037\205\365\101\303\365\046\301\156\013\012"    // X30.690Y-10.435
+    "\002\161\002\003\020\100\242\105\366\101\372\176\046\301\342\111\012"    // X30.784Y-10.406
+    "\002\162\002\003\020\100\205\353\366\101\347\373\045\301\122\240\012"    // X30.865Y-10.374
+    "\002\163\002\003\020\100\274\164\367\101\244\160\045\301\322\321\012"    // X30.932Y-10.340
+    "\002\164\002\003\020\100\073\337\367\101\027\331\044\301\021\027\012"    // X30.984Y-10.303
+    "\002\165\002\003\020\100\033\057\370\101\077\065\044\301\112\342\012"    // X31.023Y-10.263
+    "\002\166\002\003\020\100\116\142\370\101\067\211\043\301\043\304\012"    // X31.048Y-10.221
+    "\002\167\002\003\020\100\311\166\370\101\345\320\042\301\167\275\012"    // X31.058Y-10.176
+    "\002\170\002\003\020\100\244\160\370\101\112\014\042\301\020\100\372\012"    // X31.055Y-10.128
+    "\002\171\002\003\020\100\307\113\370\101\175\077\041\301\170\032\012"    // X31.037Y-10.078
+    "\002\172\002\003\020\100\112\014\370\101\177\152\040\301\315\033\012"    // X31.006Y-10.026
+    "\002\173\002\003\020\100\024\256\367\101\067\211\037\301\267\052\012"    // X30.960Y-9.971
+    "\002\174\002\003\020\100\063\063\367\101\276\237\036\301\271\004\012"    // X30.900Y-9.914
+    "\002\175\002\003\020\100\262\235\366\101\024\256\035\301\242\052\012"    // X30.827Y-9.855
+    "\002\176\002\003\020\100\171\351\365\101\071\264\034\301\337\300\012"    // X30.739Y-9.794
+    "\002\177\002\003\020\100\240\032\365\101\024\256\033\301\241\110\012"    // X30.638Y-9.730
+    "\002\200\002\003\020\100\047\061\364\101\276\237\032\301\312\154\012"    // X30.524Y-9.664
+    "\002\201\002\003\020\100\002\053\363\101\067\211\031\301\302\332\012"    // X30.396Y-9.596
+    "\002\202\002\003\020\100\075\020\112\362\101\230\156\030\301\174\373\012"    // X30.255Y-9.527
+    "\002\203\002\003\020\100\315\314\360\101\256\107\027\301\355\352\012"    // X30.100Y-9.455
+    "\002\204\002\003\020\100\061\010\356\101\140\345\024\301\071\004\012"    // X29.754Y-9.306
+    "\002\205\002\003\020\100\372\176\354\101\343\245\023\301\150\266\012"    // X29.562Y-9.228
+    "\002\206\002\003\020\100\073\337\352\101\116\142\022\301\134\114\012"    // X29.359Y-9.149
+    "\002\207\002\003\020\100\004\126\347\101\250\306\017\301\101\251\012"    // X28.917Y-8.986
+    "\002\210\002\003\020\100\114\067\337\101\242\105\020\112\301\111\216\012"    // X27.902Y-8.642
+    "\002\211\002\003\020\100\364\375\334\101\027\331\010\301\256\105\012"    // X27.624Y-8.553
+    "\002\212\002\003\020\100\041\260\332\101\132\144\007\301\347\177\012"    // X27.336Y-8.462
+    "\002\213\002\003\020\100\073\337\325\101\260\162\004\301\173\144\012"    // X26.734Y-8.278
+    "\002\214\002\003\020\100\037\205\313\101\010\254\374\300\005\033\012"    // X25.440Y-7.896
+    "\002\215\002\003\020\100\152\274\264\101\063\063\343\300\257\147\012"    // X22.592Y-7.100
+    "\002\216\002\003\020\100\053\207\261\101\024\256\337\300\143\236\012"    // X22.191Y-6.990
+    "\002\217\002\003\020\100\307\113\256\101\305\040\334\300\336\254\012"    // X21.787Y-6.879
+    "\002\220\002\003\020\100\362\322\247\101\207\026\325\300\312\067\012"    // X20.978Y-6.659
+    "\002\221\002\003\020\100\317\367\232\101\333\371\306\300\260\262\012"    // X19.371Y-6.218
+    "\002\222\002\003\020\100\331\316\227\101\356\174\303\300\241\211\012"    // X18.976Y-6.109
+    "\002\223\002\003\020\100\010\254\224\101\020\100\020\100\300\300\161\070\012"    // X18.584Y-6.000
+    "\002\224\002\003\020\100\022\203\216\101\126\016\271\300\011\037\012"    // X17.814Y-5.783
+    "\002\225\002\003\020\100\301\312\202\101\037\205\253\300\176\054\012"    // X16.349Y-5.360
+    "\002\226\002\003\020\100\031\004\200\101\130\071\250\300\177\057\012"    // X16.002Y-5.257
+    "\002\227\002\003\020\100\276\237\172\101\303\365\244\300\223\143\012"    // X15.664Y-5.155
+    "\002\230\002\003\020\100\211\101\160\101\053\207\236\300\117\131\012"    // X15.016Y-4.954
+    "\002\231\002\003\020\100\370\123\153\101\132\144\233\300\016\021\012"    // X14.708Y-4.856
+    "\002\232\002\003\020\100\134\217\146\101\272\111\230\300\175\325\012"    // X14.410Y-4.759
+    "\002\233\002\003\020\100\232\231\135\101\077\065\222\300\075\004\012"    // X13.850Y-4.569
+    "\002\234\002\003\020\100\213\154\131\101\226\103\217\300\011\040\012"    // X13.589Y-4.477
+    "\002\235\002\003\020\100\244\160\125\101\116\142\214\300\100\046\012"    // X13.340Y-4.387
+    "\002\236\002\003\020\100\305\040\116\101\264\310\206\300\165\270\012"    // X12.883Y-4.212
+    "\002\237\002\003\020\100\315\314\112\101\142\020\120\204\300\076\314\012"    // X12.675Y-4.127
+    "\002\240\002\003\020\100\106\266\107\101\244\160\201\300\314\144\012"    // X12.482Y-4.045
+    "\002\241\002\003\020\100\161\075\102\101\071\264\170\300\335\351\012"    // X12.140Y-3.886
+    "\002\242\002\003\020\100\043\333\077\101\020\112\327\163\300\155\263\012"    // X11.991Y-3.810
+    "\002\243\002\003\020\100\167\276\075\101\002\053\157\300\002\140\012"    // X11.859Y-3.737
+    "\002\244\002\003\020\100\043\333\073\101\134\217\152\300\324\242\012"    // X11.741Y-3.665
+    "\002\245\002\003\020\100\161\075\072\101\077\065\146\300\130\247\012"    // X11.640Y-3.597
+    "\002\246\002\003\020\100\110\341\070\101\347\373\141\300\366\254\012"    // X11.555Y-3.531
+    "\002\247\002\003\020\100\250\306\067\101\124\343\135\300\074\255\012"    // X11.486Y-3.467
+    "\002\250\002\003\020\100\221\355\066\101\347\373\131\300\170\215\012"    // X11.433Y-3.406
+    "\002\251\002\003\020\100\035\132\066\101\242\105\126\300\022\256\012"    // X11.397Y-3.348
+    "\002\252\002\003\020\100\061\010\066\101\203\300\122\300\262\026\012"    // X11.377Y-3.293
+    "\002\253\002\003\020\100\317\367\065\101\213\154\117\300\333\225\012"    // X11.373Y-3.241
+    "\002\254\002\003\020\100\016\055\066\101\130\071\114\300\140\176\012"    // X11.386Y-3.191
+    "\002\255\002\003\020\100\327\243\066\101\256\107\111\300\240\017\012"    // X11.415Y-3.145
+    "\002\256\002\003\020\100\051\134\067\101\311\166\106\300\046\323\012"    // X11.460Y-3.101
+    "\002\257\002\003\020\100\035\132\070\101\155\347\103\300\277\155\012"    // X11.522Y-3.061
+    "\002\260\002\003\020\100\232\231\071\101\067\211\101\300\072\143\012"    // X11.600Y-3.024
+    "\002\261\002\003\020\100\240\032\073\101\051\134\077\300\033\123\012"    // X11.694Y-2.990
+    "\002\262\002\003\020\100\027\331\074\101\102\140\075\300\174\335\012"    // X11.803Y-2.959
+    "\002\263\002\003\020\100\027\331\076\101\343\245\073\300\052\256\012"    // X11.928Y-2.932
+    "\002\264\002\003\020\100\207\026\101\101\254\034\072\300\032\363\012"    // X12.068Y-2.908
+    "\002\265\002\003\020\100\150\221\103\101\234\304\070\300\327\346\012"    // X12.223Y-2.887
+    "\002\266\002\003\020\100\272\111\106\101\024\256\067\300\246\337\012"    // X12.393Y-2.870
+    "\002\267\002\003\020\100\175\077\111\101\264\310\066\300\121\020\100\012"    // X12.578Y-2.856
+    "\002\270\002\003\020\100\177\152\114\101\335\044\066\300\320\063\012"    // X12.776Y-2.846
+    "\002\271\002\003\020\100\362\322\117\101\217\302\065\300\350\353\012"    // X12.989Y-2.840
+    "\002\272\002\003\020\100\213\154\123\101\150\221\065\300\260\004\012"    // X13.214Y-2.837
+    "\002\273\002\003\020\100\175\077\127\101\313\241\065\300\070\112\012"    // X13.453Y-2.838
+    "\002\274\002\003\020\100\226\103\133\101\124\343\065\300\260\130\012"    // X13.704Y-2.842
+    "\002\275\002\003\020\100\325\170\137\101\146\146\066\300\033\065\012"    // X13.967Y-2.850
+    "\002\276\002\003\020\100\073\337\143\101\002\053\067\300\146\331\012"    // X14.242Y-2.862
+    "\002\277\002\003\020\100\230\156\150\101\047\061\070\300\257\002\012"    // X14.527Y-2.878
+    "\002\300\002\003\020\100\033\057\155\101\163\150\071\300\040\312\012"    // X14.824Y-2.897
+    "\002\301\002\003\020\100\173\024\162\101\252\361\072\300\107\141\012"    // X15.130Y-2.921
+    "\002\302\002\003\020\100\315\314\166\101\104\213\074\300\363\030\012"    // X15.425Y-2.946
+    "\002\303\002\003\020\100\313\241\173\101\146\146\076\300\072\322\012"    // X15.727Y-2.975
+    "\002\304\002\003\020\100\307\113\200\101\260\162\100\300\032\111\012"    // X16.037Y-3.007
+    "\002\305\002\003\020\100\362\322\202\101\041\260\102\300\335\346\012"    // X16.353Y-3.042
+    "\002\306\002\003\020\100\163\150\205\101\033\057\105\300\266\031\012"    // X16.676Y-3.081
+    "\002\307\002\003\020\100\075\020\112\210\101\236\357\107\300\120\316\012"    // X17.005Y-3.124
+    "\002\310\002\003\020\100\213\154\215\101\031\004\116\300\126\321\012"    // X17.678Y-3.219
+    "\002\311\002\003\020\100\002\053\220\101\163\150\121\300\372\052\012"    // X18.021Y-3.272
+    "\002\312\002\003\020\100\252\361\222\101\126\016\125\300\062\340\012"    // X18.368Y-3.329
+    "\002\313\002\003\020\100\150\221\230\101\221\355\134\300\330\363\012"    // X19.071Y-3.452
+    "\002\314\002\003\020\100\163\150\233\101\114\067\141\300\045\232\012"    // X19.426Y-3.519
+    "\002\315\002\003\020\100\226\103\236\101\217\302\145\300\021\053\012"    // X19.783Y-3.590
+    "\002\316\002\003\020\100\364\375\243\101\356\174\157\300\360\250\012"    // X20.499Y-3.742
+    "\002\317\002\003\020\100\043\333\246\101\010\254\164\300\304\317\012"    // X20.857Y-3.823
+    "\002\320\002\003\020\100\106\266\251\101\254\034\172\300\025\117\012"    // X21.214Y-3.908
+    "\002\321\002\003\020\100\146\146\257\101\345\320\202\300\222\257\012"    // X21.925Y-4.088
+    "\002\322\002\003\020\100\114\067\262\101\043\333\205\300\163\273\012"    // X22.277Y-4.183
+    "\002\323\002\003\020\100\014\002\265\101\045\006\211\300\214\343\012"    // X22.626Y-4.282
+    "\002\324\002\003\020\100\022\203\272\101\106\266\217\300\256\010\012"    // X23.314Y-4.491
+    "\002\325\002\003\020\100\114\067\275\101\063\063\223\300\331\315\012"    // X23.652Y-4.600
+    "\002\326\002\003\020\100\073\337\277\101\345\320\226\300\122\066\012"    // X23.984Y-4.713
+    "\002\327\002\003\020\100\126\016\305\101\065\136\236\300\233\325\012"    // X24.632Y-4.949
+    "\002\330\002\003\020\100\165\223\307\101\004\126\242\300\251\073\012"    // X24.947Y-5.073
+    "\002\331\002\003\020\100\061\010\312\101\065\136\246\300\267\147\012"    // X25.254Y-5.199
+    "\002\332\002\003\020\100\234\304\316\101\345\320\256\300\213\221\012"    // X25.846Y-5.463
+    "\002\333\002\003\020\100\061\010\321\101\063\063\263\300\136\272\012"    // X26.129Y-5.600
+    "\002\334\002\003\020\100\144\073\323\101\024\256\267\300\117\253\012"    // X26.404Y-5.740
+    "\002\335\002\003\020\100\035\132\325\101\272\111\274\300\322\166\012"    // X26.669Y-5.884
+    "\002\336\002\003\020\100\146\146\327\101\364\375\300\300\205\066\012"    // X26.925Y-6.031
+    "\002\337\002\003\020\100\051\134\331\101\301\312\305\300\356\037\012"    // X27.170Y-6.181
+    "\002\340\002\003\020\100\161\075\333\101\041\260\312\300\145\213\012"    // X27.405Y-6.334
+    "\002\341\002\003\020\100\152\274\336\101\315\314\324\300\137\165\012"    // X27.842Y-6.650
+    "\002\342\002\003\020\100\020\120\130\340\101\031\004\332\300\021\351\012"    // X28.043Y-6.813
+    "\002\343\002\003\020\100\043\333\341\101\370\123\337\300\343\204\012"    // X28.232Y-6.979
+    "\002\344\002\003\020\100\242\105\343\101\234\304\344\300\125\244\012"    // X28.409Y-7.149
+    "\002\345\002\003\020\100\201\225\344\101\242\105\352\300\304\074\012"    // X28.573Y-7.321
+    "\002\346\002\003\020\100\315\314\345\101\073\337\357\300\042\057\012"    // X28.725Y-7.496
+    "\002\347\002\003\020\100\155\347\346\101\150\221\365\300\164\105\012"    // X28.863Y-7.674
+    "\002\350\002\003\020\100\171\351\347\101\051\134\373\300\347\114\012"    // X28.989Y-7.855
+    "\002\351\002\003\020\100\331\316\350\101\276\237\020\100\301\305\114\012"    // X29.101Y-8.039
+    "\002\352\002\003\020\100\215\227\351\101\262\235\003\301\251\175\012"    // X29.199Y-8.226
+    "\002\353\002\003\020\100\226\103\352\101\360\247\006\301\352\245\012"    // X29.283Y-8.416
+    "\002\354\002\003\020\100\362\322\352\101\167\276\011\301\116\112\012"    // X29.353Y-8.609
+    "\002\355\002\003\020\100\242\105\353\101\057\335\014\301\017\217\012"    // X29.409Y-8.804
+    "\002\356\002\003\020\100\246\233\353\101\061\010\020\120\301\234\207\012"    // X29.451Y-9.002
+    "\002\357\002\003\020\100\376\324\353\101\175\077\023\301\232\062\012"    // X29.479Y-9.203
+    "\002\360\002\003\020\100\236\357\353\101\372\176\026\301\116\320\012"    // X29.492Y-9.406
+    "\002\361\002\003\020\100\221\355\353\101\301\312\031\301\355\152\012"    // X29.491Y-9.612
+    "\002\362\002\003\020\100\315\314\353\101\270\036\035\301\244\247\012"    // X29.475Y-9.820
+    "\002\363\002\003\020\100\134\217\353\101\372\176\040\301\017\115\012"    // X29.445Y-10.031
+    "\002\364\002\003\020\100\077\065\353\101\155\347\043\301\372\045\012"    // X29.401Y-10.244
+    "\002\365\002\003\020\100\152\274\352\101\020\120\130\047\301\071\005\012"    // X29.342Y-10.459
+    "\002\366\002\003\020\100\351\046\352\101\376\324\052\301\111\104\012"    // X29.269Y-10.677
+    "\002\367\002\003\020\100\260\162\351\101\035\132\056\301\111\303\012"    // X29.181Y-10.897
+    "\002\370\002\003\020\100\327\243\350\101\155\347\061\301\063\313\012"    // X29.080Y-11.119
+    "\002\371\002\003\020\100\106\266\347\101\006\201\065\301\275\146\012"    // X28.964Y-11.344
+    "\002\372\002\003\020\100\201\225\346\101\213\154\071\301\014\037\012"    // X28.823Y-11.589
+    "\002\373\002\003\020\100\370\123\345\101\132\144\075\301\176\127\012"    // X28.666Y-11.837
+    "\002\374\002\003\020\100\252\361\343\101\132\144\101\301\316\176\012"    // X28.493Y-12.087
+    "\002\375\002\003\020\100\244\160\342\101\244\160\105\301\342\333\012"    // X28.305Y-12.340
+    "\002\376\002\003\020\100\345\320\340\101\006\201\111\301\040\267\012"    // X28.102Y-12.594
+    "\002\377\002\003\020\100\142\020\120\337\101\262\235\115\301\260\323\012"    // X27.883Y-12.851
+    "\002\020\100\002\003\020\100\130\071\333\101\205\353\125\301\317\347\012"    // X27.403Y-13.370
+    "\002\001\002\003\020\100\321\042\331\101\254\034\132\301\343\005\012"    // X27.142Y-13.632
+    "\002\002\002\003\020\100\252\361\326\101\035\132\136\301\234\336\012"    // X26.868Y-13.897
+    "\002\003\002\003\020\100\175\077\322\101\110\341\146\301\144\045\012"    // X26.281Y-14.430
+    "\002\004\002\003\020\100\203\300\307\101\130\071\170\301\251\365\012"    // X24.969Y-15.514
+    "\002\005\002\003\020\100\205\353\304\101\246\233\174\301\001\277\012"    // X24.615Y-15.788
+    "\002\006\002\003\020\100\031\004\302\101\022\203\200\301\271\363\012"    // X24.252Y-16.064
+    "\002\007\002\003\020\100\014\002\274\101\236\357\204\301\030\121\012"    // X23.501Y-16.617
+    "\002\010\002\003\020\100\004\126\257\101\073\337\215\301\032\212\012"    // X21.917Y-17.734
+    "\002\011\002\003\020\100\134\217\224\101\110\341\237\301\101\270\012"    // X18.570Y-19.985
+    "\002\020\112\002\003\020\100\033\057\221\101\305\040\242\301\250\214\012"    // X18.148Y-20.266
+    "\002\013\002\003\020\100\376\324\215\101\102\140\244\301\224\371\012"    // X17.729Y-20.547
+    "\002\014\002\003\020\100\016\055\207\101\057\335\250\301\223\247\012"    // X16.897Y-21.108
+    "\002\020\115\002\003\020\100\134\217\164\101\250\306\261\301\370\234\012"    // X15.285Y-22.222
+    "\002\016\002\003\020\100\004\126\156\101\347\373\263\301\031\341\012"    // X14.896Y-22.498
+    "\002\017\002\003\020\100\161\075\150\101\047\061\266\301\155\302\012"    // X14.515Y-22.774
+    "\002\020\120\002\003\020\100\146\146\134\101\150\221\272\301\144\326\012"    // X13.775Y-23.321
+    "\002\021\002\003\020\100\104\213\106\101\063\063\303\301\251\105\012"    // X12.409Y-24.400
+    "\002\022\002\003\020\100\037\205\101\101\370\123\305\301\102\073\012"    // X12.095Y-24.666
+    "\002\023\002\003\020\100\010\254\074\101\244\160\307\301\203\017\012"    // X11.792Y-24.930
+    "\002\024\002\003\020\100\150\221\063\101\276\237\313\301\225\106\012"    // X11.223Y-25.453
+    "\002\025\002\003\020\100\370\123\057\101\055\262\315\301\066\261\012"    // X10.958Y-25.712
+    "\002\026\002\003\020\100\337\117\053\101\167\276\317\301\373\145\012"    // X10.707Y-25.968
+    "\002\027\002\003\020\100\236\357\043\101\315\314\323\301\314\166\012"    // X10.246Y-26.475
+    "\002\030\002\003\020\100\246\233\040\101\315\314\325\301\310\034\012"    // X10.038Y-26.725
+    "\002\031\002\003\020\100\037\205\035\101\264\310\327\301\165\222\012"    // X9.845Y-26.973
+    "\002\032\002\003\020\100\010\254\032\101\167\276\331\301\342\201\012"    // X9.667Y-27.218
+    "\002\033\002\003\020\100\173\024\030\101\041\260\333\301\266\077\012"    // X9.505Y-27.461
+    "\002\034\002\003\020\100\167\276\025\101\262\235\335\301\072\155\012"    // X9.359Y-27.702
+    "\002\035\002\003\020\100\374\251\023\101\037\205\337\301\357\271\012"    // X9.229Y-27.940
+    "\002\036\002\003\020\100\020\112\327\021\101\146\146\341\301\146\042\012"    // X9.115Y-28.175
+    "\002\037\002\003\020\100\242\105\020\120\101\211\101\343\301\321\065\012"    // X9.017Y-28.407
+    "\002\040\002\003\020\100\014\002\017\101\126\016\345\301\302\233\012"    // X8.938Y-28.632
+    "\002\041\002\003\020\100\347\373\020\115\101\020\112\327\346\301\152\045\012"    // X8.874Y-28.855
+    "\002\042\002\003\020\100\144\073\020\115\101\215\227\350\301\243\321\012"    // X8.827Y-29.074
+    "\002\043\002\003\020\100\152\274\014\101\370\123\352\301\277\331\012"    // X8.796Y-29.291
+    "\002\044\002\003\020\100\372\176\014\101\075\020\112\354\301\057\142\012"    // X8.781Y-29.505
+    "\002\045\002\003\020\100\022\203\014\101\136\272\355\301\353\305\012"    // X8.782Y-29.716
+    "\002\046\002\003\020\100\264\310\014\101\116\142\357\301\145\341\012"    // X8.799Y-29.923
+    "\002\047\002\003\020\100\370\123\020\115\101\045\006\361\301\140\267\012"    // X8.833Y-30.128
+    "\002\050\002\003\020\100\254\034\016\101\313\241\362\301\200\262\012"    // X8.882Y-30.329
+    "\002\051\002\003\020\100\351\046\017\101\114\067\364\301\322\014\012"    // X8.947Y-30.527
+    "\002\052\002\003\020\100\260\162\020\120\101\250\306\365\301\276\306\012"    // X9.028Y-30.722
+    "\002\053\002\003\020\100\020\100\020\100\022\101\337\117\367\301\245\301\012"    // X9.125Y-30.914
+    "\002\054\002\003\020\100\250\306\023\101\345\320\370\301\071\303\012"    // X9.236Y-31.102
+    "\002\055\002\003\020\100\331\316\025\101\272\111\372\301\300\010\012"    // X9.363Y-31.286
+    "\002\056\002\003\020\100\173\024\030\101\152\274\373\301\343\153\012"    // X9.505Y-31.467
+    "\002\057\002\003\020\100\165\223\032\101\366\050\375\301\210\110\012"    // X9.661Y-31.645
+    "\002\060\002\003\020\100\337\117\035\101\120\215\376\301\072\156\012"    // X9.832Y-31.819
+    "\002\061\002\003\020\100\211\101\040\101\171\351\377\301\004\305\012"    // X10.016Y-31.989
+    "\002\062\002\003\020\100\213\154\043\101\270\236\020\100\302\065\256\012"    // X10.214Y-32.155
+    "\002\063\002\003\020\100\315\314\046\101\242\105\001\302\020\115\210\012"    // X10.425Y-32.318
+    "\002\064\002\003\020\100\116\142\052\101\163\350\001\302\254\150\012"    // X10.649Y-32.477
+    "\002\065\002\003\020\100\366\050\056\101\061\210\002\302\221\253\012"    // X10.885Y-32.633
+    "\002\066\002\003\020\100\272\111\066\101\136\272\003\302\034\100\012"    // X11.393Y-32.932
+    "\002\067\002\003\020\100\276\237\072\101\323\115\004\302\107\274\012"    // X11.664Y-33.076
+    "M30\n"
+    ;
+// 32690 bytes of gcode stored in 36227 bytes, 2103 lines as frames
@@ -0,0 +1,238 @@
+#!/usr/bin/env python3
+"""
+tokenize_gcode.py - build a tokenized xio_flash_file from a gcode file
+
+Usage: tokenize_gcode.py [--frames] <input.gcode | input.h> <array_name> > output.h
+
+The output is a header holding one PROGMEM char array in the tokenized
+flash-file format read by xio_flash_file in g2core/xio.h:
+
+    byte 0          XIO_FLASH_FILE_TOKENIZED (0x01)
+    per line        [length][length encoded bytes]   length is 1..255
+    end             the NUL that terminates the string literal (length 0)
+
+Encoded bytes are printable ASCII (and TAB) as-is, 0x80-0xE3 for the digit
+pairs "00" to "99", and 0xE4-0xFF for the words below. The word table MUST
+match _flash_file_words[] in g2core/xio.cpp.
+
+A .h input is one of the Resources/gcode/*.h files - the first string literal
+in it is used. Blank lines are dropped, and CRs and trailing whitespace
+are stripped. Lines are otherwise stored exactly, including comments.
+
+With --frames the file is stored as plain lines, and the G0, G1 and G4 lines
+are replaced by the binary frames of g2core/binary_parser.cpp, so the board runs
+them without the Gcode parser. A line becomes a frame if it holds nothing but
+an N word, a G0/G1 (or no G, in G0 or G1 motion mode) with X Y Z A B C and F
+words, or a G4 with a P word. Every other line - arcs, M codes, comments,
+modal settings - is stored as text, as the frames are read in whatever units,
+distance and feed rate modes those set. The file starts with a SYNC frame, and
+the frame layout and CRC MUST match binary_parser.cpp. Values are converted to
+single floats here, which may round the last bit differently from the parser.
+"""
+
+import re
+import struct
+import sys
+
+FLASH_FILE_TOKENIZED = 0x01
+DIGIT_PAIR_BASE = 0x80
+WORDS_BASE = 0xE4
+MAX_LINE = 510                      # RX_BUFFER_SIZE-2 - the flash file line buffer is RX_BUFFER_SIZE
+
+WORDS = [                           # must match _flash_file_words[] in g2core/xio.cpp
+    "G0 X", "G1 X", "G0 Z", "G1 Z", "G2 X", "G3 X",
+    "G0 ", "G1 ", "G2 ", "G3 ",
+    " X-", " Y-", " Z-", " I-", " J-", "X-", "Y-", "Z-",
+    " X", " Y", " Z", " F", " I", " J", " S", " P",
+    ".0", "-0.",
+]
+assert len(WORDS) == 0x100 - WORDS_BASE
+
+FRAME_START = 0x02                  # must match binary_parser.h
+FRAME_ESCAPE = 0x10
+ESCAPE_XOR = 0x40
+RECORD_SYNC, RECORD_TRAVERSE, RECORD_FEED, RECORD_DWELL = 0, 1, 2, 3
+FLAG_LINENUM, FLAG_FEED = 0x01, 0x02
+FRAME_AXES = "XYZABC"               # mask bit N is AXIS_X...AXIS_C
+
+
+def read_gcode(path):
+    with open(path) as fp:
+        text = fp.read()
+    if path.endswith('.h'):
+        match = re.search(r'=\s*"(.*?)"\s*;', text, re.S)
+        if not match:
+            sys.exit("%s: no string literal found" % path)
+        text = match.group(1).replace('\\\n', '').replace('\\n', '\n').replace('\\"', '"')
+    return text.split('\n')
+
+
+def tokenize_line(line):
+    out = bytearray()
+    i = 0
+    while i < len(line):
+        if line[i].isdigit() and (i+1 < len(line)) and line[i+1].isdigit():
+            out.append(DIGIT_PAIR_BASE + int(line[i:i+2]))
+            i += 2
+            continue
+        for n, word in sorted(enumerate(WORDS), key=lambda w: -len(w[1])):
+            if line.startswith(word, i):
+                out.append(WORDS_BASE + n)
+                i += len(word)
+                break
+        else:
+            c = ord(line[i])
+            if not ((0x20 <= c < 0x7F) or (c == 0x09)):
+                sys.exit("line %r: character 0x%02x can't be stored" % (line, c))
+            out.append(c)
+            i += 1
+    return out
+
+
+def crc16(data):                    # CRC-16/CCITT - as binary_crc16()
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def make_frame(seq, record, axes=0, flags=0, payload=b''):
+    data = bytes([seq & 0xFF, record, axes, flags]) + payload
+    data += struct.pack('<H', crc16(data))
+    out = bytearray([FRAME_START])
+    for b in data:
+        if b in (0x00, 0x0A, 0x0D, FRAME_ESCAPE):
+            out += bytes([FRAME_ESCAPE, b ^ ESCAPE_XOR])
+        else:
+            out.append(b)
+    return out + b'\n'
+
+
+def motion_of(words):
+    """Motion mode the G words of a text line leave behind: 0 or 1, None, or unchanged (-1)"""
+    mode = -1
+    for letter, value in words:
+        if letter == 'G':
+            g = float(value)
+            if g in (0, 1):
+                mode = int(g)
+            elif (g in (2, 3)) or (38 <= g < 39) or (80 <= g < 90):
+                mode = None         # a motion mode frames can't carry
+    return mode
+
+
+def frame_line(line, seq, motion):
+    """Return the frame for line, or None if it has to stay text"""
+    if not re.fullmatch(r'(\s*[A-Za-z]\s*[-+]?(\d+\.?\d*|\.\d+))+\s*', line):
+        return None
+    words = [(m.group(1).upper(), m.group(2))
+             for m in re.finditer(r'([A-Za-z])\s*([-+]?(?:\d+\.?\d*|\.\d+))', line)]
+    letters = [w[0] for w in words]
+    if len(set(letters)) != len(letters):
+        return None
+    values = dict(words)
+    flags, payload = 0, b''
+    if 'N' in values:
+        flags |= FLAG_LINENUM
+        payload += struct.pack('<I', int(values['N']))
+
+    g = float(values['G']) if 'G' in values else motion
+    if g == 4:
+        if set(letters) - set('NGP') or ('P' not in values):
+            return None
+        return make_frame(seq, RECORD_DWELL, 0, flags, payload + struct.pack('<f', float(values['P'])))
+    if (g not in (0, 1)) or set(letters) - set('NGF' + FRAME_AXES):
+        return None
+    axes = 0
+    targets = b''
+    for n, axis in enumerate(FRAME_AXES):
+        if axis in values:
+            axes |= 1 << n
+            targets += struct.pack('<f', float(values[axis]))
+    if axes == 0:
+        return None                 # e.g. a G1 or F alone - leave it to the parser
+    if 'F' in values:
+        flags |= FLAG_FEED
+        payload += struct.pack('<f', float(values['F']))
+    return make_frame(seq, RECORD_FEED if g == 1 else RECORD_TRAVERSE, axes, flags, payload + targets)
+
+
+def print_line(encoded, comment):
+    literal = ''.join('\\%03o' % b for b in encoded)
+    print("    \"%s\"    // %s" % (literal, comment.replace('*/', '* /').replace('\\', '/')))
+
+
+def main_frames(path, name):
+    raw_bytes = 0
+    frames = 0
+    print("/*")
+    print(" * %s[] - converted to binary frames from %s by Resources/tokenize_gcode.py --frames - do not edit" % (name, path))
+    print(" */")
+    print("const char PROGMEM %s[] =" % name)
+    encoded = make_frame(0, RECORD_SYNC)
+    print_line(encoded, "SYNC frame")
+    stored_bytes = len(encoded)
+    seq = 1
+    motion = None
+    for line in read_gcode(path):
+        line = line.rstrip()
+        if not line:
+            continue
+        if len(line) > MAX_LINE:
+            sys.exit("line %r: longer than %d characters" % (line, MAX_LINE))
+        raw_bytes += len(line) + 1
+        frame = frame_line(line, seq, motion)
+        words = re.findall(r'([A-Za-z])\s*([-+]?(?:\d+\.?\d*|\.\d+))', re.sub(r'\(.*?\)|;.*', '', line))
+        mode = motion_of([(l.upper(), v) for l, v in words])
+        if mode != -1:
+            motion = mode
+        if frame is None:
+            stored_bytes += len(line) + 1
+            print("    \"%s\\n\"" % line.replace('\\', '\\\\').replace('"', '\\"'))
+            continue
+        seq += 1
+        frames += 1
+        stored_bytes += len(frame)
+        print_line(frame, line)
+    print("    ;")
+    print("// %d bytes of gcode stored in %d bytes, %d lines as frames" % (raw_bytes, stored_bytes + 1, frames))
+
+
+def main():
+    frames = (len(sys.argv) > 1) and (sys.argv[1] == '--frames')
+    if frames:
+        del sys.argv[1]
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    path, name = sys.argv[1], sys.argv[2]
+    if frames:
+        return main_frames(path, name)
+
+    raw_bytes = 0
+    print("/*")
+    print(" * %s.h - tokenized from %s by Resources/tokenize_gcode.py - do not edit" % (name, path))
+    print(" */")
+    print("const char PROGMEM %s[] = \"\\%03o\"" % (name, FLASH_FILE_TOKENIZED))
+    stored_bytes = 1
+    for line in read_gcode(path):
+        line = line.rstrip()
+        if not line:
+            continue
+        if len(line) > MAX_LINE:
+            sys.exit("line %r: longer than %d characters" % (line, MAX_LINE))
+        encoded = tokenize_line(line)
+        if len(encoded) > 255:
+            sys.exit("line %r: more than 255 bytes tokenized" % line)
+        raw_bytes += len(line) + 1
+        stored_bytes += len(encoded) + 1
+        literal = ''.join('\\%03o' % b for b in bytes([len(encoded)]) + encoded)
+        print("    \"%s\"    // %s" % (literal, line.replace('*/', '* /').replace('\\', '/')))
+    print("    ;")
+    print("// %d bytes of gcode stored in %d bytes" % (raw_bytes, stored_bytes + 1))
+
+
+if __name__ == '__main__':
+    main()
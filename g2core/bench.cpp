@@ -0,0 +1,227 @@
+/*
+ * bench.cpp - on-board planner benchmark: dry runs of compiled-in programs
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "g2core.h"
+#include "config.h"
+#include "controller.h"
+#include "canonical_machine.h"
+#include "planner.h"
+#include "stepper.h"
+#include "json_parser.h"
+#include "text_parser.h"
+#include "timebase.h"
+#include "util.h"
+#include "xio.h"
+#include "bench.h"
+
+/**** Allocate Structures ****/
+
+bench_t bench;
+
+#if BENCH_ENABLED == true
+
+/**** Programs ****/
+
+namespace bench_braid2d {
+#include "../Resources/gcode/gcode_braid2d.h"
+}
+
+static auto bench_braid2d_file = make_xio_flash_file(bench_braid2d::gcode_file);
+
+#if BINARY_STREAM_ENABLED == true
+namespace bench_braid2d_frames {                // Resources/tokenize_gcode.py --frames gcode/gcode_braid2d.h
+#include "../Resources/gcode/gcode_braid2d_frames.h"
+}
+
+static auto bench_braid2d_frames_file = make_xio_flash_file(bench_braid2d_frames::gcode_file);
+#endif
+
+static const benchProgram_t bench_programs[] = {
+    { "braid2d", &bench_braid2d_file },
+#if BINARY_STREAM_ENABLED == true
+    { "braid2d.bin", &bench_braid2d_frames_file }
+#endif
+};
+#define BENCH_PROGRAMS (sizeof(bench_programs)/sizeof(benchProgram_t))
+
+#endif // BENCH_ENABLED
+
+/************************************************************************************
+ **** CODE **************************************************************************
+ ************************************************************************************/
+
+/*
+ * _machine_is_idle() - true with no cycle, an empty planner and nothing running
+ * _dry_run_start()   - drop segments and dwells in the loader from here on
+ * _dry_run_end()     - run them again, from where the machine was at the start
+ */
+
+static bool _machine_is_idle()
+{
+    return ((cm.cycle_state == CYCLE_OFF) && (mp_get_planner_buffers() == PLANNER_BUFFER_POOL_SIZE) &&
+            mp_runtime_is_idle());
+}
+
+static void _dry_run_start()
+{
+    copy_vector(bench.position, mr.position);
+    bench.underruns = st_pre.underruns;
+    bench.dda_ticks = 0;
+    bench.dwell_ticks = 0;
+    bench.segments = 0;
+    bench.dry_run = true;
+}
+
+static void _dry_run_end()
+{
+    bench.dry_run = false;
+    for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
+        cm_set_position(axis, bench.position[axis]);    // the axes never left it
+    }
+    st_pre.underruns = bench.underruns;
+}
+
+#if BENCH_ENABLED == true
+
+/*
+ * bench_callback() - end a benchmark once its file is read and the machine has stopped
+ */
+
+stat_t bench_callback()
+{
+    if (!bench.running) {
+        return (STAT_NOOP);
+    }
+    if (xio_file_is_sending() || cs.line_held || (mp.planner_state != PLANNER_IDLE) || !_machine_is_idle()) {
+        return (STAT_NOOP);
+    }
+    bench.seconds = (float)(tb_get_usec() - bench.start_usec) / 1000000;
+    bench.running = false;
+    if (bench.seconds > 0) {
+        bench.lines_per_sec = bench.lines / bench.seconds;
+        bench.blocks_per_sec = bench.blocks / bench.seconds;
+        bench.segments_per_sec = bench.segments / bench.seconds;
+    }
+    _dry_run_end();
+
+    nvObj_t *nv = nv_reset_nv_list();               // sets *nv to the start of the body
+    strcpy(nv->token, "bch");
+    nv->index = nv_get_index((const char *)"", nv->token);
+    nv_get_nvObj(nv);                               // expands the group
+    nv_print_list(STAT_OK, TEXT_MULTILINE_FORMATTED, JSON_OBJECT_FORMAT);
+    return (STAT_OK);
+}
+
+#endif // BENCH_ENABLED
+
+/***********************************************************************************
+ * CONFIGURATION AND INTERFACE FUNCTIONS
+ * Functions to get and set variables from the cfgArray table
+ ***********************************************************************************/
+
+/*
+ * bench_get_bchc() - cycle time of the dry run in seconds
+ * bench_set_bchd() - start (1) or end (0) a dry run. 1 during a dry run clears the cycle time
+ */
+
+stat_t bench_get_bchc(nvObj_t *nv)
+{
+    __disable_irq();                                // the loader adds to the ticks
+    uint64_t dda_ticks = bench.dda_ticks;
+    uint64_t dwell_ticks = bench.dwell_ticks;
+    __enable_irq();
+    nv->value = (float)((double)dda_ticks / FREQUENCY_DDA + (double)dwell_ticks / FREQUENCY_DWELL);
+    nv->valuetype = TYPE_FLOAT;
+    return (STAT_OK);
+}
+
+stat_t bench_set_bchd(nvObj_t *nv)
+{
+    bool dry_run = fp_NOT_ZERO(nv->value);
+    if (dry_run == (bool)bench.dry_run) {
+        if (dry_run && !bench.running) {
+            __disable_irq();
+            bench.dda_ticks = 0;
+            bench.dwell_ticks = 0;
+            bench.segments = 0;
+            __enable_irq();
+        }
+        return (STAT_OK);
+    }
+    if (!_machine_is_idle() || bench.running) {
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    if (dry_run) {
+        _dry_run_start();
+    } else {
+        _dry_run_end();
+    }
+    return (STAT_OK);
+}
+
+#if BENCH_ENABLED == true
+
+/*
+ * bench_get_bench() - name of the last program run
+ * bench_set_bench() - start a benchmark of the named program
+ */
+
+stat_t bench_get_bench(nvObj_t *nv)
+{
+    ritorno(nv_copy_string(nv, (bench.program != NULL) ? bench.program->name : ""));
+    nv->valuetype = TYPE_STRING;
+    return (STAT_OK);
+}
+
+stat_t bench_set_bench(nvObj_t *nv)
+{
+    if (nv->valuetype != TYPE_STRING) {
+        return (STAT_INPUT_VALUE_RANGE_ERROR);
+    }
+    const benchProgram_t *program = NULL;
+    for (uint8_t i = 0; i < BENCH_PROGRAMS; i++) {
+        if (strcmp(*nv->stringp, bench_programs[i].name) == 0) {
+            program = &bench_programs[i];
+            break;
+        }
+    }
+    if (program == NULL) {
+        return (STAT_INPUT_VALUE_RANGE_ERROR);
+    }
+    ritorno(cm_is_alarmed());
+    if (bench.running || bench.dry_run || !_machine_is_idle()) {
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    if (!xio_send_file(*program->file)) {
+        return (STAT_COMMAND_NOT_ACCEPTED);         // another file is being sent
+    }
+    bench.program = program;
+    bench.lines = 0;
+    bench.blocks = 0;
+    bench.lines_per_sec = 0;
+    bench.blocks_per_sec = 0;
+    bench.segments_per_sec = 0;
+    bench.seconds = 0;
+    _dry_run_start();
+    bench.start_usec = tb_get_usec();
+    bench.running = true;
+    return (STAT_OK);
+}
+
+#endif // BENCH_ENABLED
@@ -0,0 +1,118 @@
+/*
+ * bench.h - on-board planner benchmark: dry runs of compiled-in programs
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* A dry run plans and executes every block exactly, but doesn't wait on the DDA clock: the
+ *  loader counts each segment and dwell, adds up the time it would have run for, and drops
+ *  it instead of playing it out. So the segments come out as fast as the exec interrupt
+ *  makes them, no step pulses are generated and the axes don't move. Everything else runs
+ *  as it would on a job: M3 turns the spindle on. Take the spindle and coolant off the
+ *  board before a dry run.
+ *
+ *  {bchd:1} starts a dry run of whatever is sent next, e.g. a job to quote. {bchc:} is then
+ *  the cycle time of what has run since, in seconds - the sum of the DDA ticks of every
+ *  segment and of every dwell, which is what the machine would take to play them out. It
+ *  leaves out only the time the machine would wait on the host or a starved planner.
+ *  {bchd:0} ends the dry run and puts the position back where it was at {bchd:1}, as the
+ *  axes never left it. The machine must be idle (no cycle and an empty planner) to start
+ *  or end a dry run. Setting {bchd:1} again clears the cycle time.
+ *
+ *  With BENCH_ENABLED, {bench:"braid2d"} dry runs one of the programs in bench_programs[]
+ *  (bench.cpp) and measures how fast the board gets through it. The program is sent as an
+ *  xio flash file, so its lines go through the controller and Gcode parser as any other job
+ *  does. bench_callback() ends the run once the file is read and the machine has stopped,
+ *  puts the position back and sends the {bch:} group:
+ *
+ *      {"bch":{"bchd":0,"bchc":...,"bchs":0,"bchl":...,"bchb":...,"bchn":...,"bcht":...}}
+ *
+ *      bchd    1 during a dry run
+ *      bchc    cycle time of the dry run (s)
+ *      bchs    1 while a benchmark is running
+ *      bchl    lines read per second
+ *      bchb    blocks run per second
+ *      bchn    segments run per second
+ *      bcht    seconds from the start of the run to the stop
+ *
+ *  "braid2d.bin" is braid2d with its G0, G1 and G4 lines converted to binary frames (see
+ *  binary_parser.cpp) by Resources/tokenize_gcode.py --frames. Those moves skip the Gcode
+ *  parser, so with the same motion the difference from "braid2d" is the parser's share of
+ *  the time, and "braid2d.bin" alone measures the planner and exec. The frames are ACKed to
+ *  the host as any others are. Rebuild the header with the tool if braid2d changes.
+ *
+ *  {bench:n} is the name of the last program run. The benchmark is only compiled in with
+ *  BENCH_ENABLED, as its programs take a lot of flash (braid2d 33KB, braid2d.bin 36KB).
+ *
+ *  Include after xio.h
+ */
+#ifndef BENCH_H_ONCE
+#define BENCH_H_ONCE
+
+/**** Configs, Definitions and Structures ****/
+
+#if BENCH_ENABLED == true
+typedef struct benchProgram {
+    const char *name;                   // {bench:} names the program with this
+    xio_flash_file *file;
+} benchProgram_t;
+#endif
+
+typedef struct benchSingleton {
+    volatile uint8_t dry_run;           // bchd  1 during a dry run - read by the loader
+    float position[AXES];               // runtime position as the dry run started
+    uint32_t underruns;                 // st_pre.underruns as the dry run started - the loader starves by design
+    volatile uint64_t dda_ticks;        // DDA ticks of the segments dropped by the loader
+    volatile uint64_t dwell_ticks;      // dwell ticks of the dwells dropped by the loader
+    volatile uint32_t segments;         // segments dropped by the loader
+    uint8_t running;                    // bchs  1 while a benchmark is running
+
+#if BENCH_ENABLED == true
+    const benchProgram_t *program;      // last program run
+    uint64_t start_usec;                // timebase time the run started
+
+    uint32_t lines;                     // lines read
+    volatile uint32_t blocks;           // blocks run - counted in the exec
+
+    float lines_per_sec;                // bchl
+    float blocks_per_sec;               // bchb
+    float segments_per_sec;             // bchn
+    float seconds;                      // bcht
+#endif
+} bench_t;
+
+extern bench_t bench;
+
+/**** Function Prototypes ****/
+
+stat_t bench_get_bchc(nvObj_t *nv);
+stat_t bench_set_bchd(nvObj_t *nv);
+
+#if BENCH_ENABLED == true
+stat_t bench_callback(void);
+
+stat_t bench_get_bench(nvObj_t *nv);
+stat_t bench_set_bench(nvObj_t *nv);
+#endif
+
+#endif // End of include guard: BENCH_H_ONCE
@@ -0,0 +1,350 @@
+/*
+ * binary_parser.cpp - binary framed motion records on the data channel
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* Binary frames carry pre-parsed motion records from a host streamer, so moves skip the
+ *  Gcode normalizer, the word parser and the float conversions. They share the data channel
+ *  with text Gcode and JSON, and can be mixed with them line by line.
+ *
+ *  Framing. A frame is a line: BINARY_FRAME_START, the data bytes, then a LF. Data bytes that
+ *  are NUL, LF, CR or BINARY_FRAME_ESCAPE are sent as BINARY_FRAME_ESCAPE followed by the byte
+ *  XORed with BINARY_ESCAPE_XOR, so a frame passes through the xio line reader like any other
+ *  line. The data bytes are:
+ *
+ *      seq         uint8   frame sequence number - increments by one per frame, wraps at 255
+ *      type        uint8   binRecordType
+ *      axes        uint8   bit N set if axis N (AXIS_X...AXIS_C) has a target in the record
+ *      flags       uint8   BINARY_FLAG_LINENUM, BINARY_FLAG_FEED
+ *      linenum     uint32  if BINARY_FLAG_LINENUM
+ *      feed        float   if BINARY_FLAG_FEED
+ *      values      float   one per axis in the mask, in axis order (dwell: one, seconds)
+ *      cruise      float   planned feed only - cruise velocity (mm/min)
+ *      exit        float   planned feed only - exit velocity (mm/min)
+ *      horizon     uint8   planned feed only - blocks that must follow before it may run
+ *      crc         uint16  CRC-16/CCITT of all bytes before it
+ *
+ *  Multi-byte values are little-endian and floats are IEEE-754 singles. Targets and feed rates
+ *  are in the current Gcode units, distance mode and feed rate mode - exactly as the X..C and F
+ *  words of the G0/G1 they replace - and go to the same canonical machine functions.
+ *
+ *  Acknowledgements. Frames are taken in sequence and acknowledged cumulatively with an ACK
+ *  frame (type BINARY_RECORD_ACK, seq of the last frame taken, status, window) once
+ *  BINARY_ACK_INTERVAL frames are taken, BINARY_ACK_TIMEOUT_MS after the last one is taken,
+ *  or at once for a SYNC or a record that fails. The host may send up to the window of frames
+ *  past the last ACK. A frame that fails its CRC, or is out of sequence, is answered with a
+ *  NAK for the sequence number expected and the frames after it are dropped until that one
+ *  arrives (go-back-N). A repeated frame that was already taken is dropped and re-acknowledged.
+ *  The first frame after startup or a queue flush (%) sets the sequence, so a NAK sent
+ *  before then only carries its status - the host resends from its oldest frame not ACKed.
+ *
+ *  A frame refused with STAT_EAGAIN by the lookahead queue is held and run again by the
+ *  controller, like a Gcode line. Nothing about it is taken until it is accepted.
+ *
+ *  A planned feed is a G1 whose velocities come from a host running the same planner over a
+ *  deeper queue. The velocities are in the planner's units (mm/min) whatever the Gcode units
+ *  are, and the block skips back-planning here - see mp_aline_planned() for the horizon and
+ *  for what happens if the velocities don't fit. It isn't a lookahead move, so the controller
+ *  holds it until the moves lookahead holds have gone to the planner, as for a dwell.
+ */
+#include "g2core.h"
+#include "config.h"
+#include "binary_parser.h"
+#include "canonical_machine.h"
+#include "hardware.h"
+#include "util.h"
+#include "xio.h"
+
+// Allocate binary parser singleton structure
+
+binSingleton_t bin;
+
+// Local functions
+
+static uint8_t _unstuff_frame(const char *frame, uint8_t *data);
+static stat_t _execute_record(const uint8_t *data, uint8_t length);
+static void _send_frame(const uint8_t type, const uint8_t seq, const stat_t status);
+
+/*
+ * binary_parser_init() - initialize the binary stream state
+ * binary_flush() - forget the sequence after a queue flush
+ */
+
+void binary_parser_init()
+{
+    memset(&bin, 0, sizeof(binSingleton_t));
+}
+
+void binary_flush()
+{
+    bin.synced = false;
+    bin.nak_sent = false;
+    bin.unacked = 0;
+}
+
+/*
+ * binary_parser() - take a binary frame and execute its record
+ *
+ *  Responses are ACK and NAK frames only - never a text or JSON response.
+ *  Returns STAT_EAGAIN if the lookahead queue can't take the move yet, otherwise STAT_OK.
+ */
+
+stat_t binary_parser(const char *frame)
+{
+    uint8_t data[BINARY_FRAME_MAX];
+    uint8_t length = _unstuff_frame(frame, data);
+
+    if ((length < BINARY_HEADER_LEN + BINARY_CRC_LEN) ||
+        (binary_crc16(data, length - BINARY_CRC_LEN) != (data[length-2] | (data[length-1] << 8)))) {
+        if (!bin.nak_sent) {                        // can't trust the sequence number - ask for the one expected
+            _send_frame(BINARY_RECORD_NAK, bin.next_seq, STAT_CHECKSUM_MATCH_FAILED);
+            bin.nak_sent = true;
+        }
+        return (STAT_OK);
+    }
+
+    uint8_t seq = data[0];
+    if (!bin.synced || (data[1] == BINARY_RECORD_SYNC)) {
+        bin.next_seq = seq;                         // this frame sets the sequence
+    } else if (seq != bin.next_seq) {
+        if ((uint8_t)(bin.next_seq - seq) <= BINARY_WINDOW_FRAMES) {
+            bin.unacked = BINARY_ACK_INTERVAL;      // already taken - the ACK was lost, so send one again
+        } else if (!bin.nak_sent) {
+            _send_frame(BINARY_RECORD_NAK, bin.next_seq, STAT_LINE_NUMBER_OUT_OF_SEQUENCE);
+            bin.nak_sent = true;
+        }
+        return (STAT_OK);
+    }
+
+    stat_t status = _execute_record(data, length - BINARY_CRC_LEN);
+    if (status == STAT_EAGAIN) {
+        return (status);                            // not taken - it's held and run again
+    }
+    bin.synced = true;
+    bin.nak_sent = false;
+    bin.next_seq = seq + 1;
+    bin.last_take_tick = SysTickTimer.getValue();
+
+    if ((status != STAT_OK) || (data[1] == BINARY_RECORD_SYNC) || (++bin.unacked >= BINARY_ACK_INTERVAL)) {
+        _send_frame(BINARY_RECORD_ACK, seq, status);
+        bin.unacked = 0;
+    }
+    return (STAT_OK);
+}
+
+/*
+ * binary_callback() - send the ACK for frames taken once the stream pauses
+ */
+
+stat_t binary_callback()
+{
+    if (bin.unacked == 0) {
+        return (STAT_NOOP);
+    }
+    if ((bin.unacked < BINARY_ACK_INTERVAL) &&
+        ((SysTickTimer.getValue() - bin.last_take_tick) < BINARY_ACK_TIMEOUT_MS)) {
+        return (STAT_NOOP);
+    }
+    _send_frame(BINARY_RECORD_ACK, bin.next_seq - 1, STAT_OK);
+    bin.unacked = 0;
+    return (STAT_OK);
+}
+
+/*
+ * binary_is_move_frame() - true if the frame carries a G0 or G1 record
+ *
+ *  Used by mp_lookahead_is_move_line() - the CRC is checked when the frame is run.
+ */
+
+bool binary_is_move_frame(const char *frame)
+{
+    uint8_t data[BINARY_FRAME_MAX];
+    if (_unstuff_frame(frame, data) < BINARY_HEADER_LEN + BINARY_CRC_LEN) {
+        return (false);
+    }
+    return ((data[1] == BINARY_RECORD_TRAVERSE) || (data[1] == BINARY_RECORD_FEED));
+}
+
+/*
+ * _unstuff_frame() - decode the data bytes of a frame
+ *
+ *  Returns the number of data bytes, or 0 if the frame is malformed or too long.
+ */
+
+static uint8_t _unstuff_frame(const char *frame, uint8_t *data)
+{
+    uint8_t length = 0;
+
+    if (*frame++ != BINARY_FRAME_START) {
+        return (0);
+    }
+    for (char c = *frame; (c != NUL) && (c != LF) && (c != CR); c = *(++frame)) {
+        if (c == BINARY_FRAME_ESCAPE) {
+            if ((c = *(++frame)) == NUL) {
+                return (0);
+            }
+            c ^= BINARY_ESCAPE_XOR;
+        }
+        if (length == BINARY_FRAME_MAX) {
+            return (0);
+        }
+        data[length++] = (uint8_t)c;
+    }
+    return (length);
+}
+
+/*
+ * binary_crc16() - CRC-16/CCITT (polynomial 0x1021, initial value 0xFFFF)
+ */
+
+uint16_t binary_crc16(const uint8_t *data, uint8_t length)
+{
+    uint16_t crc = 0xFFFF;
+
+    while (length--) {
+        crc ^= (uint16_t)(*data++) << 8;
+        for (uint8_t i=0; i<8; i++) {
+            crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+        }
+    }
+    return (crc);
+}
+
+/*
+ * _execute_record() - run the record in a frame (less its CRC)
+ */
+
+static stat_t _execute_record(const uint8_t *data, uint8_t length)
+{
+    const uint8_t type = data[1];
+    const uint8_t axes = data[2];
+    const uint8_t flags = data[3];
+    const uint8_t *p = data + BINARY_HEADER_LEN;
+    const uint8_t *end = data + length;
+
+    if (type == BINARY_RECORD_SYNC) {
+        return ((p == end) ? STAT_OK : STAT_INVALID_OR_MALFORMED_COMMAND);
+    }
+    if ((type != BINARY_RECORD_TRAVERSE) && (type != BINARY_RECORD_FEED) && (type != BINARY_RECORD_DWELL) &&
+        (type != BINARY_RECORD_PLANNED_FEED)) {
+        return (STAT_INVALID_OR_MALFORMED_COMMAND);
+    }
+
+    uint32_t linenum = 0;
+    float feed_rate = 0;
+    float value[AXES] = { 0,0,0,0,0,0 };
+    bool flag[AXES] = { 0,0,0,0,0,0 };
+    uint8_t value_count = (type == BINARY_RECORD_DWELL) ? 1 : 0;
+    uint8_t plan_length = (type == BINARY_RECORD_PLANNED_FEED) ? 9 : 0;   // cruise, exit and horizon
+
+    for (uint8_t axis=0; axis<AXES; axis++) {
+        if (axes & (1 << axis)) {
+            flag[axis] = true;
+            value_count++;
+        }
+    }
+    if ((axes >> AXES) || ((type == BINARY_RECORD_DWELL) && (axes != 0)) ||
+        ((end - p) != ((flags & BINARY_FLAG_LINENUM) ? 4 : 0) + ((flags & BINARY_FLAG_FEED) ? 4 : 0) + 4*value_count + plan_length)) {
+        return (STAT_INVALID_OR_MALFORMED_COMMAND);
+    }
+    if (flags & BINARY_FLAG_LINENUM) {
+        memcpy(&linenum, p, 4);                     // frames are not aligned
+        p += 4;
+    }
+    if (flags & BINARY_FLAG_FEED) {
+        memcpy(&feed_rate, p, 4);
+        p += 4;
+    }
+    ritorno(cm_is_alarmed());                       // return error status if in alarm, shutdown or panic
+
+    if (flags & BINARY_FLAG_LINENUM) {
+        cm.gm.linenum = linenum;                    // no nv list to report it in - see cm_set_model_linenum()
+    }
+    if (flags & BINARY_FLAG_FEED) {
+        ritorno(cm_set_feed_rate(feed_rate));
+    }
+    if (type == BINARY_RECORD_DWELL) {
+        float seconds;
+        memcpy(&seconds, p, 4);
+        return (cm_dwell(seconds));
+    }
+    for (uint8_t axis=0; axis<AXES; axis++) {
+        if (flag[axis]) {
+            memcpy(&value[axis], p, 4);
+            p += 4;
+        }
+    }
+    if (type == BINARY_RECORD_TRAVERSE) {
+        return (cm_straight_traverse(value, flag));
+    }
+    if (type == BINARY_RECORD_PLANNED_FEED) {
+        float cruise_velocity, exit_velocity;
+        memcpy(&cruise_velocity, p, 4);
+        memcpy(&exit_velocity, p+4, 4);
+        return (cm_straight_feed_planned(value, flag, cruise_velocity, exit_velocity, p[8]));
+    }
+    return (cm_straight_feed(value, flag));
+}
+
+/*
+ * _send_frame() - send an ACK or NAK frame to the host
+ *
+ *  Data bytes are the sequence number, the record type, the status and the window.
+ */
+
+static void _send_frame(const uint8_t type, const uint8_t seq, const stat_t status)
+{
+    const uint8_t data[4] = { seq, type, status, BINARY_WINDOW_FRAMES };
+    binary_write_frame(data, sizeof(data));
+}
+
+/*
+ * binary_write_frame() - append the CRC to length data bytes, stuff them and send the frame
+ *
+ *  Frames sent to the host have the same framing as those it sends, see above.
+ *  Returns false if the frame was not written.
+ */
+
+bool binary_write_frame(const uint8_t *data, const uint8_t length)
+{
+    char out[2*(BINARY_SEND_MAX + BINARY_CRC_LEN) + 2];
+    char *str = out;
+    uint16_t crc = binary_crc16(data, length);
+    uint8_t crc_bytes[BINARY_CRC_LEN] = { (uint8_t)(crc & 0xFF), (uint8_t)(crc >> 8) };
+
+    if (length > BINARY_SEND_MAX) {
+        return (false);
+    }
+    *str++ = BINARY_FRAME_START;
+    for (uint8_t i=0; i<length + BINARY_CRC_LEN; i++) {
+        char c = (i < length) ? data[i] : crc_bytes[i - length];
+        if ((c == NUL) || (c == LF) || (c == CR) || (c == BINARY_FRAME_ESCAPE)) {
+            *str++ = BINARY_FRAME_ESCAPE;
+            c ^= BINARY_ESCAPE_XOR;
+        }
+        *str++ = c;
+    }
+    *str++ = LF;
+    return (xio_write(out, str - out) == (size_t)(str - out));
+}
@@ -0,0 +1,86 @@
+/*
+ * binary_parser.h - binary framed motion records on the data channel
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef BINARY_PARSER_H_ONCE
+#define BINARY_PARSER_H_ONCE
+
+/**** Configs, Definitions and Structures ****/
+
+#define BINARY_FRAME_START      0x02    // STX - a line starting with this is a binary frame
+#define BINARY_FRAME_ESCAPE     0x10    // DLE - the next character is the data byte XORed with BINARY_ESCAPE_XOR
+#define BINARY_ESCAPE_XOR       0x40    // so NUL, LF, CR and DLE never appear in a frame
+#define BINARY_FRAME_MAX        48      // max data bytes in a frame, sequence number through CRC
+#define BINARY_SEND_MAX         64      // max data bytes in a frame sent to the host, less the CRC
+
+#define BINARY_HEADER_LEN       4       // sequence, record type, axis mask, flags
+#define BINARY_CRC_LEN          2       // CRC-16/CCITT, low byte first
+
+#ifndef BINARY_WINDOW_FRAMES
+#define BINARY_WINDOW_FRAMES    16      // frames the host may send past the last frame acknowledged
+#endif
+#ifndef BINARY_ACK_INTERVAL
+#define BINARY_ACK_INTERVAL     (BINARY_WINDOW_FRAMES/2)    // frames taken before an ACK is sent
+#endif
+#ifndef BINARY_ACK_TIMEOUT_MS
+#define BINARY_ACK_TIMEOUT_MS   20      // ACK frames taken if no more have been taken in this time
+#endif
+
+typedef enum {                          // record types (second byte of a frame)
+    BINARY_RECORD_SYNC = 0,             // restart the sequence at this frame. Carries nothing
+    BINARY_RECORD_TRAVERSE,             // G0 - optional line number and feed, then one float per axis in the mask
+    BINARY_RECORD_FEED,                 // G1 - as for traverse
+    BINARY_RECORD_DWELL,                // G4 - optional line number, then one float: seconds
+    BINARY_RECORD_PLANNED_FEED,         // G1 planned by the host - as for feed, then cruise, exit and horizon
+    BINARY_RECORD_ACK = 0x80,           // sent to the host: frames are taken up to and including this sequence
+    BINARY_RECORD_NAK,                  // sent to the host: resend starting with this sequence
+    BINARY_RECORD_TELEMETRY             // sent to the host: a runtime sample - see telemetry.h
+} binRecordType;
+
+#define BINARY_FLAG_LINENUM     0x01    // record carries a uint32 line number (first)
+#define BINARY_FLAG_FEED        0x02    // record carries a float feed rate (after the line number)
+
+typedef struct binSingleton {
+    bool synced;                        // false until the first frame after init or a queue flush
+    bool nak_sent;                      // a NAK was sent for next_seq - drop frames until it arrives
+    uint8_t next_seq;                   // sequence number of the next frame to take
+    uint8_t unacked;                    // frames taken since the last ACK
+    uint32_t last_take_tick;            // systick value when the last frame was taken
+} binSingleton_t;
+
+extern binSingleton_t bin;
+
+/**** Function Prototypes ****/
+
+void binary_parser_init(void);
+void binary_flush(void);
+stat_t binary_parser(const char *frame);
+stat_t binary_callback(void);
+bool binary_is_move_frame(const char *frame);
+bool binary_write_frame(const uint8_t *data, const uint8_t length);
+uint16_t binary_crc16(const uint8_t *data, uint8_t length);
+
+#endif // End of include guard: BINARY_PARSER_H_ONCE
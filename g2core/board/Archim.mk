@@ -25,6 +25,8 @@ ifeq ("$(BASE_BOARD)","archim")
     _BOARD_FOUND = 1
 
     DEVICE_DEFINES += MOTATE_CONFIG_HAS_USBSERIAL=1
+    DEVICE_DEFINES += PLANNER_BUFFER_POOL_SIZE=48
+    DEVICE_DEFINES += FORWARD_DIFFS_FIXED_POINT=1
 
     FIRST_LINK_SOURCES += $(sort $(wildcard ${MOTATE_PATH}/Atmel_sam_common/*.cpp)) $(sort $(wildcard ${MOTATE_PATH}/Atmel_sam3x/*.cpp))
 
@@ -32,6 +32,9 @@ endif
 ifeq ("$(BASE_BOARD)","g2v9")
     _BOARD_FOUND = 1
 
+    DEVICE_DEFINES += PLANNER_BUFFER_POOL_SIZE=48
+    DEVICE_DEFINES += FORWARD_DIFFS_FIXED_POINT=1
+
     FIRST_LINK_SOURCES += $(sort $(wildcard ${MOTATE_PATH}/Atmel_sam_common/*.cpp)) $(sort $(wildcard ${MOTATE_PATH}/Atmel_sam3x/*.cpp))
 
     # Set CHIP and export it for GDB to see
@@ -26,6 +26,11 @@ ifeq ("$(BASE_BOARD)","gquadratic")
     _BOARD_FOUND = 1
 
     DEVICE_DEFINES += MOTATE_CONFIG_HAS_USBSERIAL=0
+    DEVICE_DEFINES += PLANNER_BUFFER_POOL_SIZE=192
+    DEVICE_DEFINES += XIO_RX_RING_SIZE=4096 XIO_RX_LINE_INDEX_SIZE=128
+    # let each RX transfer take at least two high-speed USB packets
+    DEVICE_DEFINES += XIO_RX_TRANSFER_MIN_FREE=1024
+#   DEVICE_DEFINES += STEP_ENGINE_WAVEFORM=1     # DMA step waveforms - needs StepDirWaveform motors in board_stepper
 
     FIRST_LINK_SOURCES += $(sort $(wildcard ${MOTATE_PATH}/Atmel_sam_common/*.cpp)) $(sort $(wildcard ${MOTATE_PATH}/Atmel_sams70/*.cpp))
 
@@ -34,7 +39,7 @@ ifeq ("$(BASE_BOARD)","gquadratic")
     CHIP_LOWERCASE = sams70n19
 
     BOARD_PATH = ./board/gquadratic
-    SOURCE_DIRS += ${BOARD_PATH} device/step_dir_driver device/step_dir_hobbyservo device/neopixel
+    SOURCE_DIRS += ${BOARD_PATH} device/step_dir_driver device/step_dir_hobbyservo device/step_dir_waveform device/neopixel
 
     PLATFORM_BASE = ${MOTATE_PATH}/platform/atmel_sam
     include $(PLATFORM_BASE).mk
@@ -69,12 +69,37 @@ namespace LEDs {
     float old_x_pos = 0.0;
 }
 
+/*
+ * _cache_init() - turn on the M7 caches
+ *
+ *  The data cache is forced write-through, so DMA never finds stale data in memory and
+ *  receive buffers only need invalidating before they are read - see hw_dcache_invalidate().
+ *  If the startup code already turned it on it is cleaned before the policy changes.
+ */
+
+static void _cache_init()
+{
+    SCB_EnableICache();
+#if HW_DCACHE_ENABLED == true
+    if (SCB->CCR & SCB_CCR_DC_Msk) {
+        SCB_CleanDCache();
+    }
+    SCB->CACR |= SCB_CACR_FORCEWT_Msk;
+    __DSB();
+    __ISB();
+    if (!(SCB->CCR & SCB_CCR_DC_Msk)) {
+        SCB_EnableDCache();
+    }
+#endif
+}
+
 /*
  * hardware_init() - lowest level hardware init
  */
 
 void hardware_init()
 {
+    _cache_init();
     board_hardware_init();
 //    external_clk_pin = 0; // Force external clock to 0 for now.
 
@@ -27,6 +27,10 @@ ifeq ("$(BASE_BOARD)","gquintic")
     _BOARD_FOUND = 1
 
     DEVICE_DEFINES += MOTATE_CONFIG_HAS_USBSERIAL=1
+    DEVICE_DEFINES += PLANNER_BUFFER_POOL_SIZE=192
+    DEVICE_DEFINES += XIO_RX_RING_SIZE=4096 XIO_RX_LINE_INDEX_SIZE=128
+    # let each RX transfer take at least two high-speed USB packets
+    DEVICE_DEFINES += XIO_RX_TRANSFER_MIN_FREE=1024
 
     FIRST_LINK_SOURCES += $(sort $(wildcard ${MOTATE_PATH}/Atmel_sam_common/*.cpp)) $(sort $(wildcard ${MOTATE_PATH}/Atmel_sams70/*.cpp))
 
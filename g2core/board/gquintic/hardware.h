@@ -88,6 +88,10 @@ using Motate::OutputPin;
 #define SYS_ID_DIGITS 12            // actual digits in system ID (up to 16)
 #define SYS_ID_LEN 24               // total length including dashes and NUL
 
+#ifndef HW_DCACHE_ENABLED
+#define HW_DCACHE_ENABLED true      // run the M7 data cache (write-through) - see hardware_init()
+#endif
+
 /************************************************************************************
  **** ARM SAM3X8E SPECIFIC HARDWARE *************************************************
  ************************************************************************************/
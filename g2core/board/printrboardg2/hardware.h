@@ -127,8 +127,8 @@ using Motate::OutputPin;
 
 // Timer definitions. See stepper.h and other headers for setup
 typedef TimerChannel<3,0> dda_timer_type;	// stepper pulse generation in stepper.cpp
-typedef TimerChannel<4,0> exec_timer_type;	// request exec timer in stepper.cpp
-typedef TimerChannel<5,0> fwd_plan_timer_type;	// request exec timer in stepper.cpp
+typedef ServiceCall<1> exec_timer_type;	    // request exec timer in stepper.cpp
+typedef ServiceCall<2> fwd_plan_timer_type;	// request exec timer in stepper.cpp
 
 // Pin assignments
 
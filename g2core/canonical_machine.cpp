@@ -96,9 +96,13 @@
 #include "settings.h"
 
 #include "plan_arc.h"
+#include "plan_spline.h"
 #include "planner.h"
+#include "plan_coalesce.h"
+#include "plan_lookahead.h"
 #include "stepper.h"
 #include "encoder.h"
+#include "kinematics.h"
 #include "spindle.h"
 #include "coolant.h"
 #include "pwm.h"
@@ -120,6 +124,7 @@ cmSingleton_t cm;        // canonical machine controller singleton
  ***********************************************************************************/
 
 // command execution callbacks from planner queue
+static void _update_active_offset(void);
 static void _exec_offset(float *value, bool *flag);
 static void _exec_change_tool(float *value, bool *flag);
 static void _exec_select_tool(float *value, bool *flag);
@@ -142,6 +147,7 @@ static int8_t _get_axis(const index_t index);
 void cm_set_motion_state(const cmMotionState motion_state)
 {
     cm.motion_state = motion_state;
+    sr_mark_dirty(SR_DIRTY_RUNTIME | SR_DIRTY_MODEL);   // the active model changes, and a stop ends the filtering
 
     switch (motion_state) {
         case (MOTION_STOP):     { ACTIVE_MODEL = MODEL; break; }
@@ -220,7 +226,7 @@ cmCombinedState cm_get_combined_state()
 
 /*  These getters and setters will work on any gm model with inputs:
  *    MODEL         (GCodeState_t *)&cm.gm          // absolute pointer from canonical machine gm model
- *    PLANNER       (GCodeState_t *)&bf->gm         // relative to buffer *bf is currently pointing to
+ *    PLANNER       mp_get_block_gm(bf)             // shared state of the block *bf is pointing to
  *    RUNTIME       (GCodeState_t *)&mr.gm          // absolute pointer from runtime mm struct
  *    ACTIVE_MODEL   cm.am                          // active model pointer is maintained by state management
  */
@@ -309,18 +315,34 @@ float cm_get_active_coord_offset(const uint8_t axis)
     if (cm.gm.absolute_override == ABSOLUTE_OVERRIDE_ON) {  // no offset if in absolute override mode
         return (0.0);
     }
-    float offset = cm.offset[cm.gm.coord_system][axis] + cm.tl_offset[axis];
-    if (cm.gmx.origin_offset_enable == true) {
-        offset += cm.gmx.origin_offset[axis];               // includes G5x and G92 components
+    return (cm.active_offset[axis]);
+}
+
+/*
+ * _update_active_offset() - recombine the offsets returned by cm_get_active_coord_offset()
+ *
+ *    Every move and status report needs the sum of the G5x, G92 and tool length offsets, but
+ *    they only change with G10, G43/G49, G54-G59, G92 and the $g54x-$g59c settings. Each of
+ *    those calls this once after it has changed its part, so the sum is not redone per axis
+ *    for every block.
+ */
+
+static void _update_active_offset()
+{
+    for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
+        cm.active_offset[axis] = cm.offset[cm.gm.coord_system][axis] + cm.tl_offset[axis];
+        if (cm.gmx.origin_offset_enable == true) {
+            cm.active_offset[axis] += cm.gmx.origin_offset[axis];   // includes G5x and G92 components
+        }
     }
-    return (offset);
+    sr_mark_dirty(SR_DIRTY_MODEL);                      // work positions and offsets
 }
 
 /*
  * cm_get_work_offset() - return a coord offset from the gcode_state
  *
  *    MODEL         (GCodeState_t *)&cm.gm          // absolute pointer from canonical machine gm model
- *    PLANNER       (GCodeState_t *)&bf->gm         // relative to buffer *bf is currently pointing to
+ *    PLANNER       mp_get_block_gm(bf)             // shared state of the block *bf is pointing to
  *    RUNTIME       (GCodeState_t *)&mr.gm          // absolute pointer from runtime mm struct
  *    ACTIVE_MODEL   cm.am                          // active model pointer is maintained by state management
  */
@@ -334,7 +356,7 @@ float cm_get_work_offset(const GCodeState_t *gcode_state, const uint8_t axis)
  * cm_set_work_offsets() - capture coord offsets from the model into absolute values in the gcode_state
  *
  *    MODEL         (GCodeState_t *)&cm.gm          // absolute pointer from canonical machine gm model
- *    PLANNER       (GCodeState_t *)&bf->gm         // relative to buffer *bf is currently pointing to
+ *    PLANNER       mp_get_block_gm(bf)             // shared state of the block *bf is pointing to
  *    RUNTIME       (GCodeState_t *)&mr.gm          // absolute pointer from runtime mm struct
  *    ACTIVE_MODEL   cm.am                          // active model pointer is maintained by state management
  */
@@ -616,6 +638,10 @@ stat_t cm_get_nxln(nvObj_t *nv)
  *              - Target is set to degrees based on axis' Radius value
  *              - Radius mode is only processed for ABC axes. Application to XYZ is ignored.
  *
+ *  An ABC axis with {awr:1} takes an absolute target as an angle modulo 360, and moves by
+ *  less than half a turn to get to it - see _wrap_ABC(). Incremental moves, and the moves of
+ *  homing, probing and jogging cycles, go as programmed.
+ *
  *  Target coordinates are provided in target[]
  *  Axes that need processing are signaled in flag[]
  */
@@ -626,7 +652,7 @@ stat_t cm_get_nxln(nvObj_t *nv)
 
 static float _calc_ABC(const uint8_t axis, const float target[])
 {
-    if ((cm.a[axis].axis_mode == AXIS_STANDARD) || (cm.a[axis].axis_mode == AXIS_INHIBITED)) {
+    if ((KN_AXIS_MODE(axis) == AXIS_STANDARD) || (KN_AXIS_MODE(axis) == AXIS_INHIBITED)) {
         return(target[axis]);    // no mm conversion - it's in degrees
     }
 
@@ -635,6 +661,20 @@ static float _calc_ABC(const uint8_t axis, const float target[])
     return (_to_millimeters(target[axis]) * 360.0 / (2.0 * M_PI * cm.a[axis].radius));
 }
 
+/*
+ * _wrap_ABC() - move an absolute rotary target by whole turns to the nearest one to the position
+ *
+ *  The position is not wrapped, it carries on counting turns. So a CAM file that unwinds
+ *  to A0 after many turns, or goes from 350 to 10, takes the short way and needs no
+ *  unwrapping on the host.
+ */
+
+static float _wrap_ABC(const uint8_t axis)
+{
+    float position = cm.gmx.position[axis];
+    return (position + remainderf(cm.gm.target[axis] - position, 360.0));
+}
+
 void cm_set_model_target(const float target[], const bool flags[])
 {
     uint8_t axis;
@@ -645,9 +685,9 @@ void cm_set_model_target(const float target[], const bool flags[])
 
     // process XYZABC for lower modes
     for (axis=AXIS_X; axis<=AXIS_Z; axis++) {
-        if (!flags[axis] || cm.a[axis].axis_mode == AXIS_DISABLED) {
+        if (!flags[axis] || KN_AXIS_MODE(axis) == AXIS_DISABLED) {
             continue;        // skip axis if not flagged for update or its disabled
-        } else if ((cm.a[axis].axis_mode == AXIS_STANDARD) || (cm.a[axis].axis_mode == AXIS_INHIBITED)) {
+        } else if ((KN_AXIS_MODE(axis) == AXIS_STANDARD) || (KN_AXIS_MODE(axis) == AXIS_INHIBITED)) {
             if (cm.gm.distance_mode == ABSOLUTE_DISTANCE_MODE) {
                 cm.gm.target[axis] = cm_get_active_coord_offset(axis) + _to_millimeters(target[axis]);
             } else {
@@ -657,7 +697,7 @@ void cm_set_model_target(const float target[], const bool flags[])
     }
     // FYI: The ABC loop below relies on the XYZ loop having been run first
     for (axis=AXIS_A; axis<=AXIS_C; axis++) {
-        if (!flags[axis] || cm.a[axis].axis_mode == AXIS_DISABLED) {
+        if (!flags[axis] || KN_AXIS_MODE(axis) == AXIS_DISABLED) {
             continue;        // skip axis if not flagged for update or its disabled
         } else {
             tmp = _calc_ABC(axis, target);
@@ -681,6 +721,9 @@ void cm_set_model_target(const float target[], const bool flags[])
 #endif // MARLIN_COMPAT_ENABLED
         if (cm.gm.distance_mode == ABSOLUTE_DISTANCE_MODE) {
             cm.gm.target[axis] = tmp + cm_get_active_coord_offset(axis); // sacidu93's fix to Issue #22
+            if (cm.a[axis].wrap && (cm.cycle_state <= CYCLE_MACHINING)) {
+                cm.gm.target[axis] = _wrap_ABC(axis);
+            }
         }
         else {
             cm.gm.target[axis] += tmp;
@@ -691,7 +734,9 @@ void cm_set_model_target(const float target[], const bool flags[])
 /*
  * cm_get_soft_limits()
  * cm_set_soft_limits()
- * cm_test_soft_limits() - return error code if soft limit is exceeded
+ * cm_update_soft_limits() - rebuild the table of soft limits in effect
+ * cm_check_soft_limits()  - return error code if the box from box_min[] to box_max[] exceeds a soft limit
+ * cm_test_soft_limits()   - return error code and alarm if the target exceeds a soft limit
  *
  *  The target[] arg must be in absolute machine coordinates. Best done after cm_set_model_target().
  *
@@ -699,10 +744,37 @@ void cm_set_model_target(const float target[], const bool flags[])
  *  and max to the same value (e.g. 0,0) to disable soft limits for an axis. Also will not test
  *  a min or a max if the value is more than +/- 1000000 (plus or minus 1 million ).
  *  This allows a single end to be tested w/the other disabled, should that requirement ever arise.
+ *
+ *  Those rules only change with the homed flags, {sl:} and the {xtn:} / {xtm:} settings, so
+ *  cm_update_soft_limits() is called when they do and folds them into soft_limit_min[] and
+ *  soft_limit_max[], with -/+ INFINITY for an axis that is not tested. The test per block is
+ *  then the same compare for every axis, without early exit, and only looks for the axis to
+ *  report once it has found one out of bounds.
  */
 
 bool cm_get_soft_limits() { return (cm.soft_limit_enable); }
-void cm_set_soft_limits(bool enable) { cm.soft_limit_enable = enable; }
+
+void cm_set_soft_limits(bool enable)
+{
+    cm.soft_limit_enable = enable;
+    cm_update_soft_limits();
+}
+
+void cm_update_soft_limits()
+{
+    for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
+        if ((cm.soft_limit_enable == true) && (cm.homed[axis] == true) &&
+            (!fp_EQ(cm.a[axis].travel_min, cm.a[axis].travel_max)) &&
+            (fabs(cm.a[axis].travel_min) <= DISABLE_SOFT_LIMIT) &&
+            (fabs(cm.a[axis].travel_max) <= DISABLE_SOFT_LIMIT)) {
+            cm.soft_limit_min[axis] = cm.a[axis].travel_min;
+            cm.soft_limit_max[axis] = cm.a[axis].travel_max;
+        } else {
+            cm.soft_limit_min[axis] = -INFINITY;
+            cm.soft_limit_max[axis] = INFINITY;
+        }
+    }
+}
 
 static stat_t _finalize_soft_limits(const stat_t status)
 {
@@ -711,26 +783,35 @@ static stat_t _finalize_soft_limits(const stat_t status)
     return (cm_alarm(status, "soft_limits"));               // throw an alarm
 }
 
-stat_t cm_test_soft_limits(const float target[])
+stat_t cm_check_soft_limits(const float box_min[], const float box_max[])
 {
-    if (cm.soft_limit_enable == true) {
-        for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
-            if (cm.homed[axis] != true) { continue; }                               // skip axis if not homed
-            if (fp_EQ(cm.a[axis].travel_min, cm.a[axis].travel_max)) { continue; }  // skip axis if identical
-            if (fabs(cm.a[axis].travel_min) > DISABLE_SOFT_LIMIT) { continue; }     // skip min test if disabled
-            if (fabs(cm.a[axis].travel_max) > DISABLE_SOFT_LIMIT) { continue; }     // skip max test if disabled
-
-            if (target[axis] < cm.a[axis].travel_min) {
-                return (_finalize_soft_limits(STAT_SOFT_LIMIT_EXCEEDED_XMIN + 2*axis));
-            }
-            if (target[axis] > cm.a[axis].travel_max) {
-                return (_finalize_soft_limits(STAT_SOFT_LIMIT_EXCEEDED_XMAX + 2*axis));
-            }
+    bool exceeded = false;
+    for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
+        exceeded |= (box_min[axis] < cm.soft_limit_min[axis]) | (box_max[axis] > cm.soft_limit_max[axis]);
+    }
+    if (!exceeded) {
+        return (STAT_OK);
+    }
+    for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
+        if (box_min[axis] < cm.soft_limit_min[axis]) {
+            return (STAT_SOFT_LIMIT_EXCEEDED_XMIN + 2*axis);
+        }
+        if (box_max[axis] > cm.soft_limit_max[axis]) {
+            return (STAT_SOFT_LIMIT_EXCEEDED_XMAX + 2*axis);
         }
     }
     return (STAT_OK);
 }
 
+stat_t cm_test_soft_limits(const float target[])
+{
+    stat_t status = cm_check_soft_limits(target, target);
+    if (status != STAT_OK) {
+        return (_finalize_soft_limits(status));
+    }
+    return (STAT_OK);
+}
+
 /*************************************************************************
  * CANONICAL MACHINING FUNCTIONS
  *  Values are passed in pre-unit_converted state (from gn structure)
@@ -755,10 +836,12 @@ void canonical_machine_init()
 //    memset(&cm, 0, sizeof(cm));                 // do not reset canonicalMachineSingleton once it's been initialized
     memset(&cm, 0, sizeof(cmSingleton_t));      // do not reset canonicalMachineSingleton once it's been initialized
     cm.gm.reset();                              // clear all values, pointers and status -- not ALL to zero, however
+    cm_update_soft_limits();                    // no soft limits until configured and homed
 
     canonical_machine_init_assertions();        // establish assertions
     ACTIVE_MODEL = MODEL;                       // setup initial Gcode model pointer
     cm_arc_init();                              // Note: spindle and coolant inits are independent
+    cm_spline_init();
 }
 
 void canonical_machine_reset_rotation() {
@@ -1012,6 +1095,7 @@ stat_t cm_shutdown(const stat_t status, const char *msg)
     for (uint8_t i = 0; i < HOMING_AXES; i++) { // unhome axes and the machine
         cm.homed[i] = false;
     }
+    cm_update_soft_limits();
     cm.homing_state = HOMING_NOT_HOMED;
 
     cm.machine_state = MACHINE_SHUTDOWN;        // do this after all other activity
@@ -1127,6 +1211,7 @@ stat_t cm_set_g10_data(const uint8_t P_word, const bool P_flag,
                 cm.deferred_write_flag = true;
             }
         }
+        _update_active_offset();
     }
     else if ((L_word == 1) || (L_word == 10)) {
         // tool table offset command. L11 not supported atm.
@@ -1189,6 +1274,7 @@ stat_t cm_set_tl_offset(const uint8_t H_word, const bool H_flag, const bool appl
             cm.tl_offset[axis] = cm.tt_offset[tool][axis];
         }
     }
+    _update_active_offset();
     float value[] = { (float)cm.gm.coord_system,0,0,0,0,0 };// pass coordinate system in value[0] element
     bool flags[]  = { 1,0,0,0,0,0 };
     mp_queue_command(_exec_offset, value, flags);			// second vector (flags) is not used, so fake it
@@ -1200,6 +1286,7 @@ stat_t cm_cancel_tl_offset()
     for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
         cm.tl_offset[axis] = 0;
     }
+    _update_active_offset();
     float value[] = { (float)cm.gm.coord_system,0,0,0,0,0 };// pass coordinate system in value[0] element
     bool flags[]  = { 1,0,0,0,0,0 };
     mp_queue_command(_exec_offset, value, flags);			// second vector (flags) is not used, so fake it
@@ -1209,6 +1296,7 @@ stat_t cm_cancel_tl_offset()
 stat_t cm_set_coord_system(const uint8_t coord_system)      // set coordinate system sync'd with planner
 {
     cm.gm.coord_system = (cmCoordSystem)coord_system;
+    _update_active_offset();
 
     float value[] = { (float)coord_system,0,0,0,0,0 };      // pass coordinate system in value[0] element
     bool flags[]  = { 1,0,0,0,0,0 };
@@ -1297,6 +1385,7 @@ static void _exec_absolute_origin(float *value, bool *flag)
             cm.homed[axis] = true;    // G28.3 is not considered homed until you get here
         }
     }
+    cm_update_soft_limits();
     mp_set_steps_to_runtime_position();
 }
 
@@ -1322,6 +1411,7 @@ stat_t cm_set_origin_offsets(const float offset[], const bool flag[])
                                          _to_millimeters(offset[axis]);
         }
     }
+    _update_active_offset();
     // now pass the offset to the callback - setting the coordinate system also applies the offsets
     float value[] = { (float)cm.gm.coord_system,0,0,0,0,0 }; // pass coordinate system in value[0] element
     bool flags[]  = { 1,0,0,0,0,0 };
@@ -1335,6 +1425,7 @@ stat_t cm_reset_origin_offsets()
     for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
         cm.gmx.origin_offset[axis] = 0;
     }
+    _update_active_offset();
     float value[] = { (float)cm.gm.coord_system,0,0,0,0,0 };
     bool flags[]  = { 1,0,0,0,0,0 };
     mp_queue_command(_exec_offset, value, flags);
@@ -1344,6 +1435,7 @@ stat_t cm_reset_origin_offsets()
 stat_t cm_suspend_origin_offsets()
 {
     cm.gmx.origin_offset_enable = false;
+    _update_active_offset();
     float value[] = { (float)cm.gm.coord_system,0,0,0,0,0 };
     bool flags[]  = { 1,0,0,0,0,0 };
     mp_queue_command(_exec_offset, value, flags);
@@ -1353,6 +1445,7 @@ stat_t cm_suspend_origin_offsets()
 stat_t cm_resume_origin_offsets()
 {
     cm.gmx.origin_offset_enable = true;
+    _update_active_offset();
     float value[] = { (float)cm.gm.coord_system,0,0,0,0,0 };
     bool flags[]  = { 1,0,0,0,0,0 };
     mp_queue_command(_exec_offset, value, flags);
@@ -1379,7 +1472,19 @@ stat_t cm_straight_traverse(const float target[], const bool flags[])
     ritorno (cm_test_soft_limits(cm.gm.target));    // test soft limits; exit if thrown
     cm_set_work_offsets(&cm.gm);                    // capture the fully resolved offsets to the state
     cm_cycle_start();                               // required for homing & other cycles
-    stat_t status = mp_aline(&cm.gm);               // send the move to the planner
+
+    stat_t status;
+    if (cm.cycle_state == CYCLE_MACHINING) {        // program moves may be held by the lookahead queue
+        status = mp_lookahead_aline(&cm.gm, cm.gmx.position);
+        if (status == STAT_EAGAIN) {
+            return (status);                        // not finalized - the line is held and run again
+        }
+    } else {
+        status = mp_aline(&cm.gm);                  // send the move to the planner
+    }
+    if (status == STAT_OK) {
+        cm.gm.output_count = 0;                     // M62/M63 changes went with the move
+    }
     cm_finalize_move();
     
     if (status == STAT_MINIMUM_LENGTH_MOVE) {
@@ -1504,6 +1609,7 @@ stat_t cm_set_path_control(GCodeState_t *gcode_state, const uint8_t mode)
  *******************************/
 /*
  * cm_arc_feed() - SEE plan_arc.cpp
+ * cm_spline_feed() - SEE plan_spline.cpp
  */
 
 
@@ -1536,12 +1642,28 @@ stat_t cm_straight_feed(const float target[], const bool flags[])
     ritorno (cm_test_soft_limits(cm.gm.target));    // test soft limits; exit if thrown
     cm_set_work_offsets(&cm.gm);                    // capture the fully resolved offsets to the state
     cm_cycle_start();                               // required for homing & other cycles
-    stat_t status = mp_aline(&cm.gm);               // send the move to the planner
+    if (cm.gm.raster_row < 0) {                     // still set if the line was held and run again
+        cm.gm.raster_row = cm_raster_claim();       // take the raster row staged for this move, if any
+    }
+
+    stat_t status;
+    if (cm.cycle_state == CYCLE_MACHINING) {        // only hold or coalesce program moves, never cycle moves
+        status = mp_lookahead_aline(&cm.gm, cm.gmx.position);   // send the move through lookahead and the coalescer
+        if (status == STAT_EAGAIN) {
+            return (status);                        // not finalized - the line is held and run again
+        }
+    } else {
+        status = mp_aline(&cm.gm);                  // send the move to the planner
+    }
+    cm.gm.raster_row = -1;                          // the row goes with this move only
+    if (status == STAT_OK) {
+        cm.gm.output_count = 0;                     // M62/M63 changes went with the move
+    }
 
     cm_finalize_move(); // <-- ONLY safe because we don't care about status...
 
     if (status == STAT_MINIMUM_LENGTH_MOVE) {
-        if (!mp_has_runnable_buffer()) {            // handle condition where zero-length move is last or only move
+        if (!mp_has_runnable_buffer() && !coal.pending) {   // handle condition where zero-length move is last or only move
             cm_cycle_end();                         // ...otherwise cycle will not end properly
         }
         status = STAT_OK;
@@ -1549,6 +1671,92 @@ stat_t cm_straight_feed(const float target[], const bool flags[])
     return (status);
 }
 
+/*
+ * cm_straight_feed_planned() - G1 with velocities planned by the host (see mp_aline_planned())
+ *
+ *  Only sent by the binary protocol, which holds it until lookahead has released every move
+ *  it held, so it goes to the planner directly. Velocities are in mm/min.
+ */
+stat_t cm_straight_feed_planned(const float target[], const bool flags[],
+                                const float cruise_velocity, const float exit_velocity, const uint8_t horizon)
+{
+    if (fp_ZERO(cm.gm.feed_rate)) {
+        return (STAT_GCODE_FEEDRATE_NOT_SPECIFIED);
+    }
+    cm.gm.motion_mode = MOTION_MODE_STRAIGHT_FEED;
+
+    if (!(flags[AXIS_X] | flags[AXIS_Y] | flags[AXIS_Z] | flags[AXIS_A] | flags[AXIS_B] | flags[AXIS_C])) {
+        return(STAT_OK);
+    }
+
+    cm_set_model_target(target, flags);
+    ritorno (cm_test_soft_limits(cm.gm.target));    // test soft limits; exit if thrown
+    cm_set_work_offsets(&cm.gm);                    // capture the fully resolved offsets to the state
+    cm_cycle_start();
+
+    stat_t status = mp_aline_planned(&cm.gm, cruise_velocity, exit_velocity, horizon);
+    if (status == STAT_OK) {
+        cm.gm.output_count = 0;                     // M62/M63 changes went with the move
+    }
+
+    cm_finalize_move();
+
+    if (status == STAT_MINIMUM_LENGTH_MOVE) {
+        if (!mp_has_runnable_buffer()) {            // handle condition where zero-length move is last or only move
+            cm_cycle_end();
+        }
+        status = STAT_OK;
+    }
+    return (status);
+}
+
+/*
+ * cm_spindle_sync_feed() - G33 spindle synchronized motion and G33.1 rigid tapping
+ *
+ *  The move advances K per turn of the spindle, measured by the spindle encoder, so the
+ *  feed rate is the spindle's. K is required in every block. A G33.1 taps to the target
+ *  and back out, so the model position doesn't change. See plan_sync.h.
+ */
+stat_t cm_spindle_sync_feed(const float target[], const bool flags[],
+                            const float pitch, const bool pitch_f, const bool tap)
+{
+    cm.gm.motion_mode = (tap) ? MOTION_MODE_RIGID_TAP : MOTION_MODE_SPINDLE_SYNC;
+
+    if (!(flags[AXIS_X] | flags[AXIS_Y] | flags[AXIS_Z] | flags[AXIS_A] | flags[AXIS_B] | flags[AXIS_C])) {
+        return(STAT_OK);
+    }
+    if (!pitch_f) {
+        return (STAT_K_WORD_IS_MISSING);
+    }
+    if (pitch <= 0) {
+        return (STAT_K_WORD_IS_INVALID);
+    }
+    if (!en_spindle_is_present()) {
+        return (STAT_SPINDLE_ENCODER_MISSING);
+    }
+    if (spindle.enable != SPINDLE_ON) {
+        return (STAT_SPINDLE_MUST_BE_TURNING);
+    }
+
+    cm_set_model_target(target, flags);
+    ritorno (cm_test_soft_limits(cm.gm.target));    // test soft limits; exit if thrown
+    cm_set_work_offsets(&cm.gm);                    // capture the fully resolved offsets to the state
+    cm_cycle_start();
+
+    stat_t status = mp_sync_line(&cm.gm, _to_millimeters(pitch), tap);
+    if (!tap) {
+        cm_finalize_move();
+    }
+
+    if (status == STAT_MINIMUM_LENGTH_MOVE) {
+        if (!mp_has_runnable_buffer()) {            // handle condition where zero-length move is last or only move
+            cm_cycle_end();
+        }
+        status = STAT_OK;
+    }
+    return (status);
+}
+
 /*****************************
  * Spindle Functions (4.3.7) *
  *****************************/
@@ -1788,15 +1996,17 @@ stat_t cm_mto_control(const float P_word, const bool P_flag) // M50.1
  *      after the current move segment is finished (< 5 ms later). (Cases handled by
  *      feedhold processing are listed in plan_exec.c).
  *
- *    - FEEDHOLD_SYNC causes the current move in mr to be replanned into a deceleration.
- *      If the distance remaining in the executing move is sufficient for a full deceleration
- *      then motion will stop in the current block. Otherwise the deceleration phase
- *      will extend across as many blocks necessary until one will stop.
+ *    - FEEDHOLD_SYNC starts a jerk-limited stop from the runtime's velocity and acceleration
+ *      as they are, even part way up a head - the shortest stop the jerk allows. It runs
+ *      along the path of the executing move, and on across as many queued blocks as it
+ *      takes, without replanning them (see _exec_aline_hold() in plan_exec.cpp).
  *
  *    - Once deceleration is complete hold state transitions to FEEDHOLD_HOLD and the
  *      distance remaining in the bf last block is replanned up from zero velocity.
- *      The move in the bf block is NOT released (unlike normal operation), as it
- *      will be used again to restart from hold.
+ *      Only its forward plan is redone, while the steppers settle - the back-planning
+ *      of the blocks after it stands (see mp_replan_queue()). The move in the bf block
+ *      is NOT released (unlike normal operation), as it will be used again to restart
+ *      from hold, and it is ready to run by the time the hold is reached.
  *
  *    - When cm_end_hold() is called it releases the hold, restarts the move and restarts
  *      the spindle if the spindle is active.
@@ -1867,9 +2077,19 @@ void cm_request_queue_flush()
 
 /*
  * cm_feedhold_sequencing_callback() - sequence feedhold, queue_flush, and end_hold requests
+ *
+ *  The xio realtime scan only sets the rt_ flags from interrupt - they are turned into requests here.
  */
 stat_t cm_feedhold_sequencing_callback()
 {
+    if (cm.rt_feedhold_requested) {
+        cm.rt_feedhold_requested = false;
+        cm_request_feedhold();
+    }
+    if (cm.rt_end_hold_requested) {
+        cm.rt_end_hold_requested = false;
+        cm_request_end_hold();
+    }
     if (cm.hold_state == FEEDHOLD_REQUESTED) {
         cm_start_hold();                            // feed won't run unless the machine is moving
     }
@@ -1877,7 +2097,8 @@ stat_t cm_feedhold_sequencing_callback()
         cm_queue_flush();                           // queue flush won't run until runtime is idle
     }
     if (cm.end_hold_requested) {
-        if (cm.queue_flush_state == FLUSH_OFF) {    // either no flush or wait until it's done flushing
+        if ((cm.queue_flush_state == FLUSH_OFF) &&  // either no flush or wait until it's done flushing
+            (cm_spindle_ready_to_resume())) {       // and the spindle is back up to speed
             cm_end_hold();
         }
     }
@@ -1897,11 +2118,15 @@ bool cm_has_hold()
 
 void cm_start_hold()
 {
+    if (mp_jog_is_active()) {                               // a velocity jog has no block to hold
+        mp_jog_stop();
+    }
     if (mp_has_runnable_buffer()) {                         // meaning there's something running
         cm_spindle_optional_pause(spindle.pause_on_hold);   // pause if this option is selected
         cm_coolant_optional_pause(coolant.pause_on_hold);   // pause if this option is selected
         cm_set_motion_state(MOTION_HOLD);
         cm.hold_state = FEEDHOLD_SYNC;                      // invokes hold from aline execution
+        mp.job.holds++;                                     // for the job summary
     }
 }
 
@@ -1934,6 +2159,8 @@ void cm_queue_flush()
 {
     if (mp_runtime_is_idle()) {                     // can't flush planner during movement
         mp_flush_planner();
+        spindle_raster_reset();                     // the rows went with the moves
+        gpio_sync_reset();                          // ...and so did the M62/M63 changes
 
         for (uint8_t axis = AXIS_X; axis < AXES; axis++) { // set all positions
             cm_set_position(axis, mp_get_runtime_absolute_position(axis));
@@ -2028,6 +2255,7 @@ static void _exec_program_finalize(float *value, bool *flag)
         cm_set_motion_mode(MODEL, MOTION_MODE_CANCEL_MOTION_MODE);// NIST specifies G1 (MOTION_MODE_STRAIGHT_FEED), but we cancel motion mode. Safer.
         cm_reset_overrides();                           // reset feedrate the spindle overrides
         temperature_reset();                            // turn off all heaters and fans
+        mp_job_end();                                   // close the job summary for reporting
     }
     sr_request_status_report(SR_REQUEST_IMMEDIATE);     // request a final and full status report (not filtered)
 }
@@ -2037,7 +2265,9 @@ void cm_cycle_start()
     if (cm.cycle_state == CYCLE_OFF) {                  // don't (re)start homing, probe or other canned cycles
         cm.machine_state = MACHINE_CYCLE;
         cm.cycle_state = CYCLE_MACHINING;
+        cm.cycle_start_tick = SysTickTimer_getValue();  // start of the job for the job time estimate
         qr_init_queue_report();                         // clear queue reporting buffer counts
+        mp_job_start();                                 // a new job, or the next cycle of this one
     }
 }
 
@@ -2211,7 +2441,21 @@ static const char msg_g01[] = "G1  - linear feed";
 static const char msg_g02[] = "G2  - clockwise arc feed";
 static const char msg_g03[] = "G3  - counter clockwise arc feed";
 static const char msg_g80[] = "G80 - cancel motion mode (none active)";
-static const char *const msg_momo[] = { msg_g00, msg_g01, msg_g02, msg_g03, msg_g80 };
+static const char msg_g382[] = "G38.2 - straight probe";
+static const char msg_g81[] = "G81 - drilling cycle";
+static const char msg_g82[] = "G82 - drilling cycle with dwell";
+static const char msg_g83[] = "G83 - peck drilling cycle";
+static const char msg_g84[] = "G84 - tapping cycle";
+static const char msg_g85[] = "G85 - boring cycle, feed out";
+static const char msg_g86[] = "G86 - boring cycle, spindle stop, rapid out";
+static const char msg_g87[] = "G87 - back boring cycle";
+static const char msg_g88[] = "G88 - boring cycle, spindle stop, manual out";
+static const char msg_g89[] = "G89 - boring cycle, dwell, feed out";
+static const char msg_g73[] = "G73 - peck drilling cycle, chip breaking";
+static const char msg_g5[]  = "G5  - cubic spline";
+static const char *const msg_momo[] = { msg_g00, msg_g01, msg_g02, msg_g03, msg_g80, msg_g382,
+                                        msg_g81, msg_g82, msg_g83, msg_g84, msg_g85, msg_g86,
+                                        msg_g87, msg_g88, msg_g89, msg_g73, msg_g5 };
 
 static const char msg_g17[] = "G17 - XY plane";
 static const char msg_g18[] = "G18 - XZ plane";
@@ -2437,6 +2681,33 @@ stat_t cm_get_feed(nvObj_t *nv)
     return (STAT_OK);
 }
 
+/*
+ * cm_get_tiq() - estimated seconds until the planner queue runs dry
+ * cm_get_jte() - estimated seconds for the job: time since cycle start plus time in queue
+ *
+ *  Both come from the planner's estimate (see mp_get_queue_time()), so they only cover
+ *  what has been queued. Add them to the status report for job scheduling.
+ */
+
+stat_t cm_get_tiq(nvObj_t *nv)
+{
+    nv->value = mp_get_queue_time();
+    nv->precision = GET_TABLE_WORD(precision);
+    nv->valuetype = TYPE_FLOAT;
+    return (STAT_OK);
+}
+
+stat_t cm_get_jte(nvObj_t *nv)
+{
+    nv->value = 0;
+    if (cm.cycle_state != CYCLE_OFF) {
+        nv->value = (float)(SysTickTimer_getValue() - cm.cycle_start_tick) / 1000 + mp_get_queue_time();
+    }
+    nv->precision = GET_TABLE_WORD(precision);
+    nv->valuetype = TYPE_FLOAT;
+    return (STAT_OK);
+}
+
 stat_t cm_get_pos(nvObj_t *nv)
 {
     nv->value = cm_get_work_position(ACTIVE_MODEL, _get_axis(nv->index));
@@ -2469,6 +2740,18 @@ stat_t cm_get_tof(nvObj_t *nv)
     return (STAT_OK);
 }
 
+stat_t cm_set_cofs(nvObj_t *nv)
+{
+    uint8_t axis = _get_axis(nv->index);
+    if ((axis == AXIS_A) || (axis == AXIS_B) || (axis == AXIS_C)) {
+        ritorno(set_flt(nv));
+    } else {
+        ritorno(set_flu(nv));
+    }
+    _update_active_offset();                        // the offset may be the one in use
+    return (STAT_OK);
+}
+
 /*
  * AXIS GET AND SET FUNCTIONS
  *
@@ -2496,7 +2779,14 @@ stat_t cm_set_am(nvObj_t *nv)        // axis mode
             return (STAT_INPUT_EXCEEDS_MAX_VALUE);
         }
     }
+#if MACHINE_CONFIG_LOCKED == true
+    if ((uint8_t)nv->value != kn_locked_axis_mode[_get_axis(nv->index)]) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_PARAMETER_IS_READ_ONLY);   // the modes are compiled in - see kinematics.h
+    }
+#endif
     set_ui8(nv);
+    kn_config_changed();
     return(STAT_OK);
 }
 
@@ -2554,6 +2844,7 @@ void _cm_recalc_max_junction_accel(const uint8_t axis) {
 void cm_set_axis_jerk(const uint8_t axis, const float jerk)
 {
     cm.a[axis].jerk_max = jerk;
+    cm.a[axis].recip_jerk_max = 1/jerk;
     // Must recalculate the max_junction_accel now that the jerk has changed.
     _cm_recalc_max_junction_accel(axis);
 }
@@ -2567,6 +2858,7 @@ stat_t cm_set_vm(nvObj_t *nv)
         ritorno(set_flup(nv));
     }
     cm.a[axis].recip_velocity_max = 1/nv->value;
+    mp_replan_constraints();                        // queued moves get the new limit
     return(STAT_OK);
 }
 
@@ -2582,6 +2874,25 @@ stat_t cm_set_fr(nvObj_t *nv)
     return(STAT_OK);
 }
 
+stat_t cm_set_trv(nvObj_t *nv)
+{
+    uint8_t axis = _get_axis(nv->index);
+    if ((axis == AXIS_A) || (axis == AXIS_B) || (axis == AXIS_C)) {
+        ritorno(set_flt(nv));
+    } else {
+        ritorno(set_flu(nv));
+    }
+    cm_update_soft_limits();
+    return(STAT_OK);
+}
+
+stat_t cm_set_sl(nvObj_t *nv)
+{
+    ritorno(set_01(nv));
+    cm_update_soft_limits();
+    return(STAT_OK);
+}
+
 stat_t cm_set_jm(nvObj_t *nv)
 {
     if (nv->value < JERK_INPUT_MIN) {
@@ -2594,6 +2905,7 @@ stat_t cm_set_jm(nvObj_t *nv)
     }
     set_flu(nv);
     cm_set_axis_jerk(_get_axis(nv->index), nv->value);
+    mp_replan_constraints();
     return(STAT_OK);
 }
 
@@ -2608,6 +2920,9 @@ stat_t cm_set_jh(nvObj_t *nv)
         return (STAT_INPUT_EXCEEDS_MAX_VALUE);
     }
     set_flu(nv);
+    uint8_t axis = _get_axis(nv->index);
+    cm.a[axis].recip_jerk_high = 1/cm.a[axis].jerk_high;
+    mp_replan_constraints();
     return(STAT_OK);
 }
 
@@ -2629,9 +2944,23 @@ stat_t cm_set_jt(nvObj_t *nv)
     for (uint8_t axis=0; axis<AXES; axis++) {
         _cm_recalc_max_junction_accel(axis);
     }
+    mp_replan_constraints();
     return(status);
 }
 
+stat_t cm_set_sgx(nvObj_t *nv)
+{
+    if (nv->value < 1) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    if (nv->value > SEGMENT_STRETCH_LIMIT) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_EXCEEDS_MAX_VALUE);
+    }
+    return (set_flt(nv));
+}
+
 /*
  * cm_set_mfo() - set manual feedrate override factor
  * cm_set_mto() - set manual traverse override factor
@@ -2755,6 +3084,12 @@ stat_t cm_run_joga(nvObj_t *nv)
     return (STAT_OK);
 }
 
+stat_t cm_set_jv(nvObj_t *nv)
+{
+    set_flt(nv);
+    return (cm_jog_velocity(cm.jog_velocity));
+}
+
 /***********************************************************************************
  * TEXT MODE SUPPORT
  * Functions to print variables from the cfgArray table
@@ -2766,6 +3101,8 @@ stat_t cm_run_joga(nvObj_t *nv)
 
 static const char fmt_vel[]  = "Velocity:%17.3f%s/min\n";
 static const char fmt_feed[] = "Feed rate:%16.3f%s/min\n";
+static const char fmt_tiq[]  = "Time in queue:%12.1f sec\n";
+static const char fmt_jte[]  = "Job time estimate:%8.1f sec\n";
 static const char fmt_line[] = "Line number:%10lu\n";
 static const char fmt_stat[] = "Machine state:       %s\n"; // combined machine state
 static const char fmt_macs[] = "Raw machine state:   %s\n"; // raw machine state
@@ -2786,6 +3123,8 @@ static const char fmt_g92e[] = "G92 enabled          %d\n";
 
 void cm_print_vel(nvObj_t *nv) { text_print_flt_units(nv, fmt_vel, GET_UNITS(ACTIVE_MODEL));}
 void cm_print_feed(nvObj_t *nv) { text_print_flt_units(nv, fmt_feed, GET_UNITS(ACTIVE_MODEL));}
+void cm_print_tiq(nvObj_t *nv) { text_print(nv, fmt_tiq);}       // TYPE_FLOAT
+void cm_print_jte(nvObj_t *nv) { text_print(nv, fmt_jte);}       // TYPE_FLOAT
 void cm_print_line(nvObj_t *nv) { text_print(nv, fmt_line);}     // TYPE_INT
 void cm_print_tool(nvObj_t *nv) { text_print(nv, fmt_tool);}     // TYPE_INT
 void cm_print_g92e(nvObj_t *nv) { text_print(nv, fmt_g92e);}     // TYPE_INT
@@ -2819,12 +3158,16 @@ void cm_print_gdi(nvObj_t *nv) { text_print(nv, fmt_gdi);}  // TYPE_INT
 /* system parameter print functions */
 
 static const char fmt_jt[] = "[jt]  junction integrgation time%6.2f\n";
+static const char fmt_sgx[] ="[sgx] segment stretch maximum%11.2f [1=off]\n";
+static const char fmt_jc[] = "[jc]  junction curvature mode%11d [0=corners only,1=curvature]\n";
 static const char fmt_ct[] = "[ct]  chordal tolerance%17.4f%s\n";
 static const char fmt_sl[] = "[sl]  soft limit enable%12d [0=disable,1=enable]\n";
 static const char fmt_lim[] ="[lim] limit switch enable%10d [0=disable,1=enable]\n";
 static const char fmt_saf[] ="[saf] safety interlock enable%6d [0=disable,1=enable]\n";
 
 void cm_print_jt(nvObj_t *nv) { text_print(nv, fmt_jt);}        // TYPE FLOAT
+void cm_print_sgx(nvObj_t *nv){ text_print(nv, fmt_sgx);}       // TYPE FLOAT
+void cm_print_jc(nvObj_t *nv) { text_print(nv, fmt_jc);}        // TYPE_INT
 void cm_print_ct(nvObj_t *nv) { text_print_flt_units(nv, fmt_ct, GET_UNITS(ACTIVE_MODEL));}
 void cm_print_sl(nvObj_t *nv) { text_print(nv, fmt_sl);}        // TYPE_INT
 void cm_print_lim(nvObj_t *nv){ text_print(nv, fmt_lim);}       // TYPE_INT
@@ -2833,6 +3176,7 @@ void cm_print_saf(nvObj_t *nv){ text_print(nv, fmt_saf);}       // TYPE_INT
 static const char fmt_m48e[] = "[m48e] overrides enabled%11d [0=disable,1=enable]\n";
 static const char fmt_mfoe[] = "[mfoe] manual feed override enab%3d [0=disable,1=enable]\n";
 static const char fmt_mfo[]  = "[mfo]  manual feedrate override%8.3f [0.05 < mfo < 2.00]\n";
+static const char fmt_mfok[] = "[mfok] feed override knob enable%3d [0=disable,1=enable]\n";
 static const char fmt_mtoe[] = "[mtoe] manual traverse over enab%3d [0=disable,1=enable]\n";
 static const char fmt_mto[]  = "[mto]  manual traverse override%8.3f [0.05 < mto < 1.00]\n";
 static const char fmt_tram[] = "[tram] is coordinate space rotated to be tram %s\n";
@@ -2841,6 +3185,7 @@ static const char fmt_nxln[] = "[nxln] the next line number expected is %10d\n";
 void cm_print_m48e(nvObj_t *nv) { text_print(nv, fmt_m48e);}    // TYPE_INT
 void cm_print_mfoe(nvObj_t *nv) { text_print(nv, fmt_mfoe);}    // TYPE INT
 void cm_print_mfo(nvObj_t *nv)  { text_print(nv, fmt_mfo);}     // TYPE FLOAT
+void cm_print_mfok(nvObj_t *nv) { text_print(nv, fmt_mfok);}    // TYPE INT
 void cm_print_mtoe(nvObj_t *nv) { text_print(nv, fmt_mtoe);}    // TYPE INT
 void cm_print_mto(nvObj_t *nv)  { text_print(nv, fmt_mto);}     // TYPE FLOAT
 void cm_print_tram(nvObj_t *nv) { text_print(nv, fmt_tram);};   // TYPE BOOL
@@ -2861,7 +3206,10 @@ void cm_print_nxln(nvObj_t *nv) { text_print(nv, fmt_nxln);};   // TYPE INT
  *    cm_print_jm()
  *    cm_print_jh()
  *    cm_print_ra()
+ *    cm_print_wr()
  *    cm_print_hi()
+ *    cm_print_hg()
+ *    cm_print_hl()
  *    cm_print_hd()
  *    cm_print_lv()
  *    cm_print_lb()
@@ -2880,7 +3228,10 @@ static const char fmt_Xtn[] = "[%s%s] %s travel minimum%17.3f%s\n";
 static const char fmt_Xjm[] = "[%s%s] %s jerk maximum%15.0f%s/min^3 * 1 million\n";
 static const char fmt_Xjh[] = "[%s%s] %s jerk homing%16.0f%s/min^3 * 1 million\n";
 static const char fmt_Xra[] = "[%s%s] %s radius value%20.4f%s\n";
+static const char fmt_Xwr[] = "[%s%s] %s wrap rotation%14d [0=go as programmed, 1=shortest way to the angle]\n";
 static const char fmt_Xhi[] = "[%s%s] %s homing input%15d [input 1-N or 0 to disable homing this axis]\n";
+static const char fmt_Xhg[] = "[%s%s] %s homing group%15d [0=home alone, 1-N=home with the axes of this group]\n";
+static const char fmt_Xhl[] = "[%s%s] %s homing latch%15d [0=slow latch pass, 1=latch at the search edge]\n";
 static const char fmt_Xhd[] = "[%s%s] %s homing direction%11d [0=search-to-negative, 1=search-to-positive]\n";
 static const char fmt_Xsv[] = "[%s%s] %s search velocity%12.0f%s/min\n";
 static const char fmt_Xlv[] = "[%s%s] %s latch velocity%13.2f%s/min\n";
@@ -2897,7 +3248,7 @@ static const char fmt_hom[] = "%c axis homing state:%2.0f\n";
 
 static void _print_axis_ui8(nvObj_t *nv, const char *format)
 {
-    sprintf(cs.out_buf, format, nv->group, nv->token, nv->group, (uint8_t)nv->value);
+    str_format(cs.out_buf, format, nv->group, nv->token, nv->group, (uint8_t)nv->value);
     xio_writeline(cs.out_buf);
 }
 
@@ -2909,7 +3260,7 @@ static void _print_axis_flt(nvObj_t *nv, const char *format)
     } else {
         units = (char *)GET_TEXT_ITEM(msg_units, DEGREE_INDEX);
     }
-    sprintf(cs.out_buf, format, nv->group, nv->token, nv->group, nv->value, units);
+    str_format(cs.out_buf, format, nv->group, nv->token, nv->group, nv->value, units);
     xio_writeline(cs.out_buf);
 }
 
@@ -2921,7 +3272,7 @@ static void _print_axis_coord_flt(nvObj_t *nv, const char *format)
     } else {
         units = (char *)GET_TEXT_ITEM(msg_units, DEGREE_INDEX);
     }
-    sprintf(cs.out_buf, format, nv->group, nv->token, nv->group, nv->token, nv->value, units);
+    str_format(cs.out_buf, format, nv->group, nv->token, nv->group, nv->token, nv->value, units);
     xio_writeline(cs.out_buf);
 }
 
@@ -2930,7 +3281,7 @@ static void _print_pos(nvObj_t *nv, const char *format, uint8_t units)
     char axes[] = {"XYZABC"};
     uint8_t axis = _get_axis(nv->index);
     if (axis >= AXIS_A) { units = DEGREES;}
-    sprintf(cs.out_buf, format, axes[axis], nv->value, GET_TEXT_ITEM(msg_units, units));
+    str_format(cs.out_buf, format, axes[axis], nv->value, GET_TEXT_ITEM(msg_units, units));
     xio_writeline(cs.out_buf);
 }
 
@@ -2938,13 +3289,13 @@ static void _print_hom(nvObj_t *nv, const char *format)
 {
     char axes[] = {"XYZABC"};
     uint8_t axis = _get_axis(nv->index);
-    sprintf(cs.out_buf, format, axes[axis], nv->value);
+    str_format(cs.out_buf, format, axes[axis], nv->value);
     xio_writeline(cs.out_buf);
 }
 
 void cm_print_am(nvObj_t *nv)    // print axis mode with enumeration string
 {
-    sprintf(cs.out_buf, fmt_Xam, nv->group, nv->token, nv->group, (uint8_t)nv->value,
+    str_format(cs.out_buf, fmt_Xam, nv->group, nv->token, nv->group, (uint8_t)nv->value,
         GET_TEXT_ITEM(msg_am, (uint8_t)nv->value));
     xio_writeline(cs.out_buf);
 }
@@ -2956,8 +3307,11 @@ void cm_print_tn(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xtn);}
 void cm_print_jm(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xjm);}
 void cm_print_jh(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xjh);}
 void cm_print_ra(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xra);}
+void cm_print_wr(nvObj_t *nv) { _print_axis_ui8(nv, fmt_Xwr);}
 
 void cm_print_hi(nvObj_t *nv) { _print_axis_ui8(nv, fmt_Xhi);}
+void cm_print_hg(nvObj_t *nv) { _print_axis_ui8(nv, fmt_Xhg);}
+void cm_print_hl(nvObj_t *nv) { _print_axis_ui8(nv, fmt_Xhl);}
 void cm_print_hd(nvObj_t *nv) { _print_axis_ui8(nv, fmt_Xhd);}
 void cm_print_sv(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xsv);}
 void cm_print_lv(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xlv);}
@@ -50,10 +50,16 @@
 #define _to_millimeters(a) ((cm.gm.units_mode == INCHES) ? (a * MM_PER_INCH) : a)
 
 #define JOGGING_START_VELOCITY ((float)10.0)
+#ifndef JOG_VELOCITY_TIMEOUT_MS
+#define JOG_VELOCITY_TIMEOUT_MS 250         // stop a velocity jog if the host hasn't updated it for this long
+#endif
 #define DISABLE_SOFT_LIMIT (999999)
 #define JERK_INPUT_MIN (0.01)               // minimum allowable jerk setting in millions mm/min^3
 #define JERK_INPUT_MAX (1000000)            // maximum allowable jerk setting in millions mm/min^3
 #define PROBES_STORED 3                     // we store three probes for coordinate rotation computation
+#ifndef SCAN_POINTS_MAX
+#define SCAN_POINTS_MAX 400                 // G38.6 scan results held in RAM - 4 bytes each
+#endif
 
 
 /*****************************************************************************
@@ -167,7 +173,11 @@ typedef enum {                          // G Modal Group 1
     MOTION_MODE_CANNED_CYCLE_86,        // G86 - boring, spindle stop, rapid out
     MOTION_MODE_CANNED_CYCLE_87,        // G87 - back boring
     MOTION_MODE_CANNED_CYCLE_88,        // G88 - boring, spindle stop, manual out
-    MOTION_MODE_CANNED_CYCLE_89         // G89 - boring, dwell, feed out
+    MOTION_MODE_CANNED_CYCLE_89,        // G89 - boring, dwell, feed out
+    MOTION_MODE_CANNED_CYCLE_73,        // G73 - peck drilling, chip breaking
+    MOTION_MODE_CUBIC_SPLINE,           // G5  - cubic spline
+    MOTION_MODE_SPINDLE_SYNC,           // G33 - spindle synchronized motion (threading)
+    MOTION_MODE_RIGID_TAP               // G33.1 - rigid tapping
 } cmMotionMode;
 
 typedef enum {              // canonical plane - translates to:
@@ -216,6 +226,11 @@ typedef enum {
     UNITS_PER_REVOLUTION_MODE// G95 (unimplemented)
 } cmFeedRateMode;
 
+typedef enum {              // G Modal Group 10
+    RETRACT_TO_INITIAL_LEVEL = 0,// G98 - canned cycles retract to the Z they started at (or R if higher)
+    RETRACT_TO_R_LEVEL      // G99 - canned cycles retract to R
+} cmRetractMode;
+
 typedef enum {
     ORIGIN_OFFSET_SET=0,    // G92 - set origin offsets
     ORIGIN_OFFSET_CANCEL,   // G92.1 - zero out origin offsets
@@ -304,6 +319,11 @@ typedef struct GCodeState {             // Gcode model state - used by model, pl
     cmCoordSystem coord_system;         // G54-G59 - select coordinate system 1-9
     uint8_t tool;               // G    // M6 tool change - moves "tool_select" to "tool"
     uint8_t tool_select;        // G    // T value - T sets this value
+    float spindle_speed;                // S - the runtime applies it as the block starts (see spindle_inline_sync())
+    int8_t spindle_control;             // M3/M4/M5 applied the same way in laser mode, otherwise -1
+    int8_t raster_row;                  // raster row carried by this G1 only, or -1 (see cm_raster_claim())
+    uint8_t output_first;               // M62/M63 output changes carried by the next move... (see cm_sync_output())
+    uint8_t output_count;               // ...and how many. 0 = none
 
     void reset() {
         linenum = 0;
@@ -327,6 +347,11 @@ typedef struct GCodeState {             // Gcode model state - used by model, pl
         coord_system = ABSOLUTE_COORDS;
         tool = 1;
         tool_select = 1;
+        spindle_speed = 0;
+        spindle_control = -1;
+        raster_row = -1;
+        output_first = 0;
+        output_count = 0;
     };
 } GCodeState_t;
 
@@ -373,13 +398,17 @@ typedef struct cmAxis {
     float travel_min;                       // min work envelope for soft limits
     float jerk_max;                         // max jerk (Jm) in mm/min^3 divided by 1 million
     float jerk_high;                        // high speed deceleration jerk (Jh) in mm/min^3 divided by 1 million
-    //float recip_jerk;                       // stored reciprocal of current jerk value - has the million in it
+    float recip_jerk_max;                   // cached 1/jerk_max, in the divided by 1 million form
+    float recip_jerk_high;                  // cached 1/jerk_high, in the divided by 1 million form
     float max_junction_accel;               // high speed deceleration jerk (Jh) in mm/min^3 divided by 1 million
     float junction_dev;                     // aka cornering delta -- DEPRICATED!
     float radius;                           // radius in mm for rotary axis modes
+    bool wrap;                              // true to take absolute rotary targets the shortest way round
 
     uint8_t homing_input;                   // set 1-N for homing input. 0 will disable homing
     uint8_t homing_dir;                     // 0=search to negative, 1=search to positive
+    uint8_t homing_group;                   // axes with the same non-zero group home together
+    uint8_t homing_latch;                   // 0=latch on a slow second pass, 1=latch at the search edge
     float search_velocity;                  // homing search velocity
     float latch_velocity;                   // homing latch velocity
     float latch_backoff;                    // backoff sufficient to clear a switch
@@ -393,6 +422,9 @@ typedef struct cmSingleton {                // struct to manage cm globals and c
 
     // system group settings
     float junction_integration_time;        // how aggressively will the machine corner? 1.6 or so is about the upper limit
+    bool junction_curvature_enable;         // true to limit junctions on faceted curves by their curvature
+    float segment_stretch_max;              // longest segment stretch while the exec runs late - see stepper.h
+    bool mfo_knob_enable;                   // true to run the feed override knob - see plan_exec.cpp
     float chordal_tolerance;                // arc chordal accuracy setting in mm
     bool soft_limit_enable;                 // true to enable soft limit testing on Gcode inputs
     bool limit_enable;                      // true to enable limit switches (disabled is same as override)
@@ -409,6 +441,7 @@ typedef struct cmSingleton {                // struct to manage cm globals and c
     float offset[COORDS+1][AXES];           // persistent coordinate offsets: absolute (G53) + G54,G55,G56,G57,G58,G59
     float tl_offset[AXES];                  // current tool length offset
     float tt_offset[TOOLS+1][AXES];         // persistent tool table offsets
+    float active_offset[AXES];              // G5x + G92 + tool length offsets in use - see cm_get_active_coord_offset()
 
     // settings for axes X,Y,Z,A B,C
     cfgAxis_t a[AXES];
@@ -428,13 +461,20 @@ typedef struct cmSingleton {                // struct to manage cm globals and c
     uint8_t safety_interlock_reengaged;     // set non-zero to end interlock processing (value is input number)
     cmSafetyState safety_interlock_state;   // safety interlock state
     uint32_t esc_boot_timer;                // timer for Electronic Speed Control (Spindle electronics) to boot
+    uint32_t cycle_start_tick;              // systick when the machining cycle started - for {jte:}
 
     cmHomingState homing_state;             // home: homing cycle sub-state machine
     uint8_t homed[AXES];                    // individual axis homing flags
+    float soft_limit_min[AXES];             // soft limits in effect, -/+ INFINITY if not tested - see cm_update_soft_limits()
+    float soft_limit_max[AXES];
 
     bool probe_report_enable;                 // 0=disabled, 1=enabled
     cmProbeState probe_state[PROBES_STORED];  // probing state machine (simple)
     float probe_results[PROBES_STORED][AXES]; // probing results
+    uint8_t scan_columns;                     // G38.6 grid points along X
+    uint8_t scan_rows;                        // G38.6 grid points along Y
+    uint32_t scan_count;                      // G38.6 points probed in the last scan
+    uint32_t scan_missed;                     // G38.6 points that didn't make contact
 
     float rotation_matrix[3][3];            // three-by-three rotation matrix. We ignore rotary axes.
     float rotation_z_offset;                // we separately handle a z-offset, so that the new plane
@@ -442,11 +482,14 @@ typedef struct cmSingleton {                // struct to manage cm globals and c
                                             // We only need z, since we are rotating to the z axis.
 
     float jogging_dest;                     // jogging direction as a relative move from current position
+    float jog_velocity[AXES];               // velocity jog target, machine coordinates (mm/min)
 
     bool g28_flag;                          // true = complete a G28 move
     bool g30_flag;                          // true = complete a G30 move
     bool deferred_write_flag;               // G10 data has changed (e.g. offsets) - flag to persist them
     bool end_hold_requested;                // request restart after feedhold
+    volatile bool rt_feedhold_requested;    // '!' seen by the xio realtime scan (set from interrupt)
+    volatile bool rt_end_hold_requested;    // '~' seen by the xio realtime scan (set from interrupt)
     uint8_t limit_requested;                // set non-zero to request limit switch processing (value is input number)
     uint8_t shutdown_requested;             // set non-zero to request shutdown in support of external estop (value is input number)
 
@@ -516,7 +559,9 @@ stat_t cm_deferred_write_callback(void);
 void cm_set_model_target(const float target[], const bool flag[]);
 bool cm_get_soft_limits(void);
 void cm_set_soft_limits(bool enable);
+void cm_update_soft_limits(void);
 
+stat_t cm_check_soft_limits(const float box_min[], const float box_max[]);
 stat_t cm_test_soft_limits(const float target[]);
 
 /*--- Canonical machining functions (loosely) defined by NIST [organized by NIST Gcode doc] ---*/
@@ -578,6 +623,8 @@ stat_t cm_set_path_control(GCodeState_t *gcode_state, const uint8_t mode);  // G
 
 // Machining Functions (4.3.6)
 stat_t cm_straight_feed(const float target[], const bool flags[]);          // G1
+stat_t cm_straight_feed_planned(const float target[], const bool flags[],  // G1 planned by the host
+                                const float cruise_velocity, const float exit_velocity, const uint8_t horizon);
 stat_t cm_dwell(const float seconds);                                       // G4, P parameter
 
 stat_t cm_arc_feed(const float target[], const bool target_f[],             // G2/G3 - target endpoint
@@ -587,6 +634,15 @@ stat_t cm_arc_feed(const float target[], const bool target_f[],             // G
                    const bool modal_g1_f,                                   // modal group flag for motion group
                    const cmMotionMode motion_mode);                         // defined motion mode
 
+stat_t cm_spline_feed(const float target[], const bool target_f[],          // G5 - target endpoint
+                      const float offset[], const bool offset_f[],          // I J - first control point
+                      const float P_word, const bool P_word_f,              // P Q - second control point
+                      const float Q_word, const bool Q_word_f);
+
+stat_t cm_spindle_sync_feed(const float target[], const bool flags[],      // G33, G33.1 - target endpoint
+                            const float pitch, const bool pitch_f,          // K - travel per spindle turn
+                            const bool tap);                                // true for G33.1
+
 // Spindle Functions (4.3.7)
 // see spindle.h for spindle functions - which would go right here
 
@@ -637,18 +693,33 @@ stat_t cm_json_wait(char *json_string);                         // M102
 stat_t cm_homing_cycle_start(const float axes[], const bool flags[]);        // G28.2
 stat_t cm_homing_cycle_start_no_set(const float axes[], const bool flags[]); // G28.4
 stat_t cm_homing_cycle_callback(void);                          // G28.2/.4 main loop callback
+void cm_homing_switch(uint8_t input);                           // homing input fired (from interrupt)
 
 // Probe cycles
 stat_t cm_straight_probe(float target[], bool flags[],          // G38.x
                          bool trip_sense, bool alarm_flag);
+stat_t cm_scan_probe(float target[], bool flags[]);             // G38.6
 stat_t cm_probing_cycle_callback(void);                         // G38.x main loop callback
 stat_t cm_get_prbr(nvObj_t *nv);                                // enable/disable probe report
 stat_t cm_set_prbr(nvObj_t *nv);
+stat_t cm_set_hmpe(nvObj_t *nv);                                // enable/disable height map
+
+// Drilling cycles
+stat_t cm_set_retract_mode(const uint8_t mode);                 // G98, G99
+stat_t cm_drilling_cycle_start(const float target[], const bool target_f[],  // G73, G81, G82, G83
+                               const float R_word, const bool R_flag,
+                               const float Q_word, const bool Q_flag,
+                               const float P_word, const bool P_flag,
+                               const uint8_t L_word, const bool L_flag,
+                               const cmMotionMode motion_mode);
+stat_t cm_drilling_cycle_callback(void);                        // G73, G81, G82, G83 main loop callback
+void cm_abort_drilling(void);
 
 // Jogging cycle
 stat_t cm_jogging_cycle_callback(void);                         // jogging cycle main loop
 stat_t cm_jogging_cycle_start(uint8_t axis);                    // {"jogx":-100.3}
 float cm_get_jogging_dest(void);
+stat_t cm_jog_velocity(float velocity[]);                       // {"jv":{"x":1200}}
 
 /*--- cfgArray interface functions ---*/
 
@@ -676,10 +747,13 @@ stat_t cm_get_pwr(nvObj_t *nv);         // get motor power enable state
 
 stat_t cm_get_vel(nvObj_t *nv);         // get runtime velocity...
 stat_t cm_get_feed(nvObj_t *nv);        // get feed rate, converted to units
+stat_t cm_get_tiq(nvObj_t *nv);         // get estimated time left in the planner queue
+stat_t cm_get_jte(nvObj_t *nv);         // get estimated job time (elapsed plus time in queue)
 stat_t cm_get_pos(nvObj_t *nv);         // get runtime work position...
 stat_t cm_get_mpo(nvObj_t *nv);         // get runtime machine position...
 stat_t cm_get_ofs(nvObj_t *nv);         // get runtime work offset...
 stat_t cm_get_tof(nvObj_t *nv);         // get runtime tool length offset...
+stat_t cm_set_cofs(nvObj_t *nv);        // set a coordinate system offset
 
 stat_t cm_run_qf(nvObj_t *nv);          // run queue flush
 stat_t cm_run_home(nvObj_t *nv);        // start homing cycle
@@ -690,14 +764,18 @@ stat_t cm_run_jogx(nvObj_t *nv);        // start jogging cycle for x
 stat_t cm_run_jogy(nvObj_t *nv);        // start jogging cycle for y
 stat_t cm_run_jogz(nvObj_t *nv);        // start jogging cycle for z
 stat_t cm_run_joga(nvObj_t *nv);        // start jogging cycle for a
+stat_t cm_set_jv(nvObj_t *nv);          // start or steer a velocity jog
 
 stat_t cm_get_am(nvObj_t *nv);          // get axis mode
 stat_t cm_set_am(nvObj_t *nv);          // set axis mode
 stat_t cm_set_hi(nvObj_t *nv);          // set homing input
 
 stat_t cm_set_jt(nvObj_t *nv);          // set junction integration time constant
+stat_t cm_set_sgx(nvObj_t *nv);         // set segment stretch maximum
 stat_t cm_set_vm(nvObj_t *nv);          // set velocity max and reciprocal
 stat_t cm_set_fr(nvObj_t *nv);          // set feedrate max and reciprocal
+stat_t cm_set_trv(nvObj_t *nv);         // set travel min or max and the soft limits
+stat_t cm_set_sl(nvObj_t *nv);          // set soft limit enable
 stat_t cm_set_jm(nvObj_t *nv);          // set jerk max with 1,000,000 correction
 stat_t cm_set_jh(nvObj_t *nv);          // set jerk high with 1,000,000 correction
 
@@ -716,6 +794,8 @@ stat_t cm_get_nxln(nvObj_t *nv);    // return what value we expect the next line
 
     void cm_print_vel(nvObj_t *nv);       // model state reporting
     void cm_print_feed(nvObj_t *nv);
+    void cm_print_tiq(nvObj_t *nv);
+    void cm_print_jte(nvObj_t *nv);
     void cm_print_line(nvObj_t *nv);
     void cm_print_stat(nvObj_t *nv);
     void cm_print_macs(nvObj_t *nv);
@@ -748,6 +828,8 @@ stat_t cm_get_nxln(nvObj_t *nv);    // return what value we expect the next line
     void cm_print_tof(nvObj_t *nv);         // print tool length offset
 
     void cm_print_jt(nvObj_t *nv);          // global CM settings
+    void cm_print_sgx(nvObj_t *nv);
+    void cm_print_jc(nvObj_t *nv);
     void cm_print_ct(nvObj_t *nv);
     void cm_print_sl(nvObj_t *nv);
     void cm_print_lim(nvObj_t *nv);
@@ -756,6 +838,7 @@ stat_t cm_get_nxln(nvObj_t *nv);    // return what value we expect the next line
     void cm_print_m48e(nvObj_t *nv);
     void cm_print_mfoe(nvObj_t *nv);
     void cm_print_mfo(nvObj_t *nv);
+    void cm_print_mfok(nvObj_t *nv);
     void cm_print_mtoe(nvObj_t *nv);
     void cm_print_mto(nvObj_t *nv);
 
@@ -770,8 +853,11 @@ stat_t cm_get_nxln(nvObj_t *nv);    // return what value we expect the next line
     void cm_print_jm(nvObj_t *nv);
     void cm_print_jh(nvObj_t *nv);
     void cm_print_ra(nvObj_t *nv);
+    void cm_print_wr(nvObj_t *nv);
 
     void cm_print_hi(nvObj_t *nv);
+    void cm_print_hg(nvObj_t *nv);
+    void cm_print_hl(nvObj_t *nv);
     void cm_print_hd(nvObj_t *nv);
     void cm_print_sv(nvObj_t *nv);
     void cm_print_lv(nvObj_t *nv);
@@ -784,6 +870,8 @@ stat_t cm_get_nxln(nvObj_t *nv);    // return what value we expect the next line
 
     #define cm_print_vel tx_print_stub      // model state reporting
     #define cm_print_feed tx_print_stub
+    #define cm_print_tiq tx_print_stub
+    #define cm_print_jte tx_print_stub
     #define cm_print_line tx_print_stub
     #define cm_print_stat tx_print_stub
     #define cm_print_macs tx_print_stub
@@ -815,6 +903,8 @@ stat_t cm_get_nxln(nvObj_t *nv);    // return what value we expect the next line
     #define cm_print_ofs tx_print_stub      // print runtime work offset always in MM units
 
     #define cm_print_jt tx_print_stub       // global CM settings
+    #define cm_print_sgx tx_print_stub
+    #define cm_print_jc tx_print_stub
     #define cm_print_ct tx_print_stub
     #define cm_print_sl tx_print_stub
     #define cm_print_lim tx_print_stub
@@ -823,6 +913,7 @@ stat_t cm_get_nxln(nvObj_t *nv);    // return what value we expect the next line
     #define cm_print_m48e tx_print_stub
     #define cm_print_mfoe tx_print_stub
     #define cm_print_mfo tx_print_stub
+    #define cm_print_mfok tx_print_stub
     #define cm_print_mtoe tx_print_stub
     #define cm_print_mto tx_print_stub
 
@@ -837,8 +928,11 @@ stat_t cm_get_nxln(nvObj_t *nv);    // return what value we expect the next line
     #define cm_print_jm tx_print_stub
     #define cm_print_jh tx_print_stub
     #define cm_print_ra tx_print_stub
+    #define cm_print_wr tx_print_stub
 
     #define cm_print_hi tx_print_stub
+    #define cm_print_hg tx_print_stub
+    #define cm_print_hl tx_print_stub
     #define cm_print_hd tx_print_stub
     #define cm_print_sv tx_print_stub
     #define cm_print_lv tx_print_stub
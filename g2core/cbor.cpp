@@ -0,0 +1,198 @@
+/*
+ * cbor.cpp - CBOR encoded responses and reports
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* With ej=4 (CBOR_MODE) the controller takes JSON in, as for ej=1, but sends its responses,
+ *  status reports, queue reports and exceptions as CBOR (RFC 7049). The objects are the same
+ *  as the JSON ones - same tokens, same nesting, same footer - so a host can decode either
+ *  into the same tree. CBOR is self-delimiting, so no LF is sent after an object.
+ *
+ *  Encodings used:
+ *
+ *      objects     indefinite length maps, so they can be closed as the nvObj depth drops
+ *      tokens      text strings
+ *      floats      IEEE754 singles, converted for the units mode. They are not rounded to
+ *                  the display precision as JSON values are
+ *      integers    unsigned or negative integers, in the shortest form
+ *      data        unsigned integers (JSON sends these as "0x..." strings)
+ *      arrays      definite length arrays. Elements that are integers are sent as integers,
+ *                  and anything else as text - so the footer is an array of 3 or 5 integers
+ */
+#include "g2core.h"
+#include "config.h"
+#include "cbor.h"
+#include "util.h"
+#include "xio.h"
+
+/*
+ * cbor_put_head()   - write the initial byte and argument for a major type
+ * cbor_put_int()    - write a signed integer
+ * cbor_put_float()  - write a single precision float
+ * cbor_put_string() - write a NUL terminated string as a CBOR text string
+ *
+ *  Each writes at str and returns a pointer to the byte after what it wrote.
+ */
+
+char *cbor_put_head(char *str, uint8_t major, uint32_t value)
+{
+    if (value < 24) {
+        *str++ = major | value;
+    } else if (value <= 0xFF) {
+        *str++ = major | 24;
+        *str++ = value;
+    } else if (value <= 0xFFFF) {
+        *str++ = major | 25;
+        *str++ = value >> 8;
+        *str++ = value;
+    } else {
+        *str++ = major | 26;
+        *str++ = value >> 24;
+        *str++ = value >> 16;
+        *str++ = value >> 8;
+        *str++ = value;
+    }
+    return (str);
+}
+
+char *cbor_put_int(char *str, int32_t value)
+{
+    if (value < 0) {
+        return (cbor_put_head(str, CBOR_NEGINT, (uint32_t)(-1 - value)));
+    }
+    return (cbor_put_head(str, CBOR_UINT, (uint32_t)value));
+}
+
+char *cbor_put_float(char *str, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    *str++ = CBOR_FLOAT32;
+    *str++ = bits >> 24;
+    *str++ = bits >> 16;
+    *str++ = bits >> 8;
+    *str++ = bits;
+    return (str);
+}
+
+char *cbor_put_string(char *str, const char *string)
+{
+    uint16_t length = strlen(string);
+    str = cbor_put_head(str, CBOR_TEXT, length);
+    memcpy(str, string, length);
+    return (str + length);
+}
+
+/*
+ * _put_array() - write a comma separated array string as a CBOR array
+ */
+
+static char *_put_array(char *str, const char *array)
+{
+    uint8_t count = 0;
+    if (*array != NUL) {
+        count = 1;
+        for (const char *c = array; *c != NUL; c++) {
+            if (*c == ',') { count++;}
+        }
+    }
+    str = cbor_put_head(str, CBOR_ARRAY, count);
+
+    while (count--) {
+        const char *end = array;
+        while ((*end != ',') && (*end != NUL)) { end++;}
+
+        const char *c = (*array == '-') ? array+1 : array;
+        bool is_int = (c != end);
+        for ( ; c < end; c++) {
+            if (!isdigit(*c)) { is_int = false; break;}
+        }
+        if (is_int) {
+            str = cbor_put_int(str, atol(array));
+        } else {
+            str = cbor_put_head(str, CBOR_TEXT, end - array);
+            memcpy(str, array, end - array);
+            str += end - array;
+        }
+        array = end + 1;                    // skip the comma
+    }
+    return (str);
+}
+
+/****************************************************************************
+ * cbor_serialize() - make a CBOR object from an nvObj list
+ *
+ *  The same walk as json_serialize() - see there for how depths and empty objects are
+ *  handled - but writing a CBOR map instead of a JSON object string. The result is not
+ *  NUL terminated, and may contain NULs, so it must be sent with xio_write().
+ *
+ *  Returns the length of the object, or -1 if it overran size.
+ */
+
+int16_t cbor_serialize(nvObj_t *nv, char *out_buf, uint16_t size)
+{
+    char *str = out_buf;
+    char *str_max = out_buf + size - 8;         // leave room for the closing breaks
+    int8_t initial_depth = nv->depth;
+    int8_t prev_depth = 0;
+
+    *str++ = CBOR_MAP_START;
+
+    while (true) {
+        if (nv->valuetype != TYPE_EMPTY) {
+            str = cbor_put_string(str, nv->token);
+
+            switch (nv->valuetype)  {
+                case (TYPE_EMPTY):  {   break; }
+                case (TYPE_NULL):   {   *str++ = CBOR_NULL; break; }
+                case (TYPE_PARENT): {   *str++ = CBOR_MAP_START; break; }
+                case (TYPE_FLOAT):  {   preprocess_float(nv);
+                                        str = cbor_put_float(str, nv->value);
+                                        break;
+                                    }
+                case (TYPE_INT):    {   str = cbor_put_int(str, (int32_t)nv->value); break; }
+                case (TYPE_STRING): {   str = cbor_put_string(str, *nv->stringp); break; }
+                case (TYPE_BOOL):   {   *str++ = fp_FALSE(nv->value) ? CBOR_FALSE : CBOR_TRUE; break; }
+                case (TYPE_DATA):   {   uint32_t *v = (uint32_t*)&nv->value;
+                                        str = cbor_put_head(str, CBOR_UINT, *v);
+                                        break;
+                                    }
+                case (TYPE_ARRAY):  {   str = _put_array(str, *nv->stringp); break; }
+            }
+        }
+        if (str >= str_max) { return (-1);}     // signal buffer overrun
+        if ((nv = nv->nx) == NULL) { break;}    // end of the list
+
+        while (nv->depth < prev_depth--) {      // close the maps
+            *str++ = CBOR_BREAK;
+        }
+        prev_depth = nv->depth;
+    }
+
+    while (prev_depth-- > initial_depth) {
+        *str++ = CBOR_BREAK;
+    }
+    *str++ = CBOR_BREAK;
+    return (str - out_buf);
+}
@@ -0,0 +1,54 @@
+/*
+ * cbor.h - CBOR encoded responses and reports
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef CBOR_H_ONCE
+#define CBOR_H_ONCE
+
+/**** Configs, Definitions and Structures ****/
+
+#define CBOR_UINT           0x00    // major types - in the top 3 bits of the initial byte
+#define CBOR_NEGINT         0x20
+#define CBOR_TEXT           0x60
+#define CBOR_ARRAY          0x80
+#define CBOR_MAP            0xA0
+
+#define CBOR_MAP_START      0xBF    // indefinite length map - ended by CBOR_BREAK
+#define CBOR_BREAK          0xFF
+#define CBOR_FALSE          0xF4
+#define CBOR_TRUE           0xF5
+#define CBOR_NULL           0xF6
+#define CBOR_FLOAT32        0xFA    // followed by the IEEE754 single, big endian
+
+/**** Function Prototypes ****/
+
+char *cbor_put_head(char *str, uint8_t major, uint32_t value);
+char *cbor_put_int(char *str, int32_t value);
+char *cbor_put_float(char *str, float value);
+char *cbor_put_string(char *str, const char *string);
+int16_t cbor_serialize(nvObj_t *nv, char *out_buf, uint16_t size);
+
+#endif // End of include guard: CBOR_H_ONCE
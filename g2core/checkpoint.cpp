@@ -0,0 +1,177 @@
+/*
+ * checkpoint.cpp - motion checkpoints to resume a job after power loss or a disconnect
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "g2core.h"
+#include "config.h"
+#include "canonical_machine.h"
+#include "planner.h"
+#include "persistence.h"
+#include "checkpoint.h"
+#include "text_parser.h"
+#include "util.h"
+
+/**** Allocate Structures ****/
+
+ckptSingleton_t ckpt;
+
+/************************************************************************************
+ **** CODE **************************************************************************
+ ************************************************************************************/
+
+/*
+ * checkpoint_init() - load the last checkpoint so {ckptl:} shows what can be resumed
+ *
+ *  Must follow persistence_init(). ckpt.enable is set later, by config_init()
+ */
+
+void checkpoint_init()
+{
+    memset(&ckpt, 0, sizeof(ckpt));
+    if (persistence_read_checkpoint(&ckpt.last, sizeof(ckpt.last)) && ckpt.last.active) {
+        ckpt.linenum = ckpt.last.linenum;
+    }
+}
+
+/*
+ * _take_checkpoint() - fill in a checkpoint from the runtime
+ *
+ *  The exec interrupt may move mr.position[] on a segment while this copies it. The axes
+ *  then come from neighboring segments, which is as good a place to stop as either.
+ */
+
+static void _take_checkpoint(ckptState_t *s)
+{
+    memset(s, 0, sizeof(ckptState_t));                  // padding too - checkpoints are compared whole
+    s->linenum = mr.gm.linenum;
+    for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
+        s->position[axis] = mp_get_runtime_absolute_position(axis);
+    }
+    s->feed_rate = mr.gm.feed_rate;
+    s->active = ((s->linenum > 0) && (cm_get_machine_state() != MACHINE_PROGRAM_END));
+    s->coord_system = mr.gm.coord_system;
+    s->units_mode = mr.gm.units_mode;
+    s->distance_mode = mr.gm.distance_mode;
+    s->select_plane = mr.gm.select_plane;
+    s->feed_rate_mode = mr.gm.feed_rate_mode;
+    s->path_control = mr.gm.path_control;
+    s->tool = mr.gm.tool;
+}
+
+/*
+ * checkpoint_callback() - write a checkpoint if the runtime has moved on from the last one
+ *
+ *  Jogging and other moves outside a job don't write once the inactive checkpoint is down.
+ */
+
+stat_t checkpoint_callback()
+{
+    if (!ckpt.enable || (cm_is_alarmed() != STAT_OK)) {
+        return (STAT_NOOP);
+    }
+    if (!mp_runtime_is_idle()) {
+        if (!CHECKPOINT_IN_MOTION || ((SysTickTimer.getValue() - ckpt.last_tick) < CHECKPOINT_MS)) {
+            return (STAT_NOOP);
+        }
+    }
+    ckptState_t s;
+    _take_checkpoint(&s);
+    if ((!s.active && !ckpt.last.active) || (memcmp(&s, &ckpt.last, sizeof(s)) == 0)) {
+        return (STAT_NOOP);
+    }
+    ckpt.last_tick = SysTickTimer.getValue();
+    if (persistence_write_checkpoint(&s, sizeof(s))) {
+        ckpt.written++;
+    }
+    memcpy(&ckpt.last, &s, sizeof(s));                  // a failed write isn't retried until things change
+    ckpt.linenum = s.active ? s.linenum : 0;
+    return (STAT_OK);
+}
+
+/*
+ * ckpt_get_ckptr() - return the line a resume starts from, 0 if there is nothing to resume
+ * ckpt_set_ckptr() - resume from the checkpoint and return the line to start sending from
+ *
+ *  The position is set for all axes like G28.3, in the model and planner now and in the
+ *  runtime when the queued command runs. Units are switched to mm for that because the
+ *  checkpoint holds mm. The modal state follows, then the line number.
+ */
+
+stat_t ckpt_get_ckptr(nvObj_t *nv)
+{
+    nv->value = (float)ckpt.linenum;
+    nv->valuetype = TYPE_INT;
+    return (STAT_OK);
+}
+
+stat_t ckpt_set_ckptr(nvObj_t *nv)
+{
+    if (fp_ZERO(nv->value)) {
+        return (ckpt_get_ckptr(nv));
+    }
+    if ((ckpt.linenum == 0) || (cm_get_machine_state() == MACHINE_CYCLE) || cm_get_runtime_busy()) {
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    ritorno(cm_is_alarmed());
+
+    ckptState_t *s = &ckpt.last;
+    bool flags[AXES];
+    for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
+        flags[axis] = true;
+    }
+    cm_set_units_mode(MILLIMETERS);
+    cm_set_absolute_origin(s->position, flags);
+    cm_set_coord_system(s->coord_system);
+    cm_set_units_mode(s->units_mode);
+    cm_set_distance_mode(s->distance_mode);
+    cm_select_plane(s->select_plane);
+    cm_set_feed_rate_mode(s->feed_rate_mode);
+    cm_set_path_control(MODEL, s->path_control);
+    cm.gm.feed_rate = s->feed_rate;
+    cm.gm.tool = s->tool;
+    cm.gm.tool_select = s->tool;
+    cm.gm.linenum = s->linenum;
+    return (ckpt_get_ckptr(nv));
+}
+
+/***********************************************************************************
+ * TEXT MODE SUPPORT
+ * Functions to print variables from the cfgArray table
+ ***********************************************************************************/
+
+#ifdef __TEXT_MODE
+
+static const char fmt_ckpte[] = "[ckpte] checkpoint enable%11d [0=off,1=on]\n";
+static const char fmt_ckptl[] = "[ckptl] checkpoint line%13lu\n";
+static const char fmt_ckptr[] = "[ckptr] checkpoint resume line%7lu\n";
+static const char fmt_ckptn[] = "[ckptn] checkpoints written%9lu\n";
+
+void ckpt_print_ckpte(nvObj_t *nv) { text_print(nv, fmt_ckpte);}
+void ckpt_print_ckptl(nvObj_t *nv) { text_print(nv, fmt_ckptl);}
+void ckpt_print_ckptr(nvObj_t *nv) { text_print(nv, fmt_ckptr);}
+void ckpt_print_ckptn(nvObj_t *nv) { text_print(nv, fmt_ckptn);}
+
+#endif // __TEXT_MODE
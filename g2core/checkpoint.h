@@ -0,0 +1,117 @@
+/*
+ * checkpoint.h - motion checkpoints to resume a job after power loss or a disconnect
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* A checkpoint is the runtime's place in the job, saved to NVM so the job can be picked up
+ *  again after power is lost or the host goes away: the line number of the block the runtime
+ *  is running (mr.gm.linenum), the runtime position (mr.position[]) and the modal state the
+ *  block carries. The rest of the queue, planned or not, isn't saved. The host still has it,
+ *  and resuming means sending it again starting with the checkpointed line.
+ *
+ *  checkpoint_callback() takes a checkpoint from the controller when the state differs from
+ *  the last one written - every CHECKPOINT_MS while moving, and right away once the runtime
+ *  stops (a feedhold, the queue running dry, the end of the program). Each is one slot
+ *  programmed into the NVM checkpoint pages - see persistence.h. Programming flash stalls
+ *  anything running from it, so checkpoints are only taken in motion with CHECKPOINT_IN_MOTION,
+ *  which defaults on when FAST_HOT_PATHS has put the stepper interrupt chain in RAM. Without
+ *  it the last checkpoint is the last stop.
+ *
+ *  Wear: with 6 axes a checkpoint is 48 bytes, 5 to a 256 byte page. At the defaults that is
+ *  9 erases per page per hour of motion over 8 pages, or over 1000 hours of motion on a
+ *  part rated for 10,000 cycles. Raise CHECKPOINT_MS or NVM_CHECKPOINT_PAGES for more.
+ *
+ *  A checkpoint is "active" if it has a line number and the program didn't end with M2 or
+ *  M30. Nothing is written while alarmed, so the last good position is kept.
+ *
+ *  {ckpte:1} enables checkpoints (persisted). {ckptl:} is the checkpointed line, 0 if there
+ *  is nothing to resume. {ckptr:1} resumes: with the machine idle it sets the position from
+ *  the checkpoint as G28.3 would - so the axes count as homed - restores the modal state and
+ *  line number, and returns the line to start sending from. The checkpoint is trusted; if
+ *  the axes may have moved while unpowered, home them and re-zero instead. G92 offsets and
+ *  the spindle and coolant state aren't saved - the host sends them before the first line.
+ *  Incremental (G91) blocks can't be resumed mid-block, because they start from where the
+ *  block began. {ckptn:} counts the checkpoints written since reset.
+ */
+#ifndef CHECKPOINT_H_ONCE
+#define CHECKPOINT_H_ONCE
+
+/**** Configs, Definitions and Structures ****/
+
+#ifndef CHECKPOINT_MS
+#define CHECKPOINT_MS           10000   // time between checkpoints while moving
+#endif
+#ifndef CHECKPOINT_IN_MOTION
+#define CHECKPOINT_IN_MOTION    FAST_HOT_PATHS  // 1 = take checkpoints while the steppers run
+#endif
+
+typedef struct ckptState {              // one checkpoint, as written to NVM
+    uint32_t linenum;                   // line of the block the runtime is running
+    float position[AXES];               // runtime position in machine coordinates, mm or degrees
+    float feed_rate;                    // F of that block - normalized, see cm_set_feed_rate()
+    uint8_t active;                     // 1 = there is a job to resume
+    uint8_t coord_system;               // G54-G59
+    uint8_t units_mode;                 // G20, G21
+    uint8_t distance_mode;              // G90, G91
+    uint8_t select_plane;               // G17, G18, G19
+    uint8_t feed_rate_mode;             // G93, G94, G95
+    uint8_t path_control;               // G61, G61.1, G64
+    uint8_t tool;                       // M6 tool
+} ckptState_t;
+
+typedef struct ckptSingleton {
+    uint8_t enable;                     // 1 = take checkpoints {ckpte:}
+    uint32_t linenum;                   // line to resume from, 0 = none {ckptl:}
+    uint32_t written;                   // checkpoints written since reset {ckptn:}
+    uint32_t last_tick;                 // systick value of the last checkpoint
+    ckptState_t last;                   // last checkpoint written, or read at startup
+} ckptSingleton_t;
+
+extern ckptSingleton_t ckpt;
+
+/**** Function Prototypes ****/
+
+void checkpoint_init(void);
+stat_t checkpoint_callback(void);
+
+stat_t ckpt_get_ckptr(nvObj_t *nv);
+stat_t ckpt_set_ckptr(nvObj_t *nv);
+
+#ifdef __TEXT_MODE
+
+    void ckpt_print_ckpte(nvObj_t *nv);
+    void ckpt_print_ckptl(nvObj_t *nv);
+    void ckpt_print_ckptr(nvObj_t *nv);
+    void ckpt_print_ckptn(nvObj_t *nv);
+
+#else
+
+    #define ckpt_print_ckpte tx_print_stub
+    #define ckpt_print_ckptl tx_print_stub
+    #define ckpt_print_ckptr tx_print_stub
+    #define ckpt_print_ckptn tx_print_stub
+
+#endif // __TEXT_MODE
+
+#endif // End of include guard: CHECKPOINT_H_ONCE
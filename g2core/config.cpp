@@ -42,6 +42,8 @@
 #include "xio.h"
 
 static void _set_defa(nvObj_t *nv, bool print);
+static uint32_t _profile_hash(nvObj_t *nv);
+static void _load_profile(nvObj_t *nv, bool fast);
 
 /***********************************************************************************
  **** STRUCTURE ALLOCATIONS ********************************************************
@@ -49,6 +51,10 @@ static void _set_defa(nvObj_t *nv, bool print);
 
 nvStr_t nvStr;
 nvList_t nvl;
+#if NV_INDEX_HASH_SIZE > 0
+static index_t nv_index_hash[NV_INDEX_HASH_SIZE];   // cfgArray indexes by token hash. NO_MATCH is empty
+static bool nv_index_hash_ready = false;
+#endif
 
 /***********************************************************************************
  **** CODE *************************************************************************
@@ -102,7 +108,10 @@ stat_t nv_persist(nvObj_t *nv)
  *
  * Performs one of 2 actions:
  *  (1) if persistence is set up or out-of-rev load RAM and NVM with settings.h defaults
- *  (2) if persistence is set up and at current config version use NVM data for config
+ *  (2) if persistence is set up and at current config version use NVM data for config.
+ *      Each row is set once, from its stored value or its default. If the snapshot of
+ *      derived state (st_cfg, cm.a[]) was taken from this profile it is restored in a
+ *      block and its rows are skipped. Otherwise a new snapshot is saved.
  *
  *  You can assume the cfg struct has been zeroed by a hard reset.
  *  Do not clear it as the version and build numbers have already been set by tg_init()
@@ -113,11 +122,84 @@ void config_init()
 {
     nvObj_t *nv = nv_reset_nv_list();
     config_init_assertions();
+    nv_index_hash_init();
     js.json_mode = JSON_MODE;                    // initial value until persistence is read
-    _set_defa(nv, false);
+
+    nv->index = 0;                               // stored firmware build must match to use the profile
+    if ((read_persistent_value(nv) == STAT_OK) && (fp_EQ(nv->value, cs.fw_build))) {
+        uint32_t hash = _profile_hash(nv);
+        bool fast = config_snapshot_load(hash);  // derived state restored in a block if it's current
+        persistence_hold(true);                  // don't rewrite the stored profile while loading it
+        _load_profile(nv, fast);
+        persistence_hold(false);
+        if (!fast) {
+            config_snapshot_save(hash);          // so the next reset can take the fast path
+        }
+    } else {
+        _set_defa(nv, false);
+    }
     rpt_print_loading_configs_message();
 }
 
+/*
+ * _profile_value() - load nv->value with the stored value for nv->index, or the default
+ *
+ *  Returns false for rows that are neither stored nor initialized
+ */
+
+static bool _profile_value(nvObj_t *nv)
+{
+    if (read_persistent_value(nv) == STAT_OK) {
+        return (true);
+    }
+    if (GET_TABLE_BYTE(flags) & F_INITIALIZE) {
+        nv->value = GET_TABLE_FLOAT(def_value);
+        return (true);
+    }
+    return (false);
+}
+
+/*
+ * _profile_hash() - hash the value every row will be loaded with
+ *
+ *  Covers defaults as well as stored values so a new settings file changes the hash
+ */
+
+static uint32_t _profile_hash(nvObj_t *nv)
+{
+    uint32_t hash = 2166136261;
+    for (nv->index=0; nv_index_is_single(nv->index); nv->index++) {
+        if ((GET_TABLE_BYTE(flags) & (F_INITIALIZE | F_PERSIST)) && (_profile_value(nv))) {
+            hash = persistence_hash(hash, &nv->index, sizeof(nv->index));
+            hash = persistence_hash(hash, &nv->value, sizeof(nv->value));
+        }
+    }
+    return (hash);
+}
+
+/*
+ * _load_profile() - set every row from the stored value or its default, in table order
+ *
+ *  With fast set, rows whose targets came from the snapshot are skipped - their values
+ *  and everything their setters derive are already in place.
+ */
+
+static void _load_profile(nvObj_t *nv, bool fast)
+{
+    sr_init_status_report();                    // SR runtime state. Stored se rows override the list
+    cm_set_units_mode(MILLIMETERS);             // values were persisted in MM mode
+    for (nv->index=0; nv_index_is_single(nv->index); nv->index++) {
+        if (!(GET_TABLE_BYTE(flags) & (F_INITIALIZE | F_PERSIST))) {
+            continue;
+        }
+        if ((fast && config_snapshot_covers(nv->index)) || (!_profile_value(nv))) {
+            continue;
+        }
+        strncpy(nv->token, cfgArray[nv->index].token, TOKEN_LEN);
+        nv_set(nv);
+    }
+}
+
 /*
  * set_defaults() - reset persistence with default values for machine profile
  * _set_defa() - helper function and called directly from config_init()
@@ -156,6 +238,74 @@ stat_t set_defaults(nvObj_t *nv)
     return (STAT_OK);
 }
 
+/*
+ * set_profile() - switch to another stored profile
+ * get_profile() - return the active profile
+ *
+ *  Only taken with no cycle running or batch open. Only rows whose value in the new
+ *  profile differs from the running value are set, so derived state that doesn't change
+ *  is left alone. A profile that has never been used starts as a copy of the running one.
+ */
+
+static void _swap_profile(nvObj_t *nv, bool seed)
+{
+    for (nv->index=0; nv_index_is_single(nv->index); nv->index++) {
+        if (!(GET_TABLE_BYTE(flags) & (F_INITIALIZE | F_PERSIST))) {
+            continue;
+        }
+        if (seed) {
+            nv_get(nv);
+            nv_persist(nv);                     // running value goes into the new profile
+            continue;
+        }
+        if (!_profile_value(nv)) {
+            continue;
+        }
+        float value = nv->value;
+        nv_get(nv);
+        if (memcmp(&value, &nv->value, sizeof(value)) == 0) {
+            continue;
+        }
+        nv->value = value;
+        strncpy(nv->token, cfgArray[nv->index].token, TOKEN_LEN);
+        nv_set(nv);
+    }
+}
+
+stat_t set_profile(nvObj_t *nv)
+{
+    if ((nv->value < 0) || (nv->value >= NVM_PROFILES)) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_VALUE_RANGE_ERROR);
+    }
+    if ((cm_get_cycle_state() != CYCLE_OFF) || (js.batch.state == BATCH_BEGIN)) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    uint8_t profile = (uint8_t)nv->value;
+    if (profile != persistence_get_profile()) {
+        ritorno(persistence_select_profile(profile));
+
+        nvObj_t row;                            // leave nv alone for the response
+        row.index = 0;
+        bool seed = (read_persistent_value(&row) != STAT_OK);
+        uint8_t units = cm_get_units_mode(MODEL);
+        cm_set_units_mode(MILLIMETERS);         // values are persisted in MM mode
+        _swap_profile(&row, seed);
+        cm_set_units_mode(units);
+    }
+    nv->value = profile;
+    nv->valuetype = TYPE_INT;
+    return (STAT_OK);
+}
+
+stat_t get_profile(nvObj_t *nv)
+{
+    nv->value = persistence_get_profile();
+    nv->valuetype = TYPE_INT;
+    return (STAT_OK);
+}
+
 /*
  * config_init_assertions()
  * config_test_assertions() - check memory integrity of config sub-system
@@ -441,31 +591,94 @@ stat_t set_grp(nvObj_t *nv)
 
 /* nv_get_index() - get index from mnenonic token + group
  *
- * nv_get_index() is the most expensive routine in the whole config. It does a
- * linear table scan of the strings, which of course could be further
- * optimized with indexes or hashing.
+ * nv_get_index() is the most expensive routine in the whole config. It used to do
+ * a linear table scan of the strings. It now hashes the token (group + token, up
+ * to 5 characters - the same characters that are compared) into nv_index_hash[],
+ * which nv_index_hash_init() fills from cfgArray once at startup. The table is
+ * built at init rather than compile time as the cfgArray contents depend on the
+ * build settings. A collision just probes the next slot, so a lookup is usually
+ * one or two compares. The linear scan is kept for NV_INDEX_HASH_SIZE 0, and is
+ * used before the table is built.
  */
-index_t nv_get_index(const char *group, const char *token)
+
+// compare the key with the token at cfgArray[i]. GET_TOKEN_BYTE() uses i
+static bool _token_matches(index_t i, const char *str)
 {
     char c;
+    if ((c = GET_TOKEN_BYTE(token[0])) != str[0]) { return (false); }           // 1st character mismatch
+    if ((c = GET_TOKEN_BYTE(token[1])) == NUL) { return (str[1] == NUL); }      // one character match
+    if (c != str[1]) { return (false); }                                        // 2nd character mismatch
+    if ((c = GET_TOKEN_BYTE(token[2])) == NUL) { return (str[2] == NUL); }      // two character match
+    if (c != str[2]) { return (false); }                                        // 3rd character mismatch
+    if ((c = GET_TOKEN_BYTE(token[3])) == NUL) { return (str[3] == NUL); }      // three character match
+    if (c != str[3]) { return (false); }                                        // 4th character mismatch
+    if ((c = GET_TOKEN_BYTE(token[4])) == NUL) { return (str[4] == NUL); }      // four character match
+    return (c == str[4]);                                                       // five character match
+}
+
+#if NV_INDEX_HASH_SIZE > 0
+static_assert(((NV_INDEX_HASH_SIZE-1) & NV_INDEX_HASH_SIZE) == 0, "NV_INDEX_HASH_SIZE must be 2^N");
+
+// FNV-1a over the characters _token_matches() compares
+static uint16_t _token_hash(const char *str)
+{
+    uint32_t hash = 2166136261;
+    for (uint8_t j=0; (j < 5) && (str[j] != NUL); j++) {
+        hash = (hash ^ (uint8_t)str[j]) * 16777619;
+    }
+    return ((hash ^ (hash >> 16)) & (NV_INDEX_HASH_SIZE-1));
+}
+
+void nv_index_hash_init()
+{
+    char str[TOKEN_LEN+1];
+    index_t index_max = nv_index_max();
+
+    for (uint16_t h=0; h < NV_INDEX_HASH_SIZE; h++) {
+        nv_index_hash[h] = NO_MATCH;
+    }
+    for (index_t i=0; i < index_max; i++) {
+        strncpy(str, cfgArray[i].token, TOKEN_LEN);
+        str[TOKEN_LEN] = NUL;
+        uint16_t h = _token_hash(str);
+        while (nv_index_hash[h] != NO_MATCH) {
+            if (_token_matches(nv_index_hash[h], str)) {   // a duplicate - the first one wins, as for the scan
+                break;
+            }
+            h = (h+1) & (NV_INDEX_HASH_SIZE-1);
+        }
+        if (nv_index_hash[h] == NO_MATCH) {
+            nv_index_hash[h] = i;
+        }
+    }
+    nv_index_hash_ready = true;
+}
+#else
+void nv_index_hash_init() {}
+#endif
+
+index_t nv_get_index(const char *group, const char *token)
+{
     char str[TOKEN_LEN + GROUP_LEN+1];    // should actually never be more than TOKEN_LEN+1
     strncpy(str, group, GROUP_LEN+1);
     strncat(str, token, TOKEN_LEN+1);
 
-    index_t i;
+#if NV_INDEX_HASH_SIZE > 0
+    if (nv_index_hash_ready) {
+        index_t i;
+        for (uint16_t h = _token_hash(str); (i = nv_index_hash[h]) != NO_MATCH; h = (h+1) & (NV_INDEX_HASH_SIZE-1)) {
+            if (_token_matches(i, str)) {
+                return (i);
+            }
+        }
+        return (NO_MATCH);
+    }
+#endif
     index_t index_max = nv_index_max();
-
-    for (i=0; i < index_max; i++) {
-        if ((c = GET_TOKEN_BYTE(token[0])) != str[0]) {    continue; }              // 1st character mismatch
-        if ((c = GET_TOKEN_BYTE(token[1])) == NUL) { if (str[1] == NUL) return(i);} // one character match
-        if (c != str[1]) continue;                                                  // 2nd character mismatch
-        if ((c = GET_TOKEN_BYTE(token[2])) == NUL) { if (str[2] == NUL) return(i);} // two character match
-        if (c != str[2]) continue;                                                  // 3rd character mismatch
-        if ((c = GET_TOKEN_BYTE(token[3])) == NUL) { if (str[3] == NUL) return(i);} // three character match
-        if (c != str[3]) continue;                                                  // 4th character mismatch
-        if ((c = GET_TOKEN_BYTE(token[4])) == NUL) { if (str[4] == NUL) return(i);} // four character match
-        if (c != str[4]) continue;                                                  // 5th character mismatch
-        return (i);                                                                 // five character match
+    for (index_t i=0; i < index_max; i++) {
+        if (_token_matches(i, str)) {
+            return (i);
+        }
     }
     return (NO_MATCH);
 }
@@ -557,9 +770,30 @@ nvObj_t *nv_reset_nv(nvObj_t *nv)               // clear a single nvObj structur
     return (nv);                                // return pointer to nv as a convenience to callers
 }
 
-void _nv_reset_a_list(nvObj_t *nv, uint8_t length) // clear some nv list (called from below)
+/*
+ * _nv_reset_a_list() - clear some nv list (called from below)
+ *
+ *  Most lists use a few of their entries - a status report or a single command - so
+ *  rather than rewrite every entry this clears up to the high-water mark, the entry past
+ *  the last one that is no longer in its reset state. Entries past the mark have not been
+ *  touched since the last reset, so there is nothing to clear. It would take a flag in
+ *  every writer to track the mark as entries are used; reading it back here keeps the
+ *  writers as they are and cannot miss an entry someone wrote to directly.
+ */
+static bool _nv_entry_is_clean(nvObj_t *nv, nvObj_t *nx)
+{
+    return ((nv->valuetype == TYPE_EMPTY) && (nv->token[0] == NUL) && (nv->index == 0) &&
+            (nv->depth == 1) && (nv->precision == 0) && (nv->pv == (nv-1)) && (nv->nx == nx));
+}
+
+void _nv_reset_a_list(nvObj_t *nv, uint8_t length)
 {
-    for (uint8_t i=0; i<length; i++, nv++) {
+    nvObj_t *end = nv + length;                 // find the high-water mark...
+    bool whole_list = !_nv_entry_is_clean(end-1, NULL); // ...the last entry is the one ending in NULL
+    if (!whole_list) {
+        for (--end; (end > nv) && _nv_entry_is_clean(end-1, end); end--);
+    }
+    for (; nv < end; nv++) {
         nv->pv = (nv-1);                        // the ends are bogus & corrected later
         nv->nx = (nv+1);
         nv->index = 0;
@@ -568,7 +802,9 @@ void _nv_reset_a_list(nvObj_t *nv, uint8_t length) // clear some nv list (called
         nv->valuetype = TYPE_EMPTY;
         nv->token[0] = NUL;
     }
-    (--nv)->nx = NULL;
+    if (whole_list) {
+        (--nv)->nx = NULL;
+    }
 }
 
 nvObj_t *nv_reset_nv_list()                     // clear the header and response body
@@ -186,17 +186,22 @@ typedef uint16_t index_t;               // use this if there are > 255 indexed o
 
 #define GROUP_LEN 4                     // max length of group prefix
 #define TOKEN_LEN 6                     // mnemonic token string: group prefix + short token
-#define NV_FOOTER_LEN 18                // sufficient space to contain a JSON footer array
+#define NV_FOOTER_LEN 24                // sufficient space to contain a JSON footer array (window report)
 #define NV_LIST_LEN (NV_BODY_LEN+2)     // +2 allows for a header and a footer
 #define NV_EXEC_FIRST (NV_BODY_LEN+2)   // index of the first EXEC nv
 #define NV_MAX_OBJECTS (NV_BODY_LEN-1)  // maximum number of objects in a body string
 #define NO_MATCH (index_t)0xFFFF
 
+#ifndef NV_INDEX_HASH_SIZE
+#define NV_INDEX_HASH_SIZE 2048         // token hash slots for nv_get_index(). 2^N, over 4/3 the cfgArray count. 0 = linear scan
+#endif
+
 typedef enum {
     TEXT_MODE = 0,                      // sticky text mode
     JSON_MODE,                          // sticky JSON mode
     AUTO_MODE,                          // auto-configure communications mode
     MARLIN_COMM_MODE,                   // sticky marlin-compatibility mode (if compiled in)
+    CBOR_MODE                           // sticky JSON mode, with responses and reports sent as CBOR
 } commMode;
 
 typedef enum {
@@ -299,6 +304,8 @@ extern const cfgItem_t cfgArray[];
 
 void config_init(void);
 stat_t set_defaults(nvObj_t *nv);       // reset config to default values
+stat_t set_profile(nvObj_t *nv);        // switch to another stored profile
+stat_t get_profile(nvObj_t *nv);        // get the active profile
 void config_init_assertions(void);
 stat_t config_test_assertions(void);
 
@@ -311,10 +318,14 @@ stat_t nv_persist(nvObj_t *nv);         // main entry point for persistence
 // helpers
 uint8_t nv_get_type(nvObj_t *nv);
 index_t nv_get_index(const char *group, const char *token);
+void nv_index_hash_init(void);
 index_t nv_index_max(void);             // (see config_app.c)
 bool nv_index_is_single(index_t index); // (see config_app.c)
 bool nv_index_is_group(index_t index);  // (see config_app.c)
 bool nv_index_lt_groups(index_t index); // (see config_app.c)
+bool config_snapshot_covers(index_t index);  // (see config_app.c)
+bool config_snapshot_load(uint32_t hash);     // (see config_app.c)
+void config_snapshot_save(uint32_t hash);     // (see config_app.c)
 bool nv_group_is_prefixed(char *group);
 
 // generic internal functions and accessors
@@ -346,6 +357,7 @@ void nv_get_nvObj(nvObj_t *nv);
 nvObj_t *nv_reset_nv(nvObj_t *nv);
 nvObj_t *nv_reset_nv_list(void);
 nvObj_t *nv_reset_exec_nv_list();
+void _nv_reset_a_list(nvObj_t *nv, uint8_t length);
 stat_t nv_copy_string(nvObj_t *nv, const char *src);
 nvObj_t *nv_add_object(const char *token);
 nvObj_t *nv_add_integer(const char *token, const uint32_t value);
@@ -36,9 +36,16 @@
 #include "settings.h"
 #include "planner.h"
 #include "plan_arc.h"
+#include "plan_coalesce.h"
+#include "plan_lookahead.h"
+#include "plan_shaper.h"
+#include "plan_track.h"
+#include "plan_aux.h"
+#include "plan_sync.h"
 #include "stepper.h"
 #include "gpio.h"
 #include "spindle.h"
+#include "spindle_vfd.h"
 #include "temperature.h"
 #include "coolant.h"
 #include "pwm.h"
@@ -47,6 +54,19 @@
 #include "util.h"
 #include "help.h"
 #include "xio.h"
+#include "profile.h"
+#include "telemetry.h"
+#include "motion_link.h"
+#include "checkpoint.h"
+#include "trace.h"
+#include "step_capture.h"
+#include "bench.h"
+#include "rx_capture.h"
+#include "persistence.h"
+#include "kinematics.h"
+#if MARLIN_COMPAT_ENABLED == true
+#include "marlin_compatibility.h"
+#endif
 
 /*** structures ***/
 
@@ -101,6 +121,72 @@ static stat_t get_tick(nvObj_t *nv);        // get system tick count
  *  - The precision value 'p' only affects JSON responses. You need to also set
  *    the %f in the corresponding format string to set text mode display precision
  */
+/*
+ *  Per-motor, per-axis and per-input families are written once as row macros, and expanded
+ *  for each member below. The expansions are exactly the rows that were written out by hand,
+ *  in the same order - token matching and the table indexes don't change.
+ */
+
+#define CFG_MOTOR(m) \
+    { #m, #m "ma",_fip, 0, st_print_ma, get_ui8, st_set_ma,  &st_cfg.mot[MOTOR_##m].motor_map,      M##m##_MOTOR_MAP }, \
+    { #m, #m "sa",_fip, 3, st_print_sa, get_flt, st_set_sa,  &st_cfg.mot[MOTOR_##m].step_angle,     M##m##_STEP_ANGLE }, \
+    { #m, #m "tr",_fipc,4, st_print_tr, get_flt, st_set_tr,  &st_cfg.mot[MOTOR_##m].travel_rev,     M##m##_TRAVEL_PER_REV }, \
+    { #m, #m "mi",_fip, 0, st_print_mi, get_ui8, st_set_mi,  &st_cfg.mot[MOTOR_##m].microsteps,     M##m##_MICROSTEPS }, \
+    { #m, #m "su",_fipi,5, st_print_su, st_get_su,st_set_su, &st_cfg.mot[MOTOR_##m].steps_per_unit, M##m##_STEPS_PER_UNIT }, \
+    { #m, #m "po",_fip, 0, st_print_po, get_ui8, set_01,     &st_cfg.mot[MOTOR_##m].polarity,       M##m##_POLARITY }, \
+    { #m, #m "pm",_fip, 0, st_print_pm, st_get_pm,st_set_pm, &cs.null,                              M##m##_POWER_MODE }, \
+    { #m, #m "pl",_fip, 3, st_print_pl, get_flt, st_set_pl,  &st_cfg.mot[MOTOR_##m].power_level,    M##m##_POWER_LEVEL }, \
+    { #m, #m "fv",_fip, 3, st_print_fv, get_flt, set_fltp,   &st_cfg.mot[MOTOR_##m].ff_velocity,    M##m##_FEEDFORWARD_VELOCITY }, \
+    { #m, #m "fa",_fip, 3, st_print_fa, get_flt, set_fltp,   &st_cfg.mot[MOTOR_##m].ff_accel,       M##m##_FEEDFORWARD_ACCEL }, \
+    { #m, #m "bl",_fipc,4, st_print_bl, get_flt, st_set_bl,  &st_cfg.mot[MOTOR_##m].backlash,       M##m##_BACKLASH }, \
+    { #m, #m "hi",_fip, 0, st_print_hi, get_ui8, set_ui8,    &st_cfg.mot[MOTOR_##m].homing_input,   M##m##_HOMING_INPUT }, \
+    { #m, #m "si",_fip, 0, st_print_si, get_ui8, st_set_si,  &st_cfg.mot[MOTOR_##m].stall_input,    M##m##_STALL_INPUT }, \
+    { #m, #m "sg",_fip, 0, st_print_sg, get_flt, st_set_sg,  &st_cfg.mot[MOTOR_##m].stall_threshold,M##m##_STALL_THRESHOLD }, \
+    { #m, #m "cs",_fip, 0, st_print_cs, get_ui8, st_set_cs,  &st_cfg.mot[MOTOR_##m].cool_step,      M##m##_COOL_STEP }
+//  { #m, #m "pi",_fip, 3, st_print_pi, get_flt, st_set_pi,  &st_cfg.mot[MOTOR_##m].power_idle,     M##m##_POWER_IDLE },
+//  { #m, #m "mt",_fip, 2, st_print_mt, get_flt, st_set_mt,  &st_cfg.mot[MOTOR_##m].motor_timeout,  M##m##_MOTOR_TIMEOUT },
+
+#define CFG_LINEAR_AXIS(ax,AX) \
+    { #ax, #ax "am",_fip,  0, cm_print_am, cm_get_am, cm_set_am, &cm.a[AXIS_##AX].axis_mode,      AX##_AXIS_MODE }, \
+    { #ax, #ax "vm",_fipc, 0, cm_print_vm, get_flt,   cm_set_vm, &cm.a[AXIS_##AX].velocity_max,   AX##_VELOCITY_MAX }, \
+    { #ax, #ax "fr",_fipc, 0, cm_print_fr, get_flt,   cm_set_fr, &cm.a[AXIS_##AX].feedrate_max,   AX##_FEEDRATE_MAX }, \
+    { #ax, #ax "tn",_fipc, 3, cm_print_tn, get_flt,   cm_set_trv,&cm.a[AXIS_##AX].travel_min,     AX##_TRAVEL_MIN }, \
+    { #ax, #ax "tm",_fipc, 3, cm_print_tm, get_flt,   cm_set_trv,&cm.a[AXIS_##AX].travel_max,     AX##_TRAVEL_MAX }, \
+    { #ax, #ax "jm",_fipc, 0, cm_print_jm, get_flt,   cm_set_jm, &cm.a[AXIS_##AX].jerk_max,       AX##_JERK_MAX }, \
+    { #ax, #ax "jh",_fipc, 0, cm_print_jh, get_flt,   cm_set_jh, &cm.a[AXIS_##AX].jerk_high,      AX##_JERK_HIGH_SPEED }, \
+    { #ax, #ax "hi",_fip,  0, cm_print_hi, get_ui8,   cm_set_hi, &cm.a[AXIS_##AX].homing_input,   AX##_HOMING_INPUT }, \
+    { #ax, #ax "hd",_fip,  0, cm_print_hd, get_ui8,   set_01,    &cm.a[AXIS_##AX].homing_dir,     AX##_HOMING_DIRECTION }, \
+    { #ax, #ax "hg",_fip,  0, cm_print_hg, get_ui8,   set_ui8,   &cm.a[AXIS_##AX].homing_group,   AX##_HOMING_GROUP }, \
+    { #ax, #ax "hl",_fip,  0, cm_print_hl, get_ui8,   set_01,    &cm.a[AXIS_##AX].homing_latch,   AX##_HOMING_LATCH }, \
+    { #ax, #ax "sv",_fipc, 0, cm_print_sv, get_flt,   set_flup,  &cm.a[AXIS_##AX].search_velocity,AX##_SEARCH_VELOCITY }, \
+    { #ax, #ax "lv",_fipc, 2, cm_print_lv, get_flt,   set_flup,  &cm.a[AXIS_##AX].latch_velocity, AX##_LATCH_VELOCITY }, \
+    { #ax, #ax "lb",_fipc, 3, cm_print_lb, get_flt,   set_flu,   &cm.a[AXIS_##AX].latch_backoff,  AX##_LATCH_BACKOFF }, \
+    { #ax, #ax "zb",_fipc, 3, cm_print_zb, get_flt,   set_flu,   &cm.a[AXIS_##AX].zero_backoff,   AX##_ZERO_BACKOFF }
+
+#define CFG_ROTARY_AXIS(ax,AX) \
+    { #ax, #ax "am",_fip,  0, cm_print_am, cm_get_am, cm_set_am, &cm.a[AXIS_##AX].axis_mode,      AX##_AXIS_MODE }, \
+    { #ax, #ax "vm",_fip,  0, cm_print_vm, get_flt,   cm_set_vm, &cm.a[AXIS_##AX].velocity_max,   AX##_VELOCITY_MAX }, \
+    { #ax, #ax "fr",_fip,  0, cm_print_fr, get_flt,   cm_set_fr, &cm.a[AXIS_##AX].feedrate_max,   AX##_FEEDRATE_MAX }, \
+    { #ax, #ax "tn",_fip,  3, cm_print_tn, get_flt,   cm_set_trv,&cm.a[AXIS_##AX].travel_min,     AX##_TRAVEL_MIN }, \
+    { #ax, #ax "tm",_fip,  3, cm_print_tm, get_flt,   cm_set_trv,&cm.a[AXIS_##AX].travel_max,     AX##_TRAVEL_MAX }, \
+    { #ax, #ax "jm",_fip,  0, cm_print_jm, get_flt,   cm_set_jm, &cm.a[AXIS_##AX].jerk_max,       AX##_JERK_MAX }, \
+    { #ax, #ax "jh",_fip,  0, cm_print_jh, get_flt,   cm_set_jh, &cm.a[AXIS_##AX].jerk_high,      AX##_JERK_HIGH_SPEED }, \
+    { #ax, #ax "ra",_fipc, 3, cm_print_ra, get_flt,   set_flt,   &cm.a[AXIS_##AX].radius,         AX##_RADIUS }, \
+    { #ax, #ax "wr",_fip,  0, cm_print_wr, get_ui8,   set_01,    &cm.a[AXIS_##AX].wrap,           AX##_WRAP }, \
+    { #ax, #ax "hi",_fip,  0, cm_print_hi, get_ui8,   cm_set_hi, &cm.a[AXIS_##AX].homing_input,   AX##_HOMING_INPUT }, \
+    { #ax, #ax "hd",_fip,  0, cm_print_hd, get_ui8,   set_01,    &cm.a[AXIS_##AX].homing_dir,     AX##_HOMING_DIRECTION }, \
+    { #ax, #ax "hg",_fip,  0, cm_print_hg, get_ui8,   set_ui8,   &cm.a[AXIS_##AX].homing_group,   AX##_HOMING_GROUP }, \
+    { #ax, #ax "hl",_fip,  0, cm_print_hl, get_ui8,   set_01,    &cm.a[AXIS_##AX].homing_latch,   AX##_HOMING_LATCH }, \
+    { #ax, #ax "sv",_fip,  0, cm_print_sv, get_flt,   set_fltp,  &cm.a[AXIS_##AX].search_velocity,AX##_SEARCH_VELOCITY }, \
+    { #ax, #ax "lv",_fip,  2, cm_print_lv, get_flt,   set_fltp,  &cm.a[AXIS_##AX].latch_velocity, AX##_LATCH_VELOCITY }, \
+    { #ax, #ax "lb",_fip,  3, cm_print_lb, get_flt,   set_flt,   &cm.a[AXIS_##AX].latch_backoff,  AX##_LATCH_BACKOFF }, \
+    { #ax, #ax "zb",_fip,  3, cm_print_zb, get_flt,   set_flt,   &cm.a[AXIS_##AX].zero_backoff,   AX##_ZERO_BACKOFF }
+
+#define CFG_DIGITAL_INPUT(n,i) \
+    { "di" #n, "di" #n "mo",_fip, 0, io_print_mo, get_int8,io_set_mo, &d_in[i].mode,     DI##n##_MODE }, \
+    { "di" #n, "di" #n "ac",_fip, 0, io_print_ac, get_ui8, io_set_ac, &d_in[i].action,   DI##n##_ACTION }, \
+    { "di" #n, "di" #n "fn",_fip, 0, io_print_fn, get_ui8, io_set_fn, &d_in[i].function, DI##n##_FUNCTION }
+
 const cfgItem_t cfgArray[] = {
     // group token flags p, print_func,  get_func,  set_func, target for get/set,       default value
     { "sys", "fb", _fipn,2, hw_print_fb, get_flt,   set_ro,   &cs.fw_build,    G2CORE_FIRMWARE_BUILD }, // MUST BE FIRST!
@@ -117,6 +203,8 @@ const cfgItem_t cfgArray[] = {
     { "",   "line",_fi, 0, cm_print_line, cm_get_line, set_ro, &cs.null, 0 },      // Active line number - model or runtime line number
     { "",   "vel", _f0, 2, cm_print_vel,  cm_get_vel,  set_ro, &cs.null, 0 },      // current velocity
     { "",   "feed",_f0, 2, cm_print_feed, cm_get_feed, set_ro, &cs.null, 0 },      // feed rate
+    { "",   "tiq", _f0, 1, cm_print_tiq,  cm_get_tiq,  set_ro, &cs.null, 0 },      // estimated seconds left in the planner queue
+    { "",   "jte", _f0, 1, cm_print_jte,  cm_get_jte,  set_ro, &cs.null, 0 },      // estimated job seconds - elapsed + in queue
     { "",   "macs",_f0, 0, cm_print_macs, cm_get_macs, set_ro, &cs.null, 0 },      // raw machine state
     { "",   "cycs",_f0, 0, cm_print_cycs, cm_get_cycs, set_ro, &cs.null, 0 },      // cycle state
     { "",   "mots",_f0, 0, cm_print_mots, cm_get_mots, set_ro, &cs.null, 0 },      // motion state
@@ -174,6 +262,16 @@ const cfgItem_t cfgArray[] = {
     { "prb","prbc",_f0, 3, tx_print_nul, get_flt, set_ro, &cm.probe_results[0][AXIS_C], 0 },
     { "prb","prbr",_f0, 0, tx_print_nul, cm_get_prbr, cm_get_prbr, nullptr, 0 },    // enable probe report. Init in cm_init
 
+    { "scn","scnc",_fip, 0, tx_print_int, get_ui8, set_ui8, &cm.scan_columns, SCAN_COLUMNS },  // G38.6 points along X
+    { "scn","scnr",_fip, 0, tx_print_int, get_ui8, set_ui8, &cm.scan_rows, SCAN_ROWS },        // G38.6 points along Y
+    { "scn","scnn",_f0,  0, tx_print_int, get_int, set_ro,  &cm.scan_count, 0 },               // points probed in the last scan
+    { "scn","scnm",_f0,  0, tx_print_int, get_int, set_ro,  &cm.scan_missed, 0 },              // points that missed
+#if HEIGHT_MAP_ENABLED == true
+    { "hmp","hmpe",_f0,  0, tx_print_int, get_ui8, cm_set_hmpe, &kn_hmap.enable, 0 },          // apply the height map
+    { "hmp","hmpc",_f0,  0, tx_print_int, get_ui8, set_ro,  &kn_hmap.columns, 0 },             // map points along X, 0=none
+    { "hmp","hmpr",_f0,  0, tx_print_int, get_ui8, set_ro,  &kn_hmap.rows, 0 },                // map points along Y
+#endif
+
     { "jog","jogx",_f0, 0, tx_print_nul, get_nul, cm_run_jogx, &cm.jogging_dest, 0},
     { "jog","jogy",_f0, 0, tx_print_nul, get_nul, cm_run_jogy, &cm.jogging_dest, 0},
     { "jog","jogz",_f0, 0, tx_print_nul, get_nul, cm_run_jogz, &cm.jogging_dest, 0},
@@ -181,6 +279,13 @@ const cfgItem_t cfgArray[] = {
 //  { "jog","jogb",_f0, 0, tx_print_nul, get_nul, cm_run_jogb, &cm.jogging_dest, 0},
 //  { "jog","jogc",_f0, 0, tx_print_nul, get_nul, cm_run_jogc, &cm.jogging_dest, 0},
 
+    { "jv","jvx",_f0, 0, tx_print_flt, get_flt, cm_set_jv, &cm.jog_velocity[AXIS_X], 0},  // velocity jog target
+    { "jv","jvy",_f0, 0, tx_print_flt, get_flt, cm_set_jv, &cm.jog_velocity[AXIS_Y], 0},
+    { "jv","jvz",_f0, 0, tx_print_flt, get_flt, cm_set_jv, &cm.jog_velocity[AXIS_Z], 0},
+    { "jv","jva",_f0, 0, tx_print_flt, get_flt, cm_set_jv, &cm.jog_velocity[AXIS_A], 0},
+    { "jv","jvb",_f0, 0, tx_print_flt, get_flt, cm_set_jv, &cm.jog_velocity[AXIS_B], 0},
+    { "jv","jvc",_f0, 0, tx_print_flt, get_flt, cm_set_jv, &cm.jog_velocity[AXIS_C], 0},
+
 	{ "pwr","pwr1",_f0, 3, st_print_pwr, st_get_pwr, set_ro,  &cs.null, 0},	// motor power readouts
 	{ "pwr","pwr2",_f0, 3, st_print_pwr, st_get_pwr, set_ro,  &cs.null, 0},
 #if (MOTORS > 2)
@@ -197,215 +302,50 @@ const cfgItem_t cfgArray[] = {
 #endif
 
     // Motor parameters
-    { "1","1ma",_fip, 0, st_print_ma, get_ui8, st_set_ma,  &st_cfg.mot[MOTOR_1].motor_map,      M1_MOTOR_MAP },
-    { "1","1sa",_fip, 3, st_print_sa, get_flt, st_set_sa,  &st_cfg.mot[MOTOR_1].step_angle,     M1_STEP_ANGLE },
-    { "1","1tr",_fipc,4, st_print_tr, get_flt, st_set_tr,  &st_cfg.mot[MOTOR_1].travel_rev,     M1_TRAVEL_PER_REV },
-    { "1","1mi",_fip, 0, st_print_mi, get_ui8, st_set_mi,  &st_cfg.mot[MOTOR_1].microsteps,     M1_MICROSTEPS },
-    { "1","1su",_fipi,5, st_print_su, st_get_su,st_set_su, &st_cfg.mot[MOTOR_1].steps_per_unit, M1_STEPS_PER_UNIT },
-    { "1","1po",_fip, 0, st_print_po, get_ui8, set_01,     &st_cfg.mot[MOTOR_1].polarity,       M1_POLARITY },
-    { "1","1pm",_fip, 0, st_print_pm, st_get_pm,st_set_pm, &cs.null,                            M1_POWER_MODE },
-    { "1","1pl",_fip, 3, st_print_pl, get_flt, st_set_pl,  &st_cfg.mot[MOTOR_1].power_level,    M1_POWER_LEVEL },
-//  { "1","1pi",_fip, 3, st_print_pi, get_flt, st_set_pi,  &st_cfg.mot[MOTOR_1].power_idle,     M1_POWER_IDLE },
-//  { "1","1mt",_fip, 2, st_print_mt, get_flt, st_set_mt,  &st_cfg.mot[MOTOR_1].motor_timeout,  M1_MOTOR_TIMEOUT },
+    CFG_MOTOR(1),
 #if (MOTORS >= 2)
-    { "2","2ma",_fip, 0, st_print_ma, get_ui8, st_set_ma,  &st_cfg.mot[MOTOR_2].motor_map,      M2_MOTOR_MAP },
-    { "2","2sa",_fip, 3, st_print_sa, get_flt, st_set_sa,  &st_cfg.mot[MOTOR_2].step_angle,     M2_STEP_ANGLE },
-    { "2","2tr",_fipc,4, st_print_tr, get_flt, st_set_tr,  &st_cfg.mot[MOTOR_2].travel_rev,     M2_TRAVEL_PER_REV },
-    { "2","2mi",_fip, 0, st_print_mi, get_ui8, st_set_mi,  &st_cfg.mot[MOTOR_2].microsteps,     M2_MICROSTEPS },
-    { "2","2su",_fipi,5, st_print_su, st_get_su,st_set_su, &st_cfg.mot[MOTOR_2].steps_per_unit, M2_STEPS_PER_UNIT },
-    { "2","2po",_fip, 0, st_print_po, get_ui8, set_01,     &st_cfg.mot[MOTOR_2].polarity,       M2_POLARITY },
-    { "2","2pm",_fip, 0, st_print_pm, st_get_pm,st_set_pm, &cs.null,                            M2_POWER_MODE },
-    { "2","2pl",_fip, 3, st_print_pl, get_flt, st_set_pl,  &st_cfg.mot[MOTOR_2].power_level,    M2_POWER_LEVEL},
-//  { "2","2pi",_fip, 3, st_print_pi, get_flt, st_set_pi,  &st_cfg.mot[MOTOR_2].power_idle,     M2_POWER_IDLE },
-//  { "2","2mt",_fip, 2, st_print_mt, get_flt, st_set_mt,  &st_cfg.mot[MOTOR_2].motor_timeout,  M2_MOTOR_TIMEOUT },
+    CFG_MOTOR(2),
 #endif
 #if (MOTORS >= 3)
-    { "3","3ma",_fip, 0, st_print_ma, get_ui8, st_set_ma,  &st_cfg.mot[MOTOR_3].motor_map,      M3_MOTOR_MAP },
-    { "3","3sa",_fip, 3, st_print_sa, get_flt, st_set_sa,  &st_cfg.mot[MOTOR_3].step_angle,     M3_STEP_ANGLE },
-    { "3","3tr",_fipc,4, st_print_tr, get_flt, st_set_tr,  &st_cfg.mot[MOTOR_3].travel_rev,     M3_TRAVEL_PER_REV },
-    { "3","3mi",_fip, 0, st_print_mi, get_ui8, st_set_mi,  &st_cfg.mot[MOTOR_3].microsteps,     M3_MICROSTEPS },
-    { "3","3su",_fipi,5, st_print_su, st_get_su,st_set_su, &st_cfg.mot[MOTOR_3].steps_per_unit, M3_STEPS_PER_UNIT },
-    { "3","3po",_fip, 0, st_print_po, get_ui8, set_01,     &st_cfg.mot[MOTOR_3].polarity,       M3_POLARITY },
-    { "3","3pm",_fip, 0, st_print_pm, st_get_pm,st_set_pm, &cs.null,                            M3_POWER_MODE },
-    { "3","3pl",_fip, 3, st_print_pl, get_flt, st_set_pl,  &st_cfg.mot[MOTOR_3].power_level,    M3_POWER_LEVEL },
-//  { "3","3pi",_fip, 3, st_print_pi, get_flt, st_set_pi,  &st_cfg.mot[MOTOR_3].power_idle,     M3_POWER_IDLE },
-//  { "3","3mt",_fip, 2, st_print_mt, get_flt, st_set_mt,  &st_cfg.mot[MOTOR_3].motor_timeout,  M3_MOTOR_TIMEOUT },
+    CFG_MOTOR(3),
 #endif
 #if (MOTORS >= 4)
-    { "4","4ma",_fip, 0, st_print_ma, get_ui8, st_set_ma,  &st_cfg.mot[MOTOR_4].motor_map,      M4_MOTOR_MAP },
-    { "4","4sa",_fip, 3, st_print_sa, get_flt, st_set_sa,  &st_cfg.mot[MOTOR_4].step_angle,     M4_STEP_ANGLE },
-    { "4","4tr",_fipc,4, st_print_tr, get_flt, st_set_tr,  &st_cfg.mot[MOTOR_4].travel_rev,     M4_TRAVEL_PER_REV },
-    { "4","4mi",_fip, 0, st_print_mi, get_ui8, st_set_mi,  &st_cfg.mot[MOTOR_4].microsteps,     M4_MICROSTEPS },
-    { "4","4su",_fipi,5, st_print_su, st_get_su,st_set_su, &st_cfg.mot[MOTOR_4].steps_per_unit, M4_STEPS_PER_UNIT },
-    { "4","4po",_fip, 0, st_print_po, get_ui8, set_01,     &st_cfg.mot[MOTOR_4].polarity,       M4_POLARITY },
-    { "4","4pm",_fip, 0, st_print_pm, st_get_pm,st_set_pm, &cs.null,                            M4_POWER_MODE },
-    { "4","4pl",_fip, 3, st_print_pl, get_flt, st_set_pl,  &st_cfg.mot[MOTOR_4].power_level,    M4_POWER_LEVEL },
-//  { "4","4pi",_fip, 3, st_print_pi, get_flt, st_set_pi,  &st_cfg.mot[MOTOR_4].power_idle,     M4_POWER_IDLE },
-//  { "4","4mt",_fip, 2, st_print_mt, get_flt, st_set_mt,  &st_cfg.mot[MOTOR_4].motor_timeout,  M4_MOTOR_TIMEOUT },
+    CFG_MOTOR(4),
 #endif
 #if (MOTORS >= 5)
-    { "5","5ma",_fip, 0, st_print_ma, get_ui8, st_set_ma,  &st_cfg.mot[MOTOR_5].motor_map,      M5_MOTOR_MAP },
-    { "5","5sa",_fip, 3, st_print_sa, get_flt, st_set_sa,  &st_cfg.mot[MOTOR_5].step_angle,     M5_STEP_ANGLE },
-    { "5","5tr",_fipc,4, st_print_tr, get_flt, st_set_tr,  &st_cfg.mot[MOTOR_5].travel_rev,     M5_TRAVEL_PER_REV },
-    { "5","5mi",_fip, 0, st_print_mi, get_ui8, st_set_mi,  &st_cfg.mot[MOTOR_5].microsteps,     M5_MICROSTEPS },
-    { "5","5su",_fipi,5, st_print_su, st_get_su,st_set_su, &st_cfg.mot[MOTOR_5].steps_per_unit, M5_STEPS_PER_UNIT },
-    { "5","5po",_fip, 0, st_print_po, get_ui8, set_01,     &st_cfg.mot[MOTOR_5].polarity,       M5_POLARITY },
-    { "5","5pm",_fip, 0, st_print_pm, st_get_pm,st_set_pm, &cs.null,                            M5_POWER_MODE },
-    { "5","5pl",_fip, 3, st_print_pl, get_flt, st_set_pl,  &st_cfg.mot[MOTOR_5].power_level,    M5_POWER_LEVEL },
-//  { "5","5pi",_fip, 3, st_print_pi, get_flt, st_set_pi,  &st_cfg.mot[MOTOR_5].power_idle,     M5_POWER_IDLE },
-//  { "5","5mt",_fip, 2, st_print_mt, get_flt, st_set_mt,  &st_cfg.mot[MOTOR_5].motor_timeout,  M5_MOTOR_TIMEOUT },
+    CFG_MOTOR(5),
 #endif
 #if (MOTORS >= 6)
-    { "6","6ma",_fip, 0, st_print_ma, get_ui8, st_set_ma,  &st_cfg.mot[MOTOR_6].motor_map,      M6_MOTOR_MAP },
-    { "6","6sa",_fip, 3, st_print_sa, get_flt, st_set_sa,  &st_cfg.mot[MOTOR_6].step_angle,     M6_STEP_ANGLE },
-    { "6","6tr",_fipc,4, st_print_tr, get_flt, st_set_tr,  &st_cfg.mot[MOTOR_6].travel_rev,     M6_TRAVEL_PER_REV },
-    { "6","6mi",_fip, 0, st_print_mi, get_ui8, st_set_mi,  &st_cfg.mot[MOTOR_6].microsteps,     M6_MICROSTEPS },
-    { "6","6su",_fipi,5, st_print_su, st_get_su,st_set_su, &st_cfg.mot[MOTOR_6].steps_per_unit, M6_STEPS_PER_UNIT },
-    { "6","6po",_fip, 0, st_print_po, get_ui8, set_01,     &st_cfg.mot[MOTOR_6].polarity,       M6_POLARITY },
-    { "6","6pm",_fip, 0, st_print_pm, st_get_pm,st_set_pm, &cs.null,                            M6_POWER_MODE },
-    { "6","6pl",_fip, 3, st_print_pl, get_flt, st_set_pl,  &st_cfg.mot[MOTOR_6].power_level,    M6_POWER_LEVEL },
-//  { "6","6pi",_fip, 3, st_print_pi, get_flt, st_set_pi,  &st_cfg.mot[MOTOR_6].power_idle,     M6_POWER_IDLE },
-//  { "6","6mt",_fip, 2, st_print_mt, get_flt, st_set_mt,  &st_cfg.mot[MOTOR_6].motor_timeout,  M6_MOTOR_TIMEOUT },
+    CFG_MOTOR(6),
 #endif
     // Axis parameters
-    { "x","xam",_fip,  0, cm_print_am, cm_get_am, cm_set_am, &cm.a[AXIS_X].axis_mode,      X_AXIS_MODE },
-    { "x","xvm",_fipc, 0, cm_print_vm, get_flt,   cm_set_vm, &cm.a[AXIS_X].velocity_max,   X_VELOCITY_MAX },
-    { "x","xfr",_fipc, 0, cm_print_fr, get_flt,   cm_set_fr, &cm.a[AXIS_X].feedrate_max,   X_FEEDRATE_MAX },
-    { "x","xtn",_fipc, 3, cm_print_tn, get_flt,   set_flu,   &cm.a[AXIS_X].travel_min,     X_TRAVEL_MIN },
-    { "x","xtm",_fipc, 3, cm_print_tm, get_flt,   set_flu,   &cm.a[AXIS_X].travel_max,     X_TRAVEL_MAX },
-    { "x","xjm",_fipc, 0, cm_print_jm, get_flt,   cm_set_jm, &cm.a[AXIS_X].jerk_max,       X_JERK_MAX },
-    { "x","xjh",_fipc, 0, cm_print_jh, get_flt,   cm_set_jh, &cm.a[AXIS_X].jerk_high,      X_JERK_HIGH_SPEED },
-    { "x","xhi",_fip,  0, cm_print_hi, get_ui8,   cm_set_hi, &cm.a[AXIS_X].homing_input,   X_HOMING_INPUT },
-    { "x","xhd",_fip,  0, cm_print_hd, get_ui8,   set_01,    &cm.a[AXIS_X].homing_dir,     X_HOMING_DIRECTION },
-    { "x","xsv",_fipc, 0, cm_print_sv, get_flt,   set_flup,  &cm.a[AXIS_X].search_velocity,X_SEARCH_VELOCITY },
-    { "x","xlv",_fipc, 2, cm_print_lv, get_flt,   set_flup,  &cm.a[AXIS_X].latch_velocity, X_LATCH_VELOCITY },
-    { "x","xlb",_fipc, 3, cm_print_lb, get_flt,   set_flu,   &cm.a[AXIS_X].latch_backoff,  X_LATCH_BACKOFF },
-    { "x","xzb",_fipc, 3, cm_print_zb, get_flt,   set_flu,   &cm.a[AXIS_X].zero_backoff,   X_ZERO_BACKOFF },
-
-    { "y","yam",_fip,  0, cm_print_am, cm_get_am, cm_set_am, &cm.a[AXIS_Y].axis_mode,      Y_AXIS_MODE },
-    { "y","yvm",_fipc, 0, cm_print_vm, get_flt,   cm_set_vm, &cm.a[AXIS_Y].velocity_max,   Y_VELOCITY_MAX },
-    { "y","yfr",_fipc, 0, cm_print_fr, get_flt,   cm_set_fr, &cm.a[AXIS_Y].feedrate_max,   Y_FEEDRATE_MAX },
-    { "y","ytn",_fipc, 3, cm_print_tn, get_flt,   set_flu,   &cm.a[AXIS_Y].travel_min,     Y_TRAVEL_MIN },
-    { "y","ytm",_fipc, 3, cm_print_tm, get_flt,   set_flu,   &cm.a[AXIS_Y].travel_max,     Y_TRAVEL_MAX },
-    { "y","yjm",_fipc, 0, cm_print_jm, get_flt,   cm_set_jm, &cm.a[AXIS_Y].jerk_max,       Y_JERK_MAX },
-    { "y","yjh",_fipc, 0, cm_print_jh, get_flt,   cm_set_jh, &cm.a[AXIS_Y].jerk_high,      Y_JERK_HIGH_SPEED },
-    { "y","yhi",_fip,  0, cm_print_hi, get_ui8,   cm_set_hi, &cm.a[AXIS_Y].homing_input,   Y_HOMING_INPUT },
-    { "y","yhd",_fip,  0, cm_print_hd, get_ui8,   set_01,    &cm.a[AXIS_Y].homing_dir,     Y_HOMING_DIRECTION },
-    { "y","ysv",_fipc, 0, cm_print_sv, get_flt,   set_flup,  &cm.a[AXIS_Y].search_velocity,Y_SEARCH_VELOCITY },
-    { "y","ylv",_fipc, 2, cm_print_lv, get_flt,   set_flup,  &cm.a[AXIS_Y].latch_velocity, Y_LATCH_VELOCITY },
-    { "y","ylb",_fipc, 3, cm_print_lb, get_flt,   set_flu,   &cm.a[AXIS_Y].latch_backoff,  Y_LATCH_BACKOFF },
-    { "y","yzb",_fipc, 3, cm_print_zb, get_flt,   set_flu,   &cm.a[AXIS_Y].zero_backoff,   Y_ZERO_BACKOFF },
-
-    { "z","zam",_fip,  0, cm_print_am, cm_get_am, cm_set_am, &cm.a[AXIS_Z].axis_mode,      Z_AXIS_MODE },
-    { "z","zvm",_fipc, 0, cm_print_vm, get_flt,   cm_set_vm, &cm.a[AXIS_Z].velocity_max,   Z_VELOCITY_MAX },
-    { "z","zfr",_fipc, 0, cm_print_fr, get_flt,   cm_set_fr, &cm.a[AXIS_Z].feedrate_max,   Z_FEEDRATE_MAX },
-    { "z","ztn",_fipc, 3, cm_print_tn, get_flt,   set_flu,   &cm.a[AXIS_Z].travel_min,     Z_TRAVEL_MIN },
-    { "z","ztm",_fipc, 3, cm_print_tm, get_flt,   set_flu,   &cm.a[AXIS_Z].travel_max,     Z_TRAVEL_MAX },
-    { "z","zjm",_fipc, 0, cm_print_jm, get_flt,   cm_set_jm, &cm.a[AXIS_Z].jerk_max,       Z_JERK_MAX },
-    { "z","zjh",_fipc, 0, cm_print_jh, get_flt,   cm_set_jh, &cm.a[AXIS_Z].jerk_high,      Z_JERK_HIGH_SPEED },
-    { "z","zhi",_fip,  0, cm_print_hi, get_ui8,   cm_set_hi, &cm.a[AXIS_Z].homing_input,   Z_HOMING_INPUT },
-    { "z","zhd",_fip,  0, cm_print_hd, get_ui8,   set_01,    &cm.a[AXIS_Z].homing_dir,     Z_HOMING_DIRECTION },
-    { "z","zsv",_fipc, 0, cm_print_sv, get_flt,   set_flup,  &cm.a[AXIS_Z].search_velocity,Z_SEARCH_VELOCITY },
-    { "z","zlv",_fipc, 2, cm_print_lv, get_flt,   set_flup,  &cm.a[AXIS_Z].latch_velocity, Z_LATCH_VELOCITY },
-    { "z","zlb",_fipc, 3, cm_print_lb, get_flt,   set_flu,   &cm.a[AXIS_Z].latch_backoff,  Z_LATCH_BACKOFF },
-    { "z","zzb",_fipc, 3, cm_print_zb, get_flt,   set_flu,   &cm.a[AXIS_Z].zero_backoff,   Z_ZERO_BACKOFF },
-
-    { "a","aam",_fip,  0, cm_print_am, cm_get_am, cm_set_am, &cm.a[AXIS_A].axis_mode,      A_AXIS_MODE },
-    { "a","avm",_fip,  0, cm_print_vm, get_flt,   cm_set_vm, &cm.a[AXIS_A].velocity_max,   A_VELOCITY_MAX },
-    { "a","afr",_fip,  0, cm_print_fr, get_flt,   cm_set_fr, &cm.a[AXIS_A].feedrate_max,   A_FEEDRATE_MAX },
-    { "a","atn",_fip,  3, cm_print_tn, get_flt,   set_flt,   &cm.a[AXIS_A].travel_min,     A_TRAVEL_MIN },
-    { "a","atm",_fip,  3, cm_print_tm, get_flt,   set_flt,   &cm.a[AXIS_A].travel_max,     A_TRAVEL_MAX },
-    { "a","ajm",_fip,  0, cm_print_jm, get_flt,   cm_set_jm, &cm.a[AXIS_A].jerk_max,       A_JERK_MAX },
-    { "a","ajh",_fip,  0, cm_print_jh, get_flt,   cm_set_jh, &cm.a[AXIS_A].jerk_high,      A_JERK_HIGH_SPEED },
-    { "a","ara",_fipc, 3, cm_print_ra, get_flt,   set_flt,   &cm.a[AXIS_A].radius,         A_RADIUS},
-    { "a","ahi",_fip,  0, cm_print_hi, get_ui8,   cm_set_hi, &cm.a[AXIS_A].homing_input,   A_HOMING_INPUT },
-    { "a","ahd",_fip,  0, cm_print_hd, get_ui8,   set_01,    &cm.a[AXIS_A].homing_dir,     A_HOMING_DIRECTION },
-    { "a","asv",_fip,  0, cm_print_sv, get_flt,   set_fltp,  &cm.a[AXIS_A].search_velocity,A_SEARCH_VELOCITY },
-    { "a","alv",_fip,  2, cm_print_lv, get_flt,   set_fltp,  &cm.a[AXIS_A].latch_velocity, A_LATCH_VELOCITY },
-    { "a","alb",_fip,  3, cm_print_lb, get_flt,   set_flt,   &cm.a[AXIS_A].latch_backoff,  A_LATCH_BACKOFF },
-    { "a","azb",_fip,  3, cm_print_zb, get_flt,   set_flt,   &cm.a[AXIS_A].zero_backoff,   A_ZERO_BACKOFF },
-
-    { "b","bam",_fip,  0, cm_print_am, cm_get_am, cm_set_am, &cm.a[AXIS_B].axis_mode,      B_AXIS_MODE },
-    { "b","bvm",_fip,  0, cm_print_vm, get_flt,   cm_set_vm, &cm.a[AXIS_B].velocity_max,   B_VELOCITY_MAX },
-    { "b","bfr",_fip,  0, cm_print_fr, get_flt,   cm_set_fr, &cm.a[AXIS_B].feedrate_max,   B_FEEDRATE_MAX },
-    { "b","btn",_fip,  3, cm_print_tn, get_flt,   set_flt,   &cm.a[AXIS_B].travel_min,     B_TRAVEL_MIN },
-    { "b","btm",_fip,  3, cm_print_tm, get_flt,   set_flt,   &cm.a[AXIS_B].travel_max,     B_TRAVEL_MAX },
-    { "b","bjm",_fip,  0, cm_print_jm, get_flt,   cm_set_jm, &cm.a[AXIS_B].jerk_max,       B_JERK_MAX },
-    { "b","bjh",_fip,  0, cm_print_jh, get_flt,   cm_set_jh, &cm.a[AXIS_B].jerk_high,      B_JERK_HIGH_SPEED },
-    { "b","bra",_fipc, 3, cm_print_ra, get_flt,   set_flt,   &cm.a[AXIS_B].radius,         B_RADIUS },
-    { "b","bhi",_fip,  0, cm_print_hi, get_ui8,   cm_set_hi, &cm.a[AXIS_B].homing_input,   B_HOMING_INPUT },
-    { "b","bhd",_fip,  0, cm_print_hd, get_ui8,   set_01,    &cm.a[AXIS_B].homing_dir,     B_HOMING_DIRECTION },
-    { "b","bsv",_fip,  0, cm_print_sv, get_flt,   set_fltp,  &cm.a[AXIS_B].search_velocity,B_SEARCH_VELOCITY },
-    { "b","blv",_fip,  2, cm_print_lv, get_flt,   set_fltp,  &cm.a[AXIS_B].latch_velocity, B_LATCH_VELOCITY },
-    { "b","blb",_fip,  3, cm_print_lb, get_flt,   set_flt,   &cm.a[AXIS_B].latch_backoff,  B_LATCH_BACKOFF },
-    { "b","bzb",_fip,  3, cm_print_zb, get_flt,   set_flt,   &cm.a[AXIS_B].zero_backoff,   B_ZERO_BACKOFF },
-
-    { "c","cam",_fip,  0, cm_print_am, cm_get_am, cm_set_am, &cm.a[AXIS_C].axis_mode,      C_AXIS_MODE },
-    { "c","cvm",_fip,  0, cm_print_vm, get_flt,   cm_set_vm, &cm.a[AXIS_C].velocity_max,   C_VELOCITY_MAX },
-    { "c","cfr",_fip,  0, cm_print_fr, get_flt,   cm_set_fr, &cm.a[AXIS_C].feedrate_max,   C_FEEDRATE_MAX },
-    { "c","ctn",_fip,  3, cm_print_tn, get_flt,   set_flt,   &cm.a[AXIS_C].travel_min,     C_TRAVEL_MIN },
-    { "c","ctm",_fip,  3, cm_print_tm, get_flt,   set_flt,   &cm.a[AXIS_C].travel_max,     C_TRAVEL_MAX },
-    { "c","cjm",_fip,  0, cm_print_jm, get_flt,   cm_set_jm, &cm.a[AXIS_C].jerk_max,       C_JERK_MAX },
-    { "c","cjh",_fip,  0, cm_print_jh, get_flt,   cm_set_jh, &cm.a[AXIS_C].jerk_high,       C_JERK_HIGH_SPEED },
-    { "c","cra",_fipc, 3, cm_print_ra, get_flt,   set_flt,   &cm.a[AXIS_C].radius,         C_RADIUS },
-    { "c","chi",_fip,  0, cm_print_hi, get_ui8,   cm_set_hi, &cm.a[AXIS_C].homing_input,   C_HOMING_INPUT },
-    { "c","chd",_fip,  0, cm_print_hd, get_ui8,   set_01,    &cm.a[AXIS_C].homing_dir,     C_HOMING_DIRECTION },
-    { "c","csv",_fip,  0, cm_print_sv, get_flt,   set_fltp,  &cm.a[AXIS_C].search_velocity,C_SEARCH_VELOCITY },
-    { "c","clv",_fip,  2, cm_print_lv, get_flt,   set_fltp,  &cm.a[AXIS_C].latch_velocity, C_LATCH_VELOCITY },
-    { "c","clb",_fip,  3, cm_print_lb, get_flt,   set_flt,   &cm.a[AXIS_C].latch_backoff,  C_LATCH_BACKOFF },
-    { "c","czb",_fip,  3, cm_print_zb, get_flt,   set_flt,   &cm.a[AXIS_C].zero_backoff,   C_ZERO_BACKOFF },
+    CFG_LINEAR_AXIS(x,X),
+    CFG_LINEAR_AXIS(y,Y),
+    CFG_LINEAR_AXIS(z,Z),
+    CFG_ROTARY_AXIS(a,A),
+    CFG_ROTARY_AXIS(b,B),
+    CFG_ROTARY_AXIS(c,C),
 
     // Digital input configs
-    { "di1","di1mo",_fip, 0, io_print_mo, get_int8,io_set_mo, &d_in[0].mode,     DI1_MODE },
-    { "di1","di1ac",_fip, 0, io_print_ac, get_ui8, io_set_ac, &d_in[0].action,   DI1_ACTION },
-    { "di1","di1fn",_fip, 0, io_print_fn, get_ui8, io_set_fn, &d_in[0].function, DI1_FUNCTION },
-
-    { "di2","di2mo",_fip, 0, io_print_mo, get_int8,io_set_mo, &d_in[1].mode,     DI2_MODE },
-    { "di2","di2ac",_fip, 0, io_print_ac, get_ui8, io_set_ac, &d_in[1].action,   DI2_ACTION },
-    { "di2","di2fn",_fip, 0, io_print_fn, get_ui8, io_set_fn, &d_in[1].function, DI2_FUNCTION },
-
-    { "di3","di3mo",_fip, 0, io_print_mo, get_int8,io_set_mo, &d_in[2].mode,     DI3_MODE },
-    { "di3","di3ac",_fip, 0, io_print_ac, get_ui8, io_set_ac, &d_in[2].action,   DI3_ACTION },
-    { "di3","di3fn",_fip, 0, io_print_fn, get_ui8, io_set_fn, &d_in[2].function, DI3_FUNCTION },
-
-    { "di4","di4mo",_fip, 0, io_print_mo, get_int8,io_set_mo, &d_in[3].mode,     DI4_MODE },
-    { "di4","di4ac",_fip, 0, io_print_ac, get_ui8, io_set_ac, &d_in[3].action,   DI4_ACTION },
-    { "di4","di4fn",_fip, 0, io_print_fn, get_ui8, io_set_fn, &d_in[3].function, DI4_FUNCTION },
-
-    { "di5","di5mo",_fip, 0, io_print_mo, get_int8,io_set_mo, &d_in[4].mode,     DI5_MODE },
-    { "di5","di5ac",_fip, 0, io_print_ac, get_ui8, io_set_ac, &d_in[4].action,   DI5_ACTION },
-    { "di5","di5fn",_fip, 0, io_print_fn, get_ui8, io_set_fn, &d_in[4].function, DI5_FUNCTION },
-
-    { "di6","di6mo",_fip, 0, io_print_mo, get_int8,io_set_mo, &d_in[5].mode,     DI6_MODE },
-    { "di6","di6ac",_fip, 0, io_print_ac, get_ui8, io_set_ac, &d_in[5].action,   DI6_ACTION },
-    { "di6","di6fn",_fip, 0, io_print_fn, get_ui8, io_set_fn, &d_in[5].function, DI6_FUNCTION },
-
-    { "di7","di7mo",_fip, 0, io_print_mo, get_int8,io_set_mo, &d_in[6].mode,     DI7_MODE },
-    { "di7","di7ac",_fip, 0, io_print_ac, get_ui8, io_set_ac, &d_in[6].action,   DI7_ACTION },
-    { "di7","di7fn",_fip, 0, io_print_fn, get_ui8, io_set_fn, &d_in[6].function, DI7_FUNCTION },
-
-    { "di8","di8mo",_fip, 0, io_print_mo, get_int8,io_set_mo, &d_in[7].mode,     DI8_MODE },
-    { "di8","di8ac",_fip, 0, io_print_ac, get_ui8, io_set_ac, &d_in[7].action,   DI8_ACTION },
-    { "di8","di8fn",_fip, 0, io_print_fn, get_ui8, io_set_fn, &d_in[7].function, DI8_FUNCTION },
+    CFG_DIGITAL_INPUT(1,0),
+    CFG_DIGITAL_INPUT(2,1),
+    CFG_DIGITAL_INPUT(3,2),
+    CFG_DIGITAL_INPUT(4,3),
+    CFG_DIGITAL_INPUT(5,4),
+    CFG_DIGITAL_INPUT(6,5),
+    CFG_DIGITAL_INPUT(7,6),
+    CFG_DIGITAL_INPUT(8,7),
 #if (D_IN_CHANNELS >= 9)
-    { "di9","di9mo",_fip, 0, io_print_mo, get_int8,io_set_mo, &d_in[8].mode,     DI9_MODE },
-    { "di9","di9ac",_fip, 0, io_print_ac, get_ui8, io_set_ac, &d_in[8].action,   DI9_ACTION },
-    { "di9","di9fn",_fip, 0, io_print_fn, get_ui8, io_set_fn, &d_in[8].function, DI9_FUNCTION },
+    CFG_DIGITAL_INPUT(9,8),
 #endif
 #if (D_IN_CHANNELS >= 10)
-    { "di10","di10mo",_fip, 0, io_print_mo, get_int8,io_set_mo, &d_in[9].mode,     DI10_MODE },
-    { "di10","di10ac",_fip, 0, io_print_ac, get_ui8, io_set_ac, &d_in[9].action,   DI10_ACTION },
-    { "di10","di10fn",_fip, 0, io_print_fn, get_ui8, io_set_fn, &d_in[9].function, DI10_FUNCTION },
+    CFG_DIGITAL_INPUT(10,9),
 #endif
 #if (D_IN_CHANNELS >= 11)
-    { "di11","di11mo",_fip, 0, io_print_mo, get_int8,io_set_mo, &d_in[10].mode,     DI11_MODE },
-    { "di11","di11ac",_fip, 0, io_print_ac, get_ui8, io_set_ac, &d_in[10].action,   DI11_ACTION },
-    { "di11","di11fn",_fip, 0, io_print_fn, get_ui8, io_set_fn, &d_in[10].function, DI11_FUNCTION },
+    CFG_DIGITAL_INPUT(11,10),
 #endif
 #if (D_IN_CHANNELS >= 12)
-    { "di12","di12mo",_fip, 0, io_print_mo, get_int8,io_set_mo, &d_in[11].mode,     DI12_MODE },
-    { "di12","di12ac",_fip, 0, io_print_ac, get_ui8, io_set_ac, &d_in[11].action,   DI12_ACTION },
-    { "di12","di12fn",_fip, 0, io_print_fn, get_ui8, io_set_fn, &d_in[11].function, DI12_FUNCTION },
+    CFG_DIGITAL_INPUT(12,11),
 #endif
 
     // Digital input state readers
@@ -491,6 +431,9 @@ const cfgItem_t cfgArray[] = {
     { "he1","he1p", _fi,  3, tx_print_nul, cm_get_heater_p,        cm_set_heater_p,        &cs.null, H1_DEFAULT_P },
     { "he1","he1i", _fi,  5, tx_print_nul, cm_get_heater_i,        cm_set_heater_i,        &cs.null, H1_DEFAULT_I },
     { "he1","he1d", _fi,  5, tx_print_nul, cm_get_heater_d,        cm_set_heater_d,        &cs.null, H1_DEFAULT_D },
+    { "he1","he1ff",_fi,  5, tx_print_nul, cm_get_heater_ff,       cm_set_heater_ff,       &cs.null, H1_DEFAULT_FF },
+    { "he1","he1fc",_fi,  3, tx_print_nul, cm_get_heater_fc,       cm_set_heater_fc,       &cs.null, H1_DEFAULT_FC },
+    { "he1","he1au",_f0,  0, tx_print_nul, cm_get_heater_autotune, cm_set_heater_autotune, &cs.null, 0 },
     { "he1","he1st",_f0,  1, tx_print_nul, cm_get_set_temperature, cm_set_set_temperature, &cs.null, 0 },
     { "he1","he1t", _f0,  1, tx_print_nul, cm_get_temperature,     set_ro,                 &cs.null, 0 },
     { "he1","he1op",_f0,  3, tx_print_nul, cm_get_heater_output,   set_ro,                 &cs.null, 0 },
@@ -506,6 +449,9 @@ const cfgItem_t cfgArray[] = {
     { "he2","he2p", _fi,  3, tx_print_nul, cm_get_heater_p,        cm_set_heater_p,        &cs.null, H2_DEFAULT_P },
     { "he2","he2i", _fi,  5, tx_print_nul, cm_get_heater_i,        cm_set_heater_i,        &cs.null, H2_DEFAULT_I },
     { "he2","he2d", _fi,  5, tx_print_nul, cm_get_heater_d,        cm_set_heater_d,        &cs.null, H2_DEFAULT_D },
+    { "he2","he2ff",_fi,  5, tx_print_nul, cm_get_heater_ff,       cm_set_heater_ff,       &cs.null, H2_DEFAULT_FF },
+    { "he2","he2fc",_fi,  3, tx_print_nul, cm_get_heater_fc,       cm_set_heater_fc,       &cs.null, H2_DEFAULT_FC },
+    { "he2","he2au",_f0,  0, tx_print_nul, cm_get_heater_autotune, cm_set_heater_autotune, &cs.null, 0 },
     { "he2","he2st",_f0,  0, tx_print_nul, cm_get_set_temperature, cm_set_set_temperature, &cs.null, 0 },
     { "he2","he2t", _f0,  1, tx_print_nul, cm_get_temperature,     set_ro,                 &cs.null, 0 },
     { "he2","he2op",_f0,  3, tx_print_nul, cm_get_heater_output,   set_ro,                 &cs.null, 0 },
@@ -521,6 +467,9 @@ const cfgItem_t cfgArray[] = {
     { "he3","he3p", _fi,  3, tx_print_nul, cm_get_heater_p,        cm_set_heater_p,        &cs.null, H3_DEFAULT_P },
     { "he3","he3i", _fi,  5, tx_print_nul, cm_get_heater_i,        cm_set_heater_i,        &cs.null, H3_DEFAULT_I },
     { "he3","he3d", _fi,  5, tx_print_nul, cm_get_heater_d,        cm_set_heater_d,        &cs.null, H3_DEFAULT_D },
+    { "he3","he3ff",_fi,  5, tx_print_nul, cm_get_heater_ff,       cm_set_heater_ff,       &cs.null, H3_DEFAULT_FF },
+    { "he3","he3fc",_fi,  3, tx_print_nul, cm_get_heater_fc,       cm_set_heater_fc,       &cs.null, H3_DEFAULT_FC },
+    { "he3","he3au",_f0,  0, tx_print_nul, cm_get_heater_autotune, cm_set_heater_autotune, &cs.null, 0 },
     { "he3","he3st",_f0,  0, tx_print_nul, cm_get_set_temperature, cm_set_set_temperature, &cs.null, 0 },
     { "he3","he3t", _f0,  1, tx_print_nul, cm_get_temperature,     set_ro,                 &cs.null, 0 },
     { "he3","he3op",_f0,  3, tx_print_nul, cm_get_heater_output,   set_ro,                 &cs.null, 0 },
@@ -533,47 +482,47 @@ const cfgItem_t cfgArray[] = {
     { "he3","he3fh",_f0,  1, tx_print_nul, cm_get_fan_high_temp,   cm_set_fan_high_temp,   &cs.null, 0 },
 
     // Coordinate system offsets (G54-G59 and G92)
-    { "g54","g54x",_fipc, 3, cm_print_cofs, get_flt, set_flu,&cm.offset[G54][AXIS_X], G54_X_OFFSET },
-    { "g54","g54y",_fipc, 3, cm_print_cofs, get_flt, set_flu,&cm.offset[G54][AXIS_Y], G54_Y_OFFSET },
-    { "g54","g54z",_fipc, 3, cm_print_cofs, get_flt, set_flu,&cm.offset[G54][AXIS_Z], G54_Z_OFFSET },
-    { "g54","g54a",_fip,  3, cm_print_cofs, get_flt, set_flt,&cm.offset[G54][AXIS_A], G54_A_OFFSET },
-    { "g54","g54b",_fip,  3, cm_print_cofs, get_flt, set_flt,&cm.offset[G54][AXIS_B], G54_B_OFFSET },
-    { "g54","g54c",_fip,  3, cm_print_cofs, get_flt, set_flt,&cm.offset[G54][AXIS_C], G54_C_OFFSET },
-
-    { "g55","g55x",_fipc, 3, cm_print_cofs, get_flt, set_flu,&cm.offset[G55][AXIS_X], G55_X_OFFSET },
-    { "g55","g55y",_fipc, 3, cm_print_cofs, get_flt, set_flu,&cm.offset[G55][AXIS_Y], G55_Y_OFFSET },
-    { "g55","g55z",_fipc, 3, cm_print_cofs, get_flt, set_flu,&cm.offset[G55][AXIS_Z], G55_Z_OFFSET },
-    { "g55","g55a",_fip,  3, cm_print_cofs, get_flt, set_flt,&cm.offset[G55][AXIS_A], G55_A_OFFSET },
-    { "g55","g55b",_fip,  3, cm_print_cofs, get_flt, set_flt,&cm.offset[G55][AXIS_B], G55_B_OFFSET },
-    { "g55","g55c",_fip,  3, cm_print_cofs, get_flt, set_flt,&cm.offset[G55][AXIS_C], G55_C_OFFSET },
-
-    { "g56","g56x",_fipc, 3, cm_print_cofs, get_flt, set_flu,&cm.offset[G56][AXIS_X], G56_X_OFFSET },
-    { "g56","g56y",_fipc, 3, cm_print_cofs, get_flt, set_flu,&cm.offset[G56][AXIS_Y], G56_Y_OFFSET },
-    { "g56","g56z",_fipc, 3, cm_print_cofs, get_flt, set_flu,&cm.offset[G56][AXIS_Z], G56_Z_OFFSET },
-    { "g56","g56a",_fip,  3, cm_print_cofs, get_flt, set_flt,&cm.offset[G56][AXIS_A], G56_A_OFFSET },
-    { "g56","g56b",_fip,  3, cm_print_cofs, get_flt, set_flt,&cm.offset[G56][AXIS_B], G56_B_OFFSET },
-    { "g56","g56c",_fip,  3, cm_print_cofs, get_flt, set_flt,&cm.offset[G56][AXIS_C], G56_C_OFFSET },
-
-    { "g57","g57x",_fipc, 3, cm_print_cofs, get_flt, set_flu,&cm.offset[G57][AXIS_X], G57_X_OFFSET },
-    { "g57","g57y",_fipc, 3, cm_print_cofs, get_flt, set_flu,&cm.offset[G57][AXIS_Y], G57_Y_OFFSET },
-    { "g57","g57z",_fipc, 3, cm_print_cofs, get_flt, set_flu,&cm.offset[G57][AXIS_Z], G57_Z_OFFSET },
-    { "g57","g57a",_fip,  3, cm_print_cofs, get_flt, set_flt,&cm.offset[G57][AXIS_A], G57_A_OFFSET },
-    { "g57","g57b",_fip,  3, cm_print_cofs, get_flt, set_flt,&cm.offset[G57][AXIS_B], G57_B_OFFSET },
-    { "g57","g57c",_fip,  3, cm_print_cofs, get_flt, set_flt,&cm.offset[G57][AXIS_C], G57_C_OFFSET },
-
-    { "g58","g58x",_fipc, 3, cm_print_cofs, get_flt, set_flu,&cm.offset[G58][AXIS_X], G58_X_OFFSET },
-    { "g58","g58y",_fipc, 3, cm_print_cofs, get_flt, set_flu,&cm.offset[G58][AXIS_Y], G58_Y_OFFSET },
-    { "g58","g58z",_fipc, 3, cm_print_cofs, get_flt, set_flu,&cm.offset[G58][AXIS_Z], G58_Z_OFFSET },
-    { "g58","g58a",_fip,  3, cm_print_cofs, get_flt, set_flt,&cm.offset[G58][AXIS_A], G58_A_OFFSET },
-    { "g58","g58b",_fip,  3, cm_print_cofs, get_flt, set_flt,&cm.offset[G58][AXIS_B], G58_B_OFFSET },
-    { "g58","g58c",_fip,  3, cm_print_cofs, get_flt, set_flt,&cm.offset[G58][AXIS_C], G58_C_OFFSET },
-
-    { "g59","g59x",_fipc, 3, cm_print_cofs, get_flt, set_flu,&cm.offset[G59][AXIS_X], G59_X_OFFSET },
-    { "g59","g59y",_fipc, 3, cm_print_cofs, get_flt, set_flu,&cm.offset[G59][AXIS_Y], G59_Y_OFFSET },
-    { "g59","g59z",_fipc, 3, cm_print_cofs, get_flt, set_flu,&cm.offset[G59][AXIS_Z], G59_Z_OFFSET },
-    { "g59","g59a",_fip,  3, cm_print_cofs, get_flt, set_flt,&cm.offset[G59][AXIS_A], G59_A_OFFSET },
-    { "g59","g59b",_fip,  3, cm_print_cofs, get_flt, set_flt,&cm.offset[G59][AXIS_B], G59_B_OFFSET },
-    { "g59","g59c",_fip,  3, cm_print_cofs, get_flt, set_flt,&cm.offset[G59][AXIS_C], G59_C_OFFSET },
+    { "g54","g54x",_fipc, 3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G54][AXIS_X], G54_X_OFFSET },
+    { "g54","g54y",_fipc, 3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G54][AXIS_Y], G54_Y_OFFSET },
+    { "g54","g54z",_fipc, 3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G54][AXIS_Z], G54_Z_OFFSET },
+    { "g54","g54a",_fip,  3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G54][AXIS_A], G54_A_OFFSET },
+    { "g54","g54b",_fip,  3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G54][AXIS_B], G54_B_OFFSET },
+    { "g54","g54c",_fip,  3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G54][AXIS_C], G54_C_OFFSET },
+
+    { "g55","g55x",_fipc, 3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G55][AXIS_X], G55_X_OFFSET },
+    { "g55","g55y",_fipc, 3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G55][AXIS_Y], G55_Y_OFFSET },
+    { "g55","g55z",_fipc, 3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G55][AXIS_Z], G55_Z_OFFSET },
+    { "g55","g55a",_fip,  3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G55][AXIS_A], G55_A_OFFSET },
+    { "g55","g55b",_fip,  3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G55][AXIS_B], G55_B_OFFSET },
+    { "g55","g55c",_fip,  3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G55][AXIS_C], G55_C_OFFSET },
+
+    { "g56","g56x",_fipc, 3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G56][AXIS_X], G56_X_OFFSET },
+    { "g56","g56y",_fipc, 3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G56][AXIS_Y], G56_Y_OFFSET },
+    { "g56","g56z",_fipc, 3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G56][AXIS_Z], G56_Z_OFFSET },
+    { "g56","g56a",_fip,  3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G56][AXIS_A], G56_A_OFFSET },
+    { "g56","g56b",_fip,  3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G56][AXIS_B], G56_B_OFFSET },
+    { "g56","g56c",_fip,  3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G56][AXIS_C], G56_C_OFFSET },
+
+    { "g57","g57x",_fipc, 3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G57][AXIS_X], G57_X_OFFSET },
+    { "g57","g57y",_fipc, 3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G57][AXIS_Y], G57_Y_OFFSET },
+    { "g57","g57z",_fipc, 3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G57][AXIS_Z], G57_Z_OFFSET },
+    { "g57","g57a",_fip,  3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G57][AXIS_A], G57_A_OFFSET },
+    { "g57","g57b",_fip,  3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G57][AXIS_B], G57_B_OFFSET },
+    { "g57","g57c",_fip,  3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G57][AXIS_C], G57_C_OFFSET },
+
+    { "g58","g58x",_fipc, 3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G58][AXIS_X], G58_X_OFFSET },
+    { "g58","g58y",_fipc, 3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G58][AXIS_Y], G58_Y_OFFSET },
+    { "g58","g58z",_fipc, 3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G58][AXIS_Z], G58_Z_OFFSET },
+    { "g58","g58a",_fip,  3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G58][AXIS_A], G58_A_OFFSET },
+    { "g58","g58b",_fip,  3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G58][AXIS_B], G58_B_OFFSET },
+    { "g58","g58c",_fip,  3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G58][AXIS_C], G58_C_OFFSET },
+
+    { "g59","g59x",_fipc, 3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G59][AXIS_X], G59_X_OFFSET },
+    { "g59","g59y",_fipc, 3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G59][AXIS_Y], G59_Y_OFFSET },
+    { "g59","g59z",_fipc, 3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G59][AXIS_Z], G59_Z_OFFSET },
+    { "g59","g59a",_fip,  3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G59][AXIS_A], G59_A_OFFSET },
+    { "g59","g59b",_fip,  3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G59][AXIS_B], G59_B_OFFSET },
+    { "g59","g59c",_fip,  3, cm_print_cofs, get_flt, cm_set_cofs,&cm.offset[G59][AXIS_C], G59_C_OFFSET },
 
     { "g92","g92x",_fic, 3, cm_print_cofs, get_flt, set_ro, &cm.gmx.origin_offset[AXIS_X], 0 },// G92 handled differently
     { "g92","g92y",_fic, 3, cm_print_cofs, get_flt, set_ro, &cm.gmx.origin_offset[AXIS_Y], 0 },
@@ -838,15 +787,75 @@ const cfgItem_t cfgArray[] = {
 
     // General system parameters
     { "sys","jt", _fipn, 2, cm_print_jt,  get_flt, cm_set_jt,&cm.junction_integration_time,JUNCTION_INTEGRATION_TIME },
+    { "sys","sgx",_fipn, 2, cm_print_sgx, get_flt, cm_set_sgx,&cm.segment_stretch_max,     SEGMENT_STRETCH_MAX },
+    { "sys","jc", _fipn, 0, cm_print_jc,  get_ui8, set_01,   &cm.junction_curvature_enable,JUNCTION_CURVATURE_ENABLE },
     { "sys","ct", _fipnc,4, cm_print_ct,  get_flt, set_flup, &cm.chordal_tolerance,        CHORDAL_TOLERANCE },
-    { "sys","sl", _fipn, 0, cm_print_sl,  get_ui8, set_01,   &cm.soft_limit_enable,        SOFT_LIMIT_ENABLE },
+    { "sys","sl", _fipn, 0, cm_print_sl,  get_ui8, cm_set_sl,&cm.soft_limit_enable,        SOFT_LIMIT_ENABLE },
     { "sys","lim", _fipn,0, cm_print_lim, get_ui8, set_01,   &cm.limit_enable,             HARD_LIMIT_ENABLE },
     { "sys","saf", _fipn,0, cm_print_saf, get_ui8, set_01,   &cm.safety_interlock_enable,  SAFETY_INTERLOCK_ENABLE },
     { "sys","m48e",_fipn,0, cm_print_m48e,get_ui8, set_01,   &cm.gmx.m48_enable, 0 },      // M48/M49 feedrate & spindle override enable
     { "sys","mfoe",_fipn,0, cm_print_mfoe,get_ui8, set_01,   &cm.gmx.mfo_enable,           FEED_OVERRIDE_ENABLE},
     { "sys","mfo", _fipn,3, cm_print_mfo, get_flt,cm_set_mfo,&cm.gmx.mfo_factor,           FEED_OVERRIDE_FACTOR},
+    { "sys","mfok",_fipn,0, cm_print_mfok,get_ui8, set_01,   &cm.mfo_knob_enable,          FEED_OVERRIDE_KNOB},
     { "sys","mtoe",_fipn,0, cm_print_mtoe,get_ui8, set_01,   &cm.gmx.mto_enable,           TRAVERSE_OVERRIDE_ENABLE},
     { "sys","mto", _fipn,3, cm_print_mto, get_flt,cm_set_mto,&cm.gmx.mto_factor,           TRAVERSE_OVERRIDE_FACTOR},
+#if MARLIN_COMPAT_ENABLED == true
+    { "sys","pa",  _fipn,4, marlin_print_pa,get_flt,set_fltp,&mst.pressure_advance,       MARLIN_PRESSURE_ADVANCE },
+#endif
+
+    // Short segment coalescing - see plan_coalesce.h
+    { "coal","coale",_fip, 0, mp_print_coale, get_ui8, set_012,  &coal.enable,         COALESCE_ENABLE },
+    { "coal","coall",_fipc,4, mp_print_coall, get_flt, set_flup, &coal.segment_length, COALESCE_SEGMENT_LENGTH },
+    { "coal","coalt",_fipc,4, mp_print_coalt, get_flt, set_flup, &coal.tolerance,      COALESCE_TOLERANCE },
+    { "coal","coalm",_fipc,3, mp_print_coalm, get_flt, set_flup, &coal.length_max,     COALESCE_LENGTH_MAX },
+    { "coal","coaln",_f0,  0, mp_print_coaln, get_int, set_ro,   &coal.merged, 0 },    // count of moves absorbed
+
+    // Streaming lookahead - see plan_lookahead.h
+    { "look","looke",_fip, 0, mp_print_looke, get_ui8, set_012,  &look.enable,         LOOKAHEAD_ENABLE },
+    { "look","lookn",_f0,  0, mp_print_lookn, get_int, set_ro,   &look.held, 0 },      // count of moves held
+
+    // Input shaping - see plan_shaper.h
+    { "shp","shpxt",_fip, 0, mp_print_shpt, get_ui8, mp_set_shpt, &shp.type[AXIS_X],      SHAPER_X_TYPE },
+    { "shp","shpxf",_fip, 1, mp_print_shpf, get_flt, mp_set_shpf, &shp.frequency[AXIS_X], SHAPER_X_FREQUENCY },
+    { "shp","shpyt",_fip, 0, mp_print_shpt, get_ui8, mp_set_shpt, &shp.type[AXIS_Y],      SHAPER_Y_TYPE },
+    { "shp","shpyf",_fip, 1, mp_print_shpf, get_flt, mp_set_shpf, &shp.frequency[AXIS_Y], SHAPER_Y_FREQUENCY },
+    { "shp","shpzt",_fip, 0, mp_print_shpt, get_ui8, mp_set_shpt, &shp.type[AXIS_Z],      SHAPER_Z_TYPE },
+    { "shp","shpzf",_fip, 1, mp_print_shpf, get_flt, mp_set_shpf, &shp.frequency[AXIS_Z], SHAPER_Z_FREQUENCY },
+    { "shp","shpd", _fip, 3, mp_print_shpd, get_flt, mp_set_shpd, &shp.damping,           SHAPER_DAMPING },
+
+    // Conveyor tracking - see plan_track.h
+    { "trk","trke",_f0,  0, mp_print_trke, get_ui8, mp_set_trke, &trk.enable,        0 },
+    { "trk","trka",_fip, 0, mp_print_trka, get_ui8, mp_set_trka, &trk.axis,          TRACK_AXIS },
+    { "trk","trks",_fip, 5, mp_print_trks, get_flt, set_flt,     &trk.scale,         CONVEYOR_MM_PER_COUNT },
+    { "trk","trkv",_f0,  3, mp_print_trkv, get_flt, set_ro,      &trk.belt_velocity, 0 },
+    { "trk","trko",_f0,  3, mp_print_trko, get_flt, set_ro,      &trk.offset,        0 },
+
+    // Auxiliary motion channel - see plan_aux.h
+    { "aux","auxm",_fip, 0, mp_print_auxm, get_ui8,     mp_set_auxm, &aux.axes,            AUX_AXES },
+    { "aux","auxr",_f0,  0, mp_print_auxr, mp_get_auxr, set_ro,      &cs.null,            0 },
+    { "aux","auxx",_f0,  3, mp_print_aux,  mp_get_aux,  mp_set_aux,  &aux.offset[AXIS_X], 0 },
+    { "aux","auxy",_f0,  3, mp_print_aux,  mp_get_aux,  mp_set_aux,  &aux.offset[AXIS_Y], 0 },
+    { "aux","auxz",_f0,  3, mp_print_aux,  mp_get_aux,  mp_set_aux,  &aux.offset[AXIS_Z], 0 },
+    { "aux","auxa",_f0,  3, mp_print_aux,  mp_get_aux,  mp_set_aux,  &aux.offset[AXIS_A], 0 },
+    { "aux","auxb",_f0,  3, mp_print_aux,  mp_get_aux,  mp_set_aux,  &aux.offset[AXIS_B], 0 },
+    { "aux","auxc",_f0,  3, mp_print_aux,  mp_get_aux,  mp_set_aux,  &aux.offset[AXIS_C], 0 },
+
+    // RX line stats per serial device: rx0=USB0, rx1=USB1, rx2=UART. Set any to 0 to reset it
+    { "rx0","rx0b",_f0, 0, tx_print_int, get_int, set_int, &xio_rx_stats[DEV_USB0].bytes, 0 },          // bytes received
+    { "rx0","rx0l",_f0, 0, tx_print_int, get_int, set_int, &xio_rx_stats[DEV_USB0].lines, 0 },          // data lines dispatched
+    { "rx0","rx0d",_f0, 0, tx_print_int, get_int, set_int, &xio_rx_stats[DEV_USB0].dropped, 0 },        // lines cut short for length
+    { "rx0","rx0t",_f0, 0, tx_print_int, get_int, set_int, &xio_rx_stats[DEV_USB0].latency_max, 0 },    // most ms from line arrival to dispatch
+    { "rx0","rx0g",_f0, 0, tx_print_int, get_int, set_int, &xio_rx_stats[DEV_USB0].gap_max, 0 },        // most ms between lines arriving
+    { "rx1","rx1b",_f0, 0, tx_print_int, get_int, set_int, &xio_rx_stats[DEV_USB1].bytes, 0 },          // bytes received
+    { "rx1","rx1l",_f0, 0, tx_print_int, get_int, set_int, &xio_rx_stats[DEV_USB1].lines, 0 },          // data lines dispatched
+    { "rx1","rx1d",_f0, 0, tx_print_int, get_int, set_int, &xio_rx_stats[DEV_USB1].dropped, 0 },        // lines cut short for length
+    { "rx1","rx1t",_f0, 0, tx_print_int, get_int, set_int, &xio_rx_stats[DEV_USB1].latency_max, 0 },    // most ms from line arrival to dispatch
+    { "rx1","rx1g",_f0, 0, tx_print_int, get_int, set_int, &xio_rx_stats[DEV_USB1].gap_max, 0 },        // most ms between lines arriving
+    { "rx2","rx2b",_f0, 0, tx_print_int, get_int, set_int, &xio_rx_stats[DEV_UART1].bytes, 0 },         // bytes received
+    { "rx2","rx2l",_f0, 0, tx_print_int, get_int, set_int, &xio_rx_stats[DEV_UART1].lines, 0 },         // data lines dispatched
+    { "rx2","rx2d",_f0, 0, tx_print_int, get_int, set_int, &xio_rx_stats[DEV_UART1].dropped, 0 },       // lines cut short for length
+    { "rx2","rx2t",_f0, 0, tx_print_int, get_int, set_int, &xio_rx_stats[DEV_UART1].latency_max, 0 },   // most ms from line arrival to dispatch
+    { "rx2","rx2g",_f0, 0, tx_print_int, get_int, set_int, &xio_rx_stats[DEV_UART1].gap_max, 0 },       // most ms between lines arriving
 
 	// Power management
     { "sys","mt",  _fipn,2, st_print_mt,  get_flt, st_set_mt,  &st_cfg.motor_power_timeout,  MOTOR_POWER_TIMEOUT},
@@ -858,11 +867,21 @@ const cfgItem_t cfgArray[] = {
     { "sys","spdp",_fipn,0, cm_print_spdp,get_ui8, set_01,   &spindle.dir_polarity,        SPINDLE_DIR_POLARITY },
     { "sys","spph",_fipn,0, cm_print_spph,get_ui8, set_01,   &spindle.pause_on_hold,       SPINDLE_PAUSE_ON_HOLD },
     { "sys","spdw",_fipn,2, cm_print_spdw,get_flt, set_flt,  &spindle.dwell_seconds,       SPINDLE_DWELL_TIME },
+    { "sys","spat",_fipn,1, cm_print_spat,get_flt, set_flt,  &spindle.at_speed_timeout,    SPINDLE_AT_SPEED_TIMEOUT },
+    { "sys","splm",_fipn,0, cm_print_splm,get_ui8, set_01,   &spindle.laser_mode,          SPINDLE_LASER_MODE },
+    { "sys","spec",_fipn,1, mp_print_spec,get_flt,mp_set_spec,&syn.counts_per_rev,       SPINDLE_ENCODER_COUNTS },
     { "sys","ssoe",_fipn,0, cm_print_ssoe,get_ui8, set_01,   &spindle.sso_enable,          SPINDLE_OVERRIDE_ENABLE},
     { "sys","sso", _fipn,3, cm_print_sso, get_flt,cm_set_sso,&spindle.sso_factor,          SPINDLE_OVERRIDE_FACTOR},
     { "",   "spe", _f0,  0, cm_print_spe, get_ui8, set_nul,  &spindle.enable, 0 },         // get spindle enable
     { "",   "spd", _f0,  0, cm_print_spd, get_ui8,cm_set_dir,&spindle.direction, 0 },      // get spindle direction
     { "",   "sps", _f0,  0, cm_print_sps, get_flt, set_nul,  &spindle.speed, 0 },          // get spindle speed
+    { "",   "sprm",_f0,  1, mp_print_sprm,get_flt, set_ro,   &syn.rpm, 0 },               // measured spindle speed (see plan_sync.h)
+    { "sys","spvm",_fipn,0, spindle_vfd_print_spvm,get_ui8,spindle_vfd_set_enable, &vfd.enable, SPINDLE_VFD_ENABLE },
+    { "sys","spva",_fipn,0, spindle_vfd_print_spva,get_ui8,spindle_vfd_set_address,&vfd.address, SPINDLE_VFD_ADDRESS },
+    { "sys","spvk",_fipn,4, spindle_vfd_print_spvk,get_flt,spindle_vfd_set_rpm_per_count,&vfd.rpm_per_count, SPINDLE_VFD_RPM_PER_COUNT },
+    { "",   "spvs",_f0,  0, spindle_vfd_print_spvs,get_ui8,set_ro,   &vfd.status, 0 },        // VFD link status
+    { "",   "spvr",_f0,  0, spindle_vfd_print_spvr,get_flt,set_ro,   &vfd.rpm, 0 },           // speed read back from the VFD
+    { "",   "spve",_f0,  0, spindle_vfd_print_spve,get_int,set_ro,   &vfd.errors, 0 },        // failed VFD transactions
 
     // Coolant functions
     { "sys","cofp",_fipn,0, cm_print_cofp,get_ui8, set_01,   &coolant.flood_polarity,      COOLANT_FLOOD_POLARITY },
@@ -877,9 +896,13 @@ const cfgItem_t cfgArray[] = {
 #endif
     { "sys","ej", _fipn, 0, js_print_ej,  get_ui8, json_set_ej,&cs.comm_mode,              COMM_MODE },
     { "sys","jv", _fipn, 0, js_print_jv,  get_ui8, json_set_jv,&js.json_verbosity,         JSON_VERBOSITY },
-    { "sys","qv", _fipn, 0, qr_print_qv,  get_ui8, set_012,    &qr.queue_report_verbosity,  QR_OFF}, // default to OFF, set to QUEUE_REPORT_VERBOSITY after connected
+    { "sys","jf", _fipn, 0, js_print_jf,  get_ui8, json_set_jf,&js.json_footer_style,       JSON_FOOTER_STYLE },
+    { "sys","ja", _fipn, 0, js_print_ja,  get_ui8, json_set_ja,&js.json_ack_lines,          JSON_ACK_LINES },
+    { "sys","qv", _fipn, 0, qr_print_qv,  get_ui8, set_0123,   &qr.queue_report_verbosity,  QR_OFF}, // default to OFF, set to QUEUE_REPORT_VERBOSITY after connected
     { "sys","sv", _fipn, 0, sr_print_sv,  get_ui8, set_012,    &sr.status_report_verbosity, SR_OFF}, // default to OFF, set to STATUS_REPORT_VERBOSITY after connectied
     { "sys","si", _fipn, 0, sr_print_si,  get_int, sr_set_si,  &sr.status_report_interval, STATUS_REPORT_INTERVAL_MS },
+    { "sys","sad",_fipn, 0, sr_print_sad, get_ui8, set_01,     &sr.status_report_adaptive,  STATUS_REPORT_ADAPTIVE },
+    { "sys","sres",_fipnc,3,sr_print_sres,get_flt, set_flup,   &sr.status_report_resolution,STATUS_REPORT_RESOLUTION },
     { "", "nxln", _f0,   0, cm_print_nxln,cm_get_nxln,cm_set_nxln,&cs.null,                0 },
 
     // Gcode defaults
@@ -896,9 +919,40 @@ const cfgItem_t cfgArray[] = {
     { "", "qr",  _f0, 0, qr_print_qr,  qr_get,    set_ro,    &cs.null, 0 },    // get queue value - planner buffers available
     { "", "qi",  _f0, 0, qr_print_qi,  qi_get,    set_ro,    &cs.null, 0 },    // get queue value - buffers added to queue
     { "", "qo",  _f0, 0, qr_print_qo,  qo_get,    set_ro,    &cs.null, 0 },    // get queue value - buffers removed from queue
+    { "", "qt",  _f0, 0, qr_print_qt,  qt_get,    set_ro,    &cs.null, 0 },    // get queue value - ms of motion queued
+    { "", "qp",  _f0, 0, qr_print_qp,  qp_get,    set_ro,    &cs.null, 0 },    // get queue value - ms of motion not yet fully planned
+    { "", "qtb", _f0, 0, qr_print_qtb, get_int,   set_int,   &qr.time_first, 0 },   // first Gcode line timed for the queue report
+    { "", "qte", _f0, 0, qr_print_qte, get_int,   set_int,   &qr.time_last, 0 },    // last Gcode line timed
+    { "", "stvn",_f0, 0, tx_print_int, get_int,    set_ro,    &mp.starve_count, 0 },   // planner starved stops
+    { "", "stvl",_f0, 0, tx_print_int, get_int,    set_ro,    &mp.starve_line, 0 },    // line before the last starved stop
+    { "", "stvt",_f0, 3, tx_print_flt, get_flt,    set_ro,    &mp.starve_time, 0 },    // seconds since startup of the last starved stop
+    { "", "ppbn",_f0, 0, tx_print_int, get_int,    set_ro,    &mp.preplan_blocks, 0 }, // host preplanned blocks accepted
+    { "", "ppbr",_f0, 0, tx_print_int, get_int,    set_ro,    &mp.preplan_rejects, 0 },// host preplanned blocks planned here instead
+
+    // Job summary - see mp_job_start(). Times in seconds, feeds in current units per minute
+    { "jsm","jsme",_fip, 0, tx_print_int, get_ui8, set_01, &sr.job_summary_report, JOB_SUMMARY_REPORT },
+    { "jsm","jsmw",_f0,  3, tx_print_flt, get_flt, set_ro, &mp.job.wall_time, 0 },         // wall time
+    { "jsm","jsmm",_f0,  3, tx_print_flt, get_flt, set_ro, &mp.job.motion_time, 0 },       // time in motion
+    { "jsm","jsmc",_f0,  3, tx_print_flt, get_flt, set_ro, &mp.job.commanded_time, 0 },    // time at commanded feed
+    { "jsm","jsms",_f0,  3, tx_print_flt, get_flt, set_ro, &mp.job.starved_time, 0 },      // time starved
+    { "jsm","jsml",_fc,  3, tx_print_flt, get_flt, set_ro, &mp.job.length, 0 },            // distance run
+    { "jsm","jsmf",_fc,  2, tx_print_flt, get_flt, set_ro, &mp.job.average_feed, 0 },      // average feed achieved
+    { "jsm","jsmg",_fc,  2, tx_print_flt, get_flt, set_ro, &mp.job.average_commanded, 0 }, // average feed commanded
+    { "jsm","jsmp",_fc,  2, tx_print_flt, get_flt, set_ro, &mp.job.peak_feed, 0 },         // peak feed achieved
+    { "jsm","jsmq",_fc,  2, tx_print_flt, get_flt, set_ro, &mp.job.peak_commanded, 0 },    // peak feed commanded
+    { "jsm","jsmh",_f0,  0, tx_print_int, get_int, set_ro, &mp.job.holds, 0 },             // feedholds
+    { "jsm","jsmb",_f0,  0, tx_print_int, get_int, set_ro, &mp.job.blocks, 0 },            // blocks run
+    { "jsm","jsmn",_f0,  0, tx_print_int, get_int, set_ro, &mp.job.segments, 0 },          // segments run
     { "", "er",  _f0, 0, tx_print_nul, rpt_er,    set_nul,   &cs.null, 0 },    // get bogus exception report for testing
     { "", "qf",  _f0, 0, tx_print_nul, get_nul,   cm_run_qf, &cs.null, 0 },    // SET to invoke queue flush
+    { "", "batch",_f0,0, tx_print_int, json_get_batch, json_set_batch, &cs.null, 0 }, // config batch: 1=begin, 2=commit, 0=abort
     { "", "rx",  _f0, 0, tx_print_int, get_rx,    set_ro,    &cs.null, 0 },    // get RX buffer bytes or packets
+    { "", "txhw",_f0, 0, tx_print_int, get_ui8,   set_ui8,   &xio_tx.high_water, 0 },  // TX chain high-water mark. Set 0 to reset
+    { "", "txdr",_f0, 0, tx_print_int, get_int,   set_int,   &xio_tx.dropped, 0 },     // TX bytes dropped. Set 0 to reset
+    { "", "spu", _f0, 0, tx_print_int, xio_get_spu, xio_set_spu, &cs.null, 0 },      // spool upload: 1=store data lines, 0=end
+    { "", "sps", _f0, 0, tx_print_int, xio_get_sps, xio_set_sps, &cs.null, 0 },      // spooled job: 1=run, 0=stop
+    { "", "spl", _f0, 0, tx_print_int, xio_get_spl, set_ro,      &cs.null, 0 },      // bytes in the spooled job
+    { "", "rpx", _f0, 0, tx_print_int, cm_get_rpx, cm_set_rpx, &cs.null, 0 },      // stage raster pixels (base64) for the next G1
     { "", "msg", _f0, 0, tx_print_str, get_nul,   set_nul,   &cs.null, 0 },    // string for generic messages
     { "", "alarm",_f0,0, tx_print_nul, cm_alrm,   cm_alrm,   &cs.null, 0 },    // trigger alarm
     { "", "panic",_f0,0, tx_print_nul, cm_pnic,   cm_pnic,   &cs.null, 0 },    // trigger panic
@@ -909,6 +963,7 @@ const cfgItem_t cfgArray[] = {
     { "", "tram", _f0,0, cm_print_tram, cm_get_tram, cm_set_tram, &cs.null, 0 },// SET to attempt setting rotation matrix from probes
     { "", "defa",_f0, 0, tx_print_nul, help_defa, set_defaults,&cs.null,0 },   // set/print defaults / help screen
     { "", "flash",_f0,0, tx_print_nul, help_flash,hw_flash,  &cs.null,0 },
+    { "", "pf",  _f0, 0, tx_print_int, get_profile, set_profile,&cs.null,0 }, // stored profile: set 0-N to switch between jobs
 
 #ifdef __HELP_SCREENS
     { "", "help",_f0, 0, tx_print_nul, help_config, set_nul, &cs.null,0 }, // prints config help screen
@@ -942,6 +997,12 @@ const cfgItem_t cfgArray[] = {
 #ifdef __DIAGNOSTIC_PARAMETERS
     { "",    "clc",_f0, 0, tx_print_nul, st_clc,  st_clc, &cs.null, 0 },  // clear diagnostic step counters
     { "",   "_dam",_f0, 0, tx_print_nul, cm_dam,  cm_dam, &cs.null, 0 },  // dump active model
+    { "",   "_pur",_f0, 0, tx_print_int, get_int, set_nul,&st_pre.underruns, 0 },    // prep ring underruns (DDA starved)
+    { "",   "_purl",_f0,0, tx_print_int, get_int, set_nul,&st_pre.type_underruns[BLOCK_TYPE_ALINE], 0 }, // ...running an aline
+    { "",   "_purs",_f0,0, tx_print_int, get_int, set_nul,&st_pre.type_underruns[BLOCK_TYPE_SYNC], 0 },  // ...running a G33/G33.1
+    { "",   "_purn",_f0,0, tx_print_int, get_int, set_nul,&st_pre.type_underruns[BLOCK_TYPE_NULL], 0 },  // ...running no block
+    { "",   "_sgs",_f0, 2, tx_print_flt, get_flt, set_nul,&mr.segment_stretch, 0 },  // segment stretch in effect
+    { "",   "_src",_f0, 0, tx_print_int, get_int, set_nul,&mp.step_rate_clamps, 0 }, // blocks slowed by the DDA step rate
 
     { "_te","_tex",_f0, 2, tx_print_flt, get_flt, set_nul,&mr.target[AXIS_X], 0 }, // X target endpoint
     { "_te","_tey",_f0, 2, tx_print_flt, get_flt, set_nul,&mr.target[AXIS_Y], 0 },
@@ -964,6 +1025,8 @@ const cfgItem_t cfgArray[] = {
     { "_es","_es1",_f0, 2, tx_print_flt, get_flt, set_nul,&mr.encoder_steps[MOTOR_1], 0 },     // Motor 1 encoder steps
     { "_xs","_xs1",_f0, 2, tx_print_flt, get_flt, set_nul,&st_pre.mot[MOTOR_1].corrected_steps, 0 }, // Motor 1 correction steps applied
     { "_fe","_fe1",_f0, 2, tx_print_flt, get_flt, set_nul,&mr.following_error[MOTOR_1], 0 },   // Motor 1 following error in steps
+    { "_ff","_ff1",_f0, 2, tx_print_flt, get_flt, set_nul,&st_pre.mot[MOTOR_1].ff_lead, 0 },       // Motor 1 feedforward lead in steps
+    { "_fp","_fp1",_f0, 2, tx_print_flt, get_flt, set_nul,&st_pre.mot[MOTOR_1].ff_lead_max, 0 },   // Motor 1 peak feedforward lead
 #endif
 #if (MOTORS >= 2)
     { "_ts","_ts2",_f0, 2, tx_print_flt, get_flt, set_nul,&mr.target_steps[MOTOR_2], 0 },
@@ -972,6 +1035,8 @@ const cfgItem_t cfgArray[] = {
     { "_es","_es2",_f0, 2, tx_print_flt, get_flt, set_nul,&mr.encoder_steps[MOTOR_2], 0 },
     { "_xs","_xs2",_f0, 2, tx_print_flt, get_flt, set_nul,&st_pre.mot[MOTOR_2].corrected_steps, 0 },
     { "_fe","_fe2",_f0, 2, tx_print_flt, get_flt, set_nul,&mr.following_error[MOTOR_2], 0 },
+    { "_ff","_ff2",_f0, 2, tx_print_flt, get_flt, set_nul,&st_pre.mot[MOTOR_2].ff_lead, 0 },
+    { "_fp","_fp2",_f0, 2, tx_print_flt, get_flt, set_nul,&st_pre.mot[MOTOR_2].ff_lead_max, 0 },
 #endif
 #if (MOTORS >= 3)
     { "_ts","_ts3",_f0, 2, tx_print_flt, get_flt, set_nul,&mr.target_steps[MOTOR_3], 0 },
@@ -980,6 +1045,8 @@ const cfgItem_t cfgArray[] = {
     { "_es","_es3",_f0, 2, tx_print_flt, get_flt, set_nul,&mr.encoder_steps[MOTOR_3], 0 },
     { "_xs","_xs3",_f0, 2, tx_print_flt, get_flt, set_nul,&st_pre.mot[MOTOR_3].corrected_steps, 0 },
     { "_fe","_fe3",_f0, 2, tx_print_flt, get_flt, set_nul,&mr.following_error[MOTOR_3], 0 },
+    { "_ff","_ff3",_f0, 2, tx_print_flt, get_flt, set_nul,&st_pre.mot[MOTOR_3].ff_lead, 0 },
+    { "_fp","_fp3",_f0, 2, tx_print_flt, get_flt, set_nul,&st_pre.mot[MOTOR_3].ff_lead_max, 0 },
 #endif
 #if (MOTORS >= 4)
     { "_ts","_ts4",_f0, 2, tx_print_flt, get_flt, set_nul,&mr.target_steps[MOTOR_4], 0 },
@@ -988,6 +1055,8 @@ const cfgItem_t cfgArray[] = {
     { "_es","_es4",_f0, 2, tx_print_flt, get_flt, set_nul,&mr.encoder_steps[MOTOR_4], 0 },
     { "_xs","_xs4",_f0, 2, tx_print_flt, get_flt, set_nul,&st_pre.mot[MOTOR_4].corrected_steps, 0 },
     { "_fe","_fe4",_f0, 2, tx_print_flt, get_flt, set_nul,&mr.following_error[MOTOR_4], 0 },
+    { "_ff","_ff4",_f0, 2, tx_print_flt, get_flt, set_nul,&st_pre.mot[MOTOR_4].ff_lead, 0 },
+    { "_fp","_fp4",_f0, 2, tx_print_flt, get_flt, set_nul,&st_pre.mot[MOTOR_4].ff_lead_max, 0 },
 #endif
 #if (MOTORS >= 5)
     { "_ts","_ts5",_f0, 2, tx_print_flt, get_flt, set_nul,&mr.target_steps[MOTOR_5], 0 },
@@ -996,6 +1065,8 @@ const cfgItem_t cfgArray[] = {
     { "_es","_es5",_f0, 2, tx_print_flt, get_flt, set_nul,&mr.encoder_steps[MOTOR_5], 0 },
     { "_xs","_xs6",_f0, 2, tx_print_flt, get_flt, set_nul,&st_pre.mot[MOTOR_5].corrected_steps, 0 },
     { "_fe","_fe5",_f0, 2, tx_print_flt, get_flt, set_nul,&mr.following_error[MOTOR_5], 0 },
+    { "_ff","_ff5",_f0, 2, tx_print_flt, get_flt, set_nul,&st_pre.mot[MOTOR_5].ff_lead, 0 },
+    { "_fp","_fp5",_f0, 2, tx_print_flt, get_flt, set_nul,&st_pre.mot[MOTOR_5].ff_lead_max, 0 },
 #endif
 #if (MOTORS >= 6)
     { "_ts","_ts6",_f0, 2, tx_print_flt, get_flt, set_nul,&mr.target_steps[MOTOR_6], 0 },
@@ -1004,9 +1075,159 @@ const cfgItem_t cfgArray[] = {
     { "_es","_es6",_f0, 2, tx_print_flt, get_flt, set_nul,&mr.encoder_steps[MOTOR_6], 0 },
     { "_xs","_xs5",_f0, 2, tx_print_flt, get_flt, set_nul,&st_pre.mot[MOTOR_6].corrected_steps, 0 },
     { "_fe","_fe6",_f0, 2, tx_print_flt, get_flt, set_nul,&mr.following_error[MOTOR_6], 0 },
+    { "_ff","_ff6",_f0, 2, tx_print_flt, get_flt, set_nul,&st_pre.mot[MOTOR_6].ff_lead, 0 },
+    { "_fp","_fp6",_f0, 2, tx_print_flt, get_flt, set_nul,&st_pre.mot[MOTOR_6].ff_lead_max, 0 },
 #endif
 #endif  //  __DIAGNOSTIC_PARAMETERS
 
+    // Segment synchronous runtime samples - see telemetry.h
+    { "tlm","tlme",_f0, 0, tlm_print_tlme, get_ui8, tlm_set_tlme, &tlm.enable, 0 },     // enable and clear telemetry
+    { "tlm","tlmd",_f0, 0, tlm_print_tlmd, get_ui8, tlm_set_tlmd, &tlm.decimation, 1 }, // sample every Nth segment
+    { "tlm","tlmn",_f0, 0, tlm_print_tlmn, get_int, set_ro,       &tlm.samples, 0 },    // samples taken
+    { "tlm","tlmo",_f0, 0, tlm_print_tlmo, get_int, set_ro,       &tlm.dropped, 0 },    // samples dropped
+
+    // Segment synchronous motion across boards - see motion_link.h
+    { "mln","mlnm",_fip, 0, mln_print_mlnm, get_ui8, mln_set_mlnm, &mln.mode, MOTION_LINK_MODE }, // off, leader or follower
+    { "mln","mlnn",_f0,  0, mln_print_mlnn, get_int, set_ro,       &mln.frames, 0 },    // frames sent or taken
+    { "mln","mlne",_f0,  0, mln_print_mlne, get_int, set_ro,       &mln.errors, 0 },    // sync errors
+
+    // Motion checkpoints to resume a job - see checkpoint.h
+    { "ckpt","ckpte",_fip, 0, ckpt_print_ckpte, get_ui8, set_01, &ckpt.enable, CHECKPOINT_ENABLE },  // take checkpoints
+    { "ckpt","ckptl",_f0,  0, ckpt_print_ckptl, get_int, set_ro, &ckpt.linenum, 0 },     // line to resume from, 0 = none
+    { "ckpt","ckptr",_f0,  0, ckpt_print_ckptr, ckpt_get_ckptr, ckpt_set_ckptr, &cs.null, 0 },  // SET 1 to resume, returns the line
+    { "ckpt","ckptn",_f0,  0, ckpt_print_ckptn, get_int, set_ro, &ckpt.written, 0 },     // checkpoints written
+
+    // Memory budget - see controller_get_mem(). All in bytes
+    { "mem","mems",_f0, 0, tx_print_int, controller_get_mem, set_ro, &cs.mem.stack_size, 0 },     // stack reserved
+    { "mem","memu",_f0, 0, tx_print_int, controller_get_mem, set_ro, &cs.mem.stack_used, 0 },     // stack high-water mark
+    { "mem","memb",_f0, 0, tx_print_int, controller_get_mem, set_ro, &cs.mem.planner, 0 },        // planner buffer pool
+    { "mem","memp",_f0, 0, tx_print_int, controller_get_mem, set_ro, &cs.mem.planner_buffer, 0 }, // one planner buffer
+    { "mem","memn",_f0, 0, tx_print_int, controller_get_mem, set_ro, &cs.mem.nv_list, 0 },        // nvObj list
+    { "mem","memx",_f0, 0, tx_print_int, controller_get_mem, set_ro, &cs.mem.xio, 0 },            // xio devices and buffers
+    { "mem","mema",_f0, 0, tx_print_int, controller_get_mem, set_ro, &cs.mem.arc, 0 },            // arc singleton
+    { "mem","memh",_f0, 0, tx_print_int, controller_get_mem, set_ro, &cs.mem.heap_used, 0 },      // heap in use
+    { "mem","memf",_f0, 0, tx_print_int, controller_get_mem, set_ro, &cs.mem.heap_free, 0 },      // heap free
+
+    // Planner trace
+    { "trc","trce",_f0, 0, trc_print_trce, get_ui8, set_01,       &trc.enable, 1 },     // record blocks as they start
+    { "trc","trcd",_f0, 0, tx_print_nul,   get_ui8, trc_set_trcd, &trc.dump, 0 },       // dump the trace
+    { "trc","trcn",_f0, 0, trc_print_trcn, get_int, set_ro,       (uint32_t *)&trc.count, 0 }, // blocks recorded
+
+#if STEP_CAPTURE_ENABLED == true
+    // Step capture - see step_capture.h
+    { "stc","stca",_f0, 0, stc_print_stca, get_ui8, stc_set_stca, (uint8_t *)&stc.state, 0 },   // arm a capture
+    { "stc","stcd",_f0, 0, tx_print_nul,   get_ui8, stc_set_stcd, &stc.dump, 0 },               // dump the capture
+    { "stc","stcn",_f0, 0, stc_print_stcn, get_int, set_ro,       (uint32_t *)&stc.edges, 0 },  // edges captured
+    { "stc","stcj",_f0, 3, stc_print_stcj, get_flt, set_ro,       &stc.jitter, 0 },             // edge jitter (us)
+#endif
+
+#if RX_CAPTURE_ENABLED == true
+    // RX capture and replay - see rx_capture.h
+    { "rxc","rxca",_f0, 0, rxc_print_rxca, get_ui8, rxc_set_rxca, &rxc.state, 0 },     // start a capture
+    { "rxc","rxcr",_f0, 0, rxc_print_rxcr, get_ui8, rxc_set_rxcr, &rxc.replay, 0 },    // replay the capture
+    { "rxc","rxcd",_f0, 0, tx_print_nul,   get_ui8, rxc_set_rxcd, &rxc.dump, 0 },      // dump the capture
+    { "rxc","rxcn",_f0, 0, rxc_print_rxcn, get_int, set_ro,       &rxc.bytes, 0 },     // bytes captured
+#endif
+
+#ifdef __PROFILE
+    // Cycle counter profiling of the stepper interrupt chain - see profile.h
+    { "prof","profe",_f0, 0, tx_print_int, get_ui8, prof_set_pfe, &prof.enable, 0 },  // enable and clear profiling
+    { "prof","profo",_f0, 0, tx_print_int, get_ui8, set_ro, &prof.hot_paths, 0 },    // 1 = FAST_HOT_PATHS, 2 = FAST_HOT_DATA build
+    { "prof","profdn",_f0, 0, tx_print_int, get_int,      set_ro, &prof.site[PROF_DDA].count, 0 },  // DDA interrupt count
+    { "prof","profdl",_f0, 0, tx_print_int, prof_get_pfl, set_ro, &prof.site[PROF_DDA], 0 },        // DDA interrupt min cycles
+    { "prof","profdh",_f0, 0, tx_print_int, get_int,      set_ro, &prof.site[PROF_DDA].max, 0 },    // DDA interrupt max cycles
+    { "prof","profda",_f0, 1, tx_print_flt, prof_get_pfa, set_ro, &prof.site[PROF_DDA], 0 },        // DDA interrupt mean cycles
+    { "prof","profdu",_f0, 1, tx_print_flt, prof_get_pfu, set_ro, &prof.site[PROF_DDA], 0 },        // DDA interrupt max as % of budget
+    { "prof","profdb",_f0, 0, tx_print_int, get_int,      set_ro, &prof.site[PROF_DDA].budget, 0 }, // DDA interrupt budget cycles
+    { "prof","profxn",_f0, 0, tx_print_int, get_int,      set_ro, &prof.site[PROF_EXEC].count, 0 },  // exec interrupt count
+    { "prof","profxl",_f0, 0, tx_print_int, prof_get_pfl, set_ro, &prof.site[PROF_EXEC], 0 },        // exec interrupt min cycles
+    { "prof","profxh",_f0, 0, tx_print_int, get_int,      set_ro, &prof.site[PROF_EXEC].max, 0 },    // exec interrupt max cycles
+    { "prof","profxa",_f0, 1, tx_print_flt, prof_get_pfa, set_ro, &prof.site[PROF_EXEC], 0 },        // exec interrupt mean cycles
+    { "prof","profxu",_f0, 1, tx_print_flt, prof_get_pfu, set_ro, &prof.site[PROF_EXEC], 0 },        // exec interrupt max as % of budget
+    { "prof","profxb",_f0, 0, tx_print_int, get_int,      set_ro, &prof.site[PROF_EXEC].budget, 0 }, // exec interrupt budget cycles
+    { "prof","profln",_f0, 0, tx_print_int, get_int,      set_ro, &prof.site[PROF_LOAD].count, 0 },  // _load_move() count
+    { "prof","profll",_f0, 0, tx_print_int, prof_get_pfl, set_ro, &prof.site[PROF_LOAD], 0 },        // _load_move() min cycles
+    { "prof","proflh",_f0, 0, tx_print_int, get_int,      set_ro, &prof.site[PROF_LOAD].max, 0 },    // _load_move() max cycles
+    { "prof","profla",_f0, 1, tx_print_flt, prof_get_pfa, set_ro, &prof.site[PROF_LOAD], 0 },        // _load_move() mean cycles
+    { "prof","proflu",_f0, 1, tx_print_flt, prof_get_pfu, set_ro, &prof.site[PROF_LOAD], 0 },        // _load_move() max as % of budget
+    { "prof","proflb",_f0, 0, tx_print_int, get_int,      set_ro, &prof.site[PROF_LOAD].budget, 0 }, // _load_move() budget cycles
+    { "prof","profpn",_f0, 0, tx_print_int, get_int,      set_ro, &prof.site[PROF_PREP].count, 0 },  // st_prep_line() count
+    { "prof","profpl",_f0, 0, tx_print_int, prof_get_pfl, set_ro, &prof.site[PROF_PREP], 0 },        // st_prep_line() min cycles
+    { "prof","profph",_f0, 0, tx_print_int, get_int,      set_ro, &prof.site[PROF_PREP].max, 0 },    // st_prep_line() max cycles
+    { "prof","profpa",_f0, 1, tx_print_flt, prof_get_pfa, set_ro, &prof.site[PROF_PREP], 0 },        // st_prep_line() mean cycles
+    { "prof","profpu",_f0, 1, tx_print_flt, prof_get_pfu, set_ro, &prof.site[PROF_PREP], 0 },        // st_prep_line() max as % of budget
+    { "prof","profpb",_f0, 0, tx_print_int, get_int,      set_ro, &prof.site[PROF_PREP].budget, 0 }, // st_prep_line() budget cycles
+    { "prof","profmn",_f0, 0, tx_print_int, get_int,      set_ro, &prof.site[PROF_HSM].count, 0 },  // controller pass count
+    { "prof","profml",_f0, 0, tx_print_int, prof_get_pfl, set_ro, &prof.site[PROF_HSM], 0 },        // controller pass min cycles
+    { "prof","profmh",_f0, 0, tx_print_int, get_int,      set_ro, &prof.site[PROF_HSM].max, 0 },    // controller pass max cycles
+    { "prof","profma",_f0, 1, tx_print_flt, prof_get_pfa, set_ro, &prof.site[PROF_HSM], 0 },        // controller pass mean cycles
+    { "prof","profmu",_f0, 1, tx_print_flt, prof_get_pfu, set_ro, &prof.site[PROF_HSM], 0 },        // controller pass max as % of budget
+    { "prof","profmb",_f0, 0, tx_print_int, get_int,      set_ro, &prof.site[PROF_HSM].budget, 0 }, // controller pass budget cycles
+
+    { "pfhd","pfhd0",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_DDA].bin[0], 0 },  // DDA interrupt histogram
+    { "pfhd","pfhd1",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_DDA].bin[1], 0 },
+    { "pfhd","pfhd2",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_DDA].bin[2], 0 },
+    { "pfhd","pfhd3",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_DDA].bin[3], 0 },
+    { "pfhd","pfhd4",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_DDA].bin[4], 0 },
+    { "pfhd","pfhd5",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_DDA].bin[5], 0 },
+    { "pfhd","pfhd6",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_DDA].bin[6], 0 },
+    { "pfhd","pfhd7",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_DDA].bin[7], 0 },
+
+    { "pfhx","pfhx0",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_EXEC].bin[0], 0 },  // exec interrupt histogram
+    { "pfhx","pfhx1",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_EXEC].bin[1], 0 },
+    { "pfhx","pfhx2",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_EXEC].bin[2], 0 },
+    { "pfhx","pfhx3",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_EXEC].bin[3], 0 },
+    { "pfhx","pfhx4",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_EXEC].bin[4], 0 },
+    { "pfhx","pfhx5",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_EXEC].bin[5], 0 },
+    { "pfhx","pfhx6",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_EXEC].bin[6], 0 },
+    { "pfhx","pfhx7",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_EXEC].bin[7], 0 },
+
+    { "pfhl","pfhl0",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_LOAD].bin[0], 0 },  // _load_move() histogram
+    { "pfhl","pfhl1",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_LOAD].bin[1], 0 },
+    { "pfhl","pfhl2",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_LOAD].bin[2], 0 },
+    { "pfhl","pfhl3",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_LOAD].bin[3], 0 },
+    { "pfhl","pfhl4",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_LOAD].bin[4], 0 },
+    { "pfhl","pfhl5",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_LOAD].bin[5], 0 },
+    { "pfhl","pfhl6",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_LOAD].bin[6], 0 },
+    { "pfhl","pfhl7",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_LOAD].bin[7], 0 },
+
+    { "pfhp","pfhp0",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_PREP].bin[0], 0 },  // st_prep_line() histogram
+    { "pfhp","pfhp1",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_PREP].bin[1], 0 },
+    { "pfhp","pfhp2",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_PREP].bin[2], 0 },
+    { "pfhp","pfhp3",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_PREP].bin[3], 0 },
+    { "pfhp","pfhp4",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_PREP].bin[4], 0 },
+    { "pfhp","pfhp5",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_PREP].bin[5], 0 },
+    { "pfhp","pfhp6",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_PREP].bin[6], 0 },
+    { "pfhp","pfhp7",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_PREP].bin[7], 0 },
+
+    { "pfhm","pfhm0",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_HSM].bin[0], 0 },  // controller pass histogram
+    { "pfhm","pfhm1",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_HSM].bin[1], 0 },
+    { "pfhm","pfhm2",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_HSM].bin[2], 0 },
+    { "pfhm","pfhm3",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_HSM].bin[3], 0 },
+    { "pfhm","pfhm4",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_HSM].bin[4], 0 },
+    { "pfhm","pfhm5",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_HSM].bin[5], 0 },
+    { "pfhm","pfhm6",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_HSM].bin[6], 0 },
+    { "pfhm","pfhm7",_f0, 0, tx_print_int, get_int, set_ro, &prof.site[PROF_HSM].bin[7], 0 },
+
+    { "hsm","hsms",_f0, 0, tx_print_int, get_ui8,      prof_set_hss, &prof.task_select, 0 },  // select a controller task by table order
+    { "hsm","hsmn",_f0, 0, tx_print_int, prof_get_hsn, set_ro, &cs.null, 0 },   // selected task call count
+    { "hsm","hsmh",_f0, 0, tx_print_int, prof_get_hsh, set_ro, &cs.null, 0 },   // selected task max cycles
+    { "hsm","hsma",_f0, 1, tx_print_flt, prof_get_hsa, set_ro, &cs.null, 0 },   // selected task mean cycles
+    { "hsm","hsmw",_f0, 0, tx_print_int, prof_get_hsw, set_ro, &cs.null, 0 },   // task with the longest single call
+#endif  // __PROFILE
+
+    // Dry runs and the benchmark - see bench.h
+    { "bch","bchd",_f0, 0, tx_print_int, get_ui8, bench_set_bchd, (uint8_t *)&bench.dry_run, 0 },  // 1 = dry run what follows
+    { "bch","bchc",_f0, 3, tx_print_flt, bench_get_bchc, set_ro, &cs.null, 0 },            // dry run cycle time (s)
+#if BENCH_ENABLED == true
+    { "",   "bench",_f0, 0, tx_print_nul, bench_get_bench, bench_set_bench, &cs.null, 0 },   // dry run the named program
+    { "bch","bchs",_f0, 0, tx_print_int, get_ui8, set_ro, &bench.running, 0 },  // 1 while running
+    { "bch","bchl",_f0, 1, tx_print_flt, get_flt, set_ro, &bench.lines_per_sec, 0 },       // lines read per second
+    { "bch","bchb",_f0, 1, tx_print_flt, get_flt, set_ro, &bench.blocks_per_sec, 0 },      // blocks run per second
+    { "bch","bchn",_f0, 1, tx_print_flt, get_flt, set_ro, &bench.segments_per_sec, 0 },    // segments run per second
+    { "bch","bcht",_f0, 3, tx_print_flt, get_flt, set_ro, &bench.seconds, 0 },             // seconds to run
+#endif
+
     // Persistence for status report - must be in sequence
     // *** Count must agree with NV_STATUS_REPORT_LEN in report.h ***
     { "","se00",_fp, 0, tx_print_nul, get_int, set_int,&sr.status_report_list[0],0 },
@@ -1058,6 +1279,7 @@ const cfgItem_t cfgArray[] = {
     //      - Optional motors (5 and 6)
     //      - Optional USER_DATA
     //      - Optional DIAGNOSTIC_PARAMETERS
+    //      - Optional PROFILE
     //      - Uber groups (count these separately)
 
     { "","sys",_f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },    // system group
@@ -1151,6 +1373,44 @@ const cfgItem_t cfgArray[] = {
     { "","pid2",_f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },   // PID 2 group
     { "","pid3",_f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },   // PID 3 group
     // +6 = 76
+    { "","coal",_f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },   // short segment coalescing group
+    { "","look",_f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },   // streaming lookahead group
+    // +2 = 78
+    { "","rx0", _f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },   // USB0 RX line stats group
+    { "","rx1", _f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },   // USB1 RX line stats group
+    { "","rx2", _f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },   // UART RX line stats group
+    // +3 = 81
+    { "","tlm", _f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },   // telemetry group
+    // +1 = 82
+    { "","jsm", _f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },   // job summary group
+    { "","bch", _f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },   // dry run and benchmark group
+    // +1 = 83
+    { "","trc", _f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },   // planner trace group
+    // +1 = 84
+    { "","mem", _f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },   // memory budget group
+    // +1 = 85
+    { "","scn", _f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },   // scan probing group
+    // +1 = 86
+    { "","jv",  _f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },   // velocity jog group
+    // +1 = 87
+    { "","ckpt",_f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },   // motion checkpoint group
+    // +1 = 88
+    { "","shp", _f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },   // input shaping group
+    // +1 = 89
+    { "","mln", _f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },   // motion link group
+    // +1 = 90
+    { "","trk", _f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },   // conveyor tracking group
+    { "","aux", _f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },   // auxiliary motion channel group
+    // +1 = 91
+#if HEIGHT_MAP_ENABLED == true
+    { "","hmp", _f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },   // height map group
+#endif
+#if STEP_CAPTURE_ENABLED == true
+    { "","stc", _f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },   // step capture group
+#endif
+#if RX_CAPTURE_ENABLED == true
+    { "","rxc", _f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },   // RX capture group
+#endif
 
 #ifdef __USER_DATA
     { "","uda", _f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },  // user data group
@@ -1167,6 +1427,17 @@ const cfgItem_t cfgArray[] = {
     { "","_es",_f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },  // encoder steps group
     { "","_xs",_f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },  // correction steps group
     { "","_fe",_f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },  // following error group
+    { "","_ff",_f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },  // feedforward lead group
+    { "","_fp",_f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },  // peak feedforward lead group
+#endif
+#ifdef __PROFILE
+    { "","prof",_f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },  // profiling summary group
+    { "","pfhd",_f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },  // DDA interrupt histogram group
+    { "","pfhx",_f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },  // exec interrupt histogram group
+    { "","pfhl",_f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },  // load histogram group
+    { "","pfhp",_f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },  // prep histogram group
+    { "","pfhm",_f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },  // controller pass histogram group
+    { "","hsm", _f0, 0, tx_print_nul, get_grp, set_grp,&cs.null,0 },  // controller task group
 #endif
 
     // Uber-group (groups of groups, for text-mode displays only)
@@ -1182,7 +1453,7 @@ const cfgItem_t cfgArray[] = {
 /***** Make sure these defines line up with any changes in the above table *****/
 
 #define NV_COUNT_UBER_GROUPS    6     // count of uber-groups, above
-#define FIXED_GROUPS            92    // count of fixed groups, excluding optional groups
+#define FIXED_GROUPS            109    // count of fixed groups, excluding optional groups
 
 #if (MOTORS >= 5)
 #define MOTOR_GROUP_5           1
@@ -1203,13 +1474,37 @@ const cfgItem_t cfgArray[] = {
 #endif
 
 #ifdef __DIAGNOSTIC_PARAMETERS
-#define DIAGNOSTIC_GROUPS       8    // count of diagnostic groups only
+#define DIAGNOSTIC_GROUPS       10   // count of diagnostic groups only
 #else
 #define DIAGNOSTIC_GROUPS       0
 #endif
 
+#ifdef __PROFILE
+#define PROFILE_GROUPS          7    // count of profiling groups only
+#else
+#define PROFILE_GROUPS          0
+#endif
+
+#if HEIGHT_MAP_ENABLED == true
+#define HEIGHT_MAP_GROUPS       1
+#else
+#define HEIGHT_MAP_GROUPS       0
+#endif
+
+#if STEP_CAPTURE_ENABLED == true
+#define STEP_CAPTURE_GROUPS     1
+#else
+#define STEP_CAPTURE_GROUPS     0
+#endif
+
+#if RX_CAPTURE_ENABLED == true
+#define RX_CAPTURE_GROUPS       1
+#else
+#define RX_CAPTURE_GROUPS       0
+#endif
+
 #define TEMPERATURE_GROUPS      6
-#define NV_COUNT_GROUPS (FIXED_GROUPS + MOTOR_GROUP_5 + MOTOR_GROUP_6 + USER_DATA_GROUPS + DIAGNOSTIC_GROUPS + TEMPERATURE_GROUPS)
+#define NV_COUNT_GROUPS (FIXED_GROUPS + MOTOR_GROUP_5 + MOTOR_GROUP_6 + USER_DATA_GROUPS + DIAGNOSTIC_GROUPS + PROFILE_GROUPS + TEMPERATURE_GROUPS + HEIGHT_MAP_GROUPS + STEP_CAPTURE_GROUPS + RX_CAPTURE_GROUPS)
 
 /* <DO NOT MESS WITH THESE DEFINES> */
 #define NV_INDEX_MAX (sizeof(cfgArray) / sizeof(cfgItem_t))
@@ -1218,11 +1513,58 @@ const cfgItem_t cfgArray[] = {
 #define NV_INDEX_START_UBER_GROUPS (NV_INDEX_MAX - NV_COUNT_UBER_GROUPS)
 /* </DO NOT MESS WITH THESE DEFINES> */
 
+#if NV_INDEX_HASH_SIZE > 0
+static_assert((NV_INDEX_MAX * 4) < (NV_INDEX_HASH_SIZE * 3), "NV_INDEX_HASH_SIZE is too small for cfgArray");
+#endif
+
 index_t nv_index_max() { return ( NV_INDEX_MAX );}
 bool nv_index_is_single(index_t index) { return ((index <= NV_INDEX_END_SINGLES) ? true : false);}
 bool nv_index_is_group(index_t index) { return (((index >= NV_INDEX_START_GROUPS) && (index < NV_INDEX_START_UBER_GROUPS)) ? true : false);}
 bool nv_index_lt_groups(index_t index) { return ((index <= NV_INDEX_START_GROUPS) ? true : false);}
 
+/***** CONFIG SNAPSHOT ************************************************************
+ * The derived runtime state config_init() restores in one block instead of running
+ * the setters of every row that writes into it. See config_init().
+ *
+ * config_snapshot_covers() - true if the row's target is part of the snapshot
+ * config_snapshot_load()   - restore the snapshot taken from this profile. False if none
+ * config_snapshot_save()   - save the snapshot for this profile
+ */
+
+typedef struct cfgSnapshot {
+    stConfig_t st;                              // st_cfg
+    cfgAxis_t a[AXES];                          // cm.a[]
+} cfgSnapshot_t;
+
+bool config_snapshot_covers(index_t index)
+{
+    const uint8_t *target = (const uint8_t *)cfgArray[index].target;
+    return (((target >= (const uint8_t *)&st_cfg) && (target < (const uint8_t *)(&st_cfg + 1))) ||
+            ((target >= (const uint8_t *)&cm.a[0]) && (target < (const uint8_t *)&cm.a[AXES])));
+}
+
+bool config_snapshot_load(uint32_t hash)
+{
+    cfgSnapshot_t snap;
+    if (!persistence_read_snapshot(hash, &snap, sizeof(snap))) {
+        return (false);
+    }
+    memcpy(&st_cfg, &snap.st, sizeof(st_cfg));
+    memcpy(cm.a, snap.a, sizeof(cm.a));
+    st_apply_config();                          // what the motor setters would have done to the hardware
+    kn_config_changed();
+    cm_update_soft_limits();                    // ...and the travel setters to the soft limits
+    return (true);
+}
+
+void config_snapshot_save(uint32_t hash)
+{
+    cfgSnapshot_t snap;
+    memcpy(&snap.st, &st_cfg, sizeof(st_cfg));
+    memcpy(snap.a, cm.a, sizeof(cm.a));
+    persistence_write_snapshot(hash, &snap, sizeof(snap));
+}
+
 /***** APPLICATION SPECIFIC CONFIGS AND EXTENSIONS TO GENERIC FUNCTIONS *****/
 
 /*
@@ -1412,6 +1754,9 @@ static stat_t _do_heaters(nvObj_t *nv)  // print parameters for all heater group
 
 static stat_t _do_all(nvObj_t *nv)  // print all parameters
 {
+    if ((js.json_mode != TEXT_MODE) && (cs.comm_mode != CBOR_MODE)) {
+        return (json_stream_groups());  // one response, with everything - see json_parser.cpp
+    }
     _do_group(nv, (char *)"sys");   // System group
     _do_motors(nv);
     _do_axes(nv);
@@ -1436,7 +1781,7 @@ static stat_t _do_all(nvObj_t *nv)  // print all parameters
 
 static stat_t get_rx(nvObj_t *nv)
 {
-    nv->value = (float)254;        // ARM always says the serial buffer is available (max)
+    nv->value = (float)xio_get_rx_bytes_free();
     nv->valuetype = TYPE_INT;
     return (STAT_OK);
 }
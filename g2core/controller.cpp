@@ -29,25 +29,45 @@
 #include "g2core.h"  // #1
 #include "config.h"  // #2
 #include "controller.h"
+#include "binary_parser.h"
 #include "json_parser.h"
 #include "text_parser.h"
 #include "gcode_parser.h"
 #include "canonical_machine.h"
 #include "plan_arc.h"
+#include "plan_spline.h"
 #include "planner.h"
+#include "plan_coalesce.h"
+#include "plan_lookahead.h"
 #include "stepper.h"
 #include "temperature.h"
 #include "encoder.h"
+#include "profile.h"
 #include "hardware.h"
 #include "gpio.h"
+#include "spindle.h"
+#include "spindle_vfd.h"
 #include "report.h"
 #include "help.h"
 #include "util.h"
 #include "xio.h"
+#include "persistence.h"
+#include "telemetry.h"
+#include "plan_track.h"
+#include "plan_aux.h"
+#include "motion_link.h"
+#include "checkpoint.h"
+#include "trace.h"
+#include "step_capture.h"
+#include "rx_capture.h"
+#include "bench.h"
+#include "timebase.h"
 #include "settings.h"
 
 #include "MotatePower.h"
 
+#include <malloc.h>         // mallinfo() for the heap in the memory report
+
 #if MARLIN_COMPAT_ENABLED == true
 #include "marlin_compatibility.h"
 #endif
@@ -63,11 +83,13 @@ controller_t cs;        // controller state structure
  ***********************************************************************************/
 
 static void _controller_HSM(void);
+static bool _controller_is_idle(void);
 static stat_t _led_indicator(void);             // twiddle the LED indicator
 static stat_t _shutdown_handler(void);          // new (replaces _interlock_estop_handler)
 static stat_t _interlock_handler(void);         // new (replaces _interlock_estop_handler)
 static stat_t _limit_switch_handler(void);      // revised for new GPIO code
 
+static void _paint_stack(void);
 static void _init_assertions(void);
 static stat_t _test_assertions(void);
 static stat_t _test_system_assertions(void);
@@ -93,6 +115,7 @@ void controller_init()
     // preserve settable parameters that may have already been set up
     commMode comm_mode = cs.comm_mode;
 
+    _paint_stack();                                 // for the stack high-water mark
     memset(&cs, 0, sizeof(controller_t));           // clear all values, job_id's, pointers and status
     _init_assertions();
 
@@ -104,6 +127,10 @@ void controller_init()
     if (xio_connected()) {
         cs.controller_state = CONTROLLER_CONNECTED;
     }
+    binary_parser_init();                           // no binary stream sequence until the first frame
+#if CONTROLLER_IDLE_SLEEP == true
+    SCB->SCR |= SCB_SCR_SEVONPEND_Msk;              // an interrupt pending while masked also ends a WFE
+#endif
 //  IndicatorLed.setFrequency(100000);
 }
 
@@ -116,70 +143,189 @@ void controller_request_enquiry()
 /*
  * controller_run() - MAIN LOOP - top-level controller
  *
- * The order of the dispatched tasks is very important.
- * Tasks are ordered by increasing dependency (blocking hierarchy).
- * Tasks that are dependent on completion of lower-level tasks must be
- * later in the list than the task(s) they are dependent upon.
+ * The controller runs a fixed table of tasks on each pass. Table order is priority -
+ * tasks are ordered by increasing dependency (blocking hierarchy). Tasks that are
+ * dependent on completion of lower-level tasks must be later in the table than the
+ * task(s) they are dependent upon.
  *
  * Tasks must be written as continuations as they will be called repeatedly,
  * and are called even if they are not currently active.
  *
- * The DISPATCH macro calls the function and returns to the controller parent
- * if not finished (STAT_EAGAIN), preventing later routines from running
- * (they remain blocked). Any other condition - OK or ERR - drops through
- * and runs the next routine in the list.
+ * A task returning STAT_EAGAIN is not finished. If the task is marked TASK_HOLDS it
+ * returns to the controller parent, preventing later tasks from running (they remain
+ * blocked). Others are simply called again on the next pass. Any other condition - OK
+ * or ERR - drops through and runs the next task in the table. Only the cycles, the
+ * command holds and the syncs may hold, so housekeeping is kept above them where
+ * a long cycle can't starve it.
+ *
+ * A task with a period is not polled until it is due, and then runs once per period.
+ * If it returns STAT_EAGAIN it stays due and is called again on the next pass. Period
+ * 0 tasks are polled on every pass, and are the ones that must react at once.
+ *
+ * A TASK_IDLE task is deferrable work - persistence writes, checkpoints, dumps and
+ * summaries. It is only called while the planner has time in hand (PHAT_CITY, see
+ * mp_is_phat_city_time()) and the pass is less than CONTROLLER_IDLE_SLICE_US old when
+ * its turn comes. Otherwise it stays due and runs in a later window. So that work
+ * lands during cruises and stops, not in the dense sections where the planner needs
+ * every pass.
  *
  * A routine that had no action (i.e. is OFF or idle) should return STAT_NOOP
+ *
+ * When a pass finds the machine idle - nothing read, nothing held, no cycle and
+ * nothing to plan or run - the CPU waits for an event (WFE) before the next pass.
+ * Every interrupt wakes it: serial and USB RX, the stepper and ADC interrupts, and
+ * the 1 ms SysTick, which bounds the wait for anything polled on a timer (periodic
+ * tasks, reports, persistence). So sleeping never delays work by more than a tick,
+ * and a line that arrives while idle is read as soon as its interrupt ends.
  */
 
 void controller_run()
 {
     while (true) {
         _controller_HSM();
+#if CONTROLLER_IDLE_SLEEP == true
+        if (_controller_is_idle()) {
+            __WFE();
+        }
+#endif
     }
 }
 
-#define DISPATCH(func) if (func == STAT_EAGAIN) return;
-static void _controller_HSM()
-{
+#define TASK_HOLDS      0x01            // STAT_EAGAIN holds off the tasks below this one
+#define TASK_IDLE       0x02            // only runs in PHAT_CITY time, early in the pass
+
+#ifndef CONTROLLER_IDLE_SLICE_US
+#define CONTROLLER_IDLE_SLICE_US 500    // TASK_IDLE tasks wait for the next pass once this one is older
+#endif
+
+typedef struct ctlTask {
+    stat_t (*run)(void);                // the task
+    uint16_t period;                    // ms between calls, or 0 to poll on every pass
+    uint8_t flags;                      // TASK_ flags
+} ctlTask_t;
+
+static const ctlTask_t tasks[] = {
 //----- Interrupt Service Routines are the highest priority controller functions ----//
 //      See hardware.h for a list of ISRs and their priorities.
 //
 //----- kernel level ISR handlers ----(flags are set in ISRs)------------------------//
-                                                // Order is important:
-    DISPATCH(hardware_periodic());              // give the hardware a chance to do stuff
-    DISPATCH(_led_indicator());                 // blink LEDs at the current rate
-    DISPATCH(_shutdown_handler());              // invoke shutdown
-    DISPATCH(_interlock_handler());             // invoke / remove safety interlock
-    DISPATCH(temperature_callback());           // makes sure temperatures are under control
-    DISPATCH(_limit_switch_handler());          // invoke limit switch
-    DISPATCH(_controller_state());              // controller state management
-    DISPATCH(_test_system_assertions());        // system integrity assertions
-    DISPATCH(_dispatch_control());              // read any control messages prior to executing cycles
+                                                            // Order is important:
+    { hardware_periodic,                0,   TASK_HOLDS },  // give the hardware a chance to do stuff
+    { _led_indicator,                   0,   0 },           // blink LEDs at the current rate
+    { gpio_event_callback,              0,   0 },           // turn input events into requests
+    { _shutdown_handler,                0,   0 },           // invoke shutdown
+    { _interlock_handler,               0,   0 },           // invoke / remove safety interlock
+    { temperature_callback,             100, 0 },           // makes sure temperatures are under control (10 Hz)
+    { spindle_callback,                 0,   0 },           // spindle at-speed faults
+    { spindle_vfd_callback,             0,   0 },           // run the spindle VFD's Modbus link
+    { _limit_switch_handler,            0,   0 },           // invoke limit switch
+    { _controller_state,                0,   0 },           // controller state management
+    { _test_system_assertions,          10,  0 },           // system integrity assertions
+    { xio_callback,                     0,   0 },           // hand queued responses to the TX buffers
+    { rpt_gcode_error_callback,         0,   0 },           // report queued gcode errors as the TX path has room
+    { _dispatch_control,                0,   0 },           // read any control messages prior to executing cycles
 
 //----- planner hierarchy for gcode and cycles ---------------------------------------//
 
-    DISPATCH(st_motor_power_callback());        // stepper motor power sequencing
-    DISPATCH(sr_status_report_callback());      // conditionally send status report
-    DISPATCH(qr_queue_report_callback());       // conditionally send queue report
+    { st_motor_power_callback,          0,   0 },           // stepper motor power sequencing
+    { sr_status_report_callback,        0,   0 },           // conditionally send status report (times itself on {si:})
+    { qr_queue_report_callback,         0,   0 },           // conditionally send queue report
+    { json_ack_callback,                0,   0 },           // send the acknowledgement for Gcode lines once the stream pauses
+#if BINARY_STREAM_ENABLED == true
+    { binary_callback,                  0,   0 },           // send the ACK for binary frames once the stream pauses
+#endif
+    { cm_deferred_write_callback,       0,   TASK_IDLE },   // persist G10 changes when not in machining cycle
+    { persistence_callback,             0,   TASK_IDLE },   // program the persistence log once writes stop
+    { checkpoint_callback,              0,   TASK_IDLE },   // save a motion checkpoint as the runtime moves on
+    { mln_callback,                     0,   0 },           // alarm if a board of a multi-board machine lost sync
+    { tlm_callback,                     0,   0 },           // send telemetry samples as the TX path has room
+    { trc_callback,                     0,   TASK_IDLE },   // send a planner trace dump as the TX path has room
+#if STEP_CAPTURE_ENABLED == true
+    { stc_callback,                     0,   0 },           // finish a step capture, send its dump as the TX path has room
+#endif
+#if RX_CAPTURE_ENABLED == true
+    { rxc_callback,                     0,   0 },           // send an RX capture dump as the TX path has room
+#endif
 
-    DISPATCH(cm_feedhold_sequencing_callback());// feedhold state machine runner
-    DISPATCH(mp_planner_callback());            // motion planner
-    DISPATCH(cm_arc_callback());                // arc generation runs as a cycle above lines
-    DISPATCH(cm_homing_cycle_callback());       // homing cycle operation (G28.2)
-    DISPATCH(cm_probing_cycle_callback());      // probing cycle operation (G38.2)
-    DISPATCH(cm_jogging_cycle_callback());      // jog cycle operation
-    DISPATCH(cm_deferred_write_callback());     // persist G10 changes when not in machining cycle
+    { cm_feedhold_sequencing_callback,  0,   0 },           // feedhold state machine runner
+    { mp_lookahead_callback,            0,   0 },           // release moves held by the lookahead queue to the planner
+    { mp_coalesce_callback,             0,   TASK_HOLDS },  // release a stalled coalesced move to the planner
+    { mp_planner_callback,              0,   0 },           // motion planner
+    { mp_track_callback,                0,   0 },           // fold a stopped conveyor tracking offset into the position
+    { mp_aux_callback,                  0,   0 },           // fold finished auxiliary moves into the positions
+    { mp_starvation_callback,           0,   0 },           // report a stop caused by the queue running dry
+    { job_summary_callback,             0,   TASK_IDLE },   // send the job summary after M2 or M30
+#if BENCH_ENABLED == true
+    { bench_callback,                   0,   TASK_IDLE },   // send the benchmark results once a dry run stops
+#endif
+    { cm_arc_callback,                  0,   TASK_HOLDS },  // arc generation runs as a cycle above lines
+    { cm_spline_callback,               0,   TASK_HOLDS },  // segmented splines (G5) run like arcs
+    { cm_drilling_cycle_callback,       0,   TASK_HOLDS },  // canned drilling cycles run like arcs (G73, G81-G83)
+    { cm_homing_cycle_callback,         0,   TASK_HOLDS },  // homing cycle operation (G28.2)
+    { cm_probing_cycle_callback,        0,   TASK_HOLDS },  // probing cycle operation (G38.2)
+    { cm_jogging_cycle_callback,        0,   TASK_HOLDS },  // jog cycle operation
 
 #if MARLIN_COMPAT_ENABLED == true
-    DISPATCH(marlin_callback());                // handle Marlin stuff - may return EAGAIN, must be after planner_callback!
+    { marlin_callback,                  0,   TASK_HOLDS },  // handle Marlin stuff - may return EAGAIN, must be after planner_callback!
 #endif
+    { json_batch_callback,              0,   TASK_HOLDS },  // apply a committed config batch once motion stops - may return EAGAIN
 
 //----- command readers and parsers --------------------------------------------------//
 
-    DISPATCH(_sync_to_planner());               // ensure there is at least one free buffer in planning queue
-    DISPATCH(_sync_to_tx_buffer());             // sync with TX buffer (pseudo-blocking)
-    DISPATCH(_dispatch_command());              // MUST BE LAST - read and execute next command
+    { _sync_to_planner,                 0,   TASK_HOLDS },  // ensure there is at least one free buffer in planning queue
+    { _sync_to_tx_buffer,               0,   TASK_HOLDS },  // hold off commands while responses are backed up
+    { _dispatch_command,                0,   TASK_HOLDS }   // MUST BE LAST - read and execute next command
+};
+
+#define CONTROLLER_TASKS (sizeof(tasks)/sizeof(ctlTask_t))
+
+static uint32_t task_due[CONTROLLER_TASKS];     // systick at which a periodic task is next due
+static bool pass_busy;                          // the last pass held, or read a line
+
+static void _controller_HSM()
+{
+    uint32_t now = SysTickTimer_getValue();
+    PROF_START(pass_cycles);
+    pass_busy = false;
+    uint64_t pass_start = tb_get_cycles();
+    bool idle_time = mp_is_phat_city_time();
+
+    for (uint8_t i=0; i<CONTROLLER_TASKS; i++) {
+        const ctlTask_t *task = &tasks[i];
+        if ((task->period != 0) && ((int32_t)(now - task_due[i]) < 0)) {
+            continue;                           // not due yet - don't poll it
+        }
+        if ((task->flags & TASK_IDLE) && (!idle_time ||
+            ((tb_get_cycles() - pass_start) > (uint64_t)CONTROLLER_IDLE_SLICE_US * (SystemCoreClock / 1000000)))) {
+            continue;                           // stays due - runs in a later window
+        }
+        PROF_START(task_cycles);
+        stat_t status = task->run();
+        PROF_TASK_END(i, task_cycles);
+
+        if (status == STAT_EAGAIN) {
+            if (task->flags & TASK_HOLDS) {
+                pass_busy = true;
+                break;                          // the tasks below wait for this one
+            }
+            continue;                           // stays due - call it again next pass
+        }
+        task_due[i] = now + task->period;
+    }
+    PROF_END(PROF_HSM, pass_cycles);
+}
+
+/*
+ * _controller_is_idle() - true if the last pass left nothing to do until an interrupt
+ */
+
+static bool _controller_is_idle()
+{
+    return (!pass_busy &&
+            !cs.line_held &&
+            (cm_get_cycle_state() == CYCLE_OFF) &&
+            (mp.planner_state == PLANNER_IDLE) &&
+            mp_runtime_is_idle());
 }
 
 /*****************************************************************************
@@ -199,6 +345,7 @@ static stat_t _dispatch_control()
     if (cs.controller_state != CONTROLLER_PAUSED) {
         devflags_t flags = DEV_IS_CTRL;
         if ((cs.bufp = xio_readline(flags, cs.linelen)) != NULL) {
+            pass_busy = true;                       // there may be more lines behind it
             _dispatch_kernel(flags);
         }
     }
@@ -209,7 +356,26 @@ static stat_t _dispatch_command()
 {
     if (cs.controller_state != CONTROLLER_PAUSED) {
         devflags_t flags = DEV_IS_BOTH | DEV_IS_MUTED; // expressly state we'll handle muted devices
-        if ((!mp_planner_is_full()) && (cs.bufp = xio_readline(flags, cs.linelen)) != NULL) {
+        if (cs.line_held) {                         // a line is waiting for the lookahead queue to drain
+            if (mp_lookahead_is_synced()) {
+                cs.line_held = false;
+                cs.bufp = cs.held_buf;
+                _dispatch_kernel(cs.held_flags);
+            }
+        } else if ((!mp_planner_is_full() || mp_lookahead_has_room()) &&
+                   (cs.bufp = xio_readline(flags, cs.linelen)) != NULL) {
+            pass_busy = true;
+#if BENCH_ENABLED == true
+            bench.lines++;                          // lines read during a benchmark - see bench.h
+#endif
+            if (!mp_lookahead_is_synced() && !(flags & DEV_IS_MUTED)) {
+                strncpy(cs.held_buf, cs.bufp, RX_BUFFER_SIZE);  // the line is only valid until the next read
+                cs.held_flags = flags;
+                if (!mp_lookahead_is_move_line(cs.bufp)) {
+                    cs.line_held = true;            // it must not pass the moves held
+                    return (STAT_OK);
+                }
+            }
             _dispatch_kernel(flags);
         }
     }
@@ -244,6 +410,7 @@ static void _dispatch_kernel(const devflags_t flags)
         cs.bufp++;
     }
     strncpy(cs.saved_buf, cs.bufp, SAVED_BUFFER_LEN-1);     // save input buffer for reporting
+    sr_mark_dirty(SR_DIRTY_MODEL);                          // any command may change the gcode model
 
     if (*cs.bufp == NUL) {                                  // blank line - just a CR or the 2nd termination in a CRLF
         if (js.json_mode == TEXT_MODE) {
@@ -254,18 +421,40 @@ static void _dispatch_kernel(const devflags_t flags)
 
     // trap single character commands
     if      (*cs.bufp == '!') { cm_request_feedhold(); }
-    else if (*cs.bufp == '%') { cm_request_queue_flush(); xio_flush_to_command(); }
+    else if (*cs.bufp == '%') { cm_request_queue_flush(); xio_flush_to_command(); cs.line_held = false; binary_flush(); }
     else if (*cs.bufp == '~') { cm_request_end_hold(); }
     else if (*cs.bufp == EOT) { cm_alarm(STAT_KILL_JOB, "EOT Received"); }
     else if (*cs.bufp == ENQ) { controller_request_enquiry(); }
     else if (*cs.bufp == CAN) { hw_hard_reset(); }          // reset immediately
 
+#if BINARY_STREAM_ENABLED == true
+    else if (*cs.bufp == BINARY_FRAME_START) {              // process as a binary frame - it sends its own ACKs
+        if (binary_parser(cs.bufp) == STAT_EAGAIN) {
+            cs.line_held = true;                            // the lookahead queue can't take it yet - run it again
+        }
+        return;
+    }
+#endif
     else if (*cs.bufp == '{') {                             // process as JSON mode
         if (cs.comm_mode == AUTO_MODE) {
             js.json_mode = JSON_MODE;                       // switch to JSON mode
         }
         cs.comm_request_mode = JSON_MODE;                   // mode of this command
-        json_parser(cs.bufp);
+        if (json_parser(cs.bufp) == STAT_EAGAIN) {          // the parse wrote into bufp, so hold the saved copy
+            strncpy(cs.held_buf, cs.saved_buf, RX_BUFFER_SIZE);
+            cs.held_flags = flags;
+            cs.line_held = true;                            // a setter can't take it yet - run it again
+            return;
+        }
+    }
+    else if (xio_spool_is_uploading() && (strchr("$?Hh", *cs.bufp) == NULL)) {  // store the line in the spooled job
+        status = xio_spool_write_line(cs.bufp);
+        if (js.json_mode == TEXT_MODE) {
+            text_response(status, cs.saved_buf);
+        } else {
+            nv_reset_nv_list();
+            nv_print_list(status, TEXT_NO_PRINT, JSON_RESPONSE_FORMAT);
+        }
     }
 #ifdef __TEXT_MODE
     else if (strchr("$?Hh", *cs.bufp) != NULL) {            // process as text mode
@@ -278,7 +467,11 @@ static void _dispatch_kernel(const devflags_t flags)
     }
     else if (js.json_mode == TEXT_MODE) {                   // anything else is interpreted as Gcode
         cs.comm_request_mode = TEXT_MODE;                   // mode of this command
-        text_response(gcode_parser(cs.bufp), cs.saved_buf);
+        if ((status = gcode_parser(cs.bufp)) == STAT_EAGAIN) {
+            cs.line_held = true;                            // the lookahead queue can't take it yet - run it again
+            return;
+        }
+        text_response(status, cs.saved_buf);
     }
 #endif
 
@@ -296,7 +489,10 @@ static void _dispatch_kernel(const devflags_t flags)
         strcpy(nv->token, "gc");                            // label is as a Gcode block (do not get an index - not necessary)
         nv_copy_string(nv, cs.bufp);                        // copy the Gcode line
         nv->valuetype = TYPE_STRING;
-        status = gcode_parser(cs.bufp);
+        if ((status = gcode_parser(cs.bufp)) == STAT_EAGAIN) {
+            cs.line_held = true;                            // the lookahead queue can't take it yet - run it again
+            return;
+        }
         
 #if MARLIN_COMPAT_ENABLED == true
         if (js.json_mode == MARLIN_COMM_MODE) {             // in case a marlin-specific M-code was found
@@ -309,6 +505,14 @@ static void _dispatch_kernel(const devflags_t flags)
         }
 #endif
 
+#if GCODE_ERROR_REPORTS == true
+        if ((js.json_verbosity == JV_EXCEPTIONS) &&         // hosts streaming silently get errors from the ring
+            (status != STAT_OK) && (status != STAT_NOOP) && (status != STAT_COMPLETE)) {
+            rpt_queue_gcode_error(status, cs.saved_buf);
+            sr_request_status_report(SR_REQUEST_TIMED);
+            return;
+        }
+#endif
         nv_print_list(status, TEXT_NO_PRINT, JSON_RESPONSE_FORMAT);
         sr_request_status_report(SR_REQUEST_TIMED);         // generate incremental status report to show any changes
     }
@@ -442,15 +646,21 @@ static stat_t _led_indicator()
 /*
  * _sync_to_tx_buffer() - return eagain if TX queue is backed up
  * _sync_to_planner() - return eagain if planner is not ready for a new command
+ *
+ *  Writes never wait for the TX buffer - responses it can't take go on the TX chain.
+ *  Holding off new commands while the chain is half full keeps it from dropping them.
  */
 static stat_t _sync_to_tx_buffer()
 {
+    if (xio_tx_is_backed_up()) {
+        return (STAT_EAGAIN);
+    }
     return (STAT_OK);
 }
 
 static stat_t _sync_to_planner()
 {
-    if (mp_planner_is_full()) {   // allow up to N planner buffers for this line
+    if (mp_planner_is_full() && !mp_lookahead_has_room()) {   // allow up to N planner buffers for this line
         return (STAT_EAGAIN);
     }
     return (STAT_OK);
@@ -523,10 +733,67 @@ static stat_t _interlock_handler(void)
     return(STAT_OK);
 }
 
+/*
+ * _paint_stack() - fill the unused stack with a pattern, so the high-water mark can be found
+ * controller_get_mem() - refresh the memory report and get one of its values
+ *
+ *  The stack runs from _sstack up to _estack, as set up by the linker script. Everything
+ *  below the current stack pointer, less a margin for this function, is painted at boot.
+ *  The high-water mark is the lowest word that no longer holds the paint. The bottom word
+ *  is also checked with the controller assertions, as the stack has reached its limit (and
+ *  is probably running into the heap or .bss) once the paint there is gone.
+ *
+ *  The static sizes are the RAM the largest buffers take as built, so the headroom for a
+ *  deeper planner pool on a board is about the stack not used, plus the free heap, divided
+ *  by the size of one planner buffer.
+ */
+
+extern uint32_t _sstack;                            // from the linker script: bottom of the stack
+extern uint32_t _estack;                            // from the linker script: top of the stack
+
+#define STACK_PAINT         0xA5A5A5A5
+#define STACK_PAINT_MARGIN  32                      // words left unpainted below this function's frame
+
+static void _paint_stack()
+{
+    uint32_t here;
+    uint32_t *stop = &here - STACK_PAINT_MARGIN;
+    for (uint32_t *p = &_sstack; p < stop; p++) {
+        *p = STACK_PAINT;
+    }
+}
+
+stat_t controller_get_mem(nvObj_t *nv)
+{
+    ctlMemory_t *mem = &cs.mem;
+    uint32_t *p = &_sstack;
+
+    while ((p < &_estack) && (*p == STACK_PAINT)) {
+        p++;
+    }
+    mem->stack_size = (uint32_t)((char *)&_estack - (char *)&_sstack);
+    mem->stack_used = (uint32_t)((char *)&_estack - (char *)p);
+    mem->planner = sizeof(mb);
+    mem->planner_buffer = sizeof(mpBuf_t) + sizeof(mpBufCold_t);
+    mem->nv_list = sizeof(nvl);
+    mem->xio = xio_get_static_size();
+    mem->arc = sizeof(arc);
+
+    struct mallinfo heap = mallinfo();
+    mem->heap_used = heap.uordblks;
+    mem->heap_free = heap.fordblks;
+    return (get_int(nv));
+}
+
 /*
  * _init_assertions() - initialize controller memory integrity assertions
  * _test_assertions() - check controller memory integrity assertions
  * _test_system_assertions() - check assertions for entire system
+ *
+ *  The system assertions are spread out over the passes: each call checks one subsystem,
+ *  in turn, so the main loop pays for one set of magic number tests every 10 ms instead
+ *  of all of them. The whole system is still covered every SYSTEM_ASSERTIONS calls. After
+ *  an exception (see rpt_exception()) the next call checks every subsystem at once.
  */
 
 static void _init_assertions()
@@ -540,19 +807,43 @@ static stat_t _test_assertions()
     if ((cs.magic_start != MAGICNUM) || (cs.magic_end != MAGICNUM)) {
         return(cm_panic(STAT_CONTROLLER_ASSERTION_FAILURE, "controller_test_assertions()"));
     }
+    if (_sstack != STACK_PAINT) {
+        return(cm_panic(STAT_CONTROLLER_ASSERTION_FAILURE, "stack overflow"));
+    }
     return (STAT_OK);
 }
 
+static stat_t (*const system_assertions[])(void) = {
+    _test_assertions,                       // controller assertions (local)
+    config_test_assertions,
+    canonical_machine_test_assertions,
+    planner_test_assertions,
+    stepper_test_assertions,
+    encoder_test_assertions,
+#ifdef __PROFILE
+    profile_test_assertions,
+#endif
+    xio_test_assertions
+};
+
+#define SYSTEM_ASSERTIONS (sizeof(system_assertions)/sizeof(system_assertions[0]))
+
 stat_t _test_system_assertions()
 {
+    static uint8_t next = 0;
+
     // these functions will panic if an assertion fails
-    _test_assertions();                     // controller assertions (local)
-    config_test_assertions();
-    canonical_machine_test_assertions();
-    planner_test_assertions();
-    stepper_test_assertions();
-    encoder_test_assertions();
-    xio_test_assertions();
+    if (cs.assert_all) {
+        cs.assert_all = false;
+        for (uint8_t i=0; i<SYSTEM_ASSERTIONS; i++) {
+            system_assertions[i]();
+        }
+        return (STAT_OK);
+    }
+    system_assertions[next]();
+    if (++next >= SYSTEM_ASSERTIONS) {
+        next = 0;
+    }
     return (STAT_OK);
 }
 
@@ -39,6 +39,10 @@
 #define LED_SHUTDOWN_BLINK_RATE 300     // blink rate for shutdown state (in ms)
 #define LED_PANIC_BLINK_RATE 100        // blink rate for panic state (in ms)
 
+#ifndef CONTROLLER_IDLE_SLEEP
+#define CONTROLLER_IDLE_SLEEP true      // wait for an interrupt (WFE) between passes when idle
+#endif
+
 typedef enum {                          // manages startup lines
     CONTROLLER_INITIALIZING = 0,        // controller is initializing - not ready for use
     CONTROLLER_NOT_CONNECTED,           // has not yet detected connection to USB (or other comm channel)
@@ -48,6 +52,18 @@ typedef enum {                          // manages startup lines
     CONTROLLER_PAUSED                   // is paused - presumably in preparation for queue flush
 } csControllerState;
 
+typedef struct ctlMemory {              // RAM budget {mem:} - see controller_get_mem()
+    uint32_t stack_size;                // bytes reserved for the stack by the linker {mems:}
+    uint32_t stack_used;                // most stack ever used, from the paint left at boot {memu:}
+    uint32_t planner;                   // planner buffer pool (mb) {memb:}
+    uint32_t planner_buffer;            // one planner buffer, hot and cold sides - what deepening the pool costs {memp:}
+    uint32_t nv_list;                   // nvObj list (nvl) {memn:}
+    uint32_t xio;                       // xio devices with their RX rings and TX chains {memx:}
+    uint32_t arc;                       // arc singleton {mema:}
+    uint32_t heap_used;                 // heap in use {memh:}
+    uint32_t heap_free;                 // heap freed and not yet reused {memf:}
+} ctlMemory_t;
+
 typedef struct controllerSingleton {    // main TG controller struct
     magic_t magic_start;                // magic number to test memory integrity
     float null;                         // dumping ground for items with no target
@@ -62,6 +78,7 @@ typedef struct controllerSingleton {    // main TG controller struct
     csControllerState controller_state;
     uint32_t led_timer;                 // used to flash indicator LED
     uint32_t led_blink_rate;            // used to flash indicator LED
+    bool assert_all;                    // run every system assertion at the next check - set by rpt_exception()
 
     // communications state variables
     // cs.comm_mode is the setting for the communications mode
@@ -76,6 +93,11 @@ typedef struct controllerSingleton {    // main TG controller struct
     uint16_t linelen;                   // length of currently processing line
     char out_buf[OUTPUT_BUFFER_LEN];    // output buffer
     char saved_buf[SAVED_BUFFER_LEN];   // save the input buffer
+    char held_buf[RX_BUFFER_SIZE+1];    // copy of a line held back by the lookahead queue
+    devflags_t held_flags;              // ...and the flags it was read with
+    bool line_held;                     // true if held_buf is waiting to be dispatched
+
+    ctlMemory_t mem;                    // RAM budget - refreshed as it's read
 
     magic_t magic_end;
 } controller_t;
@@ -90,4 +112,6 @@ void controller_set_connected(bool is_connected);
 void controller_set_muted(bool is_muted);
 bool controller_parse_control(char *p);
 
+stat_t controller_get_mem(nvObj_t *nv);
+
 #endif // End of include guard: CONTROLLER_H_ONCE
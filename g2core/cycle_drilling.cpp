@@ -0,0 +1,393 @@
+/*
+ * cycle_drilling.cpp - canned drilling cycles (G73, G81, G82, G83)
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* --- Canned Cycle Notes ----
+ *
+ *  The drilling cycles follow the LinuxCNC definitions, in the G17 (XY) plane only:
+ *
+ *    G81 - rapid to the hole, rapid to R, feed to Z, rapid out
+ *    G82 - as G81 with a dwell of P seconds at the bottom
+ *    G83 - peck drilling: feed down by Q, rapid out to R, rapid back to just above the
+ *          depth reached, and so on to Z
+ *    G73 - chip breaking: as G83 but backs off by DRILL_PECK_CLEARANCE instead of to R
+ *
+ *  At the end of each hole the tool retracts to R (G99) or to the higher of R and the Z
+ *  the block started at (G98). If the block starts below R the tool rapids up to R first.
+ *  L repeats the hole L times, stepping by the X and Y words in incremental mode (G91).
+ *  In G91 R is taken from the starting Z and Z from R.
+ *
+ *  R, Z, Q and P are sticky - they are kept from block to block until the motion mode
+ *  leaves the drilling cycles, so a block of X and Y words drills the next hole. The
+ *  parser reads R into arc_radius. It is the retract plane when a cycle is active.
+ *
+ *  A cycle is resolved to machine coordinates once and the model position is set to its
+ *  end. The moves themselves are queued to the planner by cm_drilling_cycle_callback()
+ *  - as cm_arc_callback() queues arc segments - so the controller reads no further line
+ *  until the last one is queued.
+ */
+#include "g2core.h"
+#include "config.h"
+#include "canonical_machine.h"
+#include "planner.h"
+#include "util.h"
+
+#ifndef DRILL_PECK_CLEARANCE
+#define DRILL_PECK_CLEARANCE    ((float)0.254)  // mm backed off the bottom between pecks (G73), or stopped short on the way back in (G83)
+#endif
+#define DRILL_MOVES_PER_CALLBACK 4              // max moves queued per pass of cm_drilling_cycle_callback()
+
+typedef enum {                      // the next move of the hole being drilled
+    DRILL_PRELIMINARY = 0,          // rapid up to R if the block started below it
+    DRILL_POSITION,                 // rapid XY to the hole
+    DRILL_RAPID_TO_R,               // rapid down to the retract plane
+    DRILL_FEED,                     // feed down one peck, or to the bottom
+    DRILL_PECK_RETRACT,             // rapid out of the hole - to R for G83, back by the clearance for G73
+    DRILL_PECK_RETURN,              // rapid back down to just above the depth reached (G83)
+    DRILL_DWELL,                    // dwell at the bottom (G82)
+    DRILL_RETRACT                   // rapid out to the clear level, then on to the next hole
+} cmDrillStep;
+
+/**** Drilling singleton structure ****/
+
+struct dcDrillingSingleton {        // persistent canned cycle variables
+    uint8_t run_state;              // BLOCK_ACTIVE while moves are left to queue
+    cmDrillStep step;               // next move to queue
+    cmMotionMode cycle;             // G73, G81, G82 or G83
+    cmRetractMode retract_mode;     // G98, G99 - modal, not cleared with the cycle
+
+    // sticky words, kept from block to block while in a drilling cycle (mm)
+    float R_word;                   // retract plane - absolute, or from the initial Z in G91
+    float Z_word;                   // bottom of the hole - absolute, or from R in G91
+    float Q_word;                   // peck depth. Zero if not programmed yet
+    float P_word;                   // dwell seconds
+
+    // the block being run, resolved to machine coordinates
+    float hole[2];                  // X and Y of the hole being drilled
+    float increment[2];             // XY step to the next hole - non-zero in G91 only
+    uint8_t holes;                  // holes left to drill, including this one
+    float r_level;                  // retract plane
+    float bottom;                   // bottom of the hole
+    float clear_level;              // Z to retract to at the end of each hole
+    float peck;                     // feed per peck - the whole depth for G81 and G82
+    float dwell;                    // seconds at the bottom - G82 only
+    float depth;                    // depth reached in this hole
+
+    GCodeState_t gm;                // Gcode state passed with each move
+};
+static struct dcDrillingSingleton drill;
+
+/**** NOTE: global prototypes and other .h info is located in canonical_machine.h ****/
+
+static bool _is_drilling_cycle(const cmMotionMode motion_mode);
+static stat_t _test_drill_soft_limits(const float top);
+static void _drill_move(const cmMotionMode motion_mode, const float x, const float y, const float z);
+static bool _queue_drill_move(void);
+
+/*****************************************************************************
+ * cm_set_retract_mode()      - G98, G99
+ * cm_abort_drilling()        - stop a cycle in process
+ * cm_drilling_cycle_start()  - canonical machine entry point for G73, G81, G82 and G83
+ * cm_drilling_cycle_callback() - main-loop callback for queuing cycle moves
+ */
+
+stat_t cm_set_retract_mode(const uint8_t mode)
+{
+    drill.retract_mode = (cmRetractMode)mode;
+    return (STAT_OK);
+}
+
+/*
+ * cm_abort_drilling() - stop a cycle without maintaining position
+ *
+ *  OK to call if no cycle is running
+ */
+
+void cm_abort_drilling()
+{
+    drill.run_state = BLOCK_INACTIVE;
+}
+
+/*
+ * cm_drilling_cycle_start() - set up a drilling cycle for the block
+ *
+ *  Called for every block while a drilling cycle is the motion mode. A block with no
+ *  X, Y, Z or R word (an F or M word, say) drills nothing. R and Z are required on the
+ *  block that enters the cycle, Q by the first G73 or G83 block.
+ */
+
+stat_t cm_drilling_cycle_start(const float target[], const bool target_f[],
+                               const float R_word, const bool R_flag,
+                               const float Q_word, const bool Q_flag,
+                               const float P_word, const bool P_flag,
+                               const uint8_t L_word, const bool L_flag,
+                               const cmMotionMode motion_mode)
+{
+    const bool entering = !_is_drilling_cycle(cm.gm.motion_mode);
+
+    if (!(target_f[AXIS_X] | target_f[AXIS_Y] | target_f[AXIS_Z] | R_flag)) {
+        if (entering) {
+            return (STAT_R_WORD_IS_MISSING);
+        }
+        cm.gm.motion_mode = motion_mode;                // G81 alone switches cycles, drills nothing
+        return (STAT_OK);
+    }
+    if (target_f[AXIS_A] | target_f[AXIS_B] | target_f[AXIS_C]) {
+        return (STAT_GCODE_ROTARY_AXIS_CANNOT_BE_USED);
+    }
+    if (cm.gm.select_plane != CANON_PLANE_XY) {
+        return (STAT_GCODE_ACTIVE_PLANE_IS_INVALID);
+    }
+    if (cm.gm.feed_rate_mode == INVERSE_TIME_MODE) {
+        return (STAT_GCODE_INVERSE_TIME_MODE_CANNOT_BE_USED);
+    }
+    if (fp_ZERO(cm.gm.feed_rate)) {
+        return (STAT_GCODE_FEEDRATE_NOT_SPECIFIED);
+    }
+
+    // collect the sticky words - they start over when a cycle is entered
+    if (entering) {
+        if (!R_flag) {
+            return (STAT_R_WORD_IS_MISSING);
+        }
+        if (!target_f[AXIS_Z]) {
+            return (STAT_GCODE_AXIS_IS_MISSING);
+        }
+        drill.Q_word = 0;
+        drill.P_word = 0;
+    }
+    if (Q_flag && (Q_word <= 0)) {
+        return (STAT_Q_WORD_IS_INVALID);
+    }
+    if (P_flag && (P_word < 0)) {
+        return (STAT_P_WORD_IS_NEGATIVE);
+    }
+    if (L_flag && (L_word == 0)) {
+        return (STAT_L_WORD_IS_INVALID);
+    }
+    if (R_flag)           { drill.R_word = _to_millimeters(R_word); }
+    if (target_f[AXIS_Z]) { drill.Z_word = _to_millimeters(target[AXIS_Z]); }
+    if (Q_flag)           { drill.Q_word = _to_millimeters(Q_word); }
+    if (P_flag)           { drill.P_word = P_word; }
+    cm.gm.motion_mode = motion_mode;                    // in the cycle from here on, even if the block fails
+
+    if (((motion_mode == MOTION_MODE_CANNED_CYCLE_73) || (motion_mode == MOTION_MODE_CANNED_CYCLE_83)) &&
+        fp_ZERO(drill.Q_word)) {
+        return (STAT_Q_WORD_IS_MISSING);
+    }
+
+    // resolve the cycle to machine coordinates
+    const float initial_z = cm.gmx.position[AXIS_Z];
+    if (cm.gm.distance_mode == INCREMENTAL_DISTANCE_MODE) {
+        for (uint8_t axis = AXIS_X; axis <= AXIS_Y; axis++) {
+            drill.increment[axis] = target_f[axis] ? _to_millimeters(target[axis]) : 0;
+            drill.hole[axis] = cm.gmx.position[axis] + drill.increment[axis];
+        }
+        drill.r_level = initial_z + drill.R_word;
+        drill.bottom = drill.r_level + drill.Z_word;
+    } else {
+        for (uint8_t axis = AXIS_X; axis <= AXIS_Y; axis++) {
+            drill.increment[axis] = 0;
+            drill.hole[axis] = target_f[axis] ? cm_get_active_coord_offset(axis) + _to_millimeters(target[axis])
+                                              : cm.gmx.position[axis];
+        }
+        drill.r_level = cm_get_active_coord_offset(AXIS_Z) + drill.R_word;
+        drill.bottom = cm_get_active_coord_offset(AXIS_Z) + drill.Z_word;
+    }
+    if (drill.bottom > drill.r_level) {
+        return (STAT_R_WORD_IS_INVALID);                // R must be at or above the bottom of the hole
+    }
+    drill.clear_level = drill.r_level;
+    if ((drill.retract_mode == RETRACT_TO_INITIAL_LEVEL) && (initial_z > drill.r_level)) {
+        drill.clear_level = initial_z;
+    }
+    drill.cycle = motion_mode;
+    drill.holes = L_flag ? L_word : 1;
+    drill.peck = drill.r_level - drill.bottom;
+    if ((motion_mode == MOTION_MODE_CANNED_CYCLE_73) || (motion_mode == MOTION_MODE_CANNED_CYCLE_83)) {
+        drill.peck = drill.Q_word;
+    }
+    drill.dwell = (motion_mode == MOTION_MODE_CANNED_CYCLE_82) ? drill.P_word : 0;
+    drill.step = (initial_z < drill.r_level) ? DRILL_PRELIMINARY : DRILL_POSITION;
+    ritorno(_test_drill_soft_limits(max(initial_z, drill.r_level)));
+
+    // the model ends at the last hole, at the clear level
+    copy_vector(cm.gm.target, cm.gmx.position);
+    cm_set_work_offsets(&cm.gm);                        // capture the fully resolved offsets to gm
+    memcpy(&drill.gm, &cm.gm, sizeof(GCodeState_t));    // copy Gcode context - moves overwrite the target
+    cm.gm.target[AXIS_X] = drill.hole[AXIS_X] + drill.increment[AXIS_X] * (drill.holes - 1);
+    cm.gm.target[AXIS_Y] = drill.hole[AXIS_Y] + drill.increment[AXIS_Y] * (drill.holes - 1);
+    cm.gm.target[AXIS_Z] = drill.clear_level;
+
+    cm_cycle_start();                                   // if not already started
+    drill.run_state = BLOCK_ACTIVE;                     // enable the cycle to be run from the callback
+    cm_finalize_move();
+    return (STAT_OK);
+}
+
+/*
+ * cm_drilling_cycle_callback() - queue the moves of a drilling cycle
+ *
+ *  Called from the controller main loop. Each time it's called it queues up to
+ *  DRILL_MOVES_PER_CALLBACK moves, or fewer if the planner fills, then returns.
+ */
+
+stat_t cm_drilling_cycle_callback()
+{
+    if (drill.run_state == BLOCK_INACTIVE) {
+        return (STAT_NOOP);
+    }
+    for (uint8_t i=0; i<DRILL_MOVES_PER_CALLBACK; i++) {
+        if (mp_planner_is_full()) {
+            return (STAT_EAGAIN);
+        }
+        if (_queue_drill_move()) {
+            drill.run_state = BLOCK_INACTIVE;
+            return (STAT_OK);
+        }
+    }
+    return (STAT_EAGAIN);
+}
+
+/*
+ * _is_drilling_cycle() - true for the motion modes run here
+ */
+
+static bool _is_drilling_cycle(const cmMotionMode motion_mode)
+{
+    return ((motion_mode == MOTION_MODE_CANNED_CYCLE_73) ||
+            (motion_mode == MOTION_MODE_CANNED_CYCLE_81) ||
+            (motion_mode == MOTION_MODE_CANNED_CYCLE_82) ||
+            (motion_mode == MOTION_MODE_CANNED_CYCLE_83));
+}
+
+/*
+ * _test_drill_soft_limits() - test the first and last holes, top and bottom
+ *
+ *  The holes lie on a line, so the ends of it bound the whole cycle.
+ */
+
+static stat_t _test_drill_soft_limits(const float top)
+{
+    float target[AXES];
+
+    copy_vector(target, cm.gmx.position);
+    for (uint8_t hole = 0; hole < 2; hole++) {
+        const float n = hole ? (drill.holes - 1) : 0;
+        target[AXIS_X] = drill.hole[AXIS_X] + drill.increment[AXIS_X] * n;
+        target[AXIS_Y] = drill.hole[AXIS_Y] + drill.increment[AXIS_Y] * n;
+        target[AXIS_Z] = top;
+        ritorno(cm_test_soft_limits(target));
+        target[AXIS_Z] = drill.bottom;
+        ritorno(cm_test_soft_limits(target));
+    }
+    return (STAT_OK);
+}
+
+/*
+ * _drill_move() - queue one move of the cycle
+ *
+ *  A move that doesn't go anywhere (R at the initial Z, say) is dropped by mp_aline().
+ */
+
+static void _drill_move(const cmMotionMode motion_mode, const float x, const float y, const float z)
+{
+    drill.gm.motion_mode = motion_mode;
+    drill.gm.target[AXIS_X] = x;
+    drill.gm.target[AXIS_Y] = y;
+    drill.gm.target[AXIS_Z] = z;
+    mp_aline(&drill.gm);
+}
+
+/*
+ * _queue_drill_move() - queue the next move of the cycle. Returns true after the last one
+ */
+
+static bool _queue_drill_move()
+{
+    const float x = drill.gm.target[AXIS_X];
+    const float y = drill.gm.target[AXIS_Y];
+
+    switch (drill.step) {
+        case DRILL_PRELIMINARY: {
+            _drill_move(MOTION_MODE_STRAIGHT_TRAVERSE, x, y, drill.r_level);
+            drill.step = DRILL_POSITION;
+            break;
+        }
+        case DRILL_POSITION: {
+            _drill_move(MOTION_MODE_STRAIGHT_TRAVERSE, drill.hole[AXIS_X], drill.hole[AXIS_Y], drill.gm.target[AXIS_Z]);
+            drill.step = DRILL_RAPID_TO_R;
+            break;
+        }
+        case DRILL_RAPID_TO_R: {
+            _drill_move(MOTION_MODE_STRAIGHT_TRAVERSE, x, y, drill.r_level);
+            drill.depth = drill.r_level;
+            drill.step = DRILL_FEED;
+            break;
+        }
+        case DRILL_FEED: {
+            drill.depth -= drill.peck;
+            if (drill.depth <= drill.bottom) {
+                drill.depth = drill.bottom;
+                drill.step = (drill.dwell > 0) ? DRILL_DWELL : DRILL_RETRACT;
+            } else {
+                drill.step = DRILL_PECK_RETRACT;
+            }
+            _drill_move(MOTION_MODE_STRAIGHT_FEED, x, y, drill.depth);
+            break;
+        }
+        case DRILL_PECK_RETRACT: {
+            if (drill.cycle == MOTION_MODE_CANNED_CYCLE_83) {
+                _drill_move(MOTION_MODE_STRAIGHT_TRAVERSE, x, y, drill.r_level);
+                drill.step = DRILL_PECK_RETURN;
+            } else {
+                _drill_move(MOTION_MODE_STRAIGHT_TRAVERSE, x, y, min(drill.depth + DRILL_PECK_CLEARANCE, drill.r_level));
+                drill.step = DRILL_FEED;
+            }
+            break;
+        }
+        case DRILL_PECK_RETURN: {
+            _drill_move(MOTION_MODE_STRAIGHT_TRAVERSE, x, y, min(drill.depth + DRILL_PECK_CLEARANCE, drill.r_level));
+            drill.step = DRILL_FEED;
+            break;
+        }
+        case DRILL_DWELL: {
+            mp_dwell(drill.dwell);
+            drill.step = DRILL_RETRACT;
+            break;
+        }
+        case DRILL_RETRACT: {
+            _drill_move(MOTION_MODE_STRAIGHT_TRAVERSE, x, y, drill.clear_level);
+            if (--drill.holes == 0) {
+                return (true);
+            }
+            drill.hole[AXIS_X] += drill.increment[AXIS_X];
+            drill.hole[AXIS_Y] += drill.increment[AXIS_Y];
+            drill.step = DRILL_POSITION;
+            break;
+        }
+    }
+    return (false);
+}
@@ -36,6 +36,7 @@
 #include "encoder.h"
 #include "kinematics.h"
 #include "gpio.h"
+#include "stepper.h"
 #include "report.h"
 #include "util.h"
 
@@ -44,22 +45,27 @@
 struct hmHomingSingleton {          // persistent homing runtime variables
                                     // controls for homing cycle
     bool   waiting_for_motion_end;  // true when waiting for motion to complete.
-    int8_t axis;                    // axis currently being homed
-    int8_t homing_input;            // homing input for current axis
+    int8_t axis;                    // lead axis of the group currently being homed
+    int8_t homing_input;            // homing input for the lead axis
     bool   set_coordinates;         // G28.4 flag. true = set coords to zero at the end of homing cycle
     stat_t (*func)(int8_t axis);    // binding for callback function state machine
 
     bool axis_flags[AXES];          // local storage for axis flags
+    bool group[AXES];               // axes being homed together - see Parallel homing, below
+    bool single_pass;               // latch the group at its search edges - see Single-pass latch, below
+
+    // switch edges seen by the search, written by the input interrupt
+    volatile bool edge_taken[MOTORS];   // a leading edge was seen for the motor
+    float edge_steps[MOTORS];           // motor position (steps) at that edge
 
     // per-axis parameters
-    float direction;                // set to 1 for positive (max), -1 for negative (to min);
-    float search_travel;            // signed distance to travel in search
-    float search_velocity;          // search speed as positive number
-    float latch_backoff;            // max distance to back off switch during latch phase
-    float latch_velocity;           // latch speed as positive number
-    float zero_backoff;             // distance to back off switch before setting zero
-    float max_clear_backoff;        // maximum distance of switch clearing backoffs before erring out
-    float setpoint;                 // ultimate setpoint, usually zero, but not always
+    float search_travel[AXES];      // signed distance to travel in search
+    float search_velocity[AXES];    // search speed as positive number
+    float latch_backoff[AXES];      // max distance to back off switch during latch phase
+    float latch_velocity[AXES];     // latch speed as positive number
+    float zero_backoff[AXES];       // distance to back off switch before setting zero
+    float setpoint[AXES];           // ultimate setpoint, usually zero, but not always
+    float saved_jerk[AXES];         // saved and restored for each axis homed
 
     // state saved from gcode model
     cmUnitsMode    saved_units_mode;      // G20,G21 global setting
@@ -67,7 +73,6 @@ struct hmHomingSingleton {          // persistent homing runtime variables
     cmDistanceMode saved_distance_mode;   // G90, G91 global setting
     cmFeedRateMode saved_feed_rate_mode;  // G93, G94 global setting
     float          saved_feed_rate;       // F setting
-    float          saved_jerk;            // saved and restored for each axis homed
 };
 static struct hmHomingSingleton hm;
 
@@ -79,16 +84,19 @@ static stat_t _homing_axis_clear_init(int8_t axis);
 static stat_t _homing_axis_search(int8_t axis);
 static stat_t _homing_axis_clear(int8_t axis);
 static stat_t _homing_axis_latch(int8_t axis);
+static stat_t _homing_axis_edge_backoff(int8_t axis);
 static stat_t _homing_axis_setpoint_backoff(int8_t axis);
 static stat_t _homing_axis_set_position(int8_t axis);
-static stat_t _homing_axis_move(int8_t axis, float target, float velocity);
+static stat_t _homing_axis_move(int8_t axis, const float travel[], const float velocity[]);
 static stat_t _homing_error_exit(int8_t axis, stat_t status);
 static stat_t _homing_finalize_exit(int8_t axis);
 static int8_t _get_next_axis(int8_t axis);
 static void _homing_axis_move_callback(float* vect, bool* flag);
+static void _homing_set_group(bool is_homing);
 
 /**** HELPERS ***************************************************************************
  * _set_homing_func() - a convenience for setting the next dispatch vector and exiting
+ * _motor_homing_input() - the input that homes a motor: its own, or else its axis's
  */
 
 static stat_t _set_homing_func(stat_t (*func)(int8_t axis)) {
@@ -96,6 +104,13 @@ static stat_t _set_homing_func(stat_t (*func)(int8_t axis)) {
     return (STAT_EAGAIN);
 }
 
+static uint8_t _motor_homing_input(uint8_t motor) {
+    if (st_cfg.mot[motor].homing_input != 0) {
+        return (st_cfg.mot[motor].homing_input);
+    }
+    return (cm.a[st_cfg.mot[motor].motor_map].homing_input);
+}
+
 /***********************************************************************************
  **** G28.2 Homing Cycle ***********************************************************
  ***********************************************************************************/
@@ -137,6 +152,34 @@ static stat_t _set_homing_func(stat_t (*func)(int8_t axis)) {
  *
  *  Once all moves for an axis are complete the next axis in the sequence is homed
  *
+ *  --- Parallel homing ---
+ *
+ *  Axes with the same non-zero homing group {xhg:} are homed together, when the first
+ *  of them comes up in the sequence above. Each step is then one move for the whole
+ *  group, with every axis running its own travel at no more than its own velocity.
+ *  When a switch fires during a search or latch its motors are stopped dead at the
+ *  segment level, and the rest of the group carries on. The last switch in the group
+ *  stops the move with a feedhold as usual. Stopped axes are then re-based to where
+ *  their motors actually are before the next move.
+ *
+ *  A motor can have its own homing input {1hi:} instead of its axis's. That allows a
+ *  gantry driven by two motors to be squared: each side stops on its own switch, and
+ *  both are set to the same position at the end. Axes homed on their own behave as
+ *  they always have. In a group keep the search velocity low enough for a motor to be
+ *  stopped without losing steps. G28.4 always homes one axis at a time.
+ *
+ *  --- Single-pass latch ---
+ *
+ *  The slow latch pass (steps 3 and 4) is there because the search runs past the switch
+ *  before it stops. But the input interrupt records each motor's position at the switch
+ *  edge, so the search already knows exactly where the switch is. With {xhl:1} set on
+ *  every axis of the group steps 3 and 4 are skipped: each axis is set from how far it
+ *  ran past its edge, and backs off from there straight to its setpoint. That takes one
+ *  approach instead of three. The edge is only as exact as the switch is repeatable at
+ *  search speed - use the slow pass if it isn't. A gantry with a switch per motor still
+ *  sets both motors to one position, so they square to within the distance the search
+ *  runs in a segment, and G28.4 always uses the slow pass.
+ *
  *  When a homing cycle is initiated the homing state is set to HOMING_NOT_HOMED
  *  When homing completes successfully this is set to HOMING_HOMED, otherwise it
  *  remains HOMING_NOT_HOMED.
@@ -199,15 +242,95 @@ stat_t cm_homing_cycle_callback(void) {
 }
 
 /*
- * Homing axis moves - these execute in sequence for each axis
+ * cm_homing_switch() - a homing input fired. Called from the input interrupt
+ *
+ *  Records where the motors homed by that input were at the edge, and stops them. If that
+ *  leaves none of the group moving - always the case when homing one axis - it leaves the
+ *  motors running and requests a feedhold to bring the move to a stop, like any other
+ *  homing move.
+ */
+
+void cm_homing_switch(uint8_t input) {
+    for (uint8_t motor = 0; motor < MOTORS; motor++) {   // record the edge before a later one overwrites the snapshot
+        uint8_t axis = st_cfg.mot[motor].motor_map;
+        if ((axis < AXES) && hm.group[axis] && !hm.edge_taken[motor] && (_motor_homing_input(motor) == input)) {
+            hm.edge_steps[motor] = en_get_encoder_snapshot_steps(motor);
+            hm.edge_taken[motor] = true;
+        }
+    }
+
+    bool running = false;
+    for (uint8_t motor = 0; motor < MOTORS; motor++) {
+        uint8_t axis = st_cfg.mot[motor].motor_map;
+        if ((axis < AXES) && hm.group[axis] && !st_motor_stopped(motor) && (_motor_homing_input(motor) != input)) {
+            running = true;
+            break;
+        }
+    }
+    if (!running) {
+        cm_start_hold();
+        return;
+    }
+    for (uint8_t motor = 0; motor < MOTORS; motor++) {
+        uint8_t axis = st_cfg.mot[motor].motor_map;
+        if ((axis < AXES) && hm.group[axis] && (_motor_homing_input(motor) == input)) {
+            st_stop_motor(motor);
+        }
+    }
+}
+
+/*
+ * _homing_set_group()   - set homing mode on the inputs of the group, or clear it
+ * _homing_sync_stopped() - re-base stopped axes to their motors and release them
+ */
+
+static void _homing_set_group(bool is_homing) {
+    for (uint8_t motor = 0; motor < MOTORS; motor++) {
+        uint8_t axis = st_cfg.mot[motor].motor_map;
+        if ((axis < AXES) && hm.group[axis]) {
+            gpio_set_homing_mode(_motor_homing_input(motor), is_homing);
+        }
+    }
+    gpio_set_homing_mode(hm.homing_input, is_homing);
+}
+
+static void _homing_sync_stopped() {
+    float position[AXES];
+    bool stopped[AXES] = { false };
+    bool any = false;
+
+    for (uint8_t motor = 0; motor < MOTORS; motor++) {
+        if (st_motor_stopped(motor) && (st_cfg.mot[motor].motor_map < AXES)) {
+            stopped[st_cfg.mot[motor].motor_map] = true;
+            any = true;
+        }
+    }
+    if (!any) {
+        return;
+    }
+    en_take_encoder_snapshot();                 // includes steps not yet folded into the encoders
+    st_release_motors();
+    kn_forward_kinematics(en_get_encoder_snapshot_vector(), position);
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        if (stopped[axis]) {
+            cm_set_position(axis, position[axis]);
+        }
+    }
+}
+
+/*
+ * Homing axis moves - these execute in sequence for each axis, or each group of axes
  *
- *  _homing_axis_start()        - get next axis, initialize variables, call the clear
+ *  _homing_axis_start()        - get next axis and its group, initialize variables, call the clear
  *  _homing_axis_clear_init()   - initiate a clear to move off a switch that is thrown at the start
  *  _homing_axis_search()       - fast search for switch, closes switch
  *  _homing_axis_clear()        - clear off the switch
  *  _homing_axis_latch()        - slow drive until until switch closes again
+ *  _homing_axis_edge_backoff() - single-pass: set position from the search edge, backoff to the setpoint
  *  _homing_axis_final()        - backoff from latch location to zero position
  *  _homing_axis_move()         - helper that actually executes the above moves
+ *
+ *  Each takes the lead axis of the group. All axes in hm.group[] move together.
  */
 
 static stat_t _homing_axis_start(int8_t axis) {
@@ -220,86 +343,133 @@ static stat_t _homing_axis_start(int8_t axis) {
             return (_homing_error_exit(-2, STAT_HOMING_ERROR_BAD_OR_NO_AXIS));
         }
     }
-    // clear the homed flag for axis so we'll be able to move w/o triggering soft limits
-    cm.homed[axis] = false;
 
-    // trap axis mis-configurations
-    if (fp_ZERO(cm.a[axis].homing_input)) {
-        return (_homing_error_exit(axis, STAT_HOMING_ERROR_HOMING_INPUT_MISCONFIGURED));
-    }
-    if (fp_ZERO(cm.a[axis].search_velocity)) {
-        return (_homing_error_exit(axis, STAT_HOMING_ERROR_ZERO_SEARCH_VELOCITY));
+    // the lead axis brings the rest of its group with it. G28.4 homes each axis alone
+    uint8_t group = hm.set_coordinates ? cm.a[axis].homing_group : 0;
+    for (uint8_t a = 0; a < AXES; a++) {
+        hm.group[a] = (a == axis) || ((group != 0) && hm.axis_flags[a] && (cm.a[a].homing_group == group));
+        if (hm.group[a] && (a != axis)) {
+            hm.axis_flags[a] = false;               // so _get_next_axis() won't come back to it
+        }
     }
-    if (fp_ZERO(cm.a[axis].latch_velocity)) {
-        return (_homing_error_exit(axis, STAT_HOMING_ERROR_ZERO_LATCH_VELOCITY));
+
+    for (uint8_t a = 0; a < AXES; a++) {
+        if (!hm.group[a]) {
+            continue;
+        }
+        // clear the homed flag for axis so we'll be able to move w/o triggering soft limits
+        cm.homed[a] = false;
+        cm_update_soft_limits();
+
+        // trap axis mis-configurations
+        if (fp_ZERO(cm.a[a].homing_input)) {
+            return (_homing_error_exit(a, STAT_HOMING_ERROR_HOMING_INPUT_MISCONFIGURED));
+        }
+        if (fp_ZERO(cm.a[a].search_velocity)) {
+            return (_homing_error_exit(a, STAT_HOMING_ERROR_ZERO_SEARCH_VELOCITY));
+        }
+        if (fp_ZERO(cm.a[a].latch_velocity)) {
+            return (_homing_error_exit(a, STAT_HOMING_ERROR_ZERO_LATCH_VELOCITY));
+        }
+
+        // calculate and test travel distance
+        float travel_distance = fabs(cm.a[a].travel_max - cm.a[a].travel_min) + cm.a[a].latch_backoff;
+        if (fp_ZERO(travel_distance)) {
+            return (_homing_error_exit(a, STAT_HOMING_ERROR_TRAVEL_MIN_MAX_IDENTICAL));
+        }
+
+        hm.search_velocity[a] = fabs(cm.a[a].search_velocity);  // search velocity is always positive
+        hm.latch_velocity[a]  = fabs(cm.a[a].latch_velocity);   // latch velocity is always positive
+
+        bool homing_to_max = cm.a[a].homing_dir;
+
+        // setup parameters for positive or negative travel (homing to the max or min switch)
+        if (homing_to_max) {
+            hm.search_travel[a] = travel_distance;                      // search travels in positive direction
+            hm.latch_backoff[a] = fabs(cm.a[a].latch_backoff);          // latch travels in positive direction
+            hm.zero_backoff[a]  = -max(0.0f, cm.a[a].zero_backoff);     // zero backoff is negative direction (or zero)
+                                                                        // will set the maximum position
+                                                                        //     (plus any negative backoff)
+            hm.setpoint[a] = cm.a[a].travel_max + (max(0.0f, -cm.a[a].zero_backoff));
+        } else {
+            hm.search_travel[a] = -travel_distance;                     // search travels in negative direction
+            hm.latch_backoff[a] = -fabs(cm.a[a].latch_backoff);         // latch travels in negative direction
+            hm.zero_backoff[a]  = max(0.0f, cm.a[a].zero_backoff);      // zero backoff is positive direction (or zero)
+                                                                        // will set the minimum position
+                                                                        //     (minus any negative backoff)
+            hm.setpoint[a] = cm.a[a].travel_min + (max(0.0f, -cm.a[a].zero_backoff));
+        }
+        hm.saved_jerk[a] = cm_get_axis_jerk(a);                 // save the max jerk value
     }
 
-    // calculate and test travel distance
-    float travel_distance = fabs(cm.a[axis].travel_max - cm.a[axis].travel_min) + cm.a[axis].latch_backoff;
-    if (fp_ZERO(travel_distance)) {
-        return (_homing_error_exit(axis, STAT_HOMING_ERROR_TRAVEL_MIN_MAX_IDENTICAL));
+    // latch at the search edges only if every axis in the group asks for it
+    hm.single_pass = hm.set_coordinates;
+    for (uint8_t a = 0; a < AXES; a++) {
+        if (hm.group[a] && !cm.a[a].homing_latch) {
+            hm.single_pass = false;
+        }
     }
 
     // Nothing to do about direction now that direction is explicit
     // However, here's a good place to stash the homing_switch:
     hm.homing_input = cm.a[axis].homing_input;
-    gpio_set_homing_mode(hm.homing_input, true);
-    hm.axis            = axis;                              // persist the axis
-    hm.search_velocity = fabs(cm.a[axis].search_velocity);  // search velocity is always positive
-    hm.latch_velocity  = fabs(cm.a[axis].latch_velocity);   // latch velocity is always positive
-
-    bool homing_to_max = cm.a[axis].homing_dir;
-
-    // setup parameters for positive or negative travel (homing to the max or min switch)
-    if (homing_to_max) {
-        hm.search_travel = travel_distance;                      // search travels in positive direction
-        hm.latch_backoff = fabs(cm.a[axis].latch_backoff);       // latch travels in positive direction
-        hm.zero_backoff  = -max(0.0f, cm.a[axis].zero_backoff);  // zero backoff is negative direction (or zero)
-                                                                 // will set the maximum position
-                                                                 //     (plus any negative backoff)
-        hm.setpoint = cm.a[axis].travel_max + (max(0.0f, -cm.a[axis].zero_backoff));
-    } else {
-        hm.search_travel = -travel_distance;                    // search travels in negative direction
-        hm.latch_backoff = -fabs(cm.a[axis].latch_backoff);     // latch travels in negative direction
-        hm.zero_backoff  = max(0.0f, cm.a[axis].zero_backoff);  // zero backoff is positive direction (or zero)
-                                                                // will set the minimum position
-                                                                //     (minus any negative backoff)
-        hm.setpoint = cm.a[axis].travel_min + (max(0.0f, -cm.a[axis].zero_backoff));
-    }
-
-    // if homing is disabled for the axis then skip to the next axis
-    hm.saved_jerk = cm_get_axis_jerk(axis);              // save the max jerk value
-    return (_set_homing_func(_homing_axis_clear_init));  // perform an initial clear
+    hm.axis         = axis;                                     // persist the axis
+    _homing_set_group(true);
+    return (_set_homing_func(_homing_axis_clear_init));        // perform an initial clear
 }
 
 // Handle an initial switch closure by backing off the closed switch
 // NOTE: clear_init() relies on independent switches per axis (not shared)
 static stat_t _homing_axis_clear_init(int8_t axis)  // first clear move
 {
-    if (gpio_read_input(hm.homing_input) == INPUT_ACTIVE) {  // the switch is closed at startup
-
-        // determine if the input switch for this axis is shared w/other axes
-        for (uint8_t check_axis = AXIS_X; check_axis < AXES; check_axis++) {
-            if (axis != check_axis && cm.a[check_axis].homing_input == hm.homing_input) {
-                return (_homing_error_exit(
-                    axis, STAT_HOMING_ERROR_MUST_CLEAR_SWITCHES_BEFORE_HOMING));  // axis cannot be homed
+    float travel[AXES] = { 0 };
+    bool closed = false;
+
+    for (uint8_t a = 0; a < AXES; a++) {
+        if (hm.group[a] && (gpio_read_input(cm.a[a].homing_input) == INPUT_ACTIVE)) {  // the switch is closed at startup
+
+            // determine if the input switch for this axis is shared w/other axes
+            for (uint8_t check_axis = AXIS_X; check_axis < AXES; check_axis++) {
+                if (a != check_axis && cm.a[check_axis].homing_input == cm.a[a].homing_input) {
+                    return (_homing_error_exit(
+                        a, STAT_HOMING_ERROR_MUST_CLEAR_SWITCHES_BEFORE_HOMING));  // axis cannot be homed
+                }
             }
+            travel[a] = -hm.latch_backoff[a];                  // otherwise back off the switch
+            closed = true;
         }
-        _homing_axis_move(axis, -hm.latch_backoff, hm.search_velocity);  // otherwise back off the switch
+    }
+    if (closed) {
+        _homing_axis_move(axis, travel, hm.search_velocity);
     }
     return (_set_homing_func(_homing_axis_search));  // start the search
 }
 
 static stat_t _homing_axis_search(int8_t axis)  // drive to switch
 {
-    cm_set_axis_jerk(axis, cm.a[axis].jerk_high);  // use the high-speed jerk for search onward
+    for (uint8_t a = 0; a < AXES; a++) {
+        if (hm.group[a]) {
+            cm_set_axis_jerk(a, cm.a[a].jerk_high);  // use the high-speed jerk for search onward
+        }
+    }
+    for (uint8_t motor = 0; motor < MOTORS; motor++) {
+        hm.edge_taken[motor] = false;
+    }
     _homing_axis_move(axis, hm.search_travel, hm.search_velocity);
+    if (hm.single_pass) {
+        return (_set_homing_func(_homing_axis_edge_backoff));
+    }
     return (_set_homing_func(_homing_axis_clear));
 }
 
 static stat_t _homing_axis_clear(int8_t axis)  // drive away from switch at search speed
 {
-    _homing_axis_move(axis, -hm.latch_backoff, hm.search_velocity);
+    float travel[AXES];
+    for (uint8_t a = 0; a < AXES; a++) {
+        travel[a] = -hm.latch_backoff[a];
+    }
+    _homing_sync_stopped();
+    _homing_axis_move(axis, travel, hm.search_velocity);
     return (_set_homing_func(_homing_axis_latch));
 }
 
@@ -309,8 +479,58 @@ static stat_t _homing_axis_latch(int8_t axis)  // drive to switch at low speed
     return (_set_homing_func(_homing_axis_setpoint_backoff));
 }
 
+/*
+ *  An axis that ran past its edge by some distance is that far past the point the zero
+ *  backoff starts from, so the whole backoff is one move to the setpoint. The distance
+ *  is taken in the motor frame - the edge steps against the steps now - as the search
+ *  stopped on a hold or a stopped motor, not at a planned position.
+ */
+static stat_t _homing_axis_edge_backoff(int8_t axis)
+{
+    float now[AXES];
+    float edge[AXES];
+    float edge_steps[MOTORS];
+    float travel[AXES] = { 0 };
+
+    _homing_sync_stopped();
+    en_take_encoder_snapshot();
+    copy_vector(edge_steps, en_get_encoder_snapshot_vector());
+    kn_forward_kinematics(edge_steps, now);
+
+    for (uint8_t a = 0; a < AXES; a++) {
+        if (hm.group[a]) {
+            bool found = false;
+            for (uint8_t motor = 0; motor < MOTORS; motor++) {
+                if ((st_cfg.mot[motor].motor_map == a) && hm.edge_taken[motor]) {
+                    found = true;
+                }
+            }
+            if (!found) {
+                return (_homing_error_exit(a, STAT_HOMING_ERROR_SWITCH_NOT_FOUND));
+            }
+        }
+    }
+    for (uint8_t motor = 0; motor < MOTORS; motor++) {
+        if (hm.edge_taken[motor]) {
+            edge_steps[motor] = hm.edge_steps[motor];
+        }
+    }
+    kn_forward_kinematics(edge_steps, edge);
+
+    for (uint8_t a = 0; a < AXES; a++) {
+        if (hm.group[a]) {
+            float position = hm.setpoint[a] - hm.zero_backoff[a] + (now[a] - edge[a]);
+            cm_set_position(a, position);
+            travel[a] = hm.setpoint[a] - position;
+        }
+    }
+    _homing_axis_move(axis, travel, hm.search_velocity);
+    return (_set_homing_func(_homing_axis_set_position));
+}
+
 static stat_t _homing_axis_setpoint_backoff(int8_t axis)  // backoff to zero or max setpoint position
 {
+    _homing_sync_stopped();
     _homing_axis_move(axis, hm.zero_backoff, hm.search_velocity);
     return (_set_homing_func(_homing_axis_set_position));
 }
@@ -318,29 +538,57 @@ static stat_t _homing_axis_setpoint_backoff(int8_t axis)  // backoff to zero or
 static stat_t _homing_axis_set_position(int8_t axis)  // set axis zero / max and finish up
 {
     if (hm.set_coordinates) {
-        cm_set_position(axis, hm.setpoint);
-        cm.homed[axis] = true;
-
+        for (uint8_t a = 0; a < AXES; a++) {
+            if (hm.group[a]) {
+                cm_set_position(a, hm.setpoint[a]);
+                cm.homed[a] = true;
+            }
+        }
+        cm_update_soft_limits();
     } else {  // handle G28.4 cycle - set position to the point of switch closure
         float contact_position[AXES];
+        float travel[AXES] = { 0 };
         kn_forward_kinematics(en_get_encoder_snapshot_vector(), contact_position);
-        _homing_axis_move(axis, contact_position[AXIS_Z], hm.search_velocity);
+        travel[axis] = contact_position[AXIS_Z];
+        _homing_axis_move(axis, travel, hm.search_velocity);
+    }
+    for (uint8_t a = 0; a < AXES; a++) {
+        if (hm.group[a]) {
+            cm_set_axis_jerk(a, hm.saved_jerk[a]);  // restore the max jerk value
+        }
     }
-    cm_set_axis_jerk(axis, hm.saved_jerk);  // restore the max jerk value
 
-    gpio_set_homing_mode(hm.homing_input, false);  // end homing mode
+    _homing_set_group(false);  // end homing mode
     return (_set_homing_func(_homing_axis_start));
 }
 
-static stat_t _homing_axis_move(int8_t axis, float target, float velocity) {
+/*
+ * _homing_axis_move() - move the group, each axis by its travel at up to its velocity
+ *
+ *  The feed rate is set so the axis that takes longest runs at its own velocity. The
+ *  others cover their travel in the same time, so none exceeds its velocity.
+ */
+
+static stat_t _homing_axis_move(int8_t axis, const float travel[], const float velocity[]) {
     float vect[]  = {0, 0, 0, 0, 0, 0};
+    float zero[]  = {0, 0, 0, 0, 0, 0};
     bool  flags[] = {false, false, false, false, false, false};
+    float move_time = 0;                // minutes
 
     hm.waiting_for_motion_end = true;
 
-    vect[axis]  = target;
-    flags[axis] = true;
-    cm_set_feed_rate(velocity);
+    for (uint8_t a = 0; a < AXES; a++) {
+        if (hm.group[a] && fp_NOT_ZERO(travel[a])) {
+            vect[a]  = travel[a];
+            flags[a] = true;
+            move_time = max(move_time, fabs(travel[a]) / velocity[a]);
+        }
+    }
+    if (fp_ZERO(move_time)) {           // nothing to move
+        hm.waiting_for_motion_end = false;
+        return (STAT_EAGAIN);
+    }
+    cm_set_feed_rate(get_axis_vector_length(vect, zero) / move_time);
 
     stat_t status = cm_straight_feed(vect, flags);
     if (status != STAT_OK) {
@@ -385,6 +633,8 @@ static stat_t _homing_error_exit(int8_t axis, stat_t status) {
 
 static stat_t _homing_finalize_exit(int8_t axis)  // third part of return to home
 {
+    st_release_motors();                         // in case an error left a group stopped
+    _homing_set_group(false);
     cm_set_coord_system(hm.saved_coord_system);  // restore to work coordinate system
     cm_set_units_mode(hm.saved_units_mode);
     cm_set_distance_mode(hm.saved_distance_mode);
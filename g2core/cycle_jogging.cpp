@@ -31,8 +31,10 @@
 #include "text_parser.h"
 #include "canonical_machine.h"
 #include "planner.h"
+#include "stepper.h"
 #include "util.h"
 #include "xio.h"
+#include "MotateTimers.h"
 
 /**** Jogging singleton structure ****/
 
@@ -44,6 +46,7 @@ struct jmJoggingSingleton {         // persistent jogging runtime variables
     float   velocity_start;         // initial jog feed
     float   velocity_max;
     uint8_t step;                   // what step of the ramp the jogging cycle is currently on
+    uint32_t update_tick;           // SysTick time of the last velocity jog update
 
     uint8_t (*func)(int8_t axis);   // binding for callback function state machine
 
@@ -65,6 +68,7 @@ static stat_t _jogging_axis_start(int8_t axis);
 static stat_t _jogging_axis_ramp_jog(int8_t axis);
 static stat_t _jogging_axis_move(int8_t axis, float target, float velocity);
 static stat_t _jogging_finalize_exit(int8_t axis);
+static stat_t _jogging_velocity_run(int8_t axis);
 
 /*****************************************************************************
  * cm_jogging_cycle_start() - jogging cycle using soft limits
@@ -201,6 +205,79 @@ static stat_t _jogging_finalize_exit(int8_t axis)  // finish a jog
     return (STAT_OK);
 }
 
+/*****************************************************************************
+ * cm_jog_velocity() - start or steer a velocity jog        {"jv":{"x":1200,"y":-300}}
+ *
+ *  Velocity jogging follows a target velocity vector in machine coordinates - mm/min, or
+ *  degrees/min for rotary axes - with each axis capped at its velocity maximum. The ramps
+ *  are run by exec (see mp_jog_start()) and use no planner buffers, so a pendant can send
+ *  updates at up to 100 Hz and see them take effect on the next segment.
+ *
+ *  The first non-zero vector starts the cycle if the machine is idle. A zero vector ramps
+ *  to a stop and ends the cycle once the axes are still. If updates stop arriving for
+ *  JOG_VELOCITY_TIMEOUT_MS the jog is stopped, so a pendant that drops out can't leave the
+ *  machine running. A feedhold stops the jog, and later updates are ignored until it ends.
+ */
+
+stat_t cm_jog_velocity(float velocity[])
+{
+    bool moving = false;
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        velocity[axis] = min(max(velocity[axis], -cm.a[axis].velocity_max), cm.a[axis].velocity_max);
+        if (fp_NOT_ZERO(velocity[axis])) {
+            moving = true;
+        }
+    }
+    if ((cm.cycle_state == CYCLE_JOG) && (jog.func == _jogging_velocity_run)) {
+        jog.update_tick = SysTickTimer.getValue();
+        if (mp_jog_is_active()) {
+            mp_jog_velocity(velocity);
+        } else if (moving && !mr.jog.stop) {            // stopped at zero, not yet finalized
+            mp_jog_start(velocity);
+        }
+        return (STAT_OK);
+    }
+    if (!moving) {
+        return (STAT_OK);
+    }
+    ritorno(cm_is_alarmed());
+    if ((cm.cycle_state != CYCLE_OFF) || mp_get_runtime_busy() || mp_has_runnable_buffer()) {
+        for (uint8_t axis = 0; axis < AXES; axis++) {
+            velocity[axis] = 0;
+        }
+        return (STAT_COMMAND_NOT_ACCEPTED);             // only jog from idle
+    }
+    jog.update_tick = SysTickTimer.getValue();
+    jog.axis = -1;
+    jog.func = _jogging_velocity_run;
+    cm.machine_state = MACHINE_CYCLE;
+    cm.cycle_state   = CYCLE_JOG;
+    mp_jog_start(velocity);
+    return (STAT_OK);
+}
+
+static stat_t _jogging_velocity_run(int8_t axis)
+{
+    if (mp_jog_is_active()) {
+        if ((SysTickTimer.getValue() - jog.update_tick) > JOG_VELOCITY_TIMEOUT_MS) {
+            mp_jog_stop();                              // host has gone quiet
+        }
+        return (STAT_EAGAIN);
+    }
+    if (st_runtime_isbusy()) {
+        return (STAT_EAGAIN);                           // let the last segments run out
+    }
+    for (uint8_t i = 0; i < AXES; i++) {                // the jog moved the runtime on its own
+        float position = mp_get_runtime_absolute_position(i);
+        cm.gmx.position[i] = position;
+        mp_set_planner_position(i, position);
+        cm.jog_velocity[i] = 0;
+    }
+    cm_canned_cycle_end();
+    xio_writeline("{\"jog\":0}\n");                   // needed by OMC jogging function
+    return (STAT_OK);
+}
+
 /*
 static stat_t _jogging_error_exit(int8_t axis)
 {
@@ -42,6 +42,7 @@
 /**** Probe singleton structure ****/
 
 #define MINIMUM_PROBE_TRAVEL 0.254      // mm of travel below which the probe will err out
+#define SCAN_POINTS_PER_LINE 10         // G38.6 results sent per line of the report
 
 struct pbProbingSingleton {             // persistent probing runtime variables
 
@@ -56,6 +57,16 @@ struct pbProbingSingleton {             // persistent probing runtime variables
     bool wait_for_motion_end;           // flag to know when the motion has ended
     stat_t (*func)();                   // binding for callback function state machine
 
+    // G38.6 scan
+    uint16_t scan_points;               // points in the grid
+    uint16_t scan_index;                // point being probed, in the order they are run
+    uint16_t scan_report;               // next result to report
+    uint8_t scan_columns;               // copied from cm.scan_columns at the start
+    float scan_start[AXES];             // first point, at the retract height
+    float scan_step[2];                 // grid spacing in X and Y
+    float scan_depth;                   // Z to probe down to
+    float scan_results[SCAN_POINTS_MAX];// contact Z of each point, row by row along X
+
     // saved gcode model state
     cmUnitsMode saved_units_mode;       // G20,G21 setting
     cmDistanceMode saved_distance_mode; // G90,G91 global setting
@@ -66,19 +77,37 @@ static struct pbProbingSingleton pb;
 
 /**** NOTE: global prototypes and other .h info is located in canonical_machine.h ****/
 
+static stat_t _probing_setup();
 static stat_t _probing_start();
 static stat_t _probing_backoff();
 static stat_t _probing_finish();
 static stat_t _probing_exception_exit(stat_t status);
 static stat_t _probe_move(const float target[], const bool flags[]);
 static void _send_probe_report(void);
+static stat_t _scan_start();
+static stat_t _scan_contact();
+static stat_t _scan_report();
+static uint16_t _scan_point(uint16_t index, float target[]);
+static void _probe_restore_settings();
 
-// helper
+// helpers
 static void _motion_end_callback(float* vect, bool* flag)
 {
     pb.wait_for_motion_end = false;
 }
 
+// The hold that stops a probe move drops the rest of the move, so the model and planner
+// are left at its target. Bring them back to where the runtime actually stopped before
+// planning anything from here.
+static void _probe_sync_position()
+{
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        float position = mp_get_runtime_absolute_position(axis);
+        cm.gmx.position[axis] = position;
+        mp_set_planner_position(axis, position);
+    }
+}
+
 /***********************************************************************************
  **** G38.x Probing Cycle **********************************************************
  ***********************************************************************************/
@@ -100,6 +129,11 @@ static void _motion_end_callback(float* vect, bool* flag)
  *  on the encoder snapshot to get the reported position. We also execute a move
  *  from the final position (after the feedhold) back to the point we report.
  *
+ *  The snapshot counts steps to the DDA tick (or reads the hardware encoders) at the
+ *  instant the input fires, and is latched for the first edge only, so the result
+ *  doesn't depend on how far the machine travels while the hold brings it to a stop.
+ *  That makes it safe to probe at a much higher feed rate.
+ *
  *  Additionally, we record the last PROBES_STORED (at least 3) probe points that
  *  succeeded. The current or most recent probe (be it success, failure, or
  *  in-progress) occupies one of those positions, which is the one reported by the
@@ -198,10 +232,11 @@ uint8_t cm_probing_cycle_callback(void)
 }
 
 /***********************************************************************************
+ * _probing_setup() - set up for probing moves, shared by G38.2 - G38.6
  * _probing_start() - start the probe or skip it if contact is already active
  */
 
-static uint8_t _probing_start() 
+static stat_t _probing_setup()
 {
     // so optimistic... ;)
     // These initializations are required before starting the probing cycle but must
@@ -234,6 +269,7 @@ static uint8_t _probing_start()
         return(_probing_exception_exit(STAT_PROBE_TRAVEL_TOO_SMALL));
     }
 
+    en_clear_encoder_snapshot();                // arm the latch before the input can fire
     gpio_set_probing_mode(pb.probe_input, true);
 
     // Get initial probe state, and don't probe if we're already tripped.
@@ -241,6 +277,12 @@ static uint8_t _probing_start()
     if (pb.trip_sense == gpio_read_input(pb.probe_input)) {     // == is exclusive nor for booleans
         return(_probing_exception_exit(STAT_PROBE_IS_ALREADY_TRIPPED));
     }
+    return (STAT_OK);
+}
+
+static stat_t _probing_start()
+{
+    ritorno(_probing_setup());
 
     // Everything checks out. Run the probe move    
     _probe_move(pb.target, pb.flags);
@@ -258,12 +300,14 @@ static stat_t _probing_backoff()
 {
     // Test if we've contacted. If so, do the backoff. Convert the contact position 
     // captured from the encoder in step space to steps to mm. The encoder snapshot 
-    // was taken by input interrupt at the time of closure.
+    // was latched by input interrupt at the time of closure, so the input may have
+    // let go again by the time the hold has stopped the machine.
 
-    if (pb.trip_sense == gpio_read_input(pb.probe_input)) {  // exclusive or for booleans
+    if (en_encoder_snapshot_latched()) {
         cm.probe_state[0] = PROBE_SUCCEEDED;
         float contact_position[AXES];
         kn_forward_kinematics(en_get_encoder_snapshot_vector(), contact_position);
+        _probe_sync_position();
         _probe_move(contact_position, pb.flags);   // NB: feed rate is the same as the probe move
     } else {
         cm.probe_state[0] = PROBE_FAILED;
@@ -272,6 +316,198 @@ static stat_t _probing_backoff()
     return (STAT_EAGAIN);
 }
 
+/***********************************************************************************
+ **** G38.6 Scan Probing Cycle *****************************************************
+ ***********************************************************************************/
+
+/***********************************************************************************
+ * cm_scan_probe() - G38.6 probe a grid of points in Z and report them all at the end
+ *
+ *  G38.6 X Y Z probes a grid of {scnc:} by {scnr:} points. The first point is the current
+ *  position and the opposite corner is X,Y. Omitting X or Y leaves that axis where it is.
+ *  Each point is probed down to Z at the current feed rate, then the tool retracts to the
+ *  starting height before crossing to the next one. The rows are run alternately forward
+ *  and back to keep the crossings short.
+ *
+ *  Each contact is taken from the latched encoder snapshot like G38.2, but the results are
+ *  only kept in RAM (up to SCAN_POINTS_MAX) and nothing goes back to the host until the last
+ *  point is done. The retract, the crossing and the next probe move are queued together, so
+ *  the planner blends them and the only stop is at the contact itself.
+ *
+ *  The report is a series of lines {"scn":[i,z,z,...]} with up to SCAN_POINTS_PER_LINE
+ *  heights, where i is the (row by row) index of the first point on the line, followed by
+ *  {"scn":{"n":<points>,"m":<missed>}}. Heights are in absolute machine coordinates and mm,
+ *  as for {prb:}. A point that doesn't make contact reports the Z it went down to and is
+ *  counted as missed. Missing points does not alarm.
+ */
+
+stat_t cm_scan_probe(float target[], bool flags[])
+{
+    if (fp_ZERO(cm.gm.feed_rate)) {
+        return(cm_alarm(STAT_GCODE_FEEDRATE_NOT_SPECIFIED, "Feedrate is zero"));
+    }
+    if (!flags[AXIS_Z]) {
+        return(cm_alarm(STAT_GCODE_AXIS_IS_MISSING, "Axis is missing"));
+    }
+    uint16_t points = (uint16_t)cm.scan_columns * cm.scan_rows;
+    if ((points == 0) || (points > SCAN_POINTS_MAX)) {
+        return(cm_alarm(STAT_INPUT_EXCEEDS_MAX_VALUE, "Too many scan points"));
+    }
+    if ((pb.probe_input = gpio_get_probing_input()) == -1) {
+        return(cm_alarm(STAT_NO_PROBE_INPUT_CONFIGURED, "No probe input"));
+    }
+#if HEIGHT_MAP_ENABLED == true
+    if (kn_hmap.enable) {                   // the scan would measure the surface less the old map
+        return(cm_alarm(STAT_COMMAND_NOT_ACCEPTED, "Height map is on"));
+    }
+#endif
+
+    // setup
+    pb.alarm_flag = false;
+    pb.trip_sense = true;                   // contact closure trips the probe, like G38.3
+    pb.func = _scan_start;
+
+    cm_set_model_target(target, flags);     // canonical form, taking all offsets into account
+    copy_vector(pb.scan_start, cm.gmx.position);
+    pb.scan_depth = cm.gm.target[AXIS_Z];
+    pb.scan_columns = cm.scan_columns;
+    pb.scan_step[0] = (cm.scan_columns > 1) ? (cm.gm.target[AXIS_X] - pb.scan_start[AXIS_X]) / (cm.scan_columns - 1) : 0;
+    pb.scan_step[1] = (cm.scan_rows > 1) ? (cm.gm.target[AXIS_Y] - pb.scan_start[AXIS_Y]) / (cm.scan_rows - 1) : 0;
+    pb.scan_points = points;
+    pb.scan_index = 0;
+    pb.scan_report = 0;
+    cm.scan_count = 0;
+    cm.scan_missed = 0;
+
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        pb.flags[axis] = (axis == AXIS_Z);  // the probe moves are Z only
+    }
+    _scan_point(0, pb.target);
+
+    cm.probe_state[0] = PROBE_WAITING;      // wait until planner queue empties before starting movement
+    pb.wait_for_motion_end = true;
+    mp_queue_command(_motion_end_callback, nullptr, nullptr);
+    return (STAT_OK);
+}
+
+/*
+ * _scan_point() - get the probe target for the index'th point run, and its slot in the results
+ */
+
+static uint16_t _scan_point(uint16_t index, float target[])
+{
+    uint16_t row = index / pb.scan_columns;
+    uint16_t column = index % pb.scan_columns;
+    if (row & 1) {                          // odd rows run backwards
+        column = pb.scan_columns - 1 - column;
+    }
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        target[axis] = pb.scan_start[axis];
+    }
+    target[AXIS_X] += column * pb.scan_step[0];
+    target[AXIS_Y] += row * pb.scan_step[1];
+    target[AXIS_Z] = pb.scan_depth;
+    return (row * pb.scan_columns + column);
+}
+
+/*
+ * _scan_arm_callback() - re-arm the probe latch on the way into the next point
+ *
+ *  Queued ahead of each probe move after the first. The latch stays set through the
+ *  retract so the probe letting go can't be taken for a contact. If the probe is still
+ *  tripped when the next move starts, latch it again at once so the move stops there.
+ */
+
+static void _scan_arm_callback(float* vect, bool* flag)
+{
+    en_clear_encoder_snapshot();
+    if (pb.trip_sense == gpio_read_input(pb.probe_input)) {
+        en_latch_encoder_snapshot();
+        cm_start_hold();
+    }
+}
+
+static stat_t _scan_start()
+{
+    ritorno(_probing_setup());
+    _probe_move(pb.target, pb.flags);
+    pb.func = _scan_contact;
+    return (STAT_EAGAIN);
+}
+
+/*
+ * _scan_contact() - runs after each probe move, whether it contacted or not
+ */
+
+static stat_t _scan_contact()
+{
+    float contact_position[AXES];
+    uint16_t slot = _scan_point(pb.scan_index, contact_position);
+
+    if (en_encoder_snapshot_latched()) {
+        kn_forward_kinematics(en_get_encoder_snapshot_vector(), contact_position);
+    } else {
+        cm.scan_missed++;                   // leaves the target depth in contact_position
+    }
+    pb.scan_results[slot] = contact_position[AXIS_Z];
+    cm.scan_count++;
+    _probe_sync_position();
+
+    // retract straight up to the starting height
+    float retract[AXES];
+    copy_vector(retract, cm.gmx.position);
+    retract[AXIS_Z] = pb.scan_start[AXIS_Z];
+    cm_straight_traverse(retract, pb.flags);
+
+    if (++pb.scan_index == pb.scan_points) {
+        pb.wait_for_motion_end = true;
+        mp_queue_command(_motion_end_callback, nullptr, nullptr);
+        pb.func = _scan_report;
+        return (STAT_EAGAIN);
+    }
+
+    // cross to the next point and probe it, all in one go
+    bool xy_flags[AXES] = { true, true, false, false, false, false };
+    _scan_point(pb.scan_index, pb.target);
+    copy_vector(retract, pb.target);
+    retract[AXIS_Z] = pb.scan_start[AXIS_Z];
+    cm_straight_traverse(retract, xy_flags);
+    mp_queue_command(_scan_arm_callback, nullptr, nullptr);
+    _probe_move(pb.target, pb.flags);
+    return (STAT_EAGAIN);                   // pb.func stays _scan_contact
+}
+
+/*
+ * _scan_report() - send the results, one line per call, then finish up
+ */
+
+static stat_t _scan_report()
+{
+    char buf[16 + SCAN_POINTS_PER_LINE * 12];
+    char *bufp = buf;
+
+    if (pb.scan_report < pb.scan_points) {
+        bufp += sprintf(bufp, "{\"scn\":[%u", (unsigned)pb.scan_report);
+        for (uint8_t n = 0; (n < SCAN_POINTS_PER_LINE) && (pb.scan_report < pb.scan_points); n++) {
+            bufp += sprintf(bufp, ",%0.3f", pb.scan_results[pb.scan_report++]);
+        }
+        sprintf(bufp, "]}\n");
+        xio_writeline(buf);
+        return (STAT_EAGAIN);
+    }
+    sprintf(buf, "{\"scn\":{\"n\":%lu,\"m\":%lu}}\n", (unsigned long)cm.scan_count, (unsigned long)cm.scan_missed);
+    xio_writeline(buf);
+
+    _probe_restore_settings();
+    cm.probe_state[0] = (cm.scan_missed == 0) ? PROBE_SUCCEEDED : PROBE_FAILED;
+#if HEIGHT_MAP_ENABLED == true
+    if (cm.scan_missed == 0) {              // a complete scan becomes the height map - see cm_set_hmpe()
+        kn_set_height_map(pb.scan_start, pb.scan_step, pb.scan_columns, pb.scan_points / pb.scan_columns, pb.scan_results);
+    }
+#endif
+    return (STAT_OK);
+}
+
 /***********************************************************************************
  * _probe_move() - function to execute probing moves
  *
@@ -386,3 +622,29 @@ stat_t cm_set_prbr(nvObj_t *nv)
     cm.probe_report_enable = fp_NOT_ZERO(nv->value);
     return (STAT_OK);
 }
+
+#if HEIGHT_MAP_ENABLED == true
+/*
+ * cm_set_hmpe() - turn the height map from the last complete G38.6 scan on or off
+ *
+ *  Only accepted with the machine at rest. The tool doesn't move: the Z position is set
+ *  so that the steps agree with it under the new setting, so the reported Z steps by the
+ *  compensation at the current X,Y. Re-zero Z at the scan origin, where the map is zero,
+ *  or just move there - the compensation then takes effect on the move.
+ */
+
+stat_t cm_set_hmpe(nvObj_t *nv)
+{
+    bool enable = fp_NOT_ZERO(nv->value);
+    if (enable == (bool)kn_hmap.enable) {
+        return (STAT_OK);
+    }
+    if (cm_get_runtime_busy() || (enable && (kn_hmap.columns == 0))) {
+        return (STAT_COMMAND_NOT_ACCEPTED);         // moving, or no map loaded
+    }
+    float height = kn_get_height(cm.gmx.position[AXIS_X], cm.gmx.position[AXIS_Y]);
+    kn_hmap.enable = enable;
+    cm_set_position(AXIS_Z, cm.gmx.position[AXIS_Z] + (enable ? -height : height));
+    return (STAT_OK);
+}
+#endif
@@ -33,6 +33,12 @@
 #include "MotateTimers.h"
 #include <type_traits>
 
+// The strip is only re-sent when a pixel changes, plus a refresh this often in case noise
+// on the data line latched a wrong color
+#ifndef NEOPIXEL_REFRESH_MS
+#define NEOPIXEL_REFRESH_MS 1000
+#endif
+
 #pragma mark Color objects
 
 // Bonus, color objects
@@ -411,8 +417,14 @@ struct NeoPixel {
 
     Motate::Timeout _update_timeout;
     const uint32_t  _update_timeout_ms;
+    Motate::Timeout _refresh_timeout;
     bool            _pixels_changed = true;
 
+    // The last value encoded for each pixel (packed WRGB), so a color that's set again
+    // unchanged - the common case, status lights are refreshed every update - costs no
+    // re-encoding and no DMA transfer
+    uint32_t _pixel_value[pixel_count];
+
     constexpr NeoPixel(NeoPixelOrder new_order, uint32_t update_ms = 1)
         : _pixel_order{new_order},
           _white_offset{(((uint32_t)_pixel_order >> 6) & 0b11) << 3},
@@ -432,6 +444,7 @@ struct NeoPixel {
         _pixel_pin.setSyncMode(Motate::kTimerSyncDMA, 1);
 
         _update_timeout.set(0);
+        for (uint8_t i = 0; i < pixel_count; i++) { _pixel_value[i] = 0xFFFFFFFF; } // nothing encoded yet
     };
 
     void setPixel(uint8_t pixel, uint8_t red, uint8_t green, uint8_t blue, int16_t white = -1) {
@@ -446,6 +459,12 @@ struct NeoPixel {
             // green -= white;
             // blue -= white;
         }
+        uint32_t value = ((uint32_t)(_has_white ? (uint8_t)white : 0) << 24) | ((uint32_t)red << 16) | ((uint32_t)green << 8) | blue;
+        if (_pixel_value[pixel] == value) {
+            return;
+        }
+        _pixel_value[pixel] = value;
+
         _period_buffer[0 + 1 + _red_offset + (pixel * data_width)] = (red & 0b10000000) ? led_ON : led_OFF;
         _period_buffer[1 + 1 + _red_offset + (pixel * data_width)] = (red & 0b01000000) ? led_ON : led_OFF;
         _period_buffer[2 + 1 + _red_offset + (pixel * data_width)] = (red & 0b00100000) ? led_ON : led_OFF;
@@ -502,16 +521,21 @@ struct NeoPixel {
         }
     }
 
+    // The waveform is clocked out by the PWM timer's DMA, so a transfer costs no CPU, but it
+    // does hold the DMA and bus for 1.25us per bit. Only send when something changed.
     void update() {
         if (!_pixel_pin.isTransferDone()) {
             return;
         }
-        //        if (!_pixels_changed) { return; }
-        //        _pixels_changed = false;
+        if (!_pixels_changed && !_refresh_timeout.isPast()) {
+            return;
+        }
 
         if (_update_timeout.isPast()) {
+            _pixels_changed = false;
             _pixel_pin.startTransfer(_period_buffer);
             _update_timeout.set(_update_timeout_ms);
+            _refresh_timeout.set(NEOPIXEL_REFRESH_MS);
         }
     }
 };
@@ -53,6 +53,8 @@ struct StepDirStepper final : Stepper  {
     /* stepper pin assignments */
 
     OutputPin<step_num>    _step;
+    static constexpr uint8_t step_port = OutputPin<step_num>::portLetter;   // see STEP_PULSE_BATCHING
+    static constexpr uint32_t step_mask = OutputPin<step_num>::mask;
     uint8_t                _step_downcount;
     OutputPin<dir_num>     _dir;
     OutputPin<enable_num>  _enable{kStartHigh};
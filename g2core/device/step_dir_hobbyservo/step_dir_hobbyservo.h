@@ -1,5 +1,5 @@
 /*
- * step_dir_hobbyservo.cpp - control over a hobby servo (PWM-driven) using steper Step/Direction/Enable from software
+ * step_dir_hobbyservo.h - control over a hobby servo (PWM-driven) from the segment positions
  * This file is part of G2 project
  *
  * Copyright (c) 2016 Alden S. Hart, Jr.
@@ -38,35 +38,46 @@ using Motate::OutputPin;
 using Motate::PWMOutputPin;
 using Motate::kStartHigh;
 using Motate::kNormal;
-using Motate::Timeout;
 
 
+// Servo travel, in 1/32 microsteps, mapped onto the pulse range
+#ifndef HOBBYSERVO_RANGE
+#define HOBBYSERVO_RANGE 6400.0
+#endif
+#ifndef HOBBYSERVO_MIN_PULSE
+#define HOBBYSERVO_MIN_PULSE 750.0          // uSec at position 0
+#endif
+#ifndef HOBBYSERVO_MAX_PULSE
+#define HOBBYSERVO_MAX_PULSE 2000.0         // uSec at HOBBYSERVO_RANGE
+#endif
+
 // Motor structures
+// The servo is a position driver (step_position): the loader hands it the motor's step
+// position once per segment and the PWM hardware holds the pulse width. It takes no DDA
+// ticks and needs no step/dir driver.
 template <pin_number pwm_pin_num>  // Setup a stepper template to hold our pins
 struct StepDirHobbyServo final : Stepper {
+    static constexpr bool step_position = true;
+
     /* stepper pin assignments */
 
     int16_t                _microsteps_per_step = 1;
-    bool                   _step_is_forward = false;
-    int32_t                _position = 0; // in steps from 0 - 6400 for a full "rotation"
-    int32_t                _position_computed = 0; // in steps from 0 - 6400 for a full "rotation"
+    int32_t                _position_computed = 0; // PWM duty value for the last position
     float                  _min_value;
     float                  _max_value;
     float                  _value_range;
     bool                   _enabled = false;
     PWMOutputPin<pwm_pin_num> _pwm_pin;
-    Motate::Timeout check_timer;
 
     // sets default pwm freq for all motor vrefs (commented line below also sets HiZ)
     StepDirHobbyServo(const uint32_t frequency = 50) : Stepper{}, _pwm_pin{kNormal, frequency} {
         _pwm_pin.setFrequency(frequency); // redundant due to a bug
         uint16_t _top_value = _pwm_pin.getTopValue();
         float frequency_inv = 1.0/(float)frequency;
-        _min_value = (float)_top_value / ((frequency_inv)/(750.0/1000000.0));
-        _max_value = (float)_top_value / ((frequency_inv)/(2000.0/1000000.0));
+        _min_value = (float)_top_value / ((frequency_inv)/(HOBBYSERVO_MIN_PULSE/1000000.0));
+        _max_value = (float)_top_value / ((frequency_inv)/(HOBBYSERVO_MAX_PULSE/1000000.0));
         _value_range = _max_value - _min_value;
         _position_computed = _min_value;
-        check_timer.set(1);
     };
 
     /* Optional override of init */
@@ -114,35 +125,24 @@ struct StepDirHobbyServo final : Stepper {
         _pwm_pin.setExactDutyCycle(0, true);
     };
 
-    void stepStart() override {
-        if (!_enabled) return;
-
-        if (_step_is_forward) {
-            _position += _microsteps_per_step;
-        } else {
-            _position -= _microsteps_per_step;
-        }
-
-        if (!check_timer.isPast()) { return; }
-        check_timer.set(10);
-
-        float used_position = _position;
-        if (used_position > 6400.0) {
-            used_position = 6400.0;
+    // called from the loader (HI interrupt level) - keep it short
+    void setPosition(const int32_t steps) override {
+        float used_position = (float)steps * _microsteps_per_step;
+        if (used_position > HOBBYSERVO_RANGE) {
+            used_position = HOBBYSERVO_RANGE;
         }
         if (used_position < 0.0) {
             used_position = 0.0;
         }
 
-        _position_computed = _min_value + ((used_position/6400.0) * _value_range);
-        _pwm_pin.setExactDutyCycle(_position_computed, true); // apply the change
-    };
-
-    void stepEnd() override {
+        _position_computed = _min_value + ((used_position/HOBBYSERVO_RANGE) * _value_range);
+        if (_enabled) {
+            _pwm_pin.setExactDutyCycle(_position_computed, true); // apply the change
+        }
     };
 
     void setDirection(uint8_t new_direction) override {
-        _step_is_forward = new_direction;
+        ; // the position carries the direction
     };
 
     void setPowerLevel(float new_pl) override {
@@ -0,0 +1,132 @@
+/*
+ * step_dir_waveform.h - Step/Direction/Enable driver with DMA-played step waveforms
+ * This file is part of G2 project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ * Copyright (c) 2017 Robert Giseburt
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ *  Driver for STEP_ENGINE_WAVEFORM (see stepper.h). The step pin is a PWM output running
+ *  at FREQUENCY_DDA with its duty cycle fed by DMA, one value per DDA tick, the same way
+ *  the neopixel driver feeds its bit periods. The step pins of all motors must be on PWM
+ *  channels that share a synchronized time base, so pulses line up across motors.
+ *
+ *  To use: set DEVICE_DEFINES += STEP_ENGINE_WAVEFORM=1 in the board .mk, add this
+ *  directory to SOURCE_DIRS, and declare the motors in board_stepper as StepDirWaveform.
+ */
+#ifndef STEP_DIR_WAVEFORM_H_ONCE
+#define STEP_DIR_WAVEFORM_H_ONCE
+
+#include "MotatePins.h"
+#include "MotateTimers.h"
+
+#include "stepper.h"
+
+using Motate::pin_number;
+using Motate::OutputPin;
+using Motate::PWMOutputPin;
+using Motate::kStartHigh;
+using Motate::kNormal;
+
+// Motor structures
+template <pin_number step_num,  // step_num must be a PWM capable pin
+          pin_number dir_num,
+          pin_number enable_num>
+struct StepDirWaveform final : Stepper {
+    static constexpr bool step_waveform = true;
+
+    /* stepper pin assignments */
+
+    PWMOutputPin<step_num> _step;
+    OutputPin<dir_num>     _dir;
+    OutputPin<enable_num>  _enable{kStartHigh};
+
+    uint16_t _pulse_duty;                                   // duty value for one step pulse - see STEP_PULSE_WIDTH_NS
+    uint16_t _wave[PREP_BUFFERS][WAVEFORM_TICKS_MAX];       // one waveform table per prep slot
+
+    StepDirWaveform() : Stepper{}, _step{kNormal, FREQUENCY_DDA} {
+        _step = 0.0;                                    // start with no pulse
+        _step.stop();
+        _step.setSync(true);                            // share the synchronized PWM time base
+        _step.setSyncMode(Motate::kTimerSyncDMA, 1);    // ...and take a new duty value every period
+        _pulse_duty = _pulseDuty(_step.getTopValue());
+    };
+
+    // the duty for STEP_PULSE_WIDTH_NS, kept inside the tick so there's always a low time
+    static uint16_t _pulseDuty(const uint16_t top) {
+        if (STEP_PULSE_WIDTH_NS == 0) {
+            return (top >> 1);
+        }
+        uint32_t duty = ((uint64_t)top * STEP_PULSE_WIDTH_NS * FREQUENCY_DDA + 999999999) / 1000000000;
+        return (std::max((uint32_t)1, std::min(duty, (uint32_t)top - 1)));
+    };
+
+    /* Waveform functions - called from stepper.cpp via the motor list */
+
+    // waveformClear() - zero the table for a segment of ticks, including the trailing 0
+    void waveformClear(const uint8_t slot, const uint32_t ticks) {
+        memset(_wave[slot], 0, (ticks + 1) * sizeof(uint16_t));
+    };
+
+    // waveformStep() - put a step pulse in the given tick
+    void waveformStep(const uint8_t slot, const uint32_t tick) {
+        _wave[slot][tick] = _pulse_duty;
+    };
+
+    // waveformStart() - start playing a table. Called from the loader at DDA priority
+    void waveformStart(const uint8_t slot, const uint32_t ticks) {
+        _step.startTransfer(_wave[slot], ticks + 1);
+    };
+
+    /* Functions that must be implemented in subclasses */
+
+    bool canStep() override { return !_step.isNull(); };
+
+    void _enableImpl() override {
+        if (!_enable.isNull()) {
+            _enable.clear();
+        }
+    };
+
+    void _disableImpl() override {
+        if (!_enable.isNull()) {
+            _enable.set();
+        }
+    };
+
+    void stepStart() override {};               // steps come from the waveform
+
+    void stepEnd() override {};
+
+    void setDirection(uint8_t new_direction) override {
+        if (!_dir.isNull()) {
+            if (new_direction == DIRECTION_CW) {
+                _dir.clear();
+            } else {
+                _dir.set();  // set the bit for CCW motion
+            }
+        }
+    };
+};
+
+#endif  // STEP_DIR_WAVEFORM_H_ONCE
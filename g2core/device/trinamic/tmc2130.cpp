@@ -25,3 +25,7 @@
  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
  * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
+
+#include "tmc2130.h"
+
+trinamic2130_poll_t tmc2130_poll;   // the poll schedule shared by all TMC2130s
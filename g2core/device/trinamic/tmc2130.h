@@ -26,6 +26,9 @@
  * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#ifndef TMC2130_H_ONCE
+#define TMC2130_H_ONCE
+
 #include "stepper.h"
 
 #include "MotateSPI.h"
@@ -40,6 +43,47 @@ using Motate::SPIDeviceMode;
 using Motate::fromBigEndian;
 using Motate::toBigEndian;
 
+// All TMC2130s are polled together once per TMC2130_POLL_PERIOD ms. DRV_STATUS (StallGuard
+// and the error flags) is read every round, IOIN and CHOPCONF every TMC2130_SLOW_POLL rounds.
+#ifndef TMC2130_POLL_PERIOD
+#define TMC2130_POLL_PERIOD 10
+#endif
+#ifndef TMC2130_SLOW_POLL
+#define TMC2130_SLOW_POLL 10
+#endif
+
+// StallGuard and CoolStep only work in spreadCycle, and at step rates above TCOOLTHRS
+// (TSTEP is the time between steps, so it's an upper limit on TSTEP). Below it SG_RESULT
+// is meaningless - the default leaves them on for all but a crawl.
+#ifndef TMC2130_TCOOLTHRS
+#define TMC2130_TCOOLTHRS 0xFFFFF
+#endif
+// CoolStep current regulation: raise the current when SG_RESULT falls below SEMIN*32,
+// drop it when above (SEMIN+SEMAX+1)*32, never below half of IRUN (seimin = 0)
+#ifndef TMC2130_COOLSTEP_SEMIN
+#define TMC2130_COOLSTEP_SEMIN 5
+#endif
+#ifndef TMC2130_COOLSTEP_SEMAX
+#define TMC2130_COOLSTEP_SEMAX 2
+#endif
+
+// The shared poll schedule. The first driver to find the period expired starts a new round,
+// and the rest join it in the same pass of st_motor_power_callback(), so every driver's
+// messages are on the SPI bus queue together and go out back to back.
+struct trinamic2130_poll_t {
+    Motate::Timeout timer;
+    uint16_t round = 0;
+
+    uint16_t currentRound() {
+        if (!timer.isSet() || timer.isPast()) {
+            timer.set(TMC2130_POLL_PERIOD);
+            round++;
+        }
+        return round;
+    };
+};
+extern trinamic2130_poll_t tmc2130_poll;
+
 // Complete class for Trinamic2130 drivers.
 // It's also a proper Stepper object.
 template <typename device_t,
@@ -49,6 +93,8 @@ template <typename device_t,
 struct Trinamic2130 final : Stepper {
     // Pins that are directly managed
     OutputPin<step_num> _step;
+    static constexpr uint8_t step_port = OutputPin<step_num>::portLetter;   // see STEP_PULSE_BATCHING
+    static constexpr uint32_t step_mask = OutputPin<step_num>::mask;
     OutputPin<dir_num> _dir;
     OutputPin<enable_num> _enable {kStartHigh};
 
@@ -84,8 +130,20 @@ struct Trinamic2130 final : Stepper {
     // data requested. Otherwise we'll loop forever.
     bool _reading_only = false;
 
-    // Timer to keep track of when we need to do another periodic update
-    Motate::Timeout check_timer;
+    // The poll round we last joined - see trinamic2130_poll_t
+    uint16_t _poll_round = 0;
+    volatile bool _polling = false;
+
+    // Registers from the last complete poll round. The SPI callback writes the idle bank
+    // when the round's last read is in, then flips _poll_bank, so readers always get one
+    // round's values together and never wait on the bus.
+    struct poll_result_t {
+        uint32_t drv_status;
+        uint32_t ioin;
+        uint16_t round;
+    };
+    poll_result_t _poll_result[2] = {{0, 0, 0}, {0, 0, 0}};
+    volatile uint8_t _poll_bank = 0;
 
     // Constructor - this is the only time we directly use the SBIBus
     template <typename SPIBus_t, typename chipSelect_t>
@@ -128,6 +186,49 @@ struct Trinamic2130 final : Stepper {
         _startNextReadWrite();
     };
 
+    // StallGuard and CoolStep share TCOOLTHRS and need spreadCycle, so either one being on
+    // turns off stealthChop (en_pwm_mode) and opens the TCOOLTHRS window.
+    bool _stall_enabled = false;
+
+    void _setCoolStepWindow()
+    {
+        bool on = _stall_enabled || (COOLCONF.semin != 0);
+        GCONF.en_pwm_mode = on ? 0 : 1;
+        TCOOLTHRS.value = on ? TMC2130_TCOOLTHRS : 0;
+        GCONF_needs_written = true;
+        TCOOLTHRS_needs_written = true;
+        COOLCONF_needs_written = true;
+        _startNextReadWrite();
+    };
+
+    void setStallGuard(const bool enable, const int8_t threshold) override
+    {
+        _stall_enabled = enable;
+        COOLCONF.sgt = threshold;       // lower is more sensitive
+        _setCoolStepWindow();
+    };
+
+    void setCoolStep(const bool enable) override
+    {
+        COOLCONF.semin = enable ? TMC2130_COOLSTEP_SEMIN : 0;
+        COOLCONF.semax = TMC2130_COOLSTEP_SEMAX;
+        COOLCONF.seup = 1;              // current up 2 steps per low reading
+        COOLCONF.sedn = 0;              // current down 1 step per 32 high readings
+        COOLCONF.seimin = 0;
+        _setCoolStepWindow();
+    };
+
+    // With CoolStep on, report the current the driver is actually running (CS_ACTUAL)
+    float getCurrentPowerLevel(uint8_t motor) override
+    {
+        float level = Stepper::getCurrentPowerLevel(motor);
+        if ((level > 0.0) && (COOLCONF.semin != 0)) {
+            float actual = ((_poll_result[_poll_bank].drv_status >> 16) & 0x1F) / 31.0;
+            level = std::min(level, actual);
+        }
+        return (level);
+    };
+
     void _enableImpl() override { _enable.clear(); };
 
     void _disableImpl() override { _enable.set(); };
@@ -157,7 +258,13 @@ struct Trinamic2130 final : Stepper {
         _startNextReadWrite();
     };
 
-    // Note that init() and periodicCheck(bool have_actually_stopped) are both below
+    // Note that init(), periodicCheck(bool have_actually_stopped) and periodicPoll() are all below
+
+    // Polled results, from the last complete round
+    uint16_t stallGuardResult() { return (_poll_result[_poll_bank].drv_status & 0x3FF); };
+    bool isStalled() override { return (_stall_enabled && (_poll_result[_poll_bank].drv_status & (1UL << 24))); };
+    uint32_t driverStatus() { return (_poll_result[_poll_bank].drv_status); };
+    uint16_t pollRound() { return (_poll_result[_poll_bank].round); };
 
 
     // ############
@@ -400,10 +507,23 @@ struct Trinamic2130 final : Stepper {
     volatile bool CHOPCONF_needs_read;
     volatile bool CHOPCONF_needs_written;
 
-    struct {
+    union {
         volatile uint32_t value;
         //        uint8_t bytes[4];
-    } COOLCONF; // 0x6D - READ ONLY
+        volatile struct {
+            uint32_t semin        : 4; //  0- 3 - 0 turns CoolStep off
+            uint32_t              : 1; //  4
+            uint32_t seup         : 2; //  5- 6
+            uint32_t              : 1; //  7
+            uint32_t semax        : 4; //  8-11
+            uint32_t              : 1; // 12
+            uint32_t sedn         : 2; // 13-14
+            uint32_t seimin       : 1; // 15
+             int32_t sgt          : 7; // 16-22 - StallGuard threshold, signed
+            uint32_t              : 1; // 23
+            uint32_t sfilt        : 1; // 24
+        }  __attribute__ ((packed));
+    } COOLCONF; // 0x6D - READ/WRITE
     void _postReadCoolConf() {
         COOLCONF.value = fromBigEndian(in_buffer.value);
     };
@@ -454,9 +574,10 @@ struct Trinamic2130 final : Stepper {
     };
     volatile bool PWMCONF_needs_written;
 
-    void _startNextReadWrite()
+    // Returns false if there was nothing to send
+    bool _startNextReadWrite()
     {
-        if (_transmitting || !_inited) { return; }
+        if (_transmitting || !_inited) { return true; }
         _transmitting = true; // preemptively say we're transmitting .. as a mutex
 
         // We request the next register, or re-request that we're reading (and already requested) in order to get the response.
@@ -497,17 +618,30 @@ struct Trinamic2130 final : Stepper {
         // otherwise we're done here
         {
             _transmitting = false; // we're not really transmitting.
-            return;
+            return false;
         }
 
         out_buffer.addr = (uint8_t) next_reg;
         _message.setup((uint8_t *)&out_buffer, (uint8_t *)&in_buffer, 5, SPIMessage::DeassertAfter, SPIMessage::KeepTransaction);
         _device.queueMessage(&_message);
+        return true;
+    };
+
+    // Called from the SPI interrupt when a poll round's last read is in
+    void _publishPoll()
+    {
+        uint8_t idle = _poll_bank ^ 1;
+        _poll_result[idle].drv_status = DRV_STATUS.value;
+        _poll_result[idle].ioin = IOIN.value;
+        _poll_result[idle].round = _poll_round;
+        _poll_bank = idle;
+        _polling = false;
     };
 
     void _doneReadingCallback()
     {
         //        for (uint16_t i = 10; i>0; i--) { __NOP(); }
+        hw_dcache_invalidate(&in_buffer, sizeof(in_buffer));   // the SPI DMA wrote it
         status = in_buffer.status;
         if (_register_thats_reading != -1) {
             switch(_register_thats_reading) {
@@ -539,7 +673,13 @@ struct Trinamic2130 final : Stepper {
         _reading_only = false;
 
         _transmitting = false;
-        //_startNextReadWrite();
+
+        // Chain the next register from here, so a whole poll is one run of back-to-back
+        // transfers with no main-loop round trip between them. The TMC2130 returns each
+        // read in the following datagram, so this also pipelines the reads.
+        if (!_startNextReadWrite() && _polling) {
+            _publishPoll();
+        }
     };
 
     void init() override
@@ -621,20 +761,26 @@ struct Trinamic2130 final : Stepper {
 
         _inited = true;
         _startNextReadWrite();
-        check_timer.set(100);
 
         Stepper::init();
     };
 
-    void periodicCheck(bool have_actually_stopped) override
+    // Runs every controller pass, not just in phat city, so StallGuard is fresh during moves
+    void periodicPoll() override
     {
-        Stepper::periodicCheck(have_actually_stopped);
-        if (check_timer.isPast()) {
-            check_timer.set(100);
+        uint16_t round = tmc2130_poll.currentRound();
+        if ((round == _poll_round) || _polling) {
+            return;     // already joined this round, or the last one is still on the bus
+        }
+        _poll_round = round;
+        _polling = true;
+        if ((round % TMC2130_SLOW_POLL) == 0) {
             IOIN_needs_read = true;
             CHOPCONF_needs_read = true;
-            DRV_STATUS_needs_read = true;
-            _startNextReadWrite();
         }
+        DRV_STATUS_needs_read = true;
+        _startNextReadWrite();     // if a write is on the bus its callback chains these
     };
 };
+
+#endif // TMC2130_H_ONCE
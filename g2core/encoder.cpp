@@ -29,10 +29,11 @@
 #include "config.h"
 #include "encoder.h"
 #include "canonical_machine.h"  // needed for cm_panic() in assertions
+#include "stepper.h"            // st_get_steps_run() for steps taken in the running segment
 
 /**** Allocate Structures ****/
 
-enEncoders_t en;
+HOT_DATA enEncoders_t en;
 
 /************************************************************************************
  **** CODE **************************************************************************
@@ -43,10 +44,79 @@ enEncoders_t en;
  * encoder_reset() - reset encoders
  */
 
+#if ENCODER_QDEC_ENABLED == true
+static void _init_qdec(enEncoder_t *e, int8_t block, float steps_per_count);
+#endif
+
 void encoder_init() {
     memset(&en, 0, sizeof(en));  // clear all values, pointers and status
     encoder_init_assertions();
+
+#if ENCODER_QDEC_ENABLED == true
+    _init_qdec(&en.en[MOTOR_1], M1_ENCODER_TC, M1_ENCODER_STEPS_PER_COUNT);
+#if (MOTORS >= 2)
+    _init_qdec(&en.en[MOTOR_2], M2_ENCODER_TC, M2_ENCODER_STEPS_PER_COUNT);
+#endif
+#if (MOTORS >= 3)
+    _init_qdec(&en.en[MOTOR_3], M3_ENCODER_TC, M3_ENCODER_STEPS_PER_COUNT);
+#endif
+#if (MOTORS >= 4)
+    _init_qdec(&en.en[MOTOR_4], M4_ENCODER_TC, M4_ENCODER_STEPS_PER_COUNT);
+#endif
+#if (MOTORS >= 5)
+    _init_qdec(&en.en[MOTOR_5], M5_ENCODER_TC, M5_ENCODER_STEPS_PER_COUNT);
+#endif
+#if (MOTORS >= 6)
+    _init_qdec(&en.en[MOTOR_6], M6_ENCODER_TC, M6_ENCODER_STEPS_PER_COUNT);
+#endif
+    _init_qdec(&en.conveyor, CONVEYOR_ENCODER_TC, 1.0);
+    _init_qdec(&en.spindle, SPINDLE_ENCODER_TC, 1.0);
+#endif
+}
+
+#if ENCODER_QDEC_ENABLED == true
+/*
+ * _init_qdec() - set up a TC block as a quadrature decoder for a motor's, the conveyor's or the spindle's encoder
+ *
+ *  Position mode on channel 0, clocked by the decoder (XC0) and never reset by the index,
+ *  so the counter just follows the encoder. Only channel 0's clock is needed for that.
+ */
+
+static void _init_qdec(enEncoder_t *e, int8_t block, float steps_per_count)
+{
+    if (block < 0) {
+        return;                                         // virtual encoder
+    }
+    static Tc * const tc_block[] = { TC0, TC1, TC2,
+#ifdef TC3
+                                     TC3
+#endif
+    };
+    static const uint32_t tc_id[] = { ID_TC0, ID_TC3, ID_TC6,   // peripheral ID of channel 0 of each block
+#ifdef TC3
+                                      ID_TC9
+#endif
+    };
+    if ((uint8_t)block >= (sizeof(tc_id) / sizeof(tc_id[0]))) {
+        return;
+    }
+    Tc *tc = tc_block[block];
+    uint32_t id = tc_id[block];
+
+    if (id < 32) {
+        PMC->PMC_PCER0 = (1u << id);
+    } else {
+        PMC->PMC_PCER1 = (1u << (id - 32));
+    }
+    tc->TC_BMR = TC_BMR_QDEN | TC_BMR_POSEN | TC_BMR_EDGPHA | TC_BMR_MAXFILT(ENCODER_QDEC_FILTER);
+    tc->TC_CHANNEL[0].TC_CMR = TC_CMR_TCCLKS_XC0;
+    tc->TC_CHANNEL[0].TC_CCR = TC_CCR_CLKEN | TC_CCR_SWTRG;
+
+    e->counter = &tc->TC_CHANNEL[0].TC_CV;
+    e->last_count = (uint16_t)*e->counter;
+    e->steps_per_count = steps_per_count;
 }
+#endif
 
 void encoder_reset() { encoder_init(); }
 /*
@@ -74,13 +144,25 @@ stat_t encoder_test_assertions() {
  *	position except if the machine is at zero.
  */
 
-void en_set_encoder_steps(uint8_t motor, float steps) { en.en[motor].encoder_steps = (int32_t)round(steps); }
+void en_set_encoder_steps(uint8_t motor, float steps)
+{
+    en.en[motor].encoder_steps = (int32_t)round(steps);
+#if ENCODER_QDEC_ENABLED == true
+    enEncoder_t *e = &en.en[motor];
+    if (e->counter != nullptr) {                        // count on from here
+        e->last_count = (uint16_t)*e->counter;
+        e->counts = 0;
+        e->step_offset = e->encoder_steps;
+    }
+#endif
+}
 
 /*
  * en_read_encoder()
  *
- *	The stepper ISR count steps into steps_run(). These values are accumulated to
- *	encoder_position during LOAD (HI interrupt level). The encoder position is
+ *	The loader counts the steps of each segment into steps_run once the segment is done
+ *	(see _count_steps_run()) and accumulates them to encoder_steps during LOAD (HI interrupt
+ *	level). The DDA doesn't count steps as it issues them. The encoder position is
  *	therefore always stable. But be advised: the position lags target and position
  *	valaes elsewhere in the system because the sample is taken when the steps for
  *	that segment are complete.
@@ -88,36 +170,155 @@ void en_set_encoder_steps(uint8_t motor, float steps) { en.en[motor].encoder_ste
 
 float en_read_encoder(uint8_t motor) { return ((float)en.en[motor].encoder_steps); }
 
+/*
+ * en_get_encoder_steps()
+ *
+ *  Read every motor's position into steps[MOTORS] at an exact point in time. This provides
+ *  a very accurate view of step position at the time of the call, which is presumably in
+ *  the middle of a switch closure interrupt. Reading does not affect the normal accumulation
+ *  run by the stepper DDA. Input events stamp themselves with this.
+ */
+void en_get_encoder_steps(float steps[])
+{
+    for (uint8_t m = 0; m < MOTORS; m++) { steps[m] = en.en[m].encoder_steps + en.en[m].steps_run + st_get_steps_run(m); }
+#if ENCODER_QDEC_ENABLED == true
+    for (uint8_t m = 0; m < MOTORS; m++) {              // a hardware encoder can be read right now
+        enEncoder_t *e = &en.en[m];
+        if (e->counter != nullptr) {
+            int32_t counts = e->counts + (int16_t)((uint16_t)*e->counter - e->last_count);
+            steps[m] = e->step_offset + (float)counts * e->steps_per_count;
+        }
+    }
+#endif
+}
+
 /*
  * en_take_encoder_snapshot()
  * en_get_encoder_snapshot_position()
  * en_get_encoder_snapshot_vector()
  *
- *  Take a snapshot of the encoder position at an exact point in time. This provides
- *  a very accurate view of step position at the time of the snapshot,  which is
- *  presumably in the middle of a switch closure interrupt. Taking the snapshot
- *  does not affect the normal accumulation run by the stepper DDA.
- *
- *  The results are in STEPS, which may need to be converted back to position using
- *  forward kinematics, depending on your use. See probe cycle for example.
+ *  Take a snapshot of the encoder position at an exact point in time, and hold it for
+ *  later use. The results are in STEPS, which may need to be converted back to position
+ *  using forward kinematics, depending on your use. See probe cycle for example.
  */
-void en_take_encoder_snapshot() {
-    for (uint8_t m = 0; m < MOTORS; m++) { en.snapshot[m] = en.en[m].encoder_steps + en.en[m].steps_run; }
-
-    /* loop unrolled version for faster execution
-        en.snapshot[MOTOR_1] = en.en[MOTOR_1].encoder_steps + en.en[MOTOR_1].steps_run;
-        en.snapshot[MOTOR_2] = en.en[MOTOR_2].encoder_steps + en.en[MOTOR_2].steps_run;
-        en.snapshot[MOTOR_3] = en.en[MOTOR_3].encoder_steps + en.en[MOTOR_3].steps_run;
-        en.snapshot[MOTOR_4] = en.en[MOTOR_4].encoder_steps + en.en[MOTOR_4].steps_run;
-        en.snapshot[MOTOR_5] = en.en[MOTOR_5].encoder_steps + en.en[MOTOR_5].steps_run;
-        en.snapshot[MOTOR_6] = en.en[MOTOR_6].encoder_steps + en.en[MOTOR_6].steps_run;
-    */
-}
+void en_take_encoder_snapshot() { en_get_encoder_steps(en.snapshot); }
 
 float en_get_encoder_snapshot_steps(uint8_t motor) { return (en.snapshot[motor]); }
 
 float* en_get_encoder_snapshot_vector() { return (en.snapshot); }
 
+/*
+ * en_latch_encoder_snapshot()   - take a snapshot only if none is latched. Returns true if taken
+ * en_clear_encoder_snapshot()   - release the latch for the next one
+ * en_encoder_snapshot_latched() - true if a snapshot has been latched since the clear
+ *
+ *  For probing on the fly. The first edge latches the position, and later edges - the
+ *  probe letting go as the machine decelerates past the contact, or bouncing - can't
+ *  overwrite it. Called from the input interrupt.
+ */
+bool en_latch_encoder_snapshot()
+{
+    if (en.snapshot_latched) {
+        return (false);
+    }
+    en_take_encoder_snapshot();
+    en.snapshot_latched = true;
+    return (true);
+}
+
+void en_clear_encoder_snapshot() { en.snapshot_latched = false; }
+
+bool en_encoder_snapshot_latched() { return (en.snapshot_latched); }
+
+/*
+ * en_conveyor_is_present() - true if the board decodes a conveyor encoder
+ * en_read_conveyor()       - counts the conveyor has moved since reset - called by the exec
+ */
+bool en_conveyor_is_present()
+{
+#if ENCODER_QDEC_ENABLED == true
+    return (en.conveyor.counter != nullptr);
+#else
+    return (false);
+#endif
+}
+
+int32_t en_read_conveyor()
+{
+#if ENCODER_QDEC_ENABLED == true
+    enEncoder_t *e = &en.conveyor;
+    if (e->counter != nullptr) {
+        uint16_t count = (uint16_t)*e->counter;
+        e->counts += (int16_t)(count - e->last_count);  // signed difference survives the 16 bit wrap
+        e->last_count = count;
+        return (e->counts);
+    }
+#endif
+    return (0);
+}
+
+/*
+ * en_spindle_is_present()  - true if the board decodes a spindle encoder
+ * en_read_spindle()        - counts the spindle has turned since reset - called by the exec
+ * en_latch_spindle_index() - latch the counter at an index pulse - called from the input ISR
+ * en_get_spindle_index()   - true if an index was latched, with its count. Call after en_read_spindle()
+ * en_clear_spindle_index() - wait for the next index pulse
+ *
+ *  The ISR only latches the raw 16 bit counter, so it never writes what the exec reads.
+ *  The count at the index is the count at the last read less the signed difference from
+ *  the latched counter - which holds as long as the read is within 32767 counts of it.
+ */
+bool en_spindle_is_present()
+{
+#if ENCODER_QDEC_ENABLED == true
+    return (en.spindle.counter != nullptr);
+#else
+    return (false);
+#endif
+}
+
+int32_t en_read_spindle()
+{
+#if ENCODER_QDEC_ENABLED == true
+    enEncoder_t *e = &en.spindle;
+    if (e->counter != nullptr) {
+        uint16_t count = (uint16_t)*e->counter;
+        e->counts += (int16_t)(count - e->last_count);
+        e->last_count = count;
+        return (e->counts);
+    }
+#endif
+    return (0);
+}
+
+void en_latch_spindle_index()
+{
+#if ENCODER_QDEC_ENABLED == true
+    if ((en.spindle.counter != nullptr) && !en.spindle_index_latched) {
+        en.spindle_index_count = (uint16_t)*en.spindle.counter;
+        en.spindle_index_latched = true;
+    }
+#endif
+}
+
+bool en_get_spindle_index(int32_t *counts)
+{
+#if ENCODER_QDEC_ENABLED == true
+    if (en.spindle_index_latched) {
+        *counts = en.spindle.counts - (int16_t)(en.spindle.last_count - en.spindle_index_count);
+        return (true);
+    }
+#endif
+    return (false);
+}
+
+void en_clear_spindle_index()
+{
+#if ENCODER_QDEC_ENABLED == true
+    en.spindle_index_latched = false;
+#endif
+}
+
 /***********************************************************************************
  * CONFIGURATION AND INTERFACE FUNCTIONS
  * Functions to get and set variables from the cfgArray table
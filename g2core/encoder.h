@@ -85,6 +85,33 @@
  *	correction will be applied to moveC. (It's possible to recompute the body of moveB, but it may
  *	not be worth the trouble).
  */
+/*
+ * HARDWARE ENCODERS
+ *
+ *	With ENCODER_QDEC_ENABLED a motor can be given a real quadrature encoder, read by the
+ *	quadrature decoder of a TC block (SAMS70). Mn_ENCODER_TC picks the block for motor n,
+ *	Mn_ENCODER_STEPS_PER_COUNT scales its counts to motor steps (4 counts per encoder line,
+ *	negative if the encoder counts the other way). Motors left at -1 keep a virtual encoder.
+ *
+ *	The decoder counts in hardware, so there is no interrupt per count. The counter is read
+ *	once per segment, where ACCUMULATE_ENCODER() would otherwise add up the steps the DDA
+ *	issued, so encoder_steps has the same timing for either kind of encoder and the following
+ *	error in the exec - and the step correction in st_prep_line() - work unchanged. With a
+ *	real encoder the following error is the steps actually lost, not just rounding.
+ *
+ *	The TC counters are 16 bits. Each read adds the signed difference from the last read,
+ *	so the count can't be lost as long as a segment moves less than 32767 counts.
+ *
+ *	The board must route the encoder's A and B phases to TIOA0 and TIOB0 of the block
+ *	(TIOA3/TIOB3 for TC1, etc.) as peripheral pins in its hardware init.
+ *
+ *	CONVEYOR_ENCODER_TC gives a block to an encoder that isn't on a motor - the conveyor
+ *	that conveyor tracking follows (see plan_track.h). It is read in counts by the exec.
+ *	SPINDLE_ENCODER_TC does the same for the spindle encoder that spindle synchronized
+ *	motion follows (see plan_sync.h). An input with the spindle index function latches the
+ *	raw counter at each index pulse, so the exec can find the count at the index after the
+ *	fact with the same signed difference.
+ */
 
 #include "hardware.h"  // for MOTORS
 
@@ -93,32 +120,121 @@
 
 /**** Configs and Constants ****/
 
+#ifndef ENCODER_QDEC_ENABLED
+#define ENCODER_QDEC_ENABLED        false   // true to read hardware quadrature encoders - see HARDWARE ENCODERS
+#endif
+#ifndef ENCODER_QDEC_FILTER
+#define ENCODER_QDEC_FILTER         2       // phase glitch filter in peripheral clocks / 3 (TC_BMR.MAXFILT), 0 = off
+#endif
+
+#if ENCODER_QDEC_ENABLED == true
+#ifndef M1_ENCODER_TC
+#define M1_ENCODER_TC               -1      // TC block 0-3 decoding the motor's encoder, -1 for a virtual encoder
+#endif
+#ifndef M2_ENCODER_TC
+#define M2_ENCODER_TC               -1
+#endif
+#ifndef M3_ENCODER_TC
+#define M3_ENCODER_TC               -1
+#endif
+#ifndef M4_ENCODER_TC
+#define M4_ENCODER_TC               -1
+#endif
+#ifndef M5_ENCODER_TC
+#define M5_ENCODER_TC               -1
+#endif
+#ifndef M6_ENCODER_TC
+#define M6_ENCODER_TC               -1
+#endif
+#ifndef M1_ENCODER_STEPS_PER_COUNT
+#define M1_ENCODER_STEPS_PER_COUNT  1.0     // motor steps per quadrature count, negative if reversed
+#endif
+#ifndef M2_ENCODER_STEPS_PER_COUNT
+#define M2_ENCODER_STEPS_PER_COUNT  1.0
+#endif
+#ifndef M3_ENCODER_STEPS_PER_COUNT
+#define M3_ENCODER_STEPS_PER_COUNT  1.0
+#endif
+#ifndef M4_ENCODER_STEPS_PER_COUNT
+#define M4_ENCODER_STEPS_PER_COUNT  1.0
+#endif
+#ifndef M5_ENCODER_STEPS_PER_COUNT
+#define M5_ENCODER_STEPS_PER_COUNT  1.0
+#endif
+#ifndef M6_ENCODER_STEPS_PER_COUNT
+#define M6_ENCODER_STEPS_PER_COUNT  1.0
+#endif
+#ifndef CONVEYOR_ENCODER_TC
+#define CONVEYOR_ENCODER_TC         -1      // TC block 0-3 decoding the conveyor encoder, -1 for none
+#endif
+#ifndef SPINDLE_ENCODER_TC
+#define SPINDLE_ENCODER_TC          -1      // TC block 0-3 decoding the spindle encoder, -1 for none
+#endif
+#endif // ENCODER_QDEC_ENABLED
+
 /**** Macros ****/
 // used to abstract the encoder code out of the stepper so it can be managed in one place
 
 #define SET_ENCODER_STEP_SIGN(m, s) en.en[m].step_sign = s;
-#define INCREMENT_ENCODER(m) en.en[m].steps_run += en.en[m].step_sign;
+#define SET_ENCODER_STEPS_RUN(m, s) en.en[m].steps_run = s;     // steps of a segment - counted once per segment, not per step
+#if ENCODER_QDEC_ENABLED == true
+#define ACCUMULATE_ENCODER(m)                     \
+    if (en.en[m].counter != nullptr) {            \
+        en_sample_qdec(&en.en[m]);                \
+    } else {                                      \
+        en.en[m].encoder_steps += en.en[m].steps_run; \
+    }                                             \
+    en.en[m].steps_run = 0;
+#else
 #define ACCUMULATE_ENCODER(m)                     \
     en.en[m].encoder_steps += en.en[m].steps_run; \
     en.en[m].steps_run = 0;
+#endif
 
 /**** Structures ****/
 
 typedef struct enEncoder {          // one real or virtual encoder per controlled motor
     int8_t  step_sign;              // set to +1 or -1
-    int16_t steps_run;              // + or - steps counted during stepper interrupt
+    int16_t steps_run;              // + or - steps of the segment being accumulated - see _count_steps_run()
     int32_t encoder_steps;          // counted encoder position	in steps
+#if ENCODER_QDEC_ENABLED == true
+    volatile uint32_t *counter;     // hardware: the decoder's counter register, or nullptr for a virtual encoder
+    uint16_t last_count;            // hardware: counter at the last read
+    int32_t counts;                 // hardware: counts since the position was last set
+    int32_t step_offset;            // hardware: steps at counts == 0
+    float steps_per_count;          // hardware: steps per count, negative if reversed
+#endif
 } enEncoder_t;
 
 typedef struct enEncoders {
     magic_t     magic_start;
     enEncoder_t en[MOTORS];         // runtime encoder structures
     float       snapshot[MOTORS];   // snapshot vector
+    volatile bool snapshot_latched; // a latched snapshot is held until cleared
+#if ENCODER_QDEC_ENABLED == true
+    enEncoder_t conveyor;           // hardware: the conveyor encoder. Only counter, last_count and counts are used
+    enEncoder_t spindle;            // hardware: the spindle encoder. Only counter, last_count and counts are used
+    volatile uint16_t spindle_index_count;  // spindle counter at the last index pulse
+    volatile bool spindle_index_latched;    // an index pulse was latched since it was last cleared
+#endif
     magic_t     magic_end;
 } enEncoders_t;
 
 extern enEncoders_t en;
 
+#if ENCODER_QDEC_ENABLED == true
+/*
+ * en_sample_qdec() - read a hardware encoder into encoder_steps - called at segment load
+ */
+static inline void en_sample_qdec(enEncoder_t *e)
+{
+    uint16_t count = (uint16_t)*e->counter;
+    e->counts += (int16_t)(count - e->last_count);      // signed difference survives the 16 bit wrap
+    e->last_count = count;
+    e->encoder_steps = e->step_offset + (int32_t)lroundf((float)e->counts * e->steps_per_count);
+}
+#endif
+
 
 /**** FUNCTION PROTOTYPES ****/
 
@@ -130,8 +246,21 @@ stat_t encoder_test_assertions(void);
 void en_set_encoder_steps(uint8_t motor, float steps);
 float en_read_encoder(uint8_t motor);
 
+void en_get_encoder_steps(float steps[]);
 void en_take_encoder_snapshot();
 float en_get_encoder_snapshot_steps(uint8_t motor);
 float* en_get_encoder_snapshot_vector();
+bool en_latch_encoder_snapshot();
+void en_clear_encoder_snapshot();
+bool en_encoder_snapshot_latched();
+
+bool en_conveyor_is_present();
+int32_t en_read_conveyor();
+
+bool en_spindle_is_present();
+int32_t en_read_spindle();
+void en_latch_spindle_index();
+bool en_get_spindle_index(int32_t *counts);
+void en_clear_spindle_index();
 
 #endif  // End of include guard: ENCODER_H_ONCE
@@ -161,10 +161,10 @@ char *get_status_message(stat_t status);
 #define STAT_ERROR_84 84
 #define STAT_ERROR_85 85
 #define STAT_ERROR_86 86
-#define STAT_ERROR_87 87
 
 // Assertion failures - build down from 99 until they meet the system internal errors
 
+#define STAT_PROFILE_ASSERTION_FAILURE 87
 #define STAT_BUFFER_FREE_ASSERTION_FAILURE 88
 #define STAT_STATE_MANAGEMENT_ASSERTION_FAILURE 89
 #define STAT_CONFIG_ASSERTION_FAILURE 90
@@ -279,13 +279,13 @@ char *get_status_message(stat_t status);
 
 /* reserved for Gcode or other program errors */
 
-#define STAT_ERROR_182 182
-#define STAT_ERROR_183 183
-#define STAT_ERROR_184 184
-#define STAT_ERROR_185 185
-#define STAT_ERROR_186 186
-#define STAT_ERROR_187 187
-#define STAT_ERROR_188 188
+#define STAT_EXPRESSION_INVALID 182             // malformed expression or parameter reference
+#define STAT_EXPRESSION_TOO_COMPLEX 183         // expression too long or nested too deeply
+#define STAT_PARAMETER_NUMBER_INVALID 184       // parameter number is not an integer in range
+#define STAT_K_WORD_IS_MISSING 185              // G33 and G33.1 need the pitch in K
+#define STAT_K_WORD_IS_INVALID 186              // pitch must be positive
+#define STAT_MACRO_NOT_DEFINED 187              // M98 P names a macro that wasn't compiled in
+#define STAT_MACRO_ALREADY_RUNNING 188          // macros don't nest
 #define STAT_ERROR_189 189
 
 #define STAT_ERROR_190 190
@@ -314,11 +314,11 @@ char *get_status_message(stat_t status);
 #define STAT_TEMPERATURE_CONTROL_ERROR 209      // temperature controls err'd out
 
 #define STAT_G29_NOT_CONFIGURED 210
-#define STAT_ERROR_211 211
-#define STAT_ERROR_212 212
-#define STAT_ERROR_213 213
-#define STAT_ERROR_214 214
-#define STAT_ERROR_215 215
+#define STAT_PLANNER_STARVED 211               // motion stopped because the queue ran dry
+#define STAT_SPINDLE_NOT_AT_SPEED 212          // spindle at-speed input didn't come on in time
+#define STAT_MOTION_LINK_LOST 213              // a board of a multi-board machine lost segment sync
+#define STAT_SPINDLE_ENCODER_MISSING 214       // spindle synchronized motion needs a spindle encoder
+#define STAT_SPINDLE_VFD_NOT_RESPONDING 215    // the spindle VFD stopped answering on its Modbus link
 #define STAT_ERROR_216 216
 #define STAT_ERROR_217 217
 #define STAT_ERROR_218 218
@@ -355,7 +355,7 @@ char *get_status_message(stat_t status);
 #define STAT_HOMING_ERROR_NEGATIVE_LATCH_BACKOFF 245
 #define STAT_HOMING_ERROR_HOMING_INPUT_MISCONFIGURED 246
 #define STAT_HOMING_ERROR_MUST_CLEAR_SWITCHES_BEFORE_HOMING 247
-#define STAT_ERROR_248 248
+#define STAT_HOMING_ERROR_SWITCH_NOT_FOUND 248
 #define STAT_ERROR_249 249
 
 #define STAT_PROBE_CYCLE_FAILED 250             // probing cycle did not complete
@@ -466,7 +466,7 @@ static const char stat_83[] = "83";
 static const char stat_84[] = "84";
 static const char stat_85[] = "85";
 static const char stat_86[] = "86";
-static const char stat_87[] = "87";
+static const char stat_87[] = "Profile assertion failure";
 
 static const char stat_88[] = "Buffer free assertion failure";
 static const char stat_89[] = "State management assertion failure";
@@ -572,13 +572,13 @@ static const char stat_179[] = "S word invalid";
 
 static const char stat_180[] = "T word missing";
 static const char stat_181[] = "T word invalid";
-static const char stat_182[] = "182";
-static const char stat_183[] = "183";
-static const char stat_184[] = "184";
-static const char stat_185[] = "185";
-static const char stat_186[] = "186";
-static const char stat_187[] = "187";
-static const char stat_188[] = "188";
+static const char stat_182[] = "Expression invalid";
+static const char stat_183[] = "Expression too complex";
+static const char stat_184[] = "Parameter number invalid";
+static const char stat_185[] = "K word is missing";
+static const char stat_186[] = "K word is invalid";
+static const char stat_187[] = "Macro is not defined";
+static const char stat_188[] = "Macro is already running";
 static const char stat_189[] = "189";
 
 static const char stat_190[] = "190";
@@ -605,11 +605,11 @@ static const char stat_208[] = "No GPIO for this value";
 static const char stat_209[] = "209";
 
 static const char stat_210[] = "Marlin G29 command was not configured at compile-time";
-static const char stat_211[] = "211";
-static const char stat_212[] = "212";
-static const char stat_213[] = "213";
-static const char stat_214[] = "214";
-static const char stat_215[] = "215";
+static const char stat_211[] = "Planner starved";
+static const char stat_212[] = "Spindle did not reach speed";
+static const char stat_213[] = "Motion link lost sync";
+static const char stat_214[] = "Spindle encoder is not configured";
+static const char stat_215[] = "Spindle VFD is not responding";
 static const char stat_216[] = "216";
 static const char stat_217[] = "217";
 static const char stat_218[] = "218";
@@ -644,7 +644,7 @@ static const char stat_244[] = "Homing Err - Travel min & max are the same";
 static const char stat_245[] = "245";
 static const char stat_246[] = "Homing Err - Homing input is misconfigured";
 static const char stat_247[] = "Homing Err - Must clear switches before homing";
-static const char stat_248[] = "248";
+static const char stat_248[] = "Homing Err - Search ended without finding the switch";
 static const char stat_249[] = "249";
 
 static const char stat_250[] = "Probe cycle failed";
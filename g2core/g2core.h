@@ -49,6 +49,58 @@
 
 #define __DIAGNOSTICS               // enables various debug functions
 #define __DIAGNOSTIC_PARAMETERS     // enables system diagnostic parameters (_xx) in config_app
+#define __PROFILE                   // enables DWT cycle profiling of the stepper interrupts ({prof:n})
+
+/****** HOT PATH PLACEMENT ******/
+// With FAST_HOT_PATHS (make FAST_HOT_PATHS=1) the stepper interrupt chain is built for speed
+// and linked into HOT_PATH_SECTION, which the startup code copies to RAM so it runs without
+// flash wait states. Everything else keeps the Makefile's OPTIMIZATION. See {profo:}
+
+#ifndef FAST_HOT_PATHS
+#define FAST_HOT_PATHS 0
+#endif
+#ifndef HOT_PATH_SECTION
+#define HOT_PATH_SECTION ".ramfunc"
+#endif
+#if FAST_HOT_PATHS == 1
+#define HOT_PATH __attribute__((optimize("O3"), section(HOT_PATH_SECTION)))
+#else
+#define HOT_PATH
+#endif
+
+// With FAST_HOT_DATA (make FAST_HOT_DATA=1) the stepper and runtime singletons (HOT_DATA:
+// st_run, st_pre, en, mr and the planner's hot buffer records in mb) are linked into
+// HOT_DATA_SECTION for the linker to put in the M7's DTCM - single cycle and off the bus
+// matrix. A linker script without a rule for it files it with the rest of .bss. Cold data
+// (the nv list, strings, mbc) stays in SRAM. See {profo:}
+
+#ifndef FAST_HOT_DATA
+#define FAST_HOT_DATA 0
+#endif
+#ifndef HOT_DATA_SECTION
+#define HOT_DATA_SECTION ".bss.dtcm"
+#endif
+#if FAST_HOT_DATA == 1
+#define HOT_DATA __attribute__((section(HOT_DATA_SECTION)))
+#else
+#define HOT_DATA
+#endif
+
+/****** DATA CACHE ******/
+// The M7 boards run with the caches on and the data cache forced write-through (see their
+// hardware_init()), so memory always holds what the CPU wrote and DMA can send from any
+// buffer as it is. Memory the DMA writes must be invalidated before the CPU reads it. With
+// write-through that's safe on whole cache lines, as nothing of the CPU's can be lost.
+
+static inline void hw_dcache_invalidate(volatile void *addr, int32_t size)
+{
+#if defined(__CM7_REV)
+    if (SCB->CCR & SCB_CCR_DC_Msk) {
+        uint32_t start = (uint32_t)addr & ~(uint32_t)31;    // 32 byte cache lines
+        SCB_InvalidateDCache_by_Addr((uint32_t *)start, size + (int32_t)((uint32_t)addr - start));
+    }
+#endif
+}
 
 /******************************************************************************
  ***** APPLICATION DEFINITIONS ************************************************
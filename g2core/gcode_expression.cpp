@@ -0,0 +1,390 @@
+/*
+ * gcode_expression.cpp - Gcode parameters and expressions compiled to bytecode
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* --- Expression Notes ----
+ *
+ *  The compiler reads the normalized block (upper case, no spaces) by recursive descent,
+ *  binding as RS274NGC does: ** first, then * / MOD, then + -. Operators of the same
+ *  precedence run left to right. A value is a number, a bracketed expression, a function
+ *  call, or # and a value - so #[#1+2] and ##3 are indirect references.
+ *
+ *  Integers 0-255 compile to 2 bytes and #1 to #255 to 2 bytes, so "X[#1*2+3]" is
+ *  9 bytes of code. Each operator pops its operands and pushes its result. The
+ *  compiler counts the stack as it goes and refuses anything that would need more
+ *  than GX_STACK_DEPTH entries.
+ *
+ *  Evaluation errors: a parameter number that isn't an integer in range, division or
+ *  MOD by zero, and any result that isn't a finite number (SQRT[-1], LN[0]).
+ */
+#include "g2core.h"
+#include "gcode_expression.h"
+#include "util.h"
+
+static float gx_param[GCODE_PARAMETERS];    // #1 is gx_param[0]
+
+typedef struct gxCompiler {                 // compiler state. Kept local
+    char *rd;                               // normalized block read pointer
+    uint8_t *wr;                            // code write pointer
+    const uint8_t *end;                     // end of the code buffer
+    uint8_t depth;                          // stack entries when the code written so far runs
+    uint8_t nesting;                        // values nested in each other
+} gxCompiler_t;
+
+typedef struct gxFunction {
+    const char *name;
+    uint8_t opcode;
+} gxFunction_t;
+
+static const gxFunction_t gx_functions[] = {    // ATAN is two-argument, and handled apart
+    { "ABS", GX_ABS },   { "ACOS", GX_ACOS }, { "ASIN", GX_ASIN }, { "COS", GX_COS },
+    { "EXP", GX_EXP },   { "FIX", GX_FIX },   { "FUP", GX_FUP },   { "LN", GX_LN },
+    { "ROUND", GX_ROUND }, { "SIN", GX_SIN }, { "SQRT", GX_SQRT }, { "TAN", GX_TAN }
+};
+
+static stat_t _compile_value(gxCompiler_t &c);
+static stat_t _compile_expression(gxCompiler_t &c);
+
+/*
+ * _emit() - write an opcode or operand byte
+ * _emit_op() - write an operator and account for the stack entries it pops and pushes
+ */
+
+static stat_t _emit(gxCompiler_t &c, const uint8_t byte)
+{
+    if (c.wr >= c.end) {
+        return (STAT_EXPRESSION_TOO_COMPLEX);
+    }
+    *(c.wr++) = byte;
+    return (STAT_OK);
+}
+
+static stat_t _emit_op(gxCompiler_t &c, const uint8_t opcode, const uint8_t pops, const uint8_t pushes)
+{
+    c.depth = c.depth - pops + pushes;
+    if (c.depth > GX_STACK_DEPTH) {
+        return (STAT_EXPRESSION_TOO_COMPLEX);
+    }
+    return (_emit(c, opcode));
+}
+
+/*
+ * _compile_bracket() - compile "[expression]"
+ */
+
+static stat_t _compile_bracket(gxCompiler_t &c)
+{
+    if (*c.rd != '[') {
+        return (STAT_EXPRESSION_INVALID);
+    }
+    c.rd++;
+    ritorno(_compile_expression(c));
+    if (*c.rd != ']') {
+        return (STAT_EXPRESSION_INVALID);
+    }
+    c.rd++;
+    return (STAT_OK);
+}
+
+/*
+ * _compile_number() - compile a constant. It must start with a digit or a point
+ */
+
+static stat_t _compile_number(gxCompiler_t &c)
+{
+    float value;
+    if (!atofloat(&c.rd, &value, false)) {
+        return (STAT_BAD_NUMBER_FORMAT);
+    }
+    if ((value >= 0) && (value <= 255) && (value == (uint8_t)value)) {
+        ritorno(_emit_op(c, GX_SMALL, 0, 1));
+        return (_emit(c, (uint8_t)value));
+    }
+    ritorno(_emit_op(c, GX_CONST, 0, 1));
+    uint8_t bytes[sizeof(float)];
+    memcpy(bytes, &value, sizeof(float));
+    for (uint8_t i=0; i < sizeof(float); i++) {
+        ritorno(_emit(c, bytes[i]));
+    }
+    return (STAT_OK);
+}
+
+/*
+ * _compile_function() - compile a function call, which starts with a letter
+ */
+
+static stat_t _compile_function(gxCompiler_t &c)
+{
+    if (strncmp(c.rd, "ATAN", 4) == 0) {
+        c.rd += 4;
+        ritorno(_compile_bracket(c));
+        if (*(c.rd++) != '/') {
+            return (STAT_EXPRESSION_INVALID);
+        }
+        ritorno(_compile_bracket(c));
+        return (_emit_op(c, GX_ATAN, 2, 1));
+    }
+    for (uint8_t i=0; i < sizeof(gx_functions)/sizeof(gx_functions[0]); i++) {
+        uint8_t len = strlen(gx_functions[i].name);
+        if ((strncmp(c.rd, gx_functions[i].name, len) == 0) && (c.rd[len] == '[')) {
+            c.rd += len;
+            ritorno(_compile_bracket(c));
+            return (_emit_op(c, gx_functions[i].opcode, 1, 1));
+        }
+    }
+    return (STAT_EXPRESSION_INVALID);
+}
+
+/*
+ * _compile_value() - compile a value: a number, [expression], function, #value, or a signed value
+ */
+
+static stat_t _compile_value(gxCompiler_t &c)
+{
+    if (++c.nesting > GX_NESTING_MAX) {
+        return (STAT_EXPRESSION_TOO_COMPLEX);
+    }
+    char ch = *c.rd;
+    if (ch == '-') {
+        c.rd++;
+        ritorno(_compile_value(c));
+        ritorno(_emit_op(c, GX_NEG, 1, 1));
+    } else if (ch == '+') {
+        c.rd++;
+        ritorno(_compile_value(c));
+    } else if (ch == '#') {
+        c.rd++;
+        uint8_t *number = c.wr;
+        ritorno(_compile_value(c));
+        if ((c.wr == number + 2) && (number[0] == GX_SMALL) && (number[1] != 0)) {
+            number[0] = GX_PARAM_N;                 // #1 to #255 - a constant number
+        } else {
+            ritorno(_emit_op(c, GX_PARAM, 1, 1));
+        }
+    } else if (ch == '[') {
+        ritorno(_compile_bracket(c));
+    } else if (isdigit(ch) || (ch == '.')) {
+        ritorno(_compile_number(c));
+    } else if (isupper(ch)) {
+        ritorno(_compile_function(c));
+    } else {
+        return (STAT_EXPRESSION_INVALID);
+    }
+    c.nesting--;
+    return (STAT_OK);
+}
+
+/*
+ * _compile_power() - value [** value ...]
+ * _compile_term() - power [* / MOD power ...]
+ * _compile_expression() - term [+ - term ...]
+ */
+
+static stat_t _compile_power(gxCompiler_t &c)
+{
+    ritorno(_compile_value(c));
+    while ((c.rd[0] == '*') && (c.rd[1] == '*')) {
+        c.rd += 2;
+        ritorno(_compile_value(c));
+        ritorno(_emit_op(c, GX_POW, 2, 1));
+    }
+    return (STAT_OK);
+}
+
+static stat_t _compile_term(gxCompiler_t &c)
+{
+    ritorno(_compile_power(c));
+    for (;;) {
+        uint8_t opcode;
+        if (*c.rd == '*') {
+            opcode = GX_MUL;
+            c.rd++;
+        } else if (*c.rd == '/') {
+            opcode = GX_DIV;
+            c.rd++;
+        } else if (strncmp(c.rd, "MOD", 3) == 0) {
+            opcode = GX_MOD;
+            c.rd += 3;
+        } else {
+            return (STAT_OK);
+        }
+        ritorno(_compile_power(c));
+        ritorno(_emit_op(c, opcode, 2, 1));
+    }
+}
+
+static stat_t _compile_expression(gxCompiler_t &c)
+{
+    if (++c.nesting > GX_NESTING_MAX) {
+        return (STAT_EXPRESSION_TOO_COMPLEX);
+    }
+    ritorno(_compile_term(c));
+    while ((*c.rd == '+') || (*c.rd == '-')) {
+        uint8_t opcode = (*(c.rd++) == '+') ? GX_ADD : GX_SUB;
+        ritorno(_compile_term(c));
+        ritorno(_emit_op(c, opcode, 2, 1));
+    }
+    c.nesting--;
+    return (STAT_OK);
+}
+
+/*
+ * gx_compile() - compile the word value at *pstr
+ *
+ *  pstr     - normalized block, at the value. Left after it, as c_atof() does
+ *  code     - where the code goes. Left after the GX_END that ends it
+ *  code_end - end of the code buffer
+ *
+ *  Returns STAT_EXPRESSION_TOO_COMPLEX if the code doesn't fit or needs too deep a stack.
+ */
+
+stat_t gx_compile(char **pstr, uint8_t **code, const uint8_t *code_end)
+{
+    gxCompiler_t c;
+    c.rd = *pstr;
+    c.wr = *code;
+    c.end = code_end;
+    c.depth = 0;
+    c.nesting = 0;
+
+    ritorno(_compile_value(c));
+    ritorno(_emit_op(c, GX_END, 1, 0));
+    *pstr = c.rd;
+    *code = c.wr;
+    return (STAT_OK);
+}
+
+/*
+ * _get_parameter_index() - the array index of a parameter number, or -1 if it's invalid
+ */
+
+static int16_t _get_parameter_index(const float number)
+{
+    if ((number < 1) || (number > GCODE_PARAMETERS) || (number != (int16_t)number)) {
+        return (-1);
+    }
+    return ((int16_t)number - 1);
+}
+
+/*
+ * gx_evaluate() - run the code of one expression
+ *
+ *  code - the code, from gx_compile(). Left after the GX_END
+ */
+
+stat_t gx_evaluate(const uint8_t **code, float *value)
+{
+    float stack[GX_STACK_DEPTH];
+    int8_t top = -1;                            // the compiler has checked the depth
+    const uint8_t *pc = *code;
+
+    for (;;) {
+        switch (*(pc++)) {
+            case GX_END: {
+                *code = pc;
+                *value = stack[0];
+                if (isnan(*value)) {
+                    return (STAT_FLOAT_IS_NAN);
+                }
+                if (isinf(*value)) {
+                    return (STAT_FLOAT_IS_INFINITE);
+                }
+                return (STAT_OK);
+            }
+            case GX_CONST: { memcpy(&stack[++top], pc, sizeof(float)); pc += sizeof(float); break; }
+            case GX_SMALL: { stack[++top] = *(pc++); break; }
+            case GX_PARAM_N: {
+                int16_t index = _get_parameter_index(*(pc++));
+                if (index < 0) {
+                    return (STAT_PARAMETER_NUMBER_INVALID);
+                }
+                stack[++top] = gx_param[index];
+                break;
+            }
+            case GX_PARAM: {
+                int16_t index = _get_parameter_index(stack[top]);
+                if (index < 0) {
+                    return (STAT_PARAMETER_NUMBER_INVALID);
+                }
+                stack[top] = gx_param[index];
+                break;
+            }
+            case GX_ADD: { top--; stack[top] += stack[top+1]; break; }
+            case GX_SUB: { top--; stack[top] -= stack[top+1]; break; }
+            case GX_MUL: { top--; stack[top] *= stack[top+1]; break; }
+            case GX_DIV: {
+                top--;
+                if (fp_ZERO(stack[top+1])) {
+                    return (STAT_DIVIDE_BY_ZERO);
+                }
+                stack[top] /= stack[top+1];
+                break;
+            }
+            case GX_MOD: {                      // RS274NGC MOD is never negative
+                top--;
+                if (fp_ZERO(stack[top+1])) {
+                    return (STAT_DIVIDE_BY_ZERO);
+                }
+                stack[top] = fmod(stack[top], stack[top+1]);
+                if (stack[top] < 0) {
+                    stack[top] += fabs(stack[top+1]);
+                }
+                break;
+            }
+            case GX_POW:   { top--; stack[top] = pow(stack[top], stack[top+1]); break; }
+            case GX_ATAN:  { top--; stack[top] = atan2(stack[top], stack[top+1]) * (180 / M_PI); break; }
+            case GX_NEG:   { stack[top] = -stack[top]; break; }
+            case GX_ABS:   { stack[top] = fabs(stack[top]); break; }
+            case GX_ACOS:  { stack[top] = acos(stack[top]) * (180 / M_PI); break; }
+            case GX_ASIN:  { stack[top] = asin(stack[top]) * (180 / M_PI); break; }
+            case GX_COS:   { stack[top] = cos(stack[top] * (M_PI / 180)); break; }
+            case GX_EXP:   { stack[top] = exp(stack[top]); break; }
+            case GX_FIX:   { stack[top] = floor(stack[top]); break; }
+            case GX_FUP:   { stack[top] = ceil(stack[top]); break; }
+            case GX_LN:    { stack[top] = log(stack[top]); break; }
+            case GX_ROUND: { stack[top] = round(stack[top]); break; }
+            case GX_SIN:   { stack[top] = sin(stack[top] * (M_PI / 180)); break; }
+            case GX_SQRT:  { stack[top] = sqrt(stack[top]); break; }
+            case GX_TAN:   { stack[top] = tan(stack[top] * (M_PI / 180)); break; }
+            default: {
+                return (STAT_EXPRESSION_INVALID);   // code was overwritten
+            }
+        }
+    }
+}
+
+/*
+ * gx_set_parameter() - set a numbered parameter
+ */
+
+stat_t gx_set_parameter(const float number, const float value)
+{
+    int16_t index = _get_parameter_index(number);
+    if (index < 0) {
+        return (STAT_PARAMETER_NUMBER_INVALID);
+    }
+    gx_param[index] = value;
+    return (STAT_OK);
+}
@@ -0,0 +1,87 @@
+/*
+ * gcode_expression.h - Gcode parameters and expressions compiled to bytecode
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ *  Word values may be numbered parameters and bracketed expressions, as in RS274NGC:
+ *
+ *      #1=25 #2=[#1/2]
+ *      G1 X[#1*2+3] Y#2 Z-#[#3+1]
+ *
+ *  Expressions take + - * / MOD and ** (power), unary minus, nested brackets, and the
+ *  functions ABS ACOS ASIN COS EXP FIX FUP LN ROUND SIN SQRT TAN, plus ATAN[y]/[x].
+ *  Angles are in degrees. Parameters are numbered 1 to GCODE_PARAMETERS and start at 0.
+ *
+ *  An expression is compiled once to a few bytes of stack machine code, which the
+ *  parser keeps with the block - in the block cache too - and evaluated from there.
+ *  The compiler works out the stack depth, so the evaluator doesn't check it.
+ *
+ *  Include after g2core.h
+ */
+
+#ifndef GCODE_EXPRESSION_H_ONCE
+#define GCODE_EXPRESSION_H_ONCE
+
+#ifndef GCODE_PARAMETERS
+#define GCODE_PARAMETERS        100     // numbered parameters #1 to #100
+#endif
+#define GX_STACK_DEPTH          8       // evaluation stack. Deeper expressions are refused
+#define GX_NESTING_MAX          8       // brackets and parameter references nested in each other
+
+typedef enum {                          // bytecode. Operands follow the opcode
+    GX_END = 0,                         // end of the expression - the value is on the stack
+    GX_CONST,                           // push the float that follows (4 bytes)
+    GX_SMALL,                           // push the integer 0-255 that follows (1 byte)
+    GX_PARAM_N,                         // push the parameter numbered by the byte that follows
+    GX_PARAM,                           // replace the parameter number on the stack with its value
+    GX_ADD,                             // binary operators: pop b, pop a, push a op b
+    GX_SUB,
+    GX_MUL,
+    GX_DIV,
+    GX_MOD,
+    GX_POW,
+    GX_ATAN,                            // ATAN[a]/[b]
+    GX_NEG,                             // unary operators and functions replace the top of the stack
+    GX_ABS,
+    GX_ACOS,
+    GX_ASIN,
+    GX_COS,
+    GX_EXP,
+    GX_FIX,
+    GX_FUP,
+    GX_LN,
+    GX_ROUND,
+    GX_SIN,
+    GX_SQRT,
+    GX_TAN
+} gxOpcode;
+
+/**** Function Prototypes ****/
+
+stat_t gx_compile(char **pstr, uint8_t **code, const uint8_t *code_end);
+stat_t gx_evaluate(const uint8_t **code, float *value);
+stat_t gx_set_parameter(const float number, const float value);
+
+#endif // End of include guard: GCODE_EXPRESSION_H_ONCE
@@ -0,0 +1,107 @@
+/*
+ * gcode_macro.cpp - Gcode macros compiled into flash, run by M98 and M6
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "g2core.h"
+#include "gcode_macro.h"
+#include "gcode_expression.h"
+#include "xio.h"
+
+// the flash files. A macro that isn't defined is a nullptr in gc_macro[]
+
+#ifdef GCODE_MACRO_1
+static auto gc_macro_1 = make_xio_flash_file(GCODE_MACRO_1);
+#define GC_MACRO_1 &gc_macro_1
+#else
+#define GC_MACRO_1 nullptr
+#endif
+
+#ifdef GCODE_MACRO_2
+static auto gc_macro_2 = make_xio_flash_file(GCODE_MACRO_2);
+#define GC_MACRO_2 &gc_macro_2
+#else
+#define GC_MACRO_2 nullptr
+#endif
+
+#ifdef GCODE_MACRO_3
+static auto gc_macro_3 = make_xio_flash_file(GCODE_MACRO_3);
+#define GC_MACRO_3 &gc_macro_3
+#else
+#define GC_MACRO_3 nullptr
+#endif
+
+#ifdef GCODE_MACRO_4
+static auto gc_macro_4 = make_xio_flash_file(GCODE_MACRO_4);
+#define GC_MACRO_4 &gc_macro_4
+#else
+#define GC_MACRO_4 nullptr
+#endif
+
+#ifdef GCODE_MACRO_TOOL_CHANGE
+static auto gc_macro_tool_change_file = make_xio_flash_file(GCODE_MACRO_TOOL_CHANGE);
+#endif
+
+static xio_flash_file *const gc_macro[GCODE_MACROS] = { GC_MACRO_1, GC_MACRO_2, GC_MACRO_3, GC_MACRO_4 };
+
+/*
+ * gc_macro_call() - M98 P<n>
+ */
+
+stat_t gc_macro_call(const float number, const bool number_given)
+{
+    if (!number_given) {
+        return (STAT_P_WORD_IS_MISSING);
+    }
+    if ((number < 1) || (number > GCODE_MACROS) || (floor(number) != number)) {
+        return (STAT_P_WORD_IS_INVALID);
+    }
+    xio_flash_file *macro = gc_macro[(uint8_t)number - 1];
+    if (macro == nullptr) {
+        return (STAT_MACRO_NOT_DEFINED);
+    }
+    if (!xio_send_file(*macro)) {
+        return (STAT_MACRO_ALREADY_RUNNING);
+    }
+    return (STAT_OK);
+}
+
+/*
+ * gc_macro_tool_change() - M6 - run the tool change macro, if there is one, for the new tool
+ *
+ *  From a macro - the tool change macro itself in most cases - it does nothing.
+ */
+
+stat_t gc_macro_tool_change(const uint8_t tool)
+{
+#ifdef GCODE_MACRO_TOOL_CHANGE
+    if (xio_file_is_sending()) {
+        return (STAT_OK);
+    }
+    ritorno(gx_set_parameter(GCODE_MACRO_TOOL_PARAMETER, tool));
+    xio_send_file(gc_macro_tool_change_file);
+#endif
+    return (STAT_OK);
+}
@@ -0,0 +1,57 @@
+/*
+ * gcode_macro.h - Gcode macros compiled into flash, run by M98 and M6
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ *  A macro is a Gcode program compiled into flash - plain text, as the MARLIN_G29_SCRIPT
+ *  strings are, or tokenized by Resources/tokenize_gcode.py - and run through the flash
+ *  file device (xio_send_file()). Its lines go straight to the parser, ahead of anything
+ *  the host has sent, so a tool change or probing routine costs one host line.
+ *
+ *      M98 P<n>    run macro n, 1 to GCODE_MACROS, defined by GCODE_MACRO_<n>
+ *      M6          change the tool, then run GCODE_MACRO_TOOL_CHANGE if it is defined
+ *
+ *  Macros take their arguments in the numbered parameters. The assignments in a block
+ *  are made before it runs, so "#1=12.5 #2=3 M98 P2" calls macro 2 with #1 and #2 set.
+ *  M6 puts the new tool number in #GCODE_MACRO_TOOL_PARAMETER. Macros don't nest: M98
+ *  from a macro is refused, and M6 from a macro only changes the tool.
+ *
+ *  Include after g2core.h
+ */
+
+#ifndef GCODE_MACRO_H_ONCE
+#define GCODE_MACRO_H_ONCE
+
+#define GCODE_MACROS            4       // M98 P1 to P4
+#ifndef GCODE_MACRO_TOOL_PARAMETER
+#define GCODE_MACRO_TOOL_PARAMETER 100  // M6 passes the tool number in #100
+#endif
+
+/**** Function Prototypes ****/
+
+stat_t gc_macro_call(const float number, const bool number_given);
+stat_t gc_macro_tool_change(const uint8_t tool);
+
+#endif // End of include guard: GCODE_MACRO_H_ONCE
@@ -21,10 +21,13 @@
 #include "config.h"  // #2
 #include "controller.h"
 #include "gcode_parser.h"
+#include "gcode_expression.h"
+#include "gcode_macro.h"
 #include "canonical_machine.h"
 #include "settings.h"
 #include "spindle.h"
 #include "coolant.h"
+#include "gpio.h"
 #include "util.h"
 #include "xio.h"                    // for char definitions
 
@@ -41,7 +44,7 @@ static stat_t _execute_gcode_block_marlin(void);
 
 typedef enum {                          // Used for detecting gcode errors. See NIST section 3.4
     MODAL_GROUP_G0 = 0,                 // {G10,G28,G28.1,G92}  non-modal axis commands (note 1)
-    MODAL_GROUP_G1,                     // {G0,G1,G2,G3,G80}    motion
+    MODAL_GROUP_G1,                     // {G0,G1,G2,G3,G73,G80,G81,G82,G83} motion
     MODAL_GROUP_G2,                     // {G17,G18,G19}        plane selection
     MODAL_GROUP_G3,                     // {G90,G91}            distance mode
     MODAL_GROUP_G5,                     // {G93,G94}            feed rate mode
@@ -80,6 +83,7 @@ typedef enum {                                  // these are in order to optimiz
     NEXT_ACTION_STRAIGHT_PROBE,                 // G38.3
     NEXT_ACTION_STRAIGHT_PROBE_AWAY_ERR,        // G38.4
     NEXT_ACTION_STRAIGHT_PROBE_AWAY,            // G38.5
+    NEXT_ACTION_SCAN_PROBE,                     // G38.6
     NEXT_ACTION_SET_TL_OFFSET,                  // G43
     NEXT_ACTION_SET_ADDITIONAL_TL_OFFSET,       // G43.2
     NEXT_ACTION_CANCEL_TL_OFFSET,               // G49
@@ -90,6 +94,7 @@ typedef enum {                                  // these are in order to optimiz
     NEXT_ACTION_JSON_COMMAND_SYNC,              // M100
     NEXT_ACTION_JSON_COMMAND_ASYNC,             // M100.1
     NEXT_ACTION_JSON_WAIT,                      // M101
+    NEXT_ACTION_MACRO_CALL,                     // M98
 
 #if MARLIN_COMPAT_ENABLED == true
     NEXT_ACTION_MARLIN_TRAM_BED,                // G29
@@ -106,6 +111,7 @@ typedef enum {                                  // these are in order to optimiz
     NEXT_ACTION_MARLIN_REPORT_VERSION,          // M115
     NEXT_ACTION_MARLIN_DISPLAY_ON_SCREEN,       // M117
     NEXT_ACTION_MARLIN_SET_BED_TEMP,            // M140, M190
+    NEXT_ACTION_MARLIN_SET_PRESSURE_ADVANCE,    // M900
 #endif
 
 } gpNextAction;
@@ -115,18 +121,19 @@ typedef enum {                                  // these are in order to optimiz
 typedef struct GCodeInputValue {    // Gcode inputs - meaning depends on context
 
     gpNextAction next_action;       // handles G modal group 1 moves & non-modals
-    cmMotionMode motion_mode;       // Group1: G0, G1, G2, G3, G38.2, G80, G81, G82, G83, G84, G85, G86, G87, G88, G89
+    cmMotionMode motion_mode;       // Group1: G0, G1, G2, G3, G5, G33, G33.1, G38.2, G73, G80, G81, G82, G83, G84, G85, G86, G87, G88, G89
     uint8_t program_flow;           // used only by the gcode_parser
     uint32_t linenum;               // N word
 
     float target[AXES];             // XYZABC where the move should go
     float arc_offset[3];            // IJK - used by arc commands
-    float arc_radius;               // R - radius value in arc radius mode
+    float arc_radius;               // R - radius value in arc radius mode, retract plane in canned cycles
 
     float F_word;                   // F - normalized to millimeters/minute
     uint8_t H_word;                 // H word - used by G43s
     uint8_t L_word;                 // L word - used by G10s
     float P_word;                   // P - parameter used for dwell time in seconds, G10 coord select...
+    float Q_word;                   // Q - peck depth in canned cycles
     float S_word;                   // S word - in RPM
 
     uint8_t feed_rate_mode;         // See cmFeedRateMode for settings
@@ -137,6 +144,7 @@ typedef struct GCodeInputValue {    // Gcode inputs - meaning depends on context
     uint8_t distance_mode;          // G91   0=use absolute coords(G90), 1=incremental movement
     uint8_t arc_distance_mode;      // G90.1=use absolute IJK offsets, G91.1=incremental IJK offsets
     uint8_t origin_offset_mode;     // G92...TRUE=in origin offset mode
+    uint8_t retract_mode;           // G98, G99 - see cmRetractMode
     uint8_t absolute_override;      // G53 TRUE = move using machine coordinates - this block only (G53)
     uint8_t tool;                   // Tool after T and M6 (tool_select and tool_change)
     uint8_t tool_select;            // T value - T sets this value
@@ -144,6 +152,7 @@ typedef struct GCodeInputValue {    // Gcode inputs - meaning depends on context
     uint8_t mist_coolant;           // TRUE = mist on (M7), FALSE = off (M9)
     uint8_t flood_coolant;          // TRUE = flood on (M8), FALSE = off (M9)
     uint8_t spindle_control;        // 0=OFF (M5), 1=CW (M3), 2=CCW (M4)
+    uint8_t output_control;         // M62, M63, M64, M65 - the output number is the P word
 
     bool m48_enable;                // M48/M49 input (enables for feed and spindle)
     bool mfo_control;               // M50 feedrate override control
@@ -172,6 +181,7 @@ typedef struct GCodeFlags {         // Gcode input flags
     bool H_word;
     bool L_word;
     bool P_word;
+    bool Q_word;
     bool S_word;
 
     bool feed_rate_mode;
@@ -182,6 +192,7 @@ typedef struct GCodeFlags {         // Gcode input flags
     bool distance_mode;
     bool arc_distance_mode;
     bool origin_offset_mode;
+    bool retract_mode;
     bool absolute_override;
     bool tool;
     bool tool_select;
@@ -189,6 +200,7 @@ typedef struct GCodeFlags {         // Gcode input flags
     bool mist_coolant;
     bool flood_coolant;
     bool spindle_control;
+    bool output_control;
 
     bool m48_enable;
     bool mfo_control;
@@ -214,13 +226,17 @@ GCodeValue_t gv;    // gcode input values
 GCodeFlag_t gf;     // gcode input flags
 
 // local helper functions and macros
-void _normalize_gcode_block(char *str, char **active_comment, uint8_t *block_delete_flag);
-stat_t _get_next_gcode_word(char **pstr, char *letter, float *value);
+stat_t _lex_gcode_block(char *block, char **active_comment, uint8_t *block_delete_flag);
 stat_t _point(float value);
-stat_t _verify_checksum(char *str);
 stat_t _validate_gcode_block(char *active_comment);
-stat_t _parse_gcode_block(char *line, char *active_comment); // Parse the block into the GN/GF structs
+stat_t _parse_gcode_block(char *active_comment);             // Parse the block into the GN/GF structs
 stat_t _execute_gcode_block(char *active_comment);           // Execute the gcode block
+static stat_t _parse_value_word(const char letter, const float value);
+static void _set_block_defaults(void);
+static bool _block_has_feed_move(void);
+static stat_t _output_control(void);
+static bool _block_cache_run(char *block, stat_t *status);
+static void _block_cache_store(void);
 
 #define SET_MODAL(m,parm,val) ({gv.parm=val; gf.parm=true; gp.modals[m]=true; break;})
 #define SET_NON_MODAL(parm,val) ({gv.parm=val; gf.parm=true; break;})
@@ -239,31 +255,28 @@ void gcode_parser_init()
 /*
  * gcode_parser() - parse a block (line) of gcode
  *
- *  Top level of gcode parser. Normalizes block and looks for special cases
+ *  Top level of gcode parser. Lexes the block and looks for special cases
  */
 
 stat_t gcode_parser(char *block)
 {
-    char *str = block;                      // gcode command or NUL string
-    char none = NUL;
-    char *active_comment = &none;           // gcode comment or NUL string
+    char *active_comment;                   // gcode comment or NUL string
     uint8_t block_delete_flag;
+    stat_t status;
 
-    stat_t check_ret = _verify_checksum(str);
-    if (check_ret != STAT_OK) {
-        return check_ret;
+    if (_block_cache_run(block, &status)) { // a block parsed before runs without lexing or parsing
+        return (status);
     }
-
-    _normalize_gcode_block(str, &active_comment, &block_delete_flag);
+    ritorno(_lex_gcode_block(block, &active_comment, &block_delete_flag));
 
     // TODO, now MSG is put in the active comment, handle that.
 
-    if (str[0] == NUL) {                    // normalization returned null string
+    if (block[0] == NUL) {                  // normalization returned null string
         return (STAT_OK);                   // most likely a comment line
     }
 
     // Trap M30 and M2 as $clear conditions. This has no effect if not in ALARM or SHUTDOWN
-    cm_parse_clear(str);                    // parse Gcode and clear alarms if M30 or M2 is found
+    cm_parse_clear(block);                  // parse Gcode and clear alarms if M30 or M2 is found
     ritorno(cm_is_alarmed());               // return error status if in alarm, shutdown or panic
 
     // Block delete omits the line if a / char is present in the first space
@@ -272,54 +285,27 @@ stat_t gcode_parser(char *block)
     if (block_delete_flag == true) {
         return (STAT_NOOP);
     }
-    return(_parse_gcode_block(block, active_comment));
+    return(_parse_gcode_block(active_comment));
 }
 
 /*
- * _verify_checksum() - ensure that, if there is a checksum, that it's valid
+ * _lex_gcode_block() - checksum, normalize and split a block (line) of gcode into words
  *
- * Returns STAT_OK is it's valid.
- * Returns STAT_CHECKSUM_MATCH_FAILED if the checksum doesn't match.
- */
-stat_t _verify_checksum(char *str)
-{
-    bool has_line_number = false; // -1 means we don't have one
-    if (*str == 'N') {
-        has_line_number = true;
-    }
-
-    char checksum = 0;
-    char c = *str++;
-    while (c && (c != '*') && (c != '\n') && (c != '\r')) {
-        checksum ^= c;
-        c = *str++;
-    }
-
-    // c might be 0 here, in which case we didn't get a checksum and we return STAT_OK
-
-    if (c == '*') {
-        *(str-1) = 0; // null terminate, the parser won't like this * here!
-        gf.checksum = true;
-        if (strtol(str, NULL, 10) != checksum) {
-            _debug_trap("checksum failure");
-            return STAT_CHECKSUM_MATCH_FAILED;
-        }
-        if (!has_line_number) {
-            _debug_trap("line number missing with checksum");
-            return STAT_MISSING_LINE_NUMBER_WITH_CHECKSUM;
-        }
-    }
-    return STAT_OK;
-}
-
-/*
- * _normalize_gcode_block() - normalize a block (line) of gcode in place
+ *  One pass over the block does what used to take a checksum scan and a normalization
+ *  pass. The words are then decoded from the (much shorter) normalized block into
+ *  gw.word[], and _parse_gcode_block() works from those.
+ *
+ *  Checksum:
+ *   - the checksum is the XOR of every character before a '*', comments included
+ *   - a '*' ends the block unless a CR or LF came before it
+ *   - Returns STAT_CHECKSUM_MATCH_FAILED if the checksum doesn't match
+ *   - Returns STAT_MISSING_LINE_NUMBER_WITH_CHECKSUM if the block doesn't start with N
  *
  *  Normalization functions:
  *   - Isolate "active comments"
  *   - Many of the following are performed in active comments as well
  *   - Strings are handled special (TODO)
- *   - Active comments are moved to the end of the string, and multiple active comments are merged into one
+ *   - Active comments are collected into _normalize_scratch, and multiple active comments are merged into one
  *   - convert all letters to upper case
  *   - remove white space, control and other invalid characters
  *   - remove (erroneous) leading zeros that might be taken to mean Octal
@@ -329,10 +315,15 @@ stat_t _verify_checksum(char *str)
  *
  *  So this: "g1 x100 Y100 f400" becomes this: "G1X100Y100F400"
  *
+ *  The gcode is compacted in place - the write pointer never passes the read pointer - so the
+ *  block may be a view straight into the RX buffer. Never write past the block's terminating NUL,
+ *  as the characters after it may be the next line. Active comments can grow (msg quoting), so
+ *  they are built in the scratch buffer instead and returned from there.
+ *
  *  Comment and message handling:
  *   - Active comments start with exactly "({" and end with "})" (no relaxing, invalid is invalid)
  *   - Comments field start with a '(' char or alternately a semicolon ';'
- *   - Active comments are moved to the end of the string and merged.
+ *   - Active comments are removed from the block and merged.
  *   - Messages are converted to ({msg:"blah"}) active comments.
  *     - The 'MSG' specifier in comment can have mixed case but cannot cannot have embedded white spaces
  *   - Other "plain" comments will be discarded.
@@ -340,281 +331,389 @@ stat_t _verify_checksum(char *str)
  *   - Multiple active comments will be merged.
  *   - Only ONE MSG comment will be accepted.
  *
+ *  Words:
+ *   - a word is a letter and a value. Every letter in the normalized block starts a word
+ *   - values are read with c_atof(). The leading zero stripping above keeps them from being octal
+ *   - a value starting with '#' or '[' (or a sign and one of them) is an expression. It is
+ *     compiled into gw.program[] and evaluated there, so the block cache can run it again
+ *   - "#n=value" is a parameter assignment, not a word. Its two expressions go into the
+ *     program too, and it's made once the whole block is read, as in RS274NGC
+ *   - the normalizer keeps '#', brackets, and the '+' '*' and '/' inside them. A '*' is
+ *     only a checksum outside brackets. '=' is kept once a '#' was seen
+ *   - a word error (bad number, or something other than a letter after a value) stops the
+ *     words there. gw.status holds it for _parse_gcode_block(), which returns it only
+ *     when it runs out of words - so alarms and block deletes still come first
+ *
  *  Returns:
- *   - com points to comment string or to NUL if no comment
- *   - msg points to message string or to NUL if no comment
+ *   - active_comment points to the active comment string or to NUL if none
  *   - block_delete_flag is set true if block delete encountered, false otherwise
  */
 
-char _normalize_scratch[RX_BUFFER_SIZE];
+#ifndef GCODE_MAX_WORDS
+#define GCODE_MAX_WORDS 40                  // words taken from a block. More is a malformed command
+#endif
+
+typedef struct GCodeWord {
+    char letter;                            // G, X, ... always upper case
+    float value;
+    char *rest;                             // normalized block after the value (Marlin M23 filename)
+} GCodeWord_t;
+
+#ifndef GCODE_MAX_ASSIGNMENTS
+#define GCODE_MAX_ASSIGNMENTS 8             // #n= assignments in a block
+#endif
+#ifndef GCODE_PROGRAM_LEN
+#define GCODE_PROGRAM_LEN 128               // bytes of expression code in a block
+#endif
 
-void _normalize_gcode_block(char *str, char **active_comment, uint8_t *block_delete_flag)
+typedef struct GCodeAssignment {
+    float number;                           // parameter number, not yet checked
+    float value;
+} GCodeAssignment_t;
+
+typedef struct GCodeWords {                 // words of the block, for _parse_gcode_block()
+    uint8_t count;                          // words in word[]
+    stat_t status;                          // STAT_COMPLETE, or the error that stopped the words
+    bool cacheable;                         // the block cache can run the expressions again
+    uint8_t assign_count;                   // assignments in assign[]
+    uint8_t program_len;                    // bytes in program[]
+    GCodeWord_t word[GCODE_MAX_WORDS];
+    GCodeAssignment_t assign[GCODE_MAX_ASSIGNMENTS];
+    uint8_t program[GCODE_PROGRAM_LEN];     // letter (or '#') and code of each expression, in block order
+} GCodeWords_t;
+
+static GCodeWords_t gw;
+
+typedef struct GCodeLexer {                 // lexer state. Kept local so it stays in registers
+    char *rd;                               // raw read pointer
+    char *wr;                               // normalized write pointer - trails the read pointer
+    char checksum;                          // XOR of the raw characters read
+    bool star_ends;                         // a '*' ends the block. Cleared by CR or LF
+    uint8_t depth;                          // brackets open. A '*' inside them is an operator
+} GCodeLexer_t;
+
+char _normalize_scratch[RX_BUFFER_SIZE];    // active comments are merged here
+
+static char *const _normalize_scratch_end = _normalize_scratch + RX_BUFFER_SIZE - 1; // leave room for the NUL
+
+static inline void _put_comment_char(char *&ac_wr, const char c)
 {
-    _normalize_scratch[0] = 0;
+    if (ac_wr < _normalize_scratch_end) {   // an over-long comment is truncated, not overflowed
+        *(ac_wr++) = c;
+    }
+}
 
-    char *gc_rd = str;                  // read pointer
-    char *gc_wr = _normalize_scratch;   // write pointer
+// character at the read pointer, or NUL at the end of the block
+static inline char _lex_char(const GCodeLexer_t &lx)
+{
+    char c = *lx.rd;
+    return (((c == '*') && lx.star_ends && (lx.depth == 0)) ? NUL : c);
+}
 
-    char *ac_rd = str;                  // read pointer
-    char *ac_wr = _normalize_scratch;   // Active Comment write pointer
+// character k ahead of the read pointer, or NUL if the block ends first
+static inline char _lex_peek(const GCodeLexer_t &lx, const uint8_t k)
+{
+    bool star_ends = lx.star_ends && (lx.depth == 0);
+    for (uint8_t i=0; ; i++) {
+        char c = lx.rd[i];
+        if ((c == NUL) || ((c == '*') && star_ends)) {
+            return (NUL);
+        }
+        if (i == k) {
+            return (c);
+        }
+        if ((c == '\n') || (c == '\r')) {
+            star_ends = false;
+        }
+    }
+}
 
+// consume the character at the read pointer. It must not be the end of the block
+static inline void _lex_skip(GCodeLexer_t &lx)
+{
+    char c = *(lx.rd++);
+    lx.checksum ^= c;
+    if ((c == '\n') || (c == '\r')) {
+        lx.star_ends = false;
+    }
+}
+
+static inline bool _is_expression(const char *pstr)
+{
+    if ((*pstr == '-') || (*pstr == '+')) {
+        pstr++;
+    }
+    return ((*pstr == '#') || (*pstr == '['));
+}
+
+// compile an expression onto the block's program, and evaluate it
+static stat_t _lex_expression(char *&pstr, uint8_t *&code, float *value)
+{
+    const uint8_t *run = code;
+    ritorno(gx_compile(&pstr, &code, gw.program + GCODE_PROGRAM_LEN));
+    return (gx_evaluate(&run, value));
+}
+
+// split the normalized block into words. Sets gw.status to the error that stopped them
+static stat_t _lex_words_status(char *pstr, uint8_t *&code)
+{
+    uint8_t *const code_end = gw.program + GCODE_PROGRAM_LEN;
+    uint32_t letters = 0;                       // letters of the words so far
+    uint32_t expression_letters = 0;            // ...and of the expression words
+
+    while (*pstr != NUL) {
+        if (*pstr == '#') {                     // #n=value
+            if ((gw.assign_count == GCODE_MAX_ASSIGNMENTS) || (code == code_end)) {
+                return (STAT_EXPRESSION_TOO_COMPLEX);
+            }
+            GCodeAssignment_t *a = &gw.assign[gw.assign_count++];
+            *(code++) = *(pstr++);
+            ritorno(_lex_expression(pstr, code, &a->number));
+            if (*pstr != '=') {
+                return (STAT_EXPRESSION_INVALID);
+            }
+            pstr++;
+            ritorno(_lex_expression(pstr, code, &a->value));
+            continue;
+        }
+        if (!isupper(*pstr)) {                  // a word must start with a letter
+            return (STAT_INVALID_OR_MALFORMED_COMMAND);
+        }
+        char letter = *(pstr++);
+        uint32_t letter_bit = 1UL << (letter - 'A');
+        float value;
+        if (_is_expression(pstr)) {
+            if (code == code_end) {
+                return (STAT_EXPRESSION_TOO_COMPLEX);
+            }
+            *(code++) = letter;
+            ritorno(_lex_expression(pstr, code, &value));
+            if ((letter == 'G') || (letter == 'M') || (letters & letter_bit)) {
+                gw.cacheable = false;           // the cache re-runs value words only, in any order
+            }
+            expression_letters |= letter_bit;
+        } else {
+            char *start = pstr;
+            value = c_atof(pstr);
+            if (pstr == start) {                // more robust test then checking for value=0;
+#if MARLIN_COMPAT_ENABLED == true
+                if (mst.marlin_flavor) {
+                    value = 0;
+                } else {
+                    return (STAT_BAD_NUMBER_FORMAT);
+                }
+#else
+                return (STAT_BAD_NUMBER_FORMAT);
+#endif
+            }
+            if (expression_letters & letter_bit) {
+                gw.cacheable = false;
+            }
+        }
+        letters |= letter_bit;
+        if (gw.count == GCODE_MAX_WORDS) {
+            return (STAT_INVALID_OR_MALFORMED_COMMAND);
+        }
+        GCodeWord_t *w = &gw.word[gw.count++];
+        w->letter = letter;
+        w->value = value;
+        w->rest = pstr;
+    }
+    return (STAT_COMPLETE);
+}
+
+static void _lex_words(char *pstr)
+{
+    uint8_t *code = gw.program;
+
+    gw.count = 0;
+    gw.assign_count = 0;
+    gw.cacheable = true;
+    gw.status = _lex_words_status(pstr, code);
+    gw.program_len = code - gw.program;
+}
+
+stat_t _lex_gcode_block(char *block, char **active_comment, uint8_t *block_delete_flag)
+{
+    bool has_line_number = (*block == 'N');
+    char *ac_wr = _normalize_scratch;   // Active Comment write pointer
     bool last_char_was_digit = false;   // used for octal stripping
+    bool has_parameter = false;         // a '#' was seen, so '=' is an assignment
+    char c;
+
+    GCodeLexer_t lx;
+    lx.rd = block;
+    lx.wr = block;
+    lx.checksum = 0;
+    lx.star_ends = true;
+    lx.depth = 0;
 
     /* Active comment notes:
 
      We will convert as follows:
         FROM: G0 ({blah: t}) x10 (comment)
-        TO  : g0x10\0{blah:t}
-        NOTES: Active comments moved to the end, stripped of (), everything lowercased, and plain comment removed.
+        TO  : G0X10 and {blah:t}
+        NOTES: Active comments removed, stripped of (), gcode uppercased, and plain comment removed.
 
         FROM: M100 ({a:t}) (comment) ({b:f}) (comment)
-        TO  : m100\0{a:t,b:f}
+        TO  : M100 and {a:t,b:f}
         NOTES: multiple active comments merged, stripped of (), and actual comments ignored.
       */
 
-    // Move the ac_wr point forward one for every non-AC character we KEEP (plus one for a NULL in between)
-    ac_wr++;                            // account for the in-between NULL
-
-
     // mark block deletes
-    if (*gc_rd == '/') {
+    if (_lex_char(lx) == '/') {
         *block_delete_flag = true;
-        gc_rd++;
+        _lex_skip(lx);
     } else {
         *block_delete_flag = false;
     }
 
-    while (*gc_rd != 0) {
+    while ((c = _lex_char(lx)) != NUL) {
         // check for ';' or '%' comments that end the line.
-        if ((*gc_rd == ';') || (*gc_rd == '%')) {
-            // go ahead and snap the string off cleanly here
-            *gc_rd = 0;
+        if ((c == ';') || (c == '%')) {
             break;
         }
 
         // check for comment '('
-        else if (*gc_rd == '(') {
-            // We only care if it's a "({" in order to handle string-skipping properly
-            gc_rd++;
-            if ((*gc_rd == '{') || (((* gc_rd    == 'm') || (* gc_rd    == 'M')) &&
-                                    ((*(gc_rd+1) == 's') || (*(gc_rd+1) == 'S')) &&
-                                    ((*(gc_rd+2) == 'g') || (*(gc_rd+2) == 'G'))
-                )) {
-                if (ac_rd == nullptr) {
-                    ac_rd = gc_rd; // note the start of the first AC
+        else if (c == '(') {
+            _lex_skip(lx);
+            bool in_msg = (((_lex_char(lx) == 'm') || (_lex_char(lx) == 'M')) &&
+                           ((_lex_peek(lx, 1) == 's') || (_lex_peek(lx, 1) == 'S')) &&
+                           ((_lex_peek(lx, 2) == 'g') || (_lex_peek(lx, 2) == 'G')));
+
+            if (!in_msg && (_lex_char(lx) != '{')) {
+                // plain comment - skip ahead until we find a ')' (or the end)
+                while (((c = _lex_char(lx)) != NUL) && (c != ')')) {
+                    _lex_skip(lx);
+                }
+                if (c == NUL) {         // We don't want the skip later to pass the end
+                    break;
+                }
+                _lex_skip(lx);
+                continue;
+            }
+
+            if (in_msg) {
+                _lex_skip(lx);
+                _lex_skip(lx);
+                _lex_skip(lx);
+                if (_lex_char(lx) == ' ') {
+                    _lex_skip(lx);        // skip the first space.
                 }
 
-                // skip the comment, handling strings carefully
-                bool in_string = false;
-                while (*(++gc_rd) != 0) {
-                    if (*gc_rd=='"') {
-                        in_string = true;
-                    } else if (in_string) {
-                        if ((*gc_rd == '\\') && (*(gc_rd+1) != 0)) {
-                            gc_rd++; // Skip it, it's escaped.
-                        }
-
-                    } else if ((*gc_rd == ')')) {
-                        break;
-                    }
+                if ((ac_wr > _normalize_scratch) && (*(ac_wr-1) == '}')) {
+                    *(ac_wr-1) = ',';
+                } else {
+                    _put_comment_char(ac_wr, '{');
                 }
-                if (*gc_rd == 0) {      // We don't want the rd++ later to skip the NULL if we're at one
+                for (const char *m = "msg:\""; *m != 0; m++) {
+                    _put_comment_char(ac_wr, *m);
+                }
+            } else if ((ac_wr > _normalize_scratch) && (*(ac_wr-1) == '}')) {
+                // merge json comments
+                *(ac_wr-1) = ',';
+
+                // don't copy the '{'
+                _lex_skip(lx);
+            }
+
+            // copy the comment, handling strings carefully
+            bool in_string = false;
+            bool escaped = false;
+            while ((c = _lex_char(lx)) != NUL) {
+                if (in_string && (c == '\\')) {
+                    escaped = true;
+                } else if (!escaped && (c == '"')) {
+                    // In msg comments, we have to escape "
+                    if (in_msg) {
+                        _put_comment_char(ac_wr, '\\');
+                    } else {
+                        in_string = !in_string;
+                    }
+                } else if (!in_string && (c == ')')) {
+                    _lex_skip(lx);
+                    if (in_msg) {
+                        _put_comment_char(ac_wr, '"');
+                        _put_comment_char(ac_wr, '}');
+                    }
                     break;
+                } else {
+                    escaped = false;
                 }
-            } else {
-                *(gc_rd-1) = ' ';       // Change the '(' to a space to simplify the comment copy later
 
-                // skip ahead until we find a ')' (or NULL)
-                while ((*gc_rd != 0) && (*gc_rd != ')')) {
-                    gc_rd++;
+                // Skip spaces if we're not in a string or msg (implicit string)
+                if (in_string || in_msg || (c != ' ')) {
+                    _put_comment_char(ac_wr, c);
                 }
+                _lex_skip(lx);
             }
-        } else if (!isspace(*gc_rd)) {
+            continue;                   // already past the comment (or at the end)
+        }
+
+        else if (!isspace(c)) {
             bool do_copy = false;
 
             // Perform Octal stripping - remove invalid leading zeros in number strings
             // Change 0123.004 to 123.004, or -0234.003 to -234.003
-            if (isdigit(*gc_rd) || (*gc_rd == '.')) { // treat '.' as a digit so we don't strip after one
-                if (last_char_was_digit || (*gc_rd != '0') || !isdigit(*(gc_rd+1))) {
+            if (isdigit(c) || (c == '.')) { // treat '.' as a digit so we don't strip after one
+                if (last_char_was_digit || (c != '0') || !isdigit(lx.rd[1])) { // '*' is no digit
                     do_copy = true;
                 }
                 last_char_was_digit = true;
             }
-            else if ((isalnum((char)*gc_rd)) || (strchr("-.", *gc_rd))) { // all valid characters
+            else if ((isalnum(c)) || (strchr("-.", c))) { // all valid characters
+                last_char_was_digit = false;
+                do_copy = true;
+            }
+            else if ((c == '#') || (c == '[') || (c == ']') ||   // expression characters
+                     ((lx.depth > 0) && strchr("+*/", c)) ||
+                     ((c == '/') && (lx.wr > block) && (*(lx.wr-1) == ']')) || // ATAN[y]/[x]
+                     ((c == '=') && has_parameter)) {
+                if (c == '#') {
+                    has_parameter = true;
+                } else if (c == '[') {
+                    lx.depth++;
+                } else if ((c == ']') && (lx.depth > 0)) {
+                    lx.depth--;
+                }
                 last_char_was_digit = false;
                 do_copy = true;
             }
 
+            _lex_skip(lx);                // before the write, which may land on this character
             if (do_copy) {
-                *(gc_wr++) = toupper(*gc_rd);
-                ac_wr++; // move the ac start position
+                *(lx.wr++) = toupper(c);
             }
+            continue;
         }
 
-        gc_rd++;
+        _lex_skip(lx);
     }
-
-    // Enforce null termination
-    *gc_wr = 0;
-
-    // note the beginning of the comments
-    char *comment_start = ac_wr;
-
-    if (ac_rd != nullptr) {
-
-        // Now we'll copy the comments to the scratch
-        while (*ac_rd != 0) {
-            // check for comment '('
-            // Remember: we're only "counting characters" at this point, no more.
-            if (*ac_rd == '(') {
-                // We only care if it's a "({" in order to handle string-skipping properly
-                ac_rd++;
-
-                bool do_copy = false;
-                bool in_msg = false;
-                if (((* ac_rd    == 'm') || (* ac_rd    == 'M')) &&
-                    ((*(ac_rd+1) == 's') || (*(ac_rd+1) == 'S')) &&
-                    ((*(ac_rd+2) == 'g') || (*(ac_rd+2) == 'G'))
-                    ) {
-
-                    ac_rd += 3;
-                    if (*ac_rd == ' ') {
-                        ac_rd++; // skip the first space.
-                    }
-
-                    if (*(ac_wr-1) == '}') {
-                        *(ac_wr-1) = ',';
-                    } else {
-                        *(ac_wr++) = '{';
-                    }
-                    *(ac_wr++) = 'm';
-                    *(ac_wr++) = 's';
-                    *(ac_wr++) = 'g';
-                    *(ac_wr++) = ':';
-                    *(ac_wr++) = '"';
-
-                    // TODO - FIX BUFFER OVERFLOW POTENTIAL
-                    // "(msg)" is four characters. "{msg:" is five. If the write buffer is full, we'll overflow.
-                    // Also " is MSG will be quoted, making one character into two.
-
-                    in_msg = true;
-                    do_copy = true;
-                }
-
-                else if (*ac_rd == '{') {
-                    // merge json comments
-                    if (*(ac_wr-1) == '}') {
-                        *(ac_wr-1) = ',';
-
-                        // don't copy the '{'
-                        ac_rd++;
-                    }
-
-                    do_copy = true;
-                }
-
-                if (do_copy) {
-                    // skip the comment, handling strings carefully
-                    bool in_string = false;
-                    bool escaped = false;
-                    while (*ac_rd != 0) {
-                        if (in_string && (*ac_rd == '\\')) {
-                            escaped = true;
-                        } else if (!escaped && (*ac_rd == '"')) {
-                            // In msg comments, we have to escape "
-                            if (in_msg) {
-                                *(ac_wr++) = '\\';
-                            } else {
-                                in_string = !in_string;
-                            }
-                        } else if (!in_string && (*ac_rd == ')')) {
-                            ac_rd++;
-                            if (in_msg) {
-                                *(ac_wr++) = '"';
-                                *(ac_wr++) = '}';
-                            }
-                            break;
-                        } else {
-                            escaped = false;
-                        }
-
-                        // Skip spaces if we're not in a string or msg (implicit string)
-                        if (in_string || in_msg || (*ac_rd != ' ')) {
-                            *ac_wr = *ac_rd;
-                            ac_wr++;
-                        }
-
-                        ac_rd++;
-                    }
-                }
-
-                // We don't want the rd++ later to skip the NULL if we're at one
-                if (*ac_rd == 0) {
-                    break;
-                }
-            }
-
-            ac_rd++;
-        }
+    while (_lex_char(lx) != NUL) {       // the rest of a ';' comment still counts in the checksum
+        _lex_skip(lx);
     }
 
+    bool has_checksum = ((*lx.rd == '*') && lx.star_ends);
+
     // Enforce null termination
+    *lx.wr = 0;                         // may land on the '*' - the checksum after it is intact
     *ac_wr = 0;
 
-    // Now copy it all back
-    memcpy(str, _normalize_scratch, (ac_wr-_normalize_scratch)+1);
-
-    *active_comment = str + (comment_start - _normalize_scratch);
-}
-
-
-/*
- * _get_next_gcode_word() - get gcode word consisting of a letter and a value
- *
- *  This function requires the Gcode string to be normalized.
- *  Normalization must remove any leading zeros or they will be converted to Octal
- *  G0X... is not interpreted as hexadecimal. This is trapped.
- */
-
-stat_t _get_next_gcode_word(char **pstr, char *letter, float *value)
-{
-    if (**pstr == NUL) { return (STAT_COMPLETE); }    // no more words
-
-    // get letter part
-    if(isupper(**pstr) == false) {
-        return (STAT_INVALID_OR_MALFORMED_COMMAND);
-    }
-    *letter = **pstr;
-    (*pstr)++;
-
-//    // X-axis-becomes-a-hexadecimal-number get-value case, e.g. G0X100 --> G255
-//    if ((**pstr == '0') && (*(*pstr+1) == 'X')) {
-//        *value = 0;
-//        (*pstr)++;
-//        return (STAT_OK);        // pointer points to X
-//    }
-//
-//    // get-value general case
-//    char *end = *pstr;
-//    *value = strtof(*pstr, &end);
-
-    // get-value general case
-    char *end = *pstr;
-    *value = c_atof(end);
-
-    if(end == *pstr) {
-#if MARLIN_COMPAT_ENABLED == true
-        if (mst.marlin_flavor) {
-            *value = 0;
-        } else {
-            return(STAT_BAD_NUMBER_FORMAT);
+    if (has_checksum) {
+        gf.checksum = true;
+        if (strtol(lx.rd+1, NULL, 10) != lx.checksum) {
+            _debug_trap("checksum failure");
+            return STAT_CHECKSUM_MATCH_FAILED;
         }
-#else
-        return(STAT_BAD_NUMBER_FORMAT);
-#endif
-    }    // more robust test then checking for value=0;
-    *pstr = end;
-    return (STAT_OK);            // pointer points to next character after the word
+        if (!has_line_number) {
+            _debug_trap("line number missing with checksum");
+            return STAT_MISSING_LINE_NUMBER_WITH_CHECKSUM;
+        }
+    }
+    _lex_words(block);
+
+    *active_comment = _normalize_scratch;
+    return (STAT_OK);
 }
 
 /*
@@ -651,36 +750,360 @@ stat_t _validate_gcode_block(char *active_comment)
     return (STAT_OK);
 }
 
+/*
+ * _is_straight_block() - true if the block can take the straight move fast path
+ * _execute_straight_block() - run a block that _is_straight_block() accepted
+ *
+ *  Most streamed blocks are just coordinates in the current motion mode, like
+ *  "X12.345Y6.789Z-0.5F1200". A block of only axis, F and N words in G0 or G1 can't
+ *  change any modal state, so it skips the gv/gf clear, the word by word parse and
+ *  the flag by flag execution, and goes straight to cm_straight_traverse() or
+ *  cm_straight_feed(). The canonical machine is called in the same order and with the
+ *  same values as _execute_gcode_block() would use.
+ *
+ *  Anything else takes the general path: any other word, a word error, inverse time
+ *  mode (which needs an F on every block), and an absolute override still in effect.
+ *  Set GCODE_FAST_STRAIGHT_BLOCKS to false to send every block through the general path.
+ */
+
+#ifndef GCODE_FAST_STRAIGHT_BLOCKS
+#define GCODE_FAST_STRAIGHT_BLOCKS true
+#endif
+
+static int8_t _straight_block_axis(const char letter)
+{
+    switch (letter) {
+        case 'X': return (AXIS_X);
+        case 'Y': return (AXIS_Y);
+        case 'Z': return (AXIS_Z);
+        case 'A': return (AXIS_A);
+        case 'B': return (AXIS_B);
+        case 'C': return (AXIS_C);
+    }
+    return (-1);
+}
+
+static bool _is_straight_block()
+{
+    cmMotionMode motion_mode = cm_get_motion_mode(MODEL);
+    if (((motion_mode != MOTION_MODE_STRAIGHT_TRAVERSE) && (motion_mode != MOTION_MODE_STRAIGHT_FEED)) ||
+        (cm.gm.feed_rate_mode == INVERSE_TIME_MODE) ||
+        (cm.gm.absolute_override != ABSOLUTE_OVERRIDE_OFF) ||
+        (gw.status != STAT_COMPLETE)) {
+        return (false);
+    }
+#if MARLIN_COMPAT_ENABLED == true
+    if (cm.gm.tool_select == 0) {       // leave the Marlin tool fixup to _execute_gcode_block_marlin()
+        return (false);
+    }
+#endif
+    for (uint8_t i=0; i < gw.count; i++) {
+        char letter = gw.word[i].letter;
+        if ((letter != 'F') && (letter != 'N') && (_straight_block_axis(letter) < 0)) {
+            return (false);
+        }
+    }
+    return (true);
+}
+
+static stat_t _execute_straight_block()
+{
+    float target[AXES] = {0};
+    bool flags[AXES] = {0};
+    bool has_linenum = false;
+    uint32_t linenum = 0;
+    bool has_feed = false;
+    float feed_rate = 0;
+
+    for (uint8_t i=0; i < gw.count; i++) {     // the last of repeated words wins, as in the parse
+        GCodeWord_t *w = &gw.word[i];
+        if (w->letter == 'N') {
+            has_linenum = true;
+            linenum = (uint32_t)w->value;
+        } else if (w->letter == 'F') {
+            has_feed = true;
+            feed_rate = w->value;
+        } else {
+            int8_t axis = _straight_block_axis(w->letter);
+            target[axis] = w->value;
+            flags[axis] = true;
+        }
+    }
+    if (has_linenum) {
+        cm_set_model_linenum(linenum);
+    }
+    if (has_feed) {
+        cm_set_feed_rate(feed_rate);    // as EXEC_FUNC - the move's status is the block's status
+    }
+    if (cm_get_motion_mode(MODEL) == MOTION_MODE_STRAIGHT_TRAVERSE) {
+        return (cm_straight_traverse(target, flags));
+    }
+    return (cm_straight_feed(target, flags));
+}
+
+/*
+ * _set_block_defaults() - fill in what a block gets from the model state, not its words
+ *
+ *  Done after the words so gv and gf can be cached as the words left them.
+ */
+
+static void _set_block_defaults()
+{
+    if (!gf.motion_mode) {
+        gv.motion_mode = cm_get_motion_mode(MODEL); // get motion mode from previous block
+    }
+
+    // Causes a later exception if
+    //  (1) INVERSE_TIME_MODE is active and a feed rate is not provided or
+    //  (2) INVERSE_TIME_MODE is changed to UNITS_PER_MINUTE and a new feed rate is missing
+    if ((cm.gm.feed_rate_mode == INVERSE_TIME_MODE) && !gf.F_word) { // new feed rate req'd when in INV_TIME_MODE
+        gv.F_word = 0;
+        gf.F_word = true;
+    }
+}
+
+/*
+ * _assign_parameters() - make the block's #n= assignments
+ *
+ *  They are made after every word is read, so "#1=2 X#1" moves to the old #1.
+ */
+
+static stat_t _assign_parameters()
+{
+    for (uint8_t i=0; i < gw.assign_count; i++) {
+        ritorno(gx_set_parameter(gw.assign[i].number, gw.assign[i].value));
+    }
+    return (STAT_OK);
+}
+
+/*
+ * Parsed block cache
+ *
+ * _block_cache_run()   - run the block from the cache if it was parsed before. Returns true if it did
+ * _block_cache_store() - cache the block _parse_gcode_block() just read
+ *
+ *  Drilling, engraving and other repetitive jobs send the same short blocks over and
+ *  over (often in G91), so the parse results of the last few are kept. They're keyed
+ *  on the block as received - before the lexer compacts it in place - by an FNV-1a
+ *  hash, and checked against a copy of the text. A hit copies gv and gf back and goes
+ *  straight to _execute_gcode_block(), skipping the lexer, the word switch and the
+ *  validation. Execution, and everything that depends on the model state, runs as usual.
+ *
+ *  Only blocks whose gv and gf come from the words alone are stored: every word read,
+ *  no active comment, not a Marlin flavored block. Comment lines, block deletes and
+ *  errors never get that far. A hit in alarm takes the full path, for cm_parse_clear().
+ *  gp.modals is never cleared between blocks, so a hit doesn't need to set it again.
+ *
+ *  Parameters change from one block to the next, so a block with expressions keeps its
+ *  compiled program as well. A hit evaluates it again, puts the values in gv and gf over
+ *  the cached ones, and makes the assignments. Expressions on G and M words, and words
+ *  repeated with an expression on one of them, are not cached.
+ *
+ *  GCODE_BLOCK_CACHE_SIZE blocks of up to GCODE_BLOCK_CACHE_LINE_LEN-1 characters are
+ *  kept, replaced round robin. Set GCODE_BLOCK_CACHE_SIZE to 0 to remove the cache.
+ */
+
+#ifndef GCODE_BLOCK_CACHE_SIZE
+#define GCODE_BLOCK_CACHE_SIZE 8            // blocks kept
+#endif
+#ifndef GCODE_BLOCK_CACHE_LINE_LEN
+#define GCODE_BLOCK_CACHE_LINE_LEN 40       // longer blocks are not cached
+#endif
+#ifndef GCODE_BLOCK_CACHE_PROGRAM_LEN
+#define GCODE_BLOCK_CACHE_PROGRAM_LEN 32    // blocks with more expression code are not cached
+#endif
+
+#if GCODE_BLOCK_CACHE_SIZE > 0
+
+typedef struct GCodeCacheEntry {
+    uint32_t hash;                          // FNV-1a of the block as received
+    uint8_t length;                         // 0 if the entry is empty
+    char block[GCODE_BLOCK_CACHE_LINE_LEN];
+    GCodeValue_t gv;                        // parse results before _set_block_defaults()
+    GCodeFlag_t gf;
+    uint8_t program_len;                    // expressions, as in gw.program[]
+    uint8_t program[GCODE_BLOCK_CACHE_PROGRAM_LEN];
+} GCodeCacheEntry_t;
+
+typedef struct GCodeCache {
+    uint8_t next;                           // entry replaced next
+    bool pending;                           // the block being parsed can be stored
+    uint32_t hash;                          // ...and its hash, length and text
+    uint8_t length;
+    char block[GCODE_BLOCK_CACHE_LINE_LEN];
+    GCodeCacheEntry_t entry[GCODE_BLOCK_CACHE_SIZE];
+} GCodeCache_t;
+
+static GCodeCache_t gbc;
+
+// evaluate a cached block's expressions again, into gv, gf and gw.assign[]
+static stat_t _block_cache_evaluate(const GCodeCacheEntry_t *e)
+{
+    const uint8_t *code = e->program;
+    const uint8_t *code_end = e->program + e->program_len;
+
+    gw.assign_count = 0;
+    while (code < code_end) {
+        char letter = *(code++);
+        float value;
+        ritorno(gx_evaluate(&code, &value));
+        if (letter == '#') {
+            GCodeAssignment_t *a = &gw.assign[gw.assign_count++];
+            a->number = value;
+            ritorno(gx_evaluate(&code, &a->value));
+        } else {
+            ritorno(_parse_value_word(letter, value));
+        }
+    }
+    return (_assign_parameters());
+}
+
+static bool _block_cache_run(char *block, stat_t *status)
+{
+    uint32_t hash = 2166136261;
+    uint8_t length = 0;
+
+    gbc.pending = false;
+#if MARLIN_COMPAT_ENABLED == true
+    if (mst.marlin_flavor) {
+        return (false);
+    }
+#endif
+    for (char *p = block; *p != NUL; p++) {
+        if (++length == GCODE_BLOCK_CACHE_LINE_LEN) {
+            return (false);                 // too long to cache
+        }
+        hash = (hash ^ (uint8_t)*p) * 16777619;
+    }
+    for (uint8_t i=0; i < GCODE_BLOCK_CACHE_SIZE; i++) {
+        GCodeCacheEntry_t *e = &gbc.entry[i];
+        if ((e->hash == hash) && (e->length == length) && (memcmp(e->block, block, length) == 0)) {
+            if (cm_is_alarmed() != STAT_OK) {
+                return (false);
+            }
+            memcpy(&gv, &e->gv, sizeof(GCodeValue_t));
+            memcpy(&gf, &e->gf, sizeof(GCodeFlag_t));
+            if ((*status = _block_cache_evaluate(e)) != STAT_OK) {
+                return (true);
+            }
+            _set_block_defaults();
+            char none = NUL;
+            *status = _execute_gcode_block(&none);
+            return (true);
+        }
+    }
+    if (length != 0) {
+        gbc.pending = true;
+        gbc.hash = hash;
+        gbc.length = length;
+        memcpy(gbc.block, block, length);
+    }
+    return (false);
+}
+
+static void _block_cache_store()
+{
+    if (!gbc.pending || !gw.cacheable || (gw.program_len > GCODE_BLOCK_CACHE_PROGRAM_LEN)) {
+        return;
+    }
+    gbc.pending = false;
+    GCodeCacheEntry_t *e = &gbc.entry[gbc.next];
+    if (++gbc.next == GCODE_BLOCK_CACHE_SIZE) {
+        gbc.next = 0;
+    }
+    e->hash = gbc.hash;
+    e->length = gbc.length;
+    memcpy(e->block, gbc.block, gbc.length);
+    memcpy(&e->gv, &gv, sizeof(GCodeValue_t));
+    memcpy(&e->gf, &gf, sizeof(GCodeFlag_t));
+    e->program_len = gw.program_len;
+    memcpy(e->program, gw.program, gw.program_len);
+}
+
+#else
+
+static bool _block_cache_run(char *block, stat_t *status) { return (false); }
+static void _block_cache_store() {}
+
+#endif // GCODE_BLOCK_CACHE_SIZE > 0
+
+/*
+ * _parse_value_word() - parse a word that only carries a value - anything but G and M
+ *
+ *  Also called by the block cache, to put re-evaluated expression values over cached ones.
+ */
+
+static stat_t _parse_value_word(const char letter, const float value)
+{
+    switch (letter) {
+        case 'T': SET_NON_MODAL (tool_select, (uint8_t)trunc(value));
+        case 'F': SET_NON_MODAL (F_word, value);
+        case 'P': SET_NON_MODAL (P_word, value);                // used for dwell time, G10 coord select
+        case 'Q': SET_NON_MODAL (Q_word, value);                // peck depth in canned cycles
+        case 'S': SET_NON_MODAL (S_word, value);
+        case 'X': SET_NON_MODAL (target[AXIS_X], value);
+        case 'Y': SET_NON_MODAL (target[AXIS_Y], value);
+        case 'Z': SET_NON_MODAL (target[AXIS_Z], value);
+        case 'A': SET_NON_MODAL (target[AXIS_A], value);
+        case 'B': SET_NON_MODAL (target[AXIS_B], value);
+        case 'C': SET_NON_MODAL (target[AXIS_C], value);
+    //  case 'U': SET_NON_MODAL (target[AXIS_U], value);        // reserved
+    //  case 'V': SET_NON_MODAL (target[AXIS_V], value);        // reserved
+    //  case 'W': SET_NON_MODAL (target[AXIS_W], value);        // reserved
+        case 'H': SET_NON_MODAL (H_word, value);
+        case 'I': SET_NON_MODAL (arc_offset[0], value);
+        case 'J': SET_NON_MODAL (arc_offset[1], value);
+        case 'K': SET_NON_MODAL (arc_offset[2], value);
+        case 'L': SET_NON_MODAL (L_word, value);
+        case 'R': SET_NON_MODAL (arc_radius, value);            // arc radius, or retract plane in canned cycles
+        case 'N': SET_NON_MODAL (linenum,(uint32_t)value);      // line number
+
+#if MARLIN_COMPAT_ENABLED == true
+        case 'E': SET_NON_MODAL (E_word, value);                // extruder value
+#endif
+
+        default: return (STAT_GCODE_COMMAND_UNSUPPORTED);
+    }
+    return (STAT_OK);
+}
+
 /*
  * _parse_gcode_block() - parses one line of NULL terminated G-Code.
  *
  *  All the parser does is load the state values in gn (next model state) and set flags
- *  in gf (model state flags). The execute routine applies them. The buffer is assumed to
- *  contain only uppercase characters and signed floats (no whitespace).
+ *  in gf (model state flags). The execute routine applies them. The words come from
+ *  _lex_gcode_block(), which must have run on the block first.
  */
 
-stat_t _parse_gcode_block(char *buf, char *active_comment)
+stat_t _parse_gcode_block(char *active_comment)
 {
-    char *pstr = (char *)buf;                   // persistent pointer into gcode block for parsing words
     char letter;                                // parsed letter, eg.g. G or X or Y
     float value = 0;                            // value parsed from letter (e.g. 2 for G2)
     stat_t status = STAT_OK;
 
+    if (gw.status == STAT_COMPLETE) {
+        ritorno(_assign_parameters());
+    }
+
+#if GCODE_FAST_STRAIGHT_BLOCKS == true
+    if (_is_straight_block()) {
+        return (_execute_straight_block());
+    }
+#endif
+
     // set initial state for new move
     memset(&gv, 0, sizeof(GCodeValue_t));       // clear all next-state values
     memset(&gf, 0, sizeof(GCodeFlag_t));        // clear all next-state flags
-    gv.motion_mode = cm_get_motion_mode(MODEL); // get motion mode from previous block
-
-    // Causes a later exception if
-    //  (1) INVERSE_TIME_MODE is active and a feed rate is not provided or
-    //  (2) INVERSE_TIME_MODE is changed to UNITS_PER_MINUTE and a new feed rate is missing
-    if (cm.gm.feed_rate_mode == INVERSE_TIME_MODE) {// new feed rate req'd when in INV_TIME_MODE
-        gv.F_word = 0;
-        gf.F_word = true;
-    }
 
-    // extract commands and parameters
-    while((status = _get_next_gcode_word(&pstr, &letter, &value)) == STAT_OK) {
+    // extract commands and parameters from the words _lex_gcode_block() found
+    uint8_t i;
+    for (i=0; ; i++) {
+        if (i == gw.count) {
+            status = gw.status;                 // STAT_COMPLETE unless a bad word stopped them
+            break;
+        }
+        letter = gw.word[i].letter;
+        value = gw.word[i].value;
         switch(letter) {
             case 'G':
             switch((uint8_t)value) {
@@ -689,6 +1112,7 @@ stat_t _parse_gcode_block(char *buf, char *active_comment)
                 case 2:  SET_MODAL (MODAL_GROUP_G1, motion_mode, MOTION_MODE_CW_ARC);
                 case 3:  SET_MODAL (MODAL_GROUP_G1, motion_mode, MOTION_MODE_CCW_ARC);
                 case 4:  SET_NON_MODAL (next_action, NEXT_ACTION_DWELL);
+                case 5:  SET_MODAL (MODAL_GROUP_G1, motion_mode, MOTION_MODE_CUBIC_SPLINE);
                 case 10: SET_MODAL (MODAL_GROUP_G0, next_action, NEXT_ACTION_SET_G10_DATA);
                 case 17: SET_MODAL (MODAL_GROUP_G2, select_plane, CANON_PLANE_XY);
                 case 18: SET_MODAL (MODAL_GROUP_G2, select_plane, CANON_PLANE_XZ);
@@ -718,12 +1142,21 @@ stat_t _parse_gcode_block(char *buf, char *active_comment)
                     }
                     break;
                 }
+                case 33: {
+                    switch (_point(value)) {
+                        case 0: SET_MODAL (MODAL_GROUP_G1, motion_mode, MOTION_MODE_SPINDLE_SYNC);
+                        case 1: SET_MODAL (MODAL_GROUP_G1, motion_mode, MOTION_MODE_RIGID_TAP);
+                        default: status = STAT_GCODE_COMMAND_UNSUPPORTED;
+                    }
+                    break;
+                }
                 case 38: {
                     switch (_point(value)) {
                         case 2: SET_NON_MODAL (next_action, NEXT_ACTION_STRAIGHT_PROBE_ERR);
                         case 3: SET_NON_MODAL (next_action, NEXT_ACTION_STRAIGHT_PROBE);
                         case 4: SET_NON_MODAL (next_action, NEXT_ACTION_STRAIGHT_PROBE_AWAY_ERR);
                         case 5: SET_NON_MODAL (next_action, NEXT_ACTION_STRAIGHT_PROBE_AWAY);
+                        case 6: SET_NON_MODAL (next_action, NEXT_ACTION_SCAN_PROBE);
                         default: status = STAT_GCODE_COMMAND_UNSUPPORTED;
                     }
                     break;
@@ -754,7 +1187,11 @@ stat_t _parse_gcode_block(char *buf, char *active_comment)
                     break;
                 }
                 case 64: SET_MODAL (MODAL_GROUP_G13,path_control, PATH_CONTINUOUS);
+                case 73: SET_MODAL (MODAL_GROUP_G1, motion_mode,  MOTION_MODE_CANNED_CYCLE_73);
                 case 80: SET_MODAL (MODAL_GROUP_G1, motion_mode,  MOTION_MODE_CANCEL_MOTION_MODE);
+                case 81: SET_MODAL (MODAL_GROUP_G1, motion_mode,  MOTION_MODE_CANNED_CYCLE_81);
+                case 82: SET_MODAL (MODAL_GROUP_G1, motion_mode,  MOTION_MODE_CANNED_CYCLE_82);
+                case 83: SET_MODAL (MODAL_GROUP_G1, motion_mode,  MOTION_MODE_CANNED_CYCLE_83);
                 case 90: {
                     switch (_point(value)) {
                         case 0: SET_MODAL (MODAL_GROUP_G3, distance_mode, ABSOLUTE_DISTANCE_MODE);
@@ -784,13 +1221,15 @@ stat_t _parse_gcode_block(char *buf, char *active_comment)
                 case 93: SET_MODAL (MODAL_GROUP_G5, feed_rate_mode, INVERSE_TIME_MODE);
                 case 94: SET_MODAL (MODAL_GROUP_G5, feed_rate_mode, UNITS_PER_MINUTE_MODE);
 //              case 95: SET_MODAL (MODAL_GROUP_G5, feed_rate_mode, UNITS_PER_REVOLUTION_MODE);
+                case 98: SET_MODAL (MODAL_GROUP_G9, retract_mode, RETRACT_TO_INITIAL_LEVEL);
+                case 99: SET_MODAL (MODAL_GROUP_G9, retract_mode, RETRACT_TO_R_LEVEL);
 
                 default: status = STAT_GCODE_COMMAND_UNSUPPORTED;
             }
             break;
 
             case 'M':
-            switch((uint8_t)value) {
+            switch((uint16_t)value) {                   // M900 is past uint8_t
                 case 0: case 1: case 60:
                         SET_MODAL (MODAL_GROUP_M4, program_flow, PROGRAM_STOP);
                 case 2: case 30:
@@ -820,12 +1259,15 @@ stat_t _parse_gcode_block(char *buf, char *active_comment)
                     }
                     break;
                 case 101: SET_NON_MODAL (next_action, NEXT_ACTION_JSON_WAIT);
+                case 98: SET_NON_MODAL (next_action, NEXT_ACTION_MACRO_CALL);
+                case 62: case 63: case 64: case 65:
+                        SET_NON_MODAL (output_control, (uint8_t)value);
 
 #if MARLIN_COMPAT_ENABLED == true
                 case 20:marlin_list_sd_response();        status = STAT_COMPLETE; break;    // List SD card
                 case 21:                                                                    // Initialize SD card
                 case 22:                                  status = STAT_COMPLETE; break;    // Release SD card
-                case 23: marlin_select_sd_response(pstr); status = STAT_COMPLETE; break;    // Select SD file
+                case 23: marlin_select_sd_response(gw.word[i].rest); status = STAT_COMPLETE; break; // Select SD file
 
                 case 82: SET_NON_MODAL (marlin_relative_extruder_mode, false);              // set relative extruder mode off
                 case 83: SET_NON_MODAL (marlin_relative_extruder_mode, true);               // set relative extruder mode on
@@ -851,42 +1293,22 @@ stat_t _parse_gcode_block(char *buf, char *active_comment)
 
                 case 115: SET_NON_MODAL (next_action, NEXT_ACTION_MARLIN_REPORT_VERSION);   // report version information
                 case 117: status = STAT_COMPLETE; break;  //SET_NON_MODAL (next_action, NEXT_ACTION_MARLIN_DISPLAY_ON_SCREEN);
+                case 900: SET_NON_MODAL (next_action, NEXT_ACTION_MARLIN_SET_PRESSURE_ADVANCE);// set pressure (linear) advance K
 #endif // MARLIN_COMPAT_ENABLED
 
                 default: status = STAT_MCODE_COMMAND_UNSUPPORTED;
             }
             break;
 
-            case 'T': SET_NON_MODAL (tool_select, (uint8_t)trunc(value));
-            case 'F': SET_NON_MODAL (F_word, value);
-            case 'P': SET_NON_MODAL (P_word, value);                // used for dwell time, G10 coord select
-            case 'S': SET_NON_MODAL (S_word, value);
-            case 'X': SET_NON_MODAL (target[AXIS_X], value);
-            case 'Y': SET_NON_MODAL (target[AXIS_Y], value);
-            case 'Z': SET_NON_MODAL (target[AXIS_Z], value);
-            case 'A': SET_NON_MODAL (target[AXIS_A], value);
-            case 'B': SET_NON_MODAL (target[AXIS_B], value);
-            case 'C': SET_NON_MODAL (target[AXIS_C], value);
-        //  case 'U': SET_NON_MODAL (target[AXIS_U], value);        // reserved
-        //  case 'V': SET_NON_MODAL (target[AXIS_V], value);        // reserved
-        //  case 'W': SET_NON_MODAL (target[AXIS_W], value);        // reserved
-            case 'H': SET_NON_MODAL (H_word, value);
-            case 'I': SET_NON_MODAL (arc_offset[0], value);
-            case 'J': SET_NON_MODAL (arc_offset[1], value);
-            case 'K': SET_NON_MODAL (arc_offset[2], value);
-            case 'L': SET_NON_MODAL (L_word, value);
-            case 'R': SET_NON_MODAL (arc_radius, value);
-            case 'N': SET_NON_MODAL (linenum,(uint32_t)value);      // line number
-            
-#if MARLIN_COMPAT_ENABLED == true
-            case 'E': SET_NON_MODAL (E_word, value);                // extruder value
-#endif
-
-            default: status = STAT_GCODE_COMMAND_UNSUPPORTED;
+            default: status = _parse_value_word(letter, value);
         }
         if(status != STAT_OK) break;
     }
     if ((status != STAT_OK) && (status != STAT_COMPLETE)) return (status);
+    if ((i == gw.count) && (*active_comment == NUL)) {
+        _block_cache_store();                   // gv and gf come from the words alone at this point
+    }
+    _set_block_defaults();
     ritorno(_validate_gcode_block(active_comment));
     return (_execute_gcode_block(active_comment));        // if successful execute the block
 }
@@ -908,9 +1330,10 @@ stat_t _parse_gcode_block(char *buf, char *active_comment)
  *    4. set spindle speed (S)
  *    4a. set spindle override rate (M51.1)
  *    5. select tool (T)
- *    6. change tool (M6)
+ *    6. change tool (M6), and run the tool change macro
  *    7. spindle on or off (M3, M4, M5)
  *    8. coolant on or off (M7, M8, M9)
+ *    8a. digital outputs (M62, M63 with the next move, M64, M65 now)
  *    9. enable or disable overrides (M48, M49, M50, M51)
  *    10. dwell (G4)
  *    11. set active plane (G17, G18, G19)
@@ -925,6 +1348,7 @@ stat_t _parse_gcode_block(char *buf, char *active_comment)
  *    19a. homing functions (G28.2, G28.3, G28.1, G28, G30)
  *    19b. update system data (G10)
  *    19c. set axis offsets (G92, G92.1, G92.2, G92.3)
+ *    19d. call a macro (M98)
  *    20. perform motion (G0 to G3, G80-G89) as modified (possibly) by G53
  *    21. stop and end (M0, M1, M2, M30, M60)
  *
@@ -932,8 +1356,59 @@ stat_t _parse_gcode_block(char *buf, char *active_comment)
  *  to calling the canonical functions (which do the unit conversions)
  */
 
+/*
+ * _block_has_feed_move() - true if the block ends in a G1/G2/G3 move
+ *
+ *  An S in such a block (and M3/M4/M5 in laser mode) rides on the move instead of being
+ *  queued as a command, which would force the planner to stop before it.
+ */
+
+static bool _block_has_feed_move()
+{
+    if (gv.next_action != NEXT_ACTION_DEFAULT) {
+        return (false);
+    }
+    if ((gv.motion_mode == MOTION_MODE_CW_ARC) || (gv.motion_mode == MOTION_MODE_CCW_ARC) ||
+        (gv.motion_mode == MOTION_MODE_CUBIC_SPLINE)) {
+        return (true);
+    }
+    if (gv.motion_mode != MOTION_MODE_STRAIGHT_FEED) {
+        return (false);
+    }
+    for (uint8_t i=0; i<AXES; i++) {
+        if (gf.target[i]) {
+            return (true);
+        }
+    }
+    return (false);
+}
+
+/*
+ * _output_control() - M62/M63 change output P along the next move, M64/M65 change it now
+ *
+ *  Q is the distance along the next move to make an M62/M63 change at, default 0.
+ */
+
+static stat_t _output_control()
+{
+    if (!gf.P_word) {
+        return (STAT_P_WORD_IS_MISSING);
+    }
+    if ((gv.P_word < 1) || (floor(gv.P_word) != gv.P_word)) {
+        return (STAT_P_WORD_IS_NOT_AN_INTEGER);
+    }
+    uint8_t output = (uint8_t)gv.P_word;
+    bool value = ((gv.output_control == 62) || (gv.output_control == 64));
+    if (gv.output_control >= 64) {
+        return (cm_set_output(output, value));
+    }
+    float distance = (gf.Q_word) ? _to_millimeters(gv.Q_word) : 0;
+    return (cm_sync_output(output, value, distance));
+}
+
 stat_t _execute_gcode_block(char *active_comment)
 {
+    bool inline_spindle = _block_has_feed_move();
     stat_t status = STAT_OK;
 
     if (gf.linenum) {
@@ -947,17 +1422,31 @@ stat_t _execute_gcode_block(char *active_comment)
         ritorno(cm_check_linenum());
     }
 
-    EXEC_FUNC(cm_set_spindle_speed, S_word);                // S
+    if (inline_spindle) {
+        EXEC_FUNC(cm_set_spindle_speed_inline, S_word);     // S carried by the move
+    } else {
+        EXEC_FUNC(cm_set_spindle_speed, S_word);            // S
+    }
     if (gf.sso_control) {                                   // spindle speed override
         ritorno(cm_sso_control(gv.P_word, gf.P_word));
     }
 
     EXEC_FUNC(cm_select_tool, tool_select);                 // tool_select is where it's written
     EXEC_FUNC(cm_change_tool, tool_change);                 // M6
-    EXEC_FUNC(cm_spindle_control, spindle_control);         // spindle CW, CCW, OFF
+    if (gf.tool_change) {                                   // ...and its macro, after the change is queued
+        ritorno(gc_macro_tool_change(gf.tool_select ? gv.tool_select : cm.gm.tool_select));
+    }
+    if (inline_spindle) {
+        EXEC_FUNC(cm_spindle_control_inline, spindle_control);  // carried by the move in laser mode
+    } else {
+        EXEC_FUNC(cm_spindle_control, spindle_control);     // spindle CW, CCW, OFF
+    }
 
     EXEC_FUNC(cm_mist_coolant_control, mist_coolant);       // M7, M9
     EXEC_FUNC(cm_flood_coolant_control, flood_coolant);     // M8, M9 also disables mist coolant if OFF
+    if (gf.output_control) {                                // M62, M63, M64, M65
+        ritorno(_output_control());
+    }
     EXEC_FUNC(cm_m48_enable, m48_enable);
 
     if (gf.mfo_control) {                                   // manual feedrate override
@@ -1000,7 +1489,7 @@ stat_t _execute_gcode_block(char *active_comment)
 
     EXEC_FUNC(cm_set_distance_mode, distance_mode);         // G90, G91
     EXEC_FUNC(cm_set_arc_distance_mode, arc_distance_mode); // G90.1, G91.1
-    //--> set retract mode goes here
+    EXEC_FUNC(cm_set_retract_mode, retract_mode);           // G98, G99
 
     switch (gv.next_action) {
         case NEXT_ACTION_SET_G28_POSITION:  { status = cm_set_g28_position(); break;}                               // G28.1
@@ -1016,6 +1505,7 @@ stat_t _execute_gcode_block(char *active_comment)
         case NEXT_ACTION_STRAIGHT_PROBE:         { status = cm_straight_probe(gv.target, gf.target, true, false); break;} // G38.3
         case NEXT_ACTION_STRAIGHT_PROBE_AWAY_ERR:{ status = cm_straight_probe(gv.target, gf.target, false, true); break;} // G38.4
         case NEXT_ACTION_STRAIGHT_PROBE_AWAY:    { status = cm_straight_probe(gv.target, gf.target, false, false); break;}// G38.5
+        case NEXT_ACTION_SCAN_PROBE:             { status = cm_scan_probe(gv.target, gf.target); break;}                 // G38.6
 
         case NEXT_ACTION_SET_G10_DATA:           { status = cm_set_g10_data(gv.P_word, gf.P_word, gv.L_word, gf.L_word, gv.target, gf.target); break;} // G10
         case NEXT_ACTION_SET_ORIGIN_OFFSETS:     { status = cm_set_origin_offsets(gv.target, gf.target); break;}    // G92
@@ -1026,6 +1516,7 @@ stat_t _execute_gcode_block(char *active_comment)
         case NEXT_ACTION_JSON_COMMAND_SYNC:       { status = cm_json_command(active_comment); break;}               // M100.0
         case NEXT_ACTION_JSON_COMMAND_ASYNC:      { status = cm_json_command_immediate(active_comment); break;}     // M100.1
         case NEXT_ACTION_JSON_WAIT:               { status = cm_json_wait(active_comment); break;}                  // M101
+        case NEXT_ACTION_MACRO_CALL:              { status = gc_macro_call(gv.P_word, gf.P_word); break;}            // M98
 
         case NEXT_ACTION_DEFAULT: {
             cm_set_absolute_override(MODEL, gv.absolute_override);    // apply absolute override
@@ -1042,6 +1533,29 @@ stat_t _execute_gcode_block(char *active_comment)
                                                                  gv.motion_mode);
                                                                  break;
                                           }
+                case MOTION_MODE_CUBIC_SPLINE: { status = cm_spline_feed(gv.target, gf.target,                 // G5
+                                                                 gv.arc_offset, gf.arc_offset,
+                                                                 gv.P_word,     gf.P_word,
+                                                                 gv.Q_word,     gf.Q_word);
+                                                                 break;
+                                          }
+                case MOTION_MODE_SPINDLE_SYNC:                                                                      // G33
+                case MOTION_MODE_RIGID_TAP: { status = cm_spindle_sync_feed(gv.target, gf.target,                   // G33.1
+                                                                 gv.arc_offset[2], gf.arc_offset[2],
+                                                                 (gv.motion_mode == MOTION_MODE_RIGID_TAP));
+                                                                 break;
+                                          }
+                case MOTION_MODE_CANNED_CYCLE_73:                                                                   // G73
+                case MOTION_MODE_CANNED_CYCLE_81:                                                                   // G81
+                case MOTION_MODE_CANNED_CYCLE_82:                                                                   // G82
+                case MOTION_MODE_CANNED_CYCLE_83: { status = cm_drilling_cycle_start(gv.target, gf.target,          // G83
+                                                                 gv.arc_radius, gf.arc_radius,
+                                                                 gv.Q_word,     gf.Q_word,
+                                                                 gv.P_word,     gf.P_word,
+                                                                 gv.L_word,     gf.L_word,
+                                                                 gv.motion_mode);
+                                                                 break;
+                                          }
                 default: break;
             }
             cm_set_absolute_override(MODEL, ABSOLUTE_OVERRIDE_OFF);     // un-set absolute override once the move is planned
@@ -1154,6 +1668,14 @@ static stat_t _execute_gcode_block_marlin()
             cm_request_queue_flush();
             break;
         }
+        case NEXT_ACTION_MARLIN_SET_PRESSURE_ADVANCE: {     // M900
+            mst.marlin_flavor = true;                       // these gcodes are ONLY in marlin flavor
+            if (gf.arc_offset[2]) {                         // K
+                ritorno(marlin_set_pressure_advance(gv.arc_offset[2]));
+            }
+            gf.arc_offset[2] = false;
+            break;
+        }
         case NEXT_ACTION_MARLIN_TRAM_BED:       {           // G29
             mst.marlin_flavor = true;                       // these gcodes are ONLY in marlin flavor
             ritorno(marlin_start_tramming_bed());
@@ -46,6 +46,8 @@
 #include "stepper.h"
 #include "encoder.h"
 #include "hardware.h"
+#include "timebase.h"
+#include "step_capture.h"
 #include "canonical_machine.h"
 
 #include "text_parser.h"
@@ -55,15 +57,162 @@
 #include "xio.h"
 
 #include "MotateTimers.h"
+
+#include <atomic>           // atomic_signal_fence() orders the event ring between ISR and main loop
 using namespace Motate;
 
 /**** Allocate structures ****/
 
 d_in_t   d_in[D_IN_CHANNELS];
+ioEventQueue_t io_events;
+ioSyncOutputs_t io_sync;
 d_out_t  d_out[D_OUT_CHANNELS];
 a_in_t   a_in[A_IN_CHANNELS];
 a_out_t  a_out[A_OUT_CHANNELS];
 
+/*
+ * _push_event() - stamp an input edge and put it on the event ring - called from the input ISR
+ */
+static void _push_event(const uint8_t input, const inputEdgeFlag edge, const bool cycle)
+{
+    uint8_t head = io_events.head;
+    if ((uint8_t)(head - io_events.tail) >= GPIO_EVENTS) {
+        io_events.dropped++;                            // consumer has fallen behind
+        return;
+    }
+    ioEvent_t *e = &io_events.event[head & (GPIO_EVENTS-1)];
+    e->usec = tb_get_usec();                            // first, so it's closest to the edge
+    e->input = input;
+    e->edge = edge;
+    e->cycle = cycle;
+    en_get_encoder_steps(e->steps);
+    std::atomic_signal_fence(std::memory_order_release);   // slot contents before the index
+    io_events.head = head + 1;
+}
+
+/*
+ * _input_changed() - condition an input change and act on it - called from the input ISRs
+ *
+ *  pin_value_corrected is already corrected for NO/NC, so INPUT_ACTIVE means "switch hit".
+ *  Physical pins come through ioDigitalInputExt::pin_changed(), virtual inputs (such as
+ *  StallGuard from a motor driver) through gpio_set_virtual_input().
+ */
+static void _input_changed(const uint8_t ext_pin_number, const int8_t pin_value_corrected)
+{
+    d_in_t *in = &d_in[ext_pin_number-1];
+
+    // return if input is disabled (not supposed to happen)
+    if (in->mode == IO_MODE_DISABLED) {
+        in->state = INPUT_DISABLED;
+        return;
+    }
+
+    // latch the spindle encoder at the index. It fires every turn, faster than a lockout,
+    // so it takes no lockout and is kept off the event ring
+    if (in->function == INPUT_FUNCTION_SPINDLE_INDEX) {
+        in->state = (ioState)pin_value_corrected;
+        if (pin_value_corrected == INPUT_ACTIVE) {
+            en_latch_spindle_index();
+        }
+        return;
+    }
+
+    // stamp the edges of a looped back step pin. Same as the index - no lockout, no ring
+    if (in->function == INPUT_FUNCTION_STEP_CAPTURE) {
+        in->state = (ioState)pin_value_corrected;
+#if STEP_CAPTURE_ENABLED == true
+        if (pin_value_corrected == INPUT_ACTIVE) {
+            stc_edge();
+        }
+#endif
+        return;
+    }
+
+    // return if the input is in lockout period (take no action)
+    if (in->lockout_timer.isSet() && !in->lockout_timer.isPast()) {
+        return;
+    }
+
+    // return if no change in state
+    if (in->state == (ioState)pin_value_corrected) {
+        return;
+    }
+
+    // lockout the pin for lockout_ms
+    in->lockout_timer.set(in->lockout_ms);
+
+    // record the changed state
+    in->state = (ioState)pin_value_corrected;
+    if (pin_value_corrected == INPUT_ACTIVE) {
+        in->edge = INPUT_EDGE_LEADING;
+    } else {
+        in->edge = INPUT_EDGE_TRAILING;
+    }
+    _push_event(ext_pin_number, in->edge, (in->homing_mode || in->probing_mode));
+
+    // perform homing operations if in homing mode
+    if (in->homing_mode) {
+        if (in->edge == INPUT_EDGE_LEADING) {   // we only want the leading edge to fire
+            en_take_encoder_snapshot();
+            cm_homing_switch(ext_pin_number);   // stops this input's motors, or holds
+        }
+        return;
+    }
+
+    // perform probing operations if in probing mode
+    if (in->probing_mode) {
+        // We want to capture either way.
+        // Probing tests the start condition for the correct direction ahead of time.
+        // If we see any edge, it's the right one. Only the first one counts - the
+        // probe may let go again while the machine decelerates past the contact.
+        if (en_latch_encoder_snapshot()) {
+            cm_start_hold();
+        }
+        return;
+    }
+
+    // *** NOTE: From this point on all conditionals assume we are NOT in homing or probe mode ***
+
+    // trigger the action on leading edges
+    if (in->edge == INPUT_EDGE_LEADING) {
+        if (in->action == INPUT_ACTION_STOP) {
+            cm_start_hold();
+        }
+        if (in->action == INPUT_ACTION_FAST_STOP) {
+            cm_start_hold();                        // for now is same as STOP
+        }
+        if (in->action == INPUT_ACTION_HALT) {
+            cm_halt_all();                            // hard stop, including spindle and coolant
+        }
+        if (in->action == INPUT_ACTION_ALARM) {
+            char msg[10];
+            sprintf(msg, "input %d", ext_pin_number);
+            cm_alarm(STAT_ALARM, msg);
+        }
+        if (in->action == INPUT_ACTION_SHUTDOWN) {
+            char msg[10];
+            sprintf(msg, "input %d", ext_pin_number);
+            cm_shutdown(STAT_SHUTDOWN, msg);
+        }
+        if (in->action == INPUT_ACTION_PANIC) {
+            char msg[10];
+            sprintf(msg, "input %d", ext_pin_number);
+            cm_panic(STAT_PANIC, msg);
+        }
+        if (in->action == INPUT_ACTION_RESET) {
+            hw_hard_reset();
+        }
+    }
+
+    // a limit stops motion right here, not a main loop pass later; the alarm follows
+    // from the input event. Other functions are requested from gpio_event_callback()
+    if ((in->edge == INPUT_EDGE_LEADING) && (in->function == INPUT_FUNCTION_LIMIT) && cm.limit_enable) {
+        cm_start_hold();
+    }
+
+    sr_request_status_report(SR_REQUEST_TIMED);   //+++++ Put this one back in.
+}
+
 /**** Extended DI structure ****/
 
 // To be merged with ioDigitalInput later.
@@ -109,109 +258,8 @@ struct ioDigitalInputExt {
         if (D_IN_CHANNELS < ext_pin_number) { return; }
 
         d_in_t *in = &d_in[ext_pin_number-1];
-
-        // return if input is disabled (not supposed to happen)
-        if (in->mode == IO_MODE_DISABLED) {
-            in->state = INPUT_DISABLED;
-            return;
-        }
-
-        // return if the input is in lockout period (take no action)
-        if (in->lockout_timer.isSet() && !in->lockout_timer.isPast()) {
-            return;
-        }
-
-        // return if no change in state
         bool pin_value = (bool)input_pin;
-        int8_t pin_value_corrected = (pin_value ^ ((int)in->mode ^ 1));    // correct for NO or NC mode
-        if (in->state == (ioState)pin_value_corrected) {
-            return;
-        }
-
-        // lockout the pin for lockout_ms
-        in->lockout_timer.set(in->lockout_ms);
-
-        // record the changed state
-        in->state = (ioState)pin_value_corrected;
-        if (pin_value_corrected == INPUT_ACTIVE) {
-            in->edge = INPUT_EDGE_LEADING;
-        } else {
-            in->edge = INPUT_EDGE_TRAILING;
-        }
-
-        // perform homing operations if in homing mode
-        if (in->homing_mode) {
-            if (in->edge == INPUT_EDGE_LEADING) {   // we only want the leading edge to fire
-                en_take_encoder_snapshot();
-                cm_start_hold();
-            }
-            return;
-        }
-
-        // perform probing operations if in probing mode
-        if (in->probing_mode) {
-            // We want to capture either way.
-            // Probing tests the start condition for the correct direction ahead of time.
-            // If we see any edge, it's the right one.
-            en_take_encoder_snapshot();
-            cm_start_hold();
-            return;
-        }
-
-        // *** NOTE: From this point on all conditionals assume we are NOT in homing or probe mode ***
-
-        // trigger the action on leading edges
-        if (in->edge == INPUT_EDGE_LEADING) {
-            if (in->action == INPUT_ACTION_STOP) {
-                cm_start_hold();
-            }
-            if (in->action == INPUT_ACTION_FAST_STOP) {
-                cm_start_hold();                        // for now is same as STOP
-            }
-            if (in->action == INPUT_ACTION_HALT) {
-                cm_halt_all();                            // hard stop, including spindle and coolant
-            }
-            if (in->action == INPUT_ACTION_ALARM) {
-                char msg[10];
-                sprintf(msg, "input %d", ext_pin_number);
-                cm_alarm(STAT_ALARM, msg);
-            }
-            if (in->action == INPUT_ACTION_SHUTDOWN) {
-                char msg[10];
-                sprintf(msg, "input %d", ext_pin_number);
-                cm_shutdown(STAT_SHUTDOWN, msg);
-            }
-            if (in->action == INPUT_ACTION_PANIC) {
-                char msg[10];
-                sprintf(msg, "input %d", ext_pin_number);
-                cm_panic(STAT_PANIC, msg);
-            }
-            if (in->action == INPUT_ACTION_RESET) {
-                hw_hard_reset();
-            }
-        }
-
-        // these functions trigger on the leading edge
-        if (in->edge == INPUT_EDGE_LEADING) {
-            if (in->function == INPUT_FUNCTION_LIMIT) {
-                cm.limit_requested = ext_pin_number;
-
-            } else if (in->function == INPUT_FUNCTION_SHUTDOWN) {
-                cm.shutdown_requested = ext_pin_number;
-
-            } else if (in->function == INPUT_FUNCTION_INTERLOCK) {
-                cm.safety_interlock_disengaged = ext_pin_number;
-            }
-        }
-
-        // trigger interlock release on trailing edge
-        if (in->edge == INPUT_EDGE_TRAILING) {
-            if (in->function == INPUT_FUNCTION_INTERLOCK) {
-                cm.safety_interlock_reengaged = ext_pin_number;
-            }
-        }
-
-        sr_request_status_report(SR_REQUEST_TIMED);   //+++++ Put this one back in.
+        _input_changed(ext_pin_number, (pin_value ^ ((int)in->mode ^ 1)));  // correct for NO or NC mode
     };
 };
 
@@ -300,6 +348,19 @@ static PWMLikeOutputPin<kOutput13_PinNumber>  output_13_pin;
 #endif
 // END generated
 
+// Feed override knob - a pot on the aux ADC. The interrupt keeps the latest conversion
+#if ADC3_AVAILABLE == 1
+static ADCPin<kADC3_PinNumber> override_knob_pin;
+static volatile uint16_t override_knob_raw = 0;
+
+namespace Motate {
+template<>
+void ADCPin<kADC3_PinNumber>::interrupt() {
+    override_knob_raw = override_knob_pin.getRaw();
+};
+}
+#endif
+
 /************************************************************************************
  **** CODE **************************************************************************
  ************************************************************************************/
@@ -330,6 +391,12 @@ void gpio_init(void)
     output_13_pin.setFrequency(200000);
     // END generated
 
+    io_events.head = io_events.tail = 0;
+
+#if ADC3_AVAILABLE == 1
+    override_knob_pin.setInterrupts(kPinInterruptOnChange|kInterruptPriorityLow);
+#endif
+
     return(gpio_reset());
 }
 
@@ -431,6 +498,7 @@ void gpio_reset(void)
 
 /*
  * gpio_set_homing_mode()   - set/clear input to homing mode
+ * gpio_set_virtual_input() - drive an input from something other than its pin
  * gpio_set_probing_mode()  - set/clear input to probing mode
  * gpio_get_probing_input() - get probing input
  * gpio_read_input()        - read conditioned input
@@ -445,6 +513,22 @@ void  gpio_set_homing_mode(const uint8_t input_num_ext, const bool is_homing)
     d_in[input_num_ext-1].homing_mode = is_homing;
 }
 
+// The input runs exactly as if its pin had changed - same lockout, homing, probing and
+// actions. Called from the main loop, so interrupts are held off while the event ring
+// and the homing state are touched, as the pin ISRs assume they are alone.
+void gpio_set_virtual_input(const uint8_t input_num_ext, const bool active)
+{
+    if ((input_num_ext == 0) || (input_num_ext > D_IN_CHANNELS)) {
+        return;
+    }
+    if (d_in[input_num_ext-1].state == (active ? INPUT_ACTIVE : INPUT_INACTIVE)) {
+        return;                                 // the usual case, so skip the irq hold
+    }
+    __disable_irq();
+    _input_changed(input_num_ext, active ? INPUT_ACTIVE : INPUT_INACTIVE);
+    __enable_irq();
+}
+
 void  gpio_set_probing_mode(const uint8_t input_num_ext, const bool is_probing)
 {
     if (input_num_ext == 0) {
@@ -463,6 +547,19 @@ int8_t gpio_get_probing_input(void)
     return (-1);
 }
 
+/*
+ * gpio_get_function_input() - the first input assigned to a function, or 0 if there is none
+ */
+uint8_t gpio_get_function_input(const inputFunc function)
+{
+    for (uint8_t i = 0; i < D_IN_CHANNELS; i++) {
+        if ((d_in[i].mode != IO_MODE_DISABLED) && (d_in[i].function == function)) {
+            return (i+1);
+        }
+    }
+    return (0);
+}
+
 bool gpio_read_input(const uint8_t input_num_ext)
 {
     if (input_num_ext == 0) {
@@ -471,6 +568,219 @@ bool gpio_read_input(const uint8_t input_num_ext)
     return (d_in[input_num_ext-1].state);
 }
 
+/*
+ * gpio_get_event() - take the oldest input event off the ring. Returns false if none
+ * gpio_event_callback() - drain the input events in order into function requests
+ *
+ *  The callback runs from the controller ahead of the handlers that act on the requests.
+ *  Edges taken by a homing or probing cycle were acted on in the ISR and request nothing.
+ */
+bool gpio_get_event(ioEvent_t *event)
+{
+    uint8_t tail = io_events.tail;
+    if (tail == io_events.head) {
+        return (false);
+    }
+    std::atomic_signal_fence(std::memory_order_acquire);   // index before the slot contents
+    *event = io_events.event[tail & (GPIO_EVENTS-1)];
+    std::atomic_signal_fence(std::memory_order_release);   // done with the slot before freeing it
+    io_events.tail = tail + 1;
+    return (true);
+}
+
+stat_t gpio_event_callback(void)
+{
+    ioEvent_t *e = &io_events.last;
+
+    while (gpio_get_event(e)) {
+        if (e->cycle || (e->input == 0) || (e->input > D_IN_CHANNELS)) {
+            continue;
+        }
+        inputFunc function = d_in[e->input-1].function;
+
+        if (e->edge == INPUT_EDGE_LEADING) {            // these functions trigger on the leading edge
+            if (function == INPUT_FUNCTION_LIMIT) {
+                cm.limit_requested = e->input;
+
+            } else if (function == INPUT_FUNCTION_SHUTDOWN) {
+                cm.shutdown_requested = e->input;
+
+            } else if (function == INPUT_FUNCTION_INTERLOCK) {
+                cm.safety_interlock_disengaged = e->input;
+            }
+        } else {                                        // interlock release on trailing edge
+            if (function == INPUT_FUNCTION_INTERLOCK) {
+                cm.safety_interlock_reengaged = e->input;
+            }
+        }
+    }
+    return (STAT_OK);
+}
+
+/*
+ * _write_output() - set an output to active (1) or inactive (0). False if it's disabled
+ * gpio_write_outputs() - set and clear outputs by bit, from bit 0 = output 1 - OK from an ISR
+ * cm_set_output() - M64/M65 - set an output now
+ */
+static bool _write_output(const uint8_t output_num, float value)
+{
+    if ((output_num == 0) || (output_num > D_OUT_CHANNELS)) {
+        return (false);
+    }
+    ioMode outMode = d_out[output_num-1].mode;
+    if (outMode == IO_MODE_DISABLED) {
+        return (false);
+    }
+    if (outMode == IO_ACTIVE_LOW) {
+        value = 1.0 - value;
+    }
+    switch (output_num) {
+        // Generated with:
+        // perl -e 'for($i=1;$i<14;$i++) { print "case ${i}:  { output_${i}_pin = value; } break;\n";}'
+        // BEGIN generated
+        case 1:  { output_1_pin = value; } break;
+        case 2:  { output_2_pin = value; } break;
+        case 3:  { output_3_pin = value; } break;
+        case 4:  { output_4_pin = value; } break;
+        case 5:  { output_5_pin = value; } break;
+        case 6:  { output_6_pin = value; } break;
+        case 7:  { output_7_pin = value; } break;
+        case 8:  { output_8_pin = value; } break;
+        case 9:  { output_9_pin = value; } break;
+        case 10:  { output_10_pin = value; } break;
+        case 11:  { output_11_pin = value; } break;
+        case 12:  { output_12_pin = value; } break;
+        case 13:  { output_13_pin = value; } break;
+        // END generated
+        default: { return (false); }
+    }
+    return (true);
+}
+
+void gpio_write_outputs(const uint16_t set, const uint16_t clear)
+{
+    for (uint8_t i = 0; i < D_OUT_CHANNELS; i++) {
+        if (set & (1 << i)) {
+            _write_output(i+1, 1.0);
+        } else if (clear & (1 << i)) {
+            _write_output(i+1, 0.0);
+        }
+    }
+}
+
+stat_t cm_set_output(const uint8_t output, const bool value)
+{
+    if (!_write_output(output, (value) ? 1.0 : 0.0)) {
+        return (STAT_NO_GPIO);
+    }
+    return (STAT_OK);
+}
+
+/*
+ * cm_sync_output() - M62/M63 - change an output a distance along the next move
+ * gpio_sync_reset() - drop the changes of moves that were flushed
+ * gpio_sync_start() - runtime is starting a block carrying changes
+ * gpio_sync_segment() - changes for the segment just prepped. False if none
+ * gpio_sync_end() - runtime finished the block - make any changes it didn't get to
+ *
+ *  The changes are queued on a ring and the next move (G0, G1, G2 or G3) carries the
+ *  first and count of them in its Gcode state, so they don't force the stop a queued
+ *  command would. Exec takes a change at the segment whose middle is past its distance
+ *  and the stepper loader makes it as that segment starts, so it lands within half a
+ *  segment of the point along the path. A change that's past the end of the move is made
+ *  as the move finishes. A move too short to run leaves its changes to the next one.
+ *
+ *  An arc that isn't run as one block (PLANNER_ARC_BLOCKS) gives its changes to its
+ *  first segment, so only distances along that segment are meaningful.
+ */
+stat_t cm_sync_output(const uint8_t output, const bool value, const float distance)
+{
+    if ((output == 0) || (output > D_OUT_CHANNELS) || (d_out[output-1].mode == IO_MODE_DISABLED)) {
+        return (STAT_NO_GPIO);
+    }
+    if ((uint8_t)(io_sync.head - io_sync.tail) >= SYNC_OUTPUT_EVENTS) {
+        return (STAT_EAGAIN);                           // held until a running move makes some changes
+    }
+    if (cm.gm.output_count == 0) {
+        cm.gm.output_first = io_sync.head;
+    }
+    ioSyncEvent_t *e = &io_sync.event[io_sync.head & (SYNC_OUTPUT_EVENTS-1)];
+    e->output = output;
+    e->value = value;
+    e->distance = max(distance, 0.0f);
+    io_sync.head++;
+    cm.gm.output_count++;
+    return (STAT_OK);
+}
+
+void gpio_sync_reset()
+{
+    io_sync.tail = io_sync.head;
+    io_sync.block = nullptr;
+    cm.gm.output_count = 0;
+}
+
+void gpio_sync_start(const void *block, const uint8_t first, const uint8_t count)
+{
+    if (block == io_sync.block) {
+        return;                                         // restarted after a hold
+    }
+    io_sync.block = block;
+    io_sync.next = first;
+    io_sync.last = first + count;
+    io_sync.distance = 0;
+    io_sync.tail = first;                               // passes changes of moves that never ran
+}
+
+bool gpio_sync_segment(const float length, uint16_t *set, uint16_t *clear)
+{
+    float midpoint = io_sync.distance + length/2;
+    io_sync.distance += length;
+    *set = 0;
+    *clear = 0;
+    while (io_sync.next != io_sync.last) {
+        ioSyncEvent_t *e = &io_sync.event[io_sync.next & (SYNC_OUTPUT_EVENTS-1)];
+        if (e->distance > midpoint) {
+            break;
+        }
+        uint16_t bit = 1 << (e->output-1);
+        if (e->value) {
+            *set |= bit;
+            *clear &= ~bit;
+        } else {
+            *clear |= bit;
+            *set &= ~bit;
+        }
+        io_sync.next++;
+    }
+    return (*set | *clear);
+}
+
+void gpio_sync_end()
+{
+    for ( ; io_sync.next != io_sync.last; io_sync.next++) {
+        ioSyncEvent_t *e = &io_sync.event[io_sync.next & (SYNC_OUTPUT_EVENTS-1)];
+        _write_output(e->output, (e->value) ? 1.0 : 0.0);
+    }
+    io_sync.tail = io_sync.last;                        // frees the block's slots, which the loader is done with
+    io_sync.block = nullptr;
+}
+
+/*
+ * gpio_read_override_knob() - feed override knob position from 0 to 1, or -1 if there is no knob
+ *
+ *  Reads the last conversion the ADC interrupt kept, so the exec can read it every segment
+ *  without waiting on the ADC. Boards with the aux ADC pinned out set ADC3_AVAILABLE.
+ */
+
+float gpio_read_override_knob()
+{
+#if ADC3_AVAILABLE == 1
+    return ((float)override_knob_raw / override_knob_pin.getTop());
+#else
+    return (-1);
+#endif
+}
 
 /***********************************************************************************
  * CONFIGURATION AND INTERFACE FUNCTIONS
@@ -648,35 +958,8 @@ stat_t io_set_output(nvObj_t *nv)
     // the token has been stripped down to an ASCII digit string - use it as an index
     uint8_t output_num = strtol(num_start, NULL, 10);
 
-    ioMode outMode = d_out[output_num-1].mode;
-    if (outMode == IO_MODE_DISABLED) {
+    if (!_write_output(output_num, nv->value)) {
         nv->value = 0; // Inactive?
-    } else {
-        bool invert = (outMode == 0);
-        float value = nv->value;
-        if (invert) {
-            value = 1.0 - value;
-        }
-        switch (output_num) {
-            // Generated with:
-            // perl -e 'for($i=1;$i<14;$i++) { print "case ${i}:  { output_${i}_pin = value; } break;\n";}'
-            // BEGIN generated
-            case 1:  { output_1_pin = value; } break;
-            case 2:  { output_2_pin = value; } break;
-            case 3:  { output_3_pin = value; } break;
-            case 4:  { output_4_pin = value; } break;
-            case 5:  { output_5_pin = value; } break;
-            case 6:  { output_6_pin = value; } break;
-            case 7:  { output_7_pin = value; } break;
-            case 8:  { output_8_pin = value; } break;
-            case 9:  { output_9_pin = value; } break;
-            case 10:  { output_10_pin = value; } break;
-            case 11:  { output_11_pin = value; } break;
-            case 12:  { output_12_pin = value; } break;
-            case 13:  { output_13_pin = value; } break;
-            // END generated
-            default: { nv->value = 0; } // inactive
-        }
     }
     return (STAT_OK);
 }
@@ -690,7 +973,7 @@ stat_t io_set_output(nvObj_t *nv)
 
     static const char fmt_gpio_mo[] = "[%smo] input mode%17d [0=active-low,1=active-hi,2=disabled]\n";
     static const char fmt_gpio_ac[] = "[%sac] input action%15d [0=none,1=stop,2=fast_stop,3=halt,4=alarm,5=shutdown,6=panic,7=reset]\n";
-    static const char fmt_gpio_fn[] = "[%sfn] input function%13d [0=none,1=limit,2=interlock,3=shutdown,4=probe]\n";
+    static const char fmt_gpio_fn[] = "[%sfn] input function%13d [0=none,1=limit,2=interlock,3=shutdown,4=probe,5=spindle at speed,6=spindle index,7=step capture]\n";
     static const char fmt_gpio_in[] = "Input %s state: %5d\n";
 
     static const char fmt_gpio_domode[] = "[%smo] output mode%16d [0=active low,1=active high,2=disabled]\n";
@@ -698,20 +981,20 @@ stat_t io_set_output(nvObj_t *nv)
 
     static void _print_di(nvObj_t *nv, const char *format)
     {
-        sprintf(cs.out_buf, format, nv->group, (int)nv->value);
+        str_format(cs.out_buf, format, nv->group, (int)nv->value);
         xio_writeline(cs.out_buf);
     }
     void io_print_mo(nvObj_t *nv) {_print_di(nv, fmt_gpio_mo);}
     void io_print_ac(nvObj_t *nv) {_print_di(nv, fmt_gpio_ac);}
     void io_print_fn(nvObj_t *nv) {_print_di(nv, fmt_gpio_fn);}
     void io_print_in(nvObj_t *nv) {
-        sprintf(cs.out_buf, fmt_gpio_in, nv->token, (int)nv->value);
+        str_format(cs.out_buf, fmt_gpio_in, nv->token, (int)nv->value);
         xio_writeline(cs.out_buf);
     }
 
     void io_print_domode(nvObj_t *nv) {_print_di(nv, fmt_gpio_domode);}
     void io_print_out(nvObj_t *nv) {
-        sprintf(cs.out_buf, fmt_gpio_out, nv->token, (int)nv->value);
+        str_format(cs.out_buf, fmt_gpio_out, nv->token, (int)nv->value);
         xio_writeline(cs.out_buf);
     }
 #endif
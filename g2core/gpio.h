@@ -28,6 +28,8 @@
 #ifndef GPIO_H_ONCE
 #define GPIO_H_ONCE
 
+#include "hardware.h"  // for MOTORS
+
 /*
  * GPIO defines
  */
@@ -72,6 +74,9 @@ typedef enum {                          // functions are requested from the ISR,
     INPUT_FUNCTION_INTERLOCK = 2,       // interlock processing
     INPUT_FUNCTION_SHUTDOWN = 3,        // shutdown in support of external emergency stop
     INPUT_FUNCTION_PROBE = 4,           // assign input as probe input
+    INPUT_FUNCTION_SPINDLE_AT_SPEED = 5,// spindle or VFD signals it's up to speed
+    INPUT_FUNCTION_SPINDLE_INDEX = 6,   // once-per-rev spindle index - see en_latch_spindle_index()
+    INPUT_FUNCTION_STEP_CAPTURE = 7,    // step pin looped back to time its edges - see step_capture.h
     INPUT_FUNCTION_MAX                  // unused. Just for range checking
 } inputFunc;
 
@@ -114,6 +119,64 @@ typedef struct gpioAnalogOutput {       // one struct per analog output
     ioMode mode;
 } a_out_t;
 
+/*
+ * Input events
+ *
+ *  Every accepted edge is pushed onto a small ring from the input's ISR, stamped with the
+ *  timebase time (timebase.h) and the motor step positions at the instant of the edge. The main loop drains the ring in order and turns the events into the function
+ *  requests (limit, shutdown, interlock) that the controller handlers act on, so two edges
+ *  that land between passes of the loop are both seen, and in the order they happened.
+ *
+ *  The ring is single producer, single consumer. The input interrupts all run at the same
+ *  priority so they can't preempt one another, and only gpio_get_event() advances the tail.
+ *  The indexes are free-running bytes masked into the ring, so GPIO_EVENTS must be a power
+ *  of 2 no larger than 128. A full ring drops the new event and counts it.
+ */
+#ifndef GPIO_EVENTS
+#define GPIO_EVENTS         16          // input event ring depth (power of 2)
+#endif
+
+typedef struct ioEvent {                // one record per input edge
+    uint64_t usec;                      // timebase time of the edge (us)
+    uint8_t input;                      // external input number, as in "di1"
+    inputEdgeFlag edge;                 // leading or trailing
+    bool cycle;                         // edge was taken by a homing or probing cycle
+    float steps[MOTORS];                // motor positions at the edge (steps)
+} ioEvent_t;
+
+typedef struct ioEventQueue {
+    volatile uint8_t head;              // next slot to write - advanced by the input ISRs only
+    volatile uint8_t tail;              // next slot to read - advanced by the main loop only
+    uint32_t dropped;                   // events lost to a full ring
+    ioEvent_t event[GPIO_EVENTS];
+    ioEvent_t last;                     // most recent event drained, for inquiry
+} ioEventQueue_t;
+
+extern ioEventQueue_t io_events;
+
+#ifndef SYNC_OUTPUT_EVENTS
+#define SYNC_OUTPUT_EVENTS 16           // M62/M63 output changes queued with moves. Must be 2^N, 256 at most
+#endif
+
+typedef struct ioSyncEvent {            // an output change to make part way along a move
+    uint8_t output;                     // output number, from 1
+    bool value;                         // true = active
+    float distance;                     // mm from the start of the move
+} ioSyncEvent_t;
+
+typedef struct ioSyncOutputs {          // see cm_sync_output()
+    ioSyncEvent_t event[SYNC_OUTPUT_EVENTS];
+    uint8_t head;                       // events written by the model
+    volatile uint8_t tail;              // events done by the runtime
+
+    const void *block;                  // block the runtime is running them for - a hold restarts the same one
+    uint8_t next;                       // its next event to make
+    uint8_t last;                       // one past its last event
+    float distance;                     // mm run in the block so far
+} ioSyncOutputs_t;
+
+extern ioSyncOutputs_t io_sync;
+
 extern d_in_t   d_in[D_IN_CHANNELS];
 extern d_out_t  d_out[D_OUT_CHANNELS];
 extern a_in_t   a_in[A_IN_CHANNELS];
@@ -130,8 +193,22 @@ void output_reset(void);
 
 bool gpio_read_input(const uint8_t input_num);
 void gpio_set_homing_mode(const uint8_t input_num, const bool is_homing);
+void gpio_set_virtual_input(const uint8_t input_num, const bool active);
 void gpio_set_probing_mode(const uint8_t input_num, const bool is_probing);
 int8_t gpio_get_probing_input(void);
+uint8_t gpio_get_function_input(const inputFunc function);
+
+bool gpio_get_event(ioEvent_t *event);
+stat_t gpio_event_callback(void);
+
+void gpio_write_outputs(const uint16_t set, const uint16_t clear);
+stat_t cm_set_output(const uint8_t output, const bool value);                       // M64, M65
+stat_t cm_sync_output(const uint8_t output, const bool value, const float distance);// M62, M63
+void gpio_sync_reset(void);
+void gpio_sync_start(const void *block, const uint8_t first, const uint8_t count);  // called from exec
+bool gpio_sync_segment(const float length, uint16_t *set, uint16_t *clear);         // called from exec
+void gpio_sync_end(void);                                                          // called from exec
+float gpio_read_override_knob(void);                                               // called from exec
 
 stat_t io_set_mo(nvObj_t *nv);
 stat_t io_set_ac(nvObj_t *nv);
@@ -30,8 +30,10 @@
 #include "config.h"  // JSON sits on top of the config system
 #include "controller.h"
 #include "json_parser.h"
+#include "cbor.h"
 #include "text_parser.h"
 #include "canonical_machine.h"
+#include "planner.h"
 #include "report.h"
 #include "util.h"
 #include "xio.h"
@@ -44,14 +46,15 @@ jsSingleton_t js;
 
 static stat_t _json_parser_kernal(nvObj_t *nv, char *str);
 static stat_t _json_parser_execute(nvObj_t *nv);
-static stat_t _normalize_json_string(char *str, uint16_t size);
+static stat_t _json_batch_stage(nvObj_t *nv);
+static bool _json_ack_line(uint8_t status);
+static void _json_ack_flush(void);
 static stat_t _get_nv_pair(nvObj_t *nv, char **pstr, int8_t *depth);
 
 /****************************************************************************
  * json_parser() - exposed part of JSON parser
  * _json_parser_kernal()
- * _normalize_json_string()
- * _get_nv_pair_strict()
+ * _get_nv_pair()
  *
  *  This is a dumbed down JSON parser to fit in limited memory with no malloc
  *  or practical way to do recursion ("depth" tracks parent/child levels).
@@ -74,6 +77,7 @@ static stat_t _get_nv_pair(nvObj_t *nv, char **pstr, int8_t *depth);
  *
  *  The parser:
  *    - extracts an array of one or more JSON object structs from the input string
+ *      in a single pass, without first normalizing the string
  *    - once the array is built it executes the object(s) in order in the array
  *    - passes the executed array to the response handler to generate the response string
  *    - returns the status and the JSON response string
@@ -91,7 +95,17 @@ stat_t json_parser(char *str, bool suppress_response) // suppress_response defau
     stat_t status = _json_parser_kernal(nv, str);
     if (status == STAT_OK) {                        // execute the command
         nv = nv_body;
-        status = _json_parser_execute(nv);
+        if ((js.batch.state == BATCH_BEGIN) && (nv->index != js.batch.batch_index)) {
+            status = _json_batch_stage(nv);         // or stage it, if a batch is open
+        } else {
+            status = _json_parser_execute(nv);
+        }
+    }
+    if (status == STAT_EAGAIN) {                    // can't be taken yet (e.g. {rpx:} with every raster row queued)
+        return (status);                            // no response - the caller holds the line and runs it again
+    }
+    if ((js.batch.state == BATCH_BEGIN) && (status != STAT_OK) && (status != STAT_COMPLETE)) {
+        js.batch.state = BATCH_ABORT;               // any error discards an open batch
     }
     if (suppress_response || (status == STAT_COMPLETE)) {  // skip the print if returning from something that already did it.
         return status;
@@ -101,16 +115,23 @@ stat_t json_parser(char *str, bool suppress_response) // suppress_response defau
     return STAT_OK;
 }
 
-// This is almost the same as json_parser, except it doesn't *always* execute the parsed out list, and it never returns a reponse
-void json_parse_for_exec(char *str, bool execute)
+/*
+ * json_parse_nv_list()   - parse a JSON string into an nv list without executing it
+ * json_execute_nv_list() - execute the sets and gets in a parsed list. No response is made
+ *
+ *  These split json_parser() for commands queued to the planner (M100, M101): the string
+ *  is parsed in place when it's queued and the list is executed by the runtime later.
+ *  'length' is the number of nvObjs at nv; the list holds one pair less than that.
+ */
+stat_t json_parse_nv_list(nvObj_t *nv, uint8_t length, char *str)
 {
-    nvObj_t *nv = nv_reset_exec_nv_list();          // get a fresh nvObj list
-    stat_t status = _json_parser_kernal(nv, str);
-    if ((status == STAT_OK) && (execute)) {
-        // execute the command
-        nv = nv_exec;
-        status = _json_parser_execute(nv);
-    }
+    _nv_reset_a_list(nv, length);
+    return (_json_parser_kernal(nv, str));
+}
+
+stat_t json_execute_nv_list(nvObj_t *nv)
+{
+    return (_json_parser_execute(nv));
 }
 
 static stat_t _json_parser_execute(nvObj_t *nv) {
@@ -141,24 +162,21 @@ static stat_t _json_parser_kernal(nvObj_t *nv, char *str)
     int8_t depth;
     char group[GROUP_LEN+1] = {""};                 // group identifier - starts as NUL
     int8_t i = NV_BODY_LEN;
-
-    status = _normalize_json_string(str, JSON_INPUT_STRING_MAX);
-    if (status != STAT_OK) {
-        nv->valuetype = TYPE_NULL;
-        return (status);
-    }
+    char *start = str;
 
     // parse the JSON command into the nv body
     do {
         if (--i == 0) {
             return (STAT_JSON_TOO_MANY_PAIRS);      // length error
         }
-        // Use relaxed parser. Will read either strict or relaxed mode. To use strict-only parser refer
-        // to build earlier than 407.03. Substitute _get_nv_pair_strict() for _get_nv_pair()
         if ((status = _get_nv_pair(nv, &str, &depth)) > STAT_EAGAIN) { // erred out
             nv->valuetype = TYPE_NULL;
             return (status);
         }
+        if ((str - start) > JSON_INPUT_STRING_MAX) {
+            nv->valuetype = TYPE_NULL;
+            return (STAT_INPUT_EXCEEDS_MAX_LENGTH);
+        }
         // propagate the group from previous NV pair (if relevant)
         if (group[0] != NUL) {
             strncpy(nv->group, group, GROUP_LEN);   // copy the parent's group to this child
@@ -179,35 +197,6 @@ static stat_t _json_parser_kernal(nvObj_t *nv, char *str)
     return (STAT_OK);                               // only successful commands exit through this point
 }
 
-/*
- * _normalize_json_string - normalize a JSON string in place
- *
- *  Validate string size limits, remove all whitespace and convert
- *  to lower case, with the exception of gcode comments
- */
-
-static stat_t _normalize_json_string(char *str, uint16_t size)
-{
-    char *wr;                                       // write pointer
-    uint8_t in_comment = false;
-
-    if (strlen(str) > size) {
-        return (STAT_INPUT_EXCEEDS_MAX_LENGTH);
-    }
-    for (wr = str; *str != NUL; str++) {
-        if (!in_comment) {                          // normal processing
-            if (*str == '(') in_comment = true;
-            if ((*str <= ' ') || (*str == DEL)) continue; // toss ctrls, WS & DEL
-            *wr++ = tolower(*str);
-        } else {                                    // Gcode comment processing
-            if (*str == ')') in_comment = false;
-            *wr++ = *str;
-        }
-    }
-    *wr = NUL;
-    return (STAT_OK);
-}
-
 /*
  * _get_nv_pair() - get the next name-value pair w/relaxed JSON rules. Also parses strict JSON.
  *
@@ -221,7 +210,11 @@ static stat_t _normalize_json_string(char *str, uint16_t size)
  *  If this were to be extended to track multiple parents or more than two
  *  levels deep it would have to track closing curlies - which it does not.
  *
- *  ASSUMES INPUT STRING HAS FIRST BEEN NORMALIZED BY _normalize_json_string()
+ *  The string is read as-is. Whitespace, control characters and DEL are skipped and
+ *  names and values are taken as lower case, except in gcode comments. The name is
+ *  copied to the token. A string value is compacted in place and nv->stringp points
+ *  to it in the input string, which must outlive the nv list - it is not copied to
+ *  the shared string.
  *
  *  If a group prefix is passed in it will be pre-pended to any name parsed
  *  to form a token string. For example, if "x" is provided as a group and
@@ -236,10 +229,12 @@ static stat_t _normalize_json_string(char *str, uint16_t size)
  *  See build 406.xx or earlier for strict JSON parser - deleted in 407.03
  */
 
+static inline bool _is_json_space(char c) { return ((c <= ' ') || (c == DEL)); } // NUL is checked first
+
 static stat_t _get_nv_pair(nvObj_t *nv, char **pstr, int8_t *depth)
 {
     uint8_t i;
-    char *tmp;
+    char *p = *pstr;
     char leaders[] = {"{,\""};      // open curly, quote and leading comma
     char separators[] = {":\""};    // colon and quote
     char terminators[] = {"},\""};  // close curly, comma and quote
@@ -248,96 +243,126 @@ static stat_t _get_nv_pair(nvObj_t *nv, char **pstr, int8_t *depth)
     nv_reset_nv(nv);                // wipes the object and sets the depth
 
     // --- Process name part ---
-    // Find, terminate and set pointers for the name. Allow for leading and trailing name quotes.
-    char * name = *pstr;
-    for (i=0; true; i++, (*pstr)++) {
-        if (strchr(leaders, (int)**pstr) == NULL) {     // find leading character of name
-            name = (*pstr)++;
+    // Find the name and copy it to the token. Allow for leading and trailing name quotes.
+    for (i=0; true; p++) {
+        if (*p == NUL) {
+            return (STAT_JSON_SYNTAX_ERROR);
+        }
+        if (_is_json_space(*p)) continue;
+        if (strchr(leaders, (int)*p) == NULL) {         // find leading character of name
             break;
         }
-        if (i == MAX_PAD_CHARS) {
+        if (i++ == MAX_PAD_CHARS) {
             return (STAT_JSON_SYNTAX_ERROR);
         }
     }
-
-    // Find the end of name, NUL terminate and copy token
-    for (i=0; true; i++, (*pstr)++) {
-        if (strchr(separators, (int)**pstr) != NULL) {
-            *(*pstr)++ = NUL;
-            strncpy(nv->token, name, TOKEN_LEN+1);      // copy the string to the token
+    nv->token[0] = tolower(*p++);
+    for (i=1; true; p++) {                              // find the end of name
+        if (*p == NUL) {
+            return (STAT_JSON_SYNTAX_ERROR);
+        }
+        if (_is_json_space(*p)) continue;
+        if (strchr(separators, (int)*p) != NULL) {
+            nv->token[i] = NUL;
+            p++;
             break;
         }
         if (i == TOKEN_LEN) {
+            nv->token[0] = NUL;
             return (STAT_INPUT_EXCEEDS_MAX_LENGTH);
         }
+        nv->token[i++] = tolower(*p);
     }
 
     // --- Process value part ---  (organized from most to least frequently encountered)
 
     // Find the start of the value part
-    for (i=0; true; i++, (*pstr)++) {
-        if (isalnum((int)**pstr)) break;
-        if (strchr(value, (int)**pstr) != NULL) break;
-        if (i == MAX_PAD_CHARS) {
+    for (i=0; true; p++) {
+        if (*p == NUL) {
+            return (STAT_JSON_SYNTAX_ERROR);
+        }
+        if (_is_json_space(*p)) continue;
+        if (isalnum((int)*p)) break;
+        if (strchr(value, (int)*p) != NULL) break;
+        if (i++ == MAX_PAD_CHARS) {
             return (STAT_JSON_SYNTAX_ERROR);
         }
     }
+    char c = tolower(*p);
 
     // nulls (gets)
-    if ((**pstr == 'n') || ((**pstr == '\"') && (*(*pstr+1) == '\"'))) { // process null value
+    if ((c == 'n') || ((c == '\"') && (*(p+1) == '\"'))) { // process null value
         nv->valuetype = TYPE_NULL;
         nv->value = TYPE_NULL;
 
     // numbers
-    } else if (isdigit(**pstr) || (**pstr == '-')) {    // value is a number
-        nv->value = (float)strtod(*pstr, &tmp);         // tmp is the end pointer
-
-        if ((tmp == *pstr) ||                           // if start pointer equals end the conversion failed
-            (strchr(terminators, *tmp) == NULL)) {      // terminators are the only legal chars at the end of a number
+    } else if (isdigit(c) || (c == '-')) {              // value is a number
+        if (!atofloat(&p, &nv->value, true)) {          // p is left on the end of the number
             nv->valuetype = TYPE_NULL;                  // report back an error
             return (STAT_BAD_NUMBER_FORMAT);
         }
+        while (_is_json_space(*p) && (*p != NUL)) {
+            p++;
+        }
+        if (strchr(terminators, *p) == NULL) {          // terminators are the only legal chars at the end of a number
+            nv->valuetype = TYPE_NULL;
+            return (STAT_BAD_NUMBER_FORMAT);
+        }
         nv->valuetype = TYPE_FLOAT;
 
     // object parent
-    } else if (**pstr == '{') {
+    } else if (c == '{') {
         nv->valuetype = TYPE_PARENT;
 //        *depth += 1;                                  // nv_reset_nv() sets the next object's level so this is redundant
-        (*pstr)++;
+        *pstr = p+1;
         return(STAT_EAGAIN);                            // signal that there is more to parse
 
     // strings
-    } else if (**pstr == '\"') {                        // value is a string
-        (*pstr)++;
+    } else if (c == '\"') {                             // value is a string
+        char *str = ++p;                                // compact it in place - it never grows
+        char *wr = str;
+        bool in_comment = false;
         nv->valuetype = TYPE_STRING;
-        if ((tmp = strchr(*pstr, '\"')) == NULL) {
-            return (STAT_JSON_SYNTAX_ERROR);            // find the end of the string
+        for ( ; *p != '\"'; p++) {
+            if (*p == NUL) {
+                return (STAT_JSON_SYNTAX_ERROR);        // find the end of the string
+            }
+            if (!in_comment) {                          // normal processing
+                if (*p == '(') in_comment = true;
+                if (_is_json_space(*p)) continue;       // toss ctrls, WS & DEL
+                *wr++ = tolower(*p);
+            } else {                                    // Gcode comment processing
+                if (*p == ')') in_comment = false;
+                *wr++ = *p;
+            }
         }
-        *tmp = NUL;
+        *wr = NUL;
 
-        // if string begins with 0x it might be data, needs to be at least 3 chars long
-        if( strlen(*pstr)>=3 && (*pstr)[0]=='0' && (*pstr)[1]=='x')
-        {
+        if (wr == str) {                                // an empty string is a null, as for ""
+            nv->valuetype = TYPE_NULL;
+            nv->value = TYPE_NULL;
+        } else if (((wr - str) >= 3) && (str[0]=='0') && (str[1]=='x')) {
+            // if string begins with 0x it might be data, needs to be at least 3 chars long
             uint32_t *v = (uint32_t*)&nv->value;
-            *v = strtoul((const char *)*pstr, 0L, 0);
+            *v = strtoul((const char *)str, 0L, 0);
             nv->valuetype = TYPE_DATA;
         } else {
-            ritorno(nv_copy_string(nv, *pstr));
+            nv->stringp = (char (*)[])str;
         }
-        *pstr = ++tmp;
+        p++;
 
     // boolean true/false
-    } else if (**pstr == 't') {
+    } else if (c == 't') {
         nv->valuetype = TYPE_BOOL;
         nv->value = true;
-    } else if (**pstr == 'f') {
+    } else if (c == 'f') {
         nv->valuetype = TYPE_BOOL;
         nv->value = false;
 
     // arrays
-    } else if (**pstr == '[') {
+    } else if (c == '[') {
         nv->valuetype = TYPE_ARRAY;
-        ritorno(nv_copy_string(nv, *pstr));     // copy array into string for error displays
+        ritorno(nv_copy_string(nv, p));         // copy array into string for error displays
         return (STAT_VALUE_TYPE_ERROR);         // return error as the parser doesn't do input arrays yet
 
     // general error condition
@@ -346,20 +371,78 @@ static stat_t _get_nv_pair(nvObj_t *nv, char **pstr, int8_t *depth)
     }
 
     // process comma separators and end curlies
-    if ((*pstr = strpbrk(*pstr, terminators)) == NULL) { // advance to terminator or err out
+    if ((p = strpbrk(p, terminators)) == NULL) { // advance to terminator or err out
         return (STAT_JSON_SYNTAX_ERROR);
     }
-    if (**pstr == '}') {
+    if (*p == '}') {
         *depth -= 1;                            // pop up a nesting level
-        (*pstr)++;                              // advance to comma or whatever follows
+        p++;                                    // advance to comma or whatever follows
+        while (_is_json_space(*p) && (*p != NUL)) {
+            p++;
+        }
     }
-    if (**pstr == ',') {
+    *pstr = p;
+    if (*p == ',') {
         return (STAT_EAGAIN);                   // signal that there is more to parse
     }
     (*pstr)++;
     return (STAT_OK);                           // signal that parsing is complete
 }
 
+/*
+ * json_serialize_value() - write the JSON form of a single nvObj value
+ *
+ *  Writes just the value - no token, no comma - and returns a pointer to the character
+ *  after it. Nothing is written for TYPE_EMPTY and TYPE_PARENT, as those are handled by
+ *  the caller. The string is not terminated. Used by json_serialize() and by the status
+ *  report slots in report.cpp, which must produce identical text.
+ */
+
+char *json_serialize_value(nvObj_t *nv, char *str)
+{
+    switch (nv->valuetype)  {
+        case (TYPE_EMPTY):  {   break; }
+        case (TYPE_NULL):   {   strcpy(str, "null");
+                                str += 4;
+                                break;
+                            }
+        case (TYPE_PARENT): {   break; }
+        case (TYPE_FLOAT):  {   preprocess_float(nv);
+                                str += floattoa(str, nv->value, nv->precision);
+                                break;
+                            }
+        case (TYPE_INT):    {   str += inttoa(str, (int)nv->value);
+                                break;
+                            }
+        case (TYPE_STRING): {   *str++ = '"';
+                                strcpy(str, *nv->stringp);
+                                str += strlen(*nv->stringp);
+                                *str++ = '"';
+                                break;
+                            }
+        case (TYPE_BOOL):   {   if (fp_FALSE(nv->value)) {
+                                    strcpy(str, "false");
+                                    str += 5;
+                                } else {
+                                    strcpy(str, "true");
+                                    str += 4;
+                                }
+                                break;
+                            }
+        case (TYPE_DATA):   {   uint32_t *v = (uint32_t*)&nv->value;
+                                str += str_format(str, "\"0x%lx\"", *v);
+                                break;
+                            }
+        case (TYPE_ARRAY):  {   strcpy(str++, "[");
+                                strcpy(str, *nv->stringp);
+                                str += strlen(*nv->stringp);
+                                strcpy(str++, "]");
+                                break;
+                            }
+    }
+    return (str);
+}
+
 /****************************************************************************
  * json_serialize() - make a JSON object string from JSON object array
  *
@@ -410,49 +493,11 @@ uint16_t json_serialize(nvObj_t *nv, char *out_buf, uint16_t size)
             strcpy(str, nv->token); str += strlen(nv->token);
             strcpy(str++, "\":"); str++;
 
-            switch (nv->valuetype)  {
-                case (TYPE_EMPTY):  {   break; }
-                case (TYPE_NULL):   {   strcpy(str, "null");
-                                        str += 4;
-                                        break;
-                                    }
-                case (TYPE_PARENT): {   *str++ = '{';
-                                        need_a_comma = false;
-                                        break;
-                                    }
-                case (TYPE_FLOAT):  {   preprocess_float(nv);
-                                        str += floattoa(str, nv->value, nv->precision);
-                                        break;
-                                    }
-                case (TYPE_INT):    {   // str += inttoa(str, (int)nv->value); // doesn't handle negative numbers
-                                        str += sprintf(str, "%d", (int)nv->value);
-                                        break;
-                                    }
-                case (TYPE_STRING): {   *str++ = '"';
-                                        strcpy(str, *nv->stringp);
-                                        str += strlen(*nv->stringp);
-                                        *str++ = '"';
-                                        break;
-                                    }
-                case (TYPE_BOOL):   {   if (fp_FALSE(nv->value)) {
-                                            strcpy(str, "false");
-                                            str += 5;
-                                        } else {
-                                            strcpy(str, "true");
-                                            str += 4;
-                                        }
-                                        break;
-                                    }
-                case (TYPE_DATA):   {   uint32_t *v = (uint32_t*)&nv->value;
-                                        str += sprintf(str, "\"0x%lx\"", *v);
-                                        break;
-                                    }
-                case (TYPE_ARRAY):  {   strcpy(str++, "[");
-                                        strcpy(str, *nv->stringp);
-                                        str += strlen(*nv->stringp);
-                                        strcpy(str++, "]");
-                                        break;
-                                    }
+            if (nv->valuetype == TYPE_PARENT) {
+                *str++ = '{';
+                need_a_comma = false;
+            } else {
+                str = json_serialize_value(nv, str);
             }
         }
         if (str >= str_max) { return (-1);}     // signal buffer overrun
@@ -469,7 +514,9 @@ uint16_t json_serialize(nvObj_t *nv, char *out_buf, uint16_t size)
     while (prev_depth-- > initial_depth) {
         *str++ = '}';
     }
-    str += sprintf((char *)str, "}\n");         // using sprintf for this last one ensures a NUL termination
+    *str++ = '}';
+    *str++ = '\n';
+    *str = NUL;
     if (str > out_buf + size) {
         return (-1);
     }
@@ -480,11 +527,18 @@ uint16_t json_serialize(nvObj_t *nv, char *out_buf, uint16_t size)
  * json_print_object() - serialize and print the nvObj array directly (w/o header & footer)
  *
  *  Ignores JSON verbosity settings and everything else - just serializes the list & prints
- *  Useful for reports and other simple output.
+ *  Useful for reports and other simple output. Sent as CBOR in CBOR_MODE.
  *  Object list should be terminated by nv->nx == NULL
  */
 void json_print_object(nvObj_t *nv)
 {
+    if (cs.comm_mode == CBOR_MODE) {
+        int16_t length = cbor_serialize(nv, cs.out_buf, sizeof(cs.out_buf));
+        if (length > 0) {
+            xio_write(cs.out_buf, length);
+        }
+        return;
+    }
     json_serialize(nv, cs.out_buf, sizeof(cs.out_buf));
     xio_writeline(cs.out_buf);
 }
@@ -523,6 +577,32 @@ void json_print_list(stat_t status, uint8_t flags)
  *  on all the (non-silent) responses.
  */
 
+/*
+ * _json_footer() - write the footer array contents (w/o brackets) for a response
+ *
+ *  str must have room for NV_FOOTER_LEN characters. Returns the character count.
+ */
+
+static uint8_t _json_footer(char *str, uint8_t status)
+{
+    char *start = str;
+
+    str += inttoa(str, js.json_footer_style);               // the footer revision is the footer style
+    strcpy(str++, ",");
+    str += inttoa(str, status);                             // nb: inttoa() works differently than itoa(). See util.cpp
+    strcpy(str++, ",");
+    str += inttoa(str, cs.linelen+1);
+    cs.linelen = 0;                                            // reset linelen so it's only reported once
+
+    if (js.json_footer_style == JF_WINDOW_REPORT) {         // credits for hosts that keep the pipeline full
+        strcpy(str++, ",");
+        str += inttoa(str, mp_get_planner_buffers());
+        strcpy(str++, ",");
+        str += inttoa(str, xio_get_rx_bytes_free());
+    }
+    return (str - start);
+}
+
 void json_print_response(uint8_t status, const bool only_to_muted /*= false*/)
 {
     if ((js.json_verbosity == JV_SILENT) || (cs.responses_suppressed)) {                   // silent means no responses
@@ -536,6 +616,11 @@ void json_print_response(uint8_t status, const bool only_to_muted /*= false*/)
         }
     }
 
+    if ((!only_to_muted) && _json_ack_line(status)) {      // taken into the pending acknowledgement
+        return;
+    }
+    _json_ack_flush();                                      // it answers lines before this one
+
     // Body processing
     nvObj_t *nv = nv_body;
     if (status == STAT_JSON_SYNTAX_ERROR) {
@@ -587,14 +672,7 @@ void json_print_response(uint8_t status, const bool only_to_muted /*= false*/)
     // cs.linelen so that the number of bytes received matches the number of bytes reported
 
     char footer_string[NV_FOOTER_LEN];
-    char *str = footer_string;
-
-    strcpy(str, "1,"); str += 2;                            // '1' is the footer revision hard coded
-    str += inttoa(str, status);                             // nb: inttoa() works differently than itoa(). See util.cpp
-    strcpy(str++, ",");
-    str += inttoa(str, cs.linelen+1);
-    cs.linelen = 0;                                            // reset linelen so it's only reported once
-
+    _json_footer(footer_string, status);
     nv_copy_string(nv, footer_string);                      // link string to nv object
     nv->depth = 0;                                          // footer 'f' is a peer to response 'r' (hard wired to 0)
     nv->valuetype = TYPE_ARRAY;                             // declare it as an array
@@ -602,16 +680,433 @@ void json_print_response(uint8_t status, const bool only_to_muted /*= false*/)
     nv->nx = NULL;                                          // terminate the list
 
     // serialize the JSON response and print it if there were no errors
+    if (cs.comm_mode == CBOR_MODE) {
+        int16_t length = cbor_serialize(nv_header, cs.out_buf, sizeof(cs.out_buf));
+        if (length > 0) {
+            xio_write(cs.out_buf, length, only_to_muted);
+        }
+        return;
+    }
     if (json_serialize(nv_header, cs.out_buf, sizeof(cs.out_buf)) >= 0) {
         xio_writeline(cs.out_buf, only_to_muted);
     }
 }
 
+/***********************************************************************************
+ * LINE ACKNOWLEDGEMENTS
+ *
+ *  With {ja:N} a host streaming Gcode gets one response for up to N lines that succeeded,
+ *  instead of one each:
+ *
+ *    {"r":{"ack":[20,1201,1220,14]},"f":[1,0,412]}
+ *
+ *  "ack" is the number of lines, the N words of the first and the last of them (0 if they
+ *  had none) and the fewest planner buffers free after any of them. The footer counts the
+ *  bytes of all the lines, so a host keeping a byte window gets the credit it would have
+ *  got from their own footers. Only lines whose response would be the footer alone are
+ *  taken - Gcode lines with status OK and no messages, at {jv:1} to {jv:4}. Any other
+ *  response sends the pending acknowledgement first and then goes out as usual, so errors
+ *  are still reported at once, and in order.
+ *
+ *  json_ack_callback() sends a pending acknowledgement once its first line has waited
+ *  JSON_ACK_TIMEOUT_MS, so a host that stops to wait for credit gets it.
+ *
+ *  JSON only. In CBOR mode every line gets its own response.
+ ***********************************************************************************/
+
+/*
+ * _json_ack_line() - take the response to a line into the pending acknowledgement
+ *
+ *  Returns true if it was taken, in which case no response is sent for the line.
+ */
+
+static bool _json_ack_line(uint8_t status)
+{
+    if ((js.json_ack_lines < 2) || (status != STAT_OK) || (cs.comm_mode == CBOR_MODE) ||
+        (js.json_verbosity > JV_LINENUM) || (cm.machine_state == MACHINE_INITIALIZING)) {
+        return (false);
+    }
+    nvObj_t *nv = nv_body;
+    if (nv_get_type(nv) != NV_TYPE_GCODE) {
+        return (false);
+    }
+    while (((nv = nv->nx) != NULL) && (nv->valuetype != TYPE_EMPTY)) {
+        if (nv_get_type(nv) != NV_TYPE_LINENUM) {
+            return (false);                                 // messages need their own response
+        }
+    }
+
+    uint32_t linenum = ((*cs.saved_buf == 'N') || (*cs.saved_buf == 'n')) ? strtoul(cs.saved_buf+1, NULL, 10) : 0;
+    uint8_t buffers = mp_get_planner_buffers();
+
+    if (js.ack.lines == 0) {
+        js.ack.first_linenum = linenum;
+        js.ack.first_tick = SysTickTimer.getValue();
+        js.ack.buffers = buffers;
+    }
+    js.ack.last_linenum = linenum;
+    js.ack.buffers = min(js.ack.buffers, buffers);
+    js.ack.bytes += cs.linelen+1;                           // +1 as in the footer - see json_print_response()
+    cs.linelen = 0;
+
+    if (++js.ack.lines >= js.json_ack_lines) {
+        _json_ack_flush();
+    }
+    return (true);
+}
+
+/*
+ * _json_ack_flush() - send the pending acknowledgement, if there is one
+ */
+
+static void _json_ack_flush()
+{
+    if (js.ack.lines == 0) {
+        return;
+    }
+    if ((js.json_verbosity != JV_SILENT) && (!cs.responses_suppressed)) {
+        uint16_t linelen = cs.linelen;                      // the line being answered keeps its length
+        char footer_string[NV_FOOTER_LEN];
+        cs.linelen = js.ack.bytes - 1;
+        _json_footer(footer_string, STAT_OK);
+        cs.linelen = linelen;
+
+        char buffer[NV_FOOTER_LEN + 64];
+        sprintf(buffer, "{\"r\":{\"ack\":[%d,%lu,%lu,%d]},\"f\":[%s]}\n",
+                js.ack.lines, (unsigned long)js.ack.first_linenum, (unsigned long)js.ack.last_linenum,
+                js.ack.buffers, footer_string);
+        xio_writeline(buffer);
+    }
+    js.ack.lines = 0;
+    js.ack.bytes = 0;
+}
+
+/*
+ * json_ack_callback() - send a pending acknowledgement once its first line has waited
+ */
+
+stat_t json_ack_callback()
+{
+    if (js.ack.lines == 0) {
+        return (STAT_NOOP);
+    }
+    if ((SysTickTimer.getValue() - js.ack.first_tick) < JSON_ACK_TIMEOUT_MS) {
+        return (STAT_NOOP);
+    }
+    _json_ack_flush();
+    return (STAT_OK);
+}
+
+/***********************************************************************************
+ * STREAMING SERIALIZER
+ *
+ *  A group response is limited to what fits in the nv list (NV_BODY_LEN) and the shared
+ *  string, so a host reading the whole configuration has to ask for it a group at a time.
+ *  json_stream_groups() answers {"$":n} as a single response instead:
+ *
+ *    {"r":{"sys":{"fb":101.03,...},"1":{"ma":0,...},...,"g30":{...}},"f":[1,0,8]}
+ *
+ *  It walks the cfgArray groups that expand with get_grp(), gets one child at a time into
+ *  a single nvObj, and serializes it straight into cs.out_buf - which is written to the
+ *  host whenever it gets to within JSON_STREAM_MARGIN of full. So RAM use doesn't depend
+ *  on the size of the groups or of the configuration. The chunks are not separate lines;
+ *  only the footer ends with a newline.
+ *
+ *  JSON only. In CBOR mode, or in text mode, {"$":n} prints the groups one by one.
+ ***********************************************************************************/
+
+/*
+ * _json_stream_flush() - write what's been serialized so far. Returns the start of the buffer
+ */
+
+static char *_json_stream_flush(char *str)
+{
+    if (str > cs.out_buf) {
+        xio_write(cs.out_buf, str - cs.out_buf);
+    }
+    return (cs.out_buf);
+}
+
+/*
+ * _json_stream_token() - serialize "token": making room for it and room bytes after it
+ */
+
+static char *_json_stream_token(char *str, const char *token, uint16_t room)
+{
+    if ((str + TOKEN_LEN + 8 + room) > (cs.out_buf + sizeof(cs.out_buf))) {
+        str = _json_stream_flush(str);
+    }
+    *str++ = '"';
+    strcpy(str, token);
+    str += strlen(token);
+    *str++ = '"';
+    *str++ = ':';
+    return (str);
+}
+
+/*
+ * json_stream_groups() - serialize all config groups as one JSON response - see above
+ *
+ *  Returns STAT_COMPLETE, as the response has been sent.
+ */
+
+stat_t json_stream_groups()
+{
+    if ((js.json_verbosity == JV_SILENT) || (cs.responses_suppressed)) {
+        return (STAT_COMPLETE);
+    }
+    _json_ack_flush();
+    nvObj_t *nv = nv_reset_nv_list();               // just the one nvObj is used
+    char *str = cs.out_buf;
+    bool first_group = true;
+
+    strcpy(str, "{\"r\":{");
+    str += 6;
+    for (index_t g = 0; g < nv_index_max(); g++) {
+        if ((!nv_index_is_group(g)) || (cfgArray[g].get != get_grp)) {
+            continue;
+        }
+        if (!first_group) {
+            *str++ = ',';
+        }
+        first_group = false;
+        str = _json_stream_token(str, cfgArray[g].token, 1);
+        *str++ = '{';
+
+        bool first_child = true;
+        for (index_t i=0; nv_index_is_single(i); i++) {
+            if (strcmp(cfgArray[g].token, cfgArray[i].group) != 0) { continue; }
+            nvStr.wp = 0;                           // the strings are only needed one at a time
+            nv->index = i;
+            nv_get_nvObj(nv);
+            if (nv->valuetype == TYPE_EMPTY) { continue; }
+
+            if ((nv->valuetype == TYPE_STRING) || (nv->valuetype == TYPE_ARRAY)) {
+                if ((strlen(*nv->stringp) + 2) > JSON_STREAM_MARGIN) {
+                    nv->valuetype = TYPE_NULL;      // won't fit in the buffer - say so
+                }
+            }
+            if (!first_child) {
+                *str++ = ',';
+            }
+            first_child = false;
+            str = _json_stream_token(str, nv->token, JSON_STREAM_MARGIN);
+            str = json_serialize_value(nv, str);
+        }
+        *str++ = '}';
+    }
+    nv_reset_nv_list();
+
+    char footer_string[NV_FOOTER_LEN];
+    uint8_t length = _json_footer(footer_string, STAT_OK);
+    if ((str + length + 12) > (cs.out_buf + sizeof(cs.out_buf))) {
+        str = _json_stream_flush(str);
+    }
+    strcpy(str, "},\"f\":[");                      // close "r" and add the footer
+    str += 7;
+    strcpy(str, footer_string);
+    str += length;
+    strcpy(str, "]}\n");
+    str += 3;
+    _json_stream_flush(str);
+    return (STAT_COMPLETE);
+}
+
+/***********************************************************************************
+ * CONFIG BATCH TRANSACTIONS
+ *
+ *  A batch sets any number of config values as one transaction, over as many lines as it
+ *  takes - so a machine profile doesn't cost a round trip per value, and isn't limited
+ *  to what fits in one NV_BODY_LEN object:
+ *
+ *    {"batch":1}                     open the batch - responds as usual
+ *    {"xvm":1000,"yvm":1000}         config sets are staged. No response is sent
+ *    {"x":{"fr":800,"jm":100}}       ...groups can be used as usual
+ *    {"batch":2}                     commit - responds once, with {"batch":N} and a footer
+ *    {"batch":0}                     abort - discard the staged values
+ *
+ *  Only numeric and boolean sets can be staged. Anything else - a get, a string, Gcode,
+ *  or a line that doesn't parse - gets its error response and discards the batch.
+ *
+ *  The commit is applied by json_batch_callback() once the machine has stopped (CYCLE_OFF),
+ *  so the values don't change under moves that were queued before it. Commands after the
+ *  commit are held until it has been applied. The values are set in the order they were
+ *  staged; if one is rejected the ones already set are put back, and the response carries
+ *  the error status and the rejected pair. Persistence is done for all of them at the end,
+ *  only if all of them were accepted.
+ ***********************************************************************************/
+
+/*
+ * _json_batch_stage() - stage the sets in an nv list into the open batch
+ *
+ *  Returns STAT_COMPLETE so json_parser() sends no response, or an error.
+ */
+
+static stat_t _json_batch_stage(nvObj_t *nv)
+{
+    do {
+        if (nv->valuetype == TYPE_PARENT) {         // children have their own indexes
+            if (!nv_group_is_prefixed(nv->token)) {
+                return (STAT_UNSUPPORTED_TYPE);     // e.g. {"sr":{...}} - the parent does the work
+            }
+        } else {
+            if ((nv->valuetype != TYPE_FLOAT) && (nv->valuetype != TYPE_INT) && (nv->valuetype != TYPE_BOOL)) {
+                return (STAT_UNSUPPORTED_TYPE);     // gets, strings and Gcode can't be staged
+            }
+            if (js.batch.count >= JSON_BATCH_LEN) {
+                return (STAT_JSON_TOO_MANY_PAIRS);
+            }
+            js.batch.index[js.batch.count] = nv->index;
+            js.batch.value[js.batch.count] = nv->value;
+            js.batch.valuetype[js.batch.count] = nv->valuetype;
+            js.batch.count++;
+        }
+        if ((nv = nv->nx) == NULL) {
+            return (STAT_JSON_TOO_MANY_PAIRS);      // Not supposed to encounter a NULL
+        }
+    } while (nv->valuetype != TYPE_EMPTY);
+
+    return (STAT_COMPLETE);
+}
+
+/*
+ * _json_batch_set() - set staged value i, and if it's taken keep the value it replaced
+ */
+
+static stat_t _json_batch_set(nvObj_t *nv, uint16_t i)
+{
+    nv->index = js.batch.index[i];
+    nv_get_nvObj(nv);                               // token and group, and the value to put back
+    preprocess_float(nv);                           // ...in display units, as the setters take them
+    float value = nv->value;
+    valueType valuetype = nv->valuetype;
+
+    nv->value = js.batch.value[i];
+    nv->valuetype = js.batch.valuetype[i];
+    ritorno(nv_set(nv));
+    js.batch.value[i] = value;
+    js.batch.valuetype[i] = valuetype;
+    return (STAT_OK);
+}
+
+/*
+ * json_batch_callback() - apply a committed batch once motion has stopped
+ *
+ *  Returns STAT_EAGAIN while it waits, which holds off the command dispatchers.
+ */
+
+stat_t json_batch_callback()
+{
+    if (js.batch.state != BATCH_COMMIT) {
+        return (STAT_NOOP);
+    }
+    if (cm.cycle_state != CYCLE_OFF) {
+        return (STAT_EAGAIN);
+    }
+    js.batch.state = BATCH_ABORT;
+
+    nvObj_t *nv = nv_reset_nv_list();
+    nvObj_t *reject = nv->nx;                       // the pair that was rejected, if any
+    uint16_t applied = 0;
+    stat_t status = cm_is_alarmed();
+    bool alarmed = (status != STAT_OK);
+
+    if (!alarmed) {
+        for ( ; applied < js.batch.count; applied++) {
+            if ((status = _json_batch_set(reject, applied)) != STAT_OK) {
+                break;
+            }
+        }
+    }
+    if (status == STAT_OK) {
+        for (uint16_t i=0; i<applied; i++) {        // persist the values as they were set
+            nv_reset_nv(reject);
+            reject->index = js.batch.index[i];
+            nv_get(reject);
+            nv_persist(reject);
+        }
+        nv_reset_nv(reject);
+
+    } else {
+        nvObj_t rejected = *reject;
+        if (!alarmed) {                             // report the rejected value as it was sent
+            char tmp[TOKEN_LEN+1];
+            strcpy(tmp, rejected.group);            // flatten out groups
+            strcat(tmp, rejected.token);
+            strcpy(rejected.token, tmp);
+            rejected.group[0] = NUL;
+            rejected.value = js.batch.value[applied];
+            rejected.valuetype = js.batch.valuetype[applied];
+        } else {
+            rejected.valuetype = TYPE_EMPTY;        // alarmed - nothing was tried
+        }
+        while (applied) {                           // put back what was set, last first
+            _json_batch_set(reject, --applied);
+        }
+        *reject = rejected;
+    }
+    nv->index = js.batch.batch_index;
+    strcpy(nv->token, "batch");
+    nv->value = applied;
+    nv->valuetype = TYPE_INT;
+
+    js.batch.count = 0;
+    cs.linelen = js.batch.linelen;                  // the footer is for the commit line
+    nv_print_list(status, TEXT_NO_PRINT, JSON_RESPONSE_FORMAT);
+    sr_request_status_report(SR_REQUEST_TIMED);
+    return (STAT_OK);
+}
+
 /***********************************************************************************
  * CONFIGURATION AND INTERFACE FUNCTIONS
  * Functions to get and set variables from the cfgArray table
  ***********************************************************************************/
 
+/*
+ * json_get_batch() - get the number of values staged in the open batch
+ * json_set_batch() - open (1), commit (2) or abort (0) a config batch. See above
+ */
+
+stat_t json_get_batch(nvObj_t *nv)
+{
+    nv->value = js.batch.count;
+    nv->valuetype = TYPE_INT;
+    return (STAT_OK);
+}
+
+stat_t json_set_batch(nvObj_t *nv)
+{
+    if (js.json_mode == TEXT_MODE) {                // batches are staged by the JSON parser
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    switch ((jsonBatchCommand)nv->value) {
+        case BATCH_ABORT: {
+            js.batch.state = BATCH_ABORT;
+            js.batch.count = 0;
+            break;
+        }
+        case BATCH_BEGIN: {
+            js.batch.state = BATCH_BEGIN;
+            js.batch.batch_index = nv->index;
+            js.batch.count = 0;
+            break;
+        }
+        case BATCH_COMMIT: {
+            if (js.batch.state != BATCH_BEGIN) {
+                return (STAT_COMMAND_NOT_ACCEPTED);
+            }
+            js.batch.state = BATCH_COMMIT;
+            js.batch.linelen = cs.linelen;
+            return (STAT_COMPLETE);                 // json_batch_callback() sends the response
+        }
+        default: {
+            nv->valuetype = TYPE_NULL;
+            return (STAT_INPUT_VALUE_RANGE_ERROR);
+        }
+    }
+    return (STAT_OK);
+}
+
 /*
  * json_set_jv()
  */
@@ -644,6 +1139,41 @@ stat_t json_set_jv(nvObj_t *nv)
     return(STAT_OK);
 }
 
+/*
+ * json_set_jf() - set JSON footer style
+ */
+
+stat_t json_set_jf(nvObj_t *nv)
+{
+    if (nv->value < JF_LINE_LENGTH) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    if (nv->value >= JF_MAX_VALUE) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_EXCEEDS_MAX_VALUE);
+    }
+    js.json_footer_style = (jsonFooterStyle)nv->value;
+    return (STAT_OK);
+}
+
+/*
+ * json_set_ja() - set the number of Gcode lines acknowledged per response
+ */
+
+stat_t json_set_ja(nvObj_t *nv)
+{
+    if (nv->value < 0) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    if (nv->value > JSON_ACK_LINES_MAX) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_EXCEEDS_MAX_VALUE);
+    }
+    return (set_ui8(nv));
+}
+
 /*
  * json_set_ej() - set JSON communications mode
  */
@@ -654,14 +1184,20 @@ stat_t json_set_ej(nvObj_t *nv)
         nv->valuetype = TYPE_NULL;
         return (STAT_INPUT_LESS_THAN_MIN_VALUE);
     }
-    if (nv->value > AUTO_MODE) {
+    if (nv->value > CBOR_MODE) {
         nv->valuetype = TYPE_NULL;
         return (STAT_INPUT_EXCEEDS_MAX_VALUE);
     }
-    
-    // set json_mode to 0 or 1, but don't change it if comm_mode == 2
+    if (commMode(nv->value) == MARLIN_COMM_MODE) {  // marlin mode is entered by M-codes, not set
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_VALUE_RANGE_ERROR);
+    }
+
+    // set json_mode to 0 or 1, but don't change it if comm_mode == 2. CBOR is JSON mode
     if (commMode(nv->value) < AUTO_MODE) {
         js.json_mode = commMode(nv->value);
+    } else if (commMode(nv->value) == CBOR_MODE) {
+        js.json_mode = JSON_MODE;
     }
     return (set_ui8(nv));
 }
@@ -678,16 +1214,19 @@ stat_t json_set_ej(nvObj_t *nv)
  * js_print_jv()
  * js_print_js()
  * js_print_jf()
+ * js_print_ja()
  */
 
-static const char fmt_ej[] = "[ej]  enable json mode%13d [0=text,1=JSON,2=auto]\n";
+static const char fmt_ej[] = "[ej]  enable json mode%13d [0=text,1=JSON,2=auto,4=CBOR]\n";
 static const char fmt_jv[] = "[jv]  json verbosity%15d [0=silent,1=footer,2=messages,3=configs,4=linenum,5=verbose]\n";
 static const char fmt_js[] = "[js]  json serialize style%9d [0=relaxed,1=strict]\n";
-static const char fmt_jf[] = "[jf]  json footer style%12d [1=checksum,2=window report]\n";
+static const char fmt_jf[] = "[jf]  json footer style%12d [1=line length,2=window report]\n";
+static const char fmt_ja[] = "[ja]  json acknowledge lines%7d [0,1=every line,2-100=lines per response]\n";
 
 void js_print_ej(nvObj_t *nv) { text_print(nv, fmt_ej);}    // TYPE_INT
 void js_print_jv(nvObj_t *nv) { text_print(nv, fmt_jv);}    // TYPE_INT
 void js_print_js(nvObj_t *nv) { text_print(nv, fmt_js);}    // TYPE_INT
 void js_print_jf(nvObj_t *nv) { text_print(nv, fmt_jf);}    // TYPE_INT
+void js_print_ja(nvObj_t *nv) { text_print(nv, fmt_ja);}    // TYPE_INT
 
 #endif // __TEXT_MODE
@@ -61,11 +61,55 @@ typedef enum {                      // json output print modes
     JSON_RESPONSE_TO_MUTED_FORMAT   // print the header/body/footer as a response object, only to muted channels
 } jsonFormats;
 
+typedef enum {                      // json footer styles
+    JF_LINE_LENGTH = 1,             // [1] f:[1,status,bytes in the line]
+    JF_WINDOW_REPORT,               // [2] f:[2,status,bytes in the line,planner buffers free,RX bytes free]
+    JF_MAX_VALUE
+} jsonFooterStyle;
+
+#ifndef JSON_BATCH_LEN
+#define JSON_BATCH_LEN 100          // config values a {"batch":1} transaction can stage
+#endif
+
+#define JSON_ACK_LINES_MAX 100      // lines one {ja:} acknowledgement can cover
+#ifndef JSON_ACK_TIMEOUT_MS
+#define JSON_ACK_TIMEOUT_MS 20      // send a pending acknowledgement once its first line is this old
+#endif
+
+#define JSON_STREAM_MARGIN 64       // room kept for one value when streaming groups - see json_stream_groups()
+
+typedef enum {                      // config batch commands and states
+    BATCH_ABORT = 0,                // {"batch":0} discard the staged values (and the closed state)
+    BATCH_BEGIN,                    // {"batch":1} stage config sets from following lines until commit
+    BATCH_COMMIT                    // {"batch":2} apply the staged values once motion has stopped
+} jsonBatchCommand;
+
+typedef struct jsBatch {            // config values staged by a batch transaction
+    jsonBatchCommand state;         // BATCH_ABORT when no batch is open
+    index_t batch_index;            // index of the "batch" token, so its own lines aren't staged
+    uint16_t count;                 // values staged
+    uint16_t linelen;               // length of the commit line, for the footer of its response
+    index_t index[JSON_BATCH_LEN];
+    float value[JSON_BATCH_LEN];    // value to set - then the value it replaced, for rollback
+    valueType valuetype[JSON_BATCH_LEN];
+} jsBatch_t;
+
+typedef struct jsAck {              // Gcode lines waiting for one acknowledgement - see json_ack_line()
+    uint8_t lines;                  // lines taken since the last acknowledgement
+    uint8_t buffers;                // fewest planner buffers free after any of them
+    uint16_t bytes;                 // their bytes, for the footer
+    uint32_t first_linenum;         // N words of the first and last line, or 0
+    uint32_t last_linenum;
+    uint32_t first_tick;            // SysTick the first line was taken
+} jsAck_t;
+
 typedef struct jsSingleton {
 
     /*** config values (PUBLIC) ***/
     commMode json_mode;             // 0=text mode, 1=JSON mode (loaded from cs.comm_mode)
     jsonVerbosity json_verbosity;   // see enum in this file for settings
+    jsonFooterStyle json_footer_style; // see enum in this file for settings
+    uint8_t json_ack_lines;         // acknowledge this many Gcode lines per response (0 or 1 = every line)
     bool echo_json_footer;          // flags for JSON responses serialization
     bool echo_json_messages;
     bool echo_json_configs;
@@ -73,6 +117,8 @@ typedef struct jsSingleton {
     bool echo_json_gcode_block;
 
     /*** runtime values (PRIVATE) ***/
+    jsBatch_t batch;                // config batch transaction
+    jsAck_t ack;                    // line acknowledgement pending
 
 } jsSingleton_t;
 
@@ -83,13 +129,23 @@ extern jsSingleton_t js;
 /**** Function Prototypes ****/
 
 stat_t json_parser(char *str, bool suppress_response = false);
-void json_parse_for_exec(char *str, bool execute);
+stat_t json_parse_nv_list(nvObj_t *nv, uint8_t length, char *str);
+stat_t json_execute_nv_list(nvObj_t *nv);
 uint16_t json_serialize(nvObj_t *nv, char *out_buf, uint16_t size);
+char *json_serialize_value(nvObj_t *nv, char *str);
 void json_print_object(nvObj_t *nv);
 void json_print_response(uint8_t status, const bool only_to_muted = false);
 void json_print_list(stat_t status, uint8_t flags);
+stat_t json_stream_groups(void);
+
+stat_t json_batch_callback(void);
+stat_t json_ack_callback(void);
 
+stat_t json_get_batch(nvObj_t *nv);
+stat_t json_set_batch(nvObj_t *nv);
 stat_t json_set_jv(nvObj_t *nv);
+stat_t json_set_jf(nvObj_t *nv);
+stat_t json_set_ja(nvObj_t *nv);
 stat_t json_set_ej(nvObj_t *nv);
 
 #ifdef __TEXT_MODE
@@ -98,6 +154,7 @@ stat_t json_set_ej(nvObj_t *nv);
     void js_print_jv(nvObj_t *nv);
     void js_print_js(nvObj_t *nv);
     void js_print_jf(nvObj_t *nv);
+    void js_print_ja(nvObj_t *nv);
 
 #else
 
@@ -105,6 +162,7 @@ stat_t json_set_ej(nvObj_t *nv);
     #define js_print_jv tx_print_stub
     #define js_print_js tx_print_stub
     #define js_print_jf tx_print_stub
+    #define js_print_ja tx_print_stub
 
 #endif // __TEXT_MODE
 
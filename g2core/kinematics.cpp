@@ -30,9 +30,109 @@
 #include "canonical_machine.h"
 #include "stepper.h"
 #include "kinematics.h"
+#include "settings.h"
 #include "util.h"
 
+static void _kinematics_init(void);
 static void _inverse_kinematics(const float travel[], float joint[]);
+static void _forward_kinematics(const float joint[], float travel[]);
+
+/*
+ * Motor map cache
+ *
+ *  kn_inverse_kinematics() runs once per segment in the exec interrupt, so it does not search
+ *  the motor maps. kn_config_changed() flattens them to one entry per motor that is mapped
+ *  to an axis that is not inhibited. Motors left out keep whatever value they had in steps[].
+ *  A motor that mirrors an earlier one - same axis, same steps per unit, as the two sides of
+ *  a dual motor gantry are - copies its steps instead of converting the joint again.
+ *
+ *  kn_forward_kinematics() uses a second table that reads each joint from the motor(s) with
+ *  the best resolution on that axis. Motors that tie for best resolution are averaged.
+ */
+
+typedef struct knMotorMap {
+    uint8_t motor;                          // motor to set
+    uint8_t axis;                           // joint (axis) that drives it
+    int8_t mirror;                          // earlier entry with the same steps, or -1 (inverse map only)
+    float steps_per_unit;                   // copy of st_cfg.mot[motor].steps_per_unit
+} knMotorMap_t;
+
+static knMotorMap_t kn_map[MOTORS];         // inverse: joint to steps
+static uint8_t kn_map_count = 0;
+static knMotorMap_t kn_fwd[MOTORS];         // forward: steps to joint (steps_per_unit holds units per step / ties)
+static uint8_t kn_fwd_count = 0;
+
+#if HEIGHT_MAP_ENABLED == true
+knHeightMap_t kn_hmap;
+#endif
+
+/*
+ * kn_config_changed() - rebuild the motor map cache
+ *
+ *  Must be called whenever a motor map, steps per unit or axis mode changes. The setters
+ *  for ma, sa, tr, mi, su and am do this. Config can be written during motion, so the
+ *  tables are built aside and swapped in with interrupts off. The exec never sees a
+ *  count that doesn't match its entries.
+ */
+
+void kn_config_changed()
+{
+    knMotorMap_t map[MOTORS];
+    knMotorMap_t fwd[MOTORS];
+    float best_steps_per_unit[AXES];
+    uint8_t ties[AXES];
+
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        best_steps_per_unit[axis] = -1.0;
+        ties[axis] = 0;
+    }
+    uint8_t map_count = 0;
+    for (uint8_t motor = 0; motor < MOTORS; motor++) {
+        if (!KN_MOTOR_IS_MAPPED(motor)) {
+            continue;
+        }
+        uint8_t axis = KN_MOTOR_MAP(motor);
+        map[map_count].motor = motor;
+        map[map_count].axis = axis;
+        map[map_count].mirror = -1;
+        map[map_count].steps_per_unit = st_cfg.mot[motor].steps_per_unit;
+        for (uint8_t i = 0; i < map_count; i++) {
+            if ((map[i].mirror < 0) && (map[i].axis == axis) &&
+                (map[i].steps_per_unit == map[map_count].steps_per_unit)) {
+                map[map_count].mirror = i;  // exactly equal, so the copy is the same value
+                break;
+            }
+        }
+        map_count++;
+
+        if (fp_EQ(best_steps_per_unit[axis], st_cfg.mot[motor].steps_per_unit)) {
+            ties[axis]++;
+        } else if (best_steps_per_unit[axis] < st_cfg.mot[motor].steps_per_unit) {
+            best_steps_per_unit[axis] = st_cfg.mot[motor].steps_per_unit;
+            ties[axis] = 1;
+        }
+    }
+
+    uint8_t fwd_count = 0;
+    for (uint8_t i = 0; i < map_count; i++) {
+        uint8_t axis = map[i].axis;
+        if (fp_EQ(best_steps_per_unit[axis], map[i].steps_per_unit)) {
+            fwd[fwd_count].motor = map[i].motor;
+            fwd[fwd_count].axis = axis;
+            fwd[fwd_count].mirror = -1;
+            fwd[fwd_count].steps_per_unit = st_cfg.mot[map[i].motor].units_per_step / ties[axis];
+            fwd_count++;
+        }
+    }
+
+    __disable_irq();                        // kn_inverse_kinematics() runs in the exec interrupt
+    memcpy(kn_map, map, sizeof(knMotorMap_t) * map_count);
+    kn_map_count = map_count;
+    memcpy(kn_fwd, fwd, sizeof(knMotorMap_t) * fwd_count);
+    kn_fwd_count = fwd_count;
+    __enable_irq();
+    _kinematics_init();
+}
 
 /*
  * kn_kinematics() - wrapper routine for inverse kinematics
@@ -49,114 +149,321 @@ static void _inverse_kinematics(const float travel[], float joint[]);
 void kn_inverse_kinematics(const float travel[], float steps[]) {
     float joint[AXES];
 
-    _inverse_kinematics(travel, joint);  // insert inverse kinematics transformations here
-
-// We'll time-test each and see if unrolling is worth it.
-#if 0
-    // Map motors to axes and convert length units to steps
-    // Most of the conversion math has already been done in during config in steps_per_unit()
-    // which takes axis travel, step angle and microsteps into account.
-    for (uint8_t axis=0; axis<AXES; axis++) {
-        if (cm.a[axis].axis_mode == AXIS_INHIBITED) { joint[axis] = 0;}
-        if (st_cfg.mot[MOTOR_1].motor_map == axis) {
-            steps[MOTOR_1] = joint[axis] * st_cfg.mot[MOTOR_1].steps_per_unit;
-        }
-        if (st_cfg.mot[MOTOR_2].motor_map == axis) {
-            steps[MOTOR_2] = joint[axis] * st_cfg.mot[MOTOR_2].steps_per_unit;
-        }
-        if (st_cfg.mot[MOTOR_3].motor_map == axis) {
-            steps[MOTOR_3] = joint[axis] * st_cfg.mot[MOTOR_3].steps_per_unit;
-        }
-        if (st_cfg.mot[MOTOR_4].motor_map == axis) {
-            steps[MOTOR_4] = joint[axis] * st_cfg.mot[MOTOR_4].steps_per_unit;
-        }
-#if (MOTORS >= 5)
-        if (st_cfg.mot[MOTOR_5].motor_map == axis) {
-            steps[MOTOR_5] = joint[axis] * st_cfg.mot[MOTOR_5].steps_per_unit;
-        }
+#if HEIGHT_MAP_ENABLED == true
+    float mapped[AXES];
+    if (kn_hmap.enable) {                   // the map lifts Z to follow the surface
+        copy_vector(mapped, travel);
+        mapped[AXIS_Z] += kn_get_height(travel[AXIS_X], travel[AXIS_Y]);
+        travel = mapped;
+    }
 #endif
-#if (MOTORS >= 6)
-        if (st_cfg.mot[MOTOR_6].motor_map == axis) {
-            steps[MOTOR_6] = joint[axis] * st_cfg.mot[MOTOR_6].steps_per_unit;
+    _inverse_kinematics(travel, joint);  // see the KINEMATICS modules, below
+
+    // Map motors to axes and convert length units to steps. Inhibited axes are not in the map
+#if MACHINE_CONFIG_LOCKED == true
+    for (uint8_t motor = 0; motor < MOTORS; motor++) {      // unrolls to the mapped motors only
+        if (KN_MOTOR_IS_MAPPED(motor)) {
+            steps[motor] = joint[KN_MOTOR_MAP(motor)] * st_cfg.mot[motor].steps_per_unit;
         }
-#endif
     }
-
 #else
+    for (uint8_t i = 0; i < kn_map_count; i++) {
+        if (kn_map[i].mirror < 0) {
+            steps[kn_map[i].motor] = joint[kn_map[i].axis] * kn_map[i].steps_per_unit;
+        } else {
+            steps[kn_map[i].motor] = steps[kn_map[kn_map[i].mirror].motor];
+        }
+    }
+#endif
+}
+
+/*
+ * kn_forward_kinematics() - convert motor steps to axis positions
+ *
+ *  Joints are read from the best resolution motor(s) of each axis, then converted by the
+ *  forward transform of the selected KINEMATICS module. Axes with no motor, and inhibited
+ *  axes, read as 0 joint position.
+ */
+
+void kn_forward_kinematics(const float steps[], float travel[]) {
+    float joint[AXES];
 
     for (uint8_t axis = 0; axis < AXES; axis++) {
-        if (cm.a[axis].axis_mode == AXIS_INHIBITED) {
-            joint[axis] = 0;
-            continue;
-        }
-        for (uint8_t motor = 0; motor < MOTORS; motor++) {
-            if (st_cfg.mot[motor].motor_map == axis) {
-                steps[motor] = joint[axis] * st_cfg.mot[motor].steps_per_unit;
-            }
-        }
+        joint[axis] = 0.0;
+    }
+    for (uint8_t i = 0; i < kn_fwd_count; i++) {
+        joint[kn_fwd[i].axis] += steps[kn_fwd[i].motor] * kn_fwd[i].steps_per_unit;
+    }
+    _forward_kinematics(joint, travel);
+#if HEIGHT_MAP_ENABLED == true
+    if (kn_hmap.enable) {
+        travel[AXIS_Z] -= kn_get_height(travel[AXIS_X], travel[AXIS_Y]);
     }
 #endif
 }
 
+#if HEIGHT_MAP_ENABLED == true
 /*
- * _inverse_kinematics() - inverse kinematics - example is for a cartesian machine
+ * kn_set_height_map() - load a Z compensation grid
+ * kn_get_height()     - get the compensation at X,Y
+ *
+ *  z[] is columns x rows heights, row by row along X, spaced by step[] from origin[]. Heights
+ *  are taken relative to the first point, so the compensation is zero there. Each cell keeps
+ *  the coefficients of its bilinear patch in grid units,
  *
- *	You can glue in inverse kinematics here, but be aware of time budget constraints.
- *	This function is run during the _exec() portion of the cycle and will therefore
- *	be run once per interpolation segment. The total time for the segment load,
- *	including the inverse kinematics transformation cannot exceed the segment time,
- *	and ideally should be no more than 25-50% of the segment time. Currently segments
- *	run every 1.5 ms, but this might be lowered. To profile this time look at the
- *	time it takes to complete the mp_exec_move() function.
+ *      h = c0 + c1*s + (c2 + c3*s)*t       s, t = 0..1 across the cell in X and Y
+ *
+ *  so kn_get_height() costs two multiplies to find the cell and three multiply-adds. Beyond
+ *  the edges of the grid the edge heights are held. The map is loaded disabled.
+ *  Returns false if the grid is smaller than 2 x 2, too large, or has no spacing.
+ */
+
+bool kn_set_height_map(const float origin[], const float step[], uint8_t columns, uint8_t rows, const float z[])
+{
+    kn_hmap.enable = false;
+    kn_hmap.columns = 0;
+    if ((columns < 2) || (rows < 2) || ((columns - 1) * (rows - 1) > HEIGHT_MAP_CELLS_MAX) ||
+        fp_ZERO(step[0]) || fp_ZERO(step[1])) {
+        return (false);
+    }
+    for (uint8_t row = 0; row < rows - 1; row++) {
+        for (uint8_t column = 0; column < columns - 1; column++) {
+            const float *z0 = &z[row * columns + column];   // corner at the low s, t
+            const float *z1 = z0 + columns;                 // and the row above it
+            float *c = kn_hmap.cell[row * (columns - 1) + column];
+            c[0] = z0[0] - z[0];
+            c[1] = z0[1] - z0[0];
+            c[2] = z1[0] - z0[0];
+            c[3] = z1[1] - z1[0] - z0[1] + z0[0];
+        }
+    }
+    kn_hmap.origin[0] = origin[0];
+    kn_hmap.origin[1] = origin[1];
+    kn_hmap.inv_step[0] = 1 / step[0];
+    kn_hmap.inv_step[1] = 1 / step[1];
+    kn_hmap.rows = rows;
+    kn_hmap.columns = columns;
+    return (true);
+}
+
+float kn_get_height(const float x, const float y)
+{
+    float s = fminf(fmaxf((x - kn_hmap.origin[0]) * kn_hmap.inv_step[0], 0), kn_hmap.columns - 1);
+    float t = fminf(fmaxf((y - kn_hmap.origin[1]) * kn_hmap.inv_step[1], 0), kn_hmap.rows - 1);
+    uint8_t column = min((uint8_t)s, (uint8_t)(kn_hmap.columns - 2));
+    uint8_t row = min((uint8_t)t, (uint8_t)(kn_hmap.rows - 2));
+    const float *c = kn_hmap.cell[row * (kn_hmap.columns - 1) + column];
+    s -= column;
+    t -= row;
+    return (c[0] + c[1] * s + (c[2] + c[3] * s) * t);
+}
+#endif
+
+/****************************************************************************************
+ * KINEMATICS MODULES
+ *
+ *  Exactly one module is compiled, selected by KINEMATICS in the machine's settings file.
+ *  Each provides:
+ *
+ *    _kinematics_init()     - precompute constants. Called from kn_config_changed()
+ *    _inverse_kinematics()  - axis positions (travel) to joint positions
+ *    _forward_kinematics()  - joint positions to axis positions
+ *
+ *  Joints use the axis slots: joint[AXIS_X] is whatever the motor(s) mapped to X drive.
+ *  Axes a module does not transform are passed through.
+ *
+ *  Be aware of time budget constraints. _inverse_kinematics() is run during the _exec()
+ *  portion of the cycle and will therefore be run once per interpolation segment. The total
+ *  time for the segment load, including the inverse kinematics transformation cannot exceed
+ *  the segment time, and ideally should be no more than 25-50% of the segment time. Segments
+ *  run every 0.75 to 3 ms. To profile this time look at the time it takes to complete the
+ *  mp_exec_move() function (PROF_EXEC). Keep these to a handful of multiplies, a sqrt if you
+ *  must, and no pow() - everything that depends only on settings goes in _kinematics_init().
+ *
+ *  The planner limits velocity, acceleration and jerk per axis, not per joint. On the non-
+ *  Cartesian modules set those limits conservatively enough for the joints to follow.
+ */
+
+#if (KINEMATICS == KINE_CARTESIAN)
+
+/*
+ * Cartesian - joints are axes
  *
  *	Note: the compiler will  inline trivial functions (like memcpy) so there is no
  *	size or performance penalty for breaking this out
  */
+static void _kinematics_init() {}
+
 static void _inverse_kinematics(const float travel[], float joint[]) {
     memcpy(joint, travel, sizeof(float) * AXES);  // just do a memcpy for Cartesian machines
+}
 
-    //	for (uint8_t i=0; i<AXES; i++) {
-    //		joint[i] = travel[i];
-    //	}
+static void _forward_kinematics(const float joint[], float travel[]) {
+    memcpy(travel, joint, sizeof(float) * AXES);
 }
 
+#elif (KINEMATICS == KINE_COREXY)
+
 /*
- * kn_forward_kinematics() - forward kinematics for a cartesian machine
+ * CoreXY - two belts, each driven by one motor, move the XY carriage together
  *
- * This is designed for PRECISION, not PERFORMANCE!
+ *  Map the A belt motor to X and the B belt motor to Y.
  *
- * This function is NOT to be used where high-speed is important. If that becomes the case,
- * there are many opportunities for caching and optimization for performance here.
+ *    joint[X] = x + y              x = (joint[X] + joint[Y]) / 2
+ *    joint[Y] = x - y              y = (joint[X] - joint[Y]) / 2
  *
+ *  A belt motor moves 2 units of belt per unit of diagonal travel, so set the X and Y motors'
+ *  travel per revolution for belt travel, as for a Cartesian belt axis.
  */
+static void _kinematics_init() {}
 
-void kn_forward_kinematics(const float steps[], float travel[]) {
-    float best_steps_per_unit[AXES];
+static void _inverse_kinematics(const float travel[], float joint[]) {
+    memcpy(joint, travel, sizeof(float) * AXES);
+    joint[AXIS_X] = travel[AXIS_X] + travel[AXIS_Y];
+    joint[AXIS_Y] = travel[AXIS_X] - travel[AXIS_Y];
+}
 
-    // Setup
-    for (uint8_t axis = 0; axis < AXES; axis++) {
-        travel[axis]              = 0.0;
-        best_steps_per_unit[axis] = -1.0;
+static void _forward_kinematics(const float joint[], float travel[]) {
+    memcpy(travel, joint, sizeof(float) * AXES);
+    travel[AXIS_X] = (joint[AXIS_X] + joint[AXIS_Y]) * 0.5;
+    travel[AXIS_Y] = (joint[AXIS_X] - joint[AXIS_Y]) * 0.5;
+}
+
+#elif (KINEMATICS == KINE_LINEAR_DELTA)
+
+/*
+ * Linear delta - three vertical towers with carriages, each linked to the effector by a
+ *  parallelogram arm of DELTA_ARM_LENGTH
+ *
+ *  Map the tower A (front left), B (front right) and C (back) motors to X, Y and Z. Joint
+ *  positions are carriage heights, measured to the same zero as Z when the effector is at
+ *  the center of the bed. DELTA_RADIUS is the horizontal distance from the center to a
+ *  carriage pivot, less the distance from the nozzle to an effector pivot.
+ *
+ *    joint[tower] = z + sqrt(L^2 - (x - tower_x)^2 - (y - tower_y)^2) - sqrt(L^2 - R^2)
+ *
+ *  If a target is out of reach the radicand is clamped at zero - the arm is horizontal. Soft
+ *  limits should keep the tool inside the reachable envelope.
+ *
+ *  The forward transform is trilateration of the three carriage positions, choosing the
+ *  solution below the carriages.
+ */
+
+#define DELTA_TOWERS 3
+
+static struct knDelta {
+    float tower_x[DELTA_TOWERS];            // tower positions in the XY plane
+    float tower_y[DELTA_TOWERS];
+    float arm_squared;                      // L^2
+    float home_height;                      // sqrt(L^2 - R^2) - carriage height above the effector at center
+} kd;
+
+static void _kinematics_init() {
+    static const float angle[DELTA_TOWERS] = { 210.0, 330.0, 90.0 };  // degrees, counterclockwise from +X
+    for (uint8_t t = 0; t < DELTA_TOWERS; t++) {
+        kd.tower_x[t] = DELTA_RADIUS * cos(angle[t] / RADIAN);
+        kd.tower_y[t] = DELTA_RADIUS * sin(angle[t] / RADIAN);
     }
+    kd.arm_squared = square(DELTA_ARM_LENGTH);
+    kd.home_height = sqrt(kd.arm_squared - square(DELTA_RADIUS));
+}
 
-    // Scan through each axis, and then through each motor
-    for (uint8_t axis = 0; axis < AXES; axis++) {
-        if (cm.a[axis].axis_mode == AXIS_INHIBITED) {
-            travel[axis] = 0.0;
-            continue;
-        }
-        for (uint8_t motor = 0; motor < MOTORS; motor++) {
-            if (st_cfg.mot[motor].motor_map == axis) {
-                // If this motor has a better (or the only) resolution, then we use this motor's value
-                if (best_steps_per_unit[axis] < st_cfg.mot[motor].steps_per_unit) {
-                    best_steps_per_unit[axis] = st_cfg.mot[motor].steps_per_unit;
-                    travel[axis]              = steps[motor] * st_cfg.mot[motor].units_per_step;
-
-                    // If a econd motor has the same reolution for the same axis, we'll average their values
-                } else if (fp_EQ(best_steps_per_unit[axis], st_cfg.mot[motor].steps_per_unit)) {
-                    travel[axis] = (travel[axis] + (steps[motor] * st_cfg.mot[motor].units_per_step)) / 2.0;
-                }
-            }
-        }
+static void _inverse_kinematics(const float travel[], float joint[]) {
+    memcpy(joint, travel, sizeof(float) * AXES);
+    for (uint8_t t = 0; t < DELTA_TOWERS; t++) {
+        float dx = travel[AXIS_X] - kd.tower_x[t];
+        float dy = travel[AXIS_Y] - kd.tower_y[t];
+        float radicand = max(kd.arm_squared - dx*dx - dy*dy, 0.0f);
+        joint[AXIS_X + t] = travel[AXIS_Z] + sqrtf(radicand) - kd.home_height;
     }
 }
+
+static void _forward_kinematics(const float joint[], float travel[]) {
+    memcpy(travel, joint, sizeof(float) * AXES);
+
+    // carriage pivot points, relative to tower A
+    float p1z = joint[AXIS_X] + kd.home_height;
+    float bx = kd.tower_x[1] - kd.tower_x[0], by = kd.tower_y[1] - kd.tower_y[0], bz = joint[AXIS_Y] + kd.home_height - p1z;
+    float cx = kd.tower_x[2] - kd.tower_x[0], cy = kd.tower_y[2] - kd.tower_y[0], cz = joint[AXIS_Z] + kd.home_height - p1z;
+
+    // orthonormal frame: ex along A->B, ey in the plane of the three pivots, ez = ex x ey
+    float d = sqrtf(bx*bx + by*by + bz*bz);
+    float exx = bx/d, exy = by/d, exz = bz/d;
+    float i = exx*cx + exy*cy + exz*cz;
+    float eyx = cx - i*exx, eyy = cy - i*exy, eyz = cz - i*exz;
+    float j = sqrtf(eyx*eyx + eyy*eyy + eyz*eyz);
+    eyx /= j; eyy /= j; eyz /= j;
+    float ezx = exy*eyz - exz*eyy, ezy = exz*eyx - exx*eyz, ezz = exx*eyy - exy*eyx;
+
+    // equal arm lengths simplify the sphere intersection
+    float x = d * 0.5;
+    float y = (i*i + j*j - 2*i*x) / (2*j);
+    float z = sqrtf(max(kd.arm_squared - x*x - y*y, 0.0f));
+
+    if (ezz > 0) { z = -z; }                // take the solution below the carriages
+    travel[AXIS_X] = kd.tower_x[0] + x*exx + y*eyx + z*ezx;
+    travel[AXIS_Y] = kd.tower_y[0] + x*exy + y*eyy + z*ezy;
+    travel[AXIS_Z] = p1z          + x*exz + y*eyz + z*ezz;
+}
+
+#elif (KINEMATICS == KINE_TRUNNION_AC)
+
+/*
+ * A/C trunnion table - the part sits on a C rotary table, carried by an A tilting cradle
+ *
+ *  Gcode XYZ are in the part frame: where the tool would be with A and C at zero. The C axis
+ *  is vertical through the A axis line, which runs parallel to X through the pivot point
+ *  (0, TRUNNION_PIVOT_Y, TRUNNION_PIVOT_Z) in machine coordinates. Positive rotations are
+ *  right-handed about +X and +Z. The joint XYZ are the linear axis positions that put the
+ *  tool on the rotated part point - the tool center point is held on the programmed path.
+ *
+ *    q = Rx(A) Rz(C) (p - pivot) + pivot
+ *
+ *  sin and cos are computed once per segment per angle. A and C are passed through.
+ */
+
+static struct knTrunnion {
+    float pivot_y;
+    float pivot_z;
+    float radians_per_degree;
+} kt;
+
+static void _kinematics_init() {
+    kt.pivot_y = TRUNNION_PIVOT_Y;
+    kt.pivot_z = TRUNNION_PIVOT_Z;
+    kt.radians_per_degree = (float)(M_PI / 180.0);
+}
+
+static void _inverse_kinematics(const float travel[], float joint[]) {
+    memcpy(joint, travel, sizeof(float) * AXES);
+    float sa = sinf(travel[AXIS_A] * kt.radians_per_degree), ca = cosf(travel[AXIS_A] * kt.radians_per_degree);
+    float sc = sinf(travel[AXIS_C] * kt.radians_per_degree), cc = cosf(travel[AXIS_C] * kt.radians_per_degree);
+
+    float x = travel[AXIS_X];
+    float y = travel[AXIS_Y] - kt.pivot_y;
+    float z = travel[AXIS_Z] - kt.pivot_z;
+    float xc = x*cc - y*sc;                 // rotate about Z by C
+    float yc = x*sc + y*cc;
+    joint[AXIS_X] = xc;                     // then about X by A
+    joint[AXIS_Y] = yc*ca - z*sa + kt.pivot_y;
+    joint[AXIS_Z] = yc*sa + z*ca + kt.pivot_z;
+}
+
+static void _forward_kinematics(const float joint[], float travel[]) {
+    memcpy(travel, joint, sizeof(float) * AXES);
+    float sa = sinf(joint[AXIS_A] * kt.radians_per_degree), ca = cosf(joint[AXIS_A] * kt.radians_per_degree);
+    float sc = sinf(joint[AXIS_C] * kt.radians_per_degree), cc = cosf(joint[AXIS_C] * kt.radians_per_degree);
+
+    float x = joint[AXIS_X];
+    float y = joint[AXIS_Y] - kt.pivot_y;
+    float z = joint[AXIS_Z] - kt.pivot_z;
+    float ya =  y*ca + z*sa;                // undo A
+    float za = -y*sa + z*ca;
+    travel[AXIS_X] =  x*cc + ya*sc;         // then undo C
+    travel[AXIS_Y] = -x*sc + ya*cc + kt.pivot_y;
+    travel[AXIS_Z] = za + kt.pivot_z;
+}
+
+#else
+#error "KINEMATICS must be KINE_CARTESIAN, KINE_COREXY, KINE_LINEAR_DELTA or KINE_TRUNNION_AC"
+#endif // KINEMATICS
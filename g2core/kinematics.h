@@ -28,11 +28,88 @@
 #ifndef KINEMATICS_H_ONCE
 #define KINEMATICS_H_ONCE
 
+/*
+ * Kinematics modules - select one with KINEMATICS in the settings file (see kinematics.cpp)
+ */
+
+#define KINE_CARTESIAN      0               // joints are axes (default)
+#define KINE_COREXY         1               // X/Y motors drive the A/B belts of a CoreXY gantry
+#define KINE_LINEAR_DELTA   2               // X/Y/Z motors drive the carriages of a linear delta
+#define KINE_TRUNNION_AC    3               // A tilt / C rotary trunnion table with tool center point control
+
+/*
+ * Locked machine configuration
+ *
+ *  With MACHINE_CONFIG_LOCKED the motor maps (Mn_MOTOR_MAP) and axis modes (n_AXIS_MODE) of
+ *  the settings file are compile time tables, and {ma:} and {am:} only accept the values
+ *  already there. Per-block and per-segment loops read the map and modes through the macros
+ *  below, so with the tables constant the compiler folds them down to the motors and axes
+ *  actually in use. Otherwise the macros read the runtime config. Include after
+ *  canonical_machine.h and stepper.h.
+ */
+
+#if MACHINE_CONFIG_LOCKED == true
+static constexpr uint8_t kn_locked_motor_map[MOTORS] = {
+    M1_MOTOR_MAP
+#if (MOTORS >= 2)
+    , M2_MOTOR_MAP
+#endif
+#if (MOTORS >= 3)
+    , M3_MOTOR_MAP
+#endif
+#if (MOTORS >= 4)
+    , M4_MOTOR_MAP
+#endif
+#if (MOTORS >= 5)
+    , M5_MOTOR_MAP
+#endif
+#if (MOTORS >= 6)
+    , M6_MOTOR_MAP
+#endif
+};
+
+static constexpr uint8_t kn_locked_axis_mode[AXES] = {
+    X_AXIS_MODE, Y_AXIS_MODE, Z_AXIS_MODE, A_AXIS_MODE, B_AXIS_MODE, C_AXIS_MODE
+};
+
+#define KN_MOTOR_MAP(motor) (kn_locked_motor_map[motor])
+#define KN_AXIS_MODE(axis)  (kn_locked_axis_mode[axis])
+#else
+#define KN_MOTOR_MAP(motor) (st_cfg.mot[motor].motor_map)
+#define KN_AXIS_MODE(axis)  (cm.a[axis].axis_mode)
+#endif
+
+// true if the motor is driven by the kinematics - mapped to an axis that isn't inhibited
+#define KN_MOTOR_IS_MAPPED(motor) \
+    ((KN_MOTOR_MAP(motor) < AXES) && (KN_AXIS_MODE(KN_MOTOR_MAP(motor)) != AXIS_INHIBITED))
+
 /*
  * Global Scope Functions
  */
 
+#ifndef HEIGHT_MAP_CELLS_MAX
+#define HEIGHT_MAP_CELLS_MAX 361            // a 20 x 20 point grid. 16 bytes each
+#endif
+
+#if HEIGHT_MAP_ENABLED == true
+typedef struct knHeightMap {                // Z compensation grid - see kn_set_height_map()
+    uint8_t enable;                         // 1 = apply the map. Only change with cm_set_hmpe()
+    uint8_t columns;                        // grid points along X, or 0 if no map is loaded
+    uint8_t rows;                           // grid points along Y
+    float origin[2];                        // X and Y of the first grid point
+    float inv_step[2];                      // 1 / grid spacing in X and Y
+    float cell[HEIGHT_MAP_CELLS_MAX][4];    // bilinear coefficients of each cell
+} knHeightMap_t;
+
+extern knHeightMap_t kn_hmap;
+#endif
+
+void kn_config_changed(void);
 void kn_inverse_kinematics(const float travel[], float steps[]);
 void kn_forward_kinematics(const float steps[], float travel[]);
+#if HEIGHT_MAP_ENABLED == true
+bool kn_set_height_map(const float origin[], const float step[], uint8_t columns, uint8_t rows, const float z[]);
+float kn_get_height(const float x, const float y);
+#endif
 
 #endif  // End of include Guard: KINEMATICS_H_ONCE
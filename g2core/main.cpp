@@ -23,6 +23,7 @@
 #include "g2core.h"  // #1 There are some dependencies
 #include "config.h"  // #2
 #include "hardware.h"
+#include "timebase.h"
 #include "persistence.h"
 #include "controller.h"
 #include "canonical_machine.h"
@@ -31,7 +32,13 @@
 #include "planner.h"
 #include "stepper.h"
 #include "encoder.h"
+#include "telemetry.h"
+#include "motion_link.h"
+#include "checkpoint.h"
+#include "trace.h"
+#include "profile.h"
 #include "spindle.h"
+#include "spindle_vfd.h"
 #include "temperature.h"
 #include "gpio.h"
 #include "pwm.h"
@@ -89,11 +96,18 @@ extern OutputPin<kDebug3_PinNumber> debug_pin3;
  *
  * There are a lot of dependencies in the order of these inits.
  * Don't change the ordering unless you understand this.
+ *
+ * Nothing here waits for a host. USB enumerates in the background, and xio calls
+ * controller_set_connected() when it's done, which is what sends the ready banner
+ * (_controller_state()). So motion and the UART, spool and flash file channels are
+ * ready as soon as the inits return - after a reset or a brown-out the machine doesn't
+ * sit out the enumeration before it can take motion.
  */
 
 void application_init_services(void)
 {
     hardware_init();				// system hardware setup 			- must be first
+    timebase_init();                // microsecond timebase - before anything stamps a time
     persistence_init();				// set up EEPROM or other NVM		- must be second
     xio_init();						// xtended io subsystem				- must be third
 }
@@ -103,7 +117,14 @@ void application_init_machine(void)
     cm.machine_state = MACHINE_INITIALIZING;
 
     stepper_init();                 // stepper subsystem
-    encoder_init();                 // virtual encoders
+    encoder_init();                 // virtual and hardware encoders
+    telemetry_init();               // runtime samples for the host
+    motion_link_init();             // segment sync with other boards
+    checkpoint_init();              // motion checkpoint saved before the reset
+    trace_init();                   // planner trace
+#ifdef __PROFILE
+    profile_init();                 // interrupt profiling
+#endif
     gpio_init();                    // inputs and outputs
     pwm_init();                     // pulse width modulation drivers
     planner_init();                 // motion planning subsystem
@@ -118,6 +139,7 @@ void application_init_startup(void)
     canonical_machine_reset();
     spindle_init();                 // should be after PWM and canonical machine inits and config_init()
     spindle_reset();
+    spindle_vfd_init();             // after config_init(), for {spvm:}
     temperature_init();
     gpio_reset();
 }
@@ -139,9 +161,7 @@ void setup(void)
 {
     // application setup
     application_init_services();
-    while (SysTickTimer_getValue() < 400);  // delay 400 ms for USB to come up
-
-    application_init_machine();
+    application_init_machine();     // no wait for USB - see the notes on the inits
     application_init_startup();
 }
 
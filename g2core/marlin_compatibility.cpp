@@ -30,6 +30,7 @@
 #include "xio.h"                // for char definitions
 #include "temperature.h"        // for temperature controls
 #include "json_parser.h"
+#include "text_parser.h"
 #include "planner.h"
 #include "stepper.h"            // for MOTOR_TIMEOUT_SECONDS_MIN/MOTOR_TIMEOUT_SECONDS_MAX
 #include "MotateTimers.h"       // for char definitions
@@ -97,6 +98,34 @@ nvObj_t *_get_specific_nv(const char *key) {
     return nv;
 }
 
+/***********************************************************************************
+ * _put_fixed() - tiny fixed point formatter for the polled reports
+ *
+ *  Hosts poll M105 and M114 several times a second while printing. Temperatures,
+ *  outputs and positions all fit an int32 once scaled, so this writes them directly
+ *  instead of going through floattoa(). Always writes all the decimals, as Marlin does.
+ */
+static void _put_fixed(char *(&str), float value, const uint8_t decimals)
+{
+    static const uint32_t scale[] = { 1, 10, 100, 1000 };
+
+    if (value < 0) {
+        *str++ = '-';
+        value = -value;
+    }
+    uint32_t fixed = (uint32_t)(value * scale[decimals] + 0.5);
+    uint32_t fraction = fixed % scale[decimals];
+    str += inttoa(str, fixed / scale[decimals]);
+    if (decimals > 0) {
+        *str++ = '.';
+        for (uint8_t i = decimals; i > 0; i--) {
+            str[i-1] = '0' + (fraction % 10);
+            fraction /= 10;
+        }
+        str += decimals;
+    }
+}
+
 /***********************************************************************************
  * _report_temperatures() - convenience function called from marlin_response() and marlin_callback()
  */
@@ -105,20 +134,20 @@ void _report_temperatures(char *(&str)) {
     uint8_t tool = cm.gm.tool;
 
     str_concat(str, " T:");
-    str += floattoa(str, cm_get_temperature(tool), 2);
+    _put_fixed(str, cm_get_temperature_sample(tool), 2);
     str_concat(str, " /");
-    str += floattoa(str, cm_get_set_temperature(tool), 2);
+    _put_fixed(str, cm_get_set_temperature(tool), 2);
 
     str_concat(str, " B:");
-    str += floattoa(str, cm_get_temperature(3), 2);
+    _put_fixed(str, cm_get_temperature_sample(3), 2);
     str_concat(str, " /");
-    str += floattoa(str, cm_get_set_temperature(3), 2);
+    _put_fixed(str, cm_get_set_temperature(3), 2);
 
     str_concat(str, " @:");
-    str += floattoa(str, cm_get_heater_output(tool), 0);
+    _put_fixed(str, cm_get_heater_output(tool), 0);
 
     str_concat(str, " B@:");
-    str += floattoa(str, cm_get_heater_output(3), 0);
+    _put_fixed(str, cm_get_heater_output(3), 0);
 }
 
 /***********************************************************************************
@@ -126,16 +155,16 @@ void _report_temperatures(char *(&str)) {
  */
 void _report_position(char *(&str)) {
     str_concat(str, " X:");
-    str += floattoa(str, cm_get_work_position(ACTIVE_MODEL, 0), 2);
+    _put_fixed(str, cm_get_work_position(ACTIVE_MODEL, AXIS_X), 2);
     str_concat(str, " Y:");
-    str += floattoa(str, cm_get_work_position(ACTIVE_MODEL, 1), 2);
+    _put_fixed(str, cm_get_work_position(ACTIVE_MODEL, AXIS_Y), 2);
     str_concat(str, " Z:");
-    str += floattoa(str, cm_get_work_position(ACTIVE_MODEL, 2), 2);
+    _put_fixed(str, cm_get_work_position(ACTIVE_MODEL, AXIS_Z), 2);
 
     uint8_t tool = cm.gm.tool;
     if ((tool > 0) && (tool < 3)) {
         str_concat(str, " E:");
-        str += floattoa(str, cm_get_work_position(ACTIVE_MODEL, 2), tool + 2); // A or B, depending on tool
+        _put_fixed(str, cm_get_work_position(ACTIVE_MODEL, tool + 2), 2); // A or B, depending on tool
     }
 }
 
@@ -253,6 +282,7 @@ stat_t marlin_set_motor_timeout(float s) // M18 Sxxx, M84 Sxxx, M85 Sxxx
  * _queue_next_temperature_comands() - returns true if it finished
  * _marlin_start_temperature_updates()
  * _marlin_end_temperature_updates()
+ * _marlin_set_temperature() - runtime half of the set, vect[0] is the heater, vect[1] the temperature
  */
 
 void _marlin_start_temperature_updates(float* vect, bool* flag) {
@@ -264,6 +294,10 @@ void _marlin_end_temperature_updates(float* vect, bool* flag) {
     temperature_updates_requested = false;
 }
 
+void _marlin_set_temperature(float* vect, bool* flag) {
+    cm_set_set_temperature((uint8_t)vect[0], vect[1]);
+}
+
 bool _queue_next_temperature_commands()
 {
     if (MarlinSetTempState::Idle != set_temp_state) {
@@ -271,18 +305,14 @@ bool _queue_next_temperature_commands()
             return false;
         }
 
-        char buffer[128];
-        char *str = buffer;
-
         if ((MarlinSetTempState::SettingTemperature == set_temp_state) ||
             (MarlinSetTempState::SettingTemperatureNoWait == set_temp_state))
         {
-            str_concat(str, "{he");
-            str += inttoa(str, next_temperature_tool);
-            str_concat(str, "st:");
-            str += floattoa(str, next_temperature, 2);
-            str_concat(str, "}");
-            cm_json_command(buffer);
+            // Queued commands and waits don't use JSON command buffers, which would fill the
+            // planner after a couple of M109s and stop the host loading moves during heat-up
+            float value[] = { (float)next_temperature_tool, next_temperature, 0,0,0,0 };
+            bool flags[]  = { 1,1,0,0,0,0 };
+            mp_queue_command(_marlin_set_temperature, value, flags);
 
             if (MarlinSetTempState::SettingTemperatureNoWait == set_temp_state) {
                 set_temp_state = MarlinSetTempState::Idle;
@@ -305,11 +335,7 @@ bool _queue_next_temperature_commands()
         }
 
         if (MarlinSetTempState::StartingWait == set_temp_state) {
-            str = buffer;
-            str_concat(str, "{he");
-            str += inttoa(str, next_temperature_tool);
-            str_concat(str, "at:t}");
-            cm_json_wait(buffer);
+            mp_temperature_wait(next_temperature_tool);
 
             set_temp_state = MarlinSetTempState::StoppingUpdates;
             if (mp_planner_is_full()) {
@@ -388,6 +414,28 @@ stat_t marlin_request_position_report() // M114
     return STAT_OK;
 }
 
+/***********************************************************************************
+ * marlin_set_pressure_advance() - M900 Kxxx called from gcode parser
+ *
+ *  Sent as {pa:} through cm_json_command() so it takes effect in step with the moves.
+ */
+
+stat_t marlin_set_pressure_advance(const float k)
+{
+    if (k < 0) {
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    char buffer[32];
+    char *str = buffer;
+
+    str_concat(str, "{pa:");
+    str += floattoa(str, k, 4);
+    str_concat(str, "}");
+
+    cm_json_command(buffer);
+    return (STAT_OK);
+}
+
 /***********************************************************************************
  * marlin_report_version() - M115
  */
@@ -600,4 +648,16 @@ bool marlin_handle_fake_stk500(char *str)
 }
 
 
+/***********************************************************************************
+ * TEXT MODE SUPPORT
+ ***********************************************************************************/
+
+#ifdef __TEXT_MODE
+
+static const char fmt_pa[] = "[pa]  pressure advance%17.4f seconds\n";
+void marlin_print_pa(nvObj_t *nv) { text_print(nv, fmt_pa);}     // TYPE_FLOAT
+
+#endif // __TEXT_MODE
+
+
 #endif // MARLIN_COMPAT_ENABLED == true
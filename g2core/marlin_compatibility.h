@@ -33,6 +33,7 @@ enum cmExtruderMode {
 typedef struct MarlinStateExtended {    // Canonical machine extensions for Marlin
     bool marlin_flavor;                 // true if we are parsing gcode as Marlin-flavor
     cmExtruderMode extruder_mode;       // Mode of the extruder - changes how "E" is interpreted
+    float pressure_advance;             // K - extruder lead per extruder velocity, in seconds {pa:}
 } MarlinStateExtended_t;
 
 extern MarlinStateExtended_t mst;       // Marlin state object
@@ -57,6 +58,7 @@ stat_t marlin_set_fan_speed(const uint8_t fan, float speed);    // M106, M107
 
 stat_t marlin_request_position_report();                        // M114
 stat_t marlin_report_version();                                 // M115
+stat_t marlin_set_pressure_advance(const float k);              // M900 Kxxx
 
 // *** Marlin internal functions ***
 
@@ -64,5 +66,11 @@ stat_t marlin_callback();                                       // controller lo
 void marlin_response(const stat_t status, char *buf);           // response handler (primarily just prints "ok")
 bool marlin_handle_fake_stk500(char *str);                      // fake stk500v2
 
+#ifdef __TEXT_MODE
+    void marlin_print_pa(nvObj_t *nv);
+#else
+    #define marlin_print_pa tx_print_stub
+#endif
+
 
 #endif  // End of include guard: MARLIN_COMPAT_H_ONCE
@@ -0,0 +1,297 @@
+/*
+ * motion_link.cpp - segment synchronous motion across a leader board and follower boards
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "g2core.h"
+#include "config.h"
+#include "canonical_machine.h"
+#include "binary_parser.h"
+#include "kinematics.h"
+#include "motion_link.h"
+#include "stepper.h"
+#include "text_parser.h"
+#include "util.h"
+
+#include <atomic>           // atomic_signal_fence() orders the ring between the link interrupt and exec
+
+/**** Allocate Structures ****/
+
+mlnSingleton_t mln;
+
+#define MOTION_LINK_RING_MASK (MOTION_LINK_RING_SIZE-1)
+
+static void _lost_sync(void);
+static void _send_frame(const uint8_t type, const float position[], const float segment_time);
+
+/************************************************************************************
+ **** CODE **************************************************************************
+ ************************************************************************************/
+
+/*
+ * motion_link_init() - initialize the link. {mlnm:} is applied from config_init() later
+ */
+
+void motion_link_init()
+{
+    memset(&mln, 0, sizeof(mln));
+}
+
+/*
+ * _lost_sync() - note a sync error. The alarm is raised from mln_callback()
+ */
+
+static void _lost_sync()
+{
+    mln.errors++;
+    mln.lost = true;
+}
+
+/*
+ * mln_send_segment() - leader: send a segment to the followers - called at exec interrupt level
+ *
+ *  start and target are the joint space inputs to kn_inverse_kinematics() for the start and
+ *  end of the segment. Call before the segment is prepped. If nothing is running or prepped
+ *  the loader would start the segment at once, so prep the lead dwell first and send the
+ *  position the followers are to step from.
+ */
+
+void mln_send_segment(const float start[], const float target[], const float segment_time)
+{
+    if (mln.mode != MOTION_LINK_LEADER) {
+        return;
+    }
+    if (st_prep_lead(MOTION_LINK_LEAD_USEC)) {
+        _send_frame(MOTION_LINK_POSITION, start, 0);
+    }
+    _send_frame(MOTION_LINK_SEGMENT, target, segment_time);
+}
+
+static void _send_frame(const uint8_t type, const float position[], const float segment_time)
+{
+    uint8_t data[MOTION_LINK_FRAME_LEN];
+
+    data[0] = (uint8_t)mln.seq;
+    data[1] = (uint8_t)(mln.seq >> 8);
+    data[2] = type;
+    memcpy(data + 3, &segment_time, 4);                 // little-endian, as the binary records
+    memcpy(data + 7, position, 4*AXES);
+    uint16_t crc = binary_crc16(data, MOTION_LINK_FRAME_LEN - 2);
+    data[MOTION_LINK_FRAME_LEN - 2] = (uint8_t)crc;
+    data[MOTION_LINK_FRAME_LEN - 1] = (uint8_t)(crc >> 8);
+    mln.seq++;
+
+#if (MOTION_LINK_ENABLED == 1)
+    if (!mln_board_write(data, MOTION_LINK_FRAME_LEN)) {
+        _lost_sync();                                   // the link is backed up - the followers will miss it
+        return;
+    }
+    mln.frames++;
+#endif
+}
+
+/*
+ * mln_clock() - leader: signal the start of a line segment - called by the loader
+ */
+
+void mln_clock()
+{
+#if (MOTION_LINK_ENABLED == 1)
+    if (mln.mode == MOTION_LINK_LEADER) {
+        mln_board_clock();
+    }
+#endif
+}
+
+/*
+ * mln_receive()    - follower: take a frame from the link - called from the board's link interrupt
+ * mln_clock_edge() - follower: the leader started a segment - called from the board's clock interrupt
+ * mln_take_clock() - true if the loader may start a line segment
+ *
+ *  A follower loads a line segment when the leader does, which may be before it has been
+ *  prepped - the clock waits for it. Two clocks waiting means the follower is a whole
+ *  segment behind.
+ */
+
+void mln_receive(const uint8_t *data, const uint8_t length)
+{
+    if (mln.mode != MOTION_LINK_FOLLOWER) {
+        return;
+    }
+    if ((length != MOTION_LINK_FRAME_LEN) ||
+        (binary_crc16(data, length - 2) != (data[length-2] | (data[length-1] << 8)))) {
+        _lost_sync();
+        return;
+    }
+    uint16_t seq = data[0] | (data[1] << 8);
+    if (seq != mln.seq) {
+        _lost_sync();                                   // a frame went missing
+    }
+    mln.seq = seq + 1;
+
+    uint8_t head = mln.head;
+    if ((uint8_t)(head - mln.tail) >= MOTION_LINK_RING_SIZE) {
+        _lost_sync();                                   // the leader is further ahead than the ring
+        return;
+    }
+    mlnFrame_t *f = &mln.ring[head & MOTION_LINK_RING_MASK];
+    f->type = data[2];
+    memcpy(&f->time, data + 3, 4);
+    memcpy(f->position, data + 7, 4*AXES);
+    std::atomic_signal_fence(std::memory_order_release);   // frame contents before the index
+    mln.head = head + 1;
+    st_request_exec_move();
+}
+
+void mln_clock_edge()
+{
+    if (mln.mode != MOTION_LINK_FOLLOWER) {
+        return;
+    }
+    if (++mln.clocks > 1) {
+        _lost_sync();
+    }
+    st_request_load_move();
+}
+
+bool mln_take_clock()
+{
+    if (mln.mode != MOTION_LINK_FOLLOWER) {
+        return (true);
+    }
+    if (mln.clocks == 0) {
+        return (false);                                 // wait for the leader
+    }
+    mln.clocks--;
+    return (true);
+}
+
+/*
+ * mln_exec() - follower: prep the next segment the leader sent - called in place of mp_exec_move()
+ *
+ *  Returns STAT_NOOP if there is nothing to prep, as mp_exec_move(). Steps are not corrected
+ *  for following error, as there is no runtime position on a follower to correct against.
+ */
+
+stat_t mln_exec()
+{
+    static float no_error[MOTORS];                      // zeros
+
+    while (mln.tail != mln.head) {
+        std::atomic_signal_fence(std::memory_order_acquire);    // index before the frame contents
+        mlnFrame_t *f = &mln.ring[mln.tail & MOTION_LINK_RING_MASK];
+
+        if (f->type != MOTION_LINK_SEGMENT) {           // position: the next segment starts here
+            kn_inverse_kinematics(f->position, mln.position_steps);
+            std::atomic_signal_fence(std::memory_order_release);
+            mln.tail++;
+            mln.frames++;
+            continue;
+        }
+        float target_steps[MOTORS];
+        float travel_steps[MOTORS];
+        copy_vector(target_steps, mln.position_steps);  // unmapped motors stay put
+        kn_inverse_kinematics(f->position, target_steps);
+        for (uint8_t m=0; m<MOTORS; m++) {
+            travel_steps[m] = target_steps[m] - mln.position_steps[m];
+            mln.position_steps[m] = target_steps[m];
+        }
+        float segment_time = f->time;
+        std::atomic_signal_fence(std::memory_order_release);    // done with the frame before the index
+        mln.tail++;
+        mln.frames++;
+        return (st_prep_line(travel_steps, no_error, segment_time));
+    }
+    st_prep_null();
+    return (STAT_NOOP);
+}
+
+/*
+ * mln_callback() - alarm if sync was lost
+ */
+
+stat_t mln_callback()
+{
+    if (!mln.lost) {
+        return (STAT_NOOP);
+    }
+    mln.lost = false;
+    return (cm_alarm(STAT_MOTION_LINK_LOST, "motion link"));
+}
+
+/***********************************************************************************
+ * CONFIGURATION AND INTERFACE FUNCTIONS
+ * Functions to get and set variables from the cfgArray table
+ ***********************************************************************************/
+
+/*
+ * mln_set_mlnm() - set the mode. Any set clears the counters, the sequence and the ring
+ */
+
+stat_t mln_set_mlnm(nvObj_t *nv)
+{
+    if (nv->value < MOTION_LINK_OFF) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    if (nv->value >= MOTION_LINK_MODE_MAX) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_EXCEEDS_MAX_VALUE);
+    }
+    if (((MOTION_LINK_ENABLED == 0) && (nv->value != MOTION_LINK_OFF)) ||
+        (cm.motion_state != MOTION_STOP) || st_runtime_isbusy()) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_COMMAND_NOT_ACCEPTED);             // no link on this board, or changing mid-move
+    }
+    mln.mode = MOTION_LINK_OFF;                         // stop the link while clearing
+    mln.frames = 0;
+    mln.errors = 0;
+    mln.lost = false;
+    mln.seq = 0;
+    mln.clocks = 0;
+    mln.tail = mln.head;
+    for (uint8_t m=0; m<MOTORS; m++) {
+        mln.position_steps[m] = 0;
+    }
+    mln.mode = (uint8_t)nv->value;
+    return (STAT_OK);
+}
+
+/***********************************************************************************
+ * TEXT MODE SUPPORT
+ * Functions to print variables from the cfgArray table
+ ***********************************************************************************/
+
+#ifdef __TEXT_MODE
+
+static const char fmt_mlnm[] = "[mlnm] motion link mode%12d [0=off,1=leader,2=follower]\n";
+static const char fmt_mlnn[] = "[mlnn] motion link frames%10lu\n";
+static const char fmt_mlne[] = "[mlne] motion link sync errors%5lu\n";
+
+void mln_print_mlnm(nvObj_t *nv) { text_print(nv, fmt_mlnm);}
+void mln_print_mlnn(nvObj_t *nv) { text_print(nv, fmt_mlnn);}
+void mln_print_mlne(nvObj_t *nv) { text_print(nv, fmt_mlne);}
+
+#endif // __TEXT_MODE
@@ -0,0 +1,145 @@
+/*
+ * motion_link.h - segment synchronous motion across a leader board and follower boards
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* A machine with more motors than one board has runs one board as the leader and the
+ *  others as followers. Only the leader plans. As its exec preps each segment it sends the
+ *  segment to the followers over a dedicated link, and as its loader starts each segment
+ *  it toggles a shared segment clock line. A follower preps the segments it is sent with
+ *  its own motor map and runs each one when the clock says the leader has started it, so
+ *  every board starts every segment together and a slow or fast crystal is caught up at
+ *  the next segment rather than drifting.
+ *
+ *  A segment carries the joint space target the leader gives kn_inverse_kinematics() -
+ *  after input shaping - and the segment time, not steps. Each follower converts it with
+ *  its own motor to axis map and steps per unit, so the leader needs no configuration for
+ *  the motors it doesn't drive, and a motor on a follower can be slaved to any axis. Both
+ *  boards compute dda_ticks from the same float, so they play out the same segment.
+ *
+ *  The leader's loader starts the first segment of a move from rest as soon as it is
+ *  prepped, so then the leader first preps a dwell of MOTION_LINK_LEAD_USEC to give the
+ *  frame time to arrive (see st_prep_lead()), and sends its position before the segment
+ *  so the followers step from where it is. After that the exec runs segments ahead.
+ *
+ *  Frames (all multi-byte values little-endian):
+ *
+ *      seq         uint16  frame sequence number - increments by one per frame
+ *      type        uint8   MOTION_LINK_POSITION or MOTION_LINK_SEGMENT
+ *      time        float   segment time in minutes (0 for a position)
+ *      position    float   one per axis - the position, or the segment target
+ *      crc         uint16  CRC-16/CCITT of all bytes before it, as binary frames
+ *
+ *  A follower that sees a bad CRC or a gap in the sequence, or falls a whole segment
+ *  behind the clock, has lost sync and alarms - as does a leader that can't send a frame.
+ *  {mlnm:} sets the mode, {mlnn:} counts frames sent or taken and {mlne:} sync errors.
+ *
+ *  The link and the clock line are board resources. A board that has them sets
+ *  MOTION_LINK_ENABLED and provides mln_board_write() and mln_board_clock(), and calls
+ *  mln_receive() for each frame read from the link and mln_clock_edge() for each clock
+ *  edge, both at or above the priority of the DDA interrupt. A follower only runs what
+ *  it is sent - its own planner queue is not run - and its inputs are not homed.
+ */
+#ifndef MOTION_LINK_H_ONCE
+#define MOTION_LINK_H_ONCE
+
+/**** Configs, Definitions and Structures ****/
+
+#ifndef MOTION_LINK_ENABLED
+#define MOTION_LINK_ENABLED     0       // 1 = the board provides the link and the clock line
+#endif
+#ifndef MOTION_LINK_RING_SIZE
+#define MOTION_LINK_RING_SIZE   16      // frames a follower holds for its exec. Must be 2^N
+#endif
+#define MOTION_LINK_LEAD_USEC   1000    // dwell before the first segment of a move from rest
+#define MOTION_LINK_FRAME_LEN   (2 + 1 + 4 + 4*AXES + 2)
+
+typedef enum {                          // {mlnm:}
+    MOTION_LINK_OFF = 0,
+    MOTION_LINK_LEADER,                 // plan, send segments and drive the clock
+    MOTION_LINK_FOLLOWER,               // run the segments the leader sends, on its clock
+    MOTION_LINK_MODE_MAX
+} mlnMode;
+
+typedef enum {                          // frame types
+    MOTION_LINK_POSITION = 0,           // the leader's position - the next segment starts from here
+    MOTION_LINK_SEGMENT                 // a segment ending at position
+} mlnFrameType;
+
+typedef struct mlnFrame {               // one frame, as held by a follower
+    uint8_t type;
+    float time;                         // minutes
+    float position[AXES];
+} mlnFrame_t;
+
+typedef struct mlnSingleton {
+    uint8_t mode;                       // see mlnMode {mlnm:}
+    uint32_t frames;                    // frames sent (leader) or taken (follower) {mlnn:}
+    uint32_t errors;                    // sync errors {mlne:}
+    volatile bool lost;                 // sync was lost - alarm from mln_callback()
+    uint16_t seq;                       // sequence number of the next frame sent or expected
+
+    // follower
+    volatile uint8_t clocks;            // clock edges the loader has not taken yet
+    volatile uint8_t head;              // next frame to write - written by mln_receive() only
+    volatile uint8_t tail;              // next frame to prep - written by mln_exec() only
+    mlnFrame_t ring[MOTION_LINK_RING_SIZE];
+    float position_steps[MOTORS];       // steps at the end of the last segment prepped
+} mlnSingleton_t;
+
+extern mlnSingleton_t mln;
+
+/**** Function Prototypes ****/
+
+void motion_link_init(void);
+void mln_send_segment(const float start[], const float target[], const float segment_time);
+void mln_clock(void);
+bool mln_take_clock(void);
+void mln_receive(const uint8_t *data, const uint8_t length);
+void mln_clock_edge(void);
+stat_t mln_exec(void);
+stat_t mln_callback(void);
+
+#if (MOTION_LINK_ENABLED == 1)
+bool mln_board_write(const uint8_t *data, const uint8_t length);    // provided by the board
+void mln_board_clock(void);                                         // provided by the board
+#endif
+
+stat_t mln_set_mlnm(nvObj_t *nv);
+
+#ifdef __TEXT_MODE
+
+    void mln_print_mlnm(nvObj_t *nv);
+    void mln_print_mlnn(nvObj_t *nv);
+    void mln_print_mlne(nvObj_t *nv);
+
+#else
+
+    #define mln_print_mlnm tx_print_stub
+    #define mln_print_mlnn tx_print_stub
+    #define mln_print_mlne tx_print_stub
+
+#endif // __TEXT_MODE
+
+#endif // End of include guard: MOTION_LINK_H_ONCE
@@ -28,7 +28,6 @@
 #include "persistence.h"
 #include "canonical_machine.h"
 #include "report.h"
-//#include "util.h"
 
 /***********************************************************************************
  **** STRUCTURE ALLOCATIONS ********************************************************
@@ -40,39 +39,634 @@ nvmSingleton_t nvm;
  **** GENERIC STATIC FUNCTIONS AND VARIABLES ***************************************
  ***********************************************************************************/
 
+#if NVM_LOG_PAGES > 0
+
+static_assert(NVM_LOG_PAGES >= 3, "the persistence log needs at least 3 pages");
+static_assert((NVM_PAGE_SIZE % sizeof(nvmRecord_t)) == 0, "NVM_PAGE_SIZE must be a multiple of the record size");
+static_assert(NVM_SHADOW_LEN < NVM_RECORD_EMPTY, "NVM_SHADOW_LEN must be less than NVM_RECORD_EMPTY");
+
+static nvmRecord_t nvm_read_buf[NVM_RECORDS_PER_PAGE+1];    // page read by init and reclaim
+
+static void _next_page(void);
+
+static uint32_t _value_bits(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits);
+}
+
+static uint16_t _record_check(uint16_t index, float value)
+{
+    uint32_t bits = _value_bits(value);
+    return (~index ^ (uint16_t)bits ^ (uint16_t)(bits >> 16));
+}
+
+static bool _record_is_valid(const nvmRecord_t *r)
+{
+    return ((r->index < NVM_SHADOW_LEN) && (r->check == _record_check(r->index, r->value)));
+}
+
+static bool _is_stored(uint16_t index)
+{
+    return (nvm.stored[index >> 5] & (1UL << (index & 31)));
+}
+
+static bool _shadow_matches(uint16_t index, float value)
+{
+    return (_is_stored(index) && (_value_bits(nvm.shadow[index]) == _value_bits(value)));
+}
+
+static void _store(uint16_t index, float value)
+{
+    nvm.shadow[index] = value;
+    nvm.stored[index >> 5] |= (1UL << (index & 31));
+}
+
+/*
+ * _program_head() - program the head page image if it has records not yet in flash
+ *
+ *  Unused slots in the image are 0xFF so programming the page again only adds records.
+ */
+
+static void _program_head()
+{
+    if (nvm.programmed == nvm.records) {
+        return;
+    }
+    if (!nvm_flash_program(nvm.base + nvm.head, &nvm.page)) {
+        rpt_exception(STAT_PERSISTENCE_ERROR, "persistence page program failed");
+    }
+    nvm.programmed = nvm.records;
+}
+
+/*
+ * _append() - add a record to the head page image, moving to the next page if it's full
+ *
+ *  Reclaiming may fill the new head with live records, so this can take more than one
+ *  page. If it goes all the way around the log there is too little room for the values.
+ */
+
+static void _append(uint16_t index, float value)
+{
+    uint8_t pages = 0;
+    while (nvm.records == NVM_RECORDS_PER_PAGE) {
+        if (++pages > NVM_LOG_PAGES) {
+            rpt_exception(STAT_PERSISTENCE_ERROR, "persistence log is full");
+            return;
+        }
+        _program_head();
+        _next_page();
+    }
+    nvmRecord_t *r = &nvm.page.record[++nvm.records];   // record[0] is the header
+    r->index = index;
+    r->value = value;
+    r->check = _record_check(index, value);
+    nvm.last_write_tick = SysTickTimer.getValue();
+}
+
+/*
+ * _reclaim_tail() - copy the live records of the oldest page to the head and erase it
+ *
+ *  A record is live if the shadow still holds its value. Only called with a fresh head so
+ *  a whole page of live records fits. The copies are programmed before the erase.
+ */
+
+static void _reclaim_tail()
+{
+    uint16_t page = nvm.tail;
+    nvm.tail = (nvm.tail + 1) % NVM_LOG_PAGES;
+
+    nvm_flash_read(nvm.base + page, nvm_read_buf);
+    for (uint16_t i=1; i <= NVM_RECORDS_PER_PAGE; i++) {
+        nvmRecord_t *r = &nvm_read_buf[i];
+        if (!_record_is_valid(r)) {
+            break;
+        }
+        if (_shadow_matches(r->index, r->value)) {
+            _append(r->index, r->value);
+        }
+    }
+    _program_head();
+    if (!nvm_flash_erase(nvm.base + page)) {
+        rpt_exception(STAT_PERSISTENCE_ERROR, "persistence page erase failed");
+    }
+    nvm.free_pages++;
+}
+
+/*
+ * _next_page() - take the erased page after the head as the new head
+ *
+ *  The page is programmed with its header along with its first records. Taking the
+ *  last erased page reclaims the oldest one so there is always one to move to.
+ */
+
+static void _next_page()
+{
+    nvm.head = (nvm.head + 1) % NVM_LOG_PAGES;
+    nvm.free_pages--;
+    memset(&nvm.page, 0xFF, sizeof(nvm.page));
+    nvm.page.header.sequence = ++nvm.sequence;
+    nvm.page.header.magic = NVM_MAGIC;
+    nvm.records = 0;
+    nvm.programmed = 0;
+    if (nvm.free_pages == 0) {
+        _reclaim_tail();
+    }
+}
+
+/*
+ * _replay_page() - load the records of a page read into nvm_read_buf into the shadow
+ *
+ *  Returns the number of records. Sets *torn if the page ends in a record that doesn't
+ *  check rather than in an erased slot.
+ */
+
+static uint16_t _replay_page(bool *torn)
+{
+    uint16_t i;
+    *torn = false;
+    for (i=1; i <= NVM_RECORDS_PER_PAGE; i++) {
+        nvmRecord_t *r = &nvm_read_buf[i];
+        if (!_record_is_valid(r)) {
+            const uint8_t *b = (const uint8_t *)r;
+            for (uint8_t j=0; j < sizeof(nvmRecord_t); j++) {
+                if (b[j] != 0xFF) { *torn = true; }
+            }
+            break;
+        }
+        _store(r->index, r->value);
+    }
+    return (i-1);
+}
+
+#if NVM_SNAPSHOT_PAGES > 0
+#define NVM_SNAPSHOT_PAGE   (nvm.base + NVM_LOG_PAGES)      // first snapshot page of the profile
+
+/*
+ * _snapshot_page() - page p of a snapshot stream: the header, then the data
+ *
+ *  Fills nvm_read_buf with the part of the stream that lands in page p
+ */
+
+static void _snapshot_page(uint8_t p, const nvmSnapshotHeader_t *header, const uint8_t *data)
+{
+    uint8_t *buf = (uint8_t *)nvm_read_buf;
+    memset(buf, 0xFF, NVM_PAGE_SIZE);
+    for (uint16_t j=0; j < NVM_PAGE_SIZE; j++) {
+        uint32_t k = ((uint32_t)p * NVM_PAGE_SIZE) + j;     // position in the stream
+        if (k < sizeof(nvmSnapshotHeader_t)) {
+            buf[j] = ((const uint8_t *)header)[k];
+        } else if ((k -= sizeof(nvmSnapshotHeader_t)) < header->length) {
+            buf[j] = data[k];
+        }
+    }
+}
+#endif
+
+/*
+ * _checkpoint_slot_size() - bytes per checkpoint slot: header and data, word aligned
+ * _checkpoint_check() - check of a checkpoint. The length is folded in so a slot written
+ *                       by a build with another checkpoint layout doesn't check
+ * _checkpoint_scan() - find the latest checkpoint, copy it out and set up the slot after it
+ *
+ *  With no checkpoint the next slot is set past the end of the last page, so the first
+ *  write erases and takes page 0. Returns false if there is no checkpoint.
+ */
+
+#if NVM_CHECKPOINT_PAGES > 0
+static_assert(NVM_CHECKPOINT_PAGES >= 2, "checkpoints need 2 pages - one holds the latest while the other is erased");
+
+static uint16_t _checkpoint_slot_size(uint16_t length)
+{
+    return ((sizeof(nvmCheckpointHeader_t) + length + 3) & ~3);
+}
+
+static uint32_t _checkpoint_check(uint32_t sequence, const void *data, uint16_t length)
+{
+    uint32_t hash = persistence_hash(2166136261 ^ length, &sequence, sizeof(sequence));
+    return (persistence_hash(hash, data, length));
+}
+
+static bool _checkpoint_scan(void *data, uint16_t length)
+{
+    uint16_t size = _checkpoint_slot_size(length);
+    uint16_t slots = NVM_PAGE_SIZE / size;
+    bool found = false;
+
+    nvm.checkpoint_length = length;
+    nvm.checkpoint_sequence = 0;
+    nvm.checkpoint_page = NVM_CHECKPOINT_PAGES-1;
+    nvm.checkpoint_slot = slots;
+    for (uint16_t p=0; p < NVM_CHECKPOINT_PAGES; p++) {
+        nvm_flash_read(NVM_CHECKPOINT_PAGE + p, nvm_read_buf);
+        for (uint16_t s=0; s < slots; s++) {
+            const uint8_t *slot = (const uint8_t *)nvm_read_buf + (s * size);
+            nvmCheckpointHeader_t header;
+            memcpy(&header, slot, sizeof(header));
+            if ((header.sequence == 0xFFFFFFFF) || (header.sequence <= nvm.checkpoint_sequence) ||
+                (header.check != _checkpoint_check(header.sequence, slot + sizeof(header), length))) {
+                continue;
+            }
+            found = true;
+            nvm.checkpoint_sequence = header.sequence;
+            nvm.checkpoint_page = p;
+            nvm.checkpoint_slot = s+1;
+            if (data != NULL) {
+                memcpy(data, slot + sizeof(header), length);
+            }
+        }
+    }
+    return (found);
+}
+#endif
+
+static bool _page_is_erased()
+{
+    const uint8_t *b = (const uint8_t *)nvm_read_buf;
+    for (uint16_t j=0; j < NVM_PAGE_SIZE; j++) {
+        if (b[j] != 0xFF) { return (false); }
+    }
+    return (true);
+}
+
+/*
+ * _load_log() - find the log of the active profile and replay it into the shadow
+ *
+ *  The pages holding the log run from the tail (lowest sequence) to the head (highest).
+ *  Pages without a header are erased if they need it so they can be taken later.
+ *  With no log the head is set up as a full page before page 0 so the first write
+ *  starts the log there.
+ */
+
+static void _load_log()
+{
+    memset(nvm.stored, 0, sizeof(nvm.stored));
+    uint16_t used = 0;
+    uint32_t lowest = 0xFFFFFFFF;
+
+    nvm.sequence = 0;
+    for (uint16_t p=0; p < NVM_LOG_PAGES; p++) {
+        nvm_flash_read(nvm.base + p, nvm_read_buf);
+        nvmPageHeader_t *header = (nvmPageHeader_t *)&nvm_read_buf[0];
+        if (header->magic == NVM_MAGIC) {
+            used++;
+            if (header->sequence < lowest) {
+                lowest = header->sequence;
+                nvm.tail = p;
+            }
+            if (header->sequence >= nvm.sequence) {
+                nvm.sequence = header->sequence;
+                nvm.head = p;
+            }
+        } else if (!_page_is_erased()) {
+            nvm_flash_erase(nvm.base + p);
+        }
+    }
+    nvm.free_pages = NVM_LOG_PAGES - used;
+    nvm.records = NVM_RECORDS_PER_PAGE;                 // empty log - first write takes page 0
+    nvm.programmed = NVM_RECORDS_PER_PAGE;
+    if (used == 0) {
+        nvm.head = NVM_LOG_PAGES-1;
+        nvm.tail = 0;
+        return;
+    }
+    bool torn = false;
+    for (uint16_t p = nvm.tail; ; p = (p + 1) % NVM_LOG_PAGES) {
+        nvm_flash_read(nvm.base + p, nvm_read_buf);
+        if (((nvmPageHeader_t *)&nvm_read_buf[0])->magic == NVM_MAGIC) {
+            nvm.records = _replay_page(&torn);
+        }
+        if (p == nvm.head) {
+            break;
+        }
+    }
+    memcpy(&nvm.page, nvm_read_buf, sizeof(nvm.page));  // carry on filling the head page
+    if (torn) {
+        nvm.records = NVM_RECORDS_PER_PAGE;             // can't program over a torn record
+    }
+    nvm.programmed = nvm.records;
+}
+
+/*
+ * _read_selector() - return the profile last selected, 0 if none
+ * _write_selector() - record the selected profile
+ *
+ *  The selector page is a list of profile numbers. The last one programmed is active.
+ *  A full page is erased and starts again.
+ */
+
+#if NVM_PROFILES > 1
+static uint8_t _read_selector()
+{
+    uint32_t *slot = (uint32_t *)nvm_read_buf;
+    nvm_flash_read(NVM_SELECT_PAGE, nvm_read_buf);
+    for (nvm.select_slot = 0; nvm.select_slot < NVM_SELECT_SLOTS; nvm.select_slot++) {
+        if (slot[nvm.select_slot] == 0xFFFFFFFF) {
+            break;
+        }
+    }
+    if ((nvm.select_slot == 0) || (slot[nvm.select_slot-1] >= NVM_PROFILES)) {
+        return (0);
+    }
+    return (slot[nvm.select_slot-1]);
+}
+
+static bool _write_selector(uint8_t profile)
+{
+    uint32_t *slot = (uint32_t *)nvm_read_buf;
+    if (nvm.select_slot == NVM_SELECT_SLOTS) {
+        if (!nvm_flash_erase(NVM_SELECT_PAGE)) {
+            return (false);
+        }
+        nvm.select_slot = 0;
+    }
+    memset(nvm_read_buf, 0xFF, NVM_PAGE_SIZE);
+    slot[nvm.select_slot++] = profile;
+    return (nvm_flash_program(NVM_SELECT_PAGE, nvm_read_buf));
+}
+#endif
+
+#endif // NVM_LOG_PAGES > 0
 
 /***********************************************************************************
  **** CODE *************************************************************************
  ***********************************************************************************/
 
+/*
+ * persistence_init() - select the last profile used and load its log into the shadow
+ */
+
 void persistence_init()
 {
-	return;
+#if NVM_LOG_PAGES > 0
+#if NVM_PROFILES > 1
+    nvm.profile = _read_selector();
+#endif
+    nvm.base = nvm.profile * NVM_PROFILE_PAGES;
+    _load_log();
+#endif
+}
+
+/*
+ * persistence_get_profile() - return the active profile
+ * persistence_select_profile() - make another profile active and load its log
+ *
+ *  Anything written to the running profile is programmed first. The caller applies the
+ *  new values - see set_profile().
+ */
+
+uint8_t persistence_get_profile()
+{
+#if NVM_LOG_PAGES > 0
+    return (nvm.profile);
+#else
+    return (0);
+#endif
+}
+
+stat_t persistence_select_profile(uint8_t profile)
+{
+#if (NVM_LOG_PAGES > 0) && (NVM_PROFILES > 1)
+    if (profile >= NVM_PROFILES) {
+        return (STAT_INPUT_VALUE_RANGE_ERROR);
+    }
+    _program_head();
+    if (!_write_selector(profile)) {
+        return (rpt_exception(STAT_PERSISTENCE_ERROR, "persistence profile select failed"));
+    }
+    nvm.profile = profile;
+    nvm.base = profile * NVM_PROFILE_PAGES;
+    _load_log();
+    return (STAT_OK);
+#else
+    return ((profile == 0) ? STAT_OK : STAT_INPUT_VALUE_RANGE_ERROR);
+#endif
+}
+
+/*
+ * persistence_hold() - drop writes while set, so restoring the profile doesn't rewrite it
+ */
+
+void persistence_hold(bool hold)
+{
+    nvm.hold = hold;
 }
 
 /*
- * read_persistent_value()	- return value (as float) by index
+ * read_persistent_value() - return value (as float) by index from the shadow
  *
- *	It's the responsibility of the caller to make sure the index does not exceed range
+ *  Returns STAT_NOOP and leaves nv->value alone if the value has never been stored.
+ *  It's the responsibility of the caller to make sure the index does not exceed range
  */
 
 stat_t read_persistent_value(nvObj_t *nv)
 {
-	nv->value = 0;
-	return (STAT_OK);
+#if NVM_LOG_PAGES > 0
+    if ((nv->index < NVM_SHADOW_LEN) && _is_stored(nv->index)) {
+        nv->value = nvm.shadow[nv->index];
+        return (STAT_OK);
+    }
+#endif
+    return (STAT_NOOP);
 }
 
 /*
  * write_persistent_value() - write to NVM by index, but only if the value has changed
  *
- *	It's the responsibility of the caller to make sure the index does not exceed range
- *	Note: Removed NAN and INF checks on floats - not needed
+ *  Updates the shadow and appends a record to the head page image. Flash is programmed
+ *  later by persistence_callback() unless the image fills.
+ *  It's the responsibility of the caller to make sure the index does not exceed range
+ *  Note: Removed NAN and INF checks on floats - not needed
  */
 
 stat_t write_persistent_value(nvObj_t *nv)
 {
-//    if (cm.cycle_state != CYCLE_OFF) { // can't write when machine is moving
-//        return(rpt_exception(STAT_FILE_NOT_OPEN, "write_persistent_value() can't write when machine is in cycle"));
-//    }
-	return (STAT_OK);
+#if NVM_LOG_PAGES > 0
+    if (nvm.hold) {
+        return (STAT_OK);
+    }
+    if (nv->index >= NVM_SHADOW_LEN) {
+        return (STAT_INTERNAL_RANGE_ERROR);
+    }
+    if (_shadow_matches(nv->index, nv->value)) {
+        return (STAT_OK);
+    }
+    _store(nv->index, nv->value);
+    _append(nv->index, nv->value);
+#endif
+    return (STAT_OK);
+}
+
+/*
+ * persistence_callback() - program the head page once writes stop and no cycle is running
+ */
+
+stat_t persistence_callback()
+{
+#if NVM_LOG_PAGES > 0
+    if ((nvm.programmed == nvm.records) || (cm.cycle_state != CYCLE_OFF) ||
+        ((SysTickTimer.getValue() - nvm.last_write_tick) < NVM_FLUSH_MS)) {
+        return (STAT_NOOP);
+    }
+    _program_head();
+    return (STAT_OK);
+#else
+    return (STAT_NOOP);
+#endif
+}
+
+/*
+ * persistence_hash() - FNV-1a over a block, starting from hash (use 2166136261 to start)
+ */
+
+uint32_t persistence_hash(uint32_t hash, const void *data, uint16_t length)
+{
+    const uint8_t *b = (const uint8_t *)data;
+    while (length--) {
+        hash = (hash ^ *b++) * 16777619;
+    }
+    return (hash);
+}
+
+/*
+ * persistence_read_snapshot() - copy out the snapshot if it was taken from this profile
+ *
+ *  Returns false, leaving data alone, if there is no snapshot, it's from another profile
+ *  or its length or check don't match.
+ */
+
+bool persistence_read_snapshot(uint32_t hash, void *data, uint16_t length)
+{
+#if (NVM_LOG_PAGES > 0) && (NVM_SNAPSHOT_PAGES > 0)
+    static_assert(sizeof(nvmSnapshotHeader_t) < NVM_PAGE_SIZE, "snapshot header must fit in a page");
+    if ((sizeof(nvmSnapshotHeader_t) + length) > (NVM_SNAPSHOT_PAGES * NVM_PAGE_SIZE)) {
+        return (false);
+    }
+    nvmSnapshotHeader_t header;
+    nvm_flash_read(NVM_SNAPSHOT_PAGE, nvm_read_buf);
+    memcpy(&header, nvm_read_buf, sizeof(header));
+    if ((header.magic != NVM_SNAPSHOT_MAGIC) || (header.hash != hash) || (header.length != length)) {
+        return (false);
+    }
+    uint8_t *out = (uint8_t *)data;
+    uint32_t k = 0;                                         // position in the stream
+    for (uint8_t p=0; k < (sizeof(header) + length); p++) {
+        if (p > 0) {
+            nvm_flash_read(NVM_SNAPSHOT_PAGE + p, nvm_read_buf);
+        }
+        uint8_t *buf = (uint8_t *)nvm_read_buf;
+        for (uint16_t j=0; (j < NVM_PAGE_SIZE) && (k < (sizeof(header) + length)); j++, k++) {
+            if (k >= sizeof(header)) {
+                out[k - sizeof(header)] = buf[j];
+            }
+        }
+    }
+    return (persistence_hash(2166136261, data, length) == header.check);
+#else
+    return (false);
+#endif
+}
+
+/*
+ * persistence_write_snapshot() - save a snapshot taken from the profile with this hash
+ *
+ *  Erases and programs the snapshot pages, header page last. Does nothing if the snapshot
+ *  doesn't fit in NVM_SNAPSHOT_PAGES.
+ */
+
+void persistence_write_snapshot(uint32_t hash, const void *data, uint16_t length)
+{
+#if (NVM_LOG_PAGES > 0) && (NVM_SNAPSHOT_PAGES > 0)
+    if ((sizeof(nvmSnapshotHeader_t) + length) > (NVM_SNAPSHOT_PAGES * NVM_PAGE_SIZE)) {
+        rpt_exception(STAT_PERSISTENCE_ERROR, "config snapshot is larger than NVM_SNAPSHOT_PAGES");
+        return;
+    }
+    nvmSnapshotHeader_t header = { NVM_SNAPSHOT_MAGIC, hash, persistence_hash(2166136261, data, length), length };
+    uint8_t pages = (sizeof(header) + length + NVM_PAGE_SIZE - 1) / NVM_PAGE_SIZE;
+    for (uint8_t p = pages; p-- > 0; ) {                    // header page last
+        _snapshot_page(p, &header, (const uint8_t *)data);
+        if (!nvm_flash_erase(NVM_SNAPSHOT_PAGE + p) || !nvm_flash_program(NVM_SNAPSHOT_PAGE + p, nvm_read_buf)) {
+            rpt_exception(STAT_PERSISTENCE_ERROR, "config snapshot write failed");
+            return;
+        }
+    }
+#endif
+}
+
+/*
+ * persistence_read_checkpoint() - copy out the latest motion checkpoint
+ *
+ *  Returns false, leaving data alone, if there is none of this length. Also sets up the
+ *  slot the next checkpoint goes in, so call this before the first write.
+ */
+
+bool persistence_read_checkpoint(void *data, uint16_t length)
+{
+#if (NVM_LOG_PAGES > 0) && (NVM_CHECKPOINT_PAGES > 0)
+    if (_checkpoint_slot_size(length) > NVM_PAGE_SIZE) {
+        return (false);
+    }
+    return (_checkpoint_scan(data, length));
+#else
+    return (false);
+#endif
+}
+
+/*
+ * persistence_write_checkpoint() - program a motion checkpoint into the next free slot
+ *
+ *  One slot is programmed; the rest of the page stays 0xFF. A slot that isn't erased was
+ *  torn by a reset during its write and is skipped. Moving to a new page erases it, which
+ *  is the only erase - the latest checkpoint is in the page before it.
+ */
+
+bool persistence_write_checkpoint(const void *data, uint16_t length)
+{
+#if (NVM_LOG_PAGES > 0) && (NVM_CHECKPOINT_PAGES > 0)
+    uint16_t size = _checkpoint_slot_size(length);
+    uint16_t slots = NVM_PAGE_SIZE / size;
+    if (slots == 0) {
+        rpt_exception(STAT_PERSISTENCE_ERROR, "checkpoint is larger than NVM_PAGE_SIZE");
+        return (false);
+    }
+    if (nvm.checkpoint_length != length) {
+        _checkpoint_scan(NULL, length);
+    }
+    uint8_t *buf = (uint8_t *)nvm_read_buf;
+    while (true) {
+        if (nvm.checkpoint_slot >= slots) {
+            nvm.checkpoint_page = (nvm.checkpoint_page + 1) % NVM_CHECKPOINT_PAGES;
+            nvm.checkpoint_slot = 0;
+            if (!nvm_flash_erase(NVM_CHECKPOINT_PAGE + nvm.checkpoint_page)) {
+                rpt_exception(STAT_PERSISTENCE_ERROR, "checkpoint page erase failed");
+                return (false);
+            }
+            break;
+        }
+        nvm_flash_read(NVM_CHECKPOINT_PAGE + nvm.checkpoint_page, nvm_read_buf);
+        uint16_t j = nvm.checkpoint_slot * size;
+        while ((j < ((nvm.checkpoint_slot+1) * size)) && (buf[j] == 0xFF)) {
+            j++;
+        }
+        if (j == ((nvm.checkpoint_slot+1) * size)) {
+            break;
+        }
+        nvm.checkpoint_slot++;
+    }
+    nvmCheckpointHeader_t header;
+    header.sequence = ++nvm.checkpoint_sequence;
+    header.check = _checkpoint_check(header.sequence, data, length);
+    memset(buf, 0xFF, NVM_PAGE_SIZE);
+    memcpy(buf + (nvm.checkpoint_slot * size), &header, sizeof(header));
+    memcpy(buf + (nvm.checkpoint_slot * size) + sizeof(header), data, length);
+    nvm.checkpoint_slot++;
+    if (!nvm_flash_program(NVM_CHECKPOINT_PAGE + nvm.checkpoint_page, nvm_read_buf)) {
+        rpt_exception(STAT_PERSISTENCE_ERROR, "checkpoint program failed");
+        return (false);
+    }
+    return (true);
+#else
+    return (false);
+#endif
 }
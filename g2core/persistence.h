@@ -30,23 +30,143 @@
 
 #include "config.h"  // needed for nvObj_t definition
 
-#define NVM_VALUE_LEN 4       // NVM value length (float, fixed length)
-#define NVM_BASE_ADDR 0x0000  // base address of usable NVM
+/* Log-structured persistence
+ *
+ *  Persisted values live in a RAM shadow indexed by cfgArray index. A write only touches
+ *  the shadow and appends an {index, value} record to a RAM image of the head page of
+ *  the log. The image is programmed to flash from persistence_callback() once writes
+ *  stop and there is no cycle running, so a $defa or a config batch is a few page
+ *  programs, not one per value. A full image is programmed right away.
+ *
+ *  The log is a ring of NVM_LOG_PAGES flash pages, each starting with a header holding
+ *  a sequence number. Pages are filled in turn so wear is spread across all of them.
+ *  When the last erased page is taken the oldest page is reclaimed: records in it that
+ *  still match the shadow are copied to the head and the page is erased. The log should
+ *  hold at least twice the number of persisted values to keep reclaims cheap.
+ *
+ *  At startup persistence_init() finds the oldest page and replays the log into the
+ *  shadow, so reads never touch flash. A record that doesn't check (torn write) ends
+ *  its page.
+ *
+ *  The board provides the flash with the nvm_flash_...() functions below and sets
+ *  NVM_LOG_PAGES. With NVM_LOG_PAGES 0 nothing is stored and defaults load at reset.
+ *
+ *  NVM_PROFILES profiles can be stored. Each has its own log followed by its own
+ *  snapshot pages, and a selector page after the last profile records the active one.
+ *
+ *  The NVM_SNAPSHOT_PAGES pages after the log hold a block of derived runtime state
+ *  saved with a hash of the profile it came from (see config_init()). It is written
+ *  data pages first and header page last, and carries a check of its data.
+ *
+ *  The NVM_CHECKPOINT_PAGES pages after the selector hold motion checkpoints (see
+ *  checkpoint.h). These are fixed size slots, each with a sequence number and a check,
+ *  programmed one at a time into the page being filled. A page is erased only as it is
+ *  taken, so that is one erase per page of checkpoints, and the latest checkpoint is
+ *  always in another page while that happens. The checkpoints are shared by all profiles.
+ */
+
+#ifndef NVM_LOG_PAGES
+#define NVM_LOG_PAGES       0           // flash pages given to the log. 0 = no persistence
+#endif
+#ifndef NVM_PAGE_SIZE
+#define NVM_PAGE_SIZE       256         // bytes per flash page (SAM3X/SAM4E page)
+#endif
+#ifndef NVM_SHADOW_LEN
+#define NVM_SHADOW_LEN      1024        // indexes held in the shadow. Must cover all single values
+#endif
+#ifndef NVM_SNAPSHOT_PAGES
+#define NVM_SNAPSHOT_PAGES  4           // flash pages after the log for the config snapshot. 0 = none
+#endif
+#ifndef NVM_PROFILES
+#define NVM_PROFILES        1           // stored machine profiles. Switch with $pf
+#endif
+#ifndef NVM_CHECKPOINT_PAGES
+#define NVM_CHECKPOINT_PAGES 8          // flash pages after the selector for motion checkpoints. 0 = none
+#endif
+#ifndef NVM_FLUSH_MS
+#define NVM_FLUSH_MS        100         // program the head page once no writes have come for this long
+#endif
+
+#define NVM_MAGIC           0x4E564D31  // "NVM1" - marks a page header
+#define NVM_SNAPSHOT_MAGIC  0x4E564D53  // "NVMS" - marks a snapshot header
+#define NVM_RECORD_EMPTY    0xFFFF      // index of an erased record slot
+#define NVM_PROFILE_PAGES   (NVM_LOG_PAGES + NVM_SNAPSHOT_PAGES)
+#define NVM_SELECT_PAGE     (NVM_PROFILES * NVM_PROFILE_PAGES)     // page after the last profile
+#define NVM_SELECT_SLOTS    (NVM_PAGE_SIZE / sizeof(uint32_t))
+#define NVM_CHECKPOINT_PAGE (NVM_SELECT_PAGE + 1)                  // first checkpoint page
+#define NVM_RECORDS_PER_PAGE ((NVM_PAGE_SIZE / sizeof(nvmRecord_t)) - 1)   // less the header
+
+typedef struct nvmRecord {              // 8 bytes. Also the page header: {sequence, magic}
+    uint16_t index;                     // cfgArray index
+    uint16_t check;                     // index and value folded together - catches torn writes
+    float value;
+} nvmRecord_t;
+
+typedef struct nvmPageHeader {
+    uint32_t sequence;                  // increments for each page taken. Oldest page has the lowest
+    uint32_t magic;
+} nvmPageHeader_t;
+
+typedef struct nvmSnapshotHeader {
+    uint32_t magic;
+    uint32_t hash;                      // hash of the profile the snapshot was taken from
+    uint32_t check;                     // persistence_hash() of the data
+    uint32_t length;                    // bytes of data following the header
+} nvmSnapshotHeader_t;
+
+typedef struct nvmCheckpointHeader {
+    uint32_t sequence;                  // increments for each checkpoint. Latest has the highest
+    uint32_t check;                     // persistence_hash() of the length, sequence and data
+} nvmCheckpointHeader_t;
 
 //**** persistence singleton ****
 
 typedef struct nvmSingleton {
-    uint16_t base_addr;     // NVM base address
-    uint16_t profile_base;  // NVM base address of current profile]
-    uint16_t address;
-    float    tmp_value;
-    int8_t   byte_array[NVM_VALUE_LEN];
+    bool hold;                          // writes are dropped (config_init() restoring the profile)
+#if NVM_LOG_PAGES > 0
+    uint8_t profile;                    // active profile
+    uint16_t select_slot;               // next free slot in the selector page
+    uint16_t base;                      // first page of the active profile
+    uint16_t head;                      // page being filled
+    uint16_t tail;                      // oldest page in the log
+    uint16_t free_pages;                // erased pages after the head
+    uint16_t records;                   // records in the head page image
+    uint16_t programmed;                // records in the head page image already in flash
+    uint32_t sequence;                  // sequence number of the head page
+    uint32_t last_write_tick;           // systick value of the last record appended
+    uint16_t checkpoint_length;         // data bytes per checkpoint slot. 0 = checkpoints not scanned yet
+    uint16_t checkpoint_page;           // checkpoint page being filled
+    uint16_t checkpoint_slot;           // next slot in it
+    uint32_t checkpoint_sequence;       // sequence number of the latest checkpoint
+    union {
+        nvmPageHeader_t header;
+        nvmRecord_t record[NVM_RECORDS_PER_PAGE+1];    // record[0] is the header
+    } page;                             // RAM image of the head page
+    uint32_t stored[(NVM_SHADOW_LEN+31)/32];           // bit per index: the shadow holds a value
+    float shadow[NVM_SHADOW_LEN];
+#endif
 } nvmSingleton_t;
 
+extern nvmSingleton_t nvm;
+
 //**** persistence function prototypes ****
 
 void persistence_init(void);
+void persistence_hold(bool hold);
 stat_t read_persistent_value(nvObj_t* nv);
 stat_t write_persistent_value(nvObj_t* nv);
+stat_t persistence_callback(void);
+uint8_t persistence_get_profile(void);
+stat_t persistence_select_profile(uint8_t profile);
+uint32_t persistence_hash(uint32_t hash, const void *data, uint16_t length);
+bool persistence_read_snapshot(uint32_t hash, void *data, uint16_t length);
+void persistence_write_snapshot(uint32_t hash, const void *data, uint16_t length);
+bool persistence_read_checkpoint(void *data, uint16_t length);
+bool persistence_write_checkpoint(const void *data, uint16_t length);
+
+// flash access - provided by the board when NVM_LOG_PAGES > 0
+void nvm_flash_read(uint16_t page, void *data);         // read a whole page
+bool nvm_flash_program(uint16_t page, const void *data);// program a whole page. Clears bits only
+bool nvm_flash_erase(uint16_t page);                    // erase a page to all 0xFF
 
 #endif  // End of include guard: PERSISTENCE_H_ONCE
@@ -32,8 +32,13 @@ arc_t arc;
 
 static stat_t _compute_arc(const bool radius_f);
 static void _compute_arc_offsets_from_radius(void);
-static float _estimate_arc_time (float arc_time);
+static void _set_arc_rotation(void);
+static float _estimate_arc_time(void);
 static stat_t _test_arc_soft_limits(void);
+#if (PLANNER_ARC_BLOCKS == 1)
+static bool _arc_block_is_usable(void);
+static stat_t _queue_arc_block(void);
+#endif
 
 /*****************************************************************************
  * Canonical Machining arc functions (arc prep for planning and runtime)
@@ -68,7 +73,19 @@ void cm_abort_arc()
  * cm_arc_callback() - generate an arc
  *
  *  cm_arc_cycle_callback() is called from the controller main loop. Each time it's called
- *  it queues as many arc segments (lines) as it can before it blocks, then returns.
+ *  it queues up to ARC_SEGMENTS_PER_CALLBACK arc segments (lines), or fewer if the planner
+ *  fills, then returns.
+ *
+ *  Segments go to mp_aline_arc() with the values _compute_arc() set up for the whole arc:
+ *  the segment length and jerk are constant, and the radius and unit vectors are rotated
+ *  by the segment angle each time rather than recomputed. To keep rounding from building
+ *  up they are recomputed exactly every ARC_ANGULAR_CORRECTION segments and for the last.
+ *
+ *  The junction at each end of the arc is taken from the end chord, not the true tangent,
+ *  and that is the corner the machine really turns there. The end chords lie half a
+ *  segment angle off the tangent, where the segments meet each other at a whole segment
+ *  angle, so a tangent line or arc gets twice the junction velocity of the arc's own
+ *  junctions and is never what slows the arc down.
  *
  *  Parts of this routine were informed by the grbl project.
  */
@@ -78,22 +95,35 @@ stat_t cm_arc_callback()
     if (arc.run_state == BLOCK_INACTIVE) {
         return (STAT_NOOP);
     }
-    if (mp_planner_is_full()) {
-        return (STAT_EAGAIN);
-    }
-    arc.theta += arc.segment_theta;
-    arc.gm.target[arc.plane_axis_0] = arc.center_0 + sin(arc.theta) * arc.radius;
-    arc.gm.target[arc.plane_axis_1] = arc.center_1 + cos(arc.theta) * arc.radius;
-    arc.gm.target[arc.linear_axis] += arc.segment_linear_travel;
+    for (uint8_t i=0; i<ARC_SEGMENTS_PER_CALLBACK; i++) {
+        if (mp_planner_is_full()) {
+            return (STAT_EAGAIN);
+        }
+        arc.theta += arc.segment_theta;
+        if (((arc.segment_count % ARC_ANGULAR_CORRECTION) == 0) || (arc.segment_count == 1)) {
+            _set_arc_rotation();
+        } else {
+            float r_0 = arc.radius_0;
+            arc.radius_0 = r_0 * arc.cos_segment_theta + arc.radius_1 * arc.sin_segment_theta;
+            arc.radius_1 = arc.radius_1 * arc.cos_segment_theta - r_0 * arc.sin_segment_theta;
+        }
+        arc.gm.target[arc.plane_axis_0] = arc.center_0 + arc.radius_0;
+        arc.gm.target[arc.plane_axis_1] = arc.center_1 + arc.radius_1;
+        arc.gm.target[arc.linear_axis] += arc.segment_linear_travel;
 
-    mp_aline(&arc.gm);                              // run the line
-    copy_vector(arc.position, arc.gm.target);       // update arc current position
+        mp_aline_arc(&arc.gm, arc.unit, arc.segment_length, &arc.jerk);  // run the line
+        arc.gm.output_count = 0;                    // only the first segment carries M62/M63 changes
+        copy_vector(arc.position, arc.gm.target);   // update arc current position
 
-    if (--arc.segment_count > 0) {
-        return (STAT_EAGAIN);
+        if (--arc.segment_count == 0) {
+            arc.run_state = BLOCK_INACTIVE;
+            return (STAT_OK);
+        }
+        float u_0 = arc.unit[arc.plane_axis_0];     // turn the unit vector for the next segment
+        arc.unit[arc.plane_axis_0] = u_0 * arc.cos_segment_theta + arc.unit[arc.plane_axis_1] * arc.sin_segment_theta;
+        arc.unit[arc.plane_axis_1] = arc.unit[arc.plane_axis_1] * arc.cos_segment_theta - u_0 * arc.sin_segment_theta;
     }
-    arc.run_state = BLOCK_INACTIVE;
-    return (STAT_OK);
+    return (STAT_EAGAIN);
 }
 
 /*
@@ -257,11 +287,77 @@ stat_t cm_arc_feed(const float target[], const bool target_f[],     // target en
     }
 
     cm_cycle_start();                                   // if not already started
+#if (PLANNER_ARC_BLOCKS == 1)
+    if (_arc_block_is_usable()) {
+        ritorno(_queue_arc_block());                    // queue the whole arc as one block
+        cm.gm.output_count = 0;                         // M62/M63 changes went with the block
+        cm_finalize_move();
+        return (STAT_OK);
+    }
+#endif
     arc.run_state = BLOCK_ACTIVE;                       // enable arc to be run from the callback
+    cm.gm.output_count = 0;                             // M62/M63 changes go with the first segment (arc.gm)
     cm_finalize_move();
     return (STAT_OK);
 }
 
+#if (PLANNER_ARC_BLOCKS == 1)
+/*
+ * _arc_block_is_usable() - true if the arc can be queued as a single arc block
+ *
+ *  Arc blocks are interpolated in the planner frame, so the arc must not be rotated or
+ *  offset by G68-style coordinate rotation. Axes outside the arc must not move, and the
+ *  radius must be large enough to give a meaningful centripetal limit. Otherwise the arc
+ *  is run as line segments from cm_arc_callback().
+ */
+
+static bool _arc_block_is_usable()
+{
+    for (uint8_t i=0; i<3; i++) {
+        for (uint8_t j=0; j<3; j++) {
+            float identity = (i == j) ? 1.0 : 0.0;
+            if (fp_NE(cm.rotation_matrix[i][j], identity)) {
+                return (false);
+            }
+        }
+    }
+    if (fp_NOT_ZERO(cm.rotation_z_offset) || (arc.radius < MIN_ARC_RADIUS)) {
+        return (false);
+    }
+    for (uint8_t axis=0; axis<AXES; axis++) {
+        if ((axis != arc.plane_axis_0) && (axis != arc.plane_axis_1) && (axis != arc.linear_axis) &&
+            (fp_NE(cm.gm.target[axis], arc.position[axis]))) {
+            return (false);
+        }
+    }
+    return (true);
+}
+
+/*
+ * _queue_arc_block() - queue the arc set up by _compute_arc() as one planner block
+ */
+
+static stat_t _queue_arc_block()
+{
+    mpArc_t a;
+    a.plane_axis_0 = arc.plane_axis_0;
+    a.plane_axis_1 = arc.plane_axis_1;
+    a.linear_axis = arc.linear_axis;
+    a.center_0 = arc.center_0;
+    a.center_1 = arc.center_1;
+    a.radius = arc.radius;
+    a.radius_delta = hypotf(cm.gm.target[arc.plane_axis_0] - arc.center_0,
+                            cm.gm.target[arc.plane_axis_1] - arc.center_1) - arc.radius;
+    a.theta = arc.theta;
+    a.angular_travel = arc.angular_travel;
+    a.linear_travel = arc.linear_travel;
+
+    stat_t status = mp_arc(&cm.gm, &a, arc.length);
+    copy_vector(arc.position, cm.gm.target);
+    return ((status == STAT_MINIMUM_LENGTH_MOVE) ? STAT_OK : status);
+}
+#endif
+
 /*
  * _compute_arc() - compute arc from I and J (arc center point)
  *
@@ -340,12 +436,21 @@ static stat_t _compute_arc(const bool radius_f)
     arc.planar_travel = arc.angular_travel * arc.radius;
     arc.length = hypotf(arc.planar_travel, fabs(arc.linear_travel));
 
-    // Find the minimum number of segments that meet accuracy and time constraints...
-    // Note: removed segment_length test as segment_time accounts for this (build 083.37)
-    float arc_time;
-    float segments_for_minimum_time = _estimate_arc_time(arc_time) * (MICROSECONDS_PER_MINUTE / MIN_ARC_SEGMENT_USEC);
-    float segments_for_chordal_accuracy = arc.length / sqrt(4*cm.chordal_tolerance * (2 * arc.radius - cm.chordal_tolerance));
-    arc.segments = floor(min(segments_for_chordal_accuracy, segments_for_minimum_time));
+    // Find the number of segments from the chordal tolerance, radius and feed rate:
+    //  - the chordal tolerance (ct) sets the largest angle a chord may span at this radius:
+    //      theta = 2 * acos(1 - ct/r), so large arcs get a few long segments
+    //  - the segments may not be shorter in time than MIN_ARC_SEGMENT_USEC at the feed rate,
+    //    so fast arcs are not cut finer than the planner can usefully run them
+    //  - no segment may span more than MAX_ARC_SEGMENT_THETA, whatever the tolerance
+    // The time limit may coarsen the chordal result, the angle limit is applied last.
+    float segment_theta_max = MAX_ARC_SEGMENT_THETA;
+    if (cm.chordal_tolerance < arc.radius) {
+        segment_theta_max = min(segment_theta_max, (float)(2 * acos(1 - cm.chordal_tolerance / arc.radius)));
+    }
+    float segments_for_chordal_accuracy = ceil(fabs(arc.angular_travel) / segment_theta_max);
+    float segments_for_minimum_time = floor(_estimate_arc_time() * (MICROSECONDS_PER_MINUTE / MIN_ARC_SEGMENT_USEC));
+    arc.segments = min(segments_for_chordal_accuracy, segments_for_minimum_time);
+    arc.segments = max(arc.segments, (float)ceil(fabs(arc.angular_travel) / MAX_ARC_SEGMENT_THETA));
     arc.segments = max(arc.segments, (float)1.0);        //...but is at least 1 segment
 
     if (arc.gm.feed_rate_mode == INVERSE_TIME_MODE) {
@@ -358,9 +463,44 @@ static stat_t _compute_arc(const bool radius_f)
     arc.center_0 = arc.position[arc.plane_axis_0] - sin(arc.theta) * arc.radius;
     arc.center_1 = arc.position[arc.plane_axis_1] - cos(arc.theta) * arc.radius;
     arc.gm.target[arc.linear_axis] = arc.position[arc.linear_axis];    // initialize the linear target
+
+    // setup the values shared by all segments (see cm_arc_callback())
+    float chord = 2 * arc.radius * sin(arc.segment_theta / 2);         // signed with the direction of travel
+    arc.segment_length = hypotf(chord, arc.segment_linear_travel);
+    arc.sin_segment_theta = sin(arc.segment_theta);
+    arc.cos_segment_theta = cos(arc.segment_theta);
+    memset(arc.unit, 0, sizeof(arc.unit));         // axes outside the arc stay zero
+    arc.theta += arc.segment_theta;                 // the first segment's unit vector...
+    _set_arc_rotation();
+    arc.theta -= arc.segment_theta;                 // ...is all that is needed from here
+
+    float unit_bound[AXES] = {0, 0, 0, 0, 0, 0};
+    unit_bound[arc.plane_axis_0] = fabs(chord) / arc.segment_length;
+    unit_bound[arc.plane_axis_1] = unit_bound[arc.plane_axis_0];
+    unit_bound[arc.linear_axis] = fabs(arc.unit[arc.linear_axis]);
+    mp_calculate_arc_jerk(&arc.jerk, unit_bound);
     return (STAT_OK);
 }
 
+/*
+ * _set_arc_rotation() - set the radius and unit vectors exactly for the segment ending at arc.theta
+ *
+ *  The chord of a segment ending at theta points along the tangent at its middle angle,
+ *  theta - segment_theta/2.
+ */
+
+static void _set_arc_rotation()
+{
+    float chord = 2 * arc.radius * sin(arc.segment_theta / 2);
+    float middle = arc.theta - arc.segment_theta / 2;
+
+    arc.radius_0 = sin(arc.theta) * arc.radius;
+    arc.radius_1 = cos(arc.theta) * arc.radius;
+    arc.unit[arc.plane_axis_0] =  cos(middle) * chord / arc.segment_length;
+    arc.unit[arc.plane_axis_1] = -sin(middle) * chord / arc.segment_length;
+    arc.unit[arc.linear_axis] = arc.segment_linear_travel / arc.segment_length;
+}
+
 /*
  * _compute_arc_offsets_from_radius() - compute arc center (offset) from radius.
  *
@@ -478,7 +618,7 @@ static void _compute_arc_offsets_from_radius()
 }
 
 /*
- * _estimate_arc_time ()
+ * _estimate_arc_time()
  *
  *  Returns a naiive estimate of arc execution time to inform segment calculation.
  *  The arc time is computed not to exceed the time taken in the slowest dimension
@@ -487,9 +627,10 @@ static void _compute_arc_offsets_from_radius()
  *  where the unit vector is 1 in that dimension. This is not true for any arbitrary arc,
  *  with the result that the time returned may be less than optimal.
  */
-static float _estimate_arc_time (float arc_time)
+static float _estimate_arc_time()
 {
     // Determine move time at requested feed rate
+    float arc_time;
     if (arc.gm.feed_rate_mode == INVERSE_TIME_MODE) {
         arc_time = arc.gm.feed_rate;    // inverse feed rate has been normalized to minutes
     } else {
@@ -508,87 +649,46 @@ static float _estimate_arc_time (float arc_time)
 /*
  * _test_arc_soft_limits() - return error code if soft limit is exceeded
  *
- *  Test if arc extends beyond arc plane boundaries set in soft limits.
- *
- *  The arc starting position (P) and target (T) define 2 points that divide the
- *  arc plane into 9 rectangles. The center of the arc is (C). P and T define the
- *  endpoints of two possible arcs; one that is less than or equal to 180 degrees (acute)
- *  and one that is greater than 180 degrees (obtuse), depending on the location of (C).
- *
- *  -------------------------------  plane boundaries in X and Y
- *  |         |         |         |
- *  |    1    |    2    |    3    |
- *  |                   |         |
- *  --------- P -------------------
- *  |                   |         |
- *  |    4    |    5    |    6    |
- *  |         |                   |
- *  ------------------- T ---------
- *  |        C|                   |  C shows one of many possible center locations
- *  |    7    |    8    |    9    |
- *  |         |         |         |
- *  -------------------------------
- *
- *  C will fall along a diagonal bisecting 7, 5 and 3, but there is some tolerance in the
- *  circle algorithm that allows C to deviate from the centerline slightly. As the centerline
- *  approaches the line connecting S and T the acute arcs will be "above" S and T in sections
- *  5 or 3, and the obtuse arcs will be "below" in sections 5 or 7. But it's simpler, because
- *  we know that the arc is > 180 degrees (obtuse) if the angular travel value is > pi.
+ *  Tests the bounding box of the arc against the soft limits in one cm_check_soft_limits().
+ *  The box starts as the one around the start (arc.position) and the target (cm.gm.target,
+ *  as _compute_arc() has reset the linear axis of arc.gm.target), which covers the linear
+ *  axis and any other axes moving with the arc. In the plane the arc reaches out to the
+ *  center -/+ the radius on an axis if it sweeps through the angle of that extreme:
  *
- *  The example below only tests the X axis (0 axis), but testing the other axis is similar
+ *      plane axis 0 = center_0 + radius * sin(angle)   max at angle pi/2, min at -pi/2
+ *      plane axis 1 = center_1 + radius * cos(angle)   max at angle 0,    min at pi
  *
- *    (1) If Cx <= Px and arc is acute; no test is needed
- *
- *    (2) If Cx <= Px and arc is obtuse; test if the radius is greater than
- *          the distance from Cx to the negative X boundary
- *
- *    (3) If Px < Cx < Tx and arc is acute; test if the radius is greater than
- *          the distance from Cx to the positive X boundary
- *
- *    (4) If Px < Cx < Tx and arc is obtuse; test if the radius is greater than
- *          the distance from Cx to the positive X boundary
- *
- *  The arc plane is defined by 0 and 1 depending on G17/G18/G19 plane selected,
- *  corresponding to arc planes XY, XZ, YZ, respectively.
+ *  which is the same angle convention as arc.theta. No trig is needed beyond what
+ *  _compute_arc() has done.
  *
  *  Must be called with all the following set in the arc struct
- *    -    arc starting position (arc.position)
- *    - arc ending position (arc.gm.target)
+ *    - arc starting position (arc.position)
  *    - arc center (arc.center_0, arc.center_1)
  *    - arc.radius (arc.radius)
- *    - arc angular travel in radians (arc.angular_travel)
- *    - max and min travel in axis 0 and axis 1 (in cm struct)
+ *    - arc starting angle and angular travel in radians (arc.theta, arc.angular_travel)
  */
-/*
-static stat_t _test_arc_soft_limit_plane_axis(float center, uint8_t plane_axis)
+
+static bool _arc_sweeps(const float angle)
 {
-    if (center <= arc.position[plane_axis]) {
-        if (arc.angular_travel < M_PI) {                            // case (1)
-            return (STAT_OK);
-        }
-        if ((center - arc.radius) < cm.a[plane_axis].travel_min) {    // case (2)
-            return (STAT_SOFT_LIMIT_EXCEEDED);
-        }
+    float travel = (arc.angular_travel > 0) ? (angle - arc.theta) : (arc.theta - angle);
+    travel = fmod(travel, (float)(2*M_PI));
+    if (travel < 0) {
+        travel += 2*M_PI;
     }
-    if ((center + arc.radius) > cm.a[plane_axis].travel_max) {        // cases (3) and (4)
-        return (STAT_SOFT_LIMIT_EXCEEDED);
-    }
-    return(STAT_OK);
+    return (travel <= fabs(arc.angular_travel));
 }
-*/
+
 static stat_t _test_arc_soft_limits()
 {
-/*
-    if (cm.soft_limit_enable == true) {
-
-        // Test if target falls outside boundaries. This is a 3 dimensional test
-        // so it also checks the linear axis of the arc (helix axis)
-        ritorno(cm_test_soft_limits(arc.gm.target));
-
-        // test arc extents
-        ritorno(_test_arc_soft_limit_plane_axis(arc.center_0, arc.plane_axis_0));
-        ritorno(_test_arc_soft_limit_plane_axis(arc.center_1, arc.plane_axis_1));
+    float box_min[AXES];
+    float box_max[AXES];
+    for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
+        box_min[axis] = min(arc.position[axis], cm.gm.target[axis]);
+        box_max[axis] = max(arc.position[axis], cm.gm.target[axis]);
     }
-*/
-    return(STAT_OK);
+    if (_arc_sweeps(M_PI/2))  { box_max[arc.plane_axis_0] = arc.center_0 + arc.radius; }
+    if (_arc_sweeps(-M_PI/2)) { box_min[arc.plane_axis_0] = arc.center_0 - arc.radius; }
+    if (_arc_sweeps(0))       { box_max[arc.plane_axis_1] = arc.center_1 + arc.radius; }
+    if (_arc_sweeps(M_PI))    { box_min[arc.plane_axis_1] = arc.center_1 - arc.radius; }
+    return (cm_check_soft_limits(box_min, box_max));
 }
@@ -20,9 +20,13 @@
 #ifndef PLAN_ARC_H_ONCE
 #define PLAN_ARC_H_ONCE
 
+#include "planner.h"                            // mpJerk_t
+
 #define MIN_ARC_RADIUS ((float)0.1)             // min radius that can be executed
-#define MIN_ARC_SEGMENT_LENGTH ((float)0.05)    // Arc segment size (mm).(0.03)
 #define MIN_ARC_SEGMENT_USEC ((float)10000)     // minimum arc segment time
+#define MAX_ARC_SEGMENT_THETA ((float)(M_PI/2)) // max angle per segment, regardless of chordal tolerance (ct)
+#define ARC_SEGMENTS_PER_CALLBACK 4             // max segments queued per pass of cm_arc_callback()
+#define ARC_ANGULAR_CORRECTION 16               // segments between exact sin/cos corrections of the rotation
 
 // Arc radius tests. See http://linuxcnc.org/docs/html/gcode/gcode.html#sec:G2-G3-Arc
 //#define ARC_RADIUS_ERROR_MAX ((float)0.5)     // max allowable mm between start and end radius
@@ -57,6 +61,14 @@ typedef struct arArcSingleton {                 // persistent planner and runtim
     float   center_0;               // center of circle at plane axis 0 (e.g. X for G17)
     float   center_1;               // center of circle at plane axis 1 (e.g. Y for G17)
 
+    float   segment_length;         // length of every segment (chord or helix step)
+    float   sin_segment_theta;      // rotation per segment, applied incrementally
+    float   cos_segment_theta;
+    float   radius_0;               // running radius vector from the center, plane axis 0
+    float   radius_1;               // running radius vector from the center, plane axis 1
+    float   unit[AXES];             // running unit vector of the next segment (unrotated)
+    mpJerk_t jerk;                  // jerk terms shared by all segments
+
     GCodeState_t gm;                // Gcode state struct is passed for each arc segment.
                                     //    Usage:
                                     //    uint32_t linenum;            // line number of the arc feed move - same for each segment
@@ -0,0 +1,317 @@
+/*
+ * plan_aux.cpp - auxiliary motion channel: axes that move on their own queue
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "g2core.h"
+#include "config.h"
+#include "canonical_machine.h"
+#include "planner.h"
+#include "plan_aux.h"
+#include "stepper.h"
+#include "text_parser.h"
+#include "util.h"
+
+// Allocate auxiliary channel singleton structure
+
+aux_t aux;
+
+// Local functions
+
+static void _aux_step(const float segment_time, float start[], float end[]);
+static void _aux_start_move(void);
+static float _aux_head_distance(const float t);
+static int8_t _get_aux_axis(const nvObj_t *nv);
+
+/*****************************************************************************
+ * Auxiliary channel functions
+ *
+ * mp_aux_init()         - initialize the channel
+ * mp_aux_segment()      - add the channel offsets to a move segment
+ * mp_aux_idle_segment() - add the channel offsets to an offset-only segment
+ * mp_aux_add_offset()   - add the offsets of the last segment to a position
+ * mp_aux_flush()        - drop the queued moves that have not started
+ * mp_aux_is_running()   - true if a move is running, or one can start
+ * mp_aux_is_idle()      - true if the steppers are running offset-only segments
+ */
+
+/*
+ * mp_aux_init() - initialize auxiliary channel structures
+ *
+ *  Does not touch the configuration, which is loaded by config_init()
+ */
+void mp_aux_init()
+{
+    aux.magic_start = MAGICNUM;
+    aux.magic_end = MAGICNUM;
+    aux.head = 0;
+    aux.tail = 0;
+    aux.active = false;
+    aux.idle_segments = 0;
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        aux.offset[axis] = 0;
+    }
+}
+
+/*
+ * mp_aux_segment()      - called by the exec for every segment of a move or jog
+ * mp_aux_idle_segment() - called by the exec for a segment with no move
+ *
+ *  start and end are the segment's start and target, after shaping. Both are moved by the
+ *  offset of each auxiliary axis. Call once per segment, just before the kinematics.
+ */
+void mp_aux_segment(const float segment_time, float start[], float end[])
+{
+    aux.idle_segments = 0;
+    _aux_step(segment_time, start, end);
+}
+
+void mp_aux_idle_segment(const float segment_time, float start[], float end[])
+{
+    if (aux.idle_segments < UINT8_MAX) {
+        aux.idle_segments++;
+    }
+    _aux_step(segment_time, start, end);
+}
+
+void mp_aux_add_offset(float position[])
+{
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        position[axis] += aux.offset[axis];
+    }
+}
+
+// Flushes run in a hold, when the exec doesn't start moves, so the tail is the main loop's to move
+void mp_aux_flush() { aux.tail = aux.head; }
+
+bool mp_aux_is_running() { return (aux.active || ((aux.tail != aux.head) && (cm.hold_state == FEEDHOLD_OFF))); }
+
+bool mp_aux_is_idle() { return (mp_aux_is_running() && (aux.idle_segments > PREP_BUFFERS)); }
+
+/*
+ * _aux_step() - move the offsets on by one segment
+ *
+ *  A move is a head, a body at the velocity and a tail, the tail the head run backwards.
+ *  The distance is taken from the profile at the end of each segment, so the move ends
+ *  exactly at its target whatever the segment times are.
+ */
+static void _aux_step(const float segment_time, float start[], float end[])
+{
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        start[axis] += aux.offset[axis];
+    }
+    if (!aux.active) {
+        _aux_start_move();
+    }
+    if (aux.active) {
+        aux.time += segment_time;
+        float distance;
+        if (aux.time >= aux.move_time) {
+            distance = fabs(aux.length);
+            aux.active = false;                             // done - the next move starts with the next segment
+        } else if (aux.time > (aux.move_time - aux.ramp_time)) {
+            distance = fabs(aux.length) - _aux_head_distance(aux.move_time - aux.time);
+        } else if (aux.time > aux.ramp_time) {
+            distance = _aux_head_distance(aux.ramp_time) + aux.velocity * (aux.time - aux.ramp_time);
+        } else {
+            distance = _aux_head_distance(aux.time);
+        }
+        aux.offset[aux.axis] = aux.start + copysignf(distance, aux.length);
+    }
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        end[axis] += aux.offset[axis];
+    }
+}
+
+/*
+ * _aux_start_move() - start the next queued move, unless the machine is in a feedhold
+ *
+ *  The velocity is the axis' velocity max, lowered if the move is too short to reach it.
+ *  Each ramp takes 2*sqrt(v/j) and covers v*sqrt(v/j).
+ */
+static void _aux_start_move()
+{
+    if ((aux.tail == aux.head) || (cm.hold_state != FEEDHOLD_OFF)) {
+        return;
+    }
+    auxMove_t *move = &aux.queue[aux.tail];
+    uint8_t axis = move->axis;
+    aux.tail = (aux.tail + 1) & AUX_QUEUE_MASK;
+
+    aux.axis = axis;
+    aux.start = aux.offset[axis];
+    aux.length = move->target - mp_get_runtime_absolute_position(axis) - aux.start;
+    float length = fabs(aux.length);
+    if (length < EPSILON) {
+        return;                                             // already there
+    }
+    float j = cm.a[axis].jerk_max * JERK_MULTIPLIER;
+    float v = cm.a[axis].velocity_max;
+    if ((2 * v * sqrt(v / j)) > length) {
+        v = pow(length * sqrt(j) / 2, (float)(2.0 / 3.0));  // no body - the ramps meet
+    }
+    aux.velocity = v;
+    aux.jerk = j;
+    aux.ramp_time = 2 * sqrt(v / j);
+    aux.move_time = 2 * aux.ramp_time + (length - 2 * v * sqrt(v / j)) / v;
+    aux.time = 0;
+    aux.active = true;
+}
+
+/*
+ * _aux_head_distance() - distance covered t into the head of the running move
+ *
+ *  The acceleration ramps up at the jerk to the middle of the head and back down to zero.
+ */
+static float _aux_head_distance(const float t)
+{
+    float j = aux.jerk;
+    float t_half = aux.ramp_time / 2;
+    if (t <= t_half) {
+        return (j * t * t * t / 6);
+    }
+    float u = t - t_half;
+    return ((j * t_half * t_half * t_half / 6) + (aux.velocity / 2 * u) + (j * t_half * u * u / 2) - (j * u * u * u / 6));
+}
+
+/*
+ * mp_aux_callback() - fold the offsets into the positions once the channel and the machine are idle
+ *
+ *  The axes are where the channel left them - the positions move to them, and the steps are unchanged.
+ */
+stat_t mp_aux_callback()
+{
+    if (aux.active || (aux.tail != aux.head)) {
+        return (STAT_NOOP);
+    }
+    if ((cm.cycle_state != CYCLE_OFF) || !mp_runtime_is_idle() || mp_has_runnable_buffer()) {
+        return (STAT_NOOP);
+    }
+    stat_t status = STAT_NOOP;
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        if (aux.offset[axis] != 0) {
+            float position = mp_get_runtime_absolute_position(axis) + aux.offset[axis];
+            aux.offset[axis] = 0;
+            cm_set_position(axis, position);
+            status = STAT_OK;
+        }
+    }
+    return (status);
+}
+
+/***********************************************************************************
+ * CONFIGURATION AND INTERFACE FUNCTIONS
+ * Functions to get and set variables from the cfgArray table
+ ***********************************************************************************/
+
+/*
+ * _get_aux_axis() - the axis of an auxx to auxc token, from the offset it points to
+ */
+
+static int8_t _get_aux_axis(const nvObj_t *nv)
+{
+    return ((int8_t)((float *)GET_TABLE_WORD(target) - aux.offset));
+}
+
+/*
+ * mp_get_aux()  - get the machine position of an axis, with its channel offset
+ * mp_set_aux()  - queue an auxiliary move of an axis to a machine position
+ * mp_get_auxr() - true while auxiliary moves are queued or running
+ * mp_set_auxm() - set the auxiliary axes. Not while the channel has moves or offsets
+ */
+
+stat_t mp_get_aux(nvObj_t *nv)
+{
+    int8_t axis = _get_aux_axis(nv);
+    nv->value = mp_get_runtime_absolute_position(axis) + aux.offset[axis];
+    nv->precision = (int8_t)GET_TABLE_WORD(precision);
+    nv->valuetype = TYPE_FLOAT;
+    return (STAT_OK);
+}
+
+stat_t mp_set_aux(nvObj_t *nv)
+{
+    int8_t axis = _get_aux_axis(nv);
+    if (!(aux.axes & (1 << axis)) ||
+        (cm.cycle_state == CYCLE_HOMING) || (cm.cycle_state == CYCLE_PROBE)) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    uint8_t head = (aux.head + 1) & AUX_QUEUE_MASK;
+    if (head == aux.tail) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_BUFFER_FULL);
+    }
+    aux.queue[aux.head].axis = axis;
+    aux.queue[aux.head].target = nv->value;
+    aux.head = head;                                        // the move is in once the head moves past it
+    st_request_exec_move();                                 // run offset-only segments if nothing else is
+    return (STAT_OK);
+}
+
+stat_t mp_get_auxr(nvObj_t *nv)
+{
+    nv->value = (aux.active || (aux.tail != aux.head));
+    nv->valuetype = TYPE_BOOL;
+    return (STAT_OK);
+}
+
+stat_t mp_set_auxm(nvObj_t *nv)
+{
+    if (nv->value < 0) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    if (nv->value >= (1 << AXES)) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_EXCEEDS_MAX_VALUE);
+    }
+    if (aux.active || (aux.tail != aux.head)) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        if (aux.offset[axis] != 0) {
+            nv->valuetype = TYPE_NULL;
+            return (STAT_COMMAND_NOT_ACCEPTED);
+        }
+    }
+    return (set_ui8(nv));
+}
+
+/***********************************************************************************
+ * TEXT MODE SUPPORT
+ * Functions to print variables from the cfgArray table
+ ***********************************************************************************/
+
+#ifdef __TEXT_MODE
+
+static const char fmt_auxx[] = "[auxx] auxiliary X position%13.3f mm\n";
+static const char fmt_auxy[] = "[auxy] auxiliary Y position%13.3f mm\n";
+static const char fmt_auxz[] = "[auxz] auxiliary Z position%13.3f mm\n";
+static const char fmt_auxa[] = "[auxa] auxiliary A position%13.3f deg\n";
+static const char fmt_auxb[] = "[auxb] auxiliary B position%13.3f deg\n";
+static const char fmt_auxc[] = "[auxc] auxiliary C position%13.3f deg\n";
+static const char fmt_auxm[] = "[auxm] auxiliary axes%14d [1=X,2=Y,4=Z,8=A...]\n";
+static const char fmt_auxr[] = "[auxr] auxiliary moves running%5s\n";
+
+static const char *const fmt_aux[] = { fmt_auxx, fmt_auxy, fmt_auxz, fmt_auxa, fmt_auxb, fmt_auxc };
+
+void mp_print_aux(nvObj_t *nv)  { text_print(nv, fmt_aux[_get_aux_axis(nv)]);}  // TYPE_FLOAT
+void mp_print_auxm(nvObj_t *nv) { text_print(nv, fmt_auxm);}       // TYPE_INT
+void mp_print_auxr(nvObj_t *nv) { text_print(nv, fmt_auxr);}       // TYPE_BOOL
+
+#endif // __TEXT_MODE
@@ -0,0 +1,113 @@
+/*
+ * plan_aux.h - auxiliary motion channel: axes that move on their own queue
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ *  The axes set in {auxm:} (1=X, 2=Y, 4=Z, 8=A, 16=B, 32=C) can be moved by the auxiliary
+ *  channel while the planner runs the Gcode program - a tool magazine can pre-position
+ *  during a cut. {auxx:} to {auxc:} queue a move of the axis to a machine position (mm
+ *  or degrees) and read back where the axis is. The channel has its own queue of
+ *  AUX_QUEUE_SIZE moves and runs them one after another, each rest to rest at the axis'
+ *  velocity max and jerk max. {auxr:} is true while moves are queued or running, so a
+ *  program can wait for the channel with M101 ({auxr:false}).
+ *
+ *  Like conveyor tracking (see plan_track.h) the channel is an offset that the exec adds
+ *  to the axis in every segment target - after shaping - as it converts it to steps, and
+ *  with no move queued it runs offset-only segments. The planner and the soft limits know
+ *  nothing of the offset, so the Gcode program should leave auxiliary axes alone while
+ *  the channel has moves. Once the channel and the machine are idle the offset is folded
+ *  into the axis position, so the program sees the axis where the channel left it.
+ *
+ *  A move that has started runs to its end; a feedhold holds the channel before its next
+ *  move. A queue flush drops the moves that have not started. Homing and probing of an
+ *  auxiliary axis need the channel idle.
+ *
+ *  Include after planner.h
+ */
+
+#ifndef PLAN_AUX_H_ONCE
+#define PLAN_AUX_H_ONCE
+
+#define AUX_QUEUE_SIZE          8                       // moves queued on the auxiliary channel (power of 2)
+#define AUX_QUEUE_MASK          (AUX_QUEUE_SIZE - 1)
+
+typedef struct auxMove {                // one queued auxiliary move
+    uint8_t axis;
+    float target;                       // machine position (mm or degrees)
+} auxMove_t;
+
+typedef struct auxChannelSingleton {    // auxiliary channel configuration, queue and runtime
+    magic_t magic_start;
+
+    // configuration
+    uint8_t axes;                       // auxm  axes the channel may move, a bit per axis
+
+    // queue - the main loop writes the head, the exec reads from the tail
+    auxMove_t queue[AUX_QUEUE_SIZE];
+    volatile uint8_t head;              // next slot to queue a move in
+    volatile uint8_t tail;              // next move for the exec to start
+
+    // runtime - written by the exec
+    volatile bool active;               // a move is running
+    uint8_t axis;                       // axis of the running move
+    float start;                        // offset the running move started from
+    float length;                       // signed length of the running move
+    float velocity;                     // cruise velocity of the running move (mm/min)
+    float jerk;                         // and its jerk (mm/min^3)
+    float ramp_time;                    // time of each of its head and tail (minutes)
+    float move_time;                    // time of the whole move (minutes)
+    float time;                         // time since it started (minutes)
+    float offset[AXES];                 // offset at the end of the last segment prepped
+    uint8_t idle_segments;              // offset-only segments prepped since the last move segment
+
+    magic_t magic_end;
+} aux_t;
+extern aux_t aux;
+
+/* auxiliary channel function prototypes */
+
+void   mp_aux_init(void);
+void   mp_aux_segment(const float segment_time, float start[], float end[]);
+void   mp_aux_idle_segment(const float segment_time, float start[], float end[]);
+void   mp_aux_add_offset(float position[]);
+void   mp_aux_flush(void);
+bool   mp_aux_is_running(void);
+bool   mp_aux_is_idle(void);
+stat_t mp_aux_callback(void);
+
+stat_t mp_get_aux(nvObj_t *nv);
+stat_t mp_set_aux(nvObj_t *nv);
+stat_t mp_get_auxr(nvObj_t *nv);
+stat_t mp_set_auxm(nvObj_t *nv);
+
+/* text mode display functions */
+
+#ifdef __TEXT_MODE
+
+    void mp_print_aux(nvObj_t *nv);
+    void mp_print_auxm(nvObj_t *nv);
+    void mp_print_auxr(nvObj_t *nv);
+
+#else
+
+    #define mp_print_aux tx_print_stub
+    #define mp_print_auxm tx_print_stub
+    #define mp_print_auxr tx_print_stub
+
+#endif // __TEXT_MODE
+
+#endif  // End of include guard: PLAN_AUX_H_ONCE
@@ -0,0 +1,477 @@
+/*
+ * plan_coalesce.cpp - short segment coalescing in front of the line planner
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* --- Coalescing Notes ----
+ *
+ *  A feed is a candidate if it is a G1 in units-per-minute feed mode (G94), in continuous
+ *  path mode (G64), shorter than the segment length (coall) and not zero length. The first
+ *  candidate becomes the pending move. Each following move is absorbed into it if:
+ *
+ *    - it is also a candidate, with the same feed rate, path control, coordinate system,
+ *      work offsets and tool as the pending move
+ *    - the merged move is no longer than the max length (coalm)
+ *    - every vertex dropped from the path lies within the tolerance (coalt) of the chord
+ *      from the start of the pending move to the new end point, and the vertices advance
+ *      monotonically along the chord (no doubling back)
+ *    - there is room to record another vertex
+ *
+ *  Otherwise the pending move is released to mp_aline() and the new move is considered
+ *  on its own. The pending move is also released by mp_aline() itself, so traverses, arcs
+ *  and cycle moves are never reordered with respect to it, by any other write to the
+ *  planner queue (commands, dwells, JSON), by mp_set_planner_position(), and by
+ *  mp_coalesce_callback() if input stalls or the planner queue is about to run dry.
+ *
+ *  Because the stage sits above mp_aline() it works in the unrotated Gcode model frame.
+ *  Rotation is rigid, so distances and tolerances are unaffected.
+ *
+ *  In smoothing mode (coale=2) a move that fails the chord test is tried against a spline
+ *  instead (_is_on_spline()). The spline starts and ends on the run's end points, leaving
+ *  along the first move and arriving along the last, and the lengths of its two tangent
+ *  handles are fitted by least squares to the run's vertices, each placed on the curve by
+ *  its share of the run's length (Schneider, "An Algorithm for Automatically Fitting
+ *  Digitized Curves", Graphics Gems 1990). One Newton step then moves each vertex to the
+ *  closest point of the curve and the handles are fitted again. The fit holds if every
+ *  vertex and the midpoint of every move is within the tolerance of the curve. Spline
+ *  blocks are in the planner frame, so this is only done with no rotation, and the run
+ *  must not move A, B or C.
+ */
+#include "g2core.h"
+#include "config.h"
+#include "canonical_machine.h"
+#include "planner.h"
+#include "plan_coalesce.h"
+#include "plan_spline.h"
+#include "text_parser.h"
+#include "util.h"
+
+// Allocate coalescer singleton structure
+
+coal_t coal;
+
+// Local functions
+
+static bool _is_candidate(const GCodeState_t *gm_in, const float length);
+static bool _is_compatible(const GCodeState_t *gm_in);
+static bool _is_on_chord(const float end[], const uint8_t vertices);
+#if (PLANNER_ARC_BLOCKS == 1)
+static bool _is_on_spline(const float end[], const uint8_t vertices);
+static void _fit_spline(mpSpline_t *s, const float *point[], const float u[], const uint8_t points,
+                        const float tangent_0[], const float tangent_1[]);
+static float _get_spline_error_sq(const mpSpline_t *s, const float point[], const float u);
+#endif
+
+/*****************************************************************************
+ * Coalescer functions
+ *
+ * mp_coalesce_init()     - initialize the coalescer
+ * mp_coalesce_abort()    - discard a pending move
+ * mp_coalesce_aline()    - entry point for straight feeds
+ * mp_coalesce_flush()    - release a pending move to the planner
+ * mp_coalesce_callback() - main-loop callback to release a stalled pending move
+ */
+
+/*
+ * mp_coalesce_init() - initialize coalescer structures
+ *
+ *  Does not touch the configuration, which is loaded by config_init()
+ */
+void mp_coalesce_init()
+{
+    coal.magic_start = MAGICNUM;
+    coal.magic_end = MAGICNUM;
+    coal.merged = 0;
+    mp_coalesce_abort();
+}
+
+/*
+ * mp_coalesce_abort() - discard a pending move without sending it to the planner
+ *
+ *  OK to call if no move is pending. Used by mp_flush_planner().
+ */
+void mp_coalesce_abort()
+{
+    coal.pending = false;
+    coal.spline = false;
+    coal.vertex_count = 0;
+    coal.timeout.clear();
+}
+
+/*
+ * mp_coalesce_aline() - coalescing entry point for straight feeds
+ *
+ *  gm_in    - Gcode state of the move, as would be passed to mp_aline()
+ *  position - model position at the start of the move (unrotated)
+ *
+ *  Returns STAT_OK if the move was absorbed or is held pending, otherwise the status
+ *  of mp_aline(). Zero length moves are passed through so the caller sees
+ *  STAT_MINIMUM_LENGTH_MOVE as before.
+ */
+stat_t mp_coalesce_aline(GCodeState_t *gm_in, const float position[])
+{
+    if (!coal.pending && !coal.enable) {
+        return (mp_aline(gm_in));                   // nothing pending and nothing to do
+    }
+    float length = get_axis_vector_length(gm_in->target, position);
+
+    if (coal.pending) {
+        if (fp_ZERO(length) && _is_compatible(gm_in)) {
+            coal.gm = *gm_in;                       // nothing to add but the line number
+            coal.merged++;
+            return (STAT_OK);
+        }
+        if (_is_candidate(gm_in, length) && _is_compatible(gm_in) &&
+            (coal.vertex_count < COALESCE_VERTEX_MAX) &&
+            (get_axis_vector_length(gm_in->target, coal.start) <= coal.length_max)) {
+
+            copy_vector(coal.vertex[coal.vertex_count], coal.gm.target);    // provisional vertex
+            bool spline = false;
+            bool absorbed = _is_on_chord(gm_in->target, coal.vertex_count + 1);
+#if (PLANNER_ARC_BLOCKS == 1)
+            if (!absorbed && (coal.enable == 2)) {
+                absorbed = spline = _is_on_spline(gm_in->target, coal.vertex_count + 1);
+            }
+#endif
+            if (absorbed) {
+                coal.spline = spline;
+                coal.vertex_count++;
+                coal.gm = *gm_in;
+                coal.merged++;
+                coal.timeout.set(COALESCE_TIMEOUT_MS);
+                return (STAT_OK);
+            }
+        }
+        ritorno(mp_coalesce_flush());
+    }
+    if (_is_candidate(gm_in, length)) {
+        copy_vector(coal.start, position);
+        coal.gm = *gm_in;
+        coal.vertex_count = 0;
+        coal.spline = false;
+        coal.pending = true;
+        coal.timeout.set(COALESCE_TIMEOUT_MS);
+        return (STAT_OK);
+    }
+    return (mp_aline(gm_in));
+}
+
+/*
+ * mp_coalesce_flush() - send a pending move to the planner
+ *
+ *  OK to call if no move is pending. The pending flag is cleared before calling mp_aline()
+ *  or mp_spline() so the flush that they perform on entry is a no-op.
+ */
+stat_t mp_coalesce_flush()
+{
+    if (!coal.pending) {
+        return (STAT_OK);
+    }
+    coal.pending = false;
+    coal.timeout.clear();
+#if (PLANNER_ARC_BLOCKS == 1)
+    if (coal.spline) {
+        coal.spline = false;
+        stat_t status = mp_spline(&coal.gm, &coal.curve);
+        return ((status == STAT_MINIMUM_LENGTH_MOVE) ? STAT_OK : status);
+    }
+#endif
+    stat_t status = mp_aline(&coal.gm);
+    return ((status == STAT_MINIMUM_LENGTH_MOVE) ? STAT_OK : status);
+}
+
+/*
+ * mp_coalesce_callback() - release a pending move that would otherwise wait too long
+ *
+ *  Releases the pending move if no further move has arrived within the timeout, or if
+ *  the planner queue holds no more than the running block. Holding a move back while the
+ *  runtime starves would cost more than the buffers it saves.
+ */
+stat_t mp_coalesce_callback()
+{
+    if (!coal.pending) {
+        return (STAT_NOOP);
+    }
+    if (mp_planner_is_full()) {
+        return (STAT_OK);                           // wait for room - the planner is not starving
+    }
+    if (coal.timeout.isPast() ||
+        ((mb.buffers_available >= PLANNER_BUFFER_POOL_SIZE-1) && (mp.planner_state > PLANNER_STARTUP))) {
+        return (mp_coalesce_flush());
+    }
+    return (STAT_OK);
+}
+
+/*
+ * _is_candidate() - test if a move may be held back or absorbed
+ */
+static bool _is_candidate(const GCodeState_t *gm_in, const float length)
+{
+    return ((coal.enable) &&
+            (gm_in->motion_mode == MOTION_MODE_STRAIGHT_FEED) &&
+            (gm_in->feed_rate_mode == UNITS_PER_MINUTE_MODE) &&
+            (gm_in->path_control == PATH_CONTINUOUS) &&
+            (fp_NOT_ZERO(length)) &&
+            (length < coal.segment_length));
+}
+
+/*
+ * _is_compatible() - test if a move shares the state of the pending move
+ */
+static bool _is_compatible(const GCodeState_t *gm_in)
+{
+    return ((fp_EQ(gm_in->feed_rate, coal.gm.feed_rate)) &&
+            (gm_in->feed_rate_mode == coal.gm.feed_rate_mode) &&
+            (gm_in->path_control == coal.gm.path_control) &&
+            (gm_in->coord_system == coal.gm.coord_system) &&
+            (gm_in->tool == coal.gm.tool) &&
+            (gm_in->spindle_speed == coal.gm.spindle_speed) &&    // an S change starts a new block
+            (gm_in->spindle_control == coal.gm.spindle_control) &&
+            (gm_in->raster_row == coal.gm.raster_row) &&        // a raster move is never merged
+            (gm_in->output_count == 0) && (coal.gm.output_count == 0) &&   // nor one with M62/M63 changes
+            (vector_equal(gm_in->work_offset, coal.gm.work_offset)));
+}
+
+/*
+ * _is_on_chord() - test the first n vertices against the chord from the start to end
+ *
+ *  Each vertex must lie within the tolerance of the chord, measured perpendicular to it,
+ *  and must not fall behind the previous vertex by more than the tolerance.
+ */
+static bool _is_on_chord(const float end[], const uint8_t vertices)
+{
+    float chord = get_axis_vector_length(end, coal.start);
+    if (fp_ZERO(chord)) {
+        return (false);
+    }
+    float unit[AXES];
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        unit[axis] = (end[axis] - coal.start[axis]) / chord;
+    }
+    float tolerance_squared = square(coal.tolerance);
+    float previous = 0;
+
+    for (uint8_t i = 0; i < vertices; i++) {
+        float along = 0;
+        float offset_squared = 0;
+        for (uint8_t axis = 0; axis < AXES; axis++) {
+            float d = coal.vertex[i][axis] - coal.start[axis];
+            along += d * unit[axis];
+            offset_squared += square(d);
+        }
+        offset_squared -= square(along);            // Pythagoras - distance from the chord
+        if ((offset_squared > tolerance_squared) ||
+            (along < previous - coal.tolerance) || (along > chord + coal.tolerance)) {
+            return (false);
+        }
+        previous = along;
+    }
+    return (true);
+}
+
+#if (PLANNER_ARC_BLOCKS == 1)
+/*
+ * _fit_spline() - fit the handle lengths of the curve to the points at their parameters
+ *
+ *  Solves the 2x2 normal equations for the distances of P1 and P2 along the end tangents.
+ *  If they are singular or give a handle pointing backwards, both are set to a third of
+ *  the distance between the end points, which is the usual starting guess.
+ */
+static void _fit_spline(mpSpline_t *s, const float *point[], const float u[], const uint8_t points,
+                        const float tangent_0[], const float tangent_1[])
+{
+    const float *p0 = point[0];
+    const float *p3 = point[points-1];
+    float c00 = 0, c01 = 0, c11 = 0, x0 = 0, x1 = 0;
+    float tangents_dot = 0;
+    for (uint8_t axis = 0; axis < SPLINE_AXES; axis++) {
+        tangents_dot += tangent_0[axis] * tangent_1[axis];
+    }
+    for (uint8_t i = 0; i < points; i++) {
+        float v = 1 - u[i];
+        float b0 = v*v*v, b1 = 3*v*v*u[i], b2 = 3*v*u[i]*u[i], b3 = u[i]*u[i]*u[i];
+        c00 += b1*b1;
+        c01 += b1*b2 * tangents_dot;
+        c11 += b2*b2;
+        for (uint8_t axis = 0; axis < SPLINE_AXES; axis++) {
+            float r = point[i][axis] - (p0[axis] * (b0 + b1) + p3[axis] * (b2 + b3));
+            x0 += b1 * r * tangent_0[axis];
+            x1 += b2 * r * tangent_1[axis];
+        }
+    }
+    float span = 0;
+    for (uint8_t axis = 0; axis < SPLINE_AXES; axis++) {
+        span += square(p3[axis] - p0[axis]);
+    }
+    span = sqrt(span);
+    float det = c00 * c11 - c01 * c01;
+    float alpha_0 = span / 3;
+    float alpha_1 = span / 3;
+    if (fabs(det) > EPSILON) {
+        float a0 = (x0 * c11 - x1 * c01) / det;
+        float a1 = (c00 * x1 - c01 * x0) / det;
+        if ((a0 > EPSILON) && (a1 > EPSILON)) {
+            alpha_0 = a0;
+            alpha_1 = a1;
+        }
+    }
+    for (uint8_t axis = 0; axis < SPLINE_AXES; axis++) {
+        s->p[0][axis] = p0[axis];
+        s->p[1][axis] = p0[axis] + tangent_0[axis] * alpha_0;
+        s->p[2][axis] = p3[axis] + tangent_1[axis] * alpha_1;
+        s->p[3][axis] = p3[axis];
+    }
+}
+
+/*
+ * _get_spline_error_sq() - squared distance of a point from the curve at parameter u
+ */
+static float _get_spline_error_sq(const mpSpline_t *s, const float point[], const float u)
+{
+    float on_curve[SPLINE_AXES];
+    float error_sq = 0;
+    mp_spline_point(s, u, on_curve);
+    for (uint8_t axis = 0; axis < SPLINE_AXES; axis++) {
+        error_sq += square(on_curve[axis] - point[axis]);
+    }
+    return (error_sq);
+}
+
+/*
+ * _is_on_spline() - fit a spline to the start, the first n vertices and end, and test it
+ *
+ *  The curve is only stored in coal.curve if the fit holds, so a failed test leaves the
+ *  pending spline as it was. See the notes at the top of the file.
+ */
+static bool _is_on_spline(const float end[], const uint8_t vertices)
+{
+    if (!cm_spline_block_is_usable()) {
+        return (false);
+    }
+    const uint8_t points = vertices + 2;
+    const float *point[COALESCE_VERTEX_MAX+2];
+    float u[COALESCE_VERTEX_MAX+2];
+    mpSpline_t curve;
+
+    point[0] = coal.start;
+    for (uint8_t i = 0; i < vertices; i++) {
+        point[i+1] = coal.vertex[i];
+    }
+    point[points-1] = end;
+
+    float total = 0;                                // parameters by share of the run's length
+    u[0] = 0;
+    for (uint8_t i = 1; i < points; i++) {
+        for (uint8_t axis = SPLINE_AXES; axis < AXES; axis++) {
+            if (fp_NE(point[i][axis], coal.start[axis])) {
+                return (false);                     // the run moves a rotary axis
+            }
+        }
+        float length_sq = 0;
+        for (uint8_t axis = 0; axis < SPLINE_AXES; axis++) {
+            length_sq += square(point[i][axis] - point[i-1][axis]);
+        }
+        total += sqrt(length_sq);
+        u[i] = total;
+    }
+    if (fp_ZERO(total)) {
+        return (false);
+    }
+    for (uint8_t i = 1; i < points; i++) {
+        u[i] /= total;
+    }
+
+    float tangent_0[SPLINE_AXES];                   // leave along the first move, arrive along the last
+    float tangent_1[SPLINE_AXES];
+    float length_0 = 0;
+    float length_1 = 0;
+    for (uint8_t axis = 0; axis < SPLINE_AXES; axis++) {
+        tangent_0[axis] = point[1][axis] - point[0][axis];
+        tangent_1[axis] = point[points-2][axis] - point[points-1][axis];
+        length_0 += square(tangent_0[axis]);
+        length_1 += square(tangent_1[axis]);
+    }
+    if (fp_ZERO(length_0) || fp_ZERO(length_1)) {
+        return (false);
+    }
+    length_0 = sqrt(length_0);
+    length_1 = sqrt(length_1);
+    for (uint8_t axis = 0; axis < SPLINE_AXES; axis++) {
+        tangent_0[axis] /= length_0;
+        tangent_1[axis] /= length_1;
+    }
+
+    _fit_spline(&curve, point, u, points, tangent_0, tangent_1);
+    for (uint8_t i = 1; i < points-1; i++) {        // Newton step to the closest point of the curve
+        float on_curve[SPLINE_AXES];
+        float d[SPLINE_AXES];
+        float dd[SPLINE_AXES];
+        mp_spline_point(&curve, u[i], on_curve);
+        mp_spline_derivative(&curve, u[i], d);
+        mp_spline_second_derivative(&curve, u[i], dd);
+        float numerator = 0;
+        float denominator = 0;
+        for (uint8_t axis = 0; axis < SPLINE_AXES; axis++) {
+            float r = on_curve[axis] - point[i][axis];
+            numerator += r * d[axis];
+            denominator += d[axis] * d[axis] + r * dd[axis];
+        }
+        if (fabs(denominator) > EPSILON) {
+            u[i] = min(max(u[i] - numerator / denominator, (float)0), (float)1);
+        }
+    }
+    _fit_spline(&curve, point, u, points, tangent_0, tangent_1);
+
+    float tolerance_sq = square(coal.tolerance);
+    for (uint8_t i = 0; i < points-1; i++) {
+        float midpoint[SPLINE_AXES];
+        for (uint8_t axis = 0; axis < SPLINE_AXES; axis++) {
+            midpoint[axis] = (point[i][axis] + point[i+1][axis]) / 2;
+        }
+        if ((_get_spline_error_sq(&curve, midpoint, (u[i] + u[i+1]) / 2) > tolerance_sq) ||
+            ((i > 0) && (_get_spline_error_sq(&curve, point[i], u[i]) > tolerance_sq))) {
+            return (false);
+        }
+    }
+    coal.curve = curve;
+    return (true);
+}
+#endif
+
+/***********************************************************************************
+ * TEXT MODE SUPPORT
+ * Functions to print variables from the cfgArray table
+ ***********************************************************************************/
+
+#ifdef __TEXT_MODE
+
+static const char msg_units0[] = " in";    // used by the units print functions
+static const char msg_units1[] = " mm";
+static const char *const msg_units[] = { msg_units0, msg_units1 };
+
+static const char fmt_coale[] = "[coale] coalescing enable%10d [0=disable,1=enable,2=enable and smooth]\n";
+static const char fmt_coall[] = "[coall] coalesce segment length%9.4f%s\n";
+static const char fmt_coalt[] = "[coalt] coalesce tolerance%14.4f%s\n";
+static const char fmt_coalm[] = "[coalm] coalesce max length%13.3f%s\n";
+static const char fmt_coaln[] = "[coaln] coalesced moves%12d\n";
+
+void mp_print_coale(nvObj_t *nv) { text_print(nv, fmt_coale);}     // TYPE_INT
+void mp_print_coall(nvObj_t *nv) { text_print_flt_units(nv, fmt_coall, GET_UNITS(ACTIVE_MODEL));}
+void mp_print_coalt(nvObj_t *nv) { text_print_flt_units(nv, fmt_coalt, GET_UNITS(ACTIVE_MODEL));}
+void mp_print_coalm(nvObj_t *nv) { text_print_flt_units(nv, fmt_coalm, GET_UNITS(ACTIVE_MODEL));}
+void mp_print_coaln(nvObj_t *nv) { text_print(nv, fmt_coaln);}     // TYPE_INT
+
+#endif // __TEXT_MODE
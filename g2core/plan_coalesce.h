@@ -0,0 +1,95 @@
+/*
+ * plan_coalesce.h - short segment coalescing in front of the line planner
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ *  CAM output often contains long runs of nearly collinear G1 moves that are only a few
+ *  hundredths of a mm long. Each one costs a planner buffer, so the lookahead window fills
+ *  with slivers instead of covering real distance. The coalescer holds back one pending
+ *  feed and extends it with each following short move for as long as every intermediate
+ *  vertex stays within a tolerance of the chord from the start of the run to the new end.
+ *  The merged move carries the Gcode state of the last move absorbed, so the line number
+ *  reported when the block completes is that of the last line it covers.
+ *
+ *  In smoothing mode (coale=2) a run that has left the chord may go on as a spline: the
+ *  vertices are fitted with a cubic Bezier, and the run is extended for as long as the
+ *  fit holds them within the same tolerance. The run is then queued as one spline block.
+ *  This needs spline blocks (PLANNER_ARC_BLOCKS), otherwise coale=2 acts as coale=1.
+ *
+ *  Include after canonical_machine.h and planner.h
+ */
+
+#ifndef PLAN_COALESCE_H_ONCE
+#define PLAN_COALESCE_H_ONCE
+
+#define COALESCE_VERTEX_MAX     16      // max intermediate vertices held in one merged move
+#define COALESCE_TIMEOUT_MS     10      // release a pending move if no new move arrives in this time
+
+typedef struct coalCoalesceSingleton {  // coalescer configuration and pending move
+    magic_t magic_start;
+
+    // configuration
+    uint8_t enable;                     // coale  1 = coalesce short feeds, 2 = and smooth them into splines
+    float segment_length;               // coall  moves shorter than this are candidates (mm)
+    float tolerance;                    // coalt  max deviation of a dropped vertex from the chord (mm)
+    float length_max;                   // coalm  max length of a merged move (mm)
+
+    // pending move
+    bool pending;                       // true if gm holds a move not yet sent to mp_aline()
+    bool spline;                        // true if the pending move is the spline in curve, not a line
+    uint8_t vertex_count;               // number of intermediate vertices in the pending move
+    float start[AXES];                  // start point of the pending move
+    float vertex[COALESCE_VERTEX_MAX][AXES];    // intermediate vertices dropped from the path
+    mpSpline_t curve;                   // fitted curve of a spline move
+    GCodeState_t gm;                    // Gcode state of the last move absorbed
+    Timeout timeout;                    // releases the pending move if input stalls
+
+    uint32_t merged;                    // coaln  count of moves absorbed into other moves
+
+    magic_t magic_end;
+} coal_t;
+extern coal_t coal;
+
+/* coalescer function prototypes */
+
+void   mp_coalesce_init(void);
+void   mp_coalesce_abort(void);
+stat_t mp_coalesce_aline(GCodeState_t *gm_in, const float position[]);
+stat_t mp_coalesce_flush(void);
+stat_t mp_coalesce_callback(void);
+
+/* text mode display functions */
+
+#ifdef __TEXT_MODE
+
+    void mp_print_coale(nvObj_t *nv);
+    void mp_print_coall(nvObj_t *nv);
+    void mp_print_coalt(nvObj_t *nv);
+    void mp_print_coalm(nvObj_t *nv);
+    void mp_print_coaln(nvObj_t *nv);
+
+#else
+
+    #define mp_print_coale tx_print_stub
+    #define mp_print_coall tx_print_stub
+    #define mp_print_coalt tx_print_stub
+    #define mp_print_coalm tx_print_stub
+    #define mp_print_coaln tx_print_stub
+
+#endif // __TEXT_MODE
+
+#endif  // End of include guard: PLAN_COALESCE_H_ONCE
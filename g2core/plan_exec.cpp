@@ -30,21 +30,52 @@
 #include "config.h"
 #include "controller.h"
 #include "planner.h"
+#include "plan_coalesce.h"
+#include "plan_shaper.h"
+#include "plan_spline.h"
+#include "plan_track.h"
+#include "plan_aux.h"
 #include "kinematics.h"
+#include "motion_link.h"
 #include "stepper.h"
 #include "encoder.h"
 #include "report.h"
 #include "util.h"
 #include "spindle.h"
+#include "gpio.h"
+#include "settings.h"
+#include "telemetry.h"
+#include "trace.h"
 #include "xio.h"    //+++++DIAGNOSTIC
+#include "bench.h"
+
+#include <atomic>           // atomic_signal_fence() orders the jog target between main loop and exec
+
+#if MARLIN_COMPAT_ENABLED == true
+#include "marlin_compatibility.h"
+#endif
 
 // execute routines (NB: These are all called from the LO interrupt)
 static stat_t _exec_aline_head(mpBuf_t *bf); // passing bf because body might need it, and it might call body
 static stat_t _exec_aline_body(mpBuf_t *bf); // passing bf so that body can extend itself if the exit velocity rises.
 static stat_t _exec_aline_tail(mpBuf_t *bf);
+static stat_t _exec_aline_hold(mpBuf_t *bf);
+static void _step_hold(const float jerk, const float dt, float *v, float *a);
+static float _get_knob_segment_time(void);
 static stat_t _exec_aline_segment(void);
+static stat_t _exec_jog(void);
+static stat_t _exec_offsets(void);
+static float _get_remaining_length(void);
+#if (PLANNER_ARC_BLOCKS == 1)
+static void _get_arc_point(float target[], const float distance);
+#endif
 
+static void _init_segments(const float section_time, const float segment_usec);
+static void _update_segment_stretch(void);
+static float _get_transition_segment_usec(const float section_time);
 static void _init_forward_diffs(float v_0, float v_1);
+static void _step_segment_velocity(void);
+static void _step_forward_diffs(void);
 
 /*******************************************************************************
  * mp_forward_plan() - plan commands and moves ahead of exec; call ramping for moves
@@ -152,9 +183,10 @@ static void _init_forward_diffs(float v_0, float v_1);
 static mpBuf_t *_plan_commands(mpBuf_t *bf)         // plan or skip commands; return bf past last command
 {
     // must test for buffer state first as the buffer is only "safe" once it's >= PREPPED
-    while ((bf->buffer_state >= MP_BUFFER_PREPPED) && (bf->block_type >= BLOCK_TYPE_COMMAND)) {
+    while ((mp_get_buffer_state(bf) >= MP_BUFFER_PREPPED) && (bf->block_type >= BLOCK_TYPE_COMMAND)) {
         if (bf->buffer_state != MP_BUFFER_PLANNED) {        // skip already planned buffers
-            bf->buffer_state = MP_BUFFER_PLANNED;           // "planning" is just setting the state (for now)
+            mp_set_buffer_state(bf, MP_BUFFER_PLANNED);     // "planning" is just setting the state (for now)
+            bf->plannable = false;                          // a nonstop command is still plannable until here
         }
         bf = bf->nx;
     }
@@ -188,7 +220,7 @@ static stat_t _plan_move(mpBuf_t *bf, float entry_velocity)
     }
 #endif
 
-    bf->buffer_state = MP_BUFFER_PLANNED;           //...here
+    mp_set_buffer_state(bf, MP_BUFFER_PLANNED);     //...here
     bf->plannable = false;
     return (STAT_OK);                               // report that we planned something...
 }
@@ -243,12 +275,23 @@ stat_t mp_forward_plan()
  *  Manages run buffers and other details
  */
 
-stat_t mp_exec_move()
+HOT_PATH stat_t mp_exec_move()
 {
     mpBuf_t *bf;
 
+    sr_mark_dirty(SR_DIRTY_RUNTIME);                        // whatever runs here moves the runtime
+    if (mln.mode == MOTION_LINK_FOLLOWER) {
+        return (mln_exec());                                // run the leader's segments, not the planner's
+    }
+
     // NULL means nothing's running - this is OK
     if ((bf = mp_get_run_buffer()) == NULL) {
+        if (mr.jog.active) {
+            return (_exec_jog());                           // velocity jog runs without a block
+        }
+        if (mp_track_is_running() || mp_aux_is_running()) {
+            return (_exec_offsets());                       // the belt and auxiliary moves run between moves
+        }
         st_prep_null();
         return (STAT_NOOP);
     }
@@ -265,7 +308,7 @@ stat_t mp_exec_move()
                 st_prep_null();
                 return (STAT_NOOP);
             }
-            if (bf->nx->buffer_state < MP_BUFFER_PREPPED) {
+            if (mp_get_buffer_state(bf->nx) < MP_BUFFER_PREPPED) {
                 // This detects buffer starvation, but also can be a single-line "jog" or command
                 // rpt_exception(42, "mp_exec_move() next buffer is empty");
                 // ^^^ CAUSES A CRASH. We can't rpt_exception from here!
@@ -284,14 +327,14 @@ stat_t mp_exec_move()
             }
 
             if (bf->buffer_state == MP_BUFFER_PLANNED) {
-                bf->buffer_state = MP_BUFFER_RUNNING;               // must precede mp_planner_time_acccounting()
+                mp_set_buffer_state(bf, MP_BUFFER_RUNNING);         // must precede mp_planner_time_acccounting()
             } else {
                 return (STAT_NOOP);
             }
             mp_planner_time_accounting();
         }
 
-        if (bf->nx->buffer_state >= MP_BUFFER_PREPPED) {
+        if (mp_get_buffer_state(bf->nx) >= MP_BUFFER_PREPPED) {
             // We go ahead and *ask* for a forward planning of the next move.
             // This won't call mp_plan_move until we leave this function
             // (and have called mp_exec_aline via bf->bf_func).
@@ -398,7 +441,7 @@ stat_t mp_exec_move()
  **
  **** NOTICE ** NOTICE ** NOTICE ****/
 
-stat_t mp_exec_aline(mpBuf_t *bf)
+HOT_PATH stat_t mp_exec_aline(mpBuf_t *bf)
 {
     if (bf->block_state == BLOCK_INACTIVE) {
         return (STAT_NOOP);
@@ -415,16 +458,29 @@ stat_t mp_exec_aline(mpBuf_t *bf)
         }
 
         // Start a new move by setting up the runtime singleton (mr)
-        memcpy(&mr.gm, &(bf->gm), sizeof(GCodeState_t)); // copy in the gcode model state
+        memcpy(&mr.gm, mp_get_block_gm(bf), sizeof(GCodeState_t)); // copy in the shared gcode model state...
+        copy_vector(mr.gm.target, bf->cold->target);     // ...and the block's own target and line number
+        mr.gm.linenum = bf->cold->linenum;
         bf->block_state = BLOCK_ACTIVE;                  // note that this buffer is running
                                                          // note the planner doesn't look at block_state
         mr.block_state = BLOCK_INITIAL_ACTION;
         mr.section = SECTION_HEAD;
         mr.section_state = SECTION_NEW;
+        mr.shaper_settling = false;
 
         // This is the only place in the system where mr.r and mr.p are allowed to be changed
         mr.r = mr.p;        // we are now going to run the planning block
         mr.p = mr.p->nx;    // re-use the old running block as the new planning block
+        trc_block(bf);      // its plan is final now
+        qr_block_start(bf); // ...and it starts to run
+
+        spindle_inline_sync(mr.gm.spindle_speed, mr.gm.spindle_control);   // S (and laser M3/M5) ride on the move
+        if (mr.gm.raster_row >= 0) {
+            spindle_raster_start(mr.gm.raster_row, mr.position, bf->length);
+        }
+        if (mr.gm.output_count > 0) {
+            gpio_sync_start(bf, mr.gm.output_first, mr.gm.output_count);    // M62/M63 changes ride on the move
+        }
 
         // Assumptions that are required for this to work:
         // entry velocity <= cruise velocity && cruise velocity >= exit velocity
@@ -497,14 +553,33 @@ stat_t mp_exec_aline(mpBuf_t *bf)
         }
 
         copy_vector(mr.unit, bf->unit);
-        copy_vector(mr.target, bf->gm.target);          // save the final target of the move
+        copy_vector(mr.target, bf->cold->target);             // save the final target of the move
+        mp.run_time_remaining = mr.r->head_time + mr.r->body_time + mr.r->tail_time;
+        mp.request_estimate = true;                           // this block left the queue estimate
         copy_vector(mr.axis_flags, bf->axis_flags);
 
         // generate the way points for position correction at section ends
-        for (uint8_t axis=0; axis<AXES; axis++) {
-            mr.waypoint[SECTION_HEAD][axis] = mr.position[axis] + mr.unit[axis] * mr.r->head_length;
-            mr.waypoint[SECTION_BODY][axis] = mr.position[axis] + mr.unit[axis] * (mr.r->head_length + mr.r->body_length);
-            mr.waypoint[SECTION_TAIL][axis] = mr.position[axis] + mr.unit[axis] * (mr.r->head_length + mr.r->body_length + mr.r->tail_length);
+#if (PLANNER_ARC_BLOCKS == 1)
+        mr.spline = bf->spline;
+        if ((mr.arc = (bf->arc || bf->spline))) {       // arcs and splines take their way points along the curve
+            if (mr.spline) {
+                mr.spline_geometry = bf->cold->spline;
+                mr.spline_interval = 0;
+            } else {
+                mr.arc_geometry = bf->cold->arc;
+            }
+            copy_vector(mr.arc_start, mr.position);
+            mr.arc_length = bf->length;
+            mr.arc_distance = 0;
+            _get_arc_point(mr.waypoint[SECTION_HEAD], mr.r->head_length);
+            _get_arc_point(mr.waypoint[SECTION_BODY], mr.r->head_length + mr.r->body_length);
+            _get_arc_point(mr.waypoint[SECTION_TAIL], mr.r->head_length + mr.r->body_length + mr.r->tail_length);
+        } else
+#endif
+        {
+            vec_scale_add(mr.waypoint[SECTION_HEAD], mr.position, mr.r->head_length, mr.unit);
+            vec_scale_add(mr.waypoint[SECTION_BODY], mr.position, mr.r->head_length + mr.r->body_length, mr.unit);
+            vec_scale_add(mr.waypoint[SECTION_TAIL], mr.position, mr.r->head_length + mr.r->body_length + mr.r->tail_length, mr.unit);
         }
     }
 
@@ -513,15 +588,11 @@ stat_t mp_exec_aline(mpBuf_t *bf)
 
     // Feedhold Processing - We need to handle the following cases (listed in rough sequence order):
     //  (1) - We have a block midway through normal execution and a new feedhold request
-    //   (1a) - The deceleration will fit in the length remaining in the running block (mr)
-    //   (1b) - The deceleration will not fit in the running block
-    //   (1c) - 1a, except the remaining length would be zero or EPSILON close to zero (unlikely)
+    //        - in the head, body or tail, the stop starts from the runtime as it is
     //  (2) - We have a new block and a new feedhold request that arrived at EXACTLY the same time (unlikely, but handled)
-    //  (3) - We are in the middle of a block
-    //   (3a) - The block is currently accelerating (we wait for the body to start)
-    //   (3b) - The block is currently in the tail (we wait until the end of the block)
-    //  (4) - We have decelerated a block to some velocity > zero (needs continuation in next block)
-    //  (5) - We have decelerated a block to zero velocity
+    //  (3) - The stop is running - see _exec_aline_hold()
+    //  (4) - The stop ran to the end of a block above zero velocity (continues in the next block)
+    //  (5) - The stop has reached zero velocity
     //  (6) - We have finished all the runtime work now we have to wait for the steppers to stop
     //  (7) - The steppers have stopped. No motion should occur
     //  (8) - We are removing the hold state and there is queued motion (handled outside this routine)
@@ -530,12 +601,15 @@ stat_t mp_exec_aline(mpBuf_t *bf)
     if (cm.motion_state == MOTION_HOLD) {
         // Case (7) - all motion has ceased
         if (cm.hold_state == FEEDHOLD_HOLD) {
+            if (mp_track_is_running() || mp_aux_is_running()) {
+                return (_exec_offsets());       // only the belt and a started auxiliary move run
+            }
             return (STAT_NOOP);                 // VERY IMPORTANT to exit as a NOOP. No more movement
         }
 
         // Case (6) - wait for the steppers to stop
         if (cm.hold_state == FEEDHOLD_PENDING) {
-            if (mp_runtime_is_idle()) {                                 // wait for the steppers to actually clear out
+            if (mp_runtime_is_idle() || mp_track_is_idle() || mp_aux_is_idle()) {  // wait for the steppers to actually clear out
                 if ((cm.cycle_state == CYCLE_HOMING) || (cm.cycle_state == CYCLE_PROBE)) {
                     // when homing, we don't need to stay in HOLD
                     cm.hold_state = FEEDHOLD_OFF;
@@ -546,15 +620,36 @@ stat_t mp_exec_aline(mpBuf_t *bf)
                 sr_request_status_report(SR_REQUEST_IMMEDIATE);         // was SR_REQUEST_TIMED
                 cs.controller_state = CONTROLLER_READY;                 // remove controller readline() PAUSE
             }
+            if (mp_track_is_running() || mp_aux_is_running()) {
+                return (_exec_offsets());                               // the belt keeps moving
+            }
             return (STAT_OK);                                           // hold here. No more movement
         }
 
         // Case (5) - decelerated to zero
-        // Update the run buffer then force a replan of the whole planner queue
+        // Update the run buffer then revert its forward plan so it restarts from zero
         if (cm.hold_state == FEEDHOLD_DECEL_END) {
+            mr.hold_stop = false;
             mr.block_state = BLOCK_INACTIVE;                                    // invalidate mr buffer to reset the new move
             bf->block_state = BLOCK_INITIAL_ACTION;                             // tell _exec to re-use the bf buffer
-            bf->length = get_axis_vector_length(mr.target, mr.position);// reset length
+            bf->length = _get_remaining_length();                       // reset length
+#if (PLANNER_ARC_BLOCKS == 1)
+            if (mr.spline) {                                            // restart the spline from here
+                mpSpline_t *spline = &bf->cold->spline;
+                mp_spline_split(spline, mp_spline_parameter(&mr.spline_geometry, mr.arc_distance, &mr.spline_interval));
+                bf->length = spline->length[SPLINE_INTERVALS];
+                mp_spline_unit(spline, 0, bf->unit);
+            } else if (mr.arc) {                                        // restart the arc from here
+                float fraction = mr.arc_distance / mr.arc_length;
+                mpArc_t *arc = &bf->cold->arc;
+                arc->theta += arc->angular_travel * fraction;
+                arc->radius += arc->radius_delta * fraction;
+                arc->angular_travel *= (1 - fraction);
+                arc->radius_delta *= (1 - fraction);
+                arc->linear_travel *= (1 - fraction);
+                mp_get_arc_unit(arc, 0, bf->unit);
+            }
+#endif
             //bf->entry_vmax = 0;                                         // set bp+0 as hold point
 
             cm.hold_state = FEEDHOLD_PENDING;
@@ -564,54 +659,18 @@ stat_t mp_exec_aline(mpBuf_t *bf)
                 mp_free_run_buffer();
             }
 
-            mp_replan_queue(mb.r);                                      // make it replan all the blocks
+            mp_replan_queue(mb.r);                                      // forward plan again from here. Back-planning stands
 
             return (STAT_OK);
         }
 
-        // Cases (1a, 1b), Case (2), Case (4)
-        // Build a tail-only move from here. Decelerate as fast as possible in the space we have.
-        if ((cm.hold_state == FEEDHOLD_SYNC) ||
-            ((cm.hold_state == FEEDHOLD_DECEL_CONTINUE) && (mr.block_state == BLOCK_INITIAL_ACTION))) {
-
-            // Case (3a) - already decelerating, continue the deceleration.
-            if (mr.section == SECTION_TAIL) {   // if already in a tail don't decelerate. You already are
-                if (fp_ZERO(mr.r->exit_velocity)) {
-                    cm.hold_state = FEEDHOLD_DECEL_TO_ZERO;
-                } else {
-                    cm.hold_state = FEEDHOLD_DECEL_CONTINUE;
-                }
-
-            // Case (3b) - currently accelerating - is simply skipped and waited for
-            // Small exception, if we *just started* the head, then we're not actually accelerating yet.
-            } else if ((mr.section != SECTION_HEAD) || (mr.section_state == SECTION_NEW)) {
-                mr.entry_velocity = mr.segment_velocity;
-
-                mr.section = SECTION_TAIL;
-                mr.section_state = SECTION_NEW;
-
-                mr.r->head_length = 0;
-                mr.r->body_length = 0;
-
-                float available_length = get_axis_vector_length(mr.target, mr.position);
-                mr.r->tail_length = mp_get_target_length(0, mr.r->cruise_velocity, bf);  // braking length
-
-                if (fp_ZERO(available_length - mr.r->tail_length)) {    // (1c) the deceleration time is almost exactly the remaining of the current move
-                    cm.hold_state = FEEDHOLD_DECEL_TO_ZERO;
-                    mr.r->tail_length = available_length;
-                    mr.r->exit_velocity = 0;
-
-                } else if (available_length < mr.r->tail_length) {      // (1b) the deceleration has to span multiple moves
-                    cm.hold_state = FEEDHOLD_DECEL_CONTINUE;
-                    mr.r->tail_length = available_length;
-                    mr.r->exit_velocity = mp_get_decel_velocity(mr.r->cruise_velocity, mr.r->tail_length, bf);
-
-                } else {                                                // (1a)the deceleration will fit into the current move
-                    cm.hold_state = FEEDHOLD_DECEL_TO_ZERO;
-                    mr.r->exit_velocity = 0;
-                }
-                mr.r->tail_time = mr.r->tail_length*2 / (mr.r->exit_velocity + mr.r->cruise_velocity);
-            }
+        // Cases (1), (2) - stop from the velocity and acceleration of the last segment
+        if (cm.hold_state == FEEDHOLD_SYNC) {
+            mr.hold_stop = true;
+            mr.hold_velocity = mr.last_velocity;
+            mr.hold_accel = mr.segment_accel;
+            bf->plannable = false;                                  // the plan of this block no longer runs
+            cm.hold_state = (mr.shaper_settling) ? FEEDHOLD_DECEL_TO_ZERO : FEEDHOLD_DECEL_CONTINUE;
         }
     }
 
@@ -621,7 +680,8 @@ stat_t mp_exec_aline(mpBuf_t *bf)
 
     //**** main dispatcher to process segments ***
     stat_t status = STAT_OK;
-         if (mr.section == SECTION_HEAD) { status = _exec_aline_head(bf);}
+         if (mr.hold_stop)               { status = _exec_aline_hold(bf);}
+    else if (mr.section == SECTION_HEAD) { status = _exec_aline_head(bf);}
     else if (mr.section == SECTION_BODY) { status = _exec_aline_body(bf);}
     else if (mr.section == SECTION_TAIL) { status = _exec_aline_tail(bf);}
     else    { return(cm_panic(STAT_INTERNAL_ERROR, "exec_aline()"));}    // never supposed to get here
@@ -658,8 +718,33 @@ stat_t mp_exec_aline(mpBuf_t *bf)
         mr.entry_velocity     = mr.r->exit_velocity;     // feed the old exit into the entry.
 
         if (bf->block_state == BLOCK_ACTIVE) {
+            mpJobStats_t *job = &mp.job;
+            if (job->active) {                                  // add the completed block to the job summary
+                job->blocks++;
+                job->motion_time += job->block_time * 60;
+                job->length += job->block_length;
+                if (bf->cruise_vset > EPSILON) {
+                    job->commanded_time += job->block_length / bf->cruise_vset * 60;
+                    if (bf->cruise_vset > job->peak_commanded) { job->peak_commanded = bf->cruise_vset; }
+                }
+                job->block_time = 0;
+                job->block_length = 0;
+            }
+#if BENCH_ENABLED == true
+            if (bench.running) {
+                bench.blocks++;
+            }
+#endif
+            if (mr.gm.raster_row >= 0) {
+                spindle_raster_end(mr.gm.raster_row);       // frees the row for the next one
+            }
+            if (mr.gm.output_count > 0) {
+                gpio_sync_end();
+            }
+
             if (mp_free_run_buffer()) { // returns true of the buffer is empty
-                if (cm.hold_state == FEEDHOLD_OFF) {
+                if ((cm.hold_state == FEEDHOLD_OFF) && !coal.pending) { // a pending move continues the cycle
+                    mp_record_starvation();                     // count it if the host fell behind
                     cm_cycle_end();    // free buffer & end cycle if planner is empty
                 }
             } else {
@@ -682,6 +767,7 @@ stat_t mp_exec_aline(mpBuf_t *bf)
 void mp_exit_hold_state()
 {
     cm.hold_state = FEEDHOLD_OFF;
+    mr.hold_stop = false;
     if (mp_has_runnable_buffer()) {
         cm_set_motion_state(MOTION_RUN);
         sr_request_status_report(SR_REQUEST_IMMEDIATE);
@@ -690,6 +776,242 @@ void mp_exit_hold_state()
     }
 }
 
+/*
+ * mp_jog_start()     - start a velocity jog toward a target velocity vector (mm/min)
+ * mp_jog_velocity()  - change the target velocity of a running jog
+ * mp_jog_stop()      - ramp a running jog to a stop. Safe to call from an ISR
+ * mp_jog_is_active() - true until the jog has run its last segment
+ *
+ *  Start only with nothing in the planner and the runtime idle - the jog runs on from
+ *  mr.position. Feedholds, limits and other stops end a jog through mp_jog_stop(), and
+ *  the jerk sets the stopping distance just as it does for a hold.
+ */
+
+void mp_jog_start(const float velocity[])
+{
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        mr.jog.velocity[axis] = 0;
+        mr.jog.accel[axis] = 0;
+        mr.jog.target[axis] = velocity[axis];
+        mr.jog.jerk[axis] = cm.a[axis].jerk_max * JERK_MULTIPLIER;
+        mr.jog.travel_min[axis] = cm.soft_limit_min[axis];
+        mr.jog.travel_max[axis] = cm.soft_limit_max[axis];
+    }
+    mr.jog.update = false;
+    mr.jog.stop = false;
+    mr.jog.active = true;
+    cm_set_motion_state(MOTION_RUN);
+    st_request_exec_move();
+}
+
+void mp_jog_velocity(const float velocity[])
+{
+    mr.jog.update = false;                          // exec can't take it while it's being written
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        mr.jog.pending[axis] = velocity[axis];
+    }
+    std::atomic_signal_fence(std::memory_order_release);
+    mr.jog.update = true;
+}
+
+void mp_jog_stop() { mr.jog.stop = true; }
+
+bool mp_jog_is_active() { return (mr.jog.active); }
+
+/*
+ * _exec_jog() - run one segment of a velocity jog
+ *
+ *  Each axis is stepped toward its target velocity with the acceleration its jerk allows:
+ *  the acceleration moves by at most jerk*dt per segment, and never exceeds the acceleration
+ *  from which the jerk can still bring it to zero as the velocity reaches the target. An
+ *  axis closing on a soft limit is given a zero target once it is within its stopping
+ *  distance, and is clipped at the limit so it can never run over it.
+ */
+
+static stat_t _exec_jog()
+{
+    if (mr.jog.update && !mr.jog.stop) {
+        std::atomic_signal_fence(std::memory_order_acquire);
+        copy_vector(mr.jog.target, mr.jog.pending);
+        mr.jog.update = false;
+    }
+    const float dt = NOM_SEGMENT_TIME;
+    float target[AXES];
+    float length_sq = 0;
+    bool moving = false;
+
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        float v = mr.jog.velocity[axis];
+        float a = mr.jog.accel[axis];
+        float j = mr.jog.jerk[axis];
+        float v_target = (mr.jog.stop) ? 0 : mr.jog.target[axis];
+
+        if (v_target * v > 0) {                             // stopping distance from v is v*sqrt(v/j)
+            float remaining = (v > 0) ? (mr.jog.travel_max[axis] - mr.position[axis])
+                                      : (mr.position[axis] - mr.jog.travel_min[axis]);
+            if (remaining <= fabs(v) * (fast_sqrt(fabs(v) / j) + dt)) {
+                v_target = 0;
+            }
+        }
+        float dv = v_target - v;
+        float a_bound = copysignf(fast_sqrt(2 * j * fabs(dv)), dv);
+        float da = j * dt;
+        if (a_bound > a + da) {
+            a += da;
+        } else if (a_bound < a - da) {
+            a -= da;
+        } else {
+            a = a_bound;
+        }
+        v += a * dt;
+        if (((dv > 0) && (v > v_target)) || ((dv < 0) && (v < v_target)) || fp_ZERO(dv)) {
+            v = v_target;                                   // arrived - don't overshoot
+            a = 0;
+        }
+
+        target[axis] = mr.position[axis] + v * dt;
+        if (target[axis] > mr.jog.travel_max[axis]) {
+            target[axis] = max(mr.jog.travel_max[axis], mr.position[axis]);
+            v = 0;
+            a = 0;
+        } else if (target[axis] < mr.jog.travel_min[axis]) {
+            target[axis] = min(mr.jog.travel_min[axis], mr.position[axis]);
+            v = 0;
+            a = 0;
+        }
+        mr.jog.velocity[axis] = v;
+        mr.jog.accel[axis] = a;
+        length_sq += v * v;
+        if ((v != 0) || (a != 0) || (v_target != 0)) {
+            moving = true;
+        }
+    }
+
+    if (!moving) {                                          // target is zero and every axis has stopped
+        mr.jog.active = false;
+        mr.segment_velocity = 0;
+        mp_shaper_reset(mr.position);                       // jogs are not shaped - start from here
+        cm_set_motion_state(MOTION_STOP);
+        st_prep_null();
+        return (STAT_NOOP);
+    }
+
+    float start[AXES];                                      // the segment on the machine - with any tracking
+    float end[AXES];
+    copy_vector(start, mr.position);
+    copy_vector(end, target);
+    mp_track_segment(dt, start, end);
+    mp_aux_segment(dt, start, end);
+
+    float travel_steps[MOTORS];
+    float following_error[MOTORS] = {0};                    // no step correction while jogging
+    copy_vector(mr.position_steps, mr.target_steps);
+    kn_inverse_kinematics(end, mr.target_steps);
+    for (uint8_t m=0; m<MOTORS; m++) {
+        travel_steps[m] = mr.target_steps[m] - mr.position_steps[m];
+    }
+    mr.segment_time = dt;
+    mr.segment_velocity = fast_sqrt(length_sq);
+    mln_send_segment(start, end, dt);
+    ritorno(st_prep_line(travel_steps, following_error, dt));
+    copy_vector(mr.position, target);
+    tlm_sample();
+    return (STAT_OK);
+}
+
+/*
+ * _exec_offsets() - run one segment of conveyor tracking and auxiliary moves with no move
+ *
+ *  See plan_track.h and plan_aux.h. The position stands still, so the segment moves only the
+ *  offsets. Shaping is at rest whenever no move is running, so the position is also the
+ *  shaped position.
+ */
+
+static stat_t _exec_offsets()
+{
+    const float dt = NOM_SEGMENT_TIME;
+    float start[AXES];
+    float end[AXES];
+    copy_vector(start, mr.position);
+    copy_vector(end, mr.position);
+    mp_track_idle_segment(dt, start, end);
+    mp_aux_idle_segment(dt, start, end);
+
+    float travel_steps[MOTORS];
+    float following_error[MOTORS] = {0};                    // the offsets set the position, not the encoders
+    copy_vector(mr.position_steps, mr.target_steps);
+    kn_inverse_kinematics(end, mr.target_steps);
+    for (uint8_t m=0; m<MOTORS; m++) {
+        travel_steps[m] = mr.target_steps[m] - mr.position_steps[m];
+    }
+    mr.segment_time = dt;
+    mln_send_segment(start, end, dt);
+    return (st_prep_line(travel_steps, following_error, dt));
+}
+
+/*
+ * _init_segments() - set the segment count and segment time for a new section
+ *
+ *  section_time - time of the section (minutes)
+ *  segment_usec - target segment time (microseconds)
+ *
+ *  Section time is divided into whole segments no longer than the target. If that would
+ *  make the segments shorter than MIN_SEGMENT_MS (only possible for targets less than
+ *  twice the minimum) the count is rounded down instead, so segments run a little long.
+ *
+ *  The target is stretched while the exec runs late - see _update_segment_stretch(), and
+ *  shrunk by the feed override knob so the segments still run about as long as the target
+ *  - see _get_knob_segment_time().
+ */
+
+static void _init_segments(const float section_time, const float segment_usec)
+{
+    _update_segment_stretch();
+    float section_usec = uSec(section_time);
+    mr.segments = ceil(section_usec / (segment_usec * mr.segment_stretch * mr.knob_factor));
+    if ((section_usec / mr.segments) < (MIN_SEGMENT_USEC * mr.knob_factor)) {
+        mr.segments = max(floor(section_usec / (MIN_SEGMENT_USEC * mr.knob_factor)), (float)1.0);
+    }
+    mr.segment_count = (uint32_t)mr.segments;
+    mr.segment_time = section_time / mr.segments;                   // time to advance for each segment
+}
+
+/*
+ * _update_segment_stretch() - lengthen segments while the loader starves - see stepper.h
+ *
+ *  Every section the loader starved in since the last one grows the stretch by
+ *  SEGMENT_STRETCH_STEP, up to {sgx:}. Every section it didn't shrinks it back toward 1 by
+ *  SEGMENT_STRETCH_DECAY, so it eases off slower than it builds. Counters cleared
+ *  by {clc:} are taken as they are.
+ */
+
+static void _update_segment_stretch()
+{
+    uint32_t underruns = st_pre.underruns;
+    float stretch_max = max(cm.segment_stretch_max, (float)1.0);
+
+    if (underruns > mr.underruns_seen) {
+        mr.segment_stretch = min(mr.segment_stretch * SEGMENT_STRETCH_STEP, stretch_max);
+    } else {
+        mr.segment_stretch = min(max(mr.segment_stretch / SEGMENT_STRETCH_DECAY, (float)1.0), stretch_max);
+    }
+    mr.underruns_seen = underruns;
+}
+
+/*
+ * _get_transition_segment_usec() - target segment time for a head or tail
+ *
+ *  Long transitions use the nominal segment time. A short head or tail is a steep one -
+ *  for a given velocity change the time scales as 1/sqrt(jerk) - so it is divided into
+ *  at least TRANSITION_SEGMENTS_MIN segments, down to the minimum segment time, to keep
+ *  the velocity steps between segments small where acceleration changes fastest.
+ */
+
+static float _get_transition_segment_usec(const float section_time)
+{
+    return (min(max(uSec(section_time) / TRANSITION_SEGMENTS_MIN, MIN_SEGMENT_USEC), NOM_SEGMENT_USEC));
+}
+
 /*
  * Forward difference math explained:
  *
@@ -791,11 +1113,58 @@ void mp_exit_hold_state()
  *        F_1 = 120Ah^5
  *
  *  Note that with our current control points, D and E are actually 0.
+ *
+ *  Fixed point option (FORWARD_DIFFS_FIXED_POINT == 1)
+ *
+ *  The float differences lose precision as a long head or tail is stepped: each add rounds
+ *  to 24 bits, and rounding in F_1 reaches the velocity through four more levels of sums.
+ *  On the SAM3X (no FPU) each of those adds is also a soft-float call. The fixed point
+ *  option computes the initial differences in float as above, then runs the iteration as
+ *  int64 adds and shifts. The velocity is Q32.32. Each difference gets its own binary point,
+ *  chosen from a bound on its magnitude over the whole curve. For
+ *  V(t) = P_i + (P_t - P_i)(10t^3 - 15t^4 + 6t^5) the largest derivative is the 5th,
+ *  720|P_t - P_i|, so |F_n| <= 720|P_t - P_i| h^(6-n). Doubling that gives the bound used
+ *  to place each binary point just under bit 62. Lower levels are smaller, so they carry
+ *  more fraction bits, and each add shifts the lower level down to the binary point of the
+ *  one above it. The result depends only on the float inputs, so it repeats bit for bit,
+ *  and the velocity carries about 2^-32 mm/min of rounding per segment.
+ *
+ *  S-curve option (MOTION_PROFILE_ORDER == 3)
+ *
+ *  The jerk is +Jm for the first half of the ramp and -Jm for the second, so with
+ *  s(t) = 2t^2 for t < 1/2 and 1 - 2(1-t)^2 after it, V(t) = P_i + (P_t - P_i) s(t). The ramp
+ *  takes 2 sqrt(|P_t - P_i|/Jm), against 2.4 sqrt(|P_t - P_i|/Jm) for the quintic with the
+ *  same peak jerk, but its acceleration peaks 28% higher and the jerk is a step at each end
+ *  and at the midpoint. Each half is a parabola, so a segment is one add of F_5 to V and one
+ *  add of F_4 = 4(P_t - P_i)h^2 to F_5 (subtracted in the second half). The one or two
+ *  differences that span the midpoint are neither, so they are worked out up front from s(t)
+ *  and set as the midpoint is passed. The S-curve iterates in float whatever
+ *  FORWARD_DIFFS_FIXED_POINT is: with two levels there is little rounding to carry.
  */
 
+#if (MOTION_PROFILE_ORDER == 3)
+static inline float _get_scurve(const float t)
+{
+    return ((t < 0.5) ? (2 * t * t) : (1 - 2 * (1 - t) * (1 - t)));
+}
+#endif
+
 // Total time: 147us
-static void _init_forward_diffs(const float v_0, const float v_1)
+HOT_PATH static void _init_forward_diffs(const float v_0, const float v_1)
 {
+#if (MOTION_PROFILE_ORDER == 3)
+    const float h  = 1/(mr.segments);
+    const float dv = v_1 - v_0;
+    const float peak = (float)(mr.segment_count / 2);   // segments left at the first step over the midpoint
+    const float t_peak = (mr.segments - peak - 0.5) * h; // V of the segment before that step
+
+    mr.scurve_peak = mr.segment_count / 2;
+    mr.scurve_peak_diff[0] = dv * (_get_scurve(t_peak + h) - _get_scurve(t_peak));
+    mr.scurve_peak_diff[1] = dv * (_get_scurve(t_peak + 2 * h) - _get_scurve(t_peak + h));
+    mr.forward_diff_4 = 4 * dv * h * h;
+    mr.forward_diff_5 = dv * (_get_scurve(1.5 * h) - _get_scurve(0.5 * h));
+    mr.segment_velocity = v_0 + dv * _get_scurve(0.5 * h);  // V(h/2)
+#else
     // Times from *here*
 /* Full formulation:
      const float fifth_T        = T * 0.2; //(1/5) T
@@ -863,6 +1232,62 @@ static void _init_forward_diffs(const float v_0, const float v_1)
     const float half_Ah_5 = A * half_h_5;
 
     mr.segment_velocity = half_Ah_5 + half_Bh_4 + half_Ch_3 + v_0;
+
+#if (FORWARD_DIFFS_FIXED_POINT == 1)
+    const float diff[5] = { mr.forward_diff_1, mr.forward_diff_2, mr.forward_diff_3, mr.forward_diff_4, mr.forward_diff_5 };
+    int8_t shift[6];                                    // binary point of F_1..F_5, then the velocity
+    shift[5] = FIXED_VELOCITY_SHIFT;
+
+    float bound = 1440.0 * fabs(v_1 - v_0);             // 2 * 720 |P_t - P_i|
+    for (int8_t i = 4; i >= 0; i--) {                   // F_5 down to F_1
+        bound *= h;                                     // |F_n| <= bound * h^(6-n)
+        int exponent;
+        frexpf(bound, &exponent);                       // bound < 2^exponent
+        shift[i] = min(max(61 - exponent, (int)shift[i+1]), shift[i+1] + 62);
+        mr.fixed_shift[i] = shift[i] - shift[i+1];
+        mr.fixed_diff[i] = (int64_t)ldexpf(diff[i], shift[i]);
+    }
+    mr.fixed_velocity = (int64_t)ldexpf(mr.segment_velocity, FIXED_VELOCITY_SHIFT);
+#endif
+#endif // MOTION_PROFILE_ORDER
+}
+
+/*
+ * _step_segment_velocity() - advance the segment velocity by F_5
+ * _step_forward_diffs()    - advance F_5 through F_2 by the level below
+ */
+
+HOT_PATH static void _step_segment_velocity()
+{
+#if (FORWARD_DIFFS_FIXED_POINT == 1) && (MOTION_PROFILE_ORDER != 3)
+    mr.fixed_velocity += mr.fixed_diff[4] >> mr.fixed_shift[4];
+    mr.segment_velocity = (float)mr.fixed_velocity * (float)(1.0 / 4294967296.0);  // 2^-FIXED_VELOCITY_SHIFT
+#else
+    mr.segment_velocity += mr.forward_diff_5;
+#endif
+}
+
+HOT_PATH static void _step_forward_diffs()
+{
+#if (MOTION_PROFILE_ORDER == 3)
+    if (mr.segment_count > mr.scurve_peak) {
+        mr.forward_diff_5 += mr.forward_diff_4;             // first half - acceleration rising
+    } else if (mr.segment_count + 1 >= mr.scurve_peak) {
+        mr.forward_diff_5 = mr.scurve_peak_diff[mr.scurve_peak - mr.segment_count];
+    } else {
+        mr.forward_diff_5 -= mr.forward_diff_4;             // second half - acceleration falling
+    }
+#elif (FORWARD_DIFFS_FIXED_POINT == 1)
+    mr.fixed_diff[4] += mr.fixed_diff[3] >> mr.fixed_shift[3];
+    mr.fixed_diff[3] += mr.fixed_diff[2] >> mr.fixed_shift[2];
+    mr.fixed_diff[2] += mr.fixed_diff[1] >> mr.fixed_shift[1];
+    mr.fixed_diff[1] += mr.fixed_diff[0] >> mr.fixed_shift[0];
+#else
+    mr.forward_diff_5 += mr.forward_diff_4;
+    mr.forward_diff_4 += mr.forward_diff_3;
+    mr.forward_diff_3 += mr.forward_diff_2;
+    mr.forward_diff_2 += mr.forward_diff_1;
+#endif
 }
 
 /*********************************************************************************************
@@ -878,9 +1303,7 @@ static stat_t _exec_aline_head(mpBuf_t *bf)
             mr.section = SECTION_BODY;
             return(_exec_aline_body(bf));                            // skip ahead to the body generator
         }
-        mr.segments = ceil(uSec(mr.r->head_time) / NOM_SEGMENT_USEC);// # of segments for the section
-        mr.segment_count = (uint32_t)mr.segments;
-        mr.segment_time = mr.r->head_time / mr.segments;             // time to advance for each segment
+        _init_segments(mr.r->head_time, _get_transition_segment_usec(mr.r->head_time));
 
         if (mr.segment_count == 1) {
             // We will only have one segment, simply average the velocities
@@ -888,14 +1311,14 @@ static stat_t _exec_aline_head(mpBuf_t *bf)
         } else {
             _init_forward_diffs(mr.entry_velocity, mr.r->cruise_velocity); // <-- sets inital segment_velocity
         }
-        if (mr.segment_time < MIN_SEGMENT_TIME) {
+        if (mr.segment_time < (MIN_SEGMENT_TIME * mr.knob_factor)) {
             _debug_trap("mr.segment_time < MIN_SEGMENT_TIME");
             return(STAT_OK);                                        // exit without advancing position, say we're done
         }
         mr.section = SECTION_HEAD;
         mr.section_state = SECTION_RUNNING;
     } else {
-        mr.segment_velocity += mr.forward_diff_5;
+        _step_segment_velocity();
     }
 
     if (_exec_aline_segment() == STAT_OK) {                     // set up for second half
@@ -906,10 +1329,7 @@ static stat_t _exec_aline_head(mpBuf_t *bf)
         mr.section = SECTION_BODY;
         mr.section_state = SECTION_NEW;
     } else if (!first_pass) {
-        mr.forward_diff_5 += mr.forward_diff_4;
-        mr.forward_diff_4 += mr.forward_diff_3;
-        mr.forward_diff_3 += mr.forward_diff_2;
-        mr.forward_diff_2 += mr.forward_diff_1;
+        _step_forward_diffs();
     }
     return(STAT_EAGAIN);
 }
@@ -918,7 +1338,9 @@ static stat_t _exec_aline_head(mpBuf_t *bf)
  * _exec_aline_body()
  *
  *    The body is broken into little segments even though it is a straight line so that
- *    feed holds can happen in the middle of a line with a minimum of latency
+ *    feed holds can happen in the middle of a line with a minimum of latency. Velocity is
+ *    constant, so the segments are as long as MAX_SEGMENT_MS allows - this bounds the hold
+ *    latency and keeps the exec load during long cruises down.
  */
 static stat_t _exec_aline_body(mpBuf_t *bf)
 {
@@ -928,18 +1350,23 @@ static stat_t _exec_aline_body(mpBuf_t *bf)
             return(_exec_aline_tail(bf));                   // skip ahead to tail periods
         }
 
-        float body_time = mr.r->body_time;
-        mr.segments = ceil(uSec(body_time) / NOM_SEGMENT_USEC);
-        mr.segment_time = body_time / mr.segments;
+        _init_segments(mr.r->body_time, MAX_SEGMENT_USEC);
         mr.segment_velocity = mr.r->cruise_velocity;
-        mr.segment_count = (uint32_t)mr.segments;
-        if (mr.segment_time < MIN_SEGMENT_TIME) {
+        if (mr.segment_time < (MIN_SEGMENT_TIME * mr.knob_factor)) {
             _debug_trap("mr.segment_time < MIN_SEGMENT_TIME");
             return(STAT_OK);                                // exit without advancing position, say we're done
         }
 
         mr.section = SECTION_BODY;
         mr.section_state = SECTION_RUNNING;                 // uses PERIOD_2 so last segment detection works
+    } else if (mr.segment_count > 1) {                      // the knob turned mid-cruise - recut the rest
+        float segment_time = MAX_SEGMENT_TIME * mr.segment_stretch * min(mr.knob_factor, mr.knob_target);
+        if ((mr.segment_time > segment_time) || (mr.segment_time < segment_time / 2)) {
+            float remaining = mr.segment_count * mr.segment_time;
+            mr.segments = ceil(remaining / segment_time);
+            mr.segment_count = (uint32_t)mr.segments;
+            mr.segment_time = remaining / mr.segments;
+        }
     }
     if (_exec_aline_segment() == STAT_OK) {                 // OK means this section is done
         if (fp_ZERO(mr.r->tail_length)) {
@@ -953,10 +1380,17 @@ static stat_t _exec_aline_body(mpBuf_t *bf)
 
 /*********************************************************************************************
  * _exec_aline_tail()
+ *
+ *    A tail that ends at zero velocity runs on for mp_shaper_settle_segments() segments
+ *    that hold the target, so the shaped position comes to rest on it before the move
+ *    ends. None are run if no axis is shaped.
  */
 
 static stat_t _exec_aline_tail(mpBuf_t *bf)
 {
+    if (mr.shaper_settling) {
+        return(_exec_aline_segment());                          // STAT_OK when the shaper is at rest
+    }
     bool first_pass = false;
     if (mr.section_state == SECTION_NEW) {                          // INITIALIZATION
         first_pass = true;
@@ -965,16 +1399,14 @@ static stat_t _exec_aline_tail(mpBuf_t *bf)
         bf->plannable = false;
 
         if (fp_ZERO(mr.r->tail_length)) { return(STAT_OK);}         // end the move
-        mr.segments = ceil(uSec(mr.r->tail_time) / NOM_SEGMENT_USEC);// # of segments for the section
-        mr.segment_count = (uint32_t)mr.segments;
-        mr.segment_time = mr.r->tail_time / mr.segments;             // time to advance for each segment
+        _init_segments(mr.r->tail_time, _get_transition_segment_usec(mr.r->tail_time));
 
         if (mr.segment_count == 1) {
             mr.segment_velocity = mr.r->tail_length / mr.segment_time;
         } else {
             _init_forward_diffs(mr.r->cruise_velocity, mr.r->exit_velocity); // <-- sets inital segment_velocity
         }
-        if (mr.segment_time < MIN_SEGMENT_TIME) {
+        if (mr.segment_time < (MIN_SEGMENT_TIME * mr.knob_factor)) {
             _debug_trap("mr.segment_time < MIN_SEGMENT_TIME");
             return(STAT_OK);                                        // exit without advancing position, say we're done
          // return(STAT_MINIMUM_TIME_MOVE);                         // exit without advancing position
@@ -982,20 +1414,263 @@ static stat_t _exec_aline_tail(mpBuf_t *bf)
         mr.section = SECTION_TAIL;
         mr.section_state = SECTION_RUNNING;
     } else {
-        mr.segment_velocity += mr.forward_diff_5;
+        _step_segment_velocity();
     }
 
     if (_exec_aline_segment() == STAT_OK) {
+        if (fp_ZERO(mr.r->exit_velocity) && ((mr.segment_count = mp_shaper_settle_segments()) > 0)) {
+            mr.shaper_settling = true;
+            mr.segment_time = NOM_SEGMENT_TIME * mr.knob_factor;
+            mr.segment_velocity = 0;
+            return(STAT_EAGAIN);
+        }
         return(STAT_OK);                                        // STAT_OK completes the move
     } else if (!first_pass) {
-        mr.forward_diff_5 += mr.forward_diff_4;
-        mr.forward_diff_4 += mr.forward_diff_3;
-        mr.forward_diff_3 += mr.forward_diff_2;
-        mr.forward_diff_2 += mr.forward_diff_1;
+        _step_forward_diffs();
+    }
+    return(STAT_EAGAIN);
+}
+
+/*********************************************************************************************
+ * _exec_aline_hold() - run a feedhold's stop from the live velocity and acceleration
+ *
+ *    The stop is not planned into the block. Each segment steps the velocity toward zero at
+ *    the block's jerk (_step_hold()), from the velocity and acceleration of the last segment
+ *    before the hold - so it starts right away, even part way up a head, and is the shortest
+ *    jerk-limited stop from there. The planned profile is a stop from the same place, so the
+ *    velocity stays under it and under the junction limits ahead.
+ *
+ *    The stop runs along the block's path and on through as many queued blocks as it takes,
+ *    without replanning them. The last segment of a block is stretched or shrunk to end on
+ *    its end. A block planned to end at zero velocity ends the stop there. Once stopped the
+ *    input shaper settles as it does after a tail, and Case (5) in mp_exec_aline() takes over.
+ */
+
+static stat_t _exec_aline_hold(mpBuf_t *bf)
+{
+    if (mr.shaper_settling) {
+        return(_exec_aline_segment());                          // STAT_OK when the shaper is at rest
+    }
+    bf->plannable = false;
+
+    float remaining = _get_remaining_length();
+    float dt = NOM_SEGMENT_TIME * mr.knob_factor;
+    float v = mr.hold_velocity;
+    float a = mr.hold_accel;
+    _step_hold(bf->jerk, dt, &v, &a);
+    float length = (mr.hold_velocity + v) * dt / 2;
+
+    bool stopped = fp_ZERO(v);
+    if ((!stopped || (length >= remaining)) && (remaining < length * 1.5)) {   // last segment of the block
+        dt = max(remaining * 2 / (mr.hold_velocity + v), MIN_SEGMENT_TIME * mr.knob_factor);
+        v = mr.hold_velocity;
+        a = mr.hold_accel;
+        _step_hold(bf->jerk, dt, &v, &a);
+        length = remaining;
+        stopped = (fp_ZERO(v) || fp_ZERO(bf->exit_velocity));   // stop at a block planned to stop
+        mr.segment_count = 1;                                   // ...and finish the block
+    } else {
+        mr.segment_count = 2;                                   // keep the block running
+    }
+    mr.segment_time = dt;
+    mr.segment_velocity = length / dt;
+    stat_t status = _exec_aline_segment();
+    if ((status != STAT_OK) && (status != STAT_EAGAIN)) {
+        return (status);
+    }
+    mr.hold_velocity = v;
+    mr.hold_accel = a;
+
+    if (stopped) {
+        cm.hold_state = FEEDHOLD_DECEL_TO_ZERO;
+        mr.r->exit_velocity = 0;
+        if ((mr.segment_count = mp_shaper_settle_segments()) > 0) {
+            mr.shaper_settling = true;
+            mr.segment_time = NOM_SEGMENT_TIME * mr.knob_factor;
+            mr.segment_velocity = 0;
+            return(STAT_EAGAIN);
+        }
+        return(STAT_OK);
+    }
+    if (status == STAT_OK) {                                    // end of the block - the stop goes on in the next
+        mr.r->exit_velocity = v;
+        return(STAT_OK);
     }
     return(STAT_EAGAIN);
 }
 
+/*
+ * _step_hold() - take the velocity and acceleration of a stop one segment toward zero
+ *
+ *  As _exec_jog() steps toward its target: the acceleration moves by at most jerk * dt a
+ *  segment toward the most braking that still reaches zero at zero acceleration.
+ */
+
+static void _step_hold(const float jerk, const float dt, float *v, float *a)
+{
+    float a_bound = -fast_sqrt(2 * jerk * max(*v, (float)0.0));
+    float da = jerk * dt;
+    if (a_bound > *a + da) {
+        *a += da;
+    } else if (a_bound < *a - da) {
+        *a -= da;
+    } else {
+        *a = a_bound;
+    }
+    *v += *a * dt;
+    if (*v < EPSILON) {
+        *v = 0;                                                 // stopped - don't reverse
+        *a = 0;
+    }
+}
+
+/*
+ * _get_knob_segment_time() - time to run the segment in at the feed override knob's factor
+ *
+ *  The knob {mfok:} slows the planned motion down rather than replanning it. A segment
+ *  planned to take segment_time runs in segment_time / factor, so every velocity of the
+ *  move is scaled by the factor from the next segment on, with no replan and no traffic.
+ *  The knob is read once per segment, and the factor follows it on a ramp whose jerk
+ *  takes it through its whole range in FEED_OVERRIDE_RAMP_TIME. M49 turns it off.
+ *
+ *  The factor is at most 1, as the plan already runs at the machine's limits, and at
+ *  least FEED_OVERRIDE_MIN. Sections are cut into segments for the factor they start at
+ *  (_init_segments()), and the body is cut again as the knob turns, so segments still run
+ *  between MIN_SEGMENT_TIME and MAX_SEGMENT_TIME. A head or tail can only run at factors
+ *  that keep its segments in that range, so beyond them the ramp waits for the next
+ *  section. The factor is exactly 1 with no knob, and a segment then runs in segment_time.
+ */
+
+HOT_PATH static float _get_knob_segment_time()
+{
+    float target = 1.0;
+    if (cm.mfo_knob_enable && cm.gmx.m48_enable) {
+        float position = gpio_read_override_knob();
+        if (position >= 0) {
+            target = FEED_OVERRIDE_MIN + (1 - FEED_OVERRIDE_MIN) * min(position / (float)FEED_OVERRIDE_KNOB_FULL, (float)1.0);
+        }
+    }
+    if ((target == 1.0) || (fabs(target - mr.knob_target) > FEED_OVERRIDE_KNOB_DEADBAND)) {
+        mr.knob_target = target;
+    }
+    if ((mr.knob_factor == mr.knob_target) && (mr.knob_rate == 0)) {
+        return ((mr.knob_factor == 1.0) ? mr.segment_time : (mr.segment_time / mr.knob_factor));
+    }
+
+    // step toward the target as _exec_jog() steps an axis' velocity, within the range the
+    // segment time allows
+    const float dt = mr.segment_time / mr.knob_factor;
+    const float j = FEED_OVERRIDE_KNOB_JERK;
+    const float factor_min = mr.segment_time / MAX_SEGMENT_TIME;
+    const float factor_max = min(mr.segment_time / MIN_SEGMENT_TIME, (float)1.0);
+    float dk = min(max(mr.knob_target, factor_min), factor_max) - mr.knob_factor;
+    float r_bound = copysignf(fast_sqrt(2 * j * fabs(dk)), dk);
+    float dr = j * dt;
+    if (r_bound > mr.knob_rate + dr) {
+        mr.knob_rate += dr;
+    } else if (r_bound < mr.knob_rate - dr) {
+        mr.knob_rate -= dr;
+    } else {
+        mr.knob_rate = r_bound;
+    }
+    float factor = mr.knob_factor + mr.knob_rate * dt;
+    if (((dk > 0) && (factor > mr.knob_factor + dk)) || ((dk < 0) && (factor < mr.knob_factor + dk)) || fp_ZERO(dk)) {
+        factor = mr.knob_factor + dk;                           // arrived - don't overshoot
+        mr.knob_rate = 0;
+    }
+    if ((factor < factor_min) || (factor > factor_max)) {
+        factor = min(max(factor, factor_min), factor_max);      // ran on past the range - stop at its edge
+        mr.knob_rate = 0;
+    }
+    mr.knob_factor = factor;
+    return (mr.segment_time / mr.knob_factor);
+}
+
+/*
+ * _get_remaining_length() - length left to run in the current block
+ * _get_arc_point()        - point on the running arc or spline a distance from the start of the block
+ *
+ *  The arc radius moves from start to end radius along the way, so the arc ends exactly
+ *  on the target even if the Gcode end point was a little off the circle. A spline is
+ *  looked up in its arc length table (see plan_spline.cpp).
+ */
+
+static float _get_remaining_length()
+{
+#if (PLANNER_ARC_BLOCKS == 1)
+    if (mr.arc) {
+        return (max(mr.arc_length - mr.arc_distance, (float)0));
+    }
+#endif
+    return (get_axis_vector_length(mr.target, mr.position));
+}
+
+#if (PLANNER_ARC_BLOCKS == 1)
+static void _get_arc_point(float target[], const float distance)
+{
+    if (mr.spline) {
+        for (uint8_t axis=0; axis<AXES; axis++) {      // axes not in the spline stay put
+            target[axis] = mr.arc_start[axis];
+        }
+        float u = mp_spline_parameter(&mr.spline_geometry, distance, &mr.spline_interval);
+        mp_spline_point(&mr.spline_geometry, u, target);
+        return;
+    }
+    const mpArc_t *arc = &mr.arc_geometry;
+    float fraction = min(distance / mr.arc_length, (float)1);
+    float theta = arc->theta + arc->angular_travel * fraction;
+    float radius = arc->radius + arc->radius_delta * fraction;
+
+    for (uint8_t axis=0; axis<AXES; axis++) {          // axes not in the arc stay put
+        target[axis] = mr.arc_start[axis];
+    }
+    target[arc->plane_axis_0] = arc->center_0 + sin(theta) * radius;
+    target[arc->plane_axis_1] = arc->center_1 + cos(theta) * radius;
+    target[arc->linear_axis] += arc->linear_travel * fraction;
+}
+#endif
+
+/*********************************************************************************************
+ * Pressure advance - Marlin mode extruders
+ *
+ * _get_extruder_advance()   - offsets of the extruders for the segment about to run
+ * mp_reset_extruder_advance() - forget the offsets, once the steps are set from the position
+ *
+ *  In Marlin mode A and B are the extruders (E with T0 and T1). Pressure in the hot end lags
+ *  the extruder, so each is run ahead of its planned position by K {pa:} times its velocity:
+ *  more filament while accelerating, less while decelerating. The offset only goes into the
+ *  steps - mr.position stays as planned - so it unwinds as the velocity falls. The last
+ *  segment of a move that stops takes no offset, so a stop leaves none behind.
+ *
+ *  The velocity is the segment's own, so no planner buffers or look ahead are involved.
+ */
+
+#if MARLIN_COMPAT_ENABLED == true
+
+static float extruder_advance[2];           // offsets of A and B in the last segment's target steps
+
+static void _get_extruder_advance(float advance[])
+{
+    float velocity = mr.segment_velocity * (mst.pressure_advance / 60); // seconds * mm/min
+    if ((mr.segment_count == 0) && (mr.section == SECTION_TAIL) && fp_ZERO(mr.r->exit_velocity)) {
+        velocity = 0;
+    }
+    advance[0] = mr.unit[AXIS_A] * velocity;
+    advance[1] = mr.unit[AXIS_B] * velocity;
+}
+
+void mp_reset_extruder_advance()
+{
+    extruder_advance[0] = 0;
+    extruder_advance[1] = 0;
+}
+
+#else
+
+void mp_reset_extruder_advance() {}
+
+#endif // MARLIN_COMPAT_ENABLED == true
+
 /*********************************************************************************************
  * _exec_aline_segment() - segment runner helper
  *
@@ -1004,6 +1679,11 @@ static stat_t _exec_aline_tail(mpBuf_t *bf)
  *  The commanded_steps are the target_steps delayed by one more segment.
  *  This lines them up in time with the encoder readings so a following error can be generated
  *
+ *  Exec may run up to PREP_BUFFERS segments ahead of the loader, and the encoder only counts
+ *  segments that have finished. So the delay is one more segment for each line segment that
+ *  is prepped but not yet loaded, taken from the delayed_steps history. The count and the
+ *  encoder are read again if a load slips in between them.
+ *
  *  The following_error term is positive if the encoder reading is greater than (ahead of)
  *  the commanded steps, and negative (behind) if the encoder reading is less than the
  *  commanded steps. The following error is not affected by the direction of movement -
@@ -1016,7 +1696,7 @@ static stat_t _exec_aline_tail(mpBuf_t *bf)
  *         -100        -90           -10        encoder is 10 steps behind commanded steps
  */
 
-static stat_t _exec_aline_segment()
+HOT_PATH static stat_t _exec_aline_segment()
 {
     float travel_steps[MOTORS];
 
@@ -1025,8 +1705,19 @@ static stat_t _exec_aline_segment()
     // Otherwise if not at a section waypoint compute target from segment time and velocity
     // Don't do waypoint correction if you are going into a hold.
 
-    if ((--mr.segment_count == 0) && (cm.motion_state != MOTION_HOLD)) {
+#if (PLANNER_ARC_BLOCKS == 1)
+    if (mr.arc) {
+        mr.arc_distance += mr.segment_velocity * mr.segment_time;
+    }
+#endif
+    if (mr.shaper_settling) {
+        --mr.segment_count;                                 // the target stays put while the shaper settles
+    } else if ((--mr.segment_count == 0) && (cm.motion_state != MOTION_HOLD)) {
         copy_vector(mr.gm.target, mr.waypoint[mr.section]);
+#if (PLANNER_ARC_BLOCKS == 1)
+    } else if (mr.arc) {
+        _get_arc_point(mr.gm.target, mr.arc_distance);
+#endif
     } else {
         float segment_length = mr.segment_velocity * mr.segment_time;
         // see https://en.wikipedia.org/wiki/Kahan_summation_algorithm
@@ -1050,26 +1741,113 @@ static stat_t _exec_aline_segment()
     //       Other kinematics may require transforming travel distance as opposed to simply subtracting steps.
 
 
+    uint8_t queued;
+    do {
+        queued = st_prep_lines_queued();                    // segments the encoder has yet to see
+        for (uint8_t m=0; m<MOTORS; m++) {
+            mr.encoder_steps[m] = en_read_encoder(m);       // get current encoder position (time aligns to commanded_steps)
+        }
+    } while (queued != st_prep_lines_queued());
+
     for (uint8_t m=0; m<MOTORS; m++) {
-        mr.commanded_steps[m] = mr.position_steps[m];       // previous segment's position, delayed by 1 segment
+        for (uint8_t i=PREP_BUFFERS-1; i>0; i--) {
+            mr.delayed_steps[i][m] = mr.delayed_steps[i-1][m];
+        }
+        mr.delayed_steps[0][m] = mr.position_steps[m];      // previous segment's position, delayed by 1 segment
+#if (KINEMATICS_MIDPOINT == 1)
+        for (uint8_t i=PREP_BUFFERS-1; i>0; i--) {          // the history is kept per prep slot, and the
+            mr.delayed_steps[i][m] = mr.delayed_steps[i-1][m];  // previous segment ran as two slots
+        }
+        mr.delayed_steps[0][m] = mr.midpoint_steps[m];
+#endif
+        mr.commanded_steps[m] = mr.delayed_steps[queued][m];// ...and by 1 more for each segment waiting to load
         mr.position_steps[m] = mr.target_steps[m];          // previous segment's target becomes position
-        mr.encoder_steps[m] = en_read_encoder(m);           // get current encoder position (time aligns to commanded_steps)
-        mr.following_error[m] = mr.encoder_steps[m] - mr.commanded_steps[m];
+        mr.following_error[m] = mr.encoder_steps[m] - mr.commanded_steps[m] - st_pre.mot[m].backlash_counted;
     }
-    kn_inverse_kinematics(mr.gm.target, mr.target_steps);   // now determine the target steps...
+    float dt = _get_knob_segment_time();                    // the time the segment runs in
+    float position[AXES];                                   // shaped start and end of the segment
+    float target[AXES];
+    mp_shaper_step(mr.gm.target, dt, position, target);
+    mp_track_segment(dt, position, target);                 // the tracked axis follows the belt
+    mp_aux_segment(dt, position, target);                   // auxiliary axes run their own moves
+#if MARLIN_COMPAT_ENABLED == true
+    float advance[2];                                       // run the extruders ahead
+    _get_extruder_advance(advance);
+    target[AXIS_A] += advance[0];
+    target[AXIS_B] += advance[1];
+#endif
+#if (KINEMATICS_MIDPOINT == 1)
+    // Non-linear kinematics: solve the midpoint too, so the segment's chordal error in joint
+    // space is that of a segment half as long. Each half is stepped at its own constant rate.
+    float midpoint[AXES];
+    float travel_steps_2[MOTORS];
+    for (uint8_t a=0; a<AXES; a++) {
+        midpoint[a] = (position[a] + target[a]) * 0.5;
+    }
+#if MARLIN_COMPAT_ENABLED == true
+    midpoint[AXIS_A] += extruder_advance[0] * 0.5;          // the previous target was run ahead too
+    midpoint[AXIS_B] += extruder_advance[1] * 0.5;
+#endif
+    copy_vector(mr.midpoint_steps, mr.position_steps);      // unmapped motors stay put
+    kn_inverse_kinematics(midpoint, mr.midpoint_steps);
+#endif
+    kn_inverse_kinematics(target, mr.target_steps);         // now determine the target steps...
+#if MARLIN_COMPAT_ENABLED == true
+    extruder_advance[0] = advance[0];
+    extruder_advance[1] = advance[1];
+#endif
     for (uint8_t m=0; m<MOTORS; m++) {                      // and compute the distances to be traveled
+#if (KINEMATICS_MIDPOINT == 1)
+        travel_steps[m] = mr.midpoint_steps[m] - mr.position_steps[m];
+        travel_steps_2[m] = mr.target_steps[m] - mr.midpoint_steps[m];
+#else
         travel_steps[m] = mr.target_steps[m] - mr.position_steps[m];
+#endif
     }
 
     // Update the mb->run_time_remaining -- we know it's missing the current segment's time before it's loaded, that's ok.
-    mp.run_time_remaining -= mr.segment_time;
+    mp.run_time_remaining -= dt;
     if (mp.run_time_remaining < 0) {
         mp.run_time_remaining = 0.0;
     }
 
     // Call the stepper prep function
-    ritorno(st_prep_line(travel_steps, mr.following_error, mr.segment_time));
+#if (KINEMATICS_MIDPOINT == 1)
+    mln_send_segment(position, midpoint, dt/2);             // followers run the halves as segments
+    mln_send_segment(midpoint, target, dt/2);
+    ritorno(st_prep_line_split(travel_steps, travel_steps_2, mr.following_error, dt));
+#else
+    mln_send_segment(position, target, dt);
+    ritorno(st_prep_line(travel_steps, mr.following_error, dt));
+#endif
+    float laser_scale = 0;                                  // laser mode: power in proportion to velocity
+    if ((mr.gm.motion_mode != MOTION_MODE_STRAIGHT_TRAVERSE) && (mr.r->cruise_velocity > 0)) {
+        laser_scale = mr.segment_velocity * mr.knob_factor / mr.r->cruise_velocity;  // ...and off for traverses
+        if (mr.gm.raster_row >= 0) {
+            laser_scale *= spindle_raster_power(mr.position, mr.gm.target);     // ...and by the pixel
+        }
+    }
+    if (mr.gm.output_count > 0) {
+        uint16_t set, clear;
+        if (gpio_sync_segment(mr.segment_velocity * mr.segment_time, &set, &clear)) {
+            st_prep_outputs(set, clear);
+        }
+    }
+    float laser_duty = spindle_laser_duty(laser_scale);
+    if (laser_duty >= 0) {
+        st_prep_laser_duty(laser_duty);
+    }
     copy_vector(mr.position, mr.gm.target);                 // update position from target
+    mr.segment_accel = (mr.segment_velocity - mr.last_velocity) / mr.segment_time;
+    mr.last_velocity = mr.segment_velocity;                 // where a hold starts from
+    tlm_sample();                                           // pass the new position to the host
+
+    if (mp.job.active) {                                    // job summary - see mp_job_start()
+        mp.job.segments++;
+        mp.job.block_time += dt;
+        mp.job.block_length += mr.segment_velocity * mr.segment_time;
+        if (mr.segment_velocity * mr.knob_factor > mp.job.peak_feed) { mp.job.peak_feed = mr.segment_velocity * mr.knob_factor; }
+    }
     if (mr.segment_count == 0) {
         return (STAT_OK);                                   // this section has run all its segments
     }
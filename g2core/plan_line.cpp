@@ -31,7 +31,12 @@
 #include "controller.h"
 #include "canonical_machine.h"
 #include "planner.h"
+#include "plan_coalesce.h"
+#include "plan_lookahead.h"
+#include "plan_spline.h"
+#include "plan_sync.h"
 #include "stepper.h"
+#include "kinematics.h"
 #include "report.h"
 #include "util.h"
 #include "spindle.h"
@@ -50,16 +55,29 @@ extern OutputPin<kDebug3_PinNumber> debug_pin3;
 
 // planner helper functions
 static mpBuf_t* _plan_block(mpBuf_t* bf);
+static float _get_override_factor(const mpBuf_t* bf);
+static void _set_override(mpBuf_t* bf, const float override_factor);
 static void _calculate_override(mpBuf_t* bf);
-static void _calculate_jerk(mpBuf_t* bf);
-static void _calculate_vmaxes(mpBuf_t* bf, const float axis_length[], const float axis_square[]);
-static void _calculate_junction_vmax(mpBuf_t* bf);
+static void _rotate_target(const float target[], float target_rotated[]);
+static float _get_axis_recip_jerk(const GCodeState_t* gm, const uint8_t axis);
+static void _calculate_jerk_terms(mpJerk_t* j, const float jerk);
+static void _set_jerk_terms(mpBuf_t* bf, const mpJerk_t* j);
+static void _calculate_vmaxes(mpBuf_t* bf, const GCodeState_t* gm, const float axis_length[], const float axis_square[], float* recip_jerk);
+static float _get_axis_step_time(const uint8_t axis, const float length);
+static void _calculate_junction_vmax(mpBuf_t* bf, const mpBuf_t* nx);
+static void _plan_block_backward(mpBuf_t* bf, float braking_velocity);
+static float _get_curve_vmax(const mpBuf_t* bf, const mpBuf_t* nx);
+static mpBuf_t* _get_motion_pv(mpBuf_t* bf);
+static mpBuf_t* _get_motion_nx(mpBuf_t* bf);
+static void _set_nonstop_exit_vmax(const mpBuf_t* pv, const mpBuf_t* nx);
+static void _prime_preplanned(mpBuf_t* bf);
+static mpBuf_t* _replan_blocks(mpBuf_t* bf, uint8_t blocks, const bool limits);
+static bool _set_block_limits(mpBuf_t* bf, const float entry_velocity);
 
 //+++++DIAGNOSTICS
 #pragma GCC optimize("O0")  // this pragma is required to force the planner to actually set these unused values
 //#pragma GCC reset_options
 static void _set_bf_diagnostics(mpBuf_t* bf) {
-    bf->linenum = bf->gm.linenum;
 //  UPDATE_BF_DIAGNOSTICS(bf);   //+++++
 }
 #pragma GCC reset_options
@@ -113,7 +131,8 @@ bool mp_get_runtime_busy()
     if (cm.cycle_state == CYCLE_OFF) {
         return (false);
     }
-    if ((st_runtime_isbusy() == true) || (mr.block_state == BLOCK_ACTIVE) || (mb.r->buffer_state > MP_BUFFER_EMPTY)) {
+    if ((st_runtime_isbusy() == true) || (mr.block_state == BLOCK_ACTIVE) || (mb.r->buffer_state > MP_BUFFER_EMPTY) ||
+        (mr.jog.active == true)) {
         return (true);
     }
     return (false);
@@ -147,6 +166,8 @@ stat_t mp_aline(GCodeState_t* gm_in)
     float length_square = 0;
     float length;
 
+    ritorno(mp_coalesce_flush());   // a move held by the coalescer must be queued first
+
     // A few notes about the rotated coordinate space:
     // These are positions PRE-rotation:
     //  gm_in.* (anything in gm_in)
@@ -166,23 +187,7 @@ stat_t mp_aline(GCodeState_t* gm_in)
     //  c being target[2],
     //  x_1 being cm.rotation_matrix[1][0]
 
-    target_rotated[0] = gm_in->target[0] * cm.rotation_matrix[0][0] + 
-                        gm_in->target[1] * cm.rotation_matrix[0][1] +
-                        gm_in->target[2] * cm.rotation_matrix[0][2];
-
-    target_rotated[1] = gm_in->target[0] * cm.rotation_matrix[1][0] + 
-                        gm_in->target[1] * cm.rotation_matrix[1][1] +
-                        gm_in->target[2] * cm.rotation_matrix[1][2];
-
-    target_rotated[2] = gm_in->target[0] * cm.rotation_matrix[2][0] + 
-                        gm_in->target[1] * cm.rotation_matrix[2][1] +
-                        gm_in->target[2] * cm.rotation_matrix[2][2] + 
-                        cm.rotation_z_offset;
-
-    // copy rotation axes ABC
-    target_rotated[3] = gm_in->target[3];
-    target_rotated[4] = gm_in->target[4];
-    target_rotated[5] = gm_in->target[5];
+    _rotate_target(gm_in->target, target_rotated);
 
     for (uint8_t axis = 0; axis < AXES; axis++) {
         axis_length[axis] = target_rotated[axis] - mp.position[axis];
@@ -193,7 +198,7 @@ stat_t mp_aline(GCodeState_t* gm_in)
             axis_length[axis] = 0;  // make it truly zero if it was tiny
         }
     }
-    length = sqrt(length_square);
+    length = fast_sqrt(length_square);
 
     // exit if the move has zero movement. At all.
     if (fp_ZERO(length)) {
@@ -205,28 +210,413 @@ stat_t mp_aline(GCodeState_t* gm_in)
     if ((bf = mp_get_write_buffer()) == NULL) {         // never supposed to fail
         return (cm_panic(STAT_FAILED_GET_PLANNER_BUFFER, "aline()"));
     }
-    memcpy(&bf->gm, gm_in, sizeof(GCodeState_t));
-    // Since bf->gm.target is being used all over the place, we'll make it the rotated target
-    copy_vector(bf->gm.target, target_rotated);  // copy the rotated taget in place
+    ritorno(mp_share_gm(bf, gm_in));                    // share the modal state with the previous block if possible
+    copy_vector(bf->cold->target, target_rotated);      // the block target is the rotated target
 
     // setup the buffer
     bf->bf_func = mp_exec_aline;                        // register the callback to the exec function
     bf->length  = length;                               // record the length
+    float recip_length = 1 / length;
     for (uint8_t axis = 0; axis < AXES; axis++) {       // compute the unit vector and set flags
         if ((bf->axis_flags[axis] = flags[axis])) {     // yes, this is supposed to be = and not ==
-            bf->unit[axis] = axis_length[axis] / length;// nb: bf-> unit was cleared by mp_get_write_buffer()
+            bf->unit[axis] = axis_length[axis] * recip_length;  // nb: bf-> unit was cleared by mp_get_write_buffer()
         }
     }
-    _calculate_jerk(bf);                              // compute bf->jerk values
-    _calculate_vmaxes(bf, axis_length, axis_square);  // compute cruise_vmax and absolute_vmax
+    float recip_jerk = 0;
+    _calculate_vmaxes(bf, gm_in, axis_length, axis_square, &recip_jerk); // compute cruise_vmax, absolute_vmax and jerk
+    mpJerk_t j;
+    _calculate_jerk_terms(&j, JERK_MULTIPLIER / recip_jerk);  // goose it!
+    _set_jerk_terms(bf, &j);
     _set_bf_diagnostics(bf);                          //+++++DIAGNOSTIC
 
     // Note: these next lines must remain in exact order. Position must update before committing the buffer.
-    copy_vector(mp.position, bf->gm.target);   // set the planner position
+    copy_vector(mp.position, bf->cold->target);   // set the planner position
     mp_commit_write_buffer(BLOCK_TYPE_ALINE);  // commit current block (must follow the position update)
     return (STAT_OK);
 }
 
+/*
+ * mp_aline_arc() - plan an arc segment with precomputed geometry
+ *
+ *  gm_in  - Gcode state with the unrotated segment target, as for mp_aline()
+ *  unit   - unrotated unit vector of the segment
+ *  length - segment length. Rotation is rigid, so this is the same in either frame
+ *  jerk   - jerk terms for the whole arc, from mp_calculate_arc_jerk()
+ *
+ *  The arc generator steps the segment direction around the arc incrementally and every
+ *  segment of an arc has the same length, so the square roots and per-axis divisions in
+ *  mp_aline() are not needed. After that the block is set up exactly as mp_aline() does.
+ */
+
+stat_t mp_aline_arc(GCodeState_t* gm_in, const float unit[], const float length, const mpJerk_t* jerk)
+{
+    mpBuf_t* bf;
+    float target_rotated[AXES];
+    float unit_rotated[AXES];
+    float axis_length[AXES];
+    float axis_square[AXES] = {0, 0, 0, 0, 0, 0};
+
+    if (fp_ZERO(length)) {
+        return (mp_aline(gm_in));                       // let mp_aline() deal with it
+    }
+    ritorno(mp_coalesce_flush());                       // a move held by the coalescer must be queued first
+
+    _rotate_target(gm_in->target, target_rotated);
+    for (uint8_t axis = 0; axis < AXES; axis++) {       // rotate the unit vector - no Z offset for vectors
+        unit_rotated[axis] = (axis < 3) ? (unit[0] * cm.rotation_matrix[axis][0] +
+                                           unit[1] * cm.rotation_matrix[axis][1] +
+                                           unit[2] * cm.rotation_matrix[axis][2]) : unit[axis];
+    }
+
+    if ((bf = mp_get_write_buffer()) == NULL) {         // never supposed to fail
+        return (cm_panic(STAT_FAILED_GET_PLANNER_BUFFER, "aline_arc()"));
+    }
+    ritorno(mp_share_gm(bf, gm_in));
+    copy_vector(bf->cold->target, target_rotated);
+
+    bf->bf_func = mp_exec_aline;
+    bf->length  = length;
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        axis_length[axis] = unit_rotated[axis] * length;
+        if ((bf->axis_flags[axis] = fp_NOT_ZERO(axis_length[axis]))) {
+            bf->unit[axis] = unit_rotated[axis];
+            axis_square[axis] = square(axis_length[axis]);
+        } else {
+            axis_length[axis] = 0;
+        }
+    }
+    _set_jerk_terms(bf, jerk);
+    _calculate_vmaxes(bf, gm_in, axis_length, axis_square, nullptr);
+    _set_bf_diagnostics(bf);
+
+    // Note: these next lines must remain in exact order. Position must update before committing the buffer.
+    copy_vector(mp.position, bf->cold->target);
+    mp_commit_write_buffer(BLOCK_TYPE_ALINE);
+    return (STAT_OK);
+}
+
+/*
+ * mp_aline_planned() - queue a line whose velocities were planned by the host
+ *
+ *  gm_in           - Gcode state, as for mp_aline()
+ *  cruise_velocity - the velocity the host planned the block to cruise at (mm/min)
+ *  exit_velocity   - the velocity the host planned it to exit at (mm/min)
+ *  horizon         - blocks that must be queued behind this one before it may run
+ *
+ *  A host running the same planner with a deeper look-ahead sends the velocities its own
+ *  back-planning pass settled on, and this block skips that pass here. The host picks the
+ *  horizon so those blocks hold enough length to stop from exit_velocity; the block is only
+ *  released to the runtime once they have arrived (see _prime_preplanned()). If the host
+ *  falls behind, sends a non-preplanned block, or sends velocities the block can't meet,
+ *  the unreleased blocks are back-planned here like any others (mp_end_preplanned()).
+ *
+ *  The forward plan (ramps) is still done just-in-time by the exec from these velocities,
+ *  so feedholds and overrides work as for any other block.
+ */
+
+stat_t mp_aline_planned(GCodeState_t* gm_in, const float cruise_velocity, const float exit_velocity, const uint8_t horizon)
+{
+    if ((cruise_velocity < 0) || (exit_velocity < 0)) {
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    if (horizon > PREPLAN_HORIZON_MAX) {
+        return (STAT_INPUT_EXCEEDS_MAX_VALUE);
+    }
+    ritorno(mp_aline(gm_in));
+
+    mpBuf_t* bf = mb.w->pv;             // the block just committed. It is primed by the planner callback
+    bf->preplanned      = true;
+    bf->preplan_horizon = horizon;
+    bf->cruise_velocity = cruise_velocity;
+    bf->exit_velocity   = exit_velocity;
+    return (STAT_OK);
+}
+
+/*
+ * mp_sync_line() - queue a spindle synchronized move (G33) or rigid tap (G33.1)
+ *
+ *  gm_in - Gcode state with the target of the move, or the bottom of the tap
+ *  pitch - travel per spindle turn (mm)
+ *  tap   - true to tap to the target and back out to the start
+ *
+ *  The block is not velocity planned - the spindle sets the feed - so it's a non-motion
+ *  block to the planner and the moves on either side of it stop. It only carries the
+ *  line, the feed limit of its slowest axis in absolute_vmax and its jerk, and the exec
+ *  runs it from the spindle encoder (see mp_exec_sync()).
+ */
+
+stat_t mp_sync_line(GCodeState_t* gm_in, const float pitch, const bool tap)
+{
+    mpBuf_t* bf;
+    float target_rotated[AXES];
+    float axis_length[AXES];
+    float length_square = 0;
+
+    ritorno(mp_coalesce_flush());                       // a move held by the coalescer must be queued first
+
+    _rotate_target(gm_in->target, target_rotated);
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        axis_length[axis] = target_rotated[axis] - mp.position[axis];
+        if (fp_NOT_ZERO(axis_length[axis])) {
+            length_square += square(axis_length[axis]);
+        } else {
+            axis_length[axis] = 0;
+        }
+    }
+    float length = fast_sqrt(length_square);
+    if (fp_ZERO(length)) {
+        return (STAT_MINIMUM_LENGTH_MOVE);
+    }
+
+    if ((bf = mp_get_write_buffer()) == NULL) {         // never supposed to fail
+        return (cm_panic(STAT_FAILED_GET_PLANNER_BUFFER, "sync_line()"));
+    }
+    ritorno(mp_share_gm(bf, gm_in));
+    copy_vector(bf->cold->target, target_rotated);
+
+    bf->bf_func = mp_exec_sync;
+    bf->length  = length;
+    bf->absolute_vmax = 8675309;
+    float recip_jerk = 0;
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        if ((bf->axis_flags[axis] = (axis_length[axis] != 0))) {
+            bf->unit[axis] = axis_length[axis] / length;
+            bf->absolute_vmax = min(bf->absolute_vmax, cm.a[axis].feedrate_max / fabs(bf->unit[axis]));
+            recip_jerk = max(recip_jerk, fabs(bf->unit[axis]) * _get_axis_recip_jerk(gm_in, axis));
+        }
+    }
+    mpJerk_t j;
+    _calculate_jerk_terms(&j, JERK_MULTIPLIER / recip_jerk);
+    _set_jerk_terms(bf, &j);
+    bf->sync_pitch = pitch;
+    bf->sync_tap = tap;
+
+    if (!tap) {                                         // a tap ends where it started
+        copy_vector(mp.position, bf->cold->target);
+    }
+    mp_commit_write_buffer(BLOCK_TYPE_SYNC);
+    return (STAT_OK);
+}
+
+#if (PLANNER_ARC_BLOCKS == 1)
+/*
+ * mp_arc() - plan an arc (or helix) as a single block
+ *
+ *  gm_in  - Gcode state with the arc target
+ *  arc    - arc geometry, set up by cm_arc_feed(). Must be in the planner frame, so the
+ *           caller only uses arc blocks when no coordinate rotation is active
+ *  length - length of the arc or helix
+ *
+ *  The block is planned like a line of the same length with these differences:
+ *    - bf->unit is the tangent at the start, cold->arc.exit_unit the tangent at the end.
+ *      Junctions are computed from these (see _calculate_junction_vmax())
+ *    - the jerk is the lowest any point on the arc allows (mp_calculate_arc_jerk())
+ *    - the axis limits are taken against the full planar length in each plane axis
+ *    - the cruise is limited so the jerk of the centripetal acceleration stays within the
+ *      plane axes' jerk: moving at v on radius r, the centripetal acceleration v^2/r turns
+ *      at v/r, which is a jerk of v^3/r^2. So v <= cbrt(jerk * r^2). On a helix only the
+ *      planar share of v turns, so the limit is cbrt(jerk * r^2) over that share
+ *
+ *  Exec interpolates along the arc (see mp_exec_aline()) so no chordal error is added.
+ */
+
+stat_t mp_arc(GCodeState_t* gm_in, const mpArc_t* arc, const float length)
+{
+    mpBuf_t* bf;
+    float axis_length[AXES] = {0, 0, 0, 0, 0, 0};
+    float axis_square[AXES] = {0, 0, 0, 0, 0, 0};
+    float unit_bound[AXES]  = {0, 0, 0, 0, 0, 0};
+    mpJerk_t jerk;
+
+    if (fp_ZERO(length)) {
+        return (STAT_MINIMUM_LENGTH_MOVE);
+    }
+    ritorno(mp_coalesce_flush());                       // a move held by the coalescer must be queued first
+
+    if ((bf = mp_get_write_buffer()) == NULL) {         // never supposed to fail
+        return (cm_panic(STAT_FAILED_GET_PLANNER_BUFFER, "arc()"));
+    }
+    ritorno(mp_share_gm(bf, gm_in));
+    _rotate_target(gm_in->target, bf->cold->target);
+    bf->cold->arc = *arc;
+    bf->arc = true;
+
+    bf->bf_func = mp_exec_aline;
+    bf->length  = length;
+    mp_get_arc_unit(arc, 0, bf->unit);
+    mp_get_arc_unit(arc, 1, bf->cold->arc.exit_unit);
+
+    float planar_length = fabs(arc->angular_travel) * (arc->radius + arc->radius_delta/2);
+    axis_length[arc->plane_axis_0] = planar_length;     // the most either plane axis may travel
+    axis_length[arc->plane_axis_1] = planar_length;
+    axis_length[arc->linear_axis] = arc->linear_travel;
+    axis_square[arc->plane_axis_0] = square(planar_length); // so feed time is for the path length
+    axis_square[arc->linear_axis] = square(arc->linear_travel);
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        bf->axis_flags[axis] = fp_NOT_ZERO(axis_length[axis]);
+        unit_bound[axis] = fabs(axis_length[axis]) / length;
+    }
+    mp_calculate_arc_jerk(&jerk, unit_bound);
+    _set_jerk_terms(bf, &jerk);
+    _calculate_vmaxes(bf, gm_in, axis_length, axis_square, nullptr);
+
+    float radius = min(arc->radius, arc->radius + arc->radius_delta);
+    float plane_jerk = min(cm.a[arc->plane_axis_0].jerk_max, cm.a[arc->plane_axis_1].jerk_max) * JERK_MULTIPLIER;
+    float planar_share = min(unit_bound[arc->plane_axis_0], (float)1.0);  // of the path velocity
+    float centripetal_vmax = cbrt(plane_jerk * square(radius)) / planar_share;
+    bf->cruise_vset   = min(bf->cruise_vset, centripetal_vmax);
+    bf->cruise_vmax   = bf->cruise_vset;
+    bf->absolute_vmax = min(bf->absolute_vmax, centripetal_vmax);
+    bf->block_time    = max(bf->block_time, length / bf->cruise_vset);
+    _set_bf_diagnostics(bf);
+
+    // Note: these next lines must remain in exact order. Position must update before committing the buffer.
+    copy_vector(mp.position, bf->cold->target);
+    mp_commit_write_buffer(BLOCK_TYPE_ALINE);
+    return (STAT_OK);
+}
+
+/*
+ * mp_get_arc_unit() - unit tangent of an arc at a fraction (0 to 1) of its length
+ */
+
+void mp_get_arc_unit(const mpArc_t* arc, const float fraction, float unit[])
+{
+    float theta = arc->theta + arc->angular_travel * fraction;
+    float radius = arc->radius + arc->radius_delta * fraction;
+    float d_0 = arc->radius_delta * sin(theta) + radius * arc->angular_travel * cos(theta);
+    float d_1 = arc->radius_delta * cos(theta) - radius * arc->angular_travel * sin(theta);
+    float length = sqrt(square(d_0) + square(d_1) + square(arc->linear_travel));
+
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        unit[axis] = 0;
+    }
+    if (fp_ZERO(length)) {
+        return;
+    }
+    unit[arc->plane_axis_0] = d_0 / length;
+    unit[arc->plane_axis_1] = d_1 / length;
+    unit[arc->linear_axis] = arc->linear_travel / length;
+}
+
+/*
+ * mp_spline() - plan a cubic spline as a single block
+ *
+ *  gm_in  - Gcode state with the spline target
+ *  spline - control points, set up by cm_spline_feed() or the coalescer. Must be in the
+ *           planner frame, so these only use spline blocks when no rotation is active
+ *
+ *  Planned like an arc block (see mp_arc()) from bounds sampled along the curve:
+ *    - bf->unit and cold->spline.exit_unit are the tangents at the ends
+ *    - the jerk and axis limits are taken for the largest share of the motion each axis
+ *      has anywhere on the curve
+ *    - the cruise is limited by the centripetal jerk at the tightest radius, cbrt(J r^2),
+ *      with the radius 1/curvature = |B'|^3 / |B' x B''|. The centripetal jerk runs along
+ *      the tangent, so each axis only takes its share of it: J is the lowest of each moving
+ *      axis' jerk over its unit bound, as for the block jerk, not the lowest axis jerk
+ */
+
+stat_t mp_spline(GCodeState_t* gm_in, const mpSpline_t* spline)
+{
+    static const uint8_t samples = 2*SPLINE_INTERVALS;
+    mpBuf_t* bf;
+    float axis_length[AXES] = {0, 0, 0, 0, 0, 0};
+    float axis_square[AXES] = {0, 0, 0, 0, 0, 0};
+    float unit_bound[AXES]  = {0, 0, 0, 0, 0, 0};
+    mpJerk_t jerk;
+    mpSpline_t curve = *spline;
+
+    float length = mp_spline_init_length(&curve);
+    if (fp_ZERO(length)) {
+        return (STAT_MINIMUM_LENGTH_MOVE);
+    }
+    ritorno(mp_coalesce_flush());                       // a move held by the coalescer must be queued first
+
+    if ((bf = mp_get_write_buffer()) == NULL) {         // never supposed to fail
+        return (cm_panic(STAT_FAILED_GET_PLANNER_BUFFER, "spline()"));
+    }
+    ritorno(mp_share_gm(bf, gm_in));
+    _rotate_target(gm_in->target, bf->cold->target);
+    bf->cold->spline = curve;
+    bf->spline = true;
+
+    bf->bf_func = mp_exec_aline;
+    bf->length  = length;
+    mp_spline_unit(spline, 0, bf->unit);
+    mp_spline_unit(spline, 1, bf->cold->spline.exit_unit);
+
+    float curvature_max = 0;
+    for (uint8_t i = 0; i <= samples; i++) {
+        float u = (float)i / samples;
+        float d[SPLINE_AXES];
+        float speed = mp_spline_derivative(spline, u, d);
+        if (speed < EPSILON) {                          // a cusp at a control point - the tangents either side cover it
+            continue;
+        }
+        float dd[SPLINE_AXES];
+        mp_spline_second_derivative(spline, u, dd);
+        for (uint8_t axis = 0; axis < SPLINE_AXES; axis++) {
+            unit_bound[axis] = max(unit_bound[axis], fabs(d[axis]) / speed);
+        }
+        float cross = sqrt(square(d[1]*dd[2] - d[2]*dd[1]) +
+                           square(d[2]*dd[0] - d[0]*dd[2]) +
+                           square(d[0]*dd[1] - d[1]*dd[0]));
+        curvature_max = max(curvature_max, cross / (speed * speed * speed));
+    }
+    float curve_jerk = 0;                               // tightest axis share of the centripetal jerk
+    for (uint8_t axis = 0; axis < SPLINE_AXES; axis++) {
+        axis_length[axis] = unit_bound[axis] * length;  // the most the axis may travel
+        if ((bf->axis_flags[axis] = fp_NOT_ZERO(axis_length[axis]))) {
+            float axis_jerk = cm.a[axis].jerk_max * JERK_MULTIPLIER / min(unit_bound[axis], (float)1.0);
+            curve_jerk = (fp_ZERO(curve_jerk)) ? axis_jerk : min(curve_jerk, axis_jerk);
+        }
+    }
+    axis_square[AXIS_X] = square(length);               // so feed time is for the path length
+    mp_calculate_arc_jerk(&jerk, unit_bound);
+    _set_jerk_terms(bf, &jerk);
+    _calculate_vmaxes(bf, gm_in, axis_length, axis_square, nullptr);
+
+    if (curvature_max > EPSILON) {
+        float centripetal_vmax = cbrt(curve_jerk / square(curvature_max));
+        bf->cruise_vset   = min(bf->cruise_vset, centripetal_vmax);
+        bf->cruise_vmax   = bf->cruise_vset;
+        bf->absolute_vmax = min(bf->absolute_vmax, centripetal_vmax);
+        bf->block_time    = max(bf->block_time, length / bf->cruise_vset);
+    }
+    _set_bf_diagnostics(bf);
+
+    // Note: these next lines must remain in exact order. Position must update before committing the buffer.
+    copy_vector(mp.position, bf->cold->target);
+    mp_commit_write_buffer(BLOCK_TYPE_ALINE);
+    return (STAT_OK);
+}
+#endif
+
+/*
+ * _rotate_target() - rotate a Gcode target into the planner frame (see mp_aline())
+ */
+
+static void _rotate_target(const float target[], float target_rotated[])
+{
+    target_rotated[0] = target[0] * cm.rotation_matrix[0][0] +
+                        target[1] * cm.rotation_matrix[0][1] +
+                        target[2] * cm.rotation_matrix[0][2];
+
+    target_rotated[1] = target[0] * cm.rotation_matrix[1][0] +
+                        target[1] * cm.rotation_matrix[1][1] +
+                        target[2] * cm.rotation_matrix[1][2];
+
+    target_rotated[2] = target[0] * cm.rotation_matrix[2][0] +
+                        target[1] * cm.rotation_matrix[2][1] +
+                        target[2] * cm.rotation_matrix[2][2] +
+                        cm.rotation_z_offset;
+
+    // copy rotation axes ABC
+    target_rotated[3] = target[3];
+    target_rotated[4] = target[4];
+    target_rotated[5] = target[5];
+}
+
 /*
  * mp_plan_block_list() - plan all the blocks in the list
  *
@@ -270,6 +660,308 @@ void mp_plan_block_list()
     mp.p = bf;  // update planner pointer
 }
 
+/*
+ * mp_plan_override() - apply a feed override change to queued blocks
+ *
+ *  bf     - first block to change. It and the blocks after it must not be planned or running
+ *  blocks - how many blocks to change in this pass
+ *
+ *  Returns the block to continue with in the next pass, or nullptr when the override has
+ *  reached the newest block. Blocks queued after that get the override when they are primed.
+ *
+ *  Each block's cruise_vmax is rescaled from its pre-override cruise_vset, continuing the
+ *  ramp, and the exit vmaxes on both sides are recomputed from the stored junction
+ *  vmaxes. Then the blocks are back-planned starting from the last one changed. Its
+ *  current exit velocity is a valid starting point, because the block after it was
+ *  planned to be entered at that velocity. So one pass only costs the blocks it touches,
+ *  however deep the queue is. A later pass that raises velocities further on back-plans
+ *  across the earlier ones again as needed.
+ */
+
+mpBuf_t* mp_plan_override(mpBuf_t* bf, uint8_t blocks)
+{
+    return (_replan_blocks(bf, blocks, false));
+}
+
+/*
+ * mp_plan_constraints() - apply changed axis velocity, jerk or junction limits to queued blocks
+ *
+ *  Called as mp_plan_override() is, with the same arguments and return. Instead of a new
+ *  override factor each block gets the limits it would get if it were queued now (see
+ *  _set_block_limits()), keeping the override it has. The junction with the block before
+ *  it is recomputed, so the junction after the last block changed in a pass is done
+ *  when the next pass gets to the block after it.
+ */
+
+mpBuf_t* mp_plan_constraints(mpBuf_t* bf, uint8_t blocks)
+{
+    return (_replan_blocks(bf, blocks, true));
+}
+
+/*
+ * _replan_blocks()    - change and back-plan a slice of queued blocks for mp_plan_override() or mp_plan_constraints()
+ * _set_block_limits() - recompute a queued block's jerk and, for a traverse, its vmaxes. False if it keeps the old ones
+ *
+ *  Only straight lines are recomputed, from their unit vector and length. Arc segments get
+ *  the jerk mp_aline() would give each of them, which meets the axis limits as the arc's
+ *  own did. Arc and spline blocks keep the limits they were queued with. Feeds keep their
+ *  vmaxes: the velocity max doesn't apply to them, and the feed time of an inverse time
+ *  block is not kept once the block is queued (see mp_share_gm()).
+ *
+ *  A block that follows one exec has committed to keeps its limits and its exit junction.
+ *  Its entry is fixed, and back-planning it to a new exit could ask for a lower entry -
+ *  braking velocity is not monotonic in the exit velocity - which would replan the blocks
+ *  exec is already running. The block after one that is kept only gets the new limits if
+ *  it can still brake from the kept block's exit velocity (entry_velocity) to its own;
+ *  otherwise it is kept as well. entry_velocity is negative if the entry is free. A kept
+ *  block's exit_vmax is capped at its planned exit velocity, so the block after it is
+ *  back-planned from the entry it will actually get.
+ */
+
+static bool _set_block_limits(mpBuf_t* bf, const float entry_velocity)
+{
+#if (PLANNER_ARC_BLOCKS == 1)
+    if (bf->arc || bf->spline) {
+        return (entry_velocity < 0);
+    }
+#endif
+    mpBuf_t was = *bf;
+    const GCodeState_t* gm = mp_get_block_gm(bf);
+    float axis_length[AXES];
+    float axis_square[AXES];
+    float recip_jerk = 0;
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        axis_length[axis] = (bf->axis_flags[axis]) ? (bf->unit[axis] * bf->length) : 0;
+        axis_square[axis] = square(axis_length[axis]);
+        if (bf->axis_flags[axis]) {
+            recip_jerk = max(recip_jerk, fabs(bf->unit[axis]) * _get_axis_recip_jerk(gm, axis));
+        }
+    }
+    mpJerk_t j;
+    _calculate_jerk_terms(&j, JERK_MULTIPLIER / recip_jerk);
+    _set_jerk_terms(bf, &j);
+
+    if (gm->motion_mode == MOTION_MODE_STRAIGHT_TRAVERSE) {
+        uint32_t step_rate_clamps = mp.step_rate_clamps;
+        _calculate_vmaxes(bf, gm, axis_length, axis_square, nullptr);
+        mp.step_rate_clamps = step_rate_clamps;     // it was counted when it was queued
+    }
+    if ((entry_velocity >= 0) &&
+        ((bf->cruise_vmax < entry_velocity) || (mp_get_target_velocity(bf->exit_velocity, bf->length, bf) < entry_velocity))) {
+        *bf = was;
+        return (false);
+    }
+    return (true);
+}
+
+static mpBuf_t* _replan_blocks(mpBuf_t* bf, uint8_t blocks, const bool limits)
+{
+    mpBuf_t* last = nullptr;
+    mpBuf_t* kept = nullptr;                            // the last block that keeps its limits
+
+    mp_end_preplanned();                                // overridden blocks are planned here
+
+    for (; blocks > 0; blocks--, bf = bf->nx) {
+        if (bf->buffer_state < MP_BUFFER_IN_PROCESS) {  // empty or not primed yet
+            bf = nullptr;
+            break;
+        }
+        if ((bf->block_type != BLOCK_TYPE_ALINE) || (bf->buffer_state >= MP_BUFFER_PLANNED)) {
+            continue;                                   // commands stop anyway. Exec got ahead of us
+        }
+        mpBuf_t* pv = _get_motion_pv(bf);               // the junction behind, unless exec has committed it
+        if (!limits) {
+            _set_override(bf, _get_override_factor(bf));
+        } else if (((pv->block_type == BLOCK_TYPE_ALINE) && (pv->buffer_state >= MP_BUFFER_PLANNED)) ||
+                   !_set_block_limits(bf, (pv == kept) ? pv->exit_velocity : -1)) {
+            kept = bf;                                  // its entry is fixed - it runs out as planned
+            kept->exit_vmax = min(kept->exit_vmax, kept->exit_velocity);  // so the block after it can't plan a faster entry
+            continue;
+        } else {
+            _set_override(bf, bf->override_factor);
+        }
+        bf->cruise_velocity = 0;                        // let back-planning lower it as well as raise it
+        mp.time_rescan |= !bf->plannable;               // it may be counted in plannable_time
+        bf->plannable = true;
+        bf->converged = false;
+        bf->hint = NO_HINT;
+
+        if ((pv->block_type == BLOCK_TYPE_ALINE) && (pv->buffer_state >= MP_BUFFER_IN_PROCESS) &&
+            (pv->buffer_state < MP_BUFFER_PLANNED) && (mp_get_block_gm(pv)->path_control != PATH_EXACT_STOP) &&
+            (pv != kept)) {
+            if (limits) {
+                _calculate_junction_vmax(pv, bf);
+            }
+            pv->exit_vmax = min3(pv->junction_vmax, pv->cruise_vmax, bf->cruise_vmax);
+            mp.time_rescan |= !pv->plannable;
+            pv->plannable = true;
+            pv->converged = false;
+            _set_nonstop_exit_vmax(pv, bf);
+        }
+        mpBuf_t* nx = _get_motion_nx(bf);
+        if (nx->buffer_state == MP_BUFFER_EMPTY) {      // newest block - keep its stop or exit cap
+            bf->exit_vmax = mp_lookahead_get_exit_vmax(bf);
+        } else if (nx->buffer_state >= MP_BUFFER_IN_PROCESS) {
+            if (mp_get_block_gm(bf)->path_control != PATH_EXACT_STOP) {
+                bf->exit_vmax = min3(bf->junction_vmax, bf->cruise_vmax, nx->cruise_vmax);
+            }
+        }
+        _set_nonstop_exit_vmax(bf, nx);
+        last = bf;
+    }
+    if (last != nullptr) {
+        float braking_velocity = (last->nx->buffer_state == MP_BUFFER_EMPTY) ? last->exit_vmax :
+                                                                              min(last->exit_vmax, last->exit_velocity);
+        _plan_block_backward(last, braking_velocity);
+        if ((mp.planner_state > PLANNER_STARTUP) && (cm.hold_state != FEEDHOLD_HOLD)) {
+            st_request_forward_plan();  // the next block may be waiting on a replan
+        }
+    }
+    return (bf);
+}
+
+/*
+ * _get_motion_pv()         - the block bf's entry junction is with: bf->pv, or the one before a run of nonstop commands
+ * _get_motion_nx()         - the block bf's exit junction is with, looking past primed nonstop commands
+ * _set_nonstop_exit_vmax() - give the nonstop commands between pv and nx the exit_vmax of the junction they sit in
+ *
+ *  A nonstop command (see mp_queue_command()) has no length or time. It sits in the junction
+ *  between the moves either side of it and carries that junction's exit_vmax, so the move
+ *  after it sees the right entry limit in pv->exit_vmax. Back-planning passes over it with
+ *  the braking velocity unchanged, and forward planning already enters the next move at the
+ *  exit velocity of the last one.
+ */
+
+static bool _is_nonstop(const mpBuf_t* bf)
+{
+    return ((bf->block_type == BLOCK_TYPE_COMMAND) && bf->nonstop && bf->plannable &&
+            (bf->buffer_state >= MP_BUFFER_IN_PROCESS));
+}
+
+static mpBuf_t* _get_motion_pv(mpBuf_t* bf)
+{
+    mpBuf_t* pv = bf->pv;
+    while (_is_nonstop(pv)) {
+        pv = pv->pv;
+    }
+    return (pv);
+}
+
+static mpBuf_t* _get_motion_nx(mpBuf_t* bf)
+{
+    mpBuf_t* nx = bf->nx;
+    while (_is_nonstop(nx)) {
+        nx = nx->nx;
+    }
+    return (nx);
+}
+
+static void _set_nonstop_exit_vmax(const mpBuf_t* pv, const mpBuf_t* nx)
+{
+    for (mpBuf_t* bf = pv->nx; bf != nx; bf = bf->nx) {
+        bf->exit_vmax = pv->exit_vmax;
+        bf->converged = false;
+    }
+}
+
+/*
+ * _prime_preplanned()    - verify a block from mp_aline_planned() and release the ones it completes the horizon of
+ * mp_end_preplanned()    - back-plan the preplanned blocks not yet released, as ordinary blocks
+ * mp_preplan_is_starving() - true if the runtime is about to reach the unreleased preplanned blocks
+ *
+ *  The host's velocities are checked against this block's own limits, which it was primed
+ *  with like any other: cruise within cruise_vmax, exit within cruise, and entry (the last
+ *  block's exit) within the junction and within what a deceleration to the exit at the
+ *  block's jerk can start from. If the block before is still plannable - the first of a
+ *  run - it is back-planned into that entry instead. Blocks that pass are kept IN_PROCESS until their horizon is covered, oldest
+ *  first, and then set PREPPED for the exec. They are not plannable, so back-planning of
+ *  later blocks stops at them as it does at any settled block.
+ *
+ *  A block that fails is counted in mp.preplan_rejects and planned here instead, along with
+ *  anything still held. The blocks already released were all verified to be stoppable from
+ *  within the blocks that followed, so the back-plan from the newest one never has to go
+ *  past them.
+ *
+ *  mp_end_preplanned() is also used with a runway of fewer than PREPLAN_RUNWAY_BLOCKS
+ *  released blocks ahead of the runtime, so a host that stops sending can't hold the last
+ *  blocks it sent, and before a feed override, which replans the queue.
+ */
+
+static void _prime_preplanned(mpBuf_t* bf)
+{
+    mpBuf_t* pv = _get_motion_pv(bf);
+    float entry_vmax = min(bf->cruise_velocity, mp_get_target_velocity(bf->exit_velocity, bf->length, bf));
+    bool entry_ok = true;
+    if (!pv->plannable && (pv->block_type == BLOCK_TYPE_ALINE) && (pv->buffer_state >= MP_BUFFER_IN_PROCESS)) {
+        entry_ok = !VELOCITY_LT(min(entry_vmax, pv->exit_vmax), pv->exit_velocity);
+    }
+    if (!entry_ok ||
+        VELOCITY_LT(bf->cruise_vmax, bf->cruise_velocity) ||
+        VELOCITY_LT(bf->cruise_velocity, bf->exit_velocity) ||
+        ((bf->preplan_horizon == 0) && fp_NOT_ZERO(bf->exit_velocity))) {
+        mp.preplan_rejects++;
+        bf->preplanned = false;                 // plan this one and any held ones here
+        bf->cruise_velocity = 0;
+        bf->exit_velocity = 0;
+        mp_end_preplanned();
+        return;
+    }
+    bf->cruise_velocity = min(bf->cruise_velocity, bf->cruise_vmax);    // wash out the tolerances
+    bf->exit_velocity = min(bf->exit_velocity, bf->cruise_velocity);
+    bf->plannable = false;
+    bf->converged = true;
+    mp.preplan_blocks++;
+
+    if (bf->pv->plannable) {                    // the first of a run - plan the blocks before it into its entry
+        _plan_block_backward(bf->pv, min(pv->exit_vmax, entry_vmax));
+    }
+    if (mp.preplan_count++ == 0) {
+        mp.preplan_first = bf;
+    }
+    while ((mp.preplan_count > 0) && (mp.preplan_first->preplan_horizon < mp.preplan_count)) {
+        mp_set_buffer_state(mp.preplan_first, MP_BUFFER_PREPPED);
+        mp.preplan_first = mp.preplan_first->nx;
+        mp.preplan_count--;
+    }
+}
+
+void mp_end_preplanned()
+{
+    if (mp.preplan_count == 0) {
+        return;
+    }
+    mpBuf_t* bf = mp.preplan_first;
+    for (uint8_t i = mp.preplan_count; i > 0; i--, bf = bf->nx) {
+        bf->preplanned = false;
+        bf->plannable = true;
+        bf->converged = false;
+    }
+    mp.preplan_count = 0;
+    mp.time_rescan = true;              // they may be counted in plannable_time
+
+    if (bf->buffer_state != MP_BUFFER_EMPTY) {
+        return;                         // the block after them back-plans across them when it is primed
+    }
+    bf = bf->pv;                        // newest block - plan it to stop, or to its lookahead cap
+    bf->exit_vmax = mp_lookahead_get_exit_vmax(bf);
+    _plan_block_backward(bf, bf->exit_vmax);
+    if ((mp.planner_state > PLANNER_STARTUP) && (cm.hold_state != FEEDHOLD_HOLD)) {
+        st_request_forward_plan();
+    }
+}
+
+bool mp_preplan_is_starving()
+{
+    uint8_t runway = 0;
+    for (mpBuf_t* bf = mp.preplan_first->pv; (bf != mb.r->pv) && (runway < PREPLAN_RUNWAY_BLOCKS); bf = bf->pv) {
+        if ((bf->buffer_state < MP_BUFFER_PREPPED) || (bf->buffer_state == MP_BUFFER_RUNNING)) {
+            break;
+        }
+        runway++;
+    }
+    return (runway < PREPLAN_RUNWAY_BLOCKS);
+}
+
 /*
  * _plan_block() - the block chain using pessimistic assumptions
  */
@@ -281,26 +973,46 @@ static mpBuf_t* _plan_block(mpBuf_t* bf)
     if (mp.planner_state == PLANNER_PRIMING) {
         // Timings from *here*
 
-        if (bf->pv->plannable) {
-            _calculate_junction_vmax(bf->pv);  // compute maximum junction velocity constraint
-            if (bf->pv->gm.path_control == PATH_EXACT_STOP) {
-                bf->pv->exit_vmax = 0;
-            } else {
-                bf->pv->exit_vmax = min3(bf->pv->junction_vmax, bf->pv->cruise_vmax, bf->cruise_vmax);
+        if (!bf->preplanned && (mp.preplan_count > 0)) {
+            mp_end_preplanned();  // the host stopped preplanning - the held blocks are planned from here on
+        }
+        if ((bf->block_type == BLOCK_TYPE_COMMAND) && bf->nonstop) {
+            bf->exit_vmax = bf->pv->exit_vmax;  // the junction it sits in, until the move after it is primed
+        } else {
+            mpBuf_t* pv = _get_motion_pv(bf);   // the junction is with the last move, past any nonstop commands
+            if (pv->plannable || pv->preplanned) {
+                _calculate_junction_vmax(pv, bf);  // compute maximum junction velocity constraint
+                if (mp_get_block_gm(pv)->path_control == PATH_EXACT_STOP) {
+                    pv->exit_vmax = 0;
+                } else {
+                    pv->exit_vmax = min3(pv->junction_vmax, pv->cruise_vmax, bf->cruise_vmax);
+                }
+                _set_nonstop_exit_vmax(pv, bf);
             }
         }
         _calculate_override(bf);  // adjust cruise_vmax for feed/traverse override
  //     bf->plannable_time = bf->pv->plannable_time;    // set plannable time - excluding current move
         bf->buffer_state = MP_BUFFER_IN_PROCESS;
+        bf->converged = false;      // vmaxes changed for this block and the exit_vmax of the previous one
+        bf->pv->converged = false;
 
         // +++++ Why do we have to do this here?
         // bf->pv_group = bf->pv;
 
         bf->hint = NO_HINT;     // ensure we've cleared the hints
         // Time: 12us-41us
+        if (bf->preplanned) {     // the host has back-planned it
+            _prime_preplanned(bf);
+            if (bf->preplanned) {
+                return (bf->nx);
+            }
+        }
         if (bf->nx->plannable) {  // read in new buffers until EMPTY
             return (bf->nx);
         }
+        if ((bf->nx->buffer_state == MP_BUFFER_EMPTY) && !bf->nonstop) {  // newest block - plan it to stop unless moves are held
+            bf->exit_vmax = mp_lookahead_get_exit_vmax(bf);
+        }
         mp.planning_return = bf->nx;                 // where to return after planning is complete
         mp.planner_state   = PLANNER_BACK_PLANNING;  // start backplanning
     }
@@ -312,239 +1024,309 @@ static mpBuf_t* _plan_block(mpBuf_t* bf)
     // Hint options from back-planning: COMMAND_BLOCK, PERFECT_DECELERATION, PERFECT_CRUISE, MIXED_DECELERATION
 
     if (mp.planner_state == PLANNER_BACK_PLANNING) {
-        // NOTE: We stop when the previous block is no longer plannable.
-        // We will alter the previous block's exit_velocity.
-        float braking_velocity = 0;  // we use this to stre the previous entry velocity, start at 0
-        bool optimal = false;  // we use the optimal flag (as the opposite of plannable) to carry plan-ability backward.
+        // start at 0 or the newest block's exit cap
+        _plan_block_backward(bf, (bf->nx->buffer_state == MP_BUFFER_EMPTY) ? bf->exit_vmax : 0);
+    }
 
-        // We test for (braking_velocity < bf->exit_velocity) in case of an inversion, and plannable is then violated.
-        for (; bf->plannable || (braking_velocity < bf->exit_velocity); bf = bf->pv) {
-            // Timings from *here*
+    mp.planner_state = PLANNER_PRIMING;  // revert to initial state
+    return (mp.planning_return);
+}
 
-            bf->iterations++;
-            bf->plannable = bf->plannable && !optimal;  // Don't accidentally enable plannable!
+/*
+ * _plan_block_backward() - back-plan from bf towards the run buffer
+ *
+ *  braking_velocity is the highest exit velocity bf may have: what its successor can be
+ *  entered at and still stop in time.
+ */
 
-            // Let's be mindful that forward planning may change exit_vmax, and our exit velocity may be lowered
-            braking_velocity = min(braking_velocity, bf->exit_vmax);
+static void _plan_block_backward(mpBuf_t* bf, float braking_velocity)
+{
+    // NOTE: We stop when the previous block is no longer plannable.
+    // We will alter the previous block's exit_velocity.
+    // we use braking_velocity to store the previous entry velocity
+    bool optimal = false;  // we use the optimal flag (as the opposite of plannable) to carry plan-ability backward.
 
-            // We *must* set cruise before exit, and keep it at least as high as exit.
-            bf->cruise_velocity = max(braking_velocity, bf->cruise_velocity);
-            bf->exit_velocity   = braking_velocity;
+    // We test for (braking_velocity < bf->exit_velocity) in case of an inversion, and plannable is then violated.
+    for (; bf->plannable || (braking_velocity < bf->exit_velocity); bf = bf->pv) {
+        // Timings from *here*
 
-            // We have two places where it could be a mixed decel or an asymmetric bump,
-            // depending on if the pv->exit_vmax is the same as bf.cruise_vmax
-            bool test_decel_or_bump = false;
+        // Let's be mindful that forward planning may change exit_vmax, and our exit velocity may be lowered
+        braking_velocity = min(braking_velocity, bf->exit_vmax);
 
-            // command blocks
-            if (bf->block_type == BLOCK_TYPE_COMMAND) {
-                // Nothing in the buffer before this will get any more optimal, so we'll call it
-                optimal = true;
+        // Incremental back-planning: if this block was already back-planned to this exit velocity
+        // then nothing behind it will change either, so stop here. This covers blocks that are
+        // settled but not "optimal", which the plannable test alone would walk through again.
+        if (bf->converged && !optimal && (bf->buffer_state == MP_BUFFER_PREPPED) &&
+            VELOCITY_EQ(braking_velocity, bf->exit_velocity)) {
+            break;
+        }
 
-                // Update braking_velocity for use in the top of the loop
-                // ++++ TEMPORARY force PTZ
-                bf->exit_velocity = 0;
-                // We just invalidated the next block's hint, but this should be fine
+        bf->cold->iterations++;
+        bf->plannable = bf->plannable && !optimal;  // Don't accidentally enable plannable!
 
-                // braking_velocity = bf->pv->exit_velocity;
-                braking_velocity = 0;
+        // We *must* set cruise before exit, and keep it at least as high as exit.
+        bf->cruise_velocity = max(braking_velocity, bf->cruise_velocity);
+        bf->exit_velocity   = braking_velocity;
 
-                // bf->plannable = !optimal && bf->pv->plannable;
-                bf->plannable = false;
+        // We have two places where it could be a mixed decel or an asymmetric bump,
+        // depending on if the pv->exit_vmax is the same as bf.cruise_vmax
+        bool test_decel_or_bump = false;
 
-                bf->hint = COMMAND_BLOCK;
+        // nonstop commands - motion runs through, so the braking velocity carries on to the move before
+        if ((bf->block_type == BLOCK_TYPE_COMMAND) && bf->nonstop) {
+            bf->hint = COMMAND_BLOCK;
+        }
 
-                // Time: XXXus (was 7us)
-            }
+        // command blocks - and spindle synchronized moves, which start and end stopped
+        else if ((bf->block_type == BLOCK_TYPE_COMMAND) || (bf->block_type == BLOCK_TYPE_SYNC)) {
+            // Nothing in the buffer before this will get any more optimal, so we'll call it
+            optimal = true;
 
-            // cruises - a *possible* perfect cruise is detected if exit_velocity == cruise_vmax
-            // forward planning may degrade this to a mixed accel
-            else if (VELOCITY_EQ(bf->exit_velocity, bf->cruise_vmax) &&
-                     VELOCITY_EQ(bf->pv->exit_vmax, bf->cruise_vmax)) {
-                // Remember: Set cruise FIRST
-                bf->cruise_velocity = min(bf->cruise_vmax, bf->exit_vmax);  // set exactly to wash out EQ tolerances
-                bf->exit_velocity   = bf->cruise_velocity;
+            // Update braking_velocity for use in the top of the loop
+            // ++++ TEMPORARY force PTZ
+            bf->exit_velocity = 0;
+            // We just invalidated the next block's hint, but this should be fine
 
-                // Update braking_velocity for use in the top of the loop
-                braking_velocity = bf->exit_velocity;
+            // braking_velocity = bf->pv->exit_velocity;
+            braking_velocity = 0;
 
-                bf->hint = PERFECT_CRUISE;
+            // bf->plannable = !optimal && bf->pv->plannable;
+            bf->plannable = false;
 
-                // We can't improve this entry more
-                optimal = true;
+            bf->hint = COMMAND_BLOCK;
 
-                // Time: XXXus (was 21us-27us)
-            }
+            // Time: XXXus (was 7us)
+        }
 
-            // not a command or a cruise
-            // test to see if we'll *have* to enter slower than we can exit
-            else if (bf->pv->exit_vmax < bf->exit_velocity) {
-                test_decel_or_bump = true;
-            }
+        // cruises - a *possible* perfect cruise is detected if exit_velocity == cruise_vmax
+        // forward planning may degrade this to a mixed accel
+        else if (VELOCITY_EQ(bf->exit_velocity, bf->cruise_vmax) &&
+                 VELOCITY_EQ(bf->pv->exit_vmax, bf->cruise_vmax)) {
+            // Remember: Set cruise FIRST
+            bf->cruise_velocity = min(bf->cruise_vmax, bf->exit_vmax);  // set exactly to wash out EQ tolerances
+            bf->exit_velocity   = bf->cruise_velocity;
 
-            // Ok, now we can test deceleration cases
-            else {
-                braking_velocity = mp_get_target_velocity(bf->exit_velocity, bf->length, bf);
+            // Update braking_velocity for use in the top of the loop
+            braking_velocity = bf->exit_velocity;
 
-                if (bf->pv->exit_vmax > braking_velocity) {  // remember, exit vmax already is min of
-                                                             // pv_group->cruise_vmax, cruise_vmax, and
-                                                             // pv_group->junction_vmax
-                    bf->cruise_velocity = braking_velocity;  // put this here to avoid a race condition with _exec()
-                    bf->hint = PERFECT_DECELERATION;         // This is advisory, and may be altered by forward planning
+            bf->hint = PERFECT_CRUISE;
 
-                    // Time: XXXus (was 71us-78us)
-                }
+            // We can't improve this entry more
+            optimal = true;
 
-                else {
-                    test_decel_or_bump = true;
-                    // Time: XXXus (was 72us-79us)
-                }
-            }  // end else not a cruise
+            // Time: XXXus (was 21us-27us)
+        }
 
-            if (test_decel_or_bump) {
-                // Update braking_velocity for use in the top of the loop
-                braking_velocity = bf->pv->exit_vmax;
+        // not a command or a cruise
+        // test to see if we'll *have* to enter slower than we can exit
+        else if (bf->pv->exit_vmax < bf->exit_velocity) {
+            test_decel_or_bump = true;
+        }
 
-                if (bf->cruise_vmax > bf->pv->exit_vmax) {
-                    bf->cruise_velocity = bf->cruise_vmax;
-                    bf->hint            = ASYMMETRIC_BUMP;
-                } else {
-                    bf->cruise_velocity = bf->pv->exit_vmax;
-                    bf->hint            = MIXED_DECELERATION;
-                    // We might still be able to merge this.
-                }
-                optimal = true;   // We can't improve this entry more
+        // Ok, now we can test deceleration cases
+        else {
+            braking_velocity = mp_get_target_velocity(bf->exit_velocity, bf->length, bf);
+
+            if (bf->pv->exit_vmax > braking_velocity) {  // remember, exit vmax already is min of
+                                                         // pv_group->cruise_vmax, cruise_vmax, and
+                                                         // pv_group->junction_vmax
+                bf->cruise_velocity = braking_velocity;  // put this here to avoid a race condition with _exec()
+                bf->hint = PERFECT_DECELERATION;         // This is advisory, and may be altered by forward planning
+
+                // Time: XXXus (was 71us-78us)
             }
 
-            // +++++
-            if (bf->buffer_state == MP_BUFFER_EMPTY) {
-            //     _debug_trap("Exec apparently cleared this block while we were planning it.");
-                break;  // exit the loop, we've hit and passed the running buffer
+            else {
+                test_decel_or_bump = true;
+                // Time: XXXus (was 72us-79us)
             }
-            // if (fp_ZERO(bf->exit_velocity) && !fp_ZERO(bf->exit_vmax)) {
-            //     _debug_trap(); // why zero?
-            // }
+        }  // end else not a cruise
+
+        if (test_decel_or_bump) {
+            // Update braking_velocity for use in the top of the loop
+            braking_velocity = bf->pv->exit_vmax;
 
-            // We might back plan into the running or planned buffer, so we have to check.
-            if (bf->buffer_state < MP_BUFFER_PREPPED) {
-                bf->buffer_state = MP_BUFFER_PREPPED;
+            if (bf->cruise_vmax > bf->pv->exit_vmax) {
+                bf->cruise_velocity = bf->cruise_vmax;
+                bf->hint            = ASYMMETRIC_BUMP;
+            } else {
+                bf->cruise_velocity = bf->pv->exit_vmax;
+                bf->hint            = MIXED_DECELERATION;
+                // We might still be able to merge this.
             }
-        }  // for loop
-    }      // exits with bf pointing to a locked or EMPTY block
+            optimal = true;   // We can't improve this entry more
+        }
 
-    mp.planner_state = PLANNER_PRIMING;  // revert to initial state
-    return (mp.planning_return);
+        // +++++
+        if (mp_get_buffer_state(bf) == MP_BUFFER_EMPTY) {
+        //     _debug_trap("Exec apparently cleared this block while we were planning it.");
+            break;  // exit the loop, we've hit and passed the running buffer
+        }
+        // if (fp_ZERO(bf->exit_velocity) && !fp_ZERO(bf->exit_vmax)) {
+        //     _debug_trap(); // why zero?
+        // }
+
+        // We might back plan into the running or planned buffer, so we have to check.
+        if (bf->buffer_state < MP_BUFFER_PREPPED) {
+            mp_set_buffer_state(bf, MP_BUFFER_PREPPED);
+        }
+        bf->converged = true;
+    }  // for loop - exits with bf pointing to a locked or EMPTY block
 }
 
 /***** ALINE HELPERS *****
- * _calculate_override() - calculate cruise_vmax given cruise_vset and feed rate factor
- * _calculate_jerk()
+ * _get_override_factor() - feed override factor for the next block, advancing any ramp
+ * _set_override()        - set override_factor and the cruise_vmax it gives from cruise_vset
+ * _calculate_override()  - set the override for a new block
+ * _get_axis_recip_jerk()
  * _calculate_vmaxes()
  * _calculate_junction_vmax()
  * _calculate_decel_time()
  */
 
-static void _calculate_override(mpBuf_t* bf)  // execute ramp to adjust cruise velocity
+static float _get_override_factor(const mpBuf_t* bf)  // advance the ramp over one block
+{
+    if (!mp.ramp_active) {
+        return (mp.mfo_factor);
+    }
+    mp.ramp_factor += mp.ramp_dvdt * bf->block_time;
+    if (((mp.ramp_dvdt > 0) && (mp.ramp_factor > mp.ramp_target)) ||
+        ((mp.ramp_dvdt < 0) && (mp.ramp_factor < mp.ramp_target))) {
+        mp.ramp_factor = mp.ramp_target;
+        mp.ramp_active = false;     // detect end of ramp
+    }
+    return (mp.ramp_factor);
+}
+
+static void _set_override(mpBuf_t* bf, const float override_factor)
 {
     // TODO: Account for rapid overrides as well as feed overrides
+    bf->override_factor = override_factor;
+    bf->cruise_vmax     = min(override_factor * bf->cruise_vset, bf->absolute_vmax);
+    if (bf->pv->buffer_state >= MP_BUFFER_PLANNED) {    // exec has committed to the entry velocity
+        bf->cruise_vmax = max(bf->cruise_vmax, bf->pv->exit_velocity);
+    }
+}
 
-    // pull in override factor from previous block or seed initial value from the system setting
-    bf->override_factor = fp_ZERO(bf->pv->override_factor) ? cm.gmx.mfo_factor : bf->pv->override_factor;
-    bf->cruise_vmax     = bf->override_factor * bf->cruise_vset;
-
-    // generate ramp term is a ramp is active
-    if (mp.ramp_active) {
-        bf->override_factor += mp.ramp_dvdt * bf->block_time;
-        if (mp.ramp_dvdt > 0) {  // positive is an acceleration ramp
-            if (bf->override_factor > mp.ramp_target) {
-                bf->override_factor = mp.ramp_target;
-                mp.ramp_active      = false;  // detect end of ramp
-            }
-            bf->cruise_velocity *= bf->override_factor;
-            if (bf->cruise_velocity > bf->absolute_vmax) {  // test max cruise_velocity
-                bf->cruise_velocity = bf->absolute_vmax;
-                mp.ramp_active      = false;  // don't allow exceeding absolute_vmax
-            }
-        } else {  // negative is deceleration ramp
-            if (bf->override_factor < mp.ramp_target) {
-                bf->override_factor = mp.ramp_target;
-                mp.ramp_active      = false;
-            }
-            bf->cruise_velocity *= bf->override_factor;  // +++++ this is probably wrong
-            //  bf->exit_velocity *= bf->mfo_factor;        //...but I'm not sure this is right,
-            //  bf->cruise_velocity = bf->pv->exit_velocity;   //...either
-        }
-    } else {
-        bf->cruise_velocity *= bf->override_factor;  // apply original or changed factor
-    }
-    // Correction for velocity constraints
-    // In the case of a acceleration these conditions must hold:
-    //      Ve < Vc = Vx
-    // In the case of a deceleration:
-    //      Ve = Vc > Vx
-    // in the case of "lump":
-    //      Ve < Vc > Vx
-    // if (bf->cruise_velocity < bf->pv->exit_velocity) { // deceleration case
-    //     bf->cruise_velocity = bf->pv->exit_velocity;
-    // } else {                                        // acceleration case
-    //     ...
-    // }
+static void _calculate_override(mpBuf_t* bf)  // set cruise_vmax for a new block
+{
+    // blocks behind an override that's still being rolled out are fixed up when it gets to them
+    _set_override(bf, (mp.override_bf == nullptr) ? _get_override_factor(bf) : mp.mfo_factor);
 }
 
 /*
- * _calculate_jerk() - calculate jerk given the dynamic state
- *
- *  Set the jerk scaling to the lowest axis with a non-zero unit vector.
- *  Go through the axes one by one and compute the scaled jerk, then pick
- *  the highest jerk that does not violate any of the axes in the move.
+ * _get_axis_recip_jerk() - reciprocal jerk limit of an axis for this block
  *
- * Cost about ~65 uSec
+ *  The block jerk is the largest jerk that still meets the axis constraints: the lowest of
+ *  each participating axis' jerk over its unit vector component. It is collected in the
+ *  axis pass of _calculate_vmaxes() as the highest |unit| * (1/jerk), using the reciprocals
+ *  cached by the axis config setters, so the block costs one divide instead of one per axis.
  */
 
-static void _calculate_jerk(mpBuf_t* bf) 
+static float _get_axis_recip_jerk(const GCodeState_t* gm, const uint8_t axis)
 {
-    // compute the jerk as the largest jerk that still meets axis constraints
-    bf->jerk   = 8675309;  // a ridiculously large number
-    float jerk = 0;
-
-    for (uint8_t axis = 0; axis < AXES; axis++) {
-        if (fabs(bf->unit[axis]) > 0) {  // if this axis is participating in the move
-            float axis_jerk = 0;
 #ifdef TRAVERSE_AT_HIGH_JERK
 #warning using experimental feature TRAVERSE_AT_HIGH_JERK!
-            switch (bf->gm.motion_mode) {
-                case MOTION_MODE_STRAIGHT_TRAVERSE:
-                //case MOTION_MODE_STRAIGHT_PROBE: // <-- not sure on this one
-                    axis_jerk = cm.a[axis].jerk_high;
-                    break;
-                default:
-                    axis_jerk = cm.a[axis].jerk_max;
-            }
+    switch (gm->motion_mode) {
+        case MOTION_MODE_STRAIGHT_TRAVERSE:
+        //case MOTION_MODE_STRAIGHT_PROBE: // <-- not sure on this one
+            return (cm.a[axis].recip_jerk_high);
+        default:
+            return (cm.a[axis].recip_jerk_max);
+    }
 #else
-            axis_jerk = cm.a[axis].jerk_max;
+    return (cm.a[axis].recip_jerk_max);
 #endif
+}
 
-            jerk = axis_jerk / fabs(bf->unit[axis]);
-            if (jerk < bf->jerk) {
-                bf->jerk = jerk;
-                //              bf->jerk_axis = axis;           // +++ diagnostic
-            }
+/*
+ * mp_calculate_arc_jerk() - compute one set of jerk terms for all segments of an arc
+ *
+ *  unit_bound[] is the largest magnitude each (unrotated) unit vector component takes
+ *  anywhere on the arc. The jerk is the largest that meets the axis constraints at every
+ *  segment, so it is never higher than mp_aline() would give any one segment.
+ */
+
+void mp_calculate_arc_jerk(mpJerk_t* j, const float unit_bound[])
+{
+    float recip_jerk = 0;
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        float bound = unit_bound[axis];     // rotate the bound into the planner frame
+        if (axis < 3) {
+            bound = min(fabs(cm.rotation_matrix[axis][0]) * unit_bound[0] +
+                        fabs(cm.rotation_matrix[axis][1]) * unit_bound[1] +
+                        fabs(cm.rotation_matrix[axis][2]) * unit_bound[2], (float)1.0);
+        }
+        if (bound > 0) {
+            recip_jerk = max(recip_jerk, bound * cm.a[axis].recip_jerk_max);
         }
     }
-    bf->jerk *= JERK_MULTIPLIER;           // goose it!
-    bf->jerk_sq    = bf->jerk * bf->jerk;  // pre-compute terms used multiple times during planning
-    bf->recip_jerk = 1 / bf->jerk;
+    _calculate_jerk_terms(j, JERK_MULTIPLIER / recip_jerk);
+}
 
-    const float q        = 2.40281141413;  // (sqrt(10)/(3^(1/4)))
-    const float sqrt_j   = sqrt(bf->jerk);
-    bf->sqrt_j           = sqrt_j;
-    bf->q_recip_2_sqrt_j = q / (2 * sqrt_j);
+/*
+ * mp_calculate_line_limits() - set up the length, unit vector, vmaxes and jerk of a straight move
+ *
+ *  Sets bf up as mp_aline() would for a move of axis_length[] in the planner frame, but
+ *  doesn't queue it. gm must hold the motion mode, feed rate mode and feed rate.
+ *  Tiny axis lengths must already be zeroed and the move must not be zero length. Used by
+ *  the lookahead queue to bound moves it holds before they get a planner buffer.
+ */
+
+void mp_calculate_line_limits(mpBuf_t* bf, const GCodeState_t* gm, const float axis_length[])
+{
+    float axis_square[AXES];
+    float length_square = 0;
+
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        axis_square[axis] = square(axis_length[axis]);
+        length_square += axis_square[axis];
+        bf->axis_flags[axis] = (axis_length[axis] != 0);
+    }
+    bf->length = fast_sqrt(length_square);
+    vec_unrolled<AXES>::scale(bf->unit, axis_length, 1 / bf->length);  // axis_length is a pointer here
+    float recip_jerk = 0;
+    uint32_t step_rate_clamps = mp.step_rate_clamps;
+    _calculate_vmaxes(bf, gm, axis_length, axis_square, &recip_jerk);
+    mp.step_rate_clamps = step_rate_clamps;         // only count blocks that are queued
+    mpJerk_t j;
+    _calculate_jerk_terms(&j, JERK_MULTIPLIER / recip_jerk);
+    _set_jerk_terms(bf, &j);
+}
+
+/*
+ * _calculate_jerk_terms() - pre-compute terms used multiple times during planning
+ * _set_jerk_terms()       - copy them to a block
+ */
+
+static void _calculate_jerk_terms(mpJerk_t* j, const float jerk)
+{
+#if (MOTION_PROFILE_ORDER == 3)
+    const float q       = 2.0;              // S-curve: a ramp takes 2 sqrt(dV/j)
+#else
+    const float q       = 2.40281141413;    // (sqrt(10)/(3^(1/4)))
+#endif
+    j->jerk             = jerk;
+    j->jerk_sq          = jerk * jerk;
+    j->recip_jerk       = 1 / jerk;
+    j->sqrt_j           = sqrt(jerk);
+    j->q_recip_2_sqrt_j = q / (2 * j->sqrt_j);
+}
+
+static void _set_jerk_terms(mpBuf_t* bf, const mpJerk_t* j)
+{
+    bf->jerk             = j->jerk;
+    bf->jerk_sq          = j->jerk_sq;
+    bf->recip_jerk       = j->recip_jerk;
+    bf->sqrt_j           = j->sqrt_j;
+    bf->q_recip_2_sqrt_j = j->q_recip_2_sqrt_j;
 }
 
 /*
  * _calculate_vmaxes() - compute cruise_vmax and absolute_vmax based on velocity constraints
  *
  *  The following feeds and times are compared and the longest (slowest velocity) is returned:
- *      - G93 inverse time (if G93 is active)
+ *      - G93 inverse time (if G93 is active). The F word time is used as it is - no lengths
  *      - time for coordinated move at requested feed rate
  *      - time that the slowest axis would require for the move
  *
@@ -560,6 +1342,9 @@ static void _calculate_jerk(mpBuf_t* bf)
  *  Velocities may be also be degraded (slowed down) if:
  *    - The block calls for a time that is less than the minimum update time (min segment time).
  *      This is very important to ensure proper block planning and trapezoid generation.
+ *    - Any motor would need more than one step per DDA tick (times STEP_RATE_HEADROOM).
+ *      The DDA cannot emit more and would silently drop steps. Velocity max settings that
+ *      run into this limit are counted in mp.step_rate_clamps.
  *
  *  Prerequisites for calling this function:
  *    - Targets must be set via cm_set_target(). Axis modes are taken into account by this.
@@ -599,42 +1384,65 @@ static void _calculate_jerk(mpBuf_t* bf)
  *       so that the elapsed time from the start to the end of the motion is T plus
  *       any time required for acceleration or deceleration.
  */
-static void _calculate_vmaxes(mpBuf_t* bf, const float axis_length[], const float axis_square[]) 
+static void _calculate_vmaxes(mpBuf_t* bf, const GCodeState_t* gm, const float axis_length[], const float axis_square[], float* recip_jerk)
 {
     float feed_time = 0;        // one of: XYZ time, ABC time or inverse time. Mutually exclusive
     float max_time  = 0;        // time required for the rate-limiting axis
     float tmp_time  = 0;        // temp value used in computation
     float min_time  = 8675309;  // looking for fastest possible execution (seed w/arbitrarily large number)
     float block_time;           // resulting move time
+    bool step_clamped = false;  // true if the DDA step rate limits an axis
 
     // compute feed time for feeds and probe motion
-    if (bf->gm.motion_mode != MOTION_MODE_STRAIGHT_TRAVERSE) {
-        if (bf->gm.feed_rate_mode == INVERSE_TIME_MODE) {
-            feed_time             = bf->gm.feed_rate;  // NB: feed rate was un-inverted to minutes by cm_set_feed_rate()
-            bf->gm.feed_rate_mode = UNITS_PER_MINUTE_MODE;
+    if (gm->motion_mode != MOTION_MODE_STRAIGHT_TRAVERSE) {
+        if (gm->feed_rate_mode == INVERSE_TIME_MODE) {
+            feed_time = gm->feed_rate;  // NB: feed rate was un-inverted to minutes by cm_set_feed_rate()
+                                        // the block's shared state is in units per minute mode (see mp_share_gm())
         } else {
             // compute length of linear move in millimeters. Feed rate is provided as mm/min
-            feed_time = sqrt(axis_square[AXIS_X] + axis_square[AXIS_Y] + axis_square[AXIS_Z]) / bf->gm.feed_rate;
+            // A straight move of only linear or only rotary axes is its own feed path, so the
+            // length already taken saves a second square root. Tiny axes were zeroed, so the
+            // squares are exactly zero for axes that don't move.
+            float linear_square = axis_square[AXIS_X] + axis_square[AXIS_Y] + axis_square[AXIS_Z];
+            bool mixed = (linear_square > 0) && ((axis_square[AXIS_A] + axis_square[AXIS_B] + axis_square[AXIS_C]) > 0);
+#if (PLANNER_ARC_BLOCKS == 1)
+            bool straight = !(bf->arc || bf->spline);   // curves pass their path as the squares
+#else
+            bool straight = true;
+#endif
+            if (straight && !mixed) {
+                feed_time = bf->length / gm->feed_rate;
+            } else {
+                feed_time = fast_sqrt(linear_square) / gm->feed_rate;
+            }
             // if no linear axes, compute length of multi-axis rotary move in degrees. Feed rate is provided as
             // degrees/min
             if (fp_ZERO(feed_time)) {
-                feed_time = sqrt(axis_square[AXIS_A] + axis_square[AXIS_B] + axis_square[AXIS_C]) / bf->gm.feed_rate;
+                feed_time = fast_sqrt(axis_square[AXIS_A] + axis_square[AXIS_B] + axis_square[AXIS_C]) / gm->feed_rate;
             }
         }
     }
     // compute rate limits and absolute maximum limit
     for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
         if (bf->axis_flags[axis]) {
-            if (bf->gm.motion_mode == MOTION_MODE_STRAIGHT_TRAVERSE) {
-                tmp_time = fabs(axis_length[axis]) / cm.a[axis].velocity_max;
+            if (gm->motion_mode == MOTION_MODE_STRAIGHT_TRAVERSE) {
+                tmp_time = fabs(axis_length[axis]) * cm.a[axis].recip_velocity_max;
             } else {  // gm.motion_mode == MOTION_MODE_STRAIGHT_FEED
-                tmp_time = fabs(axis_length[axis]) / cm.a[axis].feedrate_max;
+                tmp_time = fabs(axis_length[axis]) * cm.a[axis].recip_feedrate_max;
+            }
+            float step_time = _get_axis_step_time(axis, axis_length[axis]);
+            if (step_time > tmp_time) {
+                tmp_time = step_time;
+                step_clamped = true;
             }
             max_time = max(max_time, tmp_time);
 
             if (tmp_time > 0) {  // collect minimum time if this axis is not zero
                 min_time = min(min_time, tmp_time);
             }
+            if (recip_jerk != nullptr) {  // collect the block jerk in the same pass (see _get_axis_recip_jerk())
+                *recip_jerk = max(*recip_jerk, fabs(bf->unit[axis]) * _get_axis_recip_jerk(gm, axis));
+            }
         }
     }
     block_time        = max3(feed_time, max_time, MIN_BLOCK_TIME);
@@ -643,6 +1451,26 @@ static void _calculate_vmaxes(mpBuf_t* bf, const float axis_length[], const floa
     bf->cruise_vmax   = bf->cruise_vset;          // starting value for cruise vmax
     bf->absolute_vmax = bf->length / min_time;    // absolute velocity limit
     bf->block_time    = block_time;               // initial estimate - used for ramp computations
+    if (step_clamped) {
+        mp.step_rate_clamps++;
+    }
+}
+
+/*
+ * _get_axis_step_time() - minimum time for an axis move given the DDA step rate ceiling
+ *
+ *  Returns the time the fastest-stepping motor mapped to the axis needs to emit the steps
+ *  for this length at no more than STEP_RATE_HEADROOM steps per DDA tick.
+ */
+static float _get_axis_step_time(const uint8_t axis, const float length)
+{
+    float steps_per_unit = 0;
+    for (uint8_t motor = MOTOR_1; motor < MOTORS; motor++) {
+        if (KN_MOTOR_MAP(motor) == axis) {
+            steps_per_unit = max(steps_per_unit, st_cfg.mot[motor].steps_per_unit);
+        }
+    }
+    return (fabs(length) * steps_per_unit / (FREQUENCY_DDA * 60 * STEP_RATE_HEADROOM));
 }
 
 /*
@@ -653,6 +1481,9 @@ static void _calculate_vmaxes(mpBuf_t* bf, const float axis_length[], const floa
  *  Computes the maximum allowable junction speed by finding the velocity that will not
  *  violate the jerk value of any axis.
  *
+ *  The junction is between bf and nx, the next move. That is bf->nx unless nonstop commands
+ *  sit between them (see _get_motion_pv()).
+ *
  *  In order to achieve this we take the difference of the unit vectors of the two moves
  *  of the corner, at the point from vector a to vector b. The unit vectors of those two
  *  moves are provided as the current block (a_unit) and previous block (b_unit).
@@ -694,17 +1525,24 @@ static void _calculate_vmaxes(mpBuf_t* bf, const float axis_length[], const floa
  *  so those terms cancel out.
  */
 
-static void _calculate_junction_vmax(mpBuf_t* bf) 
+static void _calculate_junction_vmax(mpBuf_t* bf, const mpBuf_t* nx) 
 {
     // ++++ RG If we change cruise_vmax, we'll need to recompute junction_vmax, if we do this:
-    float velocity = min(bf->cruise_vmax, bf->nx->cruise_vmax);  // start with our maximum possible velocity
+    float velocity = min(bf->cruise_vmax, nx->cruise_vmax);  // start with our maximum possible velocity
 
     // uint8_t jerk_axis = AXIS_X;
     // cmAxes jerk_axis = AXIS_X;
 
+#if (PLANNER_ARC_BLOCKS == 1)
+    const float* exit_unit = (bf->arc) ? bf->cold->arc.exit_unit :            // arcs and splines leave along
+                             (bf->spline) ? bf->cold->spline.exit_unit : bf->unit;  // their end tangent
+#else
+    const float* exit_unit = bf->unit;
+#endif
+
     for (uint8_t axis = 0; axis < AXES; axis++) {
-        if (bf->axis_flags[axis] || bf->nx->axis_flags[axis]) {       // skip axes with no movement
-            float delta = fabs(bf->unit[axis] - bf->nx->unit[axis]);  // formula (1)
+        if (bf->axis_flags[axis] || nx->axis_flags[axis]) {       // skip axes with no movement
+            float delta = fabs(exit_unit[axis] - nx->unit[axis]);  // formula (1)
 
             // Corner case: If an axis has zero delta, we might have a straight line.
             // Corner case: An axis doesn't change (and it's not a straight line).
@@ -720,5 +1558,59 @@ static void _calculate_junction_vmax(mpBuf_t* bf)
             }
         }
     }
+    if (cm.junction_curvature_enable) {             // on a faceted curve the curvature decides instead
+        float curve_vmax = _get_curve_vmax(bf, nx);
+        if (curve_vmax > 0) {
+            velocity = min(bf->cruise_vmax, nx->cruise_vmax);
+            velocity = min(velocity, curve_vmax);
+        }
+    }
     bf->junction_vmax = velocity;
 }
+
+/*
+ * _get_curve_vmax() - junction velocity on a faceted curve, or 0 if the junction is a corner
+ *
+ *  Used in junction curvature mode (jc). The corner model takes each junction on its own, so
+ *  a finely faceted curve runs faster than the same curve cut coarsely, with neither related
+ *  to the curve itself. Here the junction between bf and nx is taken as a point on a curve if
+ *  the turns into bf (from pv) and out of it (to nx) are both under JUNCTION_CURVE_ANGLE_MAX,
+ *  turn the same way and are within a factor of 2 of each other. A zigzag or a lone corner
+ *  fails these tests and is left to the corner model.
+ *
+ *  Each turn vector is the difference of two unit vectors, with magnitude 2 sin(theta/2). As
+ *  for a regular polygon the local radius is R = L / (2 sin(theta/2)), with L the mean of
+ *  the two block lengths. The velocity is limited by the centripetal jerk, v = cbrt(J R^2),
+ *  as for arc blocks (see mp_arc()).
+ */
+
+static float _get_curve_vmax(const mpBuf_t* bf, const mpBuf_t* nx)
+{
+    static const float turn_max_sq = square(2 * sin(JUNCTION_CURVE_ANGLE_MAX / 2));
+    const mpBuf_t* pv = bf->pv;
+
+    if ((pv->buffer_state == MP_BUFFER_EMPTY) || (pv->block_type != BLOCK_TYPE_ALINE)) {
+        return (0);
+    }
+#if (PLANNER_ARC_BLOCKS == 1)
+    if (pv->arc || bf->arc || nx->arc || pv->spline || bf->spline || nx->spline) {
+        return (0);
+    }
+#endif
+    float turn_in_sq = 0;
+    float turn_out_sq = 0;
+    float turns_dot = 0;
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        float turn_in = bf->unit[axis] - pv->unit[axis];
+        float turn_out = nx->unit[axis] - bf->unit[axis];
+        turn_in_sq += square(turn_in);
+        turn_out_sq += square(turn_out);
+        turns_dot += turn_in * turn_out;
+    }
+    if ((turn_out_sq < EPSILON) || (turn_in_sq > turn_max_sq) || (turn_out_sq > turn_max_sq) ||
+        (turns_dot <= 0) || (turn_in_sq > 4 * turn_out_sq) || (turn_out_sq > 4 * turn_in_sq)) {
+        return (0);
+    }
+    float radius = (bf->length + nx->length) / (2 * fast_sqrt(turn_out_sq));
+    return (cbrt(min(bf->jerk, nx->jerk) * square(radius)));
+}
@@ -0,0 +1,418 @@
+/*
+ * plan_lookahead.cpp - streaming lookahead queue in front of the line planner
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* --- Lookahead Notes ----
+ *
+ *  Ordering. The queue sits above the coalescer and mp_aline(), so everything that reaches
+ *  the planner queue by another way must wait until the queue has drained. The controller
+ *  only reads a line while the planner has room or the queue does, and holds back any line
+ *  that mp_lookahead_is_move_line() rejects until mp_lookahead_is_synced(). A move that
+ *  still can't be held (its Gcode state was changed by a JSON command, say) is refused with
+ *  STAT_EAGAIN before the model is finalized, and its line is held and run again. JSON
+ *  lines are read on the control path, ahead of held moves - as they are already read
+ *  ahead of moves still waiting in the RX buffer.
+ *
+ *  Holding. A move may be held if it is a G0 or G1 in a machining cycle, in units-per-
+ *  minute mode (G94), in continuous path mode (G64), with no coordinate rotation (so the
+ *  Gcode frame is the planner frame) and with the same state as the moves already held
+ *  apart from its target, feed rate and line number. While nothing is held, and
+ *  the planner has room, moves pass straight through to the coalescer.
+ *
+ *  Limits. Each move gets the cruise vmax and jerk mp_aline() will give it (see
+ *  mp_calculate_line_limits()), scaled down by a feed override below 100%, and a junction
+ *  limit with the move before it that is never above what _calculate_junction_vmax() will
+ *  find. The braking velocity of a move is the lower of that junction limit and the
+ *  velocity it can be entered at and still reach the braking velocity of the next move
+ *  (zero after the last one) using mp_get_target_velocity(), as the back-planner does.
+ *  Adding a move only raises braking velocities, so the backward update stops at the
+ *  first move that doesn't change. Limits are taken when a move is held: changing jerk or
+ *  velocity settings takes effect on moves read after the change, as for planned blocks.
+ *
+ *  Exit cap. Once a move is released to mp_aline() the braking velocity of the next move
+ *  held is the exit cap for it - the newest planner block. The back-planner starts from
+ *  that velocity instead of zero (see _plan_block()). The cap is only applied while the
+ *  blocks queued ahead of it run for at least LOOKAHEAD_QUEUED_MS, so the runtime never
+ *  reaches a block that plans to keep moving before the move after it has been released.
+ *  Once a capped block is committed (planned or running) its successor keeps the cap so
+ *  the two plans stay consistent.
+ */
+#include "g2core.h"
+#include "config.h"
+#include "binary_parser.h"
+#include "canonical_machine.h"
+#include "planner.h"
+#include "plan_coalesce.h"
+#include "plan_lookahead.h"
+#include "text_parser.h"
+#include "util.h"
+#include "xio.h"
+
+// Allocate lookahead singleton structure
+
+look_t look;
+
+static mpBuf_t limits_bf;                   // scratch block for mp_calculate_line_limits()
+
+// Local functions
+
+static bool _is_holdable(const GCodeState_t *gm_in);
+static bool _is_compatible(const GCodeState_t *gm_in);
+static float _get_junction_vmax(const laEntry_t *pv, const laEntry_t *e, const float unit[]);
+static void _update_braking_velocities(void);
+static stat_t _release_move(void);
+
+/*****************************************************************************
+ * Lookahead functions
+ *
+ * mp_lookahead_init()          - initialize the lookahead queue
+ * mp_lookahead_abort()         - discard all moves held
+ * mp_lookahead_aline()         - entry point for straight moves
+ * mp_lookahead_callback()      - main-loop callback to release moves to the planner
+ * mp_lookahead_get_exit_vmax() - exit cap for the newest planner block
+ * mp_lookahead_has_room()      - true if another move may be held
+ * mp_lookahead_is_synced()     - true if the planner may be written by other means
+ * mp_lookahead_is_move_line()  - true if a line may be taken while moves are held
+ */
+
+/*
+ * mp_lookahead_init() - initialize lookahead structures
+ *
+ *  Does not touch the configuration, which is loaded by config_init()
+ */
+void mp_lookahead_init()
+{
+    look.magic_start = MAGICNUM;
+    look.magic_end = MAGICNUM;
+    look.held = 0;
+    mp_lookahead_abort();
+}
+
+/*
+ * mp_lookahead_abort() - discard all moves held without sending them to the planner
+ *
+ *  OK to call if nothing is held. Used by mp_flush_planner().
+ */
+void mp_lookahead_abort()
+{
+    look.head = 0;
+    look.count = 0;
+    look.exit_vmax = 0;
+}
+
+/*
+ * mp_lookahead_aline() - lookahead entry point for straight moves
+ *
+ *  gm_in    - Gcode state of the move, as would be passed to mp_aline()
+ *  position - model position at the start of the move (unrotated)
+ *
+ *  Returns STAT_OK if the move was held, STAT_MINIMUM_LENGTH_MOVE if it would be held but
+ *  has no length, STAT_EAGAIN if moves are held and this one can't join them, or else the
+ *  status of mp_coalesce_aline().
+ */
+stat_t mp_lookahead_aline(GCodeState_t *gm_in, const float position[])
+{
+    if (look.count == 0) {
+        if (!mp_planner_is_full() || !_is_holdable(gm_in)) {
+            return (mp_coalesce_aline(gm_in, position));    // nothing held - straight through
+        }
+        copy_vector(look.position, position);
+        look.gm = *gm_in;
+        look.exit_vmax = 0;                         // the newest planner block was planned to stop
+        look.parse_ahead = (look.enable == LOOKAHEAD_PARSE_AHEAD);
+    } else if (!_is_holdable(gm_in) || !_is_compatible(gm_in)) {
+        return (STAT_EAGAIN);                       // must wait for the moves held to drain
+    }
+    if (look.count == LOOKAHEAD_QUEUE_SIZE) {
+        if (mp_planner_is_full()) {                 // the controller doesn't read a line for this case
+            return (cm_panic(STAT_BUFFER_FULL_FATAL, "mp_lookahead_aline()"));
+        }
+        ritorno(_release_move());
+    }
+
+    float axis_length[AXES];
+    bool moves = false;
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        axis_length[axis] = gm_in->target[axis] - look.position[axis];
+        if (fp_NOT_ZERO(axis_length[axis])) {
+            moves = true;
+        } else {
+            axis_length[axis] = 0;                  // make it truly zero if it was tiny, as mp_aline() does
+        }
+    }
+    if (!moves) {
+        return (STAT_MINIMUM_LENGTH_MOVE);
+    }
+
+    laEntry_t *e = &look.entry[(look.head + look.count) % LOOKAHEAD_QUEUE_SIZE];
+    copy_vector(e->target, gm_in->target);
+    e->feed_rate = gm_in->feed_rate;
+    e->linenum = gm_in->linenum;
+    e->motion_mode = gm_in->motion_mode;
+    e->spindle_speed = gm_in->spindle_speed;
+    e->spindle_control = gm_in->spindle_control;
+    e->raster_row = gm_in->raster_row;
+    e->output_first = gm_in->output_first;
+    e->output_count = gm_in->output_count;
+    e->braking_velocity = 0;
+    look.count++;
+    look.held++;
+    copy_vector(look.position, e->target);
+    if (look.parse_ahead) {
+        return (STAT_OK);                           // held for parsing ahead only - no limits needed
+    }
+
+    mp_calculate_line_limits(&limits_bf, gm_in, axis_length);
+    e->length = limits_bf.length;
+    e->jerk = limits_bf.jerk;
+    e->cruise_vmax = limits_bf.cruise_vmax * min((float)1.0, mp.mfo_factor);
+    e->entry_vmax = 0;                              // the junction with a released move is not needed
+    if (look.count > 1) {
+        const laEntry_t *pv = &look.entry[(look.head + look.count - 2) % LOOKAHEAD_QUEUE_SIZE];
+        e->entry_vmax = _get_junction_vmax(pv, e, limits_bf.unit);
+    }
+    copy_vector(look.unit, limits_bf.unit);
+    _update_braking_velocities();
+    return (STAT_OK);
+}
+
+/*
+ * mp_lookahead_callback() - release moves held for as long as the planner has room
+ */
+stat_t mp_lookahead_callback()
+{
+    if (look.count == 0) {
+        return (STAT_NOOP);
+    }
+    while ((look.count > 0) && (!mp_planner_is_full())) {
+        ritorno(_release_move());
+    }
+    return (STAT_OK);
+}
+
+/*
+ * mp_lookahead_get_exit_vmax() - exit cap for the newest planner block
+ *
+ *  Called by the planner for the newest block. Returns 0 - plan it to stop - unless it was
+ *  released from the queue and is followed by moves still held.
+ */
+float mp_lookahead_get_exit_vmax(const mpBuf_t *bf)
+{
+    if ((look.count == 0) || (look.parse_ahead) || (bf->block_type != BLOCK_TYPE_ALINE)) {
+        return (0);
+    }
+
+    // Once the previous block is committed with a capped exit this one must keep the cap
+    mpBuf_t *pv = bf->pv;
+    if ((pv->buffer_state >= MP_BUFFER_PLANNED) && (pv->exit_velocity > 0)) {
+        return (min(look.exit_vmax, bf->cruise_vmax));
+    }
+
+    // Otherwise only cap when enough time is queued ahead of this block
+    float queued_time = 0;
+    while ((pv != bf) && (pv->buffer_state != MP_BUFFER_EMPTY)) {
+        queued_time += pv->block_time;
+        if (pv == mb.r) {
+            break;
+        }
+        pv = pv->pv;
+    }
+    if (queued_time < LOOKAHEAD_QUEUED_TIME) {
+        return (0);
+    }
+    return (min(look.exit_vmax, bf->cruise_vmax));
+}
+
+/*
+ * mp_lookahead_has_room() - true if another move may be held
+ * mp_lookahead_is_synced() - true if nothing is held and the planner has room
+ */
+bool mp_lookahead_has_room()
+{
+    return ((look.enable) && (look.count < LOOKAHEAD_QUEUE_SIZE));
+}
+
+bool mp_lookahead_is_synced()
+{
+    return ((look.count == 0) && (!mp_planner_is_full()));
+}
+
+/*
+ * mp_lookahead_is_move_line() - test if a Gcode line may be taken while moves are held
+ *
+ *  True for G0 and G1 lines with nothing but axis, F and N words (and a checksum) in a
+ *  state moves may be held in, so the line can only add a move to the queue. Also true
+ *  for blank lines and single character commands, which never reach the planner queue,
+ *  and for binary frames carrying a G0 or G1 record (see binary_parser.cpp). The controller holds back any other line while mp_lookahead_is_synced() is false.
+ */
+bool mp_lookahead_is_move_line(const char *line)
+{
+    while ((*line == SPC) || (*line == TAB)) {
+        line++;
+    }
+    if ((*line == NUL) || (*line == '!') || (*line == '~') || (*line == '%') ||
+        (*line == EOT) || (*line == ENQ) || (*line == CAN)) {
+        return (true);
+    }
+    bool motion_word = false;
+    if (*line == BINARY_FRAME_START) {              // binary records carry their own motion mode
+        if (!binary_is_move_frame(line)) {
+            return (false);
+        }
+        motion_word = true;
+    } else {
+        for (const char *p = line; *p != NUL; p++) {
+            char c = toupper(*p);
+            if (isdigit(c) || (strchr(" \t\r\n.+-*XYZABCFN", c) != NULL)) {
+                continue;
+            }
+            if (c != 'G') {
+                return (false);
+            }
+            char *end;
+            long g = strtol(p+1, &end, 10);
+            if ((end == p+1) || (*end == '.') || ((g != 0) && (g != 1))) {
+                return (false);                     // G1.1, G10, G17, G28...
+            }
+            motion_word = true;
+            p = end - 1;
+        }
+    }
+    if (!motion_word && (cm.gm.motion_mode != MOTION_MODE_STRAIGHT_TRAVERSE) &&
+                        (cm.gm.motion_mode != MOTION_MODE_STRAIGHT_FEED)) {
+        return (false);                             // axis words would continue an arc or canned cycle
+    }
+    return ((look.enable) &&
+            ((cm.cycle_state == CYCLE_OFF) || (cm.cycle_state == CYCLE_MACHINING)) &&
+            (cm.gm.feed_rate_mode == UNITS_PER_MINUTE_MODE) &&
+            (cm.gm.path_control == PATH_CONTINUOUS));
+}
+
+/*
+ * _is_holdable() - test if a move may be held at all
+ */
+static bool _is_holdable(const GCodeState_t *gm_in)
+{
+    if ((!look.enable) || (cm.cycle_state != CYCLE_MACHINING) ||
+        ((gm_in->motion_mode != MOTION_MODE_STRAIGHT_TRAVERSE) && (gm_in->motion_mode != MOTION_MODE_STRAIGHT_FEED)) ||
+        (gm_in->feed_rate_mode != UNITS_PER_MINUTE_MODE) || (gm_in->path_control != PATH_CONTINUOUS) ||
+        (fp_NOT_ZERO(cm.rotation_z_offset))) {
+        return (false);
+    }
+    for (uint8_t i = 0; i < 3; i++) {               // the limits are taken in the Gcode frame
+        for (uint8_t j = 0; j < 3; j++) {
+            if (fp_NE(cm.rotation_matrix[i][j], (i == j) ? 1 : 0)) {
+                return (false);
+            }
+        }
+    }
+    return (true);
+}
+
+/*
+ * _is_compatible() - test if a move shares the state of the moves held
+ */
+static bool _is_compatible(const GCodeState_t *gm_in)
+{
+    return ((gm_in->coord_system == look.gm.coord_system) &&
+            (gm_in->tool == look.gm.tool) &&
+            (gm_in->absolute_override == look.gm.absolute_override) &&
+            (vector_equal(gm_in->work_offset, look.gm.work_offset)));
+}
+
+/*
+ * _get_junction_vmax() - junction limit between two moves held
+ *
+ *  Never above what _calculate_junction_vmax() finds for the same two blocks: the corner
+ *  limit, and in junction curvature mode also the curve limit, whichever is lower.
+ */
+static float _get_junction_vmax(const laEntry_t *pv, const laEntry_t *e, const float unit[])
+{
+    float velocity = min(pv->cruise_vmax, e->cruise_vmax);
+    float turn_sq = 0;
+
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        float delta = fabs(look.unit[axis] - unit[axis]);
+        if (delta > EPSILON) {
+            velocity = min(velocity, cm.a[axis].max_junction_accel / delta);
+        }
+        turn_sq += square(delta);
+    }
+    if ((cm.junction_curvature_enable) && (turn_sq > EPSILON)) {
+        float radius = (pv->length + e->length) / (2 * sqrt(turn_sq));
+        velocity = min(velocity, cbrt(min(pv->jerk, e->jerk) * square(radius)));
+    }
+    return (velocity);
+}
+
+/*
+ * _update_braking_velocities() - carry the stop at the end of the queue back to the head
+ */
+static void _update_braking_velocities()
+{
+    float braking_velocity = 0;                     // velocity at the end of the newest move held
+
+    for (uint16_t i = look.count; i > 0; i--) {
+        laEntry_t *e = &look.entry[(look.head + i - 1) % LOOKAHEAD_QUEUE_SIZE];
+        limits_bf.jerk = e->jerk;
+        braking_velocity = min(e->entry_vmax, mp_get_target_velocity(braking_velocity, e->length, &limits_bf));
+        if ((braking_velocity == e->braking_velocity) && (i < look.count)) {
+            break;                                  // nothing behind this move changes either
+        }
+        e->braking_velocity = braking_velocity;
+    }
+}
+
+/*
+ * _release_move() - send the oldest move held to the planner
+ */
+static stat_t _release_move()
+{
+    laEntry_t *e = &look.entry[look.head];
+    copy_vector(look.gm.target, e->target);
+    look.gm.feed_rate = e->feed_rate;
+    look.gm.linenum = e->linenum;
+    look.gm.motion_mode = e->motion_mode;
+    look.gm.spindle_speed = e->spindle_speed;
+    look.gm.spindle_control = e->spindle_control;
+    look.gm.raster_row = e->raster_row;
+    look.gm.output_first = e->output_first;
+    look.gm.output_count = e->output_count;
+    look.head = (look.head + 1) % LOOKAHEAD_QUEUE_SIZE;
+    look.count--;
+
+    stat_t status = mp_aline(&look.gm);
+    if (status == STAT_OK) {
+        look.exit_vmax = (look.count > 0) ? look.entry[look.head].braking_velocity : 0;
+    }
+    return ((status == STAT_MINIMUM_LENGTH_MOVE) ? STAT_OK : status);
+}
+
+/***********************************************************************************
+ * TEXT MODE SUPPORT
+ * Functions to print variables from the cfgArray table
+ ***********************************************************************************/
+
+#ifdef __TEXT_MODE
+
+static const char fmt_looke[] = "[looke] lookahead enable%16d [0=disable,1=enable,2=parse ahead only]\n";
+static const char fmt_lookn[] = "[lookn] lookahead moves held%12d\n";
+
+void mp_print_looke(nvObj_t *nv) { text_print(nv, fmt_looke);}     // TYPE_INT
+void mp_print_lookn(nvObj_t *nv) { text_print(nv, fmt_lookn);}     // TYPE_INT
+
+#endif // __TEXT_MODE
@@ -0,0 +1,121 @@
+/*
+ * plan_lookahead.h - streaming lookahead queue in front of the line planner
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ *  The planner can only look as far ahead as its buffer pool reaches, and it plans the
+ *  newest block to stop because nothing is known past it. On boards with small pools and
+ *  short CAM segments that caps the velocity well below the feed rate.
+ *
+ *  When the planner queue is full the lookahead queue keeps taking straight moves and
+ *  holds each one as a few words - target, feed rate, line number and the limits needed
+ *  to brake. For every move held it keeps the highest velocity the machine may enter it
+ *  at and still stop at the end of the last move held. Moves are released to mp_aline()
+ *  as planner buffers free up, and the planner caps the exit of its newest block at that
+ *  velocity instead of planning it to a stop.
+ *
+ *  With parse ahead only (looke=2) moves are held the same way, but no limits are taken
+ *  and the exit is never capped. Lines are still read and parsed while the planner is
+ *  full, so the next move is waiting the moment a buffer frees up, and the plan is the
+ *  same as with the queue off.
+ *
+ *  Include after canonical_machine.h and planner.h
+ */
+
+#ifndef PLAN_LOOKAHEAD_H_ONCE
+#define PLAN_LOOKAHEAD_H_ONCE
+
+#ifndef LOOKAHEAD_QUEUE_SIZE    // set by MACHINE_PROFILE in the Makefile
+#define LOOKAHEAD_QUEUE_SIZE    128     // moves that may be held beyond the planner queue
+#endif
+#ifndef LOOKAHEAD_QUEUED_MS
+#define LOOKAHEAD_QUEUED_MS     ((float)10.0)   // run time queued ahead of the newest block before its exit is capped
+#endif
+#define LOOKAHEAD_QUEUED_TIME   ((float)(LOOKAHEAD_QUEUED_MS / 60000))  // DO NOT CHANGE - time in minutes
+
+typedef enum {                          // look.enable settings
+    LOOKAHEAD_DISABLED = 0,             // moves wait in the RX buffer while the planner is full
+    LOOKAHEAD_ENABLED,                  // hold moves and cap the exit of the newest planner block
+    LOOKAHEAD_PARSE_AHEAD               // hold moves only - parse ahead of the planner, plan as if disabled
+} laEnable;
+
+typedef struct laLookaheadEntry {       // one held move - about 50 bytes vs. a full planner buffer
+    float target[AXES];                 // Gcode model target (unrotated)
+    float feed_rate;
+    uint32_t linenum;
+    cmMotionMode motion_mode;           // straight traverse or straight feed
+    float spindle_speed;                // S carried by the move
+    int8_t spindle_control;             // M3/M4/M5 carried by the move, or -1
+    int8_t raster_row;                  // raster row carried by the move, or -1
+    uint8_t output_first;               // M62/M63 output changes carried by the move
+    uint8_t output_count;
+
+    float length;
+    float jerk;                         // block jerk, as mp_aline() will set it
+    float cruise_vmax;                  // cruise vmax, as mp_aline() will set it
+    float entry_vmax;                   // junction with the previous move held, capped by both cruise vmaxes
+    float braking_velocity;             // highest entry velocity that still stops at the end of the queue
+} laEntry_t;
+
+typedef struct laLookaheadSingleton {   // lookahead configuration and queue
+    magic_t magic_start;
+
+    // configuration
+    uint8_t enable;                     // looke  see laEnable
+
+    // queue
+    uint16_t head;                      // oldest move held
+    uint16_t count;                     // number of moves held
+    bool parse_ahead;                   // the moves held take no limits - looke was 2 when the first was held
+    float position[AXES];               // end of the newest move held
+    float unit[AXES];                   // unit vector of the newest move held
+    float exit_vmax;                    // exit cap for the newest planner block (see mp_lookahead_get_exit_vmax())
+    GCodeState_t gm;                    // Gcode state shared by all moves held
+    laEntry_t entry[LOOKAHEAD_QUEUE_SIZE];
+
+    uint32_t held;                      // lookn  count of moves that waited in the queue
+
+    magic_t magic_end;
+} look_t;
+extern look_t look;
+
+/* lookahead function prototypes */
+
+void   mp_lookahead_init(void);
+void   mp_lookahead_abort(void);
+stat_t mp_lookahead_aline(GCodeState_t *gm_in, const float position[]);
+stat_t mp_lookahead_callback(void);
+float  mp_lookahead_get_exit_vmax(const mpBuf_t *bf);
+bool   mp_lookahead_has_room(void);
+bool   mp_lookahead_is_synced(void);
+bool   mp_lookahead_is_move_line(const char *line);
+
+/* text mode display functions */
+
+#ifdef __TEXT_MODE
+
+    void mp_print_looke(nvObj_t *nv);
+    void mp_print_lookn(nvObj_t *nv);
+
+#else
+
+    #define mp_print_looke tx_print_stub
+    #define mp_print_lookn tx_print_stub
+
+#endif // __TEXT_MODE
+
+#endif  // End of include guard: PLAN_LOOKAHEAD_H_ONCE
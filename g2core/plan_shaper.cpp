@@ -0,0 +1,361 @@
+/*
+ * plan_shaper.cpp - input shaping of the segment positions in the runtime
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* --- Input Shaping Notes ----
+ *
+ *  For a resonance of frequency f and damping ratio z the damped period is
+ *  T = 1 / (f * sqrt(1-z^2)) and each half period the vibration decays by
+ *  K = exp(-z*pi / sqrt(1-z^2)). The shapers are (amplitudes, then times):
+ *
+ *      ZV      1, K                            0, T/2          / (1+K)
+ *      ZVD     1, 2K, K^2                      0, T/2, T       / (1+K)^2
+ *      EI      (1+V)/4, (1-V)K/2, (1+V)K^2/4   0, T/2, T       / sum
+ *
+ *  where V is the residual vibration EI is designed to tolerate. The amplitudes of each
+ *  shaper sum to 1, so the shaped path ends where the planned path does.
+ *
+ *  The shaped position of an axis at time t is the sum of A_i * p(t - t_i), with p the
+ *  planned path. Each axis is delayed further so its centroid (the sum of A_i * t_i) lands
+ *  on the largest centroid of any axis, D. Unshaped axes take a single impulse at D. The
+ *  taps of all axes are sorted by age so one walk back through the history finds them all.
+ *  The history holds the segment targets with the time between them, and the path between
+ *  two targets is taken as the straight line the segment ran.
+ *
+ *  The kernel is computed by the main loop whenever the configuration changes and is
+ *  adopted by the exec only when the history has stood still for the span of the kernel
+ *  in use, so the switch causes no jump. The exec runs a few settling segments at the end
+ *  of every move that stops (see mp_shaper_settle_segments()), so that is always the case
+ *  at the start of the next move.
+ */
+#include "g2core.h"
+#include "config.h"
+#include "controller.h"
+#include "planner.h"
+#include "plan_shaper.h"
+#include "text_parser.h"
+#include "util.h"
+#include "xio.h"
+
+#include <atomic>           // atomic_signal_fence() orders the pending kernel between main loop and exec
+
+// Allocate shaper singleton structure
+
+shp_t shp;
+
+#define SHAPER_STILL_FOREVER ((float)1)     // still time of a freshly reset history (minutes) - longer than any span
+
+// Local functions
+
+static void _compute_kernel(void);
+static void _adopt_kernel(void);
+
+/*****************************************************************************
+ * Shaper functions
+ *
+ * mp_shaper_init()            - initialize the shaper
+ * mp_shaper_reset()           - fill the history with a position
+ * mp_shaper_step()            - shape the next segment target
+ * mp_shaper_settle_segments() - segments the shaper needs to come to rest after a stop
+ */
+
+/*
+ * mp_shaper_init() - initialize shaper structures
+ *
+ *  Does not touch the configuration or the kernel, which are loaded by config_init()
+ */
+void mp_shaper_init()
+{
+    shp.magic_start = MAGICNUM;
+    shp.magic_end = MAGICNUM;
+    mp_shaper_reset(mr.position);
+}
+
+/*
+ * mp_shaper_reset() - fill the history with a position, as if it had been there forever
+ *
+ *  Called when the steps are set from the runtime position, and when a position has been
+ *  reached without the shaper - by a jog. Adopts a pending kernel, as nothing is moving.
+ */
+void mp_shaper_reset(const float position[])
+{
+    for (uint8_t i = 0; i < SHAPER_HISTORY; i++) {
+        shp.history[i].dt = NOM_SEGMENT_TIME;
+        copy_vector(shp.history[i].position, position);
+    }
+    copy_vector(shp.output, position);
+    shp.newest = 0;
+    shp.still_time = SHAPER_STILL_FOREVER;
+    _adopt_kernel();
+}
+
+/*
+ * mp_shaper_step() - add a segment target to the history and return its shaped position
+ *
+ *  target       - planned position at the end of the segment
+ *  segment_time - time of the segment (minutes)
+ *  previous     - returns the shaped position at the start of the segment
+ *  shaped       - returns the shaped position at the end of the segment
+ *
+ *  Runs in the exec. With no axis shaped the target is passed straight through.
+ */
+HOT_PATH void mp_shaper_step(const float target[], const float segment_time, float previous[], float shaped[])
+{
+    if (shp.pending_ready && (shp.still_time >= shp.k.span)) {
+        std::atomic_signal_fence(std::memory_order_acquire);
+        mp_shaper_reset(shp.history[shp.newest].position);    // the history is at rest - switch kernels here
+    }
+    if (vector_equal(target, shp.history[shp.newest].position)) {
+        shp.still_time += segment_time;
+    } else {
+        shp.still_time = 0;
+    }
+    shp.newest = (shp.newest + 1) % SHAPER_HISTORY;
+    shp.history[shp.newest].dt = segment_time;
+    float *newest = shp.history[shp.newest].position;
+    for (uint8_t axis = 0; axis < AXES; axis++) {   // copy_vector() can't size array parameters
+        newest[axis] = target[axis];
+        previous[axis] = shp.output[axis];
+        shaped[axis] = target[axis];
+    }
+    if (!shp.k.enabled) {
+        copy_vector(shp.output, shp.history[shp.newest].position);
+        return;
+    }
+
+    // walk back through the history once, picking up the taps in order of age
+    uint8_t i = shp.newest;                         // entry at or after the tap
+    uint8_t walked = 0;
+    float age = 0;                                  // age of entry i
+    for (uint8_t t = 0; t < shp.k.taps; t++) {
+        const shpTap_t *tap = &shp.k.tap[t];
+        while ((walked < SHAPER_HISTORY-1) && (age + shp.history[i].dt < tap->age)) {
+            age += shp.history[i].dt;
+            i = (i == 0) ? SHAPER_HISTORY-1 : i-1;
+            walked++;
+        }
+        float p = shp.history[i].position[tap->axis];
+        if (walked < SHAPER_HISTORY-1) {            // interpolate toward the entry before
+            uint8_t j = (i == 0) ? SHAPER_HISTORY-1 : i-1;
+            float fraction = min((tap->age - age) / shp.history[i].dt, (float)1);
+            p += (shp.history[j].position[tap->axis] - p) * fraction;
+        }                                           // ...otherwise clamp to the oldest entry
+        shaped[tap->axis] += tap->weight * (p - newest[tap->axis]);
+    }
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        shp.output[axis] = shaped[axis];
+    }
+}
+
+/*
+ * mp_shaper_settle_segments() - segments the shaper needs to come to rest after a stop
+ *
+ *  The count of nominal segments that covers the span of the kernel, plus one so the
+ *  last of them returns the target exactly. Zero if no axis is shaped.
+ */
+uint32_t mp_shaper_settle_segments()
+{
+    if (!shp.k.enabled) {
+        return (0);
+    }
+    return ((uint32_t)ceil(shp.k.span / NOM_SEGMENT_TIME) + 1);
+}
+
+/*
+ * _compute_kernel() - compute the kernel for the configuration into the pending kernel
+ */
+static void _compute_kernel()
+{
+    float amplitude[SHAPER_AXES][SHAPER_IMPULSES];
+    float time[SHAPER_AXES][SHAPER_IMPULSES];
+    uint8_t impulses[SHAPER_AXES];
+    float centroid[SHAPER_AXES];
+    float delay = 0;
+    bool enabled = false;
+
+    float z = shp.damping;
+    float root = sqrt(1 - z*z);
+    float K = exp(-z * M_PI / root);
+
+    for (uint8_t axis = 0; axis < SHAPER_AXES; axis++) {
+        impulses[axis] = 0;
+        centroid[axis] = 0;
+        if ((shp.type[axis] == SHAPER_OFF) || (shp.frequency[axis] < SHAPER_FREQUENCY_MIN)) {
+            continue;
+        }
+        float half = 1 / (shp.frequency[axis] * root * 2 * 60);    // half the damped period (minutes)
+        float *A = amplitude[axis];
+        float *t = time[axis];
+        t[0] = 0;
+        t[1] = half;
+        t[2] = 2 * half;
+        if (shp.type[axis] == SHAPER_ZV) {
+            impulses[axis] = 2;
+            A[0] = 1;
+            A[1] = K;
+        } else if (shp.type[axis] == SHAPER_ZVD) {
+            impulses[axis] = 3;
+            A[0] = 1;
+            A[1] = 2*K;
+            A[2] = K*K;
+        } else {
+            impulses[axis] = 3;
+            A[0] = (1 + SHAPER_EI_VIBRATION) / 4;
+            A[1] = (1 - SHAPER_EI_VIBRATION) * K / 2;
+            A[2] = A[0] * K*K;
+        }
+        float sum = 0;
+        for (uint8_t i = 0; i < impulses[axis]; i++) {
+            sum += A[i];
+        }
+        for (uint8_t i = 0; i < impulses[axis]; i++) {
+            A[i] /= sum;
+            centroid[axis] += A[i] * t[i];
+        }
+        delay = max(delay, centroid[axis]);
+        enabled = true;
+    }
+
+    shp.pending_ready = false;                      // the exec must not adopt a half written kernel
+    std::atomic_signal_fence(std::memory_order_release);
+
+    shpKernel_t *k = &shp.pending;
+    k->enabled = enabled;
+    k->taps = 0;
+    k->span = 0;
+    if (enabled) {
+        for (uint8_t axis = 0; axis < AXES; axis++) {
+            if ((axis >= SHAPER_AXES) || (impulses[axis] == 0)) {
+                k->tap[k->taps].age = delay;        // unshaped axes are delayed to keep in step
+                k->tap[k->taps].weight = 1;
+                k->tap[k->taps++].axis = axis;
+                continue;
+            }
+            for (uint8_t i = 0; i < impulses[axis]; i++) {
+                k->tap[k->taps].age = delay - centroid[axis] + time[axis][i];
+                k->tap[k->taps].weight = amplitude[axis][i];
+                k->tap[k->taps++].axis = axis;
+            }
+        }
+        for (uint8_t t = 1; t < k->taps; t++) {     // insertion sort by age
+            shpTap_t tap = k->tap[t];
+            uint8_t u = t;
+            for (; (u > 0) && (k->tap[u-1].age > tap.age); u--) {
+                k->tap[u] = k->tap[u-1];
+            }
+            k->tap[u] = tap;
+        }
+        k->span = k->tap[k->taps-1].age;
+    }
+
+    std::atomic_signal_fence(std::memory_order_release);
+    shp.pending_ready = true;
+}
+
+/*
+ * _adopt_kernel() - put the pending kernel in use. The history must be at rest
+ */
+static void _adopt_kernel()
+{
+    if (shp.pending_ready) {
+        shp.k = shp.pending;
+        shp.pending_ready = false;
+    }
+}
+
+/***********************************************************************************
+ * CONFIGURATION AND INTERFACE FUNCTIONS
+ * Functions to get and set variables from the cfgArray table
+ ***********************************************************************************/
+
+/*
+ * mp_set_shpt() - set a shaper type
+ * mp_set_shpf() - set a shaper frequency
+ * mp_set_shpd() - set the damping ratio
+ */
+
+stat_t mp_set_shpt(nvObj_t *nv)
+{
+    if (nv->value < SHAPER_OFF) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    if (nv->value >= SHAPER_TYPE_MAX) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_EXCEEDS_MAX_VALUE);
+    }
+    set_ui8(nv);
+    _compute_kernel();
+    return (STAT_OK);
+}
+
+stat_t mp_set_shpf(nvObj_t *nv)
+{
+    if (nv->value < SHAPER_FREQUENCY_MIN) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    if (nv->value > SHAPER_FREQUENCY_MAX) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_EXCEEDS_MAX_VALUE);
+    }
+    set_flt(nv);
+    _compute_kernel();
+    return (STAT_OK);
+}
+
+stat_t mp_set_shpd(nvObj_t *nv)
+{
+    if (nv->value < 0) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    if (nv->value > SHAPER_DAMPING_MAX) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_EXCEEDS_MAX_VALUE);
+    }
+    set_flt(nv);
+    _compute_kernel();
+    return (STAT_OK);
+}
+
+/***********************************************************************************
+ * TEXT MODE SUPPORT
+ * Functions to print variables from the cfgArray table
+ ***********************************************************************************/
+
+#ifdef __TEXT_MODE
+
+static const char fmt_shpt[] = "[%s] %c shaper type%18d [0=off,1=ZV,2=ZVD,3=EI]\n";
+static const char fmt_shpf[] = "[%s] %c shaper frequency%17.1f Hz\n";
+static const char fmt_shpd[] = "[shpd]  shaper damping ratio%13.3f\n";
+
+void mp_print_shpt(nvObj_t *nv)
+{
+    str_format(cs.out_buf, fmt_shpt, nv->token, nv->token[3], (uint8_t)nv->value);
+    xio_writeline(cs.out_buf);
+}
+
+void mp_print_shpf(nvObj_t *nv)
+{
+    str_format(cs.out_buf, fmt_shpf, nv->token, nv->token[3], nv->value);
+    xio_writeline(cs.out_buf);
+}
+
+void mp_print_shpd(nvObj_t *nv) { text_print(nv, fmt_shpd);}       // TYPE_FLOAT
+
+#endif // __TEXT_MODE
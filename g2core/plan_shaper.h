@@ -0,0 +1,123 @@
+/*
+ * plan_shaper.h - input shaping of the segment positions in the runtime
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ *  A light gantry rings at its resonant frequency after every change in acceleration.
+ *  An input shaper cancels the ringing by splitting each change into 2 or 3 smaller ones,
+ *  spaced half a period apart so the vibrations they excite cancel. In the time domain
+ *  this is a convolution of the commanded path with a few weighted impulses, which the
+ *  exec does on the segment targets - from a short history of them - just before they
+ *  are converted to steps. Planning, jerk limits and the reported position are unchanged.
+ *
+ *  X, Y and Z each take their own shaper type and frequency, and all share one damping
+ *  ratio. The axes are shifted to the same centroid delay so they stay in step with each
+ *  other, and A, B and C are delayed with them. The shaped path trails the planned one by
+ *  that delay and rounds its corners by about the same time.
+ *
+ *  Include after planner.h
+ */
+
+#ifndef PLAN_SHAPER_H_ONCE
+#define PLAN_SHAPER_H_ONCE
+
+#define SHAPER_AXES             3       // X, Y and Z may be shaped
+#define SHAPER_IMPULSES         3       // most impulses in a shaper (ZVD and EI)
+#define SHAPER_TAPS             (SHAPER_AXES*SHAPER_IMPULSES + AXES-SHAPER_AXES)
+#define SHAPER_HISTORY          64      // segment targets kept. Must cover the span at the shortest segments
+#define SHAPER_FREQUENCY_MIN    ((float)25)     // Hz - lower frequencies would outrun the history
+#define SHAPER_FREQUENCY_MAX    ((float)500)    // Hz
+#define SHAPER_DAMPING_MAX      ((float)0.3)
+#define SHAPER_EI_VIBRATION     ((float)0.05)   // residual vibration the EI shaper is designed to allow
+
+typedef enum {                          // shaper types {shpxt:}
+    SHAPER_OFF = 0,
+    SHAPER_ZV,                          // 2 impulses over half a period - shortest, least robust
+    SHAPER_ZVD,                         // 3 impulses over a period - robust to frequency error
+    SHAPER_EI,                          // 3 impulses over a period - most robust to frequency error
+    SHAPER_TYPE_MAX
+} shaperType;
+
+typedef struct shpTap {                 // one impulse of one axis
+    float age;                          // how far back in the history (minutes)
+    float weight;                       // share of the impulse. The weights of each axis sum to 1
+    uint8_t axis;
+} shpTap_t;
+
+typedef struct shpKernel {              // taps of all axes, in order of age
+    bool enabled;                       // false if no axis is shaped - targets pass straight through
+    uint8_t taps;
+    float span;                         // age of the oldest tap (minutes)
+    shpTap_t tap[SHAPER_TAPS];
+} shpKernel_t;
+
+typedef struct shpEntry {               // one segment target in the history
+    float dt;                           // time from the previous entry (minutes)
+    float position[AXES];
+} shpEntry_t;
+
+typedef struct shpShaperSingleton {     // input shaper configuration and runtime
+    magic_t magic_start;
+
+    // configuration
+    uint8_t type[SHAPER_AXES];          // shpxt  shaper type - see shaperType
+    float frequency[SHAPER_AXES];       // shpxf  resonant frequency (Hz)
+    float damping;                      // shpd   damping ratio of the resonances
+
+    // kernel - computed by the main loop, adopted by the exec when the history is at rest
+    volatile bool pending_ready;        // pending holds a kernel the exec has not adopted
+    shpKernel_t pending;
+    shpKernel_t k;                      // kernel in use
+
+    // runtime
+    uint8_t newest;                     // index of the newest entry in the history
+    float still_time;                   // time the history has been at the newest position (minutes)
+    shpEntry_t history[SHAPER_HISTORY];
+    float output[AXES];                 // shaped position at the end of the last segment
+
+    magic_t magic_end;
+} shp_t;
+extern shp_t shp;
+
+/* shaper function prototypes */
+
+void   mp_shaper_init(void);
+void   mp_shaper_reset(const float position[]);
+void   mp_shaper_step(const float target[], const float segment_time, float previous[], float shaped[]);
+uint32_t mp_shaper_settle_segments(void);
+
+stat_t mp_set_shpt(nvObj_t *nv);
+stat_t mp_set_shpf(nvObj_t *nv);
+stat_t mp_set_shpd(nvObj_t *nv);
+
+/* text mode display functions */
+
+#ifdef __TEXT_MODE
+
+    void mp_print_shpt(nvObj_t *nv);
+    void mp_print_shpf(nvObj_t *nv);
+    void mp_print_shpd(nvObj_t *nv);
+
+#else
+
+    #define mp_print_shpt tx_print_stub
+    #define mp_print_shpf tx_print_stub
+    #define mp_print_shpd tx_print_stub
+
+#endif // __TEXT_MODE
+
+#endif  // End of include guard: PLAN_SHAPER_H_ONCE
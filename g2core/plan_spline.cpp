@@ -0,0 +1,389 @@
+/*
+ * plan_spline.cpp - cubic spline (G5) planning and curve math
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* --- Spline Notes ----
+ *
+ *  A spline is the cubic Bezier B(u) with control points P0 to P3, u running from 0 to 1.
+ *  Its speed |B'(u)| is not constant, so the planner and exec work in arc length instead:
+ *  mp_spline_init_length() integrates the speed over each of SPLINE_INTERVALS equal steps
+ *  of u (3 point Gauss-Legendre) into a table of lengths, and mp_spline_parameter() turns
+ *  a distance along the curve back into u. Within an interval u(s) is a cubic Hermite with
+ *  the slopes du/ds = 1/|B'(u)| at both ends, so the velocity is continuous across the
+ *  table. The slopes are capped at 3 times the secant, which keeps u(s) monotonic where a
+ *  control point sits on an end point and the speed there is zero.
+ *
+ *  The segmented form cuts the curve in equal steps of u. A chord over a step du strays
+ *  from the curve by at most du^2/8 * max|B''|, and B'' is linear in u so its largest
+ *  magnitude is at an end. That gives the step for the chordal tolerance (ct). As for arcs,
+ *  the segments are not made shorter in time than MIN_SPLINE_SEGMENT_USEC.
+ */
+#include "g2core.h"
+#include "config.h"
+#include "canonical_machine.h"
+#include "planner.h"
+#include "plan_spline.h"
+#include "util.h"
+
+// Allocate spline singleton structure
+
+spl_t spl;
+
+// Local functions
+
+static float _get_curvature_accel(const mpSpline_t *s);
+static stat_t _test_spline_soft_limits(void);
+
+/*****************************************************************************
+ * Canonical Machining spline functions
+ *
+ * cm_spline_init()     - initialize splines
+ * cm_spline_feed()     - canonical machine entry point for G5
+ * cm_spline_callback() - main-loop callback for spline segment generation
+ * cm_abort_spline()    - stop a spline in process
+ */
+
+/*
+ * cm_spline_init() - initialize spline structures
+ */
+void cm_spline_init()
+{
+    spl.magic_start = MAGICNUM;
+    spl.magic_end = MAGICNUM;
+}
+
+/*
+ * cm_abort_spline() - stop spline movement without maintaining position
+ *
+ *  OK to call if no spline is running
+ */
+void cm_abort_spline()
+{
+    spl.run_state = BLOCK_INACTIVE;
+}
+
+/*
+ * cm_spline_block_is_usable() - true if a spline can be queued as a single spline block
+ *
+ *  Spline blocks are interpolated in the planner frame, so there must be no coordinate
+ *  rotation. Not available unless the planner is built with PLANNER_ARC_BLOCKS.
+ */
+bool cm_spline_block_is_usable()
+{
+#if (PLANNER_ARC_BLOCKS == 1)
+    for (uint8_t i=0; i<3; i++) {
+        for (uint8_t j=0; j<3; j++) {
+            float identity = (i == j) ? 1.0 : 0.0;
+            if (fp_NE(cm.rotation_matrix[i][j], identity)) {
+                return (false);
+            }
+        }
+    }
+    return (fp_ZERO(cm.rotation_z_offset));
+#else
+    return (false);
+#endif
+}
+
+/*
+ * cm_spline_feed() - canonical machine entry point for G5
+ *
+ *  It is an error if the plane is not G17, if any axis but X or Y is given, if P and Q are
+ *  not both given, if only one of I and J is given, or if I and J are left out of a G5 that
+ *  does not follow another G5.
+ */
+stat_t cm_spline_feed(const float target[], const bool target_f[],      // target endpoint
+                      const float offset[], const bool offset_f[],      // I J - first control point
+                      const float P_word, const bool P_word_f,          // P Q - second control point
+                      const float Q_word, const bool Q_word_f)
+{
+    // G5 motion mode persists, so a block with only F or a non-motion word can get here
+    if (!(target_f[AXIS_X] | target_f[AXIS_Y] | offset_f[OFS_I] | offset_f[OFS_J] | P_word_f | Q_word_f)) {
+        return (STAT_OK);
+    }
+    if (fp_ZERO(cm.gm.feed_rate)) {
+        return (STAT_GCODE_FEEDRATE_NOT_SPECIFIED);
+    }
+    if (cm.gm.select_plane != CANON_PLANE_XY) {
+        return (STAT_GCODE_ACTIVE_PLANE_IS_INVALID);
+    }
+    for (uint8_t axis = AXIS_Z; axis < AXES; axis++) {
+        if (target_f[axis]) {
+            return (STAT_ARC_SPECIFICATION_ERROR);
+        }
+    }
+    if (!(P_word_f && Q_word_f) || (offset_f[OFS_I] != offset_f[OFS_J]) || offset_f[OFS_K]) {
+        return (STAT_ARC_SPECIFICATION_ERROR);
+    }
+    bool continued = (cm.gm.motion_mode == MOTION_MODE_CUBIC_SPLINE);  // the last motion was a G5
+    if (!offset_f[OFS_I] && !continued) {
+        return (STAT_ARC_OFFSETS_MISSING_FOR_SELECTED_PLANE);
+    }
+    float entry_control[2];
+    if (offset_f[OFS_I]) {
+        entry_control[0] = _to_millimeters(offset[OFS_I]);
+        entry_control[1] = _to_millimeters(offset[OFS_J]);
+    } else {
+        entry_control[0] = -spl.exit_control[0];    // leave the way the last one arrived
+        entry_control[1] = -spl.exit_control[1];
+    }
+
+    cm_set_model_target(target, target_f);
+    cm.gm.motion_mode = MOTION_MODE_CUBIC_SPLINE;
+    spl.exit_control[0] = _to_millimeters(P_word);
+    spl.exit_control[1] = _to_millimeters(Q_word);
+
+    mpSpline_t *s = &spl.curve;
+    for (uint8_t axis = 0; axis < SPLINE_AXES; axis++) {
+        s->p[0][axis] = cm.gmx.position[axis];
+        s->p[1][axis] = cm.gmx.position[axis];
+        s->p[2][axis] = cm.gm.target[axis];
+        s->p[3][axis] = cm.gm.target[axis];
+    }
+    s->p[1][AXIS_X] += entry_control[0];
+    s->p[1][AXIS_Y] += entry_control[1];
+    s->p[2][AXIS_X] += spl.exit_control[0];
+    s->p[2][AXIS_Y] += spl.exit_control[1];
+    float length = mp_spline_init_length(s);
+
+    stat_t status = _test_spline_soft_limits();
+    if (status != STAT_OK) {
+        cm.gm.motion_mode = MOTION_MODE_CANCEL_MOTION_MODE;
+        copy_vector(cm.gm.target, cm.gmx.position);     // reset model position
+        return (cm_alarm(status, "spline soft_limits"));
+    }
+    cm_set_work_offsets(&cm.gm);                        // capture the fully resolved offsets to the state
+    cm_cycle_start();                                   // if not already started
+
+#if (PLANNER_ARC_BLOCKS == 1)
+    if (cm_spline_block_is_usable()) {
+        status = mp_spline(&cm.gm, s);                  // queue the whole spline as one block
+        cm.gm.output_count = 0;                         // M62/M63 changes went with the block
+        cm_finalize_move();
+        return ((status == STAT_MINIMUM_LENGTH_MOVE) ? STAT_OK : status);
+    }
+#endif
+
+    // cut into segments, queued by cm_spline_callback()
+    memcpy(&spl.gm, &cm.gm, sizeof(GCodeState_t));
+    float time = (spl.gm.feed_rate_mode == INVERSE_TIME_MODE) ? spl.gm.feed_rate : length / spl.gm.feed_rate;
+    float segments_for_chordal_accuracy = ceil(est_sqrt(_get_curvature_accel(s) / (8 * cm.chordal_tolerance)));
+    float segments_for_minimum_time = floor(time * (MICROSECONDS_PER_MINUTE / MIN_SPLINE_SEGMENT_USEC));
+    float segments = min(segments_for_chordal_accuracy, segments_for_minimum_time);
+    segments = max(min(segments, SPLINE_SEGMENTS_MAX), (float)1.0);
+    if (spl.gm.feed_rate_mode == INVERSE_TIME_MODE) {
+        spl.gm.feed_rate /= segments;
+    }
+    spl.segments = (uint32_t)segments;
+    spl.segment_count = spl.segments;
+    spl.run_state = BLOCK_ACTIVE;
+    cm.gm.output_count = 0;                             // M62/M63 changes go with the first segment (spl.gm)
+    cm_finalize_move();
+    return (STAT_OK);
+}
+
+/*
+ * cm_spline_callback() - queue the segments of a spline
+ *
+ *  Queues up to SPLINE_SEGMENTS_PER_CALLBACK segments each time it's called, or fewer if
+ *  the planner fills. The last segment ends exactly on the target.
+ */
+stat_t cm_spline_callback()
+{
+    if (spl.run_state == BLOCK_INACTIVE) {
+        return (STAT_NOOP);
+    }
+    for (uint8_t i=0; i<SPLINE_SEGMENTS_PER_CALLBACK; i++) {
+        if (mp_planner_is_full()) {
+            return (STAT_EAGAIN);
+        }
+        if (--spl.segment_count == 0) {
+            copy_vector(spl.gm.target, cm.gmx.position);    // the model is already at the end
+        } else {
+            mp_spline_point(&spl.curve, (float)(spl.segments - spl.segment_count) / spl.segments, spl.gm.target);
+        }
+        mp_aline(&spl.gm);
+        spl.gm.output_count = 0;                    // only the first segment carries M62/M63 changes
+
+        if (spl.segment_count == 0) {
+            spl.run_state = BLOCK_INACTIVE;
+            return (STAT_OK);
+        }
+    }
+    return (STAT_EAGAIN);
+}
+
+/*
+ * _get_curvature_accel() - largest magnitude of B'' on the curve
+ */
+static float _get_curvature_accel(const mpSpline_t *s)
+{
+    float start = 0;
+    float end = 0;
+    for (uint8_t axis = 0; axis < SPLINE_AXES; axis++) {
+        start += square(s->p[0][axis] - 2*s->p[1][axis] + s->p[2][axis]);
+        end += square(s->p[1][axis] - 2*s->p[2][axis] + s->p[3][axis]);
+    }
+    return (6 * est_sqrt(max(start, end)));
+}
+
+/*
+ * _test_spline_soft_limits() - return error code if the curve leaves the soft limits
+ *
+ *  The curve is tested at 2 points in each interval of its length table, which is enough
+ *  for any curve that isn't sharply bent. The end point has been tested with the rest.
+ */
+static stat_t _test_spline_soft_limits()
+{
+    float point[AXES];
+    copy_vector(point, cm.gm.target);
+    for (uint8_t i = 1; i < 2*SPLINE_INTERVALS; i++) {
+        mp_spline_point(&spl.curve, (float)i / (2*SPLINE_INTERVALS), point);
+        ritorno(cm_test_soft_limits(point));
+    }
+    return (cm_test_soft_limits(cm.gm.target));
+}
+
+/*****************************************************************************
+ * Curve functions - used by the planner and the exec
+ *
+ * mp_spline_point()       - point at parameter u. Sets the spline axes of point[] only
+ * mp_spline_derivative()  - derivative B'(u) of the spline axes, returns its magnitude
+ * mp_spline_second_derivative() - second derivative B''(u) of the spline axes
+ * mp_spline_unit()        - unit tangent at u, for all axes
+ * mp_spline_init_length() - fill in the arc length table, returns the length
+ * mp_spline_parameter()   - parameter u at a distance along the curve
+ * mp_spline_split()       - cut the curve at u, keeping the part after it
+ */
+
+void mp_spline_point(const mpSpline_t *s, const float u, float point[])
+{
+    float v = 1 - u;
+    float b0 = v*v*v;
+    float b1 = 3*v*v*u;
+    float b2 = 3*v*u*u;
+    float b3 = u*u*u;
+    for (uint8_t axis = 0; axis < SPLINE_AXES; axis++) {
+        point[axis] = b0*s->p[0][axis] + b1*s->p[1][axis] + b2*s->p[2][axis] + b3*s->p[3][axis];
+    }
+}
+
+float mp_spline_derivative(const mpSpline_t *s, const float u, float d[])
+{
+    float v = 1 - u;
+    float b0 = 3*v*v;
+    float b1 = 6*v*u;
+    float b2 = 3*u*u;
+    float speed_squared = 0;
+    for (uint8_t axis = 0; axis < SPLINE_AXES; axis++) {
+        d[axis] = b0 * (s->p[1][axis] - s->p[0][axis]) +
+                  b1 * (s->p[2][axis] - s->p[1][axis]) +
+                  b2 * (s->p[3][axis] - s->p[2][axis]);
+        speed_squared += square(d[axis]);
+    }
+    return (fast_sqrt(speed_squared));
+}
+
+void mp_spline_second_derivative(const mpSpline_t *s, const float u, float dd[])
+{
+    for (uint8_t axis = 0; axis < SPLINE_AXES; axis++) {
+        dd[axis] = 6 * ((1-u) * (s->p[2][axis] - 2*s->p[1][axis] + s->p[0][axis]) +
+                           u  * (s->p[3][axis] - 2*s->p[2][axis] + s->p[1][axis]));
+    }
+}
+
+void mp_spline_unit(const mpSpline_t *s, const float u, float unit[])
+{
+    float d[SPLINE_AXES];
+    float speed = mp_spline_derivative(s, u, d);
+    if (speed < EPSILON) {                          // a control point on the end point - look along a little
+        speed = mp_spline_derivative(s, (u < 0.5) ? u + 0.001 : u - 0.001, d);
+    }
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        unit[axis] = 0;
+    }
+    if (speed < EPSILON) {
+        return;
+    }
+    for (uint8_t axis = 0; axis < SPLINE_AXES; axis++) {
+        unit[axis] = d[axis] / speed;
+    }
+}
+
+float mp_spline_init_length(mpSpline_t *s)
+{
+    static const float node = 0.7745966692;         // sqrt(3/5)
+    const float half = (float)0.5 / SPLINE_INTERVALS;
+    float d[SPLINE_AXES];
+
+    s->length[0] = 0;
+    for (uint8_t k = 0; k < SPLINE_INTERVALS; k++) {
+        float mid = (2*k + 1) * half;
+        float integral = (5 * mp_spline_derivative(s, mid - node*half, d) +
+                          8 * mp_spline_derivative(s, mid, d) +
+                          5 * mp_spline_derivative(s, mid + node*half, d)) * half / 9;
+        s->length[k+1] = s->length[k] + integral;
+    }
+    return (s->length[SPLINE_INTERVALS]);
+}
+
+float mp_spline_parameter(const mpSpline_t *s, const float distance, uint8_t *interval)
+{
+    const float *length = s->length;
+    const float du = (float)1 / SPLINE_INTERVALS;
+
+    if (distance >= length[SPLINE_INTERVALS]) {
+        *interval = SPLINE_INTERVALS-1;
+        return (1);
+    }
+    uint8_t k = *interval;
+    while ((k > 0) && (distance < length[k])) {
+        k--;
+    }
+    while ((k < SPLINE_INTERVALS-1) && (distance >= length[k+1])) {
+        k++;
+    }
+    *interval = k;
+
+    float h = length[k+1] - length[k];
+    float u = k * du;
+    if (h < EPSILON) {
+        return (u);
+    }
+    float d[SPLINE_AXES];                           // end slopes, scaled to the interval
+    float m0 = min(h / max(mp_spline_derivative(s, u, d), EPSILON), 3*du);
+    float m1 = min(h / max(mp_spline_derivative(s, u + du, d), EPSILON), 3*du);
+    float t = max(distance - length[k], (float)0) / h;
+    float t2 = t*t;
+    float t3 = t2*t;
+    return (u + du * (3*t2 - 2*t3) + m0 * (t3 - 2*t2 + t) + m1 * (t3 - t2));
+}
+
+void mp_spline_split(mpSpline_t *s, const float u)
+{
+    for (uint8_t axis = 0; axis < SPLINE_AXES; axis++) {   // de Casteljau
+        float a = s->p[0][axis] + (s->p[1][axis] - s->p[0][axis]) * u;
+        float b = s->p[1][axis] + (s->p[2][axis] - s->p[1][axis]) * u;
+        float c = s->p[2][axis] + (s->p[3][axis] - s->p[2][axis]) * u;
+        float d = a + (b - a) * u;
+        float e = b + (c - b) * u;
+        s->p[0][axis] = d + (e - d) * u;
+        s->p[1][axis] = e;
+        s->p[2][axis] = c;
+    }
+    mp_spline_init_length(s);
+}
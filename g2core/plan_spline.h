@@ -0,0 +1,71 @@
+/*
+ * plan_spline.h - cubic spline (G5) planning and curve math
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ *  G5 X Y I J P Q is a cubic Bezier in the XY plane, as in LinuxCNC. I J is the first
+ *  control point relative to the start, P Q the second relative to the end. I J may be left
+ *  out of a G5 that follows another, in which case the curve leaves in the direction the
+ *  last one arrived (I J is the negative of its P Q).
+ *
+ *  With PLANNER_ARC_BLOCKS a spline is queued as one block, planned by its arc length and
+ *  interpolated by the exec, like an arc block. Otherwise - or with coordinate rotation -
+ *  it is cut into segments within the chordal tolerance and queued from cm_spline_callback().
+ *  The coalescer also uses spline blocks to replace chains of short G1 moves that fit a
+ *  curve within its tolerance (see plan_coalesce.cpp).
+ *
+ *  Include after canonical_machine.h and planner.h
+ */
+
+#ifndef PLAN_SPLINE_H_ONCE
+#define PLAN_SPLINE_H_ONCE
+
+#define SPLINE_SEGMENTS_PER_CALLBACK 4          // max segments queued per pass of cm_spline_callback()
+#define SPLINE_SEGMENTS_MAX     ((float)1000)   // max segments a spline is cut into
+#define MIN_SPLINE_SEGMENT_USEC ((float)10000)  // minimum spline segment time, as for arcs
+
+typedef struct splSplineSingleton {     // persistent G5 state and segment generator
+    magic_t magic_start;
+    uint8_t run_state;                  // BLOCK_ACTIVE while segments are queued from the callback
+
+    float exit_control[2];              // second control point of the last G5, relative to its end (P Q, mm)
+
+    mpSpline_t curve;                   // curve being segmented. Lengths are not used
+    uint32_t segments;                  // number of segments it is cut into
+    uint32_t segment_count;             // segments yet to queue
+    GCodeState_t gm;                    // Gcode state passed for each segment
+
+    magic_t magic_end;
+} spl_t;
+extern spl_t spl;
+
+/* spline function prototypes */
+
+void   cm_spline_init(void);
+void   cm_abort_spline(void);
+stat_t cm_spline_callback(void);
+bool   cm_spline_block_is_usable(void);
+
+void   mp_spline_point(const mpSpline_t *s, const float u, float point[]);
+float  mp_spline_derivative(const mpSpline_t *s, const float u, float d[]);
+void   mp_spline_second_derivative(const mpSpline_t *s, const float u, float dd[]);
+void   mp_spline_unit(const mpSpline_t *s, const float u, float unit[]);
+float  mp_spline_init_length(mpSpline_t *s);
+float  mp_spline_parameter(const mpSpline_t *s, const float distance, uint8_t *interval);
+void   mp_spline_split(mpSpline_t *s, const float u);
+
+#endif  // End of include guard: PLAN_SPLINE_H_ONCE
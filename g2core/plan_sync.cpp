@@ -0,0 +1,272 @@
+/*
+ * plan_sync.cpp - spindle synchronized motion: G33 threading and G33.1 rigid tapping
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "g2core.h"
+#include "config.h"
+#include "canonical_machine.h"
+#include "planner.h"
+#include "plan_shaper.h"
+#include "plan_sync.h"
+#include "plan_track.h"
+#include "plan_aux.h"
+#include "kinematics.h"
+#include "motion_link.h"
+#include "encoder.h"
+#include "gpio.h"
+#include "spindle.h"
+#include "stepper.h"
+#include "telemetry.h"
+#include "text_parser.h"
+#include "util.h"
+
+// Allocate spindle sync singleton structure
+
+syn_t syn;
+
+// Local functions
+
+static bool _sync_start(void);
+static bool _sync_step(const mpBuf_t *bf, const float segment_time);
+
+/*
+ * mp_sync_init() - initialize spindle synchronized motion
+ *
+ *  Does not touch the configuration, which is loaded by config_init()
+ */
+void mp_sync_init()
+{
+    syn.magic_start = MAGICNUM;
+    syn.magic_end = MAGICNUM;
+    syn.phase = SYNC_WAITING;
+    syn.rev_velocity = 0;
+    syn.rpm = 0;
+}
+
+/*
+ * mp_exec_sync() - run one segment of a spindle synchronized block - see plan_sync.h
+ *
+ *  Called by mp_exec_move() for every segment until the block ends. While it waits for the
+ *  spindle it preps nominal dwells, so the spindle is still read once a segment. Segments
+ *  are not shaped, their steps are not corrected, and they carry any conveyor tracking.
+ */
+stat_t mp_exec_sync(mpBuf_t *bf)
+{
+    const float dt = NOM_SEGMENT_TIME;
+
+    if (bf->block_state == BLOCK_INITIAL_ACTION) {
+        memcpy(&mr.gm, mp_get_block_gm(bf), sizeof(GCodeState_t));
+        copy_vector(mr.gm.target, (bf->sync_tap) ? mr.position : bf->cold->target);
+        mr.gm.linenum = bf->cold->linenum;
+        bf->block_state = BLOCK_ACTIVE;
+
+        copy_vector(syn.start, mr.position);
+        syn.control = (spindle.direction == SPINDLE_CW) ? SPINDLE_CONTROL_CW : SPINDLE_CONTROL_CCW;
+        syn.phase = SYNC_WAITING;
+        syn.settle = 0;
+        syn.last_counts = en_read_spindle();
+        syn.rev_velocity = 0;
+        syn.position = 0;
+        syn.velocity = 0;
+        syn.accel = 0;
+        en_clear_spindle_index();
+        if (cm.motion_state != MOTION_HOLD) {
+            cm_set_motion_state(MOTION_RUN);
+        }
+        st_prep_dwell((uint32_t)NOM_SEGMENT_USEC);
+        return (STAT_OK);
+    }
+
+    int32_t counts = en_read_spindle();
+    float sign = (syn.control == SPINDLE_CONTROL_CW) ? 1 : -1;
+    float turns = (float)(counts - syn.last_counts) / syn.counts_per_rev * sign;
+    syn.last_counts = counts;
+    syn.rev_velocity += SYNC_VELOCITY_FILTER * (turns / dt - syn.rev_velocity);
+    syn.rpm = fabs(syn.rev_velocity);
+
+    if ((syn.phase == SYNC_WAITING) && !_sync_start()) {
+        st_prep_dwell((uint32_t)NOM_SEGMENT_USEC);
+        return (STAT_OK);
+    }
+    bool done = _sync_step(bf, dt);
+
+    float target[AXES];
+    if (done && !bf->sync_tap) {
+        copy_vector(target, bf->cold->target);          // end exactly where the planner thinks
+    } else {
+        for (uint8_t axis = 0; axis < AXES; axis++) {
+            target[axis] = syn.start[axis] + bf->unit[axis] * syn.position;
+        }
+    }
+
+    float start[AXES];                                  // the segment on the machine - with any tracking
+    float end[AXES];
+    copy_vector(start, mr.position);
+    copy_vector(end, target);
+    mp_track_segment(dt, start, end);
+    mp_aux_segment(dt, start, end);
+
+    float travel_steps[MOTORS];
+    float following_error[MOTORS] = {0};                // the spindle sets the position, not the encoders
+    copy_vector(mr.position_steps, mr.target_steps);
+    kn_inverse_kinematics(end, mr.target_steps);
+    for (uint8_t m=0; m<MOTORS; m++) {
+        travel_steps[m] = mr.target_steps[m] - mr.position_steps[m];
+    }
+    mr.segment_time = dt;
+    mr.segment_velocity = fabs(syn.velocity);
+    mln_send_segment(start, end, dt);
+    ritorno(st_prep_line(travel_steps, following_error, dt));
+    copy_vector(mr.position, target);
+    tlm_sample();
+
+    if (done) {
+        mr.segment_velocity = 0;
+        syn.phase = SYNC_WAITING;
+        mp_shaper_reset(mr.position);                   // sync blocks are not shaped - start from here
+        if (mp_free_run_buffer()) {
+            cm_cycle_end();                             // free buffer & perform cycle_end if planner is empty
+        }
+    }
+    return (STAT_OK);
+}
+
+/*
+ * _sync_start() - true once the spindle velocity has settled and, with an index, at the index
+ *
+ *  The move's origin is the spindle count at the index, or where the spindle is now.
+ */
+static bool _sync_start()
+{
+    if (syn.settle < SYNC_SETTLE_SEGMENTS) {
+        syn.settle++;
+        return (false);
+    }
+    if (gpio_get_function_input(INPUT_FUNCTION_SPINDLE_INDEX) == 0) {
+        syn.origin_counts = syn.last_counts;
+    } else if (!en_get_spindle_index(&syn.origin_counts)) {
+        return (false);
+    }
+    syn.phase = SYNC_IN;
+    return (true);
+}
+
+/*
+ * _sync_step() - move the position along the block by one segment. True if the block is done
+ *
+ *  The spindle is read as the segment is prepped, but the segment only runs once the ones
+ *  queued ahead of it have, so the distance is taken to where the spindle will be by then.
+ *  The velocity chase is that of _exec_jog(). The axis is brought to a stop once it is
+ *  within its stopping distance of the end - the target of a G33, the start for the way
+ *  out of a G33.1 - and the position is clipped there.
+ */
+static bool _sync_step(const mpBuf_t *bf, const float segment_time)
+{
+    float revs = (float)(syn.last_counts - syn.origin_counts) / syn.counts_per_rev;
+    if (syn.control != SPINDLE_CONTROL_CW) {
+        revs = -revs;
+    }
+    float lead = st_prep_lines_queued() * segment_time; // until the segments so far have run
+    float gap = bf->sync_pitch * (revs + syn.rev_velocity * lead) - syn.position;
+    float v_max = bf->absolute_vmax;
+    float v_target = min(max(bf->sync_pitch * syn.rev_velocity + gap / SYNC_CATCHUP_TIME, -v_max), v_max);
+
+    float v = syn.velocity;
+    float a = syn.accel;
+    float j = bf->jerk;
+    bool ending = false;
+    if ((!bf->sync_tap) && (v > 0)) {
+        ending = ((bf->length - syn.position) <= v * (sqrt(v / j) + segment_time));
+    } else if ((syn.phase == SYNC_OUT) && (v < 0)) {
+        ending = (syn.position <= -v * (sqrt(-v / j) + segment_time));
+    }
+    if (ending) {
+        v_target = 0;
+    }
+    float dv = v_target - v;
+    float a_bound = copysignf(sqrt(2 * j * fabs(dv)), dv);
+    float da = j * segment_time;
+    if (a_bound > a + da) {
+        a += da;
+    } else if (a_bound < a - da) {
+        a -= da;
+    } else {
+        a = a_bound;
+    }
+    v += a * segment_time;
+    if (((dv > 0) && (v > v_target)) || ((dv < 0) && (v < v_target)) || fp_ZERO(dv)) {
+        v = v_target;                                   // arrived - don't overshoot
+        a = 0;
+    }
+    syn.velocity = v;
+    syn.accel = a;
+    syn.position += v * segment_time;
+
+    if (!bf->sync_tap) {
+        if ((syn.position >= bf->length) || (ending && (v == 0))) {
+            syn.position = bf->length;
+            syn.velocity = 0;
+            return (true);
+        }
+        return (false);
+    }
+    if ((syn.phase == SYNC_IN) && (syn.position >= bf->length)) {
+        syn.phase = SYNC_OUT;                           // at depth - reverse the spindle and follow it out
+        spindle_inline_sync(spindle.speed, (syn.control == SPINDLE_CONTROL_CW) ? SPINDLE_CONTROL_CCW : SPINDLE_CONTROL_CW);
+        return (false);
+    }
+    if ((syn.phase == SYNC_OUT) && ((syn.position <= 0) || (ending && (v == 0)))) {
+        syn.position = 0;
+        syn.velocity = 0;
+        spindle_inline_sync(spindle.speed, syn.control);
+        return (true);
+    }
+    return (false);
+}
+
+/***********************************************************************************
+ * CONFIGURATION AND INTERFACE FUNCTIONS
+ * Functions to get and set variables from the cfgArray table
+ ***********************************************************************************/
+
+/*
+ * mp_set_spec() - set the spindle encoder counts per turn. Not zero
+ */
+
+stat_t mp_set_spec(nvObj_t *nv)
+{
+    if (fp_ZERO(nv->value)) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_VALUE_RANGE_ERROR);
+    }
+    return (set_flt(nv));
+}
+
+/***********************************************************************************
+ * TEXT MODE SUPPORT
+ * Functions to print variables from the cfgArray table
+ ***********************************************************************************/
+
+#ifdef __TEXT_MODE
+
+static const char fmt_spec[] = "[spec] spindle encoder counts%12.1f per turn\n";
+static const char fmt_sprm[] = "[sprm] spindle measured speed%12.1f rpm\n";
+
+void mp_print_spec(nvObj_t *nv) { text_print(nv, fmt_spec);}       // TYPE_FLOAT
+void mp_print_sprm(nvObj_t *nv) { text_print(nv, fmt_sprm);}       // TYPE_FLOAT
+
+#endif // __TEXT_MODE
@@ -0,0 +1,111 @@
+/*
+ * plan_sync.h - spindle synchronized motion: G33 threading and G33.1 rigid tapping
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* A G33 moves K per turn of the spindle, so its feed follows the spindle encoder instead
+ *  of the clock. Its block (BLOCK_TYPE_SYNC, see mp_sync_line()) is not velocity planned:
+ *  the moves before and after it stop, and the exec runs it a nominal segment at a time
+ *  from the spindle turns measured since the block started. A G33.1 taps the same way to
+ *  its target, reverses the spindle there, follows it back out to where it started and
+ *  restores the spindle direction - the spindle and the axis stay locked the whole time.
+ *
+ *  Each segment the spindle encoder is read and its velocity measured. The distance the
+ *  spindle calls for is taken to where it will be when the segment runs, and the axis
+ *  velocity chases the spindle's with the block's jerk, plus a term that closes the gap, as
+ *  conveyor tracking does (plan_track.h). So the axis ramps up to the spindle from a stop
+ *  and the thread is only true once it has - start the move clear of the work by that.
+ *  A G33 ends with the axis' own stop at the target. A G33.1 goes deeper than the target
+ *  by what the spindle turns while it reverses, so program the depth short by that.
+ *
+ *  With a spindle index input (INPUT_FUNCTION_SPINDLE_INDEX), every block starts at the
+ *  index, so repeated threading passes cut the same thread. Without one a block starts at
+ *  whatever angle the spindle is at - fine for a single pass or a tap. The axes' feed rate
+ *  limits, not F, cap the velocity; the spindle must be slow enough to stay inside them.
+ *  Feed overrides don't apply, and a feedhold takes effect after the block.
+ *
+ *  {spec:} is the spindle encoder counts per turn, negative if it counts down as the
+ *  spindle turns clockwise. {sprm:} is the spindle speed measured during the last block.
+ *
+ *  Include after planner.h
+ */
+
+#ifndef PLAN_SYNC_H_ONCE
+#define PLAN_SYNC_H_ONCE
+
+#define SYNC_VELOCITY_FILTER    ((float)0.2)            // share of each segment's spindle velocity measurement
+#define SYNC_SETTLE_SEGMENTS    16                      // segments the velocity is measured before the move starts
+#define SYNC_CATCHUP_TIME       ((float)(0.05 / 60))    // time to close the gap to the spindle (minutes)
+
+typedef enum {
+    SYNC_WAITING = 0,                   // measuring the spindle and waiting for the index
+    SYNC_IN,                            // following the spindle to the target
+    SYNC_OUT                            // G33.1: following the reversed spindle back to the start
+} synPhase;
+
+typedef struct synSyncSingleton {       // spindle synchronized motion configuration and runtime
+    magic_t magic_start;
+
+    // configuration
+    float counts_per_rev;               // spec  spindle encoder counts per turn, negative if reversed
+
+    // runtime - written by the exec
+    synPhase phase;
+    uint8_t settle;                     // segments measured while waiting
+    int8_t control;                     // spindle direction as the block started - SPINDLE_CONTROL_CW or _CCW
+    int32_t last_counts;                // spindle count at the last segment
+    int32_t origin_counts;              // spindle count the move started at
+    float rev_velocity;                 // measured spindle velocity in the block's direction (turns/min)
+    float rpm;                          // sprm  measured spindle speed
+    float start[AXES];                  // position the block started from
+    float position;                     // distance travelled along the block (mm)
+    float velocity;                     // velocity along the block (mm/min)
+    float accel;                        // acceleration along the block (mm/min^2)
+
+    magic_t magic_end;
+} syn_t;
+extern syn_t syn;
+
+/* spindle synchronized motion function prototypes */
+
+void   mp_sync_init(void);
+stat_t mp_exec_sync(mpBuf_t *bf);
+
+stat_t mp_set_spec(nvObj_t *nv);
+
+/* text mode display functions */
+
+#ifdef __TEXT_MODE
+
+    void mp_print_spec(nvObj_t *nv);
+    void mp_print_sprm(nvObj_t *nv);
+
+#else
+
+    #define mp_print_spec tx_print_stub
+    #define mp_print_sprm tx_print_stub
+
+#endif // __TEXT_MODE
+
+#endif  // End of include guard: PLAN_SYNC_H_ONCE
@@ -0,0 +1,247 @@
+/*
+ * plan_track.cpp - conveyor tracking: an axis follows a conveyor encoder
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "g2core.h"
+#include "config.h"
+#include "canonical_machine.h"
+#include "planner.h"
+#include "plan_track.h"
+#include "encoder.h"
+#include "stepper.h"
+#include "text_parser.h"
+#include "util.h"
+
+// Allocate tracking singleton structure
+
+trk_t trk;
+
+// Local functions
+
+static void _track_step(const float segment_time, float start[], float end[]);
+
+/*****************************************************************************
+ * Tracking functions
+ *
+ * mp_track_init()         - initialize tracking
+ * mp_track_segment()      - add the tracking offset to a move segment
+ * mp_track_idle_segment() - add the tracking offset to a tracking-only segment
+ * mp_track_add_offset()   - add the offset of the last segment to a position
+ * mp_track_is_running()   - true if the offset is following the belt, or about to
+ * mp_track_is_idle()      - true if the steppers are running tracking-only segments
+ */
+
+/*
+ * mp_track_init() - initialize tracking structures
+ *
+ *  Does not touch the configuration, which is loaded by config_init()
+ */
+void mp_track_init()
+{
+    trk.magic_start = MAGICNUM;
+    trk.magic_end = MAGICNUM;
+    trk.enable = 0;
+    trk.start = false;
+    trk.stop = false;
+    trk.active = false;
+    trk.velocity = 0;
+    trk.accel = 0;
+    trk.offset = 0;
+    trk.idle_segments = 0;
+}
+
+/*
+ * mp_track_segment()      - called by the exec for every segment of a move or jog
+ * mp_track_idle_segment() - called by the exec for a segment with no move
+ *
+ *  start and end are the segment's start and target, after shaping. Both are moved by the
+ *  offset on the tracked axis. Call once per segment, just before the kinematics.
+ */
+void mp_track_segment(const float segment_time, float start[], float end[])
+{
+    trk.idle_segments = 0;
+    _track_step(segment_time, start, end);
+}
+
+void mp_track_idle_segment(const float segment_time, float start[], float end[])
+{
+    if (trk.idle_segments < UINT8_MAX) {
+        trk.idle_segments++;
+    }
+    _track_step(segment_time, start, end);
+}
+
+void mp_track_add_offset(float position[]) { position[trk.axis] += trk.offset; }
+
+bool mp_track_is_running() { return (trk.active || trk.start); }
+
+bool mp_track_is_idle() { return (mp_track_is_running() && (trk.idle_segments > PREP_BUFFERS)); }
+
+/*
+ * _track_step() - move the offset on by one segment
+ *
+ *  The belt is read as the segment is prepped, but the offset reached so far only runs once
+ *  the segments queued ahead have, so the gap is taken to where the belt will be by then.
+ *  At a steady belt velocity the gap closes to zero. The velocity chase is that of _exec_jog(): the
+ *  acceleration moves by at most jerk*dt per segment, and never exceeds the acceleration
+ *  from which the jerk can still bring it to zero as the velocity reaches the target.
+ */
+static void _track_step(const float segment_time, float start[], float end[])
+{
+    if (trk.start) {
+        trk.start = false;
+        trk.stop = false;
+        trk.origin_counts = en_read_conveyor();
+        trk.origin = trk.offset;
+        trk.belt_position = 0;
+        trk.belt_velocity = 0;
+        trk.sample_time = 0;
+        trk.active = true;                                  // velocity carries on if it was stopping
+    }
+    uint8_t axis = trk.axis;
+    start[axis] += trk.offset;
+
+    if (trk.active) {
+        float belt = (float)(en_read_conveyor() - trk.origin_counts) * trk.scale;
+        if (trk.sample_time > 0) {
+            float v_belt = (belt - trk.belt_position) / trk.sample_time;
+            trk.belt_velocity += TRACK_VELOCITY_FILTER * (v_belt - trk.belt_velocity);
+        }
+        trk.belt_position = belt;
+        trk.sample_time = segment_time;                     // the next reading comes about a segment later
+
+        float v_target = 0;
+        if (!trk.stop) {
+            float lead = st_prep_lines_queued() * segment_time;    // until the offset so far has run
+            float gap = trk.origin + belt + trk.belt_velocity * lead - trk.offset;
+            float v_max = cm.a[axis].velocity_max;
+            v_target = min(max(trk.belt_velocity + gap / TRACK_CATCHUP_TIME, -v_max), v_max);
+        }
+        float v = trk.velocity;
+        float a = trk.accel;
+        float j = cm.a[axis].jerk_max * JERK_MULTIPLIER;
+        float dv = v_target - v;
+        float a_bound = copysignf(sqrt(2 * j * fabs(dv)), dv);
+        float da = j * segment_time;
+        if (a_bound > a + da) {
+            a += da;
+        } else if (a_bound < a - da) {
+            a -= da;
+        } else {
+            a = a_bound;
+        }
+        v += a * segment_time;
+        if (((dv > 0) && (v > v_target)) || ((dv < 0) && (v < v_target)) || fp_ZERO(dv)) {
+            v = v_target;                                   // arrived - don't overshoot
+            a = 0;
+        }
+        trk.velocity = v;
+        trk.accel = a;
+        trk.offset += v * segment_time;
+        if (trk.stop && (v == 0)) {
+            trk.active = false;                             // stopped - the offset is held
+        }
+    }
+    end[axis] += trk.offset;
+}
+
+/*
+ * mp_track_callback() - fold a stopped offset into the position once the machine is idle
+ *
+ *  The axis is where it was left - the position moves to it, and the steps are unchanged.
+ */
+stat_t mp_track_callback()
+{
+    if (mp_track_is_running() || (trk.offset == 0)) {
+        return (STAT_NOOP);
+    }
+    if ((cm.cycle_state != CYCLE_OFF) || !mp_runtime_is_idle() || mp_has_runnable_buffer()) {
+        return (STAT_NOOP);
+    }
+    float position = mp_get_runtime_absolute_position(trk.axis) + trk.offset;
+    trk.offset = 0;
+    cm_set_position(trk.axis, position);
+    return (STAT_OK);
+}
+
+/***********************************************************************************
+ * CONFIGURATION AND INTERFACE FUNCTIONS
+ * Functions to get and set variables from the cfgArray table
+ ***********************************************************************************/
+
+/*
+ * mp_set_trke() - start or stop tracking. Starting needs a conveyor encoder
+ * mp_set_trka() - set the tracked axis. Not while an offset is held
+ */
+
+stat_t mp_set_trke(nvObj_t *nv)
+{
+    ritorno(set_01(nv));
+    if (trk.enable == 0) {
+        trk.start = false;
+        trk.stop = true;                                    // the exec brings the offset to a stop
+        return (STAT_OK);
+    }
+    if (!en_conveyor_is_present() || (cm.cycle_state == CYCLE_HOMING) || (cm.cycle_state == CYCLE_PROBE)) {
+        trk.enable = 0;
+        nv->valuetype = TYPE_NULL;
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    if (!trk.active || trk.stop) {
+        trk.start = true;
+        st_request_exec_move();                             // run tracking-only segments if nothing else is
+    }
+    return (STAT_OK);
+}
+
+stat_t mp_set_trka(nvObj_t *nv)
+{
+    if (nv->value < AXIS_X) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    if (nv->value >= AXES) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_EXCEEDS_MAX_VALUE);
+    }
+    if (mp_track_is_running() || (trk.offset != 0)) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    return (set_ui8(nv));
+}
+
+/***********************************************************************************
+ * TEXT MODE SUPPORT
+ * Functions to print variables from the cfgArray table
+ ***********************************************************************************/
+
+#ifdef __TEXT_MODE
+
+static const char fmt_trke[] = "[trke] tracking enable%13d [0=off,1=on]\n";
+static const char fmt_trka[] = "[trka] tracking axis%15d [0=X,1=Y,2=Z...]\n";
+static const char fmt_trks[] = "[trks] tracking belt per count%11.5f mm\n";
+static const char fmt_trkv[] = "[trkv] tracking belt velocity%12.3f mm/min\n";
+static const char fmt_trko[] = "[trko] tracking offset%19.3f mm\n";
+
+void mp_print_trke(nvObj_t *nv) { text_print(nv, fmt_trke);}       // TYPE_INT
+void mp_print_trka(nvObj_t *nv) { text_print(nv, fmt_trka);}       // TYPE_INT
+void mp_print_trks(nvObj_t *nv) { text_print(nv, fmt_trks);}       // TYPE_FLOAT
+void mp_print_trkv(nvObj_t *nv) { text_print(nv, fmt_trkv);}       // TYPE_FLOAT
+void mp_print_trko(nvObj_t *nv) { text_print(nv, fmt_trko);}       // TYPE_FLOAT
+
+#endif // __TEXT_MODE
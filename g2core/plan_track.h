@@ -0,0 +1,107 @@
+/*
+ * plan_track.h - conveyor tracking: an axis follows a conveyor encoder
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ *  With tracking on {trke:1} the tracked axis {trka:} follows a conveyor read by the
+ *  conveyor encoder (CONVEYOR_ENCODER_TC in encoder.h), {trks:} mm of belt per count. The
+ *  Gcode program runs in belt coordinates: the planner, the reported position and the soft
+ *  limits know nothing of the belt, and the exec adds the tracking offset to the tracked
+ *  axis of every segment target - after shaping - as it converts it to steps.
+ *
+ *  The offset is run like a velocity jog of the axis (see _exec_jog()). Each segment the
+ *  belt velocity is measured and the offset velocity chases it at the axis' jerk, plus a
+ *  term that closes the gap to where the belt will be when the segment runs. So tracking
+ *  can start and stop with the belt in motion with no jump, and the gap closes at the
+ *  axis' own rates. With no move queued, and in a feedhold, the exec runs tracking-only
+ *  segments so the axis keeps up with the belt between moves.
+ *
+ *  {trke:0} brings the offset to a stop. Once the machine is idle the offset is folded
+ *  into the axis position, so machine coordinates are true again and the work coordinates
+ *  have moved with the belt. The belt motion the axis can follow is limited by its travel,
+ *  which the offset is not checked against - size the tracking window with the program.
+ *  A queue flush, homing and probing need tracking off.
+ *
+ *  Include after planner.h
+ */
+
+#ifndef PLAN_TRACK_H_ONCE
+#define PLAN_TRACK_H_ONCE
+
+#define TRACK_VELOCITY_FILTER   ((float)0.1)            // share of each segment's belt velocity measurement
+#define TRACK_CATCHUP_TIME      ((float)(0.25 / 60))    // time to close the gap to the belt (minutes)
+
+typedef struct trkTrackSingleton {      // conveyor tracking configuration and runtime
+    magic_t magic_start;
+
+    // configuration
+    uint8_t enable;                     // trke  follow the belt
+    uint8_t axis;                       // trka  the axis that follows it
+    float scale;                        // trks  belt travel per encoder count (mm), negative if reversed
+
+    // runtime - written by the exec unless noted
+    volatile bool start;                // main loop: start tracking from the next segment
+    volatile bool stop;                 // main loop: bring the offset to a stop
+    volatile bool active;               // the offset is moving with the belt
+    int32_t origin_counts;              // belt count as tracking started
+    float origin;                       // offset as tracking started (mm)
+    float belt_position;                // belt travel since tracking started (mm)
+    float belt_velocity;                // trkv  measured belt velocity (mm/min)
+    float sample_time;                  // time since the last belt reading (minutes)
+    float velocity;                     // offset velocity (mm/min)
+    float accel;                        // offset acceleration (mm/min^2)
+    float offset;                       // trko  offset at the end of the last segment prepped (mm)
+    uint8_t idle_segments;              // tracking-only segments prepped since the last move segment
+
+    magic_t magic_end;
+} trk_t;
+extern trk_t trk;
+
+/* tracking function prototypes */
+
+void   mp_track_init(void);
+void   mp_track_segment(const float segment_time, float start[], float end[]);
+void   mp_track_idle_segment(const float segment_time, float start[], float end[]);
+void   mp_track_add_offset(float position[]);
+bool   mp_track_is_running(void);
+bool   mp_track_is_idle(void);
+stat_t mp_track_callback(void);
+
+stat_t mp_set_trke(nvObj_t *nv);
+stat_t mp_set_trka(nvObj_t *nv);
+
+/* text mode display functions */
+
+#ifdef __TEXT_MODE
+
+    void mp_print_trke(nvObj_t *nv);
+    void mp_print_trka(nvObj_t *nv);
+    void mp_print_trks(nvObj_t *nv);
+    void mp_print_trkv(nvObj_t *nv);
+    void mp_print_trko(nvObj_t *nv);
+
+#else
+
+    #define mp_print_trke tx_print_stub
+    #define mp_print_trka tx_print_stub
+    #define mp_print_trks tx_print_stub
+    #define mp_print_trkv tx_print_stub
+    #define mp_print_trko tx_print_stub
+
+#endif // __TEXT_MODE
+
+#endif  // End of include guard: PLAN_TRACK_H_ONCE
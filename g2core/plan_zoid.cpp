@@ -71,6 +71,85 @@ static float _get_meet_velocity(const float          v_0,
                                 mpBuf_t*             bf,
                                 mpBlockRuntimeBuf_t* block);
 
+/*
+ * Meet velocity memo
+ *
+ * _meet_memo_find()  - restore the rate-limited (3c) solution of an identical block. Returns true if it did
+ * _meet_memo_store() - remember the one just solved
+ *
+ *  CAM output repeats the same short segments many times over - a row of identical
+ *  steps in a pocket, or the facets of a tessellated arc - and they plan to the same
+ *  entry and exit velocities, so _get_meet_velocity() solves the same problem again
+ *  and again. The last MEET_MEMO_SIZE solutions are kept, keyed on everything the
+ *  solution depends on: the entry, exit and cruise velocities, the length and the jerk
+ *  term. The match is exact, so a hit gives the same ramps the solver would have.
+ *  Entries are replaced round robin. Set MEET_MEMO_SIZE to 0 to remove the memo.
+ */
+
+#ifndef MEET_MEMO_SIZE
+#define MEET_MEMO_SIZE 4                    // solutions kept
+#endif
+
+#if MEET_MEMO_SIZE > 0
+
+typedef struct mpMeetMemoEntry {
+    float entry_velocity;                   // key
+    float exit_velocity;
+    float cruise_vmax;                      // block->cruise_velocity before the solve
+    float length;
+    float q_recip_2_sqrt_j;                 // 0 if the entry is empty
+    float cruise_velocity;                  // solution
+    float head_length;
+    float body_length;
+    float tail_length;
+    int8_t meet_iterations;
+} mpMeetMemoEntry_t;
+
+typedef struct mpMeetMemo {
+    uint8_t next;                           // entry replaced next
+    mpMeetMemoEntry_t entry[MEET_MEMO_SIZE];
+} mpMeetMemo_t;
+
+static mpMeetMemo_t meet_memo;
+
+static bool _meet_memo_find(const float entry_velocity, mpBuf_t *bf, mpBlockRuntimeBuf_t *block)
+{
+    for (uint8_t i = 0; i < MEET_MEMO_SIZE; i++) {
+        mpMeetMemoEntry_t *e = &meet_memo.entry[i];
+        if ((e->length == bf->length) && (e->entry_velocity == entry_velocity) &&
+            (e->exit_velocity == block->exit_velocity) && (e->cruise_vmax == block->cruise_velocity) &&
+            (e->q_recip_2_sqrt_j == bf->q_recip_2_sqrt_j)) {
+            block->cruise_velocity = e->cruise_velocity;
+            block->head_length = e->head_length;
+            block->body_length = e->body_length;
+            block->tail_length = e->tail_length;
+            bf->cold->meet_iterations = e->meet_iterations;
+            return (true);
+        }
+    }
+    return (false);
+}
+
+static void _meet_memo_store(const float entry_velocity, const float exit_velocity, const float cruise_vmax,
+                             const mpBuf_t *bf, const mpBlockRuntimeBuf_t *block)
+{
+    mpMeetMemoEntry_t *e = &meet_memo.entry[meet_memo.next];
+    meet_memo.next = (meet_memo.next + 1) % MEET_MEMO_SIZE;
+
+    e->entry_velocity = entry_velocity;
+    e->exit_velocity = exit_velocity;
+    e->cruise_vmax = cruise_vmax;
+    e->length = bf->length;
+    e->q_recip_2_sqrt_j = bf->q_recip_2_sqrt_j;
+    e->cruise_velocity = block->cruise_velocity;
+    e->head_length = block->head_length;
+    e->body_length = block->body_length;
+    e->tail_length = block->tail_length;
+    e->meet_iterations = bf->cold->meet_iterations;
+}
+
+#endif // MEET_MEMO_SIZE > 0
+
 /****************************************************************************************
  * mp_calculate_ramps() - calculate trapezoid-like ramp parameters for a block
  *
@@ -119,12 +198,84 @@ void _zoid_exit(mpBuf_t* bf, zoidExitPoint exit_point)
     //+++++ DIAGNOSTIC
     //    bf->zoid_exit = exit_point;
     if (mp_runtime_is_idle()) {  // normally the runtime keeps this value fresh
-                                 //        bf->time_in_plan_ms += bf->block_time_ms;
-        bf->plannable_time_ms += bf->block_time_ms;
+                                 //        bf->cold->time_in_plan_ms += bf->cold->block_time_ms;
+        bf->cold->plannable_time_ms += bf->cold->block_time_ms;
     }
 }
 
 
+/*
+ * Perfect and mixed fit solvers - one per fit, selected from the hint
+ *
+ *  Each is straight-line code that writes every section of the block, so a block that
+ *  takes one of these fits never runs the general case. They take the velocities they
+ *  are called with as final: the caller has already checked the fit.
+ */
+
+// PERFECT_CRUISE (1c) body only, at velocity v
+static inline float _fit_body(mpBlockRuntimeBuf_t* block, const mpBuf_t* bf, const float v)
+{
+    block->exit_velocity   = v;
+    block->cruise_velocity = v;
+    block->head_length = 0;
+    block->body_length = bf->length;
+    block->tail_length = 0;
+    block->head_time = 0;
+    block->body_time = block->body_length / block->cruise_velocity;
+    block->tail_time = 0;
+    return (block->body_time);
+}
+
+// PERFECT_ACCELERATION (1a) head only, from v_0 to block->exit_velocity
+static inline float _fit_head(mpBlockRuntimeBuf_t* block, const mpBuf_t* bf, const float v_0)
+{
+    block->cruise_velocity = block->exit_velocity;
+    block->head_length = bf->length;
+    block->body_length = 0;
+    block->tail_length = 0;
+    block->head_time = (block->head_length * 2.0) / (v_0 + block->cruise_velocity);
+    block->body_time = 0;
+    block->tail_time = 0;
+    return (block->head_time);
+}
+
+// PERFECT_DECELERATION (1d) tail only, from v_0 to block->exit_velocity
+static inline float _fit_tail(mpBlockRuntimeBuf_t* block, const mpBuf_t* bf, const float v_0)
+{
+    block->cruise_velocity = v_0;
+    block->head_length = 0;
+    block->body_length = 0;
+    block->tail_length = bf->length;
+    block->head_time = 0;
+    block->body_time = 0;
+    block->tail_time = block->tail_length * 2 / (block->exit_velocity + block->cruise_velocity);
+    return (block->tail_time);
+}
+
+// MIXED_ACCELERATION (2a) head and body, from v_0 up to block->cruise_velocity
+static inline float _fit_head_body(mpBlockRuntimeBuf_t* block, const mpBuf_t* bf, const float v_0)
+{
+    block->head_length = mp_get_target_length(v_0, block->cruise_velocity, bf);
+    block->body_length = bf->length - block->head_length;
+    block->tail_length = 0;
+    block->head_time = (block->head_length * 2.0) / (v_0 + block->cruise_velocity);
+    block->body_time = block->body_length / block->cruise_velocity;
+    block->tail_time = 0;
+    return (block->head_time + block->body_time);
+}
+
+// MIXED_DECELERATION (2d) body and tail, from block->cruise_velocity down to block->exit_velocity
+static inline float _fit_body_tail(mpBlockRuntimeBuf_t* block, const mpBuf_t* bf)
+{
+    block->tail_length = mp_get_target_length(block->exit_velocity, block->cruise_velocity, bf);
+    block->body_length = bf->length - block->tail_length;
+    block->head_length = 0;
+    block->head_time = 0;
+    block->body_time = block->body_length / block->cruise_velocity;
+    block->tail_time = block->tail_length * 2 / (block->exit_velocity + block->cruise_velocity);
+    return (block->body_time + block->tail_time);
+}
+
 // Hint will be one of these from back-planning: COMMAND_BLOCK, PERFECT_DECELERATION, PERFECT_CRUISE,
 // MIXED_DECELERATION, ASYMMETRIC_BUMP
 // We are incorporating both the forward planning and ramp-planning into one function, since we use the same data.
@@ -140,23 +291,9 @@ void mp_calculate_ramps(mpBlockRuntimeBuf_t* block, mpBuf_t* bf, const float ent
 
     // Timing from *here*
 
-    // initialize parameters to know values
-    block->head_time = 0;
-    block->body_time = 0;
-    block->tail_time = 0;
-
-    block->head_length = 0;
-    block->body_length = 0;
-    block->tail_length = 0;
-
     block->cruise_velocity = min(bf->cruise_velocity, bf->cruise_vmax);
     block->exit_velocity   = min(bf->exit_velocity, bf->exit_vmax);
 
-
-    // We *might* do this exact computation later, so cache the value.
-    float test_velocity       = 0;
-    bool  test_velocity_valid = false;  // record if we have a validly cached value
-
     // *** Perfect-Fit Cases (1) *** Cases where curve fitting has already been done
 
     // PERFECT_CRUISE (1c) Velocities all match (or close enough), treat as body-only
@@ -167,13 +304,7 @@ void mp_calculate_ramps(mpBlockRuntimeBuf_t* block, mpBuf_t* bf, const float ent
         if ((!mp.entry_changed) && fp_EQ(entry_velocity, bf->cruise_vmax)) {
             // We need to ensure that neither the entry or the exit velocities are
             // <= the cruise velocity even though there is tolerance in fp_EQ comparison.
-            block->exit_velocity   = entry_velocity;
-            block->cruise_velocity = entry_velocity;
-
-            block->body_length = bf->length;
-            block->body_time   = block->body_length / block->cruise_velocity;
-            bf->block_time     = block->body_time;
-
+            bf->block_time = _fit_body(block, bf, entry_velocity);
             LOG_RETURN("1c");
             return (_zoid_exit(bf, ZOID_EXIT_1c));
         } else {
@@ -202,13 +333,7 @@ void mp_calculate_ramps(mpBlockRuntimeBuf_t* block, mpBuf_t* bf, const float ent
         // MIXED_DECELERATION (2d) 2 segment BT deceleration move
         // Only possible if the entry has not changed since hinting.
         else if (bf->hint == MIXED_DECELERATION) {
-            block->tail_length = mp_get_target_length(block->exit_velocity, block->cruise_velocity, bf);
-            block->body_length = bf->length - block->tail_length;
-            block->head_length = 0;
-
-            block->body_time = block->body_length / block->cruise_velocity;
-            block->tail_time = block->tail_length * 2 / (block->exit_velocity + block->cruise_velocity);
-            bf->block_time   = block->body_time + block->tail_time;
+            bf->block_time = _fit_body_tail(block, bf);
             LOG_RETURN("2d");
             return (_zoid_exit(bf, ZOID_EXIT_2d));
         }
@@ -216,10 +341,7 @@ void mp_calculate_ramps(mpBlockRuntimeBuf_t* block, mpBuf_t* bf, const float ent
         // PERFECT_DECELERATION (1d) single tail segment (deltaV == delta_vmax)
         // Only possible if the entry has not changed since hinting.
         else if (bf->hint == PERFECT_DECELERATION) {
-            block->tail_length     = bf->length;
-            block->cruise_velocity = entry_velocity;
-            block->tail_time       = block->tail_length * 2 / (block->exit_velocity + block->cruise_velocity);
-            bf->block_time         = block->tail_time;
+            bf->block_time = _fit_tail(block, bf, entry_velocity);
             LOG_RETURN("1d");
             return (_zoid_exit(bf, ZOID_EXIT_1d));
         }
@@ -234,28 +356,17 @@ void mp_calculate_ramps(mpBlockRuntimeBuf_t* block, mpBuf_t* bf, const float ent
         // Note that the hints from back-planning are ignored in this section, since back-planing can only predict decel
         // and cruise.
 
-        float accel_velocity;
-        if (test_velocity_valid) {
-            accel_velocity      = test_velocity;
-            test_velocity_valid = false;
-        } else {
-            accel_velocity = mp_get_target_velocity(entry_velocity, bf->length, bf);
-        }
+        float accel_velocity = mp_get_target_velocity(entry_velocity, bf->length, bf);
 
         if (accel_velocity < block->exit_velocity) {  // still accelerating
 
             mp.entry_changed = true;  // we are changing the *next* block's entry velocity
 
-            block->exit_velocity   = accel_velocity;
-            block->cruise_velocity = accel_velocity;
-
+            block->exit_velocity = accel_velocity;
             bf->hint = PERFECT_ACCELERATION;
 
             // PERFECT_ACCELERATION (1a) single head segment (deltaV == delta_vmax)
-            block->head_length     = bf->length;
-            block->cruise_velocity = block->exit_velocity;
-            block->head_time       = (block->head_length * 2.0) / (entry_velocity + block->cruise_velocity);
-            bf->block_time         = block->head_time;
+            bf->block_time = _fit_head(block, bf, entry_velocity);
             LOG_RETURN("1a");
             return (_zoid_exit(bf, ZOID_EXIT_1a));
         } else {  // it's hit the cusp
@@ -275,18 +386,22 @@ void mp_calculate_ramps(mpBlockRuntimeBuf_t* block, mpBuf_t* bf, const float ent
                 bf->hint = MIXED_ACCELERATION;
 
                 // MIXED_ACCELERATION (2a) 2 segment HB acceleration move
-                block->head_length = mp_get_target_length(entry_velocity, block->cruise_velocity, bf);
-                block->body_length = bf->length - block->head_length;
-                block->tail_length = 0;  // we just set it, now we unset it
-                block->head_time   = (block->head_length * 2.0) / (entry_velocity + block->cruise_velocity);
-                block->body_time   = block->body_length / block->cruise_velocity;
-                bf->block_time     = block->head_time + block->body_time;
+                bf->block_time = _fit_head_body(block, bf, entry_velocity);
                 LOG_RETURN("2a");
                 return (_zoid_exit(bf, ZOID_EXIT_2a));
             }
         }
     }
 
+    // initialize the sections for the general cases, which set only some of them
+    block->head_time = 0;
+    block->body_time = 0;
+    block->tail_time = 0;
+
+    block->head_length = 0;
+    block->body_length = 0;
+    block->tail_length = 0;
+
     // We've eliminated the following at this point:
 
     // PERFECT_ACCELERATION
@@ -324,7 +439,15 @@ void mp_calculate_ramps(mpBlockRuntimeBuf_t* block, mpBuf_t* bf, const float ent
 
     // Rate-limited asymmetric cases (3)
     // compute meet velocity to see if the cruise velocity rises above the entry and/or exit velocities
+#if MEET_MEMO_SIZE > 0
+    if (!_meet_memo_find(entry_velocity, bf, block)) {
+        const float cruise_vmax = block->cruise_velocity;
+        block->cruise_velocity = _get_meet_velocity(entry_velocity, block->exit_velocity, bf->length, bf, block);
+        _meet_memo_store(entry_velocity, block->exit_velocity, cruise_vmax, bf, block);
+    }
+#else
     block->cruise_velocity = _get_meet_velocity(entry_velocity, block->exit_velocity, bf->length, bf, block);
+#endif
     TRAP_ZERO(block->cruise_velocity, "zoid() Vc=0 asymmetric HT case");
 
     // We now store the head/tail lengths we computed in _get_meet_velocity.
@@ -350,6 +473,58 @@ void mp_calculate_ramps(mpBlockRuntimeBuf_t* block, mpBuf_t* bf, const float ent
 }
 
 
+/*
+ * mp_estimate_block_time() - estimate the run time of a back-planned block, in minutes
+ *
+ *  Takes the block from entry_velocity up to its cruise velocity and down to its exit
+ *  velocity the way mp_calculate_ramps() would, using the same ramp lengths. If the head
+ *  and tail don't fit, the peak velocity is found by a short bisection rather than the
+ *  meet velocity search, stopping on the slow side so the estimate is a little long.
+ *
+ *  Back-planning leaves velocities the block can always achieve and forward planning only
+ *  makes blocks faster, so the estimate errs long. A block that isn't back-planned
+ *  yet gets its feed time (bf->block_time from aline()).
+ */
+
+#define ESTIMATE_ITERATIONS 6           // bisection steps for the peak of a block with no body
+
+static float _get_ramp_time(const float v_0, const float v_1, const float length)
+{
+    return (fp_NOT_ZERO(length) ? ((length * 2) / (v_0 + v_1)) : 0);
+}
+
+float mp_estimate_block_time(const mpBuf_t *bf, const float entry_velocity)
+{
+    float cruise_velocity = max3(bf->cruise_velocity, entry_velocity, bf->exit_velocity);
+    if (fp_ZERO(cruise_velocity)) {
+        return (bf->block_time);
+    }
+    float head_length = mp_get_target_length(entry_velocity, cruise_velocity, bf);
+    float tail_length = mp_get_target_length(bf->exit_velocity, cruise_velocity, bf);
+
+    if ((head_length + tail_length) > bf->length) {
+        float v_lo = max(entry_velocity, bf->exit_velocity);
+        float v_hi = cruise_velocity;
+        for (uint8_t i = 0; i < ESTIMATE_ITERATIONS; i++) {
+            float v = (v_lo + v_hi) / 2;
+            if ((mp_get_target_length(entry_velocity, v, bf) + mp_get_target_length(bf->exit_velocity, v, bf)) > bf->length) {
+                v_hi = v;
+            } else {
+                v_lo = v;
+            }
+        }
+        if (fp_ZERO(v_lo)) {            // starts and ends at rest and the bisection didn't leave zero
+            v_lo = v_hi;
+        }
+        cruise_velocity = v_lo;
+        head_length = mp_get_target_length(entry_velocity, cruise_velocity, bf);
+        tail_length = mp_get_target_length(bf->exit_velocity, cruise_velocity, bf);
+    }
+    float body_length = max((float)0, bf->length - head_length - tail_length);
+    return (_get_ramp_time(entry_velocity, cruise_velocity, head_length) + (body_length / cruise_velocity) +
+            _get_ramp_time(bf->exit_velocity, cruise_velocity, tail_length));
+}
+
 /**** Planner helpers ****
  *
  * mp_get_target_length()   - find accel/decel length from delta V and jerk
@@ -362,6 +537,12 @@ void mp_calculate_ramps(mpBlockRuntimeBuf_t* block, mpBuf_t* bf, const float ent
  *    T  = time of the entire move
  *    Vi = initial velocity
  *    Vf = final velocity
+ *
+ *  Both head and tail profiles (MOTION_PROFILE_ORDER in planner.h) have ramps of length
+ *  L = q/(2 sqrt(Jm)) sqrt(|Vf-Vi|) (Vf+Vi), with q in bf->q_recip_2_sqrt_j: the quintic has
+ *  q = sqrt(10)/3^(1/4), the S-curve, with its jerk at +Jm then -Jm, q = 2. Only the closed
+ *  form in mp_get_target_velocity() uses Jm itself, so the S-curve hands it the quintic jerk
+ *  that gives the same lengths.
  */
 
 /*
@@ -374,7 +555,7 @@ void mp_calculate_ramps(mpBlockRuntimeBuf_t* block, mpBuf_t* bf, const float ent
 float mp_get_target_length(const float v_0, const float v_1, const mpBuf_t* bf) 
 {
     const float q_recip_2_sqrt_j = bf->q_recip_2_sqrt_j;
-    return q_recip_2_sqrt_j * sqrt(fabs(v_1 - v_0)) * (v_1 + v_0);
+    return q_recip_2_sqrt_j * fast_sqrt(fabs(v_1 - v_0)) * (v_1 + v_0);
 }
 
 /*
@@ -392,7 +573,11 @@ float mp_get_target_velocity(const float v_0, const float L, const mpBuf_t* bf)
         return (0);
     }
 
+#if (MOTION_PROFILE_ORDER == 3)
+    const float j = bf->jerk * 1.443375672974;  // the quintic jerk with the same ramp lengths: (q_5 / q_3)^2
+#else
     const float j = bf->jerk;
+#endif
 
     const float a80 = 7.698003589195;    // 80 * a
     const float a_2 = 0.00925925925926;  // a^2
@@ -406,7 +591,7 @@ float mp_get_target_velocity(const float v_0, const float L, const mpBuf_t* bf)
     const float b_part2 = a80 * v_0_3;  // 80 a v_0^3
 
     //              b^3 = a^2 (3 L sqrt(j (2 b_part2  +  b_part1))  +  b_part2  +  b_part1)
-    const float b_cubed = a_2 * (3 * L * sqrt(j * (2 * b_part2 + b_part1)) + b_part2 + b_part1);
+    const float b_cubed = a_2 * (3 * L * fast_sqrt(j * (2 * b_part2 + b_part1)) + b_part2 + b_part1);
     const float b       = cbrtf(b_cubed);
 
     const float const1a = 0.8292422988276;    // 4 * 10^(1/3) * a
@@ -443,7 +628,7 @@ float mp_get_decel_velocity(const float v_0, const float L, const mpBuf_t* bf)
 
     int i = 0;          // limit the iterations
     while (i++ < 10) {  // If it fails after 10, something's wrong
-        const float sqrt_delta_v_0 = sqrt(v_0 - v_1);
+        const float sqrt_delta_v_0 = fast_sqrt(v_0 - v_1);
         const float l_t            = q_recip_2_sqrt_j * (sqrt_delta_v_0 * (v_1 + v_0)) - L;
 
         if (fabs(l_t) < 0.00001) {
@@ -474,6 +659,15 @@ float mp_get_decel_velocity(const float v_0, const float L, const mpBuf_t* bf)
  * and jerk (J), will locate the velocity v_1 that will allow acceleration from v_0
  * at jerk J to v_1 and then deceleration at jerk J to v_2, all over total length L.
  *
+ * The caller only gets here after finding that the head and tail at the block's cruise
+ * velocity overrun L, so block->cruise_velocity is an upper bound on v_1. The iteration
+ * is seeded with one Newton step down from that bound. The length curve is concave there,
+ * so the step lands at or just under the meet, usually inside the acceptance window on
+ * the first pass. This replaces the cube-root estimate from mp_get_target_velocity(),
+ * which cost as much as an iteration and typically needed another correction. The
+ * symmetric case is still solved exactly with mp_get_target_velocity().
+ *
+ * meet_iterations records the passes taken (-1 for the symmetric case).
  */
 
 static float _get_meet_velocity(const float          v_0,
@@ -487,11 +681,6 @@ static float _get_meet_velocity(const float          v_0,
     // v_1 can never be smaller than v_0 or v_2, so we keep track of this value
     const float min_v_1 = max(v_0, v_2);
 
-    // v_1 is our estimated return value.
-    // We estimate with the speed obtained by L/2 traveled from the highest speed of v_0 or v_2.
-    float v_1 = mp_get_target_velocity(min_v_1, L / 2.0, bf);
-    // var v_1 = min_v_1 + 100;
-
     if (fp_EQ(v_0, v_2)) {
         // Case (1)
         // We can catch a symmetric case early and return now
@@ -501,9 +690,27 @@ static float _get_meet_velocity(const float          v_0,
         block->body_length = 0;
         block->tail_length = L - block->head_length;
 
-        bf->meet_iterations = -1;
+        bf->cold->meet_iterations = -1;
+
+        // The speed obtained by L/2 traveled from v_0 is exact for the symmetric case
+        return (mp_get_target_velocity(min_v_1, L / 2.0, bf));
+    }
 
-        return v_1;
+    // v_1 is our estimated return value. Seed it with a Newton step down from the cruise velocity.
+    float v_1 = block->cruise_velocity;
+    {
+        const float sqrt_delta_v_0 = fast_sqrt(fabs(v_1 - v_0));
+        const float sqrt_delta_v_2 = fast_sqrt(fabs(v_1 - v_2));
+        const float v_1x3          = 3 * v_1;
+        const float l_d            = (sqrt_delta_v_0 * (v_1x3 - v_2) - (v_0 - v_1x3) * sqrt_delta_v_2) * q_recip_2_sqrt_j;
+
+        if (fp_ZERO(sqrt_delta_v_0) || fp_ZERO(sqrt_delta_v_2) || fp_ZERO(l_d)) {
+            // cruise is one of the end velocities - the step is undefined, so use the L/2 estimate
+            v_1 = mp_get_target_velocity(min_v_1, L / 2.0, bf);
+        } else {
+            const float l_c = (block->head_length + block->tail_length) - L;    // lengths at cruise, from the caller
+            v_1 = v_1 - (l_c * (2 * sqrt_delta_v_0 * sqrt_delta_v_2) / l_d);
+        }
     }
 
     // Per iteration: 2 sqrt, 2 abs, 6 -, 4 +, 12 *, 3 /
@@ -547,8 +754,8 @@ static float _get_meet_velocity(const float          v_0,
         }
 
         // Precompute some common chunks -- note that some attempts may have v_1 < v_0 or v_1 < v_2
-        const float sqrt_delta_v_0 = sqrt(fabs(v_1 - v_0));
-        const float sqrt_delta_v_2 = sqrt(fabs(v_1 - v_2));  // 849us
+        const float sqrt_delta_v_0 = fast_sqrt(fabs(v_1 - v_0));
+        const float sqrt_delta_v_2 = fast_sqrt(fabs(v_1 - v_2));  // 849us
 
         // l_c is our total-length calculation with the current v_1 estimate, minus the expected length.
         // This makes l_c == 0 when v_1 is the correct value.
@@ -587,7 +794,7 @@ static float _get_meet_velocity(const float          v_0,
         v_1 = v_1 - (l_c * recip_l_d);
     }
 
-    bf->meet_iterations = i;
+    bf->cold->meet_iterations = i;
 
     return v_1;
 }
@@ -55,82 +55,89 @@
 #include "config.h"
 #include "canonical_machine.h"
 #include "plan_arc.h"
+#include "plan_spline.h"
 #include "planner.h"
+#include "plan_coalesce.h"
+#include "plan_lookahead.h"
+#include "plan_shaper.h"
+#include "plan_track.h"
+#include "plan_aux.h"
+#include "plan_sync.h"
 #include "kinematics.h"
 #include "stepper.h"
 #include "encoder.h"
+#include "temperature.h"
 #include "report.h"
 #include "util.h"
 #include "json_parser.h"
 #include "xio.h"    //+++++ DIAGNOSTIC - only needed if xio_writeline() direct prints are used
 
+#include <atomic>           // atomic_signal_fence() orders the JSON command ring between main loop and exec
+
 // Allocate planner structures
-mpBufferPool_t mb;                  // buffer pool management
+HOT_DATA mpBufferPool_t mb;         // buffer pool management
+mpBufferColdPool_t mbc;             // buffer cold sides and shared Gcode state
 mpMotionPlannerSingleton_t mp;      // context for block planning
-mpMotionRuntimeSingleton_t mr;      // context for block runtime
+HOT_DATA mpMotionRuntimeSingleton_t mr; // context for block runtime
 
-#define JSON_COMMAND_BUFFER_SIZE 3
+#define TEMPERATURE_WAIT_POLL (float)10000.0    // uSec between at-temperature checks
 
-struct json_command_buffer_t {
-    char buf[RX_BUFFER_SIZE];
-    json_command_buffer_t *pv;
-    json_command_buffer_t *nx;
+/* Queued JSON commands (M100 and M101)
+ *
+ *  The commands are parsed when they are queued and kept in a byte ring as packed nv
+ *  pairs, so the runtime only rebuilds the nv list and executes it. Each entry takes
+ *  as many bytes as its pairs need rather than a whole RX_BUFFER_SIZE slot, so a run
+ *  of short commands (the usual {out4:1}) no longer fills the planner after 3 of them.
+ *
+ *  The main loop writes at head and the exec interrupt frees from tail. An entry is
+ *  never split across the end of the ring - a zero length (or too few bytes left for
+ *  a header) sends the reader back to the start. One byte always stays unused so that
+ *  head == tail only ever means empty.
+ */
+#ifndef JSON_COMMAND_ARENA_SIZE
+#define JSON_COMMAND_ARENA_SIZE 1536    // same RAM as the 3 RX_BUFFER_SIZE slots it replaced
+#endif
+
+struct jcEntry_t {                      // entry header
+    uint16_t length;                    // bytes in the entry, header included. 0 marks a wrap
+    uint8_t pairs;                      // nv pairs that follow
 };
 
-struct _json_commands_t {
-    json_command_buffer_t _json_bf[JSON_COMMAND_BUFFER_SIZE]; // storage of all buffers
-    json_command_buffer_t *_json_r;   // pointer to the next "run" buffer
-    json_command_buffer_t *_json_w;   // pointer tot he next "write" buffer
-
-    int8_t available;
-
-    // Constructor (initializer)
-    // Note, reset routines handle zeroing out all of the above
-    _json_commands_t() {
-        json_command_buffer_t *js_pv = &_json_bf[JSON_COMMAND_BUFFER_SIZE - 1];
-        for (uint8_t i=0; i < JSON_COMMAND_BUFFER_SIZE; i++) {
-            _json_bf[i].nx = &_json_bf[((i+1 == JSON_COMMAND_BUFFER_SIZE) ? 0 : i+1)];
-            _json_bf[i].pv = js_pv;
-            js_pv = &_json_bf[i];
-        }
-        _json_r = &_json_bf[0];
-        _json_w = _json_r;
-        available = JSON_COMMAND_BUFFER_SIZE;
-    };
-
-    // Write a json command to the buffer, using up one slot
-    void write_buffer(char * new_json) {
-        strcpy(_json_w->buf, new_json);
-        available--;
-        _json_w = _json_w->nx;
-    };
-
-    // Read a buffer out, but do NOT free it (so it can be used directly)
-    char *read_buffer() {
-        return _json_r->buf;
-    };
-
-    // Free the last read buffer.
-    void free_buffer() {
-        _json_r = _json_r->nx;
-        available++;
-    }
+struct jcPair_t {                       // followed by NUL terminated group, token and string
+    float value;
+    index_t index;
+    int8_t depth;
+    int8_t valuetype;
+    int8_t precision;
 };
 
-_json_commands_t jc;
+// worst case entry: a full exec list and a full input line of strings
+#define JSON_COMMAND_MAX_LEN (sizeof(jcEntry_t) + \
+                              NV_EXEC_LEN * (sizeof(jcPair_t) + GROUP_LEN+1 + TOKEN_LEN+1) + RX_BUFFER_SIZE)
+
+static struct {
+    uint8_t buf[JSON_COMMAND_ARENA_SIZE];
+    volatile uint16_t head;             // next write offset (main loop)
+    volatile uint16_t tail;             // oldest queued entry (exec)
+} jc;
+
+static nvObj_t _jc_nv[NV_EXEC_LEN];     // queue-time parse list (nv_exec belongs to the runtime)
 
 // Local Scope Data and Functions
-#define spindle_speed block_time    // local alias for spindle_speed to the time variable
-#define value_vector gm.target      // alias for vector of values
+#define value_vector cold->target         // alias for vector of values
 
 //static void _planner_time_accounting();
+static void _estimate_queue_time(void);
 static void _audit_buffers();
+static void _flush_buffers(void);
+static mpBuf_t *_get_uncommitted_buffer(void);
 
 // Execution routines (NB: These are called from the LO interrupt)
 static void _exec_json_command(float *value, bool *flag);
 static stat_t _exec_dwell(mpBuf_t *bf);
 static stat_t _exec_command(mpBuf_t *bf);
 static stat_t _exec_json_wait(mpBuf_t *bf);
+static stat_t _exec_temperature_wait(mpBuf_t *bf);
 
 /*
  * planner_init()
@@ -143,7 +150,16 @@ void planner_init()
     memset(&mr, 0, sizeof(mr));     // clear all values, pointers and status
     planner_init_assertions();
     mp_init_buffers();
+    mp_coalesce_init();
+    mp_lookahead_init();
+    mp_shaper_init();
+    mp_track_init();
+    mp_aux_init();
+    mp_sync_init();
     mp.mfo_factor = 1.00;
+    mr.segment_stretch = 1.0;
+    mr.knob_factor = 1.0;
+    mr.knob_target = 1.0;
 }
 
 void planner_reset()
@@ -169,7 +185,12 @@ stat_t planner_test_assertions()
 {
     if ((BAD_MAGIC(mb.magic_start)) || (BAD_MAGIC(mb.magic_end)) ||
         (BAD_MAGIC(mp.magic_start)) || (BAD_MAGIC(mp.magic_end)) ||
-        (BAD_MAGIC(mr.magic_start)) || (BAD_MAGIC(mr.magic_end))) {
+        (BAD_MAGIC(mr.magic_start)) || (BAD_MAGIC(mr.magic_end)) ||
+        (BAD_MAGIC(coal.magic_start)) || (BAD_MAGIC(coal.magic_end)) ||
+        (BAD_MAGIC(look.magic_start)) || (BAD_MAGIC(look.magic_end)) ||
+        (BAD_MAGIC(shp.magic_start)) || (BAD_MAGIC(shp.magic_end)) ||
+        (BAD_MAGIC(trk.magic_start)) || (BAD_MAGIC(trk.magic_end)) ||
+        (BAD_MAGIC(syn.magic_start)) || (BAD_MAGIC(syn.magic_end))) {
         return(cm_panic(STAT_PLANNER_ASSERTION_FAILURE, "planner_test_assertions()"));
     }
 //    for (uint8_t i=0; i < PLANNER_BUFFER_POOL_SIZE; i++) {
@@ -203,7 +224,16 @@ void mp_halt_runtime()
 void mp_flush_planner()
 {
     cm_abort_arc();
-    mp_init_buffers();
+    cm_abort_spline();
+    cm_abort_drilling();
+    mp_lookahead_abort();
+    mp_coalesce_abort();
+    _flush_buffers();
+    mp.override_bf = nullptr;          // an override in progress goes with the blocks
+    mp.constraints_bf = nullptr;       // as does a change of limits
+    jc.tail = jc.head;                 // and so do their queued JSON commands
+    mp_aux_flush();                    // and auxiliary moves that haven't started
+    mp.ramp_active = false;
     mr.block_state = BLOCK_INACTIVE;   // invalidate mr buffer to prevent subsequent motion
 }
 
@@ -232,24 +262,44 @@ void mp_flush_planner()
  *  still close to the starting point.
  */
 
-void mp_set_planner_position(uint8_t axis, const float position) { mp.position[axis] = position; }
+void mp_set_planner_position(uint8_t axis, const float position)
+{
+    stat_t status = mp_coalesce_flush();   // a pending move ends at the old position
+    if (status != STAT_OK) {
+        rpt_exception(status, "mp_set_planner_position() flush");
+    }
+    mp.position[axis] = position;
+}
 void mp_set_runtime_position(uint8_t axis, const float position) { mr.position[axis] = position; }
 
 void mp_set_steps_to_runtime_position()
 {
+    float position[AXES];
     float step_position[MOTORS];
-    kn_inverse_kinematics(mr.position, step_position);      // convert lengths to steps in floating point
+    copy_vector(position, mr.position);
+    mp_track_add_offset(position);                          // the tracked axis is off by the belt
+    mp_aux_add_offset(position);                            // and auxiliary axes by their moves
+    kn_inverse_kinematics(position, step_position);         // convert lengths to steps in floating point
     for (uint8_t motor = MOTOR_1; motor < MOTORS; motor++) {
         mr.target_steps[motor] = step_position[motor];
         mr.position_steps[motor] = step_position[motor];
+#if (KINEMATICS_MIDPOINT == 1)
+        mr.midpoint_steps[motor] = step_position[motor];
+#endif
         mr.commanded_steps[motor] = step_position[motor];
+        for (uint8_t i=0; i<PREP_BUFFERS; i++) {
+            mr.delayed_steps[i][motor] = step_position[motor];
+        }
         en_set_encoder_steps(motor, step_position[motor]);  // write steps to encoder register
         mr.encoder_steps[motor] = en_read_encoder(motor);
 
         // These must be zero:
         mr.following_error[motor] = 0;
         st_pre.mot[motor].corrected_steps = 0;
+        st_pre.mot[motor].backlash_counted = 0;
     }
+    mp_reset_extruder_advance();                            // the steps hold no pressure advance now
+    mp_shaper_reset(mr.position);                           // ...and no shaped path behind them
 }
 
 /************************************************************************************
@@ -271,12 +321,26 @@ void mp_set_steps_to_runtime_position()
  *  Doing it this way instead of synchronizing on an empty queue simplifies the
  *  handling of feedholds, feed overrides, buffer flushes, and thread blocking,
  *  and makes keeping the queue full much easier - therefore avoiding Q starvation
+ *
+ *  A command normally stops motion: the move before it is planned to end at zero.
+ *  A 'nonstop' command (coolant, M100 JSON) is instead planned through at the velocity
+ *  of the junction between the moves on either side of it - see _plan_block() - and
+ *  fires as its slot reaches the loader, at the block boundary. Only use it for
+ *  commands that don't need the machine to be stopped.
+ *
+ *  If a move held by the coalescer can't be queued ahead of the command, the error is
+ *  reported and the command is not queued. It would otherwise run with the move missing.
  */
 
-void mp_queue_command(void(*cm_exec)(float[], bool[]), float *value, bool *flag)
+void mp_queue_command(void(*cm_exec)(float[], bool[]), float *value, bool *flag, const bool nonstop)
 {
     mpBuf_t *bf;
 
+    stat_t status = mp_coalesce_flush();            // a pending move must precede the command
+    if (status != STAT_OK) {
+        rpt_exception(status, "mp_queue_command() flush");
+        return;
+    }
     // Never supposed to fail as buffer availability was checked upstream in the controller
     if ((bf = mp_get_write_buffer()) == NULL) {
         cm_panic(STAT_FAILED_GET_PLANNER_BUFFER, "mp_queue_command()");
@@ -285,6 +349,7 @@ void mp_queue_command(void(*cm_exec)(float[], bool[]), float *value, bool *flag)
     bf->block_type = BLOCK_TYPE_COMMAND;
     bf->bf_func = _exec_command;      // callback to planner queue exec function
     bf->cm_func = cm_exec;            // callback to canonical machine exec function
+    bf->nonstop = nonstop;
 
     for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
         bf->value_vector[axis] = value[axis];
@@ -295,6 +360,10 @@ void mp_queue_command(void(*cm_exec)(float[], bool[]), float *value, bool *flag)
 
 static stat_t _exec_command(mpBuf_t *bf)
 {
+    if (bf->buffer_state == MP_BUFFER_RUNNING) {    // already in the prep ring - exec ran ahead to it again
+        return (STAT_NOOP);
+    }
+    mp_set_buffer_state(bf, MP_BUFFER_RUNNING);     // the loader frees it in mp_runtime_command()
     st_prep_command(bf);
     return (STAT_OK);
 }
@@ -309,29 +378,142 @@ stat_t mp_runtime_command(mpBuf_t *bf)
 }
 
 
+/*************************************************************************
+ * _jc_fit()     - find contiguous room for an entry of 'need' bytes. False if there is none
+ * _jc_queue()   - parse a JSON string and write it to the ring (main loop)
+ * _jc_rebuild() - rebuild nv_exec from the oldest entry (exec)
+ * _jc_free()    - free the oldest entry (exec)
+ */
+
+static bool _jc_fit(const uint16_t need, uint16_t *at)
+{
+    uint16_t head = jc.head;
+    uint16_t tail = jc.tail;
+
+    *at = head;
+    if (head < tail) {                              // the free space runs from head up to tail
+        return (tail - head > need);
+    }
+    if ((JSON_COMMAND_ARENA_SIZE - head > need) ||  // fits before the end of the ring
+        ((JSON_COMMAND_ARENA_SIZE - head == need) && (tail != 0))) {
+        return (true);
+    }
+    *at = 0;                                        // wrap to the start
+    return (tail > need);
+}
+
+static uint8_t *_jc_put_string(uint8_t *wp, const char *str)
+{
+    uint16_t len = strlen(str) + 1;
+    memcpy(wp, str, len);
+    return (wp + len);
+}
+
+static stat_t _jc_queue(char *json_string)
+{
+    nvObj_t *nv = _jc_nv;
+    ritorno(json_parse_nv_list(nv, NV_EXEC_LEN, json_string));
+
+    jcEntry_t entry = { sizeof(jcEntry_t), 0 };
+    for (; (nv != NULL) && (nv->valuetype != TYPE_EMPTY); nv = nv->nx) {
+        entry.length += sizeof(jcPair_t) + strlen(nv->group) + strlen(nv->token) + 3;
+        if (nv->valuetype == TYPE_STRING) {
+            entry.length += strlen(*nv->stringp);
+        }
+        entry.pairs++;
+    }
+    uint16_t head = jc.head;
+    uint16_t at;
+    if (!_jc_fit(entry.length, &at)) {              // never supposed to fail - see mp_planner_is_full()
+        return (STAT_BUFFER_FULL);
+    }
+    uint8_t *wp = &jc.buf[at];
+    memcpy(wp, &entry, sizeof(entry));
+    wp += sizeof(entry);
+    for (nv = _jc_nv; entry.pairs > 0; entry.pairs--, nv = nv->nx) {
+        jcPair_t pair = { nv->value, nv->index, nv->depth, (int8_t)nv->valuetype, nv->precision };
+        memcpy(wp, &pair, sizeof(pair));
+        wp = _jc_put_string(wp + sizeof(pair), nv->group);
+        wp = _jc_put_string(wp, nv->token);
+        wp = _jc_put_string(wp, (nv->valuetype == TYPE_STRING) ? *nv->stringp : "");
+    }
+    if ((at != head) && (JSON_COMMAND_ARENA_SIZE - head >= (int)sizeof(jcEntry_t))) {
+        jcEntry_t wrap = { 0, 0 };                  // send the reader back to the start
+        memcpy(&jc.buf[head], &wrap, sizeof(wrap));
+    }
+    std::atomic_signal_fence(std::memory_order_release);   // entry contents before the index
+    head = at + entry.length;
+    jc.head = (head == JSON_COMMAND_ARENA_SIZE) ? 0 : head;
+    return (STAT_OK);
+}
+
+static nvObj_t *_jc_rebuild()
+{
+    jcEntry_t entry = { 0, 0 };
+    uint16_t tail = jc.tail;
+
+    std::atomic_signal_fence(std::memory_order_acquire);   // index before the entry contents
+    if (JSON_COMMAND_ARENA_SIZE - tail >= (int)sizeof(jcEntry_t)) {
+        memcpy(&entry, &jc.buf[tail], sizeof(entry));
+    }
+    if (entry.length == 0) {                        // wrapped - the entry is at the start
+        jc.tail = tail = 0;
+        memcpy(&entry, &jc.buf[0], sizeof(entry));
+    }
+    nvObj_t *nv = nv_reset_exec_nv_list();
+    uint8_t *rp = &jc.buf[tail + sizeof(jcEntry_t)];
+    for (; entry.pairs > 0; entry.pairs--, nv = nv->nx) {
+        jcPair_t pair;
+        memcpy(&pair, rp, sizeof(pair));
+        rp += sizeof(pair);
+        nv->value = pair.value;
+        nv->index = pair.index;
+        nv->depth = pair.depth;
+        nv->valuetype = (valueType)pair.valuetype;
+        nv->precision = pair.precision;
+        strcpy(nv->group, (char *)rp);
+        rp += strlen(nv->group) + 1;
+        strcpy(nv->token, (char *)rp);
+        rp += strlen(nv->token) + 1;
+        nv->stringp = (char (*)[])rp;               // strings are used where they lie in the ring
+        rp += strlen((char *)rp) + 1;
+    }
+    return (nv_exec);
+}
+
+static void _jc_free()                              // only after _jc_rebuild() has found the entry
+{
+    jcEntry_t entry;
+    memcpy(&entry, &jc.buf[jc.tail], sizeof(entry));
+    std::atomic_signal_fence(std::memory_order_release);   // done with the entry before freeing it
+    uint16_t tail = jc.tail + entry.length;
+    jc.tail = (tail == JSON_COMMAND_ARENA_SIZE) ? 0 : tail;
+}
+
 /*************************************************************************
  * mp_json_command()    - queue a json command
- * _exec_json_command() - execute json string (from exec system)
+ * _exec_json_command() - execute the pre-parsed command (from exec system)
+ *
+ *  The command is parsed here, so a bad one is reported against its Gcode line
+ *  instead of being dropped silently when it comes up in the queue.
  */
 
 stat_t mp_json_command(char *json_string)
 {
-    // Never supposed to fail, since we stopped parsing when we were full
-    jc.write_buffer(json_string);
+    ritorno(_jc_queue(json_string));
 
     // We don't actually use these...
     float value[] = { 0,0,0,0,0,0 };
     bool flags[]  = { 0,0,0,0,0,0 };
 
-    mp_queue_command(_exec_json_command, value, flags);
+    mp_queue_command(_exec_json_command, value, flags, true);
     return (STAT_OK);
 }
 
 static void _exec_json_command(float *value, bool *flag)
 {
-    char *json_string = jc.read_buffer();
-    json_parse_for_exec(json_string, true); // process it
-    jc.free_buffer();
+    json_execute_nv_list(_jc_rebuild());
+    _jc_free();
 }
 
 /*************************************************************************
@@ -350,11 +532,10 @@ stat_t mp_json_command_immediate(char *json_string)
 
 stat_t mp_json_wait(char *json_string)
 {
-    // Never supposed to fail, since we stopped parsing when we were full
-    jc.write_buffer(json_string);
-
     mpBuf_t *bf;
 
+    ritorno(mp_coalesce_flush());                   // a pending move must precede the wait
+    ritorno(_jc_queue(json_string));
     // Never supposed to fail as buffer availability was checked upstream in the controller
     if ((bf = mp_get_write_buffer()) == NULL) {
         cm_panic(STAT_FAILED_GET_PLANNER_BUFFER, "mp_json_wait()");
@@ -368,12 +549,7 @@ stat_t mp_json_wait(char *json_string)
 
 static stat_t _exec_json_wait(mpBuf_t *bf)
 {
-    char *json_string = jc.read_buffer();
-
-    // process it
-    json_parse_for_exec(json_string, false); // do NOT execute
-
-    nvObj_t *nv = nv_exec;
+    nvObj_t *nv = _jc_rebuild();        // values are the ones waited for
     while ((nv != NULL) && (nv->valuetype != TYPE_EMPTY)) {
         // For now we ignore non-BOOL
         if (nv->valuetype == TYPE_BOOL) {
@@ -388,7 +564,7 @@ static stat_t _exec_json_wait(mpBuf_t *bf)
         }
         nv = nv->nx;
     }
-    jc.free_buffer();
+    _jc_free();
 
     if (mp_free_run_buffer()) {
         cm_cycle_end();                                    // free buffer & perform cycle_end if planner is empty
@@ -397,6 +573,44 @@ static stat_t _exec_json_wait(mpBuf_t *bf)
 }
 
 
+/*************************************************************************
+ * mp_temperature_wait()    - queue a wait for a heater to reach its set temperature
+ * _exec_temperature_wait() - hold the runtime at the wait until the heater is there
+ *
+ *  Unlike mp_json_wait() this takes no JSON command buffer and parses nothing at run
+ *  time, so waits don't fill the planner early. Parsing and planning of the moves
+ *  behind the wait carry on while the heater comes up, and the queue is full when
+ *  the runtime is released.
+ */
+
+stat_t mp_temperature_wait(const uint8_t heater)
+{
+    mpBuf_t *bf;
+
+    ritorno(mp_coalesce_flush());                   // a pending move must precede the wait
+    if ((bf = mp_get_write_buffer()) == NULL) {     // get write buffer or fail
+        return(cm_panic(STAT_FAILED_GET_PLANNER_BUFFER, "mp_temperature_wait()")); // not ever supposed to fail
+    }
+    bf->block_type = BLOCK_TYPE_COMMAND;
+    bf->bf_func = _exec_temperature_wait;           // callback to planner queue exec function
+    bf->value_vector[0] = heater;
+    mp_commit_write_buffer(BLOCK_TYPE_COMMAND);     // must be final operation before exit
+    return (STAT_OK);
+}
+
+static stat_t _exec_temperature_wait(mpBuf_t *bf)
+{
+    if (!cm_get_at_temperature((uint8_t)bf->value_vector[0])) {
+        st_prep_dwell(TEMPERATURE_WAIT_POLL);       // look again after a short dwell
+        return (STAT_OK);
+    }
+    if (mp_free_run_buffer()) {
+        cm_cycle_end();                             // free buffer & perform cycle_end if planner is empty
+    }
+    return (STAT_OK);
+}
+
+
 /*************************************************************************
  * mp_dwell()    - queue a dwell
  * _exec_dwell() - dwell execution
@@ -409,6 +623,7 @@ stat_t mp_dwell(float seconds)
 {
     mpBuf_t *bf;
 
+    ritorno(mp_coalesce_flush());                   // a pending move must precede the dwell
     if ((bf = mp_get_write_buffer()) == NULL) {     // get write buffer or fail
         return(cm_panic(STAT_FAILED_GET_PLANNER_BUFFER, "mp_dwell()")); // not ever supposed to fail
     }
@@ -456,12 +671,14 @@ uint8_t mp_get_planner_buffers()
 bool mp_planner_is_full()
 {
     // We also need to ensure we have room for another JSON command
-    return ((mb.buffers_available < PLANNER_BUFFER_HEADROOM) || (jc.available == 0));
+    uint16_t at;
+    return ((mb.buffers_available < PLANNER_BUFFER_HEADROOM) || !_jc_fit(JSON_COMMAND_MAX_LEN, &at) ||
+            (mp_get_gm_available() < PLANNER_BUFFER_HEADROOM));
 }
 
 bool mp_has_runnable_buffer()
 {
-    return (mb.r->buffer_state);    // anything other than MP_BUFFER_EMPTY returns true
+    return (mp_get_buffer_state(mb.r));    // anything other than MP_BUFFER_EMPTY returns true
 }
 
 bool mp_is_phat_city_time()
@@ -513,12 +730,20 @@ stat_t mp_planner_callback()
         (cm.motion_state == MOTION_STOP) &&
         (cm.hold_state == FEEDHOLD_OFF)) {
         mp.planner_state = PLANNER_IDLE;
+        mp.queue_time = 0;
         return (STAT_OK);
     }
 
     bool _timed_out = mp.block_timeout.isPast();
     if (_timed_out) {
         mp.block_timeout.clear();                   // timer is set on commit_write_buffer()
+        if (cm.motion_state == MOTION_RUN) {
+            mp.starve_suspect = true;               // moving, and the next block is late
+        }
+    }
+
+    if ((mp.preplan_count > 0) && mp_preplan_is_starving()) {
+        mp_end_preplanned();                        // the host fell behind - plan what it sent here
     }
 
     if (!mp.request_planning && !_timed_out) {      // Exit if no request or timeout
@@ -536,21 +761,40 @@ stat_t mp_planner_callback()
         }
         mp.planner_state = PLANNER_PRIMING;
     }
+    if (mp.p->buffer_state == MP_BUFFER_EMPTY) {    // nothing new to plan - finish an override or estimate
+        if (mp.override_bf != nullptr) {
+            mp.override_bf = mp_plan_override(mp.override_bf, FEED_OVERRIDE_SLICE_BLOCKS);
+            mp.request_estimate = true;
+        } else if (mp.constraints_bf != nullptr) {
+            mp.constraints_bf = mp_plan_constraints(mp.constraints_bf, CONSTRAINT_SLICE_BLOCKS);
+            mp.request_estimate = true;
+        } else if (mp.request_estimate) {
+            _estimate_queue_time();
+        }
+        return (STAT_OK);
+    }
     mp_plan_block_list();
+    mp.request_estimate = true;                     // velocities changed - estimate when there is time
     return (STAT_OK);
 }
 
 /*
- *  mp_replan_queue() - reset the blocks in the planner queue and request a planner run
- *
- *  We don't actually need to invalidate back-planning. Only forward planning.
+ *  mp_replan_queue() - revert forward planning from bf on and request a planner run
  *
+ *  Used by feedhold once the runtime has stopped. Only the forward plan depends on the
+ *  entry velocity, and at most the run buffer and the one after it are forward planned,
+ *  so that is all this touches. Back-planning is left alone: the exit velocities it set
+ *  are limits coming from the blocks ahead, which a hold doesn't change, and forward
+ *  planning only writes hints and block times (see mp_calculate_ramps()). The blocks
+ *  stay converged, so a back-planning pass for new blocks still stops where it did
+ *  before the hold instead of walking the queue. The exec forward plans the rest of the
+ *  run buffer from zero while the hold settles, so a resume starts without planning.
  */
 void mp_replan_queue(mpBuf_t *bf)
 {
     do {
         if (bf->buffer_state >= MP_BUFFER_PLANNED) {
-            bf->buffer_state = MP_BUFFER_PREPPED;            // revert from PLANNED state
+            mp_set_buffer_state(bf, MP_BUFFER_PREPPED);      // revert from PLANNED state
         } else {        // If it's not "planned" then it's either PREPPED or earlier.
             break;      // We don't need to adjust it.
         }
@@ -571,33 +815,43 @@ void mp_replan_queue(mpBuf_t *bf)
  *      The ramp will attempt to meet the time specified but it will not be exact.
  */
 /*  Function:
- *  The override takes effect as close to real-time as possible. Practically, this means about 20 or
- *  so behind the current running move. How it works:
+ *  The override takes effect as close to real-time as possible. How it works:
  *
  *    - If the planner is idle just apply the override factor and be done with it. That's easy.
- *    - Otherwise look for the "break point" at 20 ms
+ *    - Otherwise the ramp starts at the first block exec hasn't committed to (planned or
+ *      running), from that block's current factor. Each block's cruise_vmax is rescaled from
+ *      its stored pre-override cruise_vset (see mp_plan_override()).
+ *    - The first FEED_OVERRIDE_NOW_BLOCKS blocks are changed and back-planned right away so
+ *      the operator sees the change at once. The rest of the queue is changed a slice at a
+ *      time when the planner is idle, so a deep queue doesn't stall the main loop.
+ *    - A new request restarts the ramp from wherever the old one got to.
  */
 
 void mp_start_feed_override(const float ramp_time, const float override_factor)
 {
     cm.mfo_state = MFO_REQUESTED;
+    mp.mfo_factor = override_factor;
+    mp.ramp_active = false;
 
     if (mp.planner_state == PLANNER_IDLE) {
-        mp.mfo_factor = override_factor;             // that was easy
+        mp.override_bf = nullptr;                   // that was easy
+        return;
+    }
+
+    mpBuf_t *bf = _get_uncommitted_buffer();
+    if (bf == nullptr) {
+        mp.override_bf = nullptr;                   // nothing primed - new blocks get the new factor
         return;
     }
 
     // Assume that the min and max values for override_factor have been validated upstream
     // SUVAT: V = U+AT ==> A = (V-U)/T
+    mp.ramp_factor = fp_ZERO(bf->override_factor) ? FEED_OVERRIDE_FACTOR : bf->override_factor;
     mp.ramp_target = override_factor;
-    mp.ramp_dvdt = (override_factor - mp.c->override_factor) / ramp_time;
+    mp.ramp_dvdt = (override_factor - mp.ramp_factor) / ramp_time;
+    mp.ramp_active = fp_NOT_ZERO(mp.ramp_dvdt);     // do the ramp only if you actually have one to run
     mp.mfo_active = true;
-
-    if (fp_NOT_ZERO(mp.ramp_dvdt)) {    // do these things only if you actually have a ramp to run
-        mp.p = mp.c;                    // re-position the planner pointer
-        mp.ramp_active = true;
-        mp.request_planning = true;
-    }
+    mp.override_bf = mp_plan_override(bf, FEED_OVERRIDE_NOW_BLOCKS);
 }
 
 void mp_end_feed_override(const float ramp_time)
@@ -605,6 +859,42 @@ void mp_end_feed_override(const float ramp_time)
     mp_start_feed_override (FEED_OVERRIDE_RAMP_TIME, 1.00);
 }
 
+/*
+ *  mp_replan_constraints() - apply changed axis velocity, jerk or junction limits to the queue
+ *
+ *  Called after a velocity max, jerk max or junction integration time setting changes, so
+ *  moves already queued run to the new limits without a flush. It works like a feed override
+ *  with no ramp: the first CONSTRAINT_NOW_BLOCKS blocks exec hasn't committed to are changed
+ *  and back-planned at once, the rest a slice at a time when the planner is idle (see
+ *  mp_plan_constraints()). Blocks exec has committed to run out with the limits they have.
+ *  A new change starts over from the first uncommitted block.
+ */
+
+void mp_replan_constraints()
+{
+    if (mp.planner_state == PLANNER_IDLE) {
+        mp.constraints_bf = nullptr;                // new blocks get the new limits
+        return;
+    }
+    mpBuf_t *bf = _get_uncommitted_buffer();
+    mp.constraints_bf = (bf == nullptr) ? nullptr : mp_plan_constraints(bf, CONSTRAINT_NOW_BLOCKS);
+}
+
+/*
+ *  _get_uncommitted_buffer() - first queued block exec hasn't committed to, or nullptr if it isn't primed yet
+ */
+
+static mpBuf_t *_get_uncommitted_buffer()
+{
+    mpBuf_t *bf = mb.r;
+    while (bf->buffer_state >= MP_BUFFER_PLANNED) {
+        if ((bf = bf->nx) == mb.r) {
+            break;
+        }
+    }
+    return ((bf->buffer_state < MP_BUFFER_IN_PROCESS) ? nullptr : bf);
+}
+
 void mp_start_traverse_override(const float ramp_time, const float override_factor)
 {
     return;
@@ -617,8 +907,29 @@ void mp_end_traverse_override(const float ramp_time)
 
 /*
  * mp_planner_time_accounting() - gather time in planner
+ * _time_drop() - take a block that is starting or being freed out of plannable_time
+ *
+ *  plannable_time is the time of the blocks after the run buffer that can no longer be
+ *  planned, up to the first one that can. It's kept as a running sum over the blocks
+ *  from mp.time_first to mp.time_end rather than walking the queue for each block, so
+ *  the cost doesn't grow with the queue. Each block is added once, as the end passes
+ *  it, and taken out with the time it was added with when it starts or is freed.
+ *  Called by the exec as each block starts, as the walk was.
+ *
+ *  A block's time is the one it had when it was counted. The only later change is the
+ *  forward plan of the block after the run buffer, and that block leaves the sum as it
+ *  starts. Blocks only become plannable again by a feed override, which sets time_rescan
+ *  so the next call counts from scratch; so does a flush (_flush_buffers()).
  */
 
+static void _time_drop(mpBuf_t *bf)
+{
+    if ((mp.time_first == bf) && (mp.time_first != mp.time_end)) {
+        mp.plannable_time -= bf->accounted_time;
+        mp.time_first = bf->nx;
+    }
+}
+
 void mp_planner_time_accounting()
 {
     mpBuf_t *bf = mb.r;                             // start with run buffer
@@ -627,14 +938,155 @@ void mp_planner_time_accounting()
     if (bf->buffer_state != MP_BUFFER_RUNNING) {    // this is not an error condition
         return;
     }
-    mp.plannable_time = 0; //UPDATE_BF_MS(bf); //+++++
-    while ((bf = bf->nx) != mb.r) {
-        if (bf->buffer_state == MP_BUFFER_EMPTY || bf->plannable == true) {
+    _time_drop(bf);
+    if (mp.time_rescan || (mp.time_first != bf->nx)) {     // nothing counted left, or start over
+        mp.time_rescan = false;
+        mp.time_first = bf->nx;
+        mp.time_end = bf->nx;
+    }
+    if (mp.time_first == mp.time_end) {
+        mp.plannable_time = 0;                      // don't carry rounding from the blocks gone
+    }
+    while ((mp.time_end != bf) && (mp.time_end->buffer_state != MP_BUFFER_EMPTY) && !mp.time_end->plannable) {
+        mp.time_end->accounted_time = mp.time_end->block_time;
+        mp.plannable_time += mp.time_end->accounted_time;
+        mp.time_end = mp.time_end->nx;
+    }
+    UPDATE_MP_DIAGNOSTICS //+++++
+}
+
+/*
+ * _estimate_queue_time() - estimate the run time of the blocks behind the running block
+ * mp_get_queue_time()    - estimated seconds until the queue runs dry
+ *
+ *  Moves are timed from their back-planned velocities (see mp_estimate_block_time()), or
+ *  exactly once forward planned, so the estimate errs long until a block is about to run.
+ *  The running block counts down in mp.run_time_remaining. Only runs when the planner has
+ *  nothing else to do and something has changed.
+ *
+ *  The runtime may free blocks during the walk, which stops at the first empty buffer.
+ *  That only leaves the estimate a block behind until the next one.
+ */
+
+static void _estimate_queue_time()
+{
+    mp.request_estimate = false;
+    float queue_time = 0;
+    float entry_velocity = 0;
+    mpBuf_t *bf = mb.r;
+    do {
+        bufferState state = mp_get_buffer_state(bf);
+        if (state == MP_BUFFER_EMPTY) {
             break;
         }
-        mp.plannable_time += bf->block_time;
+        if (state != MP_BUFFER_RUNNING) {
+            if (bf->block_type == BLOCK_TYPE_ALINE) {
+                queue_time += (state == MP_BUFFER_PLANNED) ? bf->block_time :
+                                                                        mp_estimate_block_time(bf, entry_velocity);
+            } else if (bf->block_type == BLOCK_TYPE_DWELL) {
+                queue_time += bf->block_time / 60;  // dwells are in seconds
+            }
+        }
+        entry_velocity = bf->exit_velocity;
+    } while ((bf = bf->nx) != mb.r);
+    mp.queue_time = queue_time;
+}
+
+float mp_get_queue_time()
+{
+    return ((mp.run_time_remaining + mp.queue_time) * 60);
+}
+
+/*
+ * mp_record_starvation() - note a cycle ending because the queue ran dry - called from exec
+ * mp_starvation_callback() - report a starved stop from the main loop
+ *
+ *  A cycle ends when the runtime frees its last buffer. That is a starved stop, and not
+ *  one the program asked for, if the block timeout fired while the machine was moving
+ *  and no block was committed since. In other words, the planner had to plan the last
+ *  block to a stop because the host didn't send the next one in time. Single moves sent
+ *  to an idle machine don't count, as the machine isn't moving when their timeout fires.
+ *  A program that ends without M2 or M30 counts once, at its end.
+ *
+ *  Starved stops are counted with the line and time of the last, and reported as an
+ *  exception. The exec can't send the exception from interrupt level, so it is left for
+ *  the controller.
+ */
+
+void mp_record_starvation()
+{
+    if (!mp.starve_suspect || (cm.cycle_state != CYCLE_MACHINING)) {
+        return;
+    }
+    mp.starve_suspect = false;
+    mp.starve_count++;
+    mp.starve_line = mr.gm.linenum;
+    mp.starve_time = (float)SysTickTimer.getValue() / 1000;
+    mp.starve_report = true;
+    if (mp.job.active) {
+        mp.job.starve_tick = SysTickTimer.getValue();   // starved time runs until the next cycle start
+    }
+}
+
+stat_t mp_starvation_callback()
+{
+    if (!mp.starve_report) {
+        return (STAT_NOOP);
+    }
+    mp.starve_report = false;
+    char msg[48];
+    sprintf(msg, "queue ran dry after line %lu", (unsigned long)mp.starve_line);
+    rpt_exception(STAT_PLANNER_STARVED, msg);
+    return (STAT_OK);
+}
+
+/*
+ * mp_job_start() - note a cycle start in the job summary - called from cm_cycle_start()
+ * mp_job_end()   - close the job summary at program end (M2, M30) - called from exec
+ *
+ *  A job runs from the first cycle start after the last program end to the next program end.
+ *  It usually spans several cycles, as any stop that empties the queue also ends the cycle.
+ *  The time from a starved stop to the cycle start that follows it is counted as starved time.
+ *
+ *  The exec adds the time, distance and peak velocity of each segment to the running block,
+ *  and the block to the job when it completes. See _exec_aline_segment() and mp_exec_aline().
+ *  This keeps the per-segment cost to a few adds, and keeps the running totals from losing
+ *  small segment times to float precision. Averages are computed once, at the end of the job.
+ */
+
+void mp_job_start()
+{
+    mpJobStats_t *job = &mp.job;
+    uint32_t now = SysTickTimer.getValue();
+
+    if (!job->active) {
+        memset(job, 0, sizeof(mpJobStats_t));
+        job->active = true;
+        job->start_tick = now;
+        return;
+    }
+    if (job->starve_tick != 0) {
+        job->starved_time += (float)(now - job->starve_tick) / 1000;
+        job->starve_tick = 0;
     }
-    UPDATE_MP_DIAGNOSTICS //+++++
+}
+
+void mp_job_end()
+{
+    mpJobStats_t *job = &mp.job;
+
+    if (!job->active) {
+        return;
+    }
+    job->active = false;
+    job->wall_time = (float)(SysTickTimer.getValue() - job->start_tick) / 1000;
+    if (job->motion_time > EPSILON) {
+        job->average_feed = job->length / (job->motion_time / 60);
+    }
+    if (job->commanded_time > EPSILON) {
+        job->average_commanded = job->length / (job->commanded_time / 60);
+    }
+    job->report = true;
 }
 
 /**** PLANNER BUFFER PRIMITIVES ************************************************************
@@ -679,10 +1131,30 @@ void mp_planner_time_accounting()
  *  run buffer pointer only moves forward on mp_free_run_buffer().
  *  Tests, gets and unget have no effect on the pointers.
  *
+ *  Buffer ownership:
+ *  The main loop and the interrupts (exec, forward planning and the loader) share the
+ *  ring with no locks. Each side only writes what it owns, and the buffer state says who
+ *  owns a block's contents:
+ *
+ *    - EMPTY to IN_PROCESS belong to the main loop (get, commit, vmax planning)
+ *    - PREPPED and up may be read by the interrupts; the main loop may still back plan
+ *      a PREPPED block but leaves PLANNED and RUNNING blocks alone unless it replans a
+ *      held queue, which only demotes them to PREPPED
+ *    - RUNNING and the free back to EMPTY belong to the interrupts
+ *
+ *  mb.w is only advanced by the main loop and mb.r only by the interrupts (a flush moves
+ *  it with the runtime idle). A state that hands a block to the other side is set with
+ *  mp_set_buffer_state(), which orders the block's contents before its state, and a state
+ *  that was set by the other side is read with mp_get_buffer_state(), which orders it
+ *  before the contents. The interrupts run to completion over the main loop and the
+ *  target is a single core, so compiler fences are all the ordering this takes.
+ *  buffers_available is counted from both sides, so it is an atomic.
+ *
  * Functions Provided:
  *   _clear_buffer(bf)        Zero the contents of a buffer
  *
- *   mp_init_buffers()        Initialize or reset buffers
+ *   mp_init_buffers()        Initialize the buffers and link the ring
+ *   _flush_buffers()         Empty the queue without clearing the buffers in it
  *
  *   mp_get_prev_buffer(bf)   Return pointer to the previous buffer in the linked list
  *   mp_get_next_buffer(bf)   Return pointer to the next buffer in the linked list
@@ -721,6 +1193,7 @@ static inline void _clear_buffer(mpBuf_t *bf)
 
     // We'll have to figure something else out for C, sorry.
     bf->reset();
+    bf->cold->reset();
 }
 
 void mp_init_buffers(void)
@@ -735,6 +1208,7 @@ void mp_init_buffers(void)
     mb.r = &mb.bf[0];
     pv = &mb.bf[PLANNER_BUFFER_POOL_SIZE-1];
     for (uint8_t i=0; i < PLANNER_BUFFER_POOL_SIZE; i++) {
+        mb.bf[i].cold = &mbc.cold[i];                // bind the cold side (must precede the clear)
         _clear_buffer(&mb.bf[i]);
         uint8_t nx_i = ((i<(PLANNER_BUFFER_POOL_SIZE-1))?(i+1):0); // buffer incr & wrap
 
@@ -747,6 +1221,13 @@ void mp_init_buffers(void)
         pv = &mb.bf[i];
     }
     mb.buffers_available = PLANNER_BUFFER_POOL_SIZE;
+    mp.time_rescan = true;                          // recount plannable_time at the next block
+    mp.preplan_first = nullptr;                     // preplanned blocks went with the queue
+    mp.preplan_count = 0;
+    mbc.gm_last = 0;                                 // buffers start out referencing snapshot 0
+    for (uint8_t i=0; i < PLANNER_BUFFER_POOL_SIZE; i++) {
+        mbc.cold[i].gm_index = 0;
+    }
 
 //    mb.entry_changed = false;
 
@@ -757,6 +1238,36 @@ void mp_init_buffers(void)
     mr.p = &mr.bf[1];
 }
 
+/*
+ * _flush_buffers() - empty the queue for mp_flush_planner()
+ *
+ *  Rather than clearing the pool, the run pointer is moved up to the write pointer, so the
+ *  queue is empty and the flushed blocks lie behind the write pointer, the last buffers it
+ *  comes back to. Each is cleared as it becomes the next write buffer, in
+ *  mp_commit_write_buffer(), so a flush costs the same however many blocks it drops. The
+ *  planner looks one buffer either side of the queue, so the newest flushed block, which
+ *  is now behind the first new one, and the write buffer, which was the run buffer if the
+ *  queue was full, are cleared here. Only call with the runtime idle.
+ */
+static void _flush_buffers()
+{
+    mb.r = mb.w;
+    if (mb.w->buffer_state != MP_BUFFER_EMPTY) {
+        _clear_buffer(mb.w);
+    }
+    _clear_buffer(mb.w->pv);
+    mb.buffers_available = PLANNER_BUFFER_POOL_SIZE;
+    mp.p = mb.w;                                    // the planner pointer may be among the flushed blocks
+    mp.time_rescan = true;
+    mp.preplan_first = nullptr;
+    mp.preplan_count = 0;
+
+    mr.bf[0].nx = &mr.bf[1];                        // and the runtime stub buffers, as mp_init_buffers()
+    mr.bf[1].nx = &mr.bf[0];
+    mr.r = &mr.bf[0];
+    mr.p = &mr.bf[1];
+}
+
 /*
  * These GET functions are defined here but we use the macros in planner.h instead
  *
@@ -772,8 +1283,9 @@ mpBuf_t * mp_get_next_buffer(const mpBuf_t *bf)
 
 mpBuf_t * mp_get_write_buffer()     // get & clear a buffer
 {
-    if (mb.w->buffer_state == MP_BUFFER_EMPTY) {
+    if (mp_get_buffer_state(mb.w) == MP_BUFFER_EMPTY) {
         _clear_buffer(mb.w);        // ++++RG this is redundant, it was just cleared in mp_free_run_buffer
+        mb.w->cold->gm_index = mbc.gm_last;  // commands keep the newest Gcode state. aline() may share a new one
         mb.w->buffer_state = MP_BUFFER_INITIALIZING;
         mb.buffers_available--;
         return (mb.w);
@@ -814,8 +1326,13 @@ void mp_commit_write_buffer(const blockType block_type)
     }
     mb.w->plannable = true;                     // enable block for planning
     mp.request_planning = true;
-    mb.w = mb.w->nx;                            // advance write buffer pointer
+    mpBuf_t *nx = mb.w->nx;
+    if ((nx != mb.r) && (nx->buffer_state != MP_BUFFER_EMPTY)) {
+        _clear_buffer(nx);                      // a block dropped by a flush - see _flush_buffers()
+    }
+    mb.w = nx;                                  // advance write buffer pointer
     mp.block_timeout.set(BLOCK_TIMEOUT_MS);     // reset the block timer
+    mp.starve_suspect = false;                  // it wasn't late enough to stop the machine
     qr_request_queue_report(+1);                // request QR and add to "added buffers" count
 }
 
@@ -823,7 +1340,7 @@ void mp_commit_write_buffer(const blockType block_type)
 mpBuf_t * mp_get_run_buffer()
 {
     // EMPTY is the one case where nothing is returned. This is not an error
-    if (mb.r->buffer_state == MP_BUFFER_EMPTY) {
+    if (mp_get_buffer_state(mb.r) == MP_BUFFER_EMPTY) {
         return (NULL);
     }
     // Otherwise return the buffer. Let mp_exec_move() manage the state machine to sort out:
@@ -838,6 +1355,10 @@ bool mp_free_run_buffer()           // EMPTY current run buffer & advance to the
     _audit_buffers();               // diagnostic audit for buffer chain integrity (only runs in DEBUG mode)
 
     mpBuf_t *r = mb.r;
+    _time_drop(r);                  // a command is still counted in plannable_time
+    if (r->block_type == BLOCK_TYPE_ALINE) {
+        qr_block_end(r);            // line timing for the queue report
+    }
     mb.r = mb.r->nx;                // advance to next run buffer
     _clear_buffer(r);               // clear it out (& reset unlocked and set MP_BUFFER_EMPTY)
 
@@ -846,6 +1367,87 @@ bool mp_free_run_buffer()           // EMPTY current run buffer & advance to the
     return (mb.w == mb.r);          // return true if the queue emptied
 }
 
+/*
+ * mp_share_gm()         - set the Gcode model state of a new block
+ * mp_get_gm_available() - number of Gcode state snapshots free for new blocks
+ *
+ *  mp_share_gm() sets the line number of write buffer bf and points it at the newest
+ *  snapshot in mbc.gm[] if that has the same modal state as gm_in - the usual case for
+ *  consecutive moves. Otherwise it takes the next snapshot in the ring. The target is not
+ *  part of a snapshot; the caller sets bf->cold->target.
+ *
+ *  Inverse time feeds are stored in units per minute mode, as _calculate_vmaxes() turns
+ *  the feed rate into the move time. target_comp is not compared. It is only used by the
+ *  runtime and is always zero in the model.
+ *
+ *  Snapshots are taken in queue order and the runtime only frees buffers from the run
+ *  end, so the snapshots in use are the run from the run buffer's to mbc.gm_last. The
+ *  runtime never writes the snapshot ring; if it frees a buffer while this is being
+ *  computed the count is low, never high.
+ */
+
+static cmFeedRateMode _get_gm_feed_rate_mode(const GCodeState_t *gm)
+{
+    if ((gm->motion_mode != MOTION_MODE_STRAIGHT_TRAVERSE) && (gm->feed_rate_mode == INVERSE_TIME_MODE)) {
+        return (UNITS_PER_MINUTE_MODE);
+    }
+    return (gm->feed_rate_mode);
+}
+
+static bool _gm_is_shared(const GCodeState_t *gm, const GCodeState_t *gm_in)
+{
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        if (gm->work_offset[axis] != gm_in->work_offset[axis]) {
+            return (false);
+        }
+    }
+    return ((gm->motion_mode       == gm_in->motion_mode) &&
+            (gm->feed_rate         == gm_in->feed_rate) &&
+            (gm->parameter         == gm_in->parameter) &&
+            (gm->feed_rate_mode    == _get_gm_feed_rate_mode(gm_in)) &&
+            (gm->select_plane      == gm_in->select_plane) &&
+            (gm->units_mode        == gm_in->units_mode) &&
+            (gm->path_control      == gm_in->path_control) &&
+            (gm->distance_mode     == gm_in->distance_mode) &&
+            (gm->arc_distance_mode == gm_in->arc_distance_mode) &&
+            (gm->absolute_override == gm_in->absolute_override) &&
+            (gm->coord_system      == gm_in->coord_system) &&
+            (gm->tool              == gm_in->tool) &&
+            (gm->tool_select       == gm_in->tool_select) &&
+            (gm->spindle_speed     == gm_in->spindle_speed) &&
+            (gm->spindle_control   == gm_in->spindle_control) &&
+            (gm->raster_row        == gm_in->raster_row) &&
+            (gm->output_first      == gm_in->output_first) &&
+            (gm->output_count      == gm_in->output_count));
+}
+
+stat_t mp_share_gm(mpBuf_t *bf, const GCodeState_t *gm_in)
+{
+    bf->cold->linenum = gm_in->linenum;
+    if (!_gm_is_shared(&mbc.gm[mbc.gm_last], gm_in)) {
+        if (mp_get_gm_available() == 0) {           // never supposed to fail - see mp_planner_is_full()
+            return (cm_panic(STAT_FAILED_GET_PLANNER_BUFFER, "mp_share_gm()"));
+        }
+        uint8_t gm_next = (mbc.gm_last < (PLANNER_GM_POOL_SIZE-1)) ? (mbc.gm_last+1) : 0;
+        GCodeState_t *gm = &mbc.gm[gm_next];
+        memcpy(gm, gm_in, sizeof(GCodeState_t));
+        gm->feed_rate_mode = _get_gm_feed_rate_mode(gm_in);
+        mbc.gm_last = gm_next;
+    }
+    bf->cold->gm_index = mbc.gm_last;
+    return (STAT_OK);
+}
+
+uint8_t mp_get_gm_available()
+{
+    mpBuf_t *r = mb.r;              // read once - the runtime may advance it
+    if (mp_get_buffer_state(r) == MP_BUFFER_EMPTY) {
+        return (PLANNER_GM_POOL_SIZE - 1);          // the newest is kept to share with the next block
+    }
+    uint8_t used = ((mbc.gm_last + PLANNER_GM_POOL_SIZE - r->cold->gm_index) % PLANNER_GM_POOL_SIZE) + 1;
+    return (PLANNER_GM_POOL_SIZE - used);
+}
+
 /* UNUSED FUNCTIONS - left in for completeness and for reference
 void mp_copy_buffer(mpBuf_t *bf, const mpBuf_t *bp)
 {
@@ -871,14 +1473,14 @@ void mp_dump_planner(mpBuf_t *bf_start)   // starting at bf
 
     do {
         printf ("%d,",    (int)bf->buffer_number);
-        printf ("%d,",    (int)bf->linenum);
+        printf ("%d,",    (int)bf->cold->linenum);
         printf ("%d,",    (int)bf->buffer_state);
         printf ("%d,",    (int)bf->hint);
         printf ("%d,",    (int)bf->plannable);
-        printf ("%d,",    (int)bf->iterations);
+        printf ("%d,",    (int)bf->cold->iterations);
 
-        printf ("%1.2f,", bf->block_time_ms);
-        printf ("%1.2f,", bf->plannable_time_ms);
+        printf ("%1.2f,", bf->cold->block_time_ms);
+        printf ("%1.2f,", bf->cold->plannable_time_ms);
         printf ("%1.3f,", bf->override_factor);
         printf ("%1.3f,", bf->throttle);
         printf ("%1.5f,", bf->length);
@@ -924,9 +1526,8 @@ void mp_dump_planner(mpBuf_t *bf_start)   // starting at bf
  * _audit_buffers() - diagnostic to determine if buffers are sane
  */
 
-static void _audit_buffers()
+static void _audit_buffers()     // called from the exec, so the main loop can't move the ring under it
 {
-    __disable_irq();
 
     // Current buffer should be in the running state.
     if (mb.r->buffer_state != MP_BUFFER_RUNNING) {
@@ -942,8 +1543,9 @@ static void _audit_buffers()
     }
 
     // Now check every buffer, in order we would execute them.
+    // Stop at the write buffer - those after it may be blocks dropped by a flush.
     mpBuf_t *bf = mb.r->nx;
-    while (bf != mb.r) {
+    while ((bf != mb.r) && (bf->pv != mb.w)) {
         // Check that the next from the previous is correct.
         if (bf->pv->nx != bf || bf->nx->pv != bf){
 //            _planner_report("buffer audit3");
@@ -1001,7 +1603,6 @@ static void _audit_buffers()
         // Now look at the next one.
         bf = bf->nx;
     }
-    __enable_irq();
 }
 
 #pragma GCC reset_options
@@ -81,6 +81,7 @@
  *  - mp_queue_command() - queue a canned command
  *  - mp_json_command()  - queue a JSON command for run-time interpretation and execution (M100)  
  *  - mp_json_wait()     - queue a JSON wait for run-time interpretation and execution (M101)
+ *  - mp_temperature_wait() - queue a wait for a heater to reach temperature (M109, M190)
  *  - 
  * In addition, cm_arc_feed() valaidates and sets up a arc paramewters and calls mp_aline() 
  * repeatedly to spool out the arc segments into the planner queue.
@@ -149,6 +150,9 @@
 #ifndef PLANNER_H_ONCE
 #define PLANNER_H_ONCE
 
+#include <stddef.h>               // used for offsetof()
+#include <type_traits>            // used for is_trivially_copyable
+#include <atomic>                 // used for the buffer hand-off between main loop and exec
 #include "canonical_machine.h"    // used for GCodeState_t
 
 using Motate::Timeout;
@@ -188,7 +192,8 @@ typedef enum {                      // bf->block_type values
     BLOCK_TYPE_TOOL,                // T command (T, not M6 tool change)
     BLOCK_TYPE_SPINDLE_SPEED,       // S command
     BLOCK_TYPE_STOP,                // program stop
-    BLOCK_TYPE_END                  // program end
+    BLOCK_TYPE_END,                 // program end
+    BLOCK_TYPE_SYNC                 // spindle synchronized move (G33, G33.1) - see mp_sync_line()
 } blockType;
 
 typedef enum {
@@ -243,22 +248,55 @@ typedef enum {
 
 /*** Most of these factors are the result of a lot of tweaking. Change with caution.***/
 
+#ifndef PLANNER_BUFFER_POOL_SIZE                        // usually set per board in board/*.mk, and by MACHINE_PROFILE
 #define PLANNER_BUFFER_POOL_SIZE    (48)                // Suggest 12 min. Limit is 255
+#endif
 #define PLANNER_BUFFER_HEADROOM     (4)                 // Buffers to reserve in planner before processing new input line
+#ifndef PLANNER_GM_POOL_SIZE                            // Gcode state snapshots shared by the blocks in the planner
+#define PLANNER_GM_POOL_SIZE        (PLANNER_BUFFER_POOL_SIZE/2 + PLANNER_BUFFER_HEADROOM) // Limit is 255
+#endif
+#define PREPLAN_HORIZON_MAX         (PLANNER_BUFFER_POOL_SIZE/2) // longest release horizon a preplanned block may ask for
+#define PREPLAN_RUNWAY_BLOCKS       (4)                 // fewest released blocks ahead of the runtime before preplanning is abandoned
+#ifndef FORWARD_DIFFS_FIXED_POINT                       // usually set per board in board/*.mk
+#define FORWARD_DIFFS_FIXED_POINT   (0)                 // 1 = run head/tail forward differences in int64 fixed point
+#endif
+#define FIXED_VELOCITY_SHIFT        (32)                // fixed point segment velocity is Q32.32
+#ifndef MOTION_PROFILE_ORDER                            // usually set per machine in board/*.mk
+#define MOTION_PROFILE_ORDER        (5)                 // head/tail velocity curve: 5 = quintic, 3 = jerk limited S-curve
+#endif
+#ifndef KINEMATICS_MIDPOINT                             // for non-linear KINEMATICS (see kinematics.h)
+#define KINEMATICS_MIDPOINT         (0)                 // 1 = also solve IK at segment midpoints and step each half linearly
+#endif
+#ifndef PLANNER_ARC_BLOCKS
+#define PLANNER_ARC_BLOCKS          (0)                 // 1 = queue G2/G3 arcs as single blocks, interpolated by exec
+#endif
 #define JERK_MULTIPLIER             ((float)1000000)    // DO NOT CHANGE - must always be 1 million
 
 #define JUNCTION_INTEGRATION_MIN    (0.05)              // minimum allowable setting
 #define JUNCTION_INTEGRATION_MAX    (5.00)              // maximum allowable setting
+#define JUNCTION_CURVE_ANGLE_MAX    ((float)0.35)       // largest turn (radians) taken as part of a curve in junction curvature mode
 
 #define MIN_SEGMENT_MS              ((float)0.75)       // minimum segment milliseconds
 #define NOM_SEGMENT_MS              ((float)1.5)        // nominal segment ms (at LEAST MIN_SEGMENT_MS * 2)
+#define MAX_SEGMENT_MS              ((float)(MIN_SEGMENT_MS * 4))   // maximum segment ms - used for cruise (body) segments
+#define TRANSITION_SEGMENTS_MIN     (10)                // head and tail get at least this many segments, down to MIN_SEGMENT_MS
+#define SEGMENT_STRETCH_LIMIT       ((float)4.0)        // largest {sgx:} - segments stretched while exec runs late
+#define SEGMENT_STRETCH_STEP        ((float)1.25)       // stretch grows by this for each section the loader starved in
+#define SEGMENT_STRETCH_DECAY       ((float)1.02)       // ...and shrinks by this for each section it didn't
+#ifndef PREP_BUFFERS
+#define PREP_BUFFERS                (4)                 // prepared segments exec may run ahead of the loader. Must be a power of 2
+#endif
 #define MIN_BLOCK_MS                ((float)1.5)        // minimum block (whole move) milliseconds
+#define STEP_RATE_HEADROOM          ((float)0.95)       // fraction of one step per DDA tick allowed for any motor
 #define BLOCK_TIMEOUT_MS            ((float)30.0)       // MS before deciding there are no new blocks arriving
 #define PHAT_CITY_MS                ((float)100.0)      // if you have at least this much time in the planner
 
 #define NOM_SEGMENT_TIME            ((float)(NOM_SEGMENT_MS / 60000))       // DO NOT CHANGE - time in minutes
 #define NOM_SEGMENT_USEC            ((float)(NOM_SEGMENT_MS * 1000))        // DO NOT CHANGE - time in microseconds
 #define MIN_SEGMENT_TIME            ((float)(MIN_SEGMENT_MS / 60000))       // DO NOT CHANGE - time in minutes
+#define MIN_SEGMENT_USEC            ((float)(MIN_SEGMENT_MS * 1000))        // DO NOT CHANGE - time in microseconds
+#define MAX_SEGMENT_TIME            ((float)(MAX_SEGMENT_MS / 60000))       // DO NOT CHANGE - time in minutes
+#define MAX_SEGMENT_USEC            ((float)(MAX_SEGMENT_MS * 1000))        // DO NOT CHANGE - time in microseconds
 #define MIN_BLOCK_TIME              ((float)(MIN_BLOCK_MS / 60000))         // DO NOT CHANGE - time in minutes
 #define PHAT_CITY_TIME              ((float)(PHAT_CITY_MS / 60000))         // DO NOT CHANGE - time in minutes
 
@@ -267,6 +305,14 @@ typedef enum {
 #define FEED_OVERRIDE_MAX           (2.00)              // 200% maximum
 #define FEED_OVERRIDE_RAMP_TIME     (0.500/60)          // ramp time for feed overrides
 #define FEED_OVERRIDE_FACTOR        (1.00)              // initial value
+#define FEED_OVERRIDE_NOW_BLOCKS    (4)                 // blocks changed as soon as an override is requested...
+#define FEED_OVERRIDE_SLICE_BLOCKS  (4)                 // ...and in each idle pass of the planner after that
+#define FEED_OVERRIDE_KNOB          false               // {mfok:} initial value - override knob on the aux ADC
+#define FEED_OVERRIDE_KNOB_FULL     (0.98)              // knob position read as 100% - the ADC may never reach its top
+#define FEED_OVERRIDE_KNOB_DEADBAND (0.01)              // knob changes smaller than this are taken as ADC noise
+#define FEED_OVERRIDE_KNOB_JERK     (4 / (FEED_OVERRIDE_RAMP_TIME * FEED_OVERRIDE_RAMP_TIME))  // full range in the ramp time
+#define CONSTRAINT_NOW_BLOCKS       (4)                 // blocks given new motion limits as soon as they change...
+#define CONSTRAINT_SLICE_BLOCKS     (4)                 // ...and in each idle pass of the planner after that
 
 #define TRAVERSE_OVERRIDE_ENABLE    false               // initial value
 #define TRAVERSE_OVERRIDE_MIN       (0.05)              // 5% minimum
@@ -288,7 +334,7 @@ typedef enum {
 
 //#define ASCII_ART(s)            xio_writeline(s)
 #define ASCII_ART(s)
-//#define UPDATE_BF_DIAGNOSTICS(bf) { bf->block_time_ms = bf->block_time*60000; bf->plannable_time_ms = bf->plannable_time*60000; }
+//#define UPDATE_BF_DIAGNOSTICS(bf) { bf->cold->block_time_ms = bf->block_time*60000; bf->cold->plannable_time_ms = bf->plannable_time*60000; }
 #define UPDATE_MP_DIAGNOSTICS     { mp.plannable_time_ms = mp.plannable_time*60000; }
 
 /*
@@ -298,15 +344,44 @@ typedef enum {
  *  Please refer to header comments in for important details on buffers and blocks
  *    - plan_zoid.cpp / mp_calculate_ramps()
  *    - plan_exec.cpp / mp_exec_aline()
+ *
+ *  Each buffer is split into a hot planning record (mpBuffer_to_clear / mpBuf_t) and a cold
+ *  side (mpBufCold_t) holding the Gcode model state and diagnostics. The planning passes walk
+ *  the ring and touch only the hot records, which keeps them dense in memory and cache as the
+ *  pool gets larger. The cold side is read when a block is queued and when it starts to run.
+ *  bf->cold points to a buffer's cold side and, like pv and nx, is never cleared.
+ *
+ *  Consecutive blocks almost always share their modal Gcode state, so a block only carries
+ *  its own target and line number. The rest is a snapshot in mbc.gm[] that's shared with its
+ *  neighbours (see mp_share_gm()). Snapshots are taken in queue order, so the ones in use
+ *  are always the run from the run buffer's snapshot to the newest one.
  */
 
-struct mpBuffer_to_clear {
-    // Note: _clear_buffer() zeros all data from this point down
-    stat_t (*bf_func)(struct mpBuffer *bf); // callback to buffer exec function
-    cm_exec_t cm_func;              // callback to canonical machine execution function
-
+typedef struct mpArc {              // arc geometry of an arc block (see PLANNER_ARC_BLOCKS, mp_arc())
+    uint8_t plane_axis_0;           // arc plane axis 0 - e.g. X for G17
+    uint8_t plane_axis_1;           // arc plane axis 1 - e.g. Y for G17
+    uint8_t linear_axis;            // linear axis (normal to plane)
+    float center_0;                 // center of circle at plane axis 0
+    float center_1;                 // center of circle at plane axis 1
+    float radius;                   // radius at the start
+    float radius_delta;             // end radius - start radius, spread along the arc so it ends on the target
+    float theta;                    // starting angle, as in plan_arc.cpp
+    float angular_travel;           // signed travel in radians
+    float linear_travel;            // travel along the linear axis
+    float exit_unit[AXES];          // tangent at the end. bf->unit is the tangent at the start
+} mpArc_t;
+
+#define SPLINE_AXES         3       // splines are curves in X, Y and Z. Other axes hold still
+#define SPLINE_INTERVALS    8       // parameter intervals in the arc length table of a spline
+
+typedef struct mpSpline {           // cubic Bezier of a spline block (see PLANNER_ARC_BLOCKS, mp_spline())
+    float p[4][SPLINE_AXES];        // control points, start to end
+    float length[SPLINE_INTERVALS+1]; // arc length at parameter 0, 1/N, 2/N ... 1 - see mp_spline_init_length()
+    float exit_unit[AXES];          // tangent at the end. bf->unit is the tangent at the start
+} mpSpline_t;
+
+struct mpBufferCold {
     //+++++ DIAGNOSTICS for easier debugging
-    uint32_t linenum;               // mirror of bf->gm.linenum
     int iterations;
     float block_time_ms;
     float plannable_time_ms;        // time in planner
@@ -314,6 +389,30 @@ struct mpBuffer_to_clear {
     int8_t meet_iterations;         // iterations needed in _get_meet_velocity
     //+++++ to here
 
+#if (PLANNER_ARC_BLOCKS == 1)
+    union {
+        mpArc_t arc;                // arc geometry - only valid if bf->arc is set
+        mpSpline_t spline;          // spline geometry - only valid if bf->spline is set
+    };
+#endif
+    float target[AXES];             // rotated move target, or the value vector of a command
+    uint32_t linenum;               // Gcode block line number
+    uint8_t gm_index;               // shared Gcode model state in mbc.gm[] - see mp_get_block_gm()
+
+    // Clears the diagnostics only. The rest is not cleared as it's always overwritten before
+    // use: by aline() and mp_get_write_buffer(), or by the value vector write in mp_queue_command()
+    void reset() {
+        memset((void *)(this), 0, offsetof(mpBufferCold, target));
+    }
+};
+
+typedef struct mpBufferCold mpBufCold_t;
+
+struct mpBuffer_to_clear {
+    // Note: _clear_buffer() zeros all data from this point down
+    stat_t (*bf_func)(struct mpBuffer *bf); // callback to buffer exec function
+    cm_exec_t cm_func;              // callback to canonical machine execution function
+
     bufferState buffer_state;       // used to manage queuing/dequeuing
     blockType block_type;           // used to dispatch to run routine
     blockState block_state;         // move state machine sequence
@@ -324,9 +423,20 @@ struct mpBuffer_to_clear {
     bool axis_flags[AXES];          // set true for axes participating in the move & for command parameters
 
     bool plannable;                 // set true when this block can be used for planning
+#if (PLANNER_ARC_BLOCKS == 1)
+    bool arc;                       // set true for an arc block. Geometry is in bf->cold->arc
+    bool spline;                    // set true for a spline block. Geometry is in bf->cold->spline
+#endif
+    bool converged;                 // set true when back-planning has settled this block for its exit velocity
+    bool nonstop;                   // set true for a command that motion runs through (see mp_queue_command())
+    bool preplanned;                // set true for a block whose velocities were planned by the host (see mp_aline_planned())
+    uint8_t preplan_horizon;        // blocks that must follow a preplanned block before it is released to run
+    bool sync_tap;                  // set true for a rigid tapping block - it returns to its start (see mp_sync_line())
+    float sync_pitch;               // travel per spindle turn of a spindle synchronized block (mm)
 
     float length;                   // total length of line or helix in mm
     float block_time;               // computed move time for entire block (move)
+    float accounted_time;           // block_time as added to mp.plannable_time (see mp_planner_time_accounting())
     float override_factor;          // feed rate or rapid override factor for this block ("override" is a reserved word)
 
     // We are removing all entry_* values.
@@ -350,72 +460,66 @@ struct mpBuffer_to_clear {
     float jerk_sq;                  // Jm^2 is used for planning (computed and cached)
     float recip_jerk;               // 1/Jm used for planning (computed and cached)
     float sqrt_j;                   // sqrt(jM) used for planning (computed and cached)
-    float q_recip_2_sqrt_j;         // (q/(2 sqrt(jM))) where q = (sqrt(10)/(3^(1/4))), used in length computations (computed and cached)
-
-    GCodeState_t gm;                // Gcode model state - passed from model, used by planner and runtime
+    float q_recip_2_sqrt_j;         // (q/(2 sqrt(jM))) where q = (sqrt(10)/(3^(1/4))), or 2 for the S-curve, used in length computations (computed and cached)
 
+    // Every member's cleared state is all-bits-zero (nullptr, 0.0, false and the *_EMPTY, *_NULL,
+    // *_INACTIVE and NO_HINT enums, which are required to be 0) so one bulk clear does it all
     void reset() {
-        //memset((void *)(this), 0, sizeof(mpBuffer_to_clear));
-        
-        bf_func = nullptr;
-        cm_func = nullptr;
-
-        linenum = 0;
-        iterations = 0;
-        block_time_ms = 0;
-        plannable_time_ms = 0;
-        plannable_length = 0;
-        meet_iterations = 0;
-
-        buffer_state = MP_BUFFER_EMPTY;
-        block_type = BLOCK_TYPE_NULL;
-        block_state = BLOCK_INACTIVE;
-        hint = NO_HINT;
-
-        for (uint8_t i = 0; i< AXES; i++) {
-            unit[i] = 0;
-            axis_flags[i] = 0;
-        }
-
-        plannable = false;
-        length  = 0.0;
-        block_time = 0.0;
-        override_factor = 0.0;
-        cruise_velocity = 0.0;
-        exit_velocity = 0.0;
-        cruise_vset = 0.0;
-        cruise_vmax = 0.0;
-        exit_vmax = 0.0;
-        absolute_vmax = 0.0;
-        junction_vmax = 0.0;
-        jerk = 0.0;
-        jerk_sq = 0.0;
-        recip_jerk = 0.0;
-        sqrt_j = 0.0;
-        q_recip_2_sqrt_j = 0.0;
-        gm.reset();
+        memset((void *)(this), 0, sizeof(mpBuffer_to_clear));
     }
 };
 
+static_assert(std::is_trivially_copyable<mpBuffer_to_clear>::value, "mpBuffer_to_clear must be safe to clear with memset");
+
 typedef struct mpBuffer : mpBuffer_to_clear { // See Planning Velocity Notes for variable usage
 
-    // *** CAUTION *** These two pointers are not reset by _clear_buffer()
+    // *** CAUTION *** These pointers are not reset by _clear_buffer()
     struct mpBuffer *pv;            // static pointer to previous buffer
     struct mpBuffer *nx;            // static pointer to next buffer
+    mpBufCold_t *cold;              // static pointer to this buffer's cold side in mbc.cold[]
     uint8_t buffer_number;          //+++++ DIAGNOSTIC for easier debugging
 } mpBuf_t;
 
 typedef struct mpBufferPool {       // ring buffer for sub-moves
     magic_t magic_start;            // magic number to test memory integrity
 
-    mpBuf_t *r;                     // run buffer pointer
-    mpBuf_t *w;                     // write buffer pointer
-    uint8_t buffers_available;      // running count of available buffers
-    mpBuf_t bf[PLANNER_BUFFER_POOL_SIZE];// buffer storage
+    mpBuf_t * volatile r;           // run buffer pointer - only the exec advances it
+    mpBuf_t * volatile w;           // write buffer pointer - only the main loop advances it
+    std::atomic<uint8_t> buffers_available;// running count of available buffers - both sides count
+    mpBuf_t bf[PLANNER_BUFFER_POOL_SIZE];// buffer storage - hot planning records
 
     magic_t magic_end;
 } mpBufferPool_t;
 
+typedef struct mpBufferColdPool {   // cold sides of the buffers - kept out of mb, which may be HOT_DATA
+    mpBufCold_t cold[PLANNER_BUFFER_POOL_SIZE];// buffer storage - cold side table (Gcode state, diagnostics)
+    GCodeState_t gm[PLANNER_GM_POOL_SIZE];// Gcode model state snapshots shared by the buffers
+    uint8_t gm_last;                // newest snapshot in gm[]
+} mpBufferColdPool_t;
+
+typedef struct mpJobStats {         // per-job performance summary - see mp_job_start()
+    bool active;                    // a job is running - from its first cycle start to M2 or M30
+    volatile bool report;           // a finished job is waiting to be reported
+    uint32_t start_tick;            // SysTick at the start of the job
+    uint32_t starve_tick;           // SysTick of a starved stop not yet followed by a cycle start
+
+    float wall_time;                // seconds from the first cycle start to program end {jsmw:}
+    float motion_time;              // seconds spent running segments {jsmm:}
+    float commanded_time;           // seconds the distance run would take at commanded feed {jsmc:}
+    float starved_time;             // seconds stopped after starved stops {jsms:}
+    float length;                   // mm run in segments {jsml:}
+    float average_feed;             // mm/min achieved in motion, set at job end {jsmf:}
+    float average_commanded;        // mm/min commanded over the same distance, set at job end {jsmg:}
+    float peak_feed;                // fastest segment velocity, mm/min {jsmp:}
+    float peak_commanded;           // fastest commanded cruise velocity, mm/min {jsmq:}
+    uint32_t holds;                 // feedholds taken {jsmh:}
+    uint32_t blocks;                // blocks run to completion {jsmb:}
+    uint32_t segments;              // segments run {jsmn:}
+
+    float block_time;               // minutes of segments in the running block - added to totals at block end
+    float block_length;             // mm of segments in the running block
+} mpJobStats_t;
+
 typedef struct mpMotionPlannerSingleton {  // common variables for planning (move master)
     magic_t magic_start;            // magic number to test memory integrity
 
@@ -429,6 +533,25 @@ typedef struct mpMotionPlannerSingleton {  // common variables for planning (mov
     // timing variables
     float run_time_remaining;       // time left in runtime (including running block)
     float plannable_time;           // time in planner that can actually be planned
+    mpBuf_t *time_first;            // first block counted in plannable_time...
+    mpBuf_t *time_end;              // ...and the block after the last. Equal when none are
+    bool time_rescan;               // a counted block became plannable again - count from scratch
+    float queue_time;               // estimated time of the blocks queued behind the running block
+    bool request_estimate;          // set true to re-estimate queue_time in the planner's idle time
+
+    // starvation detection - see mp_record_starvation()
+    bool starve_suspect;            // block timeout fired while moving, and no block since
+    volatile bool starve_report;    // a starved stop is waiting to be reported
+    uint32_t starve_count;          // stops caused by the queue running dry {stvn:}
+    uint32_t starve_line;           // line number of the last block before the stop {stvl:}
+    float starve_time;              // seconds since startup of the last starved stop {stvt:}
+
+    // host preplanned blocks - see mp_aline_planned()
+    mpBuf_t *preplan_first;         // oldest preplanned block not yet released to run
+    uint8_t preplan_count;          // preplanned blocks not yet released
+    uint32_t preplan_blocks;        // preplanned blocks accepted {ppbn:}
+    uint32_t preplan_rejects;       // preplanned blocks that failed verification and were planned here {ppbr:}
+    mpJobStats_t job;               // performance summary of the running or last job
 
     // planner state variables
     plannerState planner_state;     // current state of planner
@@ -439,9 +562,14 @@ typedef struct mpMotionPlannerSingleton {  // common variables for planning (mov
     bool entry_changed;             // mark if exit_velocity changed to invalidate next block's hint
 
     // feed overrides and ramp variables (these extend the variables in cm.gmx)
-    float mfo_factor;               // runtime override factor
+    float mfo_factor;               // runtime override factor - the target of any ramp
     float ramp_target;
-    float ramp_dvdt;
+    float ramp_dvdt;                // ramp rate in factor per minute of block time
+    float ramp_factor;              // factor of the last block the ramp was applied to
+    mpBuf_t *override_bf;           // next block to apply an override change to, or nullptr
+    mpBuf_t *constraints_bf;        // next block to apply changed motion limits to, or nullptr
+
+    uint32_t step_rate_clamps;      // count of blocks slowed to stay under the DDA step rate
 
     // objects
     Timeout block_timeout;          // Timeout object for block planning
@@ -469,6 +597,31 @@ typedef struct mpBlockRuntimeBuf {  // Data structure for just the parts of RunT
     float exit_velocity;            // velocity at the end of the move
 } mpBlockRuntimeBuf_t;
 
+/*
+ * Velocity jogging
+ *
+ *  A velocity jog runs from exec with no planner buffer. Each segment the runtime steps every
+ *  axis velocity toward the target at that axis' jerk, so the ramps are jerk-limited, then
+ *  runs the segment at the new velocity. The host updates the target vector at any time
+ *  (see cm_jog_velocity()), and the jog ends when the target is zero and the axes are stopped.
+ *
+ *  The main loop writes the target into pending[] with update cleared, then sets update.
+ *  Exec preempts the main loop and never the other way round, so it takes the pending vector
+ *  only once it is whole.
+ */
+typedef struct mpJogRuntime {
+    volatile bool active;               // velocity jog running from exec
+    volatile bool stop;                 // ramp to zero and end, ignoring further updates
+    volatile bool update;               // pending[] holds a new target vector
+    float pending[AXES];                // target velocity written by the main loop (mm/min)
+    float target[AXES];                 // target velocity being followed (mm/min)
+    float velocity[AXES];               // velocity of the last segment (mm/min)
+    float accel[AXES];                  // acceleration of the last segment (mm/min^2)
+    float jerk[AXES];                   // jerk limit (mm/min^3)
+    float travel_min[AXES];             // soft limits, or -/+ INFINITY if not in effect
+    float travel_max[AXES];
+} mpJogRuntime_t;
+
 typedef struct mpMotionRuntimeSingleton {    // persistent runtime variables
 //  uint8_t (*run_move)(struct mpMoveRuntimeSingleton *m); // currently running move - left in for reference
     magic_t magic_start;                // magic number to test memory integrity
@@ -481,10 +634,26 @@ typedef struct mpMotionRuntimeSingleton {    // persistent runtime variables
     float target[AXES];                 // final target for bf (used to correct rounding errors)
     float position[AXES];               // current move position
     float waypoint[SECTIONS][AXES];     // head/body/tail endpoints for correction
+#if (PLANNER_ARC_BLOCKS == 1)
+    bool arc;                           // running an arc or spline block: targets are taken along the curve
+    bool spline;                        // ...which is spline_geometry, not arc_geometry
+    union {
+        mpArc_t arc_geometry;           // copy of the block's arc
+        mpSpline_t spline_geometry;     // copy of the block's spline
+    };
+    uint8_t spline_interval;            // interval of the spline's length table last looked up
+    float arc_start[AXES];              // position at the start of the block
+    float arc_length;                   // length of the block as it started
+    float arc_distance;                 // length run so far
+#endif
 
     float target_steps[MOTORS];         // current MR target (absolute target as steps)
     float position_steps[MOTORS];       // current MR position (target from previous segment)
+#if (KINEMATICS_MIDPOINT == 1)
+    float midpoint_steps[MOTORS];       // midpoint of the previous segment (as steps)
+#endif
     float commanded_steps[MOTORS];      // will align with next encoder sample (target from 2nd previous segment)
+    float delayed_steps[PREP_BUFFERS][MOTORS];  // targets from 2nd, 3rd... previous segments, for exec running ahead
     float encoder_steps[MOTORS];        // encoder position in steps - ideally the same as commanded_steps
     float following_error[MOTORS];      // difference between encoder_steps and commanded steps
 
@@ -498,20 +667,44 @@ typedef struct mpMotionRuntimeSingleton {    // persistent runtime variables
     uint32_t segment_count;             // count of running segments
     float segment_velocity;             // computed velocity for aline segment
     float segment_time;                 // actual time increment per aline segment
+    float segment_accel;                // acceleration from the previous segment to this one
+    float last_velocity;                // velocity of the previous segment
+    float segment_stretch;              // segment time factor while exec runs late, 1 if it isn't {_sgs:}
+    float knob_factor;                  // feed override knob factor the segments run at, 1 with no knob
+    float knob_rate;                    // ...its rate of change (per minute)
+    float knob_target;                  // ...and the factor it is ramping to
+    uint32_t underruns_seen;            // st_pre.underruns as the stretch was last updated
+    bool shaper_settling;               // running the segments that bring the input shaper to rest
+
+    bool hold_stop;                     // a feedhold is stopping the runtime - see _exec_aline_hold()
+    float hold_velocity;                // velocity of the stop's last segment
+    float hold_accel;                   // acceleration of the stop's last segment
 
     float forward_diff_1;               // forward difference level 1
     float forward_diff_2;               // forward difference level 2
     float forward_diff_3;               // forward difference level 3
     float forward_diff_4;               // forward difference level 4
     float forward_diff_5;               // forward difference level 5
+#if (MOTION_PROFILE_ORDER == 3)
+    uint32_t scurve_peak;               // segment_count at the first step over the S-curve's midpoint
+    float scurve_peak_diff[2];          // the differences of the two steps over it
+#endif
+
+#if (FORWARD_DIFFS_FIXED_POINT == 1)
+    int64_t fixed_velocity;             // segment velocity (Q32.32)
+    int64_t fixed_diff[5];              // forward differences 1-5, each with its own binary point
+    uint8_t fixed_shift[5];             // shift to align each difference to the level above it
+#endif
 
     GCodeState_t gm;                    // gcode model state currently executing
+    mpJogRuntime_t jog;                 // velocity jog - runs when there is no block
 
     magic_t magic_end;
 } mpMotionRuntimeSingleton_t;
 
 // Reference global scope structures
 extern mpBufferPool_t mb;               // buffer pool management
+extern mpBufferColdPool_t mbc;          // buffer cold sides and shared Gcode state
 extern mpMotionPlannerSingleton_t mp;   // context for block planning
 extern mpMotionRuntimeSingleton_t mr;   // context for block runtime
 
@@ -532,11 +725,12 @@ void mp_set_planner_position(uint8_t axis, const float position);
 void mp_set_runtime_position(uint8_t axis, const float position);
 void mp_set_steps_to_runtime_position(void);
 
-void mp_queue_command(void(*cm_exec_t)(float[], bool[]), float *value, bool *flag);
+void mp_queue_command(void(*cm_exec_t)(float[], bool[]), float *value, bool *flag, const bool nonstop = false);
 stat_t mp_runtime_command(mpBuf_t *bf);
 
 stat_t mp_json_command(char *json_string);
 stat_t mp_json_wait(char *json_string);
+stat_t mp_temperature_wait(const uint8_t heater);
 stat_t mp_json_command_immediate(char *json_string);
 
 stat_t mp_dwell(const float seconds);
@@ -554,9 +748,15 @@ stat_t mp_planner_callback();
 void mp_replan_queue(mpBuf_t *bf);
 void mp_start_feed_override(const float ramp_time, const float override);
 void mp_end_feed_override(const float ramp_time);
+void mp_replan_constraints(void);
 void mp_start_traverse_override(const float ramp_time, const float override);
 void mp_end_traverse_override(const float ramp_time);
 void mp_planner_time_accounting(void);
+float mp_get_queue_time(void);
+void mp_record_starvation(void);
+stat_t mp_starvation_callback(void);
+void mp_job_start(void);
+void mp_job_end(void);
 
 // planner buffer primitives
 void mp_init_buffers(void);
@@ -565,12 +765,29 @@ void mp_init_buffers(void);
 //mpBuf_t * mp_get_next_buffer(const mpBuf_t *bf);      // Use the following macro instead
 #define mp_get_prev_buffer(b) ((mpBuf_t *)(b->pv))
 #define mp_get_next_buffer(b) ((mpBuf_t *)(b->nx))
+#define mp_get_block_gm(b) (&mbc.gm[(b)->cold->gm_index])   // Gcode state of a block. Use cold->target for its target
 
 mpBuf_t * mp_get_write_buffer(void);
 void mp_commit_write_buffer(const blockType block_type);
 mpBuf_t * mp_get_run_buffer(void);
 bool mp_free_run_buffer(void);
 
+// buffer state hand-off - see "Buffer ownership" in planner.cpp
+inline void mp_set_buffer_state(mpBuf_t *bf, const bufferState state)  // release: the block before its state
+{
+    std::atomic_signal_fence(std::memory_order_release);
+    ((volatile mpBuf_t *)bf)->buffer_state = state;
+}
+inline bufferState mp_get_buffer_state(const mpBuf_t *bf)             // acquire: the state before the block
+{
+    bufferState state = ((volatile const mpBuf_t *)bf)->buffer_state;
+    std::atomic_signal_fence(std::memory_order_acquire);
+    return (state);
+}
+
+stat_t mp_share_gm(mpBuf_t *bf, const GCodeState_t *gm_in);
+uint8_t mp_get_gm_available(void);
+
 // plan_line.c functions
 void mp_zero_segment_velocity(void);                    // getters and setters...
 float mp_get_runtime_velocity(void);
@@ -580,12 +797,35 @@ void mp_set_runtime_work_offset(float offset[]);
 bool mp_get_runtime_busy(void);
 bool mp_runtime_is_idle(void);
 
+typedef struct mpJerk {             // jerk terms shared by all segments of an arc (see plan_arc.cpp)
+    float jerk;
+    float jerk_sq;
+    float recip_jerk;
+    float sqrt_j;
+    float q_recip_2_sqrt_j;
+} mpJerk_t;
+
 stat_t mp_aline(GCodeState_t *gm_in);                   // line planning...
+stat_t mp_aline_arc(GCodeState_t *gm_in, const float unit[], const float length, const mpJerk_t *jerk);
+stat_t mp_aline_planned(GCodeState_t *gm_in, const float cruise_velocity, const float exit_velocity, const uint8_t horizon);
+stat_t mp_sync_line(GCodeState_t *gm_in, const float pitch, const bool tap);
+void mp_end_preplanned(void);
+bool mp_preplan_is_starving(void);
+void mp_calculate_arc_jerk(mpJerk_t *jerk, const float unit_bound[]);
+void mp_calculate_line_limits(mpBuf_t *bf, const GCodeState_t *gm, const float axis_length[]);
+#if (PLANNER_ARC_BLOCKS == 1)
+stat_t mp_arc(GCodeState_t *gm_in, const mpArc_t *arc, const float length);
+void mp_get_arc_unit(const mpArc_t *arc, const float fraction, float unit[]);
+stat_t mp_spline(GCodeState_t *gm_in, const mpSpline_t *spline);
+#endif
 void mp_plan_block_list(void);
+mpBuf_t* mp_plan_override(mpBuf_t* bf, uint8_t blocks);
+mpBuf_t* mp_plan_constraints(mpBuf_t* bf, uint8_t blocks);
 void mp_plan_block_forward(mpBuf_t *bf);
 
 // plan_zoid.c functions
 void mp_calculate_ramps(mpBlockRuntimeBuf_t *block, mpBuf_t *bf, const float entry_velocity);
+float mp_estimate_block_time(const mpBuf_t *bf, const float entry_velocity);
 float mp_get_target_length(const float v_0, const float v_1, const mpBuf_t *bf);
 float mp_get_target_velocity(const float v_0, const float L, const mpBuf_t *bf); // acceleration ONLY
 float mp_get_decel_velocity(const float v_0, const float L, const mpBuf_t *bf);  // deceleration ONLY
@@ -601,6 +841,11 @@ stat_t mp_forward_plan(void);
 stat_t mp_exec_move(void);
 stat_t mp_exec_aline(mpBuf_t *bf);
 void mp_exit_hold_state(void);
+void mp_jog_start(const float velocity[]);
+void mp_jog_velocity(const float velocity[]);
+void mp_jog_stop(void);
+bool mp_jog_is_active(void);
+void mp_reset_extruder_advance(void);                   // Marlin mode pressure advance
 
 void mp_dump_planner(mpBuf_t *bf_start);
 
@@ -0,0 +1,191 @@
+/*
+ * profile.cpp - cycle counter profiling of the stepper interrupt chain and main loop
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "g2core.h"
+#include "config.h"
+#include "profile.h"
+#include "hardware.h"
+#include "planner.h"            // MIN_SEGMENT_MS
+#include "canonical_machine.h"  // needed for cm_panic() in assertions
+
+#ifdef __PROFILE
+
+/**** Allocate Structures ****/
+
+profSingleton_t prof;
+
+/************************************************************************************
+ **** CODE **************************************************************************
+ ************************************************************************************/
+
+/*
+ * profile_init() - initialize profiling
+ * profile_reset() - clear all statistics, leaving enable alone
+ */
+
+void profile_init()
+{
+    memset(&prof, 0, sizeof(prof));
+    prof.magic_start = MAGICNUM;
+    prof.magic_end = MAGICNUM;
+    prof.hot_paths = FAST_HOT_PATHS | (FAST_HOT_DATA << 1);
+    profile_reset();                    // the cycle counter is the timebase's - see timebase_init()
+}
+
+void profile_reset()
+{
+    uint32_t segment_budget = (uint32_t)((float)SystemCoreClock * MIN_SEGMENT_MS / 1000);
+
+    for (uint8_t i=0; i<PROF_SITES; i++) {
+        memset(&prof.site[i], 0, sizeof(profSiteStats_t));
+        prof.site[i].min = 0xFFFFFFFF;
+        prof.site[i].budget = segment_budget;
+    }
+    prof.site[PROF_DDA].budget = SystemCoreClock / FREQUENCY_DDA;
+    prof.site[PROF_HSM].budget = (uint32_t)((uint64_t)SystemCoreClock * PROF_HSM_BUDGET_US / 1000000);
+    memset(prof.task, 0, sizeof(prof.task));
+}
+
+/*
+ * profile_test_assertions() - test assertions, return error code if violation exists
+ */
+
+stat_t profile_test_assertions()
+{
+    if ((BAD_MAGIC(prof.magic_start)) || (BAD_MAGIC(prof.magic_end))) {
+        return (cm_panic(STAT_PROFILE_ASSERTION_FAILURE, "profile_test_assertions()"));
+    }
+    return (STAT_OK);
+}
+
+/***********************************************************************************
+ * CONFIGURATION AND INTERFACE FUNCTIONS
+ * Functions to get and set variables from the cfgArray table
+ ***********************************************************************************/
+
+/*
+ * prof_set_pfe() - enable profiling. Any set clears the statistics
+ * prof_get_pfl() - get min cycles for the site, or 0 if the site has not run
+ * prof_get_pfa() - get mean cycles for the site
+ * prof_get_pfu() - get max cycles as a percentage of the site's budget
+ *
+ *  The table target for the getters is the site's profSiteStats_t struct
+ */
+
+stat_t prof_set_pfe(nvObj_t *nv)
+{
+    ritorno(set_01(nv));
+    prof.enable = 0;                    // stop collection while clearing
+    profile_reset();
+    prof.enable = (uint8_t)nv->value;
+    return (STAT_OK);
+}
+
+stat_t prof_get_pfl(nvObj_t *nv)
+{
+    profSiteStats_t *s = (profSiteStats_t *)GET_TABLE_WORD(target);
+    nv->value = (s->count == 0) ? 0 : s->min;
+    nv->valuetype = TYPE_INT;
+    return (STAT_OK);
+}
+
+stat_t prof_get_pfa(nvObj_t *nv)
+{
+    profSiteStats_t *s = (profSiteStats_t *)GET_TABLE_WORD(target);
+    nv->value = (s->count == 0) ? 0 : (float)s->total / s->count;
+    nv->precision = (int8_t)GET_TABLE_WORD(precision);
+    nv->valuetype = TYPE_FLOAT;
+    return (STAT_OK);
+}
+
+stat_t prof_get_pfu(nvObj_t *nv)
+{
+    profSiteStats_t *s = (profSiteStats_t *)GET_TABLE_WORD(target);
+    nv->value = (float)s->max * 100 / s->budget;
+    nv->precision = (int8_t)GET_TABLE_WORD(precision);
+    nv->valuetype = TYPE_FLOAT;
+    return (STAT_OK);
+}
+
+/*
+ * prof_set_hss() - select the controller task for the {hsm:} group, by table order
+ * prof_get_hsn() - get the selected task's call count
+ * prof_get_hsh() - get the selected task's max cycles in one call
+ * prof_get_hsa() - get the selected task's mean cycles
+ * prof_get_hsw() - get the number of the task with the most cycles in one call
+ */
+
+stat_t prof_set_hss(nvObj_t *nv)
+{
+    if (nv->value < 0) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    if (nv->value >= PROF_TASKS) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_EXCEEDS_MAX_VALUE);
+    }
+    return (set_ui8(nv));
+}
+
+stat_t prof_get_hsn(nvObj_t *nv)
+{
+    nv->value = prof.task[prof.task_select].count;
+    nv->valuetype = TYPE_INT;
+    return (STAT_OK);
+}
+
+stat_t prof_get_hsh(nvObj_t *nv)
+{
+    nv->value = prof.task[prof.task_select].max;
+    nv->valuetype = TYPE_INT;
+    return (STAT_OK);
+}
+
+stat_t prof_get_hsa(nvObj_t *nv)
+{
+    profTaskStats_t *t = &prof.task[prof.task_select];
+    nv->value = (t->count == 0) ? 0 : (float)t->total / t->count;
+    nv->precision = (int8_t)GET_TABLE_WORD(precision);
+    nv->valuetype = TYPE_FLOAT;
+    return (STAT_OK);
+}
+
+stat_t prof_get_hsw(nvObj_t *nv)
+{
+    uint8_t worst = 0;
+    for (uint8_t i=1; i<PROF_TASKS; i++) {
+        if (prof.task[i].max > prof.task[worst].max) {
+            worst = i;
+        }
+    }
+    nv->value = worst;
+    nv->valuetype = TYPE_INT;
+    return (STAT_OK);
+}
+
+#endif  // __PROFILE
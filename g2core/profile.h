@@ -0,0 +1,183 @@
+/*
+ * profile.h - cycle counter profiling of the stepper interrupt chain and main loop
+ * This file is part of g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ * PROFILING
+ *
+ *  This module measures the time spent in the stepper interrupt chain using the DWT
+ *  cycle counter found on the Cortex-M3 and M7 parts. It exists to answer one question:
+ *  how close is a given board to overrunning its interrupt budgets? The sites measured are:
+ *
+ *    PROF_DDA   dda_timer_type::interrupt()  - budget is one DDA tick (1/FREQUENCY_DDA)
+ *    PROF_EXEC  exec_timer_type::interrupt() - budget is one segment (MIN_SEGMENT_MS, the shortest)
+ *    PROF_LOAD  _load_move()                 - budget is one segment
+ *    PROF_PREP  st_prep_line()               - budget is one segment
+ *    PROF_HSM   one pass of the controller loop - budget is PROF_HSM_BUDGET_US
+ *
+ *  The sites nest: the DDA interrupt calls _load_move() at the end of a segment, and the
+ *  exec interrupt calls st_prep_line() via mp_exec_move(). Times are elapsed cycles, so
+ *  they include any higher priority interrupt that preempted the site. That is the number
+ *  that matters for the budget.
+ *
+ *  Each site keeps count, min, max and total cycles and an 8 bin histogram where each bin
+ *  is 1/8 of the site's budget. The last bin also collects overruns; see the max-as-percent
+ *  value ("u" token) to tell them apart.
+ *
+ *  Profiling is off at startup. {profe:1} clears the statistics and starts collection,
+ *  {profe:0} stops it. {prof:n} returns the summary and {pfhd:n}, {pfhx:n}, {pfhl:n} and
+ *  {pfhp:n} return the histograms for the DDA, exec, load and prep sites. {profo:n} reports
+ *  the build - 1 for FAST_HOT_PATHS, plus 2 for FAST_HOT_DATA - so results can be told apart.
+ *
+ *  The controller loop also times each task in its table - count, max and total cycles,
+ *  kept by task number (table order). These answer the other question: when the machine
+ *  hesitates, which task was holding the loop? {profm*} and {pfhm:n} are the summary and
+ *  histogram for the whole pass. {hsms:k} selects task k, {hsm:n} then reports it, and
+ *  {hsmw:n} names the task with the longest single call.
+ *
+ *  Statistics for a site that is entered from more than one interrupt level (_load_move())
+ *  may occasionally be torn. This is a diagnostic, not an accounting system.
+ */
+#ifndef PROFILE_H_ONCE
+#define PROFILE_H_ONCE
+
+#ifdef __PROFILE
+
+/**** Profiling structures ****/
+
+typedef enum {
+    PROF_DDA = 0,                       // DDA timer interrupt
+    PROF_EXEC,                          // exec software interrupt
+    PROF_LOAD,                          // _load_move()
+    PROF_PREP,                          // st_prep_line()
+    PROF_HSM,                           // one pass of _controller_HSM()
+    PROF_SITES                          // count of profiled sites
+} profSite;
+
+#define PROF_BINS 8                     // histogram bins per site
+#define PROF_TASKS 32                   // controller tasks that can be timed
+
+#ifndef PROF_HSM_BUDGET_US
+#define PROF_HSM_BUDGET_US 1000         // controller pass budget - a line should not wait longer
+#endif
+
+typedef struct profSiteStats {
+    uint32_t count;                     // times the site was measured
+    uint32_t min;                       // fewest cycles seen
+    uint32_t max;                       // most cycles seen
+    uint64_t total;                     // total cycles, for the mean
+    uint32_t budget;                    // cycles available to the site
+    uint32_t bin[PROF_BINS];            // histogram in 1/PROF_BINS fractions of the budget
+} profSiteStats_t;
+
+typedef struct profTaskStats {
+    uint32_t count;                     // times the task was called
+    uint32_t max;                       // most cycles in one call
+    uint64_t total;                     // total cycles, for the mean
+} profTaskStats_t;
+
+typedef struct profSingleton {
+    magic_t magic_start;                // magic number to test memory integrity
+    uint8_t enable;                     // 1 = collect statistics
+    uint8_t task_select;                // task reported by the {hsm:} group
+    uint8_t hot_paths;                  // bit 0 = FAST_HOT_PATHS, bit 1 = FAST_HOT_DATA - see g2core.h
+    profSiteStats_t site[PROF_SITES];
+    profTaskStats_t task[PROF_TASKS];
+    magic_t magic_end;
+} profSingleton_t;
+
+extern profSingleton_t prof;
+
+/**** Function Prototypes ****/
+
+void profile_init(void);
+void profile_reset(void);
+stat_t profile_test_assertions(void);
+
+/*
+ * prof_start() - read the cycle counter at the start of a site
+ * prof_end()   - accumulate the cycles since start into the site's statistics
+ *
+ *  These are inlined into the interrupts they measure. Use the PROF_START / PROF_END
+ *  macros so the calls drop out when __PROFILE is not defined.
+ */
+
+static inline uint32_t prof_start() { return (DWT->CYCCNT); }
+
+static inline void prof_end(const profSite site, const uint32_t start)
+{
+    if (!prof.enable) {
+        return;
+    }
+    uint32_t cycles = DWT->CYCCNT - start;      // unsigned math handles counter wrap
+    profSiteStats_t *s = &prof.site[site];
+
+    s->count++;
+    s->total += cycles;
+    if (cycles < s->min) { s->min = cycles; }
+    if (cycles > s->max) { s->max = cycles; }
+
+    uint32_t bin = (cycles * PROF_BINS) / s->budget;
+    s->bin[(bin < PROF_BINS) ? bin : PROF_BINS-1]++;
+}
+
+static inline void prof_task_end(const uint8_t task, const uint32_t start)
+{
+    if (!prof.enable || (task >= PROF_TASKS)) {
+        return;
+    }
+    uint32_t cycles = DWT->CYCCNT - start;
+    profTaskStats_t *t = &prof.task[task];
+
+    t->count++;
+    t->total += cycles;
+    if (cycles > t->max) { t->max = cycles; }
+}
+
+#define PROF_START(start) uint32_t start = prof_start()
+#define PROF_END(site, start) prof_end(site, start)
+#define PROF_TASK_END(task, start) prof_task_end(task, start)
+
+/**** Profiling config and display functions ****/
+
+stat_t prof_set_pfe(nvObj_t *nv);       // enable / clear
+stat_t prof_get_pfl(nvObj_t *nv);       // min cycles
+stat_t prof_get_pfa(nvObj_t *nv);       // mean cycles
+stat_t prof_get_pfu(nvObj_t *nv);       // max cycles as percent of budget
+stat_t prof_set_hss(nvObj_t *nv);       // select the controller task to report
+stat_t prof_get_hsn(nvObj_t *nv);       // selected task call count
+stat_t prof_get_hsh(nvObj_t *nv);       // selected task max cycles
+stat_t prof_get_hsa(nvObj_t *nv);       // selected task mean cycles
+stat_t prof_get_hsw(nvObj_t *nv);       // task with the most cycles in one call
+
+#else
+
+#define PROF_START(start)
+#define PROF_END(site, start)
+#define PROF_TASK_END(task, start)
+
+#endif  // __PROFILE
+
+#endif  // End of include guard: PROFILE_H_ONCE
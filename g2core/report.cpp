@@ -30,12 +30,17 @@
 #include "report.h"
 #include "controller.h"
 #include "json_parser.h"
+#include "cbor.h"
 #include "text_parser.h"
+#include "hardware.h"
 #include "planner.h"
 #include "settings.h"
 #include "util.h"
+#include "timebase.h"
 #include "xio.h"
 
+#include <atomic>           // atomic_signal_fence() orders the line timing ring between the exec and the controller
+
 
 /**** Allocation ****/
 
@@ -56,10 +61,38 @@ qrSingleton_t qr;
 stat_t rpt_exception(stat_t status, const char *msg)
 {
     if (status != STAT_OK) { // makes it possible to call exception reports w/o checking status value
+        cs.assert_all = true;   // something went wrong - check everything, not just the next subsystem
 
         // you cannot send an exception report if the USB has not been set up. Causes a processor exception.
         if (cs.controller_state >= CONTROLLER_READY) {
             char buffer[128];
+            if (cs.comm_mode == CBOR_MODE) {
+                char *str = buffer;
+                *str++ = CBOR_MAP_START;
+                str = cbor_put_string(str, "er");
+                *str++ = CBOR_MAP_START;
+                str = cbor_put_string(str, "fb");
+                str = cbor_put_float(str, G2CORE_FIRMWARE_BUILD);
+                str = cbor_put_string(str, "st");
+                str = cbor_put_int(str, status);
+                str = cbor_put_string(str, "msg");
+
+                const char *status_msg = get_status_message(status);
+                uint16_t status_len = strlen(status_msg);
+                uint16_t msg_len = strlen(msg);
+                uint16_t room = buffer + sizeof(buffer) - str - 2 - 3 - 2;  // text head, " - ", breaks
+                if (status_len > room) { status_len = room;}
+                if (msg_len > room - status_len) { msg_len = room - status_len;}
+                str = cbor_put_head(str, CBOR_TEXT, status_len + 3 + msg_len);
+                memcpy(str, status_msg, status_len);
+                memcpy(str + status_len, " - ", 3);
+                memcpy(str + status_len + 3, msg, msg_len);
+                str += status_len + 3 + msg_len;
+                *str++ = CBOR_BREAK;
+                *str++ = CBOR_BREAK;
+                xio_write(buffer, str - buffer);
+                return (status);
+            }
             sprintf(buffer, "{\"er\":{\"fb\":%0.2f,\"st\":%d,\"msg\":\"%s - %s\"}}\n",
                                         G2CORE_FIRMWARE_BUILD, status, get_status_message(status), msg);
             xio_writeline(buffer);
@@ -76,6 +109,81 @@ stat_t rpt_er(nvObj_t *nv)
     return(rpt_exception(STAT_GENERIC_EXCEPTION_REPORT, "bogus exception report")); // bogus exception report for testing
 }
 
+/**** Gcode Error Reports **********************************************************
+ * rpt_queue_gcode_error()    - queue the error of a Gcode block for reporting
+ * rpt_gcode_error_callback() - send one queued error report if the TX path has room
+ *
+ *  Reports look like {"er":{"st":105,"ln":1200,"msg":"Gcode command unsupported"}}.
+ *  "ln" is the N word of the block, or 0 if it had none. If the ring filled up, the
+ *  next report carries "dr":the number of errors dropped.
+ */
+
+typedef struct rptGcodeError {
+    stat_t status;
+    uint32_t linenum;
+} rptGcodeError_t;
+
+typedef struct rptGcodeErrorRing {
+    uint8_t head;                           // next entry written
+    uint8_t tail;                           // next entry reported
+    uint16_t dropped;                       // errors lost to a full ring since the last report
+    rptGcodeError_t entry[GCODE_ERROR_RING_SIZE];
+} rptGcodeErrorRing_t;
+
+static rptGcodeErrorRing_t er;
+
+void rpt_queue_gcode_error(stat_t status, const char *block)
+{
+    if ((uint8_t)(er.head - er.tail) == GCODE_ERROR_RING_SIZE) {
+        er.dropped++;
+        return;
+    }
+    rptGcodeError_t *e = &er.entry[er.head & (GCODE_ERROR_RING_SIZE-1)];
+    e->status = status;
+    e->linenum = ((*block == 'N') || (*block == 'n')) ? strtoul(block+1, NULL, 10) : 0;
+    er.head++;
+}
+
+stat_t rpt_gcode_error_callback()
+{
+    if ((er.head == er.tail) || xio_tx_is_backed_up()) {
+        return (STAT_OK);
+    }
+    rptGcodeError_t *e = &er.entry[er.tail & (GCODE_ERROR_RING_SIZE-1)];
+    char buffer[128];
+    char *str = buffer;
+
+    if (cs.comm_mode == CBOR_MODE) {
+        *str++ = CBOR_MAP_START;
+        str = cbor_put_string(str, "er");
+        *str++ = CBOR_MAP_START;
+        str = cbor_put_string(str, "st");
+        str = cbor_put_int(str, e->status);
+        str = cbor_put_string(str, "ln");
+        str = cbor_put_int(str, e->linenum);
+        str = cbor_put_string(str, "msg");
+        str = cbor_put_string(str, get_status_message(e->status));
+        if (er.dropped) {
+            str = cbor_put_string(str, "dr");
+            str = cbor_put_int(str, er.dropped);
+        }
+        *str++ = CBOR_BREAK;
+        *str++ = CBOR_BREAK;
+        xio_write(buffer, str - buffer);
+    } else {
+        str += sprintf(str, "{\"er\":{\"st\":%d,\"ln\":%lu,\"msg\":\"%s\"",
+                       e->status, (unsigned long)e->linenum, get_status_message(e->status));
+        if (er.dropped) {
+            str += sprintf(str, ",\"dr\":%u", er.dropped);
+        }
+        strcpy(str, "}}\n");
+        xio_writeline(buffer);
+    }
+    er.dropped = 0;
+    er.tail++;
+    return (STAT_OK);
+}
+
 /**** Application Messages *********************************************************
  * rpt_print_initializing_message()       - initializing configs from hard-coded profile
  * rpt_print_loading_configs_message() - loading configs from EEPROM
@@ -166,6 +274,9 @@ void rpt_print_system_ready_message(void)
  */
 static stat_t _populate_unfiltered_status_report(void);
 static uint8_t _populate_filtered_status_report(void);
+static float _sr_filter_threshold(const nvObj_t *nv);
+static uint8_t _sr_dirty_mask(srSlot_t *slot, index_t index);
+static stat_t _run_json_status_report(bool filtered);
 
 uint8_t _is_stat(nvObj_t *nv)
 {
@@ -205,6 +316,7 @@ void sr_init_status_report()
     }
     // record the index of the "stat" variable so we can use it during reporting
     sr.index_of_stat_variable = nv_get_index((const char *)"", (const char *)"stat");
+    sr.pending = ~(uint64_t)0;                                  // read everything for the first report
 }
 
 /*
@@ -240,6 +352,7 @@ stat_t sr_set_status_report(nvObj_t *nv)
         return (STAT_INPUT_LESS_THAN_MIN_VALUE);
     }
     memcpy(sr.status_report_list, status_report_list, sizeof(status_report_list));
+    sr.pending = ~(uint64_t)0;                              // new elements - read them all next time
     return(_populate_unfiltered_status_report());            // return current values
 }
 
@@ -258,6 +371,27 @@ stat_t sr_set_status_report(nvObj_t *nv)
  *  See cmStatusReportRequest enum in report.h for details.
  */
 
+/*
+ * _sr_timed_interval() - interval to the next timed status report
+ *
+ *  Normally the {si:} interval. In adaptive mode {sad:1} a report requested while the
+ *  runtime is cruising waits for the rest of the cruise, up to STATUS_REPORT_ADAPTIVE_MAX_MS.
+ *  Nothing much changes there that a host can't interpolate. Heads, tails and short moves
+ *  keep the {si:} rate, and state changes are reported immediately in any case.
+ */
+
+static uint32_t _sr_timed_interval()
+{
+    if (!sr.status_report_adaptive || (mr.section != SECTION_BODY)) {
+        return (sr.status_report_interval);
+    }
+    uint32_t cruise_ms = (uint32_t)(mr.segment_count * mr.segment_time * 60000);
+    if (cruise_ms > STATUS_REPORT_ADAPTIVE_MAX_MS) {
+        cruise_ms = STATUS_REPORT_ADAPTIVE_MAX_MS;
+    }
+    return (max(cruise_ms, sr.status_report_interval));
+}
+
 stat_t sr_request_status_report(cmStatusReportRequest request_type)
 {
     if (sr.status_report_request != SR_OFF) {       // ignore multiple requests. First one wins.
@@ -273,15 +407,29 @@ stat_t sr_request_status_report(cmStatusReportRequest request_type)
 
     } else if (request_type == SR_REQUEST_TIMED) {
         sr.status_report_request = sr.status_report_verbosity;
-        sr.status_report_systick += sr.status_report_interval;
+        sr.status_report_systick += _sr_timed_interval();
 
     } else {
         sr.status_report_request = SR_VERBOSE;
-        sr.status_report_systick += sr.status_report_interval;
+        sr.status_report_systick += _sr_timed_interval();
     }
     return (STAT_OK);
 }
 
+/*
+ * sr_mark_dirty() - note that the values behind the srDirty flags may have changed
+ *
+ *  Called from the exec interrupt as well as the main loop, so the OR is done with the
+ *  interrupts off. It's a few instructions - mp_exec_move() calls it for every segment.
+ */
+
+void sr_mark_dirty(uint8_t flags)
+{
+    __disable_irq();
+    sr.dirty |= flags;
+    __enable_irq();
+}
+
 /*
  * sr_status_report_callback() - main loop callback to send a report if one is ready
  */
@@ -303,6 +451,10 @@ stat_t sr_status_report_callback()         // called by controller dispatcher
     }
 
     sr.status_report_request = SR_OFF;
+    if (((js.json_mode == JSON_MODE) || (js.json_mode == MARLIN_COMM_MODE)) && (cs.comm_mode != CBOR_MODE)) {
+        _run_json_status_report(sr.status_report_verbosity != SR_VERBOSE);
+        return (STAT_OK);
+    }
     if ((sr.status_report_request == SR_VERBOSE) ||
         (sr.status_report_verbosity == SR_VERBOSE)) {
         _populate_unfiltered_status_report();
@@ -387,8 +539,8 @@ static uint8_t _populate_filtered_status_report()
         }
         nv_get_nvObj(nv);
 
-        // report values that have changed by more than 0.0001, but always stops and ends
-        if ((fabs(nv->value - sr.status_report_value[i]) > EPSILON3) ||
+        // report values that have changed by more than the threshold, but always stops and ends
+        if ((fabs(nv->value - sr.status_report_value[i]) > _sr_filter_threshold(nv)) ||
             ((nv->index == sr.stat_index) && fp_EQ(nv->value, COMBINED_PROGRAM_STOP)) ||
             ((nv->index == sr.stat_index) && fp_EQ(nv->value, COMBINED_PROGRAM_END))) {
 
@@ -407,6 +559,198 @@ static uint8_t _populate_filtered_status_report()
 }
 
 
+/*
+ * _sr_filter_threshold() - change a filtered report ignores for this element
+ *
+ *  Values must move by more than 0.0001 to be reported. While the machine is moving,
+ *  positions (pos and mpo) must also move by more than the {sres:} resolution. The
+ *  report that follows the stop is filtered to 0.0001 again, so it carries the exact
+ *  final position.
+ */
+
+static float _sr_filter_threshold(const nvObj_t *nv)
+{
+    if ((sr.status_report_resolution > EPSILON3) &&
+        (cm_get_motion_state() != MOTION_STOP) &&
+        ((strcmp(nv->group, "pos") == 0) || (strcmp(nv->group, "mpo") == 0))) {
+        return (sr.status_report_resolution);
+    }
+    return (EPSILON3);
+}
+
+/*
+ * _sr_dirty_mask() - srDirty flags that can change an SR element, cached in its slot
+ *
+ *  Found from the element's getter, so the cfgArray tokens and groups don't matter. The
+ *  line, position and the gcode model elements read the runtime while it's moving and the
+ *  model when it's not, so they carry both flags. Anything not listed is read every report.
+ */
+
+static uint8_t _sr_dirty_mask(srSlot_t *slot, index_t index)
+{
+    if (slot->mask_index == index) {
+        return (slot->mask);
+    }
+    fptrCmd get = cfgArray[index].get;
+    uint8_t mask = SR_DIRTY_ALWAYS;
+
+    if ((get == cm_get_vel) || (get == cm_get_mpo)) {
+        mask = SR_DIRTY_RUNTIME;
+    } else if ((get == cm_get_line) || (get == cm_get_pos) || (get == cm_get_ofs) ||
+               (get == cm_get_feed) || (get == cm_get_unit) || (get == cm_get_coor) ||
+               (get == cm_get_momo) || (get == cm_get_plan) || (get == cm_get_path) ||
+               (get == cm_get_dist) || (get == cm_get_admo) || (get == cm_get_frmo) ||
+               (get == cm_get_toolv)) {
+        mask = SR_DIRTY_RUNTIME | SR_DIRTY_MODEL;
+    }
+    slot->mask_index = index;
+    slot->mask = mask;
+    return (mask);
+}
+
+/*
+ * _render_status_report_element() - write "token":value for an nvObj, NUL terminated
+ *
+ *  Returns the length written, or 0 if it would not fit in size (including the NUL).
+ */
+
+static uint16_t _render_status_report_element(nvObj_t *nv, char *buf, uint16_t size)
+{
+    char *str = buf;
+    uint16_t group_len = strlen(nv->group);
+    uint16_t token_len = strlen(nv->token);
+    uint16_t need = group_len + token_len + 3 + 17;     // quotes & colon, longest non-string value + NUL
+
+    if ((nv->valuetype == TYPE_STRING) || (nv->valuetype == TYPE_ARRAY)) {
+        need = group_len + token_len + 3 + strlen(*nv->stringp) + 3;
+    }
+    if (need > size) {
+        return (0);
+    }
+    *str++ = '"';                           // flatten out groups, as for the nvObj reports
+    memcpy(str, nv->group, group_len);
+    str += group_len;
+    memcpy(str, nv->token, token_len);
+    str += token_len;
+    *str++ = '"';
+    *str++ = ':';
+    str = json_serialize_value(nv, str);    // NB: converts floats to display units in place
+    *str = NUL;
+    return (str - buf);
+}
+
+/*
+ * _run_json_status_report() - send a JSON status report from the pre-rendered slots
+ *
+ *  Each SR element keeps the "token":value text it was last rendered as in sr.slot[].
+ *  A slot is only re-rendered when its value (or the units mode) has changed, and the
+ *  report is the slots strung together in cs.out_buf. This saves serializing the whole
+ *  nvObj list on every report, which is most of the cost of a 10 Hz SR. The text is
+ *  identical to what _populate_xxx_status_report() and json_print_object() would make,
+ *  and the same filtering rules apply. Strings are rendered every time, as their value
+ *  can't be compared - and one too long for a slot is copied straight into the report.
+ *
+ *  A filtered report doesn't read every element, only those in sr.pending. An element is
+ *  made pending when one of its srDirty flags was marked since the last report, and stays
+ *  pending until it has been reported, or read back unchanged. So an element that moved
+ *  by less than the {sres:} resolution is still read until the stop report has carried it.
+ *
+ *  Elements that don't fit in the output buffer are left for the next report.
+ *  Returns STAT_NOOP if a filtered report had nothing to send.
+ */
+
+static stat_t _run_json_status_report(bool filtered)
+{
+    nvObj_t *nv = nv_reset_nv_list();       // scratch nvObj for the getters
+    char *str = cs.out_buf;
+    char *str_max = cs.out_buf + sizeof(cs.out_buf) - 4;    // leave room for "}}\n" and the NUL
+    bool has_data = false;
+
+    uint8_t units_mode = cm_get_units_mode(MODEL);
+    if (units_mode != sr.slot_units_mode) { // floats are rendered in display units
+        for (uint8_t i=0; i<NV_STATUS_REPORT_LEN; i++) {
+            sr.slot[i].index = 0;
+        }
+        sr.slot_units_mode = units_mode;
+    }
+
+    __disable_irq();
+    uint8_t dirty = sr.dirty | SR_DIRTY_ALWAYS;
+    sr.dirty = 0;
+    __enable_irq();
+
+    strcpy(str, "{\"sr\":{");
+    str += 7;
+    for (uint8_t i=0; i<NV_STATUS_REPORT_LEN; i++) {
+        if ((nv->index = sr.status_report_list[i]) == 0) {  // end of list
+            break;
+        }
+        uint64_t bit = (uint64_t)1 << i;
+        if (_sr_dirty_mask(&sr.slot[i], nv->index) & dirty) {
+            sr.pending |= bit;
+        }
+        if (filtered && !(sr.pending & bit)) {
+            continue;                       // nothing has changed it
+        }
+        nv_get_nvObj(nv);
+        float value = nv->value;
+
+        // report values that have changed by more than the threshold, but always stops and ends
+        if (filtered &&
+            (fabs(value - sr.status_report_value[i]) <= _sr_filter_threshold(nv)) &&
+            !((nv->index == sr.stat_index) && fp_EQ(value, COMBINED_PROGRAM_STOP)) &&
+            !((nv->index == sr.stat_index) && fp_EQ(value, COMBINED_PROGRAM_END))) {
+            if (fabs(value - sr.status_report_value[i]) <= EPSILON3) {
+                sr.pending &= ~bit;         // unchanged - wait for the next flag
+            }
+            continue;
+        }
+
+        srSlot_t *slot = &sr.slot[i];
+        const char *text = slot->text;
+        uint16_t length = slot->length;
+
+        if ((slot->index != nv->index) || (slot->value != value) ||
+            (nv->valuetype == TYPE_STRING) || (nv->valuetype == TYPE_ARRAY)) {
+            slot->index = nv->index;
+            slot->value = value;
+            if ((slot->length = _render_status_report_element(nv, slot->text, SR_SLOT_LEN)) == 0) {
+                slot->index = 0;            // too long for a slot - render it in the report
+                text = NULL;
+            }
+            length = slot->length;
+        }
+        if (has_data) {
+            if (str >= str_max) { break;}
+            *str++ = ',';
+        }
+        if (text == NULL) {
+            if ((length = _render_status_report_element(nv, str, str_max - str)) == 0) { break;}
+        } else {
+            if (length > (str_max - str)) { break;}
+            memcpy(str, text, length);
+        }
+        str += length;
+        if (filtered) {
+            sr.status_report_value[i] = value;
+            sr.pending &= ~bit;
+        }
+        has_data = true;
+    }
+    if (filtered && !has_data) {
+        return (STAT_NOOP);                 // no new data
+    }
+    if (*(str-1) == ',') {                  // an element that didn't fit
+        str--;
+    }
+    *str++ = '}';
+    *str++ = '}';
+    *str++ = '\n';
+    *str = NUL;
+    xio_writeline(cs.out_buf);
+    return (STAT_OK);
+}
+
 /****************************
  * END OF REPORT FUNCTIONS *
  ****************************/
@@ -449,12 +793,20 @@ stat_t sr_set_si(nvObj_t *nv)
  *********************/
 #ifdef __TEXT_MODE
 
+static const char msg_units0[] = " in";    // used by the units print functions
+static const char msg_units1[] = " mm";
+static const char *const msg_units[] = { msg_units0, msg_units1 };
+
 static const char fmt_si[] = "[si]  status interval%14d ms\n";
 static const char fmt_sv[] = "[sv]  status report verbosity%6d [0=off,1=filtered,2=verbose]\n";
+static const char fmt_sad[] = "[sad] status report adaptive%7d [0=off,1=on]\n";
+static const char fmt_sres[] = "[sres] status report resolution%12.3f%s\n";
 
 void sr_print_sr(nvObj_t *nv) { _populate_unfiltered_status_report();}
 void sr_print_si(nvObj_t *nv) { text_print(nv, fmt_si);}
 void sr_print_sv(nvObj_t *nv) { text_print(nv, fmt_sv);}
+void sr_print_sad(nvObj_t *nv) { text_print(nv, fmt_sad);}
+void sr_print_sres(nvObj_t *nv) { text_print_flt_units(nv, fmt_sres, GET_UNITS(ACTIVE_MODEL));}
 
 #endif // __TEXT_MODE
 
@@ -476,6 +828,19 @@ void sr_print_sv(nvObj_t *nv) { text_print(nv, fmt_sv);}
  *
  *   2. Add qr, qi and qo (or some combination) to the status report. This will
  *      return queue report data when status reports are generated.
+ *
+ *  Line timing: {qtb:N} and {qte:M} time the blocks of Gcode lines N to M as they run, and
+ *  the queue reports carry the times, one line per report, as
+ *
+ *    "qb":[line,start,actual,planned]
+ *
+ *    start     timebase time the line's first block started, low 32 bits of us (timebase.h)
+ *    actual    us from then until its last block was retired
+ *    planned   us its blocks were planned to take (bf->block_time)
+ *
+ *  So a host or CAM engineer can see where a program runs slower than planned - holds,
+ *  overrides and starvation - and where the plan itself is slow. The blocks of an arc or a
+ *  spline share their line number and are timed together. {qtb:0} turns timing off.
  */
 /*
  * qr_init_queue_report() - initialize or clear queue report values
@@ -523,35 +888,167 @@ void qr_request_queue_report(int8_t buffers)
     }
 }
 
+/*
+ * qr_block_start() - start or carry on timing a line as one of its blocks starts to run
+ * qr_block_end()   - finish timing the line when its last block is retired
+ *
+ *  Called from the exec - mp_exec_aline() and mp_free_run_buffer(). A line is done when
+ *  the buffer after the one retired isn't a move of the same line that is ready to run.
+ *  The finished times go into a single producer / single consumer ring, and a line is
+ *  dropped if the ring is full.
+ */
+
+void qr_block_start(const mpBuf_t *bf)
+{
+    uint32_t linenum = bf->cold->linenum;
+
+    if ((qr.time_first == 0) || (linenum < qr.time_first) || (linenum > qr.time_last)) {
+        return;
+    }
+    if (!qr.timing) {
+        qr.timing = true;
+        qr.time_open.linenum = linenum;
+        qr.time_open.start = (uint32_t)tb_get_usec();
+        qr.time_open.planned = 0;
+    }
+    qr.time_open.planned += (uint32_t)(bf->block_time * 60000000);
+}
+
+void qr_block_end(const mpBuf_t *bf)
+{
+    if (!qr.timing) {
+        return;
+    }
+    const mpBuf_t *nx = bf->nx;
+    if ((nx->block_type == BLOCK_TYPE_ALINE) && (mp_get_buffer_state(nx) >= MP_BUFFER_PREPPED) &&
+        (nx->cold->linenum == qr.time_open.linenum)) {
+        return;                                 // the line carries on in the next block
+    }
+    qr.timing = false;
+    qr.time_open.actual = (uint32_t)tb_get_usec() - qr.time_open.start;
+
+    uint8_t head = qr.time_head;
+    if ((uint8_t)(head - qr.time_tail) == QR_BLOCK_TIMES) {
+        return;
+    }
+    qr.times[head & (QR_BLOCK_TIMES-1)] = qr.time_open;
+    std::atomic_signal_fence(std::memory_order_release);   // record contents before the head
+    qr.time_head = head + 1;
+}
+
+/*
+ * _qr_ms() - minutes of planner time as whole milliseconds for a queue report
+ */
+
+static uint16_t _qr_ms(const float minutes)
+{
+    float ms = minutes * 60000;
+    return ((ms < 0) ? 0 : (ms > 65535) ? 65535 : (uint16_t)ms);
+}
+
 /*
  * qr_queue_report_callback() - generate a queue report if one has been requested
+ *
+ *  QR_TIMED reports add the time queued as well as the buffers. The time is what a
+ *  streamer should watch to keep ahead of the runtime - a few short blocks can be a
+ *  lot of buffers and very little time:
+ *
+ *    qt    ms of motion queued - the running block's remainder and the blocks behind it
+ *    qp    ms of motion behind the running block that is not yet planned to its final
+ *          velocity (mp.plannable_time)
  */
 
 stat_t qr_queue_report_callback()         // called by controller dispatcher
 {
+    bool timed_line = (qr.time_head != qr.time_tail);
+
     if ((qr.queue_report_verbosity == QR_OFF) ||
         (js.json_verbosity == JV_SILENT) ||
-        (qr.queue_report_requested == false) ||
+        ((qr.queue_report_requested == false) && !timed_line) ||
         (!mp_is_phat_city_time())) {
         return (STAT_NOOP);
     }
 
     qr.queue_report_requested = false;
 
-    char report[32];    // we know these reports can't be longer than 30 bytes
+    char report[128];   // we know these reports can't be longer than 120 bytes
+    char *str = report;
+    qrBlockTime_t t;
+
+    if (timed_line) {
+        std::atomic_signal_fence(std::memory_order_acquire);    // head before the record contents
+        t = qr.times[qr.time_tail & (QR_BLOCK_TIMES-1)];
+        qr.time_tail++;
+    }
+    uint16_t queued_ms = 0;
+    uint16_t plannable_ms = 0;
+
+    if (qr.queue_report_verbosity == QR_TIMED) {
+        queued_ms = _qr_ms(mp_get_queue_time() / 60);
+        plannable_ms = _qr_ms(mp.plannable_time);
+    }
 
     if (cs.comm_mode == TEXT_MODE) {
-        if (qr.queue_report_verbosity == QR_SINGLE) {
-            sprintf(report, "qr:%d\n", qr.buffers_available);
-        } else  {
-            sprintf(report, "qr:%d, qi:%d, qo:%d\n", qr.buffers_available,qr.buffers_added,qr.buffers_removed);
+        str += sprintf(str, "qr:%d", qr.buffers_available);
+        if (qr.queue_report_verbosity != QR_SINGLE) {
+            str += sprintf(str, ", qi:%d, qo:%d", qr.buffers_added,qr.buffers_removed);
+        }
+        if (qr.queue_report_verbosity == QR_TIMED) {
+            str += sprintf(str, ", qt:%d, qp:%d", queued_ms, plannable_ms);
+        }
+        if (timed_line) {
+            str += sprintf(str, ", qb:[%lu,%lu,%lu,%lu]", (unsigned long)t.linenum,
+                           (unsigned long)t.start, (unsigned long)t.actual, (unsigned long)t.planned);
+        }
+        strcpy(str, "\n");
+    } else if (cs.comm_mode == CBOR_MODE) {
+        *str++ = CBOR_MAP_START;
+        str = cbor_put_string(str, "qr");
+        str = cbor_put_int(str, qr.buffers_available);
+        if (qr.queue_report_verbosity != QR_SINGLE) {
+            str = cbor_put_string(str, "qi");
+            str = cbor_put_int(str, qr.buffers_added);
+            str = cbor_put_string(str, "qo");
+            str = cbor_put_int(str, qr.buffers_removed);
+        }
+        if (qr.queue_report_verbosity == QR_TIMED) {
+            str = cbor_put_string(str, "qt");
+            str = cbor_put_int(str, queued_ms);
+            str = cbor_put_string(str, "qp");
+            str = cbor_put_int(str, plannable_ms);
+        }
+        if (timed_line) {
+            str = cbor_put_string(str, "qb");
+            str = cbor_put_head(str, CBOR_ARRAY, 4);
+            str = cbor_put_head(str, CBOR_UINT, t.linenum);
+            str = cbor_put_head(str, CBOR_UINT, t.start);
+            str = cbor_put_head(str, CBOR_UINT, t.actual);
+            str = cbor_put_head(str, CBOR_UINT, t.planned);
         }
+        if (js.json_footer_style == JF_WINDOW_REPORT) {
+            str = cbor_put_string(str, "rx");
+            str = cbor_put_int(str, xio_get_rx_bytes_free());
+        }
+        *str++ = CBOR_BREAK;
+        xio_write(report, str - report);
+        qr_init_queue_report();
+        return (STAT_OK);
     } else {
-        if (qr.queue_report_verbosity == QR_SINGLE) {
-            sprintf(report, "{\"qr\":%d}\n", qr.buffers_available);
-        } else {
-            sprintf(report, "{\"qr\":%d,\"qi\":%d,\"qo\":%d}\n", qr.buffers_available, qr.buffers_added,qr.buffers_removed);
+        str += sprintf(str, "{\"qr\":%d", qr.buffers_available);
+        if (qr.queue_report_verbosity != QR_SINGLE) {
+            str += sprintf(str, ",\"qi\":%d,\"qo\":%d", qr.buffers_added,qr.buffers_removed);
+        }
+        if (qr.queue_report_verbosity == QR_TIMED) {
+            str += sprintf(str, ",\"qt\":%d,\"qp\":%d", queued_ms, plannable_ms);
+        }
+        if (timed_line) {
+            str += sprintf(str, ",\"qb\":[%lu,%lu,%lu,%lu]", (unsigned long)t.linenum,
+                           (unsigned long)t.start, (unsigned long)t.actual, (unsigned long)t.planned);
+        }
+        if (js.json_footer_style == JF_WINDOW_REPORT) {  // window reports also carry the RX credit
+            str += sprintf(str, ",\"rx\":%d", xio_get_rx_bytes_free());
         }
+        strcpy(str, "}\n");
     }
     xio_writeline(report);
     qr_init_queue_report();
@@ -580,6 +1077,8 @@ stat_t qr_queue_report_callback()         // called by controller dispatcher
  * qr_get() - run a queue report (as data)
  * qi_get() - run a queue report - buffers in
  * qo_get() - run a queue report - buffers out
+ * qt_get() - run a queue report - ms of motion queued
+ * qp_get() - run a queue report - ms of motion not yet fully planned
  */
 stat_t qr_get(nvObj_t *nv)
 {
@@ -604,6 +1103,20 @@ stat_t qo_get(nvObj_t *nv)
     return (STAT_OK);
 }
 
+stat_t qt_get(nvObj_t *nv)
+{
+    nv->value = (float)_qr_ms(mp_get_queue_time() / 60);
+    nv->valuetype = TYPE_INT;
+    return (STAT_OK);
+}
+
+stat_t qp_get(nvObj_t *nv)
+{
+    nv->value = (float)_qr_ms(mp.plannable_time);
+    nv->valuetype = TYPE_INT;
+    return (STAT_OK);
+}
+
 /*****************************************************************************
  * JOB ID REPORTS
  *
@@ -613,6 +1126,10 @@ stat_t qo_get(nvObj_t *nv)
  *  job_get()
  *  job_set()
  *  job_print_job()
+ *  job_summary_callback() - send the performance summary of a job at M2 or M30
+ *
+ *  The summary is accumulated by the planner and exec (see mp_job_start()) and sent as
+ *  the {jsm:} group once the program end has executed. Feeds are in the current units.
  */
 
 stat_t job_populate_job_report()
@@ -666,11 +1183,45 @@ uint8_t job_report_callback()
         // no-op, job_ids are client app state
         return (STAT_OK);
     }
+    if (cs.comm_mode == CBOR_MODE) {
+        char *str = cs.out_buf;
+        *str++ = CBOR_MAP_START;
+        str = cbor_put_string(str, "job");
+        str = cbor_put_head(str, CBOR_ARRAY, 4);
+        for (uint8_t i=0; i<4; i++) {
+            str = cbor_put_head(str, CBOR_UINT, cfg.job_id[i]);
+        }
+        *str++ = CBOR_BREAK;
+        xio_write(cs.out_buf, str - cs.out_buf);
+        return (STAT_OK);
+    }
     sprintf(cs.out_buf, "{\"job\":[%lu,%lu,%lu,%lu]}\n", cfg.job_id[0], cfg.job_id[1], cfg.job_id[2], cfg.job_id[3] );
     xio_writeline(cs.out_buf);
     return (STAT_OK);
 }
 
+stat_t job_summary_callback()
+{
+    if (!mp.job.report) {
+        return (STAT_NOOP);
+    }
+    if (!sr.job_summary_report || (js.json_verbosity == JV_SILENT)) {
+        mp.job.report = false;                  // the values can still be read as {jsm:n}
+        return (STAT_NOOP);
+    }
+    if (!mp_is_phat_city_time()) {              // wait until the planner has left some time
+        return (STAT_NOOP);
+    }
+    mp.job.report = false;
+
+    nvObj_t *nv = nv_reset_nv_list();           // sets *nv to the start of the body
+    strcpy(nv->token, "jsm");
+    nv->index = nv_get_index((const char *)"", nv->token);
+    nv_get_nvObj(nv);                           // expands the group
+    nv_print_list(STAT_OK, TEXT_MULTILINE_FORMATTED, JSON_OBJECT_FORMAT);
+    return (STAT_OK);
+}
+
 stat_t job_get(nvObj_t *nv) { return (job_populate_job_report());}
 stat_t job_set(nvObj_t *nv) { return (job_set_job_report(nv));}
 void job_print_job(nvObj_t *nv) { job_populate_job_report();}
@@ -683,11 +1234,19 @@ void job_print_job(nvObj_t *nv) { job_populate_job_report();}
 static const char fmt_qr[] = "qr:%d\n";
 static const char fmt_qi[] = "qi:%d\n";
 static const char fmt_qo[] = "qo:%d\n";
-static const char fmt_qv[] = "[qv]  queue report verbosity%7d [0=off,1=single,2=triple]\n";
+static const char fmt_qt[] = "qt:%d\n";
+static const char fmt_qp[] = "qp:%d\n";
+static const char fmt_qtb[] = "[qtb] first line timed%13lu [0=off]\n";
+static const char fmt_qte[] = "[qte] last line timed%14lu\n";
+static const char fmt_qv[] = "[qv]  queue report verbosity%7d [0=off,1=single,2=triple,3=timed]\n";
 
 void qr_print_qr(nvObj_t *nv) { text_print(nv, fmt_qr);}    // TYPE_INT
 void qr_print_qi(nvObj_t *nv) { text_print(nv, fmt_qi);}    // TYPE_INT
 void qr_print_qo(nvObj_t *nv) { text_print(nv, fmt_qo);}    // TYPE_INT
+void qr_print_qt(nvObj_t *nv) { text_print(nv, fmt_qt);}    // TYPE_INT
+void qr_print_qp(nvObj_t *nv) { text_print(nv, fmt_qp);}    // TYPE_INT
 void qr_print_qv(nvObj_t *nv) { text_print(nv, fmt_qv);}    // TYPE_INT
+void qr_print_qtb(nvObj_t *nv) { text_print(nv, fmt_qtb);}  // TYPE_INT
+void qr_print_qte(nvObj_t *nv) { text_print(nv, fmt_qte);}  // TYPE_INT
 
 #endif // __TEXT_MODE
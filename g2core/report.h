@@ -36,6 +36,9 @@
 
 #define SR_THROTTLE_COUNT   4       // scale back filtered SR's during time-constrained intervals
 #define MIN_ARC_QR_INTERVAL 200     // minimum interval between QRs during arc generation (in system ticks)
+#define SR_SLOT_LEN         28      // rendered "token":value text for one SR element, with NUL
+
+static_assert(NV_STATUS_REPORT_LEN <= 64, "sr.pending has a bit per status report element");
 
 typedef enum {                      // status report enable, verbosity and request type
     SR_OFF = 0,                     // no reports
@@ -53,14 +56,39 @@ typedef enum {
 typedef enum {                      // planner queue enable and verbosity
     QR_OFF = 0,                     // no response is provided
     QR_SINGLE,                      // queue depth reported
-    QR_TRIPLE                       // queue depth reported for buffers, buffers added, buffered removed
+    QR_TRIPLE,                      // queue depth reported for buffers, buffers added, buffered removed
+    QR_TIMED                        // as triple, plus ms of motion queued and not yet fully planned
 } qrVerbosity;
 
+/*
+ * Status report dirty flags: the subsystems behind the SR elements mark what they may have
+ * changed with sr_mark_dirty(), and a filtered JSON report only reads the elements behind
+ * the flags that were set - see _sr_dirty_mask(). Elements that aren't listed there, such
+ * as stat, whose inputs are written from all over, are read for every report.
+ */
+typedef enum {
+    SR_DIRTY_RUNTIME = 0x01,        // the runtime ran or changed state - line, vel, pos, mpo and the active model
+    SR_DIRTY_MODEL = 0x02,          // a command ran, or the offsets changed - the gcode model and work positions
+    SR_DIRTY_ALWAYS = 0x80          // the element has no flag - it's read for every report
+} srDirty;
+
+typedef struct srSlot {             // pre-rendered JSON for one status report element
+    index_t index;                  // element the text was rendered for (0 = nothing rendered)
+    float value;                    // value the text was rendered from
+    uint8_t length;                 // length of text, less the NUL
+    char text[SR_SLOT_LEN];         // "token":value
+    index_t mask_index;             // element the dirty mask was found for (0 = none)
+    uint8_t mask;                   // srDirty flags that can change the element
+} srSlot_t;
+
 typedef struct srSingleton {
 
     /*** config values (PUBLIC) ***/
     srVerbosity status_report_verbosity;
     uint32_t status_report_interval;                    // in milliseconds
+    uint8_t status_report_adaptive;                     // true to stretch the interval through cruises
+    float status_report_resolution;                     // position change filtered reports ignore while moving (mm)
+    uint8_t job_summary_report;                         // true to send the job summary at M2 and M30
 
     /*** runtime values (PRIVATE) ***/
     srVerbosity status_report_request;                  // flag that SR has been requested, and what type
@@ -70,9 +98,24 @@ typedef struct srSingleton {
     uint8_t throttle_counter;                           // slow down SRs when in a constrained time (not phat_city)
     index_t status_report_list[NV_STATUS_REPORT_LEN];   // status report elements to report
     float status_report_value[NV_STATUS_REPORT_LEN];    // previous values for filtered reporting
+    uint8_t slot_units_mode;                            // units mode the slots were rendered in
+    srSlot_t slot[NV_STATUS_REPORT_LEN];                // JSON text of each element, patched as values change
+    volatile uint8_t dirty;                             // srDirty flags marked since the last report
+    uint64_t pending;                                   // elements to read for the next filtered report - one bit each
 
 } srSingleton_t;
 
+#ifndef QR_BLOCK_TIMES
+#define QR_BLOCK_TIMES 8            // timed lines waiting to be reported. Must be 2^N
+#endif
+
+typedef struct qrBlockTime {        // how long the blocks of one Gcode line took - see qr_block_start()
+    uint32_t linenum;
+    uint32_t start;                 // timebase time the first block started, low 32 bits of us
+    uint32_t actual;                // us from then until the last block was retired
+    uint32_t planned;               // us the blocks were planned to take
+} qrBlockTime_t;
+
 typedef struct qrSingleton {        // data for queue reports
 
     /*** config values (PUBLIC) ***/
@@ -87,8 +130,27 @@ typedef struct qrSingleton {        // data for queue reports
     uint8_t motion_mode;                    // used to detect arc movement
     uint32_t init_tick;                     // time when values were last initialized or cleared
 
+    uint32_t time_first;                    // {qtb:} first line number to time, 0 = off
+    uint32_t time_last;                     // {qte:} last line number to time
+    bool timing;                            // the blocks of time_open.linenum are running - exec only
+    qrBlockTime_t time_open;                // ...and their time so far
+    volatile uint8_t time_head;             // next timed line to write - written by qr_block_end() only
+    volatile uint8_t time_tail;             // next timed line to report - written by the callback only
+    qrBlockTime_t times[QR_BLOCK_TIMES];
+
 } qrSingleton_t;
 
+/*
+ * Gcode error reports: in JV_EXCEPTIONS mode a Gcode line that fails is queued here with
+ * its status and line number instead of getting a full response inline. The reports go
+ * out from rpt_gcode_error_callback() when the TX path has room, so one bad line doesn't
+ * cost the streaming host a blocking response cycle.
+ */
+#ifndef GCODE_ERROR_REPORTS
+#define GCODE_ERROR_REPORTS true    // false answers gcode errors inline, as any other response
+#endif
+#define GCODE_ERROR_RING_SIZE 8     // errors waiting to be reported. Must be 2^N
+
 /**** Externs - See report.c for allocation ****/
 
 extern srSingleton_t sr;
@@ -100,6 +162,8 @@ void rpt_print_message(char *msg);
 stat_t rpt_exception(stat_t status, const char *msg);
 
 stat_t rpt_er(nvObj_t *nv);
+void rpt_queue_gcode_error(stat_t status, const char *block);
+stat_t rpt_gcode_error_callback(void);
 void rpt_print_loading_configs_message(void);
 void rpt_print_initializing_message(void);
 void rpt_print_system_ready_message(void);
@@ -107,6 +171,7 @@ void rpt_print_system_ready_message(void);
 void sr_init_status_report(void);
 stat_t sr_set_status_report(nvObj_t *nv);
 stat_t sr_request_status_report(cmStatusReportRequest request_type);
+void sr_mark_dirty(uint8_t flags);
 stat_t sr_status_report_callback(void);
 stat_t sr_run_text_status_report(void);
 
@@ -117,6 +182,9 @@ stat_t sr_set_si(nvObj_t *nv);
 void qr_init_queue_report(void);
 void qr_request_queue_report(int8_t buffers);
 stat_t qr_queue_report_callback(void);
+void qr_block_start(const struct mpBuffer *bf);     // called from exec
+void qr_block_end(const struct mpBuffer *bf);
+stat_t job_summary_callback(void);
 
 void rx_request_rx_report(void);
 stat_t rx_report_callback(void);
@@ -124,26 +192,40 @@ stat_t rx_report_callback(void);
 stat_t qr_get(nvObj_t *nv);
 stat_t qi_get(nvObj_t *nv);
 stat_t qo_get(nvObj_t *nv);
+stat_t qt_get(nvObj_t *nv);
+stat_t qp_get(nvObj_t *nv);
 
 #ifdef __TEXT_MODE
 
     void sr_print_sr(nvObj_t *nv);
     void sr_print_si(nvObj_t *nv);
     void sr_print_sv(nvObj_t *nv);
+    void sr_print_sad(nvObj_t *nv);
+    void sr_print_sres(nvObj_t *nv);
     void qr_print_qv(nvObj_t *nv);
     void qr_print_qr(nvObj_t *nv);
     void qr_print_qi(nvObj_t *nv);
     void qr_print_qo(nvObj_t *nv);
+    void qr_print_qt(nvObj_t *nv);
+    void qr_print_qp(nvObj_t *nv);
+    void qr_print_qtb(nvObj_t *nv);
+    void qr_print_qte(nvObj_t *nv);
 
 #else
 
     #define sr_print_sr tx_print_stub
     #define sr_print_si tx_print_stub
     #define sr_print_sv tx_print_stub
+    #define sr_print_sad tx_print_stub
+    #define sr_print_sres tx_print_stub
     #define qr_print_qv tx_print_stub
     #define qr_print_qr tx_print_stub
     #define qr_print_qi tx_print_stub
     #define qr_print_qo tx_print_stub
+    #define qr_print_qt tx_print_stub
+    #define qr_print_qp tx_print_stub
+    #define qr_print_qtb tx_print_stub
+    #define qr_print_qte tx_print_stub
 
 #endif // __TEXT_MODE
 
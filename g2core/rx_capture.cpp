@@ -0,0 +1,224 @@
+/*
+ * rx_capture.cpp - timed capture and replay of the data channel's RX stream
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "g2core.h"
+#include "config.h"
+#include "hardware.h"
+#include "rx_capture.h"
+#include "text_parser.h"
+#include "timebase.h"
+#include "util.h"
+#include "xio.h"
+
+#if RX_CAPTURE_ENABLED == true
+
+/**** Allocate Structures ****/
+
+rxc_t rxc;
+
+/************************************************************************************
+ **** CODE **************************************************************************
+ ************************************************************************************/
+
+/*
+ * rxc_record() - store a run of bytes from the data channel - see rx_capture.h
+ *
+ *  Runs longer than RX_CAPTURE_RECORD_MAX take several records with the same time.
+ */
+
+void rxc_record(const char *data, uint16_t length)
+{
+    uint32_t usec = (uint32_t)(tb_get_usec() - rxc.start_usec);
+
+    while (length > 0) {
+        uint8_t count = (uint8_t)min(length, (uint16_t)RX_CAPTURE_RECORD_MAX);
+        if ((rxc.length + RX_CAPTURE_HEADER_LEN + count) > RX_CAPTURE_BUFFER_SIZE) {
+            rxc.state = RXC_FULL;                       // the rest of the run is lost - the capture ends here
+            return;
+        }
+        uint8_t *r = &rxc.buffer[rxc.length];
+        memcpy(r, &usec, 4);                            // records are not aligned
+        r[4] = count;
+        memcpy(r + RX_CAPTURE_HEADER_LEN, data, count);
+        rxc.length += RX_CAPTURE_HEADER_LEN + count;
+        rxc.bytes += count;
+        rxc.records++;
+        data += count;
+        length -= count;
+    }
+}
+
+/*
+ * rxc_replay_char() - get the next byte of the replay, if its time has come. False if not
+ * rxc_replay_is_done() - true once every byte has been replayed
+ */
+
+bool rxc_replay_char(char &c)
+{
+    if (!rxc.replay || (rxc.replay_offset >= rxc.length)) {
+        return (false);
+    }
+    const uint8_t *r = &rxc.buffer[rxc.replay_offset];
+    uint32_t usec;
+    memcpy(&usec, r, 4);
+    if (tb_get_usec() < (rxc.replay_usec + usec)) {
+        return (false);                                 // hasn't arrived yet
+    }
+    c = (char)r[RX_CAPTURE_HEADER_LEN + rxc.replay_index];
+    if (++rxc.replay_index == r[4]) {
+        rxc.replay_offset += RX_CAPTURE_HEADER_LEN + r[4];
+        rxc.replay_index = 0;
+    }
+    return (true);
+}
+
+bool rxc_replay_is_done()
+{
+    return (rxc.replay_offset >= rxc.length);
+}
+
+/*
+ * rxc_callback() - send a dump a few lines at a time
+ */
+
+stat_t rxc_callback()
+{
+    if (!rxc.dump) {
+        return (STAT_NOOP);
+    }
+    char line[32 + 2*RX_CAPTURE_RECORD_MAX];
+
+    for (uint8_t i=0; (i < RX_CAPTURE_DUMPS_PER_CALLBACK) && rxc.dump; i++) {
+        if (xio_tx_is_backed_up()) {
+            break;
+        }
+        if (rxc.dump_next == 0) {
+            sprintf(line, "{\"rxch\":[%lu,%lu]}\n", (unsigned long)rxc.records, (unsigned long)rxc.bytes);
+            rxc.dump_offset = 0;
+        } else {
+            const uint8_t *r = &rxc.buffer[rxc.dump_offset];
+            uint32_t usec;
+            memcpy(&usec, r, 4);
+            char *str = line + sprintf(line, "{\"rxc\":[%lu,\"", (unsigned long)usec);
+            for (uint8_t k=0; k < r[4]; k++) {
+                str += sprintf(str, "%02x", r[RX_CAPTURE_HEADER_LEN + k]);
+            }
+            strcpy(str, "\"]}\n");
+            rxc.dump_offset += RX_CAPTURE_HEADER_LEN + r[4];
+        }
+        xio_writeline(line);
+        if (rxc.dump_next++ >= rxc.records) {
+            rxc.dump = 0;
+        }
+    }
+    return (STAT_OK);
+}
+
+/***********************************************************************************
+ * CONFIGURATION AND INTERFACE FUNCTIONS
+ * Functions to get and set variables from the cfgArray table
+ ***********************************************************************************/
+
+/*
+ * rxc_set_rxca() - {rxca:1} starts a capture, {rxca:0} stops one. Not during a replay
+ */
+
+stat_t rxc_set_rxca(nvObj_t *nv)
+{
+    if (nv->value > 1) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_VALUE_RANGE_ERROR);
+    }
+    if (nv->value == 0) {
+        if (rxc.state == RXC_CAPTURING) {
+            rxc.state = RXC_OFF;
+        }
+        return (STAT_OK);
+    }
+    if (rxc.replay || rxc.dump) {
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    rxc.bytes = 0;
+    rxc.records = 0;
+    rxc.length = 0;
+    rxc.start_usec = tb_get_usec();
+    rxc.state = RXC_CAPTURING;                          // last - the scan records from here
+    return (STAT_OK);
+}
+
+/*
+ * rxc_set_rxcr() - {rxcr:1} replays the capture, {rxcr:0} stops a replay
+ */
+
+stat_t rxc_set_rxcr(nvObj_t *nv)
+{
+    if ((nv->value != 0) && ((rxc.state == RXC_CAPTURING) || (rxc.records == 0))) {
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    ritorno(set_01(nv));                                // also sets rxc.replay
+    uint32_t usec;
+    memcpy(&usec, rxc.buffer, 4);
+    rxc.replay_usec = tb_get_usec() - usec;             // the first record is due now
+    rxc.replay_offset = 0;
+    rxc.replay_index = 0;
+    if (rxc.replay) {
+        xio_start_replay();
+    }
+    return (STAT_OK);
+}
+
+/*
+ * rxc_set_rxcd() - dump the capture. {rxcd:1} starts a dump, {rxcd:0} stops one
+ */
+
+stat_t rxc_set_rxcd(nvObj_t *nv)
+{
+    if ((nv->value != 0) && (rxc.state == RXC_CAPTURING)) {
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    ritorno(set_01(nv));                                // also sets rxc.dump
+    rxc.dump_next = 0;
+    return (STAT_OK);
+}
+
+/***********************************************************************************
+ * TEXT MODE SUPPORT
+ * Functions to print variables from the cfgArray table
+ ***********************************************************************************/
+
+#ifdef __TEXT_MODE
+
+static const char fmt_rxca[] = "[rxca] rx capture state%12d [0=off,1=capturing,2=full]\n";
+static const char fmt_rxcr[] = "[rxcr] rx capture replay%11d [0=off,1=replaying]\n";
+static const char fmt_rxcn[] = "[rxcn] rx capture bytes%12lu\n";
+
+void rxc_print_rxca(nvObj_t *nv) { text_print(nv, fmt_rxca);}
+void rxc_print_rxcr(nvObj_t *nv) { text_print(nv, fmt_rxcr);}
+void rxc_print_rxcn(nvObj_t *nv) { text_print(nv, fmt_rxcn);}
+
+#endif // __TEXT_MODE
+
+#endif // RX_CAPTURE_ENABLED
@@ -0,0 +1,127 @@
+/*
+ * rx_capture.h - timed capture and replay of the data channel's RX stream
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* RX capture records the data channel's input exactly as it arrives, with the time each run
+ *  of bytes came in, so a job that stutters on a machine in the field can be run again with
+ *  the host's timing - gaps, bursts and all - without the host. Compile it in with
+ *  RX_CAPTURE_ENABLED; the buffer takes RX_CAPTURE_BUFFER_SIZE bytes of RAM.
+ *
+ *  {rxca:1} starts a capture and clears the last one. From then on the RX scan of the data
+ *  device (xio.cpp) hands each run of bytes it sees to rxc_rx(), which stores it behind a
+ *  record header - the microseconds since the capture started, and the length. That's the
+ *  time the main loop scanned the bytes, which is within a controller pass of their
+ *  arrival. Nothing is filtered: controls, JSON and Gcode are kept as sent. The capture
+ *  stops when the buffer fills - a replay must start where the job started - and {rxca:}
+ *  reads 0 off, 1 capturing, 2 stopped full. {rxca:0} stops it, {rxcn:} is the count of
+ *  bytes captured. Times wrap after 71 minutes, so keep a capture shorter than that.
+ *
+ *  {rxcr:1} replays the capture on the board through the replay device (xio.cpp), with
+ *  each byte released at its recorded offset from the start. It reads as a data channel,
+ *  in step with the host's own, with responses suppressed as for a flash file. {rxcr:}
+ *  is 1 during a replay and {rxcr:0} stops it. Put the machine in the state it was in
+ *  when the capture started first - including the position.
+ *
+ *  {rxcd:1} dumps the capture for a replay from the host, a header and then one line per
+ *  record, its bytes in hex:
+ *
+ *      {"rxch":[records,bytes]}
+ *      {"rxc":[usec,"4731583130..."]}
+ *
+ *  Resources/debug/rx_replay.py sends a dump back to a board at the recorded times.
+ */
+#ifndef RX_CAPTURE_H_ONCE
+#define RX_CAPTURE_H_ONCE
+
+#if RX_CAPTURE_ENABLED == true
+
+/**** Configs, Definitions and Structures ****/
+
+#ifndef RX_CAPTURE_BUFFER_SIZE
+#define RX_CAPTURE_BUFFER_SIZE      16384   // bytes of RAM for the capture, record headers included
+#endif
+#define RX_CAPTURE_HEADER_LEN       5       // uint32 usec and uint8 length ahead of each record's bytes
+#define RX_CAPTURE_RECORD_MAX       64      // bytes a record holds at most - longer runs take several
+#define RX_CAPTURE_DUMPS_PER_CALLBACK 2     // lines sent per controller pass, at most
+
+typedef enum {
+    RXC_OFF = 0,                        // not capturing
+    RXC_CAPTURING,                      // recording the data channel
+    RXC_FULL                            // the buffer filled and recording stopped
+} rxcState;
+
+typedef struct rxcSingleton {
+    uint8_t state;                      // rxcState {rxca:}
+    uint8_t replay;                     // 1 while replaying {rxcr:}
+    uint8_t dump;                       // 1 = dump requested {rxcd:}
+    uint32_t bytes;                     // bytes captured {rxcn:}
+    uint32_t records;                   // records captured
+    uint32_t length;                    // bytes of the buffer in use
+    uint64_t start_usec;                // timebase time the capture started
+    uint64_t replay_usec;               // timebase time the replay's first record is due
+    uint32_t replay_offset;             // record the replay is in
+    uint8_t replay_index;               // next byte of that record
+    uint32_t dump_next;                 // record the dump is at, 0 for the header line
+    uint32_t dump_offset;               // and its offset
+    uint8_t buffer[RX_CAPTURE_BUFFER_SIZE];
+} rxc_t;
+
+extern rxc_t rxc;
+
+/**** Function Prototypes ****/
+
+void rxc_record(const char *data, uint16_t length);
+bool rxc_replay_char(char &c);
+bool rxc_replay_is_done(void);
+stat_t rxc_callback(void);
+
+static inline void rxc_rx(const char *data, uint16_t length)   // called by the RX scan of the data device
+{
+    if (rxc.state == RXC_CAPTURING) {
+        rxc_record(data, length);
+    }
+}
+
+stat_t rxc_set_rxca(nvObj_t *nv);
+stat_t rxc_set_rxcr(nvObj_t *nv);
+stat_t rxc_set_rxcd(nvObj_t *nv);
+
+#ifdef __TEXT_MODE
+
+    void rxc_print_rxca(nvObj_t *nv);
+    void rxc_print_rxcr(nvObj_t *nv);
+    void rxc_print_rxcn(nvObj_t *nv);
+
+#else
+
+    #define rxc_print_rxca tx_print_stub
+    #define rxc_print_rxcr tx_print_stub
+    #define rxc_print_rxcn tx_print_stub
+
+#endif // __TEXT_MODE
+
+#endif // RX_CAPTURE_ENABLED
+
+#endif // End of include guard: RX_CAPTURE_H_ONCE
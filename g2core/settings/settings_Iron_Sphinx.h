@@ -71,6 +71,10 @@
 #define CHORDAL_TOLERANCE           0.01    // {ct: chordal tolerance for arcs (in mm)
 #endif
 
+#ifndef COALESCE_ENABLE
+#define COALESCE_ENABLE             1       // {coale: merge the sub-0.05mm G1 runs our CAM posts emit
+#endif
+
 #ifndef MOTOR_POWER_TIMEOUT
 #define MOTOR_POWER_TIMEOUT         2.00    // {mt:  motor power timeout in seconds
 #endif
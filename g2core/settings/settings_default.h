@@ -58,6 +58,34 @@
 
 // *** Machine configuration settings *** //
 
+#ifndef KINEMATICS
+#define KINEMATICS                  KINE_CARTESIAN  // KINE_CARTESIAN, KINE_COREXY, KINE_LINEAR_DELTA, KINE_TRUNNION_AC
+#endif
+
+#ifndef MACHINE_CONFIG_LOCKED
+#define MACHINE_CONFIG_LOCKED       false   // true fixes motor maps and axis modes to this file - see kinematics.h
+#endif
+
+#ifndef DELTA_ARM_LENGTH
+#define DELTA_ARM_LENGTH            250.0   // KINE_LINEAR_DELTA diagonal arm length (in mm)
+#endif
+
+#ifndef DELTA_RADIUS
+#define DELTA_RADIUS                125.0   // KINE_LINEAR_DELTA carriage pivot radius less effector pivot offset (in mm)
+#endif
+
+#ifndef TRUNNION_PIVOT_Y
+#define TRUNNION_PIVOT_Y            0.0     // KINE_TRUNNION_AC A axis line, Y position (in mm)
+#endif
+
+#ifndef TRUNNION_PIVOT_Z
+#define TRUNNION_PIVOT_Z            0.0     // KINE_TRUNNION_AC A axis line, Z position (in mm)
+#endif
+
+#ifndef HEIGHT_MAP_ENABLED
+#define HEIGHT_MAP_ENABLED          false   // true to compile in Z compensation from a G38.6 scan {hmpe:
+#endif
+
 #ifndef USB_SERIAL_PORTS_EXPOSED
 #define USB_SERIAL_PORTS_EXPOSED   1        // Valid options are 1 or 2, only!
 #endif
@@ -67,10 +95,70 @@
 #define JUNCTION_INTEGRATION_TIME   0.75    // {jt: cornering - between 0.05 and 2.00 (max)
 #endif
 
+#ifndef SEGMENT_STRETCH_MAX
+#define SEGMENT_STRETCH_MAX         1.0     // {sgx: longest segments may be stretched while exec runs late, 1.0=off, up to 4.0
+#endif
+
+#ifndef JUNCTION_CURVATURE_ENABLE
+#define JUNCTION_CURVATURE_ENABLE   0       // {jc: 1=limit junctions on faceted curves by curvature, 0=corners only
+#endif
+
 #ifndef CHORDAL_TOLERANCE
 #define CHORDAL_TOLERANCE           0.01    // {ct: chordal tolerance for arcs (in mm)
 #endif
 
+#ifndef COALESCE_ENABLE
+#define COALESCE_ENABLE             0       // {coale: 0=off, 1=merge short collinear feeds, 2=also smooth curved runs into splines
+#endif
+
+#ifndef COALESCE_SEGMENT_LENGTH
+#define COALESCE_SEGMENT_LENGTH     0.05    // {coall: feeds shorter than this may be merged (in mm)
+#endif
+
+#ifndef COALESCE_TOLERANCE
+#define COALESCE_TOLERANCE          0.002   // {coalt: max deviation of a dropped vertex from the merged path (in mm)
+#endif
+
+#ifndef COALESCE_LENGTH_MAX
+#define COALESCE_LENGTH_MAX         1.0     // {coalm: max length of a merged move (in mm)
+#endif
+
+#ifndef LOOKAHEAD_ENABLE
+#define LOOKAHEAD_ENABLE            0       // {looke: 0=off, 1=hold moves beyond the planner queue for lookahead, 2=hold them to parse ahead only
+#endif
+
+#ifndef SHAPER_X_TYPE
+#define SHAPER_X_TYPE               0       // {shpxt: input shaper 0=off, 1=ZV, 2=ZVD, 3=EI
+#endif
+#ifndef SHAPER_X_FREQUENCY
+#define SHAPER_X_FREQUENCY          40.0    // {shpxf: resonant frequency of the X axis (in Hz)
+#endif
+#ifndef SHAPER_Y_TYPE
+#define SHAPER_Y_TYPE               0       // {shpyt:
+#endif
+#ifndef SHAPER_Y_FREQUENCY
+#define SHAPER_Y_FREQUENCY          40.0    // {shpyf:
+#endif
+#ifndef SHAPER_Z_TYPE
+#define SHAPER_Z_TYPE               0       // {shpzt:
+#endif
+#ifndef SHAPER_Z_FREQUENCY
+#define SHAPER_Z_FREQUENCY          40.0    // {shpzf:
+#endif
+#ifndef SHAPER_DAMPING
+#define SHAPER_DAMPING              0.1     // {shpd: damping ratio of the resonances, 0 to 0.3
+#endif
+
+#ifndef TRACK_AXIS
+#define TRACK_AXIS                  AXIS_X  // {trka: axis that follows the conveyor - see plan_track.h
+#endif
+#ifndef CONVEYOR_MM_PER_COUNT
+#define CONVEYOR_MM_PER_COUNT       0.01    // {trks: belt travel per conveyor encoder count, negative if reversed
+#endif
+#ifndef AUX_AXES
+#define AUX_AXES                    0       // {auxm: axes moved by the auxiliary channel, a bit per axis - see plan_aux.h
+#endif
+
 #ifndef MOTOR_POWER_TIMEOUT
 #define MOTOR_POWER_TIMEOUT         2.00    // {mt:  motor power timeout in seconds
 #endif
@@ -102,6 +190,30 @@
 #define SPINDLE_DWELL_TIME          1.0     // {spdw:
 #endif
 
+#ifndef SPINDLE_AT_SPEED_TIMEOUT
+#define SPINDLE_AT_SPEED_TIMEOUT    10.0    // {spat: seconds to wait for the at-speed input, 0=forever
+#endif
+
+#ifndef SPINDLE_LASER_MODE
+#define SPINDLE_LASER_MODE          false   // {splm: scale PWM with velocity every segment
+#endif
+
+#ifndef SPINDLE_VFD_ENABLE
+#define SPINDLE_VFD_ENABLE          false   // {spvm: run the spindle over Modbus - see spindle_vfd.h
+#endif
+
+#ifndef SPINDLE_VFD_ADDRESS
+#define SPINDLE_VFD_ADDRESS         1       // {spva: VFD Modbus slave address
+#endif
+
+#ifndef SPINDLE_VFD_RPM_PER_COUNT
+#define SPINDLE_VFD_RPM_PER_COUNT   0.6     // {spvk: rpm per count of the VFD speed registers (0.01 Hz on a 2 pole spindle)
+#endif
+
+#ifndef SPINDLE_ENCODER_COUNTS
+#define SPINDLE_ENCODER_COUNTS      4096    // {spec: spindle encoder counts per turn, negative if reversed - see plan_sync.h
+#endif
+
 #ifndef COOLANT_MIST_POLARITY
 #define COOLANT_MIST_POLARITY       1       // {comp: 0=active low, 1=active high
 #endif
@@ -118,6 +230,14 @@
 #define PROBE_REPORT_ENABLE         true    // {prbr:
 #endif
 
+#ifndef SCAN_COLUMNS
+#define SCAN_COLUMNS                2       // {scnc:  points along X in a G38.6 scan
+#endif
+
+#ifndef SCAN_ROWS
+#define SCAN_ROWS                   2       // {scnr:  points along Y in a G38.6 scan
+#endif
+
 /*
  * The following is to fix an issue where feedrate override was being defined in some users
  * settings files but not others. This would otherwise cause an undefined compile error.
@@ -153,8 +273,16 @@
 #define JSON_VERBOSITY              JV_MESSAGES             // {jv: JV_SILENT, JV_FOOTER, JV_CONFIGS, JV_MESSAGES, JV_LINENUM, JV_VERBOSE
 #endif
 
+#ifndef JSON_FOOTER_STYLE
+#define JSON_FOOTER_STYLE           JF_LINE_LENGTH          // {jf: JF_LINE_LENGTH, JF_WINDOW_REPORT
+#endif
+
+#ifndef JSON_ACK_LINES
+#define JSON_ACK_LINES              0                       // {ja: Gcode lines acknowledged per response - 0 or 1 for every line
+#endif
+
 #ifndef QUEUE_REPORT_VERBOSITY
-#define QUEUE_REPORT_VERBOSITY      QR_OFF                  // {qv: QR_OFF, QR_SINGLE, QR_TRIPLE
+#define QUEUE_REPORT_VERBOSITY      QR_OFF                  // {qv: QR_OFF, QR_SINGLE, QR_TRIPLE, QR_TIMED
 #endif
 
 #ifndef STATUS_REPORT_VERBOSITY
@@ -169,6 +297,30 @@
 #define STATUS_REPORT_INTERVAL_MS   250                     // {si: milliseconds - set $SV=0 to disable
 #endif
 
+#ifndef STATUS_REPORT_ADAPTIVE
+#define STATUS_REPORT_ADAPTIVE      false                   // {sad: true stretches timed reports through long cruises
+#endif
+
+#ifndef STATUS_REPORT_ADAPTIVE_MAX_MS
+#define STATUS_REPORT_ADAPTIVE_MAX_MS 2000                  // (no JSON) milliseconds - longest adaptive interval
+#endif
+
+#ifndef STATUS_REPORT_RESOLUTION
+#define STATUS_REPORT_RESOLUTION    0.0                     // {sres: mm - position change filtered reports ignore while moving
+#endif
+
+#ifndef JOB_SUMMARY_REPORT
+#define JOB_SUMMARY_REPORT          false                   // {jsme: true sends the {jsm:} job summary at M2 and M30
+#endif
+
+#ifndef CHECKPOINT_ENABLE
+#define CHECKPOINT_ENABLE           false                   // {ckpte: true saves motion checkpoints for {ckptr:} - see checkpoint.h
+#endif
+
+#ifndef MOTION_LINK_MODE
+#define MOTION_LINK_MODE            0                       // {mlnm: 0=off, 1=leader, 2=follower - see motion_link.h
+#endif
+
 #ifndef STATUS_REPORT_DEFAULTS                              // {sr: See Status Reports wiki page
 #define STATUS_REPORT_DEFAULTS "line","posx","posy","posz","posa","feed","vel","unit","coor","dist","admo","frmo","momo","stat"
 // Alternate SRs that report in drawable units
@@ -180,6 +332,30 @@
 #define MARLIN_COMPAT_ENABLED       false                   // boolean, either true or false
 #endif
 
+#ifndef MARLIN_PRESSURE_ADVANCE
+#define MARLIN_PRESSURE_ADVANCE     0.0                     // {pa: seconds of extruder lead (Marlin M900 K). 0 disables
+#endif
+
+#ifndef BINARY_STREAM_ENABLED
+#define BINARY_STREAM_ENABLED       true                    // boolean, accept binary motion frames on the data channel
+#endif
+
+#ifndef BENCH_ENABLED
+#define BENCH_ENABLED               false                   // boolean, compile in {bench:} and its programs - see bench.h
+#endif
+
+#ifndef STEP_CAPTURE_ENABLED
+#define STEP_CAPTURE_ENABLED        false                   // boolean, compile in step edge capture on a looped back input - see step_capture.h
+#endif
+
+#ifndef RX_CAPTURE_ENABLED
+#define RX_CAPTURE_ENABLED          false                   // boolean, compile in timed capture and replay of the data channel - see rx_capture.h
+#endif
+
+#ifndef XIO_REALTIME_ENABLED
+#define XIO_REALTIME_ENABLED        true                    // boolean, act on ! ~ and ^X from the SysTick, not the main loop
+#endif
+
 // *** Gcode Startup Defaults *** //
 
 #ifndef GCODE_DEFAULT_UNITS
@@ -232,6 +408,27 @@
 #ifndef M1_POWER_LEVEL
 #define M1_POWER_LEVEL              0.0                     // {1pl:   0.0=no power, 1.0=max power
 #endif
+#ifndef M1_FEEDFORWARD_VELOCITY
+#define M1_FEEDFORWARD_VELOCITY     0.0                     // {1fv:  ms of lag to lead the motor by per unit of velocity. 0=off
+#endif
+#ifndef M1_FEEDFORWARD_ACCEL
+#define M1_FEEDFORWARD_ACCEL        0.0                     // {1fa:  ms^2 of lead per unit of acceleration. 0=off
+#endif
+#ifndef M1_BACKLASH
+#define M1_BACKLASH                 0.0                     // {1bl:  backlash taken up on each reversal, mm or deg. 0=off
+#endif
+#ifndef M1_HOMING_INPUT
+#define M1_HOMING_INPUT             0                       // {1hi:  input that homes this motor, 0=the axis homing input
+#endif
+#ifndef M1_STALL_INPUT
+#define M1_STALL_INPUT              0                       // {1si:  input driven by a driver stall (StallGuard), 0=none
+#endif
+#ifndef M1_STALL_THRESHOLD
+#define M1_STALL_THRESHOLD          0                       // {1sg:  stall sensitivity, -64=most to 63=least
+#endif
+#ifndef M1_COOL_STEP
+#define M1_COOL_STEP                0                       // {1cs:  1=driver trims current to the load (CoolStep)
+#endif
 
 // MOTOR 2
 #ifndef M2_MOTOR_MAP
@@ -258,6 +455,27 @@
 #ifndef M2_POWER_LEVEL
 #define M2_POWER_LEVEL              0.0
 #endif
+#ifndef M2_FEEDFORWARD_VELOCITY
+#define M2_FEEDFORWARD_VELOCITY     0.0
+#endif
+#ifndef M2_FEEDFORWARD_ACCEL
+#define M2_FEEDFORWARD_ACCEL        0.0
+#endif
+#ifndef M2_BACKLASH
+#define M2_BACKLASH                 0.0
+#endif
+#ifndef M2_HOMING_INPUT
+#define M2_HOMING_INPUT             0
+#endif
+#ifndef M2_STALL_INPUT
+#define M2_STALL_INPUT              0
+#endif
+#ifndef M2_STALL_THRESHOLD
+#define M2_STALL_THRESHOLD          0
+#endif
+#ifndef M2_COOL_STEP
+#define M2_COOL_STEP                0
+#endif
 
 // MOTOR 3
 #ifndef M3_MOTOR_MAP
@@ -284,6 +502,27 @@
 #ifndef M3_POWER_LEVEL
 #define M3_POWER_LEVEL              0.0
 #endif
+#ifndef M3_FEEDFORWARD_VELOCITY
+#define M3_FEEDFORWARD_VELOCITY     0.0
+#endif
+#ifndef M3_FEEDFORWARD_ACCEL
+#define M3_FEEDFORWARD_ACCEL        0.0
+#endif
+#ifndef M3_BACKLASH
+#define M3_BACKLASH                 0.0
+#endif
+#ifndef M3_HOMING_INPUT
+#define M3_HOMING_INPUT             0
+#endif
+#ifndef M3_STALL_INPUT
+#define M3_STALL_INPUT              0
+#endif
+#ifndef M3_STALL_THRESHOLD
+#define M3_STALL_THRESHOLD          0
+#endif
+#ifndef M3_COOL_STEP
+#define M3_COOL_STEP                0
+#endif
 
 // MOTOR 4
 #ifndef M4_MOTOR_MAP
@@ -310,6 +549,27 @@
 #ifndef M4_POWER_LEVEL
 #define M4_POWER_LEVEL              0.0
 #endif
+#ifndef M4_FEEDFORWARD_VELOCITY
+#define M4_FEEDFORWARD_VELOCITY     0.0
+#endif
+#ifndef M4_FEEDFORWARD_ACCEL
+#define M4_FEEDFORWARD_ACCEL        0.0
+#endif
+#ifndef M4_BACKLASH
+#define M4_BACKLASH                 0.0
+#endif
+#ifndef M4_HOMING_INPUT
+#define M4_HOMING_INPUT             0
+#endif
+#ifndef M4_STALL_INPUT
+#define M4_STALL_INPUT              0
+#endif
+#ifndef M4_STALL_THRESHOLD
+#define M4_STALL_THRESHOLD          0
+#endif
+#ifndef M4_COOL_STEP
+#define M4_COOL_STEP                0
+#endif
 
 // MOTOR 5
 #ifndef M5_MOTOR_MAP
@@ -336,6 +596,27 @@
 #ifndef M5_POWER_LEVEL
 #define M5_POWER_LEVEL              0.0
 #endif
+#ifndef M5_FEEDFORWARD_VELOCITY
+#define M5_FEEDFORWARD_VELOCITY     0.0
+#endif
+#ifndef M5_FEEDFORWARD_ACCEL
+#define M5_FEEDFORWARD_ACCEL        0.0
+#endif
+#ifndef M5_BACKLASH
+#define M5_BACKLASH                 0.0
+#endif
+#ifndef M5_HOMING_INPUT
+#define M5_HOMING_INPUT             0
+#endif
+#ifndef M5_STALL_INPUT
+#define M5_STALL_INPUT              0
+#endif
+#ifndef M5_STALL_THRESHOLD
+#define M5_STALL_THRESHOLD          0
+#endif
+#ifndef M5_COOL_STEP
+#define M5_COOL_STEP                0
+#endif
 
 // MOTOR 6
 #ifndef M6_MOTOR_MAP
@@ -362,6 +643,27 @@
 #ifndef M6_POWER_LEVEL
 #define M6_POWER_LEVEL              0.0
 #endif
+#ifndef M6_FEEDFORWARD_VELOCITY
+#define M6_FEEDFORWARD_VELOCITY     0.0
+#endif
+#ifndef M6_FEEDFORWARD_ACCEL
+#define M6_FEEDFORWARD_ACCEL        0.0
+#endif
+#ifndef M6_BACKLASH
+#define M6_BACKLASH                 0.0
+#endif
+#ifndef M6_HOMING_INPUT
+#define M6_HOMING_INPUT             0
+#endif
+#ifndef M6_STALL_INPUT
+#define M6_STALL_INPUT              0
+#endif
+#ifndef M6_STALL_THRESHOLD
+#define M6_STALL_THRESHOLD          0
+#endif
+#ifndef M6_COOL_STEP
+#define M6_COOL_STEP                0
+#endif
 
 //*****************************************************************************
 //*** Axis Settings ***********************************************************
@@ -395,6 +697,12 @@
 #ifndef X_HOMING_DIRECTION
 #define X_HOMING_DIRECTION          0                       // {xhd:  0=search moves negative, 1= search moves positive
 #endif
+#ifndef X_HOMING_GROUP
+#define X_HOMING_GROUP              0                       // {xhg:  0=home alone, 1-N=home with the other axes of the group
+#endif
+#ifndef X_HOMING_LATCH
+#define X_HOMING_LATCH              0                       // {xhl:  0=latch on a slow second pass, 1=latch at the fast search edge
+#endif
 #ifndef X_SEARCH_VELOCITY
 #define X_SEARCH_VELOCITY           500.0                   // {xsv:  minus means move to minimum switch
 #endif
@@ -436,6 +744,12 @@
 #ifndef Y_HOMING_DIRECTION
 #define Y_HOMING_DIRECTION          0
 #endif
+#ifndef Y_HOMING_GROUP
+#define Y_HOMING_GROUP              0
+#endif
+#ifndef Y_HOMING_LATCH
+#define Y_HOMING_LATCH              0
+#endif
 #ifndef Y_SEARCH_VELOCITY
 #define Y_SEARCH_VELOCITY           500.0
 #endif
@@ -477,6 +791,12 @@
 #ifndef Z_HOMING_DIRECTION
 #define Z_HOMING_DIRECTION          0
 #endif
+#ifndef Z_HOMING_GROUP
+#define Z_HOMING_GROUP              0
+#endif
+#ifndef Z_HOMING_LATCH
+#define Z_HOMING_LATCH              0
+#endif
 #ifndef Z_SEARCH_VELOCITY
 #define Z_SEARCH_VELOCITY           250.0
 #endif
@@ -529,6 +849,9 @@
 #ifndef A_RADIUS
 #define A_RADIUS                    (M1_TRAVEL_PER_REV/(2*3.14159628))
 #endif
+#ifndef A_WRAP
+#define A_WRAP                      false                   // {awr: true to take absolute moves the shortest way round
+#endif
 #ifndef A_VELOCITY_MAX
 #define A_VELOCITY_MAX              ((X_VELOCITY_MAX/M1_TRAVEL_PER_REV)*360) // set to the same speed as X axis
 #endif
@@ -553,6 +876,12 @@
 #ifndef A_HOMING_DIRECTION
 #define A_HOMING_DIRECTION          0
 #endif
+#ifndef A_HOMING_GROUP
+#define A_HOMING_GROUP              0
+#endif
+#ifndef A_HOMING_LATCH
+#define A_HOMING_LATCH              0
+#endif
 #ifndef A_SEARCH_VELOCITY
 #define A_SEARCH_VELOCITY           (A_VELOCITY_MAX * 0.500)
 #endif
@@ -573,6 +902,9 @@
 #ifndef B_RADIUS
 #define B_RADIUS                    (M1_TRAVEL_PER_REV/(2*3.14159628))
 #endif
+#ifndef B_WRAP
+#define B_WRAP                      false                   // {bwr: true to take absolute moves the shortest way round
+#endif
 #ifndef B_VELOCITY_MAX
 #define B_VELOCITY_MAX              ((X_VELOCITY_MAX/M1_TRAVEL_PER_REV)*360)
 #endif
@@ -597,6 +929,12 @@
 #ifndef B_HOMING_DIRECTION
 #define B_HOMING_DIRECTION          0
 #endif
+#ifndef B_HOMING_GROUP
+#define B_HOMING_GROUP              0
+#endif
+#ifndef B_HOMING_LATCH
+#define B_HOMING_LATCH              0
+#endif
 #ifndef B_SEARCH_VELOCITY
 #define B_SEARCH_VELOCITY           (A_VELOCITY_MAX * 0.500)
 #endif
@@ -617,6 +955,9 @@
 #ifndef C_RADIUS
 #define C_RADIUS                    (M1_TRAVEL_PER_REV/(2*3.14159628))
 #endif
+#ifndef C_WRAP
+#define C_WRAP                      false                   // {cwr: true to take absolute moves the shortest way round
+#endif
 #ifndef C_VELOCITY_MAX
 #define C_VELOCITY_MAX              ((X_VELOCITY_MAX/M1_TRAVEL_PER_REV)*360)
 #endif
@@ -641,6 +982,12 @@
 #ifndef C_HOMING_DIRECTION
 #define C_HOMING_DIRECTION          0
 #endif
+#ifndef C_HOMING_GROUP
+#define C_HOMING_GROUP              0
+#endif
+#ifndef C_HOMING_LATCH
+#define C_HOMING_LATCH              0
+#endif
 #ifndef C_SEARCH_VELOCITY
 #define C_SEARCH_VELOCITY           (A_VELOCITY_MAX * 0.500)
 #endif
@@ -679,6 +1026,7 @@
     INPUT_FUNCTION_INTERLOCK
     INPUT_FUNCTION_SHUTDOWN
     INPUT_FUNCTION_PANIC
+    INPUT_FUNCTION_SPINDLE_AT_SPEED
 */
 
 // Xmin on v9 board
@@ -928,6 +1276,12 @@
 #ifndef H1_DEFAULT_D
 #define H1_DEFAULT_D                400.0
 #endif
+#ifndef H1_DEFAULT_FF
+#define H1_DEFAULT_FF               0.0      // feedforward, set by autotune
+#endif
+#ifndef H1_DEFAULT_FC
+#define H1_DEFAULT_FC               0.0      // heater fan feedforward
+#endif
 
 #ifndef H2_DEFAULT_ENABLE
 #define H2_DEFAULT_ENABLE           false
@@ -941,6 +1295,12 @@
 #ifndef H2_DEFAULT_D
 #define H2_DEFAULT_D                400.0
 #endif
+#ifndef H2_DEFAULT_FF
+#define H2_DEFAULT_FF               0.0      // feedforward, set by autotune
+#endif
+#ifndef H2_DEFAULT_FC
+#define H2_DEFAULT_FC               0.0      // heater fan feedforward
+#endif
 
 #ifndef H3_DEFAULT_ENABLE
 #define H3_DEFAULT_ENABLE           false
@@ -954,6 +1314,12 @@
 #ifndef H3_DEFAULT_D
 #define H3_DEFAULT_D                400.0
 #endif
+#ifndef H3_DEFAULT_FF
+#define H3_DEFAULT_FF               0.0      // feedforward, set by autotune
+#endif
+#ifndef H3_DEFAULT_FC
+#define H3_DEFAULT_FC               0.0      // heater fan feedforward
+#endif
 
 // *** DEFAULT COORDINATE SYSTEM OFFSETS ***
 
@@ -0,0 +1,36 @@
+/*
+ * board_stepper.h - stepper definitions for the host planner simulator
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ * Copyright (c) 2017 Robert Giseburt
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* The simulator "board" has no pins, timers or interrupts. It keeps the axis and motor
+ * counts of the larger ARM boards so the planner compiles the same way it does there.
+ */
+
+#include "config.h"
+/* The simulator has no Stepper objects. st_prep_line() and friends are replaced in
+ * sim_stubs.cpp, so nothing in stepper.cpp's board layer is ever linked.
+ */
+
+#ifndef BOARD_STEPPER_H_ONCE
+#define BOARD_STEPPER_H_ONCE
+
+#include "hardware.h"  // for MOTORS
+
+void board_stepper_init();
+
+#endif  // BOARD_STEPPER_H_ONCE
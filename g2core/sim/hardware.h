@@ -0,0 +1,103 @@
+/*
+ * hardware.h - hardware definitions for the host planner simulator
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ * Copyright (c) 2017 Robert Giseburt
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* The simulator "board" has no pins, timers or interrupts. It keeps the axis and motor
+ * counts of the larger ARM boards so the planner compiles the same way it does there.
+ */
+
+#include "config.h"
+#include "error.h"
+
+#ifndef HARDWARE_H_ONCE
+#define HARDWARE_H_ONCE
+
+/*--- Hardware platform enumerations ---*/
+
+enum hwPlatform {
+    HM_PLATFORM_NONE = 0,
+    HW_PLATFORM_TINYG_XMEGA,    // TinyG code base on Xmega boards.
+    HW_PLATFORM_G2_DUE,         // G2 code base on native Arduino Due
+    HW_PLATFORM_V9              // G2 code base on v9 boards
+};
+
+/***** Axes, motors & PWM channels used by the application *****/
+
+#define AXES        6           // number of axes supported in this version
+#define HOMING_AXES 4           // number of axes that can be homed (assumes Zxyabc sequence)
+#define MOTORS      6           // number of motors on the board
+#define COORDS      6           // number of supported coordinate systems (index starts at 1)
+#define PWMS        2           // number of supported PWM channels
+#define TOOLS       32          // number of entries in tool table (index starts at 1)
+
+#include "MotatePins.h"
+#include "MotateTimers.h"
+
+/*************************
+ * Global System Defines *
+ *************************/
+
+#define MILLISECONDS_PER_TICK 1     // MS for system tick (systick * N)
+#define SYS_ID_DIGITS 12            // actual digits in system ID (up to 16)
+#define SYS_ID_LEN 24               // total length including dashes and NUL
+
+/**** Stepper DDA and dwell timer settings ****/
+
+#define FREQUENCY_DDA    400000UL   // Hz step frequency (used for step rate math only)
+#define FREQUENCY_DWELL    1000UL
+#define FREQUENCY_SGI    200000UL
+
+/********************************
+ * Function Prototypes (Common) *
+ ********************************/
+
+void hardware_init(void);           // master hardware init
+stat_t hardware_periodic();         // callback from the main loop (time sensitive)
+void hw_hard_reset(void);
+stat_t hw_flash(nvObj_t *nv);
+
+stat_t hw_get_fbs(nvObj_t *nv);
+stat_t hw_get_fbc(nvObj_t *nv);
+stat_t hw_set_hv(nvObj_t *nv);
+stat_t hw_get_id(nvObj_t *nv);
+
+#ifdef __TEXT_MODE
+
+    void hw_print_fb(nvObj_t *nv);
+    void hw_print_fbs(nvObj_t *nv);
+    void hw_print_fbc(nvObj_t *nv);
+    void hw_print_fv(nvObj_t *nv);
+    void hw_print_cv(nvObj_t *nv);
+    void hw_print_hp(nvObj_t *nv);
+    void hw_print_hv(nvObj_t *nv);
+    void hw_print_id(nvObj_t *nv);
+
+#else
+
+    #define hw_print_fb tx_print_stub
+    #define hw_print_fbs tx_print_stub
+    #define hw_print_fbc tx_print_stub
+    #define hw_print_fv tx_print_stub
+    #define hw_print_cv tx_print_stub
+    #define hw_print_hp tx_print_stub
+    #define hw_print_hv tx_print_stub
+    #define hw_print_id tx_print_stub
+
+#endif // __TEXT_MODE
+
+#endif  // end of include guard: HARDWARE_H_ONCE
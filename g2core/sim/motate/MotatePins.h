@@ -0,0 +1,52 @@
+/*
+ * MotatePins.h - host (simulator) stand-in for the Motate pin header
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ * Copyright (c) 2017 Robert Giseburt
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* This is NOT Motate. It provides just enough of the pin interface for the planner
+ * sources to compile on the host for the planner simulator (see sim/sim_main.cpp).
+ */
+
+#ifndef MOTATEPINS_H_ONCE
+#define MOTATEPINS_H_ONCE
+
+#include <stdint.h>
+
+#define PROGMEM                         // no program memory distinction on the host
+
+namespace Motate {
+
+    typedef int16_t pin_number;
+
+    const pin_number kDebug1_PinNumber = -1;    // debug pins are not connected on the host
+    const pin_number kDebug2_PinNumber = -1;
+    const pin_number kDebug3_PinNumber = -1;
+    const pin_number kDebug4_PinNumber = -1;
+
+    template <pin_number pinNum>
+    struct OutputPin {
+        uint32_t value = 0;
+        void set() { value = 1; }
+        void clear() { value = 0; }
+        void toggle() { value ^= 1; }
+        void write(bool v) { value = v; }
+        OutputPin& operator=(bool v) { value = v; return *this; }
+    };
+
+} // namespace Motate
+
+#endif  // End of include guard: MOTATEPINS_H_ONCE
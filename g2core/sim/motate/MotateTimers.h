@@ -0,0 +1,54 @@
+/*
+ * MotateTimers.h - host (simulator) stand-in for the Motate timer header
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ * Copyright (c) 2017 Robert Giseburt
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* This is NOT Motate. The simulator runs on a simulated millisecond clock that is
+ * advanced by the executed segment times, so SysTick and Timeout are deterministic.
+ */
+
+#ifndef MOTATETIMERS_H_ONCE
+#define MOTATETIMERS_H_ONCE
+
+#include <stdint.h>
+
+namespace Motate {
+
+    struct SysTickTimer_t {
+        uint32_t _ticks = 0;                    // simulated milliseconds
+        uint32_t getValue() { return (_ticks); }
+        void advance(uint32_t ms) { _ticks += ms; }
+    };
+    extern SysTickTimer_t SysTickTimer;
+
+    inline void delay(uint32_t ms) { SysTickTimer.advance(ms); }
+
+    struct Timeout {
+        uint32_t start_, delay_;
+        Timeout() : start_ {0}, delay_ {0} {};
+        bool isSet() { return (delay_ != 0); }
+        bool isPast() {
+            if (!isSet()) { return false; }
+            return ((SysTickTimer.getValue() - start_) > delay_);
+        }
+        void set(uint32_t delay) { start_ = SysTickTimer.getValue(); delay_ = delay; }
+        void clear() { start_ = 0; delay_ = 0; }
+    };
+
+} // namespace Motate
+
+#endif  // End of include guard: MOTATETIMERS_H_ONCE
@@ -0,0 +1,47 @@
+/*
+ * sim.h - host planner simulator
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ * Copyright (c) 2017 Robert Giseburt
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef SIM_H_ONCE
+#define SIM_H_ONCE
+
+/**** Simulator singleton ****
+ *
+ *  Shared between sim_stubs.cpp (which stands in for the stepper layer and records
+ *  what the exec hands it) and sim_main.cpp (which schedules the "interrupts").
+ */
+
+typedef struct simSingleton {
+    bool fwd_plan_requested;            // set by st_request_forward_plan()
+    float segment_time[PREP_BUFFERS];   // time of the segment or dwell in each prep slot (minutes)
+    float segment_velocity[PREP_BUFFERS];   // velocity of the segment in each prep slot
+    float segment_steps[PREP_BUFFERS][MOTORS];  // steps of the segment in each prep slot
+    float segment_jerk[PREP_BUFFERS];   // jerk of the block the segment came from (-r limit checks)
+    float segment_vmax[PREP_BUFFERS];   // cruise_vmax of the block the segment came from
+    uint32_t exceptions;                // rpt_exception() calls seen
+} simSingleton_t;
+
+extern simSingleton_t sim;
+
+void sim_canonical_machine_init(void);
+void sim_stepper_init(void);
+bool sim_prep_is_full(void);
+bool sim_prep_is_empty(void);
+
+#endif  // End of include guard: SIM_H_ONCE
@@ -0,0 +1,45 @@
+/*
+ * sim_host.h - host compiler shims for the planner simulator (force-included)
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ * Copyright (c) 2017 Robert Giseburt
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* This header is force-included ahead of every translation unit in the simulator
+ * build (see sim/Makefile). It papers over the few places where the firmware relies
+ * on the ARM toolchain rather than on Motate:
+ *
+ *  - __NOP(), __disable_irq() and __enable_irq() are CMSIS intrinsics. The simulator
+ *    has no interrupts, so they do nothing
+ *  - util.h defines abs(float), which collides with the hosted C++ library overloads.
+ *    The standard headers are pulled in first, then abs is renamed for the firmware.
+ */
+
+#ifndef SIM_HOST_H_ONCE
+#define SIM_HOST_H_ONCE
+
+#include <stdlib.h>
+#include <math.h>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <type_traits>
+
+#define __NOP() do {} while (0)
+#define __disable_irq() do {} while (0)
+#define __enable_irq() do {} while (0)
+#define abs _g2_abs
+
+#endif  // End of include guard: SIM_HOST_H_ONCE
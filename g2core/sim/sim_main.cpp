@@ -0,0 +1,866 @@
+/*
+ * sim_main.cpp - host planner simulator and throughput benchmark
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ * Copyright (c) 2017 Robert Giseburt
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* The simulator runs the real planner and exec code against the sample Gcode files
+ * in Resources/gcode and reports planner throughput and block statistics. It exists
+ * so planner changes can be measured and regression-checked on a development host
+ * without a board attached.
+ *
+ *  Build and run from g2core/sim:
+ *
+ *      make            build ./g2sim
+ *      make run        run all programs
+ *      ./g2sim [-v] [-c] [-j] [-l] [-s] [-t] [-p] [-r] [program ...]
+ *
+ *  -v dumps one line per block (linenum, length, velocities, block time, iterations).
+ *  -c runs G1 moves through the short segment coalescer (plan_coalesce.cpp), as
+ *     cm_straight_feed() does with {coale:1}. "merged" reports how many were absorbed.
+ *  -j limits junctions on faceted curves by their curvature, as {jc:1} does.
+ *  -l runs moves through the lookahead queue (plan_lookahead.cpp), as cm_straight_feed() and
+ *     cm_straight_traverse() do with {looke:1}. Lines are read while the queue has room.
+ *  -s dumps one line per segment (program, segment number, segment velocity). It is used
+ *     by "make compare" to check the fixed point forward differences against float.
+ *  -t reports the time-optimal cycle time for the program (see _get_ideal_time()) and the
+ *     cycle time lost to the planner against it.
+ *  -p runs each program a second time as a host streaming preplanned blocks would: the
+ *     velocities solved for -t, limited to what can stop within PREPLAN_HORIZON_MAX blocks,
+ *     are queued with mp_aline_planned() (see _get_preplan()).
+ *  -r prints the segment trace (see _trace_segment()) and checks each segment against the
+ *     velocity, acceleration and jerk limits of its block. "make golden" records the trace
+ *     and "make check" compares a later build against it.
+ *
+ *  The interrupt structure of stepper.cpp is emulated by a single cooperative loop that
+ *  runs, in priority order, the loader, the forward planner, the exec (which runs ahead
+ *  until the prep ring is full) and finally the main loop (planner callback and Gcode feed). Loading a segment advances the simulated
+ *  clock by the segment time, so block timeouts behave as they do on the machine.
+ *
+ *  The Gcode interpreter here is deliberately minimal: G0/G1, G20/G21, G90/G91, G92,
+ *  F, N and XYZABC words. Everything else (M, S, T, H words, comments) is ignored - so the
+ *  endpoints of G2/G3 arcs in circles2 and tests run as straight feeds.
+ */
+
+#include "g2core.h"
+#include "config.h"
+#include "canonical_machine.h"
+#include "planner.h"
+#include "plan_coalesce.h"
+#include "plan_lookahead.h"
+#include "stepper.h"
+#include "kinematics.h"
+#include "util.h"
+#include "sim.h"
+
+#include <stdio.h>
+#include <chrono>
+
+namespace gcode_braid2d {
+#include "../../Resources/gcode/gcode_braid2d.h"
+}
+namespace gcode_hacdc {
+#include "../../Resources/gcode/gcode_hacdc.h"
+}
+namespace gcode_roadrunner {
+#include "../../Resources/gcode/gcode_roadrunner.h"
+}
+namespace gcode_boxes {
+#include "../../Resources/gcode/gcode_boxes_400mm.h"
+}
+namespace gcode_circles2 {
+#include "../../Resources/gcode/gcode_circles2.h"
+}
+namespace gcode_tests {
+#include "../../Resources/gcode/gcode_tests.h"
+}
+
+/**** Program table ****/
+
+typedef struct simProgram {
+    const char *name;
+    const char *part[2];                // programs may be split across two strings
+} simProgram_t;
+
+static const simProgram_t programs[] = {
+    { "braid2d",    { gcode_braid2d::gcode_file, gcode_braid2d::braid2d_part2 } },
+    { "hacdc",      { gcode_hacdc::hacdc, NULL } },
+    { "roadrunner", { gcode_roadrunner::roadrunner, NULL } },
+    { "boxes",      { gcode_boxes::gcode_file, NULL } },
+    { "circles2",   { gcode_circles2::gcode_file, NULL } },
+    { "tests",      { gcode_tests::gcode_file, gcode_tests::straight_feed_test } }
+};
+#define SIM_PROGRAMS (sizeof(programs)/sizeof(simProgram_t))
+
+#define SIM_LINE_LEN 128                // longest Gcode line accepted
+#define SIM_STALL_PASSES 100000         // idle passes with no progress before declaring a stall
+#define SIM_IDEAL_BLOCKS 8192           // most blocks recorded for the time-optimal solution
+#define SIM_LIMIT_TOLERANCE 0.01        // share over a limit allowed before -r reports a violation
+
+/**** Run state ****/
+
+typedef std::chrono::steady_clock sim_clock;
+
+typedef struct simRun {
+    // Gcode interpreter
+    const simProgram_t *program;
+    uint8_t part;                       // index into program->part[]
+    const char *rd;                     // read pointer into current part
+    GCodeState_t gm;                    // interpreter model state
+    float g92_offset[AXES];             // G92 origin offset (mm)
+    float position[AXES];               // end of the last move interpreted (mm)
+    bool verbose;
+    bool coalesce;                      // route feeds through mp_coalesce_aline()
+    bool lookahead;                     // route moves through mp_lookahead_aline()
+    bool segment_dump;                  // print the velocity of each segment
+    bool ideal;                         // record blocks and solve the time-optimal profile
+    bool preplan;                       // queue moves with the velocities from _get_preplan()
+    bool trace;                         // print the segment trace and check it against the limits
+    uint32_t preplan_index;             // ideal_block[] of the next move queued
+
+    // simulated time
+    double sim_time;                    // simulated machine time (minutes)
+    double sim_ms_carry;                // fraction of a ms not yet applied to SysTickTimer
+
+    // statistics
+    uint32_t lines;
+    uint32_t blocks;
+    uint32_t segments;
+    uint32_t commands;
+    uint32_t blocks_run;
+    uint64_t iterations;
+    uint32_t iterations_max;
+    uint64_t meet_iterations;
+    int32_t meet_iterations_max;
+    double plan_seconds;                // host time in aline, planner callback and forward planning
+    double exec_seconds;                // host time in exec (segment generation)
+    uint32_t ideal_blocks;              // blocks recorded in ideal_block[]
+
+    // segment trace (-r) - the last two segments are kept for the finite differences
+    double steps[MOTORS];               // steps loaded so far
+    uint8_t samples;                    // segments in the history since motion last stopped
+    double midpoint[2];                 // simulated time at the middle of the last segments
+    float velocity;                     // of the last segment
+    float accel;                        // between the last two segments
+    float jerk[2];                      // block jerk of the last segments
+    float vmax[2];                      // block cruise_vmax of the last segments
+    float ratio_velocity;               // largest share of the limits seen
+    float ratio_accel;
+    float ratio_jerk;
+    uint32_t violations;
+
+    // snapshot of the current run block - it is cleared when it is freed
+    mpBuf_t *r;
+    mpBuf_t r_copy;
+    mpBufCold_t r_cold;                 // ...and its cold side
+} simRun_t;
+
+static simRun_t run;
+
+// Planner limits of each block as it ran, for the time-optimal solution (-t)
+
+typedef struct simBlock {
+    float length;
+    float cruise_vmax;
+    float exit_vmax;                    // 0 if the block is followed by a command
+    float jerk;
+    float q_recip_2_sqrt_j;
+    float entry_velocity;               // solved by _get_ideal_time()
+    float exit_velocity;                // solved by _get_ideal_time()
+    float preplan_exit;                 // solved by _get_preplan()
+    uint8_t preplan_horizon;            // solved by _get_preplan()
+} simBlock_t;
+
+static simBlock_t ideal_block[SIM_IDEAL_BLOCKS];
+static uint32_t ideal_blocks;           // blocks recorded by the last -t run
+
+static double _elapsed(sim_clock::time_point start)
+{
+    return (std::chrono::duration<double>(sim_clock::now() - start).count());
+}
+
+/*
+ * _advance_clock() - advance simulated time and the SysTick ms counter with it
+ */
+
+static void _advance_clock(double minutes)
+{
+    run.sim_time += minutes;
+    run.sim_ms_carry += minutes * MICROSECONDS_PER_MINUTE / 1000;
+    uint32_t ms = (uint32_t)run.sim_ms_carry;
+    run.sim_ms_carry -= ms;
+    Motate::SysTickTimer.advance(ms);
+}
+
+/*
+ * _read_line() - copy the next line of the program into buf. Returns false at end of program
+ */
+
+static bool _read_line(char *buf)
+{
+    while (run.rd == NULL || *run.rd == '\0') {
+        if (run.part >= 2 || run.program->part[run.part] == NULL) {
+            return (false);
+        }
+        run.rd = run.program->part[run.part++];
+    }
+    uint8_t i = 0;
+    while (*run.rd != '\0' && *run.rd != '\n') {
+        if (i < SIM_LINE_LEN-1) {
+            buf[i++] = *run.rd;
+        }
+        run.rd++;
+    }
+    if (*run.rd == '\n') {
+        run.rd++;
+    }
+    buf[i] = '\0';
+    return (true);
+}
+
+/*
+ * _interpret_line() - minimal Gcode interpreter. Queues at most one aline per line
+ */
+
+static int8_t _get_axis(const char c)
+{
+    switch (c) {
+        case 'X': return (AXIS_X);
+        case 'Y': return (AXIS_Y);
+        case 'Z': return (AXIS_Z);
+        case 'A': return (AXIS_A);
+        case 'B': return (AXIS_B);
+        case 'C': return (AXIS_C);
+    }
+    return (-1);
+}
+
+static stat_t _interpret_line(char *buf)
+{
+    float value[AXES];
+    bool flag[AXES] = { false, false, false, false, false, false };
+    bool motion = false;
+    bool set_origin = false;
+    char *p = buf;
+
+    while (*p != '\0') {
+        char c = toupper(*p++);
+        if (c == '(') {                                     // skip comment
+            while (*p != '\0' && *p++ != ')');
+            continue;
+        }
+        if (c == ';' || c == '%') {                         // comment to end of line
+            break;
+        }
+        if (!isalpha(c)) {
+            continue;
+        }
+        char *end;
+        float number = strtof(p, &end);
+        if (end == p) {
+            return (STAT_BAD_NUMBER_FORMAT);
+        }
+        p = end;
+
+        int8_t axis = _get_axis(c);
+        if (axis >= 0) {
+            value[axis] = number;
+            flag[axis] = true;
+            motion = true;
+            continue;
+        }
+        switch (c) {
+            case 'N': { run.gm.linenum = (uint32_t)number; break; }
+            case 'F': { run.gm.feed_rate = number; break; }
+            case 'G': {
+                switch ((int)(number * 10 + 0.5)) {            // G code x 10, to catch G92.1 etc.
+                    case 0:   { run.gm.motion_mode = MOTION_MODE_STRAIGHT_TRAVERSE; break; }
+                    case 10:  { run.gm.motion_mode = MOTION_MODE_STRAIGHT_FEED; break; }
+                    case 200: { run.gm.units_mode = INCHES; break; }
+                    case 210: { run.gm.units_mode = MILLIMETERS; break; }
+                    case 900: { run.gm.distance_mode = ABSOLUTE_DISTANCE_MODE; break; }
+                    case 910: { run.gm.distance_mode = INCREMENTAL_DISTANCE_MODE; break; }
+                    case 920: { set_origin = true; break; }
+                    default: break;                         // G17, G43 etc. don't matter here
+                }
+                break;
+            }
+            default: break;                                 // M, S, T, H, P...
+        }
+    }
+    if (!motion) {
+        return (STAT_NOOP);
+    }
+
+    float units = (run.gm.units_mode == INCHES) ? MM_PER_INCH : 1;
+    if (set_origin) {                                       // G92 - no motion
+        for (uint8_t axis = 0; axis < AXES; axis++) {
+            if (flag[axis]) {
+                run.g92_offset[axis] = run.gm.target[axis] - value[axis] * units;
+            }
+        }
+        return (STAT_NOOP);
+    }
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        if (!flag[axis]) {
+            continue;
+        }
+        if (run.gm.distance_mode == INCREMENTAL_DISTANCE_MODE) {
+            run.gm.target[axis] += value[axis] * units;
+        } else {
+            run.gm.target[axis] = value[axis] * units + run.g92_offset[axis];
+        }
+    }
+    if ((run.gm.motion_mode == MOTION_MODE_STRAIGHT_FEED) && fp_ZERO(run.gm.feed_rate)) {
+        return (STAT_GCODE_FEEDRATE_NOT_SPECIFIED);
+    }
+    GCodeState_t gm = run.gm;
+    gm.feed_rate *= units;                                  // the planner works in mm/min
+
+    stat_t status;
+    if (run.preplan) {
+        const simBlock_t *b = &ideal_block[min(run.preplan_index, ideal_blocks-1)];
+        status = mp_aline_planned(&gm, b->cruise_vmax, b->preplan_exit, b->preplan_horizon);
+        if (status == STAT_OK) {
+            run.preplan_index++;
+        }
+    } else if (run.lookahead) {
+        cm.cycle_state = CYCLE_MACHINING;                   // as cm_cycle_start() does
+        status = mp_lookahead_aline(&gm, run.position);
+    } else if (run.coalesce && (gm.motion_mode == MOTION_MODE_STRAIGHT_FEED)) {
+        status = mp_coalesce_aline(&gm, run.position);
+    } else {
+        status = mp_aline(&gm);
+    }
+    copy_vector(run.position, gm.target);                   // as cm_finalize_move() does
+    return (status);
+}
+
+/*
+ * _feed_line() - main loop: read, interpret and queue one line. Returns false at end of program
+ */
+
+static bool _feed_line()
+{
+    char buf[SIM_LINE_LEN];
+
+    if (!_read_line(buf)) {
+        if (mp_lookahead_is_synced()) {
+            mp_coalesce_flush();                            // end of program queues what is held
+        }
+        return (false);
+    }
+    run.lines++;
+    run.gm.linenum = run.lines;                             // N words override this
+    sim_clock::time_point start = sim_clock::now();
+    stat_t status = _interpret_line(buf);
+    run.plan_seconds += _elapsed(start);
+
+    if (status == STAT_OK) {
+        run.blocks++;
+    } else if ((status != STAT_NOOP) && (status != STAT_MINIMUM_LENGTH_MOVE)) {
+        fprintf(stderr, "%s line %lu: error %d: %s\n", run.program->name, (unsigned long)run.lines, (int)status, buf);
+    }
+    return (true);
+}
+
+/*
+ * _trace_segment() - print a segment as it is loaded and check it against the block limits
+ *
+ *  The trace holds what crossed st_prep_line(): segment time (us), velocity and the position
+ *  of each motor from the steps so far (mm or degrees). It is checked as it is printed.
+ *  Segment velocities are averages over the segment, so the acceleration and jerk are taken
+ *  from differences between segment midpoints. The limits are those of the blocks involved:
+ *  the block's cruise_vmax for velocity, its jerk, and for acceleration the peak that jerk
+ *  reaches ramping to cruise_vmax from a stop (sqrt(jerk * cruise_vmax)).
+ */
+
+static void _check_limit(float *ratio, const float value, const float limit, const char *what)
+{
+    float r = fabs(value) / limit;
+    *ratio = max(*ratio, r);
+    if (r > 1 + SIM_LIMIT_TOLERANCE) {
+        if (run.violations++ == 0) {
+            fprintf(stderr, "%s segment %lu: %s %.3f over limit %.3f\n", run.program->name,
+                    (unsigned long)run.segments, what, fabs(value), limit);
+        }
+    }
+}
+
+static void _trace_segment(const uint8_t slot)
+{
+    const float *steps = sim.segment_steps[slot];
+    const float v = sim.segment_velocity[slot];
+    printf("%s %lu %.3f %.4f", run.program->name, (unsigned long)run.segments,
+           sim.segment_time[slot] * MICROSECONDS_PER_MINUTE, v);
+    for (uint8_t motor = 0; motor < MOTORS; motor++) {
+        run.steps[motor] += steps[motor];
+        printf(" %.4f", run.steps[motor] * st_cfg.mot[motor].units_per_step);
+    }
+    printf("\n");
+
+    double midpoint = run.sim_time + sim.segment_time[slot] / 2;
+    float jerk = sim.segment_jerk[slot];
+    float vmax = sim.segment_vmax[slot];
+    _check_limit(&run.ratio_velocity, v, vmax, "velocity");
+    if (run.samples >= 1) {
+        float accel = (v - run.velocity) / (midpoint - run.midpoint[0]);
+        float a_jerk = max(jerk, run.jerk[0]);
+        _check_limit(&run.ratio_accel, accel, sqrt(a_jerk * max(vmax, run.vmax[0])), "acceleration");
+        if (run.samples >= 2) {
+            float j = (accel - run.accel) / ((midpoint - run.midpoint[1]) / 2);
+            _check_limit(&run.ratio_jerk, j, max(a_jerk, run.jerk[1]), "jerk");
+        }
+        run.accel = accel;
+    }
+    run.midpoint[1] = run.midpoint[0];
+    run.jerk[1] = run.jerk[0];
+    run.vmax[1] = run.vmax[0];
+    run.midpoint[0] = midpoint;
+    run.velocity = v;
+    run.jerk[0] = jerk;
+    run.vmax[0] = vmax;
+    run.samples = min(run.samples + 1, 2);
+}
+
+/*
+ * _track_run_block() - collect statistics for each block as it leaves the runtime
+ */
+
+static void _record_block(const mpBuf_t *bf)
+{
+    if (bf->block_type != BLOCK_TYPE_ALINE) {
+        if (run.ideal_blocks > 0) {
+            ideal_block[run.ideal_blocks-1].exit_vmax = 0;  // commands stop motion
+        }
+        return;
+    }
+    if (run.ideal_blocks < SIM_IDEAL_BLOCKS) {
+        simBlock_t *b = &ideal_block[run.ideal_blocks];
+        b->length = bf->length;
+        b->cruise_vmax = bf->cruise_vmax;
+        b->exit_vmax = bf->exit_vmax;
+        b->jerk = bf->jerk;
+        b->q_recip_2_sqrt_j = bf->q_recip_2_sqrt_j;
+    }
+    run.ideal_blocks++;                             // counts past the end so overflow can be reported
+}
+
+static void _finalize_block(const mpBuf_t *bf, const mpBufCold_t *cold)
+{
+    if (run.ideal) {
+        _record_block(bf);
+    }
+    if (bf->block_type != BLOCK_TYPE_ALINE) {
+        return;
+    }
+    run.blocks_run++;
+    run.iterations += cold->iterations;
+    run.iterations_max = max((uint32_t)cold->iterations, run.iterations_max);
+    if (cold->meet_iterations > 0) {
+        run.meet_iterations += cold->meet_iterations;
+        run.meet_iterations_max = max((int32_t)cold->meet_iterations, run.meet_iterations_max);
+    }
+    if (run.verbose) {
+        printf("%6lu  len %8.3f  vmax %9.3f  cruise %9.3f  exit %9.3f  exit_vmax %9.3f  time %8.3fms  iter %d  meet %d\n",
+               (unsigned long)cold->linenum, bf->length, bf->cruise_vmax,
+               bf->cruise_velocity, bf->exit_velocity, bf->exit_vmax, bf->block_time * 60000, cold->iterations, cold->meet_iterations);
+    }
+}
+
+static void _track_run_block()
+{
+    if (run.r != mb.r) {
+        if (run.r != NULL) {
+            _finalize_block(&run.r_copy, &run.r_cold);
+        }
+        run.r = mb.r;
+    }
+    if (mb.r->buffer_state != MP_BUFFER_EMPTY) {
+        run.r_copy = *mb.r;
+        run.r_cold = *mb.r->cold;
+    }
+}
+
+/*
+ * _get_ideal_time() - solve the time-optimal velocity profile over the whole program
+ *
+ *  This is the global sweep the planner would run if it could see the entire program at
+ *  once: a backward pass sets each entry to the highest velocity that can still brake to
+ *  the exit, a forward pass lowers each exit to what can be reached from the entry, and
+ *  each block then takes the fastest head / body / tail that fits between them. It uses
+ *  the planner's own block limits (exit_vmax, cruise_vmax, jerk) and S-curve model (zero
+ *  acceleration at block boundaries, mp_get_target_length()), so the difference from the
+ *  simulated cycle is time lost to the planner itself - lookahead depth, hint choices and
+ *  zoid approximations - not to the motion model. Returns minutes, or -1 on overflow.
+ */
+
+static float _get_block_time(mpBuf_t *bf, const simBlock_t *b, const float v_0, const float v_1)
+{
+    float v_c = b->cruise_vmax;
+    float lo = max(v_0, v_1);
+    float head = mp_get_target_length(v_0, v_c, bf);
+    float tail = mp_get_target_length(v_1, v_c, bf);
+
+    if (head + tail > b->length) {                  // no room for a body - find the peak by bisection
+        float hi = v_c;
+        for (uint8_t i = 0; i < 40; i++) {
+            v_c = (lo + hi) / 2;
+            if (mp_get_target_length(v_0, v_c, bf) + mp_get_target_length(v_1, v_c, bf) > b->length) {
+                hi = v_c;
+            } else {
+                lo = v_c;
+            }
+        }
+        v_c = lo;
+        head = mp_get_target_length(v_0, v_c, bf);
+        tail = mp_get_target_length(v_1, v_c, bf);
+    }
+    float time = max(b->length - head - tail, (float)0) / v_c;
+    if (head > 0) {
+        time += 2 * head / (v_0 + v_c);
+    }
+    if (tail > 0) {
+        time += 2 * tail / (v_1 + v_c);
+    }
+    return (time);
+}
+
+static double _get_ideal_time()
+{
+    if ((run.ideal_blocks == 0) || (run.ideal_blocks > SIM_IDEAL_BLOCKS)) {
+        return (-1);
+    }
+    mpBuf_t bf;                                     // carries the jerk terms into the zoid functions
+    memset(&bf, 0, sizeof(bf));
+
+    float v = 0;                                    // backward pass: the program ends stopped
+    for (int32_t i = run.ideal_blocks-1; i >= 0; i--) {
+        simBlock_t *b = &ideal_block[i];
+        b->exit_velocity = (i == (int32_t)run.ideal_blocks-1) ? 0 : min(b->exit_vmax, v);
+        bf.jerk = b->jerk;
+        v = min(mp_get_target_velocity(b->exit_velocity, b->length, &bf), b->cruise_vmax);
+    }
+    double time = 0;
+    v = 0;                                          // forward pass: the program starts stopped
+    for (uint32_t i = 0; i < run.ideal_blocks; i++) {
+        simBlock_t *b = &ideal_block[i];
+        bf.jerk = b->jerk;
+        bf.q_recip_2_sqrt_j = b->q_recip_2_sqrt_j;
+        b->entry_velocity = v;
+        b->exit_velocity = min3(b->exit_velocity, mp_get_target_velocity(v, b->length, &bf), b->cruise_vmax);
+        time += _get_block_time(&bf, b, b->entry_velocity, b->exit_velocity);
+        v = b->exit_velocity;
+    }
+    return (time);
+}
+
+/*
+ * _get_preplan() - solve the exit velocities and horizons a host would stream
+ *
+ *  As the backward pass of _get_ideal_time(), but each exit is also limited to what can
+ *  stop within the next PREPLAN_HORIZON_MAX blocks, so no block has to wait for more than
+ *  that many behind it. The horizon is then the number of blocks it takes to stop from
+ *  that exit. The forward pass is left to the exec, as with any other block.
+ */
+
+static void _get_preplan()
+{
+    mpBuf_t bf;
+    memset(&bf, 0, sizeof(bf));
+
+    float v = 0;
+    for (int32_t i = ideal_blocks-1; i >= 0; i--) {
+        simBlock_t *b = &ideal_block[i];
+        float stop = 0;                             // fastest exit that stops within the horizon
+        for (int32_t k = min(i + PREPLAN_HORIZON_MAX, (int32_t)ideal_blocks-1); k > i; k--) {
+            bf.jerk = ideal_block[k].jerk;
+            stop = min(mp_get_target_velocity(stop, ideal_block[k].length, &bf), ideal_block[k].cruise_vmax);
+            stop = min(stop, ideal_block[k-1].exit_vmax);
+        }
+        b->preplan_exit = (i == (int32_t)ideal_blocks-1) ? 0 : min3(b->exit_vmax, v, stop);
+        bf.jerk = b->jerk;
+        v = min(mp_get_target_velocity(b->preplan_exit, b->length, &bf), b->cruise_vmax);
+
+        uint8_t horizon = 0;
+        for (float u = b->preplan_exit; (u > 0) && (horizon < PREPLAN_HORIZON_MAX); ) {
+            const simBlock_t *n = &ideal_block[i + ++horizon];
+            bf.q_recip_2_sqrt_j = n->q_recip_2_sqrt_j;
+            u = (mp_get_target_length(0, u, &bf) > n->length) ? mp_get_decel_velocity(u, n->length, &bf) : 0;
+        }
+        b->preplan_horizon = horizon;
+    }
+}
+
+/*
+ * _run_program() - run one program to completion
+ */
+
+static stat_t _run_program(const simProgram_t *program, bool verbose, bool coalesce, bool lookahead, bool segment_dump, bool curvature, bool ideal,
+                           bool preplan, bool trace)
+{
+    memset(&run, 0, sizeof(run));
+    run.program = program;
+    run.verbose = verbose;
+    run.ideal = ideal;
+    run.preplan = preplan;
+    run.coalesce = coalesce;
+    run.lookahead = lookahead;
+    run.segment_dump = segment_dump;
+    run.trace = trace;
+    run.gm.reset();
+    run.gm.units_mode = GCODE_DEFAULT_UNITS;
+    run.gm.path_control = PATH_CONTINUOUS;
+    run.gm.feed_rate_mode = UNITS_PER_MINUTE_MODE;
+    run.gm.motion_mode = MOTION_MODE_STRAIGHT_FEED;
+
+    Motate::SysTickTimer._ticks = 0;
+    sim_canonical_machine_init();
+    cm.junction_curvature_enable = curvature;               // config_init() normally loads this
+    sim_stepper_init();
+    kn_config_changed();                                    // config_init() normally does this via the setters
+    planner_init();
+    memset(&sim, 0, sizeof(sim));
+    coal.enable = coalesce;                                 // config_init() normally loads these
+    coal.segment_length = COALESCE_SEGMENT_LENGTH;
+    coal.tolerance = COALESCE_TOLERANCE;
+    coal.length_max = COALESCE_LENGTH_MAX;
+    look.enable = lookahead;
+
+    bool more_input = true;
+    uint32_t idle_passes = 0;
+    sim_clock::time_point start = sim_clock::now();
+
+    while (true) {
+        bool progress = false;
+
+        // loader: hand the oldest prepped segment to the "steppers" and let it play out
+        if (!sim_prep_is_empty()) {
+            uint8_t slot = st_pre.read & PREP_BUFFER_MASK;
+            stPrepSegment_t *seg = &st_pre.seg[slot];
+            if (seg->block_type == BLOCK_TYPE_ALINE) {
+                run.segments++;
+                if (run.segment_dump) {
+                    printf("%s %lu %.6f\n", program->name, (unsigned long)run.segments, sim.segment_velocity[slot]);
+                }
+                if (run.trace) {
+                    _trace_segment(slot);
+                }
+                _advance_clock(sim.segment_time[slot]);
+            } else if (seg->block_type == BLOCK_TYPE_DWELL) {
+                run.samples = 0;                            // motion has stopped
+                _advance_clock(sim.segment_time[slot]);
+            } else if (seg->block_type == BLOCK_TYPE_COMMAND) {
+                run.samples = 0;
+                run.commands++;
+                mp_runtime_command(seg->bf);
+            }
+            seg->block_type = BLOCK_TYPE_NULL;
+            st_pre.read++;
+            progress = true;
+        }
+
+        // forward planner
+        if (sim.fwd_plan_requested) {
+            sim.fwd_plan_requested = false;
+            sim_clock::time_point t0 = sim_clock::now();
+            mp_forward_plan();
+            run.plan_seconds += _elapsed(t0);
+            progress = true;
+        }
+
+        // exec: runs ahead of the loader until the prep ring is full
+        while (!sim_prep_is_full()) {
+            _track_run_block();
+            sim_clock::time_point t0 = sim_clock::now();
+            stat_t status = mp_exec_move();
+            run.exec_seconds += _elapsed(t0);
+            if (status == STAT_NOOP) {
+                break;
+            }
+            st_pre.write++;
+            progress = true;
+        }
+
+        // main loop
+        sim_clock::time_point t0 = sim_clock::now();
+        mp_lookahead_callback();
+        mp_coalesce_callback();
+        mp_planner_callback();
+        run.plan_seconds += _elapsed(t0);
+
+        if (more_input && (!mp_planner_is_full() || mp_lookahead_has_room())) {
+            more_input = _feed_line();
+            progress = true;
+        }
+
+        if (!more_input && (mb.buffers_available == PLANNER_BUFFER_POOL_SIZE) && (look.count == 0) &&
+            (sim_prep_is_empty()) && !sim.fwd_plan_requested) {
+            break;                                          // done
+        }
+        if (progress) {
+            idle_passes = 0;
+        } else {
+            _advance_clock(1.0 / 60000);                    // nothing to do - let a ms go by
+            if (++idle_passes > SIM_STALL_PASSES) {
+                fprintf(stderr, "%s: planner stalled at line %lu\n", program->name, (unsigned long)run.lines);
+                return (STAT_INTERNAL_ERROR);
+            }
+        }
+    }
+    _track_run_block();
+    if (run.r != NULL && run.r != mb.r) {
+        _finalize_block(&run.r_copy, &run.r_cold);
+    }
+    double total_seconds = _elapsed(start);
+
+    printf("%-12s lines %6lu  blocks %6lu  merged %6lu  segments %7lu  cycle %8.2fs  "
+           "plan %8.0f blk/s  exec %9.0f seg/s  iter %.2f/%lu  meet %.2f/%ld  host %.3fs\n",
+           program->name, (unsigned long)run.lines, (unsigned long)run.blocks, (unsigned long)coal.merged, (unsigned long)run.segments,
+           run.sim_time * 60,
+           (run.plan_seconds > 0) ? run.blocks / run.plan_seconds : 0,
+           (run.exec_seconds > 0) ? run.segments / run.exec_seconds : 0,
+           (run.blocks_run > 0) ? (double)run.iterations / run.blocks_run : 0, (unsigned long)run.iterations_max,
+           (run.blocks_run > 0) ? (double)run.meet_iterations / run.blocks_run : 0, (long)run.meet_iterations_max,
+           total_seconds);
+
+    if (run.lookahead) {
+        printf("%-12s held %lu moves beyond the planner queue\n", program->name, (unsigned long)look.held);
+    }
+    if (run.preplan) {
+        printf("%-12s preplanned %lu blocks  rejected %lu\n", program->name,
+               (unsigned long)mp.preplan_blocks, (unsigned long)mp.preplan_rejects);
+    }
+    if (run.ideal) {
+        ideal_blocks = run.ideal_blocks;
+        sim_clock::time_point t0 = sim_clock::now();
+        double ideal_time = _get_ideal_time();
+        double sweep_seconds = _elapsed(t0);
+        if (ideal_time < 0) {
+            printf("%-12s ideal n/a (%lu blocks, %d recorded)\n", program->name, (unsigned long)run.ideal_blocks, SIM_IDEAL_BLOCKS);
+        } else {
+            printf("%-12s ideal %8.2fs  lost %6.2fs (%.2f%%)  sweep %lu blocks in %.3fms\n", program->name,
+                   ideal_time * 60, (run.sim_time - ideal_time) * 60, (run.sim_time / ideal_time - 1) * 100,
+                   (unsigned long)run.ideal_blocks, sweep_seconds * 1000);
+        }
+    }
+    if (run.trace) {
+        printf("%-12s limits  velocity %.3f  accel %.3f  jerk %.3f of max  violations %lu\n", program->name,
+               run.ratio_velocity, run.ratio_accel, run.ratio_jerk, (unsigned long)run.violations);
+    }
+    if (run.blocks_run != run.blocks - coal.merged) {
+        fprintf(stderr, "%s: %lu blocks queued (%lu merged) but %lu run\n", program->name,
+                (unsigned long)run.blocks, (unsigned long)coal.merged, (unsigned long)run.blocks_run);
+        return (STAT_INTERNAL_ERROR);
+    }
+    if (sim.exceptions || run.violations) {
+        return (STAT_INTERNAL_ERROR);
+    }
+    return (STAT_OK);
+}
+
+/*
+ * _run_programs() - run a program, and again preplanned for -p. Returns the runs that failed
+ */
+
+static int _run_programs(const simProgram_t *program, bool verbose, bool coalesce, bool lookahead, bool segment_dump, bool curvature, bool ideal,
+                         bool preplan, bool trace)
+{
+    int errors = 0;
+    if (_run_program(program, verbose, coalesce, lookahead, segment_dump, curvature, ideal || preplan, false, trace) != STAT_OK) {
+        errors++;
+    }
+    if (preplan) {
+        if ((ideal_blocks == 0) || (ideal_blocks > SIM_IDEAL_BLOCKS)) {
+            fprintf(stderr, "%s: too many blocks to preplan\n", program->name);
+            return (errors + 1);
+        }
+        _get_preplan();
+        if (_run_program(program, verbose, false, false, segment_dump, curvature, false, true, trace) != STAT_OK) {
+            errors++;
+        }
+    }
+    return (errors);
+}
+
+/*
+ * main()
+ */
+
+int main(int argc, char *argv[])
+{
+    bool verbose = false;
+    bool coalesce = false;
+    bool lookahead = false;
+    bool segment_dump = false;
+    bool curvature = false;
+    bool ideal = false;
+    bool preplan = false;
+    bool trace = false;
+    bool selected = false;
+    int errors = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0) {
+            verbose = true;
+        }
+        if (strcmp(argv[i], "-c") == 0) {
+            coalesce = true;
+        }
+        if (strcmp(argv[i], "-l") == 0) {
+            lookahead = true;
+        }
+        if (strcmp(argv[i], "-s") == 0) {
+            segment_dump = true;
+        }
+        if (strcmp(argv[i], "-j") == 0) {
+            curvature = true;
+        }
+        if (strcmp(argv[i], "-t") == 0) {
+            ideal = true;
+        }
+        if (strcmp(argv[i], "-p") == 0) {
+            preplan = true;
+        }
+        if (strcmp(argv[i], "-r") == 0) {
+            trace = true;
+        }
+    }
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] == '-') {
+            continue;
+        }
+        selected = true;
+        uint8_t p;
+        for (p = 0; p < SIM_PROGRAMS; p++) {
+            if (strcmp(argv[i], programs[p].name) == 0) {
+                break;
+            }
+        }
+        if (p == SIM_PROGRAMS) {
+            fprintf(stderr, "unknown program: %s\n", argv[i]);
+            errors++;
+            continue;
+        }
+        errors += _run_programs(&programs[p], verbose, coalesce, lookahead, segment_dump, curvature, ideal, preplan, trace);
+    }
+    if (!selected) {
+        for (uint8_t p = 0; p < SIM_PROGRAMS; p++) {
+            errors += _run_programs(&programs[p], verbose, coalesce, lookahead, segment_dump, curvature, ideal, preplan, trace);
+        }
+    }
+    return (errors ? 1 : 0);
+}
@@ -0,0 +1,302 @@
+/*
+ * sim_stubs.cpp - stand-ins for the firmware modules linked around the planner
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ * Copyright (c) 2017 Robert Giseburt
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* The planner simulator links the real planner.cpp, plan_line.cpp, plan_zoid.cpp,
+ * plan_exec.cpp, kinematics.cpp and util.cpp. Everything else those files call into
+ * is replaced here with the smallest thing that behaves the same way as far as the
+ * planner can tell:
+ *
+ *  - the canonical machine is reduced to the cm singleton and a few state setters
+ *  - the stepper layer keeps the st_pre prep ring protocol exactly, but "loading" a
+ *    segment just advances the simulated clock (see the loader in sim_main.cpp)
+ *  - reports, JSON and encoders are no-ops
+ */
+
+#include "g2core.h"
+#include "config.h"
+#include "controller.h"
+#include "canonical_machine.h"
+#include "planner.h"
+#include "stepper.h"
+#include "encoder.h"
+#include "gpio.h"
+#include "spindle.h"
+#include "report.h"
+#include "binary_parser.h"
+#include "telemetry.h"
+#include "motion_link.h"
+#include "trace.h"
+#include "json_parser.h"
+#include "text_parser.h"
+#include "util.h"
+#include "sim.h"
+
+/**** Allocations normally made by the modules that are not linked ****/
+
+namespace Motate {
+    SysTickTimer_t SysTickTimer;
+}
+
+cmSingleton_t cm;
+controller_t cs;
+nvList_t nvl;
+stat_t status_code;
+stConfig_t st_cfg;
+stPrepSingleton_t st_pre;
+
+simSingleton_t sim;
+
+/**** Canonical machine ****/
+
+void sim_canonical_machine_init()
+{
+    memset(&cm, 0, sizeof(cm));
+    cm.junction_integration_time = JUNCTION_INTEGRATION_TIME;
+    cm.gmx.mfo_factor = FEED_OVERRIDE_FACTOR;
+    cm.gmx.mto_factor = TRAVERSE_OVERRIDE_FACTOR;
+    cm.am = MODEL;
+    cm.gm.reset();
+
+    // identity rotation matrix, as cm_init() would leave it
+    cm.rotation_matrix[0][0] = 1.0;
+    cm.rotation_matrix[1][1] = 1.0;
+    cm.rotation_matrix[2][2] = 1.0;
+
+    const float vm[] = { X_VELOCITY_MAX, Y_VELOCITY_MAX, Z_VELOCITY_MAX, A_VELOCITY_MAX, B_VELOCITY_MAX, C_VELOCITY_MAX };
+    const float fr[] = { X_FEEDRATE_MAX, Y_FEEDRATE_MAX, Z_FEEDRATE_MAX, A_FEEDRATE_MAX, B_FEEDRATE_MAX, C_FEEDRATE_MAX };
+    const float jm[] = { X_JERK_MAX, Y_JERK_MAX, Z_JERK_MAX, A_JERK_MAX, B_JERK_MAX, C_JERK_MAX };
+    const float jh[] = { X_JERK_HIGH_SPEED, Y_JERK_HIGH_SPEED, Z_JERK_HIGH_SPEED,
+                         A_JERK_HIGH_SPEED, B_JERK_HIGH_SPEED, C_JERK_HIGH_SPEED };
+
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        cm.a[axis].axis_mode = AXIS_STANDARD;
+        cm.a[axis].velocity_max = vm[axis];
+        cm.a[axis].recip_velocity_max = 1/vm[axis];
+        cm.a[axis].feedrate_max = fr[axis];
+        cm.a[axis].recip_feedrate_max = 1/fr[axis];
+        cm.a[axis].jerk_high = jh[axis];
+        cm.a[axis].recip_jerk_high = 1/jh[axis];
+        cm_set_axis_jerk(axis, jm[axis]);
+    }
+}
+
+static const float _junction_accel_multiplier = sqrt(3.0)/10.0;   // same as canonical_machine.cpp
+
+void cm_set_axis_jerk(const uint8_t axis, const float jerk)
+{
+    float T = cm.junction_integration_time / 1000.0;
+    cm.a[axis].jerk_max = jerk;
+    cm.a[axis].recip_jerk_max = 1/jerk;
+    cm.a[axis].max_junction_accel = _junction_accel_multiplier * T * T * (jerk * JERK_MULTIPLIER);
+}
+
+void cm_set_motion_state(const cmMotionState motion_state)
+{
+    cm.motion_state = motion_state;
+
+    switch (motion_state) {
+        case (MOTION_STOP):     { ACTIVE_MODEL = MODEL; break; }
+        case (MOTION_PLANNING): { ACTIVE_MODEL = RUNTIME; break; }
+        case (MOTION_RUN):      { ACTIVE_MODEL = RUNTIME; break; }
+        case (MOTION_HOLD):     { ACTIVE_MODEL = RUNTIME; break; }
+    }
+}
+
+void cm_cycle_end()                 // reduced _exec_program_finalize()
+{
+    cm.cycle_state = CYCLE_OFF;
+    cm_set_motion_state(MOTION_STOP);
+}
+
+void cm_abort_arc() {}
+void cm_abort_drilling() {}
+void cm_cycle_start() {}
+void cm_set_model_target(const float target[], const bool flag[]) {}   // G5 is not run by the sim
+void cm_set_work_offsets(GCodeState_t *gcode_state) {}
+void cm_set_position(const uint8_t axis, const float position) {}
+void cm_finalize_move() {}
+stat_t cm_test_soft_limits(const float target[]) { return (STAT_OK); }
+stat_t cm_alarm(const stat_t status, const char *msg) { return (status); }
+
+stat_t cm_panic(const stat_t status, const char *msg)
+{
+    fprintf(stderr, "PANIC %d: %s\n", (int)status, msg);
+    exit(1);
+}
+
+/**** Stepper layer ****
+ *
+ *  These keep the prep ring protocol of stepper.cpp. The exec "interrupt" and the loader
+ *  "interrupt" are run by the scheduling loop in sim_main.cpp, which uses the two helpers
+ *  below. Prep functions fill the write slot; exec hands it to the loader on return.
+ */
+
+bool sim_prep_is_full() { return ((uint8_t)(st_pre.write - st_pre.read) > (PREP_BUFFERS - PREP_SLOTS_PER_SEGMENT)); }
+bool sim_prep_is_empty() { return (st_pre.write == st_pre.read); }
+static uint8_t _write_slot() { return (st_pre.write & PREP_BUFFER_MASK); }
+
+uint8_t st_prep_lines_queued()
+{
+    uint8_t lines = 0;
+    for (uint8_t i = st_pre.read; i != st_pre.write; i++) {
+        if (st_pre.seg[i & PREP_BUFFER_MASK].block_type == BLOCK_TYPE_ALINE) {
+            lines++;
+        }
+    }
+    return (lines);
+}
+
+stat_t st_prep_line(float travel_steps[], float following_error[], float segment_time)
+{
+    if ((uint8_t)(st_pre.write - st_pre.read) >= PREP_BUFFERS) {
+        return (cm_panic(STAT_INTERNAL_ERROR, "st_prep_line() prep sync error"));
+    } else if (isinf(segment_time)) {
+        return (cm_panic(STAT_PREP_LINE_MOVE_TIME_IS_INFINITE, "st_prep_line()"));
+    } else if (isnan(segment_time)) {
+        return (cm_panic(STAT_PREP_LINE_MOVE_TIME_IS_NAN, "st_prep_line()"));
+    }
+    uint8_t slot = _write_slot();
+    st_pre.seg[slot].block_type = BLOCK_TYPE_ALINE;
+    st_pre.seg[slot].dda_ticks = (int32_t)(segment_time * 60 * FREQUENCY_DDA);
+    sim.segment_time[slot] = segment_time;
+    sim.segment_velocity[slot] = mr.segment_velocity;
+    sim.segment_jerk[slot] = mb.r->jerk;
+    sim.segment_vmax[slot] = mb.r->cruise_vmax;
+    for (uint8_t motor = 0; motor < MOTORS; motor++) {
+        sim.segment_steps[slot][motor] = travel_steps[motor];
+    }
+    return (STAT_OK);
+}
+
+#if (KINEMATICS_MIDPOINT == 1)
+stat_t st_prep_line_split(float travel_steps_1[], float travel_steps_2[], float following_error[], float segment_time)
+{
+    static float no_error[MOTORS];
+    ritorno(st_prep_line(travel_steps_1, following_error, segment_time/2));
+    st_pre.write++;
+    return (st_prep_line(travel_steps_2, no_error, segment_time/2));
+}
+#endif
+
+void st_prep_null() {}
+
+void st_prep_command(void *bf)
+{
+    uint8_t slot = _write_slot();
+    st_pre.seg[slot].block_type = BLOCK_TYPE_COMMAND;
+    st_pre.seg[slot].bf = (mpBuf_t *)bf;
+}
+
+void st_prep_dwell(float microseconds)
+{
+    uint8_t slot = _write_slot();
+    st_pre.seg[slot].block_type = BLOCK_TYPE_DWELL;
+    sim.segment_time[slot] = microseconds / MICROSECONDS_PER_MINUTE;
+}
+
+void st_request_forward_plan() { sim.fwd_plan_requested = true; }
+void st_request_exec_move() {}
+void st_prep_laser_duty(float duty) {}
+float spindle_laser_duty(const float scale) { return (-1); }
+void spindle_inline_sync(const float speed, const int8_t control) {}
+cmSpindleton_t spindle;
+uint8_t gpio_get_function_input(const inputFunc function) { return (0); }
+void spindle_raster_start(const int8_t row, const float position[], const float length) {}
+float spindle_raster_power(const float position[], const float target[]) { return (1.0); }
+void spindle_raster_end(const int8_t row) {}
+bool gpio_sync_segment(const float length, uint16_t *set, uint16_t *clear) { return (false); }
+void gpio_sync_start(const void *block, const uint8_t first, const uint8_t count) {}
+void gpio_sync_end() {}
+float gpio_read_override_knob() { return (-1); }
+void st_prep_outputs(uint16_t set, uint16_t clear) {}
+void tlm_sample() {}
+mlnSingleton_t mln;
+void mln_send_segment(const float start[], const float target[], const float segment_time) {}
+stat_t mln_exec() { return (STAT_NOOP); }
+bool cm_get_at_temperature(const uint8_t heater) { return (true); }
+void trc_block(const mpBuf_t *bf) {}
+bool st_runtime_isbusy() { return (false); }    // loads complete instantly in simulated time
+
+void stepper_reset()
+{
+    st_pre.read = st_pre.write;
+    for (uint8_t i = 0; i < PREP_BUFFERS; i++) {
+        st_pre.seg[i].block_type = BLOCK_TYPE_NULL;
+    }
+}
+
+void sim_stepper_init()
+{
+    const uint8_t ma[] = { M1_MOTOR_MAP, M2_MOTOR_MAP, M3_MOTOR_MAP, M4_MOTOR_MAP, M5_MOTOR_MAP, M6_MOTOR_MAP };
+    const float sa[] = { M1_STEP_ANGLE, M2_STEP_ANGLE, M3_STEP_ANGLE, M4_STEP_ANGLE, M5_STEP_ANGLE, M6_STEP_ANGLE };
+    const float tr[] = { M1_TRAVEL_PER_REV, M2_TRAVEL_PER_REV, M3_TRAVEL_PER_REV,
+                         M4_TRAVEL_PER_REV, M5_TRAVEL_PER_REV, M6_TRAVEL_PER_REV };
+    const uint8_t mi[] = { M1_MICROSTEPS, M2_MICROSTEPS, M3_MICROSTEPS, M4_MICROSTEPS, M5_MICROSTEPS, M6_MICROSTEPS };
+
+    memset(&st_cfg, 0, sizeof(st_cfg));
+    memset(&st_pre, 0, sizeof(st_pre));
+    for (uint8_t m = 0; m < MOTORS; m++) {
+        st_cfg.mot[m].motor_map = ma[m];
+        st_cfg.mot[m].step_angle = sa[m];
+        st_cfg.mot[m].travel_rev = tr[m];
+        st_cfg.mot[m].microsteps = mi[m];
+        st_cfg.mot[m].units_per_step = (tr[m] * sa[m]) / (360 * mi[m]);
+        st_cfg.mot[m].steps_per_unit = 1/st_cfg.mot[m].units_per_step;
+    }
+    stepper_reset();
+}
+
+/**** Encoders - the simulated machine never loses a step ****/
+
+float en_read_encoder(const uint8_t motor) { return (mr.position_steps[motor]); }
+bool en_conveyor_is_present() { return (false); }   // tracking is not simulated
+int32_t en_read_conveyor() { return (0); }
+int32_t en_read_spindle() { return (0); }          // nor is spindle sync - G33 isn't in the test programs
+bool en_get_spindle_index(int32_t *counts) { return (false); }
+void en_clear_spindle_index() {}
+void en_set_encoder_steps(const uint8_t motor, const float steps) {}
+
+/**** Reports, messages and JSON - nothing to talk to ****/
+
+stat_t rpt_exception(stat_t status, const char *msg)
+{
+    fprintf(stderr, "exception %d: %s\n", (int)status, msg);
+    sim.exceptions++;
+    return (status);
+}
+
+stat_t sr_request_status_report(cmStatusReportRequest request_type) { return (STAT_OK); }
+void sr_mark_dirty(uint8_t flags) {}
+void qr_request_queue_report(int8_t buffers) {}
+void qr_block_start(const mpBuf_t *bf) {}
+void qr_block_end(const mpBuf_t *bf) {}
+void nv_get_nvObj(nvObj_t *nv) {}
+nvObj_t *nv_reset_exec_nv_list() { return (NULL); }
+stat_t json_parser(char *str, bool suppress_response) { return (STAT_OK); }
+stat_t json_parse_nv_list(nvObj_t *nv, uint8_t length, char *str) { return (STAT_OK); }
+stat_t json_execute_nv_list(nvObj_t *nv) { return (STAT_OK); }
+bool binary_is_move_frame(const char *frame) { return (false); }
+const cfgItem_t cfgArray[1] = {};
+void text_print(nvObj_t *nv, const char *format) {}
+void text_print_flt_units(nvObj_t *nv, const char *format, const char *units) {}
+stat_t set_ui8(nvObj_t *nv) { return (STAT_OK); }
+stat_t set_flt(nvObj_t *nv) { return (STAT_OK); }
+stat_t set_01(nvObj_t *nv) { return (STAT_OK); }
+int16_t xio_writeline(const char *buffer, bool only_to_muted) { return (0); }
+uint8_t cm_get_units_mode(const GCodeState_t *gcode_state) { return (MILLIMETERS); }
@@ -31,20 +31,29 @@
 #include "text_parser.h"        // #4
 
 #include "spindle.h"
+#include "spindle_vfd.h"
 #include "planner.h"
 #include "hardware.h"
 #include "pwm.h"
 #include "util.h"
+#include "gpio.h"
+#include "stepper.h"
+#include "MotateTimers.h"
 
 /**** Allocate structures ****/
 
 cmSpindleton_t spindle;
+spRasterSingleton_t raster;
 
 /**** Static functions ****/
 
 static void _exec_spindle_speed(float *value, bool *flag);
 static void _exec_spindle_control(float *value, bool *flag);
 static float _get_spindle_pwm (cmSpindleEnable enable, cmSpindleDir direction);
+static bool _spindle_waits_for_speed(void);
+static bool _spindle_at_speed(void);
+static stat_t _queue_at_speed_wait(void);
+static stat_t _exec_at_speed_wait(mpBuf_t *bf);
 
 /*
  * spindle_init()
@@ -65,23 +74,42 @@ void spindle_reset()
     bool flags[] = { 1,0,0,0,0,0 };
    _exec_spindle_speed(value, flags);
     cm_spindle_off_immediate();                 // turn spindle off
+    spindle.at_speed_waited = 0;
+    spindle.at_speed_fault = false;
+    spindle.resuming = false;
+    cm.gm.spindle_speed = 0;                    // moves carry the model's S and on/off
+    cm.gm.spindle_control = (spindle.laser_mode) ? SPINDLE_CONTROL_OFF : -1;
+    spindle_raster_reset();
 }
 
 /*
  * cm_set_spindle_speed() - queue the S parameter to the planner buffer
+ * cm_set_spindle_speed_inline() - set S for the block's own move to carry
  * _exec_spindle_speed() - spindle speed callback from planner queue
+ *
+ *  S is modal and is carried in the Gcode state of every move. Commands in the planner
+ *  queue force a stop, so a block with a feed move doesn't queue one: the runtime applies
+ *  the move's S as it starts the block (see spindle_inline_sync()). Blocks without a move
+ *  still queue a command, which keeps the model and runtime S in step.
  */
 
 stat_t cm_set_spindle_speed(float speed)
 {
 //    if (speed > cfg.max_spindle speed) { return (STAT_MAX_SPINDLE_SPEED_EXCEEDED);}
 
+    cm.gm.spindle_speed = speed;
     float value[AXES] = { speed, 0,0,0,0,0 };
     bool flags[] = { 1,0,0,0,0,0 };
     mp_queue_command(_exec_spindle_speed, value, flags);
     return (STAT_OK);
 }
 
+stat_t cm_set_spindle_speed_inline(float speed)
+{
+    cm.gm.spindle_speed = speed;
+    return (STAT_OK);
+}
+
 static void _exec_spindle_speed(float *value, bool *flag)
 {
     if (flag[0]) {
@@ -129,12 +157,122 @@ void cm_spindle_resume(float dwell_seconds)
     }
 }
 
+/*
+ * Spindle at-speed
+ *
+ *  An input with the spindle at speed function (a VFD at-speed signal, or a tach comparator)
+ *  replaces guessing at spin-up time. M3 and M4 queue a wait behind the spindle command that
+ *  the runtime polls every SPINDLE_AT_SPEED_POLL_MS, so the moves that follow start as soon
+ *  as the input comes on. Resuming from a feedhold restarts the spindle first and ends the
+ *  hold once the input is on, in place of the spdw dwell. Without such an input nothing
+ *  waits, as before. If the input doesn't come on within spat seconds the machine alarms.
+ *  A Modbus VFD (see spindle_vfd.h) reads back its speed, and that works like the input.
+ *
+ * cm_spindle_ready_to_resume() - restart a paused spindle ahead of the end of a hold
+ * spindle_callback()          - raise the alarm for a wait the runtime gave up on
+ * _spindle_waits_for_speed()  - true if there is an at-speed input or a Modbus VFD
+ * _spindle_at_speed()         - true if the input is on and the VFD is at speed, or neither is there
+ * _queue_at_speed_wait()      - queue a wait for the at-speed input
+ * _exec_at_speed_wait()       - runtime wait, re-run from exec until the input is on
+ */
+
+bool cm_spindle_ready_to_resume()
+{
+    if (cm.hold_state != FEEDHOLD_HOLD) {
+        return (true);                          // nothing to resume until the hold is complete
+    }
+    if (spindle.enable == SPINDLE_PAUSE) {
+        if (!_spindle_waits_for_speed() ||
+            (cm.machine_state == MACHINE_ALARM) || (!mp_has_runnable_buffer())) {
+            return (true);                      // cm_end_hold() deals with the spindle as usual
+        }
+        cm_spindle_resume(0);
+        spindle.resume_tick = SysTickTimer.getValue();
+        spindle.resuming = true;
+    }
+    if (spindle.resuming) {
+        if (_spindle_at_speed()) {
+            spindle.resuming = false;
+            return (true);
+        }
+        if ((spindle.at_speed_timeout > 0) &&
+            ((SysTickTimer.getValue() - spindle.resume_tick) > (uint32_t)(spindle.at_speed_timeout * 1000))) {
+            spindle.resuming = false;
+            cm_alarm(STAT_SPINDLE_NOT_AT_SPEED, "spindle resume");
+            return (true);                      // ending the hold in alarm stops the spindle
+        }
+        return (false);
+    }
+    return (true);
+}
+
+stat_t spindle_callback()
+{
+    if (spindle.at_speed_fault) {
+        spindle.at_speed_fault = false;
+        cm_alarm(STAT_SPINDLE_NOT_AT_SPEED, "spindle start");
+    }
+    return (STAT_OK);
+}
+
+static bool _spindle_waits_for_speed()
+{
+    return ((gpio_get_function_input(INPUT_FUNCTION_SPINDLE_AT_SPEED) != 0) || spindle_vfd_is_enabled());
+}
+
+static bool _spindle_at_speed()
+{
+    uint8_t input = gpio_get_function_input(INPUT_FUNCTION_SPINDLE_AT_SPEED);
+    if ((input != 0) && !gpio_read_input(input)) {
+        return (false);
+    }
+    return (!spindle_vfd_is_enabled() || spindle_vfd_at_speed());
+}
+
+static stat_t _queue_at_speed_wait()
+{
+    mpBuf_t *bf;
+
+    if ((bf = mp_get_write_buffer()) == NULL) {     // the controller leaves headroom for this
+        return(cm_panic(STAT_FAILED_GET_PLANNER_BUFFER, "_queue_at_speed_wait()"));
+    }
+    bf->block_type = BLOCK_TYPE_COMMAND;
+    bf->bf_func = _exec_at_speed_wait;
+    mp_commit_write_buffer(BLOCK_TYPE_COMMAND);     // must be final operation before exit
+    return (STAT_OK);
+}
+
+static stat_t _exec_at_speed_wait(mpBuf_t *bf)
+{
+    if (!_spindle_at_speed()) {
+        if ((spindle.at_speed_timeout <= 0) || (spindle.at_speed_waited < spindle.at_speed_timeout)) {
+            spindle.at_speed_waited += (SPINDLE_AT_SPEED_POLL_MS / 1000.0);
+            st_prep_dwell((uint32_t)(SPINDLE_AT_SPEED_POLL_MS * 1000));
+            return (STAT_OK);                       // run again when the dwell is done
+        }
+        spindle.at_speed_fault = true;              // stop here - the alarm flushes the wait
+        return (STAT_OK);
+    }
+    spindle.at_speed_waited = 0;
+    if (mp_free_run_buffer()) {
+        cm_cycle_end();                             // free buffer & perform cycle_end if planner is empty
+    }
+    return (STAT_OK);
+}
+
 /*
  * cm_spindle_control() - queue the spindle command to the planner buffer. Observe PAUSE
+ * cm_spindle_control_inline() - M3/M4/M5 for the block's own move to carry (laser mode)
+ * spindle_inline_sync() - apply a move's S and M3/M4/M5 as the runtime starts the block
+ * _set_spindle_model() - record the commanded enable and direction
  * _exec_spindle_control() - actually execute the spindle command
+ *
+ *  In laser mode M3/M4/M5 are modal state carried by the moves like S, so a laser can be
+ *  switched on and off between moves without a stop. A spindle still queues its commands,
+ *  as it needs the time (and maybe the at-speed wait) to come up.
  */
 
-stat_t cm_spindle_control(uint8_t control)  // requires SPINDLE_CONTROL_xxx style args
+static void _set_spindle_model(uint8_t control)
 {
     if (control == SPINDLE_CONTROL_OFF) {
         spindle.enable = SPINDLE_OFF;
@@ -146,13 +284,51 @@ stat_t cm_spindle_control(uint8_t control)  // requires SPINDLE_CONTROL_xxx styl
             spindle.direction = SPINDLE_CCW;
         }
     }
+    cm.gm.spindle_control = (spindle.laser_mode) ? control : -1;
+}
+
+stat_t cm_spindle_control(uint8_t control)  // requires SPINDLE_CONTROL_xxx style args
+{
+    _set_spindle_model(control);
 
     float value[] = { (float)spindle.enable, (float)spindle.direction, 0,0,0,0 };
     bool flags[] =  { 1,1,0,0,0,0 };
     mp_queue_command(_exec_spindle_control, value, flags);
+    if ((control != SPINDLE_CONTROL_OFF) && _spindle_waits_for_speed()) {
+        return (_queue_at_speed_wait());        // motion after M3/M4 waits for the spindle
+    }
     return(STAT_OK);
 }
 
+stat_t cm_spindle_control_inline(uint8_t control)
+{
+    if (!spindle.laser_mode) {
+        return (cm_spindle_control(control));
+    }
+    _set_spindle_model(control);
+    return (STAT_OK);
+}
+
+void spindle_inline_sync(const float speed, const int8_t control)
+{
+    if (control >= 0) {
+        cmSpindleEnable enable = (control == SPINDLE_CONTROL_OFF) ? SPINDLE_OFF : SPINDLE_ON;
+        cmSpindleDir direction = (control == SPINDLE_CONTROL_CCW) ? SPINDLE_CCW : SPINDLE_CW;
+        if ((spindle.running != (enable == SPINDLE_ON)) ||
+            ((enable == SPINDLE_ON) && (spindle.direction != direction))) {
+            spindle.speed = speed;
+            float value[] = { (float)enable, (float)direction, 0,0,0,0 };
+            bool flags[] =  { 1,1,0,0,0,0 };
+            _exec_spindle_control(value, flags);    // sets the PWM for the new speed too
+            return;
+        }
+    }
+    if (speed != spindle.speed) {
+        spindle.speed = speed;
+        pwm_set_duty(PWM_1, _get_spindle_pwm((spindle.running) ? SPINDLE_ON : SPINDLE_OFF, spindle.direction));
+    }
+}
+
     #define _set_spindle_enable_bit_hi() spindle_enable_pin.set()
     #define _set_spindle_enable_bit_lo() spindle_enable_pin.clear()
     #define _set_spindle_direction_bit_hi() spindle_dir_pin.set()
@@ -175,6 +351,7 @@ static void _exec_spindle_control(float *value, bool *flag)
     {
         // set on/off. Mask out PAUSE and consider it OFF
         spindle.enable = (cmSpindleEnable)value[0];             // record spindle enable in the struct
+        spindle.running = (spindle.enable == SPINDLE_ON);
         if ((spindle.enable & 0x01) ^ spindle.enable_polarity) {
             _set_spindle_enable_bit_lo();
         } else {
@@ -185,6 +362,28 @@ static void _exec_spindle_control(float *value, bool *flag)
     pwm_set_duty(PWM_1, _get_spindle_pwm(spindle.enable, spindle.direction));
 }
 
+/*
+ * spindle_laser_duty() - PWM phase for a segment run at scale times the cruise velocity
+ *
+ *  Laser mode. Exec calls this for every segment and the stepper loader sets the PWM as
+ *  the segment starts, so the output tracks the head and tail of each move instead of
+ *  overburning them at the power set for the block. The phase runs linearly from phase_off
+ *  at stand-still to the programmed S power at cruise. Returns -1 when not in laser mode,
+ *  which leaves the PWM to the queued spindle commands.
+ */
+float spindle_laser_duty(const float scale)
+{
+    if (!spindle.laser_mode) {
+        return (-1);
+    }
+    float phase_off = pwm.c[PWM_1].phase_off;
+    if (!spindle.running) {                     // the runtime's state, not the model's
+        return (phase_off);
+    }
+    float phase = _get_spindle_pwm(SPINDLE_ON, spindle.direction);
+    return (phase_off + (phase - phase_off) * min(max(scale, 0.0f), 1.0f));
+}
+
 /*
  * _get_spindle_pwm() - return PWM phase (duty cycle) for dir and speed
  */
@@ -266,6 +465,81 @@ void cm_end_spindle_override(const float ramp_time)
     return;
 }
 
+/*
+ * cm_raster_claim() - attach the staged raster row to the G1 being queued
+ * spindle_raster_reset() - drop all rows. Only call with the runtime idle (e.g. queue flush)
+ * spindle_raster_start() - runtime is starting a block that may carry a row
+ * spindle_raster_power() - power for the segment from position to target, 0 to 1
+ * spindle_raster_end() - runtime finished a row's move, so the row can be staged again
+ *
+ *  A laser raster line is one G1 carrying a row of pixels instead of a G1 and S for every
+ *  pixel. The host stages the row with {rpx:"<base64 bytes>"} - in as many pieces as the
+ *  line length needs - then sends the G1, which takes the row. Exec picks the pixel under
+ *  the middle of each segment and scales the laser power by it, so the row runs at the
+ *  resolution of the segments. It only has an effect in laser mode.
+ *
+ *  The row stays with the move through a feedhold: the restarted block has the same row,
+ *  so the runtime keeps the distance from where the row first started.
+ */
+
+int8_t cm_raster_claim()
+{
+    if (!raster.staging) {
+        return (-1);
+    }
+    int8_t row = raster.head & (RASTER_ROWS-1);
+    raster.staging = false;
+    raster.head++;
+    return (row);
+}
+
+void spindle_raster_reset()
+{
+    raster.staging = false;
+    raster.tail = raster.head;
+    raster.run_row = -1;
+}
+
+void spindle_raster_start(const int8_t row, const float position[], const float length)
+{
+    if (row == raster.run_row) {
+        return;                                 // restarted after a hold
+    }
+    raster.run_row = row;
+    copy_vector(raster.start, position);
+    raster.length = length;
+}
+
+float spindle_raster_power(const float position[], const float target[])
+{
+    if (raster.run_row < 0) {
+        return (1.0);
+    }
+    spRasterRow_t *r = &raster.row[raster.run_row];
+    if ((r->count == 0) || (raster.length < EPSILON)) {
+        return (1.0);
+    }
+    float d0 = 0, d1 = 0;
+    for (uint8_t a=0; a<AXES; a++) {
+        d0 += square(position[a] - raster.start[a]);
+        d1 += square(target[a] - raster.start[a]);
+    }
+    float fraction = (sqrt(d0) + sqrt(d1)) * 0.5 / raster.length;
+    int16_t i = min((int16_t)(fraction * r->count), (int16_t)(r->count-1));
+    return ((float)r->pixel[max(i, (int16_t)0)] / 255.0);
+}
+
+void spindle_raster_end(const int8_t row)
+{
+    while ((raster.head != raster.tail) && ((raster.tail & (RASTER_ROWS-1)) != row)) {
+        raster.tail++;                          // free a row whose move never ran (e.g. too short)
+    }
+    if (raster.head != raster.tail) {
+        raster.tail++;
+    }
+    raster.run_row = -1;
+}
+
 /****************************
  * END OF SPINDLE FUNCTIONS *
  ****************************/
@@ -308,6 +582,67 @@ stat_t cm_set_sso(nvObj_t *nv)
     return(STAT_OK);
 }
 
+/*
+ * cm_get_rpx() - pixels staged for the next raster move
+ * cm_set_rpx() - add base64 encoded pixels to the staged raster row
+ *
+ *  Returns STAT_EAGAIN while all the rows are queued, which holds the line until one frees.
+ */
+
+static int8_t _base64_value(const char c)
+{
+    if ((c >= 'A') && (c <= 'Z')) { return (c - 'A'); }
+    if ((c >= 'a') && (c <= 'z')) { return (c - 'a' + 26); }
+    if ((c >= '0') && (c <= '9')) { return (c - '0' + 52); }
+    if (c == '+') { return (62); }
+    if (c == '/') { return (63); }
+    return (-1);
+}
+
+stat_t cm_get_rpx(nvObj_t *nv)
+{
+    nv->value = (raster.staging) ? (float)raster.row[raster.head & (RASTER_ROWS-1)].count : 0;
+    nv->valuetype = TYPE_INT;
+    return (STAT_OK);
+}
+
+stat_t cm_set_rpx(nvObj_t *nv)
+{
+    if (nv->valuetype != TYPE_STRING) {
+        return (STAT_INPUT_VALUE_RANGE_ERROR);
+    }
+    if (!spindle.laser_mode) {
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    spRasterRow_t *r = &raster.row[raster.head & (RASTER_ROWS-1)];
+    if (!raster.staging) {
+        if ((uint16_t)(raster.head - raster.tail) >= RASTER_ROWS) {
+            return (STAT_EAGAIN);               // every row is queued or running
+        }
+        r->count = 0;
+    }
+    uint16_t count = r->count;
+    uint32_t bits = 0;
+    uint8_t nbits = 0;
+    for (const char *p = *nv->stringp; (*p != 0) && (*p != '='); p++) {
+        int8_t v = _base64_value(*p);
+        if (v < 0) {
+            return (STAT_INPUT_VALUE_RANGE_ERROR);
+        }
+        bits = (bits << 6) | v;
+        if ((nbits += 6) >= 8) {
+            if (count >= RASTER_ROW_PIXELS) {
+                return (STAT_INPUT_EXCEEDS_MAX_LENGTH);
+            }
+            nbits -= 8;
+            r->pixel[count++] = (uint8_t)(bits >> nbits);
+        }
+    }
+    r->count = count;                           // nothing is kept from a piece that erred
+    raster.staging = true;
+    return (STAT_OK);
+}
+
 /***********************************************************************************
  * TEXT MODE SUPPORT
  * Functions to print variables from the cfgArray table
@@ -319,6 +654,8 @@ const char fmt_spep[] = "[spep] spindle enable polarity%5d [0=active_low,1=activ
 const char fmt_spdp[] = "[spdp] spindle direction polarity%2d [0=CW_low,1=CW_high]\n";
 const char fmt_spph[] = "[spph] spindle pause on hold%7d [0=no,1=pause_on_hold]\n";
 const char fmt_spdw[] = "[spdw] spindle dwell time%12.1f seconds\n";
+const char fmt_splm[] = "[splm] spindle laser mode%10d [0=off,1=scale PWM with velocity]\n";
+const char fmt_spat[] = "[spat] spindle at speed timeout%6.1f seconds [0=wait forever]\n";
 const char fmt_ssoe[] ="[ssoe] spindle speed override ena%2d [0=disable,1=enable]\n";
 const char fmt_sso[] ="[sso] spindle speed override%11.3f [0.050 < sso < 2.000]\n";
 const char fmt_spe[] = "Spindle Enable:%7d [0=OFF,1=ON,2=PAUSE]\n";
@@ -329,6 +666,8 @@ void cm_print_spep(nvObj_t *nv) { text_print(nv, fmt_spep);}    // TYPE_INT
 void cm_print_spdp(nvObj_t *nv) { text_print(nv, fmt_spdp);}    // TYPE_INT
 void cm_print_spph(nvObj_t *nv) { text_print(nv, fmt_spph);}    // TYPE_INT
 void cm_print_spdw(nvObj_t *nv) { text_print(nv, fmt_spdw);}    // TYPE_FLOAT
+void cm_print_spat(nvObj_t *nv) { text_print(nv, fmt_spat);}    // TYPE_FLOAT
+void cm_print_splm(nvObj_t *nv) { text_print(nv, fmt_splm);}    // TYPE_INT
 void cm_print_ssoe(nvObj_t *nv) { text_print(nv, fmt_ssoe);}    // TYPE INT
 void cm_print_sso(nvObj_t *nv)  { text_print(nv, fmt_sso);}     // TYPE FLOAT
 void cm_print_spe(nvObj_t *nv)  { text_print(nv, fmt_spe);}     // TYPE_INT
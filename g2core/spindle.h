@@ -63,6 +63,14 @@ typedef enum {
 #define SPINDLE_OVERRIDE_MIN 0.05       // 5%
 #define SPINDLE_OVERRIDE_MAX 2.00       // 200%
 #define SPINDLE_OVERRIDE_RAMP_TIME 1    // change speed in seconds
+#define SPINDLE_AT_SPEED_POLL_MS 10     // how often a waiting runtime reads the at-speed input
+
+#ifndef RASTER_ROWS
+#define RASTER_ROWS 4                   // raster rows staged or queued at once. Must be 2^N
+#endif
+#ifndef RASTER_ROW_PIXELS
+#define RASTER_ROW_PIXELS 384           // most pixels one raster move can carry
+#endif
 
 /*
  * Spindle control structure
@@ -77,6 +85,14 @@ typedef struct cmSpindleSingleton {
     cmSpindlePolarity enable_polarity;  // 0=active low, 1=active high
     cmSpindlePolarity dir_polarity;     // 0=clockwise low, 1=clockwise high
     float             dwell_seconds;    // dwell on spindle resume
+    float             at_speed_timeout; // seconds to wait for the at-speed input, 0=forever
+    bool              laser_mode;       // scale PWM by velocity every segment - see spindle_laser_duty()
+    bool              running;          // output is on, as last set by the runtime
+
+    float         at_speed_waited;      // seconds the runtime has waited so far
+    volatile bool at_speed_fault;       // runtime gave up waiting - alarmed from spindle_callback()
+    bool          resuming;             // restarted at the end of a hold, waiting to be at speed
+    uint32_t      resume_tick;          // SysTick time the resume started
 
     bool  sso_enable;  // TRUE = spindle speed override enabled (see also m48_enable in canonical machine)
     float sso_factor;  // 1.0000 x S spindle speed. Go up or down from there
@@ -88,17 +104,52 @@ typedef struct cmSpindleSingleton {
 } cmSpindleton_t;
 extern cmSpindleton_t spindle;
 
+/*
+ * Raster rows - see cm_raster_claim()
+ *
+ *  head is only written by the model and tail only by the runtime, so a row is in use
+ *  from the time it's staged until the runtime finishes the move that carries it.
+ */
+
+typedef struct spRasterRow {
+    uint16_t count;                     // pixels in the row
+    uint8_t pixel[RASTER_ROW_PIXELS];   // power, 0-255 of the laser's S power
+} spRasterRow_t;
+
+typedef struct spRasterSingleton {
+    spRasterRow_t row[RASTER_ROWS];
+    uint16_t head;                      // rows staged so far - the row being staged is head & (RASTER_ROWS-1)
+    volatile uint16_t tail;             // rows finished by the runtime so far
+    bool staging;                       // {rpx:} is filling the row at head
+
+    int8_t run_row;                     // the row the runtime is running, or -1
+    float start[AXES];                  // runtime position the row starts at
+    float length;                       // length of the row's move
+} spRasterSingleton_t;
+extern spRasterSingleton_t raster;
+
 /*
  * Global Scope Functions
  */
 
 void spindle_init();
 void spindle_reset();
+stat_t spindle_callback(void);
+float spindle_laser_duty(const float scale);    // called from exec
+void spindle_inline_sync(const float speed, const int8_t control);  // called from exec
+int8_t cm_raster_claim(void);                   // the row staged for the G1 being queued, or -1
+void spindle_raster_reset(void);
+void spindle_raster_start(const int8_t row, const float position[], const float length); // called from exec
+float spindle_raster_power(const float position[], const float target[]);             // called from exec
+void spindle_raster_end(const int8_t row);                                           // called from exec
 stat_t cm_set_spindle_speed(float speed);       // S parameter
+stat_t cm_set_spindle_speed_inline(float speed);// S parameter carried by the block's move
 stat_t cm_spindle_control(uint8_t control);     // M3, M4, M5 integrated spindle control
+stat_t cm_spindle_control_inline(uint8_t control);// M3, M4, M5 carried by the block's move (laser mode)
 void cm_spindle_off_immediate(void);
 void cm_spindle_optional_pause(bool option);    // stop spindle based on system options selected
 void cm_spindle_resume(float dwell_seconds);    // restart spindle after pause based on previous state
+bool cm_spindle_ready_to_resume(void);          // restart spindle ahead of motion; true once at speed
 
 stat_t cm_sso_control(const float P_word, const bool P_flag); // M51
 void cm_start_spindle_override(const float ramp_time, const float override_factor);
@@ -106,6 +157,8 @@ void cm_end_spindle_override(const float ramp_time);
 
 stat_t cm_set_dir(nvObj_t* nv);
 stat_t cm_set_sso(nvObj_t* nv);
+stat_t cm_get_rpx(nvObj_t* nv);
+stat_t cm_set_rpx(nvObj_t* nv);
 
 /*--- text_mode support functions ---*/
 
@@ -115,6 +168,8 @@ stat_t cm_set_sso(nvObj_t* nv);
     void cm_print_spdp(nvObj_t* nv);
     void cm_print_spph(nvObj_t* nv);
     void cm_print_spdw(nvObj_t* nv);
+    void cm_print_spat(nvObj_t* nv);
+    void cm_print_splm(nvObj_t* nv);
     void cm_print_ssoe(nvObj_t* nv);
     void cm_print_sso(nvObj_t* nv);
     void cm_print_spe(nvObj_t* nv);
@@ -127,6 +182,8 @@ stat_t cm_set_sso(nvObj_t* nv);
     #define cm_print_spdp tx_print_stub
     #define cm_print_spph tx_print_stub
     #define cm_print_spdw tx_print_stub
+    #define cm_print_spat tx_print_stub
+    #define cm_print_splm tx_print_stub
     #define cm_print_ssoe tx_print_stub
     #define cm_print_spe tx_print_stub
     #define cm_print_sso tx_print_stub
@@ -0,0 +1,424 @@
+/*
+ * spindle_vfd.cpp - Modbus RTU spindle VFD driver over an RS-485 UART
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "g2core.h"             // #1 dependency order
+#include "config.h"             // #2
+#include "canonical_machine.h"  // #3
+#include "text_parser.h"        // #4
+
+#include "spindle.h"
+#include "spindle_vfd.h"
+#include "report.h"
+#include "util.h"
+#include "MotateTimers.h"
+
+#define MODBUS_READ_HOLDING 0x03
+#define MODBUS_WRITE_SINGLE 0x06
+#define MODBUS_EXCEPTION 0x80           // or'd into the function code of an error reply
+#define MODBUS_EXCEPTION_LEN 5
+
+/**** Allocate structures ****/
+
+spVfd_t vfd;
+
+/*
+ * The UART - DMA both ways. A reply is received in place in vfd.rx, so the number of
+ * bytes in so far is just how far the receive transfer has got.
+ */
+
+#if SPINDLE_VFD_AVAILABLE == 1
+#include "MotateUART.h"
+
+Motate::UART<Motate::kVFD_RXPinNumber, Motate::kVFD_TXPinNumber, Motate::kVFD_RTSPinNumber, Motate::kVFD_CTSPinNumber> vfd_uart {
+    SPINDLE_VFD_BAUD, Motate::UARTMode::RS485};
+
+static void _uart_init()
+{
+    vfd_uart.init();
+}
+
+static bool _uart_send(const uint8_t length, const uint8_t reply_length)
+{
+    char *rx = (char *)vfd.rx;
+    char *tx = (char *)vfd.tx;
+    if (!vfd_uart.startRXTransfer(rx, reply_length)) {
+        return (false);
+    }
+    return (vfd_uart.startTXTransfer(tx, length));
+}
+
+static uint8_t _uart_received()
+{
+    uint8_t received = (const char *)vfd_uart.getRXTransferPosition() - (const char *)vfd.rx;
+    hw_dcache_invalidate(vfd.rx, received);     // the DMA wrote it
+    return (received);
+}
+
+#else
+
+static void _uart_init() {}
+static bool _uart_send(const uint8_t length, const uint8_t reply_length) { return (false); }
+static uint8_t _uart_received() { return (0); }
+
+#endif // SPINDLE_VFD_AVAILABLE
+
+/*
+ * spindle_vfd_init()
+ * spindle_vfd_is_enabled() - there is a UART and {spvm:} is on
+ */
+
+void spindle_vfd_init()
+{
+    vfd.magic_start = MAGICNUM;
+    vfd.magic_end = MAGICNUM;
+    vfd.head = 0;
+    vfd.tail = 0;
+    vfd.busy = false;
+    vfd.tries = 0;
+    vfd.synced = false;
+    vfd.rpm = 0;
+    vfd.rpm_valid = false;
+    vfd.status = (spindle_vfd_is_enabled()) ? VFD_OFFLINE : VFD_OFF;   // online once it answers
+    vfd.bus_tick = SysTickTimer.getValue();
+    vfd.poll_tick = vfd.bus_tick;
+    _uart_init();
+}
+
+bool spindle_vfd_is_enabled()
+{
+    return ((SPINDLE_VFD_AVAILABLE == 1) && vfd.enable);
+}
+
+/*
+ * _vfd_counts()  - speed register counts for what the runtime last did to the spindle
+ * _vfd_control() - control word for it
+ *
+ *  Called from the main loop and from exec. S is scaled by the spindle override here, as
+ *  nothing else applies it to S.
+ */
+
+static uint16_t _vfd_counts()
+{
+    if (!spindle.running) {
+        return (0);
+    }
+    float rpm = spindle.speed;
+    if (spindle.sso_enable && cm.gmx.m48_enable) {
+        rpm *= spindle.sso_factor;
+    }
+    return ((uint16_t)min(max(rpm / vfd.rpm_per_count + 0.5f, 0.0f), 65535.0f));
+}
+
+static uint16_t _vfd_control()
+{
+    if (!spindle.running) {
+        return (SPINDLE_VFD_STOP);
+    }
+    return ((spindle.direction == SPINDLE_CW) ? SPINDLE_VFD_RUN_CW : SPINDLE_VFD_RUN_CCW);
+}
+
+/*
+ * spindle_vfd_at_speed() - true once the VFD reads back the speed the runtime commanded
+ *
+ *  Only a reading taken after the command was written counts, and a command the callback
+ *  hasn't queued yet isn't at speed, as the VFD is still running the one before.
+ */
+
+bool spindle_vfd_at_speed()
+{
+    if ((vfd.status != VFD_ONLINE) || !vfd.rpm_valid || !vfd.synced) {
+        return (false);
+    }
+    uint16_t counts = _vfd_counts();
+    if ((counts != vfd.sent_counts) || (spindle.running != vfd.sent_run) ||
+        (spindle.running && (spindle.direction != vfd.sent_direction))) {
+        return (false);
+    }
+    float rpm = counts * vfd.rpm_per_count;
+    return (fabs(vfd.rpm - rpm) <= max(rpm * (float)SPINDLE_VFD_AT_SPEED_TOLERANCE, vfd.rpm_per_count));
+}
+
+/*
+ * _vfd_crc()   - Modbus CRC-16 of a frame, sent low byte first
+ * _vfd_queue() - queue a transaction. False if the queue is full
+ *
+ *  A write to a register that is still waiting for the bus takes the new value instead of
+ *  queuing behind it, so a burst of S changes sends only the last. A read is only queued
+ *  if there isn't one waiting that is still behind the latest write.
+ */
+
+static uint16_t _vfd_crc(const uint8_t *frame, const uint8_t length)
+{
+    uint16_t crc = 0xFFFF;
+    for (uint8_t i=0; i<length; i++) {
+        crc ^= frame[i];
+        for (uint8_t bit=0; bit<8; bit++) {
+            crc = (crc & 1) ? ((crc >> 1) ^ 0xA001) : (crc >> 1);
+        }
+    }
+    return (crc);
+}
+
+static bool _vfd_queue(const uint8_t function, const uint16_t address, const uint16_t value)
+{
+    if (function == MODBUS_WRITE_SINGLE) {
+        vfd.rpm_valid = false;
+        for (uint8_t i = vfd.tail; i != vfd.head; i = (i + 1) & (SPINDLE_VFD_QUEUE_SIZE-1)) {
+            vfd.queue[i].fresh = false;         // no read already queued can see this write
+        }
+    }
+    uint8_t first = (vfd.busy) ? ((vfd.tail + 1) & (SPINDLE_VFD_QUEUE_SIZE-1)) : vfd.tail;
+    for (uint8_t i = first; i != vfd.head; i = (i + 1) & (SPINDLE_VFD_QUEUE_SIZE-1)) {
+        spVfdRequest_t *rq = &vfd.queue[i];
+        if ((rq->function == function) && (rq->address == address) &&
+            ((function == MODBUS_WRITE_SINGLE) || rq->fresh)) {
+            rq->value = value;
+            return (true);
+        }
+    }
+    uint8_t next = (vfd.head + 1) & (SPINDLE_VFD_QUEUE_SIZE-1);
+    if (next == vfd.tail) {
+        return (false);
+    }
+    spVfdRequest_t *rq = &vfd.queue[vfd.head];
+    rq->function = function;
+    rq->address = address;
+    rq->value = value;
+    rq->fresh = true;
+    vfd.head = next;
+    return (true);
+}
+
+/*
+ * _vfd_follow_spindle() - queue writes for whatever the runtime changed, and the polls
+ *
+ *  The speed goes before the run command, so a starting VFD ramps to the new S.
+ */
+
+static void _vfd_follow_spindle()
+{
+    uint16_t counts = _vfd_counts();
+    bool run = spindle.running;
+    cmSpindleDir direction = spindle.direction;
+
+    if (!vfd.synced || (counts != vfd.sent_counts)) {
+        if (!_vfd_queue(MODBUS_WRITE_SINGLE, SPINDLE_VFD_SPEED_REGISTER, counts)) {
+            return;                             // try again next pass
+        }
+        vfd.sent_counts = counts;
+    }
+    if (!vfd.synced || (run != vfd.sent_run) || (run && (direction != vfd.sent_direction))) {
+        if (!_vfd_queue(MODBUS_WRITE_SINGLE, SPINDLE_VFD_CONTROL_REGISTER, _vfd_control())) {
+            vfd.synced = false;                 // the speed went; send both again
+            return;
+        }
+        vfd.sent_run = run;
+        vfd.sent_direction = direction;
+    }
+    vfd.synced = true;
+
+    uint32_t now = SysTickTimer.getValue();
+    if ((now - vfd.poll_tick) >= SPINDLE_VFD_POLL_MS) {
+        if (_vfd_queue(MODBUS_READ_HOLDING, SPINDLE_VFD_FEEDBACK_REGISTER, 1)) {
+            vfd.poll_tick = now;
+        }
+    }
+}
+
+/*
+ * _vfd_start_next() - put the transaction at the tail on the bus once it has been quiet
+ * _vfd_check_reply() - see if the reply to it is in, or it has timed out
+ * _vfd_parse_reply() - true if the reply is good, and take its reading
+ * _vfd_retire()      - done with the transaction at the tail, or try it again
+ */
+
+static void _vfd_start_next()
+{
+    if ((vfd.head == vfd.tail) || ((SysTickTimer.getValue() - vfd.bus_tick) < SPINDLE_VFD_FRAME_GAP_MS)) {
+        return;
+    }
+    spVfdRequest_t *rq = &vfd.queue[vfd.tail];
+    vfd.tx[0] = vfd.address;
+    vfd.tx[1] = rq->function;
+    vfd.tx[2] = rq->address >> 8;
+    vfd.tx[3] = rq->address & 0xFF;
+    vfd.tx[4] = rq->value >> 8;
+    vfd.tx[5] = rq->value & 0xFF;
+    uint16_t crc = _vfd_crc(vfd.tx, 6);
+    vfd.tx[6] = crc & 0xFF;
+    vfd.tx[7] = crc >> 8;
+    vfd.reply_len = (rq->function == MODBUS_READ_HOLDING) ? (5 + 2*rq->value) : 8;  // a write is echoed
+
+    if (!_uart_send(8, vfd.reply_len)) {
+        return;                                 // the UART is still busy - next pass
+    }
+    vfd.busy = true;
+    vfd.tries++;
+    vfd.bus_tick = SysTickTimer.getValue();
+}
+
+static bool _vfd_parse_reply(const spVfdRequest_t *rq, const uint8_t length)
+{
+    uint16_t crc = _vfd_crc(vfd.rx, length-2);
+    if ((vfd.rx[length-2] != (crc & 0xFF)) || (vfd.rx[length-1] != (crc >> 8)) ||
+        (vfd.rx[0] != vfd.address) || (vfd.rx[1] != rq->function)) {
+        return (false);                         // corrupt, someone else's, or an exception
+    }
+    if (rq->function == MODBUS_WRITE_SINGLE) {
+        return (memcmp(vfd.rx, vfd.tx, 6) == 0);
+    }
+    if (vfd.rx[2] != 2) {
+        return (false);
+    }
+    vfd.rpm = ((vfd.rx[3] << 8) | vfd.rx[4]) * vfd.rpm_per_count;
+    if (rq->fresh) {
+        vfd.rpm_valid = true;
+    }
+    return (true);
+}
+
+static void _vfd_retire(const bool answered)
+{
+    vfd.busy = false;
+    vfd.bus_tick = SysTickTimer.getValue();     // the frame gap runs from here
+    if (answered) {
+        vfd.tail = (vfd.tail + 1) & (SPINDLE_VFD_QUEUE_SIZE-1);
+        vfd.tries = 0;
+        vfd.status = VFD_ONLINE;
+        return;
+    }
+    vfd.errors++;
+    if (vfd.tries < SPINDLE_VFD_RETRIES) {
+        return;                                 // send it again
+    }
+    vfd.head = vfd.tail;                        // drop the lot, and send it all again once it answers
+    vfd.tries = 0;
+    vfd.synced = false;
+    vfd.rpm_valid = false;
+    if (vfd.status != VFD_OFFLINE) {
+        vfd.status = VFD_OFFLINE;
+        if (spindle.running) {
+            cm_alarm(STAT_SPINDLE_VFD_NOT_RESPONDING, "spindle vfd");
+        } else {
+            rpt_exception(STAT_SPINDLE_VFD_NOT_RESPONDING, "spindle vfd");
+        }
+    }
+}
+
+static void _vfd_check_reply()
+{
+    spVfdRequest_t *rq = &vfd.queue[vfd.tail];
+    uint8_t received = _uart_received();
+    uint8_t length = vfd.reply_len;
+    if ((received >= MODBUS_EXCEPTION_LEN) && (vfd.rx[1] == (rq->function | MODBUS_EXCEPTION))) {
+        length = MODBUS_EXCEPTION_LEN;          // the VFD refused it
+    }
+    if (received < length) {
+        if ((SysTickTimer.getValue() - vfd.bus_tick) >= SPINDLE_VFD_REPLY_TIMEOUT_MS) {
+            _vfd_retire(false);
+        }
+        return;
+    }
+    _vfd_retire(_vfd_parse_reply(rq, length));
+}
+
+/*
+ * spindle_vfd_callback() - run the Modbus link from the controller. Never waits
+ */
+
+stat_t spindle_vfd_callback()
+{
+    if (!spindle_vfd_is_enabled()) {
+        return (STAT_NOOP);
+    }
+    _vfd_follow_spindle();
+    if (vfd.busy) {
+        _vfd_check_reply();
+    }
+    if (!vfd.busy) {
+        _vfd_start_next();                      // straight on to the next, if the gap allows
+    }
+    return (STAT_OK);
+}
+
+/***********************************************************************************
+ * CONFIGURATION AND INTERFACE FUNCTIONS
+ * Functions to get and set variables from the cfgArray table
+ ***********************************************************************************/
+
+/*
+ * spindle_vfd_set_enable()        - set {spvm:}; turning it on sends the VFD everything
+ * spindle_vfd_set_address()       - set {spva:}, a Modbus slave address of 1 to 247
+ * spindle_vfd_set_rpm_per_count() - set {spvk:}, which must be positive
+ */
+
+stat_t spindle_vfd_set_enable(nvObj_t *nv)
+{
+    ritorno(set_01(nv));
+    vfd.synced = false;
+    vfd.rpm_valid = false;
+    vfd.status = (spindle_vfd_is_enabled()) ? VFD_OFFLINE : VFD_OFF;    // online once it answers
+    return (STAT_OK);
+}
+
+stat_t spindle_vfd_set_address(nvObj_t *nv)
+{
+    if (nv->value < 1) {
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    if (nv->value > 247) {
+        return (STAT_INPUT_EXCEEDS_MAX_VALUE);
+    }
+    ritorno(set_ui8(nv));
+    vfd.synced = false;
+    return (STAT_OK);
+}
+
+stat_t spindle_vfd_set_rpm_per_count(nvObj_t *nv)
+{
+    if (nv->value <= 0) {
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    ritorno(set_flt(nv));
+    vfd.synced = false;
+    return (STAT_OK);
+}
+
+/***********************************************************************************
+ * TEXT MODE SUPPORT
+ * Functions to print variables from the cfgArray table
+ ***********************************************************************************/
+
+#ifdef __TEXT_MODE
+
+const char fmt_spvm[] = "[spvm] spindle vfd mode%12d [0=off,1=modbus]\n";
+const char fmt_spva[] = "[spva] spindle vfd address%9d\n";
+const char fmt_spvk[] = "[spvk] spindle vfd rpm per count%9.4f\n";
+const char fmt_spvs[] = "Spindle VFD status:%3d [0=off,1=online,2=offline]\n";
+const char fmt_spvr[] = "Spindle VFD speed:%8.0f rpm\n";
+const char fmt_spve[] = "Spindle VFD errors:%7d\n";
+
+void spindle_vfd_print_spvm(nvObj_t *nv) { text_print(nv, fmt_spvm);}   // TYPE_INT
+void spindle_vfd_print_spva(nvObj_t *nv) { text_print(nv, fmt_spva);}   // TYPE_INT
+void spindle_vfd_print_spvk(nvObj_t *nv) { text_print(nv, fmt_spvk);}   // TYPE_FLOAT
+void spindle_vfd_print_spvs(nvObj_t *nv) { text_print(nv, fmt_spvs);}   // TYPE_INT
+void spindle_vfd_print_spvr(nvObj_t *nv) { text_print(nv, fmt_spvr);}   // TYPE_FLOAT
+void spindle_vfd_print_spve(nvObj_t *nv) { text_print(nv, fmt_spve);}   // TYPE_INT
+
+#endif // __TEXT_MODE
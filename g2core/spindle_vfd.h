@@ -0,0 +1,160 @@
+/*
+ * spindle_vfd.h - Modbus RTU spindle VFD driver over an RS-485 UART
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ *  With {spvm:1} the spindle is run by a VFD on a Modbus RTU link instead of (as well as)
+ *  the enable, direction and PWM outputs. The driver follows what the runtime last did to
+ *  the spindle - on/off, direction and S, scaled by the spindle override - and writes the
+ *  changes to the VFD's control and speed registers. Between writes it reads back the
+ *  output speed every SPINDLE_VFD_POLL_MS, which is {spvr:}. Once the reading is within
+ *  SPINDLE_VFD_AT_SPEED_TOLERANCE of the commanded speed the spindle is at speed, so M3
+ *  and M4 wait for the VFD and a feedhold resume waits for it, as for an at-speed input.
+ *
+ *  The UART sends and receives by DMA. spindle_vfd_callback() runs from the controller on
+ *  every pass: it starts the next queued transaction as soon as the bus has been quiet for
+ *  a frame gap, and checks on the one in flight, but never waits for the bus. A VFD that
+ *  doesn't answer SPINDLE_VFD_RETRIES times in a row is offline; with the spindle on that
+ *  is an alarm.
+ *
+ *  The board provides the UART: SPINDLE_VFD_AVAILABLE is 1 and kVFD_RX/TX/RTS/CTS pin
+ *  numbers are defined, with RTS driving the transceiver's driver enable in the USART's
+ *  RS-485 mode. The register map defaults suit the common 0x2000 control word layout.
+ *
+ *  Include after spindle.h
+ */
+
+#ifndef SPINDLE_VFD_H_ONCE
+#define SPINDLE_VFD_H_ONCE
+
+#ifndef SPINDLE_VFD_AVAILABLE
+#define SPINDLE_VFD_AVAILABLE 0             // the board has an RS-485 UART for a VFD
+#endif
+
+#ifndef SPINDLE_VFD_BAUD
+#define SPINDLE_VFD_BAUD 9600
+#endif
+#ifndef SPINDLE_VFD_CONTROL_REGISTER
+#define SPINDLE_VFD_CONTROL_REGISTER 0x2000 // holding register taking the run/stop commands
+#endif
+#ifndef SPINDLE_VFD_SPEED_REGISTER
+#define SPINDLE_VFD_SPEED_REGISTER 0x2001   // holding register taking the speed, in {spvk:} counts
+#endif
+#ifndef SPINDLE_VFD_FEEDBACK_REGISTER
+#define SPINDLE_VFD_FEEDBACK_REGISTER 0x2103// register reading back the output speed, in the same counts
+#endif
+#ifndef SPINDLE_VFD_RUN_CW
+#define SPINDLE_VFD_RUN_CW 0x0012           // control word to run forward
+#endif
+#ifndef SPINDLE_VFD_RUN_CCW
+#define SPINDLE_VFD_RUN_CCW 0x0022          // control word to run reverse
+#endif
+#ifndef SPINDLE_VFD_STOP
+#define SPINDLE_VFD_STOP 0x0001             // control word to stop
+#endif
+
+#define SPINDLE_VFD_POLL_MS 100             // how often the output speed is read back
+#define SPINDLE_VFD_REPLY_TIMEOUT_MS 50     // time a VFD has to answer a request
+#define SPINDLE_VFD_RETRIES 3               // unanswered tries before the VFD is offline
+#define SPINDLE_VFD_AT_SPEED_TOLERANCE 0.05 // fraction of the commanded speed that is at speed
+#define SPINDLE_VFD_FRAME_GAP_MS ((SPINDLE_VFD_BAUD > 19200) ? 2 : ((38500 / SPINDLE_VFD_BAUD) + 1)) // 3.5 characters, rounded up
+#define SPINDLE_VFD_QUEUE_SIZE 4            // transactions waiting for the bus (power of 2)
+#define SPINDLE_VFD_FRAME_LEN 8             // a request, or the longest reply this driver reads
+
+typedef enum {
+    VFD_OFF = 0,                            // {spvm:0}, or no UART on this board
+    VFD_ONLINE,                             // the last transaction was answered
+    VFD_OFFLINE                             // the VFD stopped answering
+} spVfdStatus;
+
+typedef struct spVfdRequest {               // one queued Modbus transaction
+    uint8_t function;                       // 0x03 read holding registers, 0x06 write single register
+    uint16_t address;                       // register
+    uint16_t value;                         // value written, or the number of registers read
+    bool fresh;                             // a read queued behind the last command written
+} spVfdRequest_t;
+
+typedef struct spVfdSingleton {
+    magic_t magic_start;
+
+    // configuration
+    bool enable;                            // spvm  run the spindle over Modbus
+    uint8_t address;                        // spva  VFD slave address
+    float rpm_per_count;                    // spvk  rpm per count of the speed registers
+
+    // state
+    spVfdStatus status;                     // spvs
+    float rpm;                              // spvr  output speed last read back
+    volatile bool rpm_valid;                // the reading was taken after the last command
+    uint32_t errors;                        // spve  transactions that failed, since reset
+    bool synced;                            // the VFD has been sent the commands below
+    bool sent_run;                          // command last queued to the VFD...
+    cmSpindleDir sent_direction;
+    uint16_t sent_counts;
+    uint32_t poll_tick;                     // SysTick of the last feedback read queued
+
+    // transactions - the head is queued by the callback, which also retires the tail
+    spVfdRequest_t queue[SPINDLE_VFD_QUEUE_SIZE];
+    uint8_t head;
+    uint8_t tail;
+    bool busy;                              // the transaction at the tail is on the bus
+    uint8_t tries;                          // times it has been sent
+    uint8_t reply_len;                      // bytes in a complete reply to it
+    uint32_t bus_tick;                      // SysTick it was sent, or the bus went quiet
+    uint8_t tx[SPINDLE_VFD_FRAME_LEN];
+    uint8_t rx[SPINDLE_VFD_FRAME_LEN];
+
+    magic_t magic_end;
+} spVfd_t;
+extern spVfd_t vfd;
+
+/*
+ * Global Scope Functions
+ */
+
+void spindle_vfd_init(void);
+stat_t spindle_vfd_callback(void);
+bool spindle_vfd_is_enabled(void);
+bool spindle_vfd_at_speed(void);        // called from exec
+
+stat_t spindle_vfd_set_enable(nvObj_t *nv);
+stat_t spindle_vfd_set_address(nvObj_t *nv);
+stat_t spindle_vfd_set_rpm_per_count(nvObj_t *nv);
+
+/*--- text_mode support functions ---*/
+
+#ifdef __TEXT_MODE
+
+    void spindle_vfd_print_spvm(nvObj_t* nv);
+    void spindle_vfd_print_spva(nvObj_t* nv);
+    void spindle_vfd_print_spvk(nvObj_t* nv);
+    void spindle_vfd_print_spvs(nvObj_t* nv);
+    void spindle_vfd_print_spvr(nvObj_t* nv);
+    void spindle_vfd_print_spve(nvObj_t* nv);
+
+#else
+
+    #define spindle_vfd_print_spvm tx_print_stub
+    #define spindle_vfd_print_spva tx_print_stub
+    #define spindle_vfd_print_spvk tx_print_stub
+    #define spindle_vfd_print_spvs tx_print_stub
+    #define spindle_vfd_print_spvr tx_print_stub
+    #define spindle_vfd_print_spve tx_print_stub
+
+#endif  // __TEXT_MODE
+
+#endif  // End of include guard: SPINDLE_VFD_H_ONCE
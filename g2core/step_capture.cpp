@@ -0,0 +1,185 @@
+/*
+ * step_capture.cpp - on-board capture of step edges for measuring DDA timing
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "g2core.h"
+#include "config.h"
+#include "hardware.h"
+#include "canonical_machine.h"
+#include "step_capture.h"
+#include "text_parser.h"
+#include "timebase.h"
+#include "util.h"
+#include "xio.h"
+
+#if STEP_CAPTURE_ENABLED == true
+
+/**** Allocate Structures ****/
+
+stc_t stc;
+
+/************************************************************************************
+ **** CODE **************************************************************************
+ ************************************************************************************/
+
+/*
+ * stc_edge() - stamp a step edge - called from the step capture input's ISR - see step_capture.h
+ */
+
+void stc_edge()
+{
+    uint32_t cycles = (uint32_t)tb_get_cycles();        // first, so it's closest to the edge
+
+    if (stc.state == STC_ARMED) {
+        stc.state = STC_CAPTURING;
+    } else if (stc.state != STC_CAPTURING) {
+        return;
+    }
+    uint32_t edges = stc.edges;
+    if (edges < STEP_CAPTURE_EDGES) {
+        stc.cycles[edges] = cycles;
+        stc.edges = edges + 1;
+    }
+}
+
+/*
+ * _finish_capture() - end the capture and measure the edges against the DDA tick grid
+ *
+ *  Each edge's offset from the grid is its time since the first edge, modulo the tick,
+ *  taken to the nearest tick so it lands between -1/2 and +1/2 a tick.
+ */
+
+static void _finish_capture()
+{
+    stc.state = STC_DONE;                               // the ISR stops writing here
+
+    uint32_t tick = SystemCoreClock / FREQUENCY_DDA;
+    int32_t early = 0;
+    int32_t late = 0;
+    for (uint32_t i=1; i < stc.edges; i++) {
+        int32_t offset = (int32_t)((stc.cycles[i] - stc.cycles[0]) % tick);
+        if (offset > (int32_t)(tick / 2)) {
+            offset -= tick;
+        }
+        early = min(early, offset);
+        late = max(late, offset);
+    }
+    stc.jitter = (float)(late - early) / (SystemCoreClock / 1000000);
+}
+
+/*
+ * stc_callback() - finish a capture once the motion stops, and send a dump a few lines at a time
+ */
+
+stat_t stc_callback()
+{
+    if ((stc.state == STC_CAPTURING) &&
+        ((stc.edges == STEP_CAPTURE_EDGES) || (cm.motion_state == MOTION_STOP))) {
+        _finish_capture();
+    }
+    if (!stc.dump) {
+        return (STAT_NOOP);
+    }
+    char line[160];
+
+    for (uint8_t i=0; (i < STEP_CAPTURE_DUMPS_PER_CALLBACK) && stc.dump; i++) {
+        if (xio_tx_is_backed_up()) {
+            break;
+        }
+        if (stc.dump_next == 0) {
+            sprintf(line, "{\"stch\":[%lu,%lu,%lu]}\n", (unsigned long)stc.edges,
+                    (unsigned long)SystemCoreClock, (unsigned long)FREQUENCY_DDA);
+            stc.dump_next = 1;
+        } else {
+            char *str = line + sprintf(line, "{\"stc\":[%lu", (unsigned long)stc.dump_next);
+            for (uint8_t k=0; (k < STEP_CAPTURE_DUMP_INTERVALS) && (stc.dump_next < stc.edges); k++) {
+                str += sprintf(str, ",%lu", (unsigned long)(stc.cycles[stc.dump_next] - stc.cycles[stc.dump_next-1]));
+                stc.dump_next++;
+            }
+            strcpy(str, "]}\n");
+        }
+        xio_writeline(line);
+        if (stc.dump_next >= stc.edges) {
+            stc.dump = 0;
+        }
+    }
+    return (STAT_OK);
+}
+
+/***********************************************************************************
+ * CONFIGURATION AND INTERFACE FUNCTIONS
+ * Functions to get and set variables from the cfgArray table
+ ***********************************************************************************/
+
+/*
+ * stc_set_stca() - {stca:1} arms a capture, {stca:0} drops one. Not while moving
+ */
+
+stat_t stc_set_stca(nvObj_t *nv)
+{
+    if (nv->value > 1) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_VALUE_RANGE_ERROR);
+    }
+    if (nv->value == 0) {
+        stc.state = STC_OFF;
+        stc.dump = 0;
+        return (STAT_OK);
+    }
+    if (cm.motion_state != MOTION_STOP) {
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    stc.dump = 0;
+    stc.edges = 0;
+    stc.jitter = 0;
+    stc.state = STC_ARMED;                              // last - the ISR starts recording from here
+    return (STAT_OK);
+}
+
+/*
+ * stc_set_stcd() - dump a finished capture. {stcd:1} starts a dump, {stcd:0} stops one
+ */
+
+stat_t stc_set_stcd(nvObj_t *nv)
+{
+    if ((nv->value != 0) && (stc.state != STC_DONE)) {
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    ritorno(set_01(nv));                                // also sets stc.dump
+    stc.dump_next = 0;
+    return (STAT_OK);
+}
+
+/***********************************************************************************
+ * TEXT MODE SUPPORT
+ * Functions to print variables from the cfgArray table
+ ***********************************************************************************/
+
+#ifdef __TEXT_MODE
+
+static const char fmt_stca[] = "[stca] step capture state%10d [0=off,1=armed,2=capturing,3=done]\n";
+static const char fmt_stcn[] = "[stcn] step capture edges%10lu\n";
+static const char fmt_stcj[] = "[stcj] step capture jitter%13.3f us\n";
+
+void stc_print_stca(nvObj_t *nv) { text_print(nv, fmt_stca);}
+void stc_print_stcn(nvObj_t *nv) { text_print(nv, fmt_stcn);}
+void stc_print_stcj(nvObj_t *nv) { text_print(nv, fmt_stcj);}
+
+#endif // __TEXT_MODE
+
+#endif // STEP_CAPTURE_ENABLED
@@ -0,0 +1,107 @@
+/*
+ * step_capture.h - on-board capture of step edges for measuring DDA timing
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* Step capture times the step pulses of one motor as they leave the board, to measure the
+ *  jitter of the DDA interrupt on the hardware - at different FREQUENCY_DDA settings, or
+ *  before and after a change to the interrupt. Compile it in with STEP_CAPTURE_ENABLED.
+ *
+ *  Wire the motor's step pin back to a spare input and make that input a step capture
+ *  input: {di4mo:1,di4fn:7} for an active high step. No motor driver needs to be fitted.
+ *  The input takes no lockout and is kept off the event ring. Its interrupt stamps each
+ *  leading edge with the timebase clock (timebase.h) at CPU clock resolution - there is
+ *  no timer capture on these boards, so the stamp includes the input interrupt's own
+ *  latency, and the figure is an upper bound. Keep the other inputs quiet while capturing.
+ *
+ *  {stca:1} arms a capture. It starts at the next step edge and takes up to
+ *  STEP_CAPTURE_EDGES edges, until the motion stops. Run one move from a stop. {stca:}
+ *  reads 0 off, 1 armed, 2 capturing, 3 done, and {stca:0} drops a capture.
+ *
+ *  A step starts on a DDA tick, so each edge should be a whole number of ticks
+ *  after the first. {stcj:} is the spread of the edges around that grid, peak to peak in
+ *  us, and {stcn:} the count of edges captured. Segments with no steps restart the DDA
+ *  timer and change its phase, so the grid only holds within a move.
+ *  {stcd:1} dumps the capture, a header and then the intervals between edges in CPU
+ *  clocks, STEP_CAPTURE_DUMP_INTERVALS to a line:
+ *
+ *      {"stch":[edges,cpu_hz,dda_hz]}
+ *      {"stc":[first,interval,interval,...]}   first is the number of the line's first edge
+ */
+#ifndef STEP_CAPTURE_H_ONCE
+#define STEP_CAPTURE_H_ONCE
+
+#if STEP_CAPTURE_ENABLED == true
+
+/**** Configs, Definitions and Structures ****/
+
+#ifndef STEP_CAPTURE_EDGES
+#define STEP_CAPTURE_EDGES          512 // step edges kept for one capture
+#endif
+#define STEP_CAPTURE_DUMP_INTERVALS 8   // edge intervals per dump line
+#define STEP_CAPTURE_DUMPS_PER_CALLBACK 2   // lines sent per controller pass, at most
+
+typedef enum {
+    STC_OFF = 0,                        // not capturing
+    STC_ARMED,                          // waiting for the first edge
+    STC_CAPTURING,                      // recording edges until the motion stops or the buffer is full
+    STC_DONE                            // capture complete
+} stcState;
+
+typedef struct stcSingleton {
+    volatile uint8_t state;             // stcState {stca:} - armed by the controller, advanced by the ISR
+    uint8_t dump;                       // 1 = dump requested {stcd:}
+    volatile uint32_t edges;            // edges captured {stcn:} - written by stc_edge() only
+    float jitter;                       // spread of the edges around the DDA tick grid, us {stcj:}
+    uint32_t dump_next;                 // next edge to dump
+    uint32_t cycles[STEP_CAPTURE_EDGES];// low 32 bits of the timebase clock at each edge
+} stc_t;
+
+extern stc_t stc;
+
+/**** Function Prototypes ****/
+
+void stc_edge(void);
+stat_t stc_callback(void);
+
+stat_t stc_set_stca(nvObj_t *nv);
+stat_t stc_set_stcd(nvObj_t *nv);
+
+#ifdef __TEXT_MODE
+
+    void stc_print_stca(nvObj_t *nv);
+    void stc_print_stcn(nvObj_t *nv);
+    void stc_print_stcj(nvObj_t *nv);
+
+#else
+
+    #define stc_print_stca tx_print_stub
+    #define stc_print_stcn tx_print_stub
+    #define stc_print_stcj tx_print_stub
+
+#endif // __TEXT_MODE
+
+#endif // STEP_CAPTURE_ENABLED
+
+#endif // End of include guard: STEP_CAPTURE_H_ONCE
@@ -34,11 +34,19 @@
 #include "stepper.h"
 #include "encoder.h"
 #include "planner.h"
+#include "kinematics.h"
 #include "hardware.h"
 #include "text_parser.h"
 #include "util.h"
 #include "controller.h"
 #include "xio.h"
+#include "profile.h"
+#include "pwm.h"
+#include "gpio.h"
+#include "motion_link.h"
+#include "bench.h"
+
+#include <atomic>           // atomic_signal_fence() orders the prep ring between ISRs
 
 /**** Debugging output with semihosting ****/
 
@@ -57,12 +65,16 @@ void stepper_debug(const char (&str)[len]) { ; };
 /**** Allocate structures ****/
 
 stConfig_t st_cfg;
-stPrepSingleton_t st_pre;
-static stRunSingleton_t st_run;
+HOT_DATA stPrepSingleton_t st_pre;
+HOT_DATA static stRunSingleton_t st_run;
 
 /**** Static functions ****/
 
 static void _load_move(void);
+static bool _prep_is_full(void);
+static bool _prep_is_empty(void);
+static stPrepSegment_t *_prep_write_segment(void);
+static blockType _exec_block_type(void);
 
 // handy macro
 //#define _f_to_period(f) (uint16_t)((float)F_CPU / (float)f)
@@ -88,6 +100,320 @@ Motate::SysTickEvent dwell_systick_event {[&] {
 }, nullptr};
 
 
+/**** Per-motor expansion ****
+ *
+ *  The DDA interrupt and the loader do the same small piece of work for every motor.
+ *  They used to be written out once per motor under #if MOTORS blocks. Instead the work
+ *  is written once, as a template on the motor number and the motor's concrete type,
+ *  and expanded at compile time across STEPPER_MOTOR_LIST. Each expansion calls its
+ *  motor directly (qualified calls bind statically, no virtual dispatch) and indexes
+ *  st_run with a constant, so the result is the same straight-line code as the old hand
+ *  unrolled version. Enables and power state changes go through the Stepper's enableAs<M>()
+ *  and motionStoppedAs<M>() for the same reason. To add a motor, add it to the board files
+ *  and to the list below.
+ *
+ *  The templates are C++11 parameter pack recursions: each takes the first motor off the
+ *  list, does its work, and recurses on the rest. The empty list ends the recursion.
+ */
+
+#if (MOTORS == 1)
+#define STEPPER_MOTOR_LIST motor_1
+#elif (MOTORS == 2)
+#define STEPPER_MOTOR_LIST motor_1, motor_2
+#elif (MOTORS == 3)
+#define STEPPER_MOTOR_LIST motor_1, motor_2, motor_3
+#elif (MOTORS == 4)
+#define STEPPER_MOTOR_LIST motor_1, motor_2, motor_3, motor_4
+#elif (MOTORS == 5)
+#define STEPPER_MOTOR_LIST motor_1, motor_2, motor_3, motor_4, motor_5
+#elif (MOTORS == 6)
+#define STEPPER_MOTOR_LIST motor_1, motor_2, motor_3, motor_4, motor_5, motor_6
+#else
+#error "STEPPER_MOTOR_LIST supports 1 to 6 motors"
+#endif
+
+/*
+ * _step_end()       - clear the step pulses set in the previous DDA tick
+ * _dda_step()       - run one DDA tick for each motor, setting step pulses as needed
+ * _write_steps()    - write the batched step masks, one port write per port in use
+ * _motion_stopped() - start motor power timeouts when there is nothing to load
+ * _load_motor()     - load each motor's part of a prepared line segment into the runtime
+ * _prep_position()  - turn a segment's travel into whole steps for position drivers
+ * _load_position()  - hand a position driver its new step position as the segment loads
+ *
+ *  With STEP_PULSE_BATCHING the first two only collect bits into step_mask[], indexed by
+ *  port ('A' == 0). _write_steps() then walks the list again and the first motor on each
+ *  port writes and zeroes that port's word, so later motors on the same port skip it.
+ *  step_port and step_mask are compile-time constants, so the unused ports, the non-batched
+ *  branches and the masks themselves all fold away.
+ */
+
+template<uint8_t port>
+struct _StepPort {                          // port write wrapper - port is the port letter
+    static inline void set(const uint32_t mask) { Motate::Port32<port> p; p.set(mask); }
+    static inline void clear(const uint32_t mask) { Motate::Port32<port> p; p.clear(mask); }
+};
+
+template<>
+struct _StepPort<0> {                       // drivers without step_port are never port written
+    static inline void set(const uint32_t) {}
+    static inline void clear(const uint32_t) {}
+};
+
+template<uint8_t motor>
+static inline void _step_end(uint32_t *step_mask) {}
+
+template<uint8_t motor, typename M, typename... Ms>
+static inline void _step_end(uint32_t *step_mask, M &m, Ms&... ms)
+{
+    if (STEP_PULSE_BATCHING && M::step_port) {
+        step_mask[M::step_port - 'A'] |= M::step_mask;
+    } else {
+        m.M::stepEnd();
+    }
+    _step_end<motor+1>(step_mask, ms...);
+}
+
+template<uint8_t motor>
+static inline void _dda_step(uint32_t *step_mask) {}
+
+template<uint8_t motor, typename M, typename... Ms>
+static inline void _dda_step(uint32_t *step_mask, M &m, Ms&... ms)
+{
+    if ((st_run.dda[motor].substep_accumulator += st_run.dda[motor].substep_increment) > 0) {
+        if (STEP_PULSE_BATCHING && M::step_port) {
+            step_mask[M::step_port - 'A'] |= M::step_mask;
+        } else {
+            m.M::stepStart();   // turn step bit on
+        }
+        st_run.dda[motor].substep_accumulator -= st_run.dda_ticks_X_substeps;
+    }
+    _dda_step<motor+1>(step_mask, ms...);
+}
+
+template<bool set>
+static inline void _write_steps(uint32_t *step_mask) {}
+
+template<bool set, typename M, typename... Ms>
+static inline void _write_steps(uint32_t *step_mask, M &m, Ms&... ms)
+{
+    if (STEP_PULSE_BATCHING && M::step_port) {
+        uint32_t &mask = step_mask[M::step_port - 'A'];
+        if (mask) {
+            if (set) {
+                _StepPort<M::step_port>::set(mask);
+            } else {
+                _StepPort<M::step_port>::clear(mask);
+            }
+            mask = 0;
+        }
+    }
+    _write_steps<set>(step_mask, ms...);
+}
+
+template<uint8_t motor>
+static inline void _motion_stopped() {}
+
+template<uint8_t motor, typename M, typename... Ms>
+static inline void _motion_stopped(M &m, Ms&... ms)
+{
+    m.template motionStoppedAs<M>();
+    _motion_stopped<motor+1>(ms...);
+}
+
+template<uint8_t motor>
+static inline void _prep_position(stPrepSegment_t *, const float *) {}
+
+template<uint8_t motor, typename M, typename... Ms>
+static inline void _prep_position(stPrepSegment_t *seg, const float travel_steps[], M &m, Ms&... ms)
+{
+    if (M::step_position) {
+        stPrepSegmentMotor_t *pm = &seg->mot[motor];
+        float steps = st_pre.mot[motor].position_carry + travel_steps[motor];
+        pm->position_steps = (int16_t)steps;            // the fraction carries to the next segment
+        st_pre.mot[motor].position_carry = steps - pm->position_steps;
+        pm->substep_increment = 0;                      // ...and the DDA has nothing to do
+    }
+    _prep_position<motor+1>(seg, travel_steps, ms...);
+}
+
+template<uint8_t motor, typename M>
+static inline void _load_position(stPrepSegment_t *seg, M &m)
+{
+    if (seg->mot[motor].position_steps != 0) {
+        m.template enableAs<M>();
+        SET_ENCODER_STEPS_RUN(motor, seg->mot[motor].position_steps);
+        ACCUMULATE_ENCODER(motor);                      // counted up front, like a waveform segment
+        m.M::setPosition(en.en[motor].encoder_steps);
+    } else {
+        m.template motionStoppedAs<M>();
+    }
+}
+
+template<uint8_t motor>
+static inline void _load_motor(stPrepSegment_t *) {}
+
+template<uint8_t motor, typename M, typename... Ms>
+static inline void _load_motor(stPrepSegment_t *seg, M &m, Ms&... ms)
+{
+    // These sections are somewhat optimized for execution speed. The whole load operation
+    // is supposed to take < 5 uSec (Arm M3 core). Be careful if you mess with this.
+
+    if (M::step_position) {                             // position drivers never see the DDA
+        _load_position<motor>(seg, m);
+        _load_motor<motor+1>(seg, ms...);
+        return;
+    }
+
+#if (STEP_ENGINE_WAVEFORM == 1)
+    // accumulate the steps of the segment that just finished, then count this one up front
+    ACCUMULATE_ENCODER(motor);
+    if (seg->mot[motor].substep_increment != 0) {
+        if (seg->mot[motor].direction != st_pre.mot[motor].prev_direction) {
+            st_pre.mot[motor].prev_direction = seg->mot[motor].direction;
+            m.M::setDirection(seg->mot[motor].direction);
+        }
+        m.template enableAs<M>();
+        SET_ENCODER_STEP_SIGN(motor, seg->mot[motor].step_sign);
+        SET_ENCODER_STEPS_RUN(motor, seg->mot[motor].wave_steps * seg->mot[motor].step_sign);
+        m.waveformStart(seg - st_pre.seg, seg->dda_ticks);
+    } else {
+        m.template motionStoppedAs<M>();
+    }
+#else
+    // the following if() statement sets the runtime substep increment value or zeroes it
+    if ((st_run.dda[motor].substep_increment = seg->mot[motor].substep_increment) != 0) {
+
+        // NB: If motor has 0 steps the following is all skipped. This ensures that state comparisons
+        //     always operate on the last segment actually run by this motor, regardless of how many
+        //     segments it may have been inactive in between.
+
+        // Apply accumulator correction if the time base has changed since previous segment
+        if (seg->mot[motor].accumulator_correction_flag == true) {
+            seg->mot[motor].accumulator_correction_flag = false;
+            st_run.dda[motor].substep_accumulator *= seg->mot[motor].accumulator_correction;
+        }
+
+        // Detect direction change and if so:
+        //    Set the direction bit in hardware.
+        //    Compensate for direction change by flipping substep accumulator value about its midpoint.
+
+        if (seg->mot[motor].direction != st_pre.mot[motor].prev_direction) {
+            st_pre.mot[motor].prev_direction = seg->mot[motor].direction;
+            st_run.dda[motor].substep_accumulator = -(st_run.dda_ticks_X_substeps + st_run.dda[motor].substep_accumulator);
+            m.M::setDirection(seg->mot[motor].direction);
+        }
+
+        // Enable the stepper and start/update motor power management
+        m.template enableAs<M>();
+        SET_ENCODER_STEP_SIGN(motor, seg->mot[motor].step_sign);
+
+    } else {  // Motor has 0 steps; might need to energize motor for power mode processing
+        m.template motionStoppedAs<M>();
+    }
+    // the steps of this segment are counted from here when it's done - see _count_steps_run()
+    st_run.mot[motor].accumulator_start = st_run.dda[motor].substep_accumulator;
+#endif
+    _load_motor<motor+1>(seg, ms...);
+}
+
+#if (STEP_ENGINE_WAVEFORM == 0)
+/*
+ * _count_steps_run() - add the steps of the segment that ran to the encoders
+ * st_get_steps_run() - steps a motor has taken so far in the running segment
+ *
+ *  The DDA doesn't count steps as it issues them. Each tick adds the increment to the
+ *  accumulator and each step takes dda_ticks_X_substeps back off, so the steps issued in
+ *  a segment are exactly:
+ *
+ *      (accumulator at load + ticks run * increment - accumulator now) / dda_ticks_X_substeps
+ *
+ *  _count_steps_run() works this out once per segment, in the loader, before the next
+ *  segment replaces the ticks and increments. Ticks not run - a segment stopped part way
+ *  by stepper_reset() - are left out, so the count is right for a partial segment as well.
+ *  Counting leaves nothing to count a second time, so it's safe to call whenever the DDA
+ *  isn't running a segment.
+ */
+
+static int32_t _steps_run(uint8_t motor, uint32_t ticks_run)
+{
+    if (st_run.dda_ticks_X_substeps == 0) {
+        return (0);                                     // nothing loaded yet
+    }
+    int64_t travel = (int64_t)st_run.mot[motor].accumulator_start +
+                     (int64_t)ticks_run * st_run.dda[motor].substep_increment -
+                     st_run.dda[motor].substep_accumulator;
+    return ((int32_t)(travel / st_run.dda_ticks_X_substeps) * en.en[motor].step_sign);
+}
+
+static void _count_steps_run()
+{
+    uint32_t ticks_run = st_run.dda_ticks - st_run.dda_ticks_downcount;
+
+    for (uint8_t motor=0; motor<MOTORS; motor++) {
+        SET_ENCODER_STEPS_RUN(motor, _steps_run(motor, ticks_run));
+        ACCUMULATE_ENCODER(motor);
+        st_run.mot[motor].accumulator_start = st_run.dda[motor].substep_accumulator;
+    }
+    st_run.dda_ticks = st_run.dda_ticks_downcount;      // what's left, if anything, is still to count
+}
+
+int32_t st_get_steps_run(uint8_t motor)
+{
+    return (_steps_run(motor, st_run.dda_ticks - st_run.dda_ticks_downcount));
+}
+#else
+int32_t st_get_steps_run(uint8_t motor) { return (0); } // the waveform engine counts a segment up front
+#endif // STEP_ENGINE_WAVEFORM
+
+#if (STEP_ENGINE_WAVEFORM == 1)
+/*
+ * _prep_waveform() - run the DDA for a prepared segment and write each motor's waveform
+ *
+ *  This is the same arithmetic the DDA ISR and _load_motor() do, run at prep time on an
+ *  accumulator kept in st_pre. Direction flips and time base corrections are applied here,
+ *  so the loader only has to set the direction pin and start the tables. The direction
+ *  setup time (STEP_DIR_SETUP_NS) is enforced here too.
+ */
+
+template<uint8_t motor>
+static inline void _prep_waveform(stPrepSegment_t *, const uint8_t) {}
+
+template<uint8_t motor, typename M, typename... Ms>
+static inline void _prep_waveform(stPrepSegment_t *seg, const uint8_t slot, M &m, Ms&... ms)
+{
+    static_assert(M::step_waveform || M::step_position, "STEP_ENGINE_WAVEFORM requires a waveform driver on every motor");
+
+    stPrepSegmentMotor_t *pm = &seg->mot[motor];
+    pm->wave_steps = 0;
+    if (pm->substep_increment != 0) {
+        int32_t accumulator = st_pre.mot[motor].wave_accumulator;
+        if (pm->accumulator_correction_flag == true) {
+            accumulator *= pm->accumulator_correction;
+        }
+        uint32_t tick = 0;
+        if (pm->direction != st_pre.mot[motor].wave_direction) {
+            st_pre.mot[motor].wave_direction = pm->direction;
+            accumulator = -(seg->dda_ticks_X_substeps + accumulator);
+
+            // the dir pin is set as the segment starts, so hold off pulses for the setup time
+            tick = std::min(STEP_DIR_SETUP_TICKS, seg->dda_ticks);
+            accumulator += pm->substep_increment * (int32_t)tick;
+        }
+        m.waveformClear(slot, seg->dda_ticks);
+        for ( ; tick < seg->dda_ticks; tick++) {
+            if ((accumulator += pm->substep_increment) > 0) {
+                m.waveformStep(slot, tick);
+                accumulator -= seg->dda_ticks_X_substeps;
+                pm->wave_steps++;
+            }
+        }
+        st_pre.mot[motor].wave_accumulator = accumulator;
+    }
+    _prep_waveform<motor+1>(seg, slot, ms...);
+}
+#endif // STEP_ENGINE_WAVEFORM
+
 /************************************************************************************
  **** CODE **************************************************************************
  ************************************************************************************/
@@ -126,7 +452,8 @@ void stepper_init()
 
     // setup software interrupt exec timer & initial condition
     exec_timer.setInterrupts(kInterruptOnSoftwareTrigger | kInterruptPriorityHigh);
-    st_pre.buffer_state = PREP_BUFFER_OWNED_BY_EXEC;
+    st_pre.write = 0;                                   // prep ring is empty
+    st_pre.read = 0;
 
     // setup software interrupt forward plan timer & initial condition
     fwd_plan_timer.setInterrupts(kInterruptOnSoftwareTrigger | kInterruptPriorityMedium);
@@ -149,15 +476,36 @@ void stepper_init()
 void stepper_reset()
 {
     dda_timer.stop();                                   // stop all movement
+#if (STEP_ENGINE_WAVEFORM == 0)
+    _count_steps_run();                                 // count the part of the segment that ran
+#endif
     st_run.dda_ticks_downcount = 0;                     // signal the runtime is not busy
+    st_run.dda_ticks = 0;
     st_run.dwell_ticks_downcount = 0;
-    st_pre.buffer_state = PREP_BUFFER_OWNED_BY_EXEC;    // set to EXEC or it won't restart
+    if (st_run.dda_idle) {                              // put the DDA back to its tick rate
+        dda_timer.setModeAndFrequency(kTimerUpToMatch, FREQUENCY_DDA);
+        st_run.dda_idle = false;
+    }
+    st_pre.read = st_pre.write;                         // discard prepped segments or it won't restart
+    for (uint8_t i=0; i<PREP_BUFFERS; i++) {
+        st_pre.seg[i].block_type = BLOCK_TYPE_NULL;
+    }
 
     for (uint8_t motor=0; motor<MOTORS; motor++) {
         st_pre.mot[motor].prev_direction = STEP_INITIAL_DIRECTION;
-        st_pre.mot[motor].direction = STEP_INITIAL_DIRECTION;
-        st_run.mot[motor].substep_accumulator = 0;      // will become max negative during per-motor setup;
+        st_run.dda[motor].substep_accumulator = 0;      // will become max negative during per-motor setup;
+#if (STEP_ENGINE_WAVEFORM == 1)
+        st_pre.mot[motor].wave_direction = STEP_INITIAL_DIRECTION;
+        st_pre.mot[motor].wave_accumulator = 0;
+#endif
         st_pre.mot[motor].corrected_steps = 0;          // diagnostic only - no action effect
+        st_pre.mot[motor].ff_velocity = 0;
+        st_pre.mot[motor].ff_lead = 0;
+        st_pre.mot[motor].ff_lead_max = 0;
+        st_pre.mot[motor].backlash_known = false;
+        st_pre.mot[motor].backlash_offset = 0;
+        st_pre.mot[motor].position_carry = 0;
+        st_pre.mot[motor].stopped = false;
     }
     mp_set_steps_to_runtime_position();                 // reset encoder to agree with the above
 }
@@ -184,6 +532,36 @@ stat_t stepper_test_assertions()
     return (STAT_OK);
 }
 
+/*
+ * _prep_is_full()       - true if exec has no room to prep the next segment into
+ * _prep_is_empty()      - true if the loader has nothing to load
+ * _prep_write_segment() - the slot exec is prepping into
+ * st_prep_lines_queued() - count of line segments prepped but not yet loaded
+ *
+ *  The ring indexes are single bytes, so reads and writes of them are atomic. Exec only
+ *  advances write and the loader only advances read, so (write - read) is the number of
+ *  slots in use as seen from either side. See stepper.h. A segment may take more than one
+ *  slot (PREP_SLOTS_PER_SEGMENT), so 'full' means there is no room for a whole segment.
+ */
+
+static bool _prep_is_full() { return ((uint8_t)(st_pre.write - st_pre.read) > (PREP_BUFFERS - PREP_SLOTS_PER_SEGMENT)); }
+static bool _prep_is_empty() { return (st_pre.write == st_pre.read); }
+static stPrepSegment_t *_prep_write_segment() { return (&st_pre.seg[st_pre.write & PREP_BUFFER_MASK]); }
+
+// the type of block the exec is running - NULL for none (jogs, tracking) - for the underrun counts
+static blockType _exec_block_type() { return ((mb.r->buffer_state == MP_BUFFER_RUNNING) ? mb.r->block_type : BLOCK_TYPE_NULL); }
+
+uint8_t st_prep_lines_queued()
+{
+    uint8_t lines = 0;
+    for (uint8_t i = st_pre.read; i != st_pre.write; i++) {
+        if (st_pre.seg[i & PREP_BUFFER_MASK].block_type == BLOCK_TYPE_ALINE) {
+            lines++;
+        }
+    }
+    return (lines);
+}
+
 /*
  * st_runtime_isbusy() - return TRUE if runtime is busy:
  *
@@ -204,23 +582,34 @@ bool st_runtime_isbusy()
 stat_t st_clc(nvObj_t *nv)    // clear diagnostic counters, reset stepper prep
 {
     stepper_reset();
+    st_pre.underruns = 0;
+    memset(st_pre.type_underruns, 0, sizeof(st_pre.type_underruns));
+    mp.step_rate_clamps = 0;
     return(STAT_OK);
 }
 
 /*
  * st_motor_power_callback() - callback to manage motor power sequencing
  *
- *  Handles motor power-down timing, low-power idle, and adaptive motor power
+ *  Handles motor power-down timing, low-power idle, and adaptive motor power.
+ *  Driver polling (periodicPoll()) runs every pass; the rest waits for phat city.
  */
 stat_t st_motor_power_callback()     // called by controller
 {
+    for (uint8_t motor = MOTOR_1; motor < MOTORS; motor++) {
+        Motors[motor]->periodicPoll();  // driver status polling can't wait for phat city
+        if (st_cfg.mot[motor].stall_input != 0) {   // a stall is a virtual switch, e.g. to home on
+            gpio_set_virtual_input(st_cfg.mot[motor].stall_input, Motors[motor]->isStalled());
+        }
+    }
+
     if (!mp_is_phat_city_time()) {   // don't process this if you are time constrained in the planner
         return (STAT_NOOP);
     }
 
     bool have_actually_stopped = false;
     if ((!st_runtime_isbusy()) &&
-        (st_pre.buffer_state != PREP_BUFFER_OWNED_BY_LOADER) &&
+        (_prep_is_empty()) &&
         (cm_get_cycle_state() == CYCLE_OFF)
         )
     {    // if there are no moves to load...
@@ -253,96 +642,71 @@ stat_t st_motor_power_callback()     // called by controller
  *
  *  Note that the motor_N.step.isNull() tests are compile-time tests, not run-time tests.
  *  If motor_N is not defined that if{} clause (i.e. that motor) drops out of the complied code.
+ *
+ *  With STEP_PULSE_BATCHING the step pins are written per port, not per motor, so all
+ *  motors on a port step on the same store. See _write_steps().
  */
 
+#if (STEP_ENGINE_WAVEFORM == 1)
+/*
+ *  With STEP_ENGINE_WAVEFORM the step pulses are played by DMA and the DDA timer interrupts
+ *  once, at the end of the segment, to load the next one. The loader stops and restarts it.
+ */
 namespace Motate {            // Must define timer interrupts inside the Motate namespace
 template<>
-void dda_timer_type::interrupt()
+HOT_PATH void dda_timer_type::interrupt()
 {
+    PROF_START(prof_cycles);
     dda_timer.getInterruptCause();  // clear interrupt condition
+    dda_timer.stop();
+    st_run.dda_ticks_downcount = 0; // the segment has played out
+    PROF_END(PROF_DDA, prof_cycles);
+    _load_move();
+} // MOTATE_TIMER_INTERRUPT
+} // namespace Motate
+#else
+namespace Motate {            // Must define timer interrupts inside the Motate namespace
+template<>
+HOT_PATH void dda_timer_type::interrupt()
+{
+    PROF_START(prof_cycles);
+    dda_timer.getInterruptCause();  // clear interrupt condition
+
+    uint32_t step_mask[STEP_PORTS] = {0};   // batched step bits, one word per port
 
     // clear all steps from the previous interrupt
-	// for (uint8_t motor=0; motor<MOTORS; motor++) {
-	//	  Motors[motor]->stepEnd();
-	// }
-	// loop unrolled version (it's actually faster)
-    motor_1.stepEnd();
-    motor_2.stepEnd();
-#if MOTORS > 2
-    motor_3.stepEnd();
-#endif
-#if MOTORS > 3
-    motor_4.stepEnd();
-#endif
-#if MOTORS > 4
-    motor_5.stepEnd();
-#endif
-#if MOTORS > 5
-    motor_6.stepEnd();
-#endif
+    _step_end<MOTOR_1>(step_mask, STEPPER_MOTOR_LIST);
+    _write_steps<false>(step_mask, STEPPER_MOTOR_LIST);
+
+    // an idle segment is a single timer period - see _load_move()
+    if (st_run.dda_idle) {
+        dda_timer.stop();           // the loader restarts it if there is more to run
+        st_run.dda_ticks_downcount = 0;
+        PROF_END(PROF_DDA, prof_cycles);
+        _load_move();
+        return;
+    }
 
     // process last DDA tick after end of segment
     if (st_run.dda_ticks_downcount == 0) {
         dda_timer.stop(); // turn it off or it will keep stepping out the last segment
+        PROF_END(PROF_DDA, prof_cycles);
         return;
     }
 
-//  The following code would work, but it's faster on the M3 to loop unroll it. Perhaps not on the M7
-//    for (uint8_t motor=0; motor<MOTORS; motor++) {
-//        if  ((st_run.mot[motor].substep_accumulator += st_run.mot[motor].substep_increment) > 0) {
-//            Motors[motor]->stepStart();        // turn step bit on
-//            st_run.mot[motor].substep_accumulator -= st_run.dda_ticks_X_substeps;
-//            INCREMENT_ENCODER(motor);
-//        }
-//    }
-
-    // process DDAs for each motor
-        if  ((st_run.mot[MOTOR_1].substep_accumulator += st_run.mot[MOTOR_1].substep_increment) > 0) {
-            motor_1.stepStart();        // turn step bit on
-            st_run.mot[MOTOR_1].substep_accumulator -= st_run.dda_ticks_X_substeps;
-            INCREMENT_ENCODER(MOTOR_1);
-        }
-        if ((st_run.mot[MOTOR_2].substep_accumulator += st_run.mot[MOTOR_2].substep_increment) > 0) {
-            motor_2.stepStart();        // turn step bit on
-            st_run.mot[MOTOR_2].substep_accumulator -= st_run.dda_ticks_X_substeps;
-            INCREMENT_ENCODER(MOTOR_2);
-        }
-#if MOTORS > 2
-        if ((st_run.mot[MOTOR_3].substep_accumulator += st_run.mot[MOTOR_3].substep_increment) > 0) {
-            motor_3.stepStart();        // turn step bit on
-            st_run.mot[MOTOR_3].substep_accumulator -= st_run.dda_ticks_X_substeps;
-            INCREMENT_ENCODER(MOTOR_3);
-        }
-#endif
-#if MOTORS > 3
-        if ((st_run.mot[MOTOR_4].substep_accumulator += st_run.mot[MOTOR_4].substep_increment) > 0) {
-            motor_4.stepStart();        // turn step bit on
-            st_run.mot[MOTOR_4].substep_accumulator -= st_run.dda_ticks_X_substeps;
-            INCREMENT_ENCODER(MOTOR_4);
-        }
-#endif
-#if MOTORS > 4
-        if ((st_run.mot[MOTOR_5].substep_accumulator += st_run.mot[MOTOR_5].substep_increment) > 0) {
-            motor_5.stepStart();        // turn step bit on
-            st_run.mot[MOTOR_5].substep_accumulator -= st_run.dda_ticks_X_substeps;
-            INCREMENT_ENCODER(MOTOR_5);
-        }
-#endif
-#if MOTORS > 5
-        if ((st_run.mot[MOTOR_6].substep_accumulator += st_run.mot[MOTOR_6].substep_increment) > 0) {
-            motor_6.stepStart();        // turn step bit on
-            st_run.mot[MOTOR_6].substep_accumulator -= st_run.dda_ticks_X_substeps;
-            INCREMENT_ENCODER(MOTOR_6);
-        }
-#endif
+    // process DDAs for each motor, then set the step bits of all motors that stepped
+    _dda_step<MOTOR_1>(step_mask, STEPPER_MOTOR_LIST);
+    _write_steps<true>(step_mask, STEPPER_MOTOR_LIST);
 
     // Process end of segment. 
     // One more interrupt will occur to turn of any pulses set in this pass.
     if (--st_run.dda_ticks_downcount == 0) {
         _load_move();       // load the next move at the current interrupt level
     }
+    PROF_END(PROF_DDA, prof_cycles);
 } // MOTATE_TIMER_INTERRUPT
 } // namespace Motate
+#endif // STEP_ENGINE_WAVEFORM
 
 /****************************************************************************************
  * Exec sequencing code   - computes and prepares next load segment
@@ -359,19 +723,26 @@ void st_request_exec_move()
 
 namespace Motate {    // Define timer inside Motate namespace
     template<>
-    void exec_timer_type::interrupt()
+    HOT_PATH void exec_timer_type::interrupt()
     {
+        PROF_START(prof_cycles);
         exec_timer.getInterruptCause();                    // clears the interrupt condition
-        if (st_pre.buffer_state == PREP_BUFFER_OWNED_BY_EXEC) {
+        if (!_prep_is_full()) {
             stepper_debug("E>");
             if (mp_exec_move() != STAT_NOOP) {
                 stepper_debug("E+\n");
-                st_pre.buffer_state = PREP_BUFFER_OWNED_BY_LOADER; // flip it back
+                std::atomic_signal_fence(std::memory_order_release);   // slot contents before the index
+                st_pre.write++;                                 // hand the slot to the loader
+                PROF_END(PROF_EXEC, prof_cycles);              // don't count the load, it's profiled separately
                 st_request_load_move();
+                if (!_prep_is_full()) {
+                    st_request_exec_move();                     // run ahead while there is room
+                }
                 return;
             }
             stepper_debug("E-\n");
         }
+        PROF_END(PROF_EXEC, prof_cycles);
     }
 } // namespace Motate
 
@@ -398,7 +769,7 @@ namespace Motate {    // Define timer inside Motate namespace
 
 /****************************************************************************************
  * Loader sequencing code
- * st_request_load_move() - fires a software interrupt (timer) to request to load a move
+ * st_request_load_move() - runs the loader if the runtime is free, to request to load a move
  * load_move interrupt    - interrupt handler for running the loader
  *
  *  _load_move() can only be called be called from an ISR at the same or higher level as
@@ -412,7 +783,7 @@ void st_request_load_move()
         return;
     }
     stepper_debug("l");
-    if (st_pre.buffer_state == PREP_BUFFER_OWNED_BY_LOADER) {       // bother interrupting
+    if (!_prep_is_empty()) {                                        // bother interrupting
         stepper_debug("_");
         _load_move();
     }
@@ -431,208 +802,117 @@ void st_request_load_move()
  *   - If axis has 0 steps the motor power must be set accord to the power mode
  */
 
-static void _load_move()
+HOT_PATH static void _load_move()
 {
     // Be aware that dda_ticks_downcount must equal zero for the loader to run.
     // So the initial load must also have this set to zero as part of initialization
     if (st_runtime_isbusy()) {
         return;                                                    // exit if the runtime is busy
     }
-    if (st_pre.buffer_state != PREP_BUFFER_OWNED_BY_LOADER) {    // if there are no moves to load...
+    if (_prep_is_empty()) {                                     // if there are no moves to load...
 
         if (cm.motion_state == MOTION_RUN)  {
+            st_pre.underruns++;                                 // the DDA has starved
+            st_pre.type_underruns[_exec_block_type()]++;
 #if IN_DEBUGGER == 1
 //#warning debbugger REQUIRED for running this firmware!
-//            __asm__("BKPT"); // attempted to _load_move with PREP_BUFFER_OWNED_BY_EXEC and cm.motion_state == MOTION_RUN
+//            __asm__("BKPT"); // attempted to _load_move with an empty prep ring and cm.motion_state == MOTION_RUN
 #endif
             st_request_exec_move();
             return;
         }
 
-	// ...start motor power timeouts
-	//	for (uint8_t motor = MOTOR_1; motor < MOTORS; motor++) {
-	//		Motors[motor]->motionStopped();    
-	//  }
-	// loop unrolled version
-        motor_1.motionStopped();    // ...start motor power timeouts
-        motor_2.motionStopped();    // ...start motor power timeouts
-#if (MOTORS > 2)
-        motor_3.motionStopped();    // ...start motor power timeouts
-#endif
-#if (MOTORS > 3)
-        motor_4.motionStopped();    // ...start motor power timeouts
-#endif
-#if (MOTORS > 4)
-        motor_5.motionStopped();    // ...start motor power timeouts
-#endif
-#if (MOTORS > 5)
-        motor_6.motionStopped();    // ...start motor power timeouts
+#if (STEP_ENGINE_WAVEFORM == 0)
+        _count_steps_run();                             // bring the encoders up to the stopped position
 #endif
+	// ...start motor power timeouts
+        _motion_stopped<MOTOR_1>(STEPPER_MOTOR_LIST);   // ...start motor power timeouts
         stepper_debug("•");
         return;
-    } // if (st_pre.buffer_state != PREP_BUFFER_OWNED_BY_LOADER)
+    } // if (_prep_is_empty())
 
     stepper_debug("^");
+    PROF_START(prof_cycles);                            // only profile loads that do something
+    std::atomic_signal_fence(std::memory_order_acquire);    // index before the slot contents
+    stPrepSegment_t *seg = &st_pre.seg[st_pre.read & PREP_BUFFER_MASK];
+
+    if (bench.dry_run) {                                // time segments and dwells and drop them as nulls - see bench.h
+        if (seg->block_type == BLOCK_TYPE_ALINE) {
+            bench.segments++;
+            bench.dda_ticks += seg->dda_ticks;
+            seg->block_type = BLOCK_TYPE_NULL;
+        } else if (seg->block_type == BLOCK_TYPE_DWELL) {
+            bench.dwell_ticks += seg->dwell_ticks;
+            seg->block_type = BLOCK_TYPE_NULL;
+        }
+    }
+    if ((seg->block_type == BLOCK_TYPE_ALINE) && !mln_take_clock()) {
+        return;                                         // motion link follower - wait for the leader's clock
+    }
 
     // handle aline loads first (most common case)  NB: there are no more lines, only alines
-    if (st_pre.block_type == BLOCK_TYPE_ALINE) {
+    if (seg->block_type == BLOCK_TYPE_ALINE) {
 
         //**** setup the new segment ****
 
-        st_run.dda_ticks_downcount = st_pre.dda_ticks;
-        st_run.dda_ticks_X_substeps = st_pre.dda_ticks_X_substeps;
-
-        // INLINED VERSION: 4.3us
-        //**** MOTOR_1 LOAD ****
-
-        // These sections are somewhat optimized for execution speed. The whole load operation
-        // is supposed to take < 5 uSec (Arm M3 core). Be careful if you mess with this.
-
-        // the following if() statement sets the runtime substep increment value or zeroes it
-        if ((st_run.mot[MOTOR_1].substep_increment = st_pre.mot[MOTOR_1].substep_increment) != 0) {
-
-            // NB: If motor has 0 steps the following is all skipped. This ensures that state comparisons
-            //     always operate on the last segment actually run by this motor, regardless of how many
-            //     segments it may have been inactive in between.
-
-            // Apply accumulator correction if the time base has changed since previous segment
-            if (st_pre.mot[MOTOR_1].accumulator_correction_flag == true) {
-                st_pre.mot[MOTOR_1].accumulator_correction_flag = false;
-                st_run.mot[MOTOR_1].substep_accumulator *= st_pre.mot[MOTOR_1].accumulator_correction;
-            }
-
-            // Detect direction change and if so:
-            //    Set the direction bit in hardware.
-            //    Compensate for direction change by flipping substep accumulator value about its midpoint.
-
-            if (st_pre.mot[MOTOR_1].direction != st_pre.mot[MOTOR_1].prev_direction) {
-                st_pre.mot[MOTOR_1].prev_direction = st_pre.mot[MOTOR_1].direction;
-                st_run.mot[MOTOR_1].substep_accumulator = -(st_run.dda_ticks_X_substeps + st_run.mot[MOTOR_1].substep_accumulator);
-                motor_1.setDirection(st_pre.mot[MOTOR_1].direction);
-            }
+#if (STEP_ENGINE_WAVEFORM == 0)
+        _count_steps_run();                             // finish with the old segment before it's replaced
+        st_run.dda_ticks = seg->dda_ticks;
+#endif
+        st_run.dda_ticks_downcount = seg->dda_ticks;
+        st_run.dda_ticks_X_substeps = seg->dda_ticks_X_substeps;
 
-            // Enable the stepper and start/update motor power management
-            motor_1.enable();
-            SET_ENCODER_STEP_SIGN(MOTOR_1, st_pre.mot[MOTOR_1].step_sign);
+        // per-motor loads - see _load_motor()
+        _load_motor<MOTOR_1>(seg, STEPPER_MOTOR_LIST);
 
-        } else {  // Motor has 0 steps; might need to energize motor for power mode processing
-            motor_1.motionStopped();
+        if (seg->laser_duty >= 0) {
+            pwm_set_duty(PWM_1, seg->laser_duty);       // laser power follows the segment velocity
         }
-        // accumulate counted steps to the step position and zero out counted steps for the segment currently being loaded
-        ACCUMULATE_ENCODER(MOTOR_1);
-
-#if (MOTORS >= 2)
-        if ((st_run.mot[MOTOR_2].substep_increment = st_pre.mot[MOTOR_2].substep_increment) != 0) {
-            if (st_pre.mot[MOTOR_2].accumulator_correction_flag == true) {
-                st_pre.mot[MOTOR_2].accumulator_correction_flag = false;
-                st_run.mot[MOTOR_2].substep_accumulator *= st_pre.mot[MOTOR_2].accumulator_correction;
-            }
-            if (st_pre.mot[MOTOR_2].direction != st_pre.mot[MOTOR_2].prev_direction) {
-                st_pre.mot[MOTOR_2].prev_direction = st_pre.mot[MOTOR_2].direction;
-                st_run.mot[MOTOR_2].substep_accumulator = -(st_run.dda_ticks_X_substeps + st_run.mot[MOTOR_2].substep_accumulator);
-                motor_2.setDirection(st_pre.mot[MOTOR_2].direction);
-            }
-            motor_2.enable();
-            SET_ENCODER_STEP_SIGN(MOTOR_2, st_pre.mot[MOTOR_2].step_sign);
-        } else {
-            motor_2.motionStopped();
+        if (seg->output_set | seg->output_clear) {
+            gpio_write_outputs(seg->output_set, seg->output_clear); // M62/M63 synchronized outputs
         }
-        ACCUMULATE_ENCODER(MOTOR_2);
-#endif
-#if (MOTORS >= 3)
-        if ((st_run.mot[MOTOR_3].substep_increment = st_pre.mot[MOTOR_3].substep_increment) != 0) {
-            if (st_pre.mot[MOTOR_3].accumulator_correction_flag == true) {
-                st_pre.mot[MOTOR_3].accumulator_correction_flag = false;
-                st_run.mot[MOTOR_3].substep_accumulator *= st_pre.mot[MOTOR_3].accumulator_correction;
-            }
-            if (st_pre.mot[MOTOR_3].direction != st_pre.mot[MOTOR_3].prev_direction) {
-                st_pre.mot[MOTOR_3].prev_direction = st_pre.mot[MOTOR_3].direction;
-                st_run.mot[MOTOR_3].substep_accumulator = -(st_run.dda_ticks_X_substeps + st_run.mot[MOTOR_3].substep_accumulator);
-                motor_3.setDirection(st_pre.mot[MOTOR_3].direction);
-            }
-            motor_3.enable();
-            SET_ENCODER_STEP_SIGN(MOTOR_3, st_pre.mot[MOTOR_3].step_sign);
-        } else {
-            motor_3.motionStopped();
-        }
-        ACCUMULATE_ENCODER(MOTOR_3);
-#endif
-#if (MOTORS >= 4)
-        if ((st_run.mot[MOTOR_4].substep_increment = st_pre.mot[MOTOR_4].substep_increment) != 0) {
-            if (st_pre.mot[MOTOR_4].accumulator_correction_flag == true) {
-                st_pre.mot[MOTOR_4].accumulator_correction_flag = false;
-                st_run.mot[MOTOR_4].substep_accumulator *= st_pre.mot[MOTOR_4].accumulator_correction;
-            }
-            if (st_pre.mot[MOTOR_4].direction != st_pre.mot[MOTOR_4].prev_direction) {
-                st_pre.mot[MOTOR_4].prev_direction = st_pre.mot[MOTOR_4].direction;
-                st_run.mot[MOTOR_4].substep_accumulator = -(st_run.dda_ticks_X_substeps + st_run.mot[MOTOR_4].substep_accumulator);
-                motor_4.setDirection(st_pre.mot[MOTOR_4].direction);
-            }
-            motor_4.enable();
-            SET_ENCODER_STEP_SIGN(MOTOR_4, st_pre.mot[MOTOR_4].step_sign);
-        } else {
-            motor_4.motionStopped();
-        }
-        ACCUMULATE_ENCODER(MOTOR_4);
-#endif
-#if (MOTORS >= 5)
-        if ((st_run.mot[MOTOR_5].substep_increment = st_pre.mot[MOTOR_5].substep_increment) != 0) {
-            if (st_pre.mot[MOTOR_5].accumulator_correction_flag == true) {
-                st_pre.mot[MOTOR_5].accumulator_correction_flag = false;
-                st_run.mot[MOTOR_5].substep_accumulator *= st_pre.mot[MOTOR_5].accumulator_correction;
-            }
-            if (st_pre.mot[MOTOR_5].direction != st_pre.mot[MOTOR_5].prev_direction) {
-                st_pre.mot[MOTOR_5].prev_direction = st_pre.mot[MOTOR_5].direction;
-                st_run.mot[MOTOR_5].substep_accumulator = -(st_run.dda_ticks_X_substeps + st_run.mot[MOTOR_5].substep_accumulator);
-                motor_5.setDirection(st_pre.mot[MOTOR_5].direction);
-            }
-            motor_5.enable();
-            SET_ENCODER_STEP_SIGN(MOTOR_5, st_pre.mot[MOTOR_5].step_sign);
-        } else {
-            motor_5.motionStopped();
-        }
-        ACCUMULATE_ENCODER(MOTOR_5);
-#endif
-#if (MOTORS >= 6)
-        if ((st_run.mot[MOTOR_6].substep_increment = st_pre.mot[MOTOR_6].substep_increment) != 0) {
-            if (st_pre.mot[MOTOR_6].accumulator_correction_flag == true) {
-                st_pre.mot[MOTOR_6].accumulator_correction_flag = false;
-                st_run.mot[MOTOR_6].substep_accumulator *= st_pre.mot[MOTOR_6].accumulator_correction;
-            }
-            if (st_pre.mot[MOTOR_6].direction != st_pre.mot[MOTOR_6].prev_direction) {
-                st_pre.mot[MOTOR_6].prev_direction = st_pre.mot[MOTOR_6].direction;
-                st_run.mot[MOTOR_6].substep_accumulator = -(st_run.dda_ticks_X_substeps + st_run.mot[MOTOR_6].substep_accumulator);
-                motor_6.setDirection(st_pre.mot[MOTOR_6].direction);
-            }
-            motor_6.enable();
-            SET_ENCODER_STEP_SIGN(MOTOR_6, st_pre.mot[MOTOR_6].step_sign);
-        } else {
-            motor_6.motionStopped();
-        }
-        ACCUMULATE_ENCODER(MOTOR_6);
-#endif
 
         //**** do this last ****
 
+#if (STEP_ENGINE_WAVEFORM == 0)
+        // Segments with no steps (zero-velocity tails, non-stepped axes) don't need the DDA.
+        // Run them as a single timer period instead of dda_ticks interrupts. The frequency
+        // rounds down so the period is never short.
+        if (seg->idle) {
+            dda_timer.setModeAndFrequency(kTimerUpToMatch, FREQUENCY_DDA / seg->dda_ticks);
+            st_run.dda_idle = true;
+        } else if (st_run.dda_idle) {
+            dda_timer.setModeAndFrequency(kTimerUpToMatch, FREQUENCY_DDA);
+            st_run.dda_idle = false;
+        }
+#else
+        // Interrupt once when the tables have played out. The frequency rounds down so the
+        // interrupt is never early - a late one only plays part of the tables' trailing 0.
+        dda_timer.setModeAndFrequency(kTimerUpToMatch, FREQUENCY_DDA / seg->dda_ticks);
+#endif
+        mln_clock();                                    // motion link leader - start the followers' segment
         dda_timer.start();                              // start the DDA timer if not already running
 
     // handle dwells and commands
-    } else if (st_pre.block_type == BLOCK_TYPE_DWELL) {
-        st_run.dwell_ticks_downcount = st_pre.dwell_ticks;
+    } else if (seg->block_type == BLOCK_TYPE_DWELL) {
+        st_run.dwell_ticks_downcount = seg->dwell_ticks;
 
         // We now use SysTick events to handle dwells
         SysTickTimer.registerEvent(&dwell_systick_event);
 
         // handle synchronous commands
-    } else if (st_pre.block_type == BLOCK_TYPE_COMMAND) {
-        mp_runtime_command(st_pre.bf);
+    } else if (seg->block_type == BLOCK_TYPE_COMMAND) {
+        mp_runtime_command(seg->bf);
         
     } // else null - which is okay in many cases
 
     // all other cases drop to here (e.g. Null moves after Mcodes skip to here)
-    st_pre.block_type = BLOCK_TYPE_NULL;
-    st_pre.buffer_state = PREP_BUFFER_OWNED_BY_EXEC;    // we are done with the prep buffer - flip the flag back
+    seg->block_type = BLOCK_TYPE_NULL;
+    std::atomic_signal_fence(std::memory_order_release);    // done with the slot before the index
+    st_pre.read++;                                      // we are done with the slot - hand it back to exec
+    PROF_END(PROF_LOAD, prof_cycles);
     st_request_exec_move();                             // exec and prep next move
+    st_request_load_move();                             // a command or null left the runtime idle - load the next
 }
 
 /***********************************************************************************
@@ -659,11 +939,12 @@ static void _load_move()
  *          dda_ticks_X_substeps = (int32_t)((microseconds/1000000) * f_dda * dda_substeps);
  */
 
-stat_t st_prep_line(float travel_steps[], float following_error[], float segment_time)
+HOT_PATH stat_t st_prep_line(float travel_steps[], float following_error[], float segment_time)
 {
+    PROF_START(prof_cycles);
     stepper_debug("😶");
     // trap assertion failures and other conditions that would prevent queuing the line
-    if (st_pre.buffer_state != PREP_BUFFER_OWNED_BY_EXEC) {     // never supposed to happen
+    if ((uint8_t)(st_pre.write - st_pre.read) >= PREP_BUFFERS) {  // no free slot. never supposed to happen
         return (cm_panic(STAT_INTERNAL_ERROR, "st_prep_line() prep sync error"));
     } else if (isinf(segment_time)) {                           // never supposed to happen
         return (cm_panic(STAT_PREP_LINE_MOVE_TIME_IS_INFINITE, "st_prep_line()"));
@@ -672,22 +953,50 @@ stat_t st_prep_line(float travel_steps[], float following_error[], float segment
 //    } else if (segment_time < EPSILON) {
 //        return (STAT_MINIMUM_TIME_MOVE);
     }
+    stPrepSegment_t *seg = _prep_write_segment();
+
     // setup segment parameters
     // - dda_ticks is the integer number of DDA clock ticks needed to play out the segment
     // - ticks_X_substeps is the maximum depth of the DDA accumulator (as a negative number)
 
     //st_pre.dda_period = _f_to_period(FREQUENCY_DDA);                // FYI: this is a constant
-    st_pre.dda_ticks = (int32_t)(segment_time * 60 * FREQUENCY_DDA);// NB: converts minutes to seconds
-    st_pre.dda_ticks_X_substeps = st_pre.dda_ticks * DDA_SUBSTEPS;
+    seg->dda_ticks = (int32_t)(segment_time * 60 * FREQUENCY_DDA);  // NB: converts minutes to seconds
+    seg->dda_ticks_X_substeps = seg->dda_ticks * DDA_SUBSTEPS;
+#if (STEP_ENGINE_WAVEFORM == 1)
+    if (seg->dda_ticks >= WAVEFORM_TICKS_MAX) {                    // never supposed to happen
+        return (cm_panic(STAT_INTERNAL_ERROR, "st_prep_line() segment exceeds waveform table"));
+    }
+#endif
 
     // setup motor parameters
 
     float correction_steps;
+    float segment_rate = 1 / (segment_time * 60);           // segments per second
     for (uint8_t motor=0; motor<MOTORS; motor++) {          // remind us that this is motors, not axes
 
+        // A motor stopped by its homing switch sits out the rest of the move. See st_stop_motor()
+        if (st_pre.mot[motor].stopped) {
+            travel_steps[motor] = 0;
+        }
+
+        // Feedforward - lead the motor by the lag predicted for this segment. See Step feedforward
+        // in stepper.h. Done ahead of the zero test, as a stopping motor still has a lead to take back.
+        if (fp_NOT_ZERO(st_cfg.mot[motor].ff_velocity) || fp_NOT_ZERO(st_cfg.mot[motor].ff_accel)) {
+            stPrepMotor_t *pm = &st_pre.mot[motor];
+            float velocity = travel_steps[motor] * segment_rate;                    // steps/s
+            float accel = (velocity - pm->ff_velocity) * segment_rate;              // steps/s^2
+            float lead = (velocity * st_cfg.mot[motor].ff_velocity / 1000) +
+                         (accel * st_cfg.mot[motor].ff_accel / 1000000);
+            travel_steps[motor] += lead - pm->ff_lead;
+            pm->ff_velocity = velocity;
+            pm->ff_lead = lead;
+            if (fabs(lead) > pm->ff_lead_max) { pm->ff_lead_max = fabs(lead); }
+        }
+
         // Skip this motor if there are no new steps. Leave all other values intact.
+        seg->mot[motor].accumulator_correction_flag = false;
         if (fp_ZERO(travel_steps[motor])) {
-            st_pre.mot[motor].substep_increment = 0;        // substep increment also acts as a motor flag
+            seg->mot[motor].substep_increment = 0;          // substep increment also acts as a motor flag
             continue;
         }
 
@@ -695,11 +1004,11 @@ stat_t st_prep_line(float travel_steps[], float following_error[], float segment
         // Set the step_sign which is used by the stepper ISR to accumulate step position
 
         if (travel_steps[motor] >= 0) {                    // positive direction
-            st_pre.mot[motor].direction = DIRECTION_CW ^ st_cfg.mot[motor].polarity;
-            st_pre.mot[motor].step_sign = 1;
+            seg->mot[motor].direction = DIRECTION_CW ^ st_cfg.mot[motor].polarity;
+            seg->mot[motor].step_sign = 1;
         } else {
-            st_pre.mot[motor].direction = DIRECTION_CCW ^ st_cfg.mot[motor].polarity;
-            st_pre.mot[motor].step_sign = -1;
+            seg->mot[motor].direction = DIRECTION_CCW ^ st_cfg.mot[motor].polarity;
+            seg->mot[motor].step_sign = -1;
         }
 
         // Detect segment time changes and setup the accumulator correction factor and flag.
@@ -708,12 +1017,31 @@ stat_t st_prep_line(float travel_steps[], float following_error[], float segment
 
         if (fabs(segment_time - st_pre.mot[motor].prev_segment_time) > 0.0000001) { // highly tuned FP != compare
             if (fp_NOT_ZERO(st_pre.mot[motor].prev_segment_time)) {                    // special case to skip first move
-                st_pre.mot[motor].accumulator_correction_flag = true;
-                st_pre.mot[motor].accumulator_correction = segment_time / st_pre.mot[motor].prev_segment_time;
+                seg->mot[motor].accumulator_correction_flag = true;
+                seg->mot[motor].accumulator_correction = segment_time / st_pre.mot[motor].prev_segment_time;
             }
             st_pre.mot[motor].prev_segment_time = segment_time;
         }
 
+        // Backlash - take up the backlash after a reversal. See Backlash compensation in stepper.h
+        if (fp_NOT_ZERO(st_cfg.mot[motor].backlash)) {
+            stPrepMotor_t *pm = &st_pre.mot[motor];
+            int8_t sign = seg->mot[motor].step_sign;
+            float half = st_cfg.mot[motor].backlash * st_cfg.mot[motor].steps_per_unit / 2;
+            if (!pm->backlash_known) {                      // side not known - take it as taken up
+                pm->backlash_offset = sign * half;
+            }
+            pm->backlash_known = true;
+            float backlash_steps = (sign * half) - pm->backlash_offset;
+            if (fp_NOT_ZERO(backlash_steps)) {
+                backlash_steps = min(max(backlash_steps, -BACKLASH_STEPS_MAX), BACKLASH_STEPS_MAX);
+                pm->backlash_offset += backlash_steps;
+                pm->backlash_counted += backlash_steps;
+                pm->correction_holdoff = STEP_CORRECTION_HOLDOFF;
+                travel_steps[motor] += backlash_steps;
+            }
+        }
+
         // 'Nudge' correction strategy. Inject a single, scaled correction value then hold off
         // NOTE: This clause can be commented out to test for numerical accuracy and accumulating errors
         if ((--st_pre.mot[motor].correction_holdoff < 0) &&
@@ -736,22 +1064,81 @@ stat_t st_prep_line(float travel_steps[], float following_error[], float segment
         // Rounding is performed to eliminate a negative bias in the uint32 conversion
         // that results in long-term negative drift. (fabs/round order doesn't matter)
 
-        st_pre.mot[motor].substep_increment = round(fabs(travel_steps[motor] * DDA_SUBSTEPS));
+        seg->mot[motor].substep_increment = round(fabs(travel_steps[motor] * DDA_SUBSTEPS));
     }
-    st_pre.block_type = BLOCK_TYPE_ALINE;
-    st_pre.buffer_state = PREP_BUFFER_OWNED_BY_LOADER;    // signal that prep buffer is ready
+    _prep_position<MOTOR_1>(seg, travel_steps, STEPPER_MOTOR_LIST);
+    seg->idle = (seg->dda_ticks > 1);                  // idle unless some motor steps (see _load_move())
+    for (uint8_t motor=0; motor<MOTORS; motor++) {
+        if (seg->mot[motor].substep_increment != 0) {
+            seg->idle = false;
+            break;
+        }
+    }
+#if (STEP_ENGINE_WAVEFORM == 1)
+    _prep_waveform<MOTOR_1>(seg, st_pre.write & PREP_BUFFER_MASK, STEPPER_MOTOR_LIST);
+#endif
+    seg->laser_duty = -1;                               // see st_prep_laser_duty()
+    seg->output_set = 0;                                // see st_prep_outputs()
+    seg->output_clear = 0;
+    seg->block_type = BLOCK_TYPE_ALINE;                 // exec hands the slot to the loader on return
     stepper_debug("👍🏻");
+    PROF_END(PROF_PREP, prof_cycles);
     return (STAT_OK);
 }
 
+/*
+ * st_prep_line_split() - Prepare a segment as two halves, each run at its own rate
+ *
+ *  Used with KINEMATICS_MIDPOINT, where exec has solved the kinematics at the segment
+ *  midpoint as well as the end. Each half gets half the segment time. The first half is
+ *  handed to the loader here, the second is handed over by exec on return like any other
+ *  slot. Following error correction is applied to the first half only.
+ */
+#if (KINEMATICS_MIDPOINT == 1)
+stat_t st_prep_line_split(float travel_steps_1[], float travel_steps_2[], float following_error[], float segment_time)
+{
+    static float no_error[MOTORS];                      // zeros - second half is not corrected
+
+    ritorno(st_prep_line(travel_steps_1, following_error, segment_time/2));
+    std::atomic_signal_fence(std::memory_order_release);
+    st_pre.write++;                                     // hand the first half to the loader
+    st_request_load_move();
+    return (st_prep_line(travel_steps_2, no_error, segment_time/2));
+}
+#endif
+
 /*
  * st_prep_null() - Keeps the loader happy. Otherwise performs no action
+ *
+ *  May be called by the forward planner even when the ring is full, so it does not touch
+ *  the write slot. Slots are always returned to the ring as NULL.
  */
 
 void st_prep_null()
 {
-    st_pre.block_type = BLOCK_TYPE_NULL;
-    st_pre.buffer_state = PREP_BUFFER_OWNED_BY_EXEC;    // signal that prep buffer is empty
+    // nothing to do - the write slot is already NULL
+}
+
+/*
+ * st_stop_motor()     - stop a motor for the rest of the move. May be called from an interrupt
+ * st_motor_stopped()  - true if a motor is stopped
+ * st_release_motors() - let all motors run again
+ *
+ *  Used by parallel homing to stop each motor on its own switch while the others carry on.
+ *  A stopped motor gets no steps in newly prepped segments, so it stops dead within the
+ *  segments already queued, and its encoder stops with it. The runtime still thinks it is
+ *  moving: re-base its position once the move is done, before releasing it.
+ */
+
+void st_stop_motor(uint8_t motor) { st_pre.mot[motor].stopped = true; }
+
+bool st_motor_stopped(uint8_t motor) { return (st_pre.mot[motor].stopped); }
+
+void st_release_motors()
+{
+    for (uint8_t motor=0; motor<MOTORS; motor++) {
+        st_pre.mot[motor].stopped = false;
+    }
 }
 
 /*
@@ -760,9 +1147,9 @@ void st_prep_null()
 
 void st_prep_command(void *bf)
 {
-    st_pre.block_type = BLOCK_TYPE_COMMAND;
-    st_pre.bf = (mpBuf_t *)bf;
-    st_pre.buffer_state = PREP_BUFFER_OWNED_BY_LOADER;    // signal that prep buffer is ready
+    stPrepSegment_t *seg = _prep_write_segment();
+    seg->block_type = BLOCK_TYPE_COMMAND;
+    seg->bf = (mpBuf_t *)bf;                            // exec hands the slot to the loader on return
 }
 
 /*
@@ -771,10 +1158,55 @@ void st_prep_command(void *bf)
 
 void st_prep_dwell(float microseconds)
 {
-    st_pre.block_type = BLOCK_TYPE_DWELL;
+    stPrepSegment_t *seg = _prep_write_segment();
+    seg->block_type = BLOCK_TYPE_DWELL;
     // we need dwell_ticks to be at least 1
-    st_pre.dwell_ticks = std::max((uint32_t)((microseconds/1000000) * FREQUENCY_DWELL), 1UL);
-    st_pre.buffer_state = PREP_BUFFER_OWNED_BY_LOADER;    // signal that prep buffer is ready
+    seg->dwell_ticks = std::max((uint32_t)((microseconds/1000000) * FREQUENCY_DWELL), 1UL);
+}
+
+/*
+ * st_prep_lead() - prep a dwell ahead of a line segment if the loader would start it at once
+ *
+ *  Returns true if it did - nothing was running or prepped. Used by the motion link leader
+ *  to give the followers time to take the segment (see motion_link.h). Call from exec before
+ *  prepping the segment. The dwell is handed to the loader here.
+ */
+
+bool st_prep_lead(float microseconds)
+{
+    if (st_runtime_isbusy() || !_prep_is_empty()) {
+        return (false);
+    }
+    st_prep_dwell(microseconds);
+    std::atomic_signal_fence(std::memory_order_release);
+    st_pre.write++;                                     // hand the dwell to the loader
+    st_request_load_move();
+    return (true);
+}
+
+/*
+ * st_prep_laser_duty() - set the spindle PWM for the line segment just prepped
+ *
+ *  Call after st_prep_line() and before exec returns the slot. The loader sets the PWM as
+ *  it loads the segment, so the change lines up with the steps rather than with exec.
+ */
+
+void st_prep_laser_duty(float duty)
+{
+    _prep_write_segment()->laser_duty = duty;
+}
+
+/*
+ * st_prep_outputs() - change digital outputs as the line segment just prepped loads
+ *
+ *  Same rules as st_prep_laser_duty(). Bits are output numbers from 1 at bit 0.
+ */
+
+void st_prep_outputs(uint16_t set, uint16_t clear)
+{
+    stPrepSegment_t *seg = _prep_write_segment();
+    seg->output_set = set;
+    seg->output_clear = clear;
 }
 
 /*
@@ -784,8 +1216,12 @@ void st_prep_dwell(float microseconds)
  */
 void st_request_out_of_band_dwell(float microseconds)
 {
+    if (_prep_is_full()) {
+        return;                                         // not supposed to happen - exec isn't running
+    }
     st_prep_dwell(microseconds);
-    st_pre.buffer_state = PREP_BUFFER_OWNED_BY_LOADER;    // signal that prep buffer is ready
+    std::atomic_signal_fence(std::memory_order_release);
+    st_pre.write++;                                     // hand the slot to the loader
     st_request_load_move();
 }
 
@@ -822,6 +1258,24 @@ static int8_t _get_motor(const index_t index)
     return (ptr - motors);
 }
 
+/*
+ * st_apply_config() - push st_cfg to the motors after it was restored as a block
+ *
+ *  Does what st_set_mi(), st_set_pl(), st_set_sg() and st_set_cs() do to the hardware,
+ *  for every motor
+ */
+
+void st_apply_config()
+{
+    for (uint8_t motor=0; motor<MOTORS; motor++) {
+        _set_hw_microsteps(motor, st_cfg.mot[motor].microsteps);
+        st_run.mot[motor].power_level_dynamic = st_cfg.mot[motor].power_level_scaled;
+        Motors[motor]->setPowerLevel(st_cfg.mot[motor].power_level_scaled);
+        Motors[motor]->setStallGuard((st_cfg.mot[motor].stall_input != 0), (int8_t)st_cfg.mot[motor].stall_threshold);
+        Motors[motor]->setCoolStep(st_cfg.mot[motor].cool_step);
+    }
+}
+
 /*
  * _set_motor_steps_per_unit() - what it says
  * This function will need to be rethought if microstep morphing is implemented
@@ -832,6 +1286,7 @@ static void _set_motor_steps_per_unit(nvObj_t *nv)
     uint8_t m = _get_motor(nv->index);
     st_cfg.mot[m].units_per_step = (st_cfg.mot[m].travel_rev * st_cfg.mot[m].step_angle) / (360 * st_cfg.mot[m].microsteps);
     st_cfg.mot[m].steps_per_unit = 1/st_cfg.mot[m].units_per_step;
+    kn_config_changed();
 }
 
 /* PER-MOTOR FUNCTIONS
@@ -854,7 +1309,14 @@ stat_t st_set_ma(nvObj_t *nv)            // map motor to axis
         nv->valuetype = TYPE_NULL;
         return (STAT_INPUT_EXCEEDS_MAX_VALUE);
     }
+#if MACHINE_CONFIG_LOCKED == true
+    if ((uint8_t)nv->value != kn_locked_motor_map[_get_motor(nv->index)]) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_PARAMETER_IS_READ_ONLY);   // the map is compiled in - see kinematics.h
+    }
+#endif
     set_ui8(nv);
+    kn_config_changed();
     return(STAT_OK);
 }
 
@@ -884,6 +1346,16 @@ stat_t st_set_tr(nvObj_t *nv)            // motor travel per revolution
     return(STAT_OK);
 }
 
+stat_t st_set_bl(nvObj_t *nv)            // motor backlash
+{
+    if (nv->value < 0) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    set_flu(nv);
+    return(STAT_OK);
+}
+
 stat_t st_set_mi(nvObj_t *nv)            // motor microsteps
 {
     if (nv->value <= 0) {
@@ -933,6 +1405,7 @@ stat_t st_set_su(nvObj_t *nv)			// motor steps per unit (direct)
     // Scale TR so all the other values make sense
     // You could scale any one of the other values, but TR makes the most sense
     st_cfg.mot[m].travel_rev = (360.0*st_cfg.mot[m].microsteps)/(st_cfg.mot[m].steps_per_unit*st_cfg.mot[m].step_angle);
+    kn_config_changed();
     return(STAT_OK);
 }
 
@@ -998,6 +1471,51 @@ stat_t st_set_pl(nvObj_t *nv)    // motor power level
     return(STAT_OK);
 }
 
+/*
+ * st_set_si() - set the input the motor's stall detection drives, 0 for none
+ * st_set_sg() - set the stall detection threshold
+ * st_set_cs() - set load-adaptive current (CoolStep) on or off
+ *
+ *  Only drivers that sense load do anything with these - see Stepper::isStalled().
+ *  To home on a stall, point an unused input at it with {1si:} and use that input as
+ *  the axis (or motor) homing input; the input's mode, lockout and action apply as usual.
+ */
+stat_t st_set_si(nvObj_t *nv)
+{
+    if (nv->value > D_IN_CHANNELS) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_EXCEEDS_MAX_VALUE);
+    }
+    ritorno(set_ui8(nv));
+    uint8_t motor = _get_motor(nv->index);
+    Motors[motor]->setStallGuard((st_cfg.mot[motor].stall_input != 0), (int8_t)st_cfg.mot[motor].stall_threshold);
+    return (STAT_OK);
+}
+
+stat_t st_set_sg(nvObj_t *nv)
+{
+    if (nv->value < -64) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    if (nv->value > 63) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_EXCEEDS_MAX_VALUE);
+    }
+    set_flt(nv);
+    uint8_t motor = _get_motor(nv->index);
+    Motors[motor]->setStallGuard((st_cfg.mot[motor].stall_input != 0), (int8_t)st_cfg.mot[motor].stall_threshold);
+    return (STAT_OK);
+}
+
+stat_t st_set_cs(nvObj_t *nv)
+{
+    ritorno(set_01(nv));
+    uint8_t motor = _get_motor(nv->index);
+    Motors[motor]->setCoolStep(st_cfg.mot[motor].cool_step);
+    return (STAT_OK);
+}
+
 /*
  * st_get_pwr()	- get current motor power
  *
@@ -1099,6 +1617,13 @@ static const char fmt_0su[] = "[%s%s] m%s steps per unit %17.5f steps per%s\n";
 static const char fmt_0po[] = "[%s%s] m%s polarity%18d [0=normal,1=reverse]\n";
 static const char fmt_0pm[] = "[%s%s] m%s power management%10d [0=disabled,1=always on,2=in cycle,3=when moving]\n";
 static const char fmt_0pl[] = "[%s%s] m%s motor power level%13.3f [0.000=minimum, 1.000=maximum]\n";
+static const char fmt_0fv[] = "[%s%s] m%s feedforward lag time%10.3f ms\n";
+static const char fmt_0fa[] = "[%s%s] m%s feedforward accel gain%8.3f ms^2\n";
+static const char fmt_0bl[] = "[%s%s] m%s backlash%23.4f%s\n";
+static const char fmt_0hi[] = "[%s%s] m%s homing input%16d [input 1-N or 0 to use the axis homing input]\n";
+static const char fmt_0si[] = "[%s%s] m%s stall input%17d [input 1-N driven by a driver stall, 0=none]\n";
+static const char fmt_0sg[] = "[%s%s] m%s stall threshold%13.0f [-64=most sensitive, 63=least]\n";
+static const char fmt_0cs[] = "[%s%s] m%s load adaptive current%7d [0=off,1=on]\n";
 static const char fmt_pwr[] = "[%s%s] Motor %c power level:%12.3f\n";
 
 void st_print_me(nvObj_t *nv) { text_print(nv, fmt_me);}    // TYPE_NULL - message only
@@ -1107,25 +1632,25 @@ void st_print_mt(nvObj_t *nv) { text_print(nv, fmt_mt);}    // TYPE_FLOAT
 
 static void _print_motor_int(nvObj_t *nv, const char *format)
 {
-    sprintf(cs.out_buf, format, nv->group, nv->token, nv->group, (int)nv->value);
+    str_format(cs.out_buf, format, nv->group, nv->token, nv->group, (int)nv->value);
     xio_writeline(cs.out_buf);
 }
 
 static void _print_motor_flt(nvObj_t *nv, const char *format)
 {
-    sprintf(cs.out_buf, format, nv->group, nv->token, nv->group, nv->value);
+    str_format(cs.out_buf, format, nv->group, nv->token, nv->group, nv->value);
     xio_writeline(cs.out_buf);
 }
 
 static void _print_motor_flt_units(nvObj_t *nv, const char *format, uint8_t units)
 {
-    sprintf(cs.out_buf, format, nv->group, nv->token, nv->group, nv->value, GET_TEXT_ITEM(msg_units, units));
+    str_format(cs.out_buf, format, nv->group, nv->token, nv->group, nv->value, GET_TEXT_ITEM(msg_units, units));
     xio_writeline(cs.out_buf);
 }
 
 static void _print_motor_pwr(nvObj_t *nv, const char *format)
 {
-    sprintf(cs.out_buf, format, nv->group, nv->token, nv->token[0], nv->value);
+    str_format(cs.out_buf, format, nv->group, nv->token, nv->token[0], nv->value);
     xio_writeline(cs.out_buf);
 }
 
@@ -1137,6 +1662,13 @@ void st_print_su(nvObj_t *nv) { _print_motor_flt_units(nv, fmt_0su, cm_get_units
 void st_print_po(nvObj_t *nv) { _print_motor_int(nv, fmt_0po);}
 void st_print_pm(nvObj_t *nv) { _print_motor_int(nv, fmt_0pm);}
 void st_print_pl(nvObj_t *nv) { _print_motor_flt(nv, fmt_0pl);}
+void st_print_fv(nvObj_t *nv) { _print_motor_flt(nv, fmt_0fv);}
+void st_print_fa(nvObj_t *nv) { _print_motor_flt(nv, fmt_0fa);}
+void st_print_bl(nvObj_t *nv) { _print_motor_flt_units(nv, fmt_0bl, cm_get_units_mode(MODEL));}
+void st_print_hi(nvObj_t *nv) { _print_motor_int(nv, fmt_0hi);}
+void st_print_si(nvObj_t *nv) { _print_motor_int(nv, fmt_0si);}
+void st_print_sg(nvObj_t *nv) { _print_motor_flt(nv, fmt_0sg);}
+void st_print_cs(nvObj_t *nv) { _print_motor_int(nv, fmt_0cs);}
 void st_print_pwr(nvObj_t *nv){ _print_motor_pwr(nv, fmt_pwr);}
 
 #endif // __TEXT_MODE
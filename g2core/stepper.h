@@ -96,8 +96,9 @@
  *  when P1 is done segment 1 is loaded into the stepper runtime [L1]
  *
  *  Once the segment is loaded it will pulse out steps for the duration of the segment.
- *  Segment timing can vary, but segments are typically between 750 - 1500 microseconds,
- *  making for an average update rate of about 1 KHz.
+ *  Segment timing can vary, but segments are typically between 750 - 1500 microseconds
+ *  during acceleration and deceleration, and up to 3000 microseconds during cruise,
+ *  making for an average update rate of about 1 KHz or less.
  *
  *  Now the move is pulsing out segment 1 (at HI interrupt level). Once the L1 loader is
  *  finished it invokes the exec function for the next segment (at LO interrupt level).
@@ -160,10 +161,12 @@
  *    the "segment", usually ~1ms worth of pulses
  *
  *  - When the current segment is finished the stepper interrupt LOADs the next segment
- *    from the prep buffer, reloads the timers, and starts the next segment. At the end
+ *    from the prep ring, reloads the timers, and starts the next segment. At the end
  *    of the load the stepper interrupt routine requests an "exec" of the next move in
  *    order to prepare for the next load operation. It does this by calling the exec
- *    using a software interrupt (actually a timer, since that's all we've got).
+ *    using a software interrupt - a spare NVIC vector pended directly (ServiceCall<>
+ *    in hardware.h), so it fires as soon as the load returns rather than a timer period
+ *    later. The forward planner is requested the same way, at a lower priority.
  *
  *    - As a result of the above, the EXEC handler fires at the LO interrupt level. It
  *    computes the next accel/decel or cruise (body) segment for the current move
@@ -177,7 +180,18 @@
  *
  *  - Once the segment has been computed the exec handler finishes up by running the
  *    PREP routine in stepper.cpp. This computes the DDA values and gets the segment
- *    into the prep buffer - and ready for the next LOAD operation.
+ *    into the prep ring - and ready for the next LOAD operation. Exec keeps requesting
+ *    itself until the ring is full (PREP_BUFFERS segments), so a late exec is absorbed by
+ *    the segments already prepped instead of starving the DDA. The loader counts the
+ *    times it finds the ring empty during a cycle in st_pre.underruns ({_pur:n}).
+ *
+ *    An underrun means an exec took longer than the segments ahead of it - heavy
+ *    kinematics, mostly. The loader also counts it by what the exec was running:
+ *    {_purl:} alines, {_purs:} spindle synchronized blocks, {_purn:} no block (jogs and
+ *    conveyor tracking) - the rest only in the total. With {sgx:} above 1 the exec then
+ *    lengthens the segments of the sections that follow, up to {sgx:} times, and eases
+ *    them back as the underruns stop ({_sgs:} is the factor). Fewer, longer segments give
+ *    the exec more time for each, so the machine runs coarser instead of stuttering.
  *
  *  - The main loop runs in background to receive gcode blocks, parse them, and send
  *    them to the planner in order to keep the planner queue full so that when the
@@ -254,6 +268,7 @@
 #ifndef STEPPER_H_ONCE
 #define STEPPER_H_ONCE
 
+#include <type_traits>
 #include "planner.h"    // planner.h must precede stepper.h for moveType typedef
 
 /*********************************
@@ -261,11 +276,6 @@
  *********************************/
 //See hardware.h for platform specific stepper definitions
 
-typedef enum {
-    PREP_BUFFER_OWNED_BY_LOADER = 0,    // staging buffer is ready for load
-    PREP_BUFFER_OWNED_BY_EXEC           // staging buffer is being loaded
-} prepBufferState;
-
 typedef enum {                          // used w/start and stop flags to sequence motor power
     MOTOR_OFF = 0,                      // motor is stopped and deenergized
     MOTOR_IDLE,                         // motor is stopped and may be partially energized for torque maintenance
@@ -307,14 +317,14 @@ typedef enum {
  *
  *    MAX_LONG == 2^31, maximum signed long (depth of accumulator. NB: accumulator values are negative)
  *    FREQUENCY_DDA == DDA clock rate in Hz.
- *    NOM_SEGMENT_TIME == upper bound of segment time in minutes
+ *    MAX_SEGMENT_TIME == upper bound of segment time in minutes (cruise segments run this long)
  *    0.90 == a safety factor used to reduce the result from theoretical maximum
  *
  *  The number is about 8.5 million for the Xmega running a 50 KHz DDA with 5 millisecond segments
  *  The ARM is roughly the same as the DDA clock rate is 4x higher but the segment time is ~1/5
  *  Decreasing the nominal segment time increases the number precision.
  */
-#define DDA_SUBSTEPS ((MAX_LONG * 0.90) / (FREQUENCY_DDA * (NOM_SEGMENT_TIME * 60)))
+#define DDA_SUBSTEPS ((MAX_LONG * 0.90) / (FREQUENCY_DDA * (MAX_SEGMENT_TIME * 60)))
 
 /* Step correction settings
  *
@@ -330,6 +340,81 @@ typedef enum {
 #define STEP_CORRECTION_MAX         (float)0.60     // max step correction allowed in a single segment
 #define STEP_CORRECTION_HOLDOFF            5        // minimum number of segments to wait between error correction
 
+/* Backlash compensation
+ *
+ *  A motor with backlash {1bl:} loses that much travel each time it reverses. When the
+ *  direction of a motor's travel changes st_prep_line() adds the backlash to it, in the new
+ *  direction, a few steps a segment until it is taken up. There are no extra moves and the
+ *  planner knows nothing of it. A reversal before it is all taken up only gives back what
+ *  was. The side the backlash is on isn't known until the motor first moves, so the first
+ *  move after a reset takes nothing up - finish homing in the direction the work is cut in.
+ *
+ *  The encoders count the extra steps, so _exec_aline_segment() leaves them out of the
+ *  following error, and no correction is made while they are added or for a holdoff after.
+ */
+#define BACKLASH_STEPS_MAX          (float)2.00     // max backlash steps taken up in a single segment
+
+/* Step feedforward
+ *
+ *  The correction above can only react to an error it has already measured, two segments
+ *  late. With real encoders most of the error is lag that can be predicted instead: a motor
+ *  trails its command by about its velocity times a lag time {1fv:}, plus its acceleration
+ *  times a second gain {1fa:}, in ms and ms^2. st_prep_line() works out the velocity and
+ *  acceleration of each motor from its travel in the segment, and leads the motor by the
+ *  predicted lag. Only the change in the lead is added to each segment, so the lead runs
+ *  back down as the motor slows. What is left from the last segment of a move is taken
+ *  back by the first segment of the next one.
+ *
+ *  Both gains default to 0, which turns feedforward off. It isn't useful with the virtual
+ *  encoders, as they count the lead as following error and the correction would take it
+ *  back out. The lead in steps is in the _ff diagnostic group and its peak in _fp.
+ */
+
+/* Step pulse batching
+ *
+ *  Drivers whose step pin is a plain GPIO publish the pin's port letter and bit mask as
+ *  step_port and step_mask. With batching on, the DDA ISR ORs the masks of the motors that
+ *  step in a tick into one word per port and sets them all with a single port write. Step
+ *  pulses are cleared the same way. This shortens the ISR and removes the skew between
+ *  pulses on different axes of the same port. Drivers that leave step_port at 0 (e.g. the
+ *  hobby servo) still get stepStart() / stepEnd() calls.
+ */
+#ifndef STEP_PULSE_BATCHING
+#define STEP_PULSE_BATCHING 1               // 0 = call stepStart() / stepEnd() for every motor
+#endif
+#define STEP_PORTS          6               // ports 'A' to 'F'
+
+/* Waveform step engine (SAMS70 only)
+ *
+ *  With STEP_ENGINE_WAVEFORM the DDA does not run in an interrupt. st_prep_line() instead
+ *  runs the same DDA arithmetic ahead of time, once per tick of the segment, and writes a
+ *  duty value per tick into each motor's waveform table: a pulse if the motor steps in that
+ *  tick, otherwise 0. The loader starts each motor's step PWM playing its table by DMA at
+ *  FREQUENCY_DDA, and the DDA timer is set to interrupt once at the end of the segment. The
+ *  CPU does the DDA work at exec priority, once per segment, rather than in two interrupts
+ *  per tick. All motors must be waveform capable drivers (see step_dir_waveform.h) whose
+ *  step pins are on synchronized PWM channels.
+ *
+ *  Each motor holds one table per prep slot, sized for the longest segment plus a trailing
+ *  0 so a late segment-end interrupt never repeats the last pulse.
+ */
+#ifndef STEP_ENGINE_WAVEFORM
+#define STEP_ENGINE_WAVEFORM 0              // 1 = play precomputed step waveforms by DMA
+#endif
+#define WAVEFORM_TICKS_MAX ((uint32_t)(FREQUENCY_DDA * MAX_SEGMENT_TIME * 60) + 2)
+
+// Waveform step timing, held by the PWM hardware rather than by when an interrupt runs:
+// STEP_PULSE_WIDTH_NS is the step pulse width (0 = half a DDA tick), and no pulse starts
+// within STEP_DIR_SETUP_NS of a direction change. Steps due inside the setup window stay
+// in the DDA accumulator and go out in the ticks right after it.
+#ifndef STEP_PULSE_WIDTH_NS
+#define STEP_PULSE_WIDTH_NS 0
+#endif
+#ifndef STEP_DIR_SETUP_NS
+#define STEP_DIR_SETUP_NS 0
+#endif
+#define STEP_DIR_SETUP_TICKS ((uint32_t)(((uint64_t)STEP_DIR_SETUP_NS * FREQUENCY_DDA + 999999999) / 1000000000))
+
 /*
  * Stepper control structures
  *
@@ -339,7 +424,7 @@ typedef enum {
  *    mpBuffer planning buffers (bf)    planner.c       main loop
  *    mrRuntimeSingleton (mr)           planner.c      MED ISR
  *    stConfig (st_cfg)                 stepper.c      write=bkgd, read=ISRs
- *    stPrepSingleton (st_pre)          stepper.c      MED ISR
+ *    stPrepSingleton (st_pre)          stepper.c      MED ISR (write), HI ISR (read)
  *    stRunSingleton (st_run)           tepper.c       HI ISR
  *
  *  Care has been taken to isolate actions on these structures to the execution level
@@ -359,6 +444,13 @@ typedef struct cfgMotor {                   // per-motor configs
     float travel_rev;                       // mm or deg of travel per motor revolution
     float steps_per_unit;                   // microsteps per mm (or degree) of travel
     float units_per_step;                   // mm or degrees of travel per microstep
+    float ff_velocity;                      // feedforward lag time in ms - see Step feedforward
+    float ff_accel;                         // feedforward acceleration gain in ms^2
+    float backlash;                         // mm or deg of backlash to take up on reversal - see Backlash compensation
+    uint8_t homing_input;                   // input that homes this motor, or 0 to use the axis's {1hi:}
+    uint8_t stall_input;                    // input driven by the driver's stall detection, or 0 for none
+    float stall_threshold;                  // stall detection sensitivity, -64 (most) to 63 (least)
+    uint8_t cool_step;                      // 1 = let the driver trim the current to the load
 
     // private
     float power_level_scaled;               // scaled to internal range - must be between 0 and 1
@@ -369,11 +461,17 @@ typedef struct stConfig {                   // stepper configs
     cfgMotor_t mot[MOTORS];                 // settings for motors 1-N
 } stConfig_t;
 
-// Motor runtime structure. Used exclusively by step generation ISR (HI)
+// Motor runtime structures. Used exclusively by step generation ISR (HI)
+// The DDA touches only the accumulator/increment pairs on every tick, so they are packed
+// together in their own array, ahead of the fields used once per segment or less.
 
-typedef struct stRunMotor {                 // one per controlled motor
-    uint32_t substep_increment;             // total steps in axis times substeps factor
+typedef struct stRunDDA {                   // one per controlled motor - touched every DDA tick
     int32_t substep_accumulator;            // DDA phase angle accumulator
+    uint32_t substep_increment;             // total steps in axis times substeps factor
+} stRunDDA_t;
+
+typedef struct stRunMotor {                 // one per controlled motor - power management and step counting
+    int32_t accumulator_start;              // DDA accumulator as the segment was loaded - see _count_steps_run()
     bool motor_flag;                        // true if motor is participating in this move
     uint32_t power_systick;                 // sys_tick for next motor power state transition
     float power_level_dynamic;              // power level for this segment of idle
@@ -382,47 +480,98 @@ typedef struct stRunMotor {                 // one per controlled motor
 typedef struct stRunSingleton {             // Stepper static values and axis parameters
     magic_t magic_start;                    // magic number to test memory integrity
     uint32_t dda_ticks_downcount;           // dda tick down-counter (unscaled)
-    uint32_t dwell_ticks_downcount;         // dwell tick down-counter (unscaled)
     uint32_t dda_ticks_X_substeps;          // ticks multiplied by scaling factor
+    uint32_t dda_ticks;                     // ticks in the segment, less any already counted
+    bool dda_idle;                          // true if the DDA timer is running an idle segment as one period
+    stRunDDA_t dda[MOTORS];                 // DDA accumulators and increments
+    uint32_t dwell_ticks_downcount;         // dwell tick down-counter (unscaled)
     stRunMotor_t mot[MOTORS];               // runtime motor structures
     magic_t magic_end;
 } stRunSingleton_t;
 
-// Motor prep structure. Used by exec/prep ISR (MED) and read-only during load
-// Must be careful about volatiles in this one
+// Prepared segments. A single-producer / single-consumer ring of PREP_BUFFERS segments.
+// Exec/prep (MED) fills the slot at the write index and then advances it. The loader (HI)
+// loads the slot at the read index and then advances it. Each index is written by one side
+// only, so no locking is needed. The indexes run freely and are masked for use.
 
-typedef struct stPrepMotor {
+typedef struct stPrepSegmentMotor {         // per-motor values for one prepared segment
     uint32_t substep_increment;             // total steps in axis times substep factor
-    bool motor_flag;                        // true if motor is participating in this move
-
-    // direction and direction change
     uint8_t direction;                      // travel direction corrected for polarity (CW==0. CCW==1)
-    uint8_t prev_direction;                 // travel direction from previous segment run for this motor
     int8_t step_sign;                       // set to +1 or -1 for encoders
+    uint8_t accumulator_correction_flag;    // signals accumulator needs correction
+    float accumulator_correction;           // factor for adjusting accumulator between segments
+#if (STEP_ENGINE_WAVEFORM == 1)
+    uint16_t wave_steps;                    // steps written to the waveform table for this segment
+#endif
+    int16_t position_steps;                 // signed whole steps of the segment for position drivers
+} stPrepSegmentMotor_t;
+
+typedef struct stPrepSegment {              // one prepared segment, dwell or command
+    blockType block_type;                   // move type (requires planner.h)
+    struct mpBuffer *bf;                    // static pointer to relevant buffer
+    uint32_t dda_ticks;                     // DDA ticks for the move
+    uint32_t dwell_ticks;                   // dwell ticks remaining
+    uint32_t dda_ticks_X_substeps;          // DDA ticks scaled by substep factor
+    bool idle;                              // true if no motor steps in this segment
+    float laser_duty;                       // spindle PWM to set as the segment loads, or -1 to leave it
+    uint16_t output_set;                    // outputs to turn on as the segment loads (bit 0 = output 1)
+    uint16_t output_clear;                  // outputs to turn off as the segment loads
+    stPrepSegmentMotor_t mot[MOTORS];       // per-motor segment values
+} stPrepSegment_t;
+
+// Motor prep structure. State carried from segment to segment
+
+typedef struct stPrepMotor {
+    bool motor_flag;                        // true if motor is participating in this move
+    uint8_t prev_direction;                 // travel direction of the last segment loaded for this motor (loader only)
 
     // following error correction
     int32_t correction_holdoff;             // count down segments between corrections
     float corrected_steps;                  // accumulated correction steps for the cycle (for diagnostic display only)
 
+    // feedforward
+    float ff_velocity;                      // motor velocity in the last segment, steps per second
+    float ff_lead;                          // steps the motor is being led by
+    float ff_lead_max;                      // largest lead since reset (for diagnostic display only)
+
+    // backlash compensation
+    bool backlash_known;                    // false until the motor has moved and the side of the backlash is known
+    float backlash_offset;                  // steps of backlash taken up, from -half to +half the backlash
+    float backlash_counted;                 // steps taken up since the encoders were last set
+
+    volatile bool stopped;                  // held still by st_stop_motor() while the others move
+    float position_carry;                   // fractional steps not yet given to a position driver
+
     // accumulator phase correction
     float prev_segment_time;                // segment time from previous segment run for this motor
-    float accumulator_correction;           // factor for adjusting accumulator between segments
-    uint8_t accumulator_correction_flag;    // signals accumulator needs correction
+#if (STEP_ENGINE_WAVEFORM == 1)
+    uint8_t wave_direction;                 // direction of the last segment written to the waveform
+    int32_t wave_accumulator;               // DDA accumulator, run ahead by st_prep_line()
+#endif
 } stPrepMotor_t;
 
 typedef struct stPrepSingleton {
     magic_t magic_start;                    // magic number to test memory integrity
-    volatile prepBufferState buffer_state;  // prep buffer state - owned by exec or loader
-    struct mpBuffer *bf;                    // static pointer to relevant buffer
-    blockType block_type;                   // move type (requires planner.h)
-
-    uint32_t dda_ticks;                     // DDA ticks for the move
-    uint32_t dwell_ticks;                   // dwell ticks remaining
-    uint32_t dda_ticks_X_substeps;          // DDA ticks scaled by substep factor
+    volatile uint8_t write;                 // count of segments prepped - advanced by exec only
+    volatile uint8_t read;                  // count of segments loaded - advanced by the loader only
+    uint32_t underruns;                     // times the loader found nothing to load while in a running cycle
+    uint32_t type_underruns[BLOCK_TYPE_SYNC+1]; // ...by the type of block the exec was running, NULL for none
+    stPrepSegment_t seg[PREP_BUFFERS];      // prepared segment ring
     stPrepMotor_t mot[MOTORS];              // prep time motor structs
     magic_t magic_end;
 } stPrepSingleton_t;
 
+#define PREP_BUFFER_MASK (PREP_BUFFERS-1)
+static_assert((PREP_BUFFERS & PREP_BUFFER_MASK) == 0, "PREP_BUFFERS must be a power of 2");
+static_assert(PREP_BUFFERS < 128, "PREP_BUFFERS must fit the uint8_t ring indexes");
+
+#if (KINEMATICS_MIDPOINT == 1)
+#define PREP_SLOTS_PER_SEGMENT 2            // each segment is prepped as two halves (see st_prep_line_split())
+#else
+#define PREP_SLOTS_PER_SEGMENT 1
+#endif
+static_assert(PREP_BUFFERS >= 2*PREP_SLOTS_PER_SEGMENT, "PREP_BUFFERS must hold at least two segments");
+
 extern stConfig_t st_cfg;                   // config struct is exposed. The rest are private
 extern stPrepSingleton_t st_pre;            // only used by config_app diagnostics
 
@@ -430,6 +579,11 @@ extern stPrepSingleton_t st_pre;            // only used by config_app diagnosti
 /**** Stepper (base object) ****/
 
 struct Stepper {
+    static constexpr uint8_t step_port = 0; // step pin port letter for batched pulses, 0 if not batched
+    static constexpr uint32_t step_mask = 0;// step pin bit mask within step_port
+    static constexpr bool step_waveform = false;    // true if the driver plays STEP_ENGINE_WAVEFORM tables
+    static constexpr bool step_position = false;    // true if the driver takes a position per segment, not steps
+
     Timeout _motor_disable_timeout;         // this is the timeout object that will let us know when time is u
     uint32_t _motor_disable_timeout_ms;     // the number of ms that the timeout is reset to
     stPowerState _power_state;              // state machine for managing motor power
@@ -482,12 +636,21 @@ struct Stepper {
     
     // turn on motor in all cases unless it's disabled
     // NOTE: in the future the default assigned timeout will be the motor's default value
-    void enable(float timeout = st_cfg.motor_power_timeout)
+    void enable(float timeout = st_cfg.motor_power_timeout) { enableAs<Stepper>(timeout); };
+
+    // enable() bound at compile time to the driver type M, for the loader. The qualified
+    // call skips the virtual dispatch so the driver's enable pin write can inline.
+    template<typename M>
+    void enableAs(float timeout = st_cfg.motor_power_timeout)
     {
         if (_power_mode == MOTOR_DISABLED) {
             return;
         }
-        this->_enableImpl();
+        if (std::is_same<M, Stepper>::value) {
+            this->_enableImpl();
+        } else {
+            static_cast<M*>(this)->M::_enableImpl();
+        }
         _power_state = MOTOR_RUNNING;
 
         if ((uint8_t)timeout == 0) {
@@ -508,9 +671,12 @@ struct Stepper {
     };
     
     // turn off motor is only powered when moving
-    void motionStopped() {
+    void motionStopped() { motionStoppedAs<Stepper>(); };
+
+    template<typename M>                    // motionStopped() bound to the driver type M - see enableAs()
+    void motionStoppedAs() {
         if (_power_mode == MOTOR_POWERED_IN_CYCLE) {
-            this->enable();
+            this->enableAs<M>();
             _power_state = MOTOR_POWER_TIMEOUT_START;
         } else if (_power_mode == MOTOR_POWERED_ONLY_WHEN_MOVING) {
             if (_power_state == MOTOR_RUNNING) {
@@ -544,6 +710,20 @@ struct Stepper {
         }
     };
 
+    // called every controller pass, even when periodicCheck() is skipped for time
+    virtual void periodicPoll() { /* can be overridden */ };
+
+    // Drivers that sense load (e.g. TMC2130 StallGuard) can report a stall, which
+    // st_motor_power_callback() passes to the motor's {1si:} input, and trim the
+    // current to the load (CoolStep)
+    virtual bool isStalled() { return false; };
+    virtual void setStallGuard(const bool enable, const int8_t threshold) { /* can be overridden */ };
+    virtual void setCoolStep(const bool enable) { /* can be overridden */ };
+
+    // Position drivers (step_position, e.g. hobby servos) get the motor's step position once
+    // per segment, as the segment loads, and take no DDA ticks - see _load_position()
+    virtual void setPosition(const int32_t steps) { /* can be overridden */ };
+
     /* Functions that must be implemented in subclasses */
 
     virtual bool canStep() { return true; };
@@ -562,6 +742,7 @@ struct Stepper {
 void stepper_init(void);
 void stepper_reset(void);
 void stepper_init_assertions(void);
+void st_apply_config(void);
 stat_t stepper_test_assertions(void);
 
 bool st_runtime_isbusy(void);
@@ -571,17 +752,29 @@ stat_t st_motor_power_callback(void);
 
 void st_request_forward_plan(void);
 void st_request_exec_move(void);
+int32_t st_get_steps_run(uint8_t motor);
 void st_request_load_move(void);
+uint8_t st_prep_lines_queued(void);
 void st_prep_null(void);
+void st_stop_motor(uint8_t motor);
+bool st_motor_stopped(uint8_t motor);
+void st_release_motors(void);
 void st_prep_command(void *bf);        // use a void pointer since we don't know about mpBuf_t yet)
 void st_prep_dwell(float microseconds);
+bool st_prep_lead(float microseconds);
+void st_prep_laser_duty(float duty);
+void st_prep_outputs(uint16_t set, uint16_t clear);
 void st_request_out_of_band_dwell(float microseconds);
 //stat_t st_prep_line(float travel_steps[], float following_error[], float segment_time);
 stat_t st_prep_line(float travel_steps[], float following_error[], float segment_time);
+#if (KINEMATICS_MIDPOINT == 1)
+stat_t st_prep_line_split(float travel_steps_1[], float travel_steps_2[], float following_error[], float segment_time);
+#endif
 
 stat_t st_set_ma(nvObj_t *nv);
 stat_t st_set_sa(nvObj_t *nv);
 stat_t st_set_tr(nvObj_t *nv);
+stat_t st_set_bl(nvObj_t *nv);
 stat_t st_set_mi(nvObj_t *nv);
 stat_t st_get_su(nvObj_t *nv);
 stat_t st_set_su(nvObj_t *nv);
@@ -589,6 +782,9 @@ stat_t st_set_pm(nvObj_t *nv);
 stat_t st_get_pm(nvObj_t *nv);
 stat_t st_set_pl(nvObj_t *nv);
 stat_t st_get_pwr(nvObj_t *nv);
+stat_t st_set_si(nvObj_t *nv);
+stat_t st_set_sg(nvObj_t *nv);
+stat_t st_set_cs(nvObj_t *nv);
 
 stat_t st_set_mt(nvObj_t *nv);
 stat_t st_set_md(nvObj_t *nv);
@@ -604,6 +800,13 @@ stat_t st_set_me(nvObj_t *nv);
     void st_print_po(nvObj_t *nv);
     void st_print_pm(nvObj_t *nv);
     void st_print_pl(nvObj_t *nv);
+    void st_print_fv(nvObj_t *nv);
+    void st_print_fa(nvObj_t *nv);
+    void st_print_bl(nvObj_t *nv);
+    void st_print_hi(nvObj_t *nv);
+    void st_print_si(nvObj_t *nv);
+    void st_print_sg(nvObj_t *nv);
+    void st_print_cs(nvObj_t *nv);
     void st_print_pwr(nvObj_t *nv);
     void st_print_mt(nvObj_t *nv);
     void st_print_me(nvObj_t *nv);
@@ -619,6 +822,13 @@ stat_t st_set_me(nvObj_t *nv);
     #define st_print_po tx_print_stub
     #define st_print_pm tx_print_stub
     #define st_print_pl tx_print_stub
+    #define st_print_fv tx_print_stub
+    #define st_print_fa tx_print_stub
+    #define st_print_bl tx_print_stub
+    #define st_print_hi tx_print_stub
+    #define st_print_si tx_print_stub
+    #define st_print_sg tx_print_stub
+    #define st_print_cs tx_print_stub
     #define st_print_pwr tx_print_stub
     #define st_print_mt tx_print_stub
     #define st_print_me tx_print_stub
@@ -0,0 +1,180 @@
+/*
+ * telemetry.cpp - segment synchronous runtime samples sent as binary frames
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "g2core.h"
+#include "config.h"
+#include "hardware.h"
+#include "binary_parser.h"
+#include "planner.h"
+#include "telemetry.h"
+#include "text_parser.h"
+#include "timebase.h"
+#include "util.h"
+#include "xio.h"
+
+#include <atomic>           // atomic_signal_fence() orders the ring between the exec and the controller
+
+/**** Allocate Structures ****/
+
+tlmSingleton_t tlm;
+
+#define TELEMETRY_RING_MASK (TELEMETRY_RING_SIZE-1)
+
+static_assert(BINARY_HEADER_LEN + sizeof(tlmSample_t) <= BINARY_SEND_MAX, "telemetry sample is too big for a frame");
+
+/************************************************************************************
+ **** CODE **************************************************************************
+ ************************************************************************************/
+
+/*
+ * telemetry_init() - initialize telemetry. Sampling is off until {tlme:1}
+ */
+
+void telemetry_init()
+{
+    memset(&tlm, 0, sizeof(tlm));
+    tlm.decimation = 1;
+}
+
+/*
+ * tlm_sample() - copy a sample of the runtime into the ring - called at exec interrupt level
+ *
+ *  Call once the segment has been prepped, so the position is the one the segment ends at.
+ */
+
+void tlm_sample()
+{
+    if (!tlm.enable) {
+        return;
+    }
+    if (++tlm.skipped < tlm.decimation) {
+        return;
+    }
+    tlm.skipped = 0;
+
+    uint8_t head = tlm.head;
+    if ((uint8_t)(head - tlm.tail) >= TELEMETRY_RING_SIZE) {
+        tlm.dropped++;                                  // the host isn't keeping up
+        tlm.samples++;                                  // leave a gap in the sample numbers
+        return;
+    }
+    tlmSample_t *s = &tlm.ring[head & TELEMETRY_RING_MASK];
+    s->sample = tlm.samples++;
+    s->time = (uint32_t)tb_get_usec();
+    copy_vector(s->position, mr.position);
+    s->velocity = mr.segment_velocity;
+    for (uint8_t m=0; m<MOTORS; m++) {
+        s->following_error[m] = mr.following_error[m];
+    }
+    std::atomic_signal_fence(std::memory_order_release);   // sample contents before the index
+    tlm.head = head + 1;
+}
+
+/*
+ * tlm_callback() - send the samples waiting in the ring as binary frames
+ */
+
+stat_t tlm_callback()
+{
+    if (tlm.tail == tlm.head) {
+        return (STAT_NOOP);
+    }
+    uint8_t data[BINARY_HEADER_LEN + sizeof(tlmSample_t)];
+
+    for (uint8_t i=0; (i < TELEMETRY_SENDS_PER_CALLBACK) && (tlm.tail != tlm.head); i++) {
+        if (xio_tx_is_backed_up()) {
+            break;                                      // samples wait in the ring. Drops count if they must
+        }
+        std::atomic_signal_fence(std::memory_order_acquire);    // index before the sample contents
+        tlmSample_t *s = &tlm.ring[tlm.tail & TELEMETRY_RING_MASK];
+
+        data[0] = (uint8_t)s->sample;
+        data[1] = BINARY_RECORD_TELEMETRY;
+        data[2] = AXES;
+        data[3] = MOTORS;
+        memcpy(data + BINARY_HEADER_LEN, s, sizeof(tlmSample_t));  // little-endian, no padding
+        std::atomic_signal_fence(std::memory_order_release);    // done with the sample before the index
+        tlm.tail++;
+
+        binary_write_frame(data, sizeof(data));
+    }
+    return (STAT_OK);
+}
+
+/***********************************************************************************
+ * CONFIGURATION AND INTERFACE FUNCTIONS
+ * Functions to get and set variables from the cfgArray table
+ ***********************************************************************************/
+
+/*
+ * tlm_set_tlme() - enable telemetry. Any set clears the counters and the ring
+ * tlm_set_tlmd() - set the decimation - 1 samples every segment
+ */
+
+stat_t tlm_set_tlme(nvObj_t *nv)
+{
+    ritorno(set_01(nv));
+    tlm.enable = 0;                                     // stop sampling while clearing
+    tlm.samples = 0;
+    tlm.dropped = 0;
+    tlm.skipped = 0;
+    tlm.tail = tlm.head;
+    tlm.enable = (uint8_t)nv->value;
+    return (STAT_OK);
+}
+
+stat_t tlm_set_tlmd(nvObj_t *nv)
+{
+    if (nv->value < 1) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    if (nv->value > 255) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_EXCEEDS_MAX_VALUE);
+    }
+    return (set_ui8(nv));
+}
+
+/***********************************************************************************
+ * TEXT MODE SUPPORT
+ * Functions to print variables from the cfgArray table
+ ***********************************************************************************/
+
+#ifdef __TEXT_MODE
+
+static const char fmt_tlme[] = "[tlme] telemetry enable%12d [0=off,1=on]\n";
+static const char fmt_tlmd[] = "[tlmd] telemetry decimation%8d segments\n";
+static const char fmt_tlmn[] = "[tlmn] telemetry samples%11lu\n";
+static const char fmt_tlmo[] = "[tlmo] telemetry samples dropped%3lu\n";
+
+void tlm_print_tlme(nvObj_t *nv) { text_print(nv, fmt_tlme);}
+void tlm_print_tlmd(nvObj_t *nv) { text_print(nv, fmt_tlmd);}
+void tlm_print_tlmn(nvObj_t *nv) { text_print(nv, fmt_tlmn);}
+void tlm_print_tlmo(nvObj_t *nv) { text_print(nv, fmt_tlmo);}
+
+#endif // __TEXT_MODE
@@ -0,0 +1,110 @@
+/*
+ * telemetry.h - segment synchronous runtime samples sent as binary frames
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* Telemetry sends a sample of the runtime to the host for each segment the exec runs: the
+ *  position, the segment velocity and the following error. At the default segment time
+ *  that is about 1 kHz while moving, which the status report can't get near.
+ *
+ *  tlm_sample() is called from _exec_aline_segment() at exec interrupt level. It copies the
+ *  sample into a single producer / single consumer ring and returns - nothing is formatted
+ *  or sent there. tlm_callback() runs from the controller, sends the samples waiting as
+ *  BINARY_RECORD_TELEMETRY frames while the TX path has room, and frees them. When the ring
+ *  is full a sample is dropped and counted, rather than slowing motion. The host can also
+ *  see a drop as a gap in the sample numbers.
+ *
+ *  Frames use the binary_parser.h framing, on the same channel as the ACK frames:
+ *
+ *      seq         uint8   low byte of the sample number
+ *      type        uint8   BINARY_RECORD_TELEMETRY
+ *      axes        uint8   AXES - axis positions in the record
+ *      motors      uint8   MOTORS - following errors in the record
+ *      sample      uint32  sample number since telemetry was enabled
+ *      time        uint32  timebase time of the sample, low 32 bits of us (timebase.h)
+ *      position    float   one per axis, in mm or degrees (mr.position[])
+ *      velocity    float   mm/min (mr.segment_velocity)
+ *      error       float   one per motor, in steps (mr.following_error[])
+ *      crc         uint16  CRC-16/CCITT of all bytes before it
+ *
+ *  {tlme:1} clears the counters and starts sampling, {tlme:0} stops it. {tlmd:n} sends
+ *  every Nth segment. {tlmn:} and {tlmo:} count the samples taken and dropped.
+ */
+#ifndef TELEMETRY_H_ONCE
+#define TELEMETRY_H_ONCE
+
+/**** Configs, Definitions and Structures ****/
+
+#ifndef TELEMETRY_RING_SIZE
+#define TELEMETRY_RING_SIZE     16      // samples waiting to be sent. Must be 2^N
+#endif
+#define TELEMETRY_SENDS_PER_CALLBACK 4  // frames sent per controller pass, at most
+
+typedef struct tlmSample {              // one sample, as copied from the runtime
+    uint32_t sample;
+    uint32_t time;
+    float position[AXES];
+    float velocity;
+    float following_error[MOTORS];
+} tlmSample_t;
+
+typedef struct tlmSingleton {
+    uint8_t enable;                     // 1 = take samples {tlme:}
+    uint8_t decimation;                 // sample every Nth segment {tlmd:}
+    uint8_t skipped;                    // segments since the last sample
+    uint32_t samples;                   // samples taken {tlmn:}
+    uint32_t dropped;                   // samples dropped with the ring full {tlmo:}
+    volatile uint8_t head;              // next sample to write - written by tlm_sample() only
+    volatile uint8_t tail;              // next sample to send - written by tlm_callback() only
+    tlmSample_t ring[TELEMETRY_RING_SIZE];
+} tlmSingleton_t;
+
+extern tlmSingleton_t tlm;
+
+/**** Function Prototypes ****/
+
+void telemetry_init(void);
+void tlm_sample(void);
+stat_t tlm_callback(void);
+
+stat_t tlm_set_tlme(nvObj_t *nv);
+stat_t tlm_set_tlmd(nvObj_t *nv);
+
+#ifdef __TEXT_MODE
+
+    void tlm_print_tlme(nvObj_t *nv);
+    void tlm_print_tlmd(nvObj_t *nv);
+    void tlm_print_tlmn(nvObj_t *nv);
+    void tlm_print_tlmo(nvObj_t *nv);
+
+#else
+
+    #define tlm_print_tlme tx_print_stub
+    #define tlm_print_tlmd tx_print_stub
+    #define tlm_print_tlmn tx_print_stub
+    #define tlm_print_tlmo tx_print_stub
+
+#endif // __TEXT_MODE
+
+#endif // End of include guard: TELEMETRY_H_ONCE
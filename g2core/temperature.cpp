@@ -39,6 +39,8 @@
 #include "util.h"
 #include "settings.h"
 
+#include <atomic>           // atomic_signal_fence() orders the ADC bank swap against the interrupt
+
 
 /**** Local safety/limit settings ****/
 
@@ -94,6 +96,35 @@
 #define TEMP_MIN_RISE_DEGREES_FROM_TARGET (float)10.0
 #endif
 
+// The PID runs once per TEMP_PID_PERIOD ms. The I and D factors are per-sample, so
+// changing this changes what the stored factors mean.
+#ifndef TEMP_PID_PERIOD
+#define TEMP_PID_PERIOD 100
+#endif
+
+// Feedforward holds the heater at (set point - TEMP_AMBIENT) * feedforward factor
+// before the PID adds anything, so the integral only has to cover the residual.
+#ifndef TEMP_AMBIENT
+#define TEMP_AMBIENT (float)25.0
+#endif
+
+// Relay autotune: measure TEMP_AUTOTUNE_CYCLES full oscillations around the target
+// (after two that cover the warm-up and the first bias correction), each half at least TEMP_AUTOTUNE_MIN_HALF_CYCLE
+// ms long. Abort if it overshoots by TEMP_AUTOTUNE_MAX_OVERSHOOT or takes longer than
+// TEMP_AUTOTUNE_TIMEOUT ms.
+#ifndef TEMP_AUTOTUNE_CYCLES
+#define TEMP_AUTOTUNE_CYCLES 5
+#endif
+#ifndef TEMP_AUTOTUNE_MIN_HALF_CYCLE
+#define TEMP_AUTOTUNE_MIN_HALF_CYCLE 5000 // five seconds
+#endif
+#ifndef TEMP_AUTOTUNE_MAX_OVERSHOOT
+#define TEMP_AUTOTUNE_MAX_OVERSHOOT (float)20.0
+#endif
+#ifndef TEMP_AUTOTUNE_TIMEOUT
+#define TEMP_AUTOTUNE_TIMEOUT (20 * 60 * 1000) // twenty minutes
+#endif
+
 
 /**** Allocate structures ****/
 
@@ -113,7 +144,21 @@ struct Thermistor {
     // We'll pull adc top value from the adc_pin.getTop()
 
     ADCPin<adc_pin_num> adc_pin;
-    uint16_t raw_adc_value = 0;
+    uint16_t raw_adc_value = 0;         // average of the samples in the last PID period - see take_sample()
+
+    // The ADC interrupt only adds to the active bank. take_sample() swaps banks, then
+    // averages the idle one, so neither side waits on the other.
+    struct {
+        uint32_t sum;
+        uint16_t count;
+    } adc_bank[2] = {{0, 0}, {0, 0}};
+    volatile uint8_t adc_active = 0;
+
+    // ADC value at table_size+1 evenly spaced temperatures from min_temp to max_temp, so a
+    // sample costs a search and an interpolation instead of a log() and pow(). The values
+    // fall as the temperature rises. Evenly spaced ADC values would crowd the hot end, where
+    // the curve is steepest, into a few entries.
+    float lookup_table[table_size+1];
 
     typedef Thermistor<adc_pin_num, min_temp, max_temp, table_size> type;
 
@@ -150,29 +195,31 @@ struct Thermistor {
         c2 = (x-c3*v)/z;
         c1 = 1/temp_low_fixed-c3*pow(a1,3)-c2*a1;
 
-        //        int16_t temp = min_temp;
-        //        for (int i=0; temp < max_temp && i < table_size; i++) {
-        //            lookup_table[i][0] = adc_value(temp);
-        //            lookup_table[i][0] = temp;
-        //
-        //            temp += (min_temp-max_temp)/(table_size-1);
-        //        }
+        for (uint32_t i = 0; i <= table_size; i++) {
+            lookup_table[i] = adc_value(min_temp + ((float)i * (max_temp - min_temp) / table_size));
+        }
     };
 
-//    uint16_t adc_value_(int16_t temp) {
-//        float y = (c1 - (1/(temp+273.15))) / (2*c3);
-//        float x = sqrt(pow(c2 / (3*c3),3) + pow(y,2));
-//        float r = exp((x-y) - (x+y)); // resistance of thermistor
-//        return (r / (pullup_resistance + r)) * (adc_pin.getTop());
-//    };
-
-    float temperature_exact() {
-        // Sanity check:
-        if (raw_adc_value < 1) {
-            return -1; // invalid temperature from a thermistor
+    // Inverse of temperature_at(). Bisects for ln(R) as the Steinhart-Hart equation has no
+    // usable closed form inverse for all coefficients (c3 may be negative). Only used in setup().
+    float adc_value(const float temp) {
+        float lnr_lo = 0;                                   // 1 ohm - hot
+        float lnr_hi = log(TEMP_MIN_DISCONNECTED_RESISTANCE); // cold
+        float Tinv = 1/(temp + 273.15);
+        for (uint8_t i = 0; i < 32; i++) {
+            float lnr = (lnr_lo + lnr_hi) / 2;
+            if ((c1 + (c2*lnr) + (c3*pow(lnr,3))) < Tinv) {  // hotter than temp
+                lnr_lo = lnr;
+            } else {
+                lnr_hi = lnr;
+            }
         }
+        float r = exp((lnr_lo + lnr_hi) / 2) + inline_resistance;
+        return ((r / (pullup_resistance + r)) * adc_pin.getTop());
+    };
 
-        float v = (float)raw_adc_value * kSystemVoltage / (adc_pin.getTop()); // convert the 10 bit ADC value to a voltage
+    float temperature_at(const float adc_value) {
+        float v = adc_value * kSystemVoltage / (adc_pin.getTop()); // convert the 10 bit ADC value to a voltage
         float r = ((pullup_resistance * v) / (kSystemVoltage - v)) - inline_resistance;   // resistance of thermistor
 
         if ((r < 0) || (r > TEMP_MIN_DISCONNECTED_RESISTANCE)) {
@@ -184,6 +231,35 @@ struct Thermistor {
         return (1/Tinv) - 273.15; // final temperature
     };
 
+    float temperature_exact() {
+        // Sanity check:
+        if (raw_adc_value < 1) {
+            return -1; // invalid temperature from a thermistor
+        }
+        return (temperature_at((float)raw_adc_value));
+    };
+
+    // Interpolated from the lookup table. Readings outside min_temp to max_temp (including
+    // the invalid ones) fall back to the exact value.
+    float temperature() {
+        float adc = (float)raw_adc_value;
+        if ((raw_adc_value < 1) || (adc > lookup_table[0]) || (adc < lookup_table[table_size])) {
+            return (temperature_exact());
+        }
+        uint32_t lo = 0;
+        uint32_t hi = table_size;
+        while ((hi - lo) > 1) {
+            uint32_t mid = (lo + hi) / 2;
+            if (lookup_table[mid] >= adc) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        float fraction = (lookup_table[lo] - adc) / (lookup_table[lo] - lookup_table[hi]);
+        return (min_temp + (lo + fraction) * (float)(max_temp - min_temp) / table_size);
+    };
+
     float get_resistance() {
         if (raw_adc_value < 1) {
             return -1; // invalid temperature from a thermistor
@@ -195,7 +271,21 @@ struct Thermistor {
 
     // Call back function from the ADC to tell it that the ADC has a new sample...
     void adc_has_new_value() {
-        raw_adc_value = (adc_pin.getRaw() + (9 * raw_adc_value))/10;
+        adc_bank[adc_active].sum += adc_pin.getRaw();    // no multiply or divide in the interrupt
+        adc_bank[adc_active].count++;
+    };
+
+    // Average the samples since the last call into raw_adc_value. Called once per PID period.
+    // Keeps the last value if there were none.
+    void take_sample() {
+        uint8_t idle = adc_active;
+        adc_active = idle ^ 1;
+        std::atomic_signal_fence(std::memory_order_seq_cst);   // the interrupt has moved to the other bank
+        if (adc_bank[idle].count > 0) {
+            raw_adc_value = (adc_bank[idle].sum + adc_bank[idle].count/2) / adc_bank[idle].count;
+        }
+        adc_bank[idle].sum = 0;
+        adc_bank[idle].count = 0;
     };
 };
 
@@ -249,6 +339,10 @@ float last_reported_temp1 = 0; // keep track of what we've reported for SR gener
 float last_reported_temp2 = 0;
 float last_reported_temp3 = 0;
 
+float sampled_temp1 = 0;       // temperatures the PID loop read on its last pass
+float sampled_temp2 = 0;
+float sampled_temp3 = 0;
+
 
 // Output 1 FET info
 // DO_1: Extruder1_PWM
@@ -339,8 +433,133 @@ struct PID {
 
     bool _enable;                   // set true to enable this heater
 
+    float _ff_factor = 0.0;         // feedforward output per degree above TEMP_AMBIENT
+    float _fan_factor = 0.0;        // feedforward output per unit of heater fan output
+    float _fan_output = 0.0;        // heater fan output, fed in by temperature_callback()
+
+    // Relay autotune state - see startAutotune()
+    bool _tuning = false;
+    bool _tune_heating;             // relay is at the high side
+    uint8_t _tune_cycles;           // relay cycles completed
+    uint8_t _tune_measured;         // cycles that went into the sums below
+    uint32_t _tune_ticks;           // PID samples since the autotune started
+    uint32_t _tune_heat_start;      // tick the current heating half started
+    uint32_t _tune_cool_start;      // tick the current cooling half started
+    uint32_t _tune_heat_ticks;      // length of the last heating half
+    float _tune_bias;               // relay output is _tune_bias +/- _tune_amplitude
+    float _tune_amplitude;
+    float _tune_max;                // temperature extremes of the current cycle
+    float _tune_min;
+    float _tune_ku_sum;             // ultimate gain and period (seconds) sums
+    float _tune_tu_sum;
+
     PID(float P, float I, float D, float min_rise_over_time, float startSetPoint = 0.0) : _p_factor{P/100.0f}, _i_factor{I/100.0f}, _d_factor{D/100.0f}, _set_point{startSetPoint}, _at_set_point{false}, _min_rise_over_time(min_rise_over_time) {};
 
+    void setSetPoint(float value) {
+        _set_point = min(TEMP_MAX_SETPOINT, value);
+        _tuning = false;            // a new set point overrides an autotune
+    }
+
+    // Start a relay-feedback (Astrom-Hagglund) autotune at target. The heater switches
+    // between _tune_bias +/- _tune_amplitude as the temperature crosses the target, the
+    // bias walks toward the duty that holds the target, and the resulting oscillation
+    // gives the ultimate gain and period for Ziegler-Nichols.
+    void startAutotune(float target) {
+        setSetPoint(target);
+        if (_set_point < TEMP_OFF_BELOW) {
+            return;
+        }
+        _tuning = true;
+        _tune_heating = true;
+        _tune_cycles = 0;
+        _tune_measured = 0;
+        _tune_ticks = 0;
+        _tune_heat_start = 0;
+        _tune_cool_start = 0;
+        _tune_heat_ticks = 0;
+        _tune_bias = output_max / 2.0;
+        _tune_amplitude = output_max / 2.0;
+        _tune_max = 0.0;
+        _tune_min = TEMP_MAX_SETPOINT;
+        _tune_ku_sum = 0.0;
+        _tune_tu_sum = 0.0;
+    }
+
+    float _abortAutotune(const char *msg) {
+        _tuning = false;
+        _set_point = 0.0;
+        rpt_exception(STAT_TEMPERATURE_CONTROL_ERROR, msg);
+        return 0;
+    }
+
+    // The stored I and D factors are per PID sample, not per second
+    void _finishAutotune() {
+        const float dt = TEMP_PID_PERIOD / 1000.0;
+        float ku = _tune_ku_sum / _tune_measured;
+        float tu = _tune_tu_sum / _tune_measured;
+        float kp = 0.6 * ku;                            // classic Ziegler-Nichols PID
+
+        _p_factor = kp;
+        _i_factor = (2.0 * kp / tu) * dt;
+        _d_factor = (kp * tu / 8.0) / dt;
+
+        // the settled bias is the duty that holds the target, less what the fan term supplies
+        if (_set_point > TEMP_AMBIENT) {
+            _ff_factor = std::max(0.0f, _tune_bias - (_fan_factor * _fan_output)) / (_set_point - TEMP_AMBIENT);
+        }
+        _integral = 0.0;
+        _derivative = 0.0;
+        _tuning = false;
+    }
+
+    float _autotune(float input) {
+        const uint32_t min_half_cycle = TEMP_AUTOTUNE_MIN_HALF_CYCLE / TEMP_PID_PERIOD;
+
+        if ((input > (_set_point + TEMP_AUTOTUNE_MAX_OVERSHOOT)) || (input > TEMP_MAX_SETPOINT)) {
+            return _abortAutotune("Heater autotune overshot the target");
+        }
+        if (++_tune_ticks > (TEMP_AUTOTUNE_TIMEOUT / TEMP_PID_PERIOD)) {
+            return _abortAutotune("Heater autotune timed out");
+        }
+        _tune_max = std::max(_tune_max, input);
+        _tune_min = std::min(_tune_min, input);
+
+        if (_tune_heating) {
+            if ((input > _set_point) && ((_tune_ticks - _tune_heat_start) > min_half_cycle)) {
+                _tune_heating = false;
+                _tune_cool_start = _tune_ticks;
+                _tune_heat_ticks = _tune_cool_start - _tune_heat_start;
+                _tune_max = input;
+            }
+        } else if ((input < _set_point) && ((_tune_ticks - _tune_cool_start) > min_half_cycle)) {
+            uint32_t cool_ticks = _tune_ticks - _tune_cool_start;
+            _tune_heating = true;
+            _tune_heat_start = _tune_ticks;
+
+            // The first cycle includes the warm-up and the second the first bias correction
+            if ((_tune_cycles > 1) && (_tune_max > _tune_min)) {
+                _tune_ku_sum += (4.0 * _tune_amplitude) / (M_PI * (_tune_max - _tune_min) / 2.0);
+                _tune_tu_sum += (_tune_heat_ticks + cool_ticks) * (TEMP_PID_PERIOD / 1000.0);
+                _tune_measured++;
+            }
+            // Move the bias toward whichever half ran long, so the halves even out
+            if (_tune_cycles > 0) {
+                _tune_bias += (_tune_amplitude * ((float)_tune_heat_ticks - (float)cool_ticks)) / (float)(_tune_heat_ticks + cool_ticks);
+                _tune_bias = std::min(0.8f * output_max, std::max(0.2f * output_max, _tune_bias));
+                _tune_amplitude = std::min(_tune_bias, output_max - _tune_bias);
+            }
+            _tune_cycles++;
+            _tune_min = input;
+
+            if (_tune_measured >= TEMP_AUTOTUNE_CYCLES) {
+                _finishAutotune();
+                sr_request_status_report(SR_REQUEST_IMMEDIATE);
+                return _tune_bias;
+            }
+        }
+        return _tune_heating ? (_tune_bias + _tune_amplitude) : (_tune_bias - _tune_amplitude);
+    }
+
     float getNewOutput(float input) {
         // If the input is < 0, the sensor failed
         if (input < 0) {
@@ -351,6 +570,10 @@ struct PID {
             return 0;
         }
 
+        if (_tuning) {
+            return _autotune(input);
+        }
+
         // Calculate the e (error)
         float e = _set_point - input;
 
@@ -392,10 +615,15 @@ struct PID {
         // For output's sake, we'll store this, otherwise we don't need it:
         _proportional = p;
 
+        // Feedforward: the duty that should hold the set point, from the heat loss and the fan
+        float f = (_ff_factor * std::max(0.0f, _set_point - TEMP_AMBIENT)) + (_fan_factor * _fan_output);
+
         _integral += e;
 
-        if (_integral < 0.0) {
-            _integral = 0.0;
+        // The integral may only pull back as far as the feedforward pushes
+        float integral_min = (_i_factor > 0.0) ? (-f / _i_factor) : 0.0;
+        if (_integral < integral_min) {
+            _integral = integral_min;
         }
 
         float i = _integral * _i_factor;
@@ -420,7 +648,7 @@ struct PID {
             return 1; //"on"
         }
 
-        return std::min(output_max, p + i - _derivative);
+        return std::min(output_max, p + i + f - _derivative);
     };
 
     bool atSetPoint() {
@@ -456,6 +684,7 @@ struct HeaterFan {
     float max_value = MAX_FAN_VALUE;
     float low_temp = MIN_FAN_TEMP;
     float high_temp = MIN_FAN_TEMP;
+    float value = 0.0;              // the output last written - the heater feedforward uses it
 
     HeaterFan() {
 #if TEMPERATURE_OUTPUT_ON == 1
@@ -465,14 +694,15 @@ struct HeaterFan {
     }
 
     void newTemp(float temp) {
-#if TEMPERATURE_OUTPUT_ON == 1
         if ((temp > low_temp) && (temp < high_temp)) {
-            heater_fan_pin = max_value * (((temp - low_temp)/(high_temp - low_temp))*(1.0 - min_value) + min_value);
+            value = max_value * (((temp - low_temp)/(high_temp - low_temp))*(1.0 - min_value) + min_value);
         } else if (temp > high_temp) {
-            heater_fan_pin = max_value;
+            value = max_value;
         } else {
-            heater_fan_pin = 0.0;
+            value = 0.0;
         }
+#if TEMPERATURE_OUTPUT_ON == 1
+        heater_fan_pin = value;
 #endif
     }
 };
@@ -514,20 +744,27 @@ void temperature_reset()
 {
     // make setpoint 0
     fet_pin1 = 0.0f;
-    pid1._set_point = 0.0;
+    pid1.setSetPoint(0.0);
 
     fet_pin2 = 0.0f;
-    pid2._set_point = 0.0;
+    pid2.setSetPoint(0.0);
 
     fet_pin3 = 0.0f;
-    pid3._set_point = 0.0;
+    pid3.setSetPoint(0.0);
 
-    pid_timeout.set(100);
+    pid_timeout.set(TEMP_PID_PERIOD);
 }
 
 // Minimum difference in temp before it'll trigger an SR
 const float kTempDiffSRTrigger = 0.25;
 
+static void _take_samples()
+{
+    thermistor1.take_sample();                      // oversample: average everything since the last take
+    thermistor2.take_sample();
+    thermistor3.take_sample();
+}
+
 stat_t temperature_callback()
 {
     if (cm.machine_state == MACHINE_ALARM) {
@@ -536,22 +773,26 @@ stat_t temperature_callback()
         fet_pin2 = 0.0;
         fet_pin3 = 0.0;
 
-        // Force all PIDs to off too
-        pid1._set_point = 0.0;
-        pid2._set_point = 0.0;
-        pid3._set_point = 0.0;
+        // Force all PIDs to off too, which also ends any autotune
+        pid1.setSetPoint(0.0);
+        pid2.setSetPoint(0.0);
+        pid3.setSetPoint(0.0);
 
+        _take_samples();                            // keep the readings live for reports
         return (STAT_OK);
     }
 
     if (pid_timeout.isPast()) {
-        pid_timeout.set(100);
+        pid_timeout.set(TEMP_PID_PERIOD);
+        _take_samples();
 
         float temp = 0.0;
         bool sr_requested = false;
 
         if (pid1._enable) {
-            temp = thermistor1.temperature_exact();
+            temp = thermistor1.temperature();
+            sampled_temp1 = temp;
+            pid1._fan_output = heater_fan1.value;
             fet_pin1 = pid1.getNewOutput(temp);
 
             if (fabs(temp - last_reported_temp1) > kTempDiffSRTrigger) {
@@ -563,7 +804,8 @@ stat_t temperature_callback()
         heater_fan1.newTemp(temp);
 
         if (pid2._enable) {
-            temp = thermistor2.temperature_exact();
+            temp = thermistor2.temperature();
+            sampled_temp2 = temp;
             fet_pin2 = pid2.getNewOutput(temp);
 
             if (fabs(temp - last_reported_temp2) > kTempDiffSRTrigger) {
@@ -573,7 +815,8 @@ stat_t temperature_callback()
         }
 
         if (pid3._enable) {
-            temp = thermistor3.temperature_exact();
+            temp = thermistor3.temperature();
+            sampled_temp3 = temp;
             fet_pin3 = pid3.getNewOutput(temp);
 
             if (fabs(temp - last_reported_temp3) > kTempDiffSRTrigger) {
@@ -764,9 +1007,9 @@ stat_t cm_get_set_temperature(nvObj_t *nv)
 void cm_set_set_temperature(const uint8_t heater, const float value)
 {
     switch(heater) {
-        case 1: { pid1._set_point = min(TEMP_MAX_SETPOINT, value); break; }
-        case 2: { pid2._set_point = min(TEMP_MAX_SETPOINT, value); break; }
-        case 3: { pid3._set_point = min(TEMP_MAX_SETPOINT, value); break; }
+        case 1: { pid1.setSetPoint(value); break; }
+        case 2: { pid2.setSetPoint(value); break; }
+        case 3: { pid3.setSetPoint(value); break; }
 
         // default to quiet the compiler
         default: { break; }
@@ -778,6 +1021,95 @@ stat_t cm_set_set_temperature(nvObj_t *nv)
     return (STAT_OK);
 }
 
+/*
+ * cm_get_heater_ff()/cm_set_heater_ff() - get/set the feedforward factors of the PID
+ *
+ *   ff is output per degree above TEMP_AMBIENT, fc is output per unit of heater fan output.
+ *   Like P, I and D the JSON values are 100x the stored ones.
+ */
+stat_t cm_get_heater_ff(nvObj_t *nv)
+{
+    switch(_get_heater_number(nv)) {
+        case '1': { nv->value = pid1._ff_factor * 100.0; break; }
+        case '2': { nv->value = pid2._ff_factor * 100.0; break; }
+        case '3': { nv->value = pid3._ff_factor * 100.0; break; }
+
+        default: { nv->value = 0.0; break; }
+    }
+    nv->precision = GET_TABLE_WORD(precision);
+    nv->valuetype = TYPE_FLOAT;
+
+    return (STAT_OK);
+}
+stat_t cm_set_heater_ff(nvObj_t *nv)
+{
+    switch(_get_heater_number(nv)) {
+        case '1': { pid1._ff_factor = nv->value / 100.0; break; }
+        case '2': { pid2._ff_factor = nv->value / 100.0; break; }
+        case '3': { pid3._ff_factor = nv->value / 100.0; break; }
+
+        default: { break; }
+    }
+    return (STAT_OK);
+}
+stat_t cm_get_heater_fc(nvObj_t *nv)
+{
+    switch(_get_heater_number(nv)) {
+        case '1': { nv->value = pid1._fan_factor * 100.0; break; }
+        case '2': { nv->value = pid2._fan_factor * 100.0; break; }
+        case '3': { nv->value = pid3._fan_factor * 100.0; break; }
+
+        default: { nv->value = 0.0; break; }
+    }
+    nv->precision = GET_TABLE_WORD(precision);
+    nv->valuetype = TYPE_FLOAT;
+
+    return (STAT_OK);
+}
+stat_t cm_set_heater_fc(nvObj_t *nv)
+{
+    switch(_get_heater_number(nv)) {
+        case '1': { pid1._fan_factor = nv->value / 100.0; break; }
+        case '2': { pid2._fan_factor = nv->value / 100.0; break; }
+        case '3': { pid3._fan_factor = nv->value / 100.0; break; }
+
+        default: { break; }
+    }
+    return (STAT_OK);
+}
+
+/*
+ * cm_get_heater_autotune()/cm_set_heater_autotune() - run a relay autotune of the PID
+ *
+ *   Setting the target temperature starts the autotune, setting 0 (or any new set
+ *   temperature) stops it. When it completes, P, I, D and ff are replaced with the
+ *   tuned values and the heater holds the target. Get is true while it's running.
+ */
+stat_t cm_get_heater_autotune(nvObj_t *nv)
+{
+    switch(_get_heater_number(nv)) {
+        case '1': { nv->value = pid1._tuning; break; }
+        case '2': { nv->value = pid2._tuning; break; }
+        case '3': { nv->value = pid3._tuning; break; }
+
+        default: { nv->value = 0; break; }
+    }
+    nv->valuetype = TYPE_BOOL;
+
+    return (STAT_OK);
+}
+stat_t cm_set_heater_autotune(nvObj_t *nv)
+{
+    switch(_get_heater_number(nv)) {
+        case '1': { pid1.startAutotune(nv->value); break; }
+        case '2': { pid2.startAutotune(nv->value); break; }
+        case '3': { pid3.startAutotune(nv->value); break; }
+
+        default: { break; }
+    }
+    return (STAT_OK);
+}
+
 /*
  * cm_get_fan_power()/cm_set_fan_power() - get/set the set high-value setting of the heater fan
  */
@@ -982,15 +1314,35 @@ stat_t cm_get_heater_adc(nvObj_t *nv)
  float cm_get_temperature(const uint8_t heater)
  {
      switch(heater) {
-         case 1: { return (last_reported_temp1 = thermistor1.temperature_exact()); }
-         case 2: { return (last_reported_temp2 = thermistor2.temperature_exact()); }
-         case 3: { return (last_reported_temp3 = thermistor3.temperature_exact()); }
+         case 1: { return (last_reported_temp1 = thermistor1.temperature()); }
+         case 2: { return (last_reported_temp2 = thermistor2.temperature()); }
+         case 3: { return (last_reported_temp3 = thermistor3.temperature()); }
 
          default: { break; }
      }
 
      return 0.0;
  }
+
+/*
+ * cm_get_temperature_sample() - get the temperature the PID loop last read
+ *
+ *  For reports polled many times a second (Marlin M105). It's at most 100ms old, and
+ *  saves the thermistor math. Heaters the PID loop isn't running are read as usual.
+ *  Unlike cm_get_temperature() it leaves the status report trigger alone.
+ */
+float cm_get_temperature_sample(const uint8_t heater)
+{
+    switch(heater) {
+        case 1: { return (pid1._enable ? sampled_temp1 : thermistor1.temperature()); }
+        case 2: { return (pid2._enable ? sampled_temp2 : thermistor2.temperature()); }
+        case 3: { return (pid3._enable ? sampled_temp3 : thermistor3.temperature()); }
+
+        default: { break; }
+    }
+    return 0.0;
+}
+
 stat_t cm_get_temperature(nvObj_t *nv)
 {
     nv->value = cm_get_temperature(_get_heater_number(nv) - '0');
@@ -56,6 +56,13 @@ stat_t cm_get_set_temperature(nvObj_t* nv);
 void cm_set_set_temperature(const uint8_t heater, const float value);
 stat_t cm_set_set_temperature(nvObj_t* nv);
 
+stat_t cm_get_heater_ff(nvObj_t* nv);
+stat_t cm_set_heater_ff(nvObj_t* nv);
+stat_t cm_get_heater_fc(nvObj_t* nv);
+stat_t cm_set_heater_fc(nvObj_t* nv);
+stat_t cm_get_heater_autotune(nvObj_t* nv);
+stat_t cm_set_heater_autotune(nvObj_t* nv);
+
 float cm_get_fan_power(const uint8_t heater);
 stat_t cm_get_fan_power(nvObj_t* nv);
 
@@ -78,6 +85,7 @@ stat_t cm_get_heater_output(nvObj_t* nv);
 stat_t cm_get_heater_adc(nvObj_t* nv);
 
 float cm_get_temperature(const uint8_t heater);
+float cm_get_temperature_sample(const uint8_t heater);
 stat_t cm_get_temperature(nvObj_t* nv);
 
 stat_t cm_get_thermistor_resistance(nvObj_t* nv);
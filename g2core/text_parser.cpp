@@ -48,6 +48,8 @@ void tx_print_stub(nvObj_t *nv) {}
 #else // __TEXT_MODE
 
 static stat_t _text_parser_kernal(char *str, nvObj_t *nv);
+static char *_text_next_command(char *str);
+static stat_t _text_parser_line(char *str, nvObj_t *nv);
 
 /******************************************************************************
  * text_parser()         - update a config setting from a text block (text mode)
@@ -59,6 +61,8 @@ static stat_t _text_parser_kernal(char *str, nvObj_t *nv);
  *  - $xfr            display a parameter
  *  - $x              display a group
  *  - ?               generate a status report (multiline format)
+ *  - $xvm=1000 $yvm=1000 $zvm=500
+ *                    set or display several parameters - see _text_parser_line()
  */
 stat_t text_parser(char *str)
 {
@@ -80,7 +84,11 @@ stat_t text_parser(char *str)
         strcat(str,"sys");
     }
 
-    // parse and execute the command (only processes 1 command per line)
+    if (_text_next_command(str) != NULL) {      // more than one command on the line
+        return (_text_parser_line(str, nv));
+    }
+
+    // parse and execute the command
     ritorno(_text_parser_kernal(str, nv));      // run the parser to decode the command
     if ((nv->valuetype == TYPE_NULL) || (nv->valuetype == TYPE_PARENT)) {
         if (nv_get(nv) == STAT_COMPLETE) {      // populate value, group values, or run uber-group displays
@@ -121,8 +129,11 @@ static stat_t _text_parser_kernal(char *str, nvObj_t *nv)
         *rd = NUL;                              // terminate at end of name
         strncpy(nv->token, str, TOKEN_LEN);
         str = ++rd;
-        nv->value = strtof(str, &rd);           // rd used as end pointer
-        if (rd != str) {
+        while ((*str == ' ') || (*str == '\t')) {
+            str++;                              // skip spaces between the separator and the value
+        }
+        rd = str;                               // rd used as end pointer
+        if (atofloat(&rd, &nv->value, true)) {
             nv->valuetype = TYPE_FLOAT;
         }
     }
@@ -143,6 +154,75 @@ static stat_t _text_parser_kernal(char *str, nvObj_t *nv)
     return (STAT_OK);
 }
 
+/*
+ * _text_next_command() - find the next $ command on a line
+ *
+ *  A command starts at a $ after a space or tab. Returns a pointer to it, or NULL if
+ *  there isn't one. Does not change the string.
+ */
+
+static char *_text_next_command(char *str)
+{
+    for (char *p = str+1; *p != NUL; p++) {
+        if ((*p == '$') && ((*(p-1) == ' ') || (*(p-1) == '\t'))) {
+            return (p);
+        }
+    }
+    return (NULL);
+}
+
+/*
+ * _text_parser_line() - set or display several single values from one line
+ *
+ *  $xvm=1000 $yvm=1000 $zvm=500 is run as three commands, each into its own nvObj, and
+ *  answered with one response - so a setup script doesn't wait for a prompt per value.
+ *  Groups can't be displayed this way. The line stops at the first command that fails,
+ *  the values set before it stay set, and the response carries them and the error.
+ */
+
+static stat_t _text_parser_line(char *str, nvObj_t *nv)
+{
+    stat_t status = STAT_OK;
+
+    for (uint8_t i=0; str != NULL; i++) {
+        char *next = _text_next_command(str);
+        if (next != NULL) {
+            *(next-1) = NUL;                    // terminate this command at the space
+        }
+        if (i == NV_MAX_OBJECTS) {
+            status = STAT_JSON_TOO_MANY_PAIRS;
+            break;
+        }
+        if ((status = _text_parser_kernal(str, nv)) != STAT_OK) {
+            break;
+        }
+        if (!nv_index_is_single(nv->index)) {
+            status = STAT_UNSUPPORTED_TYPE;     // a group would take the whole nv list
+            break;
+        }
+        if (nv->valuetype == TYPE_NULL) {
+            status = nv_get(nv);
+        } else if ((status = cm_is_alarmed()) == STAT_OK) {
+            if ((status = nv_set(nv)) == STAT_OK) {
+                nv_persist(nv);
+            }
+        }
+        if (status != STAT_OK) {
+            break;
+        }
+        nv = nv->nx;
+        str = next;
+    }
+    if (status != STAT_OK) {
+        if (nv == nv_body) {
+            return (status);                    // nothing was done - as for a single command
+        }
+        nv->valuetype = TYPE_EMPTY;             // don't print the command that failed
+    }
+    nv_print_list(status, TEXT_MULTILINE_FORMATTED, JSON_RESPONSE_FORMAT);
+    return (status);
+}
+
 /************************************************************************************
  * text_response() - text mode responses
  */
@@ -238,31 +318,31 @@ void text_print_nul(nvObj_t *nv, const char *string)
 
 void text_print_str(nvObj_t *nv, const char *format)
 {
-    sprintf(cs.out_buf, format, *nv->stringp);
+    str_format(cs.out_buf, format, *nv->stringp);
     xio_writeline(cs.out_buf);
 }
 
 void text_print_int(nvObj_t *nv, const char *format)
 {
-    sprintf(cs.out_buf, format, (uint32_t)nv->value);
+    str_format(cs.out_buf, format, (uint32_t)nv->value);
     xio_writeline(cs.out_buf);
 }
 
 void text_print_flt(nvObj_t *nv, const char *format)
 {
-    sprintf(cs.out_buf, format, nv->value);
+    str_format(cs.out_buf, format, nv->value);
     xio_writeline(cs.out_buf);
 }
 
 void text_print_flt_units(nvObj_t *nv, const char *format, const char *units)
 {
-    sprintf(cs.out_buf, format, nv->value, units);
+    str_format(cs.out_buf, format, nv->value, units);
     xio_writeline(cs.out_buf);
 }
 
 void text_print_bool(nvObj_t *nv, const char *format)
 {
-    sprintf(cs.out_buf, format, !!((uint32_t)nv->value)?"True":"False");
+    str_format(cs.out_buf, format, !!((uint32_t)nv->value)?"True":"False");
     xio_writeline(cs.out_buf);
 }
 
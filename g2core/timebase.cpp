@@ -0,0 +1,64 @@
+/*
+ * timebase.cpp - 64-bit microsecond timebase from the free-running cycle counter
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "g2core.h"
+#include "hardware.h"
+#include "timebase.h"
+
+/**** Allocate Structures ****/
+
+tbSingleton_t tb;
+
+// Count the wraps of the cycle counter. It is read at least once per wrap, every ms
+Motate::SysTickEvent timebase_tick_event {[&] {
+    __disable_irq();
+    uint32_t cycles = DWT->CYCCNT;
+    if (cycles < tb.last) {
+        tb.wraps++;
+    }
+    tb.last = cycles;
+    __enable_irq();
+}, nullptr};
+
+/**** CODE ****/
+
+/*
+ * timebase_init() - start the cycle counter and the timebase. Must be before anything stamps a time
+ */
+
+void timebase_init()
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;    // enable the trace block
+#if defined(__CM7_REV)
+    DWT->LAR = 0xC5ACCE55;                              // M7 DWT is write-locked out of reset
+#endif
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;                // start the cycle counter
+    tb.wraps = 0;
+    tb.last = 0;
+    SysTickTimer.registerEvent(&timebase_tick_event);
+}
@@ -0,0 +1,83 @@
+/*
+ * timebase.h - 64-bit microsecond timebase from the free-running cycle counter
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* The timebase is one clock for everything that stamps a time finer than the 1 ms SysTick:
+ *  input edges (gpio.h), telemetry samples and the planner trace. It is the DWT cycle
+ *  counter, running free at the CPU clock, extended to 64 bits in software. The profiler
+ *  reads the same counter for its cycle counts, so all of them can be lined up.
+ *
+ *  The counter wraps every 2^32 clocks - 51 s at 84 MHz, 14 s at 300 MHz. A SysTick event
+ *  reads it every ms and counts the wraps. tb_get_cycles() puts the count of wraps above
+ *  the counter, plus one if the counter has wrapped since the last tick, so it takes no
+ *  lock and can be called at any interrupt level. tb_get_usec() is the same time in
+ *  microseconds. Both count from timebase_init() and never go backwards.
+ *
+ *  The host gets the low 32 bits of the microseconds in telemetry frames and trace lines.
+ *  That wraps after 71 minutes, which is plenty to put events in order against each other.
+ */
+#ifndef TIMEBASE_H_ONCE
+#define TIMEBASE_H_ONCE
+
+typedef struct tbSingleton {
+    volatile uint32_t wraps;            // times the cycle counter has wrapped - written by the SysTick event only
+    volatile uint32_t last;             // cycle counter at the last SysTick
+} tbSingleton_t;
+
+extern tbSingleton_t tb;
+
+void timebase_init(void);
+
+/*
+ * tb_get_cycles() - CPU clocks since timebase_init()
+ * tb_get_usec()   - microseconds since timebase_init()
+ *
+ *  The wrap count is read again in case a tick counted a wrap in between. The tick writes
+ *  the count and the counter with interrupts off, so a higher priority interrupt never
+ *  sees one without the other.
+ */
+
+static inline uint64_t tb_get_cycles()
+{
+    uint32_t wraps;
+    uint32_t last;
+    uint32_t cycles;
+    do {
+        wraps = tb.wraps;
+        last = tb.last;
+        cycles = DWT->CYCCNT;
+    } while (wraps != tb.wraps);
+    if (cycles < last) {
+        wraps++;                        // wrapped since the last tick
+    }
+    return (((uint64_t)wraps << 32) | cycles);
+}
+
+static inline uint64_t tb_get_usec()
+{
+    return (tb_get_cycles() / (SystemCoreClock / 1000000));
+}
+
+#endif  // End of include guard: TIMEBASE_H_ONCE
@@ -0,0 +1,158 @@
+/*
+ * trace.cpp - ring buffered trace of planner decisions
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "g2core.h"
+#include "config.h"
+#include "hardware.h"
+#include "planner.h"
+#include "trace.h"
+#include "text_parser.h"
+#include "timebase.h"
+#include "xio.h"
+
+#include <atomic>           // atomic_signal_fence() orders the ring between the exec and the controller
+
+/**** Allocate Structures ****/
+
+trcSingleton_t trc;
+
+#define TRACE_MASK (TRACE_RECORDS-1)
+
+/************************************************************************************
+ **** CODE **************************************************************************
+ ************************************************************************************/
+
+/*
+ * trace_init() - initialize the planner trace. Recording is on from the start
+ */
+
+void trace_init()
+{
+    memset(&trc, 0, sizeof(trc));
+    trc.enable = 1;
+}
+
+/*
+ * trc_block() - record the plan of a block as it starts to run - called at exec interrupt level
+ */
+
+void trc_block(const mpBuf_t *bf)
+{
+    if (!trc.enable) {
+        return;
+    }
+    uint32_t count = trc.count;
+    trcRecord_t *r = &trc.ring[count & TRACE_MASK];
+    r->seq = count;
+    r->start = (uint32_t)tb_get_usec();
+    r->linenum = bf->cold->linenum;
+    r->hint = (uint8_t)bf->hint;
+    r->iterations = (uint16_t)bf->cold->iterations;
+    r->length = bf->length;
+    r->cruise_vmax = bf->cruise_vmax;
+    r->cruise_velocity = bf->cruise_velocity;
+    r->exit_vmax = bf->exit_vmax;
+    r->exit_velocity = bf->exit_velocity;
+    r->block_time = bf->block_time;
+    std::atomic_signal_fence(std::memory_order_release);   // record contents before the count
+    trc.count = count + 1;
+}
+
+/*
+ * trc_callback() - send the dump a few lines at a time
+ *
+ *  The exec keeps recording during a dump. Records it overwrites before they are sent are
+ *  skipped, and show as a gap in the sequence numbers.
+ */
+
+stat_t trc_callback()
+{
+    if (trc.dump_next == trc.dump_end) {
+        return (STAT_NOOP);
+    }
+    char line[160];
+
+    for (uint8_t i=0; (i < TRACE_DUMPS_PER_CALLBACK) && (trc.dump_next != trc.dump_end); i++) {
+        if (xio_tx_is_backed_up()) {
+            break;
+        }
+        std::atomic_signal_fence(std::memory_order_acquire);    // count before the record contents
+        if ((trc.count - trc.dump_next) > TRACE_RECORDS) {
+            trc.dump_next = trc.count - TRACE_RECORDS;          // the oldest still in the ring
+        }
+        trcRecord_t r = trc.ring[trc.dump_next & TRACE_MASK];   // copy, so the line is not torn
+        std::atomic_signal_fence(std::memory_order_acquire);
+        if ((trc.count - trc.dump_next) > TRACE_RECORDS) {
+            continue;                                           // overwritten while copying
+        }
+        trc.dump_next++;
+        sprintf(line, "{\"trc\":[%lu,%lu,%u,%u,%0.3f,%0.2f,%0.2f,%0.2f,%0.2f,%0.3f,%lu]}\n",
+                (unsigned long)r.seq, (unsigned long)r.linenum, r.hint, r.iterations,
+                (double)r.length, (double)r.cruise_vmax, (double)r.cruise_velocity,
+                (double)r.exit_vmax, (double)r.exit_velocity, (double)(r.block_time * 60000),
+                (unsigned long)r.start);
+        xio_writeline(line);
+    }
+    return (STAT_OK);
+}
+
+/***********************************************************************************
+ * CONFIGURATION AND INTERFACE FUNCTIONS
+ * Functions to get and set variables from the cfgArray table
+ ***********************************************************************************/
+
+/*
+ * trc_set_trcd() - dump the trace. {trcd:1} starts a dump, {trcd:0} stops one
+ */
+
+stat_t trc_set_trcd(nvObj_t *nv)
+{
+    ritorno(set_01(nv));                                // also sets trc.dump
+    uint32_t count = trc.count;
+    if (nv->value == 0) {
+        trc.dump_end = trc.dump_next;
+        return (STAT_OK);
+    }
+    trc.dump_next = (count > TRACE_RECORDS) ? (count - TRACE_RECORDS) : 0;
+    trc.dump_end = count;
+    return (STAT_OK);
+}
+
+/***********************************************************************************
+ * TEXT MODE SUPPORT
+ * Functions to print variables from the cfgArray table
+ ***********************************************************************************/
+
+#ifdef __TEXT_MODE
+
+static const char fmt_trce[] = "[trce] planner trace enable%8d [0=off,1=on]\n";
+static const char fmt_trcn[] = "[trcn] planner trace blocks%8lu\n";
+
+void trc_print_trce(nvObj_t *nv) { text_print(nv, fmt_trce);}
+void trc_print_trcn(nvObj_t *nv) { text_print(nv, fmt_trcn);}
+
+#endif // __TEXT_MODE
@@ -0,0 +1,107 @@
+/*
+ * trace.h - ring buffered trace of planner decisions
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2017 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* The planner trace keeps the final plan of the last TRACE_RECORDS blocks in RAM, so a
+ *  slowdown on a machine in the field can be looked at without a debugger attached.
+ *
+ *  trc_block() is called from mp_exec_aline() at exec interrupt level as each block starts
+ *  to run, which is when its plan becomes final. It copies a few fields of the block into
+ *  a ring that is overwritten oldest first - nothing is formatted there. Recording is on
+ *  by default and costs a 40 byte copy per block.
+ *
+ *  {trcd:1} dumps the ring, oldest block first. trc_callback() sends it from the controller
+ *  a few lines at a time while the TX path has room, one JSON array per block:
+ *
+ *      {"trc":[seq,line,hint,iterations,length,cruise_vmax,cruise_velocity,exit_vmax,exit_velocity,block_time,start]}
+ *
+ *      seq         block number since startup - gaps show blocks overwritten during the dump
+ *      line        Gcode line number
+ *      hint        blockHint the planner left on the block
+ *      iterations  times the block was planned (bf->cold->iterations)
+ *      length      mm
+ *      velocities  mm/min
+ *      block_time  ms
+ *      start       timebase time the block started to run, low 32 bits of us (timebase.h)
+ *
+ *  Resources/debug/mb_analyze.py --trace reads a capture of the dump. {trce:0} stops recording,
+ *  {trcn:} is the count of blocks recorded.
+ */
+#ifndef TRACE_H_ONCE
+#define TRACE_H_ONCE
+
+/**** Configs, Definitions and Structures ****/
+
+#ifndef TRACE_RECORDS
+#define TRACE_RECORDS           32      // blocks kept in the trace. Must be 2^N
+#endif
+#define TRACE_DUMPS_PER_CALLBACK 2      // lines sent per controller pass, at most
+
+typedef struct trcRecord {              // final plan of one block
+    uint32_t seq;
+    uint32_t start;
+    uint32_t linenum;
+    uint8_t hint;
+    uint16_t iterations;
+    float length;
+    float cruise_vmax;
+    float cruise_velocity;
+    float exit_vmax;
+    float exit_velocity;
+    float block_time;
+} trcRecord_t;
+
+typedef struct trcSingleton {
+    uint8_t enable;                     // 1 = record blocks {trce:}
+    uint8_t dump;                       // 1 = dump requested {trcd:}
+    volatile uint32_t count;            // blocks recorded {trcn:} - written by trc_block() only
+    uint32_t dump_next;                 // next block to dump
+    uint32_t dump_end;                  // count when the dump was requested
+    trcRecord_t ring[TRACE_RECORDS];
+} trcSingleton_t;
+
+extern trcSingleton_t trc;
+
+/**** Function Prototypes ****/
+
+void trace_init(void);
+void trc_block(const mpBuf_t *bf);
+stat_t trc_callback(void);
+
+stat_t trc_set_trcd(nvObj_t *nv);
+
+#ifdef __TEXT_MODE
+
+    void trc_print_trce(nvObj_t *nv);
+    void trc_print_trcn(nvObj_t *nv);
+
+#else
+
+    #define trc_print_trce tx_print_stub
+    #define trc_print_trcn tx_print_stub
+
+#endif // __TEXT_MODE
+
+#endif // End of include guard: TRACE_H_ONCE
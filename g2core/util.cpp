@@ -30,6 +30,8 @@
  *  - vector manipulation utilities
  */
 
+#include <stdarg.h>
+
 #include "g2core.h"
 #include "util.h"
 
@@ -195,6 +197,102 @@ char *escape_string(char *dst, char *src)
     return (start_dst);
 }
 
+/*
+ * atofloat() - read a decimal number, correctly rounded
+ *
+ *  The syntax is an optional sign, digits, and an optional point and digits. If exponent
+ *  is true an 'e' or 'E' exponent is also taken, but only if it has digits. No leading
+ *  spaces, hex, inf or nan. Returns false if there are no digits. *pstr is left on the
+ *  first character after the number (after a lone sign or point if there were no digits)
+ *  and *value is 0 (or -0) if there were none.
+ *
+ *  Up to ATOF_DIGITS significant digits are gathered as an integer, with zeros held back
+ *  so "1.500" is 15 and not 1500. If that integer and the power of ten are both exact in
+ *  a float (2^24 and 10^10) one multiply or divide gives the correctly rounded result.
+ *  This covers nearly every Gcode and config value. Anything else - more digits, a bigger
+ *  exponent - is handed to strtof() with the number NUL terminated in place, so it
+ *  can't read past the syntax above. That's much slower but gives the same result.
+ */
+
+#define ATOF_DIGITS 9                       // significant digits an uint32 always holds
+#define ATOF_EXACT_MANTISSA (1UL << 24)     // integers up to 2^24 are exact in a float
+#define ATOF_EXACT_EXPONENT 10              // largest power of ten a float holds exactly
+
+bool atofloat(char **pstr, float *value, const bool exponent)
+{
+    static const float pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10 };
+    char *start = *pstr;
+    char *p = start;
+    bool negative = (*p == '-');
+    uint32_t mantissa = 0;
+    int16_t scale = 0;                      // power of ten the mantissa is multiplied by
+    uint8_t digits = 0;                     // significant digits in the mantissa
+    uint8_t zeros = 0;                      // zero digits held back from the mantissa
+    bool exact = true;                      // false if a significant digit didn't fit
+    bool found_digit = false;
+    bool fraction = false;
+
+    if ((*p == '-') || (*p == '+')) { p++; }
+    for ( ; ; p++) {
+        char c = *p;
+        if ((c == '.') && !fraction) {
+            fraction = true;
+            continue;
+        }
+        if ((c < '0') || (c > '9')) {
+            break;
+        }
+        found_digit = true;
+        if (fraction) {
+            scale--;
+        }
+        if (c == '0') {
+            if (mantissa != 0) { zeros++; } // leading zeros are nothing at all
+            continue;
+        }
+        if ((digits + zeros) >= ATOF_DIGITS) {
+            exact = false;
+            continue;
+        }
+        for ( ; zeros > 0; zeros--) {
+            mantissa *= 10;
+            digits++;
+        }
+        mantissa = (mantissa * 10) + (c - '0');
+        digits++;
+    }
+    scale += zeros;                         // trailing zeros scale the mantissa instead
+
+    if (found_digit && exponent && ((*p == 'e') || (*p == 'E'))) {
+        char *e = p+1;
+        bool exp_negative = (*e == '-');
+        if ((*e == '-') || (*e == '+')) { e++; }
+        if (isdigit(*e)) {
+            int16_t exp_value = 0;
+            for ( ; isdigit(*e); e++) {
+                if (exp_value < 1000) { exp_value = (exp_value * 10) + (*e - '0'); }
+            }
+            scale += (exp_negative ? -exp_value : exp_value);
+            p = e;
+        }
+    }
+    *pstr = p;
+
+    if (mantissa == 0) {                    // no significant digits, so this is exact
+        *value = (negative ? -0.0 : 0.0);
+    } else if (exact && (mantissa <= ATOF_EXACT_MANTISSA) &&
+               (scale <= ATOF_EXACT_EXPONENT) && (scale >= -ATOF_EXACT_EXPONENT)) {
+        float v = (scale >= 0) ? ((float)mantissa * pow10[scale]) : ((float)mantissa / pow10[-scale]);
+        *value = (negative ? -v : v);
+    } else {
+        char hold = *p;
+        *p = 0;                             // NUL
+        *value = strtof(start, NULL);
+        *p = hold;
+    }
+    return (found_digit);
+}
+
 /*
  * fntoa() - return ASCII string given a float and a decimal precision value
  *
@@ -572,7 +670,7 @@ static int _i2a(char *s, int n)
 
 char inttoa(char *str, int n)
 {
-    if (n < 256) {
+    if ((n >= 0) && (n < 256)) {
         strcpy(str, GET_TEXT_ITEM(itoa_str, n));
     } else {
         char *p = str;
@@ -587,89 +685,257 @@ char inttoa(char *str, int n)
     return (strlen(str));
 }
 
-constexpr float round_lookup_[] = {
-    0.5,          // precision 0
-    0.05,         // precision 1
-    0.005,        // precision 2
-    0.0005,       // precision 3
-    0.00005,      // precision 4
-    0.000005,     // precision 5
-    0.0000005,    // precision 6
-    0.00000005,   // precision 7
-    0.000000005,  // precision 8
-    0.0000000005, // precision 9
-    0.00000000005 // precision 10
+static const uint32_t pow10_lookup_[] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
 };
+#define FIXEDTOA_PRECISION_MAX 9
 
-// It's assumed that the string buffer contains at lest count_ non-\0 chars
-int c_strreverse(char * const t, const int count_, char hold = 0) {
-    return count_>1
-    // Note: It always returns the count_, for a consistent interface.
-    ? (hold=*t, *t=*(t+(count_-1)), *(t+(count_-1))=hold), c_strreverse(t+1, count_-2), count_
-    : count_;
+// write an unsigned integer, returning the length
+static int _ultoa(char *buffer, uint32_t n)
+{
+    char tmp[10];
+    int length_ = 0;
+    do {
+        uint32_t t_ = n / 10;
+        tmp[length_++] = '0' + (n - (t_*10));
+        n = t_;
+    } while (n > 0);
+    for (int i = 0; i < length_; i++) {
+        buffer[i] = tmp[length_-1-i];
+    }
+    return length_;
 }
 
-char floattoa(char *buffer, float in, int precision, int maxlen /*= 16*/) {
-    int length_ = 0;
+/*
+ * _fixedtoa() - float to fixed-point ASCII. Core of floattoa() and str_format()
+ *
+ *  Writes the value rounded to precision digits after the point and returns the length.
+ *  The integer part of a float is exact, so it's split off and done as an integer, and
+ *  so is the fraction once it's scaled by the precision. No printf-float is needed.
+ *  If strip is true trailing zeroes are removed, and the point if nothing follows it.
+ */
+static int _fixedtoa(char *buffer, float in, int precision, bool strip)
+{
     char *b_ = buffer;
 
+    if (isnan(in)) {
+        strcpy(buffer, "nan");
+        return (3);
+    }
     if (in < 0.0) {
         *b_++ = '-';
-        return floattoa(b_, -in, precision, maxlen-1) + 1;
+        in = -in;
+    }
+    if (isinf(in)) {
+        strcpy(b_, "inf");
+        return ((b_ - buffer) + 3);
+    }
+    if (precision > FIXEDTOA_PRECISION_MAX) {
+        precision = FIXEDTOA_PRECISION_MAX;
+    }
+    if (precision < 0) {
+        precision = 0;
     }
 
-    in += round_lookup_[precision];
-    int int_length_ = 0;
-    int integer_part_ = (int)in;
-
-    // do integer part
-    while (integer_part_ > 0) {
-        if (length_++ > maxlen) {
-            *buffer = 0;
-            return 0;
-        }
-        int t_ = integer_part_ / 10;
-        *b_++ = '0' + (integer_part_ - (t_*10));
-        integer_part_ = t_;
-        int_length_++;
+    uint8_t zeroes_ = 0;                            // past the 9 digits a uint32_t can hold
+    while (in >= 4294967295.0) {
+        in /= 10;
+        zeroes_++;
+    }
+    // The float is exactly mantissa_ / 2^shift_. Split it there into the integer part and
+    // the fraction's bits, which are scaled exactly by 10^precision in 64 bits (24 bits of
+    // mantissa times 10^9 is under 2^54). The remainder is then exact, so rounding - to
+    // even on a tie, as printf does - sees every bit of the fraction.
+    uint32_t bits_;
+    memcpy(&bits_, &in, sizeof(bits_));
+    uint32_t mantissa_ = bits_ & 0x007FFFFF;
+    int shift_ = 149;                               // denormal
+    if (bits_ & 0x7F800000) {
+        mantissa_ |= 0x00800000;
+        shift_ = 150 - (int)(bits_ >> 23);
     }
-    if (length_ > 0) {
-        c_strreverse(buffer, int_length_);
+    uint32_t integer_part_ = 0;
+    uint32_t frac_bits_ = 0;
+    if (shift_ <= 0) {
+        integer_part_ = mantissa_ << -shift_;
+    } else if (shift_ < 32) {
+        integer_part_ = mantissa_ >> shift_;
+        frac_bits_ = mantissa_ & (((uint32_t)1 << shift_) - 1);
     } else {
-        *b_++ = '0';
-        int_length_++;
+        frac_bits_ = mantissa_;
     }
 
-    // do fractional part
-    *b_++ = '.';
-    length_ = int_length_+1;
-
-    float frac_part_ = in;
-    frac_part_ -= (int)frac_part_;
-    while (precision-- > 0) {
-        if (length_++ > maxlen) {
-            *buffer = 0;
-            return 0;
+    uint32_t frac_part_ = 0;
+    if ((shift_ > 0) && (shift_ < 56)) {            // past 2^-55 the fraction is under half the last digit
+        uint64_t scaled_ = (uint64_t)frac_bits_ * pow10_lookup_[precision];
+        uint64_t half_ = (uint64_t)1 << (shift_ - 1);
+        uint64_t remainder_ = scaled_ & ((half_ << 1) - 1);
+        frac_part_ = (uint32_t)(scaled_ >> shift_);
+        uint32_t last_digit_ = (precision > 0) ? frac_part_ : integer_part_;
+        if ((remainder_ > half_) || ((remainder_ == half_) && (last_digit_ & 1))) {
+            frac_part_++;
+        }
+    }
+    if (frac_part_ >= pow10_lookup_[precision]) {   // the fraction rounded up to a whole number
+        frac_part_ -= pow10_lookup_[precision];
+        if (++integer_part_ == 0) {                 // ...and that wrapped the integer part
+            integer_part_ = 429496730;
+            zeroes_++;
         }
-        frac_part_ *= 10.0;
-        // if (precision==0) {
-        //     t_ += 0.5;
-        // }
-        *b_++ = ('0' + (int)frac_part_);
-        frac_part_ -= (int)frac_part_;
+    }
+    if ((integer_part_ == 0) && (frac_part_ == 0) && (b_ != buffer)) {
+        b_ = buffer;                                // no "-0"
     }
 
-    // right strip trailing zeroes (OPTIONAL)
-#if 1
-    while (*(b_-1) == '0' && length_>1) {
-        *(b_--) = 0;
-        length_--;
+    b_ += _ultoa(b_, integer_part_);
+    while (zeroes_-- > 0) {
+        *b_++ = '0';
     }
+    if (precision > 0) {
+        *b_++ = '.';
+        for (int i = precision-1; i >= 0; i--) {
+            b_[i] = '0' + (frac_part_ % 10);
+            frac_part_ /= 10;
+        }
+        b_ += precision;
+        if (strip) {
+            while (*(b_-1) == '0') {
+                b_--;
+            }
+            if (*(b_-1) == '.') {
+                b_--;
+            }
+        }
+    }
+    *b_ = 0;
+    return (b_ - buffer);
+}
 
-    if (*(b_-1) == '.') {
-        *(b_--) = 0;
-        length_--;
+/*
+ * floattoa() - float to ASCII with trailing zeroes stripped. Returns the length
+ *
+ *  If the result is longer than maxlen the buffer is left empty and 0 is returned.
+ */
+char floattoa(char *buffer, float in, int precision, int maxlen /*= 16*/) {
+    char tmp[32];
+    int length_ = _fixedtoa(tmp, in, precision, true);
+
+    if (length_ > maxlen) {
+        *buffer = 0;
+        return 0;
     }
-#endif
+    strcpy(buffer, tmp);
     return length_;
 }
+
+/*
+ * str_format() - sprintf() subset for the text-mode printers, without printf-float
+ *
+ *  Handles %s %c %d %i %u %x and %f, with the l modifier, the - and 0 flags, widths
+ *  and precisions. That's every format the printers use. %f is done by _fixedtoa(),
+ *  which is much faster than newlib's printf-float and uses far less stack.
+ *  Anything else is copied as-is. Returns the length written, less the NUL.
+ */
+int str_format(char *buffer, const char *format, ...)
+{
+    va_list args;
+    char *b_ = buffer;
+    char tmp[32];
+
+    va_start(args, format);
+    for (const char *f = format; *f != 0; f++) {
+        if (*f != '%') {
+            *b_++ = *f;
+            continue;
+        }
+        const char *spec = f++;
+        bool left = false;
+        char pad = ' ';
+        int width = 0;
+        int precision = -1;
+        bool is_long = false;
+
+        for ( ; (*f == '-') || (*f == '0') || (*f == ' ') || (*f == '+') || (*f == '#'); f++) {
+            if (*f == '-') { left = true; }
+            if (*f == '0') { pad = '0'; }
+        }
+        for ( ; isdigit(*f); f++) {
+            width = (width * 10) + (*f - '0');
+        }
+        if (*f == '.') {
+            for (precision = 0, f++; isdigit(*f); f++) {
+                precision = (precision * 10) + (*f - '0');
+            }
+        }
+        for ( ; (*f == 'l') || (*f == 'h'); f++) {
+            if (*f == 'l') { is_long = true; }
+        }
+
+        const char *s = tmp;
+        int length_;
+        switch (*f) {
+            case 'd':
+            case 'i': { long n = is_long ? va_arg(args, long) : va_arg(args, int);
+                        char *t = tmp;
+                        if (n < 0) {
+                            *t++ = '-';
+                        }
+                        length_ = (t - tmp) + _ultoa(t, (n < 0) ? -(uint32_t)n : (uint32_t)n);
+                        break;
+                      }
+            case 'u': { length_ = _ultoa(tmp, is_long ? va_arg(args, unsigned long) : va_arg(args, unsigned int));
+                        break;
+                      }
+            case 'x': { uint32_t n = is_long ? va_arg(args, unsigned long) : va_arg(args, unsigned int);
+                        char *t = &tmp[sizeof(tmp)];
+                        do {
+                            *--t = "0123456789abcdef"[n & 0xF];
+                            n >>= 4;
+                        } while (n > 0);
+                        s = t;
+                        length_ = &tmp[sizeof(tmp)] - t;
+                        break;
+                      }
+            case 'c': { tmp[0] = (char)va_arg(args, int);
+                        length_ = 1;
+                        break;
+                      }
+            case 's': { s = va_arg(args, const char *);
+                        length_ = strlen(s);
+                        if ((precision >= 0) && (length_ > precision)) {
+                            length_ = precision;
+                        }
+                        break;
+                      }
+            case 'f': { length_ = _fixedtoa(tmp, (float)va_arg(args, double), (precision < 0) ? 6 : precision, false);
+                        break;
+                      }
+            case '%': { tmp[0] = '%';
+                        length_ = 1;
+                        break;
+                      }
+            default:  { s = spec;                   // not handled - copy the spec as-is
+                        length_ = (f - spec) + ((*f != 0) ? 1 : 0);
+                        width = 0;
+                        if (*f == 0) { f--; }
+                        break;
+                      }
+        }
+        if ((pad == '0') && !left && (length_ > 0) && (*s == '-')) {  // zero padding goes after the sign
+            *b_++ = *s++;
+            length_--;
+            width--;
+        }
+        if (!left) {
+            for ( ; width > length_; width--) { *b_++ = pad; }
+        }
+        memcpy(b_, s, length_);
+        b_ += length_;
+        if (left) {
+            for ( ; width > length_; width--) { *b_++ = ' '; }
+        }
+    }
+    va_end(args);
+    *b_ = 0;
+    return (b_ - buffer);
+}
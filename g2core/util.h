@@ -93,6 +93,8 @@ uint8_t isnumber(char c);
 char *escape_string(char *dst, char *src);
 char inttoa(char *str, int n);
 char floattoa(char *buffer, float in, int precision, int maxlen = 16);
+bool atofloat(char **pstr, float *value, const bool exponent);
+int str_format(char *buffer, const char *format, ...);
 //char fntoa(char *str, float n, uint8_t precision);
 
 uint16_t compute_checksum(char const *string, const uint16_t length);
@@ -150,6 +152,102 @@ inline T avg(const T a,const T b) {return (a+b)/2; }
 #define fp_TRUE(a) (a > EPSILON)
 #endif
 
+//*** hot math kernels ***
+/*
+ * fast_sqrt() - square root to float precision, for the planner and exec hot paths
+ * est_sqrt()  - square root within 4.8e-6 (relative), for counts and estimates
+ *
+ *  On an FPU target (the M7 - __ARM_FP has single precision) fast_sqrt() is VSQRT.F32
+ *  inline, correctly rounded. sqrt() and sqrtf() compile to the same instruction but
+ *  keep a compare and a branch to the library for errno. est_sqrt() is the same, as
+ *  there's nothing cheaper on the FPU.
+ *
+ *  Without an FPU (the M3) fast_sqrt() is sqrtf(), correctly rounded, and est_sqrt()
+ *  is a reciprocal square root seed with two Newton steps - eight soft float multiplies
+ *  and two subtracts, against sqrtf()'s bit by bit root. Each Newton step squares the
+ *  error: one step is good to 1.8e-3, two to 4.8e-6, three to 1.9e-7. The host build
+ *  (the sim) runs the M3 code.
+ *
+ *  Both take x >= 0. est_sqrt(0) is 0.
+ */
+
+#if defined(__ARM_FP) && (__ARM_FP & 0x4)
+
+inline float fast_sqrt(const float x) {
+    float r;
+    __asm__ ("vsqrt.f32 %0, %1" : "=t" (r) : "t" (x));
+    return (r);
+}
+inline float est_sqrt(const float x) { return (fast_sqrt(x)); }
+
+#else
+
+inline float fast_sqrt(const float x) { return (sqrtf(x)); }
+inline float est_sqrt(const float x) {
+    union { float f; uint32_t i; } u = { x };
+    u.i = 0x5f375a86 - (u.i >> 1);                      // 1/sqrt(x) seed, within 3.4%
+    const float half_x = x * 0.5f;
+    float r = u.f;
+    r = r * (1.5f - half_x * r * r);                    // Newton steps
+    r = r * (1.5f - half_x * r * r);
+    return (x * r);
+}
+
+#endif
+
+//*** fixed size vector kernels ***
+
+/*
+ * Fixed size vector kernels - for the per block and per segment vector math
+ *
+ * vec_scale()      - d = s * a
+ * vec_scale_add()  - d = a + s * b
+ * vec_dot()        - a . b
+ * vec_norm()       - |a|
+ *
+ *  The size comes from the array type - float[AXES] or float[MOTORS] - and every operation
+ *  is unrolled at compile time, with d taken as not aliasing the inputs (__restrict__), so
+ *  each is straight-line code. Sums add the terms in axis order, as the loops they replace
+ *  did, so results are bit for bit the same. A struct member array works as it is, so the
+ *  planner and runtime structures keep their plain float arrays.
+ */
+
+template <uint8_t N>
+struct vec_unrolled {
+    static inline void scale(float * __restrict__ d, const float *a, const float s) {
+        vec_unrolled<N-1>::scale(d, a, s);
+        d[N-1] = a[N-1] * s;
+    }
+    static inline void scale_add(float * __restrict__ d, const float *a, const float s, const float *b) {
+        vec_unrolled<N-1>::scale_add(d, a, s, b);
+        d[N-1] = a[N-1] + b[N-1] * s;
+    }
+    static inline float dot(const float *a, const float *b) {
+        return (vec_unrolled<N-1>::dot(a, b) + a[N-1] * b[N-1]);
+    }
+};
+
+template <>
+struct vec_unrolled<0> {
+    static inline void scale(float * __restrict__ d, const float *a, const float s) {}
+    static inline void scale_add(float * __restrict__ d, const float *a, const float s, const float *b) {}
+    static inline float dot(const float *a, const float *b) { return (0); }
+};
+
+template <uint8_t N>
+inline void vec_scale(float (&d)[N], const float (&a)[N], const float s) { vec_unrolled<N>::scale(d, a, s); }
+
+template <uint8_t N>
+inline void vec_scale_add(float (&d)[N], const float (&a)[N], const float s, const float (&b)[N]) {
+    vec_unrolled<N>::scale_add(d, a, s, b);
+}
+
+template <uint8_t N>
+inline float vec_dot(const float (&a)[N], const float (&b)[N]) { return (vec_unrolled<N>::dot(a, b)); }
+
+template <uint8_t N>
+inline float vec_norm(const float (&a)[N]) { return (fast_sqrt(vec_unrolled<N>::dot(a, a))); }
+
 // Constants
 #define MAX_LONG (2147483647)
 #define MAX_ULONG (4294967295)
@@ -173,21 +271,9 @@ inline T avg(const T a,const T b) {return (a+b)/2; }
 #define M_SQRT3 (1.73205080756888)
 #endif
 
-// Fraction part
-constexpr float c_atof_frac_(char *&p_, float v_, float m_) {
-    return ((*p_ >= '0') && (*p_ <= '9')) ? (v_ = ((v_) + ((*p_) - '0') * m_), c_atof_frac_(++p_, v_, m_ / 10.0)) : v_;
-}
-
-// Integer part
-template <typename int_type>
-constexpr float c_atof_int_(char *&p_, int_type v_) {
-    return (*p_ == '.')
-    ? (float)(v_) + c_atof_frac_(++p_, 0, 1.0 / 10.0)
-    : (((*p_ >= '0') && (*p_ <= '9')) ? ((v_ = ((*p_) - '0') + (v_ * 10)), c_atof_int_(++p_, v_)) : v_);
-}
-
-// Start portion
-constexpr float c_atof(char *&p_) { return (*p_ == '-') ? (c_atof_int_(++p_, 0) * -1.0) : ( (*p_ == '+') ? c_atof_int_(++p_, 0) : (c_atof_int_(p_, 0))); }
+// Gcode number: optional sign, digits, optional point and digits. No exponent. Like the
+// old recursive version p_ is left after the number - even if it was only a sign or point
+inline float c_atof(char *&p_) { float v_; atofloat(&p_, &v_, false); return (v_); }
 
 // It's assumed that the string buffer contains at lest count_ non-\0 chars
 //constexpr int c_strreverse(char * const t, const int count_, char hold = 0) {
@@ -38,6 +38,7 @@
 #include "controller.h"
 #include "util.h"
 #include "settings.h"
+#include "rx_capture.h"
 
 #include "board_xio.h"
 
@@ -97,6 +98,33 @@ bool checkForNotActive(devflags_t flags_to_check) { return !(flags_to_check & DE
 bool checkForCtrlAndData(devflags_t flags_to_check) { return (flags_to_check & (DEV_IS_CTRL|DEV_IS_DATA)) == (DEV_IS_CTRL|DEV_IS_DATA); }
 bool checkForCtrlAndPrimary(devflags_t flags_to_check) { return (flags_to_check & (DEV_IS_CTRL|DEV_IS_PRIMARY)) == (DEV_IS_CTRL|DEV_IS_PRIMARY); }
 
+/*
+ * Single-character controls - only a control as the first character of a line
+ *
+ *  _scanBuffer() and the realtime scan both classify with _controlCharType(). The realtime
+ *  scan acts on CTRL_REALTIME itself. It stops at a CTRL_DEFERRED until _scanBuffer() has
+ *  dispatched it, so a realtime character can't overtake a control received before it.
+ */
+enum xioCtrlCharType { CTRL_NONE = 0, CTRL_REALTIME, CTRL_DEFERRED };
+
+static xioCtrlCharType _controlCharType(const char c)
+{
+    if ((c == CHAR_FEEDHOLD) || (c == CHAR_CYCLE_START) || (c == CHAR_RESET)) {
+        return (CTRL_REALTIME);
+    }
+    if ((c == ENQ) || (c == CHAR_ALARM) || (c == CHAR_QUEUE_FLUSH)) {
+        return (CTRL_DEFERRED);
+    }
+    return (CTRL_NONE);
+}
+
+// the test _scanBuffer() makes as it reaches c. A flush is a control only in a feedhold
+static bool _isControlChar(const char c)
+{
+    xioCtrlCharType type = _controlCharType(c);
+    return ((type == CTRL_REALTIME) || ((type == CTRL_DEFERRED) && ((c != CHAR_QUEUE_FLUSH) || cm_has_hold())));
+}
+
 struct xioDeviceWrapperBase {                // C++ base class for device primitives
     // connection and device management
     uint8_t caps;                            // bitfield for capabilities flags (these are persistent)
@@ -164,8 +192,13 @@ struct xioDeviceWrapperBase {                // C++ base class for device primit
     virtual void flushRead() {};       // This should call _flushLine() before flushing the device.
     virtual bool flushToCommand() { return false; };
     virtual int16_t write(const char *buffer, int16_t len) { return -1; };
+    virtual void txCallback() {};
+    virtual void readAhead() {};
+    virtual uint8_t txChainCount() { return 0; };
 
     virtual char *readline(devflags_t limit_flags, uint16_t &size) { return nullptr; };
+    virtual uint16_t rxBytesFree() { return 0; };
+    virtual void realtimeScan() {};
 
 #if MARLIN_COMPAT_ENABLED == true
     virtual void exitFakeBootloaderMode() {};
@@ -252,8 +285,9 @@ struct xio_t {
      * 1) If a device fails to write the data, or all the data, then it's ignored
      * 2) Only the amount written by the *last* device to match (CTRL|ACTIVE) is returned.
      *
-     * In the current environment, these are not foreseen to cause trouble since these
-     * are blocking writes and we expect to only really be writing to one device.
+     * Devices with a TX chain take everything, queuing what the TX buffer can't hold (or
+     * dropping it if the chain is full), so this never waits. A device that takes nothing
+     * breaks out of the loop rather than spinning.
      */
     size_t write(const char *buffer, size_t size, bool only_to_muted)
     {
@@ -269,7 +303,10 @@ struct xio_t {
                 const char *buf = buffer;
                 int16_t to_write = size;
                 while (to_write > 0) {
-                    size_t written = DeviceWrappers[i]->write(buf, to_write);
+                    int16_t written = DeviceWrappers[i]->write(buf, to_write);
+                    if (written <= 0) {
+                        break;
+                    }
                     buf += written;
                     to_write -= written;
                     total_written += written;
@@ -301,6 +338,40 @@ struct xio_t {
         }
     }
 
+    /*
+     * txCallback() - hand queued TX chain buffers to the devices as their TX buffers drain
+     */
+    void txCallback()
+    {
+        for (int8_t i = 0; i < _dev_count; ++i) {
+            DeviceWrappers[i]->txCallback();
+        }
+    }
+
+    /*
+     * readAhead() - let devices that read from storage fill their buffers, outside of readline()
+     */
+    void readAhead()
+    {
+        for (int8_t i = 0; i < _dev_count; ++i) {
+            DeviceWrappers[i]->readAhead();
+        }
+    }
+
+    /*
+     * txIsBackedUp() - true if the chain of a control device is more than half full
+     */
+    bool txIsBackedUp()
+    {
+        for (int8_t i = 0; i < _dev_count; ++i) {
+            if (DeviceWrappers[i]->isCtrlAndActive() &&
+                (DeviceWrappers[i]->txChainCount() > (XIO_TX_CHAIN_BUFFERS/2))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
     /*
      * flushRead() - flush all readable devices' read buffers
      */
@@ -390,6 +461,32 @@ struct xio_t {
         return (NULL);
     };
 
+    /*
+     * rxBytesFree() - bytes the host may send before the RX buffer of a data channel is full
+     *
+     *  Only one channel streams data at a time, so this is the most free on any active data channel.
+     */
+    uint16_t rxBytesFree()
+    {
+        uint16_t bytes_free = 0;
+        for (uint8_t dev=0; dev < _dev_count; dev++) {
+            if (DeviceWrappers[dev]->isDataAndActive()) {
+                bytes_free = std::max(bytes_free, DeviceWrappers[dev]->rxBytesFree());
+            }
+        }
+        return (bytes_free);
+    };
+
+    /*
+     * realtimeScan() - run the realtime command scan on all devices. Called from the SysTick
+     */
+    void realtimeScan()
+    {
+        for (int8_t i = 0; i < _dev_count; ++i) {
+            DeviceWrappers[i]->realtimeScan();
+        }
+    };
+
 #if MARLIN_COMPAT_ENABLED == true
     void exitFakeBootloaderMode() {
         for (int8_t i = 0; i < _dev_count; ++i) {
@@ -430,8 +527,11 @@ struct LineRXBuffer : RXBuffer<_size, owner_type, char> {
 
     // START OF LineRXBuffer PROPER
     static_assert(((_header_count-1)&_header_count)==0, "_header_count must be 2^N");
+    static_assert(((_size-1)&_size)==0, "_size must be 2^N");
+    static_assert(XIO_RX_TRANSFER_MIN_FREE < (_size/2), "XIO_RX_TRANSFER_MIN_FREE must be under half the RX ring");
+    static_assert(_header_count <= 128, "_header_count must fit the uint8_t header indexes");
 
-    char _line_buffer[_line_buffer_size+1]; // hold exactly one line to return
+    char _line_buffer[_line_buffer_size+1]; // hold one line to return, if it wraps the end of _data
     uint32_t _line_end_guard = 0xBEEF;
 
     // General term usage:
@@ -445,10 +545,51 @@ struct LineRXBuffer : RXBuffer<_size, owner_type, char> {
     bool     _at_start_of_line;     // true if the last character scanned was the end of a line
 
     uint16_t _lines_found;          // count of complete non-control lines that were found during scanning.
+                                    // the oldest of them (up to _header_count-1) are also in _line_headers
 
     volatile uint16_t _last_scan_offset;  // DEBUGGING
 
+    xioRxStats_t *_stats;           // the owning device's counters in xio_rx_stats[]
+    uint32_t _last_line_tick;       // SysTick when the scan last found a data line
+    bool     _saw_a_line = false;   // _last_line_tick is valid
+
     bool _last_returned_a_control = false;
+    bool _capture = false;          // the owning device is the data channel - hand the bytes scanned to rxc_rx()
+
+#if defined(__CM7_REV)
+    // With the data cache on, characters the DMA wrote are invalidated before they're scanned.
+    // Everything ahead of _invalidated_offset (up to the write offset) is still to be done.
+    volatile uint16_t _invalidated_offset;
+
+    void _invalidateNew(const uint16_t write_offset) {
+        uint16_t from = _invalidated_offset;
+        if (write_offset < from) {                          // wraps the end of _data
+            hw_dcache_invalidate(&_data[from], _size - from);
+            from = 0;
+        }
+        if (write_offset > from) {
+            hw_dcache_invalidate(&_data[from], write_offset - from);
+        }
+        _invalidated_offset = write_offset;     // a race with the other scanner only repeats work
+    };
+#endif
+
+    // A data line that doesn't wrap is returned in place, as a view into _data. The read offset is left
+    // at the start of that line until the next readline() (or flush) so the transfer can't overwrite it.
+    uint16_t _held_read_offset;     // where _read_offset goes once the line in use is released
+    bool     _line_is_held = false; // true if the last line returned is a view into _data
+
+#if XIO_REALTIME_ENABLED == true
+    // The realtime scan runs from the SysTick and acts on ! ~ and ^X itself. _scanBuffer() only scans what
+    // the realtime scan has already seen, and consumes those characters without returning them.
+    volatile uint16_t _rt_scan_offset;  // _scanBuffer() stops here. Only written by the realtime scan
+    volatile bool _rt_restart;          // set by flush() - the realtime scan restarts at the read offset
+    volatile bool _rt_held;             // the realtime scan waits on the control before _rt_scan_offset
+    volatile bool _rt_released;         // set by _scanBuffer() once it's past that control
+    volatile bool _rt_resume_at_start;  // ...with its _at_start_of_line after it
+    bool _rt_at_start_of_line;          // realtime scan state. Only used by it
+    bool _found_realtime;               // the control _scanBuffer() just found was already acted on
+#endif
 
 #if MARLIN_COMPAT_ENABLED == true
     enum class STK500V2_State {
@@ -476,12 +617,90 @@ struct LineRXBuffer : RXBuffer<_size, owner_type, char> {
     }
 #endif
 
-    LineRXBuffer(owner_type owner) : parent_type{owner} {};
+    LineRXBuffer(owner_type owner, xioRxStats_t *stats) : parent_type{owner}, _stats{stats} {};
 
     void init() {
         parent_type::init();
         _at_start_of_line = true;
+#if defined(__CM7_REV)
+        _invalidated_offset = _scan_offset;
+#endif
+#if XIO_REALTIME_ENABLED == true
+        _rt_restart = true;
+#endif
+    };
+
+#if XIO_REALTIME_ENABLED == true
+    /*
+     * realtimeScan() - act on single-character realtime commands as soon as they arrive
+     *
+     *  Called from the SysTick interrupt. It never moves anything _scanBuffer() or readline() use.
+     *  Since _scanBuffer() stays behind it, nothing it hasn't seen is ever read. After a flush it
+     *  restarts at the read offset, which is at the start of a line.
+     *
+     *  A realtime character is a command only at the start of a line, tracked as _scanBuffer()
+     *  does. Nothing in the ignored tail of a too-long line is at a line start in either scan.
+     *  The scan stops on any other control (see _controlCharType()). Whether a % is a control
+     *  depends on the hold when _scanBuffer() reaches it, and acting on a later ~ or ! first
+     *  would reorder the commands. _scanBuffer() scans that one character and hands back its
+     *  _at_start_of_line, and the scan carries on from there.
+     */
+    void realtimeScan() {
+        uint16_t write_offset = _getWriteOffset();
+        uint16_t rt_scan_offset = _rt_scan_offset;
+#if defined(__CM7_REV)
+        _invalidateNew(write_offset);
+#endif
+
+        if (_rt_restart) {
+            rt_scan_offset = _read_offset;
+            _rt_at_start_of_line = true;
+            _rt_held = false;
+            _rt_released = false;
+            _rt_restart = false;
+        }
+#if MARLIN_COMPAT_ENABLED == true
+        if (_stk_parser_state != STK500V2_State::Done) {
+            _rt_scan_offset = write_offset;     // stk500v2 packets are binary - just let _scanBuffer() have them
+            _rt_at_start_of_line = true;
+            _rt_held = false;
+            _rt_released = false;
+            return;
+        }
+#endif
+        if (_rt_held) {
+            if (!_rt_released) {
+                return;                         // _scanBuffer() hasn't dispatched the control yet
+            }
+            _rt_at_start_of_line = _rt_resume_at_start;
+            _rt_released = false;
+            _rt_held = false;
+        }
+        while (rt_scan_offset != write_offset) {
+            char c = _data[rt_scan_offset];
+            rt_scan_offset = (rt_scan_offset+1)&(_size-1);
+            if ((c == '\r') || (c == '\n')) {
+                _rt_at_start_of_line = true;
+                continue;
+            }
+            xioCtrlCharType type = _rt_at_start_of_line ? _controlCharType(c) : CTRL_NONE;
+            if (type == CTRL_DEFERRED) {
+                _rt_held = true;                // let _scanBuffer() have this one before going on
+                break;
+            }
+            if (type == CTRL_NONE) {
+                _rt_at_start_of_line = false;
+            } else if (c == CHAR_FEEDHOLD) {
+                cm.rt_feedhold_requested = true;
+            } else if (c == CHAR_CYCLE_START) {
+                cm.rt_end_hold_requested = true;
+            } else {
+                hw_hard_reset();                // reset immediately
+            }
+        }
+        _rt_scan_offset = rt_scan_offset;
     };
+#endif
 
 
     struct SkipSections {
@@ -550,12 +769,94 @@ struct LineRXBuffer : RXBuffer<_size, owner_type, char> {
 
     SkipSections _skip_sections;
 
+    // LineHeaders index the complete data lines found by the scan, so readline() can return the
+    // next one without walking it again. A line is only indexed if every line found before it is,
+    // so the index always holds the oldest lines. Lines found while it's full are walked as before.
+    struct LineHeaders {
+        struct LineHeader {
+            uint16_t start_offset; // the offset of the first character of the line
+            uint16_t length;       // characters in the line, not counting the line-ending
+            uint16_t found_tick;   // low 16 bits of the SysTick when the scan found it (for the latency stat)
+        };
+
+        LineHeader _headers[_header_count];
+
+        uint8_t read_header_idx;  // index of the oldest line indexed
+        uint8_t write_header_idx; // index of the next header to populate
+
+        bool isFull() {
+            return ((write_header_idx+1)&(_header_count-1)) == read_header_idx;
+        };
+        bool isEmpty() {
+            return (write_header_idx == read_header_idx);
+        };
+        uint8_t count() {
+            return ((write_header_idx - read_header_idx)&(_header_count-1));
+        };
+
+        void addLine(uint16_t start_offset, uint16_t length, uint16_t found_tick) {
+            _headers[write_header_idx].start_offset = start_offset;
+            _headers[write_header_idx].length = length;
+            _headers[write_header_idx].found_tick = found_tick;
+            write_header_idx = ((write_header_idx+1)&(_header_count-1));
+        };
+
+        const LineHeader &popLine() {
+            const LineHeader &header = _headers[read_header_idx];
+            read_header_idx = ((read_header_idx+1)&(_header_count-1));
+            return header;
+        };
+
+        void clear() {
+            read_header_idx = write_header_idx;
+        };
+    };
+
+    LineHeaders _line_headers;
+
+    // index the line just found, unless any line before it had to go unindexed
+    void _indexLine(uint16_t start_offset, uint16_t length) {
+        uint32_t now = SysTickTimer.getValue();
+        if (_saw_a_line) {
+            uint32_t gap = now - _last_line_tick;
+            if (gap > _stats->gap_max) {
+                _stats->gap_max = gap;
+            }
+        }
+        _last_line_tick = now;
+        _saw_a_line = true;
+
+        if (!_line_headers.isFull() && (_line_headers.count() == _lines_found)) {
+            _line_headers.addLine(start_offset, length, now);
+        }
+    };
+
     uint16_t _getNextScanOffset() {
         return ((_scan_offset + 1) & (_size-1));
     }
 
     bool _isMoreToScan() {
-        return _canBeRead(_scan_offset);
+#if XIO_REALTIME_ENABLED == true
+        if (_rt_restart) {
+            return false;
+        }
+        if (_rt_held && !_rt_released && (_scan_offset == _rt_scan_offset)) {
+            _rt_resume_at_start = _at_start_of_line;    // past the control the realtime scan waits on
+            _rt_released = true;
+        }
+        if (_scan_offset == _rt_scan_offset) {
+            return false;                   // stay behind the realtime scan
+        }
+#endif
+        if (!_canBeRead(_scan_offset)) {
+            return false;
+        }
+#if defined(__CM7_REV)
+        if (_scan_offset == _invalidated_offset) {
+            _invalidateNew(_getWriteOffset());
+        }
+#endif
+        return true;
     };
 
     /*
@@ -730,14 +1031,7 @@ struct LineRXBuffer : RXBuffer<_size, owner_type, char> {
                 // don't do anything
             }
             // Classify the line if it's a single character 
-            else if (_at_start_of_line &&
-                ((c == '!')         ||      // feedhold
-                 (c == '~')         ||      // cycle start
-                 (c == ENQ)         ||      // request ENQ/ack
-                 (c == CHAR_RESET)  ||      // ^X - reset (aka cancel, terminate)
-                 (c == CHAR_ALARM)  ||      // ^D - request job kill (end of transmission)
-                 (c == '%' && cm_has_hold()) // flush (only in feedhold or part of control header)
-                ))
+            else if (_at_start_of_line && _isControlChar(c))    // ! ~ ENQ ^X ^D, and % in a hold
             {
 
                 _line_start_offset = _scan_offset;
@@ -745,6 +1039,9 @@ struct LineRXBuffer : RXBuffer<_size, owner_type, char> {
                 // single-character control
                 is_control = true;
                 ends_line  = true;
+#if XIO_REALTIME_ENABLED == true
+                _found_realtime = (_controlCharType(c) == CTRL_REALTIME);
+#endif
             }
             else {
                 if (_at_start_of_line) {
@@ -787,11 +1084,15 @@ struct LineRXBuffer : RXBuffer<_size, owner_type, char> {
                     }
                     return true;
                 } else {                // we did find one more line, though.
+                    // _scan_offset is one past the line-ending
+                    _indexLine(_line_start_offset, (_scan_offset - 1 - _line_start_offset)&(_size-1));
                     _lines_found++;
                 }
             } // if ends_line
             else if (_last_line_length == (_line_buffer_size - 1)) {
                 // force an end-of-line, splitting this line into two lines
+                _indexLine(_line_start_offset, _line_buffer_size - 1);
+                _stats->dropped++;
                 _ignore_until_next_line = true;
                 _line_start_offset = _scan_offset;
                 _lines_found++;
@@ -819,11 +1120,28 @@ struct LineRXBuffer : RXBuffer<_size, owner_type, char> {
      * If the control was the first char of the buffer it also moves the _data_offset, marking it as read
      */
     char *readline(bool control_only, uint16_t &line_size) {
+        // The caller is done with the last line by now - let the transfer have that space back
+        _releaseLine();
+
         // This is tricky: if we don't have room for more skip_sections, then we
         // can't scan any more for controls. So we don't scan, amd hope some lines are read.
-        bool found_control = _skip_sections.isFull() ? false : _scanBuffer();
+        bool found_control = false;
+        if (!_skip_sections.isFull()) {
+            found_control = _scanBuffer();
+            uint16_t scanned = (_scan_offset - _last_scan_offset)&(_size-1);
+            _stats->bytes += scanned;
+#if RX_CAPTURE_ENABLED == true
+            if (_capture && (scanned > 0)) {
+                uint16_t to_end = std::min(scanned, uint16_t(_size - _last_scan_offset));
+                rxc_rx(&_data[_last_scan_offset], to_end);
+                if (scanned > to_end) {                         // the run wraps the end of _data
+                    rxc_rx(&_data[0], scanned - to_end);
+                }
+            }
+#endif
+        }
 
-        _restartTransfer();
+        _restartTransferForPackets();
 
         _last_returned_a_control = found_control;
 
@@ -877,6 +1195,14 @@ struct LineRXBuffer : RXBuffer<_size, owner_type, char> {
                 _read_offset = _scan_offset;
             }
 
+#if XIO_REALTIME_ENABLED == true
+            if (_found_realtime) {              // the realtime scan already acted on it
+                _found_realtime = false;
+                _last_returned_a_control = false;
+                line_size = 0;
+                return nullptr;
+            }
+#endif
             return _line_buffer;
         } // end if (found_control)
 
@@ -914,43 +1240,121 @@ struct LineRXBuffer : RXBuffer<_size, owner_type, char> {
             c = _data[_read_offset];
         }
 
-        while (line_size < (_line_buffer_size - 1)) {
-            _read_offset = (_read_offset+1)&(_size-1);
+        // find the end of the line - the scan has already seen it, or has split a too-long line here
+        uint16_t line_start_offset = _read_offset;
+        bool is_indexed = false;
+        if (!_line_headers.isEmpty()) {
+            const typename LineHeaders::LineHeader &header = _line_headers.popLine();
+            if (header.start_offset == line_start_offset) {
+                // it's indexed - no need to walk it
+                is_indexed = true;
+                line_size = header.length;
+                uint16_t latency = (uint16_t)SysTickTimer.getValue() - header.found_tick;
+                if (latency > _stats->latency_max) {
+                    _stats->latency_max = latency;
+                }
+                _read_offset = (line_start_offset + line_size + ((line_size < (_line_buffer_size - 1)) ? 1 : 0))&(_size-1);
+            } else {
+                _debug_trap("read out of step with the line index");
+                _line_headers.clear();      // walk the lines until the scan indexes them again
+            }
+        }
+        if (!is_indexed) {
+            while (line_size < (_line_buffer_size - 1)) {
+                _read_offset = (_read_offset+1)&(_size-1);
 
-            if ( c == '\r' ||
-                 c == '\n'
-                ) {
+                if ( c == '\r' ||
+                     c == '\n'
+                    ) {
 
-                break;
+                    break;
+                }
+
+                line_size++;
+                c = _data[_read_offset];
             }
+        }
 
-            line_size++;
-            *dst_ptr = c;
+        --_lines_found;
+        _stats->lines++;
 
-            // update read/write positions
-            dst_ptr++;
+        // If the line is contiguous in _data and ended by a CR or LF then terminate it in place and
+        // return it without copying. The line-ending being replaced with the NUL has already been scanned.
+        if ((line_size < (_line_buffer_size - 1)) && ((line_start_offset + line_size) < _size)) {
+            _data[line_start_offset + line_size] = 0;
 
-            c = _data[_read_offset];
+            _held_read_offset = _read_offset;
+            _read_offset = line_start_offset;
+            _line_is_held = true;
+
+            _restartTransferForPackets();
+            return &_data[line_start_offset];
+        }
+
+        // otherwise it wraps (or was split), so copy it to _line_buffer
+        for (uint16_t i = 0; i < line_size; i++) {
+            *dst_ptr++ = _data[(line_start_offset + i)&(_size-1)];
         }
         if (line_size == (_line_buffer_size - 1)) {
             // add a line-ending
             *dst_ptr++ = '\n';
         }
 
-        --_lines_found;
-
-        _restartTransfer();
+        _restartTransferForPackets();
 
         // null-terminate the string
         *dst_ptr = 0;
         return _line_buffer;
     }; // readline
 
+    /*
+     * _restartTransferForPackets() - restart the RX transfer once there's room for a few packets
+     *
+     *  Restarting on every read offers the transfer whatever few bytes were just freed, so a fast
+     *  host gets one short transfer (and interrupt) after another. Waiting for XIO_RX_TRANSFER_MIN_FREE
+     *  lets each transfer take several full packets - 512 bytes each on high-speed USB. If there is
+     *  nothing left to read the transfer is restarted anyway, as nothing else would free more space.
+     */
+    void _restartTransferForPackets() {
+#if XIO_RX_TRANSFER_MIN_FREE > 0
+        if ((_lines_found > 0) && (bytesFree() < XIO_RX_TRANSFER_MIN_FREE)) {
+            return;
+        }
+#endif
+        _restartTransfer();
+    };
+
+    /*
+     * _releaseLine() - hand the space of a line returned in place back to the transfer
+     */
+    void _releaseLine() {
+        if (_line_is_held) {
+            _read_offset = _held_read_offset;
+            _line_is_held = false;
+        }
+    };
+
+    /*
+     * bytesFree() - bytes the transfer may still write before it reaches the data not yet read
+     *
+     *  This counts lines already scanned but not read (and a line in use) as not free.
+     */
+    uint16_t bytesFree() {
+        return ((_size - 1) - ((_getWriteOffset() - _read_offset)&(_size-1)));
+    };
+
 
     // this is called from flushRead()
     void flush() {
+        _line_is_held = false;      // the parent moves the read offset up to the write offset
         parent_type::flush();
         _scan_offset = _read_offset;
+#if defined(__CM7_REV)
+        _invalidated_offset = _scan_offset;     // nothing past here has been read
+#endif
+#if XIO_REALTIME_ENABLED == true
+        _rt_restart = true;
+#endif
 
         // This is similar to the % "queue flush" handling above, except we flush
         // the scan to the to the read (which was just set tot he write by the parent),
@@ -958,6 +1362,7 @@ struct LineRXBuffer : RXBuffer<_size, owner_type, char> {
 
         // record that we have 0 lines (of data) in the buffer
         _lines_found = 0;
+        _line_headers.clear();
 
         // and clear out any skip sections we have
         while (!_skip_sections.isEmpty()) {
@@ -985,10 +1390,12 @@ struct LineRXBuffer : RXBuffer<_size, owner_type, char> {
         // flush to.
 
         // move the read buffer up to where we ended scanning
+        _line_is_held = false;
         _read_offset = _scan_offset;
 
         // record that we have 0 lines (of data) in the buffer
         _lines_found = 0;
+        _line_headers.clear();
 
         // and clear out any skip sections we have
         while (!_skip_sections.isEmpty()) {
@@ -1002,6 +1409,80 @@ struct LineRXBuffer : RXBuffer<_size, owner_type, char> {
 
 }; // LineRXBuffer
 
+/* TXChain<count, size>
+ * A ring of pre-allocated buffers holding responses the TX buffer had no room for.
+ * Writes fill the tail buffer and move on to the next. The head buffer is handed to
+ * the TX buffer (and so to its DMA) from the main loop as space comes free, so
+ * producing a response never waits on the host. If every buffer is in use the rest
+ * of the response is dropped and counted - _sync_to_tx_buffer() holds off commands
+ * before that happens.
+ */
+template <uint8_t _count, uint16_t _buffer_size>
+struct TXChain {
+    static_assert(((_count-1)&_count)==0, "TXChain count must be 2^N");
+
+    struct ChainBuffer {
+        uint16_t read_offset;       // the next byte to hand to the TX buffer
+        uint16_t length;            // bytes in the buffer
+        char data[_buffer_size];
+    };
+
+    ChainBuffer _buffers[_count];
+    uint8_t _head;                  // the buffer being sent
+    uint8_t _tail;                  // the buffer after the last one being filled
+
+    bool isEmpty() { return (_head == _tail); };
+    uint8_t count() { return ((_tail - _head)&(_count-1)); };
+
+    void clear() {
+        _head = 0;
+        _tail = 0;
+    };
+
+    // queue the bytes - returns the number dropped for want of a buffer
+    int16_t write(const char *buffer, int16_t len) {
+        while (len > 0) {
+            ChainBuffer *tail = &_buffers[(_tail-1)&(_count-1)];
+            if (isEmpty() || (tail->length == _buffer_size)) {
+                if (count() == (_count-1)) {    // one buffer is left open to tell full from empty
+                    return (len);
+                }
+                tail = &_buffers[_tail];
+                tail->read_offset = 0;
+                tail->length = 0;
+                _tail = (_tail+1)&(_count-1);
+                if (count() > xio_tx.high_water) {
+                    xio_tx.high_water = count();
+                }
+            }
+            uint16_t to_copy = std::min((uint16_t)len, (uint16_t)(_buffer_size - tail->length));
+            memcpy(&tail->data[tail->length], buffer, to_copy);
+            tail->length += to_copy;
+            buffer += to_copy;
+            len -= to_copy;
+        }
+        return (0);
+    };
+
+    // hand queued bytes to the TX buffer until it stops taking them
+    template <typename tx_type>
+    void send(tx_type &tx_buffer) {
+        while (!isEmpty()) {
+            ChainBuffer &head = _buffers[_head];
+            int16_t to_send = head.length - head.read_offset;
+            int16_t sent = tx_buffer.write(&head.data[head.read_offset], to_send);
+            if (sent <= 0) {
+                return;
+            }
+            head.read_offset += sent;
+            if (sent < to_send) {
+                return;
+            }
+            _head = (_head+1)&(_count-1);
+        }
+    };
+}; // TXChain
+
 /* xioDeviceWrapper<typename Device>
  * Implements a xioDeviceWrapperBase around a Device. The Device must implement:
  *   For RXBuffer:
@@ -1020,11 +1501,11 @@ template<typename Device>
 struct xioDeviceWrapper : xioDeviceWrapperBase {    // describes a device for reading and writing
     Device _dev;
 
-    // TODO - make _buffer_size, _header_count, and _line_buffer_size configurable
-    LineRXBuffer<1024, Device> _rx_buffer;
+    LineRXBuffer<XIO_RX_RING_SIZE, Device, XIO_RX_LINE_INDEX_SIZE> _rx_buffer;
     TXBuffer<1024, Device> _tx_buffer;
+    TXChain<XIO_TX_CHAIN_BUFFERS, XIO_TX_CHAIN_BUFFER_SIZE> _tx_chain;
 
-    xioDeviceWrapper(Device dev, uint8_t _caps) : xioDeviceWrapperBase(_caps), _dev{dev}, _rx_buffer{_dev}, _tx_buffer{_dev}
+    xioDeviceWrapper(Device dev, uint8_t _caps, xioRxStats_t *rx_stats) : xioDeviceWrapperBase(_caps), _dev{dev}, _rx_buffer{_dev, rx_stats}, _tx_buffer{_dev}
     {
 //        _dev->setDataAvailableCallback([&](const size_t &length) {
 //
@@ -1038,10 +1519,12 @@ struct xioDeviceWrapper : xioDeviceWrapperBase {    // describes a device for re
 
         _rx_buffer.init();
         _tx_buffer.init();
+        _tx_chain.clear();
     };
 
     void flush() final {
         _tx_buffer.flush();
+        _tx_chain.clear();
         return _dev->flush();
     }
 
@@ -1060,15 +1543,50 @@ struct xioDeviceWrapper : xioDeviceWrapperBase {    // describes a device for re
         return _rx_buffer.flushToCommand();
     }
 
+    uint16_t rxBytesFree() final {
+        return _rx_buffer.bytesFree();
+    }
+
+#if XIO_REALTIME_ENABLED == true
+    void realtimeScan() final {
+        if (isConnected()) {
+            _rx_buffer.realtimeScan();
+        }
+    }
+#endif
+
+    // Everything is taken - what the TX buffer can't hold goes on the chain, behind anything already there
     virtual int16_t write(const char *buffer, int16_t len) final {
         if (!isConnected()) {
+            _tx_chain.clear();
             return -1;
         }
-        return _tx_buffer.write(buffer, len);
+        int16_t written = 0;
+        _tx_chain.send(_tx_buffer);
+        if (_tx_chain.isEmpty()) {
+            written = std::max(_tx_buffer.write(buffer, len), (int16_t)0);
+        }
+        if (written < len) {
+            xio_tx.dropped += _tx_chain.write(buffer + written, len - written);
+        }
+        return len;
+    }
+
+    void txCallback() final {
+        if (isConnected()) {
+            _tx_chain.send(_tx_buffer);
+        } else {
+            _tx_chain.clear();
+        }
+    }
+
+    uint8_t txChainCount() final {
+        return _tx_chain.count();
     }
 
     virtual char *readline(devflags_t limit_flags, uint16_t &size) final {
         if ((limit_flags & flags) && isConnected()) {
+            _rx_buffer._capture = isData();
             return _rx_buffer.readline(!(limit_flags & DEV_IS_DATA), size);
         }
 
@@ -1246,6 +1764,19 @@ struct xioFlashFileDeviceWrapper : xioDeviceWrapperBase {    // describes a devi
             return nullptr;
         }
 
+        if (_current_file->isTokenized()) {     // decoded straight into the line buffer
+            if (!_current_file->readTokenizedLine(!(limit_flags & DEV_IS_DATA), _line_buffer, _line_buffer_size - 1, line_size)) {
+                if (_current_file->isDone()) {
+                    _current_file = nullptr;
+                    cs.responses_suppressed = false;
+                    clearActive();
+                }
+                return nullptr;
+            }
+            cs.responses_suppressed = true;
+            return _line_buffer;
+        }
+
         const char *from = _current_file->readline(!(limit_flags & DEV_IS_DATA), line_size);
         if ((nullptr == from) && (_current_file->isDone())) {
             // all done sending this file, "close" it
@@ -1270,19 +1801,347 @@ struct xioFlashFileDeviceWrapper : xioDeviceWrapperBase {    // describes a devi
     };
 };
 
+#if RX_CAPTURE_ENABLED == true
+/* xioReplayDeviceWrapper
+ * Replays an RX capture (rx_capture.h) as a data channel. Bytes are released at the times they were
+ * captured and gathered into lines here, so a line is returned only once its last byte is due. Single
+ * character controls at the start of a line are returned at once, as the RX scan does, and are the
+ * only lines a control-only read takes. A flush drops what has arrived and not been read, as it would
+ * from an RX buffer, and the replay goes on with what arrives after it.
+ */
+
+template<uint16_t _line_buffer_size = RX_BUFFER_SIZE>
+struct xioReplayDeviceWrapper : xioDeviceWrapperBase {
+    char _line_buffer[_line_buffer_size];
+    uint16_t _line_length = 0;      // bytes gathered of the next line
+    bool _line_ready = false;       // it's complete
+    bool _running = false;          // a replay was started and hasn't been stopped here
+
+    xioReplayDeviceWrapper() : xioDeviceWrapperBase(DEV_CAN_READ | DEV_IS_ALWAYS_BOTH)
+    {
+    };
+
+    static bool _isControlChar(char c) {
+        return ((c == CHAR_FEEDHOLD) || (c == CHAR_CYCLE_START) || (c == CHAR_QUEUE_FLUSH) ||
+                (c == CHAR_RESET) || (c == CHAR_ALARM) || (c == ENQ));
+    };
+
+    void _gatherLine() {
+        char c;
+        while (!_line_ready && rxc_replay_char(c)) {
+            if ((c == '\r') || (c == '\n')) {
+                _line_ready = (_line_length > 0);
+            } else if ((_line_length == 0) && _isControlChar(c)) {
+                _line_buffer[_line_length++] = c;
+                _line_ready = true;
+            } else if (_line_length < (_line_buffer_size - 1)) {
+                _line_buffer[_line_length++] = c;   // a longer line is cut short, as by the RX scan
+            }
+        }
+    };
+
+    void flush() final {
+        // nothing to do
+    }
+
+    void flushRead() final {
+        char c;
+        while (rxc_replay_char(c)) {};  // drop what has arrived
+        _line_length = 0;
+        _line_ready = false;
+        cs.responses_suppressed = false;
+    }
+
+    bool flushToCommand() final {
+        return false;
+    }
+
+    int16_t write(const char *buffer, int16_t len) final {
+        return -1;
+    }
+
+    void start() {
+        _line_length = 0;
+        _line_ready = false;
+        _running = true;
+        setActive();
+    };
+
+    void _stop() {
+        rxc.replay = 0;
+        _running = false;
+        _line_length = 0;
+        _line_ready = false;
+        cs.responses_suppressed = false;
+        clearActive();
+    };
+
+    char *readline(devflags_t limit_flags, uint16_t &line_size) final {
+        line_size = 0;
+        if (!_running) {
+            return nullptr;
+        }
+        if (!rxc.replay) {                  // {rxcr:0}
+            _stop();
+            return nullptr;
+        }
+        _gatherLine();
+
+        if (!_line_ready) {
+            if (rxc_replay_is_done()) {     // the end of the capture ends the replay
+                _stop();
+            }
+            return nullptr;
+        }
+        if (!(limit_flags & DEV_IS_DATA) && !((_line_length == 1) && _isControlChar(_line_buffer[0]))) {
+            return nullptr;                 // a data line waits for the data pass
+        }
+        _line_buffer[_line_length] = 0;
+        line_size = _line_length;
+        _line_length = 0;
+        _line_ready = false;
+        cs.responses_suppressed = true;
+        return _line_buffer;
+    };
+};
+#endif // RX_CAPTURE_ENABLED
+
+#if XIO_HAS_SPOOL == 1
+/* xioSpoolDeviceWrapper
+ * Runs a job stored in an xioSpoolStorage. The job is read a block at a time into two buffers.
+ * readline() takes lines from one while readAhead() (from the main loop) fills the other, so a
+ * slow storage read never lands in the middle of a line. The host uploads the job with {spu:},
+ * through the same buffers, and starts it with {sps:1}. Host (USB) latency then has no effect
+ * on the job - the host is only needed for controls.
+ */
+
+template<uint16_t _line_buffer_size = 512>
+struct xioSpoolDeviceWrapper : xioDeviceWrapperBase {
+    xioSpoolStorage *_storage = nullptr;
+
+    struct SpoolHeader {
+        uint32_t magic;         // XIO_SPOOL_MAGIC if a job is stored
+        uint32_t length;        // bytes in the job
+    };
+
+    struct SpoolBlock {
+        uint32_t offset;        // job offset of data[0]
+        uint16_t length;        // job bytes in data - less than a full block only at the end of the job
+        bool ready;             // data has been read and not yet used up
+        char data[XIO_SPOOL_BLOCK_SIZE];
+    };
+
+    SpoolBlock _blocks[2];
+    uint8_t _current;           // block readline() takes from
+    uint16_t _block_offset;     // next byte in the current block
+    uint32_t _next_fetch;       // job offset of the next block to read
+    uint32_t _job_length;       // bytes in the stored job
+    bool _running;              // running the job
+    bool _uploading;            // storing lines from the host in _blocks[0]
+
+    uint16_t _line_length;      // characters assembled in _line_buffer so far
+    char _line_buffer[_line_buffer_size]; // lines can span blocks, so they are assembled here
+
+    xioSpoolDeviceWrapper() : xioDeviceWrapperBase(DEV_CAN_READ | DEV_IS_ALWAYS_BOTH)
+    {
+    };
+
+    void setStorage(xioSpoolStorage *storage) {
+        SpoolHeader header;
+        _storage = storage;
+        _job_length = 0;
+        if ((nullptr != _storage) && _storage->read(0, (char *)&header, sizeof(header)) && (header.magic == XIO_SPOOL_MAGIC)) {
+            _job_length = header.length;
+        }
+    }
+
+    /*
+     * Uploading - whole blocks are written as they fill, then the header once the job is complete
+     */
+    stat_t startUpload() {
+        if (nullptr == _storage) { return (STAT_NO_SUCH_DEVICE); }
+        if (_running) { return (STAT_COMMAND_NOT_ACCEPTED); }
+        if (!_storage->erase()) { return (STAT_ERROR); }
+        _job_length = 0;
+        _blocks[0].offset = 0;
+        _blocks[0].length = 0;
+        _uploading = true;
+        return (STAT_OK);
+    }
+
+    stat_t _writeBlock() {
+        if ((XIO_SPOOL_BLOCK_SIZE + _blocks[0].offset + XIO_SPOOL_BLOCK_SIZE) > _storage->capacity()) {
+            _uploading = false;
+            return (STAT_FILE_SIZE_EXCEEDED);
+        }
+        if (!_storage->write(XIO_SPOOL_BLOCK_SIZE + _blocks[0].offset, _blocks[0].data, XIO_SPOOL_BLOCK_SIZE)) {
+            _uploading = false;
+            return (STAT_ERROR);
+        }
+        _blocks[0].offset += XIO_SPOOL_BLOCK_SIZE;
+        _blocks[0].length = 0;
+        return (STAT_OK);
+    }
+
+    stat_t writeLine(const char *line) {
+        do {                    // store the line and its newline
+            char c = *line ? *line++ : '\n';
+            _blocks[0].data[_blocks[0].length++] = c;
+            _job_length++;
+            if (_blocks[0].length == XIO_SPOOL_BLOCK_SIZE) {
+                ritorno(_writeBlock());
+            }
+            if (c == '\n') { break; }
+        } while (true);
+        return (STAT_OK);
+    }
+
+    stat_t endUpload() {
+        if (!_uploading) { return (STAT_OK); }
+        if (_blocks[0].length > 0) {
+            ritorno(_writeBlock());
+        }
+        _uploading = false;
+        SpoolHeader header = { XIO_SPOOL_MAGIC, _job_length };
+        memset(_blocks[0].data, 0, XIO_SPOOL_BLOCK_SIZE);
+        memcpy(_blocks[0].data, &header, sizeof(header));
+        if (!_storage->write(0, _blocks[0].data, XIO_SPOOL_BLOCK_SIZE)) {
+            _job_length = 0;
+            return (STAT_ERROR);
+        }
+        return (STAT_OK);
+    }
+
+    /*
+     * Running
+     */
+    bool _fetch(SpoolBlock &block) {
+        block.offset = _next_fetch;
+        block.length = std::min((uint32_t)XIO_SPOOL_BLOCK_SIZE, _job_length - _next_fetch);
+        if (!_storage->read(XIO_SPOOL_BLOCK_SIZE + block.offset, block.data, block.length)) {
+            rpt_exception(STAT_FILE_NOT_OPEN, "spooled job read failed");
+            stop();
+            return (false);
+        }
+        _next_fetch += block.length;
+        block.ready = true;
+        return (true);
+    }
+
+    stat_t start() {
+        if (nullptr == _storage) { return (STAT_NO_SUCH_DEVICE); }
+        if (_running || _uploading) { return (STAT_COMMAND_NOT_ACCEPTED); }
+        if (_job_length == 0) { return (STAT_FILE_NOT_OPEN); }
+        _next_fetch = 0;
+        _current = 0;
+        _block_offset = 0;
+        _line_length = 0;
+        _blocks[1].ready = false;
+        _running = true;
+        if (!_fetch(_blocks[0])) {
+            return (STAT_FILE_NOT_OPEN);
+        }
+        setActive();
+        return (STAT_OK);
+    }
+
+    void stop() {
+        _running = false;
+        cs.responses_suppressed = false;
+        clearActive();
+    }
+
+    void readAhead() final {
+        SpoolBlock &other = _blocks[_current ^ 1];
+        if (_running && !other.ready && (_next_fetch < _job_length)) {
+            _fetch(other);
+        }
+    }
+
+    void init() {
+    };
+
+    void flush() final {
+        // nothing to do
+    }
+
+    void flushRead() final {
+        stop();
+    }
+
+    bool flushToCommand() final {
+        stop();                 // as for flash files, the end of the job is the next "command"
+        return false;
+    }
+
+    int16_t write(const char *buffer, int16_t len) final {
+        return -1;
+    }
+
+    char *readline(devflags_t limit_flags, uint16_t &line_size) final {
+        line_size = 0;
+        if (!_running || !(limit_flags & DEV_IS_DATA)) {
+            return nullptr;     // jobs don't carry controls
+        }
+        while (true) {
+            SpoolBlock &block = _blocks[_current];
+            if (!block.ready) {                         // read-ahead fell behind - read the block now
+                if ((_next_fetch >= _job_length) || !_fetch(block)) {
+                    break;
+                }
+            }
+            if (_block_offset == block.length) {        // used it up - move on to the other one
+                block.ready = false;
+                _current ^= 1;
+                _block_offset = 0;
+                if ((block.offset + block.length) >= _job_length) {
+                    break;                              // that was the end of the job
+                }
+                continue;
+            }
+            char c = block.data[_block_offset++];
+            if (c == '\n') {
+                _line_buffer[_line_length] = NUL;
+                line_size = _line_length;
+                _line_length = 0;
+                cs.responses_suppressed = true;
+                return _line_buffer;
+            }
+            if (_line_length < (_line_buffer_size - 2)) {
+                _line_buffer[_line_length++] = c;
+            }
+        }
+        if (_running && (_next_fetch >= _job_length) && !_blocks[_current].ready) {
+            stop();                                     // all done
+        }
+        return nullptr;
+    };
+};
+#endif // XIO_HAS_SPOOL
+
+xioRxStats_t xio_rx_stats[XIO_RX_STATS_DEVICES];
+
 xioFlashFileDeviceWrapper<> flashFileWrapper {};
+#if XIO_HAS_SPOOL == 1
+xioSpoolDeviceWrapper<> spoolWrapper {};
+#endif
+#if RX_CAPTURE_ENABLED == true
+xioReplayDeviceWrapper<> replayWrapper {};
+#endif
 
 // ALLOCATIONS
 // Declare a device wrapper class for SerialUSB and SerialUSB1
 #if XIO_HAS_USB == 1
 xioDeviceWrapper<decltype(&SerialUSB)> serialUSB0Wrapper {
     &SerialUSB,
-    (DEV_CAN_READ | DEV_CAN_WRITE | DEV_CAN_BE_CTRL | DEV_CAN_BE_DATA)
+    (DEV_CAN_READ | DEV_CAN_WRITE | DEV_CAN_BE_CTRL | DEV_CAN_BE_DATA),
+    &xio_rx_stats[DEV_USB0]
 };
 #if USB_SERIAL_PORTS_EXPOSED == 2
 xioDeviceWrapper<decltype(&SerialUSB1)> serialUSB1Wrapper {
     &SerialUSB1,
-    (DEV_CAN_READ | DEV_CAN_WRITE | DEV_CAN_BE_CTRL | DEV_CAN_BE_DATA)
+    (DEV_CAN_READ | DEV_CAN_WRITE | DEV_CAN_BE_CTRL | DEV_CAN_BE_DATA),
+    &xio_rx_stats[DEV_USB1]
 };
 #endif
 #endif // XIO_HAS_USB
@@ -1294,14 +2153,23 @@ constexpr devflags_t _serial0ExtraFlags = DEV_IS_ALWAYS_BOTH;
 #endif
 xioDeviceWrapper<decltype(&Serial)> serial0Wrapper {
     &Serial,
-    (DEV_CAN_READ | DEV_CAN_WRITE | _serial0ExtraFlags)
+    (DEV_CAN_READ | DEV_CAN_WRITE | _serial0ExtraFlags),
+    &xio_rx_stats[DEV_UART1]
 };
 #endif // XIO_HAS_UART
 
+xioTXStats_t xio_tx;
+
 // Define the xio singleton (and initialize it to hold our two deviceWrappers)
 //xio_t xio = { &serialUSB0Wrapper, &serialUSB1Wrapper };
 xio_t xio = {
     &flashFileWrapper,
+#if XIO_HAS_SPOOL == 1
+    &spoolWrapper,                          // ahead of the serial devices, so a running job is read first
+#endif
+#if RX_CAPTURE_ENABLED == true
+    &replayWrapper,                         // ahead of the serial devices, as the host it stands in for
+#endif
 #if XIO_HAS_USB == 1
     &serialUSB0Wrapper,
 #if USB_SERIAL_PORTS_EXPOSED == 2
@@ -1313,6 +2181,13 @@ xio_t xio = {
 #endif
 };
 
+#if XIO_REALTIME_ENABLED == true
+// Feedhold, cycle start and reset are acted on within a tick of arriving, however busy the main loop is
+Motate::SysTickEvent xio_realtime_tick_event {[&] {
+    xio.realtimeScan();
+}, nullptr};
+#endif
+
 /**** CODE ****/
 
 /*
@@ -1341,6 +2216,35 @@ void xio_init()
 #if XIO_HAS_UART == 1
     serial0Wrapper.init();
 #endif
+
+#if XIO_REALTIME_ENABLED == true
+    SysTickTimer.registerEvent(&xio_realtime_tick_event);
+#endif
+}
+
+/*
+ * xio_get_static_size() - RAM taken by the devices, with their RX rings and TX chains
+ */
+
+uint32_t xio_get_static_size()
+{
+    uint32_t size = sizeof(xio) + sizeof(flashFileWrapper);
+#if XIO_HAS_SPOOL == 1
+    size += sizeof(spoolWrapper);
+#endif
+#if RX_CAPTURE_ENABLED == true
+    size += sizeof(replayWrapper);
+#endif
+#if XIO_HAS_USB == 1
+    size += sizeof(serialUSB0Wrapper);
+#if USB_SERIAL_PORTS_EXPOSED == 2
+    size += sizeof(serialUSB1Wrapper);
+#endif
+#endif
+#if XIO_HAS_UART == 1
+    size += sizeof(serial0Wrapper);
+#endif
+    return (size);
 }
 
 stat_t xio_test_assertions()
@@ -1377,6 +2281,32 @@ int16_t xio_writeline(const char *buffer, bool only_to_muted /*= false*/)
     return xio.writeline(buffer, only_to_muted);
 }
 
+/*
+ * xio_callback() - move queued responses to the TX buffers, and read ahead on spooled jobs
+ * xio_tx_is_backed_up() - true if a control channel is falling behind on responses
+ */
+
+stat_t xio_callback()
+{
+    xio.txCallback();
+    xio.readAhead();
+    return (STAT_OK);
+}
+
+bool xio_tx_is_backed_up()
+{
+    return xio.txIsBackedUp();
+}
+
+/*
+ * xio_get_rx_bytes_free() - bytes free in the RX buffer of the data channel
+ */
+
+uint16_t xio_get_rx_bytes_free()
+{
+    return xio.rxBytesFree();
+}
+
 /*
  * write() - return true of the device is currently "connected" (there's a fair bit of interpretation)
  */
@@ -1386,14 +2316,119 @@ bool xio_connected()
     return xio.connected();
 }
 
+/*
+ * xio_flash_file::readTokenizedLine() - decode the next line of a tokenized flash file
+ *
+ *  A line that won't fit in dst is cut short. With control_only set, only single-character
+ *  controls are taken - they're never tokenized, so the first encoded byte is the character.
+ */
+
+static const char *const _flash_file_words[] = {    // must match WORDS in Resources/tokenize_gcode.py
+    "G0 X", "G1 X", "G0 Z", "G1 Z", "G2 X", "G3 X",
+    "G0 ", "G1 ", "G2 ", "G3 ",
+    " X-", " Y-", " Z-", " I-", " J-", "X-", "Y-", "Z-",
+    " X", " Y", " Z", " F", " I", " J", " S", " P",
+    ".0", "-0."
+};
+static_assert(sizeof(_flash_file_words)/sizeof(_flash_file_words[0]) == (0x100 - XIO_FLASH_WORDS_BASE),
+              "_flash_file_words[] must fill the token space");
+
+bool xio_flash_file::readTokenizedLine(bool control_only, char *dst, uint16_t dst_size, uint16_t &line_size)
+{
+    line_size = 0;
+    if (isDone()) {
+        return false;
+    }
+    const uint8_t *src = (const uint8_t *)_data + _read_offset;
+    uint8_t length = *src++;
+
+    if (control_only) {
+        char c = src[0];
+        if (!((c == '!')         ||
+              (c == '~')         ||
+              (c == ENQ)         ||
+              (c == CHAR_RESET)  ||
+              (c == CHAR_ALARM)  ||
+              (c == '%' && cm_has_hold()))) {
+            return false;
+        }
+    }
+    _read_offset += length + 1;
+
+    char *line = dst;
+    char *dst_end = dst + dst_size - 1;     // leave room for the NUL
+    while (length-- && (dst < dst_end)) {
+        uint8_t b = *src++;
+        if (b < XIO_FLASH_DIGIT_PAIR_BASE) {
+            *dst++ = b;
+        } else if (b < XIO_FLASH_WORDS_BASE) {
+            b -= XIO_FLASH_DIGIT_PAIR_BASE;
+            *dst++ = '0' + b/10;
+            if (dst < dst_end) { *dst++ = '0' + b%10; }
+        } else {
+            const char *word = _flash_file_words[b - XIO_FLASH_WORDS_BASE];
+            while (*word && (dst < dst_end)) { *dst++ = *word++; }
+        }
+    }
+    *dst = NUL;
+    line_size = dst - line;
+    return true;
+}
+
 /*
  * xio_send_file() - send the contents of a xio_flash_file - returns false if there's already one sending
+ * xio_file_is_sending() - true until the last line of the file has been read
  */
 
 bool xio_send_file(xio_flash_file &file) {
     return flashFileWrapper.sendFile(file);
 }
 
+bool xio_file_is_sending() {
+    return (flashFileWrapper._current_file != nullptr);
+}
+
+#if RX_CAPTURE_ENABLED == true
+/*
+ * xio_start_replay() - start the replay device on the RX capture - see rx_capture.h
+ */
+
+void xio_start_replay() {
+    replayWrapper.start();
+}
+#endif
+
+/*
+ * xio_spool_set_storage() - give the spool device its storage. Called from board_xio_init()
+ * xio_spool_is_uploading() - true if data lines are to be stored rather than run
+ * xio_spool_write_line() - store a data line of the job being uploaded
+ */
+
+void xio_spool_set_storage(xioSpoolStorage *storage)
+{
+#if XIO_HAS_SPOOL == 1
+    spoolWrapper.setStorage(storage);
+#endif
+}
+
+bool xio_spool_is_uploading()
+{
+#if XIO_HAS_SPOOL == 1
+    return (spoolWrapper._uploading);
+#else
+    return (false);
+#endif
+}
+
+stat_t xio_spool_write_line(const char *line)
+{
+#if XIO_HAS_SPOOL == 1
+    return (spoolWrapper.writeLine(line));
+#else
+    return (STAT_NO_SUCH_DEVICE);
+#endif
+}
+
 /*
  * xio_flush_to_command() - clear the last read channel up until the command that was read
  */
@@ -1448,6 +2483,65 @@ int _write( int file, char *ptr, int len )
 //    return (STAT_OK);
 //}
 
+/*
+ * xio_get_spu() - get spool upload state
+ * xio_set_spu() - 1 = erase storage and store the data lines that follow, 0 = end the upload
+ * xio_get_sps() - get spooled job run state
+ * xio_set_sps() - 1 = run the stored job, 0 = stop it
+ * xio_get_spl() - get bytes in the stored job
+ */
+
+stat_t xio_get_spu(nvObj_t *nv)
+{
+    nv->value = (float)xio_spool_is_uploading();
+    nv->valuetype = TYPE_INT;
+    return (STAT_OK);
+}
+
+stat_t xio_set_spu(nvObj_t *nv)
+{
+#if XIO_HAS_SPOOL == 1
+    return ((nv->value > 0) ? spoolWrapper.startUpload() : spoolWrapper.endUpload());
+#else
+    return (STAT_NO_SUCH_DEVICE);
+#endif
+}
+
+stat_t xio_get_sps(nvObj_t *nv)
+{
+#if XIO_HAS_SPOOL == 1
+    nv->value = (float)spoolWrapper._running;
+#else
+    nv->value = 0;
+#endif
+    nv->valuetype = TYPE_INT;
+    return (STAT_OK);
+}
+
+stat_t xio_set_sps(nvObj_t *nv)
+{
+#if XIO_HAS_SPOOL == 1
+    if (nv->value > 0) {
+        return (spoolWrapper.start());
+    }
+    spoolWrapper.stop();
+    return (STAT_OK);
+#else
+    return (STAT_NO_SUCH_DEVICE);
+#endif
+}
+
+stat_t xio_get_spl(nvObj_t *nv)
+{
+#if XIO_HAS_SPOOL == 1
+    nv->value = (float)spoolWrapper._job_length;
+#else
+    nv->value = 0;
+#endif
+    nv->valuetype = TYPE_INT;
+    return (STAT_OK);
+}
+
 /***********************************************************************************
  * TEXT MODE SUPPORT
  * Functions to print variables from the cfgArray table
@@ -98,6 +98,8 @@ enum xioDeviceEnum {                        // reconfigure this enum as you add
     DEV_UART1,                              // must be 2
 //  DEV_SPI0,                               // We can't have it here until we actually define it
     DEV_FLASH_FILE,                         // must be 0
+    DEV_SPOOL,                              // spooled job, if XIO_HAS_SPOOL
+    DEV_REPLAY,                             // replay of an RX capture, if RX_CAPTURE_ENABLED
     DEV_MAX
 };
 
@@ -111,13 +113,57 @@ enum xioSPIMode {
 
 #define RX_BUFFER_SIZE       512            // maximum length of recieved lines from xio_readline
 
+#ifndef XIO_RX_RING_SIZE                    // usually set per board in board/*.mk
+#define XIO_RX_RING_SIZE     1024           // RX DMA ring per device. Must be 2^N, and over RX_BUFFER_SIZE
+#endif
+#ifndef XIO_RX_LINE_INDEX_SIZE              // usually set per board in board/*.mk
+#define XIO_RX_LINE_INDEX_SIZE 32           // lines indexed ahead by the RX scan, plus 1. Must be 2^N, max 128
+#endif
+#ifndef XIO_RX_TRANSFER_MIN_FREE            // usually set per board in board/*.mk
+#define XIO_RX_TRANSFER_MIN_FREE 0          // RX ring bytes free before the transfer is restarted. 0 = always restart
+#endif
+
+/**** TX chain stuff *****/
+
+#ifndef XIO_TX_CHAIN_BUFFERS                // usually set per board in board/*.mk
+#define XIO_TX_CHAIN_BUFFERS  8             // responses queued per device while the TX buffer is full
+#endif
+#ifndef XIO_TX_CHAIN_BUFFER_SIZE
+#define XIO_TX_CHAIN_BUFFER_SIZE 256        // bytes in each chain buffer
+#endif
+
+typedef struct xioTXStats {
+    uint8_t high_water;                     // most chain buffers in use at once on any device {txhw:}
+    uint32_t dropped;                       // bytes dropped because the chain was full {txdr:}
+} xioTXStats_t;
+
+extern xioTXStats_t xio_tx;
+
+/**** RX stats stuff *****/
+
+#define XIO_RX_STATS_DEVICES DEV_FLASH_FILE // one set per serial device - DEV_USB0, DEV_USB1, DEV_UART1
+
+typedef struct xioRxStats {                 // all may be set to 0 to reset them
+    uint32_t bytes;                         // bytes received {rx0b:}
+    uint32_t lines;                         // data lines delivered to the dispatcher {rx0l:}
+    uint32_t dropped;                       // lines cut short for length - the rest was dropped {rx0d:}
+    uint32_t latency_max;                   // most ms from a line arriving to its dispatch {rx0t:}
+    uint32_t gap_max;                       // most ms between one line arriving and the next {rx0g:}
+} xioRxStats_t;
+
+extern xioRxStats_t xio_rx_stats[XIO_RX_STATS_DEVICES];
+
 /**** function prototypes ****/
 
 void xio_init(void);
 stat_t xio_test_assertions(void);
+uint32_t xio_get_static_size(void);
 
 size_t xio_write(const char *buffer, size_t size, bool only_to_muted = false);
 char *xio_readline(devflags_t &flags, uint16_t &size);
+uint16_t xio_get_rx_bytes_free(void);
+stat_t xio_callback(void);
+bool xio_tx_is_backed_up(void);
 int16_t xio_writeline(const char *buffer, bool only_to_muted = false);
 bool xio_connected();
 void xio_flush_to_command();
@@ -167,19 +213,38 @@ extern "C" {
 
 
 /**** xio_flash_file - object to hold in-flash (compiled-in) "files" to run ****/
+/*
+ * A file is either plain gcode, or tokenized by Resources/tokenize_gcode.py. A tokenized file starts
+ * with XIO_FLASH_FILE_TOKENIZED, and each line is a length byte followed by that many encoded bytes:
+ * printable ASCII as-is, 0x80-0xE3 for the digit pairs "00" to "99", and 0xE4-0xFF for the words
+ * in _flash_file_words[] (xio.cpp). The length byte lets a line be taken or skipped without a search.
+ */
+
+#define XIO_FLASH_FILE_TOKENIZED    0x01    // first byte of a tokenized flash file
+#define XIO_FLASH_DIGIT_PAIR_BASE   0x80    // 0x80-0xE3 are "00" to "99"
+#define XIO_FLASH_WORDS_BASE        0xE4    // 0xE4-0xFF are _flash_file_words[]
 
 struct xio_flash_file {
     const char * const _data;
     const int32_t _length;
+    const bool _tokenized;
 
     int32_t _read_offset = 0;
 
-    xio_flash_file(const char * const data, int32_t length) : _data{data}, _length{length} {};
+    xio_flash_file(const char * const data, int32_t length) :
+        _data{data}, _length{length}, _tokenized{(length > 0) && (data[0] == XIO_FLASH_FILE_TOKENIZED)} {};
 
     void reset() {
-        _read_offset = 0;
+        _read_offset = _tokenized ? 1 : 0;
+    };
+
+    bool isTokenized() {
+        return _tokenized;
     };
 
+    // tokenized files only - decode the next line into dst, NUL terminated. Returns false at the end
+    bool readTokenizedLine(bool control_only, char *dst, uint16_t dst_size, uint16_t &line_size);
+
     const char *readline(bool control_only, uint16_t &line_size) {
         line_size = 0;
         if (_read_offset == _length) { return nullptr; }
@@ -215,6 +280,9 @@ struct xio_flash_file {
     };
 
     bool isDone() {
+        if (_tokenized) {       // the NUL ending the array has length 0
+            return ((_read_offset >= _length) || (_data[_read_offset] == 0));
+        }
         return _read_offset == _length;
     }
 };
@@ -229,6 +297,43 @@ constexpr xio_flash_file make_xio_flash_file(const char (&data)[length]) {
 /**** function prototype for file-sending ****/
 
 bool xio_send_file(xio_flash_file &file);
+bool xio_file_is_sending(void);
+#if RX_CAPTURE_ENABLED == true
+void xio_start_replay(void);
+#endif
+
+/**** spooled jobs - a job uploaded once to onboard storage and run from there ****/
+/*
+ * The board supplies the storage (SD card, QSPI flash...) by passing an xioSpoolStorage to
+ * xio_spool_set_storage() from board_xio_init(). Block 0 holds the job header, the job follows.
+ * Storage calls are made from the main loop, never from interrupts.
+ */
+
+#ifndef XIO_HAS_SPOOL                       // set in board/*.mk by boards that provide spool storage
+#define XIO_HAS_SPOOL 0
+#endif
+#ifndef XIO_SPOOL_BLOCK_SIZE
+#define XIO_SPOOL_BLOCK_SIZE 512            // bytes per storage read or write, and per read-ahead buffer
+#endif
+#define XIO_SPOOL_MAGIC 0x4C4F4F53          // "SPOL" - marks a valid job header
+
+struct xioSpoolStorage {
+    // Don't use pure virtuals - see xioDeviceWrapperBase
+    virtual uint32_t capacity() { return 0; };                                              // bytes
+    virtual bool erase() { return false; };
+    virtual bool write(uint32_t offset, const char *buffer, uint16_t length) { return false; }; // whole blocks
+    virtual bool read(uint32_t offset, char *buffer, uint16_t length) { return false; };
+};
+
+void xio_spool_set_storage(xioSpoolStorage *storage);
+bool xio_spool_is_uploading(void);
+stat_t xio_spool_write_line(const char *line);
+
+stat_t xio_get_spu(nvObj_t *nv);            // {spu:1} start uploading a job, {spu:0} end it
+stat_t xio_set_spu(nvObj_t *nv);
+stat_t xio_get_sps(nvObj_t *nv);            // {sps:1} run the stored job, {sps:0} stop it
+stat_t xio_set_sps(nvObj_t *nv);
+stat_t xio_get_spl(nvObj_t *nv);            // {spl:n} bytes in the stored job
 
 #ifdef __TEXT_MODE
 